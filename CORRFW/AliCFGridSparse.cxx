@@ -33,6 +33,7 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TAxis.h"
+#include "TObjArray.h"
 #include "AliCFUnfolding.h"
 
 //____________________________________________________________________
@@ -150,17 +151,22 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   AliCFGridSparse* out = new AliCFGridSparse(fName,fTitle,nVars,bins);
 
   //set the range in the THnSparse to project
-  THnSparse* clone = ((THnSparse*)fData->Clone());
+  //the ranges are set on the grid itself and restored afterwards, to avoid copying the THnSparse
+  Int_t* first = new Int_t[GetNVar()];
+  Int_t* last  = new Int_t[GetNVar()];
+  SaveAxisRanges(first,last);
   if (varMin && varMax) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
-      SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
+      SetAxisRange(fData->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
     }
   }
   else AliInfo("Keeping same axis ranges");
 
-  out->SetGrid(clone->Projection(nVars,vars));
+  out->SetGrid(fData->Projection(nVars,vars));
+  RestoreAxisRanges(first,last);
   delete [] bins;
-  delete clone;
+  delete [] first;
+  delete [] last;
   return out;
 }
 
@@ -620,10 +626,19 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   // therefore varMin and varMax must have their dimensions equal to GetNVar()
   // If useBins=true, varMin and varMax are taken as bin numbers
   // if varmin or varmax point to null, all the range is taken, including over- and underflows
+  // The ranges are set on the grid itself and restored afterwards, to avoid copying the THnSparse
 
-  THnSparse* clone = (THnSparse*)fData->Clone();
+  if (iVar1 >= GetNVar() || iVar1 < 0 || iVar2 >= GetNVar() || iVar3 >= GetNVar() ||
+      (iVar3 >= 0 && iVar2 < 0)) {
+    AliError("Non-existent variable, return NULL");
+    return 0x0;
+  }
+
+  Int_t* first = new Int_t[GetNVar()];
+  Int_t* last  = new Int_t[GetNVar()];
+  SaveAxisRanges(first,last);
   if (varMin != 0x0 && varMax != 0x0) {
-    for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
+    for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(fData->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
   }
 
   TH1* projection = 0x0 ;
@@ -633,11 +648,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
 
   if (iVar3<0) {
     if (iVar2<0) {
-      if (iVar1 >= GetNVar() || iVar1 < 0 ) {
-	AliError("Non-existent variable, return NULL");
-	return 0x0;
-      }
-      projection = (TH1D*)clone->Projection(iVar1); 
+      projection = (TH1D*)fData->Projection(iVar1); 
       projection->SetTitle(Form("%s_proj-%s",GetTitle(),GetVarTitle(iVar1)));
       for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
         Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
@@ -646,12 +657,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
       }
     }
     else {
-      if (iVar1 >= GetNVar() || iVar1 < 0 ||
-	  iVar2 >= GetNVar() || iVar2 < 0 ) {
-	AliError("Non-existent variable, return NULL");
-	return 0x0;
-      }
-      projection = (TH2D*)clone->Projection(iVar2,iVar1); 
+      projection = (TH2D*)fData->Projection(iVar2,iVar1); 
       for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
         Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
 	TString binLabel = GetAxis(iVar1)->GetBinLabel(origBin) ;
@@ -665,13 +671,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
     }
   }
   else {
-    if (iVar1 >= GetNVar() || iVar1 < 0 ||
-	iVar2 >= GetNVar() || iVar2 < 0 ||
-	iVar3 >= GetNVar() || iVar3 < 0 ) {
-      AliError("Non-existent variable, return NULL");
-      return 0x0;
-    }
-    projection = (TH3D*)clone->Projection(iVar1,iVar2,iVar3); 
+    projection = (TH3D*)fData->Projection(iVar1,iVar2,iVar3); 
     for (Int_t iBin=1; iBin<=projection->GetNbinsX(); iBin++) {
       Int_t origBin = GetAxis(iVar1)->GetFirst()+iBin-1;
       TString binLabel = GetAxis(iVar1)->GetBinLabel(origBin) ;
@@ -692,10 +692,130 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   projection->SetName (name .Data());
   projection->SetTitle(title.Data());
 
-  delete clone;
+  RestoreAxisRanges(first,last);
+  delete [] first;
+  delete [] last;
   return projection ;
 }
 
+//____________________________________________________________________
+TObjArray* AliCFGridSparse::MultiSlice(Int_t nVars, const Int_t* vars, const Double_t *varMin, const Double_t *varMax, Bool_t useBins) const
+{
+  //
+  // return the 1D slices on each of the nVars variables in vars, filled in a single loop over the filled bins.
+  // Axis ranges are defined as in Slice(): with varMin and varMax (of dimension GetNVar()) if given,
+  // otherwise the current axis ranges are used. The range of each variable applies to all the slices,
+  // including the one on the variable itself.
+  // Each slice keeps the full binning of its axis, bins outside the range are left empty.
+  // The returned array owns the histograms.
+  //
+
+  const Int_t nDim = GetNVar();
+  for (Int_t iVar=0; iVar<nVars; iVar++) {
+    if (vars[iVar] >= nDim || vars[iVar] < 0) {
+      AliError("Non-existent variable, return NULL");
+      return 0x0;
+    }
+  }
+
+  // bin ranges of all the axes
+  Int_t* first = new Int_t[nDim];
+  Int_t* last  = new Int_t[nDim];
+  SaveAxisRanges(first,last);
+  if (varMin != 0x0 && varMax != 0x0) {
+    for (Int_t iAxis=0; iAxis<nDim; iAxis++) SetAxisRange(fData->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
+  }
+  Int_t* binMin = new Int_t[nDim];
+  Int_t* binMax = new Int_t[nDim];
+  for (Int_t iAxis=0; iAxis<nDim; iAxis++) {
+    TAxis* axis = fData->GetAxis(iAxis);
+    if (axis->TestBit(TAxis::kAxisRange)) {
+      binMin[iAxis] = axis->GetFirst();
+      binMax[iAxis] = axis->GetLast();
+    }
+    else { // including under- and overflows
+      binMin[iAxis] = 0;
+      binMax[iAxis] = axis->GetNbins()+1;
+    }
+  }
+  RestoreAxisRanges(first,last);
+  delete [] first;
+  delete [] last;
+
+  // output histograms
+  TObjArray* slices = new TObjArray(nVars);
+  slices->SetOwner(kTRUE);
+  TH1D** hist = new TH1D*[nVars];
+  Bool_t calcErrors = fData->GetCalculateErrors();
+  for (Int_t iVar=0; iVar<nVars; iVar++) {
+    TAxis* axis = fData->GetAxis(vars[iVar]);
+    TString name,title;
+    GetProjectionName (name ,vars[iVar]);
+    GetProjectionTitle(title,vars[iVar]);
+    if (axis->GetXbins()->GetSize()) hist[iVar] = new TH1D(name.Data(),title.Data(),axis->GetNbins(),axis->GetXbins()->GetArray());
+    else                             hist[iVar] = new TH1D(name.Data(),title.Data(),axis->GetNbins(),axis->GetXmin(),axis->GetXmax());
+    hist[iVar]->SetDirectory(0);
+    hist[iVar]->GetXaxis()->SetTitle(axis->GetTitle());
+    for (Int_t iBin=1; iBin<=axis->GetNbins(); iBin++) {
+      TString binLabel = axis->GetBinLabel(iBin);
+      if (binLabel.CompareTo("") != 0) hist[iVar]->GetXaxis()->SetBinLabel(iBin,binLabel);
+    }
+    if (calcErrors) hist[iVar]->Sumw2();
+    slices->AddAt(hist[iVar],iVar);
+  }
+
+  // single loop over the filled bins
+  Int_t* coord = new Int_t[nDim];
+  for (Long64_t iBin=0; iBin<fData->GetNbins(); iBin++) {
+    Double_t value = fData->GetBinContent(iBin,coord);
+    Bool_t inRange = kTRUE;
+    for (Int_t iAxis=0; iAxis<nDim && inRange; iAxis++) {
+      if (coord[iAxis] < binMin[iAxis] || coord[iAxis] > binMax[iAxis]) inRange = kFALSE;
+    }
+    if (!inRange) continue;
+    Double_t error2 = calcErrors ? fData->GetBinError2(iBin) : 0.;
+    for (Int_t iVar=0; iVar<nVars; iVar++) {
+      Int_t outBin = coord[vars[iVar]];
+      hist[iVar]->AddBinContent(outBin,value);
+      if (calcErrors) {
+	Double_t* sumw2 = hist[iVar]->GetSumw2()->GetArray();
+	sumw2[outBin] += error2;
+      }
+    }
+  }
+  for (Int_t iVar=0; iVar<nVars; iVar++) hist[iVar]->SetEntries(fData->GetEntries());
+
+  delete [] coord;
+  delete [] hist;
+  delete [] binMin;
+  delete [] binMax;
+  return slices;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SaveAxisRanges(Int_t* first, Int_t* last) const {
+  //
+  // stores the current range of each axis, last<0 if no range is set
+  //
+  for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
+    TAxis* axis = fData->GetAxis(iAxis);
+    first[iAxis] = axis->GetFirst();
+    last [iAxis] = axis->TestBit(TAxis::kAxisRange) ? axis->GetLast() : -1;
+  }
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::RestoreAxisRanges(const Int_t* first, const Int_t* last) const {
+  //
+  // sets back the axis ranges stored with SaveAxisRanges
+  //
+  for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
+    TAxis* axis = fData->GetAxis(iAxis);
+    if (last[iAxis] < 0) axis->SetRange(0,0);
+    else                 axis->SetRange(first[iAxis],last[iAxis]);
+  }
+}
+
 //____________________________________________________________________
 void AliCFGridSparse::SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const {
   //
@@ -22,6 +22,10 @@
 // prototype version by S.Arcelli silvia.arcelli@cern.ch
 ///////////////////////////////////////////////////////////////////////////
 #include "AliCFCutBase.h"
+#include "AliCFTrackKineCuts.h"
+#include "AliCFTrackQualityCuts.h"
+#include "AliESDtrack.h"
+#include "AliAODTrack.h"
 #include "AliCFManager.h"
 
 ClassImp(AliCFManager)
@@ -115,6 +119,92 @@ Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, const TString
   return kTRUE;
 }
 
+//_____________________________________________________________________________
+UInt_t AliCFManager::CheckParticleSteps(TObject *obj, Int_t firstStep, Int_t lastStep, const TString &selcuts) const {
+  //
+  // cumulative check of the particle-level selections firstStep..lastStep
+  // the type of obj is determined once: kinematic and quality cuts without QA
+  // are evaluated through their typed selection for AliESDtrack/AliAODTrack,
+  // and a cut object used in several steps is evaluated only once
+  // returns the mask of the passed steps
+  //
+
+  if (lastStep<0 || lastStep>=fNStepPart) lastStep = fNStepPart-1;
+  if (lastStep>=32) {
+    AliWarning(Form("Step mask limited to 32 steps, steps %d to %d are not checked",32,lastStep));
+    lastStep = 31;
+  }
+
+  TClass *cl = obj ? obj->IsA() : 0x0;
+  const AliESDtrack *esdTrack = (cl && cl==AliESDtrack::Class()) ? static_cast<const AliESDtrack*>(obj) : 0x0;
+  const AliAODTrack *aodTrack = (cl && cl==AliAODTrack::Class()) ? static_cast<const AliAODTrack*>(obj) : 0x0;
+  const AliVParticle *track = esdTrack ? static_cast<const AliVParticle*>(esdTrack) : static_cast<const AliVParticle*>(aodTrack);
+
+  // decisions of the cuts already evaluated for this particle
+  const Int_t kMaxCache = 64;
+  const AliCFCutBase *cache[kMaxCache];
+  Bool_t cacheDecision[kMaxCache];
+  Int_t nCache = 0;
+
+  UInt_t mask = 0;
+  for (Int_t istep=firstStep; istep<=lastStep; istep++) {
+    if (fPartCutList && fPartCutList[istep]) {
+      Bool_t passed = kTRUE;
+      TObjArrayIter iter(fPartCutList[istep]);
+      AliCFCutBase *cut = 0;
+      while ( passed && (cut = (AliCFCutBase*)iter.Next()) ) {
+	if (!CompareStrings(cut->GetName(),selcuts)) continue;
+
+	Int_t icache = 0;
+	while (icache<nCache && cache[icache]!=cut) icache++;
+	if (icache<nCache) {
+	  passed = cacheDecision[icache];
+	  continue;
+	}
+
+	Bool_t decision;
+	TClass *cutClass = cut->IsA();
+	if (track && !cut->IsQAOn() && cutClass==AliCFTrackKineCuts::Class())
+	  decision = static_cast<AliCFTrackKineCuts*>(cut)->IsSelectedParticle(track);
+	else if (esdTrack && !cut->IsQAOn() && cutClass==AliCFTrackQualityCuts::Class())
+	  decision = static_cast<AliCFTrackQualityCuts*>(cut)->IsSelectedESD(esdTrack);
+	else if (aodTrack && !cut->IsQAOn() && cutClass==AliCFTrackQualityCuts::Class())
+	  decision = static_cast<AliCFTrackQualityCuts*>(cut)->IsSelectedAOD(aodTrack);
+	else
+	  decision = cut->IsSelected(obj);
+
+	// cuts filling QA histograms are re-evaluated, as with CheckParticleCuts
+	if (!cut->IsQAOn() && nCache<kMaxCache) {
+	  cache[nCache] = cut;
+	  cacheDecision[nCache++] = decision;
+	}
+	passed = decision;
+      }
+      if (!passed) break;
+    }
+    mask |= (1u << istep);
+  }
+  return mask;
+}
+
+//_____________________________________________________________________________
+UInt_t AliCFManager::FillParticleContainer(TObject *obj, const Double_t *var, Double_t weight, Int_t firstStep, Int_t lastStep, const TString &selcuts) const {
+  //
+  // fills the particle container at the steps firstStep..lastStep passed by obj,
+  // see CheckParticleSteps. Returns the mask of the passed steps
+  //
+
+  if (!fPartContainer) {
+    AliWarning("No particle container defined");
+    return 0;
+  }
+  UInt_t mask = CheckParticleSteps(obj,firstStep,lastStep,selcuts);
+  for (Int_t istep=firstStep; istep<fNStepPart && istep<32 && (mask>>istep); istep++) {
+    if (mask & (1u << istep)) fPartContainer->Fill(var,istep,weight);
+  }
+  return mask;
+}
+
 //_____________________________________________________________________________
 Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &selcuts) const{
   //
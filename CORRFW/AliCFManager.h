@@ -116,6 +116,14 @@ class AliCFManager : public TNamed
   virtual Bool_t CheckEventCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
   virtual Bool_t CheckParticleCuts(Int_t isel, TObject *obj, const TString &selcuts="all") const;
 
+  //Cumulative particle-level step evaluation: the steps firstStep..lastStep
+  //(lastStep<0 : up to the last step) are checked in sequence, each cut once
+  //per particle, until the first failing step. Bit istep of the returned mask
+  //is set if obj passes the steps firstStep..istep.
+  //FillParticleContainer also fills the particle container at these steps.
+  virtual UInt_t CheckParticleSteps(TObject *obj, Int_t firstStep=0, Int_t lastStep=-1, const TString &selcuts="all") const;
+  virtual UInt_t FillParticleContainer(TObject *obj, const Double_t *var, Double_t weight=1., Int_t firstStep=0, Int_t lastStep=-1, const TString &selcuts="all") const;
+
  private:
   
   //number of steps
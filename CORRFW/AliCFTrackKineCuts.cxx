@@ -431,6 +431,36 @@ Bool_t AliCFTrackKineCuts::IsSelected(TObject* obj) {
   return kTRUE;
 }
 //__________________________________________________________________________________
+Bool_t AliCFTrackKineCuts::IsSelectedParticle(const AliVParticle* particle) const {
+  //
+  // same decision as IsSelected, returns at the first failed cut
+  // meant for the cumulative step evaluation of AliCFManager, QA histograms are not filled
+  //
+  if (!particle) return kFALSE;
+
+  Double_t p = particle->P();
+  if (!(p >= fMomentumMin && p <= fMomentumMax)) return kFALSE;
+  Double_t pt = particle->Pt();
+  if (!(pt >= fPtMin && pt <= fPtMax)) return kFALSE;
+  Double_t px = particle->Px();
+  if (!(px >= fPxMin && px <= fPxMax)) return kFALSE;
+  Double_t py = particle->Py();
+  if (!(py >= fPyMin && py <= fPyMax)) return kFALSE;
+  Double_t pz = particle->Pz();
+  if (!(pz >= fPzMin && pz <= fPzMax)) return kFALSE;
+  Double_t eta = particle->Eta();
+  if (!(eta >= fEtaMin && eta <= fEtaMax)) return kFALSE;
+  Double_t y = particle->Y();
+  if (!(y >= fRapidityMin && y <= fRapidityMax)) return kFALSE;
+  Double_t phi = particle->Phi();
+  if (!(phi >= fPhiMin && phi <= fPhiMax)) return kFALSE;
+  Short_t charge = particle->Charge();
+  if (!(fCharge >= 10 || charge == fCharge)) return kFALSE;
+  if (fRequireIsCharged && charge == 0) return kFALSE;
+
+  return kTRUE;
+}
+//__________________________________________________________________________________
 void AliCFTrackKineCuts::SetHistogramBins(Int_t index, Int_t nbins, Double_t *bins)
 {
   //
@@ -65,6 +65,8 @@ class AliCFTrackKineCuts : public AliCFCutBase
 
   Bool_t IsSelected(TObject* obj);
   Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
+  // same decision as IsSelected, without bitmap and QA histograms
+  Bool_t IsSelectedParticle(const AliVParticle* particle) const;
 
   // cut value setter
   void SetMomentumRange(Double_t momentumMin=0., Double_t momentumMax=1e99) {fMomentumMin=momentumMin; fMomentumMax=momentumMax;}
@@ -584,6 +584,65 @@ Bool_t AliCFTrackQualityCuts::IsSelected(TObject* obj) {
   return kTRUE;
 }
 //__________________________________________________________________________________
+Bool_t AliCFTrackQualityCuts::IsSelectedESD(const AliESDtrack* esdTrack) const {
+  //
+  // same decision as IsSelected for an AliESDtrack, returns at the first failed cut
+  // meant for the cumulative step evaluation of AliCFManager, QA histograms are not filled
+  //
+  if (!esdTrack) return kFALSE;
+
+  Int_t nClustersTPC = esdTrack->GetTPCclusters(0x0);
+  if (nClustersTPC < fMinNClusterTPC) return kFALSE;
+  Int_t nClustersITS = esdTrack->GetITSclusters(0x0);
+  if (nClustersITS < fMinNClusterITS) return kFALSE;
+  if (esdTrack->GetTRDncls() < fMinNClusterTRD) return kFALSE;
+  if (fMinFoundClusterTPC > 0) {
+    Float_t fractionFoundClustersTPC = 0;
+    if (esdTrack->GetTPCNclsF() != 0) fractionFoundClustersTPC = float(nClustersTPC) / float(esdTrack->GetTPCNclsF());
+    if (!(nClustersTPC > 0 && fractionFoundClustersTPC >= fMinFoundClusterTPC)) return kFALSE;
+  }
+  Int_t nTrackletsTRD = esdTrack->GetTRDntracklets();
+  if (nTrackletsTRD < fMinNTrackletTRD) return kFALSE;
+  if (esdTrack->GetTRDntrackletsPID() < fMinNTrackletTRDpid) return kFALSE;
+
+  Float_t chi2PerClusterTPC = 0;
+  Float_t chi2PerClusterITS = 0;
+  Float_t chi2PerTrackletTRD = 0;
+  if (nClustersTPC != 0) chi2PerClusterTPC = esdTrack->GetTPCchi2() / Float_t(nClustersTPC);
+  if (nClustersITS != 0) chi2PerClusterITS = esdTrack->GetITSchi2() / Float_t(nClustersITS);
+  if (nTrackletsTRD != 0) chi2PerTrackletTRD = esdTrack->GetTRDchi2() / Float_t(nTrackletsTRD);
+  if (chi2PerClusterTPC > fMaxChi2PerClusterTPC) return kFALSE;
+  if (chi2PerClusterITS > fMaxChi2PerClusterITS) return kFALSE;
+  if (chi2PerTrackletTRD > fMaxChi2PerTrackletTRD) return kFALSE;
+  if (esdTrack->GetTPCsignalN() < fMinNdEdxClusterTPC) return kFALSE;
+
+  Double_t extCov[15];
+  esdTrack->GetExternalCovariance(extCov);
+  if (extCov[0]  > fCovariance11Max) return kFALSE;
+  if (extCov[2]  > fCovariance22Max) return kFALSE;
+  if (extCov[5]  > fCovariance33Max) return kFALSE;
+  if (extCov[9]  > fCovariance44Max) return kFALSE;
+  if (extCov[14] > fCovariance55Max) return kFALSE;
+
+  return (esdTrack->GetStatus() & fStatus) == fStatus;
+}
+//__________________________________________________________________________________
+Bool_t AliCFTrackQualityCuts::IsSelectedAOD(const AliAODTrack* aodTrack) const {
+  //
+  // same decision as IsSelected for an AliAODTrack: only the status is available,
+  // the other cut quantities are 0 as in SelectionBitMap
+  //
+  if (!aodTrack) return kFALSE;
+
+  if (0 < fMinNClusterTPC || 0 < fMinNClusterITS || 0 < fMinNClusterTRD) return kFALSE;
+  if (fMinFoundClusterTPC > 0) return kFALSE;
+  if (0 < fMinNTrackletTRD) return kFALSE;
+  if (0 > fMaxChi2PerClusterTPC || 0 > fMaxChi2PerClusterITS || 0 > fMaxChi2PerTrackletTRD) return kFALSE;
+  if (0 > fCovariance11Max || 0 > fCovariance22Max || 0 > fCovariance33Max || 0 > fCovariance44Max || 0 > fCovariance55Max) return kFALSE;
+
+  return (aodTrack->GetStatus() & fStatus) == fStatus;
+}
+//__________________________________________________________________________________
 void AliCFTrackQualityCuts::SetHistogramBins(Int_t index, Int_t nbins, Double_t *bins)
 {
   //
@@ -53,6 +53,7 @@ class TH2F;
 class TH1F;
 class TBits;
 class AliESDtrack;
+class AliAODTrack;
 class AliESDtrackCuts;
 
 class AliCFTrackQualityCuts : public AliCFCutBase
@@ -67,6 +68,9 @@ class AliCFTrackQualityCuts : public AliCFCutBase
 
   Bool_t IsSelected(TObject* obj);
   Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
+  // same decision as IsSelected, without bitmap and QA histograms
+  Bool_t IsSelectedESD(const AliESDtrack* track) const;
+  Bool_t IsSelectedAOD(const AliAODTrack* track) const;
 
   // cut value setter
   void SetMinNClusterTPC(Int_t cluster=-1)		{fMinNClusterTPC = cluster;}
@@ -130,7 +130,15 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseDenseBackend(kFALSE),
+  fNToysPerBatch(16),
+  fNDenseM(0),
+  fNDenseT(0),
+  fCellM(),
+  fCellT(),
+  fCellBin(),
+  fCellCond()
 {
   //
   // default constructor
@@ -174,7 +182,15 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseDenseBackend(kFALSE),
+  fNToysPerBatch(16),
+  fNDenseM(0),
+  fNDenseT(0),
+  fCellM(),
+  fCellT(),
+  fCellBin(),
+  fCellCond()
 {
   //
   // named constructor
@@ -353,6 +369,12 @@ void AliCFUnfolding::Unfold() {
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
+  if (fUseDenseBackend && fNDenseT==0) InitDense();
+
+  if (fUseDenseBackend) {
+    if (!UnfoldDense(iIterBayes,convergence)) return;
+  }
+  else
   for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
 
     CreateEstMeasured(); // create measured estimate from prior
@@ -456,6 +478,11 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
   // Step 5: The spread of fDeltaUnfoldedP for each bin is the error on the unfolded spectrum of that specific bin
 
 
+  if (fUseDenseBackend && !fUseSmoothing) {
+    CalculateCorrelatedErrorsDense();
+    return;
+  }
+
   //Do fNRandomIterations = bayes iterations performed
   for (int i=0; i<fNRandomIterations; i++) {
     
@@ -483,8 +510,19 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     FillDeltaUnfoldedProfile();
   }
 
+  SetUnfoldedErrors();
+
+  // now errors are calculated
+  fNCalcCorrErrors = 2;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SetUnfoldedErrors() {
+  //
   // Get statistical errors for final unfolded spectrum
   // ie. spread of each pt bin in fDeltaUnfoldedP
+  //
   Double_t meanx2 = 0.;
   Double_t mean = 0.;
   Double_t checksigma = 0.;
@@ -499,9 +537,6 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     //AliDebug(2,Form("filling error %e\n",sigma));
     fUnfoldedFinal->SetBinError(fCoordinatesN_M,checksigma);
   }
-
-  // now errors are calculated
-  fNCalcCorrErrors = 2;
 }
 
 //______________________________________________________________
@@ -862,3 +897,295 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+Long64_t AliCFUnfolding::DenseSize(const THnSparse* h) {
+  //
+  // number of cells of h, including under/overflows
+  //
+  Long64_t size = 1;
+  for (Int_t iDim=0; iDim<h->GetNdimensions(); iDim++) size *= h->GetAxis(iDim)->GetNbins()+2;
+  return size;
+}
+
+//______________________________________________________________
+
+Long64_t AliCFUnfolding::DenseIndex(const THnSparse* h, const Int_t* coord) {
+  //
+  // linear index of the cell with coordinates coord
+  //
+  Long64_t index = 0;
+  for (Int_t iDim=h->GetNdimensions()-1; iDim>=0; iDim--) index = index*(h->GetAxis(iDim)->GetNbins()+2) + coord[iDim];
+  return index;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::DenseCoordinates(const THnSparse* h, Long64_t index, Int_t* coord) {
+  //
+  // coordinates of the cell with linear index "index"
+  //
+  for (Int_t iDim=0; iDim<h->GetNdimensions(); iDim++) {
+    Int_t n = h->GetAxis(iDim)->GetNbins()+2;
+    coord[iDim] = index % n;
+    index /= n;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::ToDense(const THnSparse* h, std::vector<Double_t> &values, std::vector<Char_t> *mask) {
+  //
+  // copies the content of h to the dense vector "values"
+  // mask (if given) flags the cells existing in h
+  //
+  Long64_t size = DenseSize(h);
+  values.assign(size,0.);
+  if (mask) mask->assign(size,0);
+  Int_t* coord = new Int_t[h->GetNdimensions()];
+  for (Long_t iBin=0; iBin<h->GetNbins(); iBin++) {
+    Double_t value = h->GetBinContent(iBin,coord);
+    Long64_t index = DenseIndex(h,coord);
+    values[index] = value;
+    if (mask) (*mask)[index] = 1;
+  }
+  delete [] coord;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FromDense(THnSparse* h, const std::vector<Double_t> &values, const std::vector<Char_t> *mask) {
+  //
+  // resets h and fills it with the dense vector "values", errors set to 0
+  // only the cells flagged in mask (if given) or with a positive content are filled
+  //
+  h->Reset();
+  Int_t* coord = new Int_t[h->GetNdimensions()];
+  for (Long64_t index=0; index<(Long64_t)values.size(); index++) {
+    if (mask ? !(*mask)[index] : !(values[index]>0.)) continue;
+    DenseCoordinates(h,index,coord);
+    h->SetBinError  (coord,0.);
+    h->SetBinContent(coord,values[index]);
+  }
+  delete [] coord;
+}
+
+//______________________________________________________________
+
+Bool_t AliCFUnfolding::InitDense() {
+  //
+  // Initialisation of the dense backend : the conditional matrix becomes a list of cells
+  // (measured cell, true cell, P(M|T)) and the spectra are handled as dense vectors.
+  // Falls back to the THnSparse implementation if the spectra do not fit in memory
+  //
+  const Long64_t kMaxDenseCells = 10000000;
+
+  fNDenseM = DenseSize(fMeasured);
+  fNDenseT = DenseSize(fPrior);
+  if (fNDenseM > kMaxDenseCells || fNDenseT > kMaxDenseCells) {
+    AliWarning(Form("Spectra too large for the dense backend (%lld measured and %lld true cells), using THnSparse",fNDenseM,fNDenseT));
+    fUseDenseBackend = kFALSE;
+    fNDenseM = fNDenseT = 0;
+    return kFALSE;
+  }
+
+  Long_t nCells = fConditional->GetNbins();
+  fCellM   .resize(nCells);
+  fCellT   .resize(nCells);
+  fCellBin .resize(nCells);
+  fCellCond.resize(nCells);
+  for (Long_t iBin=0; iBin<nCells; iBin++) {
+    fCellCond[iBin] = fConditional->GetBinContent(iBin,fCoordinates2N);
+    GetCoordinates();
+    fCellM  [iBin] = DenseIndex(fMeasured,fCoordinatesN_M);
+    fCellT  [iBin] = DenseIndex(fPrior,fCoordinatesN_T);
+    fCellBin[iBin] = iBin;
+  }
+  AliInfo(Form("Dense backend : %ld response cells, %lld measured and %lld true cells",nCells,fNDenseM,fNDenseT));
+  return kTRUE;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::IterateDense(Int_t nToys, const std::vector<Double_t> &prior, const std::vector<Double_t> &eff, const std::vector<Double_t> &meas,
+				  std::vector<Double_t> &est, std::vector<Double_t> &unf, std::vector<Char_t> &unfMask, std::vector<Double_t> *inv) const {
+  //
+  // One bayes iteration of the dense backend, same steps as
+  // CreateEstMeasured(), CreateInvResponse() and CreateUnfolded().
+  // The nToys spectra are stored interleaved (cell*nToys+toy), so that
+  // each response cell is read once for all of them.
+  // inv (if given) receives the inverse response of each cell (nToys=1)
+  //
+  const Long64_t nCells = fCellCond.size();
+  std::vector<Double_t> priorTimesEff(prior.size());
+  for (Long64_t i=0; i<(Long64_t)prior.size(); i++) priorTimesEff[i] = prior[i]*eff[i];
+
+  est.assign(fNDenseM*nToys,0.);
+  for (Long64_t iCell=0; iCell<nCells; iCell++) {
+    const Double_t cond = fCellCond[iCell];
+    const Double_t *pe  = &priorTimesEff[fCellT[iCell]*nToys];
+    Double_t       *m   = &est[fCellM[iCell]*nToys];
+    for (Int_t k=0; k<nToys; k++) {
+      Double_t fill = cond * pe[k];
+      if (fill>0.) m[k] += fill;
+    }
+  }
+
+  unf.assign(fNDenseT*nToys,0.);
+  unfMask.assign(fNDenseT*nToys,0);
+  for (Long64_t iCell=0; iCell<nCells; iCell++) {
+    const Double_t cond = fCellCond[iCell];
+    const Long64_t t    = fCellT[iCell]*nToys;
+    const Long64_t m    = fCellM[iCell]*nToys;
+    for (Int_t k=0; k<nToys; k++) {
+      Double_t estMeasuredValue = est[m+k];
+      Double_t invResponseValue = (estMeasuredValue>0. ? cond * priorTimesEff[t+k] / estMeasuredValue : 0.);
+      if (inv) (*inv)[iCell*nToys+k] = invResponseValue;
+      Double_t effValue = eff[t+k];
+      Double_t fill = (effValue>0. ? invResponseValue * meas[m+k] / effValue : 0.);
+      if (fill>0.) {
+	unf[t+k] += fill;
+	unfMask[t+k] = 1;
+      }
+    }
+  }
+}
+
+//______________________________________________________________
+
+Bool_t AliCFUnfolding::UnfoldDense(Int_t &iIterBayes, Double_t &convergence) {
+  //
+  // Bayes iterations of Unfold() with the dense backend
+  // the THnSparse outputs (unfolded, prior, measured estimate, inverse response) are updated at the end
+  // returns kFALSE if the smoothing failed
+  //
+  std::vector<Double_t> prior, eff, meas, est, unf, inv(fCellCond.size());
+  std::vector<Char_t>   priorMask, unfMask;
+  ToDense(fPrior,prior,&priorMask);
+  ToDense(fEfficiency,eff,0);
+  ToDense(fMeasured,meas,0);
+
+  Bool_t smoothOK = kTRUE;
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    IterateDense(1,prior,eff,meas,est,unf,unfMask,&inv);
+
+    convergence = 0.;
+    for (Long64_t t=0; t<fNDenseT; t++) {
+      if (!priorMask[t]) continue;
+      if (prior[t] > 0.)
+	convergence += ((prior[t]-unf[t])/prior[t])*((prior[t]-unf[t])/prior[t]);
+      else 
+	AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",prior[t])); 
+    }
+    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (fMaxConvergence>0. && convergence<fMaxConvergence && fNCalcCorrErrors == 0) {
+      fNRandomIterations = iIterBayes;
+      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+
+    if (fUseSmoothing) {
+      FromDense(fUnfolded,unf,&unfMask);
+      if (Smooth()) {
+	AliError("Couldn't smooth the unfolded spectrum!!");
+	if (fNCalcCorrErrors>0) {
+	  AliInfo(Form("=======================\nUnfold of randomized distribution finished at iteration %d with convergence %e \n",iIterBayes,convergence));
+	}
+	else {
+	  AliInfo(Form("\n\n=======================\nFinish at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+	}
+	smoothOK = kFALSE;
+	break;
+      }
+      ToDense(fUnfolded,unf,&unfMask);
+    }
+
+    // update the prior distribution
+    prior     = unf;
+    priorMask = unfMask;
+
+  } // end bayes iteration
+
+  // THnSparse outputs
+  if (smoothOK) FromDense(fUnfolded,unf,&unfMask);
+  FromDense(fPrior,prior,&priorMask);
+  FromDense(fMeasuredEstimate,est,0);
+  for (Long64_t iCell=0; iCell<(Long64_t)fCellCond.size(); iCell++) {
+    fConditional->GetBinContent(fCellBin[iCell],fCoordinates2N);
+    if (inv[iCell]>0. || fInverseResponse->GetBinContent(fCoordinates2N)>0.) {
+      fInverseResponse->SetBinContent(fCoordinates2N,inv[iCell]);
+      fInverseResponse->SetBinError  (fCoordinates2N,0.);
+    }
+  }
+  return smoothOK;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CalculateCorrelatedErrorsDense() {
+  //
+  // Same as CalculateCorrelatedErrors() with the dense backend :
+  // the randomized spectra (same random sequence as CreateRandomizedDist()) are
+  // unfolded by batches of fNToysPerBatch, fMaxNumIterations iterations each
+  // (as for the randomized spectra in Unfold()), and the spread of the
+  // difference to the final unfolded spectrum gives its errors.
+  // The internal spectra (prior, unfolded...) are left as after the main unfolding.
+  //
+  std::vector<Double_t> priorOrig, final, tmp;
+  std::vector<Char_t>   finalMask;
+  ToDense(fPriorOrig,priorOrig,0);
+  ToDense(fUnfoldedFinal,final,&finalMask);
+
+  std::vector<Double_t> sum(fNDenseT,0.), sum2(fNDenseT,0.);
+  std::vector<Int_t>    entries(fNDenseT,0);
+
+  for (Int_t first=0; first<fNRandomIterations; first+=fNToysPerBatch) {
+    Int_t nToys = TMath::Min(fNToysPerBatch,fNRandomIterations-first);
+    std::vector<Double_t> prior(fNDenseT*nToys), eff(fNDenseT*nToys), meas(fNDenseM*nToys), est, unf;
+    std::vector<Char_t>   unfMask;
+
+    for (Int_t k=0; k<nToys; k++) {
+      CreateRandomizedDist();
+      ToDense(fRandomEfficiency,tmp,0);
+      for (Long64_t t=0; t<fNDenseT; t++) eff[t*nToys+k] = tmp[t];
+      ToDense(fRandomMeasured,tmp,0);
+      for (Long64_t m=0; m<fNDenseM; m++) meas[m*nToys+k] = tmp[m];
+      for (Long64_t t=0; t<fNDenseT; t++) prior[t*nToys+k] = priorOrig[t];
+    }
+
+    for (Int_t iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) {
+      IterateDense(nToys,prior,eff,meas,est,unf,unfMask,0);
+      prior.swap(unf); // update the prior distribution
+    }
+
+    for (Long64_t t=0; t<fNDenseT; t++) {
+      if (!finalMask[t]) continue;
+      for (Int_t k=0; k<nToys; k++) {
+	Double_t deltaInBin = final[t] - prior[t*nToys+k];
+	sum [t] += deltaInBin;
+	sum2[t] += deltaInBin*deltaInBin;
+	entries[t]++;
+      }
+    }
+    AliInfo(Form("=======================\nUnfolding of %d randomized distributions finished\n",first+nToys));
+  }
+
+  // fill the delta profile as FillDeltaUnfoldedProfile()
+  Int_t* coord = new Int_t[fNVariables];
+  for (Long64_t t=0; t<fNDenseT; t++) {
+    if (!finalMask[t] || entries[t]==0) continue;
+    DenseCoordinates(fDeltaUnfoldedP,t,coord);
+    fDeltaUnfoldedP->SetBinError  (coord,sum2[t]/entries[t]);
+    fDeltaUnfoldedP->SetBinContent(coord,sum [t]/entries[t]);
+    fDeltaUnfoldedN->SetBinContent(coord,entries[t]);
+  }
+  delete [] coord;
+
+  SetUnfoldedErrors();
+
+  // now errors are calculated
+  fNCalcCorrErrors = 2;
+}
@@ -13,6 +13,7 @@
 #include "TNamed.h"
 #include "THnSparse.h"
 #include "AliLog.h"
+#include <vector>
 
 class TF1;
 class TRandom3;
@@ -43,6 +44,11 @@ class AliCFUnfolding : public TNamed {
     fSmoothOption=opt;
   } 
                                                                                                 
+  void UseDenseBackend(Bool_t dense=kTRUE, Int_t nToysPerBatch=16) { // iterations on dense spectra and on the list of response cells
+    fUseDenseBackend=dense;                                           // instead of THnSparse lookups, if the spectra fit in memory;
+    fNToysPerBatch=(nToysPerBatch>0?nToysPerBatch:1);                 // the randomized spectra of the error calculation are then
+  }                                                                   // unfolded together by batches of nToysPerBatch
+
   void Unfold();
 
   const THnSparse* GetResponse()             const {return fResponseOrig;}
@@ -112,6 +118,16 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* dense backend */
+  Bool_t         fUseDenseBackend;   // Use dense spectra and the list of response cells; default is kFALSE
+  Int_t          fNToysPerBatch;     // Number of randomized spectra unfolded together in the dense backend
+  Long64_t       fNDenseM;           //! Number of cells (with under/overflows) in measured space, 0 if dense backend not initialised
+  Long64_t       fNDenseT;           //! Number of cells (with under/overflows) in true space
+  std::vector<Long64_t> fCellM;      //! Measured cell of each bin of the conditional matrix
+  std::vector<Long64_t> fCellT;      //! True cell of each bin of the conditional matrix
+  std::vector<Long64_t> fCellBin;    //! Bin index in the conditional matrix
+  std::vector<Double_t> fCellCond;   //! Conditional probability P(M|T) of each bin
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -131,8 +147,22 @@ class AliCFUnfolding : public TNamed {
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
-
-  ClassDef(AliCFUnfolding,1);
+  void     SetUnfoldedErrors();         // Sets the errors of the final unfolded spectrum from the delta profile
+
+  /* dense backend */
+  Bool_t   InitDense();                 // builds the list of response cells, kFALSE if the spectra are too large
+  Bool_t   UnfoldDense(Int_t &iIterBayes, Double_t &convergence); // bayes iterations, kFALSE if smoothing failed
+  void     IterateDense(Int_t nToys, const std::vector<Double_t> &prior, const std::vector<Double_t> &eff, const std::vector<Double_t> &meas,
+			std::vector<Double_t> &est, std::vector<Double_t> &unf, std::vector<Char_t> &unfMask, std::vector<Double_t> *inv) const; // one iteration for nToys spectra
+  void     CalculateCorrelatedErrorsDense(); // Calculates correlated errors unfolding the randomized spectra by batches
+  static Long64_t DenseSize(const THnSparse* h);
+  static Long64_t DenseIndex(const THnSparse* h, const Int_t* coord);
+  static void     DenseCoordinates(const THnSparse* h, Long64_t index, Int_t* coord);
+  static void     ToDense(const THnSparse* h, std::vector<Double_t> &values, std::vector<Char_t> *mask);
+  static void     FromDense(THnSparse* h, const std::vector<Double_t> &values, const std::vector<Char_t> *mask);
+
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
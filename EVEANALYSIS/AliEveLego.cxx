@@ -47,10 +47,21 @@
 // 4) Possibility to use AliPhysicsSelection during the all events histograms creation.
 // It is also possible to switch between real data and simulation data (MC).
 //
+// The tracks are binned only once per event (once for all events) into layers,
+// one per track selection (all, primary) and particle type (charge, specie);
+// for all events also per collision candidate flag. Changing a filter only
+// re-combines the layers into the displayed histograms.
+//
 
 ClassImp(AliEveLego)
 Double_t kPi = TMath::Pi();
 
+namespace
+{
+  const Int_t kNTypes = 7;   // positive, negative, electrons, muons, pions, kaons, protons
+  const Int_t kNTrackSel = 2; // all tracks, primary tracks
+}
+
 //______________________________________________________________________________
 AliEveLego::AliEveLego(const char* name) :
   TEveElementList(name),
@@ -99,10 +110,13 @@ AliEveLego::AliEveLego(const char* name) :
   fAl(0),
   fHisto2dLegoOverlay(0),
   fHisto2dAllEventsLegoOverlay(0),
-  fHisto2dAllEventsSlot(0)
+  fHisto2dAllEventsSlot(0),
+  fLayers(),
+  fLayersAE()
 {
   // Constructor.
   gEve->AddToListTree(this,0);
+  fNEventsAE[0] = fNEventsAE[1] = 0;
 
   // Get Current ESD event
   fEsd = AliEveEventManager::AssertESD();
@@ -251,48 +265,62 @@ namespace
 }
 
 //______________________________________________________________________________
-TEveCaloDataHist* AliEveLego::LoadData()
+void AliEveLego::FillLayers(TArrayF &layers, Int_t sel, AliESDtrack *track)
 {
-   // Load data from ESD tree
-   fHistopos->Reset();
-   fHistoneg->Reset();
-   fHistoElectrons->Reset();
-   fHistoMuons->Reset();
-   fHistoPions->Reset();
-   fHistoKaons->Reset();
-   fHistoProtons->Reset();
+   // Add the track pT to the charge and specie layers of the track selection
+   const Int_t ncells = fHistopos->GetSize();
+   const Int_t cell = fHistopos->FindBin(track->Eta(), getphi(track->Phi()));
+   const Float_t pt = fabs(track->Pt());
+   const Double_t sign = track->GetSign();
+   Float_t *l = layers.GetArray() + sel*kNTypes*ncells;
 
-   // Getting current tracks, filling histograms
-   for (int n = 0; n < fEsd->GetNumberOfTracks(); ++n) {
+   if (sign > 0)
+     l[cell] += pt;
 
-     AliESDtrack *track = fEsd->GetTrack(n);
-     const Double_t sign = fEsd->GetTrack(n)->GetSign();
-     const Int_t prob = GetParticleType(track);     
+   if (sign < 0)
+     l[ncells + cell] += pt;
 
-     // Filling histograms
-     if (sign > 0)
-       fHistopos->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-     if (sign < 0)
-       fHistoneg->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-     if (prob == 0)
-       fHistoElectrons->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-     if (prob == 1)
-       fHistoMuons->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
+   l[(2 + GetParticleType(track))*ncells + cell] += pt;
+}
 
-     if (prob == 2)
-       fHistoPions->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
+//______________________________________________________________________________
+void AliEveLego::CombineLayers(const TArrayF &layers, Int_t nsel, const Int_t *sel,
+                               const Bool_t *typeId, Float_t maxPt, TH2F **histos)
+{
+   // Sum the selected layers into the histograms, clipping at maxPt
+   const Int_t ncells = fHistopos->GetSize();
+   for (Int_t type = 0; type < kNTypes; type++) {
+      TH2F *h = histos[type];
+      h->Reset();
+      if (typeId[type] == kFALSE) continue;
+
+      Float_t *dst = h->GetArray();
+      for (Int_t i = 0; i < nsel; i++) {
+         const Float_t *l = layers.GetArray() + (sel[i]*kNTypes + type)*ncells;
+         for (Int_t cell = 0; cell < ncells; cell++)
+           dst[cell] += l[cell];
+      }
+      for (Int_t cell = 0; cell < ncells; cell++)
+        if (dst[cell] >= maxPt) dst[cell] = maxPt;
+   }
+}
 
-     if (prob == 3)
-       fHistoKaons->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
+//______________________________________________________________________________
+TEveCaloDataHist* AliEveLego::LoadData()
+{
+   // Load data from ESD tree: bin the tracks of the current event into layers
+   const Int_t ncells = fHistopos->GetSize();
+   fLayers.Set(kNTrackSel*kNTypes*ncells);
+   fLayers.Reset();
 
-     if (prob == 4)
-       fHistoProtons->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-   }
+   // All tracks
+   for (int n = 0; n < fEsd->GetNumberOfTracks(); ++n)
+     FillLayers(fLayers, 0, fEsd->GetTrack(n));
 
-   fData->DataChanged();
+   // Primary tracks
+   const AliESDVertex *pv = fEsd->GetPrimaryVertex();
+   for (Int_t n = 0; n < pv->GetNIndices(); n++)
+     FillLayers(fLayers, 1, fEsd->GetTrack(pv->GetIndices()[n]));
 
    FilterData();
 
@@ -302,54 +330,28 @@ TEveCaloDataHist* AliEveLego::LoadData()
 //______________________________________________________________________________
 TEveCaloDataHist* AliEveLego::LoadAllData()
 {
-   // Load data from all events ESD
-   fHistoposAllEvents->Reset();
-   fHistonegAllEvents->Reset();
-   fHistoElectronsAllEvents->Reset();
-   fHistoMuonsAllEvents->Reset();
-   fHistoPionsAllEvents->Reset();
-   fHistoKaonsAllEvents->Reset();
-   fHistoProtonsAllEvents->Reset();
+   // Load data from all events ESD: bin the tracks of all events into layers,
+   // separately for collision candidates and other events
+   const Int_t ncells = fHistopos->GetSize();
+   fLayersAE.Set(2*kNTrackSel*kNTypes*ncells);
+   fLayersAE.Reset();
+   fNEventsAE[0] = fNEventsAE[1] = 0;
 
    TTree* t = AliEveEventManager::GetMaster()->GetESDTree();
 
-   // Getting current tracks for each event, filling histograms
-   Int_t fAcceptedEvents = 0;
+   // Getting current tracks for each event, filling layers
    for (int event = 0; event < t->GetEntries(); event++) {
       t->GetEntry(event);
 
-      if (fCollisionCandidatesOnly == kTRUE)
-        if (fPhysicsSelection->IsCollisionCandidate(fEsd) == kFALSE) continue;
-
-      fAcceptedEvents++;
-
-      for (int n = 0; n < fEsd->GetNumberOfTracks(); ++n) {
-
-           AliESDtrack *track = fEsd->GetTrack(n);
-           const Double_t sign = track->GetSign();
-           const Int_t prob = GetParticleType(track);
-
-           if (sign > 0)
-             fHistoposAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
+      const Int_t candidate = fPhysicsSelection->IsCollisionCandidate(fEsd) ? 1 : 0;
+      fNEventsAE[candidate]++;
 
-           if (sign < 0)
-             fHistonegAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
+      for (int n = 0; n < fEsd->GetNumberOfTracks(); ++n)
+        FillLayers(fLayersAE, candidate*kNTrackSel, fEsd->GetTrack(n));
 
-           if (prob == 0)
-             fHistoElectronsAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-           if (prob == 1)
-             fHistoMuonsAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-           if (prob == 2)
-             fHistoPionsAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-           if (prob == 3)
-             fHistoKaonsAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-
-           if (prob == 4)
-             fHistoProtonsAllEvents->Fill(track->Eta(), getphi(track->Phi()), fabs(track->Pt()));
-        }
+      const AliESDVertex *pv = fEsd->GetPrimaryVertex();
+      for (Int_t n = 0; n < pv->GetNIndices(); n++)
+        FillLayers(fLayersAE, candidate*kNTrackSel + 1, fEsd->GetTrack(pv->GetIndices()[n]));
    }
 
    // Setting the current view to the first event
@@ -357,97 +359,23 @@ TEveCaloDataHist* AliEveLego::LoadAllData()
 
    // Usefull information,
    // with this we can estimate the event efficiency
-   printf("Number of events loaded: %i, with AliPhysicsSelection: %i\n",fAcceptedEvents,fCollisionCandidatesOnly);
-
-   fDataAllEvents->DataChanged();
+   printf("Number of events loaded: %i, collision candidates: %i\n",
+          fNEventsAE[0] + fNEventsAE[1], fNEventsAE[1]);
 
-   return fDataAllEvents;
+   return FilterAllData();
 }
 
 //______________________________________________________________________________
 TEveCaloDataHist* AliEveLego::FilterData()
 {
-   // Tracks selection
-   if ( fTracksId == 2 )
-   {
-      fHistopos->Reset();
-      fHistoneg->Reset();
-      fHistoElectrons->Reset();
-      fHistoMuons->Reset();
-      fHistoPions->Reset();
-      fHistoKaons->Reset();
-      fHistoProtons->Reset();
-
-      const AliESDVertex *pv  = fEsd->GetPrimaryVertex();
-
-      for (Int_t n = 0; n < pv->GetNIndices(); n++ )
-      {
-         AliESDtrack *at = fEsd->GetTrack(pv->GetIndices()[n]);
-         const Double_t sign = at->GetSign();
-         const Int_t prob = GetParticleType(at);
-
-         if (sign > 0)
-           fHistopos->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-         if (sign < 0)
-           fHistoneg->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-         if (prob == 0)
-           fHistoElectrons->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-         if (prob == 1)
-           fHistoMuons->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-         if (prob == 2)
-           fHistoPions->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-         if (prob == 3)
-           fHistoKaons->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-         if (prob == 4)
-           fHistoProtons->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-      }
-   }
-
-   fData->DataChanged();
-
-   // Max Pt threshold
-   if (GetPtMax() >= fMaxPt){
-      for (Int_t binx = 1; binx <= 100; binx++) {
-         for (Int_t biny = 1; biny <= 80; biny++) {
-
-           if (fHistopos->GetBinContent(binx, biny) >= fMaxPt)
-             fHistopos->SetBinContent(binx, biny, fMaxPt);
+   // Tracks selection, max pT threshold and particle type filter
+   // applied to the layers of the current event
+   if (fLayers.GetSize() == 0) return LoadData();
 
-           if (fHistoneg->GetBinContent(binx, biny) >= fMaxPt)
-             fHistoneg->SetBinContent(binx, biny, fMaxPt);
-
-           if (fHistoElectrons->GetBinContent(binx, biny) >= fMaxPt)
-             fHistoElectrons->SetBinContent(binx, biny, fMaxPt);
-
-           if (fHistoMuons->GetBinContent(binx, biny) >= fMaxPt)
-             fHistoMuons->SetBinContent(binx, biny, fMaxPt);
-
-           if (fHistoPions->GetBinContent(binx, biny) >= fMaxPt)
-             fHistoPions->SetBinContent(binx, biny, fMaxPt);
-
-           if (fHistoKaons->GetBinContent(binx, biny) >= fMaxPt)
-             fHistoKaons->SetBinContent(binx, biny, fMaxPt);
-
-           if (fHistoProtons->GetBinContent(binx, biny) >= fMaxPt)
-             fHistoProtons->SetBinContent(binx, biny, fMaxPt);
-         }
-      }
-   }
-
-   // Particle type filter
-   if ( fParticleTypeId[0] == kFALSE) fHistopos->Reset();
-   if ( fParticleTypeId[1] == kFALSE) fHistoneg->Reset();
-   if ( fParticleTypeId[2] == kFALSE) fHistoElectrons->Reset();
-   if ( fParticleTypeId[3] == kFALSE) fHistoMuons->Reset();
-   if ( fParticleTypeId[4] == kFALSE) fHistoPions->Reset();
-   if ( fParticleTypeId[5] == kFALSE) fHistoKaons->Reset();
-   if ( fParticleTypeId[6] == kFALSE) fHistoProtons->Reset();
+   TH2F *histos[kNTypes] = { fHistopos, fHistoneg, fHistoElectrons, fHistoMuons,
+                             fHistoPions, fHistoKaons, fHistoProtons };
+   const Int_t sel = (fTracksId == 2) ? 1 : 0;
+   CombineLayers(fLayers, 1, &sel, fParticleTypeId, fMaxPt, histos);
 
    fData->DataChanged();
 
@@ -457,107 +385,16 @@ TEveCaloDataHist* AliEveLego::FilterData()
 //______________________________________________________________________________
 TEveCaloDataHist* AliEveLego::FilterAllData()
 {
-   // Tracks selection
-   if ( fTracksIdAE == 2 )
-   {
-      fHistoposAllEvents->Reset();
-      fHistonegAllEvents->Reset();
-      fHistoElectronsAllEvents->Reset();
-      fHistoMuonsAllEvents->Reset();
-      fHistoPionsAllEvents->Reset();
-      fHistoKaonsAllEvents->Reset();
-      fHistoProtonsAllEvents->Reset();
-
-      TTree* t = AliEveEventManager::GetMaster()->GetESDTree();
-
-      // Getting current tracks for each event, filling histograms
-      Int_t fAcceptedEvents = 0;
-      for (int event = 0; event < t->GetEntries(); event++) {
-
-        t->GetEntry(event);
-        const AliESDVertex *pv  = fEsd->GetPrimaryVertex();
-
-        if (fCollisionCandidatesOnly == kTRUE)
-          if (fPhysicsSelection->IsCollisionCandidate(fEsd) == kFALSE) continue;
-
-        fAcceptedEvents++;
-
-        for (Int_t n = 0; n < pv->GetNIndices(); n++ )
-        {
-          AliESDtrack *at = fEsd->GetTrack(pv->GetIndices()[n]);
-          const Double_t sign = at->GetSign();
-          const Int_t prob = GetParticleType(at);
-
-          if (sign > 0)
-            fHistoposAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-          if (sign < 0)
-            fHistonegAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-          if (prob == 0)
-            fHistoElectronsAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-          if (prob == 1)
-            fHistoMuonsAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-          if (prob == 2)
-            fHistoPionsAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-          if (prob == 3)
-            fHistoKaonsAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-
-          if (prob == 4)
-            fHistoProtonsAllEvents->Fill(at->Eta(), getphi(at->Phi()), fabs(at->Pt()));
-        }
-      }
-      t->GetEntry(0);
-      printf("Number of events loaded: %i, with AliPhysicsSelection: %i\n",fAcceptedEvents,fCollisionCandidatesOnly);
-
-   } else {
+   // Event class, tracks selection, max pT threshold and particle type
+   // filter applied to the layers of all events
+   if (fLayersAE.GetSize() == 0) return LoadAllData();
 
-      LoadAllData();
-
-    }
-   
-   fDataAllEvents->DataChanged();
-
-   // Max Pt threshold
-   if (GetPtMaxAE() >= fMaxPtAE){
-      for (Int_t binx = 1; binx <= 100; binx++) {
-         for (Int_t biny = 1; biny <= 80; biny++) {
-
-            if (fHistoposAllEvents->GetBinContent(binx, biny) >= fMaxPtAE)            
-              fHistoposAllEvents->SetBinContent(binx, biny, fMaxPtAE);
-
-            if (fHistonegAllEvents->GetBinContent(binx, biny) >= fMaxPtAE)            
-              fHistonegAllEvents->SetBinContent(binx, biny, fMaxPtAE);
-
-            if (fHistoElectronsAllEvents->GetBinContent(binx, biny) >= fMaxPt)
-              fHistoElectronsAllEvents->SetBinContent(binx, biny, fMaxPt);
-
-            if (fHistoMuonsAllEvents->GetBinContent(binx, biny) >= fMaxPt)
-              fHistoMuonsAllEvents->SetBinContent(binx, biny, fMaxPt);
-
-            if (fHistoPionsAllEvents->GetBinContent(binx, biny) >= fMaxPt)
-              fHistoPionsAllEvents->SetBinContent(binx, biny, fMaxPt);
-
-            if (fHistoKaonsAllEvents->GetBinContent(binx, biny) >= fMaxPt)
-              fHistoKaonsAllEvents->SetBinContent(binx, biny, fMaxPt);
-
-            if (fHistoProtonsAllEvents->GetBinContent(binx, biny) >= fMaxPt)
-              fHistoProtonsAllEvents->SetBinContent(binx, biny, fMaxPt);
-         }
-      }
-   }
-
-   // Particles species and charges filter
-   if ( fParticleTypeIdAE[0] == kFALSE ) fHistoposAllEvents->Reset();
-   if ( fParticleTypeIdAE[1] == kFALSE ) fHistonegAllEvents->Reset();
-   if ( fParticleTypeIdAE[2] == kFALSE ) fHistoElectronsAllEvents->Reset();
-   if ( fParticleTypeIdAE[3] == kFALSE ) fHistoMuonsAllEvents->Reset();
-   if ( fParticleTypeIdAE[4] == kFALSE ) fHistoPionsAllEvents->Reset();
-   if ( fParticleTypeIdAE[5] == kFALSE ) fHistoKaonsAllEvents->Reset();
-   if ( fParticleTypeIdAE[6] == kFALSE ) fHistoProtonsAllEvents->Reset();
+   TH2F *histos[kNTypes] = { fHistoposAllEvents, fHistonegAllEvents, fHistoElectronsAllEvents,
+                             fHistoMuonsAllEvents, fHistoPionsAllEvents, fHistoKaonsAllEvents,
+                             fHistoProtonsAllEvents };
+   const Int_t track = (fTracksIdAE == 2) ? 1 : 0;
+   const Int_t sel[2] = { kNTrackSel + track, track }; // candidates first
+   CombineLayers(fLayersAE, fCollisionCandidatesOnly ? 1 : 2, sel, fParticleTypeIdAE, fMaxPtAE, histos);
 
    fDataAllEvents->DataChanged();
 
@@ -883,7 +720,18 @@ void AliEveLego::SetParticleType(Int_t id, Bool_t status)
   // Activate/deactivate particles types
   fParticleTypeId[id] = status;
 
-  Update();
+  FilterData();
+  gEve->Redraw3D(kTRUE);
+}
+
+//______________________________________________________________________________
+void AliEveLego::SetTracks(Int_t id)
+{
+  // Tracks selection
+  fTracksId = id;
+
+  FilterData();
+  gEve->Redraw3D(kTRUE);
 }
 
 //______________________________________________________________________________
@@ -897,8 +745,9 @@ void AliEveLego::SetParticleTypeAE(Int_t id, Bool_t status)
 void AliEveLego::SetMaxPt(Double_t val)
 {
    // Add new maximum
-   fMaxPt = val;   
-   Update();
+   fMaxPt = val;
+   FilterData();
+   gEve->Redraw3D(kTRUE);
 }
 
 //______________________________________________________________________________
@@ -955,6 +804,9 @@ void AliEveLego::SwitchDataType(Bool_t status)
   fPhysicsSelection = new AliPhysicsSelection();
   fPhysicsSelection->SetAnalyzeMC(fIsMC);
   fPhysicsSelection->Initialize(fEsd);
+
+  // The collision candidate flags changed, rebin all events
+  fLayersAE.Set(0);
   FilterAllData();
 }
 
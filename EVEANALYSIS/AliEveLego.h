@@ -11,6 +11,7 @@
 #define ALIEVELEGO_H
 
 #include "TEveElement.h"
+#include "TArrayF.h"
 
 class AliESDEvent;
 class AliEveEventSelector;
@@ -60,7 +61,7 @@ public:
   void SetParticleTypeAE(Int_t id, Bool_t status);
   void SetThreshold(Double_t val);
   void SetThresholdAE(Double_t val);
-  void SetTracks(Int_t id)   {  fTracksId = id;    Update();         }
+  void SetTracks(Int_t id);
   void SetTracksAE(Int_t id) {  fTracksIdAE = id;  FilterAllData();  }
 
   // Functions
@@ -81,6 +82,10 @@ public:
 
 
 private:
+  void                FillLayers(TArrayF &layers, Int_t sel, AliESDtrack *track);
+  void                CombineLayers(const TArrayF &layers, Int_t nsel, const Int_t *sel,
+                                    const Bool_t *typeId, Float_t maxPt, TH2F **histos);
+
   Bool_t              fIsMC;                    // Switch to MC mode for AliPhysicsSelection
   Bool_t              fCollisionCandidatesOnly; // Activate flag when loading all events
   Bool_t              *fParticleTypeId;         // Determine how particles to show
@@ -127,6 +132,9 @@ private:
   TEveCaloLegoOverlay *fHisto2dLegoOverlay;     // Overlay for calo lego
   TEveCaloLegoOverlay *fHisto2dAllEventsLegoOverlay; // Overlay for calo lego all events
   TEveWindowSlot      *fHisto2dAllEventsSlot;   // Window slot for 2d all events histogram
+  TArrayF             fLayers;                  // Binned pT of the current event per track selection and type
+  TArrayF             fLayersAE;                // Binned pT of all events per event class, track selection and type
+  Int_t               fNEventsAE[2];            // Loaded events, not collision candidates / candidates
 
   AliEveLego(const AliEveLego&);                // Not implemented
   AliEveLego& operator=(const AliEveLego&);     // Not implemented
@@ -0,0 +1,152 @@
+//
+// Class AliMixEventCache
+//
+// AliMixEventCache keeps in memory the last N selected
+// events of every event pool bin, so that mixing does
+// not need to read the mixed events again from the chain.
+// By default the events are cloned. A reduced projection
+// of the event can be stored by overriding Project().
+//
+// author:
+//        Martin Vala (martin.vala@cern.ch)
+//
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+
+#include "AliMixEventCache.h"
+
+ClassImp(AliMixEventCache)
+
+//_________________________________________________________________________________________________
+AliMixEventCache::AliMixEventCache(Int_t depth) : TObject(),
+   fDepth(depth > 0 ? depth : 1),
+   fEvents(),
+   fEntries(),
+   fNext(),
+   fN()
+{
+   //
+   // Default constructor.
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 5, "->");
+}
+
+//_________________________________________________________________________________________________
+AliMixEventCache::~AliMixEventCache()
+{
+   //
+   // Destructor
+   //
+   Clear();
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventCache::Project(AliVEvent *ev) const
+{
+   //
+   // Returns object which is stored for event (full copy of event by default)
+   //
+   if (!ev) return 0;
+   return ev->Clone();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::SetDepth(Int_t depth)
+{
+   //
+   // Sets number of events per bin (clears cache)
+   //
+   if (depth < 1) depth = 1;
+   if (depth == fDepth) return;
+   Clear();
+   fDepth = depth;
+   AliDebug(AliLog::kDebug, Form("Depth set to %d", fDepth));
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventCache::Add(Int_t bin, Long64_t entry, AliVEvent *ev)
+{
+   //
+   // Adds event to bin (oldest event in bin is replaced when bin is full)
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   if (bin < 0 || entry < 0 || !ev) {
+      AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added to bin %d !!!", entry, bin));
+      return kFALSE;
+   }
+   if (bin >= (Int_t) fN.size()) {
+      fEvents.resize((bin + 1) * fDepth, 0);
+      fEntries.resize((bin + 1) * fDepth, -1);
+      fNext.resize(bin + 1, 0);
+      fN.resize(bin + 1, 0);
+   }
+
+   Int_t index = bin * fDepth + fNext[bin];
+   delete fEvents[index];
+   fEvents[index] = Project(ev);
+   fEntries[index] = entry;
+   fNext[bin] = (fNext[bin] + 1) % fDepth;
+   if (fN[bin] < fDepth) fN[bin]++;
+   AliDebug(AliLog::kDebug, Form("Entry %lld was added to bin %d (%d events)", entry, bin, fN[bin]));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCache::GetN(Int_t bin) const
+{
+   //
+   // Returns number of cached events in bin
+   //
+   if (bin < 0 || bin >= (Int_t) fN.size()) return 0;
+   return fN[bin];
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventCache::Slot(Int_t bin, Int_t i) const
+{
+   //
+   // Returns index of i-th event (0 is newest) in bin, -1 if not available
+   //
+   if (i < 0 || i >= GetN(bin)) return -1;
+   Int_t slot = fNext[bin] - 1 - i;
+   if (slot < 0) slot += fDepth;
+   return bin * fDepth + slot;
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventCache::GetEvent(Int_t bin, Int_t i) const
+{
+   //
+   // Returns i-th event (0 is newest) in bin
+   //
+   Int_t index = Slot(bin, i);
+   if (index < 0) return 0;
+   return fEvents[index];
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventCache::GetEntry(Int_t bin, Int_t i) const
+{
+   //
+   // Returns chain entry of i-th event (0 is newest) in bin
+   //
+   Int_t index = Slot(bin, i);
+   if (index < 0) return -1;
+   return fEntries[index];
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::Clear(Option_t *)
+{
+   //
+   // Deletes all cached events
+   //
+   for (UInt_t i = 0; i < fEvents.size(); i++) delete fEvents[i];
+   fEvents.clear();
+   fEntries.clear();
+   fNext.clear();
+   fN.clear();
+}
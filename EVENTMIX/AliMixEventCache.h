@@ -0,0 +1,56 @@
+//
+// Class AliMixEventCache
+//
+// AliMixEventCache keeps in memory the last N selected
+// events of every event pool bin, so that mixing does
+// not need to read the mixed events again from the chain.
+// By default the events are cloned. A reduced projection
+// of the event can be stored by overriding Project().
+//
+// author:
+//        Martin Vala (martin.vala@cern.ch)
+//
+
+#ifndef ALIMIXEVENTCACHE_H
+#define ALIMIXEVENTCACHE_H
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliVEvent;
+class AliMixEventCache : public TObject {
+public:
+   AliMixEventCache(Int_t depth = 10);
+   virtual ~AliMixEventCache();
+
+   // returns object to store for event (owned by cache)
+   virtual TObject *Project(AliVEvent *ev) const;
+
+   void        SetDepth(Int_t depth);
+   Int_t       GetDepth() const { return fDepth; }
+
+   Bool_t      Add(Int_t bin, Long64_t entry, AliVEvent *ev);
+   Int_t       GetN(Int_t bin) const;
+   TObject    *GetEvent(Int_t bin, Int_t i) const;
+   Long64_t    GetEntry(Int_t bin, Int_t i) const;
+
+   virtual void Clear(Option_t *option = "");
+
+private:
+
+   Int_t       Slot(Int_t bin, Int_t i) const;
+
+   Int_t                  fDepth;    // number of events kept per bin
+   std::vector<TObject *> fEvents;   //! cached events [bin*fDepth+slot]
+   std::vector<Long64_t>  fEntries;  //! chain entries of cached events [bin*fDepth+slot]
+   std::vector<Int_t>     fNext;     //! next slot to fill per bin
+   std::vector<Int_t>     fN;        //! number of cached events per bin
+
+   AliMixEventCache(const AliMixEventCache &obj);
+   AliMixEventCache &operator=(const AliMixEventCache &obj);
+
+   ClassDef(AliMixEventCache, 1)
+};
+
+#endif
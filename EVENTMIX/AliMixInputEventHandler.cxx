@@ -11,11 +11,13 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
+#include "AliMixEventCache.h"
 #include "AliMixEventPool.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
@@ -31,6 +33,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fMixIntupHandlerInfoTmp(0),
    fEntryCounter(0),
    fEventPool(0),
+   fEventCache(0),
    fNumberMixed(0),
    fMixNumber(mixNum),
    fUseDefautProcess(kFALSE),
@@ -43,6 +46,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
+   fCurrentMixCached(),
    fCurrentEntryMainTree(0)
 {
    //
@@ -97,6 +101,15 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
       AliWarning("fDoMixIfNotEnoughEvents=kFALSE -> setting fDoMixExtra=kFALSE");
    }
 
+   // cache has to keep all events needed for mixing + current event
+   if (fEventCache) {
+      Int_t depth = TMath::Max(2 * fMixNumber + 2, fBufferSize) + 1;
+      if (fEventCache->GetDepth() < depth) {
+         AliInfo(Form("Setting depth of event cache to %d", depth));
+         fEventCache->SetDepth(depth);
+      }
+   }
+
    // clears array of input handlers
    fMixTrees.Delete();
    // create AliMixInputHandlerInfo
@@ -229,6 +242,10 @@ Bool_t AliMixInputEventHandler::MixStd()
    // check for PhysSelection
    if (!IsEventCurrentSelected()) return kFALSE;
 
+   // fills cache (current event is newest one)
+   fCurrentMixCached.Clear();
+   if (fEventCache) fEventCache->Add(0, fEntryCounter, inEvHMain->GetEvent());
+
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -252,6 +269,17 @@ Bool_t AliMixInputEventHandler::MixStd()
       entryMix = fEntryCounter - 1 - counter ;
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
       if (entryMix < 0) break;
+      if (fEventCache) {
+         // mixed event from cache (index 0 is current event)
+         TObject *cached = fEventCache->GetEvent(0, counter + 1);
+         if (!cached) break;
+         entryMixReal = fEventCache->GetEntry(0, counter + 1);
+         fCurrentMixCached.Clear();
+         fCurrentMixCached.Add(cached);
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
+         continue;
+      }
       entryMixReal = entryMix;
       mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
@@ -307,6 +335,9 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    TEntryList *el = 0;
    Int_t idEntryList = -1;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   // fills cache (current event is newest one in its bin)
+   fCurrentMixCached.Clear();
+   if (fEventCache && el) fEventCache->Add(idEntryList - 1, currentMainEntry, inEvHMain->GetEvent());
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -347,6 +378,18 @@ Bool_t AliMixInputEventHandler::MixBuffer()
          UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
          break;
       }
+      if (fEventCache) {
+         // mixed event from cache (index 0 is current event)
+         TObject *cached = fEventCache->GetEvent(idEntryList - 1, counter + 1);
+         if (cached) {
+            entryMixReal = fEventCache->GetEntry(idEntryList - 1, counter + 1);
+            fCurrentMixEntry.Enter(entryMixReal);
+            fCurrentMixCached.AddAtAndExpand(cached, counter);
+            fNumberMixed++;
+         }
+         counter++;
+         continue;
+      }
       entryMixReal = entryMix;
       mihi = (AliMixInputHandlerInfo *) fMixTrees.At(counter);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
@@ -407,6 +450,9 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Int_t idEntryList = -1;
    TEntryList *el = 0;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   // fills cache (current event is newest one in its bin)
+   fCurrentMixCached.Clear();
+   if (fEventCache && el) fEventCache->Add(idEntryList - 1, currentMainEntry, inEvHMain->GetEvent());
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -462,6 +508,18 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
       Long64_t entryInEntryList =  elNum - 2 - counter;
       AliDebug(AliLog::kDebug + 3, Form("entryInEntryList=%lld", entryInEntryList));
       if (entryInEntryList < 0) break;
+      if (fEventCache) {
+         // mixed event from cache (index 0 is current event)
+         TObject *cached = fEventCache->GetEvent(idEntryList - 1, counter + 1);
+         if (!cached) break;
+         entryMixReal = fEventCache->GetEntry(idEntryList - 1, counter + 1);
+         fCurrentMixEntry.Enter(entryMixReal);
+         fCurrentMixCached.Clear();
+         fCurrentMixCached.Add(cached);
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
+         continue;
+      }
       entryMix = el->GetEntry(entryInEntryList);
       AliDebug(AliLog::kDebug + 3, Form("entryMix=%lld", entryMix));
       if (entryMix < 0) break;
@@ -605,6 +663,11 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
    // (Should be used in UserExecMix() only)
    //
 
+   if (fEventCache) {
+      AliError(Form("GetEntryMixedEvent(%d) => mixed events are cached, use GetMixedEventCached(%d)", id, id));
+      return kFALSE;
+   }
+
    AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(id);
 
    Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN()-id-1);
@@ -625,3 +688,18 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+TObject *AliMixInputEventHandler::GetMixedEventCached(Int_t id) const {
+   //
+   // Returns cached mixed event with id (event or projection stored by AliMixEventCache)
+   // (Should be used in UserExecMix() only)
+   //
+
+   if (!fEventCache) {
+      AliError("No event cache was set (SetEventCache())");
+      return 0;
+   }
+   if (id < 0 || id > fCurrentMixCached.GetLast()) return 0;
+   return fCurrentMixCached.UncheckedAt(id);
+}
@@ -21,6 +21,7 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventCache;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -43,7 +44,10 @@ public:
    void                    SetInputHandlerForMixing(const AliInputEventHandler *const inHandler);
    void                    SetEventPool(AliMixEventPool *const evPool) { fEventPool = evPool; }
 
+   void                    SetEventCache(AliMixEventCache *const evCache) { fEventCache = evCache; }
+
    AliMixEventPool        *GetEventPool() const { return fEventPool; }
+   AliMixEventCache       *GetEventCache() const { return fEventCache; }
    Int_t                   BufferSize() const { return fBufferSize; }
    Int_t                   NumberMixedTimes() const { return fNumberMixed; }
    Int_t                   MixNumber() const { return fMixNumber; }
@@ -73,6 +77,7 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+   TObject                *GetMixedEventCached(Int_t id=0) const;
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -80,6 +85,7 @@ protected:
    AliMixInputHandlerInfo *fMixIntupHandlerInfoTmp;//! mix input handler info full chain
    Long64_t                fEntryCounter;          // entry counter
    AliMixEventPool        *fEventPool;             // event pool
+   AliMixEventCache       *fEventCache;            // cache of mixed events in memory (no I/O for mixed events)
    Int_t                   fNumberMixed;           // number of mixed events with current event
    Int_t                   fMixNumber;             // user's mix number request
 
@@ -98,6 +104,7 @@ private:
    ULong64_t fOfflineTriggerMask;   //  Task processes collision candidates only
 
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
+   TObjArray  fCurrentMixCached;   //! cached mixed events currently used (not owner)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
    virtual Bool_t          MixStd();
@@ -110,7 +117,7 @@ private:
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -711,6 +711,9 @@ Int_t AliHLTJETReader::InitializeFFSC() {
 			  readerHeader->GetGridEtaBinning() );
     
     fGrid->SetConeRadius( readerHeader->GetConeRadius() );
+
+    // -- Track by track radius check : only search cells which can be in the cone
+    fGrid->SetUseRadiusStencil( readerHeader->GetJetAlgorithm() == AliHLTJETBase::kFFSCRadiusCell );
     
     iResult = fGrid->Initialize();
   }
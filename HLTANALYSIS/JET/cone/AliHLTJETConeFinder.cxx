@@ -53,7 +53,12 @@ AliHLTJETConeFinder::AliHLTJETConeFinder()
   AliJetFinder(),
   fReader(NULL),
   fGrid(NULL),
-  fJets(NULL) {
+  fJets(NULL),
+  fMaxProcessingTime(0.),
+  fTimer(),
+  fProcessingTime(0.),
+  fNCandidates(0),
+  fNProcessedCandidates(0) {
   // see header file for class documentation
   // or
   // refer to README to build package
@@ -134,6 +139,10 @@ void AliHLTJETConeFinder::Reset() {
   // -- Reset output container
   if (fJets)
     fJets->Reset();
+
+  fProcessingTime = 0.;
+  fNCandidates = 0;
+  fNProcessedCandidates = 0;
   
   return;
 }
@@ -150,6 +159,7 @@ Bool_t AliHLTJETConeFinder::ProcessEvent() {
 
   // -- Reset
   Reset();
+  fTimer.Start(kTRUE);
 
   // -- Pick up jet reader
   AliHLTJETReader *reader = dynamic_cast<AliHLTJETReader*> (fReader);
@@ -182,6 +192,8 @@ Bool_t AliHLTJETConeFinder::ProcessEvent() {
     return kFALSE;
   }
 
+  fProcessingTime = 1000. * fTimer.RealTime();
+
   return kTRUE;
 }
 
@@ -191,6 +203,7 @@ Bool_t AliHLTJETConeFinder::ProcessHLTEvent() {
 
   // -- Reset
   Reset();
+  fTimer.Start(kTRUE);
 
   // -- Find Leading
   if ( FindConeLeading()  ) {
@@ -210,6 +223,8 @@ Bool_t AliHLTJETConeFinder::ProcessHLTEvent() {
     return kFALSE;
   }
 
+  fProcessingTime = 1000. * fTimer.RealTime();
+
   return kTRUE;
 }
 
@@ -277,21 +292,52 @@ Int_t AliHLTJETConeFinder::FindConeJets() {
     return -EINPROGRESS;
   }
 
+  // -- Pick up jet header
+  AliHLTJETConeHeader* header = dynamic_cast<AliHLTJETConeHeader*> (fHeader);
+  if ( !header ) {
+    HLTError("Error getting header.");
+    return -EINPROGRESS;
+  }
+
   // -- Pick up jet canidates
   TClonesArray* jetCandidates = reader->GetJetCandidates();
 
+  fNCandidates = reader->GetNJetCandidates();
+
+  // -- Min Et of jets, candidates below can be skipped
+  Float_t minEt = header->GetJetCuts()->GetMinEt();
+
   // -- Loop over jet candidates
-  for ( Int_t iter = 0; iter < reader->GetNJetCandidates(); iter++ ) {
+  for ( Int_t iter = 0; iter < reader->GetNJetCandidates() && !iResult; iter++ ) {
     
+    // -- Bounded latency : stop if the time budget is used up
+    //    candidates are sorted, the ones with the lowest seed pt are dropped
+    if ( fMaxProcessingTime > 0. ) {
+      Double_t time = 1000. * fTimer.RealTime();
+      fTimer.Continue();
+
+      if ( time > fMaxProcessingTime ) {
+	HLTWarning("Time budget of %f ms exceeded, dropping %d of %d jet candidates", 
+		   fMaxProcessingTime, fNCandidates - iter, fNCandidates);
+	reader->SetNJetCandidates(iter);
+	break;
+      }
+    }
+
+    ++fNProcessedCandidates;
+
     AliHLTJETConeJetCandidate* jet = reinterpret_cast<AliHLTJETConeJetCandidate*> ((*jetCandidates)[iter]);
     
-    // -- Set iterator for cells around seed
-    fGrid->SetCellIter( jet->GetSeedEtaIdx(), jet->GetSeedPhiIdx() ); 
+    // -- Et in cone stencil is the upper limit of the jet Et
+    if ( fGrid->GetConeEt( jet->GetSeedEtaIdx(), jet->GetSeedPhiIdx() ) < minEt )
+      continue;
 
-    Int_t cellIdx = 0;
-    
-    // -- Loop over cells around ssed
-    while ( (cellIdx = fGrid->NextCell() ) >= 0 && !iResult) {
+    // -- Loop over cells in cone stencil around seed
+    for ( Int_t stencilIdx = 0; stencilIdx < fGrid->GetStencilSize() && !iResult; stencilIdx++ ) {
+
+      Int_t cellIdx = fGrid->GetStencilCellIdx( jet->GetSeedEtaIdx(), jet->GetSeedPhiIdx(), stencilIdx );
+      if ( cellIdx < 0 )
+	continue;
 
       AliHLTJETConeEtaPhiCell* cell = NULL;
       if ( ! (cell = reinterpret_cast<AliHLTJETConeEtaPhiCell*>(fGrid->UncheckedAt(cellIdx))) )
@@ -301,7 +347,7 @@ Int_t AliHLTJETConeFinder::FindConeJets() {
 	HLTError( "Error adding cell %d to jet candiate %d", cellIdx, iter);
 	continue;
       }
-    } // while ( (cellIdx = fGrid->NextCell() ) >= 0 && !iResult) {
+    } // for ( Int_t stencilIdx = 0; stencilIdx < fGrid->GetStencilSize() && !iResult; stencilIdx++ ) {
     
   } // for ( Int_t iter = 0; iter < reader->GetNJetCandidates(); iter++ ) {
   
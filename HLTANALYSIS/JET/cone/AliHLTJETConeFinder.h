@@ -23,6 +23,8 @@
 
 #include "AliJetFinder.h"
 
+#include "TStopwatch.h"
+
 #include "AliHLTJets.h"
 #include "AliHLTLogging.h"
 
@@ -53,6 +55,13 @@
  *           depending, on the input object 
  *      * Process one event (contains reset per event)
  *          <pre>jetFinder->ProcessHLTEvent();</pre>
+ *
+ * <b>Bounded latency</b><br>
+ *  With <pre>jetFinder->SetMaxProcessingTime( ms );</pre> the jet candidates,
+ *  which are sorted descending in seed pt, are only processed until the 
+ *  time budget is used up; the remaining candidates are dropped and
+ *  GetTimeBudgetExceeded() is set for this event. The processing time of the 
+ *  last event is available via GetProcessingTime().
  *   
  * @ingroup alihlt_jet_cone
  */
@@ -103,6 +112,30 @@ public:
 
   /** Set ptr to jet reader */
   void SetJetReader( AliJetReader *reader) { fReader = reader; }
+
+  /** Set time budget per event in ms, 0 for no limit */
+  void SetMaxProcessingTime( Float_t f ) { fMaxProcessingTime = f; }
+
+  /*
+   * ---------------------------------------------------------------------------------
+   *                                     Getter
+   * ---------------------------------------------------------------------------------
+   */
+
+  /** Get time budget per event in ms */
+  Float_t GetMaxProcessingTime() const { return fMaxProcessingTime; }
+
+  /** Get processing time of the last event in ms */
+  Double_t GetProcessingTime() const { return fProcessingTime; }
+
+  /** Get number of jet candidates processed in the last event */
+  Int_t GetNProcessedCandidates() const { return fNProcessedCandidates; }
+
+  /** Get number of jet candidates found in the last event */
+  Int_t GetNCandidates() const { return fNCandidates; }
+
+  /** Check if the time budget was exceeded in the last event */
+  Bool_t GetTimeBudgetExceeded() const { return fNProcessedCandidates < fNCandidates; }
   
   /*
    * ---------------------------------------------------------------------------------
@@ -144,6 +177,9 @@ private:
   Int_t FindConeLeading();
 
   /** Find jets in one event
+   *  Candidates which can not pass the jet cuts, according to 
+   *  the Et summed up over the cone stencil of the grid, are skipped.
+   *  In bounded mode, stop after the time budget is used up.
    *  @return 0 on success, < 0 on failure
    */
   Int_t FindConeJets();
@@ -166,7 +202,22 @@ private:
   /** Container of AliAODJets */
   AliHLTJets                  *fJets;           //! transient
 
-  ClassDef(AliHLTJETConeFinder, 2)
+  /** Time budget per event in ms, 0 for no limit */
+  Float_t                      fMaxProcessingTime;    // see above
+
+  /** Timer of the current event */
+  TStopwatch                   fTimer;                //! transient
+
+  /** Processing time of the last event in ms */
+  Double_t                     fProcessingTime;       //! transient
+
+  /** Number of jet candidates in the last event */
+  Int_t                        fNCandidates;          //! transient
+
+  /** Number of processed jet candidates in the last event */
+  Int_t                        fNProcessedCandidates; //! transient
+
+  ClassDef(AliHLTJETConeFinder, 3)
 
 };
 #endif
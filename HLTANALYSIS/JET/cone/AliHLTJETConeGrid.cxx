@@ -65,7 +65,11 @@ AliHLTJETConeGrid::AliHLTJETConeGrid()
   fPhiIdxCurrent(0),
   fPhiIdxMin(0),
   fPhiIdxMax(0),
-  fConeRadius(0.0) {
+  fConeRadius(0.0),
+  fUseRadiusStencil(kFALSE),
+  fStencilEta(),
+  fStencilPhiOffset(),
+  fCellEt() {
   // see header file for class documentation
   // or
   // refer to README to build package
@@ -121,6 +125,12 @@ Int_t AliHLTJETConeGrid::Initialize() {
     iResult = 1;
   }
 
+  // -- Setup cell Et array and cone stencil
+  fCellEt.assign( fNBins, 0. );
+  FillStencil();
+
+  HLTInfo(" NStencil   %d", GetStencilSize() );
+
   return iResult;
 }
 
@@ -131,6 +141,8 @@ void AliHLTJETConeGrid::Reset() {
   if ( fGrid )
     fGrid->Clear("C");
 
+  fCellEt.assign( fCellEt.size(), 0. );
+
   return;
 }
 
@@ -170,6 +182,8 @@ Int_t AliHLTJETConeGrid::FillTrack( TParticle* particle, const Float_t* aEtaPhi,
     (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxPrimary]]))->AddTrack(particle);
   }
 
+  fCellEt[aGridIdx[kIdxPrimary]] += TMath::Abs( aEtaPhi[kIdxPt] );
+
   // ---------------------------
   // -- Fill track in outter region
   // ---------------------------
@@ -187,6 +201,8 @@ Int_t AliHLTJETConeGrid::FillTrack( TParticle* particle, const Float_t* aEtaPhi,
     else {
       (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxOutter]]))->AddTrack(particle);
     }
+
+    fCellEt[aGridIdx[kIdxOutter]] += TMath::Abs( aEtaPhi[kIdxPt] );
   }
 
   return 0;
@@ -221,6 +237,8 @@ Int_t AliHLTJETConeGrid::FillTrack( AliESDtrack *esdTrack, const Float_t* aEtaPh
   else {
     (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxPrimary]]))->AddTrack(esdTrack);
   }
+
+  fCellEt[aGridIdx[kIdxPrimary]] += TMath::Abs( aEtaPhi[kIdxPt] );
    
   // ---------------------------
   // -- Fill track in outter region
@@ -239,17 +257,101 @@ Int_t AliHLTJETConeGrid::FillTrack( AliESDtrack *esdTrack, const Float_t* aEtaPh
     else {
       (reinterpret_cast<AliHLTJETConeEtaPhiCell*> ((*fGrid)[aGridIdx[kIdxOutter]]))->AddTrack(esdTrack);
     }
+
+    fCellEt[aGridIdx[kIdxOutter]] += TMath::Abs( aEtaPhi[kIdxPt] );
   }
   
   return 0;
 }
 
+//##################################################################################
+Int_t AliHLTJETConeGrid::FillTracks( Int_t nTracks, const Float_t* aEta, const Float_t* aPhi, 
+				     const Float_t* aPt, Int_t* aCellIdx ) {
+  // see header file for class documentation
+
+  Int_t nFilled = 0;
+
+  for ( Int_t iter = 0; iter < nTracks; iter++ ) {
+
+    if ( aCellIdx ) 
+      aCellIdx[iter] = -1;
+
+    // -- Same indices as in GetCellIndex, without the per track logging
+    Float_t phiPrime = aPhi[iter] + fConeRadius;
+
+    Int_t etaIdx = TMath::FloorNint( ( fEtaMax + aEta[iter] ) / fEtaBinning );
+    Int_t phiIdx = TMath::FloorNint( phiPrime / fPhiBinning );
+
+    if ( etaIdx < 0 || etaIdx >= fEtaNGridBins || phiIdx < 0 || phiIdx >= fPhiNGridBins )
+      continue;
+
+    Float_t pt = TMath::Abs( aPt[iter] );
+    Int_t cellIdx = etaIdx + ( phiIdx * fEtaNGridBins );
+
+    fCellEt[cellIdx] += pt;
+    ++nFilled;
+
+    if ( aCellIdx ) 
+      aCellIdx[iter] = cellIdx;
+
+    // -- Fill track in outter region
+    Float_t phiOutterPrime = -1.;
+
+    if ( aPhi[iter] > ( fPhiMax - fConeRadius ) )
+      phiOutterPrime = phiPrime - fPhiMax;
+    else if ( aPhi[iter] < fConeRadius ) 
+      phiOutterPrime = phiPrime + fPhiMax;
+    else
+      continue;
+
+    Int_t phiOutterIdx = TMath::FloorNint( phiOutterPrime / fPhiBinning );
+    if ( phiOutterIdx < 0 || phiOutterIdx >= fPhiNGridBins )
+      continue;
+
+    fCellEt[etaIdx + ( phiOutterIdx * fEtaNGridBins )] += pt;
+  }
+
+  if ( nFilled < nTracks ) {
+    HLTDebug("%d of %d tracks outside of the grid", nTracks - nFilled, nTracks );
+  }
+
+  return nFilled;
+}
+
 /*
  * ---------------------------------------------------------------------------------
  *                             Helper - public
  * ---------------------------------------------------------------------------------
  */
 
+// #################################################################################
+Float_t AliHLTJETConeGrid::GetConeEt( const Int_t etaIdx, const Int_t phiIdx ) const {
+  // see header file for class documentation
+
+  const Int_t seedIdx  = etaIdx + ( phiIdx * fEtaNGridBins );
+  const Int_t nStencil = GetStencilSize();
+
+  Float_t coneEt = 0.;
+
+  // -- Seed away from the grid border : no check needed
+  if ( etaIdx >= fEtaNRBins && etaIdx < fEtaNGridBins - fEtaNRBins &&
+       phiIdx >= fPhiNRBins && phiIdx < fPhiNGridBins - fPhiNRBins ) {
+    const Float_t* cellEt = &(fCellEt[seedIdx]);
+    for ( Int_t iter = 0; iter < nStencil; iter++ )
+      coneEt += cellEt[fStencilEta[iter] + fStencilPhiOffset[iter]];
+  }
+  else {
+    for ( Int_t iter = 0; iter < nStencil; iter++ ) {
+      Int_t cellIdx = GetStencilCellIdx( etaIdx, phiIdx, iter );
+      if ( cellIdx < 0 ) 
+	continue;
+      coneEt += fCellEt[cellIdx];
+    }
+  }
+
+  return coneEt;
+}
+
 // #################################################################################
 Int_t AliHLTJETConeGrid::NextCell() {
   // see header file for class documentation
@@ -398,3 +500,34 @@ Int_t AliHLTJETConeGrid::GetCellIndex( const Float_t* aEtaPhi, Int_t* aGridIdx )
 
   return iResult;
 }
+
+//##################################################################################
+void AliHLTJETConeGrid::FillStencil() {
+  // see header file for class documentation
+
+  fStencilEta.clear();
+  fStencilPhiOffset.clear();
+
+  const Float_t coneRadius2 = fConeRadius * fConeRadius;
+
+  // -- Same cells as SetCellIter / NextCell, in the same order
+  for ( Int_t etaIter = -fEtaNRBins; etaIter <= fEtaNRBins; etaIter++ ) {
+    for ( Int_t phiIter = -fPhiNRBins; phiIter <= fPhiNRBins; phiIter++ ) {
+
+      // -- Round stencil : keep the cell if its closest point is within 
+      //    the cone radius of any point of the seed cell
+      if ( fUseRadiusStencil ) {
+	Float_t dEta = TMath::Max( 0, TMath::Abs(etaIter) - 1 ) * fEtaBinning;
+	Float_t dPhi = TMath::Max( 0, TMath::Abs(phiIter) - 1 ) * fPhiBinning;
+	
+	if ( ( dEta*dEta + dPhi*dPhi ) > coneRadius2 )
+	  continue;
+      }
+
+      fStencilEta.push_back( etaIter );
+      fStencilPhiOffset.push_back( phiIter * fEtaNGridBins );
+    }
+  }
+
+  return;
+}
@@ -22,6 +22,8 @@
 // visit http://web.ift.uib.no/~kjeks/doc/alice-hlt
 
 
+#include <vector>
+
 #include "TClonesArray.h"
 #include "TParticle.h"
 
@@ -77,6 +79,21 @@ public:
    */
   Int_t FillTrack( AliESDtrack* esdTrack, const Float_t* aEtaPhi, Int_t* aGridIdx );
 
+  /** Fill packed tracks into the cell Et array only
+   *  No cell objects are created, the tracks are only summed up
+   *  in the Et array, which is used by GetConeEt(). Tracks outside 
+   *  of the grid are skipped.
+   *  @param nTracks  number of tracks
+   *  @param aEta     array of nTracks eta values
+   *  @param aPhi     array of nTracks phi values
+   *  @param aPt      array of nTracks pt values
+   *  @param aCellIdx optional array to be filled with the 1D index
+   *                  in the primary region, -1 if skipped
+   *  @return number of filled tracks
+   */
+  Int_t FillTracks( Int_t nTracks, const Float_t* aEta, const Float_t* aPhi, 
+		    const Float_t* aPt, Int_t* aCellIdx = NULL );
+
   /*
    * ---------------------------------------------------------------------------------
    *                                   Initialize / Reset
@@ -112,6 +129,12 @@ public:
   /** Set cone radius */
   void SetConeRadius( Float_t coneRadius) { fConeRadius = coneRadius; }
 
+  /** Use a round cone stencil instead of the full square of cells
+   *  Only cells which can contain tracks within the cone radius
+   *  of a track in the seed cell are kept.
+   */
+  void SetUseRadiusStencil( Bool_t b ) { fUseRadiusStencil = b; }
+
   /*
    * ---------------------------------------------------------------------------------
    *                             Helper - public
@@ -132,6 +155,35 @@ public:
    */
   void SetCellIter( const Int_t etaIdx, const Int_t phiIdx );
 
+  /** Get number of cells in the cone stencil */
+  Int_t GetStencilSize() const { return fStencilOffset.size(); }
+
+  /** Get cell idx of one stencil entry around a seed
+   *  @param etaIdx     Eta index of seed
+   *  @param phiIdx     Phi index of seed
+   *  @param stencilIdx Index in the stencil
+   *  @return 1D cell idx, -1 if outside of the grid
+   */
+  Int_t GetStencilCellIdx( const Int_t etaIdx, const Int_t phiIdx, const Int_t stencilIdx ) const {
+    Int_t eta = etaIdx + fStencilEta[stencilIdx];
+    if ( eta < 0 || eta >= fEtaNGridBins ) 
+      return -1;
+    Int_t cellIdx = eta + ( phiIdx * fEtaNGridBins ) + fStencilPhiOffset[stencilIdx]; 
+    if ( cellIdx < 0 || cellIdx >= fNBins )
+      return -1;
+    return cellIdx;
+  }
+
+  /** Sum of the cell Et array over the cone stencil
+   *  @param etaIdx Eta index of seed
+   *  @param phiIdx Phi index of seed
+   *  @return Et within the stencil 
+   */
+  Float_t GetConeEt( const Int_t etaIdx, const Int_t phiIdx ) const;
+
+  /** Get Et of one cell from the cell Et array */
+  Float_t GetCellEt( Int_t cellIdx ) const { return fCellEt[cellIdx]; }
+
 
   /** Check if there is an object at cellIdx in fGrid
    *  @param   cellIdx    CellIdx where there coulf be an object
@@ -175,6 +227,12 @@ private:
    */
   Int_t GetCellIndex( const Float_t* aEtaPhi, Int_t* aGridIdx );
 
+  /** Fill the cone stencil
+   *  List of (eta,phi) offsets of the cells around the seed cell
+   *  which are searched, set via Initialize()
+   */
+  void FillStencil();
+
   /*
    * ---------------------------------------------------------------------------------
    *                             Members - private
@@ -260,7 +318,23 @@ private:
   /** Cone radius */
   Float_t        fConeRadius;              // see above
 
-  ClassDef(AliHLTJETConeGrid, 1)
+  /** Use round cone stencil instead of square */
+  Bool_t         fUseRadiusStencil;        // see above
+
+  // -- Cone stencil - set via Initialize()
+
+  /** Eta offsets of the stencil cells */
+  std::vector<Int_t>   fStencilEta;        //! transient
+
+  /** 1D phi offsets ( dPhi * fEtaNGridBins ) of the stencil cells */
+  std::vector<Int_t>   fStencilPhiOffset;  //! transient
+
+  // -- Cell Et array - filled together with the cells
+
+  /** Et per cell */
+  std::vector<Float_t> fCellEt;            //! transient
+
+  ClassDef(AliHLTJETConeGrid, 2)
 
 };
 #endif
@@ -31,6 +31,7 @@
 
 #include "TString.h"
 #include "TObjString.h"
+#include "TStopwatch.h"
 
 using namespace std;
 
@@ -136,6 +137,7 @@ Int_t AliHLTJETConeJetComponent::DoInit( Int_t argc, const Char_t** argv ) {
   Float_t trackCutMinPt =  1.0;
   Float_t seedCutMinPt  =  5.0;
   Float_t jetCutMinEt   = 15.0;
+  Float_t maxProcessingTime = 0.0;
 
   // ---------------------------------------------------------------------
   // -- Get Arguments
@@ -287,6 +289,26 @@ Int_t AliHLTJETConeJetComponent::DoInit( Int_t argc, const Char_t** argv ) {
       }
     } 
     
+    // -- maxProcessingTime
+    else if ( !argument.CompareTo("-maxProcessingTime") ) {
+      if ((bMissingParam=(++iter>=argc))) break;
+
+      TString parameter(argv[iter]);
+      parameter.Remove(TString::kLeading, ' ');
+
+      if ( parameter.IsFloat() ) {
+	maxProcessingTime = parameter.Atof();
+	comment += argument;
+	comment += " ";
+	comment += parameter;
+	comment += ' ';
+      }
+      else {
+	HLTError("Wrong parameter %s for argument %s.", parameter.Data(), argument.Data());
+	iResult=-EINVAL;
+      }
+    } 
+
     // -- Argument not known
     else {
       HLTError("Unknown argument %s.", argument.Data());
@@ -402,6 +424,7 @@ Int_t AliHLTJETConeJetComponent::DoInit( Int_t argc, const Char_t** argv ) {
   fJetFinder->SetJetHeader(fJetHeader);
   fJetFinder->SetJetReader(fJetReader);
   fJetFinder->SetOutputJets(fJets);
+  fJetFinder->SetMaxProcessingTime(maxProcessingTime);
 
   // ---------------------------------------------------------------------
   // -- Initialize Jet Finder
@@ -462,6 +485,8 @@ Int_t AliHLTJETConeJetComponent::DoEvent( const AliHLTComponentEventData& /*evtD
 
   const TObject* iter = NULL;
 
+  TStopwatch timer;
+
   // -- Start-Of-Run
   // -----------------
   if ( GetFirstInputObject(kAliHLTDataTypeSOR) && !iResult ) {
@@ -480,17 +505,22 @@ Int_t AliHLTJETConeJetComponent::DoEvent( const AliHLTComponentEventData& /*evtD
     fJetReader->SetInputEvent( NULL, NULL, const_cast<TObject*>(iter) );    
 
     // -- Fill grid with MC
+    timer.Start(kTRUE);
     if ( ! fJetReader->FillGridHLTMC() ) {
       HLTError("Error filling grid.");
       iResult = -EINPROGRESS;
     }
 
+    Double_t fillTime = 1000. * timer.RealTime();
+
     // -- Find jets
     if ( !iResult) {
       if ( ! fJetFinder->ProcessHLTEvent() ) {
 	HLTError("Error processing cone event.");
 	iResult = -EINPROGRESS;
       }
+      else
+	ReportTiming(fillTime);
     }
     
     // -- PushBack
@@ -511,17 +541,22 @@ Int_t AliHLTJETConeJetComponent::DoEvent( const AliHLTComponentEventData& /*evtD
     fJetReader->SetInputEvent( const_cast<TObject*>(iter), NULL, NULL );    
   
     // -- Fill grid with ESD
+    timer.Start(kTRUE);
     if ( ! fJetReader->FillGridESD() ) {
       HLTError("Error filling grid.");
       iResult = -1;  
     }
 
+    Double_t fillTime = 1000. * timer.RealTime();
+
     // -- Find jets
     if ( !iResult) {
       if ( ! fJetFinder->ProcessHLTEvent() ) {
 	HLTError("Error processing cone event.");
 	iResult = -EINPROGRESS;
       }
+      else
+	ReportTiming(fillTime);
     }
 
     // -- PushBack
@@ -542,17 +577,22 @@ Int_t AliHLTJETConeJetComponent::DoEvent( const AliHLTComponentEventData& /*evtD
     fJetReader->SetInputEvent( const_cast<TObject*>(iter), NULL, NULL );    
 
     // -- Fill grid with ESD
+    timer.Start(kTRUE);
     if ( ! fJetReader->FillGridESD() ) {
       HLTError("Error filling grid.");
       iResult = -1;  
     }
 
+    Double_t fillTime = 1000. * timer.RealTime();
+
     // -- Find jets
     if ( !iResult) {
       if ( ! fJetFinder->ProcessHLTEvent() ) {
 	HLTError("Error processing cone event.");
 	iResult = -EINPROGRESS;
       }
+      else
+	ReportTiming(fillTime);
     }
 
     // -- PushBack
@@ -563,3 +603,23 @@ Int_t AliHLTJETConeJetComponent::DoEvent( const AliHLTComponentEventData& /*evtD
 
   return iResult;
 }
+
+/*
+ * ---------------------------------------------------------------------------------
+ *                             Helper - private
+ * ---------------------------------------------------------------------------------
+ */
+
+// #################################################################################
+void AliHLTJETConeJetComponent::ReportTiming( Double_t fillTime ) {
+  // see header file for class documentation
+
+  if ( fJetFinder->GetMaxProcessingTime() <= 0. )
+    return;
+
+  HLTInfo("Timing : fill grid %.3f ms - find jets %.3f ms (budget %.3f ms) - %d of %d jet candidates processed",
+	  fillTime, fJetFinder->GetProcessingTime(), fJetFinder->GetMaxProcessingTime(),
+	  fJetFinder->GetNProcessedCandidates(), fJetFinder->GetNCandidates() );
+
+  return;
+}
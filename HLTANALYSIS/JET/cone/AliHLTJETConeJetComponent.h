@@ -67,6 +67,11 @@
  * \li  -jetCutMinPt   <i> min Et for cut on found jets, in GeV/c </i> <br>
  *       - Default : 15.0 <br>
  *
+ * \li  -maxProcessingTime <i> time budget per event of the jet finder, in ms </i> <br>
+ *       Jet candidates with the lowest seed pt are dropped, once the budget is used up.
+ *       The timing of every event is reported. <br>
+ *       - Default : 0 (no limit, timing not reported) <br>
+ *
  * @ingroup alihlt_jet
  * @ingroup alihlt_jet_cone
  */
@@ -161,6 +166,17 @@ private:
 
   /** assignment operator prohibited */
   AliHLTJETConeJetComponent& operator=(const AliHLTJETConeJetComponent&);
+
+  /*
+   * ---------------------------------------------------------------------------------
+   *                             Helper - private
+   * ---------------------------------------------------------------------------------
+   */
+
+  /** Report timing of the last event, in bounded latency mode only 
+   *  @param fillTime time to fill the grid in ms
+   */
+  void ReportTiming( Double_t fillTime );
   
   /*
    * ---------------------------------------------------------------------------------
@@ -374,6 +374,8 @@ void AliAnalysisTaskKMeans::UserExec(Option_t *)
 
   //
   Double_t rk0[10];
+  Int_t nclus[10];
+  for (Int_t i = 0; i < fK; i++) nclus[i] = i + 1;
   AliKMeansResult* res = 0;
   AliKMeansResult best(10);
   Float_t   rmaxG = -1.;
@@ -381,9 +383,9 @@ void AliAnalysisTaskKMeans::UserExec(Option_t *)
   for (Int_t k = 0; k < 20; k++) {
     Float_t   rmax   = -1.;
     Int_t     imax   = 0;
+    AliKMeansClustering::SoftKMeans2(fK, nclus, ic, phi, eta, fA);
     for (Int_t i = 0; i < fK; i++) {
       res = fA[i];
-      AliKMeansClustering::SoftKMeans2(i+1, ic, phi, eta, res->GetMx(),res->GetMy(), res->GetSigma2(), res->GetRk());
       res->Sort(ic, phi, eta);
       Int_t j = (res->GetInd())[0];
       rk0[i]  = (res->GetTarget())[j];
@@ -486,9 +488,9 @@ void AliAnalysisTaskKMeans::UserExec(Option_t *)
   for (Int_t k = 0; k < 20; k++) {
     Float_t rmax   = -1.;
     Int_t   imax   =  0;
+    AliKMeansClustering::SoftKMeans2(fK, nclus, ic, phiR, etaR, fB);
     for (Int_t i = 0; i < fK; i++) {
       res = fB[i];
-      AliKMeansClustering::SoftKMeans2(i+1, ic, phiR, etaR, res->GetMx(),res->GetMy(), res->GetSigma2(), res->GetRk());
       res->Sort(ic, phiR, etaR);
       Int_t j = (res->GetInd())[0];
       rk0[i]  = (res->GetTarget())[j];
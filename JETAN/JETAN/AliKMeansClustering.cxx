@@ -22,6 +22,10 @@
 // Author: Andreas Morsch (CERN)
 // andreas.morsch@cern.ch
  
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "AliKMeansClustering.h"
 #include <TMath.h>
 #include <TRandom.h>
@@ -31,13 +35,104 @@ ClassImp(AliKMeansClustering)
 
 Double_t AliKMeansClustering::fBeta = 10.;
 
+void AliKMeansClustering::Responsibilities(Int_t k, Int_t n, const Double_t* x, const Double_t* y, 
+					   const Double_t* mx, const Double_t* my, 
+					   const Double_t* norm, const Double_t* sx, const Double_t* sy, 
+					   Double_t* r, Double_t* nr)
+{
+    //
+    // Batch kernel for the responsibilities of k means for n points 
+    // r[i * n + j] = norm[i] * exp(- (sx[i] * dx^2 + sy[i] * dy^2)),  dx periodic in phi
+    // The sum over the means is added to nr[j].
+    // The inner loop runs over the contiguous point arrays, without branches, 
+    // such that it can be vectorised by the compiler.
+    //
+    const Double_t twoPi = 2. * TMath::Pi();
+    for (Int_t i = 0; i < k; i++) {
+	Double_t* ri = r + i * n;
+	const Double_t mxi = mx[i], myi = my[i], ni = norm[i], sxi = sx[i], syi = sy[i];
+	for (Int_t j = 0; j < n; j++) {
+	    Double_t dx = std::fabs(mxi - x[j]);
+	    dx = (dx > TMath::Pi()) ? twoPi - dx : dx;
+	    Double_t dy = myi - y[j];
+	    Double_t rij = ni * std::exp(- (sxi * dx * dx + syi * dy * dy));
+	    ri[j]  = rij;
+	    nr[j] += rij;
+	} // data point j
+    } // mean i
+}
+
+void AliKMeansClustering::Normalise(Int_t k, Int_t n, Double_t* r, Double_t* nr)
+{
+    //
+    // Normalise the responsibilities r[i * n + j] to the sum nr[j] over the means
+    //
+    for (Int_t j = 0; j < n; j++) nr[j] = 1. / nr[j];
+    for (Int_t i = 0; i < k; i++) {
+	Double_t* ri = r + i * n;
+	for (Int_t j = 0; j < n; j++) ri[j] *= nr[j];
+    } // mean i
+}
+
+Double_t AliKMeansClustering::UpdateMean(Int_t n, const Double_t* x, const Double_t* y, const Double_t* ri,
+					 Double_t& mx, Double_t& my, Double_t& rk, Double_t rmin)
+{
+    //
+    // Update step for one mean, returns the distance the mean moved
+    //
+    Double_t oldx = mx;
+    Double_t oldy = my;
+    
+    mx = x[0];
+    my = y[0];
+    rk = ri[0];
+    for (Int_t j = 1; j < n; j++) {
+	Double_t xx =  x[j];
+//
+// Here we have to take into acount the cylinder topology where phi is defined mod 2xpi
+// If two coordinates are separated by more than pi in phi one has to be shifted by +/- 2 pi
+
+	Double_t dx = mx - x[j];
+	if (dx >  TMath::Pi()) xx += 2. * TMath::Pi();
+	if (dx < -TMath::Pi()) xx -= 2. * TMath::Pi();
+	if (ri[j] > rmin) {
+	    mx = mx * rk + ri[j] * xx;
+	    my = my * rk + ri[j] * y[j];
+	    rk += ri[j];
+	    mx /= rk;
+	    my /= rk;
+	}
+	if (mx > 2. * TMath::Pi()) mx -= 2. * TMath::Pi();
+	if (mx < 0.              ) mx += 2. * TMath::Pi();
+    } // Data
+    return d(mx, my, oldx, oldy);
+}
+
+void AliKMeansClustering::Sigma2(Int_t n, const Double_t* x, const Double_t* y, const Double_t* ri,
+				 Double_t mx, Double_t my, Double_t rk, Double_t& sigmax2, Double_t& sigmay2)
+{
+    //
+    // Weighted variances in x and y of one cluster
+    //
+    const Double_t twoPi = 2. * TMath::Pi();
+    Double_t sx = 0., sy = 0.;
+    for (Int_t j = 0; j < n; j++) {
+	Double_t dx = std::fabs(mx - x[j]);
+	dx = (dx > TMath::Pi()) ? twoPi - dx : dx;
+	Double_t dy = my - y[j];
+	sx += ri[j] * dx * dx;
+	sy += ri[j] * dy * dy;
+    } // Data
+    sigmax2 = sx / rk;
+    sigmay2 = sy / rk;
+}
  
 Int_t AliKMeansClustering::SoftKMeans(Int_t k, Int_t n, const Double_t* x, const Double_t* y, Double_t* mx, Double_t* my , Double_t* rk )
 {
     //
     // The soft K-means algorithm
     //
-    Int_t i,j;
+    Int_t i;
     //
     // (1) Initialisation of the k means
 
@@ -47,12 +142,13 @@ Int_t AliKMeansClustering::SoftKMeans(Int_t k, Int_t n, const Double_t* x, const
     }
 
     //
-    // (2a) The responsibilities
-    Double_t** r = new Double_t*[n]; // responsibilities
-    for (j = 0; j < n; j++) {r[j] = new Double_t[k];}
+    // (2a) The responsibilities, r[i * n + j] for mean i and data point j
+    std::vector<Double_t> r(k * n);
     //
     // (2b) Normalisation
-    Double_t* nr   = new Double_t[n];
+    std::vector<Double_t> nr(n);
+    // Constant width 
+    std::vector<Double_t> norm(k, 1.), s(k, 0.5 * fBeta);
     // (3) Iterations
     Int_t nit = 0;
     
@@ -61,61 +157,21 @@ Int_t AliKMeansClustering::SoftKMeans(Int_t k, Int_t n, const Double_t* x, const
       //
       // Assignment step
       //
-      for (j = 0; j < n; j++) {
-	nr[j] = 0.;
-	for (i = 0; i < k; i++) {
-	  r[j][i] = TMath::Exp(- fBeta * d(mx[i], my[i], x[j], y[j]));
-	  nr[j] += r[j][i];
-	} // mean i
-      } // data point j
-	
-      for (j = 0; j < n; j++) {
-	for (i = 0; i < k; i++) {
-	  r[j][i] /=  nr[j];
-	} // mean i
-      } // data point j
+      std::fill(nr.begin(), nr.end(), 0.);
+      Responsibilities(k, n, x, y, mx, my, norm.data(), s.data(), s.data(), r.data(), nr.data());
+      Normalise(k, n, r.data(), nr.data());
       
 	//
 	// Update step
       Double_t di = 0;
       
-      for (i = 0; i < k; i++) {
-	  Double_t oldx = mx[i];
-	  Double_t oldy = my[i];
-	  
-	  mx[i] = x[0];
-	  my[i] = y[0];
-	  rk[i] = r[0][i];
-	
-	for (j = 1; j < n; j++) {
-	    Double_t xx =  x[j];
-//
-// Here we have to take into acount the cylinder topology where phi is defined mod 2xpi
-// If two coordinates are separated by more than pi in phi one has to be shifted by +/- 2 pi
-
-	    Double_t dx = mx[i] - x[j];
-	    if (dx >  TMath::Pi()) xx += 2. * TMath::Pi();
-	    if (dx < -TMath::Pi()) xx -= 2. * TMath::Pi();
-	    mx[i] = mx[i] * rk[i] + r[j][i] * xx;
-	    my[i] = my[i] * rk[i] + r[j][i] * y[j];
-	    rk[i] += r[j][i];
-	    mx[i] /= rk[i];
-	    my[i] /= rk[i];	    
-	    if (mx[i] > 2. * TMath::Pi()) mx[i] -= 2. * TMath::Pi();
-	    if (mx[i] < 0.              ) mx[i] += 2. * TMath::Pi();
-	} // Data
-	di += d(mx[i], my[i], oldx, oldy);
-      } // means 
+      for (i = 0; i < k; i++) 
+	di += UpdateMean(n, x, y, r.data() + i * n, mx[i], my[i], rk[i], -1.);
 	//
 	// ending condition
       if (di < 1.e-8 || nit > 1000) break;
     } // while
 
-// Clean-up    
-    delete[] nr;
-    for (j = 0; j < n; j++) delete[] r[j];
-    delete[] r;
-// 
     return (nit < 1000);
     
 }
@@ -125,123 +181,132 @@ Int_t AliKMeansClustering::SoftKMeans2(Int_t k, Int_t n, Double_t* x, Double_t*
     //
     // The soft K-means algorithm
     //
-    Int_t i,j;
+    return SoftKMeans2(1, &k, n, x, y, &mx, &my, &sigma2, &rk);
+}
+
+Int_t AliKMeansClustering::SoftKMeans2(Int_t nk, const Int_t* k, Int_t n, const Double_t* x, const Double_t* y, 
+				       AliKMeansResult** res)
+{
+    //
+    // The soft K-means algorithm for several numbers of clusters k[0] ... k[nk-1] in one pass over the 
+    // data points. The results for k[ik] are stored in res[ik], which has to hold at least k[ik] clusters.
+    // The initialisation uses the random numbers in the same order as nk calls of the single k version.
+    // Returns 1 if all the k values converged.
+    //
+    std::vector<Double_t*> mx(nk), my(nk), sigma2(nk), rk(nk);
+    for (Int_t ik = 0; ik < nk; ik++) {
+	mx[ik]     = res[ik]->GetMx();
+	my[ik]     = res[ik]->GetMy();
+	sigma2[ik] = res[ik]->GetSigma2();
+	rk[ik]     = res[ik]->GetRk();
+    }
+    return SoftKMeans2(nk, k, n, x, y, mx.data(), my.data(), sigma2.data(), rk.data());
+}
+
+Int_t AliKMeansClustering::SoftKMeans2(Int_t nk, const Int_t* k, Int_t n, const Double_t* x, const Double_t* y, 
+				       Double_t** mx, Double_t** my, Double_t** sigma2, Double_t** rk)
+{
+    //
+    // The soft K-means algorithm, all the means of the nk groups are kept in contiguous arrays
     //
     // (1) Initialisation of the k means using k-means++ recipe
     // 
-     OptimalInit(k, n, x, y, mx, my);
+    std::vector<Int_t> off(nk + 1, 0);
+    for (Int_t ik = 0; ik < nk; ik++) {
+	OptimalInit(k[ik], n, x, y, mx[ik], my[ik]);
+	off[ik + 1] = off[ik] + k[ik];
+    }
+    const Int_t ktot = off[nk];
+    std::vector<Double_t> cmx(ktot), cmy(ktot), cs2(ktot), crk(ktot);
+    for (Int_t ik = 0; ik < nk; ik++) {
+	std::copy(mx[ik], mx[ik] + k[ik], cmx.begin() + off[ik]);
+	std::copy(my[ik], my[ik] + k[ik], cmy.begin() + off[ik]);
+    }
     //
-    // (2a) The responsibilities
-    Double_t** r = new Double_t*[n]; // responsibilities
-    for (j = 0; j < n; j++) {r[j] = new Double_t[k];}
+    // (2a) The responsibilities, r[i * n + j] for mean i and data point j
+    std::vector<Double_t> r(ktot * n);
     //
-    // (2b) Normalisation
-    Double_t* nr = new Double_t[n];
+    // (2b) Normalisation, per group
+    std::vector<Double_t> nr(nk * n);
     //
-    // (2c) Weights 
-    Double_t* pi = new Double_t[k];
+    // (2c) Weights and kernel parameters
+    std::vector<Double_t> pi(ktot), norm(ktot, 1.), s(ktot, 0.5 * fBeta);
     //
     //
     // (2d) Initialise the responsibilties and weights
-    for (j = 0; j < n; j++) {
-      nr[j] = 0.;
-      for (i = 0; i < k; i++) {
-	r[j][i] = TMath::Exp(- fBeta * d(mx[i], my[i], x[j], y[j]));
-	nr[j] += r[j][i];
-      } // mean i
-    } // data point j
+    for (Int_t ik = 0; ik < nk; ik++) {
+      Int_t i0 = off[ik];
+      Double_t* ri  = r.data() + i0 * n;
+      Double_t* nri = nr.data() + ik * n;
+      Responsibilities(k[ik], n, x, y, &cmx[i0], &cmy[i0], &norm[i0], &s[i0], &s[i0], ri, nri);
+      Normalise(k[ik], n, ri, nri);
+    }
     
-    for (i = 0; i < k; i++) {
-      rk[i]    = 0.;
-      sigma2[i] = 1./fBeta;
- 
-      for (j = 0; j < n; j++) {
-	r[j][i] /=  nr[j];
-	rk[i] += r[j][i];
-      } // mean i
-      pi[i] = rk[i] / Double_t(n);
-    } // data point j
+    for (Int_t i = 0; i < ktot; i++) {
+      const Double_t* ri = r.data() + i * n;
+      crk[i] = 0.;
+      cs2[i] = 1./fBeta;
+      for (Int_t j = 0; j < n; j++) crk[i] += ri[j];
+      pi[i] = crk[i] / Double_t(n);
+    } // mean i
     // (3) Iterations
-    Int_t nit = 0;
-
-    while(1) {
-	nit++;
-      //
-      // Assignment step
-      //
-      for (j = 0; j < n; j++) {
-	nr[j] = 0.;
-	for (i = 0; i < k; i++) {
-	  r[j][i] = pi[i] * TMath::Exp(- d(mx[i], my[i], x[j], y[j]) / sigma2[i] ) 
-	    / (2. * sigma2[i] * TMath::Pi() * TMath::Pi());
-	  nr[j] += r[j][i];
-	} // mean i
-      } // data point j
-	
-      for (i = 0; i < k; i++) {
-	for (j = 0; j < n; j++) {
-	  r[j][i] /=  nr[j];
-	} // mean i
-      } // data point j
-      
+    std::vector<Int_t> nit(nk, 0);
+    std::vector<Bool_t> active(nk, kTRUE);
+    Int_t nactive = nk;
+
+    while(nactive > 0) {
+      for (Int_t ik = 0; ik < nk; ik++) {
+	if (!active[ik]) continue;
+	nit[ik]++;
+	const Int_t i0 = off[ik];
+	const Int_t ki = k[ik];
+	Double_t* ri  = r.data() + i0 * n;
+	Double_t* nri = nr.data() + ik * n;
+	//
+	// Assignment step
+	//
+	for (Int_t i = i0; i < i0 + ki; i++) {
+	  norm[i] = pi[i] / (2. * cs2[i] * TMath::Pi() * TMath::Pi());
+	  s[i]    = 0.5 / cs2[i];
+	}
+	std::fill(nri, nri + n, 0.);
+	Responsibilities(ki, n, x, y, &cmx[i0], &cmy[i0], &norm[i0], &s[i0], &s[i0], ri, nri);
+	Normalise(ki, n, ri, nri);
 	//
 	// Update step
-      Double_t di = 0;
-      
-      for (i = 0; i < k; i++) {
-	  Double_t oldx = mx[i];
-	  Double_t oldy = my[i];
-	  
-	  mx[i] = x[0];
-	  my[i] = y[0];
-	  rk[i] = r[0][i];
-	for (j = 1; j < n; j++) {
-	    Double_t xx =  x[j];
-//
-// Here we have to take into acount the cylinder topology where phi is defined mod 2xpi
-// If two coordinates are separated by more than pi in phi one has to be shifted by +/- 2 pi
-
-	    Double_t dx = mx[i] - x[j];
-	    if (dx >  TMath::Pi()) xx += 2. * TMath::Pi();
-	    if (dx < -TMath::Pi()) xx -= 2. * TMath::Pi();
-	    if (r[j][i] > 1.e-15) {
-	      mx[i] = mx[i] * rk[i] + r[j][i] * xx;
-	      my[i] = my[i] * rk[i] + r[j][i] * y[j];
-	      rk[i] += r[j][i];
-	      mx[i] /= rk[i];
-	      my[i] /= rk[i];	
-	    }    
-	    if (mx[i] > 2. * TMath::Pi()) mx[i] -= 2. * TMath::Pi();
-	    if (mx[i] < 0.              ) mx[i] += 2. * TMath::Pi();
-	} // Data
-	di += d(mx[i], my[i], oldx, oldy);
-
-      } // means 
-      //
-      // Sigma
-      for (i = 0; i < k; i++) {
-	sigma2[i] = 0.;
-	for (j = 0; j < n; j++) {
-	  sigma2[i] += r[j][i] * d(mx[i], my[i], x[j], y[j]);
-	} // Data
-	sigma2[i] /= rk[i];
-	if (sigma2[i] < 0.0025) sigma2[i] = 0.0025;
-      } // Clusters    
-      //
-      // Fractions
-      for (i = 0; i < k; i++) pi[i] = rk[i] / Double_t(n);
-      //
-// ending condition
-      if (di < 1.e-8 || nit > 1000) break;
+	Double_t di = 0;
+	for (Int_t i = i0; i < i0 + ki; i++) 
+	  di += UpdateMean(n, x, y, r.data() + i * n, cmx[i], cmy[i], crk[i], 1.e-15);
+	//
+	// Sigma
+	for (Int_t i = i0; i < i0 + ki; i++) {
+	  Double_t sx2, sy2;
+	  Sigma2(n, x, y, r.data() + i * n, cmx[i], cmy[i], crk[i], sx2, sy2);
+	  cs2[i] = 0.5 * (sx2 + sy2);
+	  if (cs2[i] < 0.0025) cs2[i] = 0.0025;
+	} // Clusters    
+	//
+	// Fractions
+	for (Int_t i = i0; i < i0 + ki; i++) pi[i] = crk[i] / Double_t(n);
+	//
+	// ending condition
+	if (di < 1.e-8 || nit[ik] > 1000) {
+	  active[ik] = kFALSE;
+	  nactive--;
+	}
+      } // groups
     } // while
 
-// Clean-up    
-    delete[] nr;
-    delete[] pi;
-    for (j = 0; j < n; j++) delete[] r[j];
-    delete[] r;
+    Int_t converged = 1;
+    for (Int_t ik = 0; ik < nk; ik++) {
+	std::copy(cmx.begin() + off[ik], cmx.begin() + off[ik + 1], mx[ik]);
+	std::copy(cmy.begin() + off[ik], cmy.begin() + off[ik + 1], my[ik]);
+	std::copy(cs2.begin() + off[ik], cs2.begin() + off[ik + 1], sigma2[ik]);
+	std::copy(crk.begin() + off[ik], crk.begin() + off[ik + 1], rk[ik]);
+	if (nit[ik] >= 1000) converged = 0;
+    }
 // 
-    return (nit < 1000);
+    return converged;
 }
 
 Int_t AliKMeansClustering::SoftKMeans3(Int_t k, Int_t n, Double_t* x, Double_t* y, Double_t* mx, Double_t* my , 
@@ -256,38 +321,28 @@ Int_t AliKMeansClustering::SoftKMeans3(Int_t k, Int_t n, Double_t* x, Double_t*
     // 
      OptimalInit(k, n, x, y, mx, my);
     //
-    // (2a) The responsibilities
-    Double_t** r = new Double_t*[n]; // responsibilities
-    for (j = 0; j < n; j++) {r[j] = new Double_t[k];}
+    // (2a) The responsibilities, r[i * n + j] for mean i and data point j
+    std::vector<Double_t> r(k * n);
     //
     // (2b) Normalisation
-    Double_t* nr = new Double_t[n];
+    std::vector<Double_t> nr(n, 0.);
     //
-    // (2c) Weights 
-    Double_t* pi = new Double_t[k];
+    // (2c) Weights and kernel parameters
+    std::vector<Double_t> pi(k), norm(k, 1.), sx(k, 0.5 * fBeta), sy(k, 0.5 * fBeta);
     //
     //
     // (2d) Initialise the responsibilties and weights
-    for (j = 0; j < n; j++) {
-      nr[j] = 0.;
-      for (i = 0; i < k; i++) {
-
-	r[j][i] = TMath::Exp(- fBeta * d(mx[i], my[i], x[j], y[j]));
-	nr[j] += r[j][i];
-      } // mean i
-    } // data point j
+    Responsibilities(k, n, x, y, mx, my, norm.data(), sx.data(), sy.data(), r.data(), nr.data());
+    Normalise(k, n, r.data(), nr.data());
     
     for (i = 0; i < k; i++) {
       rk[i]    = 0.;
       sigmax2[i] = 1./fBeta;
       sigmay2[i] = 1./fBeta;
  
-      for (j = 0; j < n; j++) {
-	r[j][i] /=  nr[j];
-	rk[i] += r[j][i];
-      } // mean i
+      for (j = 0; j < n; j++) rk[i] += r[i * n + j];
       pi[i] = rk[i] / Double_t(n);
-    } // data point j
+    } // mean i
     // (3) Iterations
     Int_t nit = 0;
 
@@ -296,73 +351,25 @@ Int_t AliKMeansClustering::SoftKMeans3(Int_t k, Int_t n, Double_t* x, Double_t*
       //
       // Assignment step
       //
-      for (j = 0; j < n; j++) {
-	nr[j] = 0.;
-	for (i = 0; i < k; i++) {
-
-	  Double_t dx = TMath::Abs(mx[i]-x[j]);
-	  if (dx > TMath::Pi()) dx = 2. * TMath::Pi() - dx;
-	  Double_t dy = TMath::Abs(my[i]-y[j]);
-	  r[j][i] = pi[i] * TMath::Exp(-0.5 *  (dx * dx / sigmax2[i] + dy * dy / sigmay2[i])) 
-	    / (2. * TMath::Sqrt(sigmax2[i] * sigmay2[i]) * TMath::Pi() * TMath::Pi());
-	  nr[j] += r[j][i];
-	} // mean i
-      } // data point j
-	
       for (i = 0; i < k; i++) {
-	for (j = 0; j < n; j++) {
-	  r[j][i] /=  nr[j];
-	} // mean i
-      } // data point j
+	norm[i] = pi[i] / (2. * TMath::Sqrt(sigmax2[i] * sigmay2[i]) * TMath::Pi() * TMath::Pi());
+	sx[i]   = 0.5 / sigmax2[i];
+	sy[i]   = 0.5 / sigmay2[i];
+      }
+      std::fill(nr.begin(), nr.end(), 0.);
+      Responsibilities(k, n, x, y, mx, my, norm.data(), sx.data(), sy.data(), r.data(), nr.data());
+      Normalise(k, n, r.data(), nr.data());
       
 	//
 	// Update step
       Double_t di = 0;
       
-      for (i = 0; i < k; i++) {
-	  Double_t oldx = mx[i];
-	  Double_t oldy = my[i];
-	  
-	  mx[i] = x[0];
-	  my[i] = y[0];
-	  rk[i] = r[0][i];
-	for (j = 1; j < n; j++) {
-	    Double_t xx =  x[j];
-//
-// Here we have to take into acount the cylinder topology where phi is defined mod 2xpi
-// If two coordinates are separated by more than pi in phi one has to be shifted by +/- 2 pi
-
-	    Double_t dx = mx[i] - x[j];
-	    if (dx >  TMath::Pi()) xx += 2. * TMath::Pi();
-	    if (dx < -TMath::Pi()) xx -= 2. * TMath::Pi();
-	    if (r[j][i] > 1.e-15) {
-	      mx[i] = mx[i] * rk[i] + r[j][i] * xx;
-	      my[i] = my[i] * rk[i] + r[j][i] * y[j];
-	      rk[i] += r[j][i];
-	      mx[i] /= rk[i];
-	      my[i] /= rk[i];	
-	    }    
-	    if (mx[i] > 2. * TMath::Pi()) mx[i] -= 2. * TMath::Pi();
-	    if (mx[i] < 0.              ) mx[i] += 2. * TMath::Pi();
-	} // Data
-	di += d(mx[i], my[i], oldx, oldy);
-
-      } // means 
+      for (i = 0; i < k; i++) 
+	di += UpdateMean(n, x, y, r.data() + i * n, mx[i], my[i], rk[i], 1.e-15);
       //
       // Sigma
       for (i = 0; i < k; i++) {
-	sigmax2[i] = 0.;
-	sigmay2[i] = 0.;
-
-	for (j = 0; j < n; j++) {
-	  Double_t dx = TMath::Abs(mx[i]-x[j]);
-	  if (dx > TMath::Pi()) dx = 2. * TMath::Pi() - dx;
-	  Double_t dy = TMath::Abs(my[i]-y[j]);
-	  sigmax2[i] += r[j][i] * dx * dx;
-	  sigmay2[i] += r[j][i] * dy * dy;
-	} // Data
-	sigmax2[i] /= rk[i];
-	sigmay2[i] /= rk[i];
+	Sigma2(n, x, y, r.data() + i * n, mx[i], my[i], rk[i], sigmax2[i], sigmay2[i]);
 	if (sigmax2[i] < 0.0025) sigmax2[i] = 0.0025;
 	if (sigmay2[i] < 0.0025) sigmay2[i] = 0.0025;
       } // Clusters    
@@ -374,11 +381,6 @@ Int_t AliKMeansClustering::SoftKMeans3(Int_t k, Int_t n, Double_t* x, Double_t*
       if (di < 1.e-8 || nit > 1000) break;
     } // while
 
-// Clean-up    
-    delete[] nr;
-    delete[] pi;
-    for (j = 0; j < n; j++) delete[] r[j];
-    delete[] r;
 // 
     return (nit < 1000);
 }
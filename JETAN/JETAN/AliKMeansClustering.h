@@ -13,6 +13,8 @@
 // andreas.morsch@cern.ch
 
 #include <TObject.h>
+
+class AliKMeansResult;
  
 class AliKMeansClustering : public TObject
 {
@@ -23,12 +25,27 @@ class AliKMeansClustering : public TObject
   static Int_t SoftKMeans (Int_t k, Int_t n, const Double_t* x, const Double_t* y, Double_t* mx, Double_t* my , Double_t* rk );
   static Int_t SoftKMeans2(Int_t k, Int_t n, Double_t* x, Double_t* y, Double_t* mx, Double_t* my , Double_t* sigma2, 
 			  Double_t* rk );
+  // Several k values in one pass, sharing the data point arrays
+  static Int_t SoftKMeans2(Int_t nk, const Int_t* k, Int_t n, const Double_t* x, const Double_t* y, AliKMeansResult** res);
   static Int_t SoftKMeans3(Int_t k, Int_t n, Double_t* x, Double_t* y, Double_t* mx, Double_t* my , 
 			   Double_t* sigmax2, Double_t* sigmay2, Double_t* rk );
   static void  OptimalInit(Int_t k, Int_t n, const Double_t* x, const Double_t* y, Double_t* mx, Double_t* my);
   static void  SetBeta(Double_t beta) {fBeta = beta;}
   static Double_t d(Double_t mx, Double_t my, Double_t x, Double_t y);
 protected:
+  static Int_t SoftKMeans2(Int_t nk, const Int_t* k, Int_t n, const Double_t* x, const Double_t* y,
+			   Double_t** mx, Double_t** my, Double_t** sigma2, Double_t** rk);
+  // Kernels on contiguous arrays, responsibilities stored as r[i * n + j] for mean i and point j
+  static void     Responsibilities(Int_t k, Int_t n, const Double_t* x, const Double_t* y,
+				   const Double_t* mx, const Double_t* my,
+				   const Double_t* norm, const Double_t* sx, const Double_t* sy,
+				   Double_t* r, Double_t* nr);
+  static void     Normalise(Int_t k, Int_t n, Double_t* r, Double_t* nr);
+  static Double_t UpdateMean(Int_t n, const Double_t* x, const Double_t* y, const Double_t* ri,
+			     Double_t& mx, Double_t& my, Double_t& rk, Double_t rmin);
+  static void     Sigma2(Int_t n, const Double_t* x, const Double_t* y, const Double_t* ri,
+			 Double_t mx, Double_t my, Double_t rk, Double_t& sigmax2, Double_t& sigmay2);
+
   static Double_t fBeta; // beta parameter
   
   ClassDef(AliKMeansClustering, 1)
@@ -27,6 +27,8 @@
 // Versions V1 and V2 merged
 //---------------------------------------------------------------------
 
+#include <algorithm>
+
 #include <TH2F.h>
 #include <TMath.h>
 
@@ -44,7 +46,20 @@ ClassImp(AliUA1JetFinder)
 AliUA1JetFinder::AliUA1JetFinder():
   AliJetFinder(),
   fLego(0),  
-  fJetBkg(new AliJetBkg())
+  fJetBkg(new AliJetBkg()),
+  fNCells(0),
+  fPhiPeriodic(kFALSE),
+  fEtCell(),
+  fEtaCell(),
+  fPhiCell(),
+  fFlagCell(),
+  fCellIndex(),
+  fCellRank(),
+  fSeedStencilEta(),
+  fSeedStencilPhi(),
+  fConeStencilEta(),
+  fConeStencilPhi(),
+  fCellsAround()
 {
   // Default constructor
 }
@@ -118,6 +133,9 @@ void AliUA1JetFinder::FindJets()
     etbgTotal+= ptT[i];
     etbg2 += ptT[i]*ptT[i];
   }
+
+  // the lego does not change between the background iterations
+  FillLattice();
   
   // calculate total energy and fluctuation in map
   Double_t meanpt = 0.;
@@ -306,38 +324,18 @@ void AliUA1JetFinder::RunAlgoritm(Float_t etbgTotal, Double_t dEtTotal, Int_t& n
 				  Float_t* const etJet,Float_t* const etaJet, Float_t* const phiJet,
 				  Float_t* const etallJet, Int_t* const ncellsJet)
 {
-  // Dump lego
+  // Cells are taken from the lattice filled by FillLattice()
   AliUA1JetHeader* header = (AliUA1JetHeader*) fHeader;
-  const Int_t nBinsMax = 120000; // we use a fixed array not to fragment memory 
- 
-  const Int_t nBinEta = header->GetLegoNbinEta();
-  const Int_t nBinPhi = header->GetLegoNbinPhi();
-  if((nBinPhi*nBinEta)>nBinsMax){
-    AliError("Too many bins of the ETA-PHI histogram");
-  }
+  const Int_t nCell = fNCells;
+  for (Int_t icell = 0; icell < nCell; icell++) fFlagCell[fCellIndex[icell]] = 0; //default
+
+  Float_t* const etCell   = fEtCell.data();
+  Float_t* const etaCell  = fEtaCell.data();
+  Float_t* const phiCell  = fPhiCell.data();
+  Short_t* const flagCell = fFlagCell.data();
+  const Int_t*   cellRank = fCellRank.data();
+  const Int_t    nBinPhi  = header->GetLegoNbinPhi();
 
-  Float_t etCell[nBinsMax] = {0.};   //! Cell Energy
-  Float_t etaCell[nBinsMax] = {0.};  //! Cell eta
-  Float_t phiCell[nBinsMax] = {0.};  //! Cell phi
-  Short_t flagCell[nBinsMax] = {0}; //! Cell flag
-  
-  Int_t nCell = 0;
-  TAxis* xaxis = fLego->GetXaxis();
-  TAxis* yaxis = fLego->GetYaxis();
-  Float_t e = 0.0;
-  for (Int_t i = 1; i <= nBinEta; i++) {
-    for (Int_t j = 1; j <= nBinPhi; j++) {
-      e = fLego->GetBinContent(i,j);
-      if (e < 0.0) continue; // don't include this cells
-      Float_t eta  = xaxis->GetBinCenter(i);
-      Float_t phi  = yaxis->GetBinCenter(j);
-      etCell[nCell]  = e;
-      etaCell[nCell] = eta;
-      phiCell[nCell] = phi;
-      flagCell[nCell] = 0; //default
-      nCell++;
-    }
-  }
   // Parameters from header
   Float_t minmove = header->GetMinMove();
   Float_t maxmove = header->GetMaxMove();
@@ -351,9 +349,8 @@ void AliUA1JetFinder::RunAlgoritm(Float_t etbgTotal, Double_t dEtTotal, Int_t& n
 
   // Run algorithm//
   
-  // Sort cells by et
-  Int_t index[nBinsMax];
-  TMath::Sort(nCell, etCell, index);
+  // Cells sorted by et
+  const Int_t* index = fCellIndex.data();
   // variable used in centroide loop
   Float_t eta   = 0.0;
   Float_t phi   = 0.0;
@@ -390,9 +387,15 @@ void AliUA1JetFinder::RunAlgoritm(Float_t etbgTotal, Double_t dEtTotal, Int_t& n
       etsb = ets;
       etasb = 0.0;
       phisb = 0.0;
-      for(Int_t kcell =0; kcell < nCell; kcell++)
+      // only the cells within rc + maxmove of the seed can enter the cone,
+      // looped over in the et order
+      GetCellsAround(jcell / nBinPhi, jcell % nBinPhi, fSeedStencilEta, fSeedStencilPhi, fCellsAround);
+      std::sort(fCellsAround.begin(), fCellsAround.end(),
+		[cellRank](Int_t c1, Int_t c2) { return cellRank[c1] < cellRank[c2]; });
+      const Int_t nCellAround = fCellsAround.size();
+      for(Int_t kcell =0; kcell < nCellAround; kcell++)
 	{
-	  Int_t lcell = index[kcell];
+	  Int_t lcell = fCellsAround[kcell];
 	  if(lcell == jcell) continue; // cell itself
 	  if(flagCell[lcell] != 0) continue; // cell used before
 	  if(etCell[lcell] > etCell[jcell]) continue; // can this happen
@@ -444,8 +447,16 @@ void AliUA1JetFinder::RunAlgoritm(Float_t etbgTotal, Double_t dEtTotal, Int_t& n
       Int_t   nCellIn  = 0;
       rc = header->GetRadius();
 
-      for(Int_t ncell =0; ncell < nCell; ncell++)
+      // cells around the lattice cell containing the cone axis, in the cell order
+      Int_t ietaCone = TMath::FloorNint((eta - header->GetLegoEtaMin()) / fLego->GetXaxis()->GetBinWidth(1));
+      Int_t iphiCone = TMath::FloorNint((phi - header->GetLegoPhiMin()) / fLego->GetYaxis()->GetBinWidth(1));
+      GetCellsAround(ietaCone, iphiCone, fConeStencilEta, fConeStencilPhi, fCellsAround);
+      std::sort(fCellsAround.begin(), fCellsAround.end());
+      const Int_t nCellCone = fCellsAround.size();
+
+      for(Int_t kcell =0; kcell < nCellCone; kcell++)
 	{
+	  Int_t ncell = fCellsAround[kcell];
 	  if(flagCell[ncell] != 0) continue; // cell used before
 	  //calculate dr
 	  deta = etaCell[ncell] - eta;
@@ -469,7 +480,8 @@ void AliUA1JetFinder::RunAlgoritm(Float_t etbgTotal, Double_t dEtTotal, Int_t& n
       Double_t etcmin = etCone ;  // could be used etCone - etmin !!
       //decisions !! etbmax < etcmin
       
-      for(Int_t mcell =0; mcell < nCell; mcell++){
+      for(Int_t kcell =0; kcell < nCellCone; kcell++){
+	Int_t mcell = fCellsAround[kcell];
 	if(flagCell[mcell] == -1){
 	  if(etbmax < etcmin)
 	    flagCell[mcell] = 1; //flag cell as used
@@ -533,6 +545,117 @@ void AliUA1JetFinder::Init()
 		   header->GetLegoNbinEta(), header->GetLegoEtaMin(),
 		   header->GetLegoEtaMax(),  header->GetLegoNbinPhi(),
 		   header->GetLegoPhiMin(),  header->GetLegoPhiMax());
-  
+
+  // cell lattice and stencils
+  Int_t nBins = header->GetLegoNbinEta() * header->GetLegoNbinPhi();
+  fEtCell.assign(nBins, 0.);
+  fEtaCell.assign(nBins, 0.);
+  fPhiCell.assign(nBins, 0.);
+  fFlagCell.assign(nBins, 0);
+  fCellIndex.assign(nBins, 0);
+  fCellRank.assign(nBins, -1);
+  fCellsAround.reserve(nBins);
+  fNCells = 0;
+
+  fPhiPeriodic = TMath::Abs(header->GetLegoPhiMax() - header->GetLegoPhiMin() - 2. * TMath::Pi()) < 1.e-4;
+
+  // the centroid moves at most by maxmove from the seed cell centre
+  BuildStencil(header->GetRadius() + header->GetMaxMove(), fSeedStencilEta, fSeedStencilPhi);
+  // the final cone axis is at most half a cell diagonal from the centre of its cell
+  Double_t halfDiag = 0.5 * TMath::Sqrt(fLego->GetXaxis()->GetBinWidth(1) * fLego->GetXaxis()->GetBinWidth(1) +
+					fLego->GetYaxis()->GetBinWidth(1) * fLego->GetYaxis()->GetBinWidth(1));
+  BuildStencil(header->GetRadius() + halfDiag, fConeStencilEta, fConeStencilPhi);
+
+}
+
+//-----------------------------------------------------------------------
+void AliUA1JetFinder::FillLattice()
+{
+  // Dump the lego into the cell lattice and sort the cells by et.
+  // Cells with negative et are not used, as in the lego loop before.
+  AliUA1JetHeader* header = (AliUA1JetHeader*) fHeader;
+  const Int_t nBinEta = header->GetLegoNbinEta();
+  const Int_t nBinPhi = header->GetLegoNbinPhi();
+
+  TAxis* xaxis = fLego->GetXaxis();
+  TAxis* yaxis = fLego->GetYaxis();
+
+  // et of the used cells in the cell order, for the sorting
+  std::vector<Float_t> etUsed(nBinEta * nBinPhi);
+  std::vector<Int_t>   cellUsed(nBinEta * nBinPhi);
+  std::vector<Int_t>   index(nBinEta * nBinPhi);
+
+  fNCells = 0;
+  for (Int_t i = 1; i <= nBinEta; i++) {
+    for (Int_t j = 1; j <= nBinPhi; j++) {
+      Int_t cell = (i - 1) * nBinPhi + (j - 1);
+      Float_t e = fLego->GetBinContent(i,j);
+      fEtCell[cell]   = e;
+      fEtaCell[cell]  = xaxis->GetBinCenter(i);
+      fPhiCell[cell]  = yaxis->GetBinCenter(j);
+      fFlagCell[cell] = 0;
+      fCellRank[cell] = -1;
+      if (e < 0.0) continue; // don't include this cells
+      etUsed[fNCells] = e;
+      cellUsed[fNCells] = cell;
+      fNCells++;
+    }
+  }
+
+  TMath::Sort(fNCells, etUsed.data(), index.data());
+  for (Int_t icell = 0; icell < fNCells; icell++) {
+    fCellIndex[icell] = cellUsed[index[icell]];
+    fCellRank[fCellIndex[icell]] = icell;
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliUA1JetFinder::BuildStencil(Float_t radius, std::vector<Int_t>& stencilEta, std::vector<Int_t>& stencilPhi) const
+{
+  // Offsets of the cells with the centre within radius of the centre of a cell
+  Double_t binEta = fLego->GetXaxis()->GetBinWidth(1);
+  Double_t binPhi = fLego->GetYaxis()->GetBinWidth(1);
+  Double_t r2 = radius * radius * (1. + 1.e-4); // rounding of the bin centres
+
+  Int_t nEta = TMath::CeilNint(radius / binEta);
+  Int_t nPhi = TMath::CeilNint(radius / binPhi);
+
+  stencilEta.clear();
+  stencilPhi.clear();
+  for (Int_t i = -nEta; i <= nEta; i++) {
+    for (Int_t j = -nPhi; j <= nPhi; j++) {
+      if (i * i * binEta * binEta + j * j * binPhi * binPhi > r2) continue;
+      stencilEta.push_back(i);
+      stencilPhi.push_back(j);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliUA1JetFinder::GetCellsAround(Int_t ieta, Int_t iphi, const std::vector<Int_t>& stencilEta,
+				     const std::vector<Int_t>& stencilPhi, std::vector<Int_t>& cells) const
+{
+  // Used cells of the stencil around cell (ieta, iphi), wrapped in phi.
+  // If the lego does not cover the full azimuth, all the used cells are returned
+  // (in the et order, callers sort them as needed).
+  AliUA1JetHeader* header = (AliUA1JetHeader*) fHeader;
+  const Int_t nBinEta = header->GetLegoNbinEta();
+  const Int_t nBinPhi = header->GetLegoNbinPhi();
+
+  cells.clear();
+  // a stencil wider than the lattice in phi would visit cells twice
+  if (!fPhiPeriodic || 2 * (*std::max_element(stencilPhi.begin(), stencilPhi.end())) + 1 > nBinPhi) {
+    cells.assign(fCellIndex.begin(), fCellIndex.begin() + fNCells);
+    return;
+  }
+
+  for (UInt_t k = 0; k < stencilEta.size(); k++) {
+    Int_t i = ieta + stencilEta[k];
+    if (i < 0 || i >= nBinEta) continue;
+    Int_t j = ((iphi + stencilPhi[k]) % nBinPhi + nBinPhi) % nBinPhi;
+    Int_t cell = i * nBinPhi + j;
+    if (fCellRank[cell] < 0) continue;
+    cells.push_back(cell);
+  }
 }
 
@@ -16,6 +16,8 @@
 // Versions V1 and V2 merged
 //---------------------------------------------------------------------
 
+#include <vector>
+
 #include "AliJetFinder.h"
 
 class TH2F;
@@ -44,11 +46,32 @@ class AliUA1JetFinder : public AliJetFinder
   AliUA1JetFinder(const AliUA1JetFinder& rJetF1);
   AliUA1JetFinder& operator = (const AliUA1JetFinder& rhsf);
 
+  void FillLattice();
+  void BuildStencil(Float_t radius, std::vector<Int_t>& stencilEta, std::vector<Int_t>& stencilPhi) const;
+  void GetCellsAround(Int_t ieta, Int_t iphi, const std::vector<Int_t>& stencilEta,
+		      const std::vector<Int_t>& stencilPhi, std::vector<Int_t>& cells) const;
+
   TH2F*       fLego;          //  Lego Histo
 
   AliJetBkg*  fJetBkg;        //! pointer to bkg class
 
-  ClassDef(AliUA1JetFinder,3) //  UA1 jet finder
+  // Cell lattice, dumped from the lego once per event and shared by all background iterations
+  // cells are indexed as ieta * nBinPhi + iphi
+  Int_t                fNCells;          //! number of cells used by the algorithm
+  Bool_t               fPhiPeriodic;     //! lego covers the full azimuth, stencils wrap in phi
+  std::vector<Float_t> fEtCell;          //! cell energy
+  std::vector<Float_t> fEtaCell;         //! cell eta
+  std::vector<Float_t> fPhiCell;         //! cell phi
+  std::vector<Short_t> fFlagCell;        //! cell flag
+  std::vector<Int_t>   fCellIndex;       //! cells sorted by energy
+  std::vector<Int_t>   fCellRank;        //! position of the cell in fCellIndex, -1 if not used
+  std::vector<Int_t>   fSeedStencilEta;  //! eta offsets of the cells reachable by the centroid search
+  std::vector<Int_t>   fSeedStencilPhi;  //! phi offsets of the cells reachable by the centroid search
+  std::vector<Int_t>   fConeStencilEta;  //! eta offsets of the cells which can be in the final cone
+  std::vector<Int_t>   fConeStencilPhi;  //! phi offsets of the cells which can be in the final cone
+  std::vector<Int_t>   fCellsAround;     //! work array of the cells around a seed / cone
+
+  ClassDef(AliUA1JetFinder,4) //  UA1 jet finder
 
 };
 
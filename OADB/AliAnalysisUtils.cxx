@@ -8,13 +8,80 @@
 #include "AliVEvent.h"
 #include <TMatrixDSym.h>
 #include <TMath.h>
+#include <vector>
 #include "AliVMultiplicity.h"
 #include "AliPPVsMultUtils.h"
+#include "AliAnalysisManager.h"
 
 #include "AliAnalysisUtils.h"
 
 ClassImp(AliAnalysisUtils)
 
+namespace {
+  // Results of the event checks of the current entry of the analysis manager,
+  // shared by all the AliAnalysisUtils instances of the train. Each result is
+  // stored with the event and the cut values it was evaluated with, so that
+  // instances with different settings do not see each other's results.
+  enum ECheck { kVertex2013pA, kPileUpMV, kPileUpSPD, kOutOfBunch, kSPDClsVsTrkBG };
+  const Int_t kNPar = 6; // max. number of cut values of a check
+
+  struct CachedCheck {
+    const AliVEvent *fEvent;
+    Int_t            fCheck;
+    Double_t         fPar[kNPar];
+    Bool_t           fResult;
+  };
+
+  struct CachedPercentile {
+    const AliVEvent *fEvent;
+    TString          fMethod;
+    Bool_t           fEmbedEventSelection;
+    Float_t          fResult;
+  };
+
+  Long64_t                      gCacheEntry = -1;
+  std::vector<CachedCheck>      gCachedChecks;
+  std::vector<CachedPercentile> gCachedPercentiles;
+
+  // Current entry of the analysis manager, -1 (no caching) outside of a train.
+  // The cache is emptied when the entry changes.
+  Long64_t CurrentEntry()
+  {
+    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+    Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+    if(entry != gCacheEntry) {
+      gCacheEntry = entry;
+      gCachedChecks.clear();
+      gCachedPercentiles.clear();
+    }
+    return entry;
+  }
+
+  CachedCheck *FindCheck(const AliVEvent *event, Int_t check, const Double_t *par)
+  {
+    if(CurrentEntry() < 0) return 0x0;
+    for(std::vector<CachedCheck>::iterator it = gCachedChecks.begin(); it != gCachedChecks.end(); ++it) {
+      if(it->fEvent != event || it->fCheck != check) continue;
+      Int_t ipar = 0;
+      while(ipar < kNPar && it->fPar[ipar] == par[ipar]) ipar++;
+      if(ipar == kNPar) return &(*it);
+    }
+    return 0x0;
+  }
+
+  Bool_t StoreCheck(const AliVEvent *event, Int_t check, const Double_t *par, Bool_t result)
+  {
+    if(gCacheEntry < 0) return result;
+    CachedCheck cached;
+    cached.fEvent = event;
+    cached.fCheck = check;
+    for(Int_t ipar = 0; ipar < kNPar; ipar++) cached.fPar[ipar] = par[ipar];
+    cached.fResult = result;
+    gCachedChecks.push_back(cached);
+    return result;
+  }
+}
+
 //______________________________________________________________________
 AliAnalysisUtils::AliAnalysisUtils():TObject(),
   fisAOD(kTRUE),
@@ -42,6 +109,16 @@ AliAnalysisUtils::AliAnalysisUtils():TObject(),
 
 //______________________________________________________________________
 Bool_t AliAnalysisUtils::IsVertexSelected2013pA(AliVEvent *event)
+{
+  // cached per event and cut values
+  Double_t par[kNPar] = {Double_t(fMinVtxContr), fMaxVtxZ, Double_t(fCutOnZVertexSPD), 0., 0., 0.};
+  const CachedCheck *cached = FindCheck(event, kVertex2013pA, par);
+  if(cached) return cached->fResult;
+  return StoreCheck(event, kVertex2013pA, par, CheckVertexSelected2013pA(event));
+}
+
+//______________________________________________________________________
+Bool_t AliAnalysisUtils::CheckVertexSelected2013pA(AliVEvent *event)
 {
   Bool_t accept = kFALSE;
   
@@ -142,6 +219,16 @@ Bool_t AliAnalysisUtils::IsPileUpEvent(AliVEvent *event)
 
 //______________________________________________________________________
 Bool_t AliAnalysisUtils::IsPileUpMV(AliVEvent *event)
+{
+  // check for multi-vertexer pile-up, cached per event and cut values
+  Double_t par[kNPar] = {Double_t(fMinPlpContribMV), fMaxPlpChi2MV, fMinWDistMV, Double_t(fCheckPlpFromDifferentBCMV), 0., 0.};
+  const CachedCheck *cached = FindCheck(event, kPileUpMV, par);
+  if(cached) return cached->fResult;
+  return StoreCheck(event, kPileUpMV, par, CheckPileUpMV(event));
+}
+
+//______________________________________________________________________
+Bool_t AliAnalysisUtils::CheckPileUpMV(AliVEvent *event)
 {
   // check for multi-vertexer pile-up
   const AliAODEvent *aod = dynamic_cast<const AliAODEvent*>(event);
@@ -191,6 +278,16 @@ Bool_t AliAnalysisUtils::IsPileUpMV(AliVEvent *event)
 
 //______________________________________________________________________
 Bool_t AliAnalysisUtils::IsPileUpSPD(AliVEvent *event)
+{
+  // check for SPD pile-up, cached per event and cut values
+  Double_t par[kNPar] = {Double_t(fUseSPDCutInMultBins), Double_t(fMinPlpContribSPD), fMinPlpZdistSPD, fnSigmaPlpZdistSPD, fnSigmaPlpDiamXYSPD, fnSigmaPlpDiamZSPD};
+  const CachedCheck *cached = FindCheck(event, kPileUpSPD, par);
+  if(cached) return cached->fResult;
+  return StoreCheck(event, kPileUpSPD, par, CheckPileUpSPD(event));
+}
+
+//______________________________________________________________________
+Bool_t AliAnalysisUtils::CheckPileUpSPD(AliVEvent *event)
 {
   // check for SPD pile-up
   const AliAODEvent *aod = dynamic_cast<const AliAODEvent*>(event);
@@ -208,7 +305,17 @@ Bool_t AliAnalysisUtils::IsPileUpSPD(AliVEvent *event)
 //______________________________________________________________________
 Bool_t AliAnalysisUtils::IsOutOfBunchPileUp(AliVEvent *event)
 {
-  // check for SPD pile-up
+  // check for out-of-bunch pile-up, cached per event
+  Double_t par[kNPar] = {0., 0., 0., 0., 0., 0.};
+  const CachedCheck *cached = FindCheck(event, kOutOfBunch, par);
+  if(cached) return cached->fResult;
+  return StoreCheck(event, kOutOfBunch, par, CheckOutOfBunchPileUp(event));
+}
+
+//______________________________________________________________________
+Bool_t AliAnalysisUtils::CheckOutOfBunchPileUp(AliVEvent *event)
+{
+  // check for out-of-bunch pile-up
   const AliAODEvent *aod = dynamic_cast<const AliAODEvent*>(event);
   const AliESDEvent *esd = dynamic_cast<const AliESDEvent*>(event);
   //
@@ -230,6 +337,15 @@ Bool_t AliAnalysisUtils::IsOutOfBunchPileUp(AliVEvent *event)
 
 //______________________________________________________________________
 Bool_t AliAnalysisUtils::IsSPDClusterVsTrackletBG(AliVEvent *event){
+  // cached per event and cut values
+  Double_t par[kNPar] = {fASPDCvsTCut, fBSPDCvsTCut, 0., 0., 0., 0.};
+  const CachedCheck *cached = FindCheck(event, kSPDClsVsTrkBG, par);
+  if(cached) return cached->fResult;
+  return StoreCheck(event, kSPDClsVsTrkBG, par, CheckSPDClusterVsTrackletBG(event));
+}
+
+//______________________________________________________________________
+Bool_t AliAnalysisUtils::CheckSPDClusterVsTrackletBG(AliVEvent *event){
   Int_t nClustersLayer0 = event->GetNumberOfITSClusters(0);
   Int_t nClustersLayer1 = event->GetNumberOfITSClusters(1);
   Int_t nTracklets      = event->GetMultiplicity()->GetNumberOfTracklets();
@@ -269,9 +385,26 @@ Double_t AliAnalysisUtils::GetWDist(const AliVVertex* v0, const AliVVertex* v1)
 
 //______________________________________________________________________
 Float_t AliAnalysisUtils::GetMultiplicityPercentile(AliVEvent *event, TString lMethod, Bool_t lEmbedEventSelection){
+  // cached per event, estimator and event selection flag
+  if(CurrentEntry() >= 0) {
+    for(std::vector<CachedPercentile>::const_iterator it = gCachedPercentiles.begin(); it != gCachedPercentiles.end(); ++it) {
+      if(it->fEvent == event && it->fEmbedEventSelection == lEmbedEventSelection && it->fMethod == lMethod) return it->fResult;
+    }
+  }
   if(!fPPVsMultUtils)
     fPPVsMultUtils=new AliPPVsMultUtils();
-  if( (event->InheritsFrom("AliAODEvent")) || (event->InheritsFrom("AliESDEvent")) ) return fPPVsMultUtils->GetMultiplicityPercentile(event,lMethod,lEmbedEventSelection);
+  if( (event->InheritsFrom("AliAODEvent")) || (event->InheritsFrom("AliESDEvent")) ) {
+    Float_t percentile = fPPVsMultUtils->GetMultiplicityPercentile(event,lMethod,lEmbedEventSelection);
+    if(gCacheEntry >= 0) {
+      CachedPercentile cached;
+      cached.fEvent = event;
+      cached.fMethod = lMethod;
+      cached.fEmbedEventSelection = lEmbedEventSelection;
+      cached.fResult = percentile;
+      gCachedPercentiles.push_back(cached);
+    }
+    return percentile;
+  }
   else {
     AliFatal("Event is neither of AOD nor ESD type"); 
     return -999.;
@@ -9,6 +9,9 @@
 // - identification of the fist event of the chunk                         //
 // - identification pileup events                                           //
 //                                                                          //
+// The results of the event checks are cached per event and cut values    //
+// and shared by all the instances of the train                            //
+//                                                                          //
 ///////////////////////////////////////////////////////////////////
 
 #include <TObject.h>
@@ -93,6 +96,13 @@ class AliAnalysisUtils : public TObject {
   
   AliPPVsMultUtils *fPPVsMultUtils; //! multiplicity selection in pp
 
+  // evaluation of the checks, bypassing the event cache
+  Bool_t CheckVertexSelected2013pA(AliVEvent *event);
+  Bool_t CheckPileUpMV(AliVEvent *event);
+  Bool_t CheckPileUpSPD(AliVEvent *event);
+  Bool_t CheckOutOfBunchPileUp(AliVEvent *event);
+  Bool_t CheckSPDClusterVsTrackletBG(AliVEvent *event);
+
   AliAnalysisUtils(const AliAnalysisUtils& obj); // copy constructor
   AliAnalysisUtils& operator=(const AliAnalysisUtils& other); // assignment
     
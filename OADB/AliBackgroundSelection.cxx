@@ -16,6 +16,11 @@
 // cut is more a quality selection cut than an event selection cut, so
 // it is effectively disabled by default.
 //
+// The fired trigger classes are taken from the trigger mask. The
+// histograms of each trigger class index are looked up by name the
+// first time the class fires in a run and then kept in a table, so
+// that no string is built or parsed per event.
+//
 // Author: Michele Floris, CERN
 // ----------------------------------------------------------------
 
@@ -28,6 +33,8 @@
 #include "AliAnalysisManager.h"
 #include "TTree.h"
 #include "AliMultiplicity.h"
+#include "AliESDEvent.h"
+#include "AliESDRun.h"
 #ifdef PASS1RECO
 #include "AliITSRecPoint.h"
 #endif
@@ -37,9 +44,10 @@
 ClassImp(AliBackgroundSelection)
 
 AliBackgroundSelection::AliBackgroundSelection():
-  AliAnalysisCuts(), fOutputHist(0), fACut(0), fBCut(0), fDeltaPhiCut(10)
+  AliAnalysisCuts(), fOutputHist(0), fACut(0), fBCut(0), fDeltaPhiCut(10), fClassTableRun(-1)
 {
   // ctor
+  ResetClassTable();
   fOutputHist = new TList();
   fOutputHist->SetOwner();
   fACut = 65;
@@ -48,9 +56,10 @@ AliBackgroundSelection::AliBackgroundSelection():
 }
 
 AliBackgroundSelection::AliBackgroundSelection(const char* name, const char* title):
-  AliAnalysisCuts(name,title), fOutputHist(0), fACut(0), fBCut(0), fDeltaPhiCut(10)
+  AliAnalysisCuts(name,title), fOutputHist(0), fACut(0), fBCut(0), fDeltaPhiCut(10), fClassTableRun(-1)
 {
   // ctor
+  ResetClassTable();
   fOutputHist = new TList();
   fOutputHist->SetOwner();
   fACut = 65;
@@ -60,9 +69,10 @@ AliBackgroundSelection::AliBackgroundSelection(const char* name, const char* tit
 }
 
 AliBackgroundSelection::AliBackgroundSelection(const AliBackgroundSelection& obj) : AliAnalysisCuts(obj),
-fOutputHist(0), fACut(0), fBCut(0), fDeltaPhiCut(0)
+fOutputHist(0), fACut(0), fBCut(0), fDeltaPhiCut(0), fClassTableRun(-1)
 {
   // copy ctor
+  ResetClassTable();
   fOutputHist  = obj.fOutputHist;
   fACut        = obj.fACut;
   fBCut        = obj.fBCut;
@@ -177,29 +187,18 @@ Bool_t AliBackgroundSelection::IsSelected(TObject* const obj)
   if (!isCvsTOk || !isDeltaPhiOk) SetSelected(kFALSE);
   else                            SetSelected(kTRUE );
 
-  // Fill control histos for all trigger classes
-  TString trgClasses = esdEv->GetFiredTriggerClasses();
-  TObjArray * tokens = trgClasses.Tokenize(" ");
-  TIter iter(tokens);
-  while(TObjString * tok = (TObjString*) iter.Next()){
-    // clean up trigger name
-    TString trg = tok->GetString();
-    trg.Strip(TString::kTrailing, ' ');
-    trg.Strip(TString::kLeading, ' ');
-    
-    // cluster vs tracklets
-    TH2F * hCvsT = GetClusterVsTrackletsHisto(trg.Data());
-    TH2F * hCvsTa = GetClusterVsTrackletsHistoAccepted(trg.Data());
-    hCvsT->Fill(ntracklet,spdClusters);
-    if(isCvsTOk) hCvsTa->Fill(ntracklet,spdClusters);
-
-    // Delta phi
-    TH1F * hDeltaPhi = GetDeltaPhiHisto(trg.Data());
-    TH1F * hDeltaPhia = GetDeltaPhiHistoAccepted(trg.Data());
-    hDeltaPhi->Fill(deltaPhi);
-    if(isDeltaPhiOk) hDeltaPhia->Fill(deltaPhi);
+  // Fill control histos for all fired trigger classes, in the same
+  // pass as the cut. The class table is rebuilt at run change, as
+  // the class indices are only valid within a run.
+  if(esdEv->GetRunNumber() != fClassTableRun) {
+    ResetClassTable();
+    fClassTableRun = esdEv->GetRunNumber();
+  }
+  const ULong64_t masks[2] = {esdEv->GetTriggerMask(), esdEv->GetTriggerMaskNext50()};
+  for(Int_t iclass = 0; iclass < kNTriggerClasses; iclass++){
+    if(masks[iclass/50] & (1ull << (iclass%50)))
+      FillClassHistos(esdEv, iclass, ntracklet, spdClusters, deltaPhi, isCvsTOk, isDeltaPhiOk);
   }
-  if(tokens) delete tokens;
   // return decision
 
 #ifdef PASS1RECO
@@ -212,6 +211,48 @@ Bool_t AliBackgroundSelection::IsSelected(TObject* const obj)
 }
 
 
+void AliBackgroundSelection::ResetClassTable(){
+
+  // Forget the histos of all the trigger class indices. They are
+  // looked up again by name when a class fires for the first time
+
+  for(Int_t iclass = 0; iclass < kNTriggerClasses; iclass++){
+    fClassResolved[iclass] = kFALSE;
+    fClassCvsT[iclass][0] = fClassCvsT[iclass][1] = 0;
+    fClassDeltaPhi[iclass][0] = fClassDeltaPhi[iclass][1] = 0;
+  }
+}
+
+void AliBackgroundSelection::FillClassHistos(const AliESDEvent * esdEv, Int_t iclass, Int_t ntracklet, Float_t spdClusters, Float_t deltaPhi, Bool_t isCvsTOk, Bool_t isDeltaPhiOk){
+
+  // Fill the control histos of the trigger class with index iclass,
+  // booking them if this class has not been seen before
+
+  if(!fClassResolved[iclass]) {
+    fClassResolved[iclass] = kTRUE;
+    const AliESDRun * esdRun = esdEv->GetESDRun();
+    TString trg = esdRun ? esdRun->GetTriggerClass(iclass) : "";
+    trg.Strip(TString::kBoth, ' ');
+    if(trg.IsNull()) {
+      AliWarning(Form("No name for fired trigger class %d in run %d", iclass, fClassTableRun));
+      return;
+    }
+    fClassCvsT[iclass][0]     = GetClusterVsTrackletsHisto(trg.Data());
+    fClassCvsT[iclass][1]     = GetClusterVsTrackletsHistoAccepted(trg.Data());
+    fClassDeltaPhi[iclass][0] = GetDeltaPhiHisto(trg.Data());
+    fClassDeltaPhi[iclass][1] = GetDeltaPhiHistoAccepted(trg.Data());
+  }
+  if(!fClassCvsT[iclass][0]) return;
+
+  // cluster vs tracklets
+  fClassCvsT[iclass][0]->Fill(ntracklet,spdClusters);
+  if(isCvsTOk) fClassCvsT[iclass][1]->Fill(ntracklet,spdClusters);
+
+  // Delta phi
+  fClassDeltaPhi[iclass][0]->Fill(deltaPhi);
+  if(isDeltaPhiOk) fClassDeltaPhi[iclass][1]->Fill(deltaPhi);
+}
+
 void   AliBackgroundSelection::Init(){
 
   // Set default cut values
@@ -13,11 +13,14 @@ class TList;
 class TH2F;
 class TH1F;
 class TCollection;
+class AliESDEvent;
 
 
 class AliBackgroundSelection : public AliAnalysisCuts
 {
 public:
+  enum { kNTriggerClasses = 100 }; // size of the trigger class table (trigger mask + next 50)
+
   // Inherited methods
   AliBackgroundSelection();
   AliBackgroundSelection(const char* name, const char* title);
@@ -53,14 +56,23 @@ public:
   // TODO: implement cut on global vertex DCA?
 
 private:
+  void ResetClassTable();
+  void FillClassHistos(const AliESDEvent * esdEv, Int_t iclass, Int_t ntracklet, Float_t spdClusters, Float_t deltaPhi, Bool_t isCvsTOk, Bool_t isDeltaPhiOk);
+
   TList * fOutputHist; // contains 2 histo Cluster vs Tracklets and delta phiper trigger type (all and accepted)
   Float_t fACut; // Cut on y = ax + b in the Cluster Vs Tracklets correlation. This is the "a" parameter of the cut
   Float_t fBCut; // Cut on y = ax + b in the Cluster Vs Tracklets correlation. This is the "b" parameter of the cut
   Float_t fDeltaPhiCut; // events with vertex from vertexer Z and DeltaPhi>fDeltaPhiCut are rejected
 
+  // control histos per trigger class index, resolved by name once per run (when the class first fires)
+  Int_t  fClassTableRun;                         //! run for which the trigger class table is valid
+  Bool_t fClassResolved[kNTriggerClasses];       //! the histos of this class index have been looked up in this run
+  TH2F * fClassCvsT[kNTriggerClasses][2];        //! cluster vs tracklets (all, accepted)
+  TH1F * fClassDeltaPhi[kNTriggerClasses][2];    //! delta phi (all, accepted)
+
   AliBackgroundSelection& operator=(const AliBackgroundSelection&);
 
-  ClassDef(AliBackgroundSelection, 1); 
+  ClassDef(AliBackgroundSelection, 2); 
 };
  
 #endif
@@ -34,7 +34,10 @@
 #include <TROOT.h>
 #include <TDirectory.h>
 #include <TSystem.h>
+#include <TAxis.h>
+#include <TMath.h>
 #include <iostream>
+#include <vector>
 
 #include "AliAnalysisManager.h"
 #include "AliHeader.h"
@@ -77,6 +80,73 @@
 
 ClassImp(AliCentralitySelectionTask)
 
+//________________________________________________________________________
+// Flat copies of the percentile histograms and of the outlier cuts of the
+// current run, compiled once per run in SetupRun when the lookup tables are
+// enabled. The bin search reproduces TAxis::FindBin, so the percentiles are
+// the same as the ones read from the histograms.
+class CentralityLookupTables {
+ public:
+  enum { kV0M = 0, kV0A, kV0A0, kV0A123, kV0C, kV0A23, kV0C01, kV0S, kV0MEq, kV0AEq, kV0CEq,
+	 kFMD, kTRK, kTKL, kCL0, kCL1, kCND, kZNA, kZNC, kZPA, kZPC, kV0MvsFMD, kTKLvsV0M, kNPA,
+	 kV0Mtrue, kV0Atrue, kV0Ctrue, kV0MEqtrue, kV0AEqtrue, kV0CEqtrue, kFMDtrue, kTRKtrue,
+	 kTKLtrue, kCL0true, kCL1true, kCNDtrue, kZNAtrue, kZNCtrue, kNEstimators };
+  enum { kNCentBins = 101 };
+
+  class Axis {
+  public:
+    Axis() : fNbins(0), fXmin(0), fXmax(0), fEdges() {}
+    void Set(const TAxis* axis) {
+      fNbins = axis->GetNbins();
+      fXmin  = axis->GetXmin();
+      fXmax  = axis->GetXmax();
+      fEdges.clear();
+      if (axis->GetXbins()->GetSize()) fEdges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray()+fNbins+1);
+    }
+    Int_t FindBin(Double_t x) const {
+      if (x < fXmin) return 0;
+      if (!(x < fXmax)) return fNbins+1;
+      if (fEdges.empty()) return 1 + Int_t(fNbins*(x-fXmin)/(fXmax-fXmin));
+      return 1 + TMath::BinarySearch(fNbins+1, &fEdges[0], x);
+    }
+    Int_t GetNbins() const { return fNbins; }
+  private:
+    Int_t fNbins;
+    Double_t fXmin;
+    Double_t fXmax;
+    std::vector<Double_t> fEdges; // bin edges of variable binning, empty for fixed bins
+  };
+
+  class Table {
+  public:
+    Table() : fX(), fY(), fContent() {}
+    void Set(const TH1* h) {
+      fContent.clear();
+      if (!h) return;
+      fX.Set(h->GetXaxis());
+      fY.Set(h->GetYaxis());
+      fContent.resize(h->GetNcells());
+      for (Int_t bin=0; bin<h->GetNcells(); bin++) fContent[bin] = h->GetBinContent(bin);
+    }
+    Bool_t IsValid() const { return !fContent.empty(); }
+    Double_t Lookup(Double_t x) const { return fContent[fX.FindBin(x)]; }
+    Double_t Lookup(Double_t x, Double_t y) const { return fContent[fX.FindBin(x) + (fX.GetNbins()+2)*fY.FindBin(y)]; }
+  private:
+    Axis fX;
+    Axis fY;
+    std::vector<Double_t> fContent; // bin contents including under- and overflow
+  };
+
+  void Evaluate(const Double_t* values, Float_t* const* cent) const {
+    for (Int_t i=0; i<kNEstimators; i++) if (fTables[i].IsValid()) *cent[i] = fTables[i].Lookup(values[i]);
+  }
+
+  Table fTables[kNEstimators];      // 1D estimators
+  Table fZEMvsZDC;                  // ZEM vs ZDC estimator
+  Float_t fSPDSigmaCut[kNCentBins]; // fOutliersCut * sigma of V0M vs SPD per integer centrality
+  Float_t fTPCSigmaCut[kNCentBins]; // fOutliersCut * sigma of V0M vs TPC per integer centrality
+};
+
 
 //________________________________________________________________________
 AliCentralitySelectionTask::AliCentralitySelectionTask():
@@ -87,6 +157,7 @@ AliAnalysisTaskSE(),
   fUseScaling(0),
   fUseCleaning(0),
   fFillHistos(0),
+  fUseLookupTables(kFALSE),
   fV0MScaleFactor(0),
   fSPDScaleFactor(0),
   fTPCScaleFactor(0),
@@ -336,7 +407,8 @@ AliAnalysisTaskSE(),
   fHOutMultTRKvsCL1qual2(0),
   fHOutQuality(0),
   fHOutVertex(0),
-  fHOutVertexT0(0)
+  fHOutVertexT0(0),
+  fLookupTables(0)
 {   
   // Default constructor
   AliInfo("Centrality Selection enabled.");
@@ -357,6 +429,7 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const char *name):
   fUseScaling(0),
   fUseCleaning(0),
   fFillHistos(0),
+  fUseLookupTables(kFALSE),
   fV0MScaleFactor(0),
   fSPDScaleFactor(0),
   fTPCScaleFactor(0),
@@ -606,7 +679,8 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const char *name):
   fHOutMultTRKvsCL1qual2(0),
   fHOutQuality(0),
   fHOutVertex(0),
-  fHOutVertexT0(0)
+  fHOutVertexT0(0),
+  fLookupTables(0)
 {
   // Default constructor
   AliInfo("Centrality Selection enabled.");
@@ -637,6 +711,7 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const AliCentralitySelect
   fUseScaling(ana.fUseScaling),
   fUseCleaning(ana.fUseCleaning),
   fFillHistos(ana.fFillHistos),
+  fUseLookupTables(ana.fUseLookupTables),
   fV0MScaleFactor(ana.fV0MScaleFactor),
   fSPDScaleFactor(ana.fSPDScaleFactor),
   fTPCScaleFactor(ana.fTPCScaleFactor),
@@ -886,7 +961,8 @@ AliCentralitySelectionTask::AliCentralitySelectionTask(const AliCentralitySelect
   fHOutMultTRKvsCL1qual2(ana.fHOutMultTRKvsCL1qual2),
   fHOutQuality(ana.fHOutQuality),
   fHOutVertex(ana.fHOutVertex),
-  fHOutVertexT0(ana.fHOutVertexT0)
+  fHOutVertexT0(ana.fHOutVertexT0),
+  fLookupTables(0)
 {
   // Copy Constructor	
 
@@ -901,6 +977,7 @@ AliCentralitySelectionTask::~AliCentralitySelectionTask()
   if (fEsdTrackCuts) delete fEsdTrackCuts;
   if (fEsdTrackCutsExtra1) delete fEsdTrackCutsExtra1;
   if (fEsdTrackCutsExtra2) delete fEsdTrackCutsExtra2;
+  delete fLookupTables;
 }  
 
 //________________________________________________________________________
@@ -1699,61 +1776,86 @@ void AliCentralitySelectionTask::UserExec(Option_t */*option*/)
   }
 
   // ***** Centrality Selection
-  if(fHtempV0M) fCentV0M = fHtempV0M->GetBinContent(fHtempV0M->FindBin((v0Corr)));
-  if(fHtempV0A) fCentV0A = fHtempV0A->GetBinContent(fHtempV0A->FindBin((multV0ACorr)));
-  if(fHtempV0A0) fCentV0A0 = fHtempV0A0->GetBinContent(fHtempV0A0->FindBin((multV0A0Corr)));
-  if(fHtempV0A123) fCentV0A123 = fHtempV0A123->GetBinContent(fHtempV0A123->FindBin((multV0A123Corr)));
-  if(fHtempV0C) fCentV0C = fHtempV0C->GetBinContent(fHtempV0C->FindBin((multV0CCorr)));
-  if(fHtempV0A23) fCentV0A23 = fHtempV0A23->GetBinContent(fHtempV0A23->FindBin((multV0A23Corr)));
-  if(fHtempV0C01) fCentV0C01 = fHtempV0C01->GetBinContent(fHtempV0C01->FindBin((multV0C01Corr)));
-  if(fHtempV0S)  fCentV0S = fHtempV0S->GetBinContent(fHtempV0S->FindBin((multV0SCorr)));
-  if(fHtempV0MEq) fCentV0MEq = fHtempV0MEq->GetBinContent(fHtempV0MEq->FindBin((multV0AEq+multV0CEq)));
-  if(fHtempV0AEq) fCentV0AEq = fHtempV0AEq->GetBinContent(fHtempV0AEq->FindBin((multV0AEq)));
-  if(fHtempV0CEq) fCentV0CEq = fHtempV0CEq->GetBinContent(fHtempV0CEq->FindBin((multV0CEq)));
-  if(fHtempFMD) fCentFMD = fHtempFMD->GetBinContent(fHtempFMD->FindBin((multFMDA+multFMDC)));
-  if(fHtempTRK) fCentTRK = fHtempTRK->GetBinContent(fHtempTRK->FindBin(nTracks));
-  if(fHtempTKL) fCentTKL = fHtempTKL->GetBinContent(fHtempTKL->FindBin(nTracklets));
-  if(fHtempCL0) fCentCL0 = fHtempCL0->GetBinContent(fHtempCL0->FindBin(nClusters[0]));
-  if(fHtempCL1) fCentCL1 = fHtempCL1->GetBinContent(fHtempCL1->FindBin(spdCorr));
-  if(fHtempCND) fCentCND = fHtempCND->GetBinContent(fHtempCND->FindBin(multCND));
-  if(fHtempZNA) {
-    if(znaFired) fCentZNA = fHtempZNA->GetBinContent(fHtempZNA->FindBin(znaTower));
-    else fCentZNA = 101;
-  }
-  if(fHtempZNC) {
-    if(zncFired) fCentZNC = fHtempZNC->GetBinContent(fHtempZNC->FindBin(zncTower));
-    else fCentZNC = 101;
-  }
-  if(fHtempZPA) {
-    if(znaFired) fCentZPA = fHtempZPA->GetBinContent(fHtempZPA->FindBin(zpaTower));
-    else fCentZPA = 101;
-  }
-  if(fHtempZPC) {
-    if(zpcFired) fCentZPC = fHtempZPC->GetBinContent(fHtempZPC->FindBin(zpcTower));
-    else fCentZPC = 101;
-  }
+  if (fLookupTables) {
+    // all the estimators from the flat tables compiled in SetupRun
+    const Double_t values[CentralityLookupTables::kNEstimators] = {
+      v0Corr, multV0ACorr, multV0A0Corr, multV0A123Corr, multV0CCorr, multV0A23Corr, multV0C01Corr, multV0SCorr,
+      multV0AEq+multV0CEq, multV0AEq, multV0CEq, multFMDA+multFMDC, Double_t(nTracks), Double_t(nTracklets),
+      Double_t(nClusters[0]), spdCorr, Double_t(multCND), znaTower, zncTower, zpaTower, zpcTower,
+      multV0A+multV0C, Double_t(nTracklets), Double_t(Npart),
+      multV0ACorr+multV0CCorr, multV0ACorr, multV0CCorr, multV0AEq+multV0CEq, multV0AEq, multV0CEq,
+      multFMDA+multFMDC, Double_t(nTracks), Double_t(nTracklets), Double_t(nClusters[0]), spdCorr,
+      Double_t(multCND), znaTower, zncTower };
+    Float_t* const cent[CentralityLookupTables::kNEstimators] = {
+      &fCentV0M, &fCentV0A, &fCentV0A0, &fCentV0A123, &fCentV0C, &fCentV0A23, &fCentV0C01, &fCentV0S,
+      &fCentV0MEq, &fCentV0AEq, &fCentV0CEq, &fCentFMD, &fCentTRK, &fCentTKL,
+      &fCentCL0, &fCentCL1, &fCentCND, &fCentZNA, &fCentZNC, &fCentZPA, &fCentZPC,
+      &fCentV0MvsFMD, &fCentTKLvsV0M, &fCentNPA,
+      &fCentV0Mtrue, &fCentV0Atrue, &fCentV0Ctrue, &fCentV0MEqtrue, &fCentV0AEqtrue, &fCentV0CEqtrue,
+      &fCentFMDtrue, &fCentTRKtrue, &fCentTKLtrue, &fCentCL0true, &fCentCL1true,
+      &fCentCNDtrue, &fCentZNAtrue, &fCentZNCtrue };
+    fLookupTables->Evaluate(values, cent);
+    if(fHtempZNA && !znaFired) fCentZNA = 101;
+    if(fHtempZNC && !zncFired) fCentZNC = 101;
+    if(fHtempZPA && !znaFired) fCentZPA = 101;
+    if(fHtempZPC && !zpcFired) fCentZPC = 101;
+    if(fHtempZEMvsZDC) fCentZEMvsZDC = fLookupTables->fZEMvsZDC.Lookup(zem1Energy+zem2Energy,zncEnergy+znaEnergy+zpcEnergy+zpaEnergy);
+  } else {
+    if(fHtempV0M) fCentV0M = fHtempV0M->GetBinContent(fHtempV0M->FindBin((v0Corr)));
+    if(fHtempV0A) fCentV0A = fHtempV0A->GetBinContent(fHtempV0A->FindBin((multV0ACorr)));
+    if(fHtempV0A0) fCentV0A0 = fHtempV0A0->GetBinContent(fHtempV0A0->FindBin((multV0A0Corr)));
+    if(fHtempV0A123) fCentV0A123 = fHtempV0A123->GetBinContent(fHtempV0A123->FindBin((multV0A123Corr)));
+    if(fHtempV0C) fCentV0C = fHtempV0C->GetBinContent(fHtempV0C->FindBin((multV0CCorr)));
+    if(fHtempV0A23) fCentV0A23 = fHtempV0A23->GetBinContent(fHtempV0A23->FindBin((multV0A23Corr)));
+    if(fHtempV0C01) fCentV0C01 = fHtempV0C01->GetBinContent(fHtempV0C01->FindBin((multV0C01Corr)));
+    if(fHtempV0S)  fCentV0S = fHtempV0S->GetBinContent(fHtempV0S->FindBin((multV0SCorr)));
+    if(fHtempV0MEq) fCentV0MEq = fHtempV0MEq->GetBinContent(fHtempV0MEq->FindBin((multV0AEq+multV0CEq)));
+    if(fHtempV0AEq) fCentV0AEq = fHtempV0AEq->GetBinContent(fHtempV0AEq->FindBin((multV0AEq)));
+    if(fHtempV0CEq) fCentV0CEq = fHtempV0CEq->GetBinContent(fHtempV0CEq->FindBin((multV0CEq)));
+    if(fHtempFMD) fCentFMD = fHtempFMD->GetBinContent(fHtempFMD->FindBin((multFMDA+multFMDC)));
+    if(fHtempTRK) fCentTRK = fHtempTRK->GetBinContent(fHtempTRK->FindBin(nTracks));
+    if(fHtempTKL) fCentTKL = fHtempTKL->GetBinContent(fHtempTKL->FindBin(nTracklets));
+    if(fHtempCL0) fCentCL0 = fHtempCL0->GetBinContent(fHtempCL0->FindBin(nClusters[0]));
+    if(fHtempCL1) fCentCL1 = fHtempCL1->GetBinContent(fHtempCL1->FindBin(spdCorr));
+    if(fHtempCND) fCentCND = fHtempCND->GetBinContent(fHtempCND->FindBin(multCND));
+    if(fHtempZNA) {
+      if(znaFired) fCentZNA = fHtempZNA->GetBinContent(fHtempZNA->FindBin(znaTower));
+      else fCentZNA = 101;
+    }
+    if(fHtempZNC) {
+      if(zncFired) fCentZNC = fHtempZNC->GetBinContent(fHtempZNC->FindBin(zncTower));
+      else fCentZNC = 101;
+    }
+    if(fHtempZPA) {
+      if(znaFired) fCentZPA = fHtempZPA->GetBinContent(fHtempZPA->FindBin(zpaTower));
+      else fCentZPA = 101;
+    }
+    if(fHtempZPC) {
+      if(zpcFired) fCentZPC = fHtempZPC->GetBinContent(fHtempZPC->FindBin(zpcTower));
+      else fCentZPC = 101;
+    }
 
 
-  if(fHtempV0MvsFMD) fCentV0MvsFMD = fHtempV0MvsFMD->GetBinContent(fHtempV0MvsFMD->FindBin((multV0A+multV0C)));
-  if(fHtempTKLvsV0M) fCentTKLvsV0M = fHtempTKLvsV0M->GetBinContent(fHtempTKLvsV0M->FindBin(nTracklets));
-  if(fHtempZEMvsZDC) fCentZEMvsZDC = fHtempZEMvsZDC->GetBinContent(fHtempZEMvsZDC->FindBin(zem1Energy+zem2Energy,zncEnergy+znaEnergy+zpcEnergy+zpaEnergy));
-
-  if(fHtempNPA) fCentNPA = fHtempNPA->GetBinContent(fHtempNPA->FindBin(Npart));
-  if(fHtempV0Mtrue) fCentV0Mtrue = fHtempV0Mtrue->GetBinContent(fHtempV0Mtrue->FindBin((multV0ACorr+multV0CCorr)));
-  if(fHtempV0Atrue) fCentV0Atrue = fHtempV0Atrue->GetBinContent(fHtempV0Atrue->FindBin((multV0ACorr)));
-  if(fHtempV0Ctrue) fCentV0Ctrue = fHtempV0Ctrue->GetBinContent(fHtempV0Ctrue->FindBin((multV0CCorr)));
-  if(fHtempV0MEqtrue) fCentV0MEqtrue = fHtempV0MEqtrue->GetBinContent(fHtempV0MEqtrue->FindBin((multV0AEq+multV0CEq)));
-  if(fHtempV0AEqtrue) fCentV0AEqtrue = fHtempV0AEqtrue->GetBinContent(fHtempV0AEqtrue->FindBin((multV0AEq)));
-  if(fHtempV0CEqtrue) fCentV0CEqtrue = fHtempV0CEqtrue->GetBinContent(fHtempV0CEqtrue->FindBin((multV0CEq)));
-  if(fHtempFMDtrue) fCentFMDtrue = fHtempFMDtrue->GetBinContent(fHtempFMDtrue->FindBin((multFMDA+multFMDC)));
-  if(fHtempTRKtrue) fCentTRKtrue = fHtempTRKtrue->GetBinContent(fHtempTRKtrue->FindBin(nTracks));
-  if(fHtempTKLtrue) fCentTKLtrue = fHtempTKLtrue->GetBinContent(fHtempTKLtrue->FindBin(nTracklets));
-  if(fHtempCL0true) fCentCL0true = fHtempCL0true->GetBinContent(fHtempCL0true->FindBin(nClusters[0]));
-  if(fHtempCL1true) fCentCL1true = fHtempCL1true->GetBinContent(fHtempCL1true->FindBin(spdCorr));
-  if(fHtempCNDtrue) fCentCNDtrue = fHtempCNDtrue->GetBinContent(fHtempCNDtrue->FindBin(multCND));
-  if(fHtempZNAtrue) fCentZNAtrue = fHtempZNAtrue->GetBinContent(fHtempZNAtrue->FindBin(znaTower));
-  if(fHtempZNCtrue) fCentZNCtrue = fHtempZNCtrue->GetBinContent(fHtempZNCtrue->FindBin(zncTower));
-   
+    if(fHtempV0MvsFMD) fCentV0MvsFMD = fHtempV0MvsFMD->GetBinContent(fHtempV0MvsFMD->FindBin((multV0A+multV0C)));
+    if(fHtempTKLvsV0M) fCentTKLvsV0M = fHtempTKLvsV0M->GetBinContent(fHtempTKLvsV0M->FindBin(nTracklets));
+    if(fHtempZEMvsZDC) fCentZEMvsZDC = fHtempZEMvsZDC->GetBinContent(fHtempZEMvsZDC->FindBin(zem1Energy+zem2Energy,zncEnergy+znaEnergy+zpcEnergy+zpaEnergy));
+
+    if(fHtempNPA) fCentNPA = fHtempNPA->GetBinContent(fHtempNPA->FindBin(Npart));
+    if(fHtempV0Mtrue) fCentV0Mtrue = fHtempV0Mtrue->GetBinContent(fHtempV0Mtrue->FindBin((multV0ACorr+multV0CCorr)));
+    if(fHtempV0Atrue) fCentV0Atrue = fHtempV0Atrue->GetBinContent(fHtempV0Atrue->FindBin((multV0ACorr)));
+    if(fHtempV0Ctrue) fCentV0Ctrue = fHtempV0Ctrue->GetBinContent(fHtempV0Ctrue->FindBin((multV0CCorr)));
+    if(fHtempV0MEqtrue) fCentV0MEqtrue = fHtempV0MEqtrue->GetBinContent(fHtempV0MEqtrue->FindBin((multV0AEq+multV0CEq)));
+    if(fHtempV0AEqtrue) fCentV0AEqtrue = fHtempV0AEqtrue->GetBinContent(fHtempV0AEqtrue->FindBin((multV0AEq)));
+    if(fHtempV0CEqtrue) fCentV0CEqtrue = fHtempV0CEqtrue->GetBinContent(fHtempV0CEqtrue->FindBin((multV0CEq)));
+    if(fHtempFMDtrue) fCentFMDtrue = fHtempFMDtrue->GetBinContent(fHtempFMDtrue->FindBin((multFMDA+multFMDC)));
+    if(fHtempTRKtrue) fCentTRKtrue = fHtempTRKtrue->GetBinContent(fHtempTRKtrue->FindBin(nTracks));
+    if(fHtempTKLtrue) fCentTKLtrue = fHtempTKLtrue->GetBinContent(fHtempTKLtrue->FindBin(nTracklets));
+    if(fHtempCL0true) fCentCL0true = fHtempCL0true->GetBinContent(fHtempCL0true->FindBin(nClusters[0]));
+    if(fHtempCL1true) fCentCL1true = fHtempCL1true->GetBinContent(fHtempCL1true->FindBin(spdCorr));
+    if(fHtempCNDtrue) fCentCNDtrue = fHtempCNDtrue->GetBinContent(fHtempCNDtrue->FindBin(multCND));
+    if(fHtempZNAtrue) fCentZNAtrue = fHtempZNAtrue->GetBinContent(fHtempZNAtrue->FindBin(znaTower));
+    if(fHtempZNCtrue) fCentZNCtrue = fHtempZNCtrue->GetBinContent(fHtempZNCtrue->FindBin(zncTower));
+  }
 
   // ***** Cleaning
   if (fUseCleaning) {
@@ -2157,9 +2259,36 @@ Int_t AliCentralitySelectionTask::SetupRun(const AliVEvent* const esd)
   fV0MZDCEcalOutlierPar0 =  centOADB->V0MZDCEcalOutlierPar0();  
   fV0MZDCEcalOutlierPar1 =  centOADB->V0MZDCEcalOutlierPar1();  
 
+  if (fUseLookupTables) CompileLookupTables();
+
   return 0;
 }
 
+//________________________________________________________________________
+void AliCentralitySelectionTask::CompileLookupTables()
+{
+  // Copy the percentile histograms and the outlier cuts of the run into flat tables
+  if (!fLookupTables) fLookupTables = new CentralityLookupTables;
+
+  const TH1* histos[CentralityLookupTables::kNEstimators] = {
+    fHtempV0M, fHtempV0A, fHtempV0A0, fHtempV0A123, fHtempV0C, fHtempV0A23, fHtempV0C01, fHtempV0S,
+    fHtempV0MEq, fHtempV0AEq, fHtempV0CEq, fHtempFMD, fHtempTRK, fHtempTKL,
+    fHtempCL0, fHtempCL1, fHtempCND, fHtempZNA, fHtempZNC, fHtempZPA, fHtempZPC,
+    fHtempV0MvsFMD, fHtempTKLvsV0M, fHtempNPA,
+    fHtempV0Mtrue, fHtempV0Atrue, fHtempV0Ctrue, fHtempV0MEqtrue, fHtempV0AEqtrue, fHtempV0CEqtrue,
+    fHtempFMDtrue, fHtempTRKtrue, fHtempTKLtrue, fHtempCL0true, fHtempCL1true,
+    fHtempCNDtrue, fHtempZNAtrue, fHtempZNCtrue };
+  for (Int_t i=0; i<CentralityLookupTables::kNEstimators; i++) fLookupTables->fTables[i].Set(histos[i]);
+  fLookupTables->fZEMvsZDC.Set(fHtempZEMvsZDC);
+
+  for (Int_t cent=0; cent<CentralityLookupTables::kNCentBins; cent++) {
+    Float_t spdSigma = fV0MSPDSigmaOutlierPar0 + fV0MSPDSigmaOutlierPar1*cent + fV0MSPDSigmaOutlierPar2*cent*cent;
+    Float_t tpcSigma = fV0MTPCSigmaOutlierPar0 + fV0MTPCSigmaOutlierPar1*cent + fV0MTPCSigmaOutlierPar2*cent*cent;
+    fLookupTables->fSPDSigmaCut[cent] = fOutliersCut*spdSigma;
+    fLookupTables->fTPCSigmaCut[cent] = fOutliersCut*tpcSigma;
+  }
+}
+
 
 
 //________________________________________________________________________
@@ -2167,6 +2296,8 @@ Bool_t AliCentralitySelectionTask::IsOutlierV0MSPD(Float_t spd, Float_t v0, Int_
 {
   // Clean outliers
   Float_t val = fV0MSPDOutlierPar0 +  fV0MSPDOutlierPar1 * v0;
+  if (fLookupTables && cent>=0 && cent<CentralityLookupTables::kNCentBins)
+    return TMath::Abs(spd-val) > fLookupTables->fSPDSigmaCut[cent];
   Float_t spdSigma = fV0MSPDSigmaOutlierPar0 + fV0MSPDSigmaOutlierPar1*cent + fV0MSPDSigmaOutlierPar2*cent*cent;
   if ( TMath::Abs(spd-val) > fOutliersCut*spdSigma ) 
     return kTRUE;
@@ -2179,6 +2310,8 @@ Bool_t AliCentralitySelectionTask::IsOutlierV0MTPC(Int_t tracks, Float_t v0, Int
 {
   // Clean outliers
   Float_t val = fV0MTPCOutlierPar0 +  fV0MTPCOutlierPar1 * v0;
+  if (fLookupTables && cent>=0 && cent<CentralityLookupTables::kNCentBins)
+    return TMath::Abs(tracks-val) > fLookupTables->fTPCSigmaCut[cent];
   Float_t tpcSigma = fV0MTPCSigmaOutlierPar0 + fV0MTPCSigmaOutlierPar1*cent + fV0MTPCSigmaOutlierPar2*cent*cent;
   if ( TMath::Abs(tracks-val) > fOutliersCut*tpcSigma ) 
     return kTRUE;
@@ -19,6 +19,7 @@ class TString;
 
 class AliESDEvent;
 class AliESDtrackCuts;
+class CentralityLookupTables;
 
 class AliCentralitySelectionTask : public AliAnalysisTaskSE {
 
@@ -41,10 +42,12 @@ class AliCentralitySelectionTask : public AliAnalysisTaskSE {
   void DontUseCleaning()                   {fUseCleaning=kFALSE;}
   void SetFillHistos()                     {fFillHistos=kTRUE; DefineOutput(1, TList::Class());
 }
+  void SetUseLookupTables(Bool_t flag=kTRUE) {fUseLookupTables=flag;}
 
  private:
 
   Int_t SetupRun(const AliVEvent* const esd);
+  void CompileLookupTables();
   Bool_t IsOutlierV0MSPD(Float_t spd, Float_t v0, Int_t cent) const;
   Bool_t IsOutlierV0MTPC(Int_t tracks, Float_t v0, Int_t cent) const;
   Bool_t IsOutlierV0MZDC(Float_t zdc, Float_t v0) const;
@@ -56,6 +59,7 @@ class AliCentralitySelectionTask : public AliAnalysisTaskSE {
   Bool_t   fUseScaling;         // flag to use scaling 
   Bool_t   fUseCleaning;        // flag to use cleaning  
   Bool_t   fFillHistos;         // flag to fill the QA histos
+  Bool_t   fUseLookupTables;    // flag to evaluate the estimators from flat tables compiled per run
   Float_t  fV0MScaleFactor;     // scale factor V0M
   Float_t  fSPDScaleFactor;     // scale factor SPD
   Float_t  fTPCScaleFactor;     // scale factor TPC
@@ -326,7 +330,9 @@ class AliCentralitySelectionTask : public AliAnalysisTaskSE {
   TH1F *fHOutVertex ;           //control histogram for vertex SPD
   TH1F *fHOutVertexT0 ;         //control histogram for vertex T0
 
-  ClassDef(AliCentralitySelectionTask, 31); 
+  CentralityLookupTables *fLookupTables; //! percentile and outlier tables of the current run
+
+  ClassDef(AliCentralitySelectionTask, 32); 
 };
 
 #endif
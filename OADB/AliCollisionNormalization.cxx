@@ -10,6 +10,7 @@
 //-------------------------------------------------------------------------
 
 #include "AliCollisionNormalization.h"
+#include "AliCollisionNormalizationCounters.h"
 #include "AliPhysicsSelection.h"
 #include "AliLog.h"
 #include "TFile.h"
@@ -37,6 +38,8 @@ AliCollisionNormalization::AliCollisionNormalization() :
   fHistProcTypes    (0),
   fHistStatBin0     (0),
   fHistStat     (0),
+  fCounters(0),
+  fCountersClass(""),
   fInputEvents(0),   
   fPhysSelEvents(0),
   fBgEvents(0),      
@@ -77,6 +80,8 @@ AliCollisionNormalization::AliCollisionNormalization(Int_t nbinz, Float_t minz,
   fHistProcTypes    (0),
   fHistStatBin0     (0),
   fHistStat     (0),
+  fCounters(0),
+  fCountersClass(""),
   fInputEvents(0),   
   fPhysSelEvents(0),
   fBgEvents(0),      
@@ -117,6 +122,8 @@ AliCollisionNormalization::AliCollisionNormalization(const char * dataFile, cons
   fHistProcTypes    (0),
   fHistStatBin0     (0),
   fHistStat     (0),
+  fCounters(0),
+  fCountersClass(""),
   fInputEvents(0),   
   fPhysSelEvents(0),
   fBgEvents(0),      
@@ -162,6 +169,7 @@ AliCollisionNormalization::AliCollisionNormalization(const char * dataFile, cons
     
   fHistStatBin0      =  (TH1F*) fstat->Get("fHistStatistics_Bin0");
   fHistStat          =  (TH1F*) fstat->Get("fHistStatistics");
+  fCounters          = cndata->GetCounters();
   
 }
 
@@ -179,6 +187,7 @@ AliCollisionNormalization::~AliCollisionNormalization(){
   if(fHistStatBin0     ) { delete fHistStatBin0     ; fHistStatBin0     =0;}
   if(fHistStat         ) { delete fHistStat         ; fHistStat         =0;}
   if(fHistProcTypes    ) { delete fHistProcTypes    ; fHistProcTypes    =0;}
+  if(fCounters         ) { delete fCounters         ; fCounters         =0;}
 
 }
   
@@ -204,6 +213,8 @@ void AliCollisionNormalization::BookAllHistos(){
   fHistProcTypes->GetXaxis()->SetBinLabel(kProcDD+1,"DD");
   fHistProcTypes->GetXaxis()->SetBinLabel(kProcUnknown+1,"Unknown");
 
+  fCounters = new AliCollisionNormalizationCounters();
+
   TH1::AddDirectory(oldStatus);
 
 }
@@ -305,8 +316,15 @@ Double_t AliCollisionNormalization::ComputeNint() {
   // successfully processed (useful if running on grid: you may have a
   // crash without noticing it).
 
-  fInputEvents = fHistStat->GetBinContent(1,1);
-  fPhysSelEvents = fHistStat->GetBinContent( fHistStat->GetNbinsX(),1);
+  // Without the event stat histos, use the event counters of the
+  // selected trigger class, summed over all runs
+  if (fHistStat) {
+    fInputEvents = fHistStat->GetBinContent(1,1);
+    fPhysSelEvents = fHistStat->GetBinContent( fHistStat->GetNbinsX(),1);
+  } else if (fCounters) {
+    fInputEvents   = fCounters->GetCounter(fCountersClass, AliCollisionNormalizationCounters::kCntTriggered);
+    fPhysSelEvents = fCounters->GetCounter(fCountersClass, AliCollisionNormalizationCounters::kCntPhysSel);
+  }
 
   AliInfo(Form("Input Events (No cuts: %d, After Phys. Sel.:%d)",
 	       Int_t(fInputEvents),
@@ -315,7 +333,14 @@ Double_t AliCollisionNormalization::ComputeNint() {
   // Get or compute BG. This assumes the CINT1B suite
   Double_t triggeredEventsWith0MultWithBG = fHistVzData->Integral(0, fHistVzData->GetNbinsX()+1,1, 1);
   //  Double_t bg = 0; // This will include beam gas + accidentals
-  if (fHistStatBin0->GetNbinsY() > 4) { // FIXME: we need a better criterion to decide...
+  if (!fHistStatBin0 && fCounters) {
+    AliInfo(Form("Using BG from the event counters of %s", fCountersClass.Data()));
+    fBgEvents = fCounters->GetCounter(fCountersClass, AliCollisionNormalizationCounters::kCntBackground);
+    Long64_t nBin0 = fCounters->GetCounter(fCountersClass, AliCollisionNormalizationCounters::kCntBin0);
+    if (nBin0 != Long64_t(triggeredEventsWith0MultWithBG)) {
+      AliWarning(Form("Events in bin0 from event counters and local counter not consistent: %lld - %d", nBin0, Int_t(triggeredEventsWith0MultWithBG)));
+    }
+  } else if (fHistStatBin0->GetNbinsY() > 4) { // FIXME: we need a better criterion to decide...
     AliInfo("Using BG computed by Physics Selection");
     // WARNING
     // CHECK IF THE COMPUTATION OF BG OFFSET IS STILL OK, IN CASE OF CHANGES TO THE PHYSICS SELECTION
@@ -448,7 +473,7 @@ Long64_t AliCollisionNormalization::Merge(TCollection* list)
   TObject* obj;
   
   // collections of all histograms
-  const Int_t nHists = kNProcs*3+5;
+  const Int_t nHists = kNProcs*3+6;
   TList collections[nHists];
 
   Int_t count = 0;
@@ -468,6 +493,7 @@ Long64_t AliCollisionNormalization::Merge(TCollection* list)
     if (entry->fHistProcTypes    ) collections[++ihist].Add(entry->fHistProcTypes    );
     if (entry->fHistStatBin0     ) collections[++ihist].Add(entry->fHistStatBin0     );
     if (entry->fHistStat         ) collections[++ihist].Add(entry->fHistStat         );
+    if (entry->fCounters         ) collections[++ihist].Add(entry->fCounters         );
 
     count++;
   }
@@ -483,6 +509,7 @@ Long64_t AliCollisionNormalization::Merge(TCollection* list)
   if (fHistProcTypes    ) fHistProcTypes    ->Merge(&collections[++ihist]);
   if (fHistStatBin0     ) fHistStatBin0     ->Merge(&collections[++ihist]);
   if (fHistStat         ) fHistStat         ->Merge(&collections[++ihist]);
+  if (fCounters         ) fCounters         ->Merge(&collections[++ihist]);
     
   
   delete iter;
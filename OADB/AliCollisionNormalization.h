@@ -21,6 +21,7 @@
 class TH1F;
 class TH1I;
 class AliMCEvent;
+class AliCollisionNormalizationCounters;
 
 class AliCollisionNormalization : public TObject
 
@@ -55,6 +56,9 @@ public:
   TH1F *   GetStatBin0      () { return fHistStatBin0     ; }
   TH1F *   GetStat          () { return fHistStat         ; }
   TH1F *   GetHistProcTypes () { return fHistProcTypes    ; }
+  AliCollisionNormalizationCounters * GetCounters() { return fCounters ; }
+
+  void SetCountersTriggerClass(const char * trgClass) { fCountersClass = trgClass; } // class of the counters used in ComputeNint without event stat histos
    
 
   Int_t GetProcessType(const AliMCEvent * mcEvt) ;
@@ -110,6 +114,9 @@ protected:
   TH1F * fHistStatBin0     ; // event stat histogram, created by physiscs selection; used in ComputeNint;
   TH1F * fHistStat         ; // event stat histogram, created by physiscs selection; used in ComputeNint;
 
+  AliCollisionNormalizationCounters * fCounters; // event counters per run and trigger class
+  TString fCountersClass;  // trigger class of the counters used in ComputeNint if the event stat histos are not available
+
   Double_t fInputEvents;   // number of Input Events 
   Double_t fPhysSelEvents; // number of  Events after Physics Selection 
   Double_t fBgEvents;            // number of background events 
@@ -122,7 +129,7 @@ protected:
 
   static const char * fgkProcLabel[] ; // labels of the different process types
   
-  ClassDef(AliCollisionNormalization, 4);
+  ClassDef(AliCollisionNormalization, 5);
     
 private:
   AliCollisionNormalization(const AliCollisionNormalization&);
@@ -0,0 +1,265 @@
+//-------------------------------------------------------------------------
+//                      Implementation of   Class AliCollisionNormalizationCounters
+//
+//  Event counters per run and per trigger class, used to compute the
+//  number of collisions and the integrated luminosity per run or per
+//  period. See the header for the layout of the counters.
+//
+//  Nint for a trigger class is the number of events accepted by the
+//  physics selection, minus the background, divided by the trigger
+//  efficiency of the class (SetTriggerEfficiency, 1 by default, e.g.
+//  from AliCollisionNormalization::ComputeNint). The luminosity is
+//  Nint divided by the reference cross section of the class
+//  (SetReferenceCrossSection), in the inverse units of the cross
+//  section.
+//-------------------------------------------------------------------------
+
+#include "AliCollisionNormalizationCounters.h"
+#include "AliESDEvent.h"
+#include "AliESDRun.h"
+#include "TObjString.h"
+#include "TCollection.h"
+
+ClassImp(AliCollisionNormalizationCounters)
+
+AliCollisionNormalizationCounters::AliCollisionNormalizationCounters(const char * name) :
+  TNamed(name, "Event counters per run and trigger class"),
+  fClassNames(),
+  fRuns(),
+  fCounts(),
+  fTrigEff(),
+  fRefXS(),
+  fLastRun(-1),
+  fLastRunIndex(-1),
+  fMaskRun(-1)
+{
+  // ctor
+  fClassNames.SetOwner(kTRUE);
+  for(Int_t ibit = 0; ibit < kNTriggerClasses; ibit++) fMaskClass[ibit] = -1;
+}
+
+Int_t AliCollisionNormalizationCounters::FindClass(const char * className) const {
+
+  // Returns the index of a trigger class, -1 if not known
+  for(Int_t iclass = 0; iclass < GetNClasses(); iclass++) {
+    if(!strcmp(className, ((TObjString*) fClassNames.UncheckedAt(iclass))->GetString().Data())) return iclass;
+  }
+  return -1;
+}
+
+Int_t AliCollisionNormalizationCounters::GetClassIndex(const char * className, Bool_t add) {
+
+  // Returns the index of a trigger class, to be used in Count. If the
+  // class is not known and add is true, it is added (the counters of
+  // all the runs are moved, so this should not be done per event)
+
+  Int_t iclass = FindClass(className);
+  if(iclass >= 0 || !add) return iclass;
+
+  Int_t nclass = GetNClasses();
+  std::vector<Long64_t> counts(fRuns.size()*(nclass+1)*kNCounters, 0);
+  for(UInt_t irun = 0; irun < fRuns.size(); irun++) {
+    for(Int_t i = 0; i < nclass*kNCounters; i++) {
+      counts[irun*(nclass+1)*kNCounters+i] = fCounts[irun*nclass*kNCounters+i];
+    }
+  }
+  fCounts.swap(counts);
+
+  fClassNames.Add(new TObjString(className));
+  fTrigEff.push_back(1.);
+  fRefXS  .push_back(0.);
+  return nclass;
+}
+
+const char * AliCollisionNormalizationCounters::GetTriggerClassName(Int_t iclass) const {
+
+  // Returns the name of a trigger class
+  if(iclass < 0 || iclass >= GetNClasses()) return "";
+  return ((TObjString*) fClassNames.UncheckedAt(iclass))->GetString().Data();
+}
+
+Int_t AliCollisionNormalizationCounters::FindRun(Int_t run, Bool_t add) {
+
+  // Returns the index of a run in the counters, adding it if needed.
+  // The last run is cached, as consecutive events are from the same run
+
+  if(run == fLastRun) return fLastRunIndex;
+
+  Int_t irun = -1;
+  for(UInt_t i = 0; i < fRuns.size(); i++) {
+    if(fRuns[i] == run) { irun = i; break; }
+  }
+  if(irun < 0) {
+    if(!add) return -1;
+    irun = fRuns.size();
+    fRuns.push_back(run);
+    fCounts.resize(fRuns.size()*GetNClasses()*kNCounters, 0);
+  }
+
+  fLastRun      = run;
+  fLastRunIndex = irun;
+  return irun;
+}
+
+void AliCollisionNormalizationCounters::Count(Int_t run, Int_t iclass, Int_t counter, Long64_t n) {
+
+  // Adds n to a counter of a trigger class (index from GetClassIndex) in a run
+  if(iclass < 0 || iclass >= GetNClasses() || counter < 0 || counter >= kNCounters) return;
+  Int_t irun = FindRun(run, kTRUE);
+  fCounts[(irun*GetNClasses()+iclass)*kNCounters+counter] += n;
+}
+
+void AliCollisionNormalizationCounters::FillEvent(const AliESDEvent * esd, Bool_t isSelected, Bool_t isBin0, Bool_t isBackground) {
+
+  // Counts an event for all its fired trigger classes. The classes are
+  // taken from the trigger mask, and the names of the mask bits are
+  // resolved once per run
+
+  if(!esd) return;
+  Int_t run = esd->GetRunNumber();
+
+  if(run != fMaskRun) {
+    fMaskRun = run;
+    const AliESDRun * esdRun = esd->GetESDRun();
+    for(Int_t ibit = 0; ibit < kNTriggerClasses; ibit++) {
+      TString trg = esdRun ? esdRun->GetTriggerClass(ibit) : "";
+      trg.Strip(TString::kBoth, ' ');
+      fMaskClass[ibit] = trg.IsNull() ? -1 : GetClassIndex(trg.Data());
+    }
+  }
+
+  Int_t irun = FindRun(run, kTRUE);
+  Int_t nclass = GetNClasses();
+
+  const ULong64_t masks[2] = {esd->GetTriggerMask(), esd->GetTriggerMaskNext50()};
+  for(Int_t ibit = 0; ibit < kNTriggerClasses; ibit++) {
+    if(fMaskClass[ibit] < 0 || !(masks[ibit/50] & (1ull << (ibit%50)))) continue;
+    Long64_t * counts = &fCounts[(irun*nclass+fMaskClass[ibit])*kNCounters];
+    counts[kCntTriggered]++;
+    if(!isSelected) continue;
+    counts[kCntPhysSel]++;
+    if(isBackground) counts[kCntBackground]++;
+    if(isBin0) counts[kCntBin0]++;
+    else       counts[kCntVertex]++;
+  }
+}
+
+Long64_t AliCollisionNormalizationCounters::SumCounter(Int_t iclass, Int_t counter, Int_t runMin, Int_t runMax) const {
+
+  // Sum of a counter over the runs in [runMin, runMax]
+  if(iclass < 0 || counter < 0 || counter >= kNCounters) return 0;
+  Long64_t sum = 0;
+  Int_t nclass = GetNClasses();
+  for(UInt_t irun = 0; irun < fRuns.size(); irun++) {
+    if(fRuns[irun] < runMin || fRuns[irun] > runMax) continue;
+    sum += fCounts[(irun*nclass+iclass)*kNCounters+counter];
+  }
+  return sum;
+}
+
+Long64_t AliCollisionNormalizationCounters::GetCounter(Int_t run, const char * className, Int_t counter) const {
+
+  // Returns a counter of a trigger class in a run
+  return SumCounter(FindClass(className), counter, run, run);
+}
+
+Long64_t AliCollisionNormalizationCounters::GetCounter(const char * className, Int_t counter, Int_t runMin, Int_t runMax) const {
+
+  // Returns a counter of a trigger class summed over the runs in [runMin, runMax]
+  return SumCounter(FindClass(className), counter, runMin, runMax);
+}
+
+void AliCollisionNormalizationCounters::SetTriggerEfficiency(const char * className, Double_t eff) {
+
+  // Sets the trigger efficiency of a class, used in GetNint
+  fTrigEff[GetClassIndex(className)] = eff;
+}
+
+void AliCollisionNormalizationCounters::SetReferenceCrossSection(const char * className, Double_t xs) {
+
+  // Sets the reference cross section of a class, used in GetLuminosity
+  fRefXS[GetClassIndex(className)] = xs;
+}
+
+Double_t AliCollisionNormalizationCounters::GetNint(const char * className, Int_t runMin, Int_t runMax) const {
+
+  // Number of collisions seen by a trigger class in the runs [runMin, runMax]
+  Int_t iclass = FindClass(className);
+  if(iclass < 0 || fTrigEff[iclass] <= 0) return 0;
+
+  Long64_t events = SumCounter(iclass, kCntPhysSel, runMin, runMax) - SumCounter(iclass, kCntBackground, runMin, runMax);
+  return events / fTrigEff[iclass];
+}
+
+Double_t AliCollisionNormalizationCounters::GetLuminosity(const char * className, Int_t runMin, Int_t runMax) const {
+
+  // Integrated luminosity of a trigger class in the runs [runMin, runMax]
+  Int_t iclass = FindClass(className);
+  if(iclass < 0 || fRefXS[iclass] <= 0) return 0;
+
+  return GetNint(className, runMin, runMax) / fRefXS[iclass];
+}
+
+Long64_t AliCollisionNormalizationCounters::Merge(TCollection* list) {
+
+  // Merge a list of AliCollisionNormalizationCounters objects with this.
+  // Runs and trigger classes are matched by number and name.
+  // Returns the number of merged objects (including this).
+
+  if (!list)
+    return 0;
+
+  if (list->IsEmpty())
+    return 1;
+
+  TIter iter(list);
+  TObject* obj;
+
+  Int_t count = 0;
+  while ((obj = iter.Next())) {
+
+    AliCollisionNormalizationCounters* entry = dynamic_cast<AliCollisionNormalizationCounters*> (obj);
+    if (entry == 0)
+      continue;
+
+    // class indices of the entry in this, added first so that the counters are moved only once
+    Int_t nclass = entry->GetNClasses();
+    std::vector<Int_t> classIndex(nclass);
+    for(Int_t iclass = 0; iclass < nclass; iclass++) {
+      Bool_t isNew = FindClass(entry->GetTriggerClassName(iclass)) < 0;
+      classIndex[iclass] = GetClassIndex(entry->GetTriggerClassName(iclass));
+      if(isNew) {
+	fTrigEff[classIndex[iclass]] = entry->fTrigEff[iclass];
+	fRefXS  [classIndex[iclass]] = entry->fRefXS  [iclass];
+      }
+    }
+
+    for(Int_t irun = 0; irun < entry->GetNRuns(); irun++) {
+      Int_t jrun = FindRun(entry->fRuns[irun], kTRUE);
+      for(Int_t iclass = 0; iclass < nclass; iclass++) {
+	const Long64_t * src = &entry->fCounts[(irun*nclass+iclass)*kNCounters];
+	Long64_t * dst = &fCounts[(jrun*GetNClasses()+classIndex[iclass])*kNCounters];
+	for(Int_t icnt = 0; icnt < kNCounters; icnt++) dst[icnt] += src[icnt];
+      }
+    }
+
+    count++;
+  }
+
+  return count+1;
+}
+
+void AliCollisionNormalizationCounters::Print(Option_t *) const {
+
+  // Prints the counters, Nint and luminosity per run and trigger class
+  for(Int_t iclass = 0; iclass < GetNClasses(); iclass++) {
+    Printf("%s (trigger eff. %.3f, ref. XS %g)", GetTriggerClassName(iclass), fTrigEff[iclass], fRefXS[iclass]);
+    for(Int_t irun = 0; irun < GetNRuns(); irun++) {
+      const Long64_t * counts = &fCounts[(irun*GetNClasses()+iclass)*kNCounters];
+      if(!counts[kCntTriggered]) continue;
+      Printf("  Run %d: triggered %lld, phys. sel. %lld (bin0 %lld, vertex %lld), bg %lld, Nint %.1f, L %g",
+	     fRuns[irun], counts[kCntTriggered], counts[kCntPhysSel], counts[kCntBin0], counts[kCntVertex], counts[kCntBackground],
+	     GetNint(fRuns[irun], GetTriggerClassName(iclass)), GetLuminosity(fRuns[irun], GetTriggerClassName(iclass)));
+    }
+  }
+}
@@ -0,0 +1,92 @@
+
+#ifndef ALICOLLISIONNORMALIZATIONCOUNTERS_H
+#define ALICOLLISIONNORMALIZATIONCOUNTERS_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//                      Implementation of   Class AliCollisionNormalizationCounters
+//
+//  Event counters per run and per trigger class, filled during the
+//  train pass and merged across jobs, from which the number of
+//  collisions (Nint) and the integrated luminosity are computed per
+//  run or per run range (period), without reading back the event
+//  statistics of the physics selection.
+//
+//  The counters are kept in one integer array, with a block of
+//  kNCounters entries per trigger class for each run. Trigger classes
+//  are identified by name, so that jobs with different trigger
+//  configurations can be merged.
+//-------------------------------------------------------------------------
+
+#include "TNamed.h"
+#include "TObjArray.h"
+#include <vector>
+
+class AliESDEvent;
+class TCollection;
+
+class AliCollisionNormalizationCounters : public TNamed
+{
+
+public:
+  enum { kCntTriggered,     // events with the trigger class fired
+	 kCntPhysSel,       // ... accepted by the physics selection
+	 kCntBin0,          // ... accepted and without reconstructed vertex (zero bin)
+	 kCntVertex,        // ... accepted and with reconstructed vertex
+	 kCntBackground,    // ... accepted and identified as background
+	 kNCounters };
+  enum { kNTriggerClasses = 100 }; // trigger class indices in the ESD trigger mask
+
+  AliCollisionNormalizationCounters(const char * name = "AliCollisionNormalizationCounters");
+  ~AliCollisionNormalizationCounters() {}
+
+  Int_t    GetClassIndex(const char * className, Bool_t add = kTRUE);
+  void     Count(Int_t run, Int_t iclass, Int_t counter, Long64_t n = 1);
+  void     FillEvent(const AliESDEvent * esd, Bool_t isSelected, Bool_t isBin0, Bool_t isBackground = kFALSE);
+
+  Int_t        GetNRuns()              const { return fRuns.size(); }
+  Int_t        GetRun(Int_t irun)      const { return fRuns[irun]; }
+  Int_t        GetNClasses()           const { return fClassNames.GetEntriesFast(); }
+  const char * GetTriggerClassName(Int_t iclass) const;
+
+  Long64_t GetCounter(Int_t run, const char * className, Int_t counter) const;
+  Long64_t GetCounter(const char * className, Int_t counter, Int_t runMin = 0, Int_t runMax = kMaxInt) const;
+
+  void     SetTriggerEfficiency(const char * className, Double_t eff);
+  void     SetReferenceCrossSection(const char * className, Double_t xs);
+
+  Double_t GetNint(Int_t run, const char * className) const { return GetNint(className, run, run); }
+  Double_t GetNint(const char * className, Int_t runMin = 0, Int_t runMax = kMaxInt) const;
+  Double_t GetLuminosity(Int_t run, const char * className) const { return GetLuminosity(className, run, run); }
+  Double_t GetLuminosity(const char * className, Int_t runMin = 0, Int_t runMax = kMaxInt) const;
+
+  Long64_t Merge(TCollection* list);
+  void     Print(Option_t * option = "") const;
+
+protected:
+
+  Int_t    FindRun(Int_t run, Bool_t add);
+  Int_t    FindClass(const char * className) const;
+  Long64_t SumCounter(Int_t iclass, Int_t counter, Int_t runMin, Int_t runMax) const;
+
+  TObjArray             fClassNames;   // trigger class names (TObjString)
+  std::vector<Int_t>    fRuns;         // runs, in order of appearance
+  std::vector<Long64_t> fCounts;       // counters, [run][class][counter]
+  std::vector<Double_t> fTrigEff;      // trigger efficiency per class, used in GetNint
+  std::vector<Double_t> fRefXS;        // reference cross section per class, used in GetLuminosity
+
+  Int_t    fLastRun;                   //! run of the last Count/FillEvent call
+  Int_t    fLastRunIndex;              //! its index in fRuns
+  Int_t    fMaskRun;                   //! run of the trigger mask table
+  Int_t    fMaskClass[kNTriggerClasses]; //! class index of each trigger mask bit in this run, -1 if none
+
+  ClassDef(AliCollisionNormalizationCounters, 1);
+
+private:
+  AliCollisionNormalizationCounters(const AliCollisionNormalizationCounters&);
+  AliCollisionNormalizationCounters& operator=(const AliCollisionNormalizationCounters&);
+};
+
+#endif
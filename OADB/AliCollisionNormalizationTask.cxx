@@ -20,6 +20,7 @@
 #include <AliHeader.h>
 
 #include "AliCollisionNormalization.h"
+#include "AliCollisionNormalizationCounters.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
@@ -140,10 +141,15 @@ void AliCollisionNormalizationTask::UserExec(Option_t*)
 
   Int_t ntracklet = mult->GetNumberOfTracklets();
   const AliESDVertex * vtxESD = aESD->GetPrimaryVertexSPD();
-  if (IsEventInBinZero()) {
+  Bool_t isBin0 = IsEventInBinZero();
+  if (isBin0) {
     ntracklet = 0;
     vtxESD    = 0;
   }
+
+  // Per run and trigger class counters, for Nint and luminosity
+  if (!fIsMC && fCollisionNormalization->GetCounters())
+    fCollisionNormalization->GetCounters()->FillEvent(aESD, isSelected, isBin0);
   
   if (ntracklet > 0 && !vtxESD) {
     AliError("No vertex but reconstructed tracklets?");
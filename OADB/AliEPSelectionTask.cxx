@@ -89,6 +89,8 @@ AliAnalysisTaskSE(),
   fQyContainer(0),
   fSparseDist(0),
   fHruns(0),
+  fPhiWeightChargeEta(kFALSE),
+  fTrackPhiWeight(),
   fQVector(0),
   fQContributionX(0),
   fQContributionY(0),
@@ -140,6 +142,8 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   fQyContainer(0),
   fSparseDist(0),
   fHruns(0),
+  fPhiWeightChargeEta(kFALSE),
+  fTrackPhiWeight(),
   fQVector(0),
   fQContributionX(0),
   fQContributionY(0),
@@ -250,6 +254,7 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 //   fRunNumber = -15;
 
   AliEventplane *esdEP;
+  TVector2 qq;
   TVector2 qq1;
   TVector2 qq2;
   Double_t fRP = 0.; // monte carlo reaction plane angle
@@ -294,11 +299,10 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (nt>4){
 
-	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	// qvector full event and subevents
+	FillQVectors(esdEP, tracklist, qq, qq1, qq2);
+	fQVector = new TVector2(qq);
 	fEventplaneQ = fQVector->Phi()/2;
-	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -322,7 +326,7 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 	    while (delta > TMath::Pi()) delta -= TMath::Pi();
 	    fHOutPTPsi->Fill(track->Pt(),delta);
 	    fHOutPhi->Fill(track->Phi());
-	    fHOutPhiCorr->Fill(track->Phi(),GetPhiWeight(track));
+	    fHOutPhiCorr->Fill(track->Phi(),fTrackPhiWeight[iter]);
           }
 	}
 
@@ -388,11 +392,10 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (NT>4){
 
-	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	// qvector full event and subevents
+	FillQVectors(esdEP, tracklist, qq, qq1, qq2);
+	fQVector = new TVector2(qq);
 	fEventplaneQ = fQVector->Phi()/2;
-	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -416,7 +419,7 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 	    while (delta > TMath::Pi()) delta -= TMath::Pi();
 	    fHOutPTPsi->Fill(track->Pt(),delta);
 	    fHOutPhi->Fill(track->Phi());
-	    fHOutPhiCorr->Fill(track->Phi(),GetPhiWeight(track));
+	    fHOutPhiCorr->Fill(track->Phi(),fTrackPhiWeight[iter]);
 	  }
 	}
 
@@ -619,6 +622,93 @@ void AliEPSelectionTask::GetQsub(TVector2 &Q1, TVector2 &Q2, TObjArray* tracklis
   Q2 = mQ[1];
 }
 
+//________________________________________________________________________
+void AliEPSelectionTask::FillQVectors(AliEventplane* EP, TObjArray* tracklist, TVector2 &Q, TVector2 &Q1, TVector2 &Q2)
+{
+  // Q vector of the full event (as GetQ) and of the subevents (as GetQsub)
+  // in a single loop over the tracks. The phi weight of each track is kept
+  // in fTrackPhiWeight, in the order of the track list.
+  float mQx=0, mQy=0, mQx1=0, mQy1=0, mQx2=0, mQy2=0;
+  // get recentering values
+  Double_t mean[2], rms[2];
+  Recenter(0, mean);
+  Recenter(1, rms);
+
+  Bool_t negativeID = (fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128);
+  Bool_t splitOK = (fSplitMethod == AliEPSelectionTask::kRandom || fSplitMethod == AliEPSelectionTask::kEta || fSplitMethod == AliEPSelectionTask::kCharge);
+  if (!splitOK) printf("plane resolution determination method not available!\n\n ");
+
+  TRandom2 rn = 0;
+  int nt = tracklist->GetEntries();
+  int nhalf = int(nt/2.);
+  int trackcounter1=0, trackcounter2=0;
+  fTrackPhiWeight.assign(nt, 1.);
+
+  for (int i=0; i<nt; i++){
+    AliVTrack* track = dynamic_cast<AliVTrack*> (tracklist->At(i));
+    if (!track) continue;
+    Double_t phiweight = GetPhiWeight(track);
+    Double_t ptweight = 1;
+    if (fUsePtWeight) ptweight = (track->Pt()<2) ? track->Pt() : 2;
+    fTrackPhiWeight[i] = phiweight;
+    Double_t weight = ptweight*phiweight;
+    Double_t qx = weight*cos(2*track->Phi())/rms[0];
+    Double_t qy = weight*sin(2*track->Phi())/rms[1];
+    Int_t idtemp = track->GetID();
+    if (negativeID) idtemp = idtemp*(-1) - 1;
+
+    if (fSaveTrackContribution){
+      EP->GetQContributionXArray()->AddAt(qx,idtemp);
+      EP->GetQContributionYArray()->AddAt(qy,idtemp);
+    }
+    mQx += qx;
+    mQy += qy;
+
+    // subevent of the track (0: none)
+    Int_t isub = 0;
+    if (fSplitMethod == AliEPSelectionTask::kRandom){
+      // splits the track set into 2 random subsets
+      if (trackcounter1 < nhalf && trackcounter2 < nhalf){
+        float random = rn.Rndm();
+        isub = (random < .5) ? 1 : 2;
+      }
+      else if (trackcounter1 >= nhalf) isub = 2;
+      else isub = 1;
+      if (isub == 1) trackcounter1++;
+      else trackcounter2++;
+    } else if (fSplitMethod == AliEPSelectionTask::kEta) {
+      Double_t eta = track->Eta();
+      if (eta > fEtaGap/2.) isub = 1;
+      else if (eta < -1.*fEtaGap/2.) isub = 2;
+    } else if (fSplitMethod == AliEPSelectionTask::kCharge) {
+      Short_t cha = track->Charge();
+      if (cha > 0) isub = 1;
+      else if (cha < 0) isub = 2;
+    }
+
+    if (isub == 1) {
+      mQx1 += qx;
+      mQy1 += qy;
+      if (fSaveTrackContribution){
+        EP->GetQContributionXArraysub1()->AddAt(qx,idtemp);
+        EP->GetQContributionYArraysub1()->AddAt(qy,idtemp);
+      }
+    } else if (isub == 2) {
+      mQx2 += qx;
+      mQy2 += qy;
+      if (fSaveTrackContribution){
+        EP->GetQContributionXArraysub2()->AddAt(qx,idtemp);
+        EP->GetQContributionYArraysub2()->AddAt(qy,idtemp);
+      }
+    }
+  }
+  // apply recenetering
+  Q.Set(mQx-(mean[0]/rms[0]), mQy-(mean[1]/rms[1]));
+  if (!splitOK) return;
+  Q1.Set(mQx1-(mean[0]/rms[0]), mQy1-(mean[1]/rms[1]));
+  Q2.Set(mQx2-(mean[0]/rms[0]), mQy2-(mean[1]/rms[1]));
+}
+
 //________________________________________________________________________
 void AliEPSelectionTask::SetPersonalESDtrackCuts(AliESDtrackCuts* trackcuts){
 
@@ -693,21 +783,17 @@ Double_t AliEPSelectionTask::GetPhiWeight(TObject* track1)
   Double_t phiweight=1;
   AliVTrack* track = dynamic_cast<AliVTrack*>(track1);
 
-  TH1F *phiDist = 0x0;
-  if(track) phiDist = SelectPhiDist(track);
-
-  if (fUsePhiWeight && phiDist && track) {
-    Double_t nParticles = phiDist->Integral();
-    Double_t nPhibins = phiDist->GetNbinsX();
-
-    Double_t Phi = track->Phi();
-
-    while (Phi<0) Phi += TMath::TwoPi();
-    while (Phi>TMath::TwoPi()) Phi -= TMath::TwoPi();
-
-    Double_t PhiDistValue = phiDist->GetBinContent(1+TMath::FloorNint((track->Phi())*nPhibins/TMath::TwoPi()));
-
-    if (PhiDistValue > 0) phiweight = nParticles/nPhibins/PhiDistValue;
+  Int_t itable = -1;
+  if(track) itable = SelectPhiWeightTable(track);
+
+  if (fUsePhiWeight && itable >= 0 && !fPhiWeightTable[itable].empty()) {
+    // table of the weights per bin of the phi distribution, see SetPhiWeightTables
+    const std::vector<Double_t> &table = fPhiWeightTable[itable];
+    Double_t nPhibins = table.size()-2;
+    Int_t bin = 1+TMath::FloorNint((track->Phi())*nPhibins/TMath::TwoPi());
+    if (bin < 0) bin = 0;
+    if (bin > nPhibins+1) bin = nPhibins+1;
+    phiweight = table[bin];
   }
   return phiweight;
 }
@@ -814,6 +900,30 @@ void AliEPSelectionTask::SetPhiDist()
   AliInfo("No Phi-weights available. All Phi weights set to 1");
   SetUsePhiWeight(kFALSE);
   }
+  SetPhiWeightTables();
+}
+
+//__________________________________________________________________________
+void AliEPSelectionTask::SetPhiWeightTables()
+{
+  // Flat tables of the phi weights nParticles/nPhibins/content for each bin
+  // (including under- and overflow) of the phi distributions of the run.
+  // Bins without entries get weight 1.
+  Bool_t single = (fPeriod.CompareTo("LHC10h")==0 || fUserphidist);
+  fPhiWeightChargeEta = (!single && fPeriod.CompareTo("LHC11h")==0);
+  Int_t ntables = fPhiWeightChargeEta ? 4 : (single ? 1 : 0);
+
+  for (Int_t i = 0; i<4; i++){
+    fPhiWeightTable[i].clear();
+    if (i >= ntables || !fPhiDist[i]) continue;
+    Double_t nParticles = fPhiDist[i]->Integral();
+    Int_t nPhibins = fPhiDist[i]->GetNbinsX();
+    fPhiWeightTable[i].assign(nPhibins+2, 1.);
+    for (Int_t ibin = 0; ibin<nPhibins+2; ibin++){
+      Double_t PhiDistValue = fPhiDist[i]->GetBinContent(ibin);
+      if (PhiDistValue > 0) fPhiWeightTable[i][ibin] = nParticles/Double_t(nPhibins)/PhiDistValue;
+    }
+  }
 }
 
 //__________________________________________________________________________
@@ -963,24 +1073,21 @@ void AliEPSelectionTask::SetOADBandPeriod()
 }
 
 //_________________________________________________________________________
-TH1F* AliEPSelectionTask::SelectPhiDist(AliVTrack *track)
+Int_t AliEPSelectionTask::SelectPhiWeightTable(AliVTrack *track) const
 {
-  if (fPeriod.CompareTo("LHC10h")==0  || fUserphidist) return fPhiDist[0];
-  else if(fPeriod.CompareTo("LHC11h")==0)
+  // Index of the phi distribution (and weight table) of the track, -1 if none
+  if (!fPhiWeightChargeEta) return 0;
+  if (track->Charge() < 0)
     {
-     if (track->Charge() < 0)
-       {
-        if(track->Eta() < 0.)       return fPhiDist[0];
-        else if (track->Eta() > 0.) return fPhiDist[2];
-       }
-      else if (track->Charge() > 0)
-       {
-        if(track->Eta() < 0.)       return fPhiDist[1];
-        else if (track->Eta() > 0.) return fPhiDist[3];
-       }
-
+     if(track->Eta() < 0.)       return 0;
+     else if (track->Eta() > 0.) return 2;
+    }
+  else if (track->Charge() > 0)
+    {
+     if(track->Eta() < 0.)       return 1;
+     else if (track->Eta() > 0.) return 3;
     }
-  return 0;
+  return -1;
 }
 
 TObjArray* AliEPSelectionTask::GetTracksForLHC11h(AliESDEvent* esd)
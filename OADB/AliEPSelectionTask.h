@@ -9,6 +9,8 @@
 //   author: Alberica Toia, Johanna Gramling
 //*****************************************************
 
+#include <vector>
+
 #include "AliAnalysisTaskSE.h"
 
 class TFile;
@@ -44,6 +46,7 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   
   TVector2 GetQ(AliEventplane* EP, TObjArray* event);
   void GetQsub(TVector2& Qsub1, TVector2& Qsub2, TObjArray* event,AliEventplane* EP);
+  void FillQVectors(AliEventplane* EP, TObjArray* event, TVector2& Q, TVector2& Qsub1, TVector2& Qsub2);
   Double_t GetWeight(TObject* track1);
   Double_t GetPhiWeight(TObject* track1);
   void Recenter(Int_t var, Double_t * values);
@@ -71,7 +74,8 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
 
   TObjArray* GetAODTracksAndMaxID(AliAODEvent* aod, Int_t& maxid);
   void SetOADBandPeriod();
-  TH1F* SelectPhiDist(AliVTrack *track);
+  void SetPhiWeightTables();
+  Int_t SelectPhiWeightTable(AliVTrack *track) const;
   TObjArray* GetTracksForLHC11h(AliESDEvent* esd);
 
   TString  fAnalysisInput; 		// "ESD", "AOD"
@@ -100,6 +104,9 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   THnSparse *fSparseDist;               //! THn for eta-charge phi-weighting
   TProfile* fQDist[2];			// array of TProfiles with mean+rms for recentering
   TH1F *fHruns;                         // information about runwise statistics of phi-weights
+  std::vector<Double_t> fPhiWeightTable[4]; //! phi weights per bin of fPhiDist, filled in SetPhiDist
+  Bool_t   fPhiWeightChargeEta;         //! phi weights depend on charge and eta (LHC11h)
+  std::vector<Double_t> fTrackPhiWeight; //! phi weights of the tracks of the current event
 
   TVector2* fQVector;			//! Q-Vector of the event  
   Double_t* fQContributionX;		//! array of the tracks' contributions to X component of Q-Vector - index = track ID
@@ -119,7 +126,7 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TH2F*	 fHOutDiff;			//! control histogram: Difference of MC RP and EP - only filled if fUseMCRP is true!
   TH2F*  fHOutleadPTPsi;		//! control histogram: emission angle of leading pT track vs EP angle
 
-  ClassDef(AliEPSelectionTask,4); 
+  ClassDef(AliEPSelectionTask,5); 
 };
 
 #endif
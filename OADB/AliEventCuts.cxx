@@ -7,6 +7,7 @@ using std::array;
 #include <vector>
 using std::vector;
 
+#include <TBufferFile.h>
 #include <TClonesArray.h>
 #include <TH1D.h>
 #include <TH1I.h>
@@ -31,6 +32,52 @@ using std::vector;
 ClassImp(AliEventCutsContainer);
 ClassImp(AliEventCuts);
 
+namespace {
+  /// FNV-1a hash used to identify the configuration of the cuts
+  class ConfigHash {
+    public:
+      ConfigHash() : fHash{14695981039346656037ull} {}
+      void Add(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+          fHash ^= bytes[i];
+          fHash *= 1099511628211ull;
+        }
+      }
+      template<typename T> void Add(const T& value) { Add(&value, sizeof(T)); }
+      void Add(const std::string& str) { Add(str.data(), str.size()); }
+      unsigned long Get() const { return (unsigned long)fHash; }
+    private:
+      unsigned long long fHash;
+  };
+}
+
+void AliEventCutsContainer::ResetEvent(unsigned long evid, int run) {
+  fEventId = evid;
+  fRunNumber = run;
+  fMultESD = -1;
+  fMultTrkFB32 = -1;
+  fMultTrkFB32Acc = -1;
+  fMultTrkFB32TOF = -1;
+  fMultTrkTPC = -1;
+  fMultTrkTPCout = -1;
+  fMultVZERO = -1.;
+  fSelectionKeys.clear();
+  fSelectionValues.clear();
+}
+
+int AliEventCutsContainer::FindSelection(unsigned long key) const {
+  for (size_t iK = 0; iK < fSelectionKeys.size(); ++iK)
+    if (fSelectionKeys[iK] == key) return iK;
+  return -1;
+}
+
+void AliEventCutsContainer::AddSelection(unsigned long key, bool passed, float value0, float value1) {
+  fSelectionKeys.push_back(key);
+  fSelectionValues.push_back(passed ? 1.f : 0.f);
+  fSelectionValues.push_back(value0);
+  fSelectionValues.push_back(value1);
+}
 
 
 /// Standard constructor with null selection
@@ -89,6 +136,10 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fOverrideAutoTriggerMask{false},
   fOverrideAutoPileUpCuts{false},
   fMultSelectionEvCuts{false},  
+  fShareSelections{true},
+  fSelectionKeysRun{-1},
+  fPileUpKey{0u},
+  fCentralityKey{0u},
   fCutStats{nullptr},
   fCutStatsAfterTrigger{nullptr},
   fCutStatsAfterMultSelection{nullptr},
@@ -131,6 +182,13 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     AddQAplotsToList();
   }
 
+  /// The outcome of the expensive selections is shared with the other AliEventCuts with the same configuration
+  if (current_run != fSelectionKeysRun) {
+    fSelectionKeysRun = current_run;
+    ComputeSelectionKeys();
+  }
+  AliEventCutsContainer* shared = fShareSelections ? GetSharedContainer(ev) : nullptr;
+
   /// Event selection flag, as soon as the event does not pass one cut this becomes false.
   fFlag = BIT(kNoCuts);
 
@@ -188,15 +246,26 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     else if (ntrkl < 50) fSPDpileupMinContributors = 4;
     else fSPDpileupMinContributors = 5;
   }
-  if (!ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ) &&
-      (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
-      (!fPileUpCutMV || !fUtils.IsPileUpMV(ev)))
-    fFlag |= BIT(kPileUp);
+  const int pileUpIndex = shared ? shared->FindSelection(fPileUpKey) : -1;
+  if (pileUpIndex >= 0) {
+    if (shared->fSelectionValues[3 * pileUpIndex] > 0.5f) fFlag |= BIT(kPileUp);
+  } else {
+    if (!ev->IsPileupFromSPD(fSPDpileupMinContributors,fSPDpileupMinZdist,fSPDpileupNsigmaZdist,fSPDpileupNsigmaDiamXY,fSPDpileupNsigmaDiamZ) &&
+        (!fTrackletBGcut || !fUtils.IsSPDClusterVsTrackletBG(ev)) &&
+        (!fPileUpCutMV || !fUtils.IsPileUpMV(ev)))
+      fFlag |= BIT(kPileUp);
+    if (shared) shared->AddSelection(fPileUpKey,fFlag & BIT(kPileUp));
+  }
 
   /// Centrality cuts:
   /// * Check for min and max centrality
   /// * Cross check correlation between two centrality estimators
-  if (fCentralityFramework) {
+  const int centralityIndex = (shared && fCentralityFramework) ? shared->FindSelection(fCentralityKey) : -1;
+  if (centralityIndex >= 0) {
+    fCentPercentiles[0] = shared->fSelectionValues[3 * centralityIndex + 1];
+    fCentPercentiles[1] = shared->fSelectionValues[3 * centralityIndex + 2];
+    if (shared->fSelectionValues[3 * centralityIndex] > 0.5f) fFlag |= BIT(kMultiplicity);
+  } else if (fCentralityFramework) {
     if (fCentralityFramework == 2) {
       AliCentrality* cent = ev->GetCentrality();
       fCentPercentiles[0] = cent->GetCentralityPercentile(fCentEstimators[0].data());
@@ -215,12 +284,25 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
         && fCentPercentiles[0] <= fMaxCentrality) {
           fFlag |= BIT(kMultiplicity);
     }
+    if (shared) shared->AddSelection(fCentralityKey,fFlag & BIT(kMultiplicity),fCentPercentiles[0],fCentPercentiles[1]);
   } else
     fFlag |= BIT(kMultiplicity);
 
-  if (AliMultSelectionTask::IsINELgtZERO(ev) || !fSelectInelGt0) {
+  if (fSelectInelGt0) {
+    /// The INEL>0 flag does not depend on the configuration
+    ConfigHash inel;
+    inel.Add(int(kINELgt0));
+    const unsigned long inelKey = inel.Get();
+    const int inelIndex = shared ? shared->FindSelection(inelKey) : -1;
+    bool inelGt0 = false;
+    if (inelIndex >= 0) inelGt0 = shared->fSelectionValues[3 * inelIndex] > 0.5f;
+    else {
+      inelGt0 = AliMultSelectionTask::IsINELgtZERO(ev);
+      if (shared) shared->AddSelection(inelKey,inelGt0);
+    }
+    if (inelGt0) fFlag |= BIT(kINELgt0);
+  } else
     fFlag |= BIT(kINELgt0);
-  }
 
   if (fUseVariablesCorrelationCuts && !fMC) {
     ComputeTrackMultiplicity(ev);
@@ -459,20 +541,62 @@ string AliEventCuts::GetCentralityEstimator (unsigned int estimator) const {
 }
 
 
+AliEventCutsContainer* AliEventCuts::GetSharedContainer(AliVEvent *ev) {
+  /// Find (or publish) the container of the current event, resetting it if it belongs to a previous event
+  AliEventCutsContainer* cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
+  if (!cont) {
+    cont = new AliEventCutsContainer;
+    ev->AddObject(cont);
+  }
+  unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+  const int run = ev->GetRunNumber();
+  fNewEvent = (cont->fEventId != evid || cont->fRunNumber != run);
+  if (fNewEvent) cont->ResetEvent(evid,run);
+  return cont;
+}
+
+void AliEventCuts::ComputeSelectionKeys() {
+  /// Hash of the parameters of the shared selections: instances with the same keys take the same decisions
+  ConfigHash pileup;
+  pileup.Add(int(kPileUp));
+  pileup.Add(fUseMultiplicityDependentPileUpCuts);
+  if (!fUseMultiplicityDependentPileUpCuts) pileup.Add(fSPDpileupMinContributors);
+  pileup.Add(fSPDpileupMinZdist);
+  pileup.Add(fSPDpileupNsigmaZdist);
+  pileup.Add(fSPDpileupNsigmaDiamXY);
+  pileup.Add(fSPDpileupNsigmaDiamZ);
+  pileup.Add(fTrackletBGcut);
+  pileup.Add(fPileUpCutMV);
+  if (fTrackletBGcut || fPileUpCutMV) {
+    /// AliAnalysisUtils does not expose its settings: use its streamed image
+    TBufferFile buf(TBuffer::kWrite);
+    fUtils.Streamer(buf);
+    pileup.Add(buf.Buffer(),buf.Length());
+  }
+  fPileUpKey = pileup.Get();
+
+  ConfigHash cent;
+  cent.Add(int(kMultiplicity));
+  cent.Add(fCentralityFramework);
+  cent.Add(fCentEstimators[0]);
+  cent.Add(fCentEstimators[1]);
+  cent.Add(fMultSelectionEvCuts);
+  cent.Add(fMinCentrality);
+  cent.Add(fMaxCentrality);
+  cent.Add(fUseEstimatorsCorrelationCut);
+  cent.Add(fMC);
+  cent.Add(fEstimatorsCorrelationCoef);
+  cent.Add(fEstimatorsSigmaPars);
+  cent.Add(fDeltaEstimatorNsigma);
+  fCentralityKey = cent.Get();
+}
+
 void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
-  AliEventCutsContainer* tmp_cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
-  if (tmp_cont) {
-    unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
-    fNewEvent = (tmp_cont->fEventId != evid);
-    tmp_cont->fEventId = evid;
-
-    if (!fNewEvent) {
-      fContainer = *tmp_cont;
-      return;
-    }
-  } else {
-    tmp_cont = new AliEventCutsContainer;
-    ev->AddObject(tmp_cont);
+  AliEventCutsContainer* tmp_cont = GetSharedContainer(ev);
+  if (tmp_cont->fMultESD >= 0) {
+    /// Already computed for this event by another instance
+    fContainer = *tmp_cont;
+    return;
   }
 
   bool isAOD = false;
@@ -6,6 +6,7 @@
 #include <TNamed.h>
 #include <cmath>
 #include <string>
+#include <vector>
 using std::string;
 
 #include "AliVEvent.h"
@@ -18,19 +19,30 @@ class TH1I;
 class TH2D;
 class TH2F;
 
+/// Per-event object shared by all the AliEventCuts instances of a train: it is published in the event
+/// by the first instance processing the event and holds the track multiplicities and the outcome of
+/// the expensive selections, keyed by a hash of the configuration of the corresponding cuts.
 class AliEventCutsContainer : public TNamed {
   public:
     AliEventCutsContainer() : TNamed("AliEventCutsContainer","AliEventCutsContainer"),
     fEventId(0u),
+    fRunNumber(-1),
     fMultESD(-1),
     fMultTrkFB32(-1),
     fMultTrkFB32Acc(-1),
     fMultTrkFB32TOF(-1),
     fMultTrkTPC(-1),
     fMultTrkTPCout(-1),
-    fMultVZERO(-1.) {}
+    fMultVZERO(-1.),
+    fSelectionKeys{},
+    fSelectionValues{} {}
+
+    void ResetEvent(unsigned long evid, int run);
+    int  FindSelection(unsigned long key) const;
+    void AddSelection(unsigned long key, bool passed, float value0 = -1.f, float value1 = -1.f);
 
     unsigned long fEventId;
+    int fRunNumber;
     int fMultESD;
     int fMultTrkFB32;
     int fMultTrkFB32Acc;
@@ -38,7 +50,9 @@ class AliEventCutsContainer : public TNamed {
     int fMultTrkTPC;
     int fMultTrkTPCout;
     double fMultVZERO;
-  ClassDef(AliEventCutsContainer,2)
+    std::vector<unsigned long> fSelectionKeys;  ///< Configuration hash of the cached selections
+    std::vector<float> fSelectionValues;        ///< Outcome (0/1) and two values (e.g. centrality percentiles) per cached selection
+  ClassDef(AliEventCutsContainer,3)
 };
 
 class AliEventCuts : public TList {
@@ -85,6 +99,7 @@ class AliEventCuts : public TList {
     void   SetupRun1pA(int iPeriod);
     void   SetupRun2pA(int iPeriod);
     void   UseMultSelectionEventSelection(bool useIt = true);
+    void   SetShareSelections(bool share = true) { fShareSelections = share; }
 
     static bool GoodPrimaryAODVertex(AliVEvent *ev);
 
@@ -158,6 +173,8 @@ class AliEventCuts : public TList {
     AliEventCuts operator=(const AliEventCuts& copy);
     void          AutomaticSetup (AliVEvent *ev);
     void          ComputeTrackMultiplicity(AliVEvent *ev);
+    void          ComputeSelectionKeys();
+    AliEventCutsContainer* GetSharedContainer(AliVEvent *ev);
     template<typename F> F PolN(F x, F* coef, int n);
 
     bool          fManualMode;                    ///< if true the cuts are not loaded automatically looking at the run number
@@ -175,6 +192,10 @@ class AliEventCuts : public TList {
     bool          fOverrideAutoTriggerMask;       ///<  If true the trigger mask chosen by the user is not overridden by the Automatic Setup
     bool          fOverrideAutoPileUpCuts;        ///<  If true the pile-up cuts are defined by the user.
     bool          fMultSelectionEvCuts;           ///< Enable/Disable the event selection applied in the AliMultSelection framework
+    bool          fShareSelections;               ///< If true the pile-up, centrality and INEL>0 selections are shared with the other instances with the same cuts through the AliEventCutsContainer
+    int           fSelectionKeysRun;              //!<! Run for which the selection keys were computed
+    unsigned long fPileUpKey;                     //!<! Hash of the pile-up cuts configuration
+    unsigned long fCentralityKey;                 //!<! Hash of the centrality cuts configuration
     
     /// The following pointers are used to avoid the intense usage of FindObject. The objects pointed are owned by (TList*)this.
     TH1D* fCutStats;               //!<! Cuts statistics: every column keeps track of how many times a cut is passed independently from the other cuts.
@@ -196,7 +217,7 @@ class AliEventCuts : public TList {
     AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
     AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
 
-    ClassDef(AliEventCuts,6)
+    ClassDef(AliEventCuts,7)
 };
 
 template<typename F> F AliEventCuts::PolN(F x,F* coef, int n) {
@@ -26,10 +26,61 @@
 #include "AliAODHeader.h"
 #include "AliInputEventHandler.h"
 #include "AliAnalysisManager.h"
+#include <algorithm>
 
 
 ClassImp(AliPPVsMultUtils)
 
+namespace {
+    // Event-level cache of the percentiles of all estimators and of the selection flags,
+    // shared by all instances (e.g. several wagons calling the utils on the same event).
+    enum { kINELgtZERO = 0, kAcceptedVertexPosition, kNotPileupSPDInMultBins, kNoInconsistentSPDandTrackVertices };
+
+    const char *gEstimatorNames[AliPPVsMultUtils::kNEstimators] = {
+        "V0M", "V0A", "V0C", "V0MEq", "V0AEq", "V0CEq", "V0B", "V0Apartial", "V0Cpartial", "V0S", "V0SB"
+    };
+
+    Long64_t         gCacheEntry = -1;
+    const AliVEvent *gCacheEvent = 0x0;
+    UInt_t           gFlagsKnown = 0;
+    UInt_t           gFlags      = 0;
+    Int_t            gPercentilesRun   = -1;
+    Bool_t           gPercentilesValid = kFALSE;
+    Float_t          gPercentiles[AliPPVsMultUtils::kNEstimators];
+
+    // True if the cache can be used for this event (only within a train).
+    // The cache is emptied when the entry or the event changes.
+    Bool_t IsCachedEvent(const AliVEvent *event)
+    {
+        AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+        Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+        if( entry < 0 ) return kFALSE;
+        if( entry != gCacheEntry || event != gCacheEvent ) {
+            gCacheEntry = entry;
+            gCacheEvent = event;
+            gFlagsKnown = 0;
+            gFlags = 0;
+            gPercentilesRun = -1;
+        }
+        return kTRUE;
+    }
+
+    // -1 if not known yet, otherwise the cached flag
+    Int_t FindFlag(const AliVEvent *event, Int_t flag)
+    {
+        if( !IsCachedEvent(event) || !(gFlagsKnown & (1<<flag)) ) return -1;
+        return (gFlags & (1<<flag)) ? 1 : 0;
+    }
+
+    Bool_t StoreFlag(const AliVEvent *event, Int_t flag, Bool_t result)
+    {
+        if( !IsCachedEvent(event) ) return result;
+        gFlagsKnown |= (1<<flag);
+        if( result ) gFlags |= (1<<flag);
+        return result;
+    }
+}
+
 //______________________________________________________________________
 AliPPVsMultUtils::AliPPVsMultUtils():TObject(),
     fRunNumber(0),
@@ -142,11 +193,49 @@ Float_t AliPPVsMultUtils::GetMultiplicityPercentile(AliVEvent *event, TString lM
 
     Float_t lreturnval = -1;
 
+    //All estimators are evaluated together, once per event
+    Int_t lEstimator = -1;
+    for( Int_t i = 0; i < kNEstimators; i++ ) if ( lMethod == gEstimatorNames[i] ) lEstimator = i;
+
+    Bool_t lCached = IsCachedEvent(event) && gPercentilesRun == fRunNumber;
+    Float_t lPercentiles[kNEstimators];
+    if( !lCached ) {
+        gPercentilesValid = FillPercentiles( event, lPercentiles );
+        if( IsCachedEvent(event) ) {
+            std::copy( lPercentiles, lPercentiles + kNEstimators, gPercentiles );
+            gPercentilesRun = fRunNumber;
+        }
+    }
+    const Float_t *lResults = lCached ? gPercentiles : lPercentiles;
+
+    //No VZERO or vertex information: error value, without event selection
+    if( !gPercentilesValid ) return lResults[0];
+
+    if ( lEstimator >= 0 ) lreturnval = lResults[lEstimator];
+
+    if ( lEmbedEventSelection ) {
+        if(IsSelectedTrigger                        ( event ) == kFALSE ) lreturnval = -200;
+        if(IsINELgtZERO                         ( event ) == kFALSE ) lreturnval = -201;
+        if(IsAcceptedVertexPosition             ( event ) == kFALSE ) lreturnval = -202;
+        if(IsNotPileupSPDInMultBins             ( event ) == kFALSE ) lreturnval = -203;
+        if(HasNoInconsistentSPDandTrackVertices ( event ) == kFALSE ) lreturnval = -204;
+    }
+
+    return lreturnval;
+}
+
+//______________________________________________________________________
+Bool_t AliPPVsMultUtils::FillPercentiles(AliVEvent *event, Float_t *lPercentiles)
+// Evaluates the percentiles of all estimators (see GetMultiplicityPercentile)
+// Returns kFALSE, with the error value in all estimators, if the event
+// information is not available
+{
     //Get VZERO Information for multiplicity later
     AliVVZERO* esdV0 = event->GetVZEROData();
     if (!esdV0) {
         AliError("AliVVZERO not available");
-        return -1;
+        std::fill( lPercentiles, lPercentiles + kNEstimators, -1 );
+        return kFALSE;
     }
 
     // VZERO PART
@@ -170,13 +259,19 @@ Float_t AliPPVsMultUtils::GetMultiplicityPercentile(AliVEvent *event, TString lM
     /* get ESD vertex SPD */
     if (event->InheritsFrom("AliESDEvent")) {
         AliESDEvent *esdevent = dynamic_cast<AliESDEvent *>(event);
-        if (!esdevent) return kFALSE;
+        if (!esdevent) {
+            std::fill( lPercentiles, lPercentiles + kNEstimators, 0 );
+            return kFALSE;
+        }
         lPrimarySPDVtx = esdevent->GetPrimaryVertexSPD();
     }
     /* get AOD vertex SPD */
     else if (event->InheritsFrom("AliAODEvent")) {
         AliAODEvent *aodevent = dynamic_cast<AliAODEvent *>(event);
-        if (!aodevent) return kFALSE;
+        if (!aodevent) {
+            std::fill( lPercentiles, lPercentiles + kNEstimators, 0 );
+            return kFALSE;
+        }
         lPrimarySPDVtx = aodevent->GetPrimaryVertexSPD();
     }
 
@@ -206,40 +301,31 @@ Float_t AliPPVsMultUtils::GetMultiplicityPercentile(AliVEvent *event, TString lM
         multV0Cpartial += mult;
     }
 
-    if ( lMethod == "V0M" ) lreturnval =
-            fBoundaryHisto_V0M -> GetBinContent( fBoundaryHisto_V0M->FindBin(multV0A+multV0C) );
-    if ( lMethod == "V0A" ) lreturnval =
-            fBoundaryHisto_V0A -> GetBinContent( fBoundaryHisto_V0A->FindBin(multV0A) );
-    if ( lMethod == "V0C" ) lreturnval =
-            fBoundaryHisto_V0C -> GetBinContent( fBoundaryHisto_V0C->FindBin(multV0C) );
+    lPercentiles[kV0M]        = FindPercentile( kV0M, multV0A+multV0C );
+    lPercentiles[kV0A]        = FindPercentile( kV0A, multV0A );
+    lPercentiles[kV0C]        = FindPercentile( kV0C, multV0C );
     //equalized
-    if ( lMethod == "V0MEq" ) lreturnval =
-            fBoundaryHisto_V0MEq -> GetBinContent( fBoundaryHisto_V0MEq->FindBin(multV0AEq+multV0CEq) );
-    if ( lMethod == "V0AEq" ) lreturnval =
-            fBoundaryHisto_V0AEq -> GetBinContent( fBoundaryHisto_V0AEq->FindBin(multV0AEq) );
-    if ( lMethod == "V0CEq" ) lreturnval =
-            fBoundaryHisto_V0CEq -> GetBinContent( fBoundaryHisto_V0CEq->FindBin(multV0CEq) );
+    lPercentiles[kV0MEq]      = FindPercentile( kV0MEq, multV0AEq+multV0CEq );
+    lPercentiles[kV0AEq]      = FindPercentile( kV0AEq, multV0AEq );
+    lPercentiles[kV0CEq]      = FindPercentile( kV0CEq, multV0CEq );
     //extra stuff
-    if ( lMethod == "V0B" ) lreturnval =
-            fBoundaryHisto_V0B -> GetBinContent( fBoundaryHisto_V0B->FindBin( MinVal( multV0A / fAverageAmplitudes->GetBinContent(1) , multV0C / fAverageAmplitudes->GetBinContent(2) ) ) );
-    if ( lMethod == "V0Apartial" ) lreturnval =
-            fBoundaryHisto_V0Apartial -> GetBinContent( fBoundaryHisto_V0Apartial->FindBin( multV0Apartial ) );
-    if ( lMethod == "V0Cpartial" ) lreturnval =
-            fBoundaryHisto_V0Cpartial -> GetBinContent( fBoundaryHisto_V0Cpartial->FindBin( multV0Cpartial ) );
-    if ( lMethod == "V0S" ) lreturnval =
-            fBoundaryHisto_V0S -> GetBinContent( fBoundaryHisto_V0S->FindBin( (multV0Apartial/fAverageAmplitudes->GetBinContent(3)) + (multV0Cpartial/fAverageAmplitudes->GetBinContent(4)) ) );
-    if ( lMethod == "V0SB" ) lreturnval =
-            fBoundaryHisto_V0SB -> GetBinContent( fBoundaryHisto_V0SB->FindBin( MinVal( multV0Apartial / fAverageAmplitudes->GetBinContent(3) , multV0Cpartial / fAverageAmplitudes->GetBinContent(4) ) ) );
+    lPercentiles[kV0B]        = FindPercentile( kV0B, MinVal( multV0A / fAverageValues[0] , multV0C / fAverageValues[1] ) );
+    lPercentiles[kV0Apartial] = FindPercentile( kV0Apartial, multV0Apartial );
+    lPercentiles[kV0Cpartial] = FindPercentile( kV0Cpartial, multV0Cpartial );
+    lPercentiles[kV0S]        = FindPercentile( kV0S, (multV0Apartial/fAverageValues[2]) + (multV0Cpartial/fAverageValues[3]) );
+    lPercentiles[kV0SB]       = FindPercentile( kV0SB, MinVal( multV0Apartial / fAverageValues[2] , multV0Cpartial / fAverageValues[3] ) );
 
-    if ( lEmbedEventSelection ) {
-        if(IsSelectedTrigger                        ( event ) == kFALSE ) lreturnval = -200;
-        if(IsINELgtZERO                         ( event ) == kFALSE ) lreturnval = -201;
-        if(IsAcceptedVertexPosition             ( event ) == kFALSE ) lreturnval = -202;
-        if(IsNotPileupSPDInMultBins             ( event ) == kFALSE ) lreturnval = -203;
-        if(HasNoInconsistentSPDandTrackVertices ( event ) == kFALSE ) lreturnval = -204;
-    }
+    return kTRUE;
+}
 
-    return lreturnval;
+//______________________________________________________________________
+Float_t AliPPVsMultUtils::FindPercentile(Int_t lEstimator, Double_t lValue) const
+// Same as GetBinContent(FindBin(lValue)) of the boundary histogram:
+// the number of edges below or at lValue is the bin number
+{
+    const std::vector<Double_t> &lEdges = fBoundaryEdges[lEstimator];
+    Int_t lBin = std::upper_bound( lEdges.begin(), lEdges.end(), lValue ) - lEdges.begin();
+    return fBoundaryValues[lEstimator][lBin];
 }
 
 //______________________________________________________________________
@@ -295,6 +381,11 @@ Bool_t AliPPVsMultUtils::LoadCalibration(Int_t lLoadThisCalibration)
         fAverageAmplitudes->Delete();
         fAverageAmplitudes = 0x0;
     }
+    for( Int_t i = 0; i < kNEstimators; i++ ) {
+        fBoundaryEdges[i].clear();
+        fBoundaryValues[i].clear();
+    }
+    fAverageValues.clear();
 
     AliInfo(Form( "Loading calibration file for run %i",lLoadThisCalibration) );
     TFile *lCalibFile_V0M = 0x0;
@@ -497,6 +588,20 @@ Bool_t AliPPVsMultUtils::LoadCalibration(Int_t lLoadThisCalibration)
         delete lCalibFile_Averages;
     }
 
+    //Flat copies for the lookup in every event
+    TH1F *lBoundaryHistos[kNEstimators] = {
+        fBoundaryHisto_V0M, fBoundaryHisto_V0A, fBoundaryHisto_V0C,
+        fBoundaryHisto_V0MEq, fBoundaryHisto_V0AEq, fBoundaryHisto_V0CEq,
+        fBoundaryHisto_V0B, fBoundaryHisto_V0Apartial, fBoundaryHisto_V0Cpartial,
+        fBoundaryHisto_V0S, fBoundaryHisto_V0SB
+    };
+    for( Int_t i = 0; i < kNEstimators; i++ ) {
+        Int_t lNBins = lBoundaryHistos[i]->GetNbinsX();
+        for( Int_t ibin = 1; ibin <= lNBins + 1; ibin++ ) fBoundaryEdges[i].push_back( lBoundaryHistos[i]->GetBinLowEdge(ibin) );
+        for( Int_t ibin = 0; ibin <= lNBins + 1; ibin++ ) fBoundaryValues[i].push_back( lBoundaryHistos[i]->GetBinContent(ibin) );
+    }
+    for( Int_t ibin = 1; ibin <= 4; ibin++ ) fAverageValues.push_back( fAverageAmplitudes->GetBinContent(ibin) );
+
     fRunNumber = lLoadThisCalibration; //Loaded!
     AliInfo(Form("Finished loading calibration for run %i",lLoadThisCalibration));
     return kTRUE;
@@ -542,17 +647,21 @@ Bool_t AliPPVsMultUtils::IsINELgtZERO(AliVEvent *event)
 // Function to check for INEL > 0 condition
 // Makes use of tracklets and requires at least and SPD vertex
 {
+    //Already evaluated for this event
+    Int_t lCached = FindFlag( event, kINELgtZERO );
+    if ( lCached >= 0 ) return lCached;
+
     Bool_t lReturnValue = kFALSE;
     //Use Ref.Mult. code...
     if (event->InheritsFrom("AliESDEvent")) {
         AliESDEvent *esdevent = dynamic_cast<AliESDEvent *>(event);
-        if (!esdevent) return kFALSE;
+        if (!esdevent) return StoreFlag( event, kINELgtZERO, kFALSE );
         if ( AliESDtrackCuts::GetReferenceMultiplicity(esdevent, AliESDtrackCuts::kTracklets, 1.0) >= 1 ) lReturnValue = kTRUE;
     }
     //Redo equivalent test
     else if (event->InheritsFrom("AliAODEvent")) {
         AliAODEvent *aodevent = dynamic_cast<AliAODEvent *>(event);
-        if (!aodevent) return kFALSE;
+        if (!aodevent) return StoreFlag( event, kINELgtZERO, kFALSE );
 
         //FIXME --- Actually, here we can come up with a workaround.
         // We can check for the reference multiplicity stored and look for error codes!
@@ -567,7 +676,7 @@ Bool_t AliPPVsMultUtils::IsINELgtZERO(AliVEvent *event)
             if ( lStoredRefMult != -1 && lStoredRefMult != -2 && TMath::Abs(spdmult->GetEta(i)) < 1.0 ) lReturnValue = kTRUE;
         }
     }
-    return lReturnValue;
+    return StoreFlag( event, kINELgtZERO, lReturnValue );
 }
 
 //______________________________________________________________________
@@ -575,23 +684,27 @@ Bool_t AliPPVsMultUtils::IsAcceptedVertexPosition(AliVEvent *event)
 // Simple check for the best primary vertex Z position:
 // Will accept events only if |z| < 10cm
 {
+    //Already evaluated for this event
+    Int_t lCached = FindFlag( event, kAcceptedVertexPosition );
+    if ( lCached >= 0 ) return lCached;
+
     Bool_t lReturnValue = kFALSE;
     //Getting around to the best vertex -> typecast to ESD/AOD
     const AliVVertex *lPrimaryVtx = NULL;
     /* get ESD vertex */
     if (event->InheritsFrom("AliESDEvent")) {
         AliESDEvent *esdevent = dynamic_cast<AliESDEvent *>(event);
-        if (!esdevent) return kFALSE;
+        if (!esdevent) return StoreFlag( event, kAcceptedVertexPosition, kFALSE );
         lPrimaryVtx = esdevent->GetPrimaryVertex();
     }
     /* get AOD vertex */
     else if (event->InheritsFrom("AliAODEvent")) {
         AliAODEvent *aodevent = dynamic_cast<AliAODEvent *>(event);
-        if (!aodevent) return kFALSE;
+        if (!aodevent) return StoreFlag( event, kAcceptedVertexPosition, kFALSE );
         lPrimaryVtx = aodevent->GetPrimaryVertex();
     }
     if ( TMath::Abs( lPrimaryVtx->GetZ() ) <= 10.0 ) lReturnValue = kTRUE;
-    return lReturnValue;
+    return StoreFlag( event, kAcceptedVertexPosition, lReturnValue );
 }
 
 //______________________________________________________________________
@@ -600,6 +713,10 @@ Bool_t AliPPVsMultUtils::HasNoInconsistentSPDandTrackVertices(AliVEvent *event)
 // N.B.: It is rigorously a "Not Inconsistent" function which will
 // let events with only SPD vertex go through without troubles.
 {
+    //Already evaluated for this event
+    Int_t lCached = FindFlag( event, kNoInconsistentSPDandTrackVertices );
+    if ( lCached >= 0 ) return lCached;
+
     //It's consistent until proven otherwise...
     Bool_t lReturnValue = kTRUE;
 
@@ -609,7 +726,7 @@ Bool_t AliPPVsMultUtils::HasNoInconsistentSPDandTrackVertices(AliVEvent *event)
     /* get ESD vertex */
     if (event->InheritsFrom("AliESDEvent")) {
         AliESDEvent *esdevent = dynamic_cast<AliESDEvent *>(event);
-        if (!esdevent) return kFALSE;
+        if (!esdevent) return StoreFlag( event, kNoInconsistentSPDandTrackVertices, kFALSE );
         const AliESDVertex *lPrimaryVtxSPD    = NULL;
         const AliESDVertex *lPrimaryVtxTracks = NULL;
         
@@ -629,7 +746,7 @@ Bool_t AliPPVsMultUtils::HasNoInconsistentSPDandTrackVertices(AliVEvent *event)
     /* get AOD vertex */
     else if (event->InheritsFrom("AliAODEvent")) {
         AliAODEvent *aodevent = dynamic_cast<AliAODEvent *>(event);
-        if (!aodevent) return kFALSE;
+        if (!aodevent) return StoreFlag( event, kNoInconsistentSPDandTrackVertices, kFALSE );
 
         //FIXME - Hack to deal with the fact that no
         //        AliAODEvent::GetPrimaryVertexTracks() exists...
@@ -637,7 +754,7 @@ Bool_t AliPPVsMultUtils::HasNoInconsistentSPDandTrackVertices(AliVEvent *event)
         Int_t lStoredRefMult = header->GetRefMultiplicityComb08();
         if( lStoredRefMult == -4 ) lReturnValue = kFALSE;
     }
-    return lReturnValue;
+    return StoreFlag( event, kNoInconsistentSPDandTrackVertices, lReturnValue );
 }
 
 //______________________________________________________________________
@@ -708,19 +825,23 @@ Int_t AliPPVsMultUtils::GetStandardReferenceMultiplicity(AliVEvent *event, Bool_
 Bool_t AliPPVsMultUtils::IsNotPileupSPDInMultBins(AliVEvent *event)
 // Checks if not pileup from SPD (via IsPileupFromSPDInMultBins)
 {
+    //Already evaluated for this event
+    Int_t lCached = FindFlag( event, kNotPileupSPDInMultBins );
+    if ( lCached >= 0 ) return lCached;
+
     Bool_t lReturnValue = kTRUE;
     //Getting around to the SPD vertex -> typecast to ESD/AOD
     if (event->InheritsFrom("AliESDEvent")) {
         AliESDEvent *esdevent = dynamic_cast<AliESDEvent *>(event);
-        if (!esdevent) return kFALSE;
+        if (!esdevent) return StoreFlag( event, kNotPileupSPDInMultBins, kFALSE );
         if ( esdevent->IsPileupFromSPDInMultBins() == kTRUE ) lReturnValue = kFALSE;
     }
     else if (event->InheritsFrom("AliAODEvent")) {
         AliAODEvent *aodevent = dynamic_cast<AliAODEvent *>(event);
-        if (!aodevent) return kFALSE;
+        if (!aodevent) return StoreFlag( event, kNotPileupSPDInMultBins, kFALSE );
         if ( aodevent->IsPileupFromSPDInMultBins() == kTRUE ) lReturnValue = kFALSE;
     }
-    return lReturnValue;
+    return StoreFlag( event, kNotPileupSPDInMultBins, lReturnValue );
 }
 
 //______________________________________________________________________
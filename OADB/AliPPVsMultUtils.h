@@ -1,6 +1,7 @@
 #ifndef AliPPVsMultUtils_H
 #define AliPPVsMultUtils_H
 
+#include <vector>
 #include "TObject.h"
 #include "AliVEvent.h"
 
@@ -13,6 +14,9 @@ class AliPPVsMultUtils : public TObject {
 
 public:
 
+    //Estimators of GetMultiplicityPercentile
+    enum EEstimator { kV0M = 0, kV0A, kV0C, kV0MEq, kV0AEq, kV0CEq, kV0B, kV0Apartial, kV0Cpartial, kV0S, kV0SB, kNEstimators };
+
     AliPPVsMultUtils();
     virtual ~AliPPVsMultUtils() {};
 
@@ -45,6 +49,9 @@ public:
 
 private:
 
+    Bool_t FillPercentiles(AliVEvent *event, Float_t *lPercentiles);
+    Float_t FindPercentile(Int_t lEstimator, Double_t lValue) const;
+
     Int_t fRunNumber; // for control of run changes
     Bool_t fCalibrationLoaded; // control flag
 
@@ -63,8 +70,13 @@ private:
 
     //To Store <V0A>, <V0C>, <V0Apartial> and <V0Cpartial> on a run-per-run basis
     TH1D *fAverageAmplitudes; 
+
+    //Flat copies of the calibration of the current run, for the lookup in every event
+    std::vector<Double_t> fBoundaryEdges[kNEstimators];  //! bin edges of the boundary histograms
+    std::vector<Float_t>  fBoundaryValues[kNEstimators]; //! percentile per bin, including under- and overflow
+    std::vector<Double_t> fAverageValues;                //! <V0A>, <V0C>, <V0Apartial>, <V0Cpartial>
     
-    ClassDef(AliPPVsMultUtils,3) // base helper class
+    ClassDef(AliPPVsMultUtils,4) // base helper class
 };
 #endif
 
@@ -65,6 +65,7 @@
 //   Origin: Jan Fiete Grosse-Oetringhaus, CERN 
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
+#include <algorithm>
 #include <vector>
 
 #include <Riostream.h>
@@ -111,6 +112,23 @@
 
 class StringToRegexp : public std::map<std::string, TPRegexp> {};
 
+// Trigger class strings of fCollTrigClasses and fBGTrigClasses parsed once per run:
+// the regexps on the fired trigger classes are evaluated once per event and shared
+// by all the classes, and the bunch crossing requirement becomes a lookup table
+class TriggerClassTable {
+public:
+  struct TriggerClass {
+    std::vector<std::pair<Int_t, Bool_t> > fPatterns; // index in fRegexps, required (kTRUE) or rejected (kFALSE)
+    std::vector<UChar_t> fBXMask;                      // accepted bunch crossings, empty if no requirement
+    UInt_t fReturnCode;                                // offline trigger bits returned if successful
+    Int_t fTriggerLogic;                               // trigger logic index
+  };
+  std::vector<TriggerClass> fClasses;
+  std::vector<TPRegexp*> fRegexps;    // distinct regexps of all the classes
+  std::vector<std::string> fPatterns; // trigger strings of fRegexps
+  std::vector<UChar_t> fMatches;      // result of fRegexps for the current event
+};
+
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -132,7 +150,8 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fTriggerToFormula(new StringToFormula()),
-fTriggerToRegexp(new StringToRegexp())
+fTriggerToRegexp(new StringToRegexp()),
+fTriggerClassTable(0)
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -162,7 +181,8 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fFillOADB(0),
  fTriggerOADB(0),
  fTriggerToFormula(new StringToFormula()),
- fTriggerToRegexp(new StringToRegexp())
+ fTriggerToRegexp(new StringToRegexp()),
+ fTriggerClassTable(0)
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -179,6 +199,7 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
+  delete fTriggerClassTable;
 }
 
 UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
@@ -302,18 +323,32 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     if (eventType != 7) return kFALSE;
   }
   
+  if (!fTriggerClassTable) CompileTriggerClasses();
+
+  // evaluate the fired trigger class patterns once for all the classes
+  TString classes = event->GetFiredTriggerClasses();
+  AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", classes.Data()));
+  const Int_t nPatterns = fTriggerClassTable->fRegexps.size();
+  for (Int_t i=0; i<nPatterns; i++) fTriggerClassTable->fMatches[i] = fTriggerClassTable->fRegexps[i]->Match(classes, "", 0, 1);
+  const Int_t bx = event->GetBunchCrossNumber();
+
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
+  TIter nextTriggerAnalysis(&fTriggerAnalysis);
+  // the detector decisions are computed once and shared by the trigger analysis objects,
+  // which are all configured with the same parameters
+  AliTriggerAnalysis* firstTriggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.First());
+  if (firstTriggerAnalysis) firstTriggerAnalysis->EvaluateAll(event);
   for (Int_t i=0; i<nColl+nBG; i++) {
-    const char* triggerClass = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
-    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", triggerClass));
+    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName()));
     
-    AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.At(i));
+    AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (nextTriggerAnalysis());
     triggerAnalysis->FillTriggerClasses(event);
+    if (triggerAnalysis != firstTriggerAnalysis) triggerAnalysis->CopyEventDecisions(*firstTriggerAnalysis);
     
     Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    UInt_t singleTriggerResult = CheckCompiledTriggerClass(i, bx, triggerLogic);
     if (!singleTriggerResult) continue;
     Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
     Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
@@ -322,6 +357,9 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     if (!offlineDecision) continue;
     accept |= singleTriggerResult;
   }
+  nextTriggerAnalysis.Reset();
+  while (AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (nextTriggerAnalysis()))
+    triggerAnalysis->ResetEventDecisions();
   
   if (accept) AliDebug(AliLog::kDebug, Form("Accepted event as collision candidate with bit mask %d", accept));
   return accept;
@@ -487,11 +525,95 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
   }
   
   fCurrentRun = runNumber;
+  CompileTriggerClasses();
 
   TH1::AddDirectory(oldStatus);
   return kTRUE;
 }
 
+void AliPhysicsSelection::CompileTriggerClasses(){
+  // parses the trigger class strings (same format as in CheckTriggerClass)
+  // into the lookup tables used by IsCollisionCandidate
+  delete fTriggerClassTable;
+  fTriggerClassTable = new TriggerClassTable;
+
+  struct Util {
+    static Int_t atoi(const char*& str) {
+      Int_t ret = 0;
+      while (*str && *str != ' ')
+        ret = 10 * ret + (*str++ - '0');
+      return ret;
+    }
+  };
+  const Int_t kNBX = 3564; // number of bunch crossings in the LHC orbit
+
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  fTriggerClassTable->fClasses.resize(nColl+nBG);
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    const char* trigger = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
+    TriggerClassTable::TriggerClass& cls = fTriggerClassTable->fClasses[i];
+    cls.fReturnCode = AliVEvent::kUserDefined;
+    cls.fTriggerLogic = 0;
+
+    std::string str;
+    while (*trigger) {
+      // required or rejected triggers
+      if (*trigger == '+' || *trigger == '-') {
+        Bool_t flag = (*trigger == '+');
+        trigger++;
+        const char* begin = trigger;
+        while (*trigger && *trigger != ' ')
+          trigger++;
+        str.assign(begin, trigger);
+
+        std::vector<std::string>& patterns = fTriggerClassTable->fPatterns;
+        Int_t index = std::find(patterns.begin(), patterns.end(), str) - patterns.begin();
+        if (index == (Int_t) patterns.size()) {
+          patterns.push_back(str);
+          fTriggerClassTable->fRegexps.push_back(&FindRegexp(str));
+        }
+        cls.fPatterns.push_back(std::make_pair(index, flag));
+        continue;
+      }
+      // bunch crossing
+      if (*trigger == '#') {
+        if (cls.fBXMask.empty()) cls.fBXMask.assign(kNBX, 0);
+        Int_t bx = Util::atoi(++trigger);
+        if (bx >= (Int_t) cls.fBXMask.size()) cls.fBXMask.resize(bx+1, 0);
+        if (bx >= 0) cls.fBXMask[bx] = 1;
+        continue;
+      }
+      // return value
+      if (*trigger == '&') {
+        cls.fReturnCode = Util::atoi(++trigger);
+        continue;
+      }
+      // triggerLogic value
+      if (*trigger == '*') {
+        cls.fTriggerLogic = Util::atoi(++trigger);
+        continue;
+      }
+      trigger++;
+    }
+  }
+  fTriggerClassTable->fMatches.assign(fTriggerClassTable->fRegexps.size(), 0);
+}
+
+UInt_t AliPhysicsSelection::CheckCompiledTriggerClass(Int_t i, Int_t bx, Int_t& triggerLogic) const {
+  // equivalent of CheckTriggerClass for the i-th trigger class, using the pattern
+  // results of the current event stored in fTriggerClassTable
+  const TriggerClassTable::TriggerClass& cls = fTriggerClassTable->fClasses[i];
+  for (size_t j=0; j<cls.fPatterns.size(); j++) {
+    if (fTriggerClassTable->fMatches[cls.fPatterns[j].first] != cls.fPatterns[j].second)
+      return kFALSE; // required not found or rejected found
+  }
+  if (!cls.fBXMask.empty() && (bx < 0 || bx >= (Int_t) cls.fBXMask.size() || !cls.fBXMask[bx])) return kFALSE;
+
+  triggerLogic = cls.fTriggerLogic;
+  return cls.fReturnCode;
+}
+
 void AliPhysicsSelection::FillStatistics(){
   Bool_t oldStatus = TH1::AddDirectoryStatus();
   TH1::AddDirectory(kFALSE);
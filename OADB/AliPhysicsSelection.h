@@ -45,6 +45,7 @@ class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
 class StringToRegexp;
+class TriggerClassTable;
 
 typedef std::pair<R5TFormula, std::vector<AliTriggerAnalysis::Trigger>> FormulaAndBits;
 typedef std::map<std::string, FormulaAndBits> StringToFormula;
@@ -128,6 +129,10 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
+  TriggerClassTable* fTriggerClassTable; //! Trigger classes precompiled for the current run
+  void CompileTriggerClasses();
+  UInt_t CheckCompiledTriggerClass(Int_t i, Int_t bx, Int_t& triggerLogic) const;
+
   ClassDef(AliPhysicsSelection, 24)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
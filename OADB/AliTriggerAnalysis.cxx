@@ -31,6 +31,7 @@
 #include "TMap.h"
 #include "TRandom.h"
 #include "TEllipse.h"
+#include <cstring>
 #include "AliTriggerAnalysis.h"
 #include "AliLog.h"
 #include "AliVEvent.h"
@@ -112,12 +113,15 @@ fHistFMDSum(0),
 fHistT0(0),
 fHistOFOvsTKLAcc(0),
 fHistV0MOnVsOfAcc(0),
-fTriggerClasses(new TMap)
+fTriggerClasses(new TMap),
+fEventDecisionsValid(kFALSE)
 {
   // constructor
   fHistList->SetName("histos");
   fHistList->SetOwner();
   fTriggerClasses->SetOwner();
+  memset(fEventDecisions, 0, sizeof(fEventDecisions));
+  memset(fEventDecisionFilled, 0, sizeof(fEventDecisionFilled));
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -431,6 +435,10 @@ Int_t AliTriggerAnalysis::EvaluateTrigger(const AliVEvent* event, Trigger trigge
   UInt_t triggerNoFlags = (UInt_t) trigger % (UInt_t) kStartOfFlags;
   Bool_t offline = trigger & kOfflineFlag;
   
+  // decisions precomputed for the current event by EvaluateAll
+  if (fEventDecisionsValid && triggerNoFlags < kNEventDecisions && fEventDecisionFilled[offline][triggerNoFlags])
+    return fEventDecisions[offline][triggerNoFlags];
+  
   if (!offline) {
     if ( triggerNoFlags==kT0BG
       || triggerNoFlags==kT0Pileup
@@ -623,6 +631,132 @@ Bool_t AliTriggerAnalysis::IsOfflineTriggerFired(const AliVEvent* event, Trigger
 }
 
 
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::EvaluateAll(const AliVEvent* event){
+  // computes the SPD, V0, AD, T0 and ZDC decisions of the event with one pass over each detector
+  // and keeps them until ResetEventDecisions, so that EvaluateTrigger does not re-read the
+  // detector data for each trigger class and each term of the trigger logic.
+  // Decisions of detectors without data are not cached: EvaluateTrigger then falls back
+  // to the standard methods, which report the missing information as before.
+  memset(fEventDecisionFilled, 0, sizeof(fEventDecisionFilled));
+  fEventDecisionsValid = kTRUE;
+  
+  // SPD: fast-or chips of both layers in one loop
+  const AliVMultiplicity* mult = event->GetMultiplicity();
+  if (mult) {
+    Int_t nChipsL0 = 0;
+    Int_t nChipsL1 = 0;
+    for (Int_t i=0; i<1200; i++) {
+      if (!mult->TestFastOrFiredChips(i)) continue;
+      if (fSPDGFOEfficiency) if (gRandom->Uniform() > fSPDGFOEfficiency->GetBinContent(i+1)) continue;
+      if (i<400) nChipsL0++;
+      else       nChipsL1++;
+    }
+    SetEventDecision(kSPDGFO,   kFALSE, nChipsL0+nChipsL1);
+    SetEventDecision(kSPDGFOL0, kFALSE, nChipsL0);
+    SetEventDecision(kSPDGFOL1, kFALSE, nChipsL1);
+    Int_t nClsChipsL0 = mult->GetNumberOfFiredChips(0);
+    Int_t nClsChipsL1 = mult->GetNumberOfFiredChips(1);
+    SetEventDecision(kSPDGFO,   kTRUE, nClsChipsL0+nClsChipsL1);
+    SetEventDecision(kSPDGFOL0, kTRUE, nClsChipsL0);
+    SetEventDecision(kSPDGFOL1, kTRUE, nClsChipsL1);
+  }
+  
+  // V0: beam-beam and beam-gas flags of both sides in one loop
+  const AliVVZERO* vzero = event->GetVZEROData();
+  if (vzero && vzero->TestBit(AliVVZERO::kDecisionFilled)) {
+    if (vzero->TestBit(AliVVZERO::kOnlineBitsFilled)) {
+      Bool_t bbA = kFALSE, bgA = kFALSE, bbC = kFALSE, bgC = kFALSE;
+      for (Int_t i=0; i<32; i++) {
+        bbC |= vzero->GetBBFlag(i);
+        bgC |= vzero->GetBGFlag(i);
+        bbA |= vzero->GetBBFlag(i+32);
+        bgA |= vzero->GetBGFlag(i+32);
+      }
+      // same workaround for high multiplicity in V0C as in V0Trigger
+      if (fMC && vzero->GetMTotV0C()>1000) bbC = kTRUE;
+      SetEventDecision(kV0A,   kFALSE, bbA);
+      SetEventDecision(kV0C,   kFALSE, bbC);
+      SetEventDecision(kV0ABG, kFALSE, !bbA && bgA);
+      SetEventDecision(kV0CBG, kFALSE, !bbC && bgC);
+    }
+    V0Decision v0A = (V0Decision) vzero->GetV0ADecision();
+    V0Decision v0C = (V0Decision) vzero->GetV0CDecision();
+    SetEventDecision(kV0A,   kTRUE, v0A == kV0BB);
+    SetEventDecision(kV0C,   kTRUE, v0C == kV0BB);
+    SetEventDecision(kV0ABG, kTRUE, v0A == kV0BG);
+    SetEventDecision(kV0CBG, kTRUE, v0C == kV0BG);
+  }
+  
+  // AD
+  const AliVAD* ad = event->GetADData();
+  if (ad) {
+    UShort_t bits = ad->GetTriggerBits();
+    Bool_t bbA = bits & 1<<12;
+    Bool_t bbC = bits & 1<<13;
+    SetEventDecision(kADA,   kFALSE, bbA);
+    SetEventDecision(kADC,   kFALSE, bbC);
+    SetEventDecision(kADABG, kFALSE, !bbA && (bits & 1<<3));
+    SetEventDecision(kADCBG, kFALSE, !bbC && (bits & 1<<5));
+    ADDecision adA = (ADDecision) ad->GetADADecision();
+    ADDecision adC = (ADDecision) ad->GetADCDecision();
+    SetEventDecision(kADA,   kTRUE, adA == kADBB);
+    SetEventDecision(kADC,   kTRUE, adC == kADBB);
+    SetEventDecision(kADABG, kTRUE, adA == kADBG);
+    SetEventDecision(kADCBG, kTRUE, adC == kADBG);
+  }
+  
+  // T0 and ZDC
+  Bool_t hasT0  = kFALSE;
+  Bool_t hasZDC = kFALSE;
+  if (event->GetDataLayoutType()==AliVEvent::kESD) {
+    const AliESDEvent* esd = dynamic_cast<const AliESDEvent*>(event);
+    hasT0  = esd->GetESDTZERO() != 0;
+    hasZDC = esd->GetESDZDC()   != 0;
+  } else if (event->GetDataLayoutType()==AliVEvent::kAOD) {
+    const AliAODEvent* aod = dynamic_cast<const AliAODEvent*>(event);
+    hasT0  = aod->GetTZEROData() != 0;
+    hasZDC = aod->GetZDCData()   != 0;
+  }
+  if (hasT0) {
+    SetEventDecision(kT0, kFALSE, T0Trigger(event, kTRUE) == kT0BB);
+    T0Decision t0 = T0Trigger(event, kFALSE);
+    SetEventDecision(kT0,       kTRUE, t0 == kT0BB);
+    SetEventDecision(kT0BG,     kTRUE, t0 == kT0DecBG);
+    SetEventDecision(kT0Pileup, kTRUE, t0 == kT0DecPileup);
+  }
+  if (hasZDC) {
+    Bool_t zdcNA = kFALSE, zdcNC = kFALSE, zdcPA = kFALSE, zdcPC = kFALSE;
+    if (ZDCTDCFlags(event, zdcNA, zdcNC, zdcPA, zdcPC)) {
+      SetEventDecision(kZNA,     kTRUE, zdcNA);
+      SetEventDecision(kZNC,     kTRUE, zdcNC);
+      SetEventDecision(kZDCTDCA, kTRUE, zdcNA);
+      SetEventDecision(kZDCTDCC, kTRUE, zdcNC);
+    }
+    Bool_t znaBG = kFALSE, zncBG = kFALSE;
+    if (ZDCTimeBGFlags(event, znaBG, zncBG)) {
+      SetEventDecision(kZNABG, kTRUE, znaBG);
+      SetEventDecision(kZNCBG, kTRUE, zncBG);
+    }
+    SetEventDecision(kZDCTime, kTRUE, ZDCTimeTrigger(event));
+  }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::CopyEventDecisions(const AliTriggerAnalysis& source){
+  // takes over the decisions computed by EvaluateAll in an object with the same parameters
+  memcpy(fEventDecisions, source.fEventDecisions, sizeof(fEventDecisions));
+  memcpy(fEventDecisionFilled, source.fEventDecisionFilled, sizeof(fEventDecisionFilled));
+  fEventDecisionsValid = source.fEventDecisionsValid;
+  // the simulated FO efficiency is random and must be applied by each object
+  if (fSPDGFOEfficiency || source.fSPDGFOEfficiency) {
+    fEventDecisionFilled[0][kSPDGFO]   = kFALSE;
+    fEventDecisionFilled[0][kSPDGFOL0] = kFALSE;
+    fEventDecisionFilled[0][kSPDGFOL1] = kFALSE;
+  }
+}
+
 //-------------------------------------------------------------------------------------------------
 Int_t AliTriggerAnalysis::SPDFiredChips(const AliVEvent* event, Int_t origin, Int_t fillHists, Int_t layer){
   // returns the number of fired chips in the SPD
@@ -764,6 +898,23 @@ Bool_t AliTriggerAnalysis::ZDCTDCTrigger(const AliVEvent* event, AliceSide side,
   Bool_t zdcNC = kFALSE;
   Bool_t zdcPA = kFALSE;
   Bool_t zdcPC = kFALSE;
+  if (!ZDCTDCFlags(event, zdcNA, zdcNC, zdcPA, zdcPC)) return kFALSE;
+  
+  if (side == kASide) return ((useZP && zdcPA) || (useZN && zdcNA));
+  if (side == kCSide) return ((useZP && zdcPC) || (useZN && zdcNC));
+  return kFALSE;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Bool_t AliTriggerAnalysis::ZDCTDCFlags(const AliVEvent* event, Bool_t& zdcNA, Bool_t& zdcNC, Bool_t& zdcPA, Bool_t& zdcPC) const{
+  // Fills the ZNA, ZNC, ZPA and ZPC TDC hit flags of both sides in one pass over the TDC data
+  // returns kFALSE if the ZDC information is not available
+  
+  zdcNA = kFALSE;
+  zdcNC = kFALSE;
+  zdcPA = kFALSE;
+  zdcPC = kFALSE;
   
   if (fMC) { // If it's MC, we use the energy
     Double_t minEnergy = 0;
@@ -774,6 +925,7 @@ Bool_t AliTriggerAnalysis::ZDCTDCTrigger(const AliVEvent* event, AliceSide side,
   } else if (event->GetDataLayoutType()==AliVEvent::kESD){
     const AliESDEvent* esd = dynamic_cast<const AliESDEvent*>(event);
     AliESDZDC* esdZDC = esd->GetESDZDC();
+    if (!esdZDC) return kFALSE;
     for (Int_t i=0;i<4;i++){
       zdcNA|= esdZDC->GetZDCTDCData(esdZDC->GetZNATDCChannel(),i)!=0;
       zdcNC|= esdZDC->GetZDCTDCData(esdZDC->GetZNCTDCChannel(),i)!=0;
@@ -783,6 +935,7 @@ Bool_t AliTriggerAnalysis::ZDCTDCTrigger(const AliVEvent* event, AliceSide side,
   } else if (event->GetDataLayoutType()==AliVEvent::kAOD){
     const AliAODEvent* aod = dynamic_cast<const AliAODEvent*>(event);
     AliAODZDC* aodZDC = aod->GetZDCData();
+    if (!aodZDC) return kFALSE;
     for (Int_t i=0;i<4;i++){
       // 999 is set if corresponding esdZDC->GetZDCTDCData(ch,i) is 0
       zdcNA|= aodZDC->GetZNATDCm(i)<998;
@@ -793,10 +946,7 @@ Bool_t AliTriggerAnalysis::ZDCTDCTrigger(const AliVEvent* event, AliceSide side,
   } else {
     return kFALSE;
   }
-  
-  if (side == kASide) return ((useZP && zdcPA) || (useZN && zdcNA));
-  if (side == kCSide) return ((useZP && zdcPC) || (useZN && zdcNC));
-  return kFALSE;
+  return kTRUE;
 }
 
 
@@ -864,7 +1014,24 @@ Bool_t AliTriggerAnalysis::ZDCTimeTrigger(const AliVEvent* event, Int_t fillHist
 Bool_t AliTriggerAnalysis::ZDCTimeBGTrigger(const AliVEvent* event, AliceSide side) const{
   // This method implements a selection based on the timing in zdcN
   // It can be used in order to flag background
-  if(fMC) return kFALSE;
+  Bool_t znabadhit = kFALSE;
+  Bool_t zncbadhit = kFALSE;
+  if (!ZDCTimeBGFlags(event, znabadhit, zncbadhit)) return kFALSE;
+  
+  if (side == kASide) return znabadhit;
+  if (side == kCSide) return zncbadhit;
+
+  return kFALSE;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Bool_t AliTriggerAnalysis::ZDCTimeBGFlags(const AliVEvent* event, Bool_t& znabadhit, Bool_t& zncbadhit) const{
+  // Fills the ZNA and ZNC background flags of ZDCTimeBGTrigger in one pass over the TDC data
+  // returns kFALSE if the ZDC information is not available
+  znabadhit = kFALSE;
+  zncbadhit = kFALSE;
+  if(fMC) return kTRUE;
 
   Float_t zna[4]={0};
   Float_t znc[4]={0};
@@ -872,6 +1039,7 @@ Bool_t AliTriggerAnalysis::ZDCTimeBGTrigger(const AliVEvent* event, AliceSide si
   if (event->GetDataLayoutType()==AliVEvent::kESD) {
     const AliESDEvent* esd = dynamic_cast<const AliESDEvent*>(event);
     AliESDZDC* esdZDC = esd->GetESDZDC();
+    if (!esdZDC) return kFALSE;
     Int_t detChZNA  = esdZDC->GetZNATDCChannel();
     Int_t detChZNC  = esdZDC->GetZNCTDCChannel();
     for (Int_t i=0;i<4;i++) zna[i] = esdZDC->GetZDCTDCCorrected(detChZNA,i);
@@ -879,26 +1047,20 @@ Bool_t AliTriggerAnalysis::ZDCTimeBGTrigger(const AliVEvent* event, AliceSide si
   } else if (event->GetDataLayoutType()==AliVEvent::kAOD){
     const AliAODEvent* aod = dynamic_cast<const AliAODEvent*>(event);
     AliAODZDC* aodZDC = aod->GetZDCData();
+    if (!aodZDC) return kFALSE;
     for (Int_t i=0;i<4;i++) zna[i] = aodZDC->GetZNATDCm(i);
     for (Int_t i=0;i<4;i++) znc[i] = aodZDC->GetZNCTDCm(i);
   } else {
     return kFALSE;
   }
   
-  Bool_t znabadhit = kFALSE;
-  Bool_t zncbadhit = kFALSE;
-  
   for(Int_t i = 0; i < 4; ++i) {
     Float_t absZNA = TMath::Abs(zna[i]);
     Float_t absZNC = TMath::Abs(znc[i]);
     if(absZNA<fZDCCutZNATimeCorrMax && absZNA>fZDCCutZNATimeCorrMin) znabadhit = kTRUE;
     if(absZNC<fZDCCutZNCTimeCorrMax && absZNC>fZDCCutZNCTimeCorrMin) zncbadhit = kTRUE;
   }
-  
-  if (side == kASide) return znabadhit;
-  if (side == kCSide) return zncbadhit;
-
-  return kFALSE;
+  return kTRUE;
 }
 
 
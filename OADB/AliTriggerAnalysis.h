@@ -53,6 +53,11 @@ public:
   Bool_t IsTriggerBitFired(const AliVEvent* event, ULong64_t tclass) const;
   Bool_t IsOfflineTriggerFired(const AliVEvent* event, Trigger trigger);
   
+  // per-event cache of the SPD, V0, AD, T0 and ZDC decisions (see EvaluateAll)
+  void EvaluateAll(const AliVEvent* event);
+  void CopyEventDecisions(const AliTriggerAnalysis& source);
+  void ResetEventDecisions() { fEventDecisionsValid = kFALSE; }
+  
   // some "raw" trigger functions
   ADDecision ADTrigger           (const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists = 0);
   V0Decision V0Trigger           (const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists = 0);
@@ -98,7 +103,12 @@ public:
   void Browse(TBrowser *b);
 
 protected:
+  enum { kNEventDecisions = kADCBG + 1 };
+  
   Int_t FMDHitCombinations(const AliESDEvent* aEsd, AliceSide side, Int_t fillHists = 0);
+  Bool_t ZDCTDCFlags(const AliVEvent* event, Bool_t& zdcNA, Bool_t& zdcNC, Bool_t& zdcPA, Bool_t& zdcPC) const;
+  Bool_t ZDCTimeBGFlags(const AliVEvent* event, Bool_t& znaBG, Bool_t& zncBG) const;
+  void SetEventDecision(Int_t trigger, Bool_t offline, Int_t decision) { fEventDecisions[offline][trigger] = decision; fEventDecisionFilled[offline][trigger] = kTRUE; }
   
   TH1F* fSPDGFOEfficiency;   //! FO efficiency applied in SPDFiredChips. function of chip number (bin 1..400: first layer; 401..1200: second layer)
   
@@ -166,7 +176,11 @@ protected:
 
   TMap* fTriggerClasses;     // counts the active trigger classes (uses the full string)
   
-  ClassDef(AliTriggerAnalysis, 35)
+  Int_t  fEventDecisions[2][kNEventDecisions];      //! decisions of the current event (online, offline) filled by EvaluateAll
+  Bool_t fEventDecisionFilled[2][kNEventDecisions]; //! flags the decisions available in fEventDecisions
+  Bool_t fEventDecisionsValid;                      //! fEventDecisions belong to the current event
+  
+  ClassDef(AliTriggerAnalysis, 36)
 private:
   AliTriggerAnalysis(const AliTriggerAnalysis&);
   AliTriggerAnalysis& operator=(const AliTriggerAnalysis&);
@@ -21,6 +21,7 @@
 #pragma link C++ class AliPhysicsSelectionTask+;
 #pragma link C++ class AliTriggerAnalysis+;
 #pragma link C++ class AliCollisionNormalization+;
+#pragma link C++ class AliCollisionNormalizationCounters+;
 #pragma link C++ class AliCollisionNormalizationTask+;
 #pragma link C++ class AliEventCuts+;
 #pragma link C++ class AliEventCutsContainer+;
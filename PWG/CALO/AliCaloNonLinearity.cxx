@@ -61,8 +61,10 @@ Float_t AliCaloNonLinearity::GetCorrectedEnergy(Float_t clusterEnergy, Int_t isM
 
   // Obtain enum for period name string
 //   fCurrentMC = FindEnumForMCSetString(periodName);
-  fCurrentMC = periodEnum;
-  AliInfo(Form("AliCaloNonLinearity:Period enum has been set to %o\n",fCurrentMC )) ;
+  if(fCurrentMC != periodEnum){
+    fCurrentMC = periodEnum;
+    AliInfo(Form("AliCaloNonLinearity:Period enum has been set to %o\n",fCurrentMC )) ;
+  }
 
   Bool_t fPeriodNameAvailable = kTRUE;
 
@@ -29,6 +29,7 @@
 #include "AliAODEvent.h"
 #include "AliAnaCaloTrackCorrBaseClass.h"
 #include "AliAnaCaloTrackCorrMaker.h"
+#include "AliMCTruthIndex.h"
 #include "AliLog.h"
 #include "AliGenPythiaEventHeader.h"
 
@@ -50,6 +51,7 @@ fAnaDebug(0),                 fCuts(new TList),
 fScaleFactor(-1),
 fFillDataControlHisto(1),     fSumw2(0),
 fCheckPtHard(0),
+fUseMCTruthIndex(0),          fMCTruthIndex(0),
 // Control histograms
 fhNEventsIn(0),               fhNEvents(0),
 fhNExoticEvents(0),           fhNEventsNoTriggerFound(0),
@@ -103,6 +105,8 @@ fScaleFactor(maker.fScaleFactor),
 fFillDataControlHisto(maker.fFillDataControlHisto),
 fSumw2(maker.fSumw2),
 fCheckPtHard(maker.fCheckPtHard),
+fUseMCTruthIndex(maker.fUseMCTruthIndex),
+fMCTruthIndex(0),
 fhNEventsIn(maker.fhNEventsIn),
 fhNEvents(maker.fhNEvents),
 fhNExoticEvents(maker.fhNExoticEvents),
@@ -180,6 +184,8 @@ AliAnaCaloTrackCorrMaker::~AliAnaCaloTrackCorrMaker()
   if (fReader)    delete fReader ;
   if (fCaloUtils) delete fCaloUtils ;
   
+  delete fMCTruthIndex ;
+  
   if(fCuts)
   {
 	  fCuts->Delete();
@@ -1111,6 +1117,13 @@ void AliAnaCaloTrackCorrMaker::ProcessEvent(Int_t iEntry, const char * currentFi
   if ( !TGeoGlobalMagField::Instance()->GetField() && fReader->GetInputEvent() )
       (fReader->GetInputEvent())->InitMagneticField();
   
+  // Build the MC truth index once for all the analyses
+  if ( fUseMCTruthIndex && fReader->GetMC() )
+  {
+    if ( !fMCTruthIndex ) fMCTruthIndex = new AliMCTruthIndex();
+    fMCTruthIndex->Build(fReader->GetMC());
+  }
+  
   // Loop on analysis algorithms
   
   AliDebug(1,"*** Begin analysis ***");
@@ -1122,6 +1135,8 @@ void AliAnaCaloTrackCorrMaker::ProcessEvent(Int_t iEntry, const char * currentFi
     
     ana->ConnectInputOutputAODBranches(); // Sets branches for each analysis
     
+    if ( fMCTruthIndex ) ana->GetMCAnalysisUtils()->SetMCTruthIndex(fUseMCTruthIndex ? fMCTruthIndex : 0x0);
+    
     //Fill pool for mixed event for the analysis that need it
     if(!fReader->IsEventTriggerAtSEOn() && isMBTrigger)
     {
@@ -29,6 +29,7 @@ class TClonesArray;
 class TH1F;
 
 // --- Analysis system ---
+class AliMCTruthIndex;
 #include "AliCaloTrackReader.h" 
 #include "AliCalorimeterUtils.h"
 
@@ -82,6 +83,10 @@ class AliAnaCaloTrackCorrMaker : public TObject {
   void    SwitchOnPtHardHistogram()        { fCheckPtHard = kTRUE  ; }
   void    SwitchOffPtHardHistogram()       { fCheckPtHard = kFALSE ; }
 
+  void    SwitchOnMCTruthIndex()           { fUseMCTruthIndex = kTRUE  ; }
+  void    SwitchOffMCTruthIndex()          { fUseMCTruthIndex = kFALSE ; }
+  AliMCTruthIndex * GetMCTruthIndex()      { return fMCTruthIndex  ; }
+
   void    SetScaleFactor(Double_t scale)   { fScaleFactor = scale  ; } 
 
   void    SetCaloUtils(AliCalorimeterUtils * cu) { fCaloUtils = cu ; }
@@ -135,6 +140,10 @@ class AliAnaCaloTrackCorrMaker : public TObject {
   Bool_t   fSumw2 ;                                  ///<  Call the histograms method Sumw2() after initialization, off by default, too large memory booking, use carefully
     
   Bool_t   fCheckPtHard ;                            ///< For MC done in pT-Hard bins, plot specific histogram
+
+  Bool_t   fUseMCTruthIndex ;                        ///< Build once per event a MC truth index shared by the MC utils of all analyses
+
+  AliMCTruthIndex * fMCTruthIndex ;                  //!<! MC truth index of the current event
     
   // Control histograms
   
@@ -206,7 +215,7 @@ class AliAnaCaloTrackCorrMaker : public TObject {
   AliAnaCaloTrackCorrMaker & operator = (const AliAnaCaloTrackCorrMaker & ) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaCaloTrackCorrMaker,27) ;
+  ClassDef(AliAnaCaloTrackCorrMaker,28) ;
   /// \endcond
 
 } ;
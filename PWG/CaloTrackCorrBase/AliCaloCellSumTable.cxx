@@ -0,0 +1,325 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TMath.h>
+#include <TH2I.h>
+
+// --- AliRoot system ---
+#include "AliVCaloCells.h"
+#include "AliEMCALGeometry.h"
+
+//---- ANALYSIS system ----
+#include "AliCalorimeterUtils.h"
+#include "AliFiducialCut.h"
+#include "AliCaloCellSumTable.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloCellSumTable) ;
+/// \endcond
+
+//________________________________________
+/// Default constructor
+//________________________________________
+AliCaloCellSumTable::AliCaloCellSumTable() :
+TObject(),
+fMinCellEnergy(0.),
+fCalorimeter(-1), fRun(-1),
+fFilled(kFALSE),
+fNCols(0),        fNRows(0),
+fCellIndex(),     fCellCol(),
+fCellRow(),       fCellEnergy(),
+fEnergyTable(),   fGoodTable()
+{
+}
+
+//________________________________________
+/// Forget the channel map, it is done again
+/// in the next call to Fill().
+//________________________________________
+void AliCaloCellSumTable::Reset()
+{
+  fCalorimeter = -1;
+  fRun         = -1;
+  fFilled      = kFALSE;
+  fNCols       = 0;
+  fNRows       = 0;
+
+  fCellIndex  .clear();
+  fCellCol    .clear();
+  fCellRow    .clear();
+  fCellEnergy .clear();
+  fEnergyTable.clear();
+  fGoodTable  .clear();
+}
+
+//________________________________________
+/// Place all the channels of the calorimeter in the (column,row)
+/// space, mask the bad channels and fill the table of good channels.
+/// \param calo: AliFiducialCut::kEMCAL or AliFiducialCut::kPHOS
+/// \param run: run number, the bad channels are taken for this run
+/// \param caloUtils: geometry and bad channel access
+//________________________________________
+void AliCaloCellSumTable::BuildChannelMap(Int_t calo, Int_t run, AliCalorimeterUtils * caloUtils)
+{
+  Reset();
+
+  // EMCal absId start at 0, PHOS absId at 1 for 5 modules of 64x56 crystals, CPV pads after
+  Int_t firstId = 0;
+  Int_t nIds    = 0;
+  if ( calo == AliFiducialCut::kEMCAL )
+  {
+    if ( caloUtils->GetEMCALGeometry() ) nIds = caloUtils->GetEMCALGeometry()->GetNCells();
+  }
+  else if ( calo == AliFiducialCut::kPHOS )
+  {
+    firstId = 1;
+    nIds    = 1 + 5*64*56;
+  }
+
+  fCellCol  .assign(nIds, -1);
+  fCellRow  .assign(nIds, -1);
+  fCellIndex.assign(nIds, -1);
+
+  std::vector<Bool_t> good(nIds, kFALSE);
+
+  Bool_t removeBad = caloUtils->IsBadChannelsRemovalSwitchedOn();
+
+  Int_t icol = -1, irow = -1, iRCU = -1, icolAbs = -1, irowAbs = -1;
+  for(Int_t absId = firstId; absId < nIds; absId++)
+  {
+    Int_t imod = caloUtils->GetModuleNumberCellIndexesAbsCaloMap(absId, calo, icol, irow, iRCU, icolAbs, irowAbs);
+    if ( imod < 0 || icolAbs < 0 || irowAbs < 0 ) continue; // PHOS CPV
+
+    fCellCol[absId] = icolAbs;
+    fCellRow[absId] = irowAbs;
+
+    if ( icolAbs >= fNCols ) fNCols = icolAbs+1;
+    if ( irowAbs >= fNRows ) fNRows = irowAbs+1;
+
+    Int_t status = 0;
+    if ( removeBad )
+    {
+      if ( calo == AliFiducialCut::kEMCAL )
+        status = caloUtils->GetEMCALChannelStatus(imod, icol, irow);
+      else
+      {
+        TH2I * map = caloUtils->GetPHOSChannelStatusMap(imod);
+        if ( map ) status = (Int_t) map->GetBinContent(irow, icol);
+      }
+    }
+
+    good[absId] = ( status == 0 );
+  }
+
+  fCellEnergy .assign(fNCols*fNRows, 0.);
+  fEnergyTable.assign((fNCols+1)*(fNRows+1), 0.);
+  fGoodTable  .assign((fNCols+1)*(fNRows+1), 0.);
+
+  std::vector<Double_t> goodCells(fNCols*fNRows, 0.);
+  for(Int_t absId = firstId; absId < nIds; absId++)
+  {
+    if ( !good[absId] ) continue;
+
+    Int_t index = fCellRow[absId]*fNCols+fCellCol[absId];
+    fCellIndex[absId] = index;
+    goodCells[index]  = 1.;
+  }
+
+  // Summed-area table, entry (irow+1,icol+1) is the sum of positions [0,irow]x[0,icol]
+  Int_t nCols = fNCols+1;
+  for(Int_t row = 0; row < fNRows; row++)
+  {
+    for(Int_t col = 0; col < fNCols; col++)
+    {
+      fGoodTable[(row+1)*nCols+col+1] = goodCells[row*fNCols+col]
+                                      + fGoodTable[ row   *nCols+col+1]
+                                      + fGoodTable[(row+1)*nCols+col  ]
+                                      - fGoodTable[ row   *nCols+col  ];
+    }
+  }
+
+  fCalorimeter = calo;
+  fRun         = run;
+}
+
+//________________________________________
+/// Add the energy of the cells of the event and fill the summed-area
+/// table. The channel map is done again if the run or calorimeter changed.
+/// \param cells: cells of the event
+/// \param calo: AliFiducialCut::kEMCAL or AliFiducialCut::kPHOS
+/// \param run: run number
+/// \param caloUtils: geometry and bad channel access
+//________________________________________
+void AliCaloCellSumTable::Fill(AliVCaloCells * cells, Int_t calo, Int_t run, AliCalorimeterUtils * caloUtils)
+{
+  if ( calo != fCalorimeter || run != fRun ) BuildChannelMap(calo, run, caloUtils);
+
+  fFilled = kFALSE;
+  fCellEnergy.assign(fNCols*fNRows, 0.);
+
+  if ( !cells ) return;
+
+  Int_t nIds = fCellIndex.size();
+  for(Int_t icell = 0; icell < cells->GetNumberOfCells(); icell++)
+  {
+    Int_t absId = cells->GetCellNumber(icell);
+    if ( absId < 0 || absId >= nIds || fCellIndex[absId] < 0 ) continue;
+
+    Double_t amp = cells->GetAmplitude(icell);
+    if ( amp <= fMinCellEnergy ) continue;
+
+    fCellEnergy[fCellIndex[absId]] += amp;
+  }
+
+  Int_t nCols = fNCols+1;
+  for(Int_t row = 0; row < fNRows; row++)
+  {
+    for(Int_t col = 0; col < fNCols; col++)
+    {
+      fEnergyTable[(row+1)*nCols+col+1] = fCellEnergy[row*fNCols+col]
+                                        + fEnergyTable[ row   *nCols+col+1]
+                                        + fEnergyTable[(row+1)*nCols+col  ]
+                                        - fEnergyTable[ row   *nCols+col  ];
+    }
+  }
+
+  fFilled = kTRUE;
+}
+
+//________________________________________
+/// \return kTRUE if the absId is a channel of the calorimeter, good or bad.
+/// \param absId: cell absolute ID
+/// \param col: absolute column, output
+/// \param row: absolute row, output
+//________________________________________
+Bool_t AliCaloCellSumTable::GetCellPosition(Int_t absId, Int_t & col, Int_t & row) const
+{
+  col = -1;
+  row = -1;
+
+  if ( absId < 0 || absId >= (Int_t) fCellCol.size() || fCellCol[absId] < 0 ) return kFALSE;
+
+  col = fCellCol[absId];
+  row = fCellRow[absId];
+
+  return kTRUE;
+}
+
+//________________________________________
+/// \return approximate angular size of a cell in radians, to express a cone size in cell units.
+/// \param calo: AliFiducialCut::kEMCAL or AliFiducialCut::kPHOS
+//________________________________________
+Float_t AliCaloCellSumTable::GetCellSize(Int_t calo)
+{
+  if ( calo == AliFiducialCut::kPHOS ) return 0.0049; // 2.26 cm at 4.6 m
+
+  return 0.0143;
+}
+
+//________________________________________
+/// \return number of (column,row) positions at a distance smaller than the radius
+/// from a position, in or out of the calorimeter, the area of the cone used in DiskSum().
+//________________________________________
+Int_t AliCaloCellSumTable::GetNDiskPositions(Int_t radius)
+{
+  Int_t n  = 0;
+  Int_t r2 = radius*radius;
+  for(Int_t drow = -radius+1; drow < radius; drow++)
+    n += 2*DiskHalfWidth(r2, drow)+1;
+
+  return n;
+}
+
+//________________________________________
+/// \return largest dcol with dcol^2 + drow^2 < r2, the half width of a cone row.
+//________________________________________
+Int_t AliCaloCellSumTable::DiskHalfWidth(Int_t r2, Int_t drow)
+{
+  Int_t width = Int_t(TMath::Sqrt(Double_t(r2-drow*drow)));
+  while ( width > 0 && width*width+drow*drow >= r2 ) width--;
+
+  return width;
+}
+
+//________________________________________
+/// \return sum of a summed-area table over the positions [rowMin,rowMax]x[colMin,colMax], already clipped.
+//________________________________________
+Double_t AliCaloCellSumTable::TableSum(const std::vector<Double_t> & table,
+                                       Int_t colMin, Int_t colMax, Int_t rowMin, Int_t rowMax) const
+{
+  Int_t nCols = fNCols+1;
+
+  return table[(rowMax+1)*nCols+colMax+1] - table[rowMin*nCols+colMax+1]
+       - table[(rowMax+1)*nCols+colMin  ] + table[rowMin*nCols+colMin  ];
+}
+
+//________________________________________
+/// \return energy of the cells in the rectangle [colMin,colMax]x[rowMin,rowMax], limits included.
+/// \param nPositions: number of (column,row) positions in the rectangle within the table range, output
+/// \param nGood: number of good channels in the rectangle, output
+//________________________________________
+Double_t AliCaloCellSumTable::RectangleSum(Int_t colMin, Int_t colMax, Int_t rowMin, Int_t rowMax,
+                                           Int_t & nPositions, Int_t & nGood) const
+{
+  nPositions = 0;
+  nGood      = 0;
+
+  colMin = TMath::Max(colMin, 0);
+  rowMin = TMath::Max(rowMin, 0);
+  colMax = TMath::Min(colMax, fNCols-1);
+  rowMax = TMath::Min(rowMax, fNRows-1);
+
+  if ( colMax < colMin || rowMax < rowMin ) return 0.;
+
+  nPositions = (colMax-colMin+1)*(rowMax-rowMin+1);
+  nGood      = TMath::Nint(TableSum(fGoodTable, colMin, colMax, rowMin, rowMax));
+
+  if ( !fFilled ) return 0.;
+
+  return TableSum(fEnergyTable, colMin, colMax, rowMin, rowMax);
+}
+
+//________________________________________
+/// \return energy of the cells at a distance in cell units smaller than
+/// the radius, same cone definition as AliIsolationCut::GetCellDensity().
+/// \param col: column of the cone center
+/// \param row: row of the cone center
+/// \param radius: cone radius in cell units
+/// \param nPositions: number of (column,row) positions in the cone within the table range, output
+/// \param nGood: number of good channels in the cone, output
+//________________________________________
+Double_t AliCaloCellSumTable::DiskSum(Int_t col, Int_t row, Int_t radius,
+                                      Int_t & nPositions, Int_t & nGood) const
+{
+  nPositions = 0;
+  nGood      = 0;
+
+  Double_t sum = 0.;
+  Int_t    r2  = radius*radius;
+
+  for(Int_t drow = -radius+1; drow < radius; drow++)
+  {
+    Int_t width = DiskHalfWidth(r2, drow);
+
+    Int_t nPos = 0, nGoodRow = 0;
+    sum += RectangleSum(col-width, col+width, row+drow, row+drow, nPos, nGoodRow);
+
+    nPositions += nPos;
+    nGood      += nGoodRow;
+  }
+
+  return sum;
+}
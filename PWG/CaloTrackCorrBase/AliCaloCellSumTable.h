@@ -0,0 +1,98 @@
+#ifndef ALICALOCELLSUMTABLE_H
+#define ALICALOCELLSUMTABLE_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloCellSumTable
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Summed-area table of the calorimeter cell energies of an event, in (column,row) cell index space.
+///
+/// The EMCal/DCal or PHOS cells are placed in the absolute (column,row) space of
+/// AliCalorimeterUtils::GetModuleNumberCellIndexesAbsCaloMap(). The channel map
+/// (position of each absId, bad channels) is done once per run, the cell energies
+/// are added once per event from AliVCaloCells, and the summed-area (2D prefix sum)
+/// tables of the energy and of the number of good channels are filled, so that:
+///  * the energy in a (column,row) rectangle (UE bands) is obtained from 4 table lookups,
+///  * the energy in a cone, approximated by the cells at a distance in cell units
+///    smaller than the radius, is summed row by row with one lookup per row.
+///
+/// Bad channels, if removal is on in AliCalorimeterUtils, and positions without
+/// channel do not contribute, the number of positions within the table range and
+/// of good channels in the summed region is also returned for the acceptance normalization.
+/// Used by AliIsolationCut, the table of each calorimeter is kept by AliCaloTrackReader.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <vector>
+
+class AliVCaloCells;
+class AliCalorimeterUtils;
+
+class AliCaloCellSumTable : public TObject {
+
+ public:
+
+  AliCaloCellSumTable() ;
+  virtual ~AliCaloCellSumTable() { ; }
+
+  void       Reset() ;
+  void       Fill(AliVCaloCells * cells, Int_t calo, Int_t run, AliCalorimeterUtils * caloUtils) ;
+
+  Bool_t     IsFilled()                  const { return fFilled     ; }
+  Int_t      GetCalorimeter()            const { return fCalorimeter ; }
+  Int_t      GetNColumns()               const { return fNCols      ; }
+  Int_t      GetNRows()                  const { return fNRows      ; }
+
+  Float_t    GetMinCellEnergy()          const { return fMinCellEnergy ; }
+  void       SetMinCellEnergy(Float_t e)       { fMinCellEnergy = e    ; }
+
+  Bool_t     GetCellPosition(Int_t absId, Int_t & col, Int_t & row) const ;
+
+  static Float_t GetCellSize(Int_t calo) ;
+  static Int_t   GetNDiskPositions(Int_t radius) ;
+
+  Double_t   RectangleSum(Int_t colMin, Int_t colMax, Int_t rowMin, Int_t rowMax,
+                          Int_t & nPositions, Int_t & nGood) const ;
+
+  Double_t   DiskSum(Int_t col, Int_t row, Int_t radius,
+                     Int_t & nPositions, Int_t & nGood) const ;
+
+ private:
+
+  void       BuildChannelMap(Int_t calo, Int_t run, AliCalorimeterUtils * caloUtils) ;
+
+  static Int_t DiskHalfWidth(Int_t r2, Int_t drow) ;
+
+  Double_t   TableSum(const std::vector<Double_t> & table,
+                      Int_t colMin, Int_t colMax, Int_t rowMin, Int_t rowMax) const ;
+
+  Float_t    fMinCellEnergy;               ///<  Minimum cell energy to be added to the table.
+
+  Int_t      fCalorimeter;                 //!<! Calorimeter of the channel map, -1 if none.
+  Int_t      fRun;                         //!<! Run of the channel map.
+  Bool_t     fFilled;                      //!<! The energy table is filled for the current event.
+  Int_t      fNCols;                       //!<! Number of columns.
+  Int_t      fNRows;                       //!<! Number of rows.
+
+  std::vector<Int_t>    fCellIndex;        //!<! Position row*fNCols+col of each absId, -1 if no or bad channel.
+  std::vector<Int_t>    fCellCol;          //!<! Column of each absId, -1 if no channel.
+  std::vector<Int_t>    fCellRow;          //!<! Row of each absId, -1 if no channel.
+  std::vector<Double_t> fCellEnergy;       //!<! Energy per position, fNCols x fNRows.
+  std::vector<Double_t> fEnergyTable;      //!<! Summed-area table of fCellEnergy, (fNRows+1)x(fNCols+1).
+  std::vector<Double_t> fGoodTable;        //!<! Summed-area table of the good channels, (fNRows+1)x(fNCols+1).
+
+  /// Copy constructor not implemented.
+  AliCaloCellSumTable(              const AliCaloCellSumTable & t) ;
+
+  /// Assignment operator not implemented.
+  AliCaloCellSumTable & operator = (const AliCaloCellSumTable & t) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloCellSumTable,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOCELLSUMTABLE_H
@@ -35,6 +35,7 @@
 #include "AliInputEventHandler.h"
 #include "AliAODMCParticle.h"
 #include "AliMultSelection.h"
+#include "AliMCHeaderCache.h"
 
 // ---- Detectors ----
 #include "AliPHOSGeoUtils.h"
@@ -44,6 +45,8 @@
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackSharedInput.h"
+#include "AliCaloCellSumTable.h"
 
 // ---- Jets ----
 #include "AliAODJet.h"
@@ -103,6 +106,9 @@ fListMixedTracksEvents(),    fListMixedCaloEvents(),
 fLastMixedTracksEvent(-1),   fLastMixedCaloEvent(-1),
 fWriteOutputDeltaAOD(kFALSE),
 fEMCALClustersListName(""),  fEMCALCellsListName(""),  
+fSharedInputMode(kNoSharedInput), fSharedInputName("CaloTrackCorrSharedInput"),
+fSharedInputSettings(""),    fSharedInput(0x0),           fSharedInputWarning(kFALSE),
+fCellSumTableMinCellEnergy(0.),
 fZvtxCut(0.),
 fAcceptFastCluster(kFALSE),  fRemoveLEDEvents(0),
 //Trigger rejection
@@ -141,6 +147,7 @@ fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeade
   for(Int_t i = 0; i < 7; i++) fhPHOSClusterCutsE  [i]= 0x0 ;  
   for(Int_t i = 0; i < 6; i++) fhCTSTrackCutsPt    [i]= 0x0 ;    
   for(Int_t j = 0; j < 5; j++) { fMCGenerToAccept  [j] =  ""; fMCGenerIndexToAccept[j] = -1; }
+  for(Int_t i = 0; i < 2; i++) { fCellSumTable     [i] = 0x0; fCellSumTableEvent   [i] = -1; }
   
   InitParameters();
 }
@@ -160,6 +167,10 @@ AliCaloTrackReader::~AliCaloTrackReader()
 void AliCaloTrackReader::DeletePointers()
 {  
   delete fFiducialCut ;
+  
+  if(fSharedInputMode == kPublishSharedInput) delete fSharedInput ;
+
+  for(Int_t i = 0; i < 2; i++) delete fCellSumTable[i] ;
 	
   if(fAODBranchList)
   {
@@ -651,30 +662,20 @@ Bool_t AliCaloTrackReader::ComparePtHardAndJetPt()
        ) return kTRUE ;
     //printf("\t yes \n");
     
-    Int_t nTriggerJets =  pygeh->NTriggerJets();
     Float_t ptHard = pygeh->GetPtHard();
-    TParticle * jet =  0;
 
-    AliDebug(1,Form("Njets: %d, pT Hard %f",nTriggerJets, ptHard));
+    // The leading trigger jet is shared with the other wagons of the event
+    Float_t jetPt = AliMCHeaderCache::GetLeadingTriggerJetPt(pygeh);
+
+    AliDebug(1,Form("Njets: %d, pT Hard %f, leading pycell jet pT %f",pygeh->NTriggerJets(), ptHard, jetPt));
     
-    Float_t tmpjet[]={0,0,0,0};
-    for(Int_t ijet = 0; ijet< nTriggerJets; ijet++)
+    //Compare jet pT and pt Hard
+    if(jetPt > fPtHardAndJetPtFactor * ptHard)
     {
-      pygeh->TriggerJet(ijet, tmpjet);
-      jet = new TParticle(94, 21, -1, -1, -1, -1, tmpjet[0],tmpjet[1],tmpjet[2],tmpjet[3], 0,0,0,0);
-      
-      AliDebug(1,Form("jet %d; pycell jet pT %f",ijet, jet->Pt()));
-      
-      //Compare jet pT and pt Hard
-      if(jet->Pt() > fPtHardAndJetPtFactor * ptHard)
-      {
-        AliInfo(Form("Reject jet event with : process %d, pT Hard %2.2f, pycell jet pT %2.2f, rejection factor %1.1f\n",
-                     process, ptHard, jet->Pt(), fPtHardAndJetPtFactor));
-        return kFALSE;
-      }
+      AliInfo(Form("Reject jet event with : process %d, pT Hard %2.2f, pycell jet pT %2.2f, rejection factor %1.1f\n",
+                   process, ptHard, jetPt, fPtHardAndJetPtFactor));
+      return kFALSE;
     }
-    
-    if(jet) delete jet;
   }
   
   return kTRUE ;
@@ -1271,6 +1272,10 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
   fIsTriggerMatchOpenCut[1] = kFALSE ;
   fIsTriggerMatchOpenCut[2] = kFALSE ;
   
+  // Lists published in a previous event are not valid anymore
+  if(fSharedInput && fSharedInputMode == kPublishSharedInput)
+    fSharedInput->Invalidate();
+  
   //fCurrentFileName = TString(currentFileName);
   if(!fInputEvent)
   {
@@ -1463,13 +1468,20 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
   //------------------------------------------------------
   fVertexBC = fInputEvent->GetPrimaryVertex()->GetBC();
   
+  //-----------------------------------------------
+  // Take the lists of a previous reader with the 
+  // same settings, if published for this event
+  //-----------------------------------------------
+  
+  Bool_t sharedInput = ConsumeSharedInput();
+  
   //-----------------------------------------------
   // Fill the arrays with cluster/tracks/cells data
   //-----------------------------------------------
   
   if(fFillCTS)
   {
-    FillInputCTS();
+    if ( !sharedInput ) FillInputCTS();
     //Accept events with at least one track
     if(fTrackMult[0] == 0 && fDoRejectNoTrackEvents) return kFALSE ;
     
@@ -1493,10 +1505,10 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
   if(fFillPHOSCells)
     FillInputPHOSCells();
   
-  if(fFillEMCAL || fFillDCAL)
+  if((fFillEMCAL || fFillDCAL) && !sharedInput)
     FillInputEMCAL();
   
-  if(fFillPHOS)
+  if(fFillPHOS && !sharedInput)
     FillInputPHOS();
   
   FillInputVZERO();
@@ -1507,6 +1519,9 @@ Bool_t AliCaloTrackReader::FillInputEvent(Int_t iEntry, const char * /*curFileNa
   if(fFillInputBackgroundJetBranch)
     FillInputBackgroundJets();
 
+  if(fSharedInputMode == kPublishSharedInput)
+    PublishSharedInput();
+
   AliDebug(1,"Event accepted for analysis");
 
   return kTRUE ;
@@ -2416,6 +2431,159 @@ void AliCaloTrackReader::FillInputPHOS()
   AliDebug(1,Form("PHOS selected clusters %d",fPHOSClusters->GetEntriesFast())) ;  
 }
 
+//_____________________________________________________
+/// \return The list of parameters of the reader, computed once. 
+/// Readers with the same list can share the selected lists.
+//_____________________________________________________
+const TString & AliCaloTrackReader::GetSharedInputSettings()
+{
+  if ( fSharedInputSettings.Length() == 0 )
+  {
+    TObjString * parList = GetListOfParameters();
+    fSharedInputSettings = parList->GetString();
+    delete parList;
+  }
+  
+  return fSharedInputSettings;
+}
+
+//_____________________________________________________
+/// Publish the selected CTS/EMCal/DCal/PHOS lists of this event in the
+/// input event list, for the readers of the wagons executed after this one.
+/// Together with the lists, a cut mask per item (TOF/BC for tracks, time
+/// window for clusters) and the event counters filled with the lists are stored.
+/// Not available for mixed events or MC kinematics input.
+//_____________________________________________________
+void AliCaloTrackReader::PublishSharedInput()
+{
+  if ( fMixedEvent || fDataType == kMC ) return;
+  
+  if ( !fSharedInput ) fSharedInput = new AliCaloTrackSharedInput(fSharedInputName);
+  
+  if ( !fInputEvent->FindListObject(fSharedInputName) ) fInputEvent->AddObject(fSharedInput);
+  
+  fSharedInput->Reset(fInputEvent, fEventNumber, GetSharedInputSettings());
+  
+  Double_t bz = fInputEvent->GetMagneticField();
+  
+  for(Int_t itrack = 0; itrack < fCTSTracks->GetEntriesFast(); itrack++)
+  {
+    AliVTrack * track = (AliVTrack*) fCTSTracks->At(itrack);
+    UInt_t mask = 0;
+    
+    if ( (track->GetStatus() & AliVTrack::kTOFout) == AliVTrack::kTOFout )
+    {
+      mask |= AliCaloTrackSharedInput::kTrackTOF;
+      if ( fAccessTrackTOF && track->GetTOFBunchCrossing(bz) == 0 ) mask |= AliCaloTrackSharedInput::kTrackBC0;
+    }
+    
+    fSharedInput->Add(AliCaloTrackSharedInput::kCTS, track, mask);
+  }
+  
+  TObjArray * caloLists[2] = { fEMCALClusters, fDCALClusters };
+  Int_t       sharedList[2] = { AliCaloTrackSharedInput::kEMCAL, AliCaloTrackSharedInput::kDCAL };
+  for(Int_t ilist = 0; ilist < 2; ilist++)
+  {
+    for(Int_t iclus = 0; iclus < caloLists[ilist]->GetEntriesFast(); iclus++)
+    {
+      AliVCluster * clus = (AliVCluster*) caloLists[ilist]->At(iclus);
+      UInt_t mask = IsInTimeWindow(clus->GetTOF()*1e9, clus->E()) ? AliCaloTrackSharedInput::kClusterInTime : 0;
+      fSharedInput->Add(sharedList[ilist], clus, mask);
+    }
+  }
+  
+  for(Int_t iclus = 0; iclus < fPHOSClusters->GetEntriesFast(); iclus++)
+    fSharedInput->Add(AliCaloTrackSharedInput::kPHOS, fPHOSClusters->At(iclus), 0);
+  
+  for(Int_t i = 0; i < 10; i++)
+  {
+    fSharedInput->fTrackMult [i] = fTrackMult [i];
+    fSharedInput->fTrackSumPt[i] = fTrackSumPt[i];
+  }
+  
+  for(Int_t i = 0; i < 19; i++)
+  {
+    fSharedInput->fTrackBCEvent   [i] = fTrackBCEvent   [i];
+    fSharedInput->fTrackBCEventCut[i] = fTrackBCEventCut[i];
+    fSharedInput->fEMCalBCEvent   [i] = fEMCalBCEvent   [i];
+    fSharedInput->fEMCalBCEventCut[i] = fEMCalBCEventCut[i];
+  }
+  
+  fSharedInput->fVertexBC           = fVertexBC;
+  fSharedInput->fNPileUpClusters    = fNPileUpClusters;
+  fSharedInput->fNNonPileUpClusters = fNNonPileUpClusters;
+  
+  AliDebug(1,Form("Published shared lists <%s>: CTS %d, EMCal %d, DCal %d, PHOS %d",fSharedInputName.Data(),
+                  fCTSTracks->GetEntriesFast(),fEMCALClusters->GetEntriesFast(),
+                  fDCALClusters->GetEntriesFast(),fPHOSClusters->GetEntriesFast()));
+}
+
+//_____________________________________________________
+/// Fill the CTS/EMCal/DCal/PHOS lists and the corresponding event counters
+/// from the lists published by a reader executed before in the train, 
+/// if available for this event and if the list of parameters of both readers
+/// is the same. The tracks and clusters are not filtered or corrected again,
+/// the cut histograms of the filling methods are not filled.
+/// \return kTRUE if the lists were taken from the shared ones
+//_____________________________________________________
+Bool_t AliCaloTrackReader::ConsumeSharedInput()
+{
+  if ( fSharedInputMode != kConsumeSharedInput ) return kFALSE;
+  
+  if ( fMixedEvent || fDataType == kMC ) return kFALSE;
+  
+  fSharedInput = dynamic_cast<AliCaloTrackSharedInput*> (fInputEvent->FindListObject(fSharedInputName));
+  
+  if ( !fSharedInput || !fSharedInput->IsAvailableFor(fInputEvent, fEventNumber, GetSharedInputSettings()) )
+  {
+    if ( fSharedInput && !fSharedInputWarning && 
+         fSharedInput->IsAvailableFor(fInputEvent, fEventNumber, fSharedInput->GetSettings()) )
+    {
+      AliWarning(Form("Shared lists <%s> published with different settings, fill own lists",fSharedInputName.Data()));
+      fSharedInputWarning = kTRUE;
+    }
+    
+    AliDebug(1,Form("Shared lists <%s> not available, fill own lists",fSharedInputName.Data()));
+    return kFALSE;
+  }
+  
+  if ( fFillCTS )
+    fCTSTracks->AddAll(fSharedInput->GetList(AliCaloTrackSharedInput::kCTS));
+  
+  if ( fFillEMCAL || fFillDCAL )
+  {
+    fEMCALClusters->AddAll(fSharedInput->GetList(AliCaloTrackSharedInput::kEMCAL));
+    fDCALClusters ->AddAll(fSharedInput->GetList(AliCaloTrackSharedInput::kDCAL ));
+  }
+  
+  if ( fFillPHOS )
+    fPHOSClusters->AddAll(fSharedInput->GetList(AliCaloTrackSharedInput::kPHOS));
+  
+  for(Int_t i = 0; i < 10; i++)
+  {
+    fTrackMult [i] = fSharedInput->fTrackMult [i];
+    fTrackSumPt[i] = fSharedInput->fTrackSumPt[i];
+  }
+  
+  for(Int_t i = 0; i < 19; i++)
+  {
+    fTrackBCEvent   [i] = fSharedInput->fTrackBCEvent   [i];
+    fTrackBCEventCut[i] = fSharedInput->fTrackBCEventCut[i];
+    fEMCalBCEvent   [i] = fSharedInput->fEMCalBCEvent   [i];
+    fEMCalBCEventCut[i] = fSharedInput->fEMCalBCEventCut[i];
+  }
+  
+  fVertexBC           = fSharedInput->fVertexBC;
+  fNPileUpClusters    = fSharedInput->fNPileUpClusters;
+  fNNonPileUpClusters = fSharedInput->fNNonPileUpClusters;
+  
+  AliDebug(1,Form("Use shared lists <%s>: CTS %d, EMCal %d, DCal %d, PHOS %d",fSharedInputName.Data(),
+                  fCTSTracks->GetEntriesFast(),fEMCALClusters->GetEntriesFast(),
+                  fDCALClusters->GetEntriesFast(),fPHOSClusters->GetEntriesFast()));
+  
+  return kTRUE;
+}
+
 //____________________________________________
 /// Connects the array with EMCAL cells and the pointer.
 //____________________________________________
@@ -2435,6 +2603,30 @@ void AliCaloTrackReader::FillInputPHOSCells()
   fPHOSCells = fInputEvent->GetPHOSCells();
 }
 
+//___________________________________________
+/// \return The summed-area table of the cell energies of the
+/// current event for kEMCAL or kPHOS, filled once per event at the
+/// first request and shared by all the analyses using this reader.
+//___________________________________________
+AliCaloCellSumTable * AliCaloTrackReader::GetCellSumTable(Int_t calo)
+{
+  if ( calo != kEMCAL && calo != kPHOS ) return 0x0;
+
+  if ( !fCellSumTable[calo] ) fCellSumTable[calo] = new AliCaloCellSumTable();
+
+  if ( fCellSumTableEvent[calo] != fEventNumber || !fCellSumTable[calo]->IsFilled() )
+  {
+    AliVCaloCells * cells = ( calo == kEMCAL ) ? fEMCALCells : fPHOSCells;
+    Int_t run = fInputEvent ? fInputEvent->GetRunNumber() : -1;
+
+    fCellSumTable[calo]->SetMinCellEnergy(fCellSumTableMinCellEnergy);
+    fCellSumTable[calo]->Fill(cells, calo, run, fCaloUtils);
+    fCellSumTableEvent[calo] = fEventNumber;
+  }
+
+  return fCellSumTable[calo];
+}
+
 //_______________________________________
 /// Fill VZERO information in data member, 
 /// add all the channels information.
@@ -51,6 +51,8 @@ class AliVCluster;
 // --- CaloTrackCorr / EMCAL ---
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
+class AliCaloTrackSharedInput;
+class AliCaloCellSumTable;
 #include "AliAnaWeights.h"
 
 // Jets
@@ -124,6 +126,9 @@ public:
   /// Smearing function enum.
   enum smearingFunction     { kNoSmearing, kSmearingLandau, kSmearingLandauShift           } ;
 
+  /// Sharing of the selected lists with other readers of the train, see AliCaloTrackSharedInput.
+  enum sharedInputMode      { kNoSharedInput, kPublishSharedInput, kConsumeSharedInput     } ;
+
   // Minimum pt setters and getters
   
   Float_t          GetEMCALPtMin()                   const { return fEMCALPtMin            ; }
@@ -286,6 +291,20 @@ public:
   virtual void     FillInputPHOSCells() ;
   virtual void     FillInputVZERO() ;  
   
+  // Selected lists shared with the readers of other wagons
+
+  void             SetSharedInputName(TString name)        { fSharedInputName = name                  ; }
+  TString          GetSharedInputName()              const { return fSharedInputName                  ; }
+  void             SwitchOnSharedInputPublishing()         { fSharedInputMode = kPublishSharedInput   ; }
+  void             SwitchOnSharedInputConsuming()          { fSharedInputMode = kConsumeSharedInput   ; }
+  void             SwitchOffSharedInput()                  { fSharedInputMode = kNoSharedInput        ; }
+  Int_t            GetSharedInputMode()              const { return fSharedInputMode                  ; }
+  AliCaloTrackSharedInput * GetSharedInput()         const { return fSharedInput                      ; }
+
+  virtual void     PublishSharedInput() ;
+  virtual Bool_t   ConsumeSharedInput() ;
+  const TString &  GetSharedInputSettings() ;
+  
   Int_t            GetV0Signal(Int_t i)              const { return fV0ADC[i]               ; }
   Int_t            GetV0Multiplicity(Int_t i)        const { return fV0Mul[i]               ; }
   
@@ -303,6 +322,11 @@ public:
   virtual TObjArray*     GetPHOSClusters()           const { return fPHOSClusters           ; }
   virtual AliVCaloCells* GetEMCALCells()             const { return fEMCALCells             ; }
   virtual AliVCaloCells* GetPHOSCells()              const { return fPHOSCells              ; }
+
+  /// Summed-area table of the cell energies of the current event, see AliCaloCellSumTable.
+  AliCaloCellSumTable *  GetCellSumTable(Int_t calo) ;
+  Float_t          GetCellSumTableMinCellEnergy()    const { return fCellSumTableMinCellEnergy ; }
+  void             SetCellSumTableMinCellEnergy(Float_t e) { fCellSumTableMinCellEnergy = e    ; }
   
   //-------------------------------------
   // Event/track selection methods
@@ -888,6 +912,16 @@ public:
   TString          fEMCALClustersListName;         ///<  Alternative list of clusters produced elsewhere and not from InputEvent.
   TString          fEMCALCellsListName;            ///<  Alternative list of cells produced elsewhere and not from InputEvent.
   
+  Int_t            fSharedInputMode;               ///<  Publish or consume the selected lists, see enum sharedInputMode.
+  TString          fSharedInputName;               ///<  Name of the shared lists object in the input event.
+  TString          fSharedInputSettings;           //!<! List of parameters of this reader, compared with the one of the shared lists.
+  AliCaloTrackSharedInput * fSharedInput;          //!<! Shared lists, owned by the publishing reader.
+  Bool_t           fSharedInputWarning;            //!<! Incompatible settings of the shared lists already reported.
+
+  Float_t          fCellSumTableMinCellEnergy;     ///<  Minimum cell energy added to the cell energy tables.
+  AliCaloCellSumTable * fCellSumTable[2];          //!<! Cell energy tables of EMCal and PHOS, filled once per event on request.
+  Int_t            fCellSumTableEvent[2];          //!<! Event number of the last fill of the cell energy tables.
+  
   //  Event selection
   
   Float_t          fZvtxCut ;	                     ///<  Cut on vertex position.
@@ -997,7 +1031,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,79) ;
+  ClassDef(AliCaloTrackReader,81) ;
   /// \endcond
 
 } ;
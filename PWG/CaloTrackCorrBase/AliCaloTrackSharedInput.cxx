@@ -0,0 +1,83 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//---- ANALYSIS system ----
+#include "AliCaloTrackSharedInput.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackSharedInput) ;
+/// \endcond
+
+//________________________________________
+/// Default constructor
+//________________________________________
+AliCaloTrackSharedInput::AliCaloTrackSharedInput() :
+TNamed(),
+fVertexBC(0),
+fNPileUpClusters(0), fNNonPileUpClusters(0),
+fEvent(0x0), fEntry(-1), fSettings()
+{
+  Reset(0x0, -1, "");
+}
+
+//________________________________________
+/// Constructor
+/// \param name: name of the object in the input event list
+//________________________________________
+AliCaloTrackSharedInput::AliCaloTrackSharedInput(const char * name) :
+TNamed(name, "Shared CaloTrackCorr reader lists"),
+fVertexBC(0),
+fNPileUpClusters(0), fNNonPileUpClusters(0),
+fEvent(0x0), fEntry(-1), fSettings()
+{
+  Reset(0x0, -1, "");
+}
+
+//________________________________________
+/// Empty the lists and counters before filling them for a new event.
+/// \param event: input event of the lists
+/// \param entry: entry of the event
+/// \param settings: list of parameters of the publishing reader
+//________________________________________
+void AliCaloTrackSharedInput::Reset(const AliVEvent * event, Int_t entry, const TString & settings)
+{
+  fEvent    = event;
+  fEntry    = entry;
+  fSettings = settings;
+
+  for(Int_t ilist = 0; ilist < kNLists; ilist++)
+  {
+    fList[ilist].Clear();
+    fMask[ilist].clear();
+  }
+
+  for(Int_t i = 0; i < 10; i++)
+  {
+    fTrackMult [i] = 0;
+    fTrackSumPt[i] = 0;
+  }
+
+  for(Int_t i = 0; i < 19; i++)
+  {
+    fTrackBCEvent   [i] = 0;
+    fTrackBCEventCut[i] = 0;
+    fEMCalBCEvent   [i] = 0;
+    fEMCalBCEventCut[i] = 0;
+  }
+
+  fVertexBC           = 0;
+  fNPileUpClusters    = 0;
+  fNNonPileUpClusters = 0;
+}
@@ -0,0 +1,98 @@
+#ifndef ALICALOTRACKSHAREDINPUT_H
+#define ALICALOTRACKSHAREDINPUT_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackSharedInput
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Selected CTS/EMCal/DCal/PHOS lists of one reader, shared with the other readers of the train.
+///
+/// A reader with SwitchOnSharedInputPublishing() adds this object to the input
+/// event list, and fills it at the end of each accepted event with its
+/// selected tracks and clusters, a cut mask per item and the event counters
+/// computed while filling. Readers of the wagons executed after it, with
+/// SwitchOnSharedInputConsuming() and the same list of parameters
+/// (AliCaloTrackReader::GetListOfParameters()), take the lists from here
+/// instead of filtering the tracks and correcting the clusters again.
+///
+/// The items are not owned, they are the tracks and clusters of the input
+/// event, already corrected by the publishing reader, and have to be
+/// treated as read-only by the consumers.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TNamed.h>
+#include <TObjArray.h>
+#include <TString.h>
+#include <vector>
+
+//--- AliRoot system ---
+class AliVEvent;
+
+class AliCaloTrackSharedInput : public TNamed {
+
+ public:
+
+  AliCaloTrackSharedInput() ;
+  AliCaloTrackSharedInput(const char * name) ;
+  virtual ~AliCaloTrackSharedInput() { ; }
+
+  /// Detector lists
+  enum sharedList { kCTS, kEMCAL, kDCAL, kPHOS, kNLists } ;
+
+  /// Bits of the cut mask of each item
+  enum sharedMask
+  {
+    kTrackTOF        = 1<<0,  ///< track with TOF signal
+    kTrackBC0        = 1<<1,  ///< track with TOF signal in bunch crossing 0
+    kClusterInTime   = 1<<2   ///< cluster in the time window of the publishing reader
+  } ;
+
+  void         Reset(const AliVEvent * event, Int_t entry, const TString & settings) ;
+  void         Invalidate()                                    { fEvent = 0x0 ; fEntry = -1 ; }
+
+  /// \return true if filled for this event and entry with the given reader settings
+  Bool_t       IsAvailableFor(const AliVEvent * event, Int_t entry, const TString & settings) const
+  { return fEvent && fEvent == event && fEntry == entry && fSettings == settings ; }
+
+  const TString & GetSettings()                          const { return fSettings ; }
+
+  void         Add(Int_t list, TObject * obj, UInt_t mask)     { fList[list].Add(obj) ; fMask[list].push_back(mask) ; }
+  TObjArray  * GetList(Int_t list)                             { return &fList[list] ; }
+  Int_t        GetNEntries(Int_t list)                   const { return fList[list].GetEntriesFast() ; }
+  UInt_t       GetMask(Int_t list, Int_t i)              const { return fMask[list][i] ; }
+
+  // Event counters computed while filling the lists
+
+  Int_t        fTrackMult[10];        ///<  Track multiplicity, count for different pT cuts
+  Float_t      fTrackSumPt[10];       ///<  Track sum pT, count for different pT cuts
+  Int_t        fTrackBCEvent[19];     ///<  Tracks per BC
+  Int_t        fTrackBCEventCut[19];  ///<  Tracks per BC, after pT/acceptance cut
+  Int_t        fEMCalBCEvent[19];     ///<  EMCal clusters per BC
+  Int_t        fEMCalBCEventCut[19];  ///<  EMCal clusters per BC, after E/acceptance cut
+  Int_t        fVertexBC;             ///<  Vertex BC
+  Int_t        fNPileUpClusters;      ///<  Number of clusters out of the time window
+  Int_t        fNNonPileUpClusters;   ///<  Number of clusters in the time window
+
+ private:
+
+  const AliVEvent   *  fEvent;            //!<! input event the lists were filled for
+  Int_t                fEntry;            //!<! entry the lists were filled for
+  TString              fSettings;         //!<! list of parameters of the publishing reader
+  TObjArray            fList[kNLists];    //!<! selected items per detector, not owned
+  std::vector<UInt_t>  fMask[kNLists];    //!<! cut mask (sharedMask) per item
+
+  /// Copy constructor not implemented.
+  AliCaloTrackSharedInput(              const AliCaloTrackSharedInput & in) ;
+
+  /// Assignment operator not implemented.
+  AliCaloTrackSharedInput & operator = (const AliCaloTrackSharedInput & in) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackSharedInput,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKSHAREDINPUT_H
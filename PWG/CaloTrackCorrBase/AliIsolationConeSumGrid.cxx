@@ -0,0 +1,345 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TMath.h>
+#include <algorithm>
+
+//---- ANALYSIS system ----
+#include "AliIsolationConeSumGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliIsolationConeSumGrid) ;
+/// \endcond
+
+//________________________________________
+/// Default constructor
+//________________________________________
+AliIsolationConeSumGrid::AliIsolationConeSumGrid() :
+TObject(),
+fCellSize(0.1), fEtaMin(0.),
+fNEta(0),       fNPhi(0),
+fItemObj(),     fItemID(),
+fItemPt(),      fItemEta(),
+fItemPhi(),     fItemCell(),
+fCellFirst(),   fCellItems(),
+fCellSum(),     fCellMax(),
+fTable(),       fIDIndex()
+{
+}
+
+//________________________________________
+/// Remove the items of the previous event.
+//________________________________________
+void AliIsolationConeSumGrid::Reset()
+{
+  fItemObj.clear();
+  fItemID .clear();
+  fItemPt .clear();
+  fItemEta.clear();
+  fItemPhi.clear();
+  fItemCell.clear();
+  fIDIndex.clear();
+
+  fNEta = 0;
+  fNPhi = 0;
+}
+
+//________________________________________
+/// Add a track or cluster, call Build() once all are added.
+/// \param obj: track or cluster
+/// \param id: ID of the track or cluster to find it with FindItems(), negative if not needed
+/// \param pt: transverse momentum
+/// \param eta: pseudorapidity
+/// \param phi: azimuthal angle in [0,2pi[
+//________________________________________
+void AliIsolationConeSumGrid::AddItem(TObject * obj, Int_t id, Float_t pt, Float_t eta, Float_t phi)
+{
+  fItemObj.push_back(obj);
+  fItemID .push_back(id);
+  fItemPt .push_back(pt);
+  fItemEta.push_back(eta);
+  fItemPhi.push_back(phi);
+}
+
+//________________________________________
+/// Sort the items in cells and fill the
+/// per cell sums and the summed-area table.
+/// \param cellSize: size of the cells in eta and phi
+//________________________________________
+void AliIsolationConeSumGrid::Build(Float_t cellSize)
+{
+  fCellSize = cellSize;
+
+  Int_t   nItems = GetNItems();
+  Float_t etaMax = 0;
+
+  fEtaMin = 0;
+  if ( nItems > 0 )
+  {
+    fEtaMin = *std::min_element(fItemEta.begin(), fItemEta.end());
+    etaMax  = *std::max_element(fItemEta.begin(), fItemEta.end());
+  }
+
+  fNEta = Int_t((etaMax-fEtaMin)/fCellSize) + 1;
+  fNPhi = Int_t(TMath::TwoPi()/fCellSize)   + 1;
+
+  Int_t nCells = fNEta*fNPhi;
+
+  fCellFirst.assign(nCells+1, 0);
+  fCellSum  .assign(nCells  , 0.);
+  fCellMax  .assign(nCells  , 0.);
+  fItemCell .resize(nItems);
+
+  for(Int_t i = 0; i < nItems; i++)
+  {
+    Int_t ieta = TMath::Min(TMath::Max(Int_t((fItemEta[i]-fEtaMin)/fCellSize), 0), fNEta-1);
+    Int_t iphi = TMath::Min(TMath::Max(Int_t( fItemPhi[i]         /fCellSize), 0), fNPhi-1);
+
+    Int_t cell   = ieta*fNPhi+iphi;
+    fItemCell[i] = cell;
+
+    fCellFirst[cell+1]++;
+    fCellSum  [cell] += fItemPt[i];
+    if ( fItemPt[i] > fCellMax[cell] ) fCellMax[cell] = fItemPt[i];
+  }
+
+  for(Int_t cell = 0; cell < nCells; cell++) fCellFirst[cell+1] += fCellFirst[cell];
+
+  std::vector<Int_t> position(fCellFirst.begin(), fCellFirst.end()-1);
+  fCellItems.resize(nItems);
+  for(Int_t i = 0; i < nItems; i++) fCellItems[position[fItemCell[i]]++] = i;
+
+  // Summed-area table, entry (ieta+1,iphi+1) is the sum of cells [0,ieta]x[0,iphi]
+  fTable.assign((fNEta+1)*(fNPhi+1), 0.);
+  for(Int_t ieta = 0; ieta < fNEta; ieta++)
+  {
+    for(Int_t iphi = 0; iphi < fNPhi; iphi++)
+    {
+      fTable[(ieta+1)*(fNPhi+1)+iphi+1] = fCellSum[ieta*fNPhi+iphi]
+                                        + fTable[ ieta   *(fNPhi+1)+iphi+1]
+                                        + fTable[(ieta+1)*(fNPhi+1)+iphi  ]
+                                        - fTable[ ieta   *(fNPhi+1)+iphi  ];
+    }
+  }
+
+  fIDIndex.clear();
+  for(Int_t i = 0; i < nItems; i++)
+  {
+    if ( fItemID[i] >= 0 ) fIDIndex.push_back(std::make_pair(fItemID[i], i));
+  }
+  std::sort(fIDIndex.begin(), fIDIndex.end());
+}
+
+//________________________________________
+/// Add to the list the items with a given ID.
+/// \param id: ID of the track or cluster, see AddItem()
+/// \param items: list of item indices, output
+//________________________________________
+void AliIsolationConeSumGrid::FindItems(Int_t id, std::vector<Int_t> & items) const
+{
+  if ( id < 0 ) return;
+
+  std::vector< std::pair<Int_t,Int_t> >::const_iterator it =
+  std::lower_bound(fIDIndex.begin(), fIDIndex.end(), std::make_pair(id, -1));
+
+  for( ; it != fIDIndex.end() && it->first == id; it++) items.push_back(it->second);
+}
+
+//________________________________________
+/// Cells of one axis overlapping the interval ]min,max[.
+/// \param min: lower edge of the interval
+/// \param max: upper edge of the interval
+/// \param eta: eta axis if true, phi axis if false
+/// \param first: first cell overlapping, first > last if none
+/// \param last: last cell overlapping
+/// \param fullFirst: first cell fully inside, fullFirst > fullLast if none
+/// \param fullLast: last cell fully inside
+//________________________________________
+void AliIsolationConeSumGrid::CellRange(Float_t min, Float_t max, Bool_t eta,
+                                        Int_t & first, Int_t & last, Int_t & fullFirst, Int_t & fullLast) const
+{
+  Float_t origin = eta ? fEtaMin : 0.;
+  Int_t   n      = eta ? fNEta   : fNPhi;
+
+  first     = 1; last     = 0;
+  fullFirst = 1; fullLast = 0;
+
+  if ( max <= origin || min >= origin+n*fCellSize || min >= max ) return;
+
+  first = TMath::Max(TMath::FloorNint((min-origin)/fCellSize), 0);
+  last  = TMath::Min(TMath::FloorNint((max-origin)/fCellSize), n-1);
+
+  fullFirst = first;
+  fullLast  = last;
+  if ( origin +  first  *fCellSize <= min ) fullFirst++;
+  if ( origin + (last+1)*fCellSize >  max ) fullLast--;
+}
+
+//________________________________________
+/// \return pT sum of the cells [etaFirst,etaLast]x[phiFirst,phiLast], from the summed-area table.
+//________________________________________
+Double_t AliIsolationConeSumGrid::TableSum(Int_t etaFirst, Int_t etaLast, Int_t phiFirst, Int_t phiLast) const
+{
+  Int_t nPhi = fNPhi+1;
+
+  return fTable[(etaLast+1)*nPhi+phiLast+1] - fTable[etaFirst*nPhi+phiLast+1]
+       - fTable[(etaLast+1)*nPhi+phiFirst ] + fTable[etaFirst*nPhi+phiFirst ];
+}
+
+//________________________________________
+/// \return pT sum of the items of a cell inside the rectangle ]etaMin,etaMax[x]phiMin,phiMax[.
+//________________________________________
+Double_t AliIsolationConeSumGrid::CellItemsSum(Int_t cell, Float_t etaMin, Float_t etaMax, Float_t phiMin, Float_t phiMax) const
+{
+  Double_t sum = 0;
+
+  for(Int_t k = fCellFirst[cell]; k < fCellFirst[cell+1]; k++)
+  {
+    Int_t i = fCellItems[k];
+    if ( fItemEta[i] > etaMin && fItemEta[i] < etaMax &&
+         fItemPhi[i] > phiMin && fItemPhi[i] < phiMax ) sum += fItemPt[i];
+  }
+
+  return sum;
+}
+
+//________________________________________
+/// \return pT sum of the items in the rectangle ]etaMin,etaMax[x]phiMin,phiMax[.
+/// The cells fully inside are taken from the summed-area table,
+/// the items of the cells on the border are checked one by one.
+//________________________________________
+Float_t AliIsolationConeSumGrid::RectangleSum(Float_t etaMin, Float_t etaMax, Float_t phiMin, Float_t phiMax) const
+{
+  Int_t etaFirst = 0, etaLast = 0, etaFullFirst = 0, etaFullLast = 0;
+  Int_t phiFirst = 0, phiLast = 0, phiFullFirst = 0, phiFullLast = 0;
+
+  CellRange(etaMin, etaMax, kTRUE , etaFirst, etaLast, etaFullFirst, etaFullLast);
+  CellRange(phiMin, phiMax, kFALSE, phiFirst, phiLast, phiFullFirst, phiFullLast);
+
+  if ( etaFirst > etaLast || phiFirst > phiLast ) return 0;
+
+  Double_t sum = 0;
+  if ( etaFullFirst <= etaFullLast && phiFullFirst <= phiFullLast )
+    sum += TableSum(etaFullFirst, etaFullLast, phiFullFirst, phiFullLast);
+
+  for(Int_t ieta = etaFirst; ieta <= etaLast; ieta++)
+  {
+    Bool_t fullRow = ( ieta >= etaFullFirst && ieta <= etaFullLast && phiFullFirst <= phiFullLast );
+
+    for(Int_t iphi = phiFirst; iphi <= phiLast; iphi++)
+    {
+      // Skip the cells already summed, jump to the last border cell of the row
+      if ( fullRow && iphi == phiFullFirst ) { iphi = phiFullLast; continue; }
+
+      sum += CellItemsSum(ieta*fNPhi+iphi, etaMin, etaMax, phiMin, phiMax);
+    }
+  }
+
+  return sum;
+}
+
+//________________________________________
+/// pT sum of the items at a distance in [rMin,r[ of the disk center,
+/// without wrapping around phi = 0; phiC can be shifted by 2pi to get
+/// the items on the other side. The cells fully inside the disk are taken
+/// from the per cell sums, the cells crossed by the borders or containing
+/// an excluded item are checked item by item.
+/// \param etaC: pseudorapidity of the disk center
+/// \param phiC: azimuthal angle of the disk center
+/// \param r: radius of the disk
+/// \param rMin: items closer to the center are not counted
+/// \param excluded: list of items not counted
+/// \param ptMax: maximum pT of the counted items, output, not reset
+/// \param items: list of the counted items, output, not filled if null
+/// \return pT sum
+//________________________________________
+Float_t AliIsolationConeSumGrid::DiskSum(Float_t etaC, Float_t phiC, Float_t r, Float_t rMin,
+                                         const std::vector<Int_t> & excluded, Float_t & ptMax,
+                                         std::vector<Int_t> * items) const
+{
+  Int_t etaFirst = 0, etaLast = 0, etaFullFirst = 0, etaFullLast = 0;
+  Int_t phiFirst = 0, phiLast = 0, phiFullFirst = 0, phiFullLast = 0;
+
+  CellRange(etaC-r, etaC+r, kTRUE , etaFirst, etaLast, etaFullFirst, etaFullLast);
+  CellRange(phiC-r, phiC+r, kFALSE, phiFirst, phiLast, phiFullFirst, phiFullLast);
+
+  Double_t sum   = 0;
+  Double_t r2    = r*r;
+  Double_t rMin2 = rMin > 0 ? rMin*rMin : -1;
+
+  for(Int_t ieta = etaFirst; ieta <= etaLast; ieta++)
+  {
+    Double_t etaLow  = fEtaMin + ieta*fCellSize - etaC;
+    Double_t etaHigh = etaLow  + fCellSize;
+    Double_t etaNear = etaLow > 0 ? etaLow : (etaHigh < 0 ? -etaHigh : 0);
+    Double_t etaFar  = TMath::Max(TMath::Abs(etaLow), TMath::Abs(etaHigh));
+
+    for(Int_t iphi = phiFirst; iphi <= phiLast; iphi++)
+    {
+      Int_t cell = ieta*fNPhi+iphi;
+      if ( fCellFirst[cell] == fCellFirst[cell+1] ) continue;
+
+      Double_t phiLow  = iphi*fCellSize - phiC;
+      Double_t phiHigh = phiLow + fCellSize;
+      Double_t phiNear = phiLow > 0 ? phiLow : (phiHigh < 0 ? -phiHigh : 0);
+      Double_t phiFar  = TMath::Max(TMath::Abs(phiLow), TMath::Abs(phiHigh));
+
+      Double_t near2 = etaNear*etaNear + phiNear*phiNear;
+      Double_t far2  = etaFar *etaFar  + phiFar *phiFar;
+
+      if ( near2 >= r2 ) continue;
+
+      Bool_t full = ( far2 < r2 && near2 >= rMin2 );
+      for(UInt_t iex = 0; iex < excluded.size() && full; iex++)
+      {
+        if ( fItemCell[excluded[iex]] == cell ) full = kFALSE;
+      }
+
+      if ( full )
+      {
+        sum += fCellSum[cell];
+        if ( fCellMax[cell] > ptMax ) ptMax = fCellMax[cell];
+
+        if ( items )
+        {
+          for(Int_t k = fCellFirst[cell]; k < fCellFirst[cell+1]; k++) items->push_back(fCellItems[k]);
+        }
+
+        continue;
+      }
+
+      for(Int_t k = fCellFirst[cell]; k < fCellFirst[cell+1]; k++)
+      {
+        Int_t i = fCellItems[k];
+
+        if ( std::find(excluded.begin(), excluded.end(), i) != excluded.end() ) continue;
+
+        Float_t dEta = etaC-fItemEta[i];
+        Float_t dPhi = phiC-fItemPhi[i];
+        Float_t rad  = TMath::Sqrt( dEta*dEta + dPhi*dPhi );
+
+        if ( rad >= r || rad < rMin ) continue;
+
+        sum += fItemPt[i];
+        if ( fItemPt[i] > ptMax ) ptMax = fItemPt[i];
+
+        if ( items ) items->push_back(i);
+      }
+    }
+  }
+
+  return sum;
+}
@@ -0,0 +1,93 @@
+#ifndef ALIISOLATIONCONESUMGRID_H
+#define ALIISOLATIONCONESUMGRID_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliIsolationConeSumGrid
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Eta-phi grid of the tracks or clusters of an event, to sum pT in cones and bands.
+///
+/// The items (pT, eta, phi) are added once per event and sorted in cells of
+/// fixed size in eta and phi. The pT sum and maximum of each cell are kept,
+/// together with a summed-area (2D prefix sum) table of the pT, so that:
+///  * the pT in a eta-phi rectangle (UE bands) is obtained from 4 table lookups
+///    plus the items of the cells crossed by the rectangle border,
+///  * the pT in a cone sums the cells fully contained in the cone and
+///    checks item by item only the cells crossed by the cone border.
+///
+/// The phi range is [0,2pi[ and the cones do not wrap around phi=0, as in
+/// AliIsolationCut::MakeIsolationCut where only particles on the same side
+/// of the candidate are counted in the cone. Used by AliIsolationCut.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <vector>
+
+class AliIsolationConeSumGrid : public TObject {
+
+ public:
+
+  AliIsolationConeSumGrid() ;
+  virtual ~AliIsolationConeSumGrid() { ; }
+
+  void       Reset() ;
+  void       AddItem(TObject * obj, Int_t id, Float_t pt, Float_t eta, Float_t phi) ;
+  void       Build(Float_t cellSize) ;
+
+  Int_t      GetNItems()                 const { return fItemPt.size()  ; }
+  TObject *  GetItem(Int_t i)            const { return fItemObj[i]     ; }
+  Float_t    GetItemPt(Int_t i)          const { return fItemPt[i]      ; }
+  Float_t    GetItemEta(Int_t i)         const { return fItemEta[i]     ; }
+  Float_t    GetItemPhi(Int_t i)         const { return fItemPhi[i]     ; }
+
+  void       FindItems(Int_t id, std::vector<Int_t> & items) const ;
+
+  Float_t    RectangleSum(Float_t etaMin, Float_t etaMax, Float_t phiMin, Float_t phiMax) const ;
+
+  Float_t    DiskSum(Float_t etaC, Float_t phiC, Float_t r, Float_t rMin,
+                     const std::vector<Int_t> & excluded, Float_t & ptMax,
+                     std::vector<Int_t> * items = 0x0) const ;
+
+ private:
+
+  void       CellRange(Float_t min, Float_t max, Bool_t eta,
+                       Int_t & first, Int_t & last, Int_t & fullFirst, Int_t & fullLast) const ;
+
+  Double_t   TableSum(Int_t etaFirst, Int_t etaLast, Int_t phiFirst, Int_t phiLast) const ;
+
+  Double_t   CellItemsSum(Int_t cell, Float_t etaMin, Float_t etaMax, Float_t phiMin, Float_t phiMax) const ;
+
+  Float_t    fCellSize;                    ///<  Size of the cells in eta and phi.
+  Float_t    fEtaMin;                      ///<  Lower eta edge of the grid.
+  Int_t      fNEta;                        ///<  Number of cells in eta.
+  Int_t      fNPhi;                        ///<  Number of cells in phi.
+
+  std::vector<TObject*> fItemObj;          //!<! Track or cluster of each item.
+  std::vector<Int_t>    fItemID;           //!<! ID of each item, negative if none.
+  std::vector<Float_t>  fItemPt;           //!<! pT of each item.
+  std::vector<Float_t>  fItemEta;          //!<! Eta of each item.
+  std::vector<Float_t>  fItemPhi;          //!<! Phi of each item, in [0,2pi[.
+  std::vector<Int_t>    fItemCell;         //!<! Cell of each item.
+
+  std::vector<Int_t>    fCellFirst;        //!<! Position in fCellItems of the first item of each cell, one more entry for the end.
+  std::vector<Int_t>    fCellItems;        //!<! Items sorted by cell.
+  std::vector<Double_t> fCellSum;          //!<! pT sum per cell.
+  std::vector<Float_t>  fCellMax;          //!<! Maximum pT per cell.
+  std::vector<Double_t> fTable;            //!<! Summed-area table of fCellSum, (fNEta+1)x(fNPhi+1).
+  std::vector< std::pair<Int_t,Int_t> > fIDIndex; //!<! (ID, item) pairs sorted by ID.
+
+  /// Copy constructor not implemented.
+  AliIsolationConeSumGrid(              const AliIsolationConeSumGrid & g) ;
+
+  /// Assignment operator not implemented.
+  AliIsolationConeSumGrid & operator = (const AliIsolationConeSumGrid & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliIsolationConeSumGrid,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIISOLATIONCONESUMGRID_H
@@ -20,6 +20,7 @@
 #include "AliCaloTrackParticleCorrelation.h"
 #include "AliEMCALGeometry.h"
 #include "AliEMCALGeoParams.h"
+#include "AliPHOSGeoUtils.h"
 #include "AliAODTrack.h"
 #include "AliVCluster.h"
 #include "AliMixedEvent.h"
@@ -31,6 +32,11 @@
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
 #include "AliIsolationCut.h"
+#include "AliIsolationConeSumGrid.h"
+#include "AliCaloCellSumTable.h"
+
+// --- Standard library ---
+#include <algorithm>
 
 /// \cond CLASSIMP
 ClassImp(AliIsolationCut) ;
@@ -54,11 +60,40 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fUseConeSumGrid(kFALSE),
+fConeSumGridCellSize(0.1),
+fTrackGrid(0x0),
+fClusterGrid(0x0),
+fGridEventNumber(-1),
+fGridPartInCone(-1),
+fGridBuild(0),
+fGridLastBuild(-1),
+fGridLastCandidate(0x0),
+fGridLastConeSize(-1),
+fGridLastDistMin(-1),
+fUseCellSumTable(kFALSE)
 {
+  for(Int_t i = 0; i < 2; i++)
+  {
+    fGridLists   [i] = 0x0;
+    fGridNEntries[i] = -1;
+  }
+  
+  for(Int_t i = 0; i < 7; i++) fGridLastSums[i] = 0;
+  
   InitParameters();
 }
 
+//____________________________________
+/// Destructor.
+//____________________________________
+AliIsolationCut::~AliIsolationCut()
+{
+  delete fTrackGrid;
+  delete fClusterGrid;
+}
+
 //_________________________________________________________________________________________________________________________________
 /// Get normalization of cluster background band.
 //_________________________________________________________________________________________________________________________________
@@ -174,6 +209,18 @@ Float_t AliIsolationCut::GetCellDensity(AliCaloTrackParticleCorrelation * pCandi
   Double_t coneCellsBad = 0.; //number of bad cells in cone with radius fConeSize
   Double_t cellDensity  = 1.;
 
+  if ( fUseCellSumTable )
+  {
+    // Count as bad "cells" out of the calorimeter acceptance
+    Float_t energy[3]; Int_t nPositions[3], nGood[3];
+    Int_t   sqrSize = int(fConeSize/AliCaloCellSumTable::GetCellSize(pCandidate->GetDetectorTag())) ;
+    Int_t   nCone   = AliCaloCellSumTable::GetNDiskPositions(sqrSize);
+    if ( GetCellSumsFromTable(pCandidate, reader, energy, nPositions, nGood) && nCone > 0 )
+      cellDensity = Double_t(nGood[0])/nCone;
+
+    return cellDensity;
+  }
+
   Float_t phiC  = pCandidate->Phi() ;
   if(phiC<0) phiC+=TMath::TwoPi();
   Float_t etaC  = pCandidate->Eta() ;
@@ -260,6 +307,18 @@ void AliIsolationCut::GetCoeffNormBadCell(AliCaloTrackParticleCorrelation * pCan
   Double_t phiBandCells = 0.; //number of cells in band phi
   Double_t etaBandCells = 0.; //number of cells in band eta
 
+  if ( fUseCellSumTable )
+  {
+    Float_t energy[3]; Int_t nPositions[3], nGood[3];
+    if ( !GetCellSumsFromTable(pCandidate, reader, energy, nPositions, nGood) ) return;
+
+    if ( nPositions[0] > 0 ) coneBadCellsCoeff    = Float_t(nGood[0])/nPositions[0];
+    if ( nPositions[1] > 0 ) etaBandBadCellsCoeff = Float_t(nGood[1])/nPositions[1];
+    if ( nPositions[2] > 0 ) phiBandBadCellsCoeff = Float_t(nGood[2])/nPositions[2];
+
+    return;
+  }
+
   Float_t phiC  = pCandidate->Phi() ;
   if ( phiC < 0 ) phiC+=TMath::TwoPi();
   Float_t etaC  = pCandidate->Eta() ;
@@ -343,6 +402,113 @@ void AliIsolationCut::GetCoeffNormBadCell(AliCaloTrackParticleCorrelation * pCan
   }
 }
 
+//___________________________________________________________________________________
+/// Cell energy, number of (column,row) positions and number of good channels in the
+/// cone and UE bands of the candidate, from the cell energy table of the reader.
+/// The cone and bands are defined in cell units as in GetCoeffNormBadCell():
+/// cone with radius fConeSize, phi band the columns of the cone minus the cone,
+/// eta band the rows of the cone minus the columns of the cone.
+/// Works for EMCal and PHOS candidates.
+/// \param energy: energy in cone, eta band and phi band, output
+/// \param nPositions: positions in cone, eta band and phi band, output
+/// \param nGood: good channels in cone, eta band and phi band, output
+/// \return kFALSE if the candidate is not on a cell of the calorimeter
+//___________________________________________________________________________________
+Bool_t AliIsolationCut::GetCellSumsFromTable(AliCaloTrackParticleCorrelation * pCandidate,
+                                             AliCaloTrackReader * reader,
+                                             Float_t energy[3], Int_t nPositions[3], Int_t nGood[3]) const
+{
+  for(Int_t i = 0; i < 3; i++) { energy[i] = 0; nPositions[i] = 0; nGood[i] = 0; }
+
+  Int_t calo = pCandidate->GetDetectorTag();
+  if ( calo != AliCaloTrackReader::kEMCAL && calo != AliCaloTrackReader::kPHOS ) return kFALSE;
+
+  AliCaloCellSumTable * table = reader->GetCellSumTable(calo);
+  AliCalorimeterUtils * cu    = reader->GetCaloUtils();
+  if ( !table || !cu ) return kFALSE;
+
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+
+  Int_t absId = -999;
+  if ( calo == AliCaloTrackReader::kEMCAL )
+  {
+    if ( !cu->GetEMCALGeometry() || !cu->GetEMCALGeometry()->GetAbsCellIdFromEtaPhi(etaC,phiC,absId) ) absId = -999;
+  }
+  else if ( cu->GetPHOSGeometry() )
+  {
+    Double_t vtx[3] = {0,0,0};
+    reader->GetVertex(vtx);
+
+    Int_t    mod = 0, relId[4];
+    Double_t x = 0, z = 0;
+    if ( cu->GetPHOSGeometry()->ImpactOnEmc(vtx, 2*TMath::ATan(TMath::Exp(-etaC)), phiC, mod, z, x) )
+    {
+      cu->GetPHOSGeometry()->RelPosToRelId(mod, x, z, relId);
+      if ( !cu->GetPHOSGeometry()->RelToAbsNumbering(relId, absId) ) absId = -999;
+    }
+  }
+
+  Int_t colC = -1, rowC = -1;
+  if ( !table->GetCellPosition(absId, colC, rowC) )
+  {
+    AliWarning("Candidate with bad (eta,phi) in calorimeter for cell energy calculation");
+    return kFALSE;
+  }
+
+  Int_t sqrSize = int(fConeSize/AliCaloCellSumTable::GetCellSize(calo)) ; // Cone size in cells
+  Int_t colMax  = table->GetNColumns()-1;
+  Int_t rowMax  = table->GetNRows()-1;
+
+  Int_t    nPos = 0, nGoodCells = 0;
+  Double_t sum  = 0;
+
+  // Cone
+  energy[0] = table->DiskSum(colC, rowC, sqrSize, nPositions[0], nGood[0]);
+
+  // Phi band, columns of the cone minus the cone
+  sum = table->RectangleSum(colC-sqrSize+1, colC+sqrSize-1, 0, rowMax, nPos, nGoodCells);
+  energy    [2] = sum        - energy    [0];
+  nPositions[2] = nPos       - nPositions[0];
+  nGood     [2] = nGoodCells - nGood     [0];
+
+  // Eta band, rows of the cone minus the columns of the cone
+  sum = table->RectangleSum(0, colMax, rowC-sqrSize+1, rowC+sqrSize-1, nPos, nGoodCells);
+  energy    [1] = sum;
+  nPositions[1] = nPos;
+  nGood     [1] = nGoodCells;
+
+  sum = table->RectangleSum(colC-sqrSize+1, colC+sqrSize-1, rowC-sqrSize+1, rowC+sqrSize-1, nPos, nGoodCells);
+  energy    [1] -= sum;
+  nPositions[1] -= nPos;
+  nGood     [1] -= nGoodCells;
+
+  return kTRUE;
+}
+
+//___________________________________________________________________________________
+/// Energy of the cells in the cone and UE bands of the candidate, from the summed-area
+/// table of the cell energies of the event kept by the reader, see GetCellSumsFromTable().
+/// Bad channels do not contribute, the good cell fractions are given by GetCoeffNormBadCell()
+/// with SwitchOnCellSumTable().
+/// \return kFALSE if the candidate is not on a cell of the calorimeter
+//___________________________________________________________________________________
+Bool_t AliIsolationCut::GetCellEnergyInConeAndBands(AliCaloTrackParticleCorrelation * pCandidate,
+                                                    AliCaloTrackReader * reader,
+                                                    Float_t & coneEnergy,
+                                                    Float_t & etaBandEnergy, Float_t & phiBandEnergy) const
+{
+  Float_t energy[3]; Int_t nPositions[3], nGood[3];
+  Bool_t ok = GetCellSumsFromTable(pCandidate, reader, energy, nPositions, nGood);
+
+  coneEnergy    = energy[0];
+  etaBandEnergy = energy[1];
+  phiBandEnergy = energy[2];
+
+  return ok;
+}
+
 //____________________________________________
 // Put data member values in string to keep
 // in output container.
@@ -371,6 +537,10 @@ TString AliIsolationCut::GetICParametersList()
   parList+=onePar ;
   snprintf(onePar,buffersize,"fDistMinToTrigger=%1.2f \n",fDistMinToTrigger) ;
   parList+=onePar ;
+  snprintf(onePar,buffersize,"fUseConeSumGrid=%d, cell size %1.2f \n",fUseConeSumGrid,fConeSumGridCellSize) ;
+  parList+=onePar ;
+  snprintf(onePar,buffersize,"fUseCellSumTable=%d \n",fUseCellSumTable) ;
+  parList+=onePar ;
 
   return parList;
 }
@@ -453,11 +623,24 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   Int_t       ntrackrefs   = 0;
   Int_t       nclusterrefs = 0;
   
+  // --------------------------------
+  // Get the sums from the eta-phi grid, 
+  // the cone must not reach the opposite side
+  // --------------------------------
+  
+  Bool_t useGrid = ( fUseConeSumGrid && fConeSize < TMath::PiOver2() && fDistMinToTrigger < fConeSize );
+  
+  if ( useGrid )
+    GetConeSumsFromGrid(plCTS, plNe, reader, pid, bFillAOD, pCandidate, aodArrayRefName,
+                        reftracks, refclusters, coneptsumTrack, coneptsumCluster, ptLead,
+                        etaBandPtSumTrack  , phiBandPtSumTrack  ,
+                        etaBandPtSumCluster, phiBandPtSumCluster);
+  
   // --------------------------------
   // Check charged tracks in cone.
   // --------------------------------
   
-  if(plCTS &&
+  if(!useGrid && plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
     for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
@@ -602,7 +785,7 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   // Check calorimeter clusters in cone.
   // --------------------------------
   
-  if(plNe &&
+  if(!useGrid && plNe &&
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
@@ -878,6 +1061,304 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   }
 }
 
+//________________________________________________________________________________
+/// Fill the eta-phi grids with the tracks and clusters that
+/// MakeIsolationCut() would consider in the cone, if not done yet
+/// for this event and lists. Candidate independent selections, 
+/// like the rejection of track matched clusters, are applied here.
+///
+/// \param plCTS: List of tracks.
+/// \param plNe: List of clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+//________________________________________________________________________________
+void AliIsolationCut::FillConeSumGrid(TObjArray * plCTS, TObjArray * plNe,
+                                      AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  Int_t nCTS = plCTS ? plCTS->GetEntriesFast() : 0;
+  Int_t nNe  = plNe  ? plNe ->GetEntriesFast() : 0;
+  
+  if ( fGridEventNumber == reader->GetEventNumber() && fGridPartInCone == fPartInCone &&
+       fGridLists[0] == plCTS && fGridNEntries[0] == nCTS &&
+       fGridLists[1] == plNe  && fGridNEntries[1] == nNe    ) return;
+  
+  fGridEventNumber = reader->GetEventNumber();
+  fGridPartInCone  = fPartInCone;
+  fGridLists   [0] = plCTS;
+  fGridLists   [1] = plNe;
+  fGridNEntries[0] = nCTS;
+  fGridNEntries[1] = nNe;
+  fGridBuild++;
+  
+  if ( !fTrackGrid   ) fTrackGrid   = new AliIsolationConeSumGrid();
+  if ( !fClusterGrid ) fClusterGrid = new AliIsolationConeSumGrid();
+  
+  fTrackGrid  ->Reset();
+  fClusterGrid->Reset();
+  
+  Float_t pt  = -100. ;
+  Float_t eta = -100. ;
+  Float_t phi = -100. ;
+  
+  if ( fPartInCone == kOnlyCharged || fPartInCone == kNeutralAndCharged )
+  {
+    for(Int_t ipr = 0; ipr < nCTS; ipr ++ )
+    {
+      Int_t id = -1;
+      AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+      
+      if(track)
+      {
+        id = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+        
+        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+        pt  = fTrackVector.Pt();
+        eta = fTrackVector.Eta();
+        phi = fTrackVector.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliCaloTrackParticles
+        AliCaloTrackParticle * trackmix = dynamic_cast<AliCaloTrackParticle*>(plCTS->At(ipr)) ;
+        if(!trackmix)
+        {
+          AliWarning("Wrong track data type, continue");
+          continue;
+        }
+        
+        pt  = trackmix->Pt();
+        eta = trackmix->Eta();
+        phi = trackmix->Phi() ;
+      }
+      
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      fTrackGrid->AddItem(plCTS->At(ipr), id, pt, eta, phi);
+    }
+  }
+  
+  if ( fPartInCone == kOnlyNeutral || fPartInCone == kNeutralAndCharged )
+  {
+    for(Int_t ipr = 0; ipr < nNe; ipr ++ )
+    {
+      Int_t id = -1;
+      AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+      
+      if(calo)
+      {
+        // Get the index where the cluster comes, to retrieve the corresponding vertex
+        Int_t evtIndex = 0 ;
+        if (reader->GetMixedEvent())
+          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+        
+        // Skip matched clusters with tracks in case of neutral+charged analysis
+        if(fIsTMClusterInConeRejected)
+        {
+          if( fPartInCone == kNeutralAndCharged &&
+             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+        }
+        
+        id = calo->GetID();
+        
+        // Assume that come from vertex in straight line
+        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+        
+        pt  = fMomentum.Pt()  ;
+        eta = fMomentum.Eta() ;
+        phi = fMomentum.Phi() ;
+      }
+      else
+      {// Mixed event stored in AliCaloTrackParticles
+        AliCaloTrackParticle * calomix = dynamic_cast<AliCaloTrackParticle*>(plNe->At(ipr)) ;
+        if(!calomix)
+        {
+          AliWarning("Wrong calo data type, continue");
+          continue;
+        }
+        
+        pt  = calomix->Pt();
+        eta = calomix->Eta();
+        phi = calomix->Phi() ;
+      }
+      
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      fClusterGrid->AddItem(plNe->At(ipr), id, pt, eta, phi);
+    }
+  }
+  
+  fTrackGrid  ->Build(fConeSumGridCellSize);
+  fClusterGrid->Build(fConeSumGridCellSize);
+  
+  AliDebug(1,Form("Cone sum grids built with %d tracks and %d clusters",
+                  fTrackGrid->GetNItems(),fClusterGrid->GetNItems()));
+}
+
+//________________________________________________________________________________
+/// Get the cone and UE band sums of MakeIsolationCut() from the eta-phi grids,
+/// filled if needed with FillConeSumGrid(). If called again for the same
+/// candidate, cone size and grids, as when only the thresholds change, the
+/// sums of the previous call are returned. The parameters are those of
+/// MakeIsolationCut(), the sums and reference arrays are output.
+//________________________________________________________________________________
+void AliIsolationCut::GetConeSumsFromGrid(TObjArray * plCTS, TObjArray * plNe,
+                                          AliCaloTrackReader * reader, AliCaloPID * pid,
+                                          Bool_t bFillAOD, AliCaloTrackParticleCorrelation * pCandidate,
+                                          TString aodArrayRefName, TObjArray * & reftracks, TObjArray * & refclusters,
+                                          Float_t & coneptsumTrack,    Float_t & coneptsumCluster,    Float_t & ptLead,
+                                          Float_t & etaBandPtSumTrack, Float_t & phiBandPtSumTrack,
+                                          Float_t & etaBandPtSumCluster, Float_t & phiBandPtSumCluster)
+{
+  FillConeSumGrid(plCTS, plNe, reader, pid);
+  
+  if ( !bFillAOD && fGridLastBuild == fGridBuild && fGridLastCandidate == pCandidate &&
+       fGridLastConeSize == fConeSize && fGridLastDistMin == fDistMinToTrigger )
+  {
+    coneptsumTrack      = fGridLastSums[0];
+    coneptsumCluster    = fGridLastSums[1];
+    etaBandPtSumTrack   = fGridLastSums[3];
+    phiBandPtSumTrack   = fGridLastSums[4];
+    etaBandPtSumCluster = fGridLastSums[5];
+    phiBandPtSumCluster = fGridLastSums[6];
+    
+    if ( ptLead < fGridLastSums[2] ) ptLead = fGridLastSums[2];
+    
+    return;
+  }
+  
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Float_t ptMax = 0;
+  
+  std::vector<Int_t> excluded;
+  std::vector<Int_t> inCone;
+  
+  // Tracks, do not count the candidate or its daughters
+  if ( plCTS && (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged) )
+  {
+    if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS )
+    {
+      for(Int_t i = 0; i < 4; i++) fTrackGrid->FindItems(pCandidate->GetTrackLabel(i), excluded);
+      
+      std::sort(excluded.begin(), excluded.end());
+      excluded.erase(std::unique(excluded.begin(), excluded.end()), excluded.end());
+    }
+    
+    coneptsumTrack = fTrackGrid->DiskSum(etaC, phiC, fConeSize, fDistMinToTrigger,
+                                         excluded, ptMax, bFillAOD ? &inCone : 0x0);
+    
+    GetBandSumsFromGrid(fTrackGrid, etaC, phiC, excluded, etaBandPtSumTrack, phiBandPtSumTrack);
+    
+    if ( bFillAOD && inCone.size() > 0 )
+    {
+      // Keep the order of the input list
+      std::sort(inCone.begin(), inCone.end());
+      
+      reftracks = new TObjArray(0);
+      TString tempo(aodArrayRefName)  ;
+      tempo += "Tracks" ;
+      reftracks->SetName(tempo);
+      reftracks->SetOwner(kFALSE);
+      for(UInt_t i = 0; i < inCone.size(); i++) reftracks->Add(fTrackGrid->GetItem(inCone[i]));
+    }
+  }
+  
+  // Clusters, do not count the candidate (photon or pi0) or its daughters
+  if ( plNe && (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged) )
+  {
+    excluded.clear();
+    inCone  .clear();
+    
+    fClusterGrid->FindItems(pCandidate->GetCaloLabel(0), excluded);
+    if ( pCandidate->GetCaloLabel(1) != pCandidate->GetCaloLabel(0) )
+      fClusterGrid->FindItems(pCandidate->GetCaloLabel(1), excluded);
+    
+    coneptsumCluster = fClusterGrid->DiskSum(etaC, phiC, fConeSize, fDistMinToTrigger,
+                                             excluded, ptMax, bFillAOD ? &inCone : 0x0);
+    
+    GetBandSumsFromGrid(fClusterGrid, etaC, phiC, excluded, etaBandPtSumCluster, phiBandPtSumCluster);
+    
+    if ( bFillAOD && inCone.size() > 0 )
+    {
+      // Keep the order of the input list
+      std::sort(inCone.begin(), inCone.end());
+      
+      refclusters = new TObjArray(0);
+      TString tempo(aodArrayRefName)  ;
+      tempo += "Clusters" ;
+      refclusters->SetName(tempo);
+      refclusters->SetOwner(kFALSE);
+      for(UInt_t i = 0; i < inCone.size(); i++) refclusters->Add(fClusterGrid->GetItem(inCone[i]));
+    }
+  }
+  
+  if ( ptLead < ptMax ) ptLead = ptMax;
+  
+  fGridLastBuild     = fGridBuild;
+  fGridLastCandidate = pCandidate;
+  fGridLastConeSize  = fConeSize;
+  fGridLastDistMin   = fDistMinToTrigger;
+  fGridLastSums[0]   = coneptsumTrack;
+  fGridLastSums[1]   = coneptsumCluster;
+  fGridLastSums[2]   = ptMax;
+  fGridLastSums[3]   = etaBandPtSumTrack;
+  fGridLastSums[4]   = phiBandPtSumTrack;
+  fGridLastSums[5]   = etaBandPtSumCluster;
+  fGridLastSums[6]   = phiBandPtSumCluster;
+  
+  AliDebug(1,Form("Grid cone sums: track %2.2f, cluster %2.2f, leading %2.2f",
+                  coneptsumTrack,coneptsumCluster,ptMax));
+}
+
+//________________________________________________________________________________
+/// UE band sums of MakeIsolationCut() from an eta-phi grid: particles out of the
+/// cone within the cone size in eta (phi band) or in phi (eta band).
+/// The band strips are summed on the grid and the full cone is removed,
+/// also on the other side of phi = 0 for the phi band, since Radius() wraps around.
+///
+/// \param grid: grid of the tracks or the clusters
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle.
+/// \param excluded: items of the grid not counted, candidate or its daughters.
+/// \param etaBandPtSum: sum in the eta band, output.
+/// \param phiBandPtSum: sum in the phi band, output.
+//________________________________________________________________________________
+void AliIsolationCut::GetBandSumsFromGrid(const AliIsolationConeSumGrid * grid, Float_t etaC, Float_t phiC,
+                                          const std::vector<Int_t> & excluded,
+                                          Float_t & etaBandPtSum, Float_t & phiBandPtSum) const
+{
+  std::vector<Int_t> none;
+  Float_t ptMax = 0;
+  
+  Float_t cone  = grid->DiskSum(etaC, phiC, fConeSize, -1, none, ptMax);
+  
+  Float_t coneOtherSide = 0;
+  if ( phiC < fConeSize )
+    coneOtherSide += grid->DiskSum(etaC, phiC+TMath::TwoPi(), fConeSize, -1, none, ptMax);
+  if ( phiC > TMath::TwoPi()-fConeSize )
+    coneOtherSide += grid->DiskSum(etaC, phiC-TMath::TwoPi(), fConeSize, -1, none, ptMax);
+  
+  phiBandPtSum = grid->RectangleSum(etaC-fConeSize, etaC+fConeSize, -1, 2*TMath::TwoPi()) - cone - coneOtherSide;
+  etaBandPtSum = grid->RectangleSum(-100, 100, phiC-fConeSize, phiC+fConeSize)           - cone;
+  
+  // Excluded particles out of the cone are in the strips
+  for(UInt_t iex = 0; iex < excluded.size(); iex++)
+  {
+    Float_t eta = grid->GetItemEta(excluded[iex]);
+    Float_t phi = grid->GetItemPhi(excluded[iex]);
+    
+    if ( Radius(etaC, phiC, eta, phi) <= fConeSize ) continue;
+    
+    if ( eta > (etaC-fConeSize) && eta < (etaC+fConeSize) ) phiBandPtSum -= grid->GetItemPt(excluded[iex]);
+    if ( phi > (phiC-fConeSize) && phi < (phiC+fConeSize) ) etaBandPtSum -= grid->GetItemPt(excluded[iex]);
+  }
+  
+  // Rounding of the differences
+  if ( phiBandPtSum < 0 ) phiBandPtSum = 0;
+  if ( etaBandPtSum < 0 ) etaBandPtSum = 0;
+}
+
 //_____________________________________________________
 /// Print some relevant parameters set for the analysis.
 //_____________________________________________________
@@ -896,6 +1377,8 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("particle type in cone =  %d\n",    fPartInCone ) ;
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
+  printf("cone sums from eta-phi grid ? %d, cell size %1.2f\n",fUseConeSumGrid,fConeSumGridCellSize);
+  printf("cell fractions from cell energy table ? %d\n",fUseCellSumTable);
   printf("    \n") ;
 }
 
@@ -22,11 +22,14 @@
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
+#include <vector>
 
 // --- ANALYSIS system ---
 class AliCaloTrackParticleCorrelation ;
 class AliCaloTrackReader ;
 class AliCaloPID;
+class AliIsolationConeSumGrid;
+class AliCaloCellSumTable;
 
 class AliIsolationCut : public TObject {
 
@@ -34,8 +37,7 @@ class AliIsolationCut : public TObject {
 
   AliIsolationCut() ;  // default ctor
 
-  /// Virtual destructor.
-  virtual ~AliIsolationCut() { ; }
+  virtual ~AliIsolationCut() ;
 
   // Enums
 
@@ -61,6 +63,23 @@ class AliIsolationCut : public TObject {
 
   void       Print(const Option_t * opt) const ;
 
+  // Cone sums from an eta-phi grid of the particles, see AliIsolationConeSumGrid
+
+  void       FillConeSumGrid(TObjArray * plCTS, TObjArray * plNe,
+                             AliCaloTrackReader * reader, AliCaloPID * pid) ;
+
+  void       GetConeSumsFromGrid(TObjArray * plCTS, TObjArray * plNe,
+                                 AliCaloTrackReader * reader, AliCaloPID * pid,
+                                 Bool_t bFillAOD, AliCaloTrackParticleCorrelation * pCandidate,
+                                 TString aodArrayRefName, TObjArray * & reftracks, TObjArray * & refclusters,
+                                 Float_t & coneptsumTrack,    Float_t & coneptsumCluster,    Float_t & ptLead,
+                                 Float_t & etaBandPtSumTrack, Float_t & phiBandPtSumTrack,
+                                 Float_t & etaBandPtSumCluster, Float_t & phiBandPtSumCluster) ;
+
+  void       GetBandSumsFromGrid(const AliIsolationConeSumGrid * grid, Float_t etaC, Float_t phiC,
+                                 const std::vector<Int_t> & excluded,
+                                 Float_t & etaBandPtSum, Float_t & phiBandPtSum) const ;
+
   Float_t    Radius(Float_t etaCandidate, Float_t phiCandidate, Float_t eta, Float_t phi) const ;
 
   // Cone background studies medthods
@@ -82,6 +101,13 @@ class AliIsolationCut : public TObject {
                                  Float_t & coneBadCellsCoeff,
                                  Float_t & etaBandBadCellsCoeff  , Float_t & phiBandBadCellsCoeff) ;
 
+  // Cell level sums from the cell energy table of the reader, see AliCaloCellSumTable
+
+  Bool_t     GetCellEnergyInConeAndBands(AliCaloTrackParticleCorrelation * pCandidate,
+                                         AliCaloTrackReader * reader,
+                                         Float_t & coneEnergy,
+                                         Float_t & etaBandEnergy, Float_t & phiBandEnergy) const ;
+
 
   // Parameter setters and getters
 
@@ -109,9 +135,23 @@ class AliIsolationCut : public TObject {
   void       SetFracIsThresh(Bool_t f )                        { fFracIsThresh      = f    ; }
   void       SetTrackMatchedClusterRejectionInCone(Bool_t tm)  { fIsTMClusterInConeRejected = tm ; }
   void       SetMinDistToTrigger(Float_t md)                   { fDistMinToTrigger  = md   ; }
+
+  Bool_t     IsConeSumGridOn()        const { return fUseConeSumGrid ; }
+  Float_t    GetConeSumGridCellSize() const { return fConeSumGridCellSize ; }
+  void       SwitchOnConeSumGrid()                             { fUseConeSumGrid    = kTRUE  ; }
+  void       SwitchOffConeSumGrid()                            { fUseConeSumGrid    = kFALSE ; }
+  void       SetConeSumGridCellSize(Float_t size)              { fConeSumGridCellSize = size ; }
+
+  Bool_t     IsCellSumTableOn()       const { return fUseCellSumTable ; }
+  void       SwitchOnCellSumTable()                            { fUseCellSumTable   = kTRUE  ; }
+  void       SwitchOffCellSumTable()                           { fUseCellSumTable   = kFALSE ; }
     
  private:
 
+  Bool_t     GetCellSumsFromTable(AliCaloTrackParticleCorrelation * pCandidate,
+                                  AliCaloTrackReader * reader,
+                                  Float_t energy[3], Int_t nPositions[3], Int_t nGood[3]) const ;
+
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -140,6 +180,36 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  Bool_t     fUseConeSumGrid;    ///<  Get the cone and UE band sums from an eta-phi grid of the particles, built once per event and lists.
+
+  Float_t    fConeSumGridCellSize; ///< Size in eta and phi of the grid cells.
+
+  AliIsolationConeSumGrid * fTrackGrid;   //!<! Grid of the tracks in plCTS.
+
+  AliIsolationConeSumGrid * fClusterGrid; //!<! Grid of the clusters in plNe.
+
+  Int_t      fGridEventNumber;   //!<! Event number of the grids.
+
+  TObjArray* fGridLists[2];      //!<! Track and cluster lists of the grids.
+
+  Int_t      fGridNEntries[2];   //!<! Entries of the track and cluster lists of the grids.
+
+  Int_t      fGridPartInCone;    //!<! Particle type in cone of the grids.
+
+  Int_t      fGridBuild;         //!<! Counter of grid builds, to check the validity of the last sums.
+
+  Int_t      fGridLastBuild;     //!<! Grid build of the last sums.
+
+  const AliCaloTrackParticleCorrelation * fGridLastCandidate; //!<! Candidate of the last sums.
+
+  Float_t    fGridLastConeSize;  //!<! Cone size of the last sums.
+
+  Float_t    fGridLastDistMin;   //!<! Minimum distance to candidate of the last sums.
+
+  Float_t    fGridLastSums[7];   //!<! Last cone sums, leading pT and band sums.
+
+  Bool_t     fUseCellSumTable;   ///<  Get the good cell fractions in cone and UE bands from the cell energy table of the reader, also for PHOS.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -147,7 +217,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,13) ;
   /// \endcond
 
 } ;
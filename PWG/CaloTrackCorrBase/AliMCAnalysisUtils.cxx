@@ -22,6 +22,7 @@
 
 //---- ANALYSIS system ----
 #include "AliMCAnalysisUtils.h"
+#include "AliMCTruthIndex.h"
 #include "AliMCEvent.h"
 #include "AliGenPythiaEventHeader.h"
 #include "AliVParticle.h"
@@ -42,7 +43,8 @@ fJetsList(new TList),
 fMCGenerator(kPythia),
 fMCGeneratorString("PYTHIA"),
 fDaughMom(),  fDaughMom2(),
-fMotherMom(), fGMotherMom()
+fMotherMom(), fGMotherMom(),
+fMCTruthIndex(0x0)
 {}
 
 //_______________________________________
@@ -173,12 +175,16 @@ Int_t AliMCAnalysisUtils::CheckCommonAncestor(Int_t index1, Int_t index2,
 //____________________________________________________________________________________________________
 /// \return tag with primary particle at the origin of the cluster/track.
 /// Here we have only one input MC label not multiple. 
+/// If a MC truth index built for this event is set, the tag is taken from it.
 ///
 /// \param labels: list of MC labels of cluster
 /// \param mcevent: pointer to MCEvent()
 //_____________________________________________________________________________________________________
 Int_t AliMCAnalysisUtils::CheckOrigin(Int_t label, const AliMCEvent* mcevent)
 {      
+  if ( fMCTruthIndex && fMCTruthIndex->IsBuiltFor(mcevent) )
+    return fMCTruthIndex->GetOriginTag(label, this);
+  
   Int_t labels[] = { label };
   
   return CheckOrigin(labels, 1, mcevent);  
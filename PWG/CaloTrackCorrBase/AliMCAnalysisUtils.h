@@ -30,6 +30,7 @@ class TClonesArray;
 //--- AliRoot system ---
 class AliMCEvent;
 class AliGenEventHeader;
+class AliMCTruthIndex;
 
 class AliMCAnalysisUtils : public TObject {
 	
@@ -123,6 +124,11 @@ class AliMCAnalysisUtils : public TObject {
   void    PrintAncestry(AliMCEvent* mcevent, Int_t label, Int_t nGenerMax = 1000) const;
   void    PrintMCTag(Int_t tag) const;
 
+  /// Event level MC truth index, not owned, used by CheckOrigin(label,mcevent)
+  /// when built for the same MC event. Has to be rebuilt for each event.
+  void    SetMCTruthIndex(AliMCTruthIndex * index) { fMCTruthIndex = index ; }
+  AliMCTruthIndex * GetMCTruthIndex()     const { return fMCTruthIndex ; }
+
  private:
 
   Int_t          fCurrentEvent;        ///<  Current Event number - GetJets()
@@ -142,6 +148,8 @@ class AliMCAnalysisUtils : public TObject {
   TLorentzVector fMotherMom;           //!<! particle momentum
   
   TLorentzVector fGMotherMom;          //!<! particle momentum
+
+  AliMCTruthIndex * fMCTruthIndex;     //!<! event level MC truth index, not owned
   
   /// Copy constructor not implemented.
   AliMCAnalysisUtils & operator = (const AliMCAnalysisUtils & mcu) ; 
@@ -150,7 +158,7 @@ class AliMCAnalysisUtils : public TObject {
   AliMCAnalysisUtils(              const AliMCAnalysisUtils & mcu) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliMCAnalysisUtils,7) ;
+  ClassDef(AliMCAnalysisUtils,8) ;
   /// \endcond
 
 } ;
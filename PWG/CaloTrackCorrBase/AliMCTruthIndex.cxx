@@ -0,0 +1,237 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TMath.h>
+
+//---- ANALYSIS system ----
+#include "AliMCTruthIndex.h"
+#include "AliMCAnalysisUtils.h"
+#include "AliMCEvent.h"
+#include "AliVParticle.h"
+#include "AliLog.h"
+
+/// \cond CLASSIMP
+ClassImp(AliMCTruthIndex) ;
+/// \endcond
+
+//________________________________________
+/// Constructor
+//________________________________________
+AliMCTruthIndex::AliMCTruthIndex() :
+TObject(),
+fMCEvent(0x0),
+fMother(),        fPdg(),
+fStatus(),        fPrimaryClass(),
+fDaughterStart(), fDaughters(),
+fOriginTag(),     fOriginTagDone(),
+fTagGenerator(-1),
+fNTagsComputed(0), fNTagsRequested(0)
+{}
+
+//________________________________________
+/// Remove the content of the previous event.
+/// The memory of the arrays is kept for the next event.
+//________________________________________
+void AliMCTruthIndex::Reset()
+{
+  fMCEvent = 0x0;
+  fMother.clear();
+  fPdg.clear();
+  fStatus.clear();
+  fPrimaryClass.clear();
+  fDaughterStart.clear();
+  fDaughters.clear();
+  fOriginTag.clear();
+  fOriginTagDone.clear();
+  fTagGenerator   = -1;
+  fNTagsComputed  = 0;
+  fNTagsRequested = 0;
+}
+
+//________________________________________________________________
+/// Fill the arrays with one loop on the MC particles of the event.
+/// Has to be called for each new event, the MC event object is
+/// reused by the framework so it cannot be used to detect a new event.
+/// The daughters are taken from the mother labels, so that the
+/// adjacency is consistent in both directions.
+///
+/// \param mcevent: pointer to MCEvent()
+//________________________________________________________________
+void AliMCTruthIndex::Build(const AliMCEvent* mcevent)
+{
+  Reset();
+
+  if ( !mcevent )
+  {
+    AliDebug(1,"MCEvent is not available, index not built");
+    return;
+  }
+
+  Int_t nparticles = mcevent->GetNumberOfTracks();
+
+  fMother      .resize(nparticles,-1);
+  fPdg         .resize(nparticles, 0);
+  fStatus      .resize(nparticles,-1);
+  fPrimaryClass.resize(nparticles,kBadLabel);
+  fOriginTag    .assign(nparticles,0);
+  fOriginTagDone.assign(nparticles,0);
+  fDaughterStart.assign(nparticles+1,0);
+
+  for(Int_t ipart = 0; ipart < nparticles; ipart++)
+  {
+    AliVParticle * particle = mcevent->GetTrack(ipart);
+    if ( !particle ) continue;
+
+    Int_t imother = particle->GetMother();
+    if ( imother >= nparticles ) imother = -1;
+
+    fMother[ipart] = imother;
+    fPdg   [ipart] = particle->PdgCode();
+    fStatus[ipart] = particle->MCStatusCode();
+
+    if      ( particle->IsPhysicalPrimary()        ) fPrimaryClass[ipart] = kPhysicalPrimary;
+    else if ( particle->IsSecondaryFromWeakDecay() ) fPrimaryClass[ipart] = kSecondaryWeakDecay;
+    else if ( particle->IsSecondaryFromMaterial()  ) fPrimaryClass[ipart] = kSecondaryMaterial;
+    else                                             fPrimaryClass[ipart] = kSecondaryOther;
+
+    if ( imother >= 0 ) fDaughterStart[imother+1]++;
+  }
+
+  // Daughters grouped by mother, in increasing label order
+  for(Int_t ipart = 0; ipart < nparticles; ipart++)
+    fDaughterStart[ipart+1] += fDaughterStart[ipart];
+
+  fDaughters.resize(fDaughterStart[nparticles]);
+
+  std::vector<Int_t> fill(fDaughterStart.begin(), fDaughterStart.end()-1);
+  for(Int_t ipart = 0; ipart < nparticles; ipart++)
+  {
+    Int_t imother = fMother[ipart];
+    if ( imother >= 0 ) fDaughters[fill[imother]++] = ipart;
+  }
+
+  fMCEvent = mcevent;
+}
+
+//________________________________________________________________
+/// \return label of the first ancestor with the given PDG code, -1 if none.
+///
+/// \param label: MC label of the particle
+/// \param pdg: PDG code of the ancestor
+/// \param absPdg: compare the absolute value of the PDG codes
+//________________________________________________________________
+Int_t AliMCTruthIndex::GetAncestorWithPdg(Int_t label, Int_t pdg, Bool_t absPdg) const
+{
+  Int_t imother = GetMother(label);
+  Int_t ngener  = 0;
+
+  while ( imother >= 0 && ngener < 1000 )
+  {
+    Int_t mpdg = fPdg[imother];
+    if ( absPdg ) { mpdg = TMath::Abs(mpdg); pdg = TMath::Abs(pdg); }
+    if ( mpdg == pdg ) return imother;
+
+    imother = fMother[imother];
+    ngener++;
+  }
+
+  return -1;
+}
+
+//________________________________________________________________
+/// \return label of the particle itself if physical primary or of
+/// its first physical primary ancestor, -1 if none.
+///
+/// \param label: MC label of the particle
+//________________________________________________________________
+Int_t AliMCTruthIndex::GetFirstPhysicalPrimaryAncestor(Int_t label) const
+{
+  Int_t ngener = 0;
+
+  while ( IsValidLabel(label) && ngener < 1000 )
+  {
+    if ( fPrimaryClass[label] == kPhysicalPrimary ) return label;
+
+    label = fMother[label];
+    ngener++;
+  }
+
+  return -1;
+}
+
+//________________________________________________________________
+/// \return tag of AliMCAnalysisUtils::CheckOrigin() for a single label.
+/// Computed the first time the label is requested in the event and kept
+/// for the next requests. The tag depends on the MC generator setting
+/// of the utils, requests from utils with a different setting than the
+/// first one in the event are computed each time.
+///
+/// \param label: MC label of the particle
+/// \param mcutils: utils computing the tag
+//________________________________________________________________
+Int_t AliMCTruthIndex::GetOriginTag(Int_t label, AliMCAnalysisUtils* mcutils)
+{
+  if ( !mcutils ) return -1;
+
+  Int_t labels[] = { label };
+
+  if ( !fMCEvent || !IsValidLabel(label) )
+    return mcutils->CheckOrigin(labels, 1, fMCEvent);
+
+  if ( fTagGenerator < 0 ) fTagGenerator = mcutils->GetMCGenerator();
+
+  if ( fTagGenerator != mcutils->GetMCGenerator() )
+    return mcutils->CheckOrigin(labels, 1, fMCEvent);
+
+  fNTagsRequested++;
+
+  if ( !fOriginTagDone[label] )
+  {
+    fOriginTag    [label] = mcutils->CheckOrigin(labels, 1, fMCEvent);
+    fOriginTagDone[label] = 1;
+    fNTagsComputed++;
+  }
+
+  return fOriginTag[label];
+}
+
+//________________________________________________________________
+/// Compute the origin tags of all the particles of the event,
+/// for analyses requesting most of them.
+///
+/// \param mcutils: utils computing the tag
+//________________________________________________________________
+void AliMCTruthIndex::ComputeAllOriginTags(AliMCAnalysisUtils* mcutils)
+{
+  for(Int_t ipart = 0; ipart < GetNParticles(); ipart++)
+    GetOriginTag(ipart, mcutils);
+}
+
+//________________________________________________________
+/// Print the content of the index for the current event.
+//________________________________________________________
+void AliMCTruthIndex::Print(const Option_t * opt) const
+{
+  if(! opt)
+    return;
+
+  printf("***** Print: %s %s ******\n", GetName(), GetTitle() ) ;
+
+  printf("N particles    = %d\n",GetNParticles());
+  printf("N daughters    = %d\n",(Int_t)fDaughters.size());
+  printf("Origin tags    : computed %d, requested %d\n",fNTagsComputed,fNTagsRequested);
+  printf(" \n");
+}
@@ -0,0 +1,97 @@
+#ifndef ALIMCTRUTHINDEX_H
+#define ALIMCTRUTHINDEX_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliMCTruthIndex
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Event level index of the MC truth, built once per event.
+///
+/// Keeps in flat arrays indexed by the MC label the mother, the daughters,
+/// the PDG code and the primary/secondary classification of all the
+/// particles of an AliMCEvent, so that the mother chains of the reconstructed
+/// candidates can be walked without AliMCEvent::GetTrack() lookups.
+/// The origin tag of AliMCAnalysisUtils::CheckOrigin() is computed the first
+/// time a label is requested and kept for the rest of the event, so that
+/// several analyses or cut variations checking the same label pay it once.
+///
+/// Usage, once per event:
+/// ~~~{.cxx}
+/// fTruthIndex->Build(mcEvent);
+/// Int_t tag = fTruthIndex->GetOriginTag(label, fMCUtils);
+/// if ( fTruthIndex->GetPrimaryClass(label) == AliMCTruthIndex::kSecondaryWeakDecay ) ...
+/// ~~~
+/// AliMCAnalysisUtils::SetMCTruthIndex() makes CheckOrigin(label,mcevent) use it.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <vector>
+
+//--- AliRoot system ---
+class AliMCEvent;
+class AliMCAnalysisUtils;
+
+class AliMCTruthIndex : public TObject {
+
+ public:
+
+  AliMCTruthIndex() ;
+  virtual ~AliMCTruthIndex() { ; }
+
+  /// Primary/secondary classification of the MC particles
+  enum primaryClass { kPhysicalPrimary, kSecondaryWeakDecay, kSecondaryMaterial, kSecondaryOther, kBadLabel } ;
+
+  void    Build(const AliMCEvent* mcevent) ;
+  void    Reset() ;
+
+  /// \return true if built for this MC event and not yet reset
+  Bool_t  IsBuiltFor(const AliMCEvent* mcevent) const { return fMCEvent && fMCEvent == mcevent ; }
+  Int_t   GetNParticles()                       const { return fMother.size() ; }
+  Bool_t  IsValidLabel(Int_t label)             const { return label >= 0 && label < GetNParticles() ; }
+
+  Int_t   GetMother(Int_t label)                const { return IsValidLabel(label) ? fMother[label]   : -1 ; }
+  Int_t   GetPdgCode(Int_t label)               const { return IsValidLabel(label) ? fPdg[label]      : 0  ; }
+  Int_t   GetMCStatusCode(Int_t label)          const { return IsValidLabel(label) ? fStatus[label]   : -1 ; }
+  Int_t   GetNDaughters(Int_t label)            const { return IsValidLabel(label) ? fDaughterStart[label+1]-fDaughterStart[label] : 0 ; }
+  Int_t   GetDaughter(Int_t label, Int_t i)     const { return fDaughters[fDaughterStart[label]+i] ; }
+  Int_t   GetPrimaryClass(Int_t label)          const { return IsValidLabel(label) ? fPrimaryClass[label] : kBadLabel ; }
+  Bool_t  IsPhysicalPrimary(Int_t label)        const { return GetPrimaryClass(label) == kPhysicalPrimary ; }
+
+  Int_t   GetAncestorWithPdg(Int_t label, Int_t pdg, Bool_t absPdg = kTRUE) const ;
+  Int_t   GetFirstPhysicalPrimaryAncestor(Int_t label) const ;
+
+  Int_t   GetOriginTag(Int_t label, AliMCAnalysisUtils* mcutils) ;
+  void    ComputeAllOriginTags(AliMCAnalysisUtils* mcutils) ;
+
+  void    Print(const Option_t * opt) const;
+
+ private:
+
+  const AliMCEvent  *  fMCEvent;          //!<! MC event the index was built for
+  std::vector<Int_t>   fMother;           //!<! mother label per label
+  std::vector<Int_t>   fPdg;              //!<! PDG code per label
+  std::vector<Int_t>   fStatus;           //!<! MC status code per label
+  std::vector<UChar_t> fPrimaryClass;     //!<! primaryClass per label
+  std::vector<Int_t>   fDaughterStart;    //!<! first entry of the daughters of a label in fDaughters, size nparticles+1
+  std::vector<Int_t>   fDaughters;        //!<! daughter labels grouped by mother
+  std::vector<Int_t>   fOriginTag;        //!<! origin tag of AliMCAnalysisUtils per label
+  std::vector<UChar_t> fOriginTagDone;    //!<! origin tag available for the label
+  Int_t                fTagGenerator;     //!<! MC generator setting of the utils used for the origin tags, -1 if none yet
+  Int_t                fNTagsComputed;    //!<! number of origin tags computed in this event
+  Int_t                fNTagsRequested;   //!<! number of origin tag requests in this event
+
+  /// Copy constructor not implemented.
+  AliMCTruthIndex(              const AliMCTruthIndex & idx) ;
+
+  /// Assignment operator not implemented.
+  AliMCTruthIndex & operator = (const AliMCTruthIndex & idx) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliMCTruthIndex,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIMCTRUTHINDEX_H
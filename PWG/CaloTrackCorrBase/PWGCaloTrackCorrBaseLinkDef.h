@@ -9,9 +9,13 @@
 #pragma link C++ class AliFiducialCut+;
 #pragma link C++ class AliCaloPID+;
 #pragma link C++ class AliMCAnalysisUtils+;
+#pragma link C++ class AliMCTruthIndex+;
 #pragma link C++ class AliIsolationCut+;
+#pragma link C++ class AliIsolationConeSumGrid+;
+#pragma link C++ class AliCaloCellSumTable+;
 #pragma link C++ class AliCaloTrackParticle+;
 #pragma link C++ class AliCaloTrackParticleCorrelation+;
+#pragma link C++ class AliCaloTrackSharedInput+;
 #pragma link C++ class AliCaloTrackReader+;
 #pragma link C++ class AliCaloTrackESDReader+;
 #pragma link C++ class AliCaloTrackAODReader+;
@@ -149,21 +149,56 @@ Double_t AliGenEMCocktailV2::GetYWeight(Int_t np, TParticle* part) {
 
   if (!fUseYWeighting) return 1.;
 
-  Double_t weight = 0.;
-  if (fPtYDistribution[np]) {
-    if (part->Pt() > fPtYDistribution[np]->GetXaxis()->GetXmin() && part->Pt() < fPtYDistribution[np]->GetXaxis()->GetXmin()) {
-      if (part->Y() > fPtYDistribution[np]->GetYaxis()->GetXmin() && part->Y() < fPtYDistribution[np]->GetYaxis()->GetXmin()) {
-        weight = fPtYDistribution[np]->GetBinContent(fPtYDistribution[np]->GetXaxis()->FindBin(part->Pt()), fPtYDistribution[np]->GetYaxis()->FindBin(part->Y()));
-        if (weight)
-          return weight;
-        else
-          return 1.;
-      } else
-        return 1.;
-    } else
-      return 1.;
-  } else
-    return 1.;
+  const TH2F* hist = fPtYDistribution[np];
+  if (!hist) return 1.;
+
+  const TAxis* xAxis = hist->GetXaxis();
+  const Double_t pt = part->Pt();
+  if (pt <= xAxis->GetXmin() || pt >= xAxis->GetXmax()) return 1.;
+
+  const TAxis* yAxis = hist->GetYaxis();
+  const Double_t y = part->Y();
+  if (y <= yAxis->GetXmin() || y >= yAxis->GetXmax()) return 1.;
+
+  Double_t weight = hist->GetBinContent(xAxis->FindFixBin(pt), yAxis->FindFixBin(y));
+  return weight ? weight : 1.;
+}
+
+//_________________________________________________________________________
+Int_t AliGenEMCocktailV2::GetGeneratorIndex(Int_t pdgCode) {
+
+  // generator index of the mother particle, -1 if it is not a cocktail source
+  switch (pdgCode) {
+    case 111:     return kPizero;
+    case 221:     return kEta;
+    case 113:     return kRho0;
+    case 223:     return kOmega;
+    case 331:     return kEtaprime;
+    case 333:     return kPhi;
+    case 443:     return kJpsi;
+    case 220000:  return kDirectRealGamma;
+    case 220001:  return kDirectVirtGamma;
+    case 3212:    return kSigma0;
+    case 310:     return kK0s;
+    case 130:     return kK0l;
+    case 3122:    return kLambda;
+    case 2224:    return kDeltaPlPl;
+    case 2214:    return kDeltaPl;
+    case 1114:    return kDeltaMi;
+    case 2114:    return kDeltaZero;
+    case 213:     return kRhoPl;
+    case -213:    return kRhoMi;
+    case 313:     return kK0star;
+    case 321:     return kKPl;
+    case -321:    return kKMi;
+    case -3334:   return kOmegaPl;
+    case 3334:    return kOmegaMi;
+    case -3312:   return kXiPl;
+    case 3312:    return kXiMi;
+    case 3224:    return kSigmaPl;
+    case 3114:    return kSigmaMi;
+    default:      return -1;
+  }
 }
 
 //_________________________________________________________________________
@@ -936,122 +971,13 @@ void AliGenEMCocktailV2::Generate()
       }
     } else pdgMother = part->GetPdgCode();
 
-    switch (pdgMother){
-      case 111:
-        dNdy = fYieldArray[kPizero];
-        yWeight = GetYWeight(kPizero, part);
-        break;
-      case 221:
-        dNdy = fYieldArray[kEta];
-        yWeight = GetYWeight(kEta, part);
-        break;
-      case 113:
-        dNdy = fYieldArray[kRho0];
-        yWeight = GetYWeight(kRho0, part);
-        break;
-      case 223:
-        dNdy = fYieldArray[kOmega];
-        yWeight = GetYWeight(kOmega, part);
-        break;
-      case 331:
-        dNdy = fYieldArray[kEtaprime];
-        yWeight = GetYWeight(kEtaprime, part);
-        break;
-      case 333:
-        dNdy = fYieldArray[kPhi];
-        yWeight = GetYWeight(kPhi, part);
-        break;
-      case 443:
-        dNdy = fYieldArray[kJpsi];
-        yWeight = GetYWeight(kJpsi, part);
-        break;
-      case 220000:
-        dNdy = fYieldArray[kDirectRealGamma];
-        yWeight = 0.;
-        break;
-      case 220001:
-        dNdy = fYieldArray[kDirectVirtGamma];
-        yWeight = 0.;
-        break;
-      case 3212:
-        dNdy = fYieldArray[kSigma0];
-        yWeight = GetYWeight(kSigma0, part);
-        break;
-      case 310:
-        dNdy = fYieldArray[kK0s];
-        yWeight = GetYWeight(kK0s, part);
-        break;
-      case 130:
-        dNdy = fYieldArray[kK0l];
-        yWeight = GetYWeight(kK0l, part);
-        break;
-      case 3122:
-        dNdy = fYieldArray[kLambda];
-        yWeight = GetYWeight(kLambda, part);
-        break;
-      case 2224:
-        dNdy = fYieldArray[kDeltaPlPl];
-        yWeight = GetYWeight(kDeltaPlPl, part);
-        break;
-      case 2214:
-        dNdy = fYieldArray[kDeltaPl];
-        yWeight = GetYWeight(kDeltaPl, part);
-        break;
-      case 1114:
-        dNdy = fYieldArray[kDeltaMi];
-        yWeight = GetYWeight(kDeltaMi, part);
-        break;
-      case 2114:
-        dNdy = fYieldArray[kDeltaZero];
-        yWeight = GetYWeight(kDeltaZero, part);
-        break;
-      case 213:
-        dNdy = fYieldArray[kRhoPl];
-        yWeight = GetYWeight(kRhoPl, part);
-        break;
-      case -213:
-        dNdy = fYieldArray[kRhoMi];
-        yWeight = GetYWeight(kRhoMi, part);
-        break;
-      case 313:
-        dNdy = fYieldArray[kK0star];
-        yWeight = GetYWeight(kK0star, part);
-        break;
-      case 321:
-        dNdy = fYieldArray[kKPl];
-        yWeight = GetYWeight(kKPl, part);
-        break;
-      case -321:
-        dNdy = fYieldArray[kKMi];
-        yWeight = GetYWeight(kKMi, part);
-        break;
-      case -3334:
-        dNdy = fYieldArray[kOmegaPl];
-        yWeight = GetYWeight(kOmegaPl, part);
-        break;
-      case 3334:
-        dNdy = fYieldArray[kOmegaMi];
-        yWeight = GetYWeight(kOmegaMi, part);
-        break;
-      case -3312:
-        dNdy = fYieldArray[kXiPl];
-        yWeight = GetYWeight(kXiPl, part);
-        break;
-      case 3312:
-        dNdy = fYieldArray[kXiMi];
-        yWeight = GetYWeight(kXiMi, part);
-        break;
-      case 3224:
-        dNdy = fYieldArray[kSigmaPl];
-        yWeight = GetYWeight(kSigmaPl, part);
-        break;
-      case 3114:
-        dNdy = fYieldArray[kSigmaMi];
-        yWeight = GetYWeight(kSigmaMi, part);
-        break;
-      default:
-        dNdy = 0.;
-        yWeight = 0.;
+    Int_t np = GetGeneratorIndex(pdgMother);
+    if (np < 0) {
+      dNdy = 0.;
+      yWeight = 0.;
+    } else {
+      dNdy = fYieldArray[np];
+      yWeight = (np == kDirectRealGamma || np == kDirectVirtGamma) ? 0. : GetYWeight(np, part);
     }
     
     if (fUseYWeighting && yWeight)
@@ -86,7 +86,8 @@ public:
   TString   GetParametrizationFileV2Directory() const                 { return fV2ParametrizationDir;     }
   Int_t     GetNumberOfParticles()            const                   { return fNPart;                    }
   Double_t  GetMaxPtStretchFactor(Int_t pdgCode);
-  Double_t  GetYWeight(Int_t pdgCode, TParticle* part);
+  Double_t  GetYWeight(Int_t np, TParticle* part);
+  static    Int_t   GetGeneratorIndex(Int_t pdgCode);
   void      GetPtRange(Double_t &ptMin, Double_t &ptMax);
   static    TF1*    GetPtParametrization(Int_t np);
   static    TH1D*   GetMtScalingFactors();
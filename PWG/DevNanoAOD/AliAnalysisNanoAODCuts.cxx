@@ -4,10 +4,13 @@
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODTrack.h"
 #include "AliMultSelection.h"
+#include "AliNanoAODColumn.h"
+#include "AliNanoAODTrackMapping.h"
 #include <iomanip>
 
 ClassImp(AliAnalysisNanoAODTrackCuts)
 ClassImp(AliAnalysisNanoAODEventCuts)
+ClassImp(AliAnalysisNanoAODReaderCuts)
 ClassImp(AliNanoAODSimpleSetter)
 
 
@@ -82,6 +85,203 @@ Bool_t AliAnalysisNanoAODEventCuts::IsSelected(TObject* obj)
 }
 
 
+AliAnalysisNanoAODReaderCuts::AliAnalysisNanoAODReaderCuts(const char * name):
+  AliAnalysisCuts(name, name),
+  fEventVars(),
+  fEventMin(),
+  fEventMax(),
+  fTrackVars(),
+  fTrackMin(),
+  fTrackMax(),
+  fFilterMask(0),
+  fMinSelectedTracks(0),
+  fHasProductionCuts(kFALSE),
+  fProdFilterMask(0),
+  fProdMinPt(0),
+  fProdMaxEta(0),
+  fInitialized(kFALSE),
+  fEventIndex(),
+  fTrackIndex(),
+  fTrackColumn(),
+  fTrackActiveMin(),
+  fTrackActiveMax(),
+  fActiveFilterMask(0),
+  fFilterMapIndex(-1),
+  fTrackIndicesOK(kFALSE),
+  fSelectedTracks(),
+  fSurvivors()
+{
+  // default ctor
+}
+
+void AliAnalysisNanoAODReaderCuts::AddEventPredicate(const char * var, Double_t min, Double_t max)
+{
+  // Accept only events with min <= var <= max; var is a header variable
+  // (Centr, CentrTRK, CentrCL0, CentrCL1, MagField, OfflineTrigger, RunNumber or a cst variable)
+  fEventVars.push_back(var);
+  fEventMin.push_back(min);
+  fEventMax.push_back(max);
+  fInitialized = kFALSE;
+}
+
+void AliAnalysisNanoAODReaderCuts::AddTrackPredicate(const char * var, Double_t min, Double_t max)
+{
+  // Select only tracks with min <= var <= max; var is a track variable or "eta"
+  fTrackVars.push_back(var);
+  fTrackMin.push_back(min);
+  fTrackMax.push_back(max);
+  fInitialized = kFALSE;
+}
+
+void AliAnalysisNanoAODReaderCuts::SetProductionCuts(const AliAnalysisNanoAODTrackCuts * cuts)
+{
+  // Track cuts used to produce the nano AOD: the predicates they imply are not evaluated again
+  fHasProductionCuts = (cuts != 0);
+  if (!cuts) return;
+  fProdFilterMask = cuts->GetBitMask();
+  fProdMinPt = cuts->GetMinPt();
+  fProdMaxEta = cuts->GetMaxEta();
+  fInitialized = kFALSE;
+}
+
+Bool_t AliAnalysisNanoAODReaderCuts::IsSelected(TObject* obj)
+{
+  // Returns true if the event passes the event predicates and has enough tracks passing
+  // the track predicates. The selected tracks are available with GetSelectedTracks()
+  fSelectedTracks.clear();
+  AliAODEvent * evt = dynamic_cast<AliAODEvent*>(obj);
+  if (!evt) return kFALSE;
+  AliNanoAODHeader * header = dynamic_cast<AliNanoAODHeader*>((TObject*)evt->GetHeader());
+  if (!header) AliFatal("Not a nano AOD");
+
+  if (!fInitialized) Init(header);
+
+  // the tracks are not touched for events rejected by the header
+  if (!IsHeaderSelected(header)) return kFALSE;
+
+  SelectTracks(evt);
+  if (fMinSelectedTracks > 0 && (Int_t)fSelectedTracks.size() < fMinSelectedTracks) return kFALSE;
+
+  return kTRUE;
+}
+
+Int_t AliAnalysisNanoAODReaderCuts::GetHeaderIndex(AliNanoAODHeader * header, const TString & var)
+{
+  // Index of a header variable
+  if (var == "Centr"         ) return header->GetCentrIndex();
+  if (var == "CentrTRK"      ) return header->GetCentrTRKIndex();
+  if (var == "CentrCL0"      ) return header->GetCentrCL0Index();
+  if (var == "CentrCL1"      ) return header->GetCentrCL1Index();
+  if (var == "MagField"      ) return header->GetMagFieldIndex();
+  if (var == "OfflineTrigger") return header->GetOfflineTriggerIndex();
+  if (var == "RunNumber"     ) return header->GetRunNumberIndex();
+  return header->GetVarIndex(var);
+}
+
+void AliAnalysisNanoAODReaderCuts::Init(AliNanoAODHeader * header)
+{
+  // Resolve the variables once and drop the predicates implied by the production cuts
+
+  fEventIndex.clear();
+  for (size_t ivar = 0; ivar < fEventVars.size(); ivar++) {
+    Int_t index = GetHeaderIndex(header, fEventVars[ivar]);
+    if (index < 0) AliFatal(Form("Header variable %s not available", fEventVars[ivar].Data()));
+    fEventIndex.push_back(index);
+  }
+
+  fTrackColumn.clear();
+  fTrackActiveMin.clear();
+  fTrackActiveMax.clear();
+  for (size_t ivar = 0; ivar < fTrackVars.size(); ivar++) {
+    const TString & var = fTrackVars[ivar];
+    Double_t min = fTrackMin[ivar], max = fTrackMax[ivar];
+    if (fHasProductionCuts) {
+      if ((var == "pt" && min <= fProdMinPt && max >= 1e6) ||
+          (var == "eta" && min <= -fProdMaxEta && max >= fProdMaxEta)) {
+        AliInfo(Form("Track predicate %g <= %s <= %g guaranteed by the production, not evaluated", min, var.Data(), max));
+        continue;
+      }
+    }
+    if (var == "eta") {
+      // eta is not stored, the range is converted to a range on theta
+      fTrackColumn.push_back("theta");
+      fTrackActiveMin.push_back(2. * TMath::ATan(TMath::Exp(-max)));
+      fTrackActiveMax.push_back(2. * TMath::ATan(TMath::Exp(-min)));
+      continue;
+    }
+    fTrackColumn.push_back(var);
+    fTrackActiveMin.push_back(min);
+    fTrackActiveMax.push_back(max);
+  }
+
+  fActiveFilterMask = fFilterMask;
+  if (fFilterMask && fHasProductionCuts && fProdFilterMask && (fProdFilterMask & ~fFilterMask) == 0) {
+    AliInfo(Form("Filter bit mask %u guaranteed by the production, not evaluated", fFilterMask));
+    fActiveFilterMask = 0;
+  }
+
+  fTrackIndicesOK = kFALSE;
+  fInitialized = kTRUE;
+}
+
+Bool_t AliAnalysisNanoAODReaderCuts::IsHeaderSelected(AliNanoAODHeader * header) const
+{
+  for (size_t ivar = 0; ivar < fEventIndex.size(); ivar++) {
+    Double_t value = header->GetVar(fEventIndex[ivar]);
+    if (value < fEventMin[ivar] || value > fEventMax[ivar]) return kFALSE;
+  }
+  return kTRUE;
+}
+
+void AliAnalysisNanoAODReaderCuts::SelectTracks(const AliAODEvent * event)
+{
+  // Each predicate is evaluated only on the tracks which passed the previous ones. In the
+  // columnar format only the columns of the predicates are read.
+
+  AliNanoAODColumn * probe = AliNanoAODColumn::GetColumn(event, fTrackColumn.empty() ? "pt" : fTrackColumn[0].Data());
+  Bool_t columnar = (probe != 0) && (event->GetNumberOfTracks() == 0);
+  Int_t ntracks = columnar ? probe->GetEntries() : event->GetNumberOfTracks();
+
+  if (!columnar && !fTrackIndicesOK) {
+    AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+    fTrackIndex.clear();
+    for (size_t ivar = 0; ivar < fTrackColumn.size(); ivar++) {
+      Int_t index = mapping->GetVarIndex(fTrackColumn[ivar]);
+      if (index < 0) AliFatal(Form("Track variable %s not available", fTrackColumn[ivar].Data()));
+      fTrackIndex.push_back(index);
+    }
+    fFilterMapIndex = fActiveFilterMask ? mapping->GetVarIndex("FilterMap") : -1;
+    if (fActiveFilterMask && fFilterMapIndex < 0) AliFatal("Track variable FilterMap not available");
+    fTrackIndicesOK = kTRUE;
+  }
+
+  fSelectedTracks.resize(ntracks);
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) fSelectedTracks[itrack] = itrack;
+
+  if (fActiveFilterMask) ApplyPredicate(event, columnar, "FilterMap", fFilterMapIndex, 0, 0, fActiveFilterMask);
+  for (size_t ivar = 0; ivar < fTrackColumn.size() && !fSelectedTracks.empty(); ivar++) {
+    ApplyPredicate(event, columnar, fTrackColumn[ivar], columnar ? -1 : fTrackIndex[ivar], fTrackActiveMin[ivar], fTrackActiveMax[ivar], 0);
+  }
+}
+
+void AliAnalysisNanoAODReaderCuts::ApplyPredicate(const AliAODEvent * event, Bool_t columnar, const TString & var, Int_t index, Double_t min, Double_t max, UInt_t mask)
+{
+  // Keep the selected tracks with min <= var <= max (or with one of the bits of mask if not 0)
+  AliNanoAODColumn * column = 0x0;
+  if (columnar) {
+    column = AliNanoAODColumn::GetColumn(event, var.Data());
+    if (!column) AliFatal(Form("Column %s not available", var.Data()));
+  }
+  fSurvivors.clear();
+  for (size_t isel = 0; isel < fSelectedTracks.size(); isel++) {
+    Int_t itrack = fSelectedTracks[isel];
+    Double_t value = columnar ? column->GetValue(itrack) : static_cast<AliNanoAODTrack*>(event->GetTrack(itrack))->GetVar(index);
+    Bool_t pass = mask ? ((UInt_t(value) & mask) != 0) : (value >= min && value <= max);
+    if (pass) fSurvivors.push_back(itrack);
+  }
+  fSelectedTracks.swap(fSurvivors);
+}
+
 void AliNanoAODSimpleSetter::SetNanoAODHeader(const AliAODEvent * event   , AliNanoAODHeader * head , TString varListHeader  ) {
 
   AliAODHeader * header = dynamic_cast<AliAODHeader*>(event->GetHeader());
@@ -1,9 +1,13 @@
 #ifndef _ALIANALYSISNANOAODCUTSANDSETTERS_H_
 #define _ALIANALYSISNANOAODCUTSANDSETTERS_H_
 
+#include <vector>
 #include "AliAnalysisCuts.h"
 #include "AliNanoAODCustomSetter.h"
 
+class AliAODEvent;
+class AliNanoAODHeader;
+
 class AliAnalysisNanoAODTrackCuts : public AliAnalysisCuts
 {
 public:
@@ -11,11 +15,11 @@ public:
   virtual ~AliAnalysisNanoAODTrackCuts()  {}
   virtual Bool_t IsSelected(TObject* obj); // TObject should be an AliAODTrack
   virtual Bool_t IsSelected(TList*   /* list */ ) { return kTRUE; }
-  UInt_t GetBitMask() { return fBitMask; }
+  UInt_t GetBitMask() const { return fBitMask; }
   void  SetBitMask (UInt_t var) { fBitMask = var;}
-  Float_t GetMinPt() { return fMinPt; }
+  Float_t GetMinPt() const { return fMinPt; }
   void  SetMinPt (Float_t var) { fMinPt = var;}
-  Float_t GetMaxEta() { return fMaxEta; }
+  Float_t GetMaxEta() const { return fMaxEta; }
   void  SetMaxEta (Float_t var) { fMaxEta = var;}
 
 private:
@@ -49,6 +53,71 @@ public:
   ClassDef(AliAnalysisNanoAODEventCuts,2); // event cut object for nano AOD filtering
 };
 
+// Selection applied when reading nano AODs. Event predicates are ranges on header
+// variables, track predicates ranges on track variables (or "eta", converted to a
+// range on theta) and a filter bit mask. The header is checked first, then each track
+// predicate is evaluated only on the tracks which passed the previous ones, reading
+// only the needed variable (one AliNanoAODColumn in the columnar format). Predicates
+// already guaranteed by the production cuts (SetProductionCuts) are dropped.
+//
+//   AliAnalysisNanoAODReaderCuts * cuts = new AliAnalysisNanoAODReaderCuts;
+//   cuts->AddEventPredicate("Centr", 0, 10);
+//   cuts->AddTrackPredicate("pt", 0.15, 1e9);
+//   cuts->AddTrackPredicate("eta", -0.8, 0.8);
+//   cuts->SetMinSelectedTracks(1);
+//   if (!cuts->IsSelected(event)) return;
+//   const std::vector<Int_t> & tracks = cuts->GetSelectedTracks();
+class AliAnalysisNanoAODReaderCuts : public AliAnalysisCuts
+{
+public:
+  AliAnalysisNanoAODReaderCuts(const char * name = "AliAnalysisNanoAODReaderCuts");
+  virtual ~AliAnalysisNanoAODReaderCuts() {}
+  virtual Bool_t IsSelected(TObject* obj); // TObject should be an AliAODEvent with a nano AOD header
+  virtual Bool_t IsSelected(TList*   /* list */ ) { return kTRUE; }
+
+  void  AddEventPredicate(const char * var, Double_t min, Double_t max);
+  void  AddTrackPredicate(const char * var, Double_t min, Double_t max);
+  void  SetTrackFilterBits(UInt_t mask) { fFilterMask = mask; }
+  void  SetMinSelectedTracks(Int_t n) { fMinSelectedTracks = n; }
+  void  SetProductionCuts(const AliAnalysisNanoAODTrackCuts * cuts);
+
+  const std::vector<Int_t> & GetSelectedTracks() const { return fSelectedTracks; }
+
+private:
+  void   Init(AliNanoAODHeader * header);
+  Bool_t IsHeaderSelected(AliNanoAODHeader * header) const;
+  void   SelectTracks(const AliAODEvent * event);
+  void   ApplyPredicate(const AliAODEvent * event, Bool_t columnar, const TString & var, Int_t index, Double_t min, Double_t max, UInt_t mask);
+  static Int_t GetHeaderIndex(AliNanoAODHeader * header, const TString & var);
+
+  std::vector<TString>  fEventVars;         // header variables of the event predicates
+  std::vector<Double_t> fEventMin;          // lower limits of the event predicates
+  std::vector<Double_t> fEventMax;          // upper limits of the event predicates
+  std::vector<TString>  fTrackVars;         // track variables of the track predicates
+  std::vector<Double_t> fTrackMin;          // lower limits of the track predicates
+  std::vector<Double_t> fTrackMax;          // upper limits of the track predicates
+  UInt_t                fFilterMask;        // tracks must have one of these filter bits (0: no requirement)
+  Int_t                 fMinSelectedTracks; // minimum number of selected tracks to accept the event
+  Bool_t                fHasProductionCuts; // production cuts known
+  UInt_t                fProdFilterMask;    // filter bit mask of the production
+  Double_t              fProdMinPt;         // minimum pt of the production
+  Double_t              fProdMaxEta;        // maximum |eta| of the production
+
+  Bool_t                fInitialized;       //! variable indices resolved
+  std::vector<Int_t>    fEventIndex;        //! header index of the event predicates
+  std::vector<Int_t>    fTrackIndex;        //! track variable index of the active track predicates
+  std::vector<TString>  fTrackColumn;       //! track variable name of the active track predicates
+  std::vector<Double_t> fTrackActiveMin;    //! lower limits of the active track predicates
+  std::vector<Double_t> fTrackActiveMax;    //! upper limits of the active track predicates
+  UInt_t                fActiveFilterMask;  //! filter bit mask not guaranteed by the production
+  Int_t                 fFilterMapIndex;    //! track variable index of the filter map
+  Bool_t                fTrackIndicesOK;    //! track variable indices resolved
+  std::vector<Int_t>    fSelectedTracks;    //! tracks of the current event passing the track predicates
+  std::vector<Int_t>    fSurvivors;         //! work array
+
+  ClassDef(AliAnalysisNanoAODReaderCuts,1); // reader side selection of nano AOD events and tracks
+};
+
 class AliNanoAODSimpleSetter : public AliNanoAODCustomSetter
 {
 public:
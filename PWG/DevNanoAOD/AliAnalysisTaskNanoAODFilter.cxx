@@ -27,6 +27,7 @@
 #include "TH2F.h"
 #include "TCanvas.h"
 #include "TList.h"
+#include "TObjArray.h"
 
 #include "AliAnalysisTaskSE.h"
 #include "AliAnalysisManager.h"
@@ -40,6 +41,7 @@
 #include "AliESDtrack.h"
 #include "AliAODHandler.h"
 #include "AliNanoAODReplicator.h"
+#include "AliNanoAODColumn.h"
 #include "AliNanoAODTrackMapping.h"
 
 using std::cout;
@@ -63,7 +65,10 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fSaveAODZDC(kFALSE),
   fSaveVzero(kFALSE),
   fInputArrayName(""),
-  fOutputArrayName("")
+  fOutputArrayName(""),
+  fColumnarOutput(kFALSE),
+  fColumnVarList(""),
+  fColumnPacking(0x0)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -83,7 +88,10 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fSaveAODZDC(kFALSE),
    fSaveVzero(kFALSE),
    fInputArrayName(""),
-   fOutputArrayName("")
+   fOutputArrayName(""),
+   fColumnarOutput(kFALSE),
+   fColumnVarList(""),
+   fColumnPacking(0x0)
 
 {
   // Constructor
@@ -100,6 +108,20 @@ AliAnalysisTaskNanoAODFilter::~AliAnalysisTaskNanoAODFilter()
 {
   // Destructor. Clean-up the output list, but not the histograms that are put inside
   // (the list is owner and will clean-up these histograms). Protect in PROOF case.
+  delete fColumnPacking;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskNanoAODFilter::SetColumnPacking(const char * var, Int_t packing, Double_t min, Double_t max, Int_t nBits)
+{
+  // Set the packing of the column of variable var (see AliNanoAODColumn::EPacking)
+  if (!fColumnPacking) {
+    fColumnPacking = new TObjArray;
+    fColumnPacking->SetOwner(kTRUE);
+  }
+  TObject * old = fColumnPacking->FindObject(AliNanoAODColumn::GetColumnName(var));
+  if (old) delete fColumnPacking->Remove(old);
+  fColumnPacking->Add(new AliNanoAODColumn(var, packing, min, max, nBits));
 }
 
 //________________________________________________________________________
@@ -143,6 +165,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   if (fVarListHeader_fTC) rep->SetVarListHeaderStringVariable(fVarListHeader_fTC);
   if (!fInputArrayName.IsNull()) rep->SetInputArrayName(fInputArrayName);
   if (!fOutputArrayName.IsNull()) rep->SetOutputArrayName(fOutputArrayName);
+  if (fColumnarOutput) rep->SetColumnarOutput(kTRUE, fColumnVarList, fColumnPacking);
 
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
 
@@ -19,6 +19,7 @@ class AliESDtrackCuts;
 class AliAnalysisCuts;
 class AliNanoAODReplicator;
 class AliNanoAODCustomSetter;
+class TObjArray;
 
 #ifndef ALIANALYSISTASKSE_H
 #include "AliAnalysisTaskSE.h"
@@ -60,6 +61,10 @@ public:
   void SetInputArrayName(TString name) {fInputArrayName=name;}
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
 
+  // columnar output, see AliNanoAODReplicator::SetColumnarOutput and AliNanoAODColumn
+  void SetColumnarOutput(TString columnVars = "") {fColumnarOutput=kTRUE; fColumnVarList=columnVars;}
+  void SetColumnPacking(const char * var, Int_t packing, Double_t min = 0., Double_t max = 0., Int_t nBits = 10);
+
 private:
   Int_t fMCMode; // true if processing monte carlo. if > 1 not all MC particles are filtered
   AliNanoAODReplicator* fTrkrep       ; // ! replicator
@@ -78,10 +83,14 @@ private:
   TString fInputArrayName; // name of TObjectArray of Tracks
   TString fOutputArrayName; // name of TObjectArray of AliNanoAODTracks
 
+  Bool_t fColumnarOutput; // if kTRUE the tracks are written in the columnar format
+  TString fColumnVarList; // list of variables written as columns (all variables if empty)
+  TObjArray * fColumnPacking; // packing of the columns (AliNanoAODColumn prototypes)
+
   AliAnalysisTaskNanoAODFilter(const AliAnalysisTaskNanoAODFilter&); // not implemented
   AliAnalysisTaskNanoAODFilter& operator=(const AliAnalysisTaskNanoAODFilter&); // not implemented
 
-  ClassDef(AliAnalysisTaskNanoAODFilter, 4); // example of analysis
+  ClassDef(AliAnalysisTaskNanoAODFilter, 5); // example of analysis
 };
 
 #endif
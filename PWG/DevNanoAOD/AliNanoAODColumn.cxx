@@ -0,0 +1,98 @@
+#include "AliNanoAODColumn.h"
+#include "AliAODEvent.h"
+#include "AliLog.h"
+#include <cstring>
+
+ClassImp(AliNanoAODColumn)
+
+AliNanoAODColumn::AliNanoAODColumn():
+  TNamed(),
+  fVarName(""),
+  fPacking(kFloat),
+  fMin(0.),
+  fMax(0.),
+  fNBits(10),
+  fFloatValues(),
+  fShortValues(),
+  fVarIndex(-1)
+{
+  // default ctor
+}
+
+AliNanoAODColumn::AliNanoAODColumn(const char * varName, Int_t packing, Double_t min, Double_t max, Int_t nBits):
+  TNamed(GetColumnName(varName), varName),
+  fVarName(varName),
+  fPacking(packing),
+  fMin(min),
+  fMax(max),
+  fNBits(nBits),
+  fFloatValues(),
+  fShortValues(),
+  fVarIndex(-1)
+{
+  // ctor
+  if (fPacking == kShort && fMax <= fMin) {
+    AliError(Form("Invalid range [%f,%f] for short packing of %s, using float", fMin, fMax, varName));
+    fPacking = kFloat;
+  }
+  if (fNBits < 0 || fNBits > 23) fNBits = 23;
+}
+
+void AliNanoAODColumn::SetPacking(const AliNanoAODColumn & proto) {
+  // copy the packing settings of proto
+  fPacking = proto.fPacking;
+  fMin     = proto.fMin;
+  fMax     = proto.fMax;
+  fNBits   = proto.fNBits;
+  Reset();
+}
+
+void AliNanoAODColumn::Reserve(Int_t n) {
+  // reserve memory for n entries
+  if (fPacking == kShort) fShortValues.reserve(n);
+  else fFloatValues.reserve(n);
+}
+
+void AliNanoAODColumn::Fill(Double_t value) {
+  // add the value of the next track
+
+  if (fPacking == kShort) {
+    Double_t packed = (value - fMin) / (fMax - fMin) * 65534. - 32767.;
+    if (packed < -32767.) packed = -32767.;
+    if (packed >  32767.) packed =  32767.;
+    fShortValues.push_back(Short_t(packed < 0 ? packed - 0.5 : packed + 0.5));
+    return;
+  }
+
+  Float_t fvalue = value;
+  if (fPacking == kTruncatedFloat && fNBits < 23) {
+    // round the mantissa to fNBits bits and zero the others
+    UInt_t bits = 0;
+    memcpy(&bits, &fvalue, sizeof(bits));
+    const UInt_t nDrop = 23 - fNBits;
+    const UInt_t mask = (1u << nDrop) - 1;
+    if (((bits >> 23) & 0xff) != 0xff) { // leave inf and nan untouched
+      bits += (1u << (nDrop - 1));
+      bits &= ~mask;
+    }
+    memcpy(&fvalue, &bits, sizeof(bits));
+  }
+  fFloatValues.push_back(fvalue);
+}
+
+void AliNanoAODColumn::GetValues(std::vector<Float_t> & values) const {
+  // bulk read: copy all the values of the event to values
+  if (fPacking != kShort) {
+    values.assign(fFloatValues.begin(), fFloatValues.end());
+    return;
+  }
+  const Int_t n = fShortValues.size();
+  values.resize(n);
+  for (Int_t i = 0; i < n; i++) values[i] = Unpack(fShortValues[i]);
+}
+
+AliNanoAODColumn * AliNanoAODColumn::GetColumn(const AliAODEvent * event, const char * varName) {
+  // return the column of the variable varName in event, 0 if not present
+  if (!event) return 0;
+  return dynamic_cast<AliNanoAODColumn*>(event->FindListObject(GetColumnName(varName)));
+}
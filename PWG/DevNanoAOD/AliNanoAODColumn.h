@@ -0,0 +1,70 @@
+#ifndef _ALINANOAODCOLUMN_H_
+#define _ALINANOAODCOLUMN_H_
+
+// AliNanoAODColumn
+
+// Column of one track variable for the columnar nano AOD format.
+// The values of all the tracks of an event are stored in a single
+// array, so that each variable is written to its own branch and an
+// analysis reading only a few variables does not need to read the
+// others. The values can be packed with reduced precision, which
+// also improves the compression:
+//  - kFloat:          32 bit float
+//  - kTruncatedFloat: 32 bit float keeping only fNBits bits of the mantissa
+//  - kShort:          16 bit integer, linear in [fMin,fMax] (values outside are clamped)
+//
+// Read a whole column with AliNanoAODColumn::GetColumn(event,"pt")->GetValues(vec)
+
+#include "TNamed.h"
+#include <vector>
+
+class AliAODEvent;
+
+class AliNanoAODColumn : public TNamed
+{
+public:
+  enum EPacking { kFloat = 0, kTruncatedFloat, kShort };
+
+  AliNanoAODColumn();
+  AliNanoAODColumn(const char * varName, Int_t packing = kFloat, Double_t min = 0., Double_t max = 0., Int_t nBits = 10);
+  virtual ~AliNanoAODColumn() {;}
+
+  static TString GetColumnName(const char * varName) { return TString("nano_") + varName; }
+  static AliNanoAODColumn * GetColumn(const AliAODEvent * event, const char * varName);
+
+  virtual void Clear(Option_t * opt = "") { Reset(); TNamed::Clear(opt); }
+  void     Reset() { fFloatValues.clear(); fShortValues.clear(); }
+  void     Fill(Double_t value);
+  void     Reserve(Int_t n);
+
+  const char * GetVarName() const { return fVarName.Data(); }
+  Int_t    GetPacking() const { return fPacking; }
+  Double_t GetMin() const { return fMin; }
+  Double_t GetMax() const { return fMax; }
+  Int_t    GetNBits() const { return fNBits; }
+  void     SetPacking(const AliNanoAODColumn & proto);
+
+  Int_t    GetEntries() const { return fPacking == kShort ? fShortValues.size() : fFloatValues.size(); }
+  Double_t GetValue(Int_t i) const { return fPacking == kShort ? Unpack(fShortValues[i]) : fFloatValues[i]; }
+  void     GetValues(std::vector<Float_t> & values) const;
+  const Float_t * GetFloatArray() const { return fFloatValues.empty() ? 0 : &fFloatValues[0]; } // only for float packing
+
+  Int_t    GetVarIndex() const { return fVarIndex; }
+  void     SetVarIndex(Int_t index) { fVarIndex = index; }
+
+private:
+  Double_t Unpack(Short_t value) const { return fMin + (Double_t(value) + 32767.) * (fMax - fMin) / 65534.; }
+
+  TString               fVarName;     // name of the variable in AliNanoAODTrackMapping
+  Int_t                 fPacking;     // packing of the values (EPacking)
+  Double_t              fMin;         // lower limit for kShort packing
+  Double_t              fMax;         // upper limit for kShort packing
+  Int_t                 fNBits;       // mantissa bits kept for kTruncatedFloat packing
+  std::vector<Float_t>  fFloatValues; // values for kFloat and kTruncatedFloat packing
+  std::vector<Short_t>  fShortValues; // values for kShort packing
+  Int_t                 fVarIndex;    //! index of the variable in AliNanoAODTrackMapping
+
+  ClassDef(AliNanoAODColumn, 1)
+};
+
+#endif /* _ALINANOAODCOLUMN_H_ */
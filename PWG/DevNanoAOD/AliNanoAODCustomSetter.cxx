@@ -1,3 +1,9 @@
 #include "AliNanoAODCustomSetter.h"
 
 ClassImp(AliNanoAODCustomSetter)
+
+void AliNanoAODCustomSetter::SetNanoAODTracks(const std::vector<const AliAODTrack *> & aodTracks, const std::vector<AliNanoAODTrack *> & spTracks)
+{
+  // Default: the per-track setter for each track
+  for (size_t itrack = 0; itrack < aodTracks.size(); itrack++) SetNanoAODTrack(aodTracks[itrack], spTracks[itrack]);
+}
@@ -8,6 +8,7 @@
 
 // Author: Michele Floris, michele.floris@cern.ch
 
+#include <vector>
 #include "TNamed.h"
 
 class AliAODEvent;
@@ -23,6 +24,9 @@ public:
   virtual ~AliNanoAODCustomSetter() {;}
   virtual void SetNanoAODHeader(const AliAODEvent * event   , AliNanoAODHeader * head , TString varListHeader  ) =0;
   virtual void SetNanoAODTrack (const AliAODTrack * aodTrack, AliNanoAODTrack * spTrack) =0;
+  // Called once per event with all the selected tracks when the replicator runs with
+  // SetCompiledSetter(): override to fill the custom variables one variable at a time
+  virtual void SetNanoAODTracks(const std::vector<const AliAODTrack *> & aodTracks, const std::vector<AliNanoAODTrack *> & spTracks);
 
   ClassDef(AliNanoAODCustomSetter, 1)
 };
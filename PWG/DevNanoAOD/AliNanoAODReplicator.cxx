@@ -75,6 +75,10 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODColumn.h"
+#include "AliAnalysisManager.h"
+#include "AliInputEventHandler.h"
+#include "AliPIDResponseCache.h"
 
 using std::cout;
 using std::endl;
@@ -103,7 +107,18 @@ AliAODBranchReplicator(),
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
-  fVarListHeader_fTC(""){
+  fVarListHeader_fTC(""),
+  fColumnarOutput(kFALSE),
+  fColumnVarList(""),
+  fColumnPacking(0x0),
+  fColumns(0x0),
+  fCompiledSetter(kFALSE),
+  fCompiledVars(),
+  fPIDVarIndex(),
+  fPIDVarDetector(),
+  fPIDVarSpecies(),
+  fSelectedAODTracks(),
+  fSelectedNanoTracks(){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file
   }
 
@@ -134,7 +149,18 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
-  fVarListHeader_fTC("")
+  fVarListHeader_fTC(""),
+  fColumnarOutput(kFALSE),
+  fColumnVarList(""),
+  fColumnPacking(0x0),
+  fColumns(0x0),
+  fCompiledSetter(kFALSE),
+  fCompiledVars(),
+  fPIDVarIndex(),
+  fPIDVarDetector(),
+  fPIDVarSpecies(),
+  fSelectedAODTracks(),
+  fSelectedNanoTracks()
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -158,6 +184,84 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
   // dtor
   delete fTrackCut;
   delete fList;
+  if (fColumnarOutput) delete fTracks; // not part of fList in columnar mode
+  delete fColumns; // does not own the columns
+  delete fColumnPacking;
+}
+
+//_____________________________________________________________________________
+void AliNanoAODReplicator::SetColumnarOutput(Bool_t columnar, const char * columnVars, const TObjArray * packing)
+{
+  // Write the tracks in the columnar format (one branch per variable).
+  // Has to be called before the output list is created
+  if (fList) {
+    AliError("Output list already created, cannot change the output format");
+    return;
+  }
+  fColumnarOutput = columnar;
+  fColumnVarList = columnVars;
+  delete fColumnPacking;
+  fColumnPacking = 0x0;
+  if (packing) {
+    fColumnPacking = new TObjArray(packing->GetEntriesFast());
+    fColumnPacking->SetOwner(kTRUE);
+    TIter next(packing);
+    TObject * obj = 0x0;
+    while ((obj = next())) fColumnPacking->Add(obj->Clone());
+  }
+}
+
+//_____________________________________________________________________________
+void AliNanoAODReplicator::CompileTrackVariables()
+{
+  // Resolve the track variable list once per job (compiled setter mode)
+  AliNanoAODTrack::CompileVarList(fCompiledVars);
+
+  static const char * kDetectorNames[] = {"ITS", "TPC", "TOF"};
+  static const Int_t kDetectors[] = {AliPIDResponse::kITS, AliPIDResponse::kTPC, AliPIDResponse::kTOF};
+  static const char * kSpeciesNames[] = {"El", "Mu", "Pi", "Ka", "Pr", "De"};
+  static const Int_t kSpecies[] = {AliPID::kElectron, AliPID::kMuon, AliPID::kPion, AliPID::kKaon, AliPID::kProton, AliPID::kDeuteron};
+
+  fPIDVarIndex.clear();
+  fPIDVarDetector.clear();
+  fPIDVarSpecies.clear();
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  for (Int_t index = 0; index < (Int_t)fCompiledVars.size(); index++) {
+    if (fCompiledVars[index] != AliNanoAODTrack::kVarCustom) continue;
+    TString varString = mapping->GetVarName(index);
+    if (!varString.BeginsWith("cstNSigma")) continue;
+    for (Int_t idet = 0; idet < 3; idet++) {
+      for (Int_t ispec = 0; ispec < 6; ispec++) {
+        if (varString != TString::Format("cstNSigma%s%s", kDetectorNames[idet], kSpeciesNames[ispec])) continue;
+        fPIDVarIndex.push_back(index);
+        fPIDVarDetector.push_back(kDetectors[idet]);
+        fPIDVarSpecies.push_back(kSpecies[ispec]);
+      }
+    }
+  }
+  AliInfo(Form("Compiled %d track variables, %d filled from the PID response", (Int_t)fCompiledVars.size(), (Int_t)fPIDVarIndex.size()));
+}
+
+//_____________________________________________________________________________
+void AliNanoAODReplicator::FillPIDVariables(Int_t ntracks)
+{
+  // Fill the nsigma variables one detector and species at a time for all the tracks of the event
+  if (fPIDVarIndex.empty()) return;
+  AliAnalysisManager * mgr = AliAnalysisManager::GetAnalysisManager();
+  AliInputEventHandler * handler = mgr ? dynamic_cast<AliInputEventHandler*>(mgr->GetInputEventHandler()) : 0x0;
+  AliPIDResponse * pidResponse = handler ? handler->GetPIDResponse() : 0x0;
+  if (!pidResponse) {
+    AliError("PID response not available, nsigma variables not filled");
+    return;
+  }
+  for (size_t ivar = 0; ivar < fPIDVarIndex.size(); ivar++) {
+    const Int_t index = fPIDVarIndex[ivar];
+    const AliPIDResponse::EDetector det = static_cast<AliPIDResponse::EDetector>(fPIDVarDetector[ivar]);
+    const AliPID::EParticleType species = static_cast<AliPID::EParticleType>(fPIDVarSpecies[ivar]);
+    for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+      fSelectedNanoTracks[itrack]->SetVar(index, AliPIDResponseCache::NumberOfSigmas(pidResponse, det, fSelectedAODTracks[itrack], species));
+    }
+  }
 }
 
 //_____________________________________________________________________________
@@ -437,7 +541,29 @@ TList* AliNanoAODReplicator::GetList() const
 
       fTracks = new TClonesArray("AliNanoAODTrack");
       fTracks->SetName(fOutputArrayName.Data()); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);
+      if (!fColumnarOutput) fList->Add(fTracks);
+      else {
+	// the tracks are still built (for the custom setter and the MC filtering), but only the columns are written
+	fColumns = new TObjArray;
+	TObjArray * vars = (fColumnVarList.IsNull() ? fVarList : fColumnVarList).Tokenize(",");
+	TIter nextVar(vars);
+	TObjString * var = 0x0;
+	while ((var = static_cast<TObjString*>(nextVar()))) {
+	  TString varName = var->String().Strip(TString::kBoth);
+	  Int_t index = AliNanoAODTrackMapping::GetInstance()->GetVarIndex(varName);
+	  if (index < 0) {
+	    AliError(Form("Variable %s not in the track mapping, no column written", varName.Data()));
+	    continue;
+	  }
+	  AliNanoAODColumn * column = new AliNanoAODColumn(varName);
+	  AliNanoAODColumn * proto = fColumnPacking ? static_cast<AliNanoAODColumn*>(fColumnPacking->FindObject(column->GetName())) : 0x0;
+	  if (proto) column->SetPacking(*proto);
+	  column->SetVarIndex(index);
+	  fColumns->Add(column);
+	  fList->Add(column);
+	}
+	delete vars;
+      }
 
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam, fNumberOfHeaderParamInt);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -485,6 +611,11 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
 
   fTracks->Clear("C");			
+  if (fColumns) {
+    TIter nextColumn(fColumns);
+    AliNanoAODColumn * column = 0x0;
+    while ((column = static_cast<AliNanoAODColumn*>(nextColumn()))) column->Reset();
+  }
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -521,6 +652,12 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
 
   if(entries<=0) return;
 
+  if (fCompiledSetter) {
+    if (fCompiledVars.empty()) CompileTrackVariables();
+    fSelectedAODTracks.clear();
+    fSelectedNanoTracks.clear();
+  }
+
   for(Int_t j=0; j<entries; j++){
     AliVTrack *track = 0x0;
     if (particleArray) track = (AliVTrack*)particleArray->At(j);
@@ -529,10 +666,35 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     AliAODTrack *aodtrack =(AliAODTrack*)track;// FIXME DYNAMIC CAST?
     if(fTrackCut && !fTrackCut->IsSelected(aodtrack)) continue;
 
+    if (fCompiledSetter) {
+      AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fCompiledVars);
+      fSelectedAODTracks.push_back(aodtrack);
+      fSelectedNanoTracks.push_back(special);
+      continue;
+    }
+
     AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fVarList);
 
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
   }  
+
+  if (fCompiledSetter) {
+    FillPIDVariables(ntracks);
+    if(fCustomSetter) fCustomSetter->SetNanoAODTracks(fSelectedAODTracks, fSelectedNanoTracks);
+  }
+
+  if (fColumns) {
+    // fill the columns one variable at a time
+    const Int_t nColumns = fColumns->GetEntriesFast();
+    for (Int_t icol = 0; icol < nColumns; icol++) {
+      AliNanoAODColumn * column = static_cast<AliNanoAODColumn*>(fColumns->UncheckedAt(icol));
+      const Int_t index = column->GetVarIndex();
+      column->Reserve(ntracks);
+      for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+	column->Fill(static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack))->GetVar(index));
+      }
+    }
+  }
   //----------------------------------------------------------
   
   TIter nextV(source.GetVertices());
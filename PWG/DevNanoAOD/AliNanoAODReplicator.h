@@ -15,6 +15,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 /* #ifndef AliAOD3LH_H */
 /* #include "AliAOD3LH.h" */
@@ -57,6 +58,7 @@ class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
+class TObjArray;
 
 class TH1F;
 
@@ -102,9 +104,25 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
 
   void SetVarListHeaderStringVariable(TString var) {fVarListHeader_fTC=var;}
+
+  // Columnar output: one AliNanoAODColumn branch per variable instead of the array of AliNanoAODTrack
+  // columnVars: comma separated subset of the variable list (all if empty)
+  // packing: AliNanoAODColumn objects with the packing of the variables which are not stored as plain floats
+  void SetColumnarOutput(Bool_t columnar = kTRUE, const char * columnVars = "", const TObjArray * packing = 0x0);
+  Bool_t GetColumnarOutput() const { return fColumnarOutput; }
+
+  // Compiled setter: the variable list is resolved to indices once per job, the tracks are filled
+  // in one pass without string comparisons, the cstNSigma<ITS|TPC|TOF><El|Mu|Pi|Ka|Pr|De> custom
+  // variables are filled from the PID response one detector and species at a time, and the custom
+  // setter is called once per event with all the tracks (AliNanoAODCustomSetter::SetNanoAODTracks)
+  void SetCompiledSetter(Bool_t compiled = kTRUE) { fCompiledSetter = compiled; }
+  Bool_t GetCompiledSetter() const { return fCompiledSetter; }
     
  private:
 
+  void CompileTrackVariables();
+  void FillPIDVariables(Int_t ntracks);
+
   void SelectParticle(Int_t i);
   Bool_t IsParticleSelected(Int_t i);
   void CreateLabelMap(const AliAODEvent& source);
@@ -146,13 +164,26 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+
+  Bool_t fColumnarOutput; // if kTRUE the tracks are written as one AliNanoAODColumn per variable
+  TString fColumnVarList; // list of variables written as columns (all variables if empty)
+  TObjArray* fColumnPacking; // packing of the columns (AliNanoAODColumn prototypes)
+  mutable TObjArray* fColumns; //! internal array of AliNanoAODColumns
+
+  Bool_t fCompiledSetter; // if kTRUE the variable list is compiled once per job, see SetCompiledSetter
+  std::vector<Int_t> fCompiledVars; //! AliNanoAODTrack::EKinVar of each track variable
+  std::vector<Int_t> fPIDVarIndex; //! track variables filled from the PID response
+  std::vector<Int_t> fPIDVarDetector; //! AliPIDResponse::EDetector of these variables
+  std::vector<Int_t> fPIDVarSpecies; //! AliPID::EParticleType of these variables
+  std::vector<const AliAODTrack*> fSelectedAODTracks; //! selected input tracks of the event
+  std::vector<AliNanoAODTrack*> fSelectedNanoTracks; //! nano tracks of the event
  private:
 
 
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator,4) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,6) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -67,67 +67,125 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
 {
   // constructor
 
-  Double_t position[3];
-  Bool_t isPosAvailable = !(aodTrack->GetXYZ(position)); // GetXYZ() returns kTRUE, if it's DCA information
   AliNanoAODTrackMapping::GetInstance(vars);
+  std::vector<Int_t> varCodes;
+  CompileVarList(varCodes);
+  FillVars(aodTrack, varCodes);
+}
 
-  // Create internal structure
-  AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
+//______________________________________________________________________________
+AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const std::vector<Int_t> & varCodes) :
+  AliVTrack(), 
+  AliNanoAODStorage(),
+  fLabel(0),
+  fProdVertex(0),
+  fCharge(0),
+  fAODEvent(NULL)
+{
+  // constructor with the variable list resolved once per job by CompileVarList:
+  // no string comparison per track and variable
 
-  for (Int_t index = 0; index<AliNanoAODTrackMapping::GetInstance()->GetSize(); index++) {
-    TString varString = AliNanoAODTrackMapping::GetInstance()->GetVarName(index);
-
-    if     (varString == "pt"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()               , aodTrack->Pt()                      );
-    else if(varString == "phi"                    ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()              , aodTrack->Phi()                     );
-    else if(varString == "theta"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()            , aodTrack->Theta()                   );
-    else if(varString == "chi2perNDF"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()       , aodTrack->Chi2perNDF()              );  
-    else if(varString == "posx" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()             , position[0]                         );
-    else if(varString == "posy" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()             , position[1]                         );
-    else if(varString == "posz" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()             , position[2]                         );
-    else if(varString == "posDCAx"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()          , aodTrack->XAtDCA()                  );
-    else if(varString == "posDCAy"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()          , aodTrack->YAtDCA()                  );
-    else if(varString == "pDCAx"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()            , aodTrack->PxAtDCA()                 );
-    else if(varString == "pDCAy"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()            , aodTrack->PyAtDCA()                 );
-    else if(varString == "pDCAz"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()            , aodTrack->PzAtDCA()                 );
-    else if(varString == "RAtAbsorberEnd"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()   , aodTrack->GetRAtAbsorberEnd()       );
-    else if(varString == "TPCncls"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()          , aodTrack->GetTPCNcls()              );
-    else if(varString == "id"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->Getid()               , aodTrack->GetID()                   );
-    else if(varString == "TPCnclsF"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()         , aodTrack->GetTPCNclsF()             );
-    else if(varString == "TPCNCrossedRows"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()  , aodTrack->GetTPCNCrossedRows()      );
-    else if(varString == "TrackPhiOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()  , aodTrack->GetTrackPhiOnEMCal()      );
-    else if(varString == "TrackEtaOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()  , aodTrack->GetTrackEtaOnEMCal()      );
-    else if(varString == "TrackPtOnEMCal"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()   , aodTrack->GetTrackPtOnEMCal()       );
-    else if(varString == "ITSsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal()        , aodTrack->GetITSsignal()            );
-    else if(varString == "TPCsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal()        , aodTrack->GetTPCsignal()            );
-    else if(varString == "TPCsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()   , aodTrack->GetTPCsignalTunedOnData() );
-    else if(varString == "TPCsignalN"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN()       , aodTrack->GetTPCsignalN()           );
-    else if(varString == "TPCmomentum"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()      , aodTrack->GetTPCmomentum()          );
-    else if(varString == "TPCTgl"                 ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl()           , aodTrack->GetTPCTgl()               );
-    else if(varString == "TOFsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal()        , aodTrack->GetTOFsignal()            );
-    else if(varString == "integratedLength"       ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetintegratedLenght() , aodTrack->GetIntegratedLength()     );
-    else if(varString == "TOFsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()   , aodTrack->GetTOFsignalTunedOnData() );
-    else if(varString == "HMPIDsignal"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal()      , aodTrack->GetHMPIDsignal()          );
-    else if(varString == "HMPIDoccupancy"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy()   , aodTrack->GetHMPIDoccupancy()       );
-    else if(varString == "TRDsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal()        , aodTrack->GetTRDsignal()            );
-    else if(varString == "TRDChi2"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2()          , aodTrack->GetTRDchi2()              );
-    else if(varString == "TRDnSlices"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()       , aodTrack->GetNumberOfTRDslices()    );  
-    else if(varString == "IsMuonTrack"             ) {
-        if (aodTrack->IsMuonTrack()) SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 1.);
-        else SetVar(AliNanoAODTrackMapping::GetInstance()->GetIsMuonTrack(), 0.);
+  FillVars(aodTrack, varCodes);
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrack::CompileVarList(std::vector<Int_t> & varCodes)
+{
+  // Resolve the names of the variables of the current track mapping to the AOD track
+  // property they are copied from (EKinVar). Custom variables get kVarCustom.
+
+  static const char * kVarNames[] = {
+    "pt", "phi", "theta", "chi2perNDF", "posx", "posy", "posz",
+    "posDCAx", "posDCAy", "pDCAx", "pDCAy", "pDCAz", "RAtAbsorberEnd",
+    "TPCncls", "id", "TPCnclsF", "TPCNCrossedRows", "TrackPhiOnEMCal",
+    "TrackEtaOnEMCal", "TrackPtOnEMCal", "ITSsignal", "TPCsignal", "TPCsignalTuned",
+    "TPCsignalN", "TPCmomentum", "TPCTgl", "TOFsignal", "integratedLength",
+    "TOFsignalTuned", "HMPIDsignal", "HMPIDoccupancy", "TRDsignal", "TRDChi2",
+    "TRDnSlices", "IsMuonTrack", "TPCnclsS", "FilterMap", "covmat0"
+  };
+  static const Int_t kNVarNames = sizeof(kVarNames) / sizeof(kVarNames[0]);
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  Int_t size = mapping->GetSize();
+  varCodes.assign(size, kVarCustom);
+  for (Int_t index = 0; index < size; index++) {
+    TString varString = mapping->GetVarName(index);
+    for (Int_t ivar = 0; ivar < kNVarNames; ivar++) {
+      if (varString != kVarNames[ivar]) continue;
+      varCodes[index] = ivar;
+      break;
+    }
+    if (varCodes[index] == kVarCovMat) {
+      for (Int_t i = 1; i < 21 && index + i < size; i++) varCodes[index + i] = kVarSkip;
+      index += 20;
     }
-    else if(varString == "TPCnclsS"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsS()         , aodTrack->GetTPCnclsS()             );
-    else if(varString == "FilterMap"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetFilterMap()        , aodTrack->GetFilterMap()            );
-    else if(varString == "covmat0"                 ) {
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrack::FillVars(AliAODTrack * aodTrack, const std::vector<Int_t> & varCodes)
+{
+  // Copy the requested variables from the AOD track, in one pass over the compiled variable list
+
+  Double_t position[3];
+  Bool_t isPosAvailable = !(aodTrack->GetXYZ(position)); // GetXYZ() returns kTRUE, if it's DCA information
+
+  // Create internal structure
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  AllocateInternalStorage(mapping->GetSize());
+
+  Int_t size = varCodes.size();
+  for (Int_t index = 0; index < size; index++) {
+    switch (varCodes[index]) {
+      case kVarPt               : SetVar(index, aodTrack->Pt()                      ); break;
+      case kVarPhi              : SetVar(index, aodTrack->Phi()                     ); break;
+      case kVarTheta            : SetVar(index, aodTrack->Theta()                   ); break;
+      case kVarChi2PerNDF       : SetVar(index, aodTrack->Chi2perNDF()              ); break;
+      case kVarPosX             : if (isPosAvailable) SetVar(index, position[0]     ); break;
+      case kVarPosY             : if (isPosAvailable) SetVar(index, position[1]     ); break;
+      case kVarPosZ             : if (isPosAvailable) SetVar(index, position[2]     ); break;
+      case kVarPosDCAx          : SetVar(index, aodTrack->XAtDCA()                  ); break;
+      case kVarPosDCAy          : SetVar(index, aodTrack->YAtDCA()                  ); break;
+      case kVarPDCAx            : SetVar(index, aodTrack->PxAtDCA()                 ); break;
+      case kVarPDCAy            : SetVar(index, aodTrack->PyAtDCA()                 ); break;
+      case kVarPDCAz            : SetVar(index, aodTrack->PzAtDCA()                 ); break;
+      case kVarRAtAbsorberEnd   : SetVar(index, aodTrack->GetRAtAbsorberEnd()       ); break;
+      case kVarTPCncls          : SetVar(index, aodTrack->GetTPCNcls()              ); break;
+      case kVarID               : SetVar(index, aodTrack->GetID()                   ); break;
+      case kVarTPCnclsF         : SetVar(index, aodTrack->GetTPCNclsF()             ); break;
+      case kVarTPCNCrossedRows  : SetVar(index, aodTrack->GetTPCNCrossedRows()      ); break;
+      case kVarTrackPhiOnEMCal  : SetVar(index, aodTrack->GetTrackPhiOnEMCal()      ); break;
+      case kVarTrackEtaOnEMCal  : SetVar(index, aodTrack->GetTrackEtaOnEMCal()      ); break;
+      case kVarTrackPtOnEMCal   : SetVar(index, aodTrack->GetTrackPtOnEMCal()       ); break;
+      case kVarITSsignal        : SetVar(index, aodTrack->GetITSsignal()            ); break;
+      case kVarTPCsignal        : SetVar(index, aodTrack->GetTPCsignal()            ); break;
+      case kVarTPCsignalTuned   : SetVar(index, aodTrack->GetTPCsignalTunedOnData() ); break;
+      case kVarTPCsignalN       : SetVar(index, aodTrack->GetTPCsignalN()           ); break;
+      case kVarTPCmomentum      : SetVar(index, aodTrack->GetTPCmomentum()          ); break;
+      case kVarTPCTgl           : SetVar(index, aodTrack->GetTPCTgl()               ); break;
+      case kVarTOFsignal        : SetVar(index, aodTrack->GetTOFsignal()            ); break;
+      case kVarIntegratedLength : SetVar(index, aodTrack->GetIntegratedLength()     ); break;
+      case kVarTOFsignalTuned   : SetVar(index, aodTrack->GetTOFsignalTunedOnData() ); break;
+      case kVarHMPIDsignal      : SetVar(index, aodTrack->GetHMPIDsignal()          ); break;
+      case kVarHMPIDoccupancy   : SetVar(index, aodTrack->GetHMPIDoccupancy()       ); break;
+      case kVarTRDsignal        : SetVar(index, aodTrack->GetTRDsignal()            ); break;
+      case kVarTRDChi2          : SetVar(index, aodTrack->GetTRDchi2()              ); break;
+      case kVarTRDnSlices       : SetVar(index, aodTrack->GetNumberOfTRDslices()    ); break;
+      case kVarIsMuonTrack      : SetVar(index, aodTrack->IsMuonTrack() ? 1. : 0.   ); break;
+      case kVarTPCnclsS         : SetVar(index, aodTrack->GetTPCnclsS()             ); break;
+      case kVarFilterMap        : SetVar(index, aodTrack->GetFilterMap()            ); break;
+      case kVarCovMat           : {
         Double_t covMatrix[21];
         aodTrack->GetCovarianceXYZPxPyPz(covMatrix);
         for(Int_t i=0;i<21;i++){
-            SetVar(AliNanoAODTrackMapping::GetInstance()->GetCovMat(i)       , covMatrix[i]                        );
+          SetVar(mapping->GetCovMat(i), covMatrix[i]);
         }
-        index+=20;
+        break;
+      }
+      default                   : break;
     }
   }
 
-
   fLabel = aodTrack->GetLabel();
   fCharge = aodTrack->Charge();
   fProdVertex = aodTrack->GetProdVertex();
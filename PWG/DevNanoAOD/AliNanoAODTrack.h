@@ -71,9 +71,23 @@ class AliNanoAODTrack : public AliVTrack, public AliNanoAODStorage {
 public:
   
   using TObject::ClassName;
+
+  /// Code of the AOD track property copied into each variable of the mapping, see CompileVarList
+  enum EKinVar {
+    kVarCustom = -1,    // custom ("cst") variable or variable filled elsewhere
+    kVarSkip = -2,      // trailing elements of the covariance matrix, filled together with covmat0
+    kVarPt = 0, kVarPhi, kVarTheta, kVarChi2PerNDF, kVarPosX, kVarPosY, kVarPosZ,
+    kVarPosDCAx, kVarPosDCAy, kVarPDCAx, kVarPDCAy, kVarPDCAz, kVarRAtAbsorberEnd,
+    kVarTPCncls, kVarID, kVarTPCnclsF, kVarTPCNCrossedRows, kVarTrackPhiOnEMCal,
+    kVarTrackEtaOnEMCal, kVarTrackPtOnEMCal, kVarITSsignal, kVarTPCsignal, kVarTPCsignalTuned,
+    kVarTPCsignalN, kVarTPCmomentum, kVarTPCTgl, kVarTOFsignal, kVarIntegratedLength,
+    kVarTOFsignalTuned, kVarHMPIDsignal, kVarHMPIDoccupancy, kVarTRDsignal, kVarTRDChi2,
+    kVarTRDnSlices, kVarIsMuonTrack, kVarTPCnclsS, kVarFilterMap, kVarCovMat
+  };
   
   AliNanoAODTrack();
   AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars);
+  AliNanoAODTrack(AliAODTrack * aodTrack, const std::vector<Int_t> & varCodes);
   AliNanoAODTrack(AliESDTrack * esdTrack, const char * vars);
   AliNanoAODTrack(const char * vars);
 
@@ -81,6 +95,8 @@ public:
   AliNanoAODTrack(const AliNanoAODTrack& trk); 
   AliNanoAODTrack& operator=(const AliNanoAODTrack& trk);
 
+  static void CompileVarList(std::vector<Int_t> & varCodes);
+
 
   virtual void Clear(Option_t * opt) ;
   
@@ -373,7 +389,7 @@ void SetChi2perNDF(Double_t chi2perNDF) { fVars[AliNanoAODTrackMapping::GetInsta
 
 private :
 
-
+  void FillVars(AliAODTrack * aodTrack, const std::vector<Int_t> & varCodes);
 
   // Momentum & position
   // FIXME: the following was replaced by posx, posy, posz. Check if the names make sense
@@ -6,9 +6,11 @@
 #pragma link C++ class AliNanoAODReplicator+;
 #pragma link C++ class AliAnalysisTaskNanoAODFilter+;
 #pragma link C++ class AliNanoAODTrack+;
+#pragma link C++ class AliNanoAODColumn+;
 #pragma link C++ class AliNanoAODCustomSetter+;
 #pragma link C++ class AliAnalysisNanoAODTrackCuts+;
 #pragma link C++ class AliAnalysisNanoAODEventCuts+;
+#pragma link C++ class AliAnalysisNanoAODReaderCuts+;
 #pragma link C++ class AliNanoAODSimpleSetter+;
 #pragma link C++ class AliAnalysisNanoAODTrackCutsCRCZDC+;
 #pragma link C++ class AliAnalysisNanoAODEventCutsCRCZDC+;
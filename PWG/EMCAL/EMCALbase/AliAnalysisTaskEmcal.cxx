@@ -35,8 +35,10 @@
 #include "AliAnalysisManager.h"
 #include "AliCentrality.h"
 #include "AliEmcalDownscaleFactorsOCDB.h"
+#include "AliEmcalEventInfo.h"
 #include "AliEMCALGeometry.h"
 #include "AliEmcalPythiaInfo.h"
+#include "AliEmcalPythiaXsecCache.h"
 #include "AliEMCALTriggerPatchInfo.h"
 #include "AliESDEvent.h"
 #include "AliAODInputHandler.h"
@@ -47,10 +49,12 @@
 #include "AliInputEventHandler.h"
 #include "AliLog.h"
 #include "AliMCEvent.h"
+#include "AliMCHeaderCache.h"
 #include "AliMCParticle.h"
 #include "AliMultiInputEventHandler.h"
 #include "AliMultSelection.h"
 #include "AliStack.h"
+#include "AliTaskCostMonitor.h"
 #include "AliVCaloTrigger.h"
 #include "AliVCluster.h"
 #include "AliVEventHandler.h"
@@ -111,10 +115,13 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fEMCalTriggerMode(kOverlapWithLowThreshold),
   fUseNewCentralityEstimation(kFALSE),
   fGeneratePythiaInfoObject(kFALSE),
+  fUseSharedEventInfo(kFALSE),
+  fPrefetchPythiaXsecFile(kFALSE),
   fUsePtHardBinScaling(kFALSE),
   fUseXsecFromHeader(kFALSE),
   fMCRejectFilter(kFALSE),
   fCountDownscaleCorrectedEvents(kFALSE),
+  fCostMonitoring(kFALSE),
   fPtHardAndJetPtFactor(0.),
   fPtHardAndClusterPtFactor(0.),
   fPtHardAndTrackPtFactor(0.),
@@ -147,6 +154,7 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fXsection(0),
   fPythiaInfo(nullptr),
   fOutput(nullptr),
+  fCostMonitor(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
   fHistEventsAfterSel(nullptr),
@@ -224,10 +232,13 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fEMCalTriggerMode(kOverlapWithLowThreshold),
   fUseNewCentralityEstimation(kFALSE),
   fGeneratePythiaInfoObject(kFALSE),
+  fUseSharedEventInfo(kFALSE),
+  fPrefetchPythiaXsecFile(kFALSE),
   fUsePtHardBinScaling(kFALSE),
   fUseXsecFromHeader(kFALSE),
   fMCRejectFilter(kFALSE),
   fCountDownscaleCorrectedEvents(kFALSE),
+  fCostMonitoring(kFALSE),
   fPtHardAndJetPtFactor(0.),
   fPtHardAndClusterPtFactor(0.),
   fPtHardAndTrackPtFactor(0.),
@@ -260,6 +271,7 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fXsection(0),
   fPythiaInfo(0),
   fOutput(nullptr),
+  fCostMonitor(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
   fHistEventsAfterSel(nullptr),
@@ -519,6 +531,12 @@ void AliAnalysisTaskEmcal::UserCreateOutputObjects()
   fHistEventCount->GetYaxis()->SetTitle("counts");
   fOutput->Add(fHistEventCount);
 
+  if (fCostMonitoring) {
+    fCostMonitor = new AliTaskCostMonitor(Form("fCostMonitor_%s", GetName()));
+    fCostMonitor->SetOutput(fOutput);
+    fOutput->Add(fCostMonitor);
+  }
+
   PostData(1, fOutput);
 }
 
@@ -572,6 +590,8 @@ Bool_t AliAnalysisTaskEmcal::FillGeneralHistograms()
 
 void AliAnalysisTaskEmcal::UserExec(Option_t *option)
 {
+  AliTaskCostMonitor::Scope costScope(fCostMonitor, AliTaskCostMonitor::kEvent);
+
   if (!fLocalInitialized){
     ExecOnce();
     UserExecOnce();
@@ -638,6 +658,11 @@ void AliAnalysisTaskEmcal::UserExec(Option_t *option)
   }
 }
 
+void AliAnalysisTaskEmcal::FinishTaskOutput()
+{
+  if (fCostMonitor) fCostMonitor->Finish();
+}
+
 Bool_t AliAnalysisTaskEmcal::AcceptCluster(AliVCluster *clus, Int_t c) const
 {
   AliWarning("AliAnalysisTaskEmcal::AcceptCluster method is deprecated. Please use GetCusterContainer(c)->AcceptCluster(clus).");
@@ -669,14 +694,12 @@ Bool_t AliAnalysisTaskEmcal::AcceptTrack(AliVParticle *track, Int_t c) const
   return cont->AcceptParticle(track, rejectionReason);
 }
 
-Bool_t AliAnalysisTaskEmcal::PythiaInfoFromFile(const char* currFile, Float_t &fXsec, Float_t &fTrials, Int_t &pthard)
+TString AliAnalysisTaskEmcal::GetPythiaXsecDirectory(const char* currFile, TString &archivetype) const
 {
   TString file(currFile);
-  fXsec = 0;
-  fTrials = 1;
 
   // Determine archive type
-  TString archivetype;
+  archivetype = "";
   std::unique_ptr<TObjArray> walk(file.Tokenize("/"));
   for(auto t : *walk){
     TString &tok = static_cast<TObjString *>(t)->String();
@@ -697,6 +720,16 @@ Bool_t AliAnalysisTaskEmcal::PythiaInfoFromFile(const char* currFile, Float_t &f
     file.ReplaceAll(gSystem->BaseName(file.Data()),"");
   }
   AliDebugStream(1) << "File name: " << file << std::endl;
+  return file;
+}
+
+Bool_t AliAnalysisTaskEmcal::PythiaInfoFromFile(const char* currFile, Float_t &fXsec, Float_t &fTrials, Int_t &pthard)
+{
+  fXsec = 0;
+  fTrials = 1;
+
+  TString archivetype;
+  TString file = GetPythiaXsecDirectory(currFile, archivetype);
 
   // Build virtual file name
   // Support for train tests
@@ -779,46 +812,37 @@ Bool_t AliAnalysisTaskEmcal::PythiaInfoFromFile(const char* currFile, Float_t &f
   AliInfoStream() << "File: " << file << std::endl;
 
   // problem that we cannot really test the existance of a file in a archive so we have to live with open error message from root
-  std::unique_ptr<TFile> fxsec(TFile::Open(Form("%s%s",file.Data(),"pyxsec.root")));
+  // the files are read once per process and shared among the wagons via AliEmcalPythiaXsecCache
+  AliEmcalPythiaXsecCache *xsecCache = AliEmcalPythiaXsecCache::Instance();
+  const AliEmcalPythiaXsecCache::Entry *xsecInfo = &xsecCache->Get(Form("%s%s",file.Data(),"pyxsec.root"));
 
-  if (!fxsec) {
+  if (xsecInfo->fType == AliEmcalPythiaXsecCache::kNotOpened) {
     // next trial fetch the histgram file
-    fxsec = std::unique_ptr<TFile>(TFile::Open(Form("%s%s",file.Data(),"pyxsec_hists.root")));
-    if (!fxsec){
+    xsecInfo = &xsecCache->Get(Form("%s%s",file.Data(),"pyxsec_hists.root"));
+    if (xsecInfo->fType == AliEmcalPythiaXsecCache::kNotOpened){
       AliErrorStream() << "Failed reading cross section from file " << file << std::endl;
       fUseXsecFromHeader = true;
       return kFALSE; // not a severe condition but inciate that we have no information
     }
     else {
-      // find the tlist we want to be independtent of the name so use the Tkey
-      TKey* key = (TKey*)fxsec->GetListOfKeys()->At(0); 
-      if (!key) return kFALSE;
-      TList *list = dynamic_cast<TList*>(key->ReadObj());
-      if (!list) return kFALSE;
-      TProfile *xSecHist = static_cast<TProfile*>(list->FindObject("h1Xsec"));
+      if (xsecInfo->fType != AliEmcalPythiaXsecCache::kHistograms) return kFALSE;
       // check for failure
-      if(!xSecHist->GetEntries()) {
+      if(!xsecInfo->fHasXsec) {
         // No cross seciton information available - fall back to raw
-        AliErrorStream() << "No cross section information available in file " << fxsec->GetName() <<" - fall back to cross section in PYTHIA header" << std::endl;
+        AliErrorStream() << "No cross section information available in file " << file << "pyxsec_hists.root - fall back to cross section in PYTHIA header" << std::endl;
         fUseXsecFromHeader = true;
       } else {
         // Cross section histogram filled - take it from there
-        fXsec = xSecHist->GetBinContent(1);
+        fXsec = xsecInfo->fXsec;
         if(!fXsec) AliErrorStream() << GetName() << ": Cross section 0 for file " << file << std::endl;
         fUseXsecFromHeader = false;
       }
-      fTrials  = ((TH1F*)list->FindObject("h1Trials"))->GetBinContent(1);
+      fTrials  = xsecInfo->fTrials;
     }
   } else { // no tree pyxsec.root
-    TTree *xtree = (TTree*)fxsec->Get("Xsection");
-    if (!xtree) return kFALSE;
-    UInt_t   ntrials  = 0;
-    Double_t  xsection  = 0;
-    xtree->SetBranchAddress("xsection",&xsection);
-    xtree->SetBranchAddress("ntrials",&ntrials);
-    xtree->GetEntry(0);
-    fTrials = ntrials;
-    fXsec = xsection;
+    if (xsecInfo->fType != AliEmcalPythiaXsecCache::kTree) return kFALSE;
+    fTrials = xsecInfo->fTrials;
+    fXsec = xsecInfo->fXsec;
   }
   return kTRUE;
 }
@@ -880,6 +904,17 @@ Bool_t AliAnalysisTaskEmcal::FileChanged(){
   }
   fHistEvents->Fill(pthardbin, nevents);
 
+  if (fPrefetchPythiaXsecFile && chain) {
+    // request the cross section files of the next file in the chain while the current one is processed
+    TObject *next = chain->GetListOfFiles()->At(chain->GetTreeNumber() + 1);
+    if (next) {
+      TString archivetype;
+      TString nextdir = GetPythiaXsecDirectory(next->GetTitle(), archivetype);
+      AliEmcalPythiaXsecCache::Instance()->Prefetch(nextdir + "pyxsec.root");
+      AliEmcalPythiaXsecCache::Instance()->Prefetch(nextdir + "pyxsec_hists.root");
+    }
+  }
+
   return kTRUE;
 }
 
@@ -1279,25 +1314,15 @@ Bool_t AliAnalysisTaskEmcal::CheckMCOutliers()
 
   // Condition 1: Pythia jet / pT-hard > factor
   if (fPtHardAndJetPtFactor > 0.) {
-    AliTLorentzVector jet;
-
-    Int_t nTriggerJets =  fPythiaHeader->NTriggerJets();
-
-    AliDebug(1,Form("Njets: %d, pT Hard %f",nTriggerJets, fPtHard));
-
-    Float_t tmpjet[]={0,0,0,0};
-    for (Int_t ijet = 0; ijet< nTriggerJets; ijet++) {
-      fPythiaHeader->TriggerJet(ijet, tmpjet);
-
-      jet.SetPxPyPzE(tmpjet[0],tmpjet[1],tmpjet[2],tmpjet[3]);
+    // the leading trigger jet is shared by all the wagons of the event
+    Float_t jetPt = AliMCHeaderCache::GetLeadingTriggerJetPt(fPythiaHeader);
 
-      AliDebug(1,Form("jet %d; pycell jet pT %f",ijet, jet.Pt()));
+    AliDebug(1,Form("Njets: %d, pT Hard %f, leading pycell jet pT %f",fPythiaHeader->NTriggerJets(), fPtHard, jetPt));
 
-      //Compare jet pT and pt Hard
-      if (jet.Pt() > fPtHardAndJetPtFactor * fPtHard) {
-        AliInfo(Form("Reject jet event with : pT Hard %2.2f, pycell jet pT %2.2f, rejection factor %1.1f\n", fPtHard, jet.Pt(), fPtHardAndJetPtFactor));
-        return kFALSE;
-      }
+    //Compare jet pT and pt Hard
+    if (jetPt > fPtHardAndJetPtFactor * fPtHard) {
+      AliInfo(Form("Reject jet event with : pT Hard %2.2f, pycell jet pT %2.2f, rejection factor %1.1f\n", fPtHard, jetPt, fPtHardAndJetPtFactor));
+      return kFALSE;
     }
   }
   // end condition 1
@@ -1379,29 +1404,52 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
     GeneratePythiaInfoObject(MCEvent());
   }
 
-  const AliVVertex *vert = InputEvent()->GetPrimaryVertex();
-  if (vert) {
-    vert->GetXYZ(fVertex);
-    fNVertCont = vert->GetNContributors();
+  // Values already extracted by another wagon for this event are read from the shared event info
+  AliEmcalEventInfo *sharedInfo = 0;
+  if (fUseSharedEventInfo) {
+    sharedInfo = AliEmcalEventInfo::Instance();
+    if (!sharedInfo->IsCurrentEvent(InputEvent())) sharedInfo->NewEvent(InputEvent());
+  }
+
+  if (sharedInfo && sharedInfo->HasVertices()) {
+    sharedInfo->GetVertices(fVertex, fNVertCont, fVertexSPD, fNVertSPDCont);
   }
+  else {
+    const AliVVertex *vert = InputEvent()->GetPrimaryVertex();
+    if (vert) {
+      vert->GetXYZ(fVertex);
+      fNVertCont = vert->GetNContributors();
+    }
 
-  const AliVVertex *vertSPD = InputEvent()->GetPrimaryVertexSPD();
-  if (vertSPD) {
-    vertSPD->GetXYZ(fVertexSPD);
-    fNVertSPDCont = vertSPD->GetNContributors();
+    const AliVVertex *vertSPD = InputEvent()->GetPrimaryVertexSPD();
+    if (vertSPD) {
+      vertSPD->GetXYZ(fVertexSPD);
+      fNVertSPDCont = vertSPD->GetNContributors();
+    }
+    if (sharedInfo) sharedInfo->SetVertices(fVertex, fNVertCont, fVertexSPD, fNVertSPDCont);
   }
 
-  fBeamType = GetBeamType();
+  if (sharedInfo && fForceBeamType == kNA) {
+    if (!sharedInfo->HasBeamType()) sharedInfo->SetBeamType(GetBeamType());
+    fBeamType = static_cast<BeamType>(sharedInfo->GetBeamType());
+  }
+  else {
+    fBeamType = GetBeamType();
+  }
   TObject * header = InputEvent()->GetHeader();
   if (fBeamType == kAA || fBeamType == kpA ) {
+    if (!sharedInfo || !sharedInfo->GetCentrality(fCentEst, fUseNewCentralityEstimation, fCent)) {
+    Bool_t centFound = kFALSE;
     if (fUseNewCentralityEstimation) {
     if (header->InheritsFrom("AliNanoAODStorage")){
        AliNanoAODHeader *nanoHead = (AliNanoAODHeader*)header;
        fCent=nanoHead->GetCentr(fCentEst.Data());
+       centFound = kTRUE;
     }else{
       AliMultSelection *MultSelection = static_cast<AliMultSelection*>(InputEvent()->FindListObject("MultSelection"));
       if (MultSelection) {
         fCent = MultSelection->GetMultiplicityPercentile(fCentEst.Data());
+        centFound = kTRUE;
       }
       else {
         AliWarning(Form("%s: Could not retrieve centrality information! Assuming 99", GetName()));
@@ -1412,16 +1460,20 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
     if (header->InheritsFrom("AliNanoAODStorage")){
        AliNanoAODHeader *nanoHead = (AliNanoAODHeader*)header;
        fCent=nanoHead->GetCentr(fCentEst.Data());
+       centFound = kTRUE;
     }else{
       AliCentrality *aliCent = InputEvent()->GetCentrality();
       if (aliCent) {
         fCent = aliCent->GetCentralityPercentile(fCentEst.Data());
+        centFound = kTRUE;
       }
       else {
         AliWarning(Form("%s: Could not retrieve centrality information! Assuming 99", GetName()));
       }
     }
     }
+    if (sharedInfo && centFound) sharedInfo->SetCentrality(fCentEst, fUseNewCentralityEstimation, fCent);
+    }
 
     if (fNcentBins==4) {
       if      (fCent >=  0 && fCent <   10) fCentBin = 0;
@@ -1460,17 +1512,22 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
         fCentBin = fNcentBins-1;
       }
     }
-    if (header->InheritsFrom("AliNanoAODStorage")){
+    if (sharedInfo && sharedInfo->HasEventPlane()) {
+      sharedInfo->GetEventPlane(fEPV0, fEPV0A, fEPV0C);
+    }
+    else if (header->InheritsFrom("AliNanoAODStorage")){
         AliNanoAODHeader *nanoHead = (AliNanoAODHeader*)header;
         fEPV0=nanoHead->GetVar(nanoHead->GetVarIndex("cstEvPlaneV0"));
         fEPV0A=nanoHead->GetVar(nanoHead->GetVarIndex("cstEvPlaneV0A"));
         fEPV0C=nanoHead->GetVar(nanoHead->GetVarIndex("cstEvPlaneV0C"));
+        if (sharedInfo) sharedInfo->SetEventPlane(fEPV0, fEPV0A, fEPV0C);
     }else{
     AliEventplane *aliEP = InputEvent()->GetEventplane();
     if (aliEP) {
       fEPV0  = aliEP->GetEventplane("V0" ,InputEvent());
       fEPV0A = aliEP->GetEventplane("V0A",InputEvent());
       fEPV0C = aliEP->GetEventplane("V0C",InputEvent());
+      if (sharedInfo) sharedInfo->SetEventPlane(fEPV0, fEPV0A, fEPV0C);
     } else {
       AliWarning(Form("%s: Could not retrieve event plane information!", GetName()));
     }
@@ -1559,7 +1616,10 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
   }
 
 
-  fTriggers = GetTriggerList();
+  if (!sharedInfo || !sharedInfo->GetTriggerBits(fTriggerPatchInfo, fTriggers)) {
+    fTriggers = GetTriggerList();
+    if (sharedInfo) sharedInfo->SetTriggerBits(fTriggerPatchInfo, fTriggers);
+  }
 
   AliEmcalContainer* cont = 0;
 
@@ -19,6 +19,7 @@ class AliVCaloTrigger;
 class AliAnalysisUtils;
 class AliEMCALTriggerPatchInfo;
 class AliAODTrack;
+class AliTaskCostMonitor;
 class AliEmcalPythiaInfo;
 class AliAODInputHandler;
 class AliESDInputHandler;
@@ -291,6 +292,8 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   virtual void                SetNCentBins(Int_t n)                                 { fNcentBins         = n                              ; }
   void                        SetNeedEmcalGeom(Bool_t n)                            { fNeedEmcalGeom     = n                              ; }
   void                        SetCountDownscaleCorrectedEvents(Bool_t d)            { fCountDownscaleCorrectedEvents =  d                 ; }
+  void                        SetCostMonitoring(Bool_t b)                           { fCostMonitoring    = b                              ; }
+  AliTaskCostMonitor         *GetCostMonitor() const                                { return fCostMonitor                                 ; }
   void                        SetOffTrigger(UInt_t t)                               { fOffTrigger        = t                              ; }
 
   /**
@@ -328,6 +331,8 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   void                        SetEMCalTriggerMode(EMCalTriggerMode_t m)             { fEMCalTriggerMode  = m                              ; }
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetGeneratePythiaInfoObject(Bool_t b)                 { fGeneratePythiaInfoObject = b                       ; }
+  void                        SetUseSharedEventInfo(Bool_t b)                       { fUseSharedEventInfo = b                             ; }
+  void                        SetPrefetchPythiaXsecFile(Bool_t b)                   { fPrefetchPythiaXsecFile = b                         ; }
   void                        SetPythiaInfoName(const char *n)                      { fPythiaInfoName    = n                              ; }
   const TString&              GetPythiaInfoName()                             const { return fPythiaInfoName                              ; }
   const AliEmcalPythiaInfo   *GetPythiaInfo()                                 const { return fPythiaInfo                                  ; }
@@ -508,6 +513,13 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
    * @return True if parameters were obtained successfully, false otherwise
    */
   Bool_t                      PythiaInfoFromFile(const char* currFile, Float_t &fXsec, Float_t &fTrials, Int_t &pthard);
+  /**
+   * @brief Directory (or archive prefix) of the cross section files belonging to an ESD/AOD file
+   * @param[in] currFile Name of the ESD/AOD file
+   * @param[out] archivetype Archive name without ".zip", empty if the file is not in an archive
+   * @return Prefix to which pyxsec.root or pyxsec_hists.root is appended
+   */
+  TString                     GetPythiaXsecDirectory(const char* currFile, TString &archivetype) const;
   /**
    * @brief Determines if a track is inside the EMCal acceptance.
    *
@@ -603,6 +615,12 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
    */
   void                        UserExec(Option_t *option);
 
+  /**
+   * @brief Updates the histogram entries of the cost monitor
+   * at the end of the job.
+   */
+  void                        FinishTaskOutput();
+
   /**
    * @brief Notifying the user that the input data file has
    * changed and performing steps needed to be done.
@@ -865,10 +883,13 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   EMCalTriggerMode_t          fEMCalTriggerMode;           ///< EMCal trigger selection mode
   Bool_t                      fUseNewCentralityEstimation; ///< Use new centrality estimation (for 2015 data)
   Bool_t                      fGeneratePythiaInfoObject;   ///< Generate Pythia info object
+  Bool_t                      fUseSharedEventInfo;         ///< Read vertex, centrality, event plane and triggers from AliEmcalEventInfo if another wagon filled them
+  Bool_t                      fPrefetchPythiaXsecFile;     ///< Request the asynchronous opening of the cross section file of the next file in the chain
   Bool_t                      fUsePtHardBinScaling;        ///< Use \f$ p_{t}\f$-hard bin scaling in merging
   Bool_t                      fUseXsecFromHeader;          //!<! Use cross section from header instead of pyxsec.root (purely transient)
   Bool_t                      fMCRejectFilter;             ///< enable the filtering of events by tail rejection
   Bool_t                      fCountDownscaleCorrectedEvents; ///< Count event number corrected for downscaling
+  Bool_t                      fCostMonitoring;             ///< Time the event method (and user regions) with an AliTaskCostMonitor in the output
   Float_t                     fPtHardAndJetPtFactor;       ///< Factor between ptHard and jet pT to reject/accept event.
   Float_t                     fPtHardAndClusterPtFactor;   ///< Factor between ptHard and cluster pT to reject/accept event.
   Float_t                     fPtHardAndTrackPtFactor;     ///< Factor between ptHard and track pT to reject/accept event.
@@ -907,6 +928,7 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
 
   // Output
   AliEmcalList               *fOutput;                     //!<!output list
+  AliTaskCostMonitor         *fCostMonitor;                //!<!cost monitor of the wagon, if enabled
   TH1                        *fHistEventCount;             //!<!incoming and selected events
   TH1                        *fHistTrialsAfterSel;         //!<!total number of trials per pt hard bin after selection
   TH1                        *fHistEventsAfterSel;         //!<!total number of events per pt hard bin after selection
@@ -930,7 +952,7 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcal &operator=(const AliAnalysisTaskEmcal&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcal, 17) // EMCAL base analysis task
+  ClassDef(AliAnalysisTaskEmcal, 20) // EMCAL base analysis task
   /// \endcond
 };
 
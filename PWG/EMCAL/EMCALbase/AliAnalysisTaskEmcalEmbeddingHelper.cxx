@@ -26,6 +26,7 @@
 #include <TMath.h>
 #include <TRandom.h>
 #include <TChain.h>
+#include <TObjArray.h>
 #include <TGrid.h>
 #include <TGridResult.h>
 #include <TSystem.h>
@@ -48,6 +49,7 @@
 
 #include "AliYAMLConfiguration.h"
 #include "AliEmcalList.h"
+#include "AliEmcalPythiaXsecCache.h"
 
 #include "AliAnalysisTaskEmcalEmbeddingHelper.h"
 
@@ -67,6 +69,10 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fPtHardJetPtRejectionFactor(4),
   fZVertexCut(10),
   fMaxVertexDist(999),
+  fUsePrefetching(false),
+  fNFilesToPrefetch(1),
+  fPrefetchCacheSize(30000000),
+  fLastPrefetchedFile(-1),
   fInitializedConfiguration(false),
   fInitializedNewFile(false),
   fInitializedEmbedding(false),
@@ -128,6 +134,10 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fPtHardJetPtRejectionFactor(4),
   fZVertexCut(10),
   fMaxVertexDist(999),
+  fUsePrefetching(false),
+  fNFilesToPrefetch(1),
+  fPrefetchCacheSize(30000000),
+  fLastPrefetchedFile(-1),
   fInitializedConfiguration(false),
   fInitializedNewFile(false),
   fInitializedEmbedding(false),
@@ -648,6 +658,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
       // fCurrentEntry and fLowerEntry are automatically reset in InitTree()
       fFileNumber = 0;
       fUpperEntry = 0;
+      fLastPrefetchedFile = -1;
 
       // Re-init back to the start
       InitTree();
@@ -1155,6 +1166,8 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
   Bool_t res = SetupInputFiles();
   if (!res) { return; }
 
+  SetupPrefetching();
+
   // Note if getting random event access
   if (fRandomEventNumberAccess) {
     AliInfo("Random event number access enabled!");
@@ -1163,6 +1176,60 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
   fInitializedEmbedding = kTRUE;
 }
 
+/**
+ * Setup the prefetching of the embedded events, if enabled with SetUsePrefetching(). The TChain gets a
+ * tree cache including all the branches, so that the baskets of the next entries are read in one
+ * vectored request per cluster instead of one request per branch and entry, and which are decompressed
+ * by the parallel unzip thread of the tree cache. The files following the current one are opened
+ * asynchronously (see PrefetchFiles()), so that the file transitions in GetNextEntry() do not wait
+ * for the opening of remote files.
+ *
+ * The event selection (CheckIsEmbeddedEventSelected()) stays on the main thread, since the external event
+ * is filled by the branches of the TChain and cannot be shared with a background reader.
+ *
+ * NOTE: The parallel unzip setting is global in ROOT, so it also applies to the trees opened afterwards.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::SetupPrefetching()
+{
+  if (!fUsePrefetching || !fChain) return;
+
+  AliInfoStream() << "Enabling prefetching of the embedded events with a " << fPrefetchCacheSize << " bytes cache and opening " << fNFilesToPrefetch << " file(s) ahead.\n";
+
+  fChain->SetCacheSize(fPrefetchCacheSize);
+  fChain->AddBranchToCache("*", kTRUE);
+  fChain->SetParallelUnzip(kTRUE);
+
+  PrefetchFiles();
+}
+
+/**
+ * Request the asynchronous opening of the next fNFilesToPrefetch files of the TChain (and of their pythia cross
+ * section files). TFile::Open() picks up the pending request when the TChain (or PythiaInfoFromCrossSectionFile())
+ * moves to the file, instead of opening it from scratch.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::PrefetchFiles()
+{
+  if (!fUsePrefetching || !fChain) return;
+
+  TObjArray * files = fChain->GetListOfFiles();
+  if (!files) return;
+
+  // The current file is already open
+  if (fLastPrefetchedFile < static_cast<Int_t>(fFileNumber)) fLastPrefetchedFile = fFileNumber;
+
+  Int_t lastFile = TMath::Min(static_cast<Int_t>(fFileNumber) + fNFilesToPrefetch, static_cast<Int_t>(fMaxNumberOfFiles) - 1);
+  for (Int_t iFile = fLastPrefetchedFile + 1; iFile <= lastFile; iFile++) {
+    TObject * element = files->At(iFile);
+    if (!element) continue;
+    AliDebugStream(3) << "Requesting asynchronous opening of file " << iFile << ": \"" << element->GetTitle() << "\"\n";
+    TFile::AsyncOpen(element->GetTitle());
+    if (static_cast<UInt_t>(iFile) < fPythiaCrossSectionFilenames.size()) {
+      AliEmcalPythiaXsecCache::Instance()->Prefetch(fPythiaCrossSectionFilenames.at(iFile).c_str());
+    }
+    fLastPrefetchedFile = iFile;
+  }
+}
+
 /**
  * Initializes a new TTree within the TChain by determining the limits of the current TTree
  * within the TChain. By carefully keeping track of the first and lest entry of the current
@@ -1236,6 +1303,9 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   // (re)set whether we have wrapped the tree
   fWrappedAroundTree = false;
 
+  // Request the next files while this one is being embedded
+  PrefetchFiles();
+
   // Note that the tree in the new file has been initialized
   fInitializedNewFile = kTRUE;
 }
@@ -1249,47 +1319,36 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
  */
 bool AliAnalysisTaskEmcalEmbeddingHelper::PythiaInfoFromCrossSectionFile(std::string pythiaFileName)
 {
-  std::unique_ptr<TFile> fxsec(TFile::Open(pythiaFileName.c_str()));
+  // The file is read once per process and shared with the other wagons via AliEmcalPythiaXsecCache
+  const AliEmcalPythiaXsecCache::Entry & xsecInfo = AliEmcalPythiaXsecCache::Instance()->Get(pythiaFileName.c_str());
 
-  if (fxsec)
+  if (xsecInfo.fType != AliEmcalPythiaXsecCache::kNotOpened)
   {
     int trials = 0;
     double crossSection = 0;
     double nEvents = 0;
     // Check if it's a tree
-    TTree *xtree = dynamic_cast<TTree*>(fxsec->Get("Xsection"));
-    if (xtree) {
-      UInt_t ntrials  = 0;
-      Double_t xsection  = 0;
-      xtree->SetBranchAddress("xsection",&xsection);
-      xtree->SetBranchAddress("ntrials",&ntrials);
-      xtree->GetEntry(0);
-      trials = ntrials;
-      crossSection = xsection;
+    if (xsecInfo.fType == AliEmcalPythiaXsecCache::kTree) {
+      trials = xsecInfo.fTrials;
+      crossSection = xsecInfo.fXsec;
       // TODO: Test this on a file which has pyxsec.root!
       nEvents = 1.;
       AliFatal("Have no tested pyxsec.root files. Need to determine the proper way to get nevents!!");
     }
     else {
       // Check if it's instead the histograms
-      // find the tlist we want to be independtent of the name so use the Tkey
-      TKey* key = static_cast<TKey*>(fxsec->GetListOfKeys()->At(0));
-      if (!key) return false;
-      TList *list = dynamic_cast<TList*>(key->ReadObj());
-      if (!list) return false;
-      TProfile * crossSectionHist = static_cast<TProfile*>(list->FindObject("h1Xsec"));
+      if (xsecInfo.fType != AliEmcalPythiaXsecCache::kHistograms) return false;
       // check for failure
-      if(!(crossSectionHist->GetEntries())) {
+      if(!xsecInfo.fHasXsec) {
         // No cross seciton information available - fall back to raw
-        AliErrorStream() << "No cross section information available in file \"" << fxsec->GetName() << "\". Will still attempt to extract cross section information from pythia header.\n";
+        AliErrorStream() << "No cross section information available in file \"" << pythiaFileName << "\". Will still attempt to extract cross section information from pythia header.\n";
       } else {
         // Cross section histogram filled - take it from there
-        crossSection = crossSectionHist->GetBinContent(1);
+        crossSection = xsecInfo.fXsec;
         if(!crossSection) AliErrorStream() << GetName() << ": Cross section 0 for file " << pythiaFileName << std::endl;
       }
-      TH1F * trialsHist = static_cast<TH1F*>(list->FindObject("h1Trials"));
-      trials = trialsHist->GetBinContent(1);
-      nEvents = trialsHist->GetEntries();
+      trials = xsecInfo.fTrials;
+      nEvents = xsecInfo.fNEntriesTrials;
     }
 
     // If successful in retrieveing the values, normalizae the xsec and trials by the number of events
@@ -1437,6 +1496,11 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "Z vertex cut: " << fZVertexCut << "\n";
   tempSS << "Max vertex distance: " << fMaxVertexDist << "\n";
 
+  tempSS << "\nPrefetching settings:\n";
+  tempSS << "Use prefetching: " << fUsePrefetching << "\n";
+  tempSS << "Number of files to prefetch: " << fNFilesToPrefetch << "\n";
+  tempSS << "Cache size: " << fPrefetchCacheSize << "\n";
+
   if (includeFileList) {
     tempSS << "\nFiles to embed:\n";
     for (auto filename : fFilenames) {
@@ -151,6 +151,20 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetMaxVertexDistance(Double_t distance)                    { fMaxVertexDist = distance; }
   /* @} */
 
+  /**
+   * @{
+   * @name Prefetching of the embedded events
+   * @brief Move the file opening and the decompression of the embedded events off the critical path. See SetupPrefetching().
+   */
+  bool GetUsePrefetching()                                  const { return fUsePrefetching; }
+  Int_t GetNFilesToPrefetch()                               const { return fNFilesToPrefetch; }
+  Long64_t GetPrefetchCacheSize()                           const { return fPrefetchCacheSize; }
+
+  void SetUsePrefetching(bool b = true)                           { fUsePrefetching = b; }
+  void SetNFilesToPrefetch(Int_t n)                               { fNFilesToPrefetch = n; }
+  void SetPrefetchCacheSize(Long64_t size)                        { fPrefetchCacheSize = size; }
+  /* @} */
+
   /**
    * @{
    * @name Properties of Embedded Event
@@ -222,6 +236,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            SetupPrefetching()    ;
+  void            PrefetchFiles()       ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   Bool_t          IsGoodEmbeddedRun(TString path);
 
@@ -231,6 +247,11 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Double_t                                      fZVertexCut;        ///<  Z vertex cut on embedded event
   Double_t                                      fMaxVertexDist;     ///<  Max distance between Z vertex of internal and embedded event
 
+  bool                                          fUsePrefetching;    ///<  If true, open the next files ahead of time and read ahead and unzip the embedded tree in the background
+  Int_t                                         fNFilesToPrefetch;  ///<  Number of files after the current one which are opened ahead of time
+  Long64_t                                      fPrefetchCacheSize; ///<  Size of the tree cache of the embedded chain (bytes)
+  Int_t                                         fLastPrefetchedFile; //!<! Last file number of the TChain for which the opening was requested
+
   bool                                          fInitializedConfiguration; ///< Notes if the configuration has been initialized
   bool                                          fInitializedNewFile; //!<! Notes where the entry indices have been initialized for a new tree in the chain
   bool                                          fInitializedEmbedding; //!<! Notes where the TChain has been initialized for embedding
@@ -283,7 +304,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 8);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 9);
   /// \endcond
 };
 #endif
@@ -34,6 +34,7 @@
 #include "AliEMCALGeometry.h"
 #include "AliESDEvent.h"
 #include "AliEmcalParticle.h"
+#include "AliEmcalPythiaXsecCache.h"
 #include "AliEventplane.h"
 #include "AliInputEventHandler.h"
 #include "AliLog.h"
@@ -49,6 +50,7 @@
 #include "AliEMCALTriggerPatchInfo.h"
 
 #include "AliMultSelection.h"
+#include "AliTaskCostMonitor.h"
 
 #include "AliAnalysisTaskEmcalLight.h"
 
@@ -94,6 +96,7 @@ AliAnalysisTaskEmcalLight::AliAnalysisTaskEmcalLight() :
   fPtHardAndTrackPtFactor(0.),
   fSwitchOffLHC15oFaultyBranches(kFALSE),
   fEventSelectionAfterRun(kFALSE),
+  fCostMonitoring(kFALSE),
   fSelectGeneratorName(),
   fLocalInitialized(kFALSE),
   fDataType(kAOD),
@@ -118,6 +121,7 @@ AliAnalysisTaskEmcalLight::AliAnalysisTaskEmcalLight() :
   fXsection(0),
   fGeneratorName(),
   fOutput(0),
+  fCostMonitor(0),
   fHistTrialsVsPtHardNoSel(0),
   fHistEventsVsPtHardNoSel(0),
   fHistXsectionVsPtHardNoSel(0),
@@ -189,6 +193,7 @@ AliAnalysisTaskEmcalLight::AliAnalysisTaskEmcalLight(const char *name, Bool_t hi
   fPtHardAndTrackPtFactor(0.),
   fSwitchOffLHC15oFaultyBranches(kFALSE),
   fEventSelectionAfterRun(kFALSE),
+  fCostMonitoring(kFALSE),
   fSelectGeneratorName(),
   fLocalInitialized(kFALSE),
   fDataType(kAOD),
@@ -213,6 +218,7 @@ AliAnalysisTaskEmcalLight::AliAnalysisTaskEmcalLight(const char *name, Bool_t hi
   fXsection(0),
   fGeneratorName(),
   fOutput(0),
+  fCostMonitor(0),
   fHistTrialsVsPtHardNoSel(0),
   fHistEventsVsPtHardNoSel(0),
   fHistXsectionVsPtHardNoSel(0),
@@ -428,6 +434,12 @@ void AliAnalysisTaskEmcalLight::UserCreateOutputObjects()
   fHistEventCount->GetYaxis()->SetTitle("counts");
   fOutput->Add(fHistEventCount);
 
+  if (fCostMonitoring) {
+    fCostMonitor = new AliTaskCostMonitor(Form("fCostMonitor_%s", GetName()));
+    fCostMonitor->SetOutput(fOutput);
+    fOutput->Add(fCostMonitor);
+  }
+
   PostData(1, fOutput);
 }
 
@@ -501,6 +513,8 @@ Bool_t AliAnalysisTaskEmcalLight::FillGeneralHistograms(Bool_t eventSelected)
  */
 void AliAnalysisTaskEmcalLight::UserExec(Option_t *option)
 {
+  AliTaskCostMonitor::Scope costScope(fCostMonitor, AliTaskCostMonitor::kEvent);
+
   if (!fLocalInitialized) ExecOnce();
 
   if (!fLocalInitialized) return;
@@ -532,6 +546,14 @@ void AliAnalysisTaskEmcalLight::UserExec(Option_t *option)
   }
 }
 
+/**
+ * Updates the histogram entries of the cost monitor at the end of the job.
+ */
+void AliAnalysisTaskEmcalLight::FinishTaskOutput()
+{
+  if (fCostMonitor) fCostMonitor->Finish();
+}
+
 /**
  * Get the cross section and the trails either from pyxsec.root or from pysec_hists.root
  * Get the pt hard bin from the file path
@@ -577,45 +599,22 @@ Bool_t AliAnalysisTaskEmcalLight::PythiaInfoFromFile(const char* currFile, Float
   }
 
   // problem that we cannot really test the existance of a file in a archive so we have to live with open error message from root
-  TFile *fxsec = TFile::Open(Form("%s%s",file.Data(),"pyxsec.root"));
+  // the files are read once per process and shared among the wagons via AliEmcalPythiaXsecCache
+  AliEmcalPythiaXsecCache *xsecCache = AliEmcalPythiaXsecCache::Instance();
+  const AliEmcalPythiaXsecCache::Entry *xsecInfo = &xsecCache->Get(Form("%s%s",file.Data(),"pyxsec.root"));
 
-  if (!fxsec) {
+  if (xsecInfo->fType == AliEmcalPythiaXsecCache::kNotOpened) {
     // next trial fetch the histgram file
-    fxsec = TFile::Open(Form("%s%s",file.Data(),"pyxsec_hists.root"));
-    if (!fxsec) {
+    xsecInfo = &xsecCache->Get(Form("%s%s",file.Data(),"pyxsec_hists.root"));
+    if (xsecInfo->fType != AliEmcalPythiaXsecCache::kHistograms) {
       // not a severe condition but inciate that we have no information
       return kFALSE;
-    } else {
-      // find the tlist we want to be independtent of the name so use the Tkey
-      TKey* key = static_cast<TKey*>(fxsec->GetListOfKeys()->At(0));
-      if (!key) {
-        fxsec->Close();
-        return kFALSE;
-      }
-      TList *list = dynamic_cast<TList*>(key->ReadObj());
-      if (!list) {
-        fxsec->Close();
-        return kFALSE;
-      }
-      fXsec = static_cast<TProfile*>(list->FindObject("h1Xsec"))->GetBinContent(1);
-      fTrials = static_cast<TH1F*>(list->FindObject("h1Trials"))->GetBinContent(1);
-      fxsec->Close();
     }
   } else { // no tree pyxsec.root
-    TTree *xtree = static_cast<TTree*>(fxsec->Get("Xsection"));
-    if (!xtree) {
-      fxsec->Close();
-      return kFALSE;
-    }
-    UInt_t   ntrials  = 0;
-    Double_t  xsection  = 0;
-    xtree->SetBranchAddress("xsection",&xsection);
-    xtree->SetBranchAddress("ntrials",&ntrials);
-    xtree->GetEntry(0);
-    fTrials = ntrials;
-    fXsec = xsection;
-    fxsec->Close();
+    if (xsecInfo->fType != AliEmcalPythiaXsecCache::kTree) return kFALSE;
   }
+  fXsec = xsecInfo->fXsec;
+  fTrials = xsecInfo->fTrials;
   return kTRUE;
 }
 
@@ -20,6 +20,7 @@ class AliVCaloTrigger;
 class AliAnalysisUtils;
 class AliEMCALTriggerPatchInfo;
 class AliAODTrack;
+class AliTaskCostMonitor;
 
 #include <map>
 #include <set>
@@ -153,6 +154,8 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
   void                        SetTrackPtFactor(Float_t f)                           { fPtHardAndTrackPtFactor = f                         ; }
   Float_t                     TrackPtFactor()                                       { return fPtHardAndTrackPtFactor                      ; }
   void                        SetEventSelectionAfterRun(Bool_t b)                   { fEventSelectionAfterRun = b                         ; }
+  void                        SetCostMonitoring(Bool_t b)                           { fCostMonitoring    = b                              ; }
+  AliTaskCostMonitor         *GetCostMonitor() const                                { return fCostMonitor                                 ; }
   void                        SelectGeneratorName(TString gen)                      { fSelectGeneratorName = gen                          ; }
 
  protected:
@@ -168,6 +171,7 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
   void                        UserCreateOutputObjects();
   void                        UserExec(Option_t *option);
   Bool_t                      UserNotify();
+  void                        FinishTaskOutput();
 
   // Virtual functions, to be overloaded in derived classes
   virtual void                ExecOnce();
@@ -241,6 +245,7 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
   Float_t                     fPtHardAndTrackPtFactor;     ///< Factor between ptHard and track pT to reject/accept event.
   Bool_t                      fSwitchOffLHC15oFaultyBranches; ///< Switch off faulty tree branches in LHC15o AOD trees
   Bool_t                      fEventSelectionAfterRun;     ///< If kTRUE, the event selection is performed after Run() but before FillHistograms()
+  Bool_t                      fCostMonitoring;             ///< Time the event method (and user regions) with an AliTaskCostMonitor in the output
   TString                     fSelectGeneratorName;        ///< Selects only events produced by a generator that has a name containing a string
 
   // Service fields
@@ -271,6 +276,7 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
 
   // Output
   TList                      *fOutput;                     //!<!output list
+  AliTaskCostMonitor         *fCostMonitor;                //!<!cost monitor of the wagon, if enabled
   TH1                        *fHistTrialsVsPtHardNoSel;    //!<!total number of trials per pt hard bin after selection (no event selection)
   TH1                        *fHistEventsVsPtHardNoSel;    //!<!total number of events per pt hard bin after selection (no event selection)
   TProfile                   *fHistXsectionVsPtHardNoSel;  //!<!x section from pythia header (no event selection)
@@ -296,7 +302,7 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalLight &operator=(const AliAnalysisTaskEmcalLight&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalLight, 4);
+  ClassDef(AliAnalysisTaskEmcalLight, 5);
   /// \endcond
 };
 
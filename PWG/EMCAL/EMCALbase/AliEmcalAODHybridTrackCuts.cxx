@@ -54,24 +54,30 @@ AliEmcalAODHybridTrackCuts::AliEmcalAODHybridTrackCuts(const char *name):
 AliEmcalTrackSelResultPtr AliEmcalAODHybridTrackCuts::IsSelected(TObject *o){
   AliAODTrack *aodtrack = dynamic_cast<AliAODTrack *>(o);
   if(!aodtrack) return AliEmcalTrackSelResultPtr(nullptr, kFALSE);
-  bool selectionresult = aodtrack->IsHybridGlobalConstrainedGlobal();
-  // Reject non-ITSrefit tracks if requested
-  if((fSelectNonITSrefitTracks == false) && (!(aodtrack->GetStatus() & AliVTrack::kITSrefit))) selectionresult = false;
+  Int_t tracktype(AliEmcalTrackSelResultHybrid::kUndefined);
+  bool selectionresult = IsSelectedValue(aodtrack, tracktype);
   AliEmcalTrackSelResultPtr result(aodtrack, selectionresult);
   // Create user object defining the hybrid track type (only in case the object is selected as hybrid track)
-  if(selectionresult){
-    AliEmcalTrackSelResultHybrid::HybridType_t tracktype = AliEmcalTrackSelResultHybrid::kHybridGlobal;
-    if(fHybridFilterBits[0] > -1 && fHybridFilterBits[1 ] > -1) {
-      if(aodtrack->TestFilterBit(BIT(fHybridFilterBits[0]))) tracktype = AliEmcalTrackSelResultHybrid::kHybridGlobal;
-      else if(aodtrack->TestFilterBit(BIT(fHybridFilterBits[1]))){
-        if(aodtrack->GetStatus() & AliVTrack::kITSrefit) tracktype = AliEmcalTrackSelResultHybrid::kHybridConstrained;
-        else tracktype = AliEmcalTrackSelResultHybrid::kHybridConstrainedNoITSrefit;
-    }
-  }
-  result.SetUserInfo(new AliEmcalTrackSelResultHybrid(tracktype));
+  if(selectionresult) result.SetUserInfo(new AliEmcalTrackSelResultHybrid(static_cast<AliEmcalTrackSelResultHybrid::HybridType_t>(tracktype)));
+  return result;
+}
 
+Bool_t AliEmcalAODHybridTrackCuts::IsSelectedValue(TObject *o, Int_t &hybridtype){
+  hybridtype = AliEmcalTrackSelResultHybrid::kUndefined;
+  AliAODTrack *aodtrack = dynamic_cast<AliAODTrack *>(o);
+  if(!aodtrack) return kFALSE;
+  if(!aodtrack->IsHybridGlobalConstrainedGlobal()) return kFALSE;
+  // Reject non-ITSrefit tracks if requested
+  if((fSelectNonITSrefitTracks == false) && (!(aodtrack->GetStatus() & AliVTrack::kITSrefit))) return kFALSE;
+  hybridtype = AliEmcalTrackSelResultHybrid::kHybridGlobal;
+  if(fHybridFilterBits[0] > -1 && fHybridFilterBits[1 ] > -1) {
+    if(aodtrack->TestFilterBit(BIT(fHybridFilterBits[0]))) hybridtype = AliEmcalTrackSelResultHybrid::kHybridGlobal;
+    else if(aodtrack->TestFilterBit(BIT(fHybridFilterBits[1]))){
+      if(aodtrack->GetStatus() & AliVTrack::kITSrefit) hybridtype = AliEmcalTrackSelResultHybrid::kHybridConstrained;
+      else hybridtype = AliEmcalTrackSelResultHybrid::kHybridConstrainedNoITSrefit;
+    }
   }
-  return result;
+  return kTRUE;
 }
 
 TestAliEmcalAODHybridTrackCuts::TestAliEmcalAODHybridTrackCuts():
@@ -74,6 +74,15 @@ namespace EMCAL {
    */
   virtual AliEmcalTrackSelResultPtr IsSelected(TObject *o);
 
+  /**
+   * @brief Run track selection of hybrid tracks without creating the result objects
+   * 
+   * @param[in] o Object (AliAODTrack) to be tested
+   * @param[out] hybridtype Hybrid track type (kUndefined if not selected)
+   * @return True if the track is a hybrid track
+   */
+  virtual Bool_t IsSelectedValue(TObject *o, Int_t &hybridtype);
+
   /**
    * @brief Switch on/off selection of hybrid tracks without ITSrefit
    * 
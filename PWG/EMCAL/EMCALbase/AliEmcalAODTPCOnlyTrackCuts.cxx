@@ -26,6 +26,7 @@
  ************************************************************************************/
 #include "AliAODTrack.h"
 #include "AliEmcalAODTPCOnlyTrackCuts.h"
+#include "AliEmcalTrackSelResultHybrid.h"
 
 ClassImp(PWG::EMCAL::AliEmcalAODTPCOnlyTrackCuts)
 
@@ -48,4 +49,10 @@ AliEmcalTrackSelResultPtr AliEmcalAODTPCOnlyTrackCuts::IsSelected(TObject *o) {
     return AliEmcalTrackSelResultPtr(aodtrack, aodtrack->IsHybridTPCConstrainedGlobal());
   }
   return AliEmcalTrackSelResultPtr(nullptr, kFALSE);  // Not an AOD track
+}
+
+Bool_t AliEmcalAODTPCOnlyTrackCuts::IsSelectedValue(TObject *o, Int_t &hybridtype) {
+  hybridtype = AliEmcalTrackSelResultHybrid::kUndefined;
+  if(auto aodtrack = dynamic_cast<AliAODTrack *>(o)) return aodtrack->IsHybridTPCConstrainedGlobal();
+  return kFALSE;  // Not an AOD track
 }
\ No newline at end of file
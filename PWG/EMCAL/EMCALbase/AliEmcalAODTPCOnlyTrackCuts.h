@@ -72,6 +72,14 @@ public:
    */
   virtual AliEmcalTrackSelResultPtr IsSelected(TObject *o);
 
+  /**
+   * @brief Selection of TPC-only hybrid tracks without creating the result object
+   * @param[in] o Track to be selected
+   * @param[out] hybridtype Always kUndefined
+   * @return True in case the track is a TPC-only track
+   */
+  virtual Bool_t IsSelectedValue(TObject *o, Int_t &hybridtype);
+
   /// \cond CLASSIMP
   ClassDef(AliEmcalAODTPCOnlyTrackCuts, 1);
   /// \endcond
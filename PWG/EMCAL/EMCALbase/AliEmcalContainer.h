@@ -10,6 +10,7 @@ class AliTLorentzVector;
 class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
+class TArrayI;
 
 #include <TNamed.h>
 #include <TClonesArray.h>
@@ -143,7 +144,7 @@ class AliEmcalContainer : public TObject {
   Int_t                       GetCurrentID()                  const { return fCurrentID                 ; }
   Bool_t                      GetIsParticleLevel()            const { return fIsParticleLevel           ; }
   Int_t                       GetIndexFromLabel(Int_t lab)    const;
-  Int_t                       GetNEntries()                   const { return fClArray ? fClArray->GetEntriesFast() : 0 ; }
+  virtual Int_t               GetNEntries()                   const { return fClArray ? fClArray->GetEntriesFast() : 0 ; }
   virtual Bool_t              GetMomentum(TLorentzVector &mom, Int_t i) const = 0;
   virtual Bool_t              GetAcceptMomentum(TLorentzVector &mom, Int_t i) const = 0;
   virtual Bool_t              GetNextMomentum(TLorentzVector &mom) = 0;
@@ -151,6 +152,14 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  /**
+   * Get the indices of the accepted objects in case the container caches the selection
+   * for the current event (see i.e. AliParticleContainer::SetUseCache). Used by
+   * the iterable containers in order to avoid re-evaluating the selection.
+   * @param[out] indices Indices of accepted objects
+   * @return True if the container provided cached indices, false otherwise
+   */
+  virtual Bool_t              GetCachedAcceptIndices(TArrayI &indices) const { return kFALSE; }
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
@@ -25,6 +25,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
  ************************************************************************************/
 #include "AliEmcalCutBase.h"
+#include "AliEmcalTrackSelResultHybrid.h"
 
 ClassImp(PWG::EMCAL::AliEmcalCutBase)
 
@@ -34,4 +35,11 @@ AliEmcalCutBase::AliEmcalCutBase(const char *name, const char *title):
   TNamed(name, title)
 {
   
-}
\ No newline at end of file
+}
+
+Bool_t AliEmcalCutBase::IsSelectedValue(TObject *o, Int_t &hybridtype){
+  AliEmcalTrackSelResultPtr result = IsSelected(o);
+  const AliEmcalTrackSelResultHybrid *hybridinfo = dynamic_cast<const AliEmcalTrackSelResultHybrid *>(result.GetUserInfo());
+  hybridtype = hybridinfo ? hybridinfo->GetHybridTrackType() : AliEmcalTrackSelResultHybrid::kUndefined;
+  return result.GetSelectionResult();
+}
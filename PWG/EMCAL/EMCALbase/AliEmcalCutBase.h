@@ -54,6 +54,12 @@ namespace EMCAL {
  * - Selection Status
  * - Pointer to track processed
  * - User information (optional)
+ *
+ * For the per-event selection of all tracks in AliEmcalTrackSelection the decision is also needed
+ * without creating the result and user objects: IsSelectedValue(TObject *, Int_t &) returns the
+ * selection status and the hybrid track type (AliEmcalTrackSelResultHybrid::HybridType_t) as plain
+ * values. The default implementation extracts them from IsSelected, cut classes used for track
+ * containers implement it directly.
  */
 class AliEmcalCutBase : public TNamed {
 public:
@@ -63,6 +69,14 @@ public:
 
   virtual AliEmcalTrackSelResultPtr IsSelected(TObject *o) = 0;
 
+  /**
+   * @brief Selection status without result object
+   * @param[in] o Object to be checked
+   * @param[out] hybridtype Hybrid track type (AliEmcalTrackSelResultHybrid::HybridType_t), kUndefined if not defined by the cut
+   * @return True if the object is selected, false otherwise
+   */
+  virtual Bool_t IsSelectedValue(TObject *o, Int_t &hybridtype);
+
 private:
 
   ClassDef(AliEmcalCutBase, 1);
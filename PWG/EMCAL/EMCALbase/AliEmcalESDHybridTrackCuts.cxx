@@ -72,22 +72,30 @@ AliEmcalESDHybridTrackCuts::~AliEmcalESDHybridTrackCuts(){
 
 AliEmcalTrackSelResultPtr AliEmcalESDHybridTrackCuts::IsSelected(TObject *o){
   AliDebugStream(1) << "AliEmcalESDHybridTrackCuts::IsSelected(): Called" << std::endl;
-  if(!fLocalInitialized) Init();
   if(auto esdtrack = dynamic_cast<AliESDtrack *>(o)) {
-    AliEmcalTrackSelResultHybrid::HybridType_t tracktype = AliEmcalTrackSelResultHybrid::kUndefined;
-    if(fHybridTrackCutsGlobal && fHybridTrackCutsGlobal->AcceptTrack(esdtrack)) tracktype = AliEmcalTrackSelResultHybrid::kHybridGlobal;
-    else
-    {
-      if(fHybridTrackCutsConstrained && fHybridTrackCutsConstrained->AcceptTrack(esdtrack)) tracktype = AliEmcalTrackSelResultHybrid::kHybridConstrained;
-      else if(fHybridTrackCutsNoItsRefit && fHybridTrackCutsNoItsRefit->AcceptTrack(esdtrack)) tracktype = AliEmcalTrackSelResultHybrid::kHybridConstrainedNoITSrefit;
-    }
-    AliEmcalTrackSelResultPtr result(esdtrack, tracktype != AliEmcalTrackSelResultHybrid::kUndefined);
+    Int_t tracktype(AliEmcalTrackSelResultHybrid::kUndefined);
+    AliEmcalTrackSelResultPtr result(esdtrack, IsSelectedValue(esdtrack, tracktype));
+    if(result) result.SetUserInfo(new AliEmcalTrackSelResultHybrid(static_cast<AliEmcalTrackSelResultHybrid::HybridType_t>(tracktype)));
     return result;
   }
   AliErrorStream() << "No ESD track" << std::endl;
   return AliEmcalTrackSelResultPtr(nullptr, kFALSE);
 }
 
+Bool_t AliEmcalESDHybridTrackCuts::IsSelectedValue(TObject *o, Int_t &hybridtype){
+  if(!fLocalInitialized) Init();
+  hybridtype = AliEmcalTrackSelResultHybrid::kUndefined;
+  auto esdtrack = dynamic_cast<AliESDtrack *>(o);
+  if(!esdtrack) return kFALSE;
+  if(fHybridTrackCutsGlobal && fHybridTrackCutsGlobal->AcceptTrack(esdtrack)) hybridtype = AliEmcalTrackSelResultHybrid::kHybridGlobal;
+  else
+  {
+    if(fHybridTrackCutsConstrained && fHybridTrackCutsConstrained->AcceptTrack(esdtrack)) hybridtype = AliEmcalTrackSelResultHybrid::kHybridConstrained;
+    else if(fHybridTrackCutsNoItsRefit && fHybridTrackCutsNoItsRefit->AcceptTrack(esdtrack)) hybridtype = AliEmcalTrackSelResultHybrid::kHybridConstrainedNoITSrefit;
+  }
+  return hybridtype != AliEmcalTrackSelResultHybrid::kUndefined;
+}
+
 void AliEmcalESDHybridTrackCuts::Init(){
   switch(fHybridTrackDefinition){
   case kDef2010: InitHybridTracks2010(); break;
@@ -86,6 +86,15 @@ public:
    */
   virtual AliEmcalTrackSelResultPtr IsSelected(TObject *o);
 
+  /**
+   * @brief Test whether track is accepted as hybrid track without creating the result objects
+   * 
+   * @param[in] o Track to be tested
+   * @param[out] hybridtype Hybrid track type (kUndefined if not selected)
+   * @return True if the track is accepted as hybrid track
+   */
+  virtual Bool_t IsSelectedValue(TObject *o, Int_t &hybridtype);
+
   /**
    * @brief Set the hybrid track definition used in the hybrid track selection
    * 
@@ -0,0 +1,171 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include "AliAnalysisManager.h"
+#include "AliVEvent.h"
+
+#include "AliEmcalEventInfo.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalEventInfo)
+/// \endcond
+
+AliEmcalEventInfo *AliEmcalEventInfo::fgInstance = nullptr;
+
+AliEmcalEventInfo::AliEmcalEventInfo() :
+  TObject(),
+  fEvent(nullptr),
+  fEntry(-1),
+  fHasVertices(kFALSE),
+  fNVertCont(0),
+  fNVertSPDCont(0),
+  fBeamType(-1),
+  fCentralities(),
+  fHasEventPlane(kFALSE),
+  fEPV0(0),
+  fEPV0A(0),
+  fEPV0C(0),
+  fTriggers()
+{
+  for (Int_t i = 0; i < 3; i++) {
+    fVertex[i] = 0;
+    fVertexSPD[i] = 0;
+  }
+}
+
+AliEmcalEventInfo *AliEmcalEventInfo::Instance()
+{
+  if (!fgInstance) {
+    fgInstance = new AliEmcalEventInfo;
+  }
+  return fgInstance;
+}
+
+/**
+ * Check whether the stored values belong to the event currently processed by
+ * the analysis manager.
+ * @param event Input event of the calling task
+ * @return kTRUE if the stored values are those of event
+ */
+Bool_t AliEmcalEventInfo::IsCurrentEvent(const AliVEvent *event) const
+{
+  if (!event || event != fEvent) return kFALSE;
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  return entry == fEntry;
+}
+
+/**
+ * Clear all the stored values and attach the object to a new event.
+ * @param event Input event of the calling task
+ */
+void AliEmcalEventInfo::NewEvent(const AliVEvent *event)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  fEvent = event;
+  fEntry = mgr ? mgr->GetCurrentEntry() : -1;
+  fHasVertices = kFALSE;
+  fBeamType = -1;
+  fCentralities.clear();
+  fHasEventPlane = kFALSE;
+  fTriggers.clear();
+}
+
+void AliEmcalEventInfo::GetVertices(Double_t *vertex, Int_t &nCont, Double_t *vertexSPD, Int_t &nContSPD) const
+{
+  for (Int_t i = 0; i < 3; i++) {
+    vertex[i] = fVertex[i];
+    vertexSPD[i] = fVertexSPD[i];
+  }
+  nCont = fNVertCont;
+  nContSPD = fNVertSPDCont;
+}
+
+void AliEmcalEventInfo::SetVertices(const Double_t *vertex, Int_t nCont, const Double_t *vertexSPD, Int_t nContSPD)
+{
+  for (Int_t i = 0; i < 3; i++) {
+    fVertex[i] = vertex[i];
+    fVertexSPD[i] = vertexSPD[i];
+  }
+  fNVertCont = nCont;
+  fNVertSPDCont = nContSPD;
+  fHasVertices = kTRUE;
+}
+
+/**
+ * Look up the centrality of an estimator.
+ * @param[in] estimator Name of the estimator
+ * @param[in] newEstimation Centrality from AliMultSelection (kTRUE) or AliCentrality (kFALSE)
+ * @param[out] cent Centrality percentile, unchanged if not found
+ * @return kTRUE if the centrality was stored for this estimator
+ */
+Bool_t AliEmcalEventInfo::GetCentrality(const TString &estimator, Bool_t newEstimation, Double_t &cent) const
+{
+  for (const auto &entry : fCentralities) {
+    if (entry.fNewEstimation == newEstimation && entry.fEstimator == estimator) {
+      cent = entry.fCent;
+      return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
+void AliEmcalEventInfo::SetCentrality(const TString &estimator, Bool_t newEstimation, Double_t cent)
+{
+  CentralityEntry entry;
+  entry.fEstimator = estimator;
+  entry.fNewEstimation = newEstimation;
+  entry.fCent = cent;
+  fCentralities.push_back(entry);
+}
+
+void AliEmcalEventInfo::GetEventPlane(Double_t &epV0, Double_t &epV0A, Double_t &epV0C) const
+{
+  epV0 = fEPV0;
+  epV0A = fEPV0A;
+  epV0C = fEPV0C;
+}
+
+void AliEmcalEventInfo::SetEventPlane(Double_t epV0, Double_t epV0A, Double_t epV0C)
+{
+  fEPV0 = epV0;
+  fEPV0A = epV0A;
+  fEPV0C = epV0C;
+  fHasEventPlane = kTRUE;
+}
+
+/**
+ * Look up the trigger bits derived from a trigger patch array.
+ * @param[in] patches Trigger patch array
+ * @param[out] triggers Trigger bits, unchanged if not found
+ * @return kTRUE if the bits were stored for this array
+ */
+Bool_t AliEmcalEventInfo::GetTriggerBits(const TClonesArray *patches, ULong_t &triggers) const
+{
+  for (const auto &entry : fTriggers) {
+    if (entry.fPatches == patches) {
+      triggers = entry.fTriggers;
+      return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
+void AliEmcalEventInfo::SetTriggerBits(const TClonesArray *patches, ULong_t triggers)
+{
+  TriggerEntry entry;
+  entry.fPatches = patches;
+  entry.fTriggers = triggers;
+  fTriggers.push_back(entry);
+}
@@ -0,0 +1,106 @@
+#ifndef ALIEMCALEVENTINFO_H
+#define ALIEMCALEVENTINFO_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <TObject.h>
+#include <TString.h>
+
+class AliVEvent;
+class TClonesArray;
+
+/**
+ * @class AliEmcalEventInfo
+ * @brief Per-event objects shared among the EMCAL wagons of a train
+ * @ingroup  EMCALCOREFW
+ *
+ * Singleton holding the quantities that every AliAnalysisTaskEmcal wagon extracts from the
+ * input event in RetrieveEventObjects(): primary and SPD vertex, beam type, centrality per
+ * estimator, event plane and the trigger bits derived from a trigger patch array. The first
+ * wagon running on a new event fills the object; the following wagons of the same event read
+ * it instead of repeating the lookups.
+ *
+ * ~~~{.cxx}
+ * task->SetUseSharedEventInfo(kTRUE);
+ * ~~~
+ *
+ * The event is identified as in AliPIDResponseCache by the input event pointer together with
+ * the current entry of the analysis manager, so the object is reset automatically for each new
+ * event. Settings-dependent values are stored with their settings (centrality estimator and
+ * method, trigger patch array), so wagons with different settings never read each other's
+ * values; a wagon only falls back to its own lookup for a value nobody filled yet.
+ */
+class AliEmcalEventInfo : public TObject {
+public:
+  /**
+   * Get the instance shared by all the wagons. If called for the first time a new
+   * object is created
+   * @return Shared event info
+   */
+  static AliEmcalEventInfo *Instance();
+
+  virtual ~AliEmcalEventInfo() {}
+
+  Bool_t   IsCurrentEvent(const AliVEvent *event) const;
+  void     NewEvent(const AliVEvent *event);
+
+  Bool_t   HasVertices()                         const { return fHasVertices; }
+  void     GetVertices(Double_t *vertex, Int_t &nCont, Double_t *vertexSPD, Int_t &nContSPD) const;
+  void     SetVertices(const Double_t *vertex, Int_t nCont, const Double_t *vertexSPD, Int_t nContSPD);
+
+  Bool_t   HasBeamType()                         const { return fBeamType >= 0; }
+  Int_t    GetBeamType()                         const { return fBeamType; }
+  void     SetBeamType(Int_t beamType)                 { fBeamType = beamType; }
+
+  Bool_t   GetCentrality(const TString &estimator, Bool_t newEstimation, Double_t &cent) const;
+  void     SetCentrality(const TString &estimator, Bool_t newEstimation, Double_t cent);
+
+  Bool_t   HasEventPlane()                       const { return fHasEventPlane; }
+  void     GetEventPlane(Double_t &epV0, Double_t &epV0A, Double_t &epV0C) const;
+  void     SetEventPlane(Double_t epV0, Double_t epV0A, Double_t epV0C);
+
+  Bool_t   GetTriggerBits(const TClonesArray *patches, ULong_t &triggers) const;
+  void     SetTriggerBits(const TClonesArray *patches, ULong_t triggers);
+
+private:
+  AliEmcalEventInfo();
+  AliEmcalEventInfo(const AliEmcalEventInfo &);
+  AliEmcalEventInfo &operator=(const AliEmcalEventInfo &);
+
+  /// Centrality of one estimator
+  struct CentralityEntry {
+    TString  fEstimator;        ///< estimator name
+    Bool_t   fNewEstimation;    ///< AliMultSelection (kTRUE) or AliCentrality (kFALSE)
+    Double_t fCent;             ///< centrality percentile
+  };
+
+  /// Trigger bits obtained from one trigger patch array
+  struct TriggerEntry {
+    const TClonesArray *fPatches; ///< trigger patch array
+    ULong_t  fTriggers;         ///< trigger bits
+  };
+
+  static AliEmcalEventInfo *fgInstance;      ///< shared instance
+
+  const AliVEvent          *fEvent;          //!<! input event of the stored values
+  Long64_t                  fEntry;          //!<! analysis manager entry of the stored values
+  Bool_t                    fHasVertices;    //!<! vertices filled
+  Double_t                  fVertex[3];      //!<! primary vertex
+  Int_t                     fNVertCont;      //!<! primary vertex contributors
+  Double_t                  fVertexSPD[3];   //!<! SPD vertex
+  Int_t                     fNVertSPDCont;   //!<! SPD vertex contributors
+  Int_t                     fBeamType;       //!<! beam type from the event (-1 if not filled)
+  std::vector<CentralityEntry> fCentralities; //!<! centrality per estimator
+  Bool_t                    fHasEventPlane;  //!<! event plane filled
+  Double_t                  fEPV0;           //!<! event plane V0
+  Double_t                  fEPV0A;          //!<! event plane V0A
+  Double_t                  fEPV0C;          //!<! event plane V0C
+  std::vector<TriggerEntry> fTriggers;       //!<! trigger bits per patch array
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalEventInfo, 1);
+  /// \endcond
+};
+
+#endif
@@ -328,16 +328,22 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 /**
  * Build list of accepted indices inside the container.
  * For this all objects inside the container are checked
- * for being accepted or not.
+ * for being accepted or not, unless the container provides
+ * the accepted indices from its per-event cache.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
+  // Use the selection cached by the container for the current event if available
+  if(fkContainer->GetCachedAcceptIndices(fAcceptIndices)) return;
+
+  // Evaluate the selection only once per object: reserve space for all entries and shrink afterwards
+  fAcceptIndices.Set(fkContainer->GetNEntries());
   int acceptCounter = 0;
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
     UInt_t rejectionReason = 0;
     if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
   }
+  fAcceptIndices.Set(acceptCounter);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -13,7 +13,11 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 
+#include <algorithm>
+#include <vector>
 #include "TList.h"
+#include "TClass.h"
+#include "TMethodCall.h"
 #include "TH1.h"
 #include "THnBase.h"
 #include "AliLog.h"
@@ -24,7 +28,7 @@ ClassImp(AliEmcalList)
 /// \endcond
 
 //________________________________________________________________________
-AliEmcalList::AliEmcalList() : TList(), fUseScaling(kFALSE)
+AliEmcalList::AliEmcalList() : TList(), fUseScaling(kFALSE), fIncrementalMerge(kFALSE), fMergeFanIn(8)
 {
   // constructor
 }
@@ -38,7 +42,7 @@ Long64_t AliEmcalList::Merge(TCollection *hlist)
 
   AliInfo(Form("Scaled merging for list %s is %sactivated.", hlist->GetName(),(fUseScaling) ? "" : "not "));
   if(!fUseScaling)
-    return TList::Merge(hlist);
+    return fIncrementalMerge ? MergeIncremental(hlist) : TList::Merge(hlist);
 
   // #### Retrieve xsection and ntrials from histograms in this list
   // NOTE: they must be directly added to the AliEmcalList, not nested in sublists!
@@ -75,10 +79,133 @@ Long64_t AliEmcalList::Merge(TCollection *hlist)
 
   AliInfo("Merge() done.");
 
+  if(fIncrementalMerge)
+    return MergeIncremental(hlist);
   TList::Merge(hlist);
   return hlist->GetEntries() + 1;
 }
 
+/// Merge the lists in hlist into this list with a tree reduction:
+/// the inputs are merged in groups of fMergeFanIn into the first list
+/// of each group, until the remaining lists are merged into this one.
+/// The input lists are modified in the process.
+//________________________________________________________________________
+Long64_t AliEmcalList::MergeIncremental(TCollection *hlist)
+{
+  std::vector<TCollection *> inputs;
+  TIter listIterator(hlist);
+  while (TObject* listObject = listIterator())
+  {
+    TCollection *input = dynamic_cast<TCollection *>(listObject);
+    if(input && input != this)
+      inputs.push_back(input);
+  }
+
+  const size_t fanIn = fMergeFanIn > 1 ? fMergeFanIn : 2;
+  while(inputs.size() > fanIn)
+  {
+    std::vector<TCollection *> groups;
+    for(size_t first = 0; first < inputs.size(); first += fanIn)
+    {
+      size_t last = std::min(first + fanIn, inputs.size());
+      MergeCollections(inputs[first], &inputs[first] + 1, last - first - 1);
+      groups.push_back(inputs[first]);
+    }
+    inputs.swap(groups);
+  }
+  if(!inputs.empty())
+    MergeCollections(this, &inputs[0], inputs.size());
+
+  return hlist->GetEntries() + 1;
+}
+
+/// Merge the objects of the input collections into the corresponding objects of
+/// the target collection. Objects are matched by position, or by name if the
+/// layout of an input differs. Nested collections are merged recursively and
+/// empty histograms are not passed to Merge.
+//________________________________________________________________________
+void AliEmcalList::MergeCollections(TCollection *target, TCollection **inputs, Int_t ninputs)
+{
+  if(!ninputs)
+    return;
+
+  std::vector<TIter *> inputIterators(ninputs);
+  for(Int_t iinput = 0; iinput < ninputs; iinput++)
+    inputIterators[iinput] = new TIter(inputs[iinput]);
+
+  std::vector<TCollection *> subcollections;
+  TList mergeList;
+  TIter targetIterator(target);
+  while (TObject* targetObject = targetIterator())
+  {
+    subcollections.clear();
+    mergeList.Clear();
+    TCollection *targetCollection = dynamic_cast<TCollection *>(targetObject);
+    for(Int_t iinput = 0; iinput < ninputs; iinput++)
+    {
+      TObject *inputObject = (*inputIterators[iinput])();
+      if(!inputObject || strcmp(inputObject->GetName(), targetObject->GetName()))
+        inputObject = inputs[iinput]->FindObject(targetObject->GetName());
+      if(!inputObject)
+        continue;
+      if(targetCollection)
+      {
+        TCollection *inputCollection = dynamic_cast<TCollection *>(inputObject);
+        if(inputCollection)
+          subcollections.push_back(inputCollection);
+      }
+      else if(!IsEmptyObject(inputObject))
+        mergeList.Add(inputObject);
+    }
+
+    if(targetCollection)
+    {
+      if(!subcollections.empty())
+        MergeCollections(targetCollection, &subcollections[0], subcollections.size());
+      continue;
+    }
+    if(mergeList.IsEmpty())
+      continue;
+
+    if(TH1 *histogram = dynamic_cast<TH1 *>(targetObject))
+      histogram->Merge(&mergeList);
+    else if(THnBase *histogramND = dynamic_cast<THnBase *>(targetObject))
+      histogramND->Merge(&mergeList);
+    else
+    {
+      // Any other mergeable object, as done by TCollection::Merge
+      TMethodCall callEnv;
+      if(targetObject->IsA())
+        callEnv.InitWithPrototype(targetObject->IsA(), "Merge", "TCollection*");
+      if(!callEnv.IsValid())
+      {
+        AliWarning(Form("Object %s (%s) cannot be merged", targetObject->GetName(), targetObject->ClassName()));
+        continue;
+      }
+      callEnv.SetParam((Long_t) &mergeList);
+      callEnv.Execute(targetObject);
+    }
+  }
+  mergeList.Clear();
+
+  for(Int_t iinput = 0; iinput < ninputs; iinput++)
+    delete inputIterators[iinput];
+}
+
+/// Helper function to identify histograms without any content,
+/// which do not need to be merged
+//________________________________________________________________________
+Bool_t AliEmcalList::IsEmptyObject(const TObject *obj) const
+{
+  const TH1 *histogram = dynamic_cast<const TH1 *>(obj);
+  if(histogram)
+    return histogram->GetEntries() == 0 && histogram->GetSumOfWeights() == 0;
+  const THnBase *histogramND = dynamic_cast<const THnBase *>(obj);
+  if(histogramND)
+    return histogramND->GetEntries() == 0 && histogramND->GetSumw() == 0;
+  return kFALSE;
+}
+
 /// Function that does the scaling of all histograms in hlist recursively
 //________________________________________________________________________
 void AliEmcalList::ScaleAllHistograms(TCollection *hlist, Double_t scalingFactor)
@@ -11,6 +11,11 @@
  * Scaling is recursively applied also to all nested lists deriving from TCollection
  * fHistXsection and fHistTrials must be added directly to the list (not to a nested list)
  *
+ * With SetIncrementalMerge(kTRUE) the lists are merged object by object instead of via
+ * TList::Merge: empty histograms of the inputs are skipped, nested collections are merged
+ * recursively, and many inputs are combined with a tree reduction (groups of fMergeFanIn
+ * inputs are merged first, then the results of the groups)
+ *
  * \author Ruediger Haake <ruediger.haake@cern.ch>, CERN
  * \date May 05, 2016
  * \ingroup EMCALCOREFW
@@ -30,6 +35,8 @@ public:
   Long64_t                    Merge(TCollection *hlist);
   void                        SetUseScaling(Bool_t val) {fUseScaling = val;}
   Bool_t                      IsUseScaling() const { return fUseScaling; }
+  void                        SetIncrementalMerge(Bool_t val, Int_t fanIn = 8) {fIncrementalMerge = val; fMergeFanIn = fanIn;}
+  Bool_t                      IsIncrementalMerge() const { return fIncrementalMerge; }
 
 private:
   // ####### Helper functions
@@ -37,11 +44,16 @@ private:
   Double_t                    GetScalingFactor(TH1* xsection, TH1* ntrials);
   Bool_t                      IsLastMergeLevel(TCollection* collection);
   Int_t                       GetFilledBinNumber(TH1* hist);
+  Long64_t                    MergeIncremental(TCollection *hlist);
+  void                        MergeCollections(TCollection *target, TCollection **inputs, Int_t ninputs);
+  Bool_t                      IsEmptyObject(const TObject *obj) const;
   
   Bool_t                      fUseScaling;                    ///< if true, scaling will be done. if false AliEmcalList simplifies to TList
+  Bool_t                      fIncrementalMerge;              ///< if true, merge object by object skipping empty inputs, with a tree reduction over the inputs
+  Int_t                       fMergeFanIn;                    ///< number of inputs merged together in one step of the tree reduction
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalList, 1);
+  ClassDef(AliEmcalList, 2);
   /// \endcond
 };
 
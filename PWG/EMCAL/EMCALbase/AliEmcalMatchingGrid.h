@@ -0,0 +1,153 @@
+#ifndef ALIEMCALMATCHINGGRID_H
+#define ALIEMCALMATCHINGGRID_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <algorithm>
+#include <Rtypes.h>
+#include <TMath.h>
+
+/**
+ * @class AliEmcalMatchingGrid
+ * @brief Per-event grid of positions on the calorimeter surface for cluster-track matching
+ * @ingroup EMCALCOREFW
+ *
+ * Positions (e.g. the track positions after propagation to the EMCal
+ * surface, or the cluster positions) are added once per event together with
+ * an index of the caller, and binned on a grid in a linear coordinate
+ * (\f$\eta\f$ or z) and the periodic azimuthal angle. Matching a cluster is then
+ * a query of the entries in the cells around its position instead of a loop
+ * over all the entries of the event:
+ *
+ * ~~~{.cxx}
+ * grid.Reset(-0.9, 0.9, maxDist, maxDist);
+ * for(Int_t itrack = 0; itrack < ntracks; itrack++) grid.Add(etaOnEMCal[itrack], phiOnEMCal[itrack], itrack);
+ * grid.Build();
+ * grid.FindCandidates(clusterEta, clusterPhi, maxDist, maxDist, candidates);
+ * ~~~
+ *
+ * The query returns all the entries of the cells overlapping the window,
+ * the exact matching criterion has to be applied by the caller, so that the
+ * matching result does not depend on the grid binning. Entries outside the
+ * range in the linear coordinate are kept in the first or last row. Candidates
+ * are returned in the order in which they were added.
+ */
+class AliEmcalMatchingGrid {
+public:
+  AliEmcalMatchingGrid(): fMin(0), fMax(0), fCellSize(1), fPhiCellSize(TMath::TwoPi()), fNCells(1), fNPhiCells(1),
+    fU(), fPhi(), fIndex(), fCellStart(), fOrdered(), fBuilt(kFALSE) {}
+  ~AliEmcalMatchingGrid() {}
+
+  /**
+   * @brief Remove all entries and set the binning for the next event.
+   * The memory of the arrays is kept for the next event.
+   * @param[in] min Lower edge of the grid in the linear coordinate
+   * @param[in] max Upper edge of the grid in the linear coordinate
+   * @param[in] cellSize Cell size in the linear coordinate, typically the matching window
+   * @param[in] phiCellSize Cell size in the azimuthal angle, typically the matching window
+   */
+  void Reset(Double_t min, Double_t max, Double_t cellSize, Double_t phiCellSize) {
+    fMin = min; fMax = max > min ? max : min + 1;
+    fCellSize = cellSize > 0 ? cellSize : fMax - fMin;
+    fNCells = TMath::Max(1, TMath::Min(1000, TMath::CeilNint((fMax - fMin) / fCellSize)));
+    fNPhiCells = phiCellSize > 0 ? TMath::Max(1, TMath::Min(1000, Int_t(TMath::TwoPi() / phiCellSize))) : 1;
+    fPhiCellSize = TMath::TwoPi() / fNPhiCells;
+    fU.clear(); fPhi.clear(); fIndex.clear();
+    fBuilt = kFALSE;
+  }
+
+  /**
+   * @brief Add an entry, to be called before Build().
+   * @param[in] u Linear coordinate (\f$\eta\f$ or z)
+   * @param[in] phi Azimuthal angle, any range
+   * @param[in] index Index of the entry for the caller (e.g. track index)
+   */
+  void Add(Double_t u, Double_t phi, Int_t index) {
+    fU.push_back(u); fPhi.push_back(WrapPhi(phi)); fIndex.push_back(index);
+    fBuilt = kFALSE;
+  }
+
+  /**
+   * @brief Sort the entries by cell, to be called once after all the entries are added.
+   */
+  void Build() {
+    Int_t ncells = fNCells * fNPhiCells;
+    fCellStart.assign(ncells + 1, 0);
+    std::vector<Int_t> cell(fU.size());
+    for(UInt_t ientry = 0; ientry < fU.size(); ientry++) {
+      cell[ientry] = GetCell(fU[ientry], fPhi[ientry]);
+      fCellStart[cell[ientry] + 1]++;
+    }
+    for(Int_t icell = 0; icell < ncells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+    fOrdered.resize(fU.size());
+    std::vector<Int_t> fill(fCellStart.begin(), fCellStart.end() - 1);
+    for(UInt_t ientry = 0; ientry < fU.size(); ientry++) fOrdered[fill[cell[ientry]]++] = ientry;
+    fBuilt = kTRUE;
+  }
+
+  Bool_t IsBuilt() const { return fBuilt; }
+  Int_t GetEntries() const { return fU.size(); }
+  Double_t GetU(Int_t ientry) const { return fU[ientry]; }
+  Double_t GetPhi(Int_t ientry) const { return fPhi[ientry]; }
+  Int_t GetIndex(Int_t ientry) const { return fIndex[ientry]; }
+
+  /**
+   * @brief Find the entries in the cells overlapping a window around a position.
+   * @param[in] u Linear coordinate of the position
+   * @param[in] phi Azimuthal angle of the position
+   * @param[in] du Half width of the window in the linear coordinate
+   * @param[in] dphi Half width of the window in the azimuthal angle
+   * @param[out] candidates Entry numbers (not caller indices), use GetIndex() to get the caller index
+   */
+  void FindCandidates(Double_t u, Double_t phi, Double_t du, Double_t dphi, std::vector<Int_t> &candidates) const {
+    candidates.clear();
+    if(!fBuilt) return;
+    Int_t ulow = GetUCell(u - du), uhigh = GetUCell(u + du);
+    Int_t nphi = fNPhiCells;
+    Int_t phiCenter = GetPhiCell(WrapPhi(phi));
+    Int_t dcells = dphi >= TMath::Pi() ? nphi : Int_t(dphi / fPhiCellSize) + 1;
+    if(2 * dcells + 1 >= nphi) { phiCenter = 0; dcells = -1; }
+    for(Int_t iu = ulow; iu <= uhigh; iu++) {
+      if(dcells < 0) {
+        // the window covers the full azimuth
+        AppendCell(iu * nphi, (iu + 1) * nphi, candidates);
+        continue;
+      }
+      for(Int_t iphi = phiCenter - dcells; iphi <= phiCenter + dcells; iphi++) {
+        Int_t icell = iu * nphi + ((iphi % nphi) + nphi) % nphi;
+        AppendCell(icell, icell + 1, candidates);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+  }
+
+private:
+  static Double_t WrapPhi(Double_t phi) {
+    phi = TMath::Abs(phi) < 100 ? phi : 0; // default values of not propagated tracks
+    while(phi < 0) phi += TMath::TwoPi();
+    while(phi >= TMath::TwoPi()) phi -= TMath::TwoPi();
+    return phi;
+  }
+  Int_t GetUCell(Double_t u) const { return TMath::Max(0, TMath::Min(fNCells - 1, Int_t(TMath::Floor((u - fMin) / fCellSize)))); }
+  Int_t GetPhiCell(Double_t phi) const { return TMath::Min(fNPhiCells - 1, Int_t(phi / fPhiCellSize)); }
+  Int_t GetCell(Double_t u, Double_t phi) const { return GetUCell(u) * fNPhiCells + GetPhiCell(phi); }
+  void AppendCell(Int_t first, Int_t last, std::vector<Int_t> &candidates) const {
+    for(Int_t ientry = fCellStart[first]; ientry < fCellStart[last]; ientry++) candidates.push_back(fOrdered[ientry]);
+  }
+
+  Double_t                        fMin;                 ///< Lower edge in the linear coordinate
+  Double_t                        fMax;                 ///< Upper edge in the linear coordinate
+  Double_t                        fCellSize;            ///< Cell size in the linear coordinate
+  Double_t                        fPhiCellSize;         ///< Cell size in the azimuthal angle
+  Int_t                           fNCells;              ///< Number of cells in the linear coordinate
+  Int_t                           fNPhiCells;           ///< Number of cells in the azimuthal angle
+  std::vector<Double_t>           fU;                   ///< Linear coordinate per entry
+  std::vector<Double_t>           fPhi;                 ///< Azimuthal angle in [0,2pi) per entry
+  std::vector<Int_t>              fIndex;               ///< Caller index per entry
+  std::vector<Int_t>              fCellStart;           ///< First ordered entry per cell, size ncells+1
+  std::vector<Int_t>              fOrdered;             ///< Entry numbers grouped by cell
+  Bool_t                          fBuilt;               ///< Build() called after the last Add()
+};
+
+#endif
@@ -0,0 +1,241 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+#include <TClonesArray.h>
+
+#include "AliVEvent.h"
+#include "AliLog.h"
+
+#include "AliEmcalMergedParticleContainer.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalMergedParticleContainer);
+/// \endcond
+
+/**
+ * Default constructor.
+ */
+AliEmcalMergedParticleContainer::AliEmcalMergedParticleContainer():
+  AliParticleContainer(),
+  fComponents(),
+  fOffsets()
+{
+  fComponents.SetOwner(kTRUE);
+}
+
+/**
+ * Standard constructor.
+ * @param name Name of the merged container, not an array in the event
+ */
+AliEmcalMergedParticleContainer::AliEmcalMergedParticleContainer(const char *name):
+  AliParticleContainer(name),
+  fComponents(),
+  fOffsets()
+{
+  fComponents.SetOwner(kTRUE);
+}
+
+/**
+ * Add a component container, adopted by the merged container.
+ * Has to be called before the arrays are connected (SetArray).
+ * @param cont Component container
+ * @return The component container
+ */
+AliParticleContainer* AliEmcalMergedParticleContainer::AddComponent(AliParticleContainer *cont)
+{
+  if (!cont) return 0;
+  fComponents.Add(cont);
+  return cont;
+}
+
+/**
+ * Find the component holding the particle with a given merged index.
+ * @param[in] i Index in the merged container
+ * @param[out] localIndex Index of the particle in the component
+ * @return Component container, 0 if the index is out of range
+ */
+AliParticleContainer* AliEmcalMergedParticleContainer::GetComponentFromIndex(Int_t i, Int_t &localIndex) const
+{
+  localIndex = -1;
+  if (i < 0 || i >= GetNEntries()) return 0;
+  // first offset larger than i, the component is the one before
+  Int_t icomp = std::upper_bound(fOffsets.begin(), fOffsets.end(), i) - fOffsets.begin() - 1;
+  localIndex = i - fOffsets[icomp];
+  return GetComponent(icomp);
+}
+
+/**
+ * Recompute the merged indices from the current number of entries of the components.
+ */
+void AliEmcalMergedParticleContainer::UpdateOffsets()
+{
+  Int_t ncomp = GetNComponents();
+  fOffsets.resize(ncomp + 1);
+  fOffsets[0] = 0;
+  for (Int_t icomp = 0; icomp < ncomp; icomp++) {
+    fOffsets[icomp + 1] = fOffsets[icomp] + GetComponent(icomp)->GetNEntries();
+  }
+}
+
+/**
+ * Connect the components to their arrays. The merged container has no array in
+ * the event, it points to the array of the first component so that the type of
+ * the particles can be checked by the users of the container.
+ * @param event Input event
+ */
+void AliEmcalMergedParticleContainer::SetArray(const AliVEvent * event)
+{
+  for (Int_t icomp = 0; icomp < GetNComponents(); icomp++) {
+    GetComponent(icomp)->SetArray(event);
+  }
+
+  if (GetNComponents() == 0) {
+    AliError(Form("%s: No component containers!", GetName()));
+  }
+  else if (GetComponent(0)->GetArray()) {
+    fClArray = GetComponent(0)->GetArray();
+    fLoadedClass = fClArray->GetClass();
+  }
+
+  UpdateOffsets();
+}
+
+/**
+ * Prepare the components for the next event and update the merged indices.
+ * @param event Input event
+ */
+void AliEmcalMergedParticleContainer::NextEvent(const AliVEvent *event)
+{
+  for (Int_t icomp = 0; icomp < GetNComponents(); icomp++) {
+    GetComponent(icomp)->NextEvent(event);
+  }
+
+  UpdateOffsets();
+
+  AliParticleContainer::NextEvent(event);
+}
+
+/**
+ * Get the particle with the given merged index.
+ * @param i Index in the merged container (-1 for the current one)
+ * @return Particle, 0 if the index is out of range
+ */
+AliVParticle* AliEmcalMergedParticleContainer::GetParticle(Int_t i) const
+{
+  if (i == -1) i = fCurrentID;
+  Int_t local = -1;
+  AliParticleContainer *cont = GetComponentFromIndex(i, local);
+  return cont ? cont->GetParticle(local) : 0;
+}
+
+/**
+ * Apply the selection of the component holding the particle.
+ * @param[in] i Index in the merged container
+ * @param[out] rejectionReason Bit map of the failed cuts
+ * @return True if the particle is accepted by its component
+ */
+Bool_t AliEmcalMergedParticleContainer::AcceptParticle(Int_t i, UInt_t &rejectionReason) const
+{
+  Int_t local = -1;
+  AliParticleContainer *cont = GetComponentFromIndex(i, local);
+  if (!cont) {
+    rejectionReason |= kNullObject;
+    return kFALSE;
+  }
+  return cont->AcceptParticle(local, rejectionReason);
+}
+
+/**
+ * Apply the selection of the component holding the particle. The component is
+ * searched in the arrays of the components, particles not found in any of them
+ * are tested with the selection of the first component.
+ * @param[in] vp Particle
+ * @param[out] rejectionReason Bit map of the failed cuts
+ * @return True if the particle is accepted
+ */
+Bool_t AliEmcalMergedParticleContainer::AcceptParticle(const AliVParticle* vp, UInt_t &rejectionReason) const
+{
+  if (GetNComponents() == 0) {
+    rejectionReason |= kNullObject;
+    return kFALSE;
+  }
+  for (Int_t icomp = 0; icomp < GetNComponents(); icomp++) {
+    AliParticleContainer *cont = GetComponent(icomp);
+    if (cont->GetArray() && cont->GetArray()->IndexOf(vp) >= 0) return cont->AcceptParticle(vp, rejectionReason);
+  }
+  return GetComponent(0)->AcceptParticle(vp, rejectionReason);
+}
+
+/**
+ * Get the momentum of a particle with the mass hypothesis of its component.
+ * @param[out] mom Momentum vector
+ * @param[in] i Index in the merged container (-1 for the current one)
+ * @return True if the particle exists
+ */
+Bool_t AliEmcalMergedParticleContainer::GetMomentum(TLorentzVector &mom, Int_t i) const
+{
+  if (i == -1) i = fCurrentID;
+  Int_t local = -1;
+  AliParticleContainer *cont = GetComponentFromIndex(i, local);
+  if (!cont) {
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+  return cont->GetMomentum(mom, local);
+}
+
+/**
+ * Get the momentum of an accepted particle with the mass hypothesis of its component.
+ * @param[out] mom Momentum vector
+ * @param[in] i Index in the merged container (-1 for the current one)
+ * @return True if the particle is accepted
+ */
+Bool_t AliEmcalMergedParticleContainer::GetAcceptMomentum(TLorentzVector &mom, Int_t i) const
+{
+  if (i == -1) i = fCurrentID;
+  if (!GetAcceptParticle(i)) {
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+  return GetMomentum(mom, i);
+}
+
+/**
+ * Get the momentum of the next particle.
+ * @param[out] mom Momentum vector
+ * @return True if there is a next particle
+ */
+Bool_t AliEmcalMergedParticleContainer::GetNextMomentum(TLorentzVector &mom)
+{
+  if (!GetNextParticle()) {
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+  return GetMomentum(mom, fCurrentID);
+}
+
+/**
+ * Get the momentum of the next accepted particle.
+ * @param[out] mom Momentum vector
+ * @return True if there is a next accepted particle
+ */
+Bool_t AliEmcalMergedParticleContainer::GetNextAcceptMomentum(TLorentzVector &mom)
+{
+  if (!GetNextAcceptParticle()) {
+    mom.SetPtEtaPhiM(0, 0, 0, 0);
+    return kFALSE;
+  }
+  return GetMomentum(mom, fCurrentID);
+}
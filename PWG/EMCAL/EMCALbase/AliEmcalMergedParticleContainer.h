@@ -0,0 +1,77 @@
+#ifndef ALIEMCALMERGEDPARTICLECONTAINER_H
+#define ALIEMCALMERGEDPARTICLECONTAINER_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <TObjArray.h>
+
+#include "AliParticleContainer.h"
+
+/**
+ * @class AliEmcalMergedParticleContainer
+ * @brief Particle container presenting several particle containers as one
+ * @ingroup EMCALCOREFW
+ *
+ * The particles of the component containers (e.g. the tracks of the data
+ * event and the tracks of the embedded event) are presented as one logical
+ * container, without copying them into a new TClonesArray. The index i of
+ * the merged container runs over the particles of the first component, then
+ * over the particles of the second component, and so on:
+ *
+ * ~~~{.cxx}
+ * AliEmcalMergedParticleContainer *merged = new AliEmcalMergedParticleContainer("tracksMerged");
+ * merged->AddComponent(new AliTrackContainer("tracks"));
+ * AliTrackContainer *embedded = new AliTrackContainer("tracks");
+ * embedded->SetIsEmbedding(kTRUE);
+ * merged->AddComponent(embedded);
+ * task->AdoptParticleContainer(merged);
+ * ~~~
+ *
+ * The selection and the mass hypothesis of each component are applied to its
+ * own particles, the cuts set on the merged container itself are not used.
+ * GetComponentFromIndex() gives the component and its local index, needed to
+ * register a particle in the AliEmcalContainerIndexMap of the component arrays.
+ */
+class AliEmcalMergedParticleContainer : public AliParticleContainer {
+ public:
+  AliEmcalMergedParticleContainer();
+  AliEmcalMergedParticleContainer(const char *name);
+  virtual ~AliEmcalMergedParticleContainer() {;}
+
+  AliParticleContainer       *AddComponent(AliParticleContainer *cont);
+  Int_t                       GetNComponents()                          const   { return fComponents.GetEntriesFast(); }
+  AliParticleContainer       *GetComponent(Int_t i)                     const   { return static_cast<AliParticleContainer*>(fComponents.At(i)); }
+  TObjArray                  &GetComponents()                                   { return fComponents; }
+  AliParticleContainer       *GetComponentFromIndex(Int_t i, Int_t &localIndex) const;
+
+  virtual TObject            *operator[](int index) const                       { return GetParticle(index); }
+  virtual Int_t               GetNEntries()                             const   { return fOffsets.empty() ? 0 : fOffsets.back(); }
+
+  virtual Bool_t              AcceptParticle(const AliVParticle* vp, UInt_t &rejectionReason) const;
+  virtual Bool_t              AcceptParticle(Int_t i, UInt_t &rejectionReason) const;
+  virtual AliVParticle       *GetParticle(Int_t i=-1)                   const;
+  virtual Bool_t              GetMomentum(TLorentzVector &mom, Int_t i) const;
+  virtual Bool_t              GetAcceptMomentum(TLorentzVector &mom, Int_t i) const;
+  virtual Bool_t              GetNextMomentum(TLorentzVector &mom);
+  virtual Bool_t              GetNextAcceptMomentum(TLorentzVector &mom);
+
+  void                        SetArray(const AliVEvent * event);
+  virtual void                NextEvent(const AliVEvent *event);
+
+ protected:
+  void                        UpdateOffsets();
+
+  TObjArray                   fComponents;                    ///< Component containers (owned)
+  std::vector<Int_t>          fOffsets;                       //!<! First merged index of each component, and total number of entries
+
+ private:
+  AliEmcalMergedParticleContainer(const AliEmcalMergedParticleContainer& obj); // copy constructor
+  AliEmcalMergedParticleContainer& operator=(const AliEmcalMergedParticleContainer& other); // assignment
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalMergedParticleContainer,1);
+  /// \endcond
+};
+
+#endif
@@ -0,0 +1,126 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <memory>
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TProfile.h>
+#include <TTree.h>
+
+#include "AliLog.h"
+
+#include "AliEmcalPythiaXsecCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalPythiaXsecCache)
+/// \endcond
+
+AliEmcalPythiaXsecCache *AliEmcalPythiaXsecCache::fgInstance = nullptr;
+
+AliEmcalPythiaXsecCache::AliEmcalPythiaXsecCache() :
+  TObject(),
+  fEntries(),
+  fPrefetched()
+{
+}
+
+AliEmcalPythiaXsecCache *AliEmcalPythiaXsecCache::Instance()
+{
+  if (!fgInstance) {
+    fgInstance = new AliEmcalPythiaXsecCache;
+  }
+  return fgInstance;
+}
+
+/**
+ * Get the values of a cross section file, reading the file at the first request.
+ * @param path Full path of the pyxsec.root or pyxsec_hists.root file
+ * @return Values read from the file (fType kNotOpened if it could not be opened)
+ */
+const AliEmcalPythiaXsecCache::Entry &AliEmcalPythiaXsecCache::Get(const TString &path)
+{
+  std::map<std::string, Entry>::iterator found = fEntries.find(path.Data());
+  if (found != fEntries.end()) return found->second;
+  AliDebugStream(1) << "Reading cross section file " << path << std::endl;
+  Entry &entry = fEntries[path.Data()];
+  entry = ReadFile(path);
+  return entry;
+}
+
+/**
+ * Request the asynchronous opening of a cross section file. TFile::Open() picks up the
+ * pending request when the file is read with Get(). Nothing is done for files which are
+ * already cached or requested.
+ * @param path Full path of the pyxsec.root or pyxsec_hists.root file
+ */
+void AliEmcalPythiaXsecCache::Prefetch(const TString &path)
+{
+  if (path.IsNull() || IsCached(path)) return;
+  if (!fPrefetched.insert(path.Data()).second) return;
+  AliDebugStream(2) << "Requesting asynchronous opening of cross section file " << path << std::endl;
+  TFile::AsyncOpen(path.Data());
+}
+
+void AliEmcalPythiaXsecCache::Clear(Option_t *)
+{
+  fEntries.clear();
+  fPrefetched.clear();
+}
+
+/**
+ * Read the cross section and trials from a file: either the Xsection tree of pyxsec.root
+ * or the h1Xsec and h1Trials histograms in the first list of pyxsec_hists.root.
+ * @param path Full path of the file
+ * @return Values found in the file
+ */
+AliEmcalPythiaXsecCache::Entry AliEmcalPythiaXsecCache::ReadFile(const TString &path)
+{
+  Entry entry;
+  std::unique_ptr<TFile> fxsec(TFile::Open(path.Data()));
+  if (!fxsec || fxsec->IsZombie()) return entry;
+
+  entry.fType = kUnreadable;
+  TTree *xtree = dynamic_cast<TTree*>(fxsec->Get("Xsection"));
+  if (xtree) {
+    UInt_t   ntrials  = 0;
+    Double_t xsection = 0;
+    xtree->SetBranchAddress("xsection",&xsection);
+    xtree->SetBranchAddress("ntrials",&ntrials);
+    xtree->GetEntry(0);
+    entry.fType = kTree;
+    entry.fHasXsec = kTRUE;
+    entry.fXsec = xsection;
+    entry.fTrials = ntrials;
+    return entry;
+  }
+
+  // find the tlist independently of its name using the first key
+  TKey *key = static_cast<TKey*>(fxsec->GetListOfKeys()->At(0));
+  if (!key) return entry;
+  std::unique_ptr<TList> list(dynamic_cast<TList*>(key->ReadObj()));
+  if (!list) return entry;
+  list->SetOwner(kTRUE);
+  TProfile *xSecHist = dynamic_cast<TProfile*>(list->FindObject("h1Xsec"));
+  TH1 *trialsHist = dynamic_cast<TH1*>(list->FindObject("h1Trials"));
+  if (!xSecHist || !trialsHist) return entry;
+  entry.fType = kHistograms;
+  entry.fHasXsec = xSecHist->GetEntries() > 0;
+  if (entry.fHasXsec) entry.fXsec = xSecHist->GetBinContent(1);
+  entry.fTrials = trialsHist->GetBinContent(1);
+  entry.fNEntriesTrials = trialsHist->GetEntries();
+  return entry;
+}
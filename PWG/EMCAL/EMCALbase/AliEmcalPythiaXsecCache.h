@@ -0,0 +1,80 @@
+#ifndef ALIEMCALPYTHIAXSECCACHE_H
+#define ALIEMCALPYTHIAXSECCACHE_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <map>
+#include <set>
+#include <string>
+#include <TObject.h>
+#include <TString.h>
+
+/**
+ * @class AliEmcalPythiaXsecCache
+ * @brief Process-wide cache of the pythia cross section and trials read from pyxsec files
+ * @ingroup  EMCALCOREFW
+ *
+ * Singleton shared by all the AliAnalysisTaskEmcal wagons and the embedding helper. Each
+ * pyxsec.root / pyxsec_hists.root file is opened once per process; the following requests
+ * for the same path, e.g. from the other wagons at the same file change, are served from
+ * the cache. Files which could not be opened are remembered as well.
+ *
+ * ~~~{.cxx}
+ * AliEmcalPythiaXsecCache *cache = AliEmcalPythiaXsecCache::Instance();
+ * cache->Prefetch(nextDir + "pyxsec_hists.root");   // asynchronous open of the next file
+ * const AliEmcalPythiaXsecCache::Entry &xsec = cache->Get(dir + "pyxsec_hists.root");
+ * if (xsec.fType == AliEmcalPythiaXsecCache::kHistograms) { ... }
+ * ~~~
+ */
+class AliEmcalPythiaXsecCache : public TObject {
+public:
+  /// Content found in the file
+  enum EFileType_t {
+    kNotOpened = 0,   ///< file could not be opened
+    kUnreadable = 1,  ///< file opened, but neither the tree nor the histogram list found
+    kTree = 2,        ///< pyxsec.root with the Xsection tree
+    kHistograms = 3   ///< pyxsec_hists.root with the h1Xsec and h1Trials histograms
+  };
+
+  /// Values read from one file
+  struct Entry {
+    Entry() : fType(kNotOpened), fHasXsec(kFALSE), fXsec(0), fTrials(0), fNEntriesTrials(0) {}
+    EFileType_t fType;            ///< content of the file
+    Bool_t      fHasXsec;         ///< cross section available (tree, or h1Xsec with entries)
+    Double_t    fXsec;            ///< cross section
+    Double_t    fTrials;          ///< number of trials
+    Double_t    fNEntriesTrials;  ///< number of entries of h1Trials (histogram files only)
+  };
+
+  /**
+   * Get the instance shared by all the wagons. If called for the first
+   * time a new object is created
+   * @return Cross section cache
+   */
+  static AliEmcalPythiaXsecCache *Instance();
+
+  virtual ~AliEmcalPythiaXsecCache() {}
+
+  const Entry &Get(const TString &path);
+  void         Prefetch(const TString &path);
+  Bool_t       IsCached(const TString &path) const { return fEntries.find(path.Data()) != fEntries.end(); }
+  void         Clear(Option_t *opt = "");
+
+private:
+  AliEmcalPythiaXsecCache();
+  AliEmcalPythiaXsecCache(const AliEmcalPythiaXsecCache &);
+  AliEmcalPythiaXsecCache &operator=(const AliEmcalPythiaXsecCache &);
+
+  static Entry ReadFile(const TString &path);
+
+  static AliEmcalPythiaXsecCache *fgInstance;  ///< shared instance
+
+  std::map<std::string, Entry>    fEntries;    //!<! values per file path
+  std::set<std::string>           fPrefetched; //!<! paths for which an asynchronous open was requested
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalPythiaXsecCache, 1);
+  /// \endcond
+};
+
+#endif
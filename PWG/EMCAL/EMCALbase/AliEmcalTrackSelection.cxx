@@ -14,7 +14,9 @@
  **************************************************************************/
 #include <TObjArray.h>
 #include <TClonesArray.h>
+#include "AliAnalysisManager.h"
 #include "AliESDtrackCuts.h"
+#include "AliEmcalCutBase.h"
 #include "AliEmcalESDtrackCutsWrapper.h"
 #include "AliEmcalVCutsWrapper.h"
 #include "AliEmcalTrackSelection.h"
@@ -33,7 +35,10 @@ AliEmcalTrackSelection::AliEmcalTrackSelection() :
 	TObject(),
 	fListOfTracks(NULL),
 	fListOfCuts(NULL),
-	fSelectionModeAny(kFALSE)
+	fSelectionModeAny(kFALSE),
+	fSelectionStatus(),
+	fSelectedArray(NULL),
+	fSelectedEntry(-1)
 {
 }
 
@@ -41,7 +46,10 @@ AliEmcalTrackSelection::AliEmcalTrackSelection(const AliEmcalTrackSelection& ref
 	TObject(ref),
 	fListOfTracks(NULL),
 	fListOfCuts(NULL),
-	fSelectionModeAny(kFALSE)
+	fSelectionModeAny(kFALSE),
+	fSelectionStatus(),
+	fSelectedArray(NULL),
+	fSelectedEntry(-1)
 {
 	if(ref.fListOfTracks) fListOfTracks = new TObjArray(*(ref.fListOfTracks));
 	if(ref.fListOfCuts){
@@ -63,6 +71,8 @@ AliEmcalTrackSelection& AliEmcalTrackSelection::operator=(const AliEmcalTrackSel
 		  for(auto cutIter : *(ref.fListOfCuts))
 		    fListOfCuts->Add(new AliEmcalManagedObject(*(static_cast<AliEmcalManagedObject *>(cutIter))));
 		} else fListOfCuts = NULL;
+		fSelectedArray = NULL;
+		fSelectedEntry = -1;
 	}
 	return *this;
 }
@@ -164,6 +174,45 @@ TObjArray* AliEmcalTrackSelection::GetAcceptedTracks(const AliVEvent* const even
   return fListOfTracks;
 }
 
+const std::vector<AliEmcalTrackSelection::SelectionStatus> &AliEmcalTrackSelection::SelectTracks(const TClonesArray* const tracks)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (tracks == fSelectedArray && entry == fSelectedEntry && entry >= 0) return fSelectionStatus;
+
+  fSelectionStatus.resize(tracks->GetEntriesFast());
+  for (Int_t itrk = 0; itrk < tracks->GetEntriesFast(); itrk++) {
+    fSelectionStatus[itrk] = IsTrackAcceptedValue(static_cast<AliVTrack *>(tracks->UncheckedAt(itrk)));
+  }
+  fSelectedArray = tracks;
+  fSelectedEntry = entry;
+  return fSelectionStatus;
+}
+
+AliEmcalTrackSelection::SelectionStatus AliEmcalTrackSelection::IsTrackAcceptedValue(AliVTrack* const trk)
+{
+  SelectionStatus result;
+  result.fTrack = trk ? GetSelectableTrack(trk) : NULL;
+  if (!result.fTrack) return result;
+
+  Int_t ncuts(0), nselected(0);
+  if (fListOfCuts) {
+    for (auto cutIter : *fListOfCuts) {
+      PWG::EMCAL::AliEmcalCutBase *trackCuts = static_cast<PWG::EMCAL::AliEmcalCutBase*>(static_cast<AliEmcalManagedObject *>(cutIter)->GetObject());
+      Int_t hybridtype(0);
+      if (trackCuts->IsSelectedValue(result.fTrack, hybridtype)) {
+        if (ncuts < 64) result.fCutBits |= (ULong64_t(1) << ncuts);
+        if (hybridtype) result.fHybridType = hybridtype;
+        nselected++;
+      }
+      ncuts++;
+    }
+  }
+  // In case of ANY at least one cut has to be passed, while in case of ALL all cuts have to be passed
+  result.fSelected = fSelectionModeAny ? (nselected > 0 || ncuts == 0) : (nselected == ncuts);
+  return result;
+}
+
 AliEmcalManagedObject::AliEmcalManagedObject():
     TObject(),
     fOwner(false),
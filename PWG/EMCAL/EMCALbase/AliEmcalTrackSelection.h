@@ -3,6 +3,7 @@
 /* Copyright(c) 1998-2015, ALICE Experiment at CERN, All rights reserved. *
  * See cxx source for full Copyright notice                               */
 
+#include <vector>
 #include <TObject.h>
 #include <TBits.h>
 #include "AliEmcalTrackSelResultPtr.h"
@@ -143,10 +144,33 @@ private:
  * - GenerateTrackCuts
  *
  * The usage of the virtual track selection is described here: \subpage VirtualTrackSelection
+ *
+ * For the selection of all tracks of an event, SelectTracks provides the results as a vector
+ * of SelectionStatus values (cut bitmap, combined decision, hybrid track type) instead of one
+ * AliEmcalTrackSelResultPtr with user objects per track. The pass is done once per event and
+ * input array; further calls within the same event return the stored results.
  */
 class AliEmcalTrackSelection : public TObject {
 public:
 
+  /**
+   * @struct SelectionStatus
+   * @brief Selection result of a track as plain value
+   *
+   * Bit i of the cut bitmap is set if cut object i selected the track (up to 64 cut objects),
+   * fSelected is the combined result in the ANY / ALL mode. The hybrid track type
+   * (AliEmcalTrackSelResultHybrid::HybridType_t) is the one provided by the cuts which
+   * selected the track. fTrack is the track the cuts were applied to (the underlying
+   * AOD / ESD track for pico tracks), nullptr if the track type is not supported.
+   */
+  struct SelectionStatus {
+    SelectionStatus(): fTrack(nullptr), fCutBits(0), fHybridType(0), fSelected(kFALSE) {}
+    AliVTrack  *fTrack;        ///< Track processed by the cuts
+    ULong64_t   fCutBits;      ///< Bitmap of the cuts selecting the track
+    Int_t       fHybridType;   ///< Hybrid track type
+    Bool_t      fSelected;     ///< Combined selection result
+  };
+
   /**
    * @enum ETrackFilterType_t
    * @brief Pre-defined track filters
@@ -226,6 +250,29 @@ public:
 	 */
 	TObjArray *GetAcceptedTracks(const AliVEvent *const event);
 
+	/**
+	 * @brief Select all tracks of an input array, results as plain values
+	 *
+	 * Running the cuts for all tracks in the input array via IsSelectedValue of
+	 * the cut objects, without creating result or user objects. The results are
+	 * stored per event and array: for the same array within the same event (entry
+	 * of the analysis manager) the stored results are returned without running
+	 * the cuts again. Index i of the result corresponds to index i of the array.
+	 *
+	 * @param[in] tracks TClonesArray of tracks (must not be null)
+	 * @return Selection status of all tracks in the array
+	 */
+	const std::vector<SelectionStatus> &SelectTracks(const TClonesArray * const tracks);
+
+	/**
+	 * @brief Selection of a single track, result as plain value
+	 *
+	 * Same decision as IsTrackAccepted, without creating result or user objects.
+	 * @param[in] trk Track to be checked
+	 * @return Selection status of the track
+	 */
+	SelectionStatus IsTrackAcceptedValue(AliVTrack * const trk);
+
 	/**
 	 * @brief Interface for track selection code
 	 *
@@ -321,9 +368,23 @@ public:
 	virtual void SaveQAObjects(TList *outputList) {}
 
 protected:
+
+	/**
+	 * @brief Get the track on which the cuts operate
+	 *
+	 * Resolves pico tracks to the underlying AOD / ESD track. To be
+	 * implemented by the child classes.
+	 * @param[in] trk Input track
+	 * @return Track to be checked by the cuts, nullptr if not supported
+	 */
+	virtual AliVTrack *GetSelectableTrack(AliVTrack * const trk) const = 0;
+
 	TObjArray    *fListOfTracks;         ///< TObjArray with accepted tracks
 	TObjArray    *fListOfCuts;           ///< List of track cut objects
 	Bool_t        fSelectionModeAny;     ///< Accept track if any of the cuts is fulfilled
+	std::vector<SelectionStatus> fSelectionStatus; //!<! Results of SelectTracks for the current event
+	const TClonesArray *fSelectedArray;  //!<! Array for which fSelectionStatus was obtained
+	Long64_t      fSelectedEntry;        //!<! Analysis manager entry for which fSelectionStatus was obtained
 
 	/// \cond CLASSIMP
 
@@ -144,7 +144,7 @@ void AliEmcalTrackSelectionAOD::GenerateTrackCuts(ETrackFilterType_t type, const
   }
 }
 
-PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionAOD::IsTrackAccepted(AliVTrack * const trk)
+AliVTrack *AliEmcalTrackSelectionAOD::GetSelectableTrack(AliVTrack * const trk) const
 {
   AliAODTrack *aodt = dynamic_cast<AliAODTrack*>(trk);
   if (!aodt){
@@ -154,13 +154,20 @@ PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionAOD::IsTrackAccepted
     }
     else {
       AliError("Track neither AOD track nor pico track");
-      return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+      return nullptr;
     }
   }
   if(!aodt){
     AliError("Failed getting AOD track");
-    return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+    return nullptr;
   }
+  return aodt;
+}
+
+PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionAOD::IsTrackAccepted(AliVTrack * const trk)
+{
+  AliAODTrack *aodt = static_cast<AliAODTrack *>(GetSelectableTrack(trk));
+  if(!aodt) return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
 
   TBits trackbitmap(64);
   trackbitmap.ResetAllBits();
@@ -283,7 +290,7 @@ void TestAliEmcalTrackSelectionAOD::Init() {
 }
 
 bool TestAliEmcalTrackSelectionAOD::RunAllTests() const {
- return TestHybridDef2010wRefit() && TestHybridDef2010woRefit() && TestHybridDef2011() && TestTPConly();
+ return TestHybridDef2010wRefit() && TestHybridDef2010woRefit() && TestHybridDef2011() && TestTPConly() && TestSelectionValue();
 }
 
 bool TestAliEmcalTrackSelectionAOD::TestHybridDef2010wRefit() const {
@@ -496,6 +503,45 @@ bool TestAliEmcalTrackSelectionAOD::TestTPConly() const {
   return nfailure == 0;
 }
 
+bool TestAliEmcalTrackSelectionAOD::TestSelectionValue() const {
+  AliInfoStream() << "Running test for selection results as values" << std::endl;
+  AliAODTrack testCat1, testCat2WithRefit, testCat2WithoutRefit, testNoHybrid, testTPConly;
+  testCat1.SetIsHybridGlobalConstrainedGlobal();
+  testCat2WithRefit.SetIsHybridGlobalConstrainedGlobal();
+  testCat2WithoutRefit.SetIsHybridGlobalConstrainedGlobal();
+  testCat1.SetStatus(AliVTrack::kITSrefit);
+  testCat2WithRefit.SetStatus(AliVTrack::kITSrefit);
+  testCat1.SetFilterMap(BIT(8));
+  testCat2WithRefit.SetFilterMap(BIT(4));
+  testCat2WithoutRefit.SetFilterMap(BIT(4));
+  testTPConly.SetIsHybridTPCConstrainedGlobal(true);
+
+  AliAODTrack *testtracks[5] = {&testCat1, &testCat2WithRefit, &testCat2WithoutRefit, &testNoHybrid, &testTPConly};
+  AliEmcalTrackSelectionAOD *selections[3] = {fTrackSelHybrid2010wRefit, fTrackSelHybrid2010woRefit, fTrackSelTPConly};
+  int nfailure = 0;
+  for(auto sel : selections) {
+    for(auto trk : testtracks) {
+      auto resultptr = sel->IsTrackAccepted(trk);
+      auto resultvalue = sel->IsTrackAcceptedValue(trk);
+      if(bool(resultptr) != bool(resultvalue.fSelected)) {
+        AliErrorStream() << "Selection status differs between result pointer and result value" << std::endl;
+        nfailure++;
+      }
+      if(resultvalue.fTrack != trk) {
+        AliErrorStream() << "Track not set in result value" << std::endl;
+        nfailure++;
+      }
+      auto hybridcat = FindHybridSelectionResult(resultptr);
+      int hybridtype = hybridcat ? hybridcat->GetHybridTrackType() : AliEmcalTrackSelResultHybrid::kUndefined;
+      if(hybridtype != resultvalue.fHybridType) {
+        AliErrorStream() << "Hybrid track type differs between result pointer (" << hybridtype << ") and result value (" << resultvalue.fHybridType << ")" << std::endl;
+        nfailure++;
+      }
+    }
+  }
+  return nfailure == 0;
+}
+
 const AliEmcalTrackSelResultHybrid *TestAliEmcalTrackSelectionAOD::FindHybridSelectionResult(const AliEmcalTrackSelResultPtr &data) const {
   if(!data.GetUserInfo()) return nullptr;
   if(auto hybridinfo = dynamic_cast<const AliEmcalTrackSelResultHybrid *>(data.GetUserInfo())) return hybridinfo;
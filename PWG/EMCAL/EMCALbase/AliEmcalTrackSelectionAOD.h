@@ -121,6 +121,15 @@ public:
 	 */
 	static Bool_t GetHybridFilterBits(Char_t bits[], TString period);
 
+protected:
+
+	/**
+	 * @brief Get the AOD track on which the cuts operate
+	 * @param[in] trk AOD track or pico track
+	 * @return AOD track (underlying AOD track for pico tracks), nullptr if not available
+	 */
+	virtual AliVTrack *GetSelectableTrack(AliVTrack * const trk) const;
+
 private:
 
 	/// \cond CLASSIMP
@@ -172,6 +181,7 @@ public:
 	bool TestHybridDef2010woRefit() const;
 	bool TestHybridDef2011() const;
 	bool TestTPConly() const;
+	bool TestSelectionValue() const;
 
 private:
 	/**
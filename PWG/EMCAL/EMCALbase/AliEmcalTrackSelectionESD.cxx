@@ -120,10 +120,10 @@ void AliEmcalTrackSelectionESD::GenerateTrackCuts(ETrackFilterType_t type, const
   }
 }
 
-PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionESD::IsTrackAccepted(AliVTrack* const trk) {
+AliVTrack *AliEmcalTrackSelectionESD::GetSelectableTrack(AliVTrack* const trk) const {
   if (!fListOfCuts){
     AliDebugStream(2) << "No cut array " << std::endl;
-    return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+    return nullptr;
   } 
   AliESDtrack *esdt = dynamic_cast<AliESDtrack *>(trk);
   if (!esdt) {
@@ -133,9 +133,19 @@ PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionESD::IsTrackAccepted
     }
     else {
       AliError("Neither Pico nor ESD track");
-      return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+      return nullptr;
     }
   }
+  return esdt;
+}
+
+PWG::EMCAL::AliEmcalTrackSelResultPtr AliEmcalTrackSelectionESD::IsTrackAccepted(AliVTrack* const trk) {
+  if (!fListOfCuts){
+    AliDebugStream(2) << "No cut array " << std::endl;
+    return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
+  } 
+  AliESDtrack *esdt = static_cast<AliESDtrack *>(GetSelectableTrack(trk));
+  if (!esdt) return PWG::EMCAL::AliEmcalTrackSelResultPtr(nullptr, kFALSE);
 
   TBits trackbitmap(64);
   trackbitmap.ResetAllBits();
@@ -93,6 +93,15 @@ public:
 
   virtual void SaveQAObjects(TList *outputList);
 
+protected:
+
+	/**
+	 * @brief Get the ESD track on which the cuts operate
+	 * @param[in] trk ESD track or pico track
+	 * @return ESD track (underlying ESD track for pico tracks), nullptr if not available or no cuts are defined
+	 */
+	virtual AliVTrack *GetSelectableTrack(AliVTrack * const trk) const;
+
 	/// \cond CLASSIMP
 	ClassDef(AliEmcalTrackSelectionESD,1);
 	/// \endcond
@@ -27,6 +27,7 @@
 #include "AliVCuts.h"
 #include "AliVTrack.h"
 #include "AliEmcalVCutsWrapper.h"
+#include "AliEmcalTrackSelResultHybrid.h"
 
 ClassImp(PWG::EMCAL::AliEmcalVCutsWrapper)
 
@@ -52,4 +53,9 @@ AliEmcalVCutsWrapper::~AliEmcalVCutsWrapper(){
 
 AliEmcalTrackSelResultPtr AliEmcalVCutsWrapper::IsSelected(TObject *o) {
   return AliEmcalTrackSelResultPtr(dynamic_cast<AliVTrack *>(o), fCutObject->IsSelected(o), nullptr);
+}
+
+Bool_t AliEmcalVCutsWrapper::IsSelectedValue(TObject *o, Int_t &hybridtype) {
+  hybridtype = AliEmcalTrackSelResultHybrid::kUndefined;
+  return fCutObject->IsSelected(o);
 }
\ No newline at end of file
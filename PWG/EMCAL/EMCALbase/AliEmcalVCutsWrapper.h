@@ -48,6 +48,7 @@ public:
   virtual ~AliEmcalVCutsWrapper();
 
   AliEmcalTrackSelResultPtr IsSelected(TObject *o);
+  Bool_t IsSelectedValue(TObject *o, Int_t &hybridtype);
   AliVCuts *GetCutObject() const { return fCutObject; }
 
 private:
@@ -10,6 +10,7 @@
 
 #include "AliTLorentzVector.h"
 #include "AliMCParticleContainer.h"
+#include "AliParticleContainerCache.h"
 
 /// \cond CLASSIMP
 ClassImp(AliMCParticleContainer);
@@ -84,6 +85,9 @@ AliAODMCParticle* AliMCParticleContainer::GetAcceptMCParticle(Int_t i) const
 
   UInt_t rejectionReason = 0;
   if (i == -1) i = fCurrentID;
+  if (fUseCache) {
+    return GetAcceptedCache().IsAccepted(i) ? GetMCParticle(i) : 0;
+  }
   if (AcceptMCParticle(i, rejectionReason)) {
       return GetMCParticle(i);
   }
@@ -22,6 +22,7 @@
 
 #include "AliTLorentzVector.h"
 #include "AliParticleContainer.h"
+#include "AliParticleContainerCache.h"
 
 /// \cond CLASSIMP
 ClassImp(AliParticleContainer);
@@ -37,7 +38,9 @@ AliParticleContainer::AliParticleContainer():
   AliEmcalContainer(),
   fMinDistanceTPCSectorEdge(-1),
   fChargeCut(kNoChargeCut),
-  fGeneratorIndex(-1)
+  fGeneratorIndex(-1),
+  fUseCache(kFALSE),
+  fCache(0)
 {
   fBaseClassName = "AliVParticle";
   SetClassName("AliVParticle");
@@ -51,12 +54,22 @@ AliParticleContainer::AliParticleContainer(const char *name) :
   AliEmcalContainer(name),
   fMinDistanceTPCSectorEdge(-1),
   fChargeCut(kNoChargeCut),
-  fGeneratorIndex(-1)
+  fGeneratorIndex(-1),
+  fUseCache(kFALSE),
+  fCache(0)
 {
   fBaseClassName = "AliVParticle";
   SetClassName("AliVParticle");
 }
 
+/**
+ * Destructor, deleting the per-event cache.
+ */
+AliParticleContainer::~AliParticleContainer()
+{
+  delete fCache;
+}
+
 /**
  * Get the leading particle in the container. If "p" is contained in the parameter opt,
  * then the absolute momentum is use instead of the transverse momentum.
@@ -114,6 +127,9 @@ AliVParticle* AliParticleContainer::GetAcceptParticle(Int_t i) const
 {
   UInt_t rejectionReason = 0;
   if (i == -1) i = fCurrentID;
+  if (fUseCache) {
+    return GetAcceptedCache().IsAccepted(i) ? GetParticle(i) : 0;
+  }
   if (AcceptParticle(i, rejectionReason)) {
       return GetParticle(i);
   }
@@ -418,6 +434,8 @@ Bool_t AliParticleContainer::ApplyKinematicCuts(const AliTLorentzVector& mom, UI
  */
 Int_t AliParticleContainer::GetNAcceptedParticles() const
 {
+  if (fUseCache) return GetAcceptedCache().GetEntries();
+
   Int_t nPart = 0;
   for(int ipart = 0; ipart < this->GetNParticles(); ipart++){
     UInt_t rejectionReason = 0;
@@ -454,6 +472,65 @@ void AliParticleContainer::SetArray(const AliVEvent * event)
   fgEmcalContainerIndexMap.RegisterArray(GetArray());
 }
 
+/**
+ * Preparation for the next event: Invalidate the cache of
+ * accepted particles. The cache is rebuilt on first access.
+ * @param[in] event The event to be processed.
+ */
+void AliParticleContainer::NextEvent(const AliVEvent *event)
+{
+  AliEmcalContainer::NextEvent(event);
+
+  if (fCache) fCache->SetValid(kFALSE);
+}
+
+/**
+ * Get the cache of accepted particles for the current event. The
+ * cache is built on the first call after NextEvent, evaluating the
+ * particle selection once for each particle in the container.
+ * @return Cache of accepted particles
+ */
+const AliParticleContainerCache &AliParticleContainer::GetAcceptedCache() const
+{
+  if (!fCache) fCache = new AliParticleContainerCache;
+  if (!fCache->IsValid()) {
+    FillCache(*fCache);
+    fCache->SetValid(kTRUE);
+  }
+  return *fCache;
+}
+
+/**
+ * Fill the cache with all particles accepted under the
+ * particle selection.
+ * @param[out] cache Cache to be filled
+ */
+void AliParticleContainer::FillCache(AliParticleContainerCache &cache) const
+{
+  const Int_t n = GetNEntries();
+  cache.Reset(n);
+  for (Int_t ipart = 0; ipart < n; ipart++) {
+    UInt_t rejectionReason = 0;
+    if (!AcceptParticle(ipart, rejectionReason)) continue;
+    AliVParticle *part = GetParticle(ipart);
+    cache.Add(ipart, part->Pt(), part->Eta(), part->Phi(), part->Charge(), part->GetLabel(), GetCacheSelectionBits(ipart));
+  }
+}
+
+/**
+ * Provide the accepted indices from the per-event cache to the
+ * iterable containers in case the cache is enabled.
+ * @param[out] indices Indices of the accepted particles
+ * @return True if the cache is enabled
+ */
+Bool_t AliParticleContainer::GetCachedAcceptIndices(TArrayI &indices) const
+{
+  if (!fUseCache) return kFALSE;
+  const AliParticleContainerCache &cache = GetAcceptedCache();
+  indices.Set(cache.GetEntries(), cache.GetIndices());
+  return kTRUE;
+}
+
 /**
  * Create an iterable container interface over all objects in the
  * EMCAL container.
@@ -8,6 +8,7 @@
 
 class AliVEvent;
 class AliTLorentzVector;
+class AliParticleContainerCache;
 
 #include "AliEmcalContainer.h"
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -34,7 +35,7 @@ class AliParticleContainer : public AliEmcalContainer {
 
   AliParticleContainer();
   AliParticleContainer(const char *name);
-  virtual ~AliParticleContainer(){;}
+  virtual ~AliParticleContainer();
 
   /**
    * Index operator: Providing access to track in the container with the
@@ -76,6 +77,19 @@ class AliParticleContainer : public AliEmcalContainer {
   void                        SelectHIJING(Bool_t s)                            { if (s) fGeneratorIndex = 0; else fGeneratorIndex = -1; }
   void                        SetGeneratorIndex(Short_t i)                      { fGeneratorIndex = i  ; }
   void                        SetArray(const AliVEvent * event);
+  virtual void                NextEvent(const AliVEvent *event);
+
+  /**
+   * Switch on the per-event cache of accepted particles. When enabled, the
+   * particle selection is evaluated only once per event; GetAcceptParticle,
+   * GetNAcceptedParticles and the accepted iterators use the cached result.
+   * Note: Cuts must not be changed after the first access within an event.
+   * @param[in] b If true the cache is used
+   */
+  void                        SetUseCache(Bool_t b = kTRUE)                     { fUseCache = b        ; }
+  Bool_t                      GetUseCache()                             const   { return fUseCache     ; }
+  const AliParticleContainerCache &GetAcceptedCache()                   const;
+  virtual Bool_t              GetCachedAcceptIndices(TArrayI &indices)  const;
 
   const char*                 GetTitle() const;
 
@@ -91,6 +105,13 @@ class AliParticleContainer : public AliEmcalContainer {
 #endif
 
  protected:
+  virtual void                FillCache(AliParticleContainerCache &cache) const;
+  /**
+   * Selection bits stored in the cache for the particle with the given index.
+   * @param[in] i Index of the particle in the container
+   * @return Selection bits (0 for generic particles)
+   */
+  virtual UInt_t              GetCacheSelectionBits(Int_t i)            const   { return 0; }
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   static AliEmcalContainerIndexMap <TClonesArray, AliVParticle> fgEmcalContainerIndexMap; //!<! Mapping from containers to indices
@@ -99,13 +120,15 @@ class AliParticleContainer : public AliEmcalContainer {
   Double_t                    fMinDistanceTPCSectorEdge;      ///< require minimum distance to edge of TPC sector edge
   EChargeCut_t                fChargeCut;                     ///< select particles according to their charge
   Short_t                     fGeneratorIndex;                ///< select MC particles with generator index (default = -1 = switch off selection)
+  Bool_t                      fUseCache;                      ///< use per-event cache of accepted particles
+  mutable AliParticleContainerCache *fCache;                  //!<! per-event cache of accepted particles
 
  private:
   AliParticleContainer(const AliParticleContainer& obj); // copy constructor
   AliParticleContainer& operator=(const AliParticleContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliParticleContainer,11);
+  ClassDef(AliParticleContainer,12);
   /// \endcond
 
 };
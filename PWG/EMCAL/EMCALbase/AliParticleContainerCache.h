@@ -0,0 +1,99 @@
+#ifndef ALIPARTICLECONTAINERCACHE_H
+#define ALIPARTICLECONTAINERCACHE_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <Rtypes.h>
+
+/**
+ * @class AliParticleContainerCache
+ * @brief Per-event structure-of-arrays cache of accepted particles
+ * @ingroup EMCALCOREFW
+ *
+ * Stores the kinematics and selection information of the particles accepted
+ * by an AliParticleContainer in contiguous arrays. The cache is built once per
+ * event (on first request after AliParticleContainer::NextEvent) so that the
+ * particle selection is not re-evaluated by each consumer, and loops over the
+ * packed arrays can be vectorized by the compiler:
+ *
+ * ~~~{.cxx}
+ * const AliParticleContainerCache &cache = cont->GetAcceptedCache();
+ * const Float_t *pt = cache.GetPt();
+ * Double_t sumpt = 0;
+ * for(Int_t ipart = 0; ipart < cache.GetEntries(); ipart++) sumpt += pt[ipart];
+ * ~~~
+ *
+ * The entries are ordered according to the index of the particle in
+ * the container, which is available via GetIndex(). The selection bits
+ * contain the track type (1 << AliTrackContainer::ETrackType_t) for
+ * track containers and are 0 otherwise.
+ */
+class AliParticleContainerCache {
+public:
+  AliParticleContainerCache(): fPt(), fEta(), fPhi(), fCharge(), fLabel(), fSelectionBits(), fIndex(), fAccepted(), fValid(kFALSE) {}
+  ~AliParticleContainerCache() {}
+
+  /**
+   * @brief Remove all entries and mark the cache as out of date.
+   *
+   * The memory of the arrays is kept for the next event.
+   * @param[in] nentries Number of entries in the container for the next fill
+   */
+  void Reset(Int_t nentries) {
+    fPt.clear(); fEta.clear(); fPhi.clear(); fCharge.clear();
+    fLabel.clear(); fSelectionBits.clear(); fIndex.clear();
+    fAccepted.assign(nentries > 0 ? nentries : 0, 0);
+    fValid = kFALSE;
+  }
+
+  /**
+   * @brief Add an accepted particle at the end of the cache.
+   */
+  void Add(Int_t index, Float_t pt, Float_t eta, Float_t phi, Short_t charge, Int_t label, UInt_t selectionBits) {
+    fPt.push_back(pt); fEta.push_back(eta); fPhi.push_back(phi); fCharge.push_back(charge);
+    fLabel.push_back(label); fSelectionBits.push_back(selectionBits); fIndex.push_back(index);
+    if(index >= 0 && index < static_cast<Int_t>(fAccepted.size())) fAccepted[index] = 1;
+  }
+
+  void SetValid(Bool_t valid = kTRUE) { fValid = valid; }
+  Bool_t IsValid() const { return fValid; }
+
+  Int_t GetEntries() const { return fIndex.size(); }
+
+  /**
+   * @brief Check whether the particle with the given index in the container is accepted.
+   * @param[in] index Index of the particle in the container
+   * @return True if the particle is accepted
+   */
+  Bool_t IsAccepted(Int_t index) const { return index >= 0 && index < static_cast<Int_t>(fAccepted.size()) && fAccepted[index]; }
+
+  const Float_t *GetPt() const { return fPt.empty() ? 0 : &fPt[0]; }
+  const Float_t *GetEta() const { return fEta.empty() ? 0 : &fEta[0]; }
+  const Float_t *GetPhi() const { return fPhi.empty() ? 0 : &fPhi[0]; }
+  const Short_t *GetCharge() const { return fCharge.empty() ? 0 : &fCharge[0]; }
+  const Int_t *GetLabel() const { return fLabel.empty() ? 0 : &fLabel[0]; }
+  const UInt_t *GetSelectionBits() const { return fSelectionBits.empty() ? 0 : &fSelectionBits[0]; }
+  const Int_t *GetIndices() const { return fIndex.empty() ? 0 : &fIndex[0]; }
+
+  Float_t GetPt(Int_t i) const { return fPt[i]; }
+  Float_t GetEta(Int_t i) const { return fEta[i]; }
+  Float_t GetPhi(Int_t i) const { return fPhi[i]; }
+  Short_t GetCharge(Int_t i) const { return fCharge[i]; }
+  Int_t GetLabel(Int_t i) const { return fLabel[i]; }
+  UInt_t GetSelectionBits(Int_t i) const { return fSelectionBits[i]; }
+  Int_t GetIndex(Int_t i) const { return fIndex[i]; }
+
+private:
+  std::vector<Float_t>            fPt;                  ///< Transverse momentum
+  std::vector<Float_t>            fEta;                 ///< Pseudorapidity
+  std::vector<Float_t>            fPhi;                 ///< Azimuthal angle
+  std::vector<Short_t>            fCharge;              ///< Charge
+  std::vector<Int_t>              fLabel;               ///< MC label
+  std::vector<UInt_t>             fSelectionBits;       ///< Selection bits (track type for tracks)
+  std::vector<Int_t>              fIndex;               ///< Index of the particle in the container
+  std::vector<UChar_t>            fAccepted;            ///< Acceptance flag per container index
+  Bool_t                          fValid;               ///< Cache up to date for the current event
+};
+
+#endif
@@ -26,6 +26,8 @@
  ************************************************************************************/
 #include <bitset>
 #include <iostream>
+#include <map>
+#include <string>
 #include <TClonesArray.h>
 
 #include "AliAODEvent.h"
@@ -41,6 +43,7 @@
 #include "AliEmcalTrackSelResultPtr.h"
 #include "AliEmcalTrackSelResultCombined.h"
 #include "AliEmcalTrackSelResultHybrid.h"
+#include "AliParticleContainerCache.h"
 #include "AliTrackContainer.h"
 
 /// \cond CLASSIMP
@@ -49,6 +52,14 @@ ClassImp(AliTrackContainer);
 
 TString AliTrackContainer::fgDefTrackCutsPeriod = "";
 
+namespace {
+  /// Track selections of the predefined filter types, shared among the track containers (never deleted)
+  std::map<std::string, AliEmcalTrackSelection *> &SharedTrackSelections() {
+    static std::map<std::string, AliEmcalTrackSelection *> selections;
+    return selections;
+  }
+}
+
 /**
  * Default constructor.
  */
@@ -61,6 +72,8 @@ AliTrackContainer::AliTrackContainer():
   fAODFilterBits(0),
   fTrackCutsPeriod(),
   fEmcalTrackSelection(0),
+  fShareTrackSelection(kTRUE),
+  fSharedTrackSelection(kFALSE),
   fFilteredTracks(),
   fTrackTypes(5000)
 {
@@ -83,6 +96,8 @@ AliTrackContainer::AliTrackContainer(const char *name, const char *period):
   fAODFilterBits(0),
   fTrackCutsPeriod(period),
   fEmcalTrackSelection(0),
+  fShareTrackSelection(kTRUE),
+  fSharedTrackSelection(kFALSE),
   fFilteredTracks(),
   fTrackTypes(5000)
 {
@@ -107,8 +122,9 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
   AliParticleContainer::SetArray(event);
 
   if (fTrackFilterType == AliEmcalTrackSelection::kNoTrackFilter) {
-    if (fEmcalTrackSelection) delete fEmcalTrackSelection;
+    if (fEmcalTrackSelection && !fSharedTrackSelection) delete fEmcalTrackSelection;
     fEmcalTrackSelection = 0;
+    fSharedTrackSelection = kFALSE;
   }
   else {
     if (fTrackFilterType == AliEmcalTrackSelection::kCustomTrackFilter) {
@@ -148,6 +164,21 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
         AliInfo(Form("Using track cuts %d (no data period was provided!)", fTrackFilterType));
       }
 
+      // Containers with the same predefined filter type and period run the same cuts:
+      // they share the selection object, and with it the per-event selection results
+      std::string sharedkey;
+      if (fLoadedClass->InheritsFrom("AliAODTrack")) sharedkey = Form("AOD_%d_%s", fTrackFilterType, fTrackCutsPeriod.Data());
+      else if (fLoadedClass->InheritsFrom("AliESDtrack")) sharedkey = Form("ESD_%d_%s", fTrackFilterType, fTrackCutsPeriod.Data());
+      if (fShareTrackSelection && sharedkey.length()) {
+        auto found = SharedTrackSelections().find(sharedkey);
+        if (found != SharedTrackSelections().end()) {
+          AliInfo(Form("Objects are of type %s: using track selection shared with other containers.", fLoadedClass->GetName()));
+          fEmcalTrackSelection = found->second;
+          fSharedTrackSelection = kTRUE;
+          return;
+        }
+      }
+
       if (fLoadedClass->InheritsFrom("AliAODTrack")) {
         AliInfo(Form("Objects are of type %s: AOD track selection will be done.", fLoadedClass->GetName()));
         fEmcalTrackSelection = new AliEmcalTrackSelectionAOD(fTrackFilterType, fTrackCutsPeriod);
@@ -159,6 +190,10 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
       else {
         AliWarning(Form("Objects are of type %s: no track filtering will be done!!", fLoadedClass->GetName()));
       }
+      if (fShareTrackSelection && fEmcalTrackSelection) {
+        SharedTrackSelections()[sharedkey] = fEmcalTrackSelection;
+        fSharedTrackSelection = kTRUE;
+      }
     }
   }
 }
@@ -174,7 +209,7 @@ void AliTrackContainer::NextEvent(const AliVEvent * event)
 
   fTrackTypes.Reset(kUndefined);
   if (fEmcalTrackSelection) {
-    auto acceptedTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
+    const std::vector<AliEmcalTrackSelection::SelectionStatus> &acceptedTracks = fEmcalTrackSelection->SelectTracks(fClArray);
 
     TObjArray *trackarray(fFilteredTracks.GetData());
     if(!trackarray){
@@ -188,12 +223,11 @@ void AliTrackContainer::NextEvent(const AliVEvent * event)
 
     int naccepted(0), nrejected(0), nhybridTracks1(0), nhybridTracks2(0), nhybridTracks3(0);
     Int_t i = 0;
-    for(auto accresult : *acceptedTracks) {
+    for(const auto &selectionResult : acceptedTracks) {
       if (i >= fTrackTypes.GetSize()) fTrackTypes.Set((i+1)*2);
-      PWG::EMCAL::AliEmcalTrackSelResultPtr *selectionResult = static_cast<PWG::EMCAL::AliEmcalTrackSelResultPtr *>(accresult);
-      AliVTrack *vTrack = selectionResult->GetTrack();
+      AliVTrack *vTrack = selectionResult.fTrack;
       trackarray->AddLast(vTrack);
-      if (!(*selectionResult) || !vTrack) {
+      if (!selectionResult.fSelected || !vTrack) {
         nrejected++;
         fTrackTypes[i] = kRejected;
       }
@@ -201,7 +235,7 @@ void AliTrackContainer::NextEvent(const AliVEvent * event)
         // track is accepted;
         naccepted++;
         if (IsHybridTrackSelection()) {
-          switch(GetHybridDefinition(*selectionResult)) {
+          switch(selectionResult.fHybridType) {
             case PWG::EMCAL::AliEmcalTrackSelResultHybrid::kHybridGlobal:
               fTrackTypes[i] = kHybridGlobal;
               nhybridTracks1++;
@@ -253,6 +287,9 @@ AliVTrack* AliTrackContainer::GetAcceptTrack(Int_t i) const
 {
   UInt_t rejectionReason;
   if (i == -1) i = fCurrentID;
+  if (fUseCache) {
+    return GetAcceptedCache().IsAccepted(i) ? GetTrack(i) : 0;
+  }
   if (AcceptTrack(i, rejectionReason)) {
       return GetTrack(i);
   }
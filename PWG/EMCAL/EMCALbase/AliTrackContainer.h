@@ -141,6 +141,7 @@ class AliTrackContainer : public AliParticleContainer {
   void                        SetTrackFilterType(ETrackFilterType_t f)          { fTrackFilterType = f; }
   void                        SetFilterHybridTracks(Bool_t f)                   { if (f) fTrackFilterType = AliEmcalTrackSelection::kHybridTracks; else fTrackFilterType = AliEmcalTrackSelection::kNoTrackFilter; }   // legacy method
   void                        SetITSHybridTrackDistinction(Bool_t doUse)        { fITSHybridTrackDistinction = doUse; }
+  void                        SetShareTrackSelection(Bool_t doShare)            { fShareTrackSelection = doShare; }
 
   void                        SetTrackCutsPeriod(const char* period)            { fTrackCutsPeriod = period; }
   void                        AddTrackCuts(AliVCuts *cuts);
@@ -187,6 +188,14 @@ class AliTrackContainer : public AliParticleContainer {
    */
   virtual TString             GetDefaultArrayName(const AliVEvent * const ev) const;
 
+  /**
+   * Selection bits stored in the cache: bit corresponding to the hybrid
+   * track type in case of hybrid track selection, 0 otherwise.
+   * @param[in] i Index of the track in the container
+   * @return Selection bits
+   */
+  virtual UInt_t              GetCacheSelectionBits(Int_t i) const { Char_t type = GetTrackType(i); return (IsHybridTrackSelection() && type != (Char_t)kRejected) ? (1u << type) : 0; }
+
   PWG::EMCAL::AliEmcalTrackSelResultHybrid::HybridType_t  GetHybridDefinition(const PWG::EMCAL::AliEmcalTrackSelResultPtr &selectionResult) const;
 
   static TString              fgDefTrackCutsPeriod;           //!<! default period string used to generate track cuts
@@ -198,6 +207,8 @@ class AliTrackContainer : public AliParticleContainer {
   UInt_t                      fAODFilterBits;                 ///< track filter bits
   TString                     fTrackCutsPeriod;               ///< period string used to generate track cuts
   AliEmcalTrackSelection     *fEmcalTrackSelection;           //!<! track selection object
+  Bool_t                      fShareTrackSelection;           ///< share the track selection of predefined filter types with other containers
+  Bool_t                      fSharedTrackSelection;          //!<! fEmcalTrackSelection is shared (not owned by the container)
   TrackOwnerHandler           fFilteredTracks;                //!<! tracks filtered using fEmcalTrackSelection
   TArrayC                     fTrackTypes;                    //!<! track types
 
@@ -206,7 +217,7 @@ class AliTrackContainer : public AliParticleContainer {
   AliTrackContainer& operator=(const AliTrackContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliTrackContainer,1);
+  ClassDef(AliTrackContainer,2);
   /// \endcond
 };
 
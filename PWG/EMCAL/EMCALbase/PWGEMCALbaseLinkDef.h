@@ -12,6 +12,8 @@
 #pragma link C++ class AliEmcalContainer+;
 #pragma link C++ class AliEmcalContainerUtils+;
 #pragma link C++ class AliEmcalDownscaleFactorsOCDB+;
+#pragma link C++ class AliEmcalEventInfo+;
+#pragma link C++ class AliEmcalPythiaXsecCache+;
 #pragma link C++ class AliEmcalESDTrackCutsGenerator+;
 #pragma link C++ class AliEmcalParticle+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
@@ -23,6 +25,7 @@
 #pragma link C++ class AliParticleContainer+;
 #pragma link C++ class AliPicoTrack+;
 #pragma link C++ class AliMCParticleContainer+;
+#pragma link C++ class AliEmcalMergedParticleContainer+;
 #pragma link C++ class AliTrackContainer+;
 #pragma link C++ class AliTrackContainer::TrackOwnerHandler+;
 #pragma link C++ class AliEmcalList+;
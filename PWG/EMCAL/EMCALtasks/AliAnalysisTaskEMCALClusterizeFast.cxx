@@ -20,6 +20,7 @@
 #include <TString.h>
 #include <TTree.h>
 #include <TArrayI.h>
+#include <vector>
 
 // --- AliRoot ---
 #include "AliAODCaloCluster.h"
@@ -87,10 +88,15 @@ AliAnalysisTaskEMCALClusterizeFast::AliAnalysisTaskEMCALClusterizeFast() :
   fFiducial(kFALSE),
   fDoNonLinearity(kFALSE),
   fRecalDistToBadChannels(kFALSE),
+  fClusterizePerSM(kFALSE),
+  fUseClusterPool(kFALSE),
   fSetCellMCLabelFromCluster(0),
   fSetCellMCLabelFromEdepFrac(0),
   fCaloCells(0),
   fCaloClusters(0),
+  fCaloClustersOwned(kFALSE),
+  fSMDigitsArr(0),
+  fSMClusterArr(0),
   fEsd(0),
   fAod(0),
   fGeom(0)
@@ -142,10 +148,15 @@ AliAnalysisTaskEMCALClusterizeFast::AliAnalysisTaskEMCALClusterizeFast(const cha
   fFiducial(kFALSE),
   fDoNonLinearity(kFALSE),
   fRecalDistToBadChannels(kFALSE),
+  fClusterizePerSM(kFALSE),
+  fUseClusterPool(kFALSE),
   fSetCellMCLabelFromCluster(0),
   fSetCellMCLabelFromEdepFrac(0),
   fCaloCells(0),
   fCaloClusters(0),
+  fCaloClustersOwned(kFALSE),
+  fSMDigitsArr(0),
+  fSMClusterArr(0),
   fEsd(0),
   fAod(0),
   fGeom(0)
@@ -166,6 +177,8 @@ AliAnalysisTaskEMCALClusterizeFast::~AliAnalysisTaskEMCALClusterizeFast()
 
   delete fClusterizer;
   delete fUnfolder;   
+  delete fSMDigitsArr;
+  delete fSMClusterArr;
   delete fRecoUtils;
   delete fRecParam;
 }
@@ -271,7 +284,7 @@ void AliAnalysisTaskEMCALClusterizeFast::CopyClusters(TClonesArray *orig, TClone
     if (!oc->IsEMCAL())
       continue;
     
-    AliVCluster *dc = static_cast<AliVCluster*>(dest->New(i));
+    AliVCluster *dc = NewCluster(dest, i);
     dc->SetType(AliVCluster::kEMCALClusterv1);
     dc->SetE(oc->E());
     Float_t pos[3] = {0};
@@ -311,6 +324,18 @@ void AliAnalysisTaskEMCALClusterizeFast::CopyClusters(TClonesArray *orig, TClone
   }
 }
 
+//________________________________________________________________________
+AliVCluster *AliAnalysisTaskEMCALClusterizeFast::NewCluster(TClonesArray *clus, Int_t i)
+{
+  // Get a new cluster at position i. With the cluster pool, in the arrays only filled
+  // by the task, the cluster object left by the previous event (cleared) is reused.
+
+  if (fUseClusterPool && (clus == fOutputAODBranch || (clus == fCaloClusters && fCaloClustersOwned)))
+    return static_cast<AliVCluster*>(clus->ConstructedAt(i, "C"));
+
+  return static_cast<AliVCluster*>(clus->New(i));
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskEMCALClusterizeFast::Clusterize()
 {
@@ -321,7 +346,13 @@ void AliAnalysisTaskEMCALClusterizeFast::Clusterize()
     fClusterizer->SetCalibrationParameters(0);
   }
 
-  fClusterizer->Digits2Clusters("");
+  if (fClusterizePerSM && fRecParam->GetClusterizerFlag() != AliEMCALRecParam::kClusterizerFW) {
+    ClusterizePerSM();
+  }
+  else {
+    fClusterizer->Digits2Clusters("");
+    fClusterArr = const_cast<TObjArray *>(fClusterizer->GetRecPoints());
+  }
  
   if (fSubBackground) {
     if (fCalibData) {
@@ -331,6 +362,88 @@ void AliAnalysisTaskEMCALClusterizeFast::Clusterize()
   }
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskEMCALClusterizeFast::ClusterizePerSM()
+{
+  // Clusterize each supermodule separately, with a digits array containing only
+  // the digits of the supermodule, skipping the supermodules without digits.
+  // The rec points are moved to fSMClusterArr and their digits lists are set back
+  // to the indices in fDigitsArr, so that the rest of the task is unchanged.
+  // The clusters are not shared among supermodules, as in the default clusterizer setting.
+
+  if (!fSMDigitsArr) {
+    fSMDigitsArr = new TClonesArray("AliEMCALDigit", 1000);
+    fSMDigitsArr->SetOwner(1);
+  }
+  if (!fSMClusterArr) {
+    fSMClusterArr = new TObjArray(100);
+    fSMClusterArr->SetOwner(1);
+  }
+  fSMClusterArr->Delete();
+  fClusterArr = fSMClusterArr;
+
+  const Int_t nsm    = fGeom->GetNumberOfSuperModules();
+  const Int_t ndigis = fDigitsArr->GetEntriesFast();
+
+  // sort the digits indices by supermodule
+  std::vector<Int_t> smFirst(nsm+1, 0);
+  std::vector<Int_t> smDigits(ndigis);
+  std::vector<Int_t> digitSM(ndigis);
+  for (Int_t idigit = 0; idigit < ndigis; ++idigit) {
+    AliEMCALDigit *digit = static_cast<AliEMCALDigit*>(fDigitsArr->At(idigit));
+    digitSM[idigit] = fGeom->GetSuperModuleNumber(digit->GetId());
+    ++smFirst[digitSM[idigit]+1];
+  }
+  for (Int_t ism = 0; ism < nsm; ++ism)
+    smFirst[ism+1] += smFirst[ism];
+  std::vector<Int_t> smNext(smFirst.begin(), smFirst.end()-1);
+  for (Int_t idigit = 0; idigit < ndigis; ++idigit)
+    smDigits[smNext[digitSM[idigit]]++] = idigit;
+
+  TObjArray *recPoints = const_cast<TObjArray *>(fClusterizer->GetRecPoints());
+
+  for (Int_t ism = 0; ism < nsm; ++ism) {
+    const Int_t first    = smFirst[ism];
+    const Int_t nsmdigis = smFirst[ism+1] - first;
+    if (nsmdigis == 0)
+      continue;
+
+    fSMDigitsArr->Clear("C");
+    for (Int_t j = 0; j < nsmdigis; ++j) {
+      AliEMCALDigit *digit = static_cast<AliEMCALDigit*>(fDigitsArr->At(smDigits[first+j]));
+      AliEMCALDigit *smdigit = new((*fSMDigitsArr)[j]) AliEMCALDigit(*digit);
+      smdigit->SetIndexInList(j);
+    }
+
+    fClusterizer->SetDigitsArr(fSMDigitsArr);
+    fClusterizer->Digits2Clusters("");
+
+    // calibrated amplitude and time, used when updating the cells
+    for (Int_t j = 0; j < nsmdigis; ++j) {
+      AliEMCALDigit *digit   = static_cast<AliEMCALDigit*>(fDigitsArr->At(smDigits[first+j]));
+      AliEMCALDigit *smdigit = static_cast<AliEMCALDigit*>(fSMDigitsArr->At(j));
+      digit->SetCalibAmp(smdigit->GetCalibAmp());
+      digit->SetTime(smdigit->GetTime());
+    }
+
+    const Int_t nrp = recPoints->GetEntriesFast();
+    for (Int_t irp = 0; irp < nrp; ++irp) {
+      AliEMCALRecPoint *recpoint = static_cast<AliEMCALRecPoint*>(recPoints->RemoveAt(irp));
+      if (!recpoint)
+        continue;
+      Int_t *dlist = recpoint->GetDigitsList();
+      for (Int_t c = 0; c < recpoint->GetMultiplicity(); ++c)
+        dlist[c] = smDigits[first+dlist[c]];
+      recpoint->SetUniqueID(fSMClusterArr->GetEntriesFast());
+      fSMClusterArr->Add(recpoint);
+    }
+  }
+
+  fClusterizer->SetDigitsArr(fDigitsArr);
+
+  AliDebug(1, Form("%d rec points in %d supermodules", fSMClusterArr->GetEntriesFast(), nsm));
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskEMCALClusterizeFast::FillDigitsArray()
 {
@@ -795,7 +908,7 @@ void AliAnalysisTaskEMCALClusterizeFast::RecPoints2Clusters(TClonesArray *clus)
     
     AliDebug(1, Form("energy %f", recpoint->GetEnergy()));
     
-    AliVCluster *c = static_cast<AliVCluster*>(clus->New(nout++));
+    AliVCluster *c = NewCluster(clus, nout++);
     c->SetType(AliVCluster::kEMCALClusterv1);
     c->SetE(recpoint->GetEnergy());
     c->SetPosition(g);
@@ -918,16 +1031,22 @@ void AliAnalysisTaskEMCALClusterizeFast::UpdateClusters()
 {
   // Update cells in case re-calibration was done.
   
-  const Int_t nents = fCaloClusters->GetEntries();
-  for (Int_t i=0;i<nents;++i) {
-    AliVCluster *c = static_cast<AliVCluster*>(fCaloClusters->At(i));
-    if (!c)
-      continue;
-    if (c->IsEMCAL())
-      delete fCaloClusters->RemoveAt(i);
+  if (fUseClusterPool && (fCaloClusters == fOutputAODBranch || fCaloClustersOwned)) {
+    // only EMCal clusters of the task, keep the objects for the next clusters
+    fCaloClusters->Clear("C");
   }
+  else {
+    const Int_t nents = fCaloClusters->GetEntries();
+    for (Int_t i=0;i<nents;++i) {
+      AliVCluster *c = static_cast<AliVCluster*>(fCaloClusters->At(i));
+      if (!c)
+        continue;
+      if (c->IsEMCAL())
+        delete fCaloClusters->RemoveAt(i);
+    }
 
-  fCaloClusters->Compress();
+    fCaloClusters->Compress();
+  }
   
   RecPoints2Clusters(fCaloClusters);
 }
@@ -1093,6 +1212,7 @@ void AliAnalysisTaskEMCALClusterizeFast::Init()
 	
 	fCaloClusters->SetName(fCaloClustersName);
 	InputEvent()->AddObject(fCaloClusters);
+	fCaloClustersOwned = kTRUE;
       }
     }
 
@@ -100,6 +100,10 @@ class AliAnalysisTaskEMCALClusterizeFast : public AliAnalysisTaskSE {
   void                   SetDoNonLinearity(Bool_t b)                          { fDoNonLinearity              = b     ; }
   void                   SetRecalDistToBadChannels(Bool_t b)                  { fRecalDistToBadChannels      = b     ; }
   void                   SetCellMCLabelFromCluster(Int_t s)                   { fSetCellMCLabelFromCluster   = s     ; }
+  void                   SetClusterizePerSM(Bool_t b)                         { fClusterizePerSM             = b     ; }
+  void                   SetUseClusterPool(Bool_t b)                          { fUseClusterPool              = b     ; }
+  Bool_t                 GetClusterizePerSM()                         const   { return fClusterizePerSM              ; }
+  Bool_t                 GetUseClusterPool()                          const   { return fUseClusterPool               ; }
 
   // For backward compatibility
   const TString         &GetNewClusterArrayName()                     const   { return GetCaloClustersName()         ; }
@@ -112,6 +116,7 @@ class AliAnalysisTaskEMCALClusterizeFast : public AliAnalysisTaskSE {
  protected:
   Bool_t                 AcceptCell(Int_t cellNumber);
   virtual void           Clusterize();
+  virtual void           ClusterizePerSM();
   virtual void           FillDigitsArray();
   virtual void           Init();
   virtual void           RecPoints2Clusters(TClonesArray *clus);
@@ -120,6 +125,7 @@ class AliAnalysisTaskEMCALClusterizeFast : public AliAnalysisTaskSE {
   virtual void           CalibrateClusters();
   virtual void           TrackClusterMatching(AliVCluster *c, TClonesArray *tarr);
   virtual void           CopyClusters(TClonesArray *orig, TClonesArray *dest);
+  AliVCluster           *NewCluster(TClonesArray *clus, Int_t i);
 
   Int_t                  fRun;                            //!run number
   TClonesArray          *fDigitsArr;                      //!digits array
@@ -159,6 +165,8 @@ class AliAnalysisTaskEMCALClusterizeFast : public AliAnalysisTaskSE {
   Bool_t                 fFiducial;                       // fiducial cut
   Bool_t                 fDoNonLinearity;                 // non linearity calib
   Bool_t                 fRecalDistToBadChannels;         // recalculate distance to bad channel
+  Bool_t                 fClusterizePerSM;                // clusterize each supermodule separately, clusters not shared among supermodules
+  Bool_t                 fUseClusterPool;                 // reuse the cluster objects of the previous event in the arrays filled by the task
     
   // MC labels
   static const Int_t     fgkTotalCellNumber = 17664 ;     // Maximum number of cells in EMCAL/DCAL: (48*24)*(10+4/3.+6*2/3.)
@@ -175,6 +183,9 @@ class AliAnalysisTaskEMCALClusterizeFast : public AliAnalysisTaskSE {
   
   AliVCaloCells         *fCaloCells;                      //!calo cells object
   TClonesArray          *fCaloClusters;                   //!calo clusters array       
+  Bool_t                 fCaloClustersOwned;              //!calo clusters array created by the task, only filled with its clusters
+  TClonesArray          *fSMDigitsArr;                    //!digits of one supermodule, for the per supermodule clusterization
+  TObjArray             *fSMClusterArr;                   //!recpoints of all the supermodules, for the per supermodule clusterization
   AliESDEvent           *fEsd;                            //!esd event
   AliAODEvent           *fAod;                            //!aod event
   AliEMCALGeometry      *fGeom;                           //!geometry object
@@ -183,6 +194,6 @@ class AliAnalysisTaskEMCALClusterizeFast : public AliAnalysisTaskSE {
   AliAnalysisTaskEMCALClusterizeFast(const AliAnalysisTaskEMCALClusterizeFast&);            // not implemented
   AliAnalysisTaskEMCALClusterizeFast &operator=(const AliAnalysisTaskEMCALClusterizeFast&); // not implemented
 
-  ClassDef(AliAnalysisTaskEMCALClusterizeFast, 10);
+  ClassDef(AliAnalysisTaskEMCALClusterizeFast, 11);
 };
 #endif //ALIANALYSISTASKEMCALCLUSTERIZEFAST_H
@@ -3,6 +3,10 @@
 
 #include "AliAnalysisTaskEmcal.h"
 
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include "AliEmcalMatchingGrid.h"
+#endif
+
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
   AliEmcalClusTrackMatcherTask();
@@ -38,6 +42,10 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   Bool_t        fUpdateTracks;          // update tracks with matching info
   Bool_t        fUpdateClusters;        // update clusters with matching info
 
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  AliEmcalMatchingGrid fClusterGrid;    //!eta-phi grid of the cluster positions of the current event
+#endif
+
   TClonesArray *fEmcalTracks;           //!emcal tracks
   TClonesArray *fEmcalClusters;         //!emcal clusters
   Int_t         fNEmcalTracks;          //!number of emcal tracks
@@ -51,6 +59,6 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 9) // Cluster-Track matching task
 };
 #endif
@@ -44,6 +44,7 @@ Bool_t AliEmcalCorrectionCellBadChannel::Initialize()
   AliWarning("Init EMCAL cell bad channel removal");
   
   GetProperty("createHistos", fCreateHisto);
+  GetProperty("useCellCalibTable", fUseCellCalibTable);
 
   // init reco utils
   if (!fRecoUtils)
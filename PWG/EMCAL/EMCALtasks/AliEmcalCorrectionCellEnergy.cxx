@@ -47,6 +47,7 @@ Bool_t AliEmcalCorrectionCellEnergy::Initialize()
   AliWarning("Init EMCAL cell recalibration");
   
   GetProperty("createHistos", fCreateHisto);
+  GetProperty("useCellCalibTable", fUseCellCalibTable);
 
   if(fFilepass.Contains("LHC14a1a")) fUseAutomaticRecalib = kTRUE;
   
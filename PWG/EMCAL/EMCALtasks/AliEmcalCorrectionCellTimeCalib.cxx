@@ -48,6 +48,7 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Initialize()
   AliWarning("Init EMCAL time calibration");
   
   GetProperty("createHistos", fCreateHisto);
+  GetProperty("useCellCalibTable", fUseCellCalibTable);
   
   fCalibrateTime = kTRUE;
 
@@ -5,6 +5,7 @@
 
 #include <TH1.h>
 #include <TList.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -39,6 +40,7 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUpdateClusters(kTRUE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
+  fClusterGrid(),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
@@ -369,11 +371,26 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Bin the cluster positions on an eta-phi grid, so that each track
+  // is only compared to the clusters in the cells around it
+  fClusterGrid.Reset(-1., 1., fMaxDistance, fMaxDistance);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    Float_t pos[3] = {0};
+    emcalCluster->GetCluster()->GetPosition(pos);
+    TVector3 cpos(pos);
+    fClusterGrid.Add(cpos.Eta(), cpos.Phi(), icluster);
+  }
+  fClusterGrid.Build();
+
+  std::vector<Int_t> candidates;
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fClusterGrid.FindCandidates(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fMaxDistance, fMaxDistance, candidates);
+    for (UInt_t icand = 0; icand < candidates.size(); icand++) {
+      Int_t icluster = fClusterGrid.GetIndex(candidates[icand]);
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
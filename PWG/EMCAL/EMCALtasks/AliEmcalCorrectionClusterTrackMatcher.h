@@ -5,6 +5,7 @@
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
+#include "AliEmcalMatchingGrid.h"
 #endif
 
 class TH1;
@@ -92,6 +93,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   // Handle mapping between index and containers
   AliEmcalContainerIndexMap <AliClusterContainer, AliVCluster> fClusterContainerIndexMap;    //!<! Mapping between index and cluster containers
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
+  AliEmcalMatchingGrid  fClusterGrid;   //!<! eta-phi grid of the cluster positions of the current event
 #endif
 
   TClonesArray *fEmcalTracks;           //!<!emcal tracks
@@ -115,7 +117,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -8,6 +8,7 @@
 
 #include "AliEmcalList.h"
 #include "AliEMCALRecoUtils.h"
+#include "AliEMCALCellCalibTable.h"
 #include "AliAnalysisManager.h"
 #include "AliVEvent.h"
 #include "AliClusterContainer.h"
@@ -48,6 +49,8 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent() :
   fParticleCollArray(),
   fCaloCells(0),
   fRecoUtils(0),
+  fUseCellCalibTable(kFALSE),
+  fCellCalibTable(0),
   fOutput(0),
   fBasePath("")
 
@@ -82,6 +85,8 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
   fParticleCollArray(),
   fCaloCells(0),
   fRecoUtils(0),
+  fUseCellCalibTable(kFALSE),
+  fCellCalibTable(0),
   fOutput(0),
   fBasePath("")
 {
@@ -95,6 +100,7 @@ AliEmcalCorrectionComponent::AliEmcalCorrectionComponent(const char * name) :
  */
 AliEmcalCorrectionComponent::~AliEmcalCorrectionComponent()
 {
+  delete fCellCalibTable;
 }
 
 /**
@@ -192,6 +198,10 @@ void AliEmcalCorrectionComponent::GetEtaPhiDiff(const AliVTrack *t, const AliVCl
 /**
  * Remove bad cells from the cell list
  * Recalibrate energy and time cells
+ *
+ * If fUseCellCalibTable is set, the per run calibration table is (re)built from
+ * the RecoUtils when the run or the RecoUtils switches change, and applied to
+ * the cells in one pass, giving the same result as RecalibrateCells().
  */
 void AliEmcalCorrectionComponent::UpdateCells()
 {
@@ -200,7 +210,16 @@ void AliEmcalCorrectionComponent::UpdateCells()
   
   Int_t bunchCrossNo = fEventManager.InputEvent()->GetBunchCrossNumber();
   
-  if (fRecoUtils)
+  if (fRecoUtils && fUseCellCalibTable && fGeom)
+  {
+    if (!fCellCalibTable) fCellCalibTable = new AliEMCALCellCalibTable();
+
+    if (!fCellCalibTable->IsValidFor(fRun, fRecoUtils))
+      fCellCalibTable->Build(fRun, fGeom->GetNCells(), fRecoUtils);
+
+    fCellCalibTable->Apply(fCaloCells, bunchCrossNo, fRecoUtils);
+  }
+  else if (fRecoUtils)
     fRecoUtils->RecalibrateCells(fCaloCells, bunchCrossNo);
   
   fCaloCells->Sort();
@@ -9,6 +9,7 @@ class TH1F;
 
 class AliMCEvent;
 class AliEMCALRecoUtils;
+class AliEMCALCellCalibTable;
 class AliVCaloCells;
 class AliVTrack;
 class AliVCluster;
@@ -130,6 +131,8 @@ class AliEmcalCorrectionComponent : public TNamed {
   TObjArray               fParticleCollArray;             ///< Particle/track collection array
   AliVCaloCells          *fCaloCells;                     //!<! Pointer to CaloCells
   AliEMCALRecoUtils      *fRecoUtils;                     ///<  Pointer to RecoUtils
+  Bool_t                  fUseCellCalibTable;             ///<  Recalibrate the cells with the per run calibration table
+  AliEMCALCellCalibTable *fCellCalibTable;                //!<! Per run cell bad channel, energy and time calibration table
   TList                  *fOutput;                        //!<! List of output histograms
   
   TString                fBasePath;                       ///< Base folder path to get root files
@@ -139,7 +142,7 @@ class AliEmcalCorrectionComponent : public TNamed {
   AliEmcalCorrectionComponent &operator=(const AliEmcalCorrectionComponent &);    // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionComponent, 5); // EMCal correction component
+  ClassDef(AliEmcalCorrectionComponent, 6); // EMCal correction component
   /// \endcond
 };
 
@@ -12,6 +12,7 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <map>
 
 #include <TChain.h>
 
@@ -59,6 +60,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fDefaultConfigurationFilename(""),
   fOrderedComponentsToExecute(),
   fCorrectionComponents(),
+  fComponentBranches(),
+  fRunComponentsByBranch(false),
   fConfigurationInitialized(false),
   fIsEsd(false),
   fEventInitialized(false),
@@ -104,6 +107,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fDefaultConfigurationFilename(""),
   fOrderedComponentsToExecute(),
   fCorrectionComponents(),
+  fComponentBranches(),
+  fRunComponentsByBranch(false),
   fConfigurationInitialized(false),
   fIsEsd(false),
   fEventInitialized(false),
@@ -149,6 +154,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fDefaultConfigurationFilename(task.fDefaultConfigurationFilename),
   fOrderedComponentsToExecute(task.fOrderedComponentsToExecute),
   fCorrectionComponents(task.fCorrectionComponents),  // TODO: These should be copied!
+  fComponentBranches(task.fComponentBranches),
+  fRunComponentsByBranch(task.fRunComponentsByBranch),
   fConfigurationInitialized(task.fConfigurationInitialized),
   fIsEsd(task.fIsEsd),
   fEventInitialized(task.fEventInitialized),
@@ -212,6 +219,8 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fDefaultConfigurationFilename, second.fDefaultConfigurationFilename);
   swap(first.fOrderedComponentsToExecute, second.fOrderedComponentsToExecute);
   swap(first.fCorrectionComponents, second.fCorrectionComponents);
+  swap(first.fComponentBranches, second.fComponentBranches);
+  swap(first.fRunComponentsByBranch, second.fRunComponentsByBranch);
   swap(first.fConfigurationInitialized, second.fConfigurationInitialized);
   swap(first.fIsEsd, second.fIsEsd);
   swap(first.fEventInitialized, second.fEventInitialized);
@@ -385,6 +394,9 @@ void AliEmcalCorrectionTask::InitializeConfiguration()
 
   // Initialize
   fYAMLConfig.Initialize();
+  // Flatten the configurations once, since each component retrieves many properties.
+  // Also reports settings in the user configuration which are not in the default configuration.
+  fYAMLConfig.BuildSnapshot(true);
 
   // Note that it is initialized properly so that the analysis can proceed
   fConfigurationInitialized = true;
@@ -591,6 +603,64 @@ void AliEmcalCorrectionTask::InitializeComponents()
       fCorrectionComponents.push_back(component);
     }
   }
+
+  DetermineComponentBranches();
+}
+
+/**
+ * Groups the correction components according to the input objects that they are configured to use.
+ * Two components belong to the same group (branch) if they share any cells, cluster or track
+ * container, directly or through other components of the group. Within a branch, the components
+ * keep the order of the YAML configuration, which is the only ordering that the corrections rely on.
+ * Components of different branches (for example corrections of the data and of the embedded cells)
+ * do not depend on each other, as long as the dependencies are expressed through the input objects.
+ */
+void AliEmcalCorrectionTask::DetermineComponentBranches()
+{
+  fComponentBranches.clear();
+  const std::size_t nComponents = fCorrectionComponents.size();
+
+  // Union-find over the components, connecting those which share an input object
+  std::vector <std::size_t> parent(nComponents);
+  for (std::size_t i = 0; i < nComponents; i++) { parent[i] = i; }
+  auto findRoot = [&parent](std::size_t i) {
+    while (parent[i] != i) { parent[i] = parent[parent[i]]; i = parent[i]; }
+    return i;
+  };
+
+  std::map <std::string, std::size_t> objectOwner;
+  const AliEmcalContainerUtils::InputObject_t inputObjectTypes[] = {AliEmcalContainerUtils::kCaloCells, AliEmcalContainerUtils::kCluster, AliEmcalContainerUtils::kTrack};
+  for (std::size_t i = 0; i < nComponents; i++)
+  {
+    for (auto inputObjectType : inputObjectTypes)
+    {
+      std::string inputObjectName = GetInputFieldNameFromInputObjectType(inputObjectType);
+      std::vector <std::string> inputObjects;
+      // Property is not required, because not all components need all kinds of input objects
+      fYAMLConfig.GetProperty(std::vector<std::string>{fCorrectionComponents.at(i)->GetName(), inputObjectName + "Names"}, inputObjects, false);
+      for (auto const & str : inputObjects)
+      {
+        auto result = objectOwner.insert(std::make_pair(inputObjectName + ":" + str, i));
+        if (!result.second) {
+          parent[findRoot(i)] = findRoot(result.first->second);
+        }
+      }
+    }
+  }
+
+  // Collect the branches, ordered by their first component
+  std::map <std::size_t, std::size_t> branchIndex;
+  for (std::size_t i = 0; i < nComponents; i++)
+  {
+    std::size_t root = findRoot(i);
+    auto result = branchIndex.insert(std::make_pair(root, fComponentBranches.size()));
+    if (result.second) {
+      fComponentBranches.push_back(std::vector <std::size_t>());
+    }
+    fComponentBranches.at(result.first->second).push_back(i);
+  }
+
+  AliDebugStream(1) << "Found " << fComponentBranches.size() << " independent branches of correction components" << std::endl;
 }
 
 /**
@@ -1041,6 +1111,7 @@ void AliEmcalCorrectionTask::UserCreateOutputObjects()
 
   // YAML Objects cannot be streamed, so we need to reinitialize them here.
   fYAMLConfig.Reinitialize();
+  fYAMLConfig.BuildSnapshot();
 
   if (fForceBeamType == kpp)
     fNcentBins = 1;
@@ -1310,9 +1381,26 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
  */
 Bool_t AliEmcalCorrectionTask::Run()
 {
+  // Determine the order of execution. By default, it is the order of the configuration. Otherwise,
+  // each branch of components is run in turn, keeping the configured order within the branch.
+  if (fRunComponentsByBranch && fComponentBranches.empty() && !fCorrectionComponents.empty()) {
+    DetermineComponentBranches();
+  }
+  std::vector <std::size_t> executionOrder;
+  executionOrder.reserve(fCorrectionComponents.size());
+  if (fRunComponentsByBranch) {
+    for (const auto & branch : fComponentBranches) {
+      executionOrder.insert(executionOrder.end(), branch.begin(), branch.end());
+    }
+  }
+  else {
+    for (std::size_t i = 0; i < fCorrectionComponents.size(); i++) { executionOrder.push_back(i); }
+  }
+
   // Run the initialization for all derived classes.
-  for (auto component : fCorrectionComponents)
+  for (auto iComponent : executionOrder)
   {
+    AliEmcalCorrectionComponent * component = fCorrectionComponents.at(iComponent);
     component->SetInputEvent(InputEvent());
     component->SetMCEvent(MCEvent());
     component->SetCentralityBin(fCentBin);
@@ -1759,6 +1847,17 @@ std::string AliEmcalCorrectionTask::toString(bool includeYAMLConfigurationInfo)
   for (auto component : fOrderedComponentsToExecute) {
     tempSS << "\t" << component << "\n";
   }
+  // Show the independent branches of components
+  if (fComponentBranches.size() > 1) {
+    tempSS << "\nIndependent branches of correction components:\n";
+    for (std::size_t iBranch = 0; iBranch < fComponentBranches.size(); iBranch++) {
+      tempSS << "\tBranch " << iBranch << ":";
+      for (auto iComponent : fComponentBranches.at(iBranch)) {
+        tempSS << " " << fCorrectionComponents.at(iComponent)->GetName();
+      }
+      tempSS << "\n";
+    }
+  }
   // Input objects
   tempSS << "\nInput objects:\n";
   PrintRequestedContainersInformation(AliEmcalContainerUtils::kCaloCells, tempSS);
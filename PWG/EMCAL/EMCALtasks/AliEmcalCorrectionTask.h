@@ -104,6 +104,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  void                        SetRunComponentsByBranch(bool b)                      { fRunComponentsByBranch = b                          ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -119,6 +120,16 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
    */
   const std::vector<AliEmcalCorrectionComponent *> & CorrectionComponents() { return fCorrectionComponents; }
   AliEmcalCorrectionComponent * GetCorrectionComponent(const std::string & name) const;
+  /**
+   * Groups of correction components which share input objects (cells, clusters or tracks). Each group
+   * contains the indices of the components in CorrectionComponents(), in execution order. Components in
+   * different groups operate on disjoint input objects and are independent of each other.
+   *
+   * If SetRunComponentsByBranch() is enabled, Run() executes one group after the other instead of following
+   * the configuration order. This is only valid if all dependencies between components are expressed through
+   * their input objects (for example, objects created by a component must be requested by it as well).
+   */
+  const std::vector <std::vector <std::size_t> > & GetComponentBranches() const { return fComponentBranches; }
 
   // Containers and cells
   AliParticleContainer       *AddParticleContainer(const char *n)                   { return AliEmcalContainerUtils::AddContainer<AliParticleContainer>(n, fParticleCollArray); }
@@ -201,6 +212,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   void DetermineComponentsToExecute(std::vector <std::string> & componentsToExecute);
   void CheckForUnmatchedUserSettings();
   void InitializeComponents();
+  void DetermineComponentBranches();
 
   // Input objects (Cells, Clusters, Tracks) functions
   void CreateInputObjects(AliEmcalContainerUtils::InputObject_t inputObjectType);
@@ -228,6 +240,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
 
   std::vector <std::string>   fOrderedComponentsToExecute; ///< Ordered set of components to execute
   std::vector <AliEmcalCorrectionComponent *> fCorrectionComponents; ///< Contains the correction components
+  std::vector <std::vector <std::size_t> > fComponentBranches; ///< Indices of the components in each group sharing input objects
+  bool                        fRunComponentsByBranch;      ///< Run the components grouped by branch instead of in configuration order
   bool                        fConfigurationInitialized;   ///< True if the YAML configuration files are initialized
 
   bool                        fIsEsd;                      ///< File type
@@ -253,7 +267,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 4); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 5); // EMCal correction task
   /// \endcond
 };
 
@@ -67,7 +67,19 @@ AliEmcalFastOrMonitorTask::AliEmcalFastOrMonitorTask() :
   fNameMaskedFastorOADB(),
   fNameMaskedCellOADB("$ALICE_PHYSICS/OADB/EMCAL/EMCALBadChannels.root"),
   fMaskedFastorOADB(nullptr),
-  fMaskedCellOADB(nullptr)
+  fMaskedCellOADB(nullptr),
+  fCellFastor(),
+  fFastorPos(),
+  fFastorCells(),
+  fFastorEta(),
+  fFastorPhi(),
+  fFastorMasked(),
+  fCellMasked(),
+  fFastorNMaskedCells(),
+  fFastorAmp(),
+  fFastorL1TimeSum(),
+  fFastorNL0Times(),
+  fFastorsFired()
 {
 
 }
@@ -80,12 +92,25 @@ AliEmcalFastOrMonitorTask::AliEmcalFastOrMonitorTask(const char *name) :
   fOldRun(-1),
   fRequestTrigger(AliVEvent::kAny),
   fTriggerPattern(""),
+  fCellData(),
   fMaskedFastors(),
   fMaskedCells(),
   fNameMaskedFastorOADB(),
   fNameMaskedCellOADB("$ALICE_PHYSICS/OADB/EMCAL/EMCALBadChannels.root"),
   fMaskedFastorOADB(nullptr),
-  fMaskedCellOADB(nullptr)
+  fMaskedCellOADB(nullptr),
+  fCellFastor(),
+  fFastorPos(),
+  fFastorCells(),
+  fFastorEta(),
+  fFastorPhi(),
+  fFastorMasked(),
+  fCellMasked(),
+  fFastorNMaskedCells(),
+  fFastorAmp(),
+  fFastorL1TimeSum(),
+  fFastorNL0Times(),
+  fFastorsFired()
 {
   DefineOutput(1, TList::Class());
 }
@@ -131,8 +156,40 @@ void AliEmcalFastOrMonitorTask::UserCreateOutputObjects() {
 void AliEmcalFastOrMonitorTask::ExecOnce(){
   fGeom = AliEMCALGeometry::GetInstanceFromRunNumber(InputEvent()->GetRunNumber());
 
-  int nrow = fGeom->GetTriggerMappingVersion() == 2 ? 104 : 64;
-  fCellData.Allocate(48, nrow);
+  const int kNcol = 48;
+  int nrow = fGeom->GetTriggerMappingVersion() == 2 ? 104 : 64, nfastor = kNcol * nrow, ncell = fGeom->GetNCells();
+  fCellData.Allocate(kNcol, nrow);
+
+  // Static lookup tables replacing the per-event geometry queries
+  fFastorPos.assign(nfastor, -1);
+  fFastorCells.assign(4 * nfastor, -1);
+  fFastorEta.assign(nfastor, 0.);
+  fFastorPhi.assign(nfastor, 0.);
+  fCellFastor.assign(ncell, -1);
+  for(int ifastor = 0; ifastor < nfastor; ifastor++){
+    int col, row;
+    if(!fGeom->GetPositionInEMCALFromAbsFastORIndex(ifastor, col, row)) continue;
+    fFastorPos[ifastor] = col + kNcol * row;
+    int *cellIDs = &fFastorCells[4 * ifastor];
+    if(!fGeom->GetTriggerMapping()->GetCellIndexFromFastORIndex(ifastor, cellIDs)) continue;
+    // FastOR position: for the approximation take mean eta and phi of the cells
+    double eta = 0., phi = 0.;
+    for(int icell = 0; icell < 4; icell++){
+      double etatmp, phitmp;
+      fGeom->EtaPhiFromIndex(cellIDs[icell], etatmp, phitmp);
+      eta += etatmp;
+      phi += phitmp;
+      if(cellIDs[icell] >= 0 && cellIDs[icell] < ncell) fCellFastor[cellIDs[icell]] = ifastor;
+    }
+    fFastorEta[ifastor] = eta / 4.;
+    fFastorPhi[ifastor] = phi / 4.;
+  }
+
+  fFastorAmp.assign(nfastor, 0.);
+  fFastorL1TimeSum.assign(nfastor, 0);
+  fFastorNL0Times.assign(nfastor, 0);
+  fFastorsFired.reserve(nfastor);
+  BuildMaskTables();
 
   if(fNameMaskedCellOADB.Length()){
     fMaskedCellOADB = new AliOADBContainer("AliEMCALBadChannels");
@@ -186,6 +243,22 @@ void AliEmcalFastOrMonitorTask::RunChanged(Int_t newrun){
       std::sort(fMaskedCells.begin(), fMaskedCells.end(), std::less<int>());
     }
   }
+
+  BuildMaskTables();
+}
+
+void AliEmcalFastOrMonitorTask::BuildMaskTables(){
+  fFastorMasked.assign(fFastorPos.size(), false);
+  fCellMasked.assign(fCellFastor.size(), false);
+  fFastorNMaskedCells.assign(fFastorPos.size(), 0);
+  for(auto fastor : fMaskedFastors){
+    if(fastor >= 0 && fastor < static_cast<int>(fFastorMasked.size())) fFastorMasked[fastor] = true;
+  }
+  for(auto cell : fMaskedCells){
+    if(cell < 0 || cell >= static_cast<int>(fCellMasked.size())) continue;
+    fCellMasked[cell] = true;
+    if(fCellFastor[cell] >= 0) fFastorNMaskedCells[fCellFastor[cell]]++;
+  }
 }
 
 void AliEmcalFastOrMonitorTask::UserExec(Option_t *) {
@@ -211,19 +284,14 @@ void AliEmcalFastOrMonitorTask::UserExec(Option_t *) {
   vtx->GetXYZ(vtxpos);
 
   LoadEventCellData();
+  LoadEventFastorData();
 
   fHistos->FillTH1("hEvents", 1);
 
-  AliVCaloTrigger *triggerdata = InputEvent()->GetCaloTrigger("EMCAL");
-  triggerdata->Reset();
-  Int_t nl0times, l1timesum, fastOrID, globCol, globRow;
-  Float_t amp;
-  while(triggerdata->Next()){
-    triggerdata->GetAmplitude(amp);
-    triggerdata->GetNL0Times(nl0times);
-    triggerdata->GetL1TimeSum(l1timesum);
-    triggerdata->GetPosition(globCol, globRow);
-    fGeom->GetTriggerMapping()->GetAbsFastORIndexFromPositionInEMCAL(globCol, globRow, fastOrID);
+  for(auto fastOrID : fFastorsFired){
+    Float_t amp = fFastorAmp[fastOrID];
+    Int_t l1timesum = fFastorL1TimeSum[fastOrID], nl0times = fFastorNL0Times[fastOrID],
+          globCol = fFastorPos[fastOrID] % 48, globRow = fFastorPos[fastOrID] / 48;
     if(amp > 1e-5){
       fHistos->FillTH2("hFastOrColRowFrequencyL0", globCol, globRow);
       fHistos->FillTH1("hFastOrFrequencyL0", fastOrID);
@@ -232,23 +300,17 @@ void AliEmcalFastOrMonitorTask::UserExec(Option_t *) {
       fHistos->FillTH2("hFastOrColRowFrequencyL1", globCol, globRow);
       fHistos->FillTH1("hFastOrFrequencyL1", fastOrID);
     }
-    if(std::find(fMaskedFastors.begin(), fMaskedFastors.end(), fastOrID) == fMaskedFastors.end()){
+    if(!fFastorMasked[fastOrID]){
       fHistos->FillTH2("hFastOrAmplitude", fastOrID, amp);
       fHistos->FillTH2("hFastOrTimeSum", fastOrID, l1timesum);
       fHistos->FillTH2("hFastOrNL0Times", fastOrID, nl0times);
       fHistos->FillTH2("hFastOrTransverseTimeSum", fastOrID, GetTransverseTimeSum(fastOrID, l1timesum, vtxpos));
       fHistos->FillTH2("hEnergyFastorCell", fCellData(globCol, globRow), l1timesum * EMCALTrigger::kEMCL1ADCtoGeV);
-      int ncellmasked = 0;
-      int fastorCells[4];
-      fGeom->GetTriggerMapping()->GetCellIndexFromFastORIndex(fastOrID, fastorCells);
-      for(int icell = 0; icell < 4; icell++){
-        if(std::find(fMaskedCells.begin(), fMaskedCells.end(), fastorCells[icell]) != fMaskedCells.end()) ncellmasked++;
-      }
       double energydata[4] = {
             static_cast<double>(fastOrID),
             fCellData(globCol, globRow),
             l1timesum * EMCALTrigger::kEMCL1ADCtoGeV,
-            static_cast<double>(ncellmasked)
+            static_cast<double>(fFastorNMaskedCells[fastOrID])
       };
       fHistos->FillTHnSparse("hFastOrEnergyOfflineOnline", energydata);
     }
@@ -265,32 +327,47 @@ void AliEmcalFastOrMonitorTask::LoadEventCellData(){
      double amplitude = emccells->GetAmplitude(icell);
      if(amplitude > 0){
        fHistos->FillTH1("hCellEnergyCount", position);
-       if(std::find(fMaskedCells.begin(), fMaskedCells.end(), position) != fMaskedCells.end()){
+       if(position < 0 || position >= static_cast<int>(fCellFastor.size()) || fCellFastor[position] < 0) continue;
+       if(fCellMasked[position]){
          AliErrorStream() << "Non-0 cell energy " << amplitude << " found for masked cell " << position << std::endl;
        }
-       int absFastor, col, row;
-       fGeom->GetTriggerMapping()->GetFastORIndexFromCellIndex(position, absFastor);
-       fGeom->GetPositionInEMCALFromAbsFastORIndex(absFastor, col, row);
-       fCellData(col, row) += amplitude;
+       int fastorpos = fFastorPos[fCellFastor[position]];
+       fCellData(fastorpos % 48, fastorpos / 48) += amplitude;
      }
    }
 }
 
-Double_t AliEmcalFastOrMonitorTask::GetTransverseTimeSum(Int_t fastorAbsID, Double_t adc, const Double_t *vertex) const{
-  Int_t cellIDs[4];
-  fGeom->GetTriggerMapping()->GetCellIndexFromFastORIndex(fastorAbsID, cellIDs);
-  std::vector<double> eta, phi;
-  for(int i = 0l; i < 4; i++){
-    double etatmp, phitmp;
-    fGeom->EtaPhiFromIndex(cellIDs[i], etatmp, phitmp);
-    eta.push_back(etatmp);
-    phi.push_back(phitmp);
+void AliEmcalFastOrMonitorTask::LoadEventFastorData(){
+  for(auto fastor : fFastorsFired){
+    fFastorAmp[fastor] = 0.;
+    fFastorL1TimeSum[fastor] = 0;
+    fFastorNL0Times[fastor] = 0;
   }
+  fFastorsFired.clear();
 
-  // Calculate FastOR position: for the approximation take mean eta and phi
+  AliVCaloTrigger *triggerdata = InputEvent()->GetCaloTrigger("EMCAL");
+  triggerdata->Reset();
+  Int_t nl0times, l1timesum, fastOrID, globCol, globRow;
+  Float_t amp;
+  while(triggerdata->Next()){
+    triggerdata->GetPosition(globCol, globRow);
+    if(!fGeom->GetTriggerMapping()->GetAbsFastORIndexFromPositionInEMCAL(globCol, globRow, fastOrID)) continue;
+    if(fastOrID < 0 || fastOrID >= static_cast<int>(fFastorPos.size())) continue;
+    triggerdata->GetAmplitude(amp);
+    triggerdata->GetNL0Times(nl0times);
+    triggerdata->GetL1TimeSum(l1timesum);
+    fFastorAmp[fastOrID] = amp;
+    fFastorL1TimeSum[fastOrID] = l1timesum;
+    fFastorNL0Times[fastOrID] = nl0times;
+    fFastorsFired.push_back(fastOrID);
+  }
+}
+
+Double_t AliEmcalFastOrMonitorTask::GetTransverseTimeSum(Int_t fastorAbsID, Double_t adc, const Double_t *vertex) const{
+  // FastOR position (mean eta and phi of the cells) is taken from the lookup table
   // Radius is taken from the geometry
   TVector3 fastorPos, vertexPos(vertex[0], vertex[1], vertex[2]);
-  fastorPos.SetPtEtaPhi(fGeom->GetIPDistance(), TMath::Mean(eta.begin(), eta.end()), TMath::Mean(phi.begin(), phi.end()));
+  fastorPos.SetPtEtaPhi(fGeom->GetIPDistance(), fFastorEta[fastorAbsID], fFastorPhi[fastorAbsID]);
   fastorPos -= vertexPos;
 
   TLorentzVector evec(fastorPos, adc);
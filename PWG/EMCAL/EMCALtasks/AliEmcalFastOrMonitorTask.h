@@ -29,6 +29,7 @@
 
 #include "AliAnalysisTaskSE.h"
 #include "AliEMCALTriggerDataGrid.h"
+#include <vector>
 #include <TString.h>
 
 class AliEMCALGeometry;
@@ -152,7 +153,8 @@ protected:
    * Performing initial initializations. In contrast to UserCreateOutputObjects,
    * which is called before the event loop, ExecOnce is called for the first event
    * within the event loop. At that step some basic event information is already
-   * available,
+   * available. The geometry lookup tables (cell -> FastOR position, FastOR -> cells,
+   * FastOR centre in eta-phi) are built here once.
    */
   virtual void ExecOnce();
 
@@ -186,6 +188,21 @@ protected:
    */
   void LoadEventCellData();
 
+  /**
+   * @brief Load event-dependent FastOR data
+   *
+   * Reads the trigger data of the event in one pass into dense arrays indexed
+   * by the FastOR abs. ID and keeps the list of FastORs with data.
+   */
+  void LoadEventFastorData();
+
+  /**
+   * @brief Update the mask tables per FastOR and per cell
+   *
+   * Called after the masked FastORs and cells are loaded for a new run.
+   */
+  void BuildMaskTables();
+
   THistManager                            *fHistos;           //!<! Histogram handler
   AliEMCALGeometry                        *fGeom;             //!<! EMCAL Geometry object
   Bool_t                                  fLocalInitialized;  ///< Switch whether task is initialized (for ExecOnce)
@@ -203,8 +220,21 @@ protected:
   AliOADBContainer                        *fMaskedFastorOADB; //!<! OADB container with masked fastors
   AliOADBContainer                        *fMaskedCellOADB;   //!<! OADB container with masked cells
 
+  std::vector<int>                        fCellFastor;        //!<! FastOR abs. ID for each cell abs. ID (-1 if not mapped)
+  std::vector<int>                        fFastorPos;         //!<! Position (col + 48 * row) for each FastOR abs. ID
+  std::vector<int>                        fFastorCells;       //!<! Cell abs. IDs of each FastOR (4 per FastOR)
+  std::vector<double>                     fFastorEta;         //!<! Mean eta of the cells of each FastOR
+  std::vector<double>                     fFastorPhi;         //!<! Mean phi of the cells of each FastOR
+  std::vector<bool>                       fFastorMasked;      //!<! Mask flag per FastOR abs. ID
+  std::vector<bool>                       fCellMasked;        //!<! Mask flag per cell abs. ID
+  std::vector<int>                        fFastorNMaskedCells;//!<! Number of masked cells per FastOR abs. ID
+  std::vector<float>                      fFastorAmp;         //!<! L0 amplitude per FastOR abs. ID (event)
+  std::vector<int>                        fFastorL1TimeSum;   //!<! L1 time sum per FastOR abs. ID (event)
+  std::vector<int>                        fFastorNL0Times;    //!<! Number of L0 times per FastOR abs. ID (event)
+  std::vector<int>                        fFastorsFired;      //!<! FastOR abs. IDs with data in the event
+
   /// \cond CLASSIMP
-  ClassDef(AliEmcalFastOrMonitorTask, 1);
+  ClassDef(AliEmcalFastOrMonitorTask, 2);
   /// \endcond
 };
 
@@ -19,6 +19,7 @@
 
 #include <TArrayI.h>
 #include <TF1.h>
+#include <TMath.h>
 #include <TObjArray.h>
 #include <TRandom.h>
 
@@ -65,6 +66,8 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fSmearModelMean(nullptr),
   fSmearModelSigma(nullptr),
   fSmearThreshold(0.1),
+  fUseIntegralImage(kFALSE),
+  fIntegralL1Algorithms(),
   fGeometry(nullptr),
   fPatchAmplitudes(nullptr),
   fPatchADCSimple(nullptr),
@@ -72,9 +75,20 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
+  fIntegralADC(),
+  fIntegralAmplitudes(),
+  fIntegralADCSimple(),
+  fIntegralEnergySmeared(),
+  fIntegralCountADC(),
+  fIntegralCountAmplitudes(),
+  fIntegralCountADCSimple(),
+  fIntegralCountEnergySmeared(),
+  fL1RawPatches(),
+  fL0RawPatches(),
   fADCtoGeV(1.)
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
+  memset(fIntegralL0Algorithm, 0, sizeof(Int_t) * 5);
   memset(fL1ThresholdsOffline, 0, sizeof(ULong64_t) * 4);
   fCellTimeLimits[0] = -10000.;
   fCellTimeLimits[1] = 10000.;
@@ -128,6 +142,9 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+
+  Int_t config[5] = {rowmin, rowmax, static_cast<Int_t>(bitmask), patchSize, subregionSize};
+  fIntegralL1Algorithms.insert(fIntegralL1Algorithms.end(), config, config + 5);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -136,6 +153,12 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+
+  fIntegralL0Algorithm[0] = rowmin;
+  fIntegralL0Algorithm[1] = rowmax;
+  fIntegralL0Algorithm[2] = static_cast<Int_t>(bitmask);
+  fIntegralL0Algorithm[3] = patchSize;
+  fIntegralL0Algorithm[4] = subregionSize;
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -146,6 +169,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -163,6 +187,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -180,6 +205,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP20158x8()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -197,6 +223,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -212,6 +239,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -227,6 +255,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -242,6 +271,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  fIntegralL1Algorithms.clear();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -504,16 +534,35 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   bkgPatchMask = 1 << fTriggerBitConfig->GetBkgBit();
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
-  std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
-    if (useL0amp) {
-      patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  std::vector<AliEMCALTriggerRawPatch> &patches = fL1RawPatches, &l0patches = fL0RawPatches;
+  patches.clear();
+  l0patches.clear();
+  if (fUseIntegralImage) {
+    // One summed-area table per grid, shared by all L1 and L0 algorithms
+    if (!useL0amp) BuildIntegralImage(*fPatchADC, fIntegralADC, fIntegralCountADC);
+    BuildIntegralImage(*fPatchAmplitudes, fIntegralAmplitudes, fIntegralCountAmplitudes);
+    BuildIntegralImage(*fPatchADCSimple, fIntegralADCSimple, fIntegralCountADCSimple);
+    if (fPatchEnergySimpleSmeared) BuildIntegralImage(*fPatchEnergySimpleSmeared, fIntegralEnergySmeared, fIntegralCountEnergySmeared);
+    const std::vector<double> &l1sums = useL0amp ? fIntegralAmplitudes : fIntegralADC;
+    const std::vector<int> &l1counts = useL0amp ? fIntegralCountAmplitudes : fIntegralCountADC;
+    for (UInt_t ialgo = 0; ialgo + 5 <= fIntegralL1Algorithms.size(); ialgo += 5) {
+      FindPatchesIntegral(&fIntegralL1Algorithms[ialgo], l1sums, l1counts, patches);
     }
-    else {
-      patches = fPatchFinder->FindPatches(*fPatchADC, *fPatchADCSimple);
+    if (fIntegralL0Algorithm[3] > 0) FindPatchesIntegral(fIntegralL0Algorithm, fIntegralAmplitudes, fIntegralCountAmplitudes, l0patches);
+  }
+  else {
+    if (fPatchFinder) {
+      if (useL0amp) {
+        patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+      }
+      else {
+        patches = fPatchFinder->FindPatches(*fPatchADC, *fPatchADCSimple);
+      }
     }
+    if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
   }
   outputcont.clear();
+  outputcont.reserve(patches.size() + l0patches.size());
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = patches.begin(); patchit != patches.end(); ++patchit){
     // Apply offline and recalc selection
     // Remove unwanted bits from the online bits (gamma bits from jet patches and vice versa)
@@ -548,9 +597,13 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
       double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+      if(fUseIntegralImage){
+        energysmear = GetIntegralSum(fIntegralEnergySmeared, fIntegralCountEnergySmeared, fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
+      } else {
+        for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
+          for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
+            energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+          }
         }
       }
       AliDebugStream(1) << "Patch size(" << fullpatch.GetPatchSize() <<") energy " << fullpatch.GetPatchE() << " smeared " << energysmear << std::endl;
@@ -559,9 +612,7 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     outputcont.push_back(fullpatch);
   }
 
-  // Find Level0 patches
-  std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  // Convert Level0 patches
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -579,9 +630,13 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
       double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+      if(fUseIntegralImage){
+        energysmear = GetIntegralSum(fIntegralEnergySmeared, fIntegralCountEnergySmeared, fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
+      } else {
+        for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
+          for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
+            energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+          }
         }
       }
       fullpatch.SetSmearedEnergy(energysmear);
@@ -591,6 +646,52 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   // std::cout << "Finished finding trigger patches" << std::endl;
 }
 
+void AliEmcalTriggerMakerKernel::BuildIntegralImage(const AliEMCALTriggerDataGrid<double> &grid, std::vector<double> &sums, std::vector<int> &counts) const {
+  int ncols = grid.GetNumberOfCols(), nrows = grid.GetNumberOfRows(), width = ncols + 1;
+  sums.assign(width * (nrows + 1), 0.);
+  counts.assign(width * (nrows + 1), 0);
+  for(int irow = 0; irow < nrows; irow++){
+    double rowsum = 0.;
+    int rowcount = 0;
+    for(int icol = 0; icol < ncols; icol++){
+      double value = grid(icol, irow);
+      rowsum += value;
+      if(value != 0.) rowcount++;
+      sums[(irow + 1) * width + icol + 1] = sums[irow * width + icol + 1] + rowsum;
+      counts[(irow + 1) * width + icol + 1] = counts[irow * width + icol + 1] + rowcount;
+    }
+  }
+}
+
+double AliEmcalTriggerMakerKernel::GetIntegralSum(const std::vector<double> &sums, const std::vector<int> &counts, int col, int row, int size) const {
+  int width = fPatchADCSimple->GetNumberOfCols() + 1, height = fPatchADCSimple->GetNumberOfRows() + 1;
+  if(static_cast<int>(sums.size()) != width * height) return 0.;
+  int colmin = TMath::Max(col, 0), colmax = TMath::Min(col + size, width - 1),
+      rowmin = TMath::Max(row, 0), rowmax = TMath::Min(row + size, height - 1);
+  if(colmin >= colmax || rowmin >= rowmax) return 0.;
+  // exactly zero without signal, independent of the rounding in the table
+  if(!(counts[rowmax * width + colmax] - counts[rowmin * width + colmax] - counts[rowmax * width + colmin] + counts[rowmin * width + colmin])) return 0.;
+  double sum = sums[rowmax * width + colmax] - sums[rowmin * width + colmax] - sums[rowmax * width + colmin] + sums[rowmin * width + colmin];
+  return sum > 0. ? sum : 0.;     // all channels are positive
+}
+
+void AliEmcalTriggerMakerKernel::FindPatchesIntegral(const Int_t *config, const std::vector<double> &adcSums, const std::vector<int> &adcCounts,
+                                                     std::vector<AliEMCALTriggerRawPatch> &result) const {
+  int rowmin = config[0], rowmax = config[1], patchsize = config[3], subregion = config[4] > 0 ? config[4] : 1;
+  int rowStartMax = rowmax - (patchsize - 1), colStartMax = fPatchADCSimple->GetNumberOfCols() - patchsize;
+  for(int irow = rowmin; irow <= rowStartMax; irow += subregion){
+    for(int icol = 0; icol <= colStartMax; icol += subregion){
+      double sumadc = GetIntegralSum(adcSums, adcCounts, icol, irow, patchsize),
+             sumofflineadc = GetIntegralSum(fIntegralADCSimple, fIntegralCountADCSimple, icol, irow, patchsize);
+      if(sumadc > 0. || sumofflineadc > 0.){
+        AliEMCALTriggerRawPatch recpatch(icol, irow, patchsize, sumadc, sumofflineadc);
+        recpatch.SetBitmask(static_cast<UInt_t>(config[2]));
+        result.push_back(recpatch);
+      }
+    }
+  }
+}
+
 double AliEmcalTriggerMakerKernel::GetL0TriggerChannelAmplitude(Int_t col, Int_t row) const{
   double amp = 0;
   try {
@@ -9,12 +9,12 @@
 
 #include <TObject.h>
 #include <TArrayF.h>
+#include "AliEMCALTriggerRawPatch.h"
 //#include <AliEMCALTriggerPatchInfoV1.h>
 
 class TF1;
 class TObjArray;
 class AliEMCALTriggerPatchInfo;
-class AliEMCALTriggerRawPatch;
 class AliEMCALGeometry;
 class AliVCaloCells;
 class AliVCaloTrigger;
@@ -370,6 +370,20 @@ public:
    */
   void SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
 
+  /**
+   * @brief Use the summed-area table patch search
+   *
+   * Instead of the sliding window sums of the trigger algorithms, one
+   * integral image is built per event for each data grid, and the ADC of
+   * every patch of the configured L1 and L0 algorithms (2x2 gamma and L0,
+   * 8x8 background, 8x8 or 16x16 jet) is obtained with four lookups. Online,
+   * recalc and offline ADCs of L1 and L0 patches come out of the same pass.
+   * The patch selection follows AliEMCALTriggerAlgorithm (patches with non-zero
+   * online or offline ADC, in the order of the algorithms).
+   * @param[in] doUse If true the summed-area table patch search is used
+   */
+  void SetUseIntegralImagePatchFinder(Bool_t doUse = kTRUE) { fUseIntegralImage = doUse; }
+
   /**
    * @brief Set energy-dependent models for gaussian energy smearing
    * @param[in] mean Parameterization of the mean
@@ -473,6 +487,42 @@ protected:
    */
   bool HasPHOSOverlap(const AliEMCALTriggerRawPatch &patch) const;
 
+  /**
+   * @brief Build the summed-area table of a data grid
+   *
+   * Entry (col, row) of the table is the sum of all channels with smaller
+   * column and row, the table has one more column and row than the grid.
+   * The number of non-zero channels is summed in parallel, so that patches
+   * without any signal come out with exactly zero ADC.
+   * @param[in] grid Data grid
+   * @param[out] sums Summed-area table of the ADC values
+   * @param[out] counts Summed-area table of the number of non-zero channels
+   */
+  void BuildIntegralImage(const AliEMCALTriggerDataGrid<double> &grid, std::vector<double> &sums, std::vector<int> &counts) const;
+
+  /**
+   * @brief Sum of a square patch from a summed-area table
+   *
+   * The patch is clipped at the borders of the grid.
+   * @param[in] sums Summed-area table of the ADC values
+   * @param[in] counts Summed-area table of the number of non-zero channels
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] size Patch size in FastORs
+   * @return Sum of the channels in the patch
+   */
+  double GetIntegralSum(const std::vector<double> &sums, const std::vector<int> &counts, int col, int row, int size) const;
+
+  /**
+   * @brief Find the patches of a trigger algorithm from the summed-area tables
+   * @param[in] config Algorithm configuration (rowmin, rowmax, bitmask, patch size, subregion size)
+   * @param[in] adcSums Summed-area table for the online/recalc ADC
+   * @param[in] adcCounts Non-zero channels for the online/recalc ADC
+   * @param[out] result Container the raw patches are appended to
+   */
+  void FindPatchesIntegral(const Int_t *config, const std::vector<double> &adcSums, const std::vector<int> &adcCounts,
+                           std::vector<AliEMCALTriggerRawPatch> &result) const;
+
   std::set<Short_t>                         fBadChannels;                 ///< Container of bad channels
   std::set<Short_t>                         fOfflineBadChannels;          ///< Abd ID of offline bad channels
   TArrayF                                   fFastORPedestal;              ///< FastOR pedestal
@@ -498,6 +548,9 @@ protected:
   TF1                                       *fSmearModelMean;             ///< Smearing parameterization for the mean
   TF1                                       *fSmearModelSigma;            ///< Smearing parameterization for the width
   Double_t                                  fSmearThreshold;              ///< Smear threshold: Only cell energies above threshold are smeared
+  Bool_t                                    fUseIntegralImage;            ///< Use the summed-area table patch search
+  std::vector<Int_t>                        fIntegralL1Algorithms;        ///< L1 algorithms for the summed-area table patch search, 5 entries each (rowmin, rowmax, bitmask, patch size, subregion size)
+  Int_t                                     fIntegralL0Algorithm[5];      ///< L0 algorithm for the summed-area table patch search, patch size 0 if not set
 
   const AliEMCALGeometry                    *fGeometry;                   //!<! Underlying EMCAL geometry
   AliEMCALTriggerDataGrid<double>           *fPatchAmplitudes;            //!<! TRU Amplitudes (for L0)
@@ -506,11 +559,21 @@ protected:
   AliEMCALTriggerDataGrid<double>           *fPatchEnergySimpleSmeared;   //!<! Data grid for smeared energy values from cell energies
   AliEMCALTriggerDataGrid<char>             *fLevel0TimeMap;              //!<! Map needed to store the level0 times
   AliEMCALTriggerDataGrid<int>              *fTriggerBitMap;              //!<! Map of trigger bits
+  std::vector<double>                       fIntegralADC;                 //!<! Summed-area table of the L1 ADC values
+  std::vector<double>                       fIntegralAmplitudes;          //!<! Summed-area table of the L0 amplitudes
+  std::vector<double>                       fIntegralADCSimple;           //!<! Summed-area table of the offline ADC values
+  std::vector<double>                       fIntegralEnergySmeared;       //!<! Summed-area table of the smeared energies
+  std::vector<int>                          fIntegralCountADC;            //!<! Non-zero channels of the L1 ADC values
+  std::vector<int>                          fIntegralCountAmplitudes;     //!<! Non-zero channels of the L0 amplitudes
+  std::vector<int>                          fIntegralCountADCSimple;      //!<! Non-zero channels of the offline ADC values
+  std::vector<int>                          fIntegralCountEnergySmeared;  //!<! Non-zero channels of the smeared energies
+  std::vector<AliEMCALTriggerRawPatch>      fL1RawPatches;                //!<! Pool of L1 raw patches, reused between events
+  std::vector<AliEMCALTriggerRawPatch>      fL0RawPatches;                //!<! Pool of L0 raw patches, reused between events
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -58,6 +58,7 @@ AliEmcalTriggerMakerTask::AliEmcalTriggerMakerTask():
   fUseL0Amplitudes(kFALSE),
   fLoadFastORMaskingFromOCDB(kFALSE),
   fCaloTriggersOut(0),
+  fPatchBuffer(),
   fDoQA(kFALSE),
   fQAHistos(NULL)
 {
@@ -75,6 +76,7 @@ AliEmcalTriggerMakerTask::AliEmcalTriggerMakerTask(const char *name, Bool_t doQA
   fUseL0Amplitudes(kFALSE),
   fLoadFastORMaskingFromOCDB(kFALSE),
   fCaloTriggersOut(NULL),
+  fPatchBuffer(),
   fDoQA(doQA),
   fQAHistos(NULL)
 {
@@ -286,7 +288,7 @@ Bool_t AliEmcalTriggerMakerTask::Run(){
     }
   }
 
-  std::vector<AliEMCALTriggerPatchInfo> patches;
+  std::vector<AliEMCALTriggerPatchInfo> &patches = fPatchBuffer;
   fTriggerMaker->CreateTriggerPatches(InputEvent(), patches, fUseL0Amplitudes);
   Int_t patchcounter = 0;
   TString triggerstring;
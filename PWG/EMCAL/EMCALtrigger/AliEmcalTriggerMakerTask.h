@@ -5,7 +5,9 @@
 
 #include "AliEmcalTriggerMakerKernel.h"
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEMCALTriggerPatchInfo.h"
 #include <TString.h>
+#include <vector>
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include <functional>
 #endif
@@ -13,7 +15,6 @@
 class TClonesArray;
 class THistManager;
 class AliVVZERO;
-class AliEMCALTriggerPatchInfo;
 
 /**
  * @class AliEmcalTriggerMakerTask
@@ -257,6 +258,7 @@ protected:
   Bool_t                                  fUseL0Amplitudes;           ///< Use L0 amplitudes instead of L1 time sum (useful for runs where STU was not read)
   Bool_t                                  fLoadFastORMaskingFromOCDB; ///< Load FastOR masking from the OCDB
   TClonesArray                            *fCaloTriggersOut;          //!<! trigger array out
+  std::vector<AliEMCALTriggerPatchInfo>   fPatchBuffer;               //!<! patches of the current event, reused between events
 
   Bool_t                                  fDoQA;                      ///< Fill QA histograms
   THistManager                            *fQAHistos;                 //!<! Histograms for QA
@@ -266,7 +268,7 @@ private:
   AliEmcalTriggerMakerTask &operator=(const AliEmcalTriggerMakerTask &);
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerTask, 2);
+  ClassDef(AliEmcalTriggerMakerTask, 3);
   /// \endcond
 };
 
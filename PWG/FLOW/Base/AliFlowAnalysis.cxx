@@ -31,7 +31,8 @@ ClassImp(AliFlowAnalysis)
 AliFlowAnalysis::AliFlowAnalysis(const char* name):
 TNamed(name,name),
 fEventCuts(NULL),
-fPOItype(1)
+fPOItype(1),
+fDriver(NULL)
 {
   //ctor
 }
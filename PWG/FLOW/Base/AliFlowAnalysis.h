@@ -8,6 +8,7 @@
 
 class AliFlowEventSimple;
 class AliFlowEventSimpleCuts;
+class AliFlowAnalysisDriver;
 class TList;
 class TDirectoryFile;
 #include "TNamed.h"
@@ -39,15 +40,19 @@ class AliFlowAnalysis : public TNamed {
    void SetEventCuts(AliFlowEventSimpleCuts* cuts) {fEventCuts=cuts;}
    AliFlowEventSimpleCuts* GetEventCuts() const {return fEventCuts;}
 
+   void SetDriver(const AliFlowAnalysisDriver* driver) {fDriver=driver;}
+   const AliFlowAnalysisDriver* GetDriver() const {return fDriver;} //shared per-event quantities, NULL if run alone
+
  protected:
    AliFlowEventSimpleCuts* fEventCuts;  //some analysis level event cuts
    Int_t fPOItype;                       //which POI type are we processing in this analysis?
+   const AliFlowAnalysisDriver* fDriver; //! driver running this analysis together with others
  
  private:
    AliFlowAnalysis(const AliFlowAnalysis& anAnalysis);            //copy constructor
    AliFlowAnalysis& operator=(const AliFlowAnalysis& anAnalysis); //assignment operator
 
-   ClassDef(AliFlowAnalysis,1)  // class version
+   ClassDef(AliFlowAnalysis,2)  // class version
 };
  
 #endif
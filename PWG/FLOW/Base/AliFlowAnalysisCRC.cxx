@@ -45,6 +45,7 @@
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisCRC.h"
+#include "AliFlowQVectorBuilder.h"
 #include "AliLog.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -148,6 +149,10 @@ fUseQvectorTerms(kFALSE),
 fReQ(NULL),
 fImQ(NULL),
 fSpk(NULL),
+fQVectorBuilder(NULL),
+fTrackCosH(),
+fTrackSinH(),
+fTrackWPow(),
 fReQGF(NULL),
 fImQGF(NULL),
 fIntFlowCorrelationsEBE(NULL),
@@ -425,6 +430,7 @@ AliFlowAnalysisCRC::~AliFlowAnalysisCRC()
   delete[] fchisqVA;
   delete[] fchisqVC;
   if(fPhiExclZoneHist) delete fPhiExclZoneHist;
+  delete fQVectorBuilder;
 } // end of AliFlowAnalysisCRC::~AliFlowAnalysisCRC()
 
 //================================================================================================================
@@ -744,6 +750,17 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
   // loop over particles **********************************************************************************************
 
+  if(fQVectorBuilder->GetBaseHarmonic() != n){fQVectorBuilder->Configure(12,8,n);}
+  fQVectorBuilder->Reset();
+  // per-track tables of cos(h*phi), sin(h*phi) and w^k, filled once per RP and POI and used by all the fills below:
+  const Int_t nTrackHar = TMath::Max(TMath::Max(20,4*n),TMath::Max(fCRCnHar,fFlowNHarmMax));
+  const Int_t nTrackPow = TMath::Max(8,fFlowNHarmMax);
+  fTrackCosH.resize(nTrackHar+1);
+  fTrackSinH.resize(nTrackHar+1);
+  fTrackWPow.resize(nTrackPow+1);
+  Double_t *dCosH = &fTrackCosH[0];
+  Double_t *dSinH = &fTrackSinH[0];
+  Double_t *dWPow = &fTrackWPow[0];
   for(Int_t i=0;i<nPrim;i++) {
     if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
     aftsTrack=anEvent->GetTrack(i);
@@ -817,26 +834,13 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           if(fPhiExclZoneHist->GetBinContent(fPhiExclZoneHist->FindBin(dEta,dPhi))<0.5) continue;
         }
 
-        // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-        for(Int_t m=0;m<12;m++) // to be improved - hardwired 6
-        {
-          for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-          {
-            (*fReQ)(m,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi);
-            (*fImQ)(m,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi);
-          }
-        }
-        // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-        for(Int_t p=0;p<8;p++)
-        {
-          for(Int_t k=0;k<9;k++)
-          {
-            (*fSpk)(p,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k);
-          }
-        }
+        // Pack this RP for Re[Q_{m*n,k}], Im[Q_{m*n,k}] (m = 1,2,...,12, k = 0,1,...,8) and S_{p,k}, calculated after the loop over data bellow:
+        fQVectorBuilder->AddTrack(dPhi,wPhiEta*wPhi*wPt*wEta*wTrack);
         // Differential flow:
         if(fCalculateDiffFlow || fCalculate2DDiffFlow)
         {
+          AliFlowQVectorBuilder::Harmonics(dPhi,nTrackHar,dCosH,dSinH);
+          AliFlowQVectorBuilder::Powers(wPhiEta*wPhi*wPt*wEta*wTrack,nTrackPow,dWPow);
           ptEta[0] = dPt;
           ptEta[1] = dEta;
           // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs):
@@ -848,21 +852,21 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
               {
                 for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
                 {
-                  fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                  fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                  fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],dWPow[k]*dCosH[(m+1)*n],1.);
+                  fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],dWPow[k]*dSinH[(m+1)*n],1.);
                   if(m==0) // s_{p,k} does not depend on index m
                   {
-                    fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                    fs1dEBE[0][pe][k]->Fill(ptEta[pe],dWPow[k],1.);
                   } // end of if(m==0) // s_{p,k} does not depend on index m
                 } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
               } // end of if(fCalculateDiffFlow)
               if(fCalculate2DDiffFlow)
               {
-                fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,dWPow[k]*dCosH[(m+1)*n],1.);
+                fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,dWPow[k]*dSinH[(m+1)*n],1.);
                 if(m==0) // s_{p,k} does not depend on index m
                 {
-                  fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                  fs2dEBE[0][k]->Fill(dPt,dEta,dWPow[k],1.);
                 } // end of if(m==0) // s_{p,k} does not depend on index m
               } // end of if(fCalculate2DDiffFlow)
             } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -879,21 +883,21 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                 {
                   for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
                   {
-                    fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                    fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                    fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],dWPow[k]*dCosH[(m+1)*n],1.);
+                    fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],dWPow[k]*dSinH[(m+1)*n],1.);
                     if(m==0) // s_{p,k} does not depend on index m
                     {
-                      fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                      fs1dEBE[2][pe][k]->Fill(ptEta[pe],dWPow[k],1.);
                     } // end of if(m==0) // s_{p,k} does not depend on index m
                   } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
                 } // end of if(fCalculateDiffFlow)
                 if(fCalculate2DDiffFlow)
                 {
-                  fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                  fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                  fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,dWPow[k]*dCosH[(m+1)*n],1.);
+                  fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,dWPow[k]*dSinH[(m+1)*n],1.);
                   if(m==0) // s_{p,k} does not depend on index m
                   {
-                    fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
+                    fs2dEBE[2][k]->Fill(dPt,dEta,dWPow[k],1.);
                   } // end of if(m==0) // s_{p,k} does not depend on index m
                 } // end of if(fCalculate2DDiffFlow)
               } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
@@ -991,6 +995,9 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           if(dPhi>2.136283 && dPhi<2.324779) continue;
         }
 
+        AliFlowQVectorBuilder::Harmonics(dPhi,nTrackHar,dCosH,dSinH);
+        AliFlowQVectorBuilder::Powers(wPhiEta*wPhi*wPt*wEta*wTrack,nTrackPow,dWPow); // wPhi, wPt, wEta and wTrack are 1 here, the SP and CRC fills use the same powers of wPhiEta
+
         // Generic Framework: Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
         Double_t MaxPtCut = 3.;
         if(fMinMulZN==99) MaxPtCut = 1.;
@@ -999,8 +1006,8 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           {
             for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
             {
-              (*fReQGF)(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos(m*dPhi);
-              (*fImQGF)(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin(m*dPhi);
+              (*fReQGF)(m,k) += dWPow[k]*dCosH[m];
+              (*fImQGF)(m,k) += dWPow[k]*dSinH[m];
             }
           }
         }
@@ -1018,8 +1025,8 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           {
             for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
             {
-              (*fReQGFPt[ptb])(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos(m*dPhi);
-              (*fImQGFPt[ptb])(m,k) += pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin(m*dPhi);
+              (*fReQGFPt[ptb])(m,k) += dWPow[k]*dCosH[m];
+              (*fImQGFPt[ptb])(m,k) += dWPow[k]*dSinH[m];
             }
           }
         }
@@ -1035,14 +1042,14 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
             {
               for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
               {
-                fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+                fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],dWPow[k]*dCosH[(m+1)*n],1.);
+                fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],dWPow[k]*dSinH[(m+1)*n],1.);
               } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
             } // end of if(fCalculateDiffFlow)
             if(fCalculate2DDiffFlow)
             {
-              fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-              fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
+              fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,dWPow[k]*dCosH[(m+1)*n],1.);
+              fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,dWPow[k]*dSinH[(m+1)*n],1.);
             } // end of if(fCalculate2DDiffFlow)
           } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
         } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
@@ -1050,31 +1057,31 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         // Charge-Rapidity Correlations
         for (Int_t h=0;h<fCRCnHar;h++) {
 
-          fCRCQRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fCRCQIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fCRCQRe[cw][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+          fCRCQIm[cw][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
           fCRCMult[cw][h]->Fill(dEta,wPhiEta);
 
-          fCRC2QRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fCRC2QIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
-          fCRC2Mul[cw][h]->Fill(dEta,pow(wPhiEta,h));
+          fCRC2QRe[cw][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+          fCRC2QIm[cw][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
+          fCRC2Mul[cw][h]->Fill(dEta,dWPow[h]);
 
-          fCRCZDCQRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fCRCZDCQIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fCRCZDCQRe[cw][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+          fCRCZDCQIm[cw][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
           fCRCZDCMult[cw][h]->Fill(dEta,wPhiEta);
 
           if(fRandom->Integer(2)>0.5) {
-            fCRC2QRe[2][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCRC2QIm[2][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
-            fCRC2Mul[2][h]->Fill(dEta,pow(wPhiEta,h));
+            fCRC2QRe[2][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+            fCRC2QIm[2][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
+            fCRC2Mul[2][h]->Fill(dEta,dWPow[h]);
           }
 
           if(fRandom->Integer(2)>0.5) {
-            fCRCZDCQRe[2][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCRCZDCQIm[2][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCRCZDCQRe[2][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+            fCRCZDCQIm[2][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
             fCRCZDCMult[2][h]->Fill(dEta,wPhiEta);
           } else {
-            fCRCZDCQRe[3][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCRCZDCQIm[3][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCRCZDCQRe[3][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+            fCRCZDCQIm[3][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
             fCRCZDCMult[3][h]->Fill(dEta,wPhiEta);
           }
 
@@ -1084,11 +1091,11 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
               Double_t weraw = fZDCESESpecWeightsHist[fZDCESEclEbE]->GetBinContent(fZDCESESpecWeightsHist[fZDCESEclEbE]->FindBin(fCentralityEBE,dPt));
               if(weraw > 0.) SpecWeig = 1./weraw;
             }
-            fCMEQRe[cw][h]->Fill(dEta,SpecWeig*wPhiEta*TMath::Cos((h+1.)*dPhi));
-            fCMEQIm[cw][h]->Fill(dEta,SpecWeig*wPhiEta*TMath::Sin((h+1.)*dPhi));
+            fCMEQRe[cw][h]->Fill(dEta,SpecWeig*wPhiEta*dCosH[h+1]);
+            fCMEQIm[cw][h]->Fill(dEta,SpecWeig*wPhiEta*dSinH[h+1]);
             fCMEMult[cw][h]->Fill(dEta,SpecWeig*wPhiEta);
-            fCMEQRe[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*TMath::Cos((h+1.)*dPhi));
-            fCMEQIm[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*TMath::Sin((h+1.)*dPhi));
+            fCMEQRe[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*dCosH[h+1]);
+            fCMEQIm[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.)*dSinH[h+1]);
             fCMEMult[2+cw][h]->Fill(dEta,pow(SpecWeig*wPhiEta,2.));
 
             // spectra
@@ -1105,42 +1112,42 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
             if(fFlowQCDeltaEta>0.) {
 
-              fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
+              fPOIPtDiffQRe[k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+              fPOIPtDiffQIm[k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+              fPOIPtDiffMul[k][h]->Fill(dPt,dWPow[k]);
 
-              fPOIPtDiffQReCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPtDiffQImCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPtDiffMulCh[cw][k][h]->Fill(dPt,pow(wPhiEta,k));
+              fPOIPtDiffQReCh[cw][k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+              fPOIPtDiffQImCh[cw][k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+              fPOIPtDiffMulCh[cw][k][h]->Fill(dPt,dWPow[k]);
 
-              fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
+              fPOIPhiDiffQRe[k][h]->Fill(dPhi,dWPow[k]*dCosH[h+1]);
+              fPOIPhiDiffQIm[k][h]->Fill(dPhi,dWPow[k]*dSinH[h+1]);
+              fPOIPhiDiffMul[k][h]->Fill(dPhi,dWPow[k]);
 
-              fPOIPhiEtaDiffQRe[k][h]->Fill(dPhi,dEta,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-              fPOIPhiEtaDiffQIm[k][h]->Fill(dPhi,dEta,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-              fPOIPhiEtaDiffMul[k][h]->Fill(dPhi,dEta,pow(wPhiEta,k));
+              fPOIPhiEtaDiffQRe[k][h]->Fill(dPhi,dEta,dWPow[k]*dCosH[h+1]);
+              fPOIPhiEtaDiffQIm[k][h]->Fill(dPhi,dEta,dWPow[k]*dSinH[h+1]);
+              fPOIPhiEtaDiffMul[k][h]->Fill(dPhi,dEta,dWPow[k]);
 
               if(fabs(dEta)>fFlowQCDeltaEta/2.) {
                 Int_t keta = (dEta<0.?0:1);
-                fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
-                fPOIPhiDiffQReEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQImEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMulEG[keta][k][h]->Fill(dPhi,pow(wPhiEta,k));
+                fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+                fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+                fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,dWPow[k]);
+                fPOIPhiDiffQReEG[keta][k][h]->Fill(dPhi,dWPow[k]*dCosH[h+1]);
+                fPOIPhiDiffQImEG[keta][k][h]->Fill(dPhi,dWPow[k]*dSinH[h+1]);
+                fPOIPhiDiffMulEG[keta][k][h]->Fill(dPhi,dWPow[k]);
               }
 
             } else if(fFlowQCDeltaEta<0. && fFlowQCDeltaEta>-1.) {
 
               if(dEta>0.) {
-                fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
+                fPOIPtDiffQRe[k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+                fPOIPtDiffQIm[k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+                fPOIPtDiffMul[k][h]->Fill(dPt,dWPow[k]);
 
-                fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
+                fPOIPhiDiffQRe[k][h]->Fill(dPhi,dWPow[k]*dCosH[h+1]);
+                fPOIPhiDiffQIm[k][h]->Fill(dPhi,dWPow[k]*dSinH[h+1]);
+                fPOIPhiDiffMul[k][h]->Fill(dPhi,dWPow[k]);
 
                 Double_t boundetagap = fabs(fFlowQCDeltaEta);
 
@@ -1148,9 +1155,9 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                   Int_t keta;
                   if(dEta>0. && dEta<0.4-boundetagap/2.) keta = 0;
                   else keta = 1;
-                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
+                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,dWPow[k]);
                 }
               } else {
                 bFillDis = kFALSE;
@@ -1160,13 +1167,13 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
             } else if(fFlowQCDeltaEta<-1. && fFlowQCDeltaEta>-2.) {
 
               if(dEta<0.) {
-                fPOIPtDiffQRe[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPtDiffQIm[k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPtDiffMul[k][h]->Fill(dPt,pow(wPhiEta,k));
+                fPOIPtDiffQRe[k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+                fPOIPtDiffQIm[k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+                fPOIPtDiffMul[k][h]->Fill(dPt,dWPow[k]);
 
-                fPOIPhiDiffQRe[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                fPOIPhiDiffQIm[k][h]->Fill(dPhi,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                fPOIPhiDiffMul[k][h]->Fill(dPhi,pow(wPhiEta,k));
+                fPOIPhiDiffQRe[k][h]->Fill(dPhi,dWPow[k]*dCosH[h+1]);
+                fPOIPhiDiffQIm[k][h]->Fill(dPhi,dWPow[k]*dSinH[h+1]);
+                fPOIPhiDiffMul[k][h]->Fill(dPhi,dWPow[k]);
 
                 Double_t boundetagap = fabs(fFlowQCDeltaEta)-1.;
 
@@ -1174,9 +1181,9 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
                   Int_t keta;
                   if(dEta<0. && dEta>-0.4+boundetagap/2.) keta = 0;
                   else keta = 1;
-                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Cos((h+1.)*dPhi));
-                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k)*TMath::Sin((h+1.)*dPhi));
-                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,pow(wPhiEta,k));
+                  fPOIPtDiffQReEG[keta][k][h]->Fill(dPt,dWPow[k]*dCosH[h+1]);
+                  fPOIPtDiffQImEG[keta][k][h]->Fill(dPt,dWPow[k]*dSinH[h+1]);
+                  fPOIPtDiffMulEG[keta][k][h]->Fill(dPt,dWPow[k]);
                 }
               } else {
                 bFillDis = kFALSE;
@@ -1188,11 +1195,11 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         }
 
         for (Int_t h=0;h<fFlowNHarmMax;h++) {
-          fEtaDiffQRe[cw][h]->Fill(dEta,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fEtaDiffQIm[cw][h]->Fill(dEta,wPhiEta*TMath::Sin((h+1.)*dPhi));
-          fEtaDiffMul[cw][h]->Fill(dEta,pow(wPhiEta,h+1));
-          fPOIEtaPtQRe[cw][h]->Fill(dEta,dPt,wPhiEta*TMath::Cos((h+1.)*dPhi));
-          fPOIEtaPtQIm[cw][h]->Fill(dEta,dPt,wPhiEta*TMath::Sin((h+1.)*dPhi));
+          fEtaDiffQRe[cw][h]->Fill(dEta,wPhiEta*dCosH[h+1]);
+          fEtaDiffQIm[cw][h]->Fill(dEta,wPhiEta*dSinH[h+1]);
+          fEtaDiffMul[cw][h]->Fill(dEta,dWPow[h+1]);
+          fPOIEtaPtQRe[cw][h]->Fill(dEta,dPt,wPhiEta*dCosH[h+1]);
+          fPOIEtaPtQIm[cw][h]->Fill(dEta,dPt,wPhiEta*dSinH[h+1]);
           fPOIEtaPtMul[cw][h]->Fill(dEta,dPt,wPhiEta);
         }
 
@@ -1205,14 +1212,14 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
         if(bFillDis && bPassZDCcuts && fCalculateFlowZDC && fUseZDC) {
 
-          fFlowSPZDCv1etaPro[fCenBin][0][7]->Fill(dEta,TMath::Cos(dPhi)*ZARe+TMath::Sin(dPhi)*ZAIm,wPhiEta);
-          fFlowSPZDCv1etaPro[fCenBin][0][8]->Fill(dEta,TMath::Cos(dPhi)*ZCRe+TMath::Sin(dPhi)*ZCIm,wPhiEta);
+          fFlowSPZDCv1etaPro[fCenBin][0][7]->Fill(dEta,dCosH[1]*ZARe+dSinH[1]*ZAIm,wPhiEta);
+          fFlowSPZDCv1etaPro[fCenBin][0][8]->Fill(dEta,dCosH[1]*ZCRe+dSinH[1]*ZCIm,wPhiEta);
           if(cw==0) {
-            fFlowSPZDCv1etaPro[fCenBin][0][9]->Fill(dEta,TMath::Cos(dPhi)*ZARe+TMath::Sin(dPhi)*ZAIm,wPhiEta);
-            fFlowSPZDCv1etaPro[fCenBin][0][10]->Fill(dEta,TMath::Cos(dPhi)*ZCRe+TMath::Sin(dPhi)*ZCIm,wPhiEta);
+            fFlowSPZDCv1etaPro[fCenBin][0][9]->Fill(dEta,dCosH[1]*ZARe+dSinH[1]*ZAIm,wPhiEta);
+            fFlowSPZDCv1etaPro[fCenBin][0][10]->Fill(dEta,dCosH[1]*ZCRe+dSinH[1]*ZCIm,wPhiEta);
           } else {
-            fFlowSPZDCv1etaPro[fCenBin][0][11]->Fill(dEta,TMath::Cos(dPhi)*ZARe+TMath::Sin(dPhi)*ZAIm,wPhiEta);
-            fFlowSPZDCv1etaPro[fCenBin][0][12]->Fill(dEta,TMath::Cos(dPhi)*ZCRe+TMath::Sin(dPhi)*ZCIm,wPhiEta);
+            fFlowSPZDCv1etaPro[fCenBin][0][11]->Fill(dEta,dCosH[1]*ZARe+dSinH[1]*ZAIm,wPhiEta);
+            fFlowSPZDCv1etaPro[fCenBin][0][12]->Fill(dEta,dCosH[1]*ZCRe+dSinH[1]*ZCIm,wPhiEta);
           }
 
         }
@@ -1221,8 +1228,8 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         fCRCQVecPhiHist->Fill(fCentralityEBE,dPhi,dEta,wPhiEta);
         fCRCQVecPhiHistCh[cw]->Fill(fCentralityEBE,dPhi,dEta,wPhiEta);
         for (Int_t h=0;h<6;h++) {
-          fCRCQVecHarCosProCh[cw]->Fill(fCentralityEBE,(Double_t)h+0.5,dEta,TMath::Cos((h+1.)*dPhi),wPhiEta);
-          fCRCQVecHarSinProCh[cw]->Fill(fCentralityEBE,(Double_t)h+0.5,dEta,TMath::Sin((h+1.)*dPhi),wPhiEta);
+          fCRCQVecHarCosProCh[cw]->Fill(fCentralityEBE,(Double_t)h+0.5,dEta,dCosH[h+1],wPhiEta);
+          fCRCQVecHarSinProCh[cw]->Fill(fCentralityEBE,(Double_t)h+0.5,dEta,dSinH[h+1],wPhiEta);
         }
         Double_t FillCw = (fbFlagIsPosMagField==kTRUE?(cw==0?0.5:1.5):(cw==0?2.5:3.5));
         if(fCentralityEBE>5. && fCentralityEBE<40.) {
@@ -1249,11 +1256,14 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
 
   // ************************************************************************************************************
 
-  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
+  // e) Calculate Q_{m*n,k} and S_{p,k} from the packed RPs and the final expressions for S_{p,k} and s_{p,k} (important !!!!):
+  fQVectorBuilder->Build();
+  fQVectorBuilder->FillMatrices(*fReQ,*fImQ);
   for(Int_t p=0;p<8;p++)
   {
     for(Int_t k=0;k<9;k++)
     {
+      (*fSpk)(p,k)+=fQVectorBuilder->SumOfWeights(k);
       (*fSpk)(p,k)=pow((*fSpk)(p,k),p+1);
     }
   }
@@ -2495,6 +2505,7 @@ void AliFlowAnalysisCRC::BookEverythingForIntegratedFlow()
   fReQ = new TMatrixD(12,9);
   fImQ = new TMatrixD(12,9);
   fSpk = new TMatrixD(8,9);
+  fQVectorBuilder = new AliFlowQVectorBuilder(12,8,fHarmonic);
   fReQGF = new TMatrixD(21,9);
   fImQGF = new TMatrixD(21,9);
   for(Int_t i=0; i<fkGFPtB; i++) {
@@ -5363,6 +5374,7 @@ void AliFlowAnalysisCRC::InitializeArraysForQVec()
     for(Int_t k=0; k<4; k++) {
       fZDCVtxCenHist[c][k] = NULL;
     }
+    fZDCVtxCenRecOffset[c] = -1;
     for(Int_t k=0; k<8; k++) {
       fZDCVtxCenHistMagPol[c][k] = NULL;
     }
@@ -7064,6 +7076,7 @@ void AliFlowAnalysisCRC::RecenterCRCQVecZDC()
       }
     }
 
+    FillZDCRecenteringTables();
   }
 
   if(!fQAZDCCutsFlag) return;
@@ -7097,15 +7110,23 @@ void AliFlowAnalysisCRC::RecenterCRCQVecZDC()
 
   // recenter vs centrality
   if (fZDCQHist[0]) {
-    Double_t AvQCRe = fZDCQHist[0]->GetBinContent(fZDCQHist[0]->FindBin(fCentralityEBE));
-    Double_t SDQCRe = fZDCQHist[0]->GetBinError(fZDCQHist[0]->FindBin(fCentralityEBE));
-    Double_t AvQCIm = fZDCQHist[1]->GetBinContent(fZDCQHist[1]->FindBin(fCentralityEBE));
-    Double_t SDQCIm = fZDCQHist[1]->GetBinError(fZDCQHist[1]->FindBin(fCentralityEBE));
-
-    Double_t AvQARe = fZDCQHist[2]->GetBinContent(fZDCQHist[2]->FindBin(fCentralityEBE));
-    Double_t SDQARe = fZDCQHist[2]->GetBinError(fZDCQHist[2]->FindBin(fCentralityEBE));
-    Double_t AvQAIm = fZDCQHist[3]->GetBinContent(fZDCQHist[3]->FindBin(fCentralityEBE));
-    Double_t SDQAIm = fZDCQHist[3]->GetBinError(fZDCQHist[3]->FindBin(fCentralityEBE));
+    Double_t AvQ[4], SDQ[4];
+    if(!fZDCQRecTable.empty()) {
+      const Double_t *rec = &fZDCQRecTable[8*fZDCQHist[0]->FindBin(fCentralityEBE)];
+      for(Int_t k=0; k<4; k++) {
+        AvQ[k] = rec[2*k];
+        SDQ[k] = rec[2*k+1];
+      }
+    } else {
+      for(Int_t k=0; k<4; k++) {
+        AvQ[k] = fZDCQHist[k]->GetBinContent(fZDCQHist[k]->FindBin(fCentralityEBE));
+        SDQ[k] = fZDCQHist[k]->GetBinError(fZDCQHist[k]->FindBin(fCentralityEBE));
+      }
+    }
+    Double_t AvQCRe = AvQ[0], SDQCRe = SDQ[0];
+    Double_t AvQCIm = AvQ[1], SDQCIm = SDQ[1];
+    Double_t AvQARe = AvQ[2], SDQARe = SDQ[2];
+    Double_t AvQAIm = AvQ[3], SDQAIm = SDQ[3];
 
     if(AvQCRe && AvQCIm && QMC>0. && sqrt(QCRe*QCRe+QCIm*QCIm)>1.E-6) {
       QCReR = QCRe-AvQCRe;
@@ -7156,30 +7177,30 @@ void AliFlowAnalysisCRC::RecenterCRCQVecZDC()
     if(fVtxPosCor[1] < fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetXmin() || fVtxPosCor[1] > fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetXmax()) withinvtx = kFALSE;
     if(fVtxPosCor[2] < fZDCVtxCenHist[fCenBin][0]->GetZaxis()->GetXmin() || fVtxPosCor[2] > fZDCVtxCenHist[fCenBin][0]->GetZaxis()->GetXmax()) withinvtx = kFALSE;
 
-    if(withinvtx) {
-      QCReR -= fZDCVtxCenHist[fCenBin][0]->GetBinContent(fZDCVtxCenHist[fCenBin][0]->FindBin(fVtxPosCor[0],fVtxPosCor[1],fVtxPosCor[2]));
-      QCImR -= fZDCVtxCenHist[fCenBin][1]->GetBinContent(fZDCVtxCenHist[fCenBin][1]->FindBin(fVtxPosCor[0],fVtxPosCor[1],fVtxPosCor[2]));
-      fZDCFlowVect[0].Set(QCReR,QCImR);
-      QAReR -= fZDCVtxCenHist[fCenBin][2]->GetBinContent(fZDCVtxCenHist[fCenBin][2]->FindBin(fVtxPosCor[0],fVtxPosCor[1],fVtxPosCor[2]));
-      QAImR -= fZDCVtxCenHist[fCenBin][3]->GetBinContent(fZDCVtxCenHist[fCenBin][3]->FindBin(fVtxPosCor[0],fVtxPosCor[1],fVtxPosCor[2]));
-      fZDCFlowVect[1].Set(QAReR,QAImR);
-    } else {
-      Double_t vx = fVtxPosCor[0];
-      Double_t vy = fVtxPosCor[1];
-      Double_t vz = fVtxPosCor[2];
+    Double_t vx = fVtxPosCor[0];
+    Double_t vy = fVtxPosCor[1];
+    Double_t vz = fVtxPosCor[2];
+    if(!withinvtx) {
       if(fVtxPosCor[0] < fZDCVtxCenHist[fCenBin][0]->GetXaxis()->GetXmin()) vx = fZDCVtxCenHist[fCenBin][0]->GetXaxis()->GetBinCenter(1);
       if(fVtxPosCor[0] > fZDCVtxCenHist[fCenBin][0]->GetXaxis()->GetXmax()) vx = fZDCVtxCenHist[fCenBin][0]->GetXaxis()->GetBinCenter(fZDCVtxCenHist[fCenBin][0]->GetNbinsX());
       if(fVtxPosCor[1] < fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetXmin()) vy = fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetBinCenter(1);
       if(fVtxPosCor[1] > fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetXmax()) vy = fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetBinCenter(fZDCVtxCenHist[fCenBin][0]->GetNbinsY());
       if(fVtxPosCor[2] < fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetXmin()) vz = fZDCVtxCenHist[fCenBin][0]->GetZaxis()->GetBinCenter(1);
       if(fVtxPosCor[2] > fZDCVtxCenHist[fCenBin][0]->GetYaxis()->GetXmax()) vz = fZDCVtxCenHist[fCenBin][0]->GetZaxis()->GetBinCenter(fZDCVtxCenHist[fCenBin][0]->GetNbinsZ());
-      QCReR -= fZDCVtxCenHist[fCenBin][0]->GetBinContent(fZDCVtxCenHist[fCenBin][0]->FindBin(vx,vy,vz));
-      QCImR -= fZDCVtxCenHist[fCenBin][1]->GetBinContent(fZDCVtxCenHist[fCenBin][1]->FindBin(vx,vy,vz));
-      fZDCFlowVect[0].Set(QCReR,QCImR);
-      QAReR -= fZDCVtxCenHist[fCenBin][2]->GetBinContent(fZDCVtxCenHist[fCenBin][2]->FindBin(vx,vy,vz));
-      QAImR -= fZDCVtxCenHist[fCenBin][3]->GetBinContent(fZDCVtxCenHist[fCenBin][3]->FindBin(vx,vy,vz));
-      fZDCFlowVect[1].Set(QAReR,QAImR);
     }
+    Double_t AvQ[4];
+    if(fZDCVtxCenRecOffset[fCenBin]>=0) {
+      const Double_t *rec = &fZDCVtxCenRecTable[fZDCVtxCenRecOffset[fCenBin]+4*fZDCVtxCenHist[fCenBin][0]->FindBin(vx,vy,vz)];
+      for(Int_t k=0; k<4; k++) AvQ[k] = rec[k];
+    } else {
+      for(Int_t k=0; k<4; k++) AvQ[k] = fZDCVtxCenHist[fCenBin][k]->GetBinContent(fZDCVtxCenHist[fCenBin][k]->FindBin(vx,vy,vz));
+    }
+    QCReR -= AvQ[0];
+    QCImR -= AvQ[1];
+    fZDCFlowVect[0].Set(QCReR,QCImR);
+    QAReR -= AvQ[2];
+    QAImR -= AvQ[3];
+    fZDCFlowVect[1].Set(QAReR,QAImR);
   }
 
   fillstep=2.5;
@@ -7707,6 +7728,55 @@ Bool_t AliFlowAnalysisCRC::PassCutZDCQVecDis(Double_t ZCRe, Double_t ZCIm, Doubl
 
 //=======================================================================================================================
 
+void AliFlowAnalysisCRC::FillZDCRecenteringTables()
+{
+  // Flatten the run-by-run ZDC recentering profiles once per run, so that each event needs
+  // a single FindBin per step for the four components (ZNC Re, Im, ZNA Re, Im).
+  // A step is tabulated only if its four profiles share the binning, otherwise the profiles are used directly.
+
+  fZDCQRecTable.clear();
+  if(fZDCQHist[0] && fZDCQHist[1] && fZDCQHist[2] && fZDCQHist[3]) {
+    const Int_t ncells = fZDCQHist[0]->GetNcells();
+    Bool_t same = kTRUE;
+    for(Int_t k=1; k<4; k++) {
+      if(fZDCQHist[k]->GetNcells()!=ncells || fZDCQHist[k]->GetXaxis()->GetXmin()!=fZDCQHist[0]->GetXaxis()->GetXmin()
+         || fZDCQHist[k]->GetXaxis()->GetXmax()!=fZDCQHist[0]->GetXaxis()->GetXmax()) same = kFALSE;
+    }
+    if(same) {
+      fZDCQRecTable.resize(8*ncells);
+      for(Int_t b=0; b<ncells; b++) {
+        for(Int_t k=0; k<4; k++) {
+          fZDCQRecTable[8*b+2*k]   = fZDCQHist[k]->GetBinContent(b);
+          fZDCQRecTable[8*b+2*k+1] = fZDCQHist[k]->GetBinError(b);
+        }
+      }
+    }
+  }
+
+  fZDCVtxCenRecTable.clear();
+  for(Int_t c=0; c<10; c++) {
+    fZDCVtxCenRecOffset[c] = -1;
+    if(!fZDCVtxCenHist[c][0] || !fZDCVtxCenHist[c][1] || !fZDCVtxCenHist[c][2] || !fZDCVtxCenHist[c][3]) continue;
+    const Int_t ncells = fZDCVtxCenHist[c][0]->GetNcells();
+    Bool_t same = kTRUE;
+    for(Int_t k=1; k<4; k++) {
+      if(fZDCVtxCenHist[c][k]->GetNcells()!=ncells
+         || fZDCVtxCenHist[c][k]->GetXaxis()->GetXmin()!=fZDCVtxCenHist[c][0]->GetXaxis()->GetXmin() || fZDCVtxCenHist[c][k]->GetXaxis()->GetXmax()!=fZDCVtxCenHist[c][0]->GetXaxis()->GetXmax()
+         || fZDCVtxCenHist[c][k]->GetYaxis()->GetXmin()!=fZDCVtxCenHist[c][0]->GetYaxis()->GetXmin() || fZDCVtxCenHist[c][k]->GetYaxis()->GetXmax()!=fZDCVtxCenHist[c][0]->GetYaxis()->GetXmax()
+         || fZDCVtxCenHist[c][k]->GetZaxis()->GetXmin()!=fZDCVtxCenHist[c][0]->GetZaxis()->GetXmin() || fZDCVtxCenHist[c][k]->GetZaxis()->GetXmax()!=fZDCVtxCenHist[c][0]->GetZaxis()->GetXmax()) same = kFALSE;
+    }
+    if(!same) continue;
+    fZDCVtxCenRecOffset[c] = fZDCVtxCenRecTable.size();
+    fZDCVtxCenRecTable.resize(fZDCVtxCenRecTable.size()+4*ncells);
+    Double_t *rec = &fZDCVtxCenRecTable[fZDCVtxCenRecOffset[c]];
+    for(Int_t b=0; b<ncells; b++) {
+      for(Int_t k=0; k<4; k++) rec[4*b+k] = fZDCVtxCenHist[c][k]->GetBinContent(b);
+    }
+  }
+}
+
+//=======================================================================================================================
+
 void AliFlowAnalysisCRC::PassQAZDCCuts()
 {
   // VZ eta < 0
@@ -30,6 +30,7 @@
 #include "AliFlowCommonConstants.h"
 #include "TNamed.h"
 #include <complex>
+#include <vector>
 #include <cmath>
 
 class TObjArray;
@@ -52,6 +53,7 @@ class AliFlowCommonConstants;
 class AliFlowCommonHist;
 class AliFlowCommonHistResults;
 class AliFlowVector;
+class AliFlowQVectorBuilder;
 
 //==============================================================================================================
 
@@ -222,6 +224,7 @@ public:
   // 2i.) Charge-Rapidity Correlations
   virtual void RecenterCRCQVec();
   virtual void RecenterCRCQVecZDC();
+  virtual void FillZDCRecenteringTables();
   virtual void RecenterCRCQVecVZERO();
   virtual void PassQAZDCCuts();
   virtual Bool_t PassCutZDCQVecDis(Double_t ZCRe, Double_t ZCIm, Double_t ZARe, Double_t ZAIm);
@@ -1284,6 +1287,10 @@ private:
   TMatrixD *fReQ; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQ; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   TMatrixD *fSpk; //! fSM[p][k] = (sum_{i=1}^{M} w_{i}^{k})^{p+1}
+  AliFlowQVectorBuilder *fQVectorBuilder; //! fills fReQ, fImQ and fSpk from the packed RPs in one pass
+  std::vector<Double_t> fTrackCosH; //! cos(h*phi) of the current track, shared by the QC, GF, CRC, CME and SP fills
+  std::vector<Double_t> fTrackSinH; //! sin(h*phi) of the current track
+  std::vector<Double_t> fTrackWPow; //! powers of the weight of the current track
   TMatrixD *fReQGF; //! fReQ[m][k] = sum_{i=1}^{M} w_{i}^{k} cos(m*phi_{i})
   TMatrixD *fImQGF; //! fImQ[m][k] = sum_{i=1}^{M} w_{i}^{k} sin(m*phi_{i})
   const static Int_t fkGFPtB = 8;
@@ -1655,6 +1662,9 @@ private:
   TProfile *fhAvAbsOrbit; //!
 
   TProfile3D *fZDCVtxCenHist[10][4]; //! Run-by-run vtxZDCQvec
+  std::vector<Double_t> fZDCQRecTable; //! fZDCQHist[0-3] per centrality bin: {mean,sigma} x 4, empty if not tabulated
+  std::vector<Double_t> fZDCVtxCenRecTable; //! fZDCVtxCenHist[c][0-3] per vtx bin: 4 means, centrality bins one after the other
+  Int_t fZDCVtxCenRecOffset[10]; //! start of centrality bin c in fZDCVtxCenRecTable, -1 if not tabulated
   TProfile3D *fZDCVtxCenHistMagPol[10][8]; //! Run-by-run vtxZDCQvec
   TProfile2D *fVZEROCenHist[3];//! Run-by-run VZERO Q-vector (harmonics 1-3)
   TH3D *fZDCVtxFitHist[4]; //!
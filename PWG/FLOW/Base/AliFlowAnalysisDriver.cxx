@@ -0,0 +1,142 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowAnalysisDriver.h"
+#include "AliFlowAnalysis.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowEventSimpleCuts.h"
+#include "AliFlowPackedTracks.h"
+#include "AliFlowCommonHist.h"
+#include "TList.h"
+
+//********************************************************************
+// AliFlowAnalysisDriver:                                            *
+// Single pass over the event for several flow methods.              *
+//********************************************************************
+
+ClassImp(AliFlowAnalysisDriver)
+
+//________________________________________________________________________
+
+AliFlowAnalysisDriver::AliFlowAnalysisDriver(const char* name):
+  TNamed(name,name),
+  fMethods(),
+  fCommonHist(NULL),
+  fEventCuts(NULL),
+  fCurrentEvent(NULL),
+  fQ(),
+  fQsub0(),
+  fQsub1()
+{
+  // constructor
+  SetQVectorRange(8,1,1);
+}
+
+//________________________________________________________________________
+
+AliFlowAnalysisDriver::~AliFlowAnalysisDriver()
+{
+  // destructor
+  for(UInt_t i=0;i<fMethods.size();i++) delete fMethods[i];
+  delete fCommonHist;
+  delete fEventCuts;
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::AddMethod(AliFlowAnalysis *method)
+{
+  // registers a method, which will be called in the order of registration
+  if(!method) return;
+  method->SetDriver(this);
+  fMethods.push_back(method);
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::SetQVectorRange(Int_t maxHarmonic, Int_t maxPower, Int_t baseHarmonic)
+{
+  // sets the harmonics and weight powers of the shared Q-vectors
+  fQ.Configure(maxHarmonic,maxPower,baseHarmonic);
+  fQsub0.Configure(maxHarmonic,maxPower,baseHarmonic);
+  fQsub1.Configure(maxHarmonic,maxPower,baseHarmonic);
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::Init()
+{
+  // initialises all the methods
+  for(UInt_t i=0;i<fMethods.size();i++) fMethods[i]->Init();
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::ProcessEvent(AliFlowEventSimple *event)
+{
+  // computes the shared quantities once and passes the event to all the methods
+  if(!event) return;
+  if(fEventCuts && !fEventCuts->IsSelected(event,(TObject*)NULL)) return;
+
+  fCurrentEvent = event;
+  BuildQVectors(event);
+  if(fCommonHist) fCommonHist->FillControlHistograms(event);
+
+  for(UInt_t i=0;i<fMethods.size();i++) fMethods[i]->ProcessEvent(event);
+  fCurrentEvent = NULL;
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::BuildQVectors(AliFlowEventSimple *event)
+{
+  // fills the RP Q-vectors of the full event and of subevents 0 and 1
+  // from the packed tracks, which the methods then find already built
+  fQ.Reset(); fQsub0.Reset(); fQsub1.Reset();
+  const AliFlowPackedTracks *tracks = event->GetPackedTracks();
+  Int_t nTracks = tracks->GetNumberOfTracks();
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   if(!tracks->InRPSelection(i)) continue;
+   Double_t phi = tracks->Phi(i);
+   Double_t weight = tracks->Weight(i);
+   fQ.AddTrack(phi,weight);
+   if(tracks->InSubevent(i,0)) fQsub0.AddTrack(phi,weight);
+   if(tracks->InSubevent(i,1)) fQsub1.AddTrack(phi,weight);
+  }
+  fQ.Build(); fQsub0.Build(); fQsub1.Build();
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::Finish()
+{
+  // finishes all the methods
+  for(UInt_t i=0;i<fMethods.size();i++) fMethods[i]->Finish();
+}
+
+//________________________________________________________________________
+
+void AliFlowAnalysisDriver::GetOutputHistograms(TList *outputList)
+{
+  // adds the histogram list of each method, and the common histograms, to outputList
+  if(!outputList) return;
+  for(UInt_t i=0;i<fMethods.size();i++)
+  {
+   TList *list = fMethods[i]->GetHistList();
+   if(list) outputList->Add(list);
+  }
+  if(fCommonHist) outputList->Add(fCommonHist);
+}
@@ -0,0 +1,75 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+#ifndef ALIFLOWANALYSISDRIVER_H
+#define ALIFLOWANALYSISDRIVER_H
+
+#include <vector>
+#include "TNamed.h"
+#include "TMath.h"
+#include "AliFlowQVectorBuilder.h"
+
+class TList;
+class AliFlowAnalysis;
+class AliFlowEventSimple;
+class AliFlowEventSimpleCuts;
+class AliFlowCommonHist;
+
+//********************************************************************
+// AliFlowAnalysisDriver:                                            *
+// Runs several AliFlowAnalysis methods on the same event. The       *
+// per-event quantities the methods have in common are computed once *
+// before the methods are called: the packed tracks of the event,    *
+// the RP Q-vectors Q_{h*n,p} of the full event and of subevents 0   *
+// and 1 (track weights), and the control histograms in              *
+// AliFlowCommonHist. A method reads them with GetDriver() while its *
+// Make() runs; methods which do not, behave as when run alone.      *
+//********************************************************************
+
+class AliFlowAnalysisDriver : public TNamed {
+ public:
+  AliFlowAnalysisDriver(const char* name="AliFlowAnalysisDriver");
+  virtual ~AliFlowAnalysisDriver();
+
+  void AddMethod(AliFlowAnalysis *method);  // registers a method; owned by the driver
+  Int_t GetNumberOfMethods() const {return fMethods.size();}
+  AliFlowAnalysis* GetMethod(Int_t i) const {return fMethods[i];}
+
+  void SetQVectorRange(Int_t maxHarmonic, Int_t maxPower, Int_t baseHarmonic = 1); // harmonics h*n, h<=maxHarmonic, and weight powers p<=maxPower
+  void SetCommonHist(AliFlowCommonHist *hist) {fCommonHist = hist;} // control histograms filled once per event; owned by the driver
+  AliFlowCommonHist* GetCommonHist() const {return fCommonHist;}
+  void SetEventCuts(AliFlowEventSimpleCuts *cuts) {fEventCuts = cuts;} // cuts applied before anything is computed; owned by the driver
+  AliFlowEventSimpleCuts* GetEventCuts() const {return fEventCuts;}
+
+  void Init();                                 // calls Init() of all methods
+  void ProcessEvent(AliFlowEventSimple *event); // computes the shared quantities and calls ProcessEvent() of all methods
+  void Finish();                               // calls Finish() of all methods
+  void GetOutputHistograms(TList *outputList); // lists the histogram list of every method in outputList
+
+  // shared quantities of the event being processed
+  AliFlowEventSimple* GetCurrentEvent() const {return fCurrentEvent;}
+  const AliFlowQVectorBuilder& GetQ() const {return fQ;}                // RP Q-vectors of the full event
+  const AliFlowQVectorBuilder& GetQsub(Int_t s) const {return s==0 ? fQsub0 : fQsub1;} // RP Q-vectors of subevent s (0 or 1)
+  Int_t GetNumberOfRPs() const {return TMath::Nint(fQ.SumOfWeights(0));}
+  Int_t GetNumberOfRPsInSubevent(Int_t s) const {return TMath::Nint(GetQsub(s).SumOfWeights(0));}
+
+ private:
+  AliFlowAnalysisDriver(const AliFlowAnalysisDriver& driver);
+  AliFlowAnalysisDriver& operator=(const AliFlowAnalysisDriver& driver);
+
+  void BuildQVectors(AliFlowEventSimple *event);
+
+  std::vector<AliFlowAnalysis*> fMethods;   // registered methods
+  AliFlowCommonHist* fCommonHist;           // shared control histograms
+  AliFlowEventSimpleCuts* fEventCuts;       // event cuts applied by the driver
+  AliFlowEventSimple* fCurrentEvent;        //! event being processed
+  AliFlowQVectorBuilder fQ;                 // RP Q-vectors, full event
+  AliFlowQVectorBuilder fQsub0;             // RP Q-vectors, subevent 0
+  AliFlowQVectorBuilder fQsub1;             // RP Q-vectors, subevent 1
+
+  ClassDef(AliFlowAnalysisDriver, 1); // runs several flow methods on one event
+};
+
+#endif
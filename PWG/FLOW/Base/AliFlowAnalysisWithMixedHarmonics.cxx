@@ -43,6 +43,7 @@
 
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowPackedTracks.h"
 #include "AliFlowAnalysisWithMixedHarmonics.h"
 
 class TH1;
@@ -219,7 +220,7 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
  Double_t wPhi = 1.; // phi weight
  Double_t wPt  = 1.; // pt weight
  Double_t wEta = 1.; // eta weight
- AliFlowTrackSimple *aftsTrack = NULL; // simple track
+ const AliFlowPackedTracks *packedTracks = NULL; // packed tracks, shared by all the methods analysing this event
  
  // c) Fill common control histograms:
  fCommonHists->FillControlHistograms(anEvent);  
@@ -232,18 +233,18 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
  // Start loop over data:
+ packedTracks = anEvent->GetPackedTracks();
  for(Int_t i=0;i<nPrim;i++) 
  { 
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
+  if(i<packedTracks->GetNumberOfTracks())
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue; // consider only tracks which are either RPs or POIs
+   if(!(packedTracks->InRPSelection(i) || packedTracks->InPOISelection(i))) continue; // consider only tracks which are either RPs or POIs
    Int_t n = fHarmonic; 
-   if(aftsTrack->InRPSelection()) // checking RP condition:
+   if(packedTracks->InRPSelection(i)) // checking RP condition:
    {    
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = packedTracks->Phi(i);
+    dPt  = packedTracks->Pt(i);
+    dEta = packedTracks->Eta(i);
     if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi-weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -273,31 +274,30 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
       (*fSpk)(p,k)+=pow(wPhi*wPt*wEta,k);
      }
     }    
-   } // end of if(aftsTrack->InRPSelection())
+   } // end of if(packedTracks->InRPSelection(i))
    // POIs:
    if(fEvaluateDifferential3pCorrelator)
    {
-    if(aftsTrack->InPOISelection()) // 1st POI
+    if(packedTracks->InPOISelection(i)) // 1st POI
     {
-     Double_t dPsi1 = aftsTrack->Phi();
-     Double_t dPt1 = aftsTrack->Pt();
-     Double_t dEta1 = aftsTrack->Eta();
-     Int_t iCharge1 = aftsTrack->Charge();
+     Double_t dPsi1 = packedTracks->Phi(i);
+     Double_t dPt1 = packedTracks->Pt(i);
+     Double_t dEta1 = packedTracks->Eta(i);
+     Int_t iCharge1 = packedTracks->Charge(i);
      Bool_t b1stPOIisAlsoRP = kFALSE;
-     if(aftsTrack->InRPSelection()){b1stPOIisAlsoRP = kTRUE;}
+     if(packedTracks->InRPSelection(i)){b1stPOIisAlsoRP = kTRUE;}
      for(Int_t j=0;j<nPrim;j++)
      {
       if(j==i){continue;}
-      aftsTrack=anEvent->GetTrack(j);
-      if(aftsTrack->InPOISelection()) // 2nd POI
+      if(packedTracks->InPOISelection(j)) // 2nd POI
       {
-       Double_t dPsi2 = aftsTrack->Phi();
-       Double_t dPt2 = aftsTrack->Pt(); 
-       Double_t dEta2 = aftsTrack->Eta();
-       Int_t iCharge2 = aftsTrack->Charge();
+       Double_t dPsi2 = packedTracks->Phi(j);
+       Double_t dPt2 = packedTracks->Pt(j); 
+       Double_t dEta2 = packedTracks->Eta(j);
+       Int_t iCharge2 = packedTracks->Charge(j);
        if(fOppositeChargesPOI && iCharge1 == iCharge2){continue;}
        Bool_t b2ndPOIisAlsoRP = kFALSE;
-       if(aftsTrack->InRPSelection()){b2ndPOIisAlsoRP = kTRUE;}
+       if(packedTracks->InRPSelection(j)){b2ndPOIisAlsoRP = kTRUE;}
 
        // Fill:Pt
        fRePEBE[0]->Fill((dPt1+dPt2)/2.,TMath::Cos(n*(dPsi1+dPsi2)),1.);
@@ -388,11 +388,11 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
         fImNITEBE[1][1][2]->Fill((dEta1+dEta2)/2.,TMath::Sin(n*(dPsi2)),1.);
         fImNITEBE[1][1][3]->Fill(TMath::Abs(dEta1-dEta2),TMath::Sin(n*(dPsi2)),1.);       
        }
-      } // end of if(aftsTrack->InPOISelection()) // 2nd POI
+      } // end of if(packedTracks->InPOISelection(j)) // 2nd POI
      } // end of for(Int_t j=i+1;j<nPrim;j++)
-    } // end of if(aftsTrack->InPOISelection()) // 1st POI  
+    } // end of if(packedTracks->InPOISelection(i)) // 1st POI  
    } // end of if(fEvaluateDifferential3pCorrelator)
-  } else // to if(aftsTrack)
+  } else // to if(i<packedTracks->GetNumberOfTracks())
     {
      cout<<endl;
      cout<<" WARNING (MH): No particle! (i.e. aftsTrack is a NULL pointer in Make().)"<<endl;
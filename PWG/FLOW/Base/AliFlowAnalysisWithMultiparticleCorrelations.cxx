@@ -24,6 +24,7 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include "AliFlowQVectorBuilder.h"
 
 using std::endl;
 using std::cout;
@@ -63,6 +64,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorList(NULL),       
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
+ fQvectorBuilder(NULL),
  fCalculateDiffQvectors(kFALSE),
  // 3.) Correlations:
  fCorrelationsList(NULL),
@@ -169,6 +171,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fQvectorBuilder;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -2000,6 +2003,12 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
  Double_t wToPowerP = 1.; // weight raised to power p
  Int_t nCounterRPs = 0;
+ if(!fQvectorBuilder){fQvectorBuilder = new AliFlowQVectorBuilder(fMaxHarmonic*fMaxCorrelator,fMaxCorrelator);}
+ if(fQvectorBuilder->GetMaxHarmonic() != fMaxHarmonic*fMaxCorrelator || fQvectorBuilder->GetMaxPower() != fMaxCorrelator)
+ {
+  fQvectorBuilder->Configure(fMaxHarmonic*fMaxCorrelator,fMaxCorrelator);
+ }
+ fQvectorBuilder->Reset();
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
   AliFlowTrackSimple *pTrack = NULL;
@@ -2035,15 +2044,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    dEta = pTrack->Eta();
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
-   // Calculate Q-vector components:
-   for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
-   {
-    for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
-    {
-     if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-    } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
-   } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+   // Pack this RP for the Q-vector components, calculated after the loop over all tracks:
+   fQvectorBuilder->AddTrack(dPhi,wPhi*wPt*wEta); // weights not in use are 1
   } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
 
   // Differential Q-vectors (a.k.a. p-vector and q-vector):
@@ -2104,6 +2106,16 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
+ // Calculate Q-vector components from the packed RPs:
+ fQvectorBuilder->Build();
+ for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+ {
+  for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+  {
+   fQvector[h][wp] += fQvectorBuilder->Q(h,wp);
+  } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
+ } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+
 } // void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimple *anEvent)
 
 //=======================================================================================================================
@@ -31,6 +31,8 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 
+class AliFlowQVectorBuilder;
+
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
   AliFlowAnalysisWithMultiparticleCorrelations();
@@ -382,6 +384,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   TProfile *fQvectorFlagsPro;    // profile to hold all flags for Q-vector
   Bool_t fCalculateQvector;      // to calculate or not to calculate Q-vector components, that's a Boolean...
   TComplex fQvector[49][9];      // Q-vector components [fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1]  
+  AliFlowQVectorBuilder *fQvectorBuilder; //! builds fQvector from the packed RPs in one pass
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
@@ -43,6 +43,8 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
+#include "AliFlowQVectorBuilder.h"
+#include "AliFlowPackedTracks.h"
 #include "TArrayD.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -137,6 +139,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fReQ(NULL),
  fImQ(NULL),
  fSpk(NULL),
+ fQVectorBuilder(NULL),
  fIntFlowCorrelationsEBE(NULL),
  fIntFlowEventWeightsForCorrelationsEBE(NULL),
  fIntFlowCorrelationsAllEBE(NULL),
@@ -271,6 +274,7 @@ AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
  // destructor
  
  delete fHistList;
+ delete fQVectorBuilder;
 
 } // end of AliFlowAnalysisWithQCumulants::~AliFlowAnalysisWithQCumulants()
 
@@ -377,21 +381,22 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
+ const AliFlowPackedTracks *packedTracks = anEvent->GetPackedTracks(); // shared by all the methods analysing this event
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ if(fQVectorBuilder->GetBaseHarmonic() != n){fQVectorBuilder->Configure(12,8,n);}
+ fQVectorBuilder->Reset();
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
+  if(i<packedTracks->GetNumberOfTracks())
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
+   if(!(packedTracks->InRPSelection(i) || packedTracks->InPOISelection(i))){continue;} // safety measure: consider only tracks which are RPs or POIs
+   if(packedTracks->InRPSelection(i)) // RP condition:
    {    
     nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = packedTracks->Phi(i);
+    dPt  = packedTracks->Pt(i);
+    dEta = packedTracks->Eta(i);
     if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -407,25 +412,10 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     // Access track weight:
     if(fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = packedTracks->Weight(i); 
     }
-    // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
-    {
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
-     } 
-    }
-    // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
-    {
-     for(Int_t k=0;k<9;k++)
-     {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
-     }
-    } 
+    // Pack this RP for Re[Q_{m*n,k}], Im[Q_{m*n,k}] (m = 1,2,...,12, k = 0,1,...,8) and S_{p,k}, calculated after the loop over data bellow:
+    fQVectorBuilder->AddTrack(dPhi,wPhi*wPt*wEta*wTrack);
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
@@ -460,7 +450,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
+     if(packedTracks->InPOISelection(i))
      {
       // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
       for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
@@ -490,34 +480,34 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
         } // end of if(fCalculate2DDiffFlow)
        } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
       } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
+     } // end of if(packedTracks->InPOISelection(i))  
     } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
    } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
+   if(packedTracks->InPOISelection(i))
    {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = packedTracks->Phi(i);
+    dPt  = packedTracks->Pt(i);
+    dEta = packedTracks->Eta(i);
     wPhi = 1.;
     wPt  = 1.;
     wEta = 1.;
     wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
+    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && packedTracks->InRPSelection(i)) // determine phi weight for POI && RP particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
     }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
+    if(fUsePtWeights && fPtWeights && fnBinsPt && packedTracks->InRPSelection(i)) // determine pt weight for POI && RP particle:
     {
      wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
     }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
+    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && packedTracks->InRPSelection(i)) // determine eta weight for POI && RP particle: 
     {
      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
     }      
     // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
+    if(packedTracks->InRPSelection(i) && fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = packedTracks->Weight(i); 
     }
     ptEta[0] = dPt;
     ptEta[1] = dEta;
@@ -542,17 +532,20 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
    } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
+  } else // to if(i<packedTracks->GetNumberOfTracks())
     {
      printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
     }
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
- // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
+ // e) Calculate Q_{m*n,k} and S_{p,k} from the packed RPs and the final expressions for S_{p,k} and s_{p,k} (important !!!!):
+ fQVectorBuilder->Build();
+ fQVectorBuilder->FillMatrices(*fReQ,*fImQ);
  for(Int_t p=0;p<8;p++)
  {
   for(Int_t k=0;k<9;k++)
   {
+   (*fSpk)(p,k)+=fQVectorBuilder->SumOfWeights(k);
    (*fSpk)(p,k)=pow((*fSpk)(p,k),p+1);
    // ... for the time being s_{p,k} dosn't need higher powers, so no need to finalize it here ...
   } // end of for(Int_t k=0;k<9;k++)  
@@ -1773,6 +1766,7 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForIntegratedFlow()
  fReQ = new TMatrixD(12,9);
  fImQ = new TMatrixD(12,9);
  fSpk = new TMatrixD(8,9);
+ fQVectorBuilder = new AliFlowQVectorBuilder(12,8,fHarmonic);
  // average correlations <2>, <4>, <6> and <8> for single event (bining is the same as in fIntFlowCorrelationsPro and fIntFlowCorrelationsHist):
  TString intFlowCorrelationsEBEName = "fIntFlowCorrelationsEBE";
  intFlowCorrelationsEBEName += fAnalysisLabel->Data();
@@ -29,6 +29,7 @@
 #include "AliFlowEventSimple.h"
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowPackedTracks.h"
 #include "AliFlowCommonHist.h"
 #include "AliFlowCommonHistResults.h"
 #include "AliFlowAnalysisWithScalarProduct.h"
@@ -372,14 +373,14 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
   fHistProNUAq->Fill(6.,vQm.X()/dNq,dWq);
 
   //loop over the tracks of the event
-  AliFlowTrackSimple*   pTrack = NULL; 
-  Int_t iNumberOfTracks = anEvent->NumberOfTracks(); 
+  //the packed tracks are shared by all the methods analysing this event,
+  //the track objects are only needed to subtract their daughters
+  const AliFlowPackedTracks* packedTracks = anEvent->GetPackedTracks();
+  Int_t iNumberOfTracks = packedTracks->GetNumberOfTracks(); 
   for (Int_t i=0;i<iNumberOfTracks;i++) {
-    pTrack = anEvent->GetTrack(i) ; 
-    if (!pTrack) continue;
-    Double_t dPhi = pTrack->Phi();
-    Double_t dPt  = pTrack->Pt();
-    Double_t dEta = pTrack->Eta();
+    Double_t dPhi = packedTracks->Phi(i);
+    Double_t dPt  = packedTracks->Pt(i);
+    Double_t dEta = packedTracks->Eta(i);
 
     //calculate vU
     TVector2 vU;
@@ -402,7 +403,7 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
     //remove track if in subevent
     for(Int_t inSubEvent=0; inSubEvent<2; ++inSubEvent) {
-      if( !pTrack->InSubevent( inSubEvent ) )
+      if( !packedTracks->InSubevent( i, inSubEvent ) )
         continue;
       if(inSubEvent==0)
         if( (fTotalQvector%2)!=1 )
@@ -426,13 +427,13 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
       //subtrack the track from the Q vector, but only if it was used to construct this
       //Q vector: i.e. check wether it has the same tags and is in the same subevent
       //this is especially important for the daughters (as for the mother it is already checked)
-      Int_t numberOfsubtractedDaughters=vQm.SubtractTrackWithDaughters(pTrack,dW);
+      Int_t numberOfsubtractedDaughters=vQm.SubtractTrackWithDaughters(anEvent->GetTrack(i),dW);
       
       if(!fMinimalBook) {
         fHistNumberOfSubtractedDaughters->Fill(numberOfsubtractedDaughters);
       }
 
-      dMq = dMq-dW*pTrack->Weight();
+      dMq = dMq-dW*packedTracks->Weight(i);
     }
     dNq = fNormalizationType ? dMq : vQm.Mod();
     dWq = fNormalizationType ? dMq : 1;
@@ -455,9 +456,9 @@ void AliFlowAnalysisWithScalarProduct::Make(AliFlowEventSimple* anEvent) {
 
     //fill the profile histograms
     for(Int_t iPOI=0; iPOI!=2; ++iPOI) {
-      if( (iPOI==0)&&(!pTrack->InRPSelection()) )
+      if( (iPOI==0)&&(!packedTracks->InRPSelection(i)) )
         continue;
-      if( (iPOI==1)&&(!pTrack->InPOISelection(fPOItype)) )
+      if( (iPOI==1)&&(!packedTracks->InPOISelection(i,fPOItype)) )
         continue;
       fHistProUQ[iPOI][0]->Fill(dPt ,dUQ/dNq,dWq); //Fill (uQ/Nq') with weight (Nq')
       fHistProUQ[iPOI][1]->Fill(dEta,dUQ/dNq,dWq); //Fill (uQ/Nq') with weight (Nq')
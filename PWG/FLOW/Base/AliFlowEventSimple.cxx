@@ -42,6 +42,7 @@
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowPackedTracks.h"
 #include "TRandom.h"
 
 using std::cout;
@@ -87,6 +88,9 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fPackedTracks(NULL),
+  fPackedTracksValid(kFALSE),
+  fPackedSinglePrecision(kFALSE),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -146,6 +150,9 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fPackedTracks(NULL),
+  fPackedTracksValid(kFALSE),
+  fPackedSinglePrecision(kFALSE),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -209,6 +216,9 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPCM(anEvent.fZPCM),
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fPackedTracks(NULL),
+  fPackedTracksValid(kFALSE),
+  fPackedSinglePrecision(anEvent.fPackedSinglePrecision),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -306,6 +316,8 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  fPackedSinglePrecision = anEvent.fPackedSinglePrecision;
+  InvalidatePackedTracks();
   return *this;
 }
 
@@ -322,6 +334,7 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fShuffledIndexes;
   delete fMothersCollection;
   delete [] fNumberOfPOIs;
+  delete fPackedTracks;
 }
 
 //-----------------------------------------------------------------------
@@ -364,6 +377,7 @@ void AliFlowEventSimple::Generate(Int_t nParticles,
                                   Double_t etaMin,
                                   Double_t etaMax)
 {
+  InvalidatePackedTracks();
   //generate nParticles random tracks uniform in phi and eta
   //according to the specified pt distribution
   if (!ptDist)
@@ -429,9 +443,28 @@ AliFlowTrackSimple* AliFlowEventSimple::GetTrack(Int_t i)
   return pTrack;
 }
 
+//-----------------------------------------------------------------------
+const AliFlowPackedTracks* AliFlowEventSimple::GetPackedTracks()
+{
+  //packed copy of the tracks, in the order of GetTrack(i), built at the first
+  //call after the event was modified and then shared by all the flow methods
+  //analysing this event. Call InvalidatePackedTracks() after modifying
+  //tracks obtained with GetTrack()
+  if (!fPackedTracks) fPackedTracks = new AliFlowPackedTracks();
+  if (!fPackedTracksValid || fPackedTracks->GetNumberOfTracks()!=fNumberOfTracks ||
+      fPackedTracks->IsSinglePrecision()!=fPackedSinglePrecision)
+  {
+    fPackedTracks->SetSinglePrecision(fPackedSinglePrecision);
+    fPackedTracks->Fill(this);
+    fPackedTracksValid = kTRUE;
+  }
+  return fPackedTracks;
+}
+
 //-----------------------------------------------------------------------
 void AliFlowEventSimple::ShuffleTracks()
 {
+  InvalidatePackedTracks();
   //shuffle track indexes
   if (!fShuffledIndexes)
   {
@@ -447,6 +480,7 @@ void AliFlowEventSimple::ShuffleTracks()
 //-----------------------------------------------------------------------
 void AliFlowEventSimple::AddTrack( AliFlowTrackSimple* track )
 {
+  InvalidatePackedTracks();
   //add a track, delete the old one if necessary
   if (fNumberOfTracks < fTrackCollection->GetEntriesFast())
   {
@@ -465,6 +499,7 @@ void AliFlowEventSimple::AddTrack( AliFlowTrackSimple* track )
 //-----------------------------------------------------------------------
 void AliFlowEventSimple::TrackAdded()
 {
+  InvalidatePackedTracks();
   //book keeping after a new track has been added
   fNumberOfTracks++;
   if (fShuffledIndexes)
@@ -893,6 +928,9 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fPackedTracks(NULL),
+  fPackedTracksValid(kFALSE),
+  fPackedSinglePrecision(kFALSE),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -954,6 +992,7 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
 //_____________________________________________________________________________
 void AliFlowEventSimple::CloneTracks(Int_t n)
 {
+  InvalidatePackedTracks();
   //clone every track n times to add non-flow
   if (n<=0) return; //no use to clone stuff zero or less times
   Int_t ntracks = fNumberOfTracks;
@@ -973,6 +1012,7 @@ void AliFlowEventSimple::CloneTracks(Int_t n)
 //_____________________________________________________________________________
 void AliFlowEventSimple::ResolutionPt(Double_t res)
 {
+  InvalidatePackedTracks();
   //smear pt of all tracks by gaussian with sigma=res
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -988,6 +1028,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
                                             Double_t etaMinB,
                                             Double_t etaMaxB )
 {
+  InvalidatePackedTracks();
   //Flag two subevents in given eta ranges
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1003,6 +1044,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagSubeventsByCharge()
 {
+  InvalidatePackedTracks();
   //Flag two subevents in given eta ranges
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1018,6 +1060,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV1( Double_t v1 )
 {
+  InvalidatePackedTracks();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1035,6 +1078,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV2( Double_t v2 )
 {
+  InvalidatePackedTracks();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1052,6 +1096,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV3( Double_t v3 )
 {
+  InvalidatePackedTracks();
   //add v3 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1069,6 +1114,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV4( Double_t v4 )
 {
+  InvalidatePackedTracks();
   //add v4 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1086,6 +1132,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV5( Double_t v5 )
 {
+  InvalidatePackedTracks();
   //add v4 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1104,6 +1151,7 @@ void AliFlowEventSimple::AddV5( Double_t v5 )
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5,
                                   Double_t rp1, Double_t rp2, Double_t rp3, Double_t rp4, Double_t rp5 )
 {
+  InvalidatePackedTracks();
   //add flow to all tracks wrt the reaction plane angle, for all harmonic separate angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1116,6 +1164,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5 )
 {
+  InvalidatePackedTracks();
   //add flow to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1128,6 +1177,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 {
+  InvalidatePackedTracks();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1142,6 +1192,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 {
+  InvalidatePackedTracks();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1156,6 +1207,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
+  InvalidatePackedTracks();
   //tag tracks as reference particles (RPs)
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1178,6 +1230,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
+  InvalidatePackedTracks();
   //tag tracks as particles of interest (POIs)
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1210,6 +1263,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
                                          Double_t phiMin,
                                          Double_t phiMax )
 {
+  InvalidatePackedTracks();
   //mark tracks in given eta-phi region as dead
   //by resetting the flow bits
   for (Int_t i=0; i<fNumberOfTracks; i++)
@@ -1232,6 +1286,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
 //_____________________________________________________________________________
 Int_t AliFlowEventSimple::CleanUpDeadTracks()
 {
+  InvalidatePackedTracks();
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
   Int_t ncleaned=0;
@@ -1271,6 +1326,7 @@ TF1* AliFlowEventSimple::SimplePtSpectrum()
 //_____________________________________________________________________________
 void AliFlowEventSimple::ClearFast()
 {
+  InvalidatePackedTracks();
   //clear the counters without deleting allocated objects so they can be reused
   fReferenceMultiplicity = 0;
   fNumberOfTracks = 0;
@@ -25,6 +25,7 @@ class TF1;
 class TF2;
 class AliFlowTrackSimple;
 class AliFlowTrackSimpleCuts;
+class AliFlowPackedTracks;
 
 class AliFlowEventSimple: public TObject {
 
@@ -116,6 +117,10 @@ class AliFlowEventSimple: public TObject {
   void AddTrack( AliFlowTrackSimple* track );
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
+  const AliFlowPackedTracks* GetPackedTracks();
+  void InvalidatePackedTracks()                     { fPackedTracksValid=kFALSE; }
+  void SetPackedTracksSinglePrecision(Bool_t b=kTRUE) { fPackedSinglePrecision=b; }
+  Int_t GetNumberOfPOItypes() const                 { return fNumberOfPOItypes; }
 
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
@@ -204,12 +209,15 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  AliFlowPackedTracks*    fPackedTracks;              //! packed copy of the tracks, see GetPackedTracks()
+  Bool_t                  fPackedTracksValid;         //! fPackedTracks is up to date
+  Bool_t                  fPackedSinglePrecision;     //! pack phi, eta, pt and weight as Float_t
 
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,7)
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
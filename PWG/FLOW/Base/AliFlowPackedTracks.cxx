@@ -0,0 +1,105 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowPackedTracks.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackSimple.h"
+
+//********************************************************************
+// AliFlowPackedTracks:                                              *
+// Structure-of-arrays copy of the tracks of a flow event.           *
+//********************************************************************
+
+ClassImp(AliFlowPackedTracks)
+
+//________________________________________________________________________
+
+AliFlowPackedTracks::AliFlowPackedTracks():
+  TObject(),
+  fSinglePrecision(kFALSE),
+  fPhiF(),
+  fEtaF(),
+  fPtF(),
+  fWeightF(),
+  fPhiD(),
+  fEtaD(),
+  fPtD(),
+  fWeightD(),
+  fCharge(),
+  fPOIMask(),
+  fSubeventMask()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+
+void AliFlowPackedTracks::Clear(Option_t* /*option*/)
+{
+  // removes the packed tracks, keeping the allocated memory
+  fPhiF.clear(); fEtaF.clear(); fPtF.clear(); fWeightF.clear();
+  fPhiD.clear(); fEtaD.clear(); fPtD.clear(); fWeightD.clear();
+  fCharge.clear(); fPOIMask.clear(); fSubeventMask.clear();
+}
+
+//________________________________________________________________________
+
+void AliFlowPackedTracks::Fill(AliFlowEventSimple *event)
+{
+  // packs the tracks of event, in the order of AliFlowEventSimple::GetTrack;
+  // missing tracks are packed untagged so that the indices stay the same
+  Clear();
+  if(!event) return;
+  Int_t nTracks = event->NumberOfTracks();
+  Int_t nPOItypes = event->GetNumberOfPOItypes();
+  if(nPOItypes > fgkMaxPOItypes) nPOItypes = fgkMaxPOItypes;
+
+  if(fSinglePrecision)
+  {
+    fPhiF.resize(nTracks); fEtaF.resize(nTracks); fPtF.resize(nTracks); fWeightF.resize(nTracks);
+  } else
+  {
+    fPhiD.resize(nTracks); fEtaD.resize(nTracks); fPtD.resize(nTracks); fWeightD.resize(nTracks);
+  }
+  fCharge.resize(nTracks);
+  fPOIMask.resize(nTracks);
+  fSubeventMask.resize(nTracks);
+
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   AliFlowTrackSimple *track = event->GetTrack(i);
+   Double_t phi = 0., eta = 0., pt = 0., weight = 0.;
+   UInt_t poiMask = 0;
+   UChar_t subeventMask = 0;
+   Short_t charge = 0;
+   if(track)
+   {
+    phi = track->Phi(); eta = track->Eta(); pt = track->Pt(); weight = track->Weight();
+    charge = track->Charge();
+    for(Int_t k=0;k<nPOItypes;k++) {if(track->InPOISelection(k)) poiMask |= (1u<<k);}
+    for(Int_t k=0;k<fgkMaxSubevents;k++) {if(track->InSubevent(k)) subeventMask |= (1u<<k);}
+   }
+   if(fSinglePrecision)
+   {
+    fPhiF[i] = phi; fEtaF[i] = eta; fPtF[i] = pt; fWeightF[i] = weight;
+   } else
+   {
+    fPhiD[i] = phi; fEtaD[i] = eta; fPtD[i] = pt; fWeightD[i] = weight;
+   }
+   fCharge[i] = charge;
+   fPOIMask[i] = poiMask;
+   fSubeventMask[i] = subeventMask;
+  }
+}
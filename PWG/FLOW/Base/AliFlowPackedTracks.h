@@ -0,0 +1,76 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+#ifndef ALIFLOWPACKEDTRACKS_H
+#define ALIFLOWPACKEDTRACKS_H
+
+#include <vector>
+#include "TObject.h"
+
+class AliFlowEventSimple;
+
+//********************************************************************
+// AliFlowPackedTracks:                                              *
+// Packed copy of the tracks of an AliFlowEventSimple: phi, eta, pt  *
+// and weight in contiguous arrays (Float_t or Double_t), the charge *
+// and the RP/POI and subevent tags as bit masks. Track i is the     *
+// track returned by AliFlowEventSimple::GetTrack(i), which remains  *
+// available for everything not packed here (daughters, mass, ...).  *
+// Built by AliFlowEventSimple::GetPackedTracks() and shared by all  *
+// the flow methods analysing the same event.                        *
+//********************************************************************
+
+class AliFlowPackedTracks : public TObject {
+ public:
+  AliFlowPackedTracks();
+  virtual ~AliFlowPackedTracks() {}
+
+  void   SetSinglePrecision(Bool_t b = kTRUE) {fSinglePrecision = b;} // store phi, eta, pt, weight as Float_t
+  Bool_t IsSinglePrecision() const {return fSinglePrecision;}
+
+  void   Fill(AliFlowEventSimple *event);  // packs all the tracks of event
+  void   Clear(Option_t *option = "");
+
+  Int_t    GetNumberOfTracks() const {return fPOIMask.size();}
+  Double_t Phi(Int_t i) const {return fSinglePrecision ? fPhiF[i] : fPhiD[i];}
+  Double_t Eta(Int_t i) const {return fSinglePrecision ? fEtaF[i] : fEtaD[i];}
+  Double_t Pt(Int_t i) const {return fSinglePrecision ? fPtF[i] : fPtD[i];}
+  Double_t Weight(Int_t i) const {return fSinglePrecision ? fWeightF[i] : fWeightD[i];}
+  Int_t    Charge(Int_t i) const {return fCharge[i];}
+  UInt_t   GetPOIMask(Int_t i) const {return fPOIMask[i];}          // bit k set if the track is POI of type k (k=0: RP)
+  UInt_t   GetSubeventMask(Int_t i) const {return fSubeventMask[i];} // bit k set if the track is in subevent k
+  Bool_t   InRPSelection(Int_t i) const {return fPOIMask[i]&1u;}
+  Bool_t   InPOISelection(Int_t i, Int_t poiType=1) const {return poiType>=0 && poiType<fgkMaxPOItypes && ((fPOIMask[i]>>poiType)&1u);}
+  Bool_t   InSubevent(Int_t i, Int_t subevent) const {return subevent>=0 && subevent<fgkMaxSubevents && ((fSubeventMask[i]>>subevent)&1u);}
+
+  // the arrays themselves, NULL for the precision which is not in use
+  const Float_t  *GetPhiF() const {return (fSinglePrecision && !fPhiF.empty()) ? &fPhiF[0] : NULL;}
+  const Double_t *GetPhiD() const {return (!fSinglePrecision && !fPhiD.empty()) ? &fPhiD[0] : NULL;}
+  const UInt_t   *GetPOIMasks() const {return fPOIMask.empty() ? NULL : &fPOIMask[0];}
+
+  static const Int_t fgkMaxPOItypes = 32; // POI types kept in the mask
+  static const Int_t fgkMaxSubevents = 8; // subevents kept in the mask
+
+ private:
+  AliFlowPackedTracks(const AliFlowPackedTracks& tracks);
+  AliFlowPackedTracks& operator=(const AliFlowPackedTracks& tracks);
+
+  Bool_t fSinglePrecision;            // store the kinematics as Float_t
+  std::vector<Float_t>  fPhiF;        //! phi (single precision)
+  std::vector<Float_t>  fEtaF;        //! eta (single precision)
+  std::vector<Float_t>  fPtF;         //! pt (single precision)
+  std::vector<Float_t>  fWeightF;     //! track weight (single precision)
+  std::vector<Double_t> fPhiD;        //! phi (double precision)
+  std::vector<Double_t> fEtaD;        //! eta (double precision)
+  std::vector<Double_t> fPtD;         //! pt (double precision)
+  std::vector<Double_t> fWeightD;     //! track weight (double precision)
+  std::vector<Short_t>  fCharge;      //! charge
+  std::vector<UInt_t>   fPOIMask;     //! RP/POI tags
+  std::vector<UChar_t>  fSubeventMask;//! subevent tags
+
+  ClassDef(AliFlowPackedTracks, 1); // packed tracks of a flow event
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  * 
+**************************************************************************/
+
+#include "AliFlowQVectorBuilder.h"
+#include "TMath.h"
+#include "TMatrixD.h"
+
+//********************************************************************
+// AliFlowQVectorBuilder:                                            *
+// One-pass builder of Q_{h*n,p} for all harmonics and weight powers *
+// used by the Q-cumulant style flow analyses.                       *
+//********************************************************************
+
+ClassImp(AliFlowQVectorBuilder)
+
+//________________________________________________________________________
+
+AliFlowQVectorBuilder::AliFlowQVectorBuilder():
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fBaseHarmonic(1),
+  fPhi(),
+  fWeight(),
+  fReQ(),
+  fImQ(),
+  fWeightPow()
+{
+  // default constructor
+  Configure(0,0,1);
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorBuilder::AliFlowQVectorBuilder(Int_t maxHarmonic, Int_t maxPower, Int_t baseHarmonic):
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fBaseHarmonic(1),
+  fPhi(),
+  fWeight(),
+  fReQ(),
+  fImQ(),
+  fWeightPow()
+{
+  // constructor
+  Configure(maxHarmonic,maxPower,baseHarmonic);
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorBuilder::~AliFlowQVectorBuilder()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Configure(Int_t maxHarmonic, Int_t maxPower, Int_t baseHarmonic)
+{
+  // Set the highest multiple of the base harmonic and the highest weight power, then clear the builder.
+  fMaxHarmonic = (maxHarmonic > 0) ? maxHarmonic : 0;
+  fMaxPower = (maxPower > 0) ? maxPower : 0;
+  fBaseHarmonic = baseHarmonic;
+  fWeightPow.assign(fMaxPower+1,1.);
+  Reset();
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Reset()
+{
+  // Clear packed tracks and Q-vectors. Memory is kept for the next event.
+  fPhi.clear();
+  fWeight.clear();
+  fReQ.assign((fMaxHarmonic+1)*(fMaxPower+1),0.);
+  fImQ.assign((fMaxHarmonic+1)*(fMaxPower+1),0.);
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Build()
+{
+  // Add the packed tracks to the Q-vectors and clear the packed arrays.
+  if(fPhi.empty()){return;}
+  Build(&fPhi[0],&fWeight[0],fPhi.size());
+  fPhi.clear();
+  fWeight.clear();
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Build(const Double_t *phi, const Double_t *weight, Int_t nTracks)
+{
+  // Add nTracks tracks to the Q-vectors. If weight is NULL all weights are 1.
+  //   Q_{h*n,p} += w^p * (cos(n*phi) + i sin(n*phi))^h
+  // The harmonics are generated recursively from cos(n*phi) and sin(n*phi) of each track.
+  const Int_t nPowers = fMaxPower+1;
+  Double_t *wPow = &fWeightPow[0];
+  Double_t *reQ = &fReQ[0];
+  Double_t *imQ = &fImQ[0];
+  for(Int_t t=0;t<nTracks;t++)
+  {
+   const Double_t dAngle = fBaseHarmonic*phi[t];
+   const Double_t dCos = TMath::Cos(dAngle);
+   const Double_t dSin = TMath::Sin(dAngle);
+   const Double_t dWeight = weight ? weight[t] : 1.;
+   wPow[0] = 1.;
+   for(Int_t p=1;p<nPowers;p++){wPow[p] = wPow[p-1]*dWeight;}
+   Double_t dRe = 1.; // cos(h*n*phi)
+   Double_t dIm = 0.; // sin(h*n*phi)
+   for(Int_t h=0;h<=fMaxHarmonic;h++)
+   {
+    Double_t *reRow = reQ + h*nPowers;
+    Double_t *imRow = imQ + h*nPowers;
+    for(Int_t p=0;p<nPowers;p++)
+    {
+     reRow[p] += wPow[p]*dRe;
+     imRow[p] += wPow[p]*dIm;
+    }
+    const Double_t dReNext = dRe*dCos-dIm*dSin;
+    dIm = dRe*dSin+dIm*dCos;
+    dRe = dReNext;
+   } // for(Int_t h=0;h<=fMaxHarmonic;h++)
+  } // for(Int_t t=0;t<nTracks;t++)
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Harmonics(Double_t phi, Int_t maxHarmonic, Double_t *cosPhi, Double_t *sinPhi)
+{
+  // Per-track table cos(h*phi), sin(h*phi) for h = 0,...,maxHarmonic, for code which fills
+  // several Q-vector like histograms with the same track. Same recursion as in Build().
+  const Double_t dCos = TMath::Cos(phi);
+  const Double_t dSin = TMath::Sin(phi);
+  cosPhi[0] = 1.;
+  sinPhi[0] = 0.;
+  for(Int_t h=1;h<=maxHarmonic;h++)
+  {
+   cosPhi[h] = cosPhi[h-1]*dCos-sinPhi[h-1]*dSin;
+   sinPhi[h] = cosPhi[h-1]*dSin+sinPhi[h-1]*dCos;
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Powers(Double_t weight, Int_t maxPower, Double_t *weightPow)
+{
+  // Per-track table weight^p for p = 0,...,maxPower.
+  weightPow[0] = 1.;
+  for(Int_t p=1;p<=maxPower;p++){weightPow[p] = weightPow[p-1]*weight;}
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowQVectorBuilder::Q(Int_t h, Int_t p) const
+{
+  // Complex Q-vector component, negative harmonics are returned as complex conjugate.
+  if(h>=0){return TComplex(ReQ(h,p),ImQ(h,p));}
+  return TComplex(ReQ(-h,p),-ImQ(-h,p));
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::FillMatrices(TMatrixD &reQ, TMatrixD &imQ) const
+{
+  // Add Q_{(m+1)*n,k} to reQ(m,k) and imQ(m,k), the layout used by the Q-cumulant classes.
+  for(Int_t m=0;m<reQ.GetNrows() && m<fMaxHarmonic;m++)
+  {
+   for(Int_t k=0;k<reQ.GetNcols() && k<=fMaxPower;k++)
+   {
+    reQ(m,k) += ReQ(m+1,k);
+    imQ(m,k) += ImQ(m+1,k);
+   }
+  }
+}
@@ -0,0 +1,68 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORBUILDER_H
+#define ALIFLOWQVECTORBUILDER_H
+
+#include <vector>
+#include "TObject.h"
+#include "TComplex.h"
+
+class TMatrixD;
+
+//********************************************************************
+// AliFlowQVectorBuilder:                                            *
+// Builds all Q-vector components Q_{h*n,p} = sum_i w_i^p exp(i*h*n*phi_i)
+// for h = 0,...,maxHarmonic and p = 0,...,maxPower in one pass over *
+// a packed array of azimuthal angles and weights. cos/sin are       *
+// evaluated once per track, higher harmonics are obtained by        *
+// complex multiplication and weight powers by repeated products.    *
+// The h = 0 row holds the sums of weight powers S_{1,p}.            *
+//********************************************************************
+
+class AliFlowQVectorBuilder : public TObject {
+ public:
+  AliFlowQVectorBuilder();
+  AliFlowQVectorBuilder(Int_t maxHarmonic, Int_t maxPower, Int_t baseHarmonic = 1);
+  virtual ~AliFlowQVectorBuilder();
+
+  void Configure(Int_t maxHarmonic, Int_t maxPower, Int_t baseHarmonic = 1); // sets the ranges and clears the builder
+  void Reset();                                                              // clears the packed tracks and the Q-vectors
+  void AddTrack(Double_t phi, Double_t weight = 1.) {fPhi.push_back(phi); fWeight.push_back(weight);} // packs one track
+  void Build();                                                              // adds the packed tracks to the Q-vectors
+  void Build(const Double_t *phi, const Double_t *weight, Int_t nTracks);    // adds external arrays to the Q-vectors (weight may be NULL)
+
+  Int_t GetNumberOfTracks() const {return fPhi.size();}
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;}
+  Int_t GetMaxPower() const {return fMaxPower;}
+  Int_t GetBaseHarmonic() const {return fBaseHarmonic;}
+
+  Double_t ReQ(Int_t h, Int_t p) const {return fReQ[h*(fMaxPower+1)+p];}   // Re[Q_{h*n,p}]
+  Double_t ImQ(Int_t h, Int_t p) const {return fImQ[h*(fMaxPower+1)+p];}   // Im[Q_{h*n,p}]
+  Double_t SumOfWeights(Int_t p) const {return ReQ(0,p);}                   // sum_i w_i^p
+  TComplex Q(Int_t h, Int_t p) const;                                       // Q_{h*n,p}, Q_{-h*n,p} = Q_{h*n,p}^*
+
+  void FillMatrices(TMatrixD &reQ, TMatrixD &imQ) const; // adds Q_{(m+1)*n,k} to reQ(m,k) and imQ(m,k) within the matrix ranges
+
+  static void Harmonics(Double_t phi, Int_t maxHarmonic, Double_t *cosPhi, Double_t *sinPhi); // cos(h*phi), sin(h*phi) of one track, h = 0,...,maxHarmonic
+  static void Powers(Double_t weight, Int_t maxPower, Double_t *weightPow);                   // weight^p of one track, p = 0,...,maxPower
+
+ private:
+  AliFlowQVectorBuilder(const AliFlowQVectorBuilder& builder);
+  AliFlowQVectorBuilder& operator=(const AliFlowQVectorBuilder& builder);
+
+  Int_t fMaxHarmonic;               // highest multiple h of the base harmonic
+  Int_t fMaxPower;                  // highest weight power p
+  Int_t fBaseHarmonic;              // base harmonic n
+  std::vector<Double_t> fPhi;       //! packed azimuthal angles
+  std::vector<Double_t> fWeight;    //! packed weights
+  std::vector<Double_t> fReQ;       //! Re[Q_{h*n,p}], index h*(fMaxPower+1)+p
+  std::vector<Double_t> fImQ;       //! Im[Q_{h*n,p}], index h*(fMaxPower+1)+p
+  std::vector<Double_t> fWeightPow; //! scratch for the weight powers of one track
+
+  ClassDef(AliFlowQVectorBuilder, 1); // builder of flow Q-vectors
+};
+
+#endif
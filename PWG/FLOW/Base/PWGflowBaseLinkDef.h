@@ -8,6 +8,8 @@
 #pragma link C++ namespace AliFlowLYZConstants;
 
 #pragma link C++ class AliFlowVector+;
+#pragma link C++ class AliFlowQVectorBuilder+;
+#pragma link C++ class AliFlowPackedTracks+;
 #pragma link C++ class AliFlowTrackSimple+;
 #pragma link C++ class AliFlowEventSimple+;
 
@@ -31,6 +33,7 @@
 #pragma link C++ class AliFlowLYZEventPlane+;
 
 #pragma link C++ class AliFlowAnalysis+;
+#pragma link C++ class AliFlowAnalysisDriver+;
 #pragma link C++ class AliFlowAnalysisCRC+;
 #pragma link C++ class AliFlowAnalysisWithMCEventPlane+;
 #pragma link C++ class AliFlowAnalysisWithScalarProduct+;
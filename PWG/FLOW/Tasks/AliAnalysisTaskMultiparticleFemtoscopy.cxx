@@ -142,6 +142,8 @@ AliAnalysisTaskMultiparticleFemtoscopy::AliAnalysisTaskMultiparticleFemtoscopy(c
  fFill4pCorrelationFunctions(kFALSE),
  fNormalizationOption(0),
  fnMergedBins(-44),
+ fRestrictToHistogramRange(kTRUE),
+ fnSortedTracks(0),
  // 4.) Background:
  fBackgroundList(NULL),
  fBackgroundFlagsPro(NULL),
@@ -387,6 +389,8 @@ AliAnalysisTaskMultiparticleFemtoscopy::AliAnalysisTaskMultiparticleFemtoscopy()
  fFill4pCorrelationFunctions(kFALSE),
  fNormalizationOption(0),
  fnMergedBins(-44),
+ fRestrictToHistogramRange(kTRUE),
+ fnSortedTracks(0),
  // 4.) Background:
  fBackgroundList(NULL),
  fBackgroundFlagsPro(NULL),
@@ -4805,192 +4809,121 @@ Bool_t AliAnalysisTaskMultiparticleFemtoscopy::PassesMixedEventCuts(AliVEvent *a
 
 //=======================================================================================================================
 
-void AliAnalysisTaskMultiparticleFemtoscopy::CalculateCorrelationFunctions(AliAODEvent *aAOD)
+void AliAnalysisTaskMultiparticleFemtoscopy::FillSpeciesSortedTracks(AliAODEvent *aAOD)
 {
- // Calculate correlation functions.
+ // Single pass over the tracks of the event, shared by 2p, 3p and 4p correlation functions.
 
  // a) Insanity checks;
- // b) Two nested loops to calculate C(k), just an example; TBI
- // c) Three nested loops to calculate C(Q3), just an example; TBI
- // d) Four nested loops to calculate C(Q4), just an example. TBI
+ // b) Select the tracks and identify them once. The four-momenta are stored, and the indices are sorted per species;
+ // c) Table of Q2 for all pairs of identified tracks.
 
  // a) Insanity checks:
- TString sMethodName = "void AliAnalysisTaskMultiparticleFemtoscopy::CalculateCorrelationFunctions(AliAODEvent *aAOD)";
+ TString sMethodName = "void AliAnalysisTaskMultiparticleFemtoscopy::FillSpeciesSortedTracks(AliAODEvent *aAOD)";
  if(!aAOD){Fatal(sMethodName.Data(),"!aAOD");}
  if(0 == fGlobalTracksAOD[0]->GetSize()){Fatal(sMethodName.Data(),"0 == fGlobalTracksAOD[0]->GetSize()");} // this case shall be already treated in UserExec
 
- // b) Two nested loops to calculate C(k), just an example:
+ // b) Select the tracks and identify them once:
+ fnSortedTracks = 0;
+ fSortedTracksP4.clear();
+ fSortedTracksGID.clear();
+ for(Int_t pid=0;pid<10;pid++){fSpeciesSortedTracks[pid].clear();}
  Int_t nTracks = aAOD->GetNumberOfTracks();
- for(Int_t iTrack1=0;iTrack1<nTracks;iTrack1++)
+ for(Int_t iTrack=0;iTrack<nTracks;iTrack++)
  {
-  AliAODTrack *atrack1 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack1));
+  AliAODTrack *atrack = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack));
   // TBI Temporary track insanity checks:
-  if(!atrack1){Fatal(sMethodName.Data(),"!atrack1");} // TBI keep this for some time, eventually just continue
-  if(atrack1->GetID()>=0 && atrack1->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack1->GetID()>=0 && atrack1->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-  if(atrack1->TestFilterBit(128) && atrack1->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack1->TestFiletrBit(128) && atrack1->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-  if(!PassesCommonTrackCuts(atrack1)){continue;} // TBI re-think
+  if(!atrack){Fatal(sMethodName.Data(),"!atrack");} // TBI keep this for some time, eventually just continue
+  if(atrack->GetID()>=0 && atrack->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack->GetID()>=0 && atrack->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
+  if(atrack->TestFilterBit(128) && atrack->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack->TestFiletrBit(128) && atrack->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
+  if(!PassesCommonTrackCuts(atrack)){continue;} // TBI re-think
   // Corresponding AOD global track:
-  Int_t id1 = atrack1->GetID();
-  AliAODTrack *gtrack1 = dynamic_cast<AliAODTrack*>(id1>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id1)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id1+1))));
-  if(!gtrack1){Fatal(sMethodName.Data(),"!gtrack1");} // TBI keep this for some time, eventually just continue
-  Int_t gid1 = (id1>=0 ? id1 : -(id1+1)); // ID of corresponding global track
+  Int_t id = atrack->GetID();
+  AliAODTrack *gtrack = dynamic_cast<AliAODTrack*>(id>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id+1))));
+  if(!gtrack){Fatal(sMethodName.Data(),"!gtrack");} // TBI keep this for some time, eventually just continue
+  Int_t gid = (id>=0 ? id : -(id+1)); // ID of corresponding global track
   // Common track selection criteria for all "normal" global tracks:
-  if(!PassesGlobalTrackCuts(gtrack1)){continue;}
-
-  // Loop over the 2nd particle:
-  for(Int_t iTrack2=iTrack1+1;iTrack2<nTracks;iTrack2++)
+  if(!PassesGlobalTrackCuts(gtrack)){continue;}
+
+  // PID, only once per track:
+  Bool_t bSpecies[10] = {kFALSE};
+  bSpecies[2] = Pion(gtrack,1,kTRUE);
+  bSpecies[7] = Pion(gtrack,-1,kTRUE);
+  bSpecies[3] = Kaon(gtrack,1,kTRUE);
+  bSpecies[8] = Kaon(gtrack,-1,kTRUE);
+  bSpecies[4] = Proton(gtrack,1,kTRUE);
+  bSpecies[9] = Proton(gtrack,-1,kTRUE);
+  if(!(bSpecies[2] || bSpecies[7] || bSpecies[3] || bSpecies[8] || bSpecies[4] || bSpecies[9])){continue;} // not used in any correlation function
+
+  // Kinematics either from 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, from 'atrack':
+  AliAODTrack *agtrack = (fFillControlHistogramsWithGlobalTrackInfo ? gtrack : atrack);
+  fSortedTracksP4.push_back(agtrack->Px());
+  fSortedTracksP4.push_back(agtrack->Py());
+  fSortedTracksP4.push_back(agtrack->Pz());
+  fSortedTracksP4.push_back(agtrack->E());
+  fSortedTracksGID.push_back(gid);
+  for(Int_t pid=0;pid<10;pid++)
   {
-   AliAODTrack *atrack2 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack2));
-   // TBI Temporary track insanity checks:
-   if(!atrack2){Fatal(sMethodName.Data(),"!atrack2");} // TBI keep this for some time, eventually just continue
-   if(atrack2->GetID()>=0 && atrack2->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack2->GetID()>=0 && atrack2->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-   if(atrack2->TestFilterBit(128) && atrack2->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack2->TestFiletrBit(128) && atrack2->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-   if(!PassesCommonTrackCuts(atrack2)){continue;} // TBI re-think
-   // Corresponding AOD global track:
-   Int_t id2 = atrack2->GetID();
-   AliAODTrack *gtrack2 = dynamic_cast<AliAODTrack*>(id2>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id2)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id2+1))));
-   if(!gtrack2){Fatal(sMethodName.Data(),"!gtrack2");} // TBI keep this for some time, eventually just continue
-   Int_t gid2 = (id2>=0 ? id2 : -(id2+1)); // ID of corresponding global track
-   if(gid1==gid2){continue;} // Eliminate self-correlations:
+   if(bSpecies[pid]){fSpeciesSortedTracks[pid].push_back(fnSortedTracks);} // indices stay in the order of the tracks in the event
+  }
+  fnSortedTracks++;
+ } // for(Int_t iTrack=0;iTrack<nTracks;iTrack++)
 
-   // Common track selection criteria for all "normal" global tracks:
-   if(!PassesGlobalTrackCuts(gtrack2)){continue;}
+ // c) Table of Q2 for all pairs of identified tracks:
+ fPairQ2.assign(fnSortedTracks*fnSortedTracks,0.);
+ for(Int_t t1=0;t1<fnSortedTracks;t1++)
+ {
+  TLorentzVector lv1(fSortedTracksP4[4*t1],fSortedTracksP4[4*t1+1],fSortedTracksP4[4*t1+2],fSortedTracksP4[4*t1+3]);
+  for(Int_t t2=t1+1;t2<fnSortedTracks;t2++)
+  {
+   TLorentzVector lv2(fSortedTracksP4[4*t2],fSortedTracksP4[4*t2+1],fSortedTracksP4[4*t2+2],fSortedTracksP4[4*t2+3]);
+   fPairQ2[t1*fnSortedTracks+t2] = fPairQ2[t2*fnSortedTracks+t1] = Q2(lv1,lv2);
+  }
+ }
 
-   // Okay, so we have two tracks, let's decide whether kinemetics from 'atrack' or 'gtrack' is taken, let's check PID, and fill the correlation functions:
-   AliAODTrack *agtrack1 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-   AliAODTrack *agtrack2 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-   if(fFillControlHistogramsWithGlobalTrackInfo)
-   {
-    agtrack1 = gtrack1;
-    agtrack2 = gtrack2;
-   }
-   else
-   {
-    agtrack1 = atrack1;
-    agtrack2 = atrack2;
-   } // if(fFillControlHistogramsWithGlobalTrackInfo)
-   if(!agtrack1){Fatal(sMethodName.Data(),"!agtrack1");}
-   if(!agtrack2){Fatal(sMethodName.Data(),"!agtrack2");}
+} // void AliAnalysisTaskMultiparticleFemtoscopy::FillSpeciesSortedTracks(AliAODEvent *aAOD)
 
-   // 1.) Same particle species:
+//=======================================================================================================================
 
-   // a) pion-pion:
-   //  a1) pi+pi+ [2][2]:
-   if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE))
-   {
-    fCorrelationFunctions[2][2]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  a2) pi-pi- [7][7]:
-   if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[7][7]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  a3) pi+pi- || pi-pi+ [2][7]:
-   if((Pion(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE)) || (Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,1,kTRUE)))
-   {
-    fCorrelationFunctions[2][7]->Fill(Q2(agtrack1,agtrack2));
-   }
+void AliAnalysisTaskMultiparticleFemtoscopy::CalculateCorrelationFunctions(AliAODEvent *aAOD)
+{
+ // Calculate correlation functions.
 
-   // b) kaon-kaon:
-   //  b1) K+K+ [3][3]:
-   if(Kaon(gtrack1,1,kTRUE) && Kaon(gtrack2,1,kTRUE))
-   {
-    fCorrelationFunctions[3][3]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  b2) K-K- [8][8]:
-   if(Kaon(gtrack1,-1,kTRUE) && Kaon(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[8][8]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  b3) K+K- || K-K+ [3][8]:
-   if((Kaon(gtrack1,1,kTRUE) && Kaon(gtrack2,-1,kTRUE)) || (Kaon(gtrack1,-1,kTRUE) && Kaon(gtrack2,1,kTRUE)))
-   {
-    fCorrelationFunctions[3][8]->Fill(Q2(agtrack1,agtrack2));
-   }
+ // a) Insanity checks, and species-sorted tracks of this event;
+ // b) Two nested loops to calculate C(k), just an example; TBI
+ // c) Three nested loops to calculate C(Q3), just an example; TBI
+ // d) Four nested loops to calculate C(Q4), just an example. TBI
 
-   // c) proton-proton:
-   //  c1) p+p+ [4][4]:
-   if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE))
-   {
-    fCorrelationFunctions[4][4]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  c2) p-p- [9][9]:
-   if(Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[9][9]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  c3) p+p- || p-p+ [4][9]:
-   if((Proton(gtrack1,1,kTRUE) && Proton(gtrack2,-1,kTRUE)) || (Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,1,kTRUE)))
-   {
-    fCorrelationFunctions[4][9]->Fill(Q2(agtrack1,agtrack2));
-   }
+ // a) Insanity checks, and species-sorted tracks of this event:
+ TString sMethodName = "void AliAnalysisTaskMultiparticleFemtoscopy::CalculateCorrelationFunctions(AliAODEvent *aAOD)";
+ if(!aAOD){Fatal(sMethodName.Data(),"!aAOD");}
+ this->FillSpeciesSortedTracks(aAOD);
 
-   // 2.) Mixed particle species:
-   // a) pion-kaon
-   //  a1) pi+K+ [2][3]:
-   if(Pion(gtrack1,1,kTRUE) && Kaon(gtrack2,1,kTRUE))
-   {
-    fCorrelationFunctions[2][3]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  a2) pi+K- [2][8]
-   if(Pion(gtrack1,1,kTRUE) && Kaon(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[2][8]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  a3) K+pi- [3][7]
-   if(Kaon(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[3][7]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  a4) pi-K- [7][8]
-   if(Pion(gtrack1,-1,kTRUE) && Kaon(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[7][8]->Fill(Q2(agtrack1,agtrack2));
-   }
-   // b) pion-proton
-   //  b1) pi+p+ [2][4]:
-   if(Pion(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE))
-   {
-    fCorrelationFunctions[2][4]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  b2) pi+p- [2][9]
-   if(Pion(gtrack1,1,kTRUE) && Proton(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[2][9]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  b3) p+pi- [4][7]
-   if(Proton(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[4][7]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  b4) pi-p- [7][9]
-   if(Pion(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[7][9]->Fill(Q2(agtrack1,agtrack2));
-   }
-   // c) kaon-proton
-   //  c1) K+p+ [3][4]:
-   if(Kaon(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE))
-   {
-    fCorrelationFunctions[3][4]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  c2) K+p- [3][9]
-   if(Kaon(gtrack1,1,kTRUE) && Proton(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[3][9]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  c3) p+K- [4][8]
-   if(Proton(gtrack1,1,kTRUE) && Kaon(gtrack2,-1,kTRUE))
-   {
-    fCorrelationFunctions[4][8]->Fill(Q2(agtrack1,agtrack2));
-   }
-   //  c4) K-p- [8][9]
-   if(Kaon(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE))
+ // b) Two nested loops to calculate C(k), just an example:
+ //    [pid1][pid2] of the correlation function, and whether the two tracks can come in any order (e.g. pi+pi- || pi-pi+).
+ //    Otherwise, the 1st particle shall come first in the event (e.g. pi+K+):
+ const Int_t n2p = 21;
+ const Int_t pid2p[n2p][3] = {{2,2,0},{7,7,0},{2,7,1}, // 1.) a) pion-pion
+                              {3,3,0},{8,8,0},{3,8,1}, //     b) kaon-kaon
+                              {4,4,0},{9,9,0},{4,9,1}, //     c) proton-proton
+                              {2,3,0},{2,8,0},{3,7,0},{7,8,0},  // 2.) a) pion-kaon
+                              {2,4,0},{2,9,0},{4,7,0},{7,9,0},  //     b) pion-proton
+                              {3,4,0},{3,9,0},{4,8,0},{8,9,0}}; //     c) kaon-proton
+ for(Int_t c=0;c<n2p;c++)
+ {
+  const std::vector<Int_t> &tracks1 = fSpeciesSortedTracks[pid2p[c][0]];
+  const std::vector<Int_t> &tracks2 = fSpeciesSortedTracks[pid2p[c][1]];
+  for(UInt_t i1=0;i1<tracks1.size();i1++)
+  {
+   Int_t t1 = tracks1[i1];
+   for(UInt_t i2=0;i2<tracks2.size();i2++)
    {
-    fCorrelationFunctions[8][9]->Fill(Q2(agtrack1,agtrack2));
+    Int_t t2 = tracks2[i2];
+    if(pid2p[c][2] ? t2==t1 : t2<=t1){continue;} // Eliminate self-evident self-correlations, and permutations as well
+    if(fSortedTracksGID[t1]==fSortedTracksGID[t2]){continue;} // Eliminate not-so-evident self-correlations
+    fCorrelationFunctions[pid2p[c][0]][pid2p[c][1]]->Fill(fPairQ2[t1*fnSortedTracks+t2]);
    }
-  } // for(Int_t iTrack2=0;iTrack2<nTracks;iTrack2++)
- } // for(Int_t iTrack1=0;iTrack1<nTracks;iTrack1++)
+  }
+ } // for(Int_t c=0;c<n2p;c++)
 
  // c) Three nested loops to calculate C(Q3), just an example; TBI
  if(fFill3pCorrelationFunctions) this->Calculate3pCorrelationFunctions(aAOD);
@@ -5004,7 +4937,7 @@ void AliAnalysisTaskMultiparticleFemtoscopy::CalculateCorrelationFunctions(AliAO
 
 void AliAnalysisTaskMultiparticleFemtoscopy::Calculate3pCorrelationFunctions(AliAODEvent *aAOD)
 {
- // Calculate 3-particle correlation functions.
+ // Calculate 3-particle correlation functions, from the species-sorted tracks and the pair table of FillSpeciesSortedTracks.
 
  // a) Insanity checks;
  // b) Three nested loops to calculate C(Q3), just an example.
@@ -5012,261 +4945,44 @@ void AliAnalysisTaskMultiparticleFemtoscopy::Calculate3pCorrelationFunctions(Ali
  // a) Insanity checks:
  TString sMethodName = "void AliAnalysisTaskMultiparticleFemtoscopy::Calculate3pCorrelationFunctions(AliAODEvent *aAOD)";
  if(!aAOD){Fatal(sMethodName.Data(),"!aAOD");}
- if(0 == fGlobalTracksAOD[0]->GetSize()){Fatal(sMethodName.Data(),"0 == fGlobalTracksAOD[0]->GetSize()");} // this case shall be already treated in UserExec
+ if((Int_t)fSortedTracksGID.size() != fnSortedTracks){Fatal(sMethodName.Data(),"(Int_t)fSortedTracksGID.size() != fnSortedTracks");} // FillSpeciesSortedTracks shall be already called
 
  // b) Three nested loops to calculate C(Q3), just an example:
- Int_t nTracks = aAOD->GetNumberOfTracks();
- for(Int_t iTrack1=0;iTrack1<nTracks;iTrack1++)
- {
-  AliAODTrack *atrack1 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack1));
-  // TBI Temporary track insanity checks:
-  if(!atrack1){Fatal(sMethodName.Data(),"!atrack1");} // TBI keep this for some time, eventually just continue
-  if(atrack1->GetID()>=0 && atrack1->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack1->GetID()>=0 && atrack1->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-  if(atrack1->TestFilterBit(128) && atrack1->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack1->TestFiletrBit(128) && atrack1->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-  if(!PassesCommonTrackCuts(atrack1)){continue;} // TBI re-think
-  // Corresponding AOD global track:
-  Int_t id1 = atrack1->GetID();
-  AliAODTrack *gtrack1 = dynamic_cast<AliAODTrack*>(id1>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id1)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id1+1))));
-  if(!gtrack1){Fatal(sMethodName.Data(),"!gtrack1");} // TBI keep this for some time, eventually just continue
-  Int_t gid1 = (id1>=0 ? id1 : -(id1+1)); // ID of corresponding global track
-  // Common track selection criteria for all "normal" global tracks:
-  if(!PassesGlobalTrackCuts(gtrack1)){continue;}
-
-  // Loop over the 2nd particle:
-  for(Int_t iTrack2=0;iTrack2<nTracks;iTrack2++)
+ //    Q3 is not smaller than any of the three Q2, so with fRestrictToHistogramRange a pair beyond fnQ3max can only land in the overflow.
+ //    Tracks come in the order of the event (modulo permutations). Cases of interest:
+ const Int_t n3p = 32;
+ const Int_t pid3p[n3p][3] = {{2,2,2},{7,7,7},{3,3,3},{8,8,8},{4,4,4},{9,9,9}, // a) Same species and same charge
+                              {2,2,7},{2,7,7},{3,3,8},{3,8,8},{4,4,9},{4,9,9}, // b) Same species but different charge combinations
+                              {2,2,3},{2,2,8},{7,7,3},{7,7,8},{2,7,3},{2,7,8},{2,2,4},{2,2,9},{7,7,4},{7,7,9},{2,7,4},{2,7,9}, // c) Two pions + something else
+                              {4,4,2},{4,4,7},{4,4,3},{4,4,8},{9,9,2},{9,9,7},{9,9,3},{9,9,8}}; // d) Two nucleons + something else
+ Double_t dQ2max = (fRestrictToHistogramRange ? fnQ3max : 1.e44);
+ for(Int_t c=0;c<n3p;c++)
+ {
+  const std::vector<Int_t> &tracks1 = fSpeciesSortedTracks[pid3p[c][0]];
+  const std::vector<Int_t> &tracks2 = fSpeciesSortedTracks[pid3p[c][1]];
+  const std::vector<Int_t> &tracks3 = fSpeciesSortedTracks[pid3p[c][2]];
+  for(UInt_t i1=0;i1<tracks1.size();i1++)
   {
-   if(iTrack2<=iTrack1){continue;} // Eliminate self-evident self-correlations, and permutations as well
-   AliAODTrack *atrack2 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack2));
-   // TBI Temporary track insanity checks:
-   if(!atrack2){Fatal(sMethodName.Data(),"!atrack2");} // TBI keep this for some time, eventually just continue
-   if(atrack2->GetID()>=0 && atrack2->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack2->GetID()>=0 && atrack2->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-   if(atrack2->TestFilterBit(128) && atrack2->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack2->TestFiletrBit(128) && atrack2->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-   if(!PassesCommonTrackCuts(atrack2)){continue;} // TBI re-think
-   // Corresponding AOD global track:
-   Int_t id2 = atrack2->GetID();
-   AliAODTrack *gtrack2 = dynamic_cast<AliAODTrack*>(id2>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id2)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id2+1))));
-   if(!gtrack2){Fatal(sMethodName.Data(),"!gtrack2");} // TBI keep this for some time, eventually just continue
-   Int_t gid2 = (id2>=0 ? id2 : -(id2+1)); // ID of corresponding global track
-   if(gid1==gid2){continue;} // Eliminate not-so-evident self-correlations:
-   // Common track selection criteria for all "normal" global tracks:
-   if(!PassesGlobalTrackCuts(gtrack2)){continue;}
-
-   // Loop over the 3rd particle:
-   for(Int_t iTrack3=0;iTrack3<nTracks;iTrack3++)
-   {
-    if(iTrack3<=iTrack2 || iTrack3<=iTrack1){continue;} // Eliminate self-evident self-correlations, and permutations as well
-    AliAODTrack *atrack3 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack3));
-    // TBI Temporary track insanity checks:
-    if(!atrack3){Fatal(sMethodName.Data(),"!atrack3");} // TBI keep this for some time, eventually just continue
-    if(atrack3->GetID()>=0 && atrack3->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack3->GetID()>=0 && atrack3->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-    if(atrack3->TestFilterBit(128) && atrack3->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack3->TestFiletrBit(128) && atrack3->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-    if(!PassesCommonTrackCuts(atrack3)){continue;} // TBI re-think
-    // Corresponding AOD global track:
-    Int_t id3 = atrack3->GetID();
-    AliAODTrack *gtrack3 = dynamic_cast<AliAODTrack*>(id3>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id3)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id3+1))));
-    if(!gtrack3){Fatal(sMethodName.Data(),"!gtrack3");} // TBI keep this for some time, eventually just continue
-    Int_t gid3 = (id3>=0 ? id3 : -(id3+1)); // ID of corresponding global track
-    if(gid3==gid2 || gid3==gid1){continue;} // Eliminate not-so-evident self-correlations
-    // Common track selection criteria for all "normal" global tracks:
-    if(!PassesGlobalTrackCuts(gtrack3)){continue;}
-
-    // Okay, so we have three tracks, let's decide whether kinemetics from 'atrack' or 'gtrack' is taken, let's check PID, and fill the correlation functions:
-    AliAODTrack *agtrack1 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-    AliAODTrack *agtrack2 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-    AliAODTrack *agtrack3 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-    if(fFillControlHistogramsWithGlobalTrackInfo)
-    {
-     agtrack1 = gtrack1;
-     agtrack2 = gtrack2;
-     agtrack3 = gtrack3;
-    }
-    else
-    {
-     agtrack1 = atrack1;
-     agtrack2 = atrack2;
-     agtrack3 = atrack3;
-    } // if(fFillControlHistogramsWithGlobalTrackInfo)
-    if(!agtrack1){Fatal(sMethodName.Data(),"!agtrack1");}
-    if(!agtrack2){Fatal(sMethodName.Data(),"!agtrack2");}
-    if(!agtrack3){Fatal(sMethodName.Data(),"!agtrack3");}
-
-    // Cases of interest:
-    // a) Same species and same charge;
-    // b) Same species but different charge combinations (modulo permutations);
-    // c) Two pions + something else (modulo permutations);
-    // d) Two nucleons + something else (modulo permutations).
-
-    // a) Same species:
-    // pi+pi+pi+
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Pion(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][2][2]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi-pi-pi-
-    if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Pion(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[7][7][7]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // K+K+K+
-    if(Kaon(gtrack1,1,kTRUE) && Kaon(gtrack2,1,kTRUE) && Kaon(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[3][3][3]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // K-K-K-
-    if(Kaon(gtrack1,-1,kTRUE) && Kaon(gtrack2,-1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[8][8][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p+p+p+
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE) && Proton(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][4][4]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p-p-p-
-    if(Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE) && Proton(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[9][9][9]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-
-    // b) Same species but different charge combinations (modulo permutations):
-    // pi+pi+pi-
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Pion(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][2][7]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi-pi-
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Pion(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][7][7]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // K+K+K-
-    if(Kaon(gtrack1,1,kTRUE) && Kaon(gtrack2,1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[3][3][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // K+K-K-
-    if(Kaon(gtrack1,1,kTRUE) && Kaon(gtrack2,-1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[3][8][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p+p+p-
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE) && Proton(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][4][9]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p+p-p-
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,-1,kTRUE) && Proton(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][9][9]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-
-    // c) Two pions + something else (modulo permutations):
-    // pi+pi+K+
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Kaon(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][2][3]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi+K-
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][2][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi-pi-K+
-    if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Kaon(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[7][7][3]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi-pi-K-
-    if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[7][7][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi-K+
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Kaon(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][7][3]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi-K-
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][7][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi+p+
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Proton(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][2][4]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi+p-
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Proton(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][2][9]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi-pi-p+
-    if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Proton(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[7][7][4]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi-pi-p-
-    if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Proton(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[7][7][9]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi-p+
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Proton(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][7][4]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // pi+pi-p-
-    if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Proton(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[2][7][9]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-
-    // d) Two nucleons + something else (modulo permutations):
-    // p+p+pi+
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE) && Pion(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][4][2]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p+p+pi-
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE) && Pion(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][4][7]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p+p+K+
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE) && Kaon(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][4][3]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p+p+K-
-    if(Proton(gtrack1,1,kTRUE) && Proton(gtrack2,1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[4][4][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p-p-pi+
-    if(Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE) && Pion(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[9][9][2]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p-p-pi-
-    if(Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE) && Pion(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[9][9][7]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p-p-K+
-    if(Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE) && Kaon(gtrack3,1,kTRUE))
-    {
-     f3pCorrelationFunctions[9][9][3]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-    // p-p-K-
-    if(Proton(gtrack1,-1,kTRUE) && Proton(gtrack2,-1,kTRUE) && Kaon(gtrack3,-1,kTRUE))
-    {
-     f3pCorrelationFunctions[9][9][8]->Fill(Q3(agtrack1,agtrack2,agtrack3));
-    }
-
-   } // for(Int_t iTrack3=0;iTrack3<nTracks;iTrack3++)
-  } // for(Int_t iTrack3=0;iTrack3<nTracks;iTrack3++)
- } // for(Int_t iTrack3=0;iTrack3<nTracks;iTrack3++)
+   Int_t t1 = tracks1[i1];
+   const Double_t *q1 = &fPairQ2[t1*fnSortedTracks]; // Q2 of the 1st track with all others
+   for(UInt_t i2=0;i2<tracks2.size();i2++)
+   {
+    Int_t t2 = tracks2[i2];
+    if(t2<=t1){continue;} // Eliminate self-evident self-correlations, and permutations as well
+    if(fSortedTracksGID[t1]==fSortedTracksGID[t2]){continue;} // Eliminate not-so-evident self-correlations
+    if(q1[t2]>=dQ2max){continue;}
+    const Double_t *q2 = &fPairQ2[t2*fnSortedTracks]; // Q2 of the 2nd track with all others
+    for(UInt_t i3=0;i3<tracks3.size();i3++)
+    {
+     Int_t t3 = tracks3[i3];
+     if(t3<=t2){continue;} // Eliminate self-evident self-correlations, and permutations as well
+     if(fSortedTracksGID[t3]==fSortedTracksGID[t2] || fSortedTracksGID[t3]==fSortedTracksGID[t1]){continue;} // Eliminate not-so-evident self-correlations
+     if(q1[t3]>=dQ2max || q2[t3]>=dQ2max){continue;}
+     f3pCorrelationFunctions[pid3p[c][0]][pid3p[c][1]][pid3p[c][2]]->Fill(pow(pow(q1[t2],2.)+pow(q1[t3],2.)+pow(q2[t3],2.),0.5));
+    } // for(UInt_t i3=0;i3<tracks3.size();i3++)
+   } // for(UInt_t i2=0;i2<tracks2.size();i2++)
+  } // for(UInt_t i1=0;i1<tracks1.size();i1++)
+ } // for(Int_t c=0;c<n3p;c++)
 
 } // void AliAnalysisTaskMultiparticleFemtoscopy::Calculate3pCorrelationFunctions()
 
@@ -5274,7 +4990,7 @@ void AliAnalysisTaskMultiparticleFemtoscopy::Calculate3pCorrelationFunctions(Ali
 
 void AliAnalysisTaskMultiparticleFemtoscopy::Calculate4pCorrelationFunctions(AliAODEvent *aAOD)
 {
- // Calculate 4-particle correlation functions.
+ // Calculate 4-particle correlation functions, from the species-sorted tracks and the pair table of FillSpeciesSortedTracks.
 
  // a) Insanity checks;
  // b) Four nested loops to calculate C(Q4), just an example.
@@ -5282,126 +4998,50 @@ void AliAnalysisTaskMultiparticleFemtoscopy::Calculate4pCorrelationFunctions(Ali
  // a) Insanity checks:
  TString sMethodName = "void AliAnalysisTaskMultiparticleFemtoscopy::Calculate4pCorrelationFunctions(AliAODEvent *aAOD)";
  if(!aAOD){Fatal(sMethodName.Data(),"!aAOD");}
- if(0 == fGlobalTracksAOD[0]->GetSize()){Fatal(sMethodName.Data(),"0 == fGlobalTracksAOD[0]->GetSize()");} // this case shall be already treated in UserExec
+ if((Int_t)fSortedTracksGID.size() != fnSortedTracks){Fatal(sMethodName.Data(),"(Int_t)fSortedTracksGID.size() != fnSortedTracks");} // FillSpeciesSortedTracks shall be already called
 
  // b) Four nested loops to calculate C(Q4), just an example:
- Int_t nTracks = aAOD->GetNumberOfTracks();
- for(Int_t iTrack1=0;iTrack1<nTracks;iTrack1++)
- {
-  AliAODTrack *atrack1 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack1));
-  // TBI Temporary track insanity checks:
-  if(!atrack1){Fatal(sMethodName.Data(),"!atrack1");} // TBI keep this for some time, eventually just continue
-  if(atrack1->GetID()>=0 && atrack1->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack1->GetID()>=0 && atrack1->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-  if(atrack1->TestFilterBit(128) && atrack1->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack1->TestFiletrBit(128) && atrack1->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-  if(!PassesCommonTrackCuts(atrack1)){continue;} // TBI re-think
-  // Corresponding AOD global track:
-  Int_t id1 = atrack1->GetID();
-  AliAODTrack *gtrack1 = dynamic_cast<AliAODTrack*>(id1>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id1)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id1+1))));
-  if(!gtrack1){Fatal(sMethodName.Data(),"!gtrack1");} // TBI keep this for some time, eventually just continue
-  Int_t gid1 = (id1>=0 ? id1 : -(id1+1)); // ID of corresponding global track
-  // Common track selection criteria for all "normal" global tracks:
-  if(!PassesGlobalTrackCuts(gtrack1)){continue;}
-
-  // Loop over the 2nd particle:
-  for(Int_t iTrack2=0;iTrack2<nTracks;iTrack2++)
+ //    All permutations are taken. Q4 is not smaller than any of the six Q2, so with fRestrictToHistogramRange a pair beyond fnQ4max can only land in the overflow.
+ // TBI
+ // First test example: pi+pi+pi+pi+, second test example: pi-pi-pi-pi-
+ const Int_t n4p = 2;
+ const Int_t pid4p[n4p] = {2,7};
+ Double_t dQ2max = (fRestrictToHistogramRange ? fnQ4max : 1.e44);
+ for(Int_t c=0;c<n4p;c++)
+ {
+  const std::vector<Int_t> &tracks = fSpeciesSortedTracks[pid4p[c]];
+  Int_t n = tracks.size();
+  for(Int_t i1=0;i1<n;i1++)
   {
-   if(iTrack1==iTrack2){continue;} // Eliminate self-evident self-correlations
-   AliAODTrack *atrack2 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack2));
-   // TBI Temporary track insanity checks:
-   if(!atrack2){Fatal(sMethodName.Data(),"!atrack2");} // TBI keep this for some time, eventually just continue
-   if(atrack2->GetID()>=0 && atrack2->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack2->GetID()>=0 && atrack2->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-   if(atrack2->TestFilterBit(128) && atrack2->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack2->TestFiletrBit(128) && atrack2->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-   if(!PassesCommonTrackCuts(atrack2)){continue;} // TBI re-think
-   // Corresponding AOD global track:
-   Int_t id2 = atrack2->GetID();
-   AliAODTrack *gtrack2 = dynamic_cast<AliAODTrack*>(id2>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id2)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id2+1))));
-   if(!gtrack2){Fatal(sMethodName.Data(),"!gtrack2");} // TBI keep this for some time, eventually just continue
-   Int_t gid2 = (id2>=0 ? id2 : -(id2+1)); // ID of corresponding global track
-   if(gid1==gid2){continue;} // Eliminate not-so-evident self-correlations:
-   // Common track selection criteria for all "normal" global tracks:
-   if(!PassesGlobalTrackCuts(gtrack2)){continue;}
-
-   // Loop over the 3rd particle:
-   for(Int_t iTrack3=0;iTrack3<nTracks;iTrack3++)
-   {
-    if(iTrack3==iTrack2 || iTrack3==iTrack1){continue;} // Eliminate self-evident self-correlations
-    AliAODTrack *atrack3 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack3));
-    // TBI Temporary track insanity checks:
-    if(!atrack3){Fatal(sMethodName.Data(),"!atrack3");} // TBI keep this for some time, eventually just continue
-    if(atrack3->GetID()>=0 && atrack3->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack3->GetID()>=0 && atrack3->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-    if(atrack3->TestFilterBit(128) && atrack3->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack3->TestFiletrBit(128) && atrack3->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-    if(!PassesCommonTrackCuts(atrack3)){continue;} // TBI re-think
-    // Corresponding AOD global track:
-    Int_t id3 = atrack3->GetID();
-    AliAODTrack *gtrack3 = dynamic_cast<AliAODTrack*>(id3>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id3)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id3+1))));
-    if(!gtrack3){Fatal(sMethodName.Data(),"!gtrack3");} // TBI keep this for some time, eventually just continue
-    Int_t gid3 = (id3>=0 ? id3 : -(id3+1)); // ID of corresponding global track
-    if(gid3==gid2 || gid3==gid1){continue;} // Eliminate not-so-evident self-correlations
-    // Common track selection criteria for all "normal" global tracks:
-    if(!PassesGlobalTrackCuts(gtrack3)){continue;}
-
-    // Loop over the 4th particle:
-    for(Int_t iTrack4=0;iTrack4<nTracks;iTrack4++)
-    {
-     if(iTrack4==iTrack3 || iTrack4==iTrack2 || iTrack4==iTrack1){continue;} // Eliminate self-evident self-correlations
-     AliAODTrack *atrack4 = dynamic_cast<AliAODTrack*>(aAOD->GetTrack(iTrack4));
-     // TBI Temporary track insanity checks:
-     if(!atrack4){Fatal(sMethodName.Data(),"!atrack4");} // TBI keep this for some time, eventually just continue
-     if(atrack4->GetID()>=0 && atrack4->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack4->GetID()>=0 && atrack4->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-     if(atrack4->TestFilterBit(128) && atrack4->IsGlobalConstrained()){Fatal(sMethodName.Data(),"atrack4->TestFiletrBit(128) && atrack4->IsGlobalConstrained()");} // TBI keep this for some time, eventually just continue
-     if(!PassesCommonTrackCuts(atrack4)){continue;} // TBI re-think
-     // Corresponding AOD global track:
-     Int_t id4 = atrack4->GetID();
-     AliAODTrack *gtrack4 = dynamic_cast<AliAODTrack*>(id4>=0 ? aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(id4)) : aAOD->GetTrack(fGlobalTracksAOD[0]->GetValue(-(id4+1))));
-     if(!gtrack4){Fatal(sMethodName.Data(),"!gtrack4");} // TBI keep this for some time, eventually just continue
-     Int_t gid4 = (id4>=0 ? id4 : -(id4+1)); // ID of corresponding global track
-     if(gid4==gid3 || gid4==gid2 || gid4==gid1){continue;} // Eliminate not-so-evident self-correlations
-     // Common track selection criteria for all "normal" global tracks:
-     if(!PassesGlobalTrackCuts(gtrack4)){continue;}
-
-     // Okay, so we have four tracks, let's decide whether kinemetics from 'atrack' or 'gtrack' is taken, let's check PID, and fill the correlation functions:
-     AliAODTrack *agtrack1 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-     AliAODTrack *agtrack2 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-     AliAODTrack *agtrack3 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-     AliAODTrack *agtrack4 = NULL; // either 'atrack' or 'gtrack', depending on the flag fFillControlHistogramsWithGlobalTrackInfo. By default, agtrack = 'atrack'
-     if(fFillControlHistogramsWithGlobalTrackInfo)
+   Int_t t1 = tracks[i1];
+   Int_t gid1 = fSortedTracksGID[t1];
+   const Double_t *q1 = &fPairQ2[t1*fnSortedTracks];
+   for(Int_t i2=0;i2<n;i2++)
+   {
+    Int_t t2 = tracks[i2];
+    Int_t gid2 = fSortedTracksGID[t2];
+    if(i2==i1 || gid2==gid1){continue;} // Eliminate self-correlations
+    if(q1[t2]>=dQ2max){continue;}
+    const Double_t *q2 = &fPairQ2[t2*fnSortedTracks];
+    for(Int_t i3=0;i3<n;i3++)
+    {
+     Int_t t3 = tracks[i3];
+     Int_t gid3 = fSortedTracksGID[t3];
+     if(i3==i2 || i3==i1 || gid3==gid2 || gid3==gid1){continue;} // Eliminate self-correlations
+     if(q1[t3]>=dQ2max || q2[t3]>=dQ2max){continue;}
+     const Double_t *q3 = &fPairQ2[t3*fnSortedTracks];
+     for(Int_t i4=0;i4<n;i4++)
      {
-      agtrack1 = gtrack1;
-      agtrack2 = gtrack2;
-      agtrack3 = gtrack3;
-      agtrack4 = gtrack4;
-     }
-     else
-     {
-      agtrack1 = atrack1;
-      agtrack2 = atrack2;
-      agtrack3 = atrack3;
-      agtrack4 = atrack4;
-     } // if(fFillControlHistogramsWithGlobalTrackInfo)
-     if(!agtrack1){Fatal(sMethodName.Data(),"!agtrack1");}
-     if(!agtrack2){Fatal(sMethodName.Data(),"!agtrack2");}
-     if(!agtrack3){Fatal(sMethodName.Data(),"!agtrack3");}
-     if(!agtrack4){Fatal(sMethodName.Data(),"!agtrack4");}
-
-
-     // TBI
-     // First test example: pi+pi+pi+pi+
-     if(Pion(gtrack1,1,kTRUE) && Pion(gtrack2,1,kTRUE) && Pion(gtrack3,1,kTRUE) && Pion(gtrack4,1,kTRUE))
-     {
-      f4pCorrelationFunctions[2][2][2][2]->Fill(Q4(agtrack1,agtrack2,agtrack3,agtrack4)); // Lorentz invariant Q4
-     }
-
-     // Second test example: pi-pi-pi-pi-
-     if(Pion(gtrack1,-1,kTRUE) && Pion(gtrack2,-1,kTRUE) && Pion(gtrack3,-1,kTRUE) && Pion(gtrack4,-1,kTRUE))
-     {
-      f4pCorrelationFunctions[7][7][7][7]->Fill(Q4(agtrack1,agtrack2,agtrack3,agtrack4)); // Lorentz invariant Q4
-     }
-
-
-    } // for(Int_t iTrack4=0;iTrack4<nTracks;iTrack4++)
-   } // for(Int_t iTrack3=0;iTrack3<nTracks;iTrack3++)
-  } // for(Int_t iTrack2=0;iTrack2<nTracks;iTrack2++)
- } // for(Int_t iTrack1=0;iTrack1<nTracks;iTrack1++)
+      Int_t t4 = tracks[i4];
+      Int_t gid4 = fSortedTracksGID[t4];
+      if(i4==i3 || i4==i2 || i4==i1 || gid4==gid3 || gid4==gid2 || gid4==gid1){continue;} // Eliminate self-correlations
+      if(q1[t4]>=dQ2max || q2[t4]>=dQ2max || q3[t4]>=dQ2max){continue;}
+      f4pCorrelationFunctions[pid4p[c]][pid4p[c]][pid4p[c]][pid4p[c]]->Fill(pow(pow(q1[t2],2.)+pow(q1[t3],2.)+pow(q1[t4],2.)+pow(q2[t3],2.)+pow(q2[t4],2.)+pow(q3[t4],2.),0.5)); // Lorentz invariant Q4
+     } // for(Int_t i4=0;i4<n;i4++)
+    } // for(Int_t i3=0;i3<n;i3++)
+   } // for(Int_t i2=0;i2<n;i2++)
+  } // for(Int_t i1=0;i1<n;i1++)
+ } // for(Int_t c=0;c<n4p;c++)
 
 } // void AliAnalysisTaskMultiparticleFemtoscopy::Calculate4pCorrelationFunctions()
 
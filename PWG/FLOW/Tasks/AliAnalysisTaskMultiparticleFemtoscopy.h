@@ -31,6 +31,8 @@
 #include "THnSparse.h"
 #include "TSystem.h"
 
+#include <vector>
+
 //================================================================================================================
 
 class AliAnalysisTaskMultiparticleFemtoscopy : public AliAnalysisTaskSE{
@@ -123,6 +125,7 @@ class AliAnalysisTaskMultiparticleFemtoscopy : public AliAnalysisTaskSE{
   Bool_t SpecifiedEvent(UInt_t run, UShort_t bunchCross, UInt_t orbit, UInt_t period);
   Int_t CurrentEventNumber();
   virtual void DoSomeDebugging(AliVEvent *ave);
+  virtual void FillSpeciesSortedTracks(AliAODEvent *aAOD); // shared by 2p, 3p and 4p correlation functions
   virtual void CalculateCorrelationFunctions(AliAODEvent *aAOD);
    virtual void Calculate3pCorrelationFunctions(AliAODEvent *aAOD);
    virtual void Calculate4pCorrelationFunctions(AliAODEvent *aAOD);
@@ -247,6 +250,8 @@ class AliAnalysisTaskMultiparticleFemtoscopy : public AliAnalysisTaskSE{
   Bool_t GetFill3pCorrelationFunctions() const {return this->fFill3pCorrelationFunctions;};
   void SetFill4pCorrelationFunctions(Bool_t f4pcf) {this->fFill4pCorrelationFunctions = f4pcf;};
   Bool_t GetFill4pCorrelationFunctions() const {return this->fFill4pCorrelationFunctions;};
+  void SetRestrictToHistogramRange(Bool_t rthr) {this->fRestrictToHistogramRange = rthr;};
+  Bool_t GetRestrictToHistogramRange() const {return this->fRestrictToHistogramRange;};
   void SetNormalizationOption(Int_t fno) {this->fNormalizationOption = fno;};
   Int_t GetNormalizationOption() const {return this->fNormalizationOption;};
   void SetNormalizationInterval(Float_t min, Float_t max)
@@ -647,6 +652,12 @@ class AliAnalysisTaskMultiparticleFemtoscopy : public AliAnalysisTaskSE{
   Int_t fNormalizationOption;                    // set here how to normalize the correlation function: 0 = "just scale", 1 = "use concrete interval", 2 = ...
   Float_t fNormalizationInterval[2];             // concrete example: 0.15 < q < 0.175 GeV/c. Then, fNormalizationInterval[0] is the low edge, etc. See the relevant setter SetNormalizationInterval
   Int_t fnMergedBins;                            // before normalization, both signal and background will be rebinned with this value
+  Bool_t fRestrictToHistogramRange;              // 3p and 4p: skip combinations with a pair beyond fnQ3max (fnQ4max), which can only land in the overflow
+  Int_t fnSortedTracks;                          //! number of identified tracks in the current event, see FillSpeciesSortedTracks
+  std::vector<Double_t> fSortedTracksP4;         //! (px,py,pz,e) of each identified track, from 'atrack' or 'gtrack' as in the nested loops
+  std::vector<Int_t> fSortedTracksGID;           //! ID of the corresponding global track, to eliminate self-correlations
+  std::vector<Int_t> fSpeciesSortedTracks[10];   //! indices of the identified tracks in fSortedTracksP4, per species (same indexing as fCorrelationFunctions)
+  std::vector<Double_t> fPairQ2;                 //! Q2 of each pair of identified tracks, fnSortedTracks x fnSortedTracks
 
   // 4.) Background:
   TList *fBackgroundList;              // list to hold all background objects primary particle
@@ -800,7 +811,7 @@ class AliAnalysisTaskMultiparticleFemtoscopy : public AliAnalysisTaskSE{
   UInt_t fOrbit;                  // do something only for the specified event
   UInt_t fPeriod;                 // do something only for the specified event
 
-  ClassDef(AliAnalysisTaskMultiparticleFemtoscopy,23);
+  ClassDef(AliAnalysisTaskMultiparticleFemtoscopy,24);
 
 };
 
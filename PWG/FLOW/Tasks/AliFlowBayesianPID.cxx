@@ -36,7 +36,7 @@ TH1D* AliFlowBayesianPID::fgHtofChannelDist=NULL;
 
 //________________________________________________________________________
 AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid) 
-  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0)
+  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0),fUseResponseTables(kFALSE),fPriorsCentBin(-1)
 {
   // Constructor
   Bool_t redopriors = kFALSE;
@@ -124,6 +124,8 @@ AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid)
   fTPCResponseF->SetParameter(0,1./fTPCResponseF->Integral(-7,7));
   fTPCResponseF->SetLineColor(4);
 
+  FillResponseTables();
+
   fBBdata = new TF1("fBBdata", "[0] * AliExternalTrackParam::BetheBlochAleph(x, [1], [2], [3], [4], [5])",0.1, 4000.);
 
   // initialize the mask
@@ -161,6 +163,7 @@ void AliFlowBayesianPID::SetDetResponse(AliESDEvent *esd,Float_t centrality,ESta
     if(centrality <= 0) centrality = 0.001;
   }
   fCurrCentrality = centrality;
+  fPriorsCentBin = -1;
 
   // retune BB
   Double_t alephParameters[5];
@@ -285,6 +288,7 @@ void AliFlowBayesianPID::SetDetResponse(AliAODEvent *aod,Float_t centrality,ESta
     if(centrality <= 0) centrality = 0.001;
   }
   fCurrCentrality = centrality;
+  fPriorsCentBin = -1;
 
   // retune BB
   Double_t alephParameters[5];
@@ -633,7 +637,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
       else if(centr < 70) resolutionTPC *= 0.88;
       else resolutionTPC *= 0.83;
       
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
+      fWeights[0][iS] = EvalResponse(fTPCResponseF,fTPCResponseTable,(dedx - dedxExp)/resolutionTPC)/resolutionTPC;
     }
     fMaskCurrent[0] = kTRUE;
   }
@@ -674,7 +678,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
       if (TMath::Abs(delta) > 5*expsigma) {
 	fWeights[1][iS] = mismfrac*mismweight;
       } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+	fWeights[1][iS] = EvalResponse(fTOFResponseF,fTOFResponseTable,delta/expsigma)/expsigma + mismfrac*mismweight;
     }
     fMaskCurrent[1] = kTRUE;
   }
@@ -782,7 +786,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
       else if(centr < 70) resolutionTPC *= 0.88;
       else resolutionTPC *= 0.83;
       
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
+      fWeights[0][iS] = EvalResponse(fTPCResponseF,fTPCResponseTable,(dedx - dedxExp)/resolutionTPC)/resolutionTPC;
     }
     fMaskCurrent[0] = kTRUE;
   }
@@ -850,7 +854,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
       if (TMath::Abs(delta) > 5*expsigma) {
 	fWeights[1][iS] = mismfrac*mismweight;
       } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+	fWeights[1][iS] = EvalResponse(fTOFResponseF,fTOFResponseTable,delta/expsigma)/expsigma + mismfrac*mismweight;
     }
     fMaskCurrent[1] = kTRUE;
   }
@@ -875,9 +879,7 @@ void AliFlowBayesianPID::ComputeProb(const AliESDtrack *t,Float_t /*centrObsolet
   Float_t priors[fgkNspecies];
   fProbTofMism = 0;
 
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+  GetPriors(t->Pt(),priors);
 
 
   if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
@@ -938,9 +940,7 @@ void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *ao
   Float_t priors[fgkNspecies];
   fProbTofMism = 0;
 
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+  GetPriors(t->Pt(),priors);
 
 
   if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
@@ -994,6 +994,68 @@ void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *ao
   
 }
 //________________________________________________________________________
+Int_t AliFlowBayesianPID::ComputeProb(const AliESDEvent *esd,std::vector<Float_t> &probs){
+  // compute Bayesian probabilities for all the tracks of the event:
+  // probs[i*fgkNspecies+iS] for track i and specie iS
+  Int_t ntracks = esd ? esd->GetNumberOfTracks() : 0;
+  probs.resize(ntracks*fgkNspecies);
+  for(Int_t i=0;i < ntracks;i++){
+    const AliESDtrack *t = esd->GetTrack(i);
+    if(t) ComputeProb(t);
+    for(Int_t iS=0;iS<fgkNspecies;iS++) probs[i*fgkNspecies+iS] = t ? fProb[iS] : 0;
+  }
+  return ntracks;
+}
+//________________________________________________________________________
+Int_t AliFlowBayesianPID::ComputeProb(const AliAODEvent *aod,std::vector<Float_t> &probs){
+  // compute Bayesian probabilities for all the tracks of the event:
+  // probs[i*fgkNspecies+iS] for track i and specie iS
+  Int_t ntracks = aod ? aod->GetNumberOfTracks() : 0;
+  probs.resize(ntracks*fgkNspecies);
+  for(Int_t i=0;i < ntracks;i++){
+    const AliAODTrack *t = dynamic_cast<const AliAODTrack*>(aod->GetTrack(i));
+    if(t) ComputeProb(t,aod);
+    for(Int_t iS=0;iS<fgkNspecies;iS++) probs[i*fgkNspecies+iS] = t ? fProb[iS] : 0;
+  }
+  return ntracks;
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::FillResponseTables(){
+  // tabulate the TPC and TOF response functions in [-7,7] (step 0.005)
+  for(Int_t i=0;i < fgkNresponsePoints;i++){
+    Double_t x = -7. + 14.*i/(fgkNresponsePoints-1);
+    fTPCResponseTable[i] = fTPCResponseF->Eval(x);
+    fTOFResponseTable[i] = fTOFResponseF->Eval(x);
+  }
+}
+//________________________________________________________________________
+Float_t AliFlowBayesianPID::EvalResponse(const TF1 *f,const Float_t *table,Float_t x) const{
+  // response function at x, linearly interpolated from the table if requested and x in [-7,7]
+  if(!fUseResponseTables || !(x > -7 && x < 7)) return f->Eval(x);
+  Float_t u = (x + 7)*(fgkNresponsePoints-1)/14.;
+  Int_t i = Int_t(u);
+  if(i >= fgkNresponsePoints-1) return table[fgkNresponsePoints-1];
+  u -= i;
+  return table[i] + u*(table[i+1]-table[i]);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::GetPriors(Float_t pt,Float_t *priors){
+  // priors for the current centrality; the pt bins of this centrality are
+  // copied from the histograms once per event (all the priors share the same binning)
+  Int_t centBin = fghPriors[0]->GetXaxis()->FindBin(fCurrCentrality);
+  if(centBin != fPriorsCentBin){
+    for(Int_t ipt=0;ipt < fgkNptBinsPriors;ipt++)
+      for(Int_t iS=0;iS<fgkNspecies;iS++) fPriorsTable[ipt][iS] = fghPriors[iS]->GetBinContent(centBin,ipt);
+    fPriorsCentBin = centBin;
+  }
+  Int_t ptBin = fghPriors[0]->GetYaxis()->FindBin(pt);
+  if(ptBin < 0 || ptBin >= fgkNptBinsPriors){
+    for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(centBin,ptBin);
+    return;
+  }
+  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fPriorsTable[ptBin][iS];
+}
+//________________________________________________________________________
 void AliFlowBayesianPID::SetPsiCorrectionDeDx(Float_t psi,Float_t res){
   fPsi=psi;
   fPsiRes=res;
@@ -7,6 +7,7 @@
 #ifndef ALIFLOWBAYESIANPID_H
 #define ALIFLOWBAYESIANPID_H
 
+#include <vector>
 #include "AliESDpid.h"
 #include "AliPIDResponse.h"
 
@@ -68,6 +69,15 @@ More details:
      TH2D *hPr = mypid->GetHistoPriors(isp); // 2D (centrality - pT) histo for the priors of specie-isp (centrality < 0 means pp collisions)
                                              // all the priors are normalized to the pion ones
 
+Faster evaluation:
+
+ mypid->SetUseResponseTables(); // TPC/TOF response functions interpolated from tables instead of TF1::Eval
+
+ std::vector<Float_t> probs;
+ mypid->ComputeProb(aodEvent,probs); // all the tracks of the event, probs[itrack*AliFlowBayesianPID::GetNspecies()+isp]
+
+ The priors of the current centrality are always read from a per-event table filled at the first track.
+
 */
 
 class AliFlowBayesianPID : public AliPIDResponse{
@@ -114,6 +124,11 @@ class AliFlowBayesianPID : public AliPIDResponse{
   void ComputeProb(const AliESDtrack *t){ComputeProb(t,0.0);}; 
   void ComputeWeights(const AliAODTrack *t,const AliAODEvent *aod=NULL);
   void ComputeProb(const AliAODTrack *t,const AliAODEvent *aod=NULL); // obsolete method
+  Int_t ComputeProb(const AliESDEvent *esd,std::vector<Float_t> &probs); // all the tracks, returns the number of tracks
+  Int_t ComputeProb(const AliAODEvent *aod,std::vector<Float_t> &probs); // all the tracks, returns the number of tracks
+  static Int_t GetNspecies() {return fgkNspecies;};
+
+  void SetUseResponseTables(Bool_t flag=kTRUE){fUseResponseTables=flag;};
 
   void SetTOFres(Float_t res){fTOFresolution=res;};
 
@@ -123,6 +138,9 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
  private: 
   void SetPriors();
+  void FillResponseTables();
+  Float_t EvalResponse(const TF1 *f,const Float_t *table,Float_t x) const;
+  void GetPriors(Float_t pt,Float_t *priors);
 
   static const Int_t fgkNdetectors = 2; // Number of detector used for PID
   static const Int_t fgkNspecies = 9;// 0=el, 1=mu, 2=pi, 3=ka, 4=pr, 5=deuteron, 6=triton, 7=He3 
@@ -164,7 +182,15 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
   static TH1D *fgHtofChannelDist; // channel distance from IP
 
-  ClassDef(AliFlowBayesianPID, 10); // example of analysis
+  static const Int_t fgkNresponsePoints = 2801; // points of the response tables in [-7,7]
+  static const Int_t fgkNptBinsPriors = 82; // pt bins of the priors, including underflow and overflow
+  Bool_t fUseResponseTables; // interpolate the response functions from the tables
+  Float_t fTPCResponseTable[fgkNresponsePoints]; //! fTPCResponseF at the table points
+  Float_t fTOFResponseTable[fgkNresponsePoints]; //! fTOFResponseF at the table points
+  Float_t fPriorsTable[fgkNptBinsPriors][fgkNspecies]; //! priors of the current centrality bin per pt bin
+  Int_t fPriorsCentBin; //! centrality bin of fPriorsTable (-1 if not filled)
+
+  ClassDef(AliFlowBayesianPID, 11); // example of analysis
 };
 
 #endif
@@ -955,8 +955,9 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       //get input object (particle)
       TObject* particle = rpCuts->GetInputObject(i);
 
-      Bool_t rp = rpCuts->IsSelected(particle,i);
-      Bool_t poi = poiCuts->IsSelected(particle,i);
+      Bool_t rp = kFALSE;
+      Bool_t poi = kFALSE;
+      rpCuts->IsSelectedRPandPOI(poiCuts,particle,i,rp,poi);
 
       if (!(rp||poi)) continue;
 
@@ -73,6 +73,7 @@
 #include "AliFlowCommonConstants.h"
 #include "AliAnalysisManager.h"
 #include "AliPIDResponse.h"
+#include "AliPIDResponseCache.h"
 #include "TF2.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODTrack.h"
@@ -211,7 +212,9 @@ AliFlowTrackCuts::AliFlowTrackCuts():
   fMaxITSclusterShared(0),
   fCutITSChi2(kFALSE),
   fMaxITSChi2(0),
-  fRun(0)
+  fRun(0),
+  fUseCompiledCuts(kFALSE),
+  fNCompiledChecks(0)
 {
   //io constructor 
   SetPriors(); //init arrays
@@ -363,7 +366,9 @@ AliFlowTrackCuts::AliFlowTrackCuts(const char* name):
   fMaxITSclusterShared(0),
   fCutITSChi2(kFALSE),
   fMaxITSChi2(0),
-  fRun(0)
+  fRun(0),
+  fUseCompiledCuts(kFALSE),
+  fNCompiledChecks(0)
 {
   //constructor
   SetTitle("AliFlowTrackCuts");
@@ -518,7 +523,9 @@ AliFlowTrackCuts::AliFlowTrackCuts(const AliFlowTrackCuts& that):
   fMaxITSclusterShared(0),
   fCutITSChi2(kFALSE),
   fMaxITSChi2(0),
-  fRun(0)
+  fRun(0),
+  fUseCompiledCuts(that.fUseCompiledCuts),
+  fNCompiledChecks(0)
 {
   //copy constructor
   if (that.fTPCpidCuts) fTPCpidCuts = new TMatrixF(*(that.fTPCpidCuts));
@@ -711,6 +718,8 @@ AliFlowTrackCuts& AliFlowTrackCuts::operator=(const AliFlowTrackCuts& that)
   fNsigmaCut2 = that.fNsigmaCut2;
  
   fRun = that.fRun;
+  fUseCompiledCuts = that.fUseCompiledCuts;
+  fNCompiledChecks = 0;
   
   fPhiCutLow = new TF1("fPhiCutLow",  "0.1/x/x+pi/18.0-0.025", 0, 100);
   fPhiCutHigh = new TF1("fPhiCutHigh", "0.12/x+pi/18.0+0.035", 0, 100);
@@ -809,7 +818,75 @@ void AliFlowTrackCuts::SetEvent(AliVEvent* event, AliMCEvent* mcEvent)
   
   if(fPIDsource==kTOFbayesian) fBayesianResponse->SetDetAND(1);
   else if(fPIDsource==kTPCbayesian) fBayesianResponse->ResetDetOR(1);
-    
+
+  //the cut settings may have changed since the last event
+  if (fUseCompiledCuts) CompileCuts();
+}
+
+//-----------------------------------------------------------------------
+void AliFlowTrackCuts::CompileCuts()
+{
+  //build the flat list of the enabled kinematic checks used by PassesCompiledCuts().
+  //The list stays empty, i.e. all cuts are evaluated for every track, when
+  //  - QA histograms are filled, as they need every cut of every track,
+  //  - the cuts are applied to other parameters than those of the input particle
+  //    (TPC standalone parameters of ESD tracks),
+  //  - the particles are muons or MC particles with charge in units of e/3 (charge check only).
+  fNCompiledChecks=0;
+  if (fQA) return;
+  if (fParamType==kMUON) return;
+  if (fParamType==kTPCstandalone) return;
+  if (fForceTPCstandalone && fParamType!=kGlobal) return;
+
+  //cheapest and most selective first
+  if (fCutPt) fCompiledChain[fNCompiledChecks++]=kCheckPt;
+  if (fCutEta) fCompiledChain[fNCompiledChecks++]=kCheckEta;
+  if (!fFakesAreOK) fCompiledChain[fNCompiledChecks++]=kCheckLabel;
+  if (fCutPhi) fCompiledChain[fNCompiledChecks++]=kCheckPhi;
+  if (fRequireCharge) fCompiledChain[fNCompiledChecks++]=kCheckRequireCharge;
+  if (fCutCharge && fParamType!=kMC) fCompiledChain[fNCompiledChecks++]=kCheckCharge;
+}
+
+//-----------------------------------------------------------------------
+Bool_t AliFlowTrackCuts::PassesCompiledCuts(const AliVParticle* vparticle) const
+{
+  //enabled kinematic cuts on the input particle, same definitions as in PassesCuts(AliVParticle*)
+  for (Int_t i=0; i<fNCompiledChecks; i++)
+  {
+    switch (fCompiledChain[i])
+    {
+      case kCheckPt:
+        {
+          Double_t pt = vparticle->Pt();
+          if (pt < fPtMin || pt >= fPtMax) return kFALSE;
+        }
+        break;
+      case kCheckEta:
+        {
+          Double_t eta = vparticle->Eta();
+          if (eta < fEtaMin || eta >= fEtaMax) return kFALSE;
+        }
+        break;
+      case kCheckLabel:
+        if (vparticle->GetLabel()<0) return kFALSE;
+        break;
+      case kCheckPhi:
+        {
+          Double_t phi = vparticle->Phi();
+          if (phi < fPhiMin || phi >= fPhiMax) return kFALSE;
+        }
+        break;
+      case kCheckRequireCharge:
+        if (vparticle->Charge() == 0) return kFALSE;
+        break;
+      case kCheckCharge:
+        if (vparticle->Charge() != fCharge) return kFALSE;
+        break;
+      default:
+        break;
+    }
+  }
+  return kTRUE;
 }
 
 //-----------------------------------------------------------------------
@@ -858,6 +935,23 @@ Bool_t AliFlowTrackCuts::IsSelected(TObject* obj, Int_t id)
   return kFALSE;  //default when passed wrong type of object
 }
 
+//-----------------------------------------------------------------------
+void AliFlowTrackCuts::IsSelectedRPandPOI(AliFlowTrackCuts* poiCuts, TObject* obj, Int_t id, Bool_t& rp, Bool_t& poi)
+{
+  //selection with this object as RP cuts and poiCuts as POI cuts, for tracks of the same
+  //source. Same result as calling IsSelected() of both, but the type of obj is resolved
+  //once; with compiled cuts each chain stops at the first failing kinematic check
+  AliVParticle* vparticle = dynamic_cast<AliVParticle*>(obj);
+  if (!vparticle || fParamType==kMUON || poiCuts->fParamType==kMUON)
+  {
+    rp = IsSelected(obj,id);
+    poi = poiCuts->IsSelected(obj,id);
+    return;
+  }
+  rp = PassesCuts(vparticle);
+  poi = poiCuts->PassesCuts(vparticle);
+}
+
 //-----------------------------------------------------------------------
 Bool_t AliFlowTrackCuts::IsSelectedMCtruth(TObject* obj, Int_t id)
 {
@@ -1146,6 +1240,9 @@ Bool_t AliFlowTrackCuts::PassesCuts(AliVParticle* vparticle)
   ClearTrack();
   Bool_t pass=kTRUE;
 
+  //compiled chain: reject on the kinematics before any detector or PID cut
+  if (fNCompiledChecks>0 && !PassesCompiledCuts(vparticle)) return kFALSE;
+
   //get the label and the mc particle
   fTrackLabel = (fFakesAreOK)?TMath::Abs(vparticle->GetLabel()):vparticle->GetLabel();
   if (fMCevent) fMCparticle = static_cast<AliMCParticle*>(fMCevent->GetTrack(fTrackLabel));
@@ -4126,8 +4223,8 @@ Bool_t AliFlowTrackCuts::PassesTPCTOFNsigmaCut(const AliAODTrack* track)
     // check TPC status
     if(track->GetTPCsignal() < 10) return kFALSE;
 
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
-    Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTPC,track,fParticleID);
+    Float_t nsigmaTOF = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTOF,track,fParticleID);
 
     Float_t nsigma2 = nsigmaTPC*nsigmaTPC + nsigmaTOF*nsigmaTOF;
 
@@ -4150,8 +4247,8 @@ Bool_t AliFlowTrackCuts::PassesTPCTOFNsigmaCut(const AliESDtrack* track)
     // check TPC status
     if(track->GetTPCsignal() < 10) return kFALSE;
 
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
-    Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTPC,track,fParticleID);
+    Float_t nsigmaTOF = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTOF,track,fParticleID);
 
     Float_t nsigma2 = nsigmaTPC*nsigmaTPC + nsigmaTOF*nsigmaTOF;
 
@@ -4180,8 +4277,8 @@ Bool_t AliFlowTrackCuts::PassesTPCTOFNsigmaPurityCut(const AliAODTrack* track)
      Double_t LowPtPIDTPCnsigHigh_Kaon[2] ={3,2.2};
      */
     
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
-    Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTPC,track,fParticleID);
+    Float_t nsigmaTOF = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTOF,track,fParticleID);
     
     int index = (fParticleID-2)*60 + p_int;
     if ( (track->IsOn(AliAODTrack::kITSin))){
@@ -5347,7 +5444,7 @@ Bool_t AliFlowTrackCuts::PassesTPCTPCTOFNsigmaCut(const AliAODTrack* track){
   }
   if(pass){
     Double_t Pt = track->Pt();
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTPC,track,fParticleID);
     Float_t nsigma2 = 999.;
     if(Pt < fPtTOFPIDoff){
       nsigma2 = nsigmaTPC*nsigmaTPC;
@@ -5356,7 +5453,7 @@ Bool_t AliFlowTrackCuts::PassesTPCTPCTOFNsigmaCut(const AliAODTrack* track){
       if (((track->GetStatus()&AliVTrack::kTOFout)==0)&&((track->GetStatus()&AliVTrack::kTIME)==0)){
         pass = kFALSE;
       }else{
-        Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+        Float_t nsigmaTOF = AliPIDResponseCache::NumberOfSigmas(fPIDResponse,AliPIDResponse::kTOF,track,fParticleID);
         nsigma2 = nsigmaTPC*nsigmaTPC + nsigmaTOF*nsigmaTOF;
       }
     }
@@ -244,6 +244,7 @@ class AliFlowTrackCuts : public AliFlowTrackSimpleCuts {
 
   virtual Bool_t IsSelected(TObject* obj, Int_t id=-666);
   virtual Bool_t IsSelectedMCtruth(TObject* obj, Int_t id=-666);
+  void IsSelectedRPandPOI(AliFlowTrackCuts* poiCuts, TObject* obj, Int_t id, Bool_t& rp, Bool_t& poi); //this as RP cuts and poiCuts on the same object
   AliVParticle* GetTrack() const {return fTrack;}
   AliMCParticle* GetMCparticle() const {return fMCparticle;}
   //AliFlowTrack* MakeFlowTrack() const;
@@ -354,6 +355,12 @@ class AliFlowTrackCuts : public AliFlowTrackSimpleCuts {
   void SetRun(Int_t const run) {this->fRun = run;};
   Int_t GetRun() const {return this->fRun;};
 
+  //compiled cut chain: the enabled kinematic cuts are checked first, in a flat loop,
+  //and a track failing one of them is rejected before the detector and PID cuts
+  void SetUseCompiledCuts(Bool_t b=kTRUE) {fUseCompiledCuts=b;}
+  Bool_t GetUseCompiledCuts() const {return fUseCompiledCuts;}
+  void CompileCuts();
+
  protected:
   //AliFlowTrack* MakeFlowTrackSPDtracklet() const;
   //AliFlowTrack* MakeFlowTrackPMDtrack() const;
@@ -380,6 +387,9 @@ class AliFlowTrackCuts : public AliFlowTrackSimpleCuts {
   Bool_t TPCTOFagree(const AliVTrack *track);
   // end part added by F. Noferini
   Bool_t PassesTPCTPCTOFNsigmaCut(const AliAODTrack* track); // added by B. Hohlweger
+  Bool_t PassesCompiledCuts(const AliVParticle* vparticle) const;
+
+  enum compiledCheck { kCheckLabel, kCheckPt, kCheckEta, kCheckPhi, kCheckRequireCharge, kCheckCharge, kNCompiledChecks };
 
   //the cuts
   AliESDtrackCuts* fAliESDtrackCuts; //alianalysis cuts
@@ -532,8 +542,12 @@ class AliFlowTrackCuts : public AliFlowTrackSimpleCuts {
   Bool_t fCutITSChi2;                   // cut fMaxITSChi2
   Double_t  fMaxITSChi2;                // fMaxITSChi2
   Int_t         fRun;                   // run number
+
+  Bool_t fUseCompiledCuts;                      // check the kinematic cuts first, see CompileCuts()
+  Int_t  fCompiledChain[kNCompiledChecks];      //! enabled kinematic checks, in evaluation order
+  Int_t  fNCompiledChecks;                      //! number of entries in fCompiledChain, 0 if not applicable
   
-  ClassDef(AliFlowTrackCuts,21)
+  ClassDef(AliFlowTrackCuts,22)
 };
 
 #endif
@@ -26,6 +26,7 @@
 #include <TMath.h>
 #include <TEllipse.h>
 #include <TRandom.h>
+#include <TDirectory.h>
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TNtuple.h>
@@ -172,7 +173,11 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fUseCollisionGrid(kFALSE),
+  fOutputDirectory(0),
+  fGridStart(),
+  fGridIndex()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +327,11 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fUseCollisionGrid(in.fUseCollisionGrid),
+  fOutputDirectory(in.fOutputDirectory),
+  fGridStart(),
+  fGridIndex()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,6 +462,8 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fUseCollisionGrid=in.fUseCollisionGrid;
+  fOutputDirectory=in.fOutputDirectory;
   return *this;
 }
 
@@ -511,6 +522,10 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
+  // with a fixed cross section only nucleons in neighbouring cells can collide
+  if (fUseCollisionGrid && !fDoFluc)
+    CollideWithGrid(d2, bNN, Nco, Ncohc);
+  else
   // for each of the A nucleons in nucleus B
   for (Int_t i = 0; i<fBN; i++)
   {
@@ -554,6 +569,82 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   return CalcResults(bgen);
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::CollideWithGrid(Double_t d2, Double_t &bNN, Double_t &Nco, Double_t &Ncohc)
+{
+  // Same collision finding as the pairwise loop in CalcEvent, but the
+  // nucleons of A are first sorted in a grid in the transverse plane
+  // with cells as large as the "ball" diameter, so that each nucleon
+  // of B is only tested against the nucleons in the 3x3 cells around it
+
+  if (fAN <= 0 || fBN <= 0) return;
+  Double_t d = TMath::Sqrt(d2);
+  Double_t xmin = 1e10, xmax = -1e10, ymin = 1e10, ymax = -1e10;
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    xmin = TMath::Min(xmin, nucleonA->GetX());
+    xmax = TMath::Max(xmax, nucleonA->GetX());
+    ymin = TMath::Min(ymin, nucleonA->GetY());
+    ymax = TMath::Max(ymax, nucleonA->GetY());
+  }
+  Int_t nx = TMath::Min(Int_t((xmax-xmin)/d)+1, 200);
+  Int_t ny = TMath::Min(Int_t((ymax-ymin)/d)+1, 200);
+  Double_t cellx = (xmax-xmin)/nx + 1e-9;
+  Double_t celly = (ymax-ymin)/ny + 1e-9;
+  if (cellx < d) cellx = d;
+  if (celly < d) celly = d;
+
+  // counting sort of the nucleons of A by cell
+  fGridStart.assign(nx*ny+1, 0);
+  fGridIndex.resize(fAN);
+  std::vector<Int_t> cellOfA(fAN);
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    Int_t cx = TMath::Min(Int_t((nucleonA->GetX()-xmin)/cellx), nx-1);
+    Int_t cy = TMath::Min(Int_t((nucleonA->GetY()-ymin)/celly), ny-1);
+    cellOfA[j] = cx*ny+cy;
+    ++fGridStart[cellOfA[j]+1];
+  }
+  for (Int_t k = 0; k<nx*ny; k++) fGridStart[k+1] += fGridStart[k];
+  std::vector<Int_t> fill(fGridStart.begin(), fGridStart.end()-1);
+  for (Int_t j = 0; j<fAN; j++) fGridIndex[fill[cellOfA[j]]++] = j;
+
+  for (Int_t i = 0; i<fBN; i++)
+  {
+    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+    Double_t fx = (nucleonB->GetX()-xmin)/cellx;
+    Double_t fy = (nucleonB->GetY()-ymin)/celly;
+    if (fx < -1 || fy < -1 || fx >= nx+1 || fy >= ny+1) continue;
+    Int_t bx = TMath::FloorNint(fx);
+    Int_t by = TMath::FloorNint(fy);
+    for (Int_t cx = TMath::Max(bx-1,0); cx <= TMath::Min(bx+1,nx-1); cx++)
+    {
+      for (Int_t cy = TMath::Max(by-1,0); cy <= TMath::Min(by+1,ny-1); cy++)
+      {
+        Int_t cell = cx*ny+cy;
+        for (Int_t k = fGridStart[cell]; k < fGridStart[cell+1]; k++)
+        {
+          AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fGridIndex[k]));
+          Double_t dx = nucleonB->GetX()-nucleonA->GetX();
+          Double_t dy = nucleonB->GetY()-nucleonA->GetY();
+          Double_t dij = dx*dx+dy*dy;
+          if (dij < d2)
+          {
+            bNN += dij;
+            ++Nco;
+            nucleonB->Collide();
+            nucleonA->Collide();
+            if (dij<d2/4)
+              ++Ncohc;
+          }
+        }
+      }
+    }
+  }
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcResults(Double_t bgen)
 {
@@ -1692,7 +1783,9 @@ void AliGlauberMC::Run(Int_t nevents)
   {
     fnt = new TNtuple(name,title,
                       "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
-    fnt->SetDirectory(0);
+    // with an output directory the baskets are written out while
+    // filling instead of keeping the whole ntuple in memory
+    fnt->SetDirectory(fOutputDirectory);
   }
   Int_t q = 0;
   Int_t u = 0;
@@ -1785,21 +1878,38 @@ void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      Double_t mind,
                                      Double_t r,
                                      Double_t a,
-                                     const char *fname)
+                                     const char *fname,
+                                     Int_t stream)
 {
   //example run
+  //for parallel generation run one job per stream and merge the
+  //output files with hadd
+  if (stream>=0) SetRandomStream(stream);
   AliGlauberMC mcg(sysA,sysB,signn);
   mcg.SetMinDistance(mind);
   mcg.Setr(r);
   mcg.Seta(a);
+  mcg.SetUseCollisionGrid();
+  TFile out(fname,"recreate",fname,9);
+  mcg.SetOutputDirectory(&out);
   mcg.Run(n);
   TNtuple  *nt=mcg.GetNtuple();
-  TFile out(fname,"recreate",fname,9);
   if(nt) nt->Write();
   printf("total cross section with a nucleon-nucleon cross section \t%f is \t%f",signn,mcg.GetTotXSect());
+  mcg.Reset();
   out.Close();
 }
 
+//---------------------------------------------------------------------------------
+void AliGlauberMC::SetRandomStream(Int_t stream, UInt_t seed)
+{
+  //give this job its own random number sequence, so that the events
+  //of jobs with different stream numbers running in parallel are
+  //independent. The generator is seeded with seed+stream, seed must
+  //be non-zero (zero would give a time dependent seed).
+  gRandom->SetSeed(seed+stream);
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNucleons( Int_t n,
                                        const Option_t *sysA,
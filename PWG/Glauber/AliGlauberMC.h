@@ -16,9 +16,11 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TDirectory;
 
 using std::cout;
 using std::endl;
@@ -96,6 +98,9 @@ public:
    void   SetBmax(Double_t bmax)      {fBMax = bmax;}
    void   SetMinDistance(Double_t d)  {fANucleus.SetMinDist(d); fBNucleus.SetMinDist(d);}
    void   SetDoPartProduction(Bool_t b) { fDoPartProd = b; }
+   void   SetUseCollisionGrid(Bool_t b=kTRUE) { fUseCollisionGrid = b; }
+   void   SetOutputDirectory(TDirectory *dir) { fOutputDirectory = dir; }
+   static void SetRandomStream(Int_t stream, UInt_t seed=4357);
    void   Setr(Double_t r)  {fANucleus.SetR(r); fBNucleus.SetR(r);}
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
@@ -109,7 +114,8 @@ public:
                                        Double_t mind=0.4,
 				       Double_t r=6.62,
 				       Double_t a=0.546,
-                                       const char *fname="glau_pbpb_ntuple.root");
+                                       const char *fname="glau_pbpb_ntuple.root",
+                                       Int_t stream=-1);
    void RunAndSaveNucleons( Int_t n,
                             const Option_t *sysA,
                             const Option_t *sysB,
@@ -251,9 +257,14 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Bool_t       fUseCollisionGrid; //=kTRUE then find collisions with a spatial grid
+   TDirectory  *fOutputDirectory; //!directory the ntuple is written to while filling
+   std::vector<Int_t> fGridStart; //!first entry of each grid cell in fGridIndex
+   std::vector<Int_t> fGridIndex; //!nucleons of A sorted by grid cell
    Bool_t       CalcResults(Double_t bgen);
+   void         CollideWithGrid(Double_t d2, Double_t &bNN, Double_t &Nco, Double_t &Ncohc);
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
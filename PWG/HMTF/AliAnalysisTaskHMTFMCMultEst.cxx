@@ -25,14 +25,14 @@ ClassImp(AliAnalysisTaskHMTFMCMultEst)
 
 //________________________________________________________________________
 AliAnalysisTaskHMTFMCMultEst::AliAnalysisTaskHMTFMCMultEst()
-: AliAnalysisTaskSE(), fMyOut(0), fClassifiers(0), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
+: AliAnalysisTaskSE(), fMyOut(0), fClassifiers(0), fObservables(0), fEngine(), fGlobalTrigger(0), fGlobalSystem(0),
   fGlobalTriggerClassifiers(0)
 {
 }
 
 //________________________________________________________________________
 AliAnalysisTaskHMTFMCMultEst::AliAnalysisTaskHMTFMCMultEst(const char *name)
-  : AliAnalysisTaskSE(name), fMyOut(0), fClassifiers(0), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
+  : AliAnalysisTaskSE(name), fMyOut(0), fClassifiers(0), fObservables(0), fEngine(), fGlobalTrigger(0), fGlobalSystem(0),
     fGlobalTriggerClassifiers(0)
 {
   DefineOutput(1, TList::Class());
@@ -129,6 +129,8 @@ void AliAnalysisTaskHMTFMCMultEst::UserCreateOutputObjects()
      //fObservables.push_back(new AliObservableCorrelationsOfClassifiers(fClassifiers.at(i), refClassifierSpherocity));
      fObservables.push_back(new AliObservableCorrelationsOfClassifiers(fClassifiers.at(i), refClassifierSphericity));
   }
+  for (UInt_t i = 0; i < fClassifiers.size(); i++) fEngine.AddClassifier(fClassifiers[i]);
+  for (UInt_t i = 0; i < fObservables.size(); i++) fEngine.AddObservable(fObservables[i]);
   AliLog::SetGlobalLogLevel(AliLog::kError);
   PostData(1, fMyOut);
 }
@@ -137,26 +139,21 @@ void AliAnalysisTaskHMTFMCMultEst::UserCreateOutputObjects()
 //________________________________________________________________________
 void AliAnalysisTaskHMTFMCMultEst::UserExec(Option_t *)
 {
-  // Reset classifiers before doing anything with this new event
-  for (Int_t i = 0; i < fClassifiers.size(); i++) {
-    fClassifiers[i]->ResetClassifier();
-  }
-
   // Load event
   AliMCEvent* mcEvent = MCEvent();
   if (!mcEvent) {
      AliError("ERROR: Could not retrieve MC event");
      return;
   }
-  AliStack  *stack = mcEvent->Stack();
+
+  // Reset classifiers and build the particle table of this new event (single loop over the stack)
+  fEngine.BeginEvent(mcEvent);
 
   // do we have the right trigger?
-  if (((fGlobalTrigger == kINEL) && IsInel(mcEvent, stack)) ||
-      ((fGlobalTrigger == kINELGT0) && IsInelGt0(mcEvent, stack)) ||
-      ((fGlobalTrigger == kV0AND) && IsV0AND(mcEvent, stack))) {
-    for (Int_t i = 0; i < fObservables.size(); i++) {
-      fObservables[i]->Fill(mcEvent, stack);
-    }
+  if (((fGlobalTrigger == kINEL) && IsInel()) ||
+      ((fGlobalTrigger == kINELGT0) && IsInelGt0()) ||
+      ((fGlobalTrigger == kV0AND) && IsV0AND())) {
+    fEngine.FillObservables();
   }
   
   // Post output data.
@@ -190,21 +187,21 @@ void AliAnalysisTaskHMTFMCMultEst::SetupV0ANDAsGlobalTrigger(AliEventClassifierB
 /*
   Return true if the current event fulfills the trigger requiremtn
 */
-Bool_t AliAnalysisTaskHMTFMCMultEst::IsInel(AliMCEvent *event, AliStack *stack) {
+Bool_t AliAnalysisTaskHMTFMCMultEst::IsInel() {
   return kTRUE;
 }
 
-Bool_t AliAnalysisTaskHMTFMCMultEst::IsInelGt0(AliMCEvent *event, AliStack *stack) {
-  if (fGlobalTriggerClassifiers[0]->GetClassifierValue(event, stack) > 0)
+Bool_t AliAnalysisTaskHMTFMCMultEst::IsInelGt0() {
+  if (fEngine.GetClassifierValue(fGlobalTriggerClassifiers[0]) > 0)
     return kTRUE;
   else
     return kFALSE;
 }
 
-Bool_t AliAnalysisTaskHMTFMCMultEst::IsV0AND(AliMCEvent *event, AliStack *stack) {
+Bool_t AliAnalysisTaskHMTFMCMultEst::IsV0AND() {
   // The tow estimators in the vector are V0A and V0B
-  if ((fGlobalTriggerClassifiers[0]->GetClassifierValue(event, stack) > 0)
-      && (fGlobalTriggerClassifiers[1]->GetClassifierValue(event, stack) > 0))
+  if ((fEngine.GetClassifierValue(fGlobalTriggerClassifiers[0]) > 0)
+      && (fEngine.GetClassifierValue(fGlobalTriggerClassifiers[1]) > 0))
     return kTRUE;
   else
     return kFALSE;
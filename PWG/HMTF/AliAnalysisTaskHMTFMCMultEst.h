@@ -4,6 +4,7 @@
 #include "AliAnalysisTaskSE.h"
 
 #include "AliEventClassifierBase.h"
+#include "AliEventClassifierEngine.h"
 #include "AliObservableBase.h"
 
 class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
@@ -23,6 +24,7 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
   TList *fMyOut;                          // Output list
   std::vector<AliEventClassifierBase*> fClassifiers;
   std::vector<AliObservableBase*> fObservables;
+  AliEventClassifierEngine fEngine;       //! Evaluates the classifiers and observables in one pass per event
 
   Int_t fGlobalTrigger;
   enum {kINEL, kINELGT0, kV0AND};
@@ -33,9 +35,9 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
   void SetupInelGt0AsGlobalTrigger(AliEventClassifierBase* etaLt1);
   void SetupV0ANDAsGlobalTrigger(AliEventClassifierBase* V0A, AliEventClassifierBase* V0C);
 
-  Bool_t IsInel(AliMCEvent *event, AliStack *stack);
-  Bool_t IsInelGt0(AliMCEvent *event, AliStack *stack);
-  Bool_t IsV0AND(AliMCEvent *event, AliStack *stack);
+  Bool_t IsInel();
+  Bool_t IsInelGt0();
+  Bool_t IsV0AND();
   // vector to save the classifiers used in the global trigger
   std::vector<AliEventClassifierBase*> fGlobalTriggerClassifiers;
 
@@ -43,7 +45,7 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
   AliAnalysisTaskHMTFMCMultEst(const AliAnalysisTaskHMTFMCMultEst&); // not implemented
   AliAnalysisTaskHMTFMCMultEst& operator=(const AliAnalysisTaskHMTFMCMultEst&); // not implemented
 
-  ClassDef(AliAnalysisTaskHMTFMCMultEst, 2); // example of analysis
+  ClassDef(AliAnalysisTaskHMTFMCMultEst, 3); // example of analysis
 };
 
 #endif
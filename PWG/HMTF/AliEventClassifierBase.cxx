@@ -6,6 +6,7 @@
 #include "AliStack.h"
 
 #include "AliEventClassifierBase.h"
+#include "AliIsPi0PhysicalPrimary.h"
 
 using namespace std;
 
@@ -46,3 +47,52 @@ Float_t AliEventClassifierBase::GetClassifierValue(AliMCEvent *event, AliStack *
   }
   return fClassifierValue;
 }
+
+Float_t AliEventClassifierBase::GetClassifierValue(AliMCEvent *event, AliStack *stack,
+						   const AliEventClassifierParticles &particles) {
+  if(!fClassifierValueIsCached) {
+    if (!CalculateClassifierValueFromParticles(particles, event))
+      CalculateClassifierValue(event, stack);
+    fClassifierValueIsCached = true;
+  }
+  return fClassifierValue;
+}
+
+void AliEventClassifierParticles::Clear() {
+  fEta.clear();
+  fY.clear();
+  fPhi.clear();
+  fPt.clear();
+  fCharge.clear();
+  fPdg.clear();
+  fFlags.clear();
+}
+
+void AliEventClassifierParticles::Fill(AliMCEvent *event, AliStack *stack) {
+  Clear();
+  for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++) {
+    AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
+    // load track
+    if (!track) {
+      Printf("ERROR: Could not receive track %d", iTrack);
+      continue;
+    }
+    // discard unphysical particles from some generators
+    if (track->Pt() == 0 || track->E() <= 0)
+      continue;
+
+    // primaries (Aliroot definition excluding Pi0) or primary pi0's
+    UChar_t flags = 0;
+    if (stack->IsPhysicalPrimary(iTrack)) flags = kPhysicalPrimary;
+    else if (AliIsPi0PhysicalPrimary(iTrack, stack)) flags = kPi0PhysicalPrimary;
+    else continue;
+
+    fEta.push_back(track->Eta());
+    fY.push_back(track->Y());
+    fPhi.push_back(track->Phi());
+    fPt.push_back(track->Pt());
+    fCharge.push_back(track->Charge());
+    fPdg.push_back(track->PdgCode());
+    fFlags.push_back(flags);
+  }
+}
@@ -1,12 +1,34 @@
 #ifndef AliEventClassifierBase_cxx
 #define AliEventClassifierBase_cxx
 
+#include <vector>
+
 #include "TList.h"
 #include "TNamed.h"
 
 #include "AliMCEvent.h"
 #include "AliStack.h"
 
+// Packed table of the particles of one MC event which pass the selection common to all
+// classifiers and observables: Pt() != 0, E() > 0 and physical primary or physical primary pi0.
+// It is filled once per event by AliEventClassifierEngine; each column has one entry per particle.
+struct AliEventClassifierParticles {
+  enum {kPhysicalPrimary = BIT(0), kPi0PhysicalPrimary = BIT(1)};
+
+  void Fill(AliMCEvent *event, AliStack *stack);
+  void Clear();
+  Int_t GetN() const {return fPt.size();}
+  Bool_t IsPhysicalPrimary(Int_t i) const {return fFlags[i] & kPhysicalPrimary;}
+
+  std::vector<Double_t> fEta;
+  std::vector<Double_t> fY;
+  std::vector<Double_t> fPhi;
+  std::vector<Double_t> fPt;
+  std::vector<Short_t>  fCharge;
+  std::vector<Int_t>    fPdg;
+  std::vector<UChar_t>  fFlags;     // kPhysicalPrimary, or kPi0PhysicalPrimary for the pi0 which are not
+};
+
 class AliEventClassifierBase : public TNamed {
  public:
   AliEventClassifierBase();
@@ -14,6 +36,8 @@ class AliEventClassifierBase : public TNamed {
   virtual ~AliEventClassifierBase() {}
 
   Float_t GetClassifierValue(AliMCEvent *event, AliStack *stack);
+  // Same, but computed from the particle table of the event if the classifier supports it
+  Float_t GetClassifierValue(AliMCEvent *event, AliStack *stack, const AliEventClassifierParticles &particles);
   void ResetClassifier() {fClassifierValueIsCached = false;}
   TList* GetClassifierOutputList() {return fClassifierOutputList;}
   Int_t GetExpectedMinValue() {return fExpectedMinValue;}
@@ -21,6 +45,9 @@ class AliEventClassifierBase : public TNamed {
 
  protected:
   virtual void CalculateClassifierValue(AliMCEvent *event, AliStack *stack) = 0;
+  // Return false if the classifier does not implement it; CalculateClassifierValue is used then
+  virtual Bool_t CalculateClassifierValueFromParticles(const AliEventClassifierParticles &/*particles*/,
+						       AliMCEvent */*event*/) {return kFALSE;}
   Bool_t fClassifierValueIsCached;    // Is the classifier value already computed?
   Float_t fClassifierValue;           // The value for this classifier for the current event
   Int_t fExpectedMinValue;            // The expected min value produced by this estimator, used for hists
@@ -0,0 +1,45 @@
+#include "AliMCEvent.h"
+#include "AliStack.h"
+
+#include "AliEventClassifierEngine.h"
+
+using namespace std;
+
+ClassImp(AliEventClassifierEngine)
+
+AliEventClassifierEngine::AliEventClassifierEngine()
+  : TObject(),
+    fClassifiers(),
+    fObservables(),
+    fParticles(),
+    fEvent(0),
+    fStack(0)
+{
+}
+
+void AliEventClassifierEngine::BeginEvent(AliMCEvent *event) {
+  for (UInt_t i = 0; i < fClassifiers.size(); i++) {
+    fClassifiers[i]->ResetClassifier();
+  }
+  fEvent = event;
+  fStack = event->Stack();
+  fParticles.Fill(fEvent, fStack);
+}
+
+Float_t AliEventClassifierEngine::GetClassifierValue(AliEventClassifierBase *classifier) {
+  return classifier->GetClassifierValue(fEvent, fStack, fParticles);
+}
+
+void AliEventClassifierEngine::EvaluateClassifiers() {
+  for (UInt_t i = 0; i < fClassifiers.size(); i++) {
+    GetClassifierValue(fClassifiers[i]);
+  }
+}
+
+void AliEventClassifierEngine::FillObservables() {
+  // The observables query their classifiers, make sure the values are cached from the table first
+  EvaluateClassifiers();
+  for (UInt_t i = 0; i < fObservables.size(); i++) {
+    fObservables[i]->FillFromParticles(fEvent, fStack, fParticles);
+  }
+}
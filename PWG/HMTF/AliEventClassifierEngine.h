@@ -0,0 +1,43 @@
+#ifndef AliEventClassifierEngine_cxx
+#define AliEventClassifierEngine_cxx
+
+#include <vector>
+
+#include "TObject.h"
+
+#include "AliEventClassifierBase.h"
+#include "AliObservableBase.h"
+
+// Evaluates all registered classifiers and observables of one event from a single pass over
+// the MC stack. BeginEvent() resets the classifiers and fills the particle table once; the
+// classifiers and observables which support it are then computed from the table, the other
+// ones fall back to their own loop over the event.
+// The classifiers and observables are not owned.
+class AliEventClassifierEngine : public TObject {
+ public:
+  AliEventClassifierEngine();
+  virtual ~AliEventClassifierEngine() {}
+
+  void AddClassifier(AliEventClassifierBase *classifier) {fClassifiers.push_back(classifier);}
+  void AddObservable(AliObservableBase *observable) {fObservables.push_back(observable);}
+
+  void BeginEvent(AliMCEvent *event);
+  Float_t GetClassifierValue(AliEventClassifierBase *classifier);
+  void EvaluateClassifiers();
+  void FillObservables();
+  const AliEventClassifierParticles& GetParticles() const {return fParticles;}
+
+ private:
+  std::vector<AliEventClassifierBase*> fClassifiers;  //! Registered classifiers
+  std::vector<AliObservableBase*> fObservables;       //! Registered observables
+  AliEventClassifierParticles fParticles;             //! Particle table of the current event
+  AliMCEvent *fEvent;                                 //! Current event
+  AliStack *fStack;                                   //! Stack of the current event
+
+  AliEventClassifierEngine(const AliEventClassifierEngine&); // not implemented
+  AliEventClassifierEngine& operator=(const AliEventClassifierEngine&); // not implemented
+
+  ClassDef(AliEventClassifierEngine, 1);
+};
+
+#endif
@@ -60,17 +60,30 @@ void AliEventClassifierMult::CalculateClassifierValue(AliMCEvent *event, AliStac
     // do we count charged or neutral?
     if (track->Charge() == 0 && fCountCharged) continue;
 
-    // does this track fall into any of the defined regions?
-    Double_t eta = track->Eta();
-    Bool_t trackIsInRegion = false;
-    for(Int_t i = 0; i != fRegions.size(); i++) {
-      if(eta >= fRegions[i][0] && eta <=fRegions[i][1]) {
-	trackIsInRegion = true;
-      }
+    if (IsCounted(track->Eta())) fClassifierValue += 1.0;
+  }
+}
+
+Bool_t AliEventClassifierMult::CalculateClassifierValueFromParticles(const AliEventClassifierParticles &particles,
+								      AliMCEvent */*event*/) {
+  fClassifierValue = 0.0;
+  for (Int_t i = 0; i < particles.GetN(); i++) {
+    if (!particles.IsPhysicalPrimary(i)) continue;
+    if (particles.fCharge[i] == 0 && fCountCharged) continue;
+    if (IsCounted(particles.fEta[i])) fClassifierValue += 1.0;
+  }
+  return kTRUE;
+}
+
+Bool_t AliEventClassifierMult::IsCounted(Double_t eta) const {
+  // does this track fall into any of the defined regions?
+  Bool_t trackIsInRegion = false;
+  for(UInt_t i = 0; i != fRegions.size(); i++) {
+    if(eta >= fRegions[i][0] && eta <=fRegions[i][1]) {
+      trackIsInRegion = true;
+      break;
     }
-    // Are we counting tracks inside or outside of the region?
-    // increment counter accordingly
-    if (trackIsInRegion && fRegionsAreInclusive) fClassifierValue += 1.0;
-    else if (!trackIsInRegion && !fRegionsAreInclusive) fClassifierValue += 1.0;   
   }
+  // Are we counting tracks inside or outside of the region?
+  return trackIsInRegion == fRegionsAreInclusive;
 }
@@ -23,6 +23,8 @@ class AliEventClassifierMult : public AliEventClassifierBase {
   Bool_t fRegionsAreInclusive;
   Bool_t fCountCharged;
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+  Bool_t CalculateClassifierValueFromParticles(const AliEventClassifierParticles &particles, AliMCEvent *event);
+  Bool_t IsCounted(Double_t eta) const;
 
   ClassDef(AliEventClassifierMult, 1);
 };
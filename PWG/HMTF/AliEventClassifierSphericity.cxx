@@ -24,15 +24,7 @@ AliEventClassifierSphericity::AliEventClassifierSphericity(const char* name, con
 }
 
 void AliEventClassifierSphericity::CalculateClassifierValue(AliMCEvent *event, AliStack *stack) {
-  // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
-  fClassifierValue = -1.0;
-
-  Float_t sphericity = -1.0;
-  Float_t s00=0;
-  Float_t s01=0;
-  Float_t s11=0;
-  Float_t totalpt=0;
-
+  std::vector<Double_t> pt, phi;
   Int_t ntracks = event->GetNumberOfTracks();
   for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
     AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
@@ -44,19 +36,43 @@ void AliEventClassifierSphericity::CalculateClassifierValue(AliMCEvent *event, A
     // discard unphysical particles from some generators
     if (track->Pt() == 0 || track->E() <= 0)
       continue;
-    
-    Float_t px = track->Pt() * TMath::Cos( track->Phi() );
-    Float_t py = track->Pt() * TMath::Sin( track->Phi() );
-    s00 += (px * px) / track->Pt();
-    s01 += (py * px) / track->Pt();
-    s11 += (py * py) / track->Pt();
-    totalpt += track->Pt();
+    pt.push_back(track->Pt());
+    phi.push_back(track->Phi());
+  }
+  fClassifierValue = Sphericity(pt, phi);
+}
+
+Bool_t AliEventClassifierSphericity::CalculateClassifierValueFromParticles(const AliEventClassifierParticles &particles,
+									    AliMCEvent */*event*/) {
+  std::vector<Double_t> pt, phi;
+  for (Int_t i = 0; i < particles.GetN(); i++) {
+    if (!particles.IsPhysicalPrimary(i)) continue;
+    pt.push_back(particles.fPt[i]);
+    phi.push_back(particles.fPhi[i]);
   }
-  // did we have valid tracks or did we never reach the bottom of the for loop?
-  if (!(totalpt > 0)) {
-    fClassifierValue = -1;
-    return;
+  fClassifierValue = Sphericity(pt, phi);
+  return kTRUE;
+}
+
+Float_t AliEventClassifierSphericity::Sphericity(const std::vector<Double_t> &pt, const std::vector<Double_t> &phi) {
+  // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
+  Float_t sphericity = -1.0;
+  Float_t s00=0;
+  Float_t s01=0;
+  Float_t s11=0;
+  Float_t totalpt=0;
+
+  for (UInt_t i = 0; i < pt.size(); i++) {
+    Float_t px = pt[i] * TMath::Cos( phi[i] );
+    Float_t py = pt[i] * TMath::Sin( phi[i] );
+    s00 += (px * px) / pt[i];
+    s01 += (py * px) / pt[i];
+    s11 += (py * py) / pt[i];
+    totalpt += pt[i];
   }
+  // did we have valid tracks?
+  if (!(totalpt > 0))
+    return -1;
 
   Double_t S00=s00/totalpt;
   Double_t S01=s01/totalpt;
@@ -68,7 +84,5 @@ void AliEventClassifierSphericity::CalculateClassifierValue(AliMCEvent *event, A
     sphericity=0;
   if(lambda1+lambda2!=0)
     sphericity=2*TMath::Min( lambda1,lambda2 )/( lambda1+lambda2 );
-  
-  // Compute the final sphericity:
-  fClassifierValue = sphericity;
+  return sphericity;
 }
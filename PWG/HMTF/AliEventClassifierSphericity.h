@@ -13,6 +13,8 @@ class AliEventClassifierSphericity : public AliEventClassifierBase {
 
  private:
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+  Bool_t CalculateClassifierValueFromParticles(const AliEventClassifierParticles &particles, AliMCEvent *event);
+  static Float_t Sphericity(const std::vector<Double_t> &pt, const std::vector<Double_t> &phi);
   
   ClassDef(AliEventClassifierSphericity, 1);
 };
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
 #include "TMath.h"
+#include "TVector2.h"
 
 #include "AliLog.h"
 #include "AliMCEvent.h"
@@ -42,50 +44,78 @@ Bool_t AliEventClassifierSpherocity::TrackPassesSelection(AliMCParticle* track,
 }
 
 void AliEventClassifierSpherocity::CalculateClassifierValue(AliMCEvent *event, AliStack *stack) {
-  // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
-  fClassifierValue = 0.0;
-
-  Float_t sumRatioSquare = 0;
-  Float_t minimalSumRatioSquare = 2;
-  
-  // Step size in phi unit vector used to find m spherocity
-  Float_t phiStepSize = 0.1;
-
-  // Computing total pt
-  Float_t sumapt = 0;
+  std::vector<Double_t> pt, phi;
   Int_t ntracks = event->GetNumberOfTracks();
   for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
     AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
     if (!TrackPassesSelection(track, stack, iTrack)) continue;
-    sumapt += track->Pt();
+    pt.push_back(track->Pt());
+    phi.push_back(track->Phi());
   }
-  
-  // Getting thrust
-  for(Int_t i = 0; i < 360/(phiStepSize); ++i){
-    Float_t numerator = 0;
-    Float_t phiparam  = 0;
-    Float_t nx = 0;
-    Float_t ny = 0;
-    phiparam=((TMath::Pi()) * i * phiStepSize) / 180; // parametrization of the angle
-    nx = TMath::Cos(phiparam);            // x component of an unitary vector n
-    ny = TMath::Sin(phiparam);            // y component of an unitary vector n
-    for(Int_t iTrack = 0; iTrack < ntracks; ++iTrack){
-      AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-      if (!TrackPassesSelection(track, stack, iTrack)) continue;
-      
-      Float_t pxA = track->Pt() * TMath::Cos(track->Phi());
-      Float_t pyA = track->Pt() * TMath::Sin(track->Phi());
-      //product between p projection in XY plane and the unitary vector
-      numerator += TMath::Abs( ny * pxA - nx * pyA );
-    }
-    
-    sumRatioSquare = TMath::Power((numerator / sumapt), 2);
-    if(sumRatioSquare < minimalSumRatioSquare)  //minimization of pFull
-      {
-	minimalSumRatioSquare = sumRatioSquare;
-      }
+  fClassifierValue = Spherocity(pt, phi);
+}
+
+Bool_t AliEventClassifierSpherocity::CalculateClassifierValueFromParticles(const AliEventClassifierParticles &particles,
+									    AliMCEvent */*event*/) {
+  // Same selection as TrackPassesSelection
+  std::vector<Double_t> pt, phi;
+  for (Int_t i = 0; i < particles.GetN(); i++) {
+    if (!particles.IsPhysicalPrimary(i)) continue;
+    if (TMath::Abs(particles.fEta[i]) > 0.8) continue;
+    pt.push_back(particles.fPt[i]);
+    phi.push_back(particles.fPhi[i]);
+  }
+  fClassifierValue = Spherocity(pt, phi);
+  return kTRUE;
+}
+
+Float_t AliEventClassifierSpherocity::Spherocity(const std::vector<Double_t> &pt, const std::vector<Double_t> &phi) {
+  // Definition as in PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx:
+  // S0 = pi^2/4 * min_n (sum_i |p_i x n| / sum_i |p_i|)^2
+  // Instead of scanning n in steps of 0.1 degree, the exact minimum is found: the sum is a
+  // positive sinusoid between two particle directions, hence concave, so the minimum lies on the
+  // direction of one of the particles. With the directions folded into [0, pi) and sorted, the
+  // sum for n along particle k splits into the particles below and above it:
+  // sum = sin(phi_k) (X_below - X_above) - cos(phi_k) (Y_below - Y_above)
+  // which is evaluated for all k with running sums, O(N log N) in total.
+  const Int_t n = pt.size();
+  std::vector<std::pair<Double_t, Int_t> > folded(n);
+  Double_t sumapt = 0;
+  for (Int_t i = 0; i < n; i++) {
+    Double_t a = TVector2::Phi_0_2pi(phi[i]);
+    if (a >= TMath::Pi()) a -= TMath::Pi();
+    folded[i] = std::make_pair(a, i);
+    sumapt += pt[i];
+  }
+  // no particles: keep the value of the angular scan (2 * pi^2 / 4)
+  if (!(sumapt > 0))
+    return TMath::Pi() * TMath::Pi() / 2.0;
+  std::sort(folded.begin(), folded.end());
+
+  std::vector<Double_t> x(n), y(n);
+  Double_t xabove = 0, yabove = 0;
+  for (Int_t k = 0; k < n; k++) {
+    x[k] = pt[folded[k].second] * TMath::Cos(folded[k].first);
+    y[k] = pt[folded[k].second] * TMath::Sin(folded[k].first);
+    xabove += x[k];
+    yabove += y[k];
+  }
+
+  Double_t xbelow = 0, ybelow = 0;
+  Double_t minimalSum = sumapt;
+  for (Int_t k = 0; k < n; k++) {
+    xabove -= x[k];
+    yabove -= y[k];
+    Double_t nx = TMath::Cos(folded[k].first);
+    Double_t ny = TMath::Sin(folded[k].first);
+    Double_t sum = ny * (xbelow - xabove) - nx * (ybelow - yabove);
+    if (sum < minimalSum) minimalSum = sum;
+    xbelow += x[k];
+    ybelow += y[k];
   }
+  if (minimalSum < 0) minimalSum = 0;  // rounding
 
   // Compute the final spherocity:
-  fClassifierValue = (minimalSumRatioSquare * TMath::Pi() * TMath::Pi()) / 4.0;
+  Double_t ratio = minimalSum / sumapt;
+  return (ratio * ratio * TMath::Pi() * TMath::Pi()) / 4.0;
 }
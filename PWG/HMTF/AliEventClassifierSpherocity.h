@@ -14,6 +14,8 @@ class AliEventClassifierSpherocity : public AliEventClassifierBase {
  private:
   Bool_t TrackPassesSelection(AliMCParticle* track, AliStack *stack, Int_t iTrack);
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+  Bool_t CalculateClassifierValueFromParticles(const AliEventClassifierParticles &particles, AliMCEvent *event);
+  static Float_t Spherocity(const std::vector<Double_t> &pt, const std::vector<Double_t> &phi);
   
   ClassDef(AliEventClassifierSpherocity, 1);
 };
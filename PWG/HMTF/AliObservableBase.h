@@ -12,6 +12,9 @@ class AliObservableBase : public TNamed {
   ~AliObservableBase() {}
 
   virtual void Fill(AliMCEvent *event, AliStack *stack) = 0;
+  // Fill from the particle table of the event; observables which do not implement it loop over the event
+  virtual void FillFromParticles(AliMCEvent *event, AliStack *stack, const AliEventClassifierParticles &/*particles*/)
+  {Fill(event, stack);}
 
   ClassDef(AliObservableBase, 1);
 };
@@ -123,6 +123,27 @@ void AliObservableClassifierpTPID::Fill(AliMCEvent *event, AliStack *stack) {
   }
 }
 
+void AliObservableClassifierpTPID::FillFromParticles(AliMCEvent *event, AliStack *stack,
+						      const AliEventClassifierParticles &particles) {
+  Double_t classifier_value = fclassifier->GetClassifierValue(event, stack, particles);
+  Double_t event_weight = event->GenEventHeader()->EventWeight();
+
+  // The table holds exactly the primaries and pi0's
+  for (Int_t i = 0; i < particles.GetN(); i++) {
+    if (!(TMath::Abs(particles.fY[i]) < 0.5)) continue;
+    Int_t pdgCode = particles.fPdg[i];
+    for (Int_t ipid = 0; ipid < kNPID; ipid++) {
+      if (pdgCode == this->Pid_enum_to_pdg(ipid)){
+	fhistogram->Fill(classifier_value, particles.fPt[i], ipid, event_weight);
+	break;
+      }
+    }
+    if (particles.fCharge[i] != 0) {
+      fhistogram->Fill(classifier_value, particles.fPt[i], this->kALLCHARGED, event_weight);
+    }
+  }
+}
+
 Int_t AliObservableClassifierpTPID::Pid_enum_to_pdg(Int_t pid_enum) {
   if (pid_enum == kPROTON) return 2212;
   else if (pid_enum == kANTIPROTON) return -2212;
@@ -12,6 +12,7 @@ class AliObservableClassifierpTPID : public AliObservableBase {
   ~AliObservableClassifierpTPID() {};
 
   void Fill(AliMCEvent *event, AliStack *stack);
+  void FillFromParticles(AliMCEvent *event, AliStack *stack, const AliEventClassifierParticles &particles);
  private:
   enum {
     kPROTON,
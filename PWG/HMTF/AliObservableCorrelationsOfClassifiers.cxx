@@ -54,3 +54,11 @@ void AliObservableCorrelationsOfClassifiers::Fill(AliMCEvent *event, AliStack *s
   Float_t weight = event->GenEventHeader()->EventWeight();
   fhistogram->Fill(cls0, cls1, weight);
 }
+
+void AliObservableCorrelationsOfClassifiers::FillFromParticles(AliMCEvent *event, AliStack *stack,
+								const AliEventClassifierParticles &particles) {
+  Float_t cls0 = fclassifier0->GetClassifierValue(event, stack, particles);
+  Float_t cls1 = fclassifier1->GetClassifierValue(event, stack, particles);
+  Float_t weight = event->GenEventHeader()->EventWeight();
+  fhistogram->Fill(cls0, cls1, weight);
+}
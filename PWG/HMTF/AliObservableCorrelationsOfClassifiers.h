@@ -10,6 +10,7 @@ class AliObservableCorrelationsOfClassifiers : public AliObservableBase {
   ~AliObservableCorrelationsOfClassifiers() {};
 
   void Fill(AliMCEvent *event, AliStack *stack);
+  void FillFromParticles(AliMCEvent *event, AliStack *stack, const AliEventClassifierParticles &particles);
 
  private:
   TH2F *fhistogram;
@@ -69,3 +69,15 @@ void AliObservableEtaNch::Fill(AliMCEvent *event, AliStack *stack) {
     fhistogram->Fill(track->Eta(), classifier_value, event_weight);
   }
 }
+
+void AliObservableEtaNch::FillFromParticles(AliMCEvent *event, AliStack *stack,
+					     const AliEventClassifierParticles &particles) {
+  Double_t classifier_value = fclassifier->GetClassifierValue(event, stack, particles);
+  Double_t event_weight = event->GenEventHeader()->EventWeight();
+
+  for (Int_t i = 0; i < particles.GetN(); i++) {
+    // charged primaries only
+    if (!particles.IsPhysicalPrimary(i) || particles.fCharge[i] == 0) continue;
+    fhistogram->Fill(particles.fEta[i], classifier_value, event_weight);
+  }
+}
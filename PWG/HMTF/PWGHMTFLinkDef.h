@@ -11,6 +11,7 @@
 #pragma link C++ class AliObservableCorrelationsOfClassifiers+;
 #pragma link C++ class AliObservableEtaNch+;
 #pragma link C++ class AliEventClassifierBase+;
+#pragma link C++ class AliEventClassifierEngine+;
 #pragma link C++ class AliEventClassifierMult+;
 #pragma link C++ class AliEventClassifierMPI+;
 #pragma link C++ class AliEventClassifierSphericity+;
@@ -64,7 +64,11 @@ AliEmcalJet::AliEmcalJet() :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fPackedOffset(-1),
+  fNPackedTracks(0),
+  fNPackedClusters(0),
+  fIndexBuffer(0)
 {
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
@@ -116,7 +120,11 @@ AliEmcalJet::AliEmcalJet(Double_t px, Double_t py, Double_t pz) :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fPackedOffset(-1),
+  fNPackedTracks(0),
+  fNPackedClusters(0),
+  fIndexBuffer(0)
 {
   if (fPt != 0) {
     fPhi = TVector2::Phi_0_2pi(TMath::ATan2(py, px));
@@ -173,7 +181,11 @@ AliEmcalJet::AliEmcalJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fJetShapeProperties(0),
   fJetAcceptanceType(0),
   fParticleConstituents(),
-  fClusterConstituents()
+  fClusterConstituents(),
+  fPackedOffset(-1),
+  fNPackedTracks(0),
+  fNPackedClusters(0),
+  fIndexBuffer(0)
 {
   fPhi = TVector2::Phi_0_2pi(fPhi);
 
@@ -224,7 +236,11 @@ AliEmcalJet::AliEmcalJet(const AliEmcalJet& jet) :
   fJetShapeProperties(0),
   fJetAcceptanceType(jet.fJetAcceptanceType),
   fParticleConstituents(jet.fParticleConstituents),
-  fClusterConstituents(jet.fClusterConstituents)
+  fClusterConstituents(jet.fClusterConstituents),
+  fPackedOffset(jet.fPackedOffset),
+  fNPackedTracks(jet.fNPackedTracks),
+  fNPackedClusters(jet.fNPackedClusters),
+  fIndexBuffer(jet.fIndexBuffer)
 
 {
   // Copy constructor.
@@ -296,6 +312,10 @@ AliEmcalJet& AliEmcalJet::operator=(const AliEmcalJet& jet)
     fJetAcceptanceType  = jet.fJetAcceptanceType;
     fParticleConstituents = jet.fParticleConstituents;
     fClusterConstituents = jet.fClusterConstituents;
+    fPackedOffset       = jet.fPackedOffset;
+    fNPackedTracks      = jet.fNPackedTracks;
+    fNPackedClusters    = jet.fNPackedClusters;
+    fIndexBuffer        = jet.fIndexBuffer;
   }
 
   return *this;
@@ -385,6 +405,7 @@ TLorentzVector AliEmcalJet::SubtractRhoVect(Double_t rho, Bool_t save)
 
 /**
  *  Sort constituent by index (increasing).
+ *  Packed constituents are not sorted: sorting has to be done before packing.
  *
  */
 void AliEmcalJet::SortConstituents()
@@ -540,8 +561,8 @@ void AliEmcalJet::ResetMatching()
  */
 Int_t AliEmcalJet::ContainsTrack(Int_t it) const
 {
-  for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
-    if (it == fTrackIDs[i]) return i;
+  for (Int_t i = 0; i < GetNumberOfTracks(); i++) {
+    if (it == TrackAt(i)) return i;
   }
   return -1;
 }
@@ -553,8 +574,8 @@ Int_t AliEmcalJet::ContainsTrack(Int_t it) const
  */
 Int_t AliEmcalJet::ContainsCluster(Int_t ic) const
 {
-  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
-    if (ic == fClusterIDs[i]) return i;
+  for (Int_t i = 0; i < GetNumberOfClusters(); i++) {
+    if (ic == ClusterAt(i)) return i;
   }
   return -1;
 }
@@ -677,6 +698,42 @@ void AliEmcalJet::Clear(Option_t */*option*/)
   fHasGhost = kFALSE;
   fClusterConstituents.clear();
   fParticleConstituents.clear();
+  fPackedOffset = -1;
+  fNPackedTracks = 0;
+  fNPackedClusters = 0;
+  fIndexBuffer = 0;
+}
+
+/**
+ * Move the track and cluster constituent indices of the jet into a shared per-event buffer.
+ * Afterwards the jet only stores the offset and the number of constituents, the
+ * indices are accessed via the buffer. Constituents must not be added or sorted
+ * after packing.
+ * @param buffer Index buffer of the jet collection
+ */
+void AliEmcalJet::PackConstituents(AliEmcalJetConstituentIndexBuffer &buffer)
+{
+  if (fPackedOffset >= 0) return;
+  fNPackedTracks = fTrackIDs.GetSize();
+  fNPackedClusters = fClusterIDs.GetSize();
+  fPackedOffset = buffer.Append(fTrackIDs, fClusterIDs);
+  fIndexBuffer = &buffer;
+  fTrackIDs.Set(0);
+  fClusterIDs.Set(0);
+}
+
+/**
+ * Access to a packed constituent index.
+ * @param pos Position relative to the jet offset (tracks first, then clusters)
+ * @return Constituent index (-1 if the index buffer is not available)
+ */
+Int_t AliEmcalJet::PackedIndexAt(Int_t pos) const
+{
+  if (!fIndexBuffer) {
+    AliError("Jet constituents are packed but no index buffer is attached");
+    return -1;
+  }
+  return fIndexBuffer->At(fPackedOffset + pos);
 }
 
 /**
@@ -20,6 +20,7 @@
 #include <AliVEvent.h>
 
 #include "AliEmcalJetShapeProperties.h"
+#include "AliEmcalJetConstituentIndexBuffer.h"
 #include "AliEmcalClusterJetConstituent.h"
 #include "AliEmcalParticleJetConstituent.h"
 
@@ -47,6 +48,11 @@
  *
  * Constituents are distinguished between cluster type (EMCAL/PHOS cluster) and particle
  * type (track / particle) constituents.
+ *
+ * The constituent indices can be packed (see PackConstituents) into an AliEmcalJetConstituentIndexBuffer
+ * shared by all jets of the event. In this case the jet only stores an offset into the buffer, and
+ * the indices are streamed as a single array for the whole event. The buffer is attached to the
+ * jets by AliJetContainer, the access via TrackAt / ClusterAt is unchanged.
  */
 class AliEmcalJet : public AliVParticle
 {
@@ -134,9 +140,9 @@ class AliEmcalJet : public AliVParticle
   Double_t          AreaE()                      const { return fAreaE                   ; }
   Double_t          AreaEmc()                    const { return fAreaEmc                 ; }
   Bool_t            AxisInEmcal()                const { return fAxisInEmcal             ; }
-  Int_t             ClusterAt(Int_t idx)         const { return fClusterIDs.At(idx)      ; }
-  UShort_t          GetNumberOfClusters()        const { return fClusterIDs.GetSize()    ; }
-  UShort_t          GetNumberOfTracks()          const { return fTrackIDs.GetSize()      ; }
+  Int_t             ClusterAt(Int_t idx)         const { return fPackedOffset < 0 ? fClusterIDs.At(idx) : PackedIndexAt(fNPackedTracks + idx); }
+  UShort_t          GetNumberOfClusters()        const { return fPackedOffset < 0 ? fClusterIDs.GetSize() : fNPackedClusters; }
+  UShort_t          GetNumberOfTracks()          const { return fPackedOffset < 0 ? fTrackIDs.GetSize() : fNPackedTracks; }
   UShort_t          GetNumberOfConstituents()    const { return GetNumberOfClusters()+GetNumberOfTracks(); }
   Double_t          FracEmcalArea()              const { return fAreaEmc/fArea           ; }
   Bool_t            IsInsideEmcal()              const { return (fAreaEmc/fArea>0.999)   ; }
@@ -157,7 +163,7 @@ class AliEmcalJet : public AliVParticle
   Double_t          PtEmc()                      const { return fPtEmc                   ; }
   Double_t          PtSub()                      const { return fPtSub                   ; }
   Double_t          PtSubVect()                  const { return fPtSubVect               ; }
-  Int_t             TrackAt(Int_t idx)           const { return fTrackIDs.At(idx)        ; }
+  Int_t             TrackAt(Int_t idx)           const { return fPackedOffset < 0 ? fTrackIDs.At(idx) : PackedIndexAt(idx); }
 
   // Background subtraction
   Double_t          PtSub(Double_t rho, Bool_t save = kFALSE)          ;
@@ -309,6 +315,11 @@ class AliEmcalJet : public AliVParticle
    */
   void              AddClusterConstituent(const PWG::JETFW::AliEmcalClusterJetConstituent &clust);
 
+  // Packed constituent indices
+  void              PackConstituents(AliEmcalJetConstituentIndexBuffer &buffer);
+  Bool_t            HasPackedConstituents()                   const { return fPackedOffset >= 0; }
+  void              SetConstituentIndexBuffer(const AliEmcalJetConstituentIndexBuffer *buffer) { fIndexBuffer = buffer; }
+
   // Sorting methods
   void              SortConstituents();
   std::vector<int>  GetPtSortedTrackConstituentIndexes(TClonesArray *tracks) const;
@@ -422,6 +433,13 @@ class AliEmcalJet : public AliVParticle
   std::vector<PWG::JETFW::AliEmcalParticleJetConstituent>      fParticleConstituents;  ///< List of particle constituents
   std::vector<PWG::JETFW::AliEmcalClusterJetConstituent>       fClusterConstituents;   ///< List of cluster constituents
 
+  Int_t             fPackedOffset;        ///<  Offset of the packed constituent indices in the index buffer (-1 if not packed)
+  UShort_t          fNPackedTracks;       ///<  Number of packed track constituents
+  UShort_t          fNPackedClusters;     ///<  Number of packed cluster constituents
+  const AliEmcalJetConstituentIndexBuffer *fIndexBuffer; //!<! Index buffer holding the packed constituent indices
+
+  Int_t             PackedIndexAt(Int_t pos) const;
+
  private:
   /**
    * @struct sort_descend
@@ -433,7 +451,7 @@ class AliEmcalJet : public AliVParticle
   };
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJet,19);
+  ClassDef(AliEmcalJet,20);
   /// \endcond
 };
 
@@ -0,0 +1,73 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <TArrayI.h>
+#include <TString.h>
+
+#include "AliEmcalJetConstituentIndexBuffer.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalJetConstituentIndexBuffer);
+/// \endcond
+
+/**
+ * Default constructor, for ROOT I/O.
+ */
+AliEmcalJetConstituentIndexBuffer::AliEmcalJetConstituentIndexBuffer() :
+  TNamed(),
+  fIndices()
+{
+}
+
+/**
+ * Standard constructor.
+ * @param name Name of the buffer (see GetBufferName)
+ */
+AliEmcalJetConstituentIndexBuffer::AliEmcalJetConstituentIndexBuffer(const char *name) :
+  TNamed(name, name),
+  fIndices()
+{
+}
+
+/**
+ * Remove all indices. The memory is kept for the next event.
+ */
+void AliEmcalJetConstituentIndexBuffer::Clear(Option_t * /*option*/)
+{
+  fIndices.clear();
+}
+
+/**
+ * Append the constituent indices of a jet at the end of the buffer.
+ * @param tracks Indices of the track constituents
+ * @param clusters Indices of the cluster constituents
+ * @return Offset of the first track index of the jet in the buffer
+ */
+Int_t AliEmcalJetConstituentIndexBuffer::Append(const TArrayI &tracks, const TArrayI &clusters)
+{
+  Int_t offset = fIndices.size();
+  fIndices.insert(fIndices.end(), tracks.GetArray(), tracks.GetArray() + tracks.GetSize());
+  fIndices.insert(fIndices.end(), clusters.GetArray(), clusters.GetArray() + clusters.GetSize());
+  return offset;
+}
+
+/**
+ * Name of the index buffer associated to a jet collection.
+ * @param jetsName Name of the jet collection
+ * @return Name of the index buffer
+ */
+TString AliEmcalJetConstituentIndexBuffer::GetBufferName(const char *jetsName)
+{
+  return TString::Format("%s_ConstituentIndices", jetsName);
+}
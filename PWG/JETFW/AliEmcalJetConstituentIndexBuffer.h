@@ -0,0 +1,49 @@
+#ifndef ALIEMCALJETCONSTITUENTINDEXBUFFER_H
+#define ALIEMCALJETCONSTITUENTINDEXBUFFER_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <TNamed.h>
+
+class TArrayI;
+
+/**
+ * @class AliEmcalJetConstituentIndexBuffer
+ * @brief Packed storage of the constituent indices of all jets of a jet collection in one event
+ * @ingroup JETFW
+ *
+ * Jets with packed constituents (see AliEmcalJet::PackConstituents) only store
+ * an offset and the number of tracks and clusters. The indices themselves
+ * are stored contiguously in this buffer (first the tracks, then the clusters of
+ * each jet), which is streamed as a single array instead of two arrays per jet.
+ *
+ * The buffer is added to the event by the jet finder with the name of the jet
+ * collection followed by "_ConstituentIndices" (see GetBufferName), and attached
+ * to the jets by AliJetContainer in each event.
+ */
+class AliEmcalJetConstituentIndexBuffer : public TNamed {
+public:
+  AliEmcalJetConstituentIndexBuffer();
+  AliEmcalJetConstituentIndexBuffer(const char *name);
+  virtual ~AliEmcalJetConstituentIndexBuffer() {}
+
+  void                Clear(Option_t *option="");
+  Int_t               Append(const TArrayI &tracks, const TArrayI &clusters);
+  Int_t               At(Int_t i)                   const { return fIndices[i]; }
+  Int_t               GetSize()                     const { return fIndices.size(); }
+
+  static TString      GetBufferName(const char *jetsName);
+
+protected:
+  std::vector<Int_t>  fIndices;         ///< Packed constituent indices of all jets of the event
+
+private:
+  AliEmcalJetConstituentIndexBuffer(const AliEmcalJetConstituentIndexBuffer&);             // not implemented
+  AliEmcalJetConstituentIndexBuffer& operator=(const AliEmcalJetConstituentIndexBuffer&);  // not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalJetConstituentIndexBuffer, 1);
+  /// \endcond
+};
+#endif
@@ -22,6 +22,7 @@
 #include "AliClusterContainer.h"
 #include "AliLocalRhoParameter.h"
 #include "AliTLorentzVector.h"
+#include "AliEmcalContainerUtils.h"
 
 #include "AliJetContainer.h"
 
@@ -63,7 +64,8 @@ AliJetContainer::AliJetContainer():
   fGeom(0),
   fRunNumber(0),
   fTpcHolePos(0),
-  fTpcHoleWidth(0)
+  fTpcHoleWidth(0),
+  fConstituentIndexBuffer(0)
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -104,7 +106,8 @@ AliJetContainer::AliJetContainer(const char *name):
   fGeom(0),
   fRunNumber(0),
   fTpcHolePos(0),
-  fTpcHoleWidth(0)
+  fTpcHoleWidth(0),
+  fConstituentIndexBuffer(0)
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -154,7 +157,8 @@ AliJetContainer::AliJetContainer(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoSc
   fLocalRho(0),
   fRhoMass(0),
   fGeom(0),
-  fRunNumber(0)
+  fRunNumber(0),
+  fConstituentIndexBuffer(0)
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -170,6 +174,28 @@ void AliJetContainer::SetArray(const AliVEvent *event)
   // Set jet array
 
   AliEmcalContainer::SetArray(event);
+
+  // Index buffer of packed jet constituents (if any)
+  const AliVEvent *jetEvent = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
+  if (jetEvent) {
+    fConstituentIndexBuffer = dynamic_cast<AliEmcalJetConstituentIndexBuffer*>(jetEvent->FindListObject(AliEmcalJetConstituentIndexBuffer::GetBufferName(fClArrayName)));
+  }
+}
+
+/**
+ * Calls the base class method, then attaches the index buffer
+ * of the packed jet constituents (if available) to the jets.
+ * @param event The event to be processed.
+ */
+void AliJetContainer::NextEvent(const AliVEvent *event)
+{
+  AliParticleContainer::NextEvent(event);
+
+  if (!fConstituentIndexBuffer || !fClArray) return;
+  for (Int_t ijet = 0; ijet < fClArray->GetEntriesFast(); ijet++) {
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fClArray->UncheckedAt(ijet));
+    if (jet && jet->HasPackedConstituents()) jet->SetConstituentIndexBuffer(fConstituentIndexBuffer);
+  }
 }
 
 /**
@@ -177,6 +177,7 @@ class AliJetContainer : public AliParticleContainer {
   Double_t                    GetJetPtCutMax()                      const    {return GetMaxPt() ; }
 
   void                        SetArray(const AliVEvent *event);
+  virtual void                NextEvent(const AliVEvent *event);
   AliParticleContainer       *GetParticleContainer() const                   {return fParticleContainer;}
   AliClusterContainer        *GetClusterContainer() const                    {return fClusterContainer;}
   Double_t                    GetFractionSharedPt(const AliEmcalJet *jet, AliParticleContainer *cont2 = 0x0) const;
@@ -224,6 +225,7 @@ class AliJetContainer : public AliParticleContainer {
   Int_t                       fRunNumber;            //!<! run number
   Double_t                    fTpcHolePos;           ///   position(in radians) of the malfunctioning TPC sector
   Double_t                    fTpcHoleWidth;         ///   width of the malfunctioning TPC area
+  AliEmcalJetConstituentIndexBuffer *fConstituentIndexBuffer; //!<! index buffer of the packed jet constituents
  private:
   AliJetContainer(const AliJetContainer& obj); // copy constructor
   AliJetContainer& operator=(const AliJetContainer& other); // assignment
@@ -7,6 +7,7 @@
 // ESD stuff
 #include "AliESDEvent.h"
 #include "AliESDInputHandler.h"
+#include "AliESDTrdTrack.h"
 
 // GTU simulation
 #include "AliTRDgtuParam.h"
@@ -32,6 +33,11 @@ AliAnalysisTaskTRDgtuSim::AliAnalysisTaskTRDgtuSim(const char *name) :
 {
   // ctor
 
+  for (Int_t iStack = 0; iStack < fgkNstacks; ++iStack) {
+    fTracksCheck[iStack].reserve(20);
+    fTracksRef[iStack].reserve(20);
+  }
+
   DefineOutput(1, TList::Class());
 }
 
@@ -118,65 +124,79 @@ void AliAnalysisTaskTRDgtuSim::Check(Int_t label, Int_t labelRef)
   if (!esdEvent)
     return;
 
-  TList tracksCheck;
-  TList tracksRef;
+  // tracks can only share tracklets within a stack,
+  // so they are sorted by stack into the preallocated buffers
+  for (Int_t iStack = 0; iStack < fgkNstacks; ++iStack) {
+    fTracksCheck[iStack].clear();
+    fTracksRef[iStack].clear();
+  }
 
   Int_t nTracks = esdEvent->GetNumberOfTrdTracks();
   for (Int_t iTrack = 0; iTrack < nTracks; ++iTrack) {
     AliESDTrdTrack *trk = esdEvent->GetTrdTrack(iTrack);
+    Int_t globalStack = 5*trk->GetSector() + trk->GetStack();
+    if ((globalStack < 0) || (globalStack >= fgkNstacks))
+      continue;
     if (trk->GetLabel() == label)
-      tracksCheck.Add(trk);
+      fTracksCheck[globalStack].push_back(trk);
     if (trk->GetLabel() == labelRef)
-      tracksRef.Add(trk);
+      fTracksRef[globalStack].push_back(trk);
   }
 
-  TIter iterTrack(&tracksCheck);
-  while (AliESDTrdTrack *trk = (AliESDTrdTrack*) iterTrack()) {
-    TIter iterTrackRef(&tracksRef);
-    Bool_t foundMatch = kFALSE;
-    while (AliESDTrdTrack *trkRef = (AliESDTrdTrack*) iterTrackRef()) {
-      // check for common tracklets
-      Bool_t commonTracklet = kFALSE;
-      Bool_t allEqual = kTRUE;
-      for (Int_t iLayer = 0; iLayer < 6; ++iLayer) {
-	if (trk->GetTracklet(iLayer)) {
-	  if (trk->GetTracklet(iLayer) == trkRef->GetTracklet(iLayer))
-	    commonTracklet = kTRUE;
-	  else
+  for (Int_t iStack = 0; iStack < fgkNstacks; ++iStack) {
+    std::vector<AliESDTrdTrack*> &tracksCheck = fTracksCheck[iStack];
+    std::vector<AliESDTrdTrack*> &tracksRef = fTracksRef[iStack];
+    Int_t nRefLeft = tracksRef.size();
+
+    for (UInt_t iTrack = 0; iTrack < tracksCheck.size(); ++iTrack) {
+      AliESDTrdTrack *trk = tracksCheck[iTrack];
+      Bool_t foundMatch = kFALSE;
+      for (UInt_t iTrackRef = 0; iTrackRef < tracksRef.size(); ++iTrackRef) {
+	AliESDTrdTrack *trkRef = tracksRef[iTrackRef];
+	if (!trkRef)
+	  continue;
+	// check for common tracklets
+	Bool_t commonTracklet = kFALSE;
+	Bool_t allEqual = kTRUE;
+	for (Int_t iLayer = 0; iLayer < 6; ++iLayer) {
+	  if (trk->GetTracklet(iLayer)) {
+	    if (trk->GetTracklet(iLayer) == trkRef->GetTracklet(iLayer))
+	      commonTracklet = kTRUE;
+	    else
+	      allEqual = kFALSE;
+	  }
+	  else if (trkRef->GetTracklet(iLayer))
 	    allEqual = kFALSE;
 	}
-	else if (trkRef->GetTracklet(iLayer))
-	  allEqual = kFALSE;
-      }
-      if (commonTracklet) {
-	// tracks with a common tracklet should be identical
-	if (allEqual) {
-	  // identical track composition
-	  fHistStat->Fill(1);
-	  Int_t deltaA = trk->GetA() - trkRef->GetA();
-	  fHistDeltaA->Fill(deltaA);
-	  Int_t deltaB = trk->GetB() - trkRef->GetB();
-	  fHistDeltaB->Fill(deltaB);
-	  Int_t deltaC = trk->GetC() - trkRef->GetC();
-	  fHistDeltaC->Fill(deltaC);
-	}
-	else {
-	  // track with different tracklets
-	  fHistStat->Fill(2);
+	if (commonTracklet) {
+	  // tracks with a common tracklet should be identical
+	  if (allEqual) {
+	    // identical track composition
+	    fHistStat->Fill(1);
+	    Int_t deltaA = trk->GetA() - trkRef->GetA();
+	    fHistDeltaA->Fill(deltaA);
+	    Int_t deltaB = trk->GetB() - trkRef->GetB();
+	    fHistDeltaB->Fill(deltaB);
+	    Int_t deltaC = trk->GetC() - trkRef->GetC();
+	    fHistDeltaC->Fill(deltaC);
+	  }
+	  else {
+	    // track with different tracklets
+	    fHistStat->Fill(2);
+	  }
+	  tracksRef[iTrackRef] = 0x0;
+	  --nRefLeft;
+	  foundMatch = kTRUE;
+	  break;
 	}
-	tracksRef.Remove(trkRef);
-	foundMatch = kTRUE;
-	break;
+      }
+      if (!foundMatch) {
+	// unmatched sim track
+	fHistStat->Fill(3);
       }
     }
-    if (!foundMatch) {
-      // unmatched sim track
-      fHistStat->Fill(3);
-    }
-  }
-  TIter iterTrackRef(&tracksRef);
-  while (iterTrackRef()) {
-    // unmatched raw track
-    fHistStat->Fill(4);
+    // unmatched raw tracks
+    for (Int_t iRef = 0; iRef < nRefLeft; ++iRef)
+      fHistStat->Fill(4);
   }
 }
@@ -1,10 +1,13 @@
 #ifndef ALIANALYSISTASKTRDGTUSIM_H
 #define ALIANALYSISTASKTRDGTUSIM_H
 
+#include <vector>
+
 #include "AliAnalysisTaskSE.h"
 
 class TH1;
 class AliTRDgtuSim;
+class AliESDTrdTrack;
 
 class AliAnalysisTaskTRDgtuSim : public AliAnalysisTaskSE {
  public:
@@ -48,11 +51,15 @@ class AliAnalysisTaskTRDgtuSim : public AliAnalysisTaskSE {
   Bool_t fLimitNoTracklets; // enable limitation on tracklet number
   Int_t fMaxNoTracklets; // maximum no of tracklets (if enabled)
 
+  static const Int_t fgkNstacks = 90; // no. of TRD stacks (global)
+  std::vector<AliESDTrdTrack*> fTracksCheck[fgkNstacks]; //! tracks to check, per stack
+  std::vector<AliESDTrdTrack*> fTracksRef[fgkNstacks];   //! reference tracks, per stack
+
  private:
   AliAnalysisTaskTRDgtuSim(const AliAnalysisTaskTRDgtuSim &rhs);
   AliAnalysisTaskTRDgtuSim& operator=(const AliAnalysisTaskTRDgtuSim &rhs);
 
-  ClassDef(AliAnalysisTaskTRDgtuSim, 1);
+  ClassDef(AliAnalysisTaskTRDgtuSim, 2);
 };
 
 #endif
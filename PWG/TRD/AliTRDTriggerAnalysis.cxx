@@ -20,6 +20,9 @@
 //
 // Author: Jochen Klein <jochen.klein@cern.ch>
 
+#include "TObjArray.h"
+
+#include "AliAnalysisManager.h"
 #include "AliLog.h"
 #include "AliVTrack.h"
 #include "AliVEvent.h"
@@ -30,6 +33,29 @@
 
 #include "AliTRDTriggerAnalysis.h"
 
+namespace {
+  // TRD trigger record of the current event: trigger inputs and classes,
+  // GTU contributions and GTU tracks, filled by the first instance
+  // calling CalcTriggers and reused by all others (e.g. other wagons)
+  struct TriggerRecord_t {
+    Long64_t fEntry;
+    const AliVEvent *fEvent;
+    UChar_t fInputs;
+    UChar_t fClasses;
+    UInt_t fContribs[18];
+    std::vector<AliTRDTriggerAnalysis::GtuTrack_t> fTracks;
+  };
+
+  TriggerRecord_t gRecord = { -1, 0x0, 0, 0, { 0 }, std::vector<AliTRDTriggerAnalysis::GtuTrack_t>() };
+
+  // current entry of the analysis manager, -1 (no record) outside of a train
+  Long64_t CurrentEntry()
+  {
+    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+    return mgr ? mgr->GetCurrentEntry() : -1;
+  }
+}
+
 AliTRDTriggerAnalysis::AliTRDTriggerAnalysis() :
   TObject(),
   fTriggerFlags(),
@@ -51,7 +77,8 @@ AliTRDTriggerAnalysis::AliTRDTriggerAnalysis() :
   fTRDminSectorHEE(6),
   fTRDmaxSectorHEE(8),
   fTRDptHJT(3.),
-  fTRDnHJT(3)
+  fTRDnHJT(3),
+  fGtuTracks()
 {
   // ctor
 
@@ -84,6 +111,17 @@ Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event)
     return kFALSE;
   }
 
+  // use the trigger record if the event was already read
+  Long64_t entry = CurrentEntry();
+  if ((entry >= 0) && (entry == gRecord.fEntry) && (event == gRecord.fEvent)) {
+    fTriggerInputs = gRecord.fInputs;
+    fTriggerClasses = gRecord.fClasses;
+    memcpy(fTriggerContribs, gRecord.fContribs, sizeof(fTriggerContribs));
+    fGtuTracks = gRecord.fTracks;
+    EvaluateConditions(fGtuTracks);
+    return kTRUE;
+  }
+
   // GTU information
   UInt_t header = 0x0;
 
@@ -171,11 +209,60 @@ Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event)
     MarkInput(kHEE);
 
   // evaluate TRD GTU tracks
-  const Int_t nStacks = (fJetTriggerMode == kHJTWindowZPhi) ? 360 : 90;
-  Int_t nTracks[360] = { 0 }; // stack-wise counted number of tracks above pt threshold
+  FillGtuTracks(event);
+  EvaluateConditions(fGtuTracks);
+
+  // keep the trigger record for the other consumers of this event
+  if (entry >= 0) {
+    gRecord.fEntry = entry;
+    gRecord.fEvent = event;
+    gRecord.fInputs = fTriggerInputs;
+    gRecord.fClasses = fTriggerClasses;
+    memcpy(gRecord.fContribs, fTriggerContribs, sizeof(fTriggerContribs));
+    gRecord.fTracks = fGtuTracks;
+  }
+
+  return kTRUE;
+}
+
+Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event, const TObjArray *variants)
+{
+  // evaluate the trigger conditions for this configuration
+  // and for all the variants (AliTRDTriggerAnalysis objects with
+  // different requirements and thresholds), reading the GTU tracks
+  // of the event only once
+
+  if (!CalcTriggers(event))
+    return kFALSE;
+
+  if (!variants)
+    return kTRUE;
+
+  for (Int_t iVariant = 0; iVariant < variants->GetEntriesFast(); ++iVariant) {
+    AliTRDTriggerAnalysis *variant = dynamic_cast<AliTRDTriggerAnalysis*> (variants->UncheckedAt(iVariant));
+    if (!variant)
+      continue;
+    variant->ResetTriggers();
+    variant->fTriggerInputs = fTriggerInputs;
+    variant->fTriggerClasses = fTriggerClasses;
+    memcpy(variant->fTriggerContribs, fTriggerContribs, sizeof(fTriggerContribs));
+    variant->EvaluateConditions(fGtuTracks);
+  }
+
+  return kTRUE;
+}
+
+void AliTRDTriggerAnalysis::FillGtuTracks(const AliVEvent *event)
+{
+  // cache the properties of the GTU tracks of the event
+  // which enter the trigger conditions
+
+  fGtuTracks.clear();
 
   Int_t nTrdTracks = event->GetNumberOfTrdTracks();
+  fGtuTracks.reserve(nTrdTracks);
 
+  GtuTrack_t gtuTrack;
   for (Int_t iTrack = 0; iTrack < nTrdTracks; ++iTrack) {
     AliVTrdTrack *trdTrack = event->GetTrdTrack(iTrack);
     if (!trdTrack) {
@@ -183,10 +270,6 @@ Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event)
       continue;
     }
 
-    Int_t globalStack = 5*trdTrack->GetSector() + trdTrack->GetStack();
-
-    MarkCondition(kHCO, globalStack);
-
     for (Int_t iLayer = 0; iLayer < 6; ++iLayer) {
       if (trdTrack->GetLayerMask() & (1 << iLayer)) {
 	AliVTrdTracklet *trkl = trdTrack->GetTracklet(iLayer);
@@ -197,47 +280,78 @@ Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event)
       }
     }
 
-    // ignore the track if it was not in time
-    // (if required)
-    if (fRequireInTime && !trdTrack->GetTrackInTime())
-      continue;
-
     AliVTrack *match = trdTrack->GetTrackMatch();
     AliDebug(2, Form("GTU track %2i with pt = %5.2f has match: %p (pt = %5.2f)",
 		     iTrack, trdTrack->Pt(), match, match ? match->Pt() : 0));
 
+    gtuTrack.fPt = TMath::Abs(trdTrack->Pt());
+    gtuTrack.fPID = trdTrack->GetPID();
+    gtuTrack.fSector = trdTrack->GetSector();
+    gtuTrack.fStack = trdTrack->GetStack();
+    gtuTrack.fNTracklets = trdTrack->GetNTracklets();
+    gtuTrack.fLayerMask = trdTrack->GetLayerMask();
+    gtuTrack.fInTime = trdTrack->GetTrackInTime();
+    gtuTrack.fMatch = (match != 0x0);
+    gtuTrack.fMatchID = match ? match->GetID() : -1;
+    gtuTrack.fWindowIdx = -1;
+
+    // window (in z and phi) of stack size for the jet trigger
+    AliESDTrdTrack *esdTrdTrack = dynamic_cast<AliESDTrdTrack*> (trdTrack);
+    if (esdTrdTrack) {
+      Double_t a = esdTrdTrack->GetA()/128.;
+      Double_t b = esdTrdTrack->GetB()/128.;
+      Double_t c = esdTrdTrack->GetC()/256. / TMath::Tan( -2.0 / 180.0 * TMath::Pi() );
+      Double_t x = 297.759; // L0: 297.759, L1: 309.17
+
+      Double_t ypos = -a + x*b + (a >= 0. ? -0.253 : 0.253);
+      Double_t zpos = c*x + (c >= 0. ? -0.84 : 0.84);
+
+      const Float_t zStackCenter[5] = {241, 117, 0, -117, -241};
+
+      Bool_t upperHalfPhi = ypos >= 0.;
+      Bool_t upperHalfZ = zpos >= zStackCenter[esdTrdTrack->GetStack()];
+
+      gtuTrack.fWindowIdx = 20 * esdTrdTrack->GetSector() + (upperHalfPhi ? 10 : 0) + 2 * esdTrdTrack->GetStack() + (upperHalfZ ? 1 : 0);
+    }
+
+    fGtuTracks.push_back(gtuTrack);
+  }
+}
+
+void AliTRDTriggerAnalysis::EvaluateConditions(const std::vector<GtuTrack_t> &tracks)
+{
+  // evaluate the conditions on the GTU tracks
+  // with the requirements and thresholds of this object
+
+  const Int_t nStacks = (fJetTriggerMode == kHJTWindowZPhi) ? 360 : 90;
+  Int_t nTracks[360] = { 0 }; // stack-wise counted number of tracks above pt threshold
+
+  for (std::vector<GtuTrack_t>::const_iterator trk = tracks.begin(); trk != tracks.end(); ++trk) {
+    Int_t globalStack = 5*trk->fSector + trk->fStack;
+
+    MarkCondition(kHCO, globalStack);
+
+    // ignore the track if it was not in time
+    // (if required)
+    if (fRequireInTime && !trk->fInTime)
+      continue;
+
     // ignore the track if it does not have a matched global track
     // (if required)
-    if (fRequireMatch && !match)
+    if (fRequireMatch && !trk->fMatch)
       continue;
 
     // stack-wise counting of tracks above pt threshold for jet trigger
-    if (TMath::Abs(trdTrack->Pt()) >= fTRDptHJT) {
+    if (trk->fPt >= fTRDptHJT) {
       if (fJetTriggerMode == kHJTDefault)
 	++nTracks[globalStack];
-      else if (fJetTriggerMode == kHJTWindowZPhi) {
-	AliESDTrdTrack *esdTrdTrack = dynamic_cast<AliESDTrdTrack*> (trdTrack);
-	if (esdTrdTrack) {
-	  Double_t a = esdTrdTrack->GetA()/128.;
-	  Double_t b = esdTrdTrack->GetB()/128.;
-	  Double_t c = esdTrdTrack->GetC()/256. / TMath::Tan( -2.0 / 180.0 * TMath::Pi() );
-	  Double_t x = 297.759; // L0: 297.759, L1: 309.17
-
-	  Double_t ypos = -a + x*b + (a >= 0. ? -0.253 : 0.253);
-	  Double_t zpos = c*x + (c >= 0. ? -0.84 : 0.84);
-
-	  const Float_t zStackCenter[5] = {241, 117, 0, -117, -241};
-
-	  Bool_t upperHalfPhi = ypos >= 0.;
-	  Bool_t upperHalfZ = zpos >= zStackCenter[esdTrdTrack->GetStack()];
-
-	  Int_t stackIdx = 20 * esdTrdTrack->GetSector() + (upperHalfPhi ? 10 : 0) + 2 * esdTrdTrack->GetStack() + (upperHalfZ ? 1 : 0);
-	  ++nTracks[stackIdx];
-	  ++nTracks[stackIdx - 10 + (((stackIdx - 10) < 0) ? 360 : 0)];
-	  if ((stackIdx % 10) != 0) {
-	    ++nTracks[stackIdx -  1];
-	    ++nTracks[stackIdx - 11 + (((stackIdx - 11) < 0) ? 360 : 0)];
-	  }
+      else if (fJetTriggerMode == kHJTWindowZPhi && trk->fWindowIdx >= 0) {
+	Int_t stackIdx = trk->fWindowIdx;
+	++nTracks[stackIdx];
+	++nTracks[stackIdx - 10 + (((stackIdx - 10) < 0) ? 360 : 0)];
+	if ((stackIdx % 10) != 0) {
+	  ++nTracks[stackIdx -  1];
+	  ++nTracks[stackIdx - 11 + (((stackIdx - 11) < 0) ? 360 : 0)];
 	}
       }
     }
@@ -245,24 +359,24 @@ Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event)
     // ignore the track for the electron triggers
     // if it does not have a matched global track
     // (if required)
-    if (fRequireMatchElectron && !match)
+    if (fRequireMatchElectron && !trk->fMatch)
       continue;
 
     // ignore the track for the electron triggers
     // if it does not fulfill the tracklet requirement
-    if (trdTrack->GetNTracklets() < fTRDnTrackletsEl)
+    if (trk->fNTracklets < fTRDnTrackletsEl)
       continue;
-    if ((trdTrack->GetLayerMask() & fTRDlayerMaskEl) != fTRDlayerMaskEl)
+    if ((trk->fLayerMask & fTRDlayerMaskEl) != fTRDlayerMaskEl)
       continue;
 
-    if ((TMath::Abs(trdTrack->Pt()) >= fTRDptHQU) && (trdTrack->GetPID() >= fTRDpidHQU))
+    if ((trk->fPt >= fTRDptHQU) && (trk->fPID >= fTRDpidHQU))
       MarkCondition(kHQU, globalStack);
 
-    if ((TMath::Abs(trdTrack->Pt()) >= fTRDptHSE) && (trdTrack->GetPID() >= fTRDpidHSE))
+    if ((trk->fPt >= fTRDptHSE) && (trk->fPID >= fTRDpidHSE))
       MarkCondition(kHSE, globalStack);
 
-    if ((trdTrack->GetSector() >= fTRDminSectorHEE) && (trdTrack->GetSector() <= fTRDmaxSectorHEE) &&
-	(TMath::Abs(trdTrack->Pt()) >= fTRDptHEE) && (trdTrack->GetPID() >= fTRDpidHEE))
+    if ((trk->fSector >= fTRDminSectorHEE) && (trk->fSector <= fTRDmaxSectorHEE) &&
+	(trk->fPt >= fTRDptHEE) && (trk->fPID >= fTRDpidHEE))
       MarkCondition(kHEE, globalStack);
   }
 
@@ -273,6 +387,4 @@ Bool_t AliTRDTriggerAnalysis::CalcTriggers(const AliVEvent *event)
       break;
     }
   }
-
-  return kTRUE;
 }
@@ -11,6 +11,11 @@
 #ifndef ALITRDTRIGGERANALYSIS_H
 #define ALITRDTRIGGERANALYSIS_H
 
+#include <vector>
+
+#include "TObject.h"
+
+class TObjArray;
 class AliVEvent;
 
 class AliTRDTriggerAnalysis : public TObject
@@ -23,8 +28,24 @@ public:
 
   enum JetTriggerMode_t { kHJTDefault = 0, kHJTWindowZPhi };
 
+  // GTU track properties used by the trigger conditions,
+  // cached once per event (and shared by all instances)
+  struct GtuTrack_t {
+    Float_t fPt;            // |pt|
+    UChar_t fPID;           // PID value
+    Char_t  fSector;        // sector
+    Char_t  fStack;         // stack in sector
+    Char_t  fNTracklets;    // no. of tracklets
+    UChar_t fLayerMask;     // layer mask
+    Bool_t  fInTime;        // track in time
+    Bool_t  fMatch;         // matched global track
+    Int_t   fMatchID;       // ID of the matched global track (if fMatch)
+    Short_t fWindowIdx;     // window index for kHJTWindowZPhi (-1 if n/a)
+  };
+
   void ResetTriggers();
   Bool_t CalcTriggers(const AliVEvent* event);
+  Bool_t CalcTriggers(const AliVEvent* event, const TObjArray *variants);
 
   Bool_t IsFired(TRDTrigger_t trg) const {
     Obsolete("IsFired(...) is deprecated, use CheckCondition instead",
@@ -69,7 +90,19 @@ public:
   void SetVerbosity(UChar_t val) { fVerbosity = val; }
   UChar_t GetVerbosity() const { return fVerbosity; }
 
+  void SetElectronTrackletRequirement(UChar_t layerMask, UChar_t nTracklets) { fTRDlayerMaskEl = layerMask; fTRDnTrackletsEl = nTracklets; }
+  void SetThresholdsHSE(Float_t pt, UChar_t pid) { fTRDptHSE = pt; fTRDpidHSE = pid; }
+  void SetThresholdsHQU(Float_t pt, UChar_t pid) { fTRDptHQU = pt; fTRDpidHQU = pid; }
+  void SetThresholdsHEE(Float_t pt, UChar_t pid, UChar_t minSector = 6, UChar_t maxSector = 8)
+  { fTRDptHEE = pt; fTRDpidHEE = pid; fTRDminSectorHEE = minSector; fTRDmaxSectorHEE = maxSector; }
+  void SetThresholdsHJT(Float_t pt, UChar_t n) { fTRDptHJT = pt; fTRDnHJT = n; }
+
+  const std::vector<GtuTrack_t>& GetGtuTracks() const { return fGtuTracks; }
+
 protected:
+  void FillGtuTracks(const AliVEvent *event);
+  void EvaluateConditions(const std::vector<GtuTrack_t> &tracks);
+
   void MarkClass(TRDTrigger_t trg) { fTriggerClasses |= (1 << trg); }
   void MarkInput(TRDTrigger_t trg) { fTriggerInputs |= (1 << trg); }
    void MarkCondition(TRDTrigger_t trg, Int_t stack)
@@ -112,7 +145,9 @@ protected:
 
   UInt_t fTriggerContribs[18]; // temporary for debugging !!!
 
-  ClassDef(AliTRDTriggerAnalysis, 1);
+  std::vector<GtuTrack_t> fGtuTracks; //! GTU tracks of the current event
+
+  ClassDef(AliTRDTriggerAnalysis, 2);
 };
 
 #endif
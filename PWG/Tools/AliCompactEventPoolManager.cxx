@@ -0,0 +1,392 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include <TObjArray.h>
+#include <TClonesArray.h>
+#include <THashList.h>
+
+#include "AliVParticle.h"
+#include "AliBasicParticle.h"
+#include "AliLog.h"
+
+#include "AliCompactEventPoolManager.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCompactEventPool)
+ClassImp(AliCompactEventPoolManager)
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliCompactEventPool::AliCompactEventPool() :
+  TObject(),
+  fMaxNEvents(0),
+  fTargetTrackDepth(0),
+  fTargetFraction(1.),
+  fTargetEvents(0),
+  fNTracks(0),
+  fEvents(),
+  fManager(0x0)
+{
+}
+
+/**
+ * Constructor
+ * \param maxNEvents maximum number of events kept in the pool (no limit if <= 0)
+ * \param targetTrackDepth number of tracks the pool should hold
+ * \param targetFraction fraction of targetTrackDepth needed for the pool to be ready
+ * \param targetEvents number of events needed for the pool to be ready (not used if <= 0)
+ */
+AliCompactEventPool::AliCompactEventPool(Int_t maxNEvents, Int_t targetTrackDepth, Double_t targetFraction, Int_t targetEvents) :
+  TObject(),
+  fMaxNEvents(maxNEvents),
+  fTargetTrackDepth(targetTrackDepth),
+  fTargetFraction(targetFraction),
+  fTargetEvents(targetEvents),
+  fNTracks(0),
+  fEvents(),
+  fManager(0x0)
+{
+}
+
+/**
+ * Removes all the events from the pool
+ */
+void AliCompactEventPool::Clear(Option_t * /*opt*/)
+{
+  if (fManager) fManager->fMemoryUsage -= GetMemoryUsage();
+  fEvents.clear();
+  fNTracks = 0;
+}
+
+/**
+ * Whether the pool holds enough tracks or events for mixing
+ */
+Bool_t AliCompactEventPool::IsReady() const
+{
+  if (fNTracks >= fTargetFraction * fTargetTrackDepth) return kTRUE;
+  if (fTargetEvents > 0 && GetCurrentNEvents() >= fTargetEvents) return kTRUE;
+  return kFALSE;
+}
+
+/**
+ * Memory used by the pooled tracks in bytes
+ */
+Long64_t AliCompactEventPool::GetMemoryUsage() const
+{
+  Long64_t mem = 0;
+  for (std::deque<Event>::const_iterator ev = fEvents.begin(); ev != fEvents.end(); ++ev) {
+    mem += ev->fPt.size() * (3 * sizeof(Float_t) + sizeof(Short_t)) + ev->fID.size() * sizeof(Int_t);
+  }
+  return mem;
+}
+
+/**
+ * Removes the oldest event
+ * \return memory released in bytes
+ */
+Long64_t AliCompactEventPool::RemoveOldestEvent()
+{
+  if (fEvents.empty()) return 0;
+  const Event &ev = fEvents.front();
+  Long64_t mem = ev.fPt.size() * (3 * sizeof(Float_t) + sizeof(Short_t)) + ev.fID.size() * sizeof(Int_t);
+  fNTracks -= ev.fPt.size();
+  fEvents.pop_front();
+  if (fManager) fManager->fMemoryUsage -= mem;
+  return mem;
+}
+
+/**
+ * Applies the rolling-buffer logic of AliEventPool for an incoming event
+ * with nTracks tracks and appends an empty event to be filled
+ */
+AliCompactEventPool::Event &AliCompactEventPool::PrepareNewEvent(Int_t nTracks, Long64_t eventId)
+{
+  Bool_t removeFirstEvent = kFALSE;
+  if (fNTracks > fTargetTrackDepth && !fEvents.empty() &&
+      fNTracks - (Int_t)fEvents.front().fPt.size() + nTracks > fTargetTrackDepth) removeFirstEvent = kTRUE;
+  if (fMaxNEvents > 0 && GetCurrentNEvents() >= fMaxNEvents) removeFirstEvent = kTRUE;
+  if (removeFirstEvent) RemoveOldestEvent();
+
+  fEvents.push_back(Event());
+  Event &ev = fEvents.back();
+  ev.fEventId = eventId;
+  ev.fPt.reserve(nTracks);
+  ev.fEta.reserve(nTracks);
+  ev.fPhi.reserve(nTracks);
+  ev.fCharge.reserve(nTracks);
+  return ev;
+}
+
+/**
+ * Updates the track count and the memory usage of the manager after the newest event was filled
+ */
+void AliCompactEventPool::FinishNewEvent()
+{
+  const Event &ev = fEvents.back();
+  fNTracks += ev.fPt.size();
+  if (fManager) {
+    fManager->fMemoryUsage += ev.fPt.size() * (3 * sizeof(Float_t) + sizeof(Short_t)) + ev.fID.size() * sizeof(Int_t);
+    fManager->EnforceMemoryBudget(this);
+  }
+}
+
+/**
+ * Adds an event to the pool. Only pt, eta, phi and charge of the particles are stored.
+ * If eventId is not negative and is the one of the newest pooled event, the event
+ * is not added again (pools shared by several wagons).
+ * \param tracks array of AliVParticle, not modified
+ * \param eventId identifier of the event (e.g. entry number), -1 if not used
+ * \return number of events in the pool
+ */
+Int_t AliCompactEventPool::UpdatePool(const TObjArray *tracks, Long64_t eventId)
+{
+  if (!tracks) return GetCurrentNEvents();
+  if (eventId >= 0 && !fEvents.empty() && fEvents.back().fEventId == eventId) return GetCurrentNEvents();
+
+  Int_t nTracks = tracks->GetEntriesFast();
+  Event &ev = PrepareNewEvent(nTracks, eventId);
+  for (Int_t i = 0; i < nTracks; i++) {
+    AliVParticle *part = static_cast<AliVParticle*>(tracks->UncheckedAt(i));
+    if (!part) continue;
+    ev.fPt.push_back(part->Pt());
+    ev.fEta.push_back(part->Eta());
+    ev.fPhi.push_back(part->Phi());
+    ev.fCharge.push_back(part->Charge());
+  }
+  FinishNewEvent();
+  return GetCurrentNEvents();
+}
+
+/**
+ * Adds an event given as arrays of nTracks entries
+ * \param id track IDs, not stored if 0x0
+ * \param eventId identifier of the event, see UpdatePool(const TObjArray*, Long64_t)
+ * \return number of events in the pool
+ */
+Int_t AliCompactEventPool::UpdatePool(Int_t nTracks, const Float_t *pt, const Float_t *eta, const Float_t *phi,
+                                      const Short_t *charge, const Int_t *id, Long64_t eventId)
+{
+  if (eventId >= 0 && !fEvents.empty() && fEvents.back().fEventId == eventId) return GetCurrentNEvents();
+
+  Event &ev = PrepareNewEvent(nTracks, eventId);
+  if (nTracks > 0) {
+    ev.fPt.assign(pt, pt + nTracks);
+    ev.fEta.assign(eta, eta + nTracks);
+    ev.fPhi.assign(phi, phi + nTracks);
+    ev.fCharge.assign(charge, charge + nTracks);
+    if (id) ev.fID.assign(id, id + nTracks);
+  }
+  FinishNewEvent();
+  return GetCurrentNEvents();
+}
+
+/**
+ * Fills particles with AliBasicParticle objects for the tracks of event iEv,
+ * for code written for the TObjArray returned by AliEventPool::GetEvent
+ * \return number of particles
+ */
+Int_t AliCompactEventPool::FillEvent(Int_t iEv, TClonesArray &particles) const
+{
+  particles.Clear();
+  const Event &ev = fEvents.at(iEv);
+  Int_t nTracks = ev.fPt.size();
+  for (Int_t i = 0; i < nTracks; i++) {
+    new (particles[i]) AliBasicParticle(ev.fEta[i], ev.fPhi[i], ev.fPt[i], ev.fCharge[i]);
+  }
+  return nTracks;
+}
+
+/**
+ * Prints the content of the pool
+ */
+void AliCompactEventPool::PrintInfo() const
+{
+  Printf("AliCompactEventPool: %d events, %d tracks (target %d, fraction %.2f, max %d events), %lld bytes, ready: %d",
+         GetCurrentNEvents(), fNTracks, fTargetTrackDepth, fTargetFraction, fMaxNEvents, GetMemoryUsage(), IsReady());
+}
+
+/**
+ * Default constructor
+ */
+AliCompactEventPoolManager::AliCompactEventPoolManager() :
+  TNamed(),
+  fCentBins(),
+  fZvtxBins(),
+  fPsiBins(),
+  fPools(),
+  fMaxMemory(0),
+  fMemoryUsage(0)
+{
+}
+
+/**
+ * Constructor, same binning as AliEventPoolManager
+ * \param maxNEvents maximum number of events per pool
+ * \param targetTrackDepth number of tracks each pool should hold
+ * \param nCentBins number of centrality bins, centBins has nCentBins+1 edges
+ * \param nZvtxBins number of z vertex bins, zvtxBins has nZvtxBins+1 edges
+ * \param nPsiBins number of event plane bins (no event plane binning if 0)
+ */
+AliCompactEventPoolManager::AliCompactEventPoolManager(Int_t maxNEvents, Int_t targetTrackDepth,
+                                                       Int_t nCentBins, const Double_t *centBins,
+                                                       Int_t nZvtxBins, const Double_t *zvtxBins,
+                                                       Int_t nPsiBins, const Double_t *psiBins) :
+  TNamed("AliCompactEventPoolManager", "AliCompactEventPoolManager"),
+  fCentBins(centBins, centBins + nCentBins + 1),
+  fZvtxBins(zvtxBins, zvtxBins + nZvtxBins + 1),
+  fPsiBins(),
+  fPools(),
+  fMaxMemory(0),
+  fMemoryUsage(0)
+{
+  if (nPsiBins > 0 && psiBins) fPsiBins.assign(psiBins, psiBins + nPsiBins + 1);
+
+  Int_t nPools = nCentBins * nZvtxBins * GetNumberOfPsiBins();
+  fPools.reserve(nPools);
+  for (Int_t i = 0; i < nPools; i++) {
+    AliCompactEventPool *pool = new AliCompactEventPool(maxNEvents, targetTrackDepth);
+    pool->fManager = this;
+    fPools.push_back(pool);
+  }
+}
+
+/**
+ * Destructor
+ */
+AliCompactEventPoolManager::~AliCompactEventPoolManager()
+{
+  for (std::vector<AliCompactEventPool*>::iterator it = fPools.begin(); it != fPools.end(); ++it) delete *it;
+}
+
+/**
+ * Returns the manager registered with the given name, creating it at the first call.
+ * The shared managers are owned by the registry and must not be deleted by the tasks.
+ * If a manager with this name exists with a different binning, a private manager is
+ * created and a warning is printed; it is then owned by the caller.
+ */
+AliCompactEventPoolManager *AliCompactEventPoolManager::GetSharedManager(const char *name, Int_t maxNEvents, Int_t targetTrackDepth,
+                                                                         Int_t nCentBins, const Double_t *centBins,
+                                                                         Int_t nZvtxBins, const Double_t *zvtxBins,
+                                                                         Int_t nPsiBins, const Double_t *psiBins)
+{
+  static THashList registry;
+
+  AliCompactEventPoolManager *mgr = static_cast<AliCompactEventPoolManager*>(registry.FindObject(name));
+  if (mgr) {
+    if (mgr->HasSameBinning(nCentBins, centBins, nZvtxBins, zvtxBins, nPsiBins, psiBins)) return mgr;
+    AliWarningGeneral("AliCompactEventPoolManager", Form("Shared pool manager %s exists with another binning, creating a private one", name));
+    mgr = new AliCompactEventPoolManager(maxNEvents, targetTrackDepth, nCentBins, centBins, nZvtxBins, zvtxBins, nPsiBins, psiBins);
+    mgr->SetName(name);
+    return mgr;
+  }
+
+  mgr = new AliCompactEventPoolManager(maxNEvents, targetTrackDepth, nCentBins, centBins, nZvtxBins, zvtxBins, nPsiBins, psiBins);
+  mgr->SetName(name);
+  registry.Add(mgr);
+  return mgr;
+}
+
+/**
+ * Whether the manager has exactly the given binning
+ */
+Bool_t AliCompactEventPoolManager::HasSameBinning(Int_t nCentBins, const Double_t *centBins, Int_t nZvtxBins, const Double_t *zvtxBins,
+                                                  Int_t nPsiBins, const Double_t *psiBins) const
+{
+  if (nCentBins != GetNumberOfCentBins() || nZvtxBins != GetNumberOfZvtxBins()) return kFALSE;
+  if ((nPsiBins > 0 && psiBins) ? nPsiBins != (Int_t)fPsiBins.size() - 1 : !fPsiBins.empty()) return kFALSE;
+  if (!std::equal(fCentBins.begin(), fCentBins.end(), centBins)) return kFALSE;
+  if (!std::equal(fZvtxBins.begin(), fZvtxBins.end(), zvtxBins)) return kFALSE;
+  if (!fPsiBins.empty() && !std::equal(fPsiBins.begin(), fPsiBins.end(), psiBins)) return kFALSE;
+  return kTRUE;
+}
+
+/**
+ * Bin of val for the given edges: lower edges included, last upper edge included
+ * \return -1 if val is outside the edges
+ */
+Int_t AliCompactEventPoolManager::FindBin(const std::vector<Double_t> &edges, Double_t val)
+{
+  Int_t nBins = edges.size() - 1;
+  if (nBins < 1 || val < edges[0] || val > edges[nBins]) return -1;
+  if (val == edges[nBins]) return nBins - 1;
+  for (Int_t i = 0; i < nBins; i++) {
+    if (val < edges[i + 1]) return i;
+  }
+  return -1;
+}
+
+/**
+ * Pool of the given bin indices, 0x0 if out of range
+ */
+AliCompactEventPool *AliCompactEventPoolManager::GetEventPool(Int_t iCent, Int_t iZvtx, Int_t iPsi) const
+{
+  if (iCent < 0 || iCent >= GetNumberOfCentBins()) return 0x0;
+  if (iZvtx < 0 || iZvtx >= GetNumberOfZvtxBins()) return 0x0;
+  if (iPsi < 0 || iPsi >= GetNumberOfPsiBins()) return 0x0;
+  return fPools[iCent + GetNumberOfCentBins() * (iZvtx + GetNumberOfZvtxBins() * iPsi)];
+}
+
+/**
+ * Pool of the given centrality, z vertex and event plane values, 0x0 if out of range
+ */
+AliCompactEventPool *AliCompactEventPoolManager::GetEventPool(Double_t centVal, Double_t zVtxVal, Double_t psiVal) const
+{
+  Int_t iCent = FindBin(fCentBins, centVal);
+  Int_t iZvtx = FindBin(fZvtxBins, zVtxVal);
+  Int_t iPsi = fPsiBins.empty() ? 0 : FindBin(fPsiBins, psiVal);
+  return GetEventPool(iCent, iZvtx, iPsi);
+}
+
+/**
+ * Sets the target track depth, ready fraction and ready number of events of all the pools
+ */
+void AliCompactEventPoolManager::SetTargetValues(Int_t trackDepth, Double_t fraction, Int_t nEvents)
+{
+  for (std::vector<AliCompactEventPool*>::iterator it = fPools.begin(); it != fPools.end(); ++it) {
+    (*it)->SetTargetTrackDepth(trackDepth, fraction);
+    (*it)->SetTargetEvents(nEvents);
+  }
+}
+
+/**
+ * Removes all the events from all the pools
+ */
+void AliCompactEventPoolManager::ClearPools()
+{
+  for (std::vector<AliCompactEventPool*>::iterator it = fPools.begin(); it != fPools.end(); ++it) (*it)->Clear();
+  fMemoryUsage = 0;
+}
+
+/**
+ * Removes the oldest events of the pools with most tracks until the memory usage fits
+ * the budget. The newest event of the pool just updated is never removed.
+ */
+void AliCompactEventPoolManager::EnforceMemoryBudget(const AliCompactEventPool *updated)
+{
+  if (fMaxMemory <= 0) return;
+  while (fMemoryUsage > fMaxMemory) {
+    AliCompactEventPool *largest = 0x0;
+    for (std::vector<AliCompactEventPool*>::iterator it = fPools.begin(); it != fPools.end(); ++it) {
+      Int_t minEvents = (*it == updated) ? 2 : 1;
+      if ((*it)->GetCurrentNEvents() < minEvents) continue;
+      if (!largest || (*it)->NTracksInPool() > largest->NTracksInPool()) largest = *it;
+    }
+    if (!largest) break;
+    largest->RemoveOldestEvent();
+  }
+}
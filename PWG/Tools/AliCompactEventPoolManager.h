@@ -0,0 +1,162 @@
+#ifndef ALICOMPACTEVENTPOOLMANAGER_H
+#define ALICOMPACTEVENTPOOLMANAGER_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <deque>
+#include <TObject.h>
+#include <TNamed.h>
+
+class TObjArray;
+class TClonesArray;
+class AliCompactEventPoolManager;
+
+/**
+ * \class AliCompactEventPool
+ * \brief Mixed-event pool storing the tracks of each event as typed arrays
+ *
+ * Drop-in counterpart of AliEventPool for the tracks stored by most correlation tasks
+ * (pt, eta, phi, charge and an optional integer ID). Each pooled event keeps one
+ * contiguous array per variable instead of a cloned TObjArray of particle objects:
+ *
+ * ~~~{.cxx}
+ * for (Int_t iEv = 0; iEv < pool->GetCurrentNEvents(); iEv++) {
+ *   const Float_t *phi = pool->GetPhi(iEv), *eta = pool->GetEta(iEv);
+ *   for (Int_t i = 0; i < pool->GetNTracksInEvent(iEv); i++) { ... }
+ * }
+ * ~~~
+ *
+ * The rolling-buffer logic is the one of AliEventPool: the oldest event is dropped when
+ * the pool would stay above the target track depth without it, or when the pool holds
+ * the maximum number of events. The pool is ready when it holds fTargetFraction times
+ * the target track depth, or the target number of events.
+ *
+ * All the read methods are const and do not modify the pool, so several threads can
+ * read the same pool concurrently. UpdatePool must not run concurrently with any other
+ * call on the same manager.
+ */
+class AliCompactEventPool : public TObject {
+public:
+  AliCompactEventPool();
+  AliCompactEventPool(Int_t maxNEvents, Int_t targetTrackDepth, Double_t targetFraction = 1., Int_t targetEvents = 0);
+  virtual ~AliCompactEventPool() {}
+
+  Int_t   UpdatePool(const TObjArray *tracks, Long64_t eventId = -1);
+  Int_t   UpdatePool(Int_t nTracks, const Float_t *pt, const Float_t *eta, const Float_t *phi,
+                     const Short_t *charge, const Int_t *id = 0x0, Long64_t eventId = -1);
+  void    Clear(Option_t *opt = "");
+  void    SetTargetTrackDepth(Int_t depth, Double_t fraction = 1.) { fTargetTrackDepth = depth; fTargetFraction = fraction; }
+  void    SetTargetEvents(Int_t nEvents) { fTargetEvents = nEvents; }
+
+  Bool_t  IsReady()                        const;
+  Int_t   GetCurrentNEvents()              const { return (Int_t)fEvents.size(); }
+  Int_t   NTracksInPool()                  const { return fNTracks; }
+  Int_t   GetNTracksInEvent(Int_t iEv)     const { return (Int_t)fEvents.at(iEv).fPt.size(); }
+  Long64_t GetEventId(Int_t iEv)           const { return fEvents.at(iEv).fEventId; }
+  const Float_t *GetPt(Int_t iEv)          const { return Column(fEvents.at(iEv).fPt); }
+  const Float_t *GetEta(Int_t iEv)         const { return Column(fEvents.at(iEv).fEta); }
+  const Float_t *GetPhi(Int_t iEv)         const { return Column(fEvents.at(iEv).fPhi); }
+  const Short_t *GetCharge(Int_t iEv)      const { return fEvents.at(iEv).fCharge.empty() ? 0x0 : &fEvents.at(iEv).fCharge[0]; }
+  const Int_t   *GetID(Int_t iEv)          const { return fEvents.at(iEv).fID.empty() ? 0x0 : &fEvents.at(iEv).fID[0]; }
+  Int_t   FillEvent(Int_t iEv, TClonesArray &particles) const;
+  Long64_t GetMemoryUsage()                const;
+
+  void    PrintInfo() const;
+
+  /// One pooled event: one array per variable, fID empty if no ID was given
+  struct Event {
+    Event() : fEventId(-1), fPt(), fEta(), fPhi(), fCharge(), fID() {}
+    Long64_t             fEventId;
+    std::vector<Float_t> fPt;
+    std::vector<Float_t> fEta;
+    std::vector<Float_t> fPhi;
+    std::vector<Short_t> fCharge;
+    std::vector<Int_t>   fID;
+  };
+
+private:
+  friend class AliCompactEventPoolManager;
+
+  static const Float_t *Column(const std::vector<Float_t> &col) { return col.empty() ? 0x0 : &col[0]; }
+  Event  &PrepareNewEvent(Int_t nTracks, Long64_t eventId);
+  void    FinishNewEvent();
+  Long64_t RemoveOldestEvent();
+
+  Int_t    fMaxNEvents;           ///< maximum number of events (no limit if <= 0)
+  Int_t    fTargetTrackDepth;     ///< number of tracks the pool should hold
+  Double_t fTargetFraction;       ///< fraction of fTargetTrackDepth needed to be ready
+  Int_t    fTargetEvents;         ///< number of events needed to be ready (not used if <= 0)
+  Int_t    fNTracks;              ///< number of tracks in the pool
+  std::deque<Event> fEvents;      //!<! pooled events, oldest first
+  AliCompactEventPoolManager *fManager; //!<! manager enforcing the memory budget
+
+  ClassDef(AliCompactEventPool, 1);
+};
+
+/**
+ * \class AliCompactEventPoolManager
+ * \brief Pool manager with the binning interface of AliEventPoolManager and AliCompactEventPool pools
+ *
+ * ~~~{.cxx}
+ * fPoolMgr = new AliCompactEventPoolManager(poolsize, trackDepth, nCentBins, centBins, nZvtxBins, zvtxBins);
+ * fPoolMgr->SetMaxMemory(500*1024*1024); // optional total budget in bytes
+ * ...
+ * AliCompactEventPool *pool = fPoolMgr->GetEventPool(centrality, zVtx);
+ * ~~~
+ *
+ * With a memory budget, after each update the oldest events of the fullest pools are
+ * removed until the total size of the pooled tracks fits the budget.
+ *
+ * Wagons with identical binning and identical track selection can share the pools
+ * with GetSharedManager(): the manager is created by the first wagon and returned to
+ * the others, and UpdatePool with the same eventId is done only once per pool.
+ */
+class AliCompactEventPoolManager : public TNamed {
+public:
+  AliCompactEventPoolManager();
+  AliCompactEventPoolManager(Int_t maxNEvents, Int_t targetTrackDepth, Int_t nCentBins, const Double_t *centBins,
+                             Int_t nZvtxBins, const Double_t *zvtxBins, Int_t nPsiBins = 0, const Double_t *psiBins = 0x0);
+  virtual ~AliCompactEventPoolManager();
+
+  static AliCompactEventPoolManager *GetSharedManager(const char *name, Int_t maxNEvents, Int_t targetTrackDepth,
+                                                      Int_t nCentBins, const Double_t *centBins,
+                                                      Int_t nZvtxBins, const Double_t *zvtxBins,
+                                                      Int_t nPsiBins = 0, const Double_t *psiBins = 0x0);
+
+  AliCompactEventPool *GetEventPool(Int_t iCent, Int_t iZvtx, Int_t iPsi = 0) const;
+  AliCompactEventPool *GetEventPool(Double_t centVal, Double_t zVtxVal, Double_t psiVal = 0.) const;
+  Int_t   GetNumberOfCentBins() const { return (Int_t)fCentBins.size() - 1; }
+  Int_t   GetNumberOfZvtxBins() const { return (Int_t)fZvtxBins.size() - 1; }
+  Int_t   GetNumberOfPsiBins()  const { return fPsiBins.empty() ? 1 : (Int_t)fPsiBins.size() - 1; }
+  Int_t   GetNumberOfAllBins()  const { return (Int_t)fPools.size(); }
+
+  void    SetTargetValues(Int_t trackDepth, Double_t fraction, Int_t nEvents);
+  void    SetMaxMemory(Long64_t bytes) { fMaxMemory = bytes; }
+  Long64_t GetMaxMemory()       const { return fMaxMemory; }
+  Long64_t GetMemoryUsage()     const { return fMemoryUsage; }
+  void    ClearPools();
+
+  Bool_t  HasSameBinning(Int_t nCentBins, const Double_t *centBins, Int_t nZvtxBins, const Double_t *zvtxBins,
+                         Int_t nPsiBins, const Double_t *psiBins) const;
+
+private:
+  friend class AliCompactEventPool;
+
+  AliCompactEventPoolManager(const AliCompactEventPoolManager &);
+  AliCompactEventPoolManager &operator=(const AliCompactEventPoolManager &);
+
+  static Int_t FindBin(const std::vector<Double_t> &edges, Double_t val);
+  void    EnforceMemoryBudget(const AliCompactEventPool *updated);
+
+  std::vector<Double_t> fCentBins;    ///< centrality/multiplicity bin edges
+  std::vector<Double_t> fZvtxBins;    ///< z vertex bin edges
+  std::vector<Double_t> fPsiBins;     ///< event plane bin edges (empty: no binning)
+  std::vector<AliCompactEventPool*> fPools; //!<! pools, index iCent + nCent*(iZvtx + nZvtx*iPsi)
+  Long64_t fMaxMemory;                ///< memory budget for the pooled tracks in bytes (no limit if <= 0)
+  Long64_t fMemoryUsage;              //!<! memory used by the pooled tracks in bytes
+
+  ClassDef(AliCompactEventPoolManager, 1);
+};
+
+#endif
@@ -0,0 +1,100 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <TMath.h>
+
+#include "AliAnalysisManager.h"
+#include "AliGenPythiaEventHeader.h"
+
+#include "AliMCHeaderCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliMCHeaderCache)
+/// \endcond
+
+AliMCHeaderCache *AliMCHeaderCache::fgInstance = 0x0;
+
+/**
+ * Default constructor
+ */
+AliMCHeaderCache::AliMCHeaderCache() :
+  TObject(),
+  fHeader(0x0),
+  fEntry(-1),
+  fLeadingJetPt(0),
+  fLeadingJet(-1)
+{
+}
+
+/**
+ * Get the instance used by the static helpers, created at the first call
+ * @return Cache instance
+ */
+AliMCHeaderCache *AliMCHeaderCache::Instance()
+{
+  if(!fgInstance) fgInstance = new AliMCHeaderCache;
+  return fgInstance;
+}
+
+/**
+ * pt of the leading PYTHIA trigger jet of the event
+ * @param header PYTHIA event header
+ * @return Leading trigger jet pt, 0 if the header has no trigger jets
+ */
+Float_t AliMCHeaderCache::LeadingTriggerJetPt(const AliGenPythiaEventHeader *header)
+{
+  Update(header);
+  return fLeadingJetPt;
+}
+
+/**
+ * Index of the leading PYTHIA trigger jet of the event
+ * @param header PYTHIA event header
+ * @return Index of the leading trigger jet in the header, -1 if the header has no trigger jets
+ */
+Int_t AliMCHeaderCache::LeadingTriggerJetIndex(const AliGenPythiaEventHeader *header)
+{
+  Update(header);
+  return fLeadingJet;
+}
+
+/**
+ * Walk the trigger jets of the header, unless the values of this header
+ * and event of the analysis manager are already cached
+ * @param header PYTHIA event header
+ */
+void AliMCHeaderCache::Update(const AliGenPythiaEventHeader *header)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if(header && header == fHeader && entry >= 0 && entry == fEntry) return;
+
+  fHeader = header;
+  fEntry = entry;
+  fLeadingJetPt = 0;
+  fLeadingJet = -1;
+  if(!header) return;
+
+  // TriggerJet() is not const
+  AliGenPythiaEventHeader *pythiaHeader = const_cast<AliGenPythiaEventHeader*>(header);
+  Float_t tmpjet[] = {0, 0, 0, 0};
+  for(Int_t ijet = 0; ijet < pythiaHeader->NTriggerJets(); ijet++) {
+    pythiaHeader->TriggerJet(ijet, tmpjet);
+    Float_t pt = TMath::Sqrt(tmpjet[0]*tmpjet[0] + tmpjet[1]*tmpjet[1]);
+    if(fLeadingJet < 0 || pt > fLeadingJetPt) {
+      fLeadingJetPt = pt;
+      fLeadingJet = ijet;
+    }
+  }
+}
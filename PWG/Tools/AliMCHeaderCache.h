@@ -0,0 +1,56 @@
+#ifndef ALIMCHEADERCACHE_H
+#define ALIMCHEADERCACHE_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <TObject.h>
+
+class AliGenPythiaEventHeader;
+
+/**
+ * \class AliMCHeaderCache
+ * \brief Event-scoped summary of the PYTHIA event header for the pt-hard outlier rejection
+ *
+ * In pt-hard binned productions the jet (AliAnalysisTaskEmcal) and calorimeter
+ * (AliCaloTrackReader) frameworks reject outlier events by comparing the PYTHIA trigger
+ * jets with the pt-hard of the event, once per wagon. The static helpers of this class
+ * walk the trigger jet array of the header once per event and return the cached result:
+ *
+ * ~~~{.cxx}
+ * if (AliMCHeaderCache::GetLeadingTriggerJetPt(pythiaHeader) > factor * pythiaHeader->GetPtHard()) reject = kTRUE;
+ * ~~~
+ *
+ * The cache is cleared automatically when the analysis manager moves to a new event or
+ * when another header is passed. Outside of the analysis manager the values are computed
+ * at each request.
+ */
+class AliMCHeaderCache : public TObject {
+public:
+  AliMCHeaderCache();
+  virtual ~AliMCHeaderCache() {}
+
+  static AliMCHeaderCache *Instance();
+
+  static Float_t GetLeadingTriggerJetPt(const AliGenPythiaEventHeader *header) { return Instance()->LeadingTriggerJetPt(header); }
+  static Int_t   GetLeadingTriggerJetIndex(const AliGenPythiaEventHeader *header) { return Instance()->LeadingTriggerJetIndex(header); }
+
+  Float_t LeadingTriggerJetPt(const AliGenPythiaEventHeader *header);
+  Int_t   LeadingTriggerJetIndex(const AliGenPythiaEventHeader *header);
+
+private:
+  AliMCHeaderCache(const AliMCHeaderCache&);             // not implemented
+  AliMCHeaderCache& operator=(const AliMCHeaderCache&);  // not implemented
+
+  void    Update(const AliGenPythiaEventHeader *header);
+
+  const AliGenPythiaEventHeader *fHeader;        //!<! Header of the cached values
+  Long64_t                       fEntry;         //!<! Entry of the analysis manager of the cached values, -1 if not cached
+  Float_t                        fLeadingJetPt;  //!<! pt of the leading trigger jet, 0 if there is none
+  Int_t                          fLeadingJet;    //!<! Index of the leading trigger jet, -1 if there is none
+
+  static AliMCHeaderCache       *fgInstance;     //!<! Instance used by the static helpers
+
+  ClassDef(AliMCHeaderCache, 1);
+};
+
+#endif /* ALIMCHEADERCACHE_H */
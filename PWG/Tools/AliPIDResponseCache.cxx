@@ -0,0 +1,194 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include "AliAnalysisManager.h"
+#include "AliVEventHandler.h"
+#include "AliVEvent.h"
+#include "AliVParticle.h"
+
+#include "AliPIDResponseCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliPIDResponseCache)
+/// \endcond
+
+AliPIDResponseCache *AliPIDResponseCache::fgInstance = 0x0;
+
+/**
+ * Default constructor
+ */
+AliPIDResponseCache::AliPIDResponseCache() :
+  TObject(),
+  fEnabled(kTRUE),
+  fBulkFill(kFALSE),
+  fEvent(0x0),
+  fEntry(-1),
+  fResponse(0x0),
+  fNTracks(-1),
+  fTrackIndex(),
+  fNSigma(),
+  fFilled()
+{
+  for(Int_t idet = 0; idet < kNDetectors; idet++) fBulkFilled[idet] = kFALSE;
+}
+
+/**
+ * Get the instance used by the static helpers, created at the first call
+ * @return Cache instance
+ */
+AliPIDResponseCache *AliPIDResponseCache::Instance()
+{
+  if(!fgInstance) fgInstance = new AliPIDResponseCache;
+  return fgInstance;
+}
+
+/**
+ * Cached nsigma for the detector enumeration of AliPIDResponse. Detectors other
+ * than ITS, TPC and TOF are passed to the PID response.
+ * @param pid PID response
+ * @param det Detector
+ * @param track Track
+ * @param type Particle species
+ * @return Number of sigmas
+ */
+Float_t AliPIDResponseCache::NumberOfSigmas(const AliPIDResponse *pid, AliPIDResponse::EDetector det, const AliVParticle *track, AliPID::EParticleType type)
+{
+  switch(det) {
+    case AliPIDResponse::kITS: return Instance()->GetNumberOfSigmas(pid, kITS, track, type);
+    case AliPIDResponse::kTPC: return Instance()->GetNumberOfSigmas(pid, kTPC, track, type);
+    case AliPIDResponse::kTOF: return Instance()->GetNumberOfSigmas(pid, kTOF, track, type);
+    default: break;
+  }
+  return pid ? pid->NumberOfSigmas(det, track, type) : -999.;
+}
+
+/**
+ * Get the nsigma from the cache, compute and cache it if not yet available
+ * @param pid PID response
+ * @param det Detector
+ * @param track Track
+ * @param type Particle species
+ * @return Number of sigmas
+ */
+Float_t AliPIDResponseCache::GetNumberOfSigmas(const AliPIDResponse *pid, EDetector det, const AliVParticle *track, AliPID::EParticleType type)
+{
+  if(!fEnabled || !pid || !track || type < 0 || type >= AliPID::kSPECIESC) return Compute(pid, det, track, type);
+
+  CheckEvent();
+  if(!fEvent) return Compute(pid, det, track, type);
+  if(!fResponse) fResponse = pid;
+  else if(fResponse != pid) return Compute(pid, det, track, type);
+
+  Int_t itrack = GetTrackIndex(track);
+  if(itrack < 0) return Compute(pid, det, track, type);
+
+  if(fBulkFill && !fBulkFilled[det]) BulkFill(det);
+
+  Int_t iflag = itrack * kNDetectors + det;
+  Int_t ivalue = iflag * AliPID::kSPECIESC + type;
+  if(!(fFilled[iflag] & (1 << type))) {
+    fNSigma[ivalue] = Compute(pid, det, track, type);
+    fFilled[iflag] |= (1 << type);
+  }
+  return fNSigma[ivalue];
+}
+
+/**
+ * Set the event of the cached values, the cache is cleared. Called automatically
+ * for each new event of the analysis manager.
+ * @param event Event, 0 to disable the cache until the next event
+ * @param entry Entry of the event in the analysis manager
+ */
+void AliPIDResponseCache::SetEvent(const AliVEvent *event, Long64_t entry)
+{
+  fEvent = event;
+  fEntry = entry;
+  fResponse = 0x0;
+  fNTracks = -1;
+  fTrackIndex.Delete();
+  fFilled.clear();
+  for(Int_t idet = 0; idet < kNDetectors; idet++) fBulkFilled[idet] = kFALSE;
+}
+
+/**
+ * Clear the cache if the analysis manager moved to a new event
+ */
+void AliPIDResponseCache::CheckEvent()
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if(!mgr || !mgr->GetInputEventHandler()) return;
+  const AliVEvent *event = mgr->GetInputEventHandler()->GetEvent();
+  Long64_t entry = mgr->GetCurrentEntry();
+  if(event != fEvent || entry != fEntry) SetEvent(event, entry);
+}
+
+/**
+ * Index of the track in the input event. The index is built at the first request
+ * of the event from the track pointers of the event.
+ * @param track Track
+ * @return Index of the track, -1 if the track is not a track of the input event
+ */
+Int_t AliPIDResponseCache::GetTrackIndex(const AliVParticle *track)
+{
+  if(fNTracks < 0) {
+    fNTracks = fEvent->GetNumberOfTracks();
+    for(Int_t itrack = 0; itrack < fNTracks; itrack++) {
+      const AliVParticle *eventTrack = fEvent->GetTrack(itrack);
+      if(eventTrack) fTrackIndex.Add((Long64_t)(ULong_t)eventTrack, itrack + 1);
+    }
+    fNSigma.resize(fNTracks * kNDetectors * AliPID::kSPECIESC);
+    fFilled.assign(fNTracks * kNDetectors, 0);
+  }
+  return (Int_t)fTrackIndex.GetValue((Long64_t)(ULong_t)track) - 1;
+}
+
+/**
+ * Compute all species of all tracks of the event for a detector
+ * @param det Detector
+ */
+void AliPIDResponseCache::BulkFill(EDetector det)
+{
+  const UShort_t allSpecies = (1 << AliPID::kSPECIESC) - 1;
+  for(Int_t itrack = 0; itrack < fNTracks; itrack++) {
+    const AliVParticle *track = fEvent->GetTrack(itrack);
+    if(!track) continue;
+    Int_t iflag = itrack * kNDetectors + det;
+    for(Int_t ispecies = 0; ispecies < AliPID::kSPECIESC; ispecies++) {
+      if(fFilled[iflag] & (1 << ispecies)) continue;
+      fNSigma[iflag * AliPID::kSPECIESC + ispecies] = Compute(fResponse, det, track, (AliPID::EParticleType)ispecies);
+    }
+    fFilled[iflag] = allSpecies;
+  }
+  fBulkFilled[det] = kTRUE;
+}
+
+/**
+ * Ask the PID response
+ * @param pid PID response
+ * @param det Detector
+ * @param track Track
+ * @param type Particle species
+ * @return Number of sigmas
+ */
+Float_t AliPIDResponseCache::Compute(const AliPIDResponse *pid, EDetector det, const AliVParticle *track, AliPID::EParticleType type)
+{
+  if(!pid) return -999.;
+  switch(det) {
+    case kITS: return pid->NumberOfSigmasITS(track, type);
+    case kTPC: return pid->NumberOfSigmasTPC(track, type);
+    case kTOF: return pid->NumberOfSigmasTOF(track, type);
+    default: break;
+  }
+  return -999.;
+}
@@ -0,0 +1,88 @@
+#ifndef ALIPIDRESPONSECACHE_H
+#define ALIPIDRESPONSECACHE_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <TObject.h>
+#include <TExMap.h>
+
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+
+class AliVEvent;
+class AliVParticle;
+
+/**
+ * \class AliPIDResponseCache
+ * \brief Event-scoped cache of the ITS, TPC and TOF nsigma values of AliPIDResponse
+ *
+ * The PID cut objects of the different analysis trains (dielectron, HF, resonances, HFE,
+ * flow) ask the PID response for the same nsigma of the same track many times per event.
+ * The static helpers of this class return the cached value, computed at the first request,
+ * keyed by (track index in the input event, detector, species):
+ *
+ * ~~~{.cxx}
+ * Float_t nsigma = AliPIDResponseCache::NumberOfSigmasTPC(pidResponse, track, AliPID::kElectron);
+ * ~~~
+ *
+ * The cache is cleared automatically when the analysis manager moves to a new event. Outside
+ * of the analysis manager SetEvent() has to be called for each event, otherwise nothing is cached.
+ * Only tracks of the input event are cached, other tracks (e.g. copies, tracks of mixed events)
+ * and requests for another PID response object than the first one of the event are passed
+ * to the PID response directly.
+ *
+ * With SetBulkFill() all species of all tracks are computed at the first request for a detector.
+ */
+class AliPIDResponseCache : public TObject {
+public:
+  enum EDetector { kITS = 0, kTPC, kTOF, kNDetectors };
+
+  AliPIDResponseCache();
+  virtual ~AliPIDResponseCache() {}
+
+  static AliPIDResponseCache *Instance();
+
+  static Float_t NumberOfSigmasITS(const AliPIDResponse *pid, const AliVParticle *track, AliPID::EParticleType type)
+    { return Instance()->GetNumberOfSigmas(pid, kITS, track, type); }
+  static Float_t NumberOfSigmasTPC(const AliPIDResponse *pid, const AliVParticle *track, AliPID::EParticleType type)
+    { return Instance()->GetNumberOfSigmas(pid, kTPC, track, type); }
+  static Float_t NumberOfSigmasTOF(const AliPIDResponse *pid, const AliVParticle *track, AliPID::EParticleType type)
+    { return Instance()->GetNumberOfSigmas(pid, kTOF, track, type); }
+  static Float_t NumberOfSigmas(const AliPIDResponse *pid, AliPIDResponse::EDetector det, const AliVParticle *track, AliPID::EParticleType type);
+
+  Float_t GetNumberOfSigmas(const AliPIDResponse *pid, EDetector det, const AliVParticle *track, AliPID::EParticleType type);
+
+  void    SetEvent(const AliVEvent *event, Long64_t entry = -1);
+  void    Reset() { SetEvent(0x0); }
+  void    SetEnabled(Bool_t enabled = kTRUE) { fEnabled = enabled; }
+  void    SetBulkFill(Bool_t bulk = kTRUE)   { fBulkFill = bulk; }
+  Bool_t  IsEnabled()                  const { return fEnabled; }
+  Bool_t  GetBulkFill()                const { return fBulkFill; }
+
+private:
+  AliPIDResponseCache(const AliPIDResponseCache&);             // not implemented
+  AliPIDResponseCache& operator=(const AliPIDResponseCache&);  // not implemented
+
+  static Float_t Compute(const AliPIDResponse *pid, EDetector det, const AliVParticle *track, AliPID::EParticleType type);
+  void           CheckEvent();
+  Int_t          GetTrackIndex(const AliVParticle *track);
+  void           BulkFill(EDetector det);
+
+  Bool_t                 fEnabled;         ///< Use the cache, otherwise all requests are passed to the PID response
+  Bool_t                 fBulkFill;        ///< Compute all species of all tracks at the first request for a detector
+  const AliVEvent       *fEvent;           //!<! Event of the cached values
+  Long64_t               fEntry;           //!<! Entry of the analysis manager of the cached values
+  const AliPIDResponse  *fResponse;        //!<! PID response of the cached values
+  Int_t                  fNTracks;         //!<! Number of tracks of the event, -1 if the track index is not built
+  TExMap                 fTrackIndex;      //!<! Track pointer to track index + 1
+  std::vector<Float_t>   fNSigma;          //!<! nsigma per track, detector and species
+  std::vector<UShort_t>  fFilled;          //!<! Bit map of the cached species per track and detector
+  Bool_t                 fBulkFilled[kNDetectors]; //!<! All species of all tracks cached for the detector
+
+  static AliPIDResponseCache *fgInstance;  //!<! Instance used by the static helpers
+
+  ClassDef(AliPIDResponseCache, 1);
+};
+
+#endif /* ALIPIDRESPONSECACHE_H */
@@ -32,6 +32,8 @@
 // Author: Jan Fiete Grosse-Oetringhaus
 
 #include "AliTHn.h"
+#include "TBinLookup.h"
+#include "TBinning.h"
 #include "TList.h"
 #include "TCollection.h"
 #include "AliLog.h"
@@ -40,8 +42,73 @@
 #include "THnSparse.h"
 #include "TMath.h"
 
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 templateClassImp(AliTHnT)
 
+// private fill buffer for one shard (i.e. one thread); not streamed
+template <typename TemplateType>
+class AliTHnFillBuffer
+{
+ public:
+  typedef std::unordered_map<Long64_t, std::pair<TemplateType, TemplateType> > SparseStep_t; // global bin -> (sum w, sum w^2)
+
+  AliTHnFillBuffer(Int_t nVars, Int_t nSteps, Long64_t nBins, Bool_t sparse) :
+    fNBins(nBins),
+    fSparse(sparse),
+    fValues(sparse ? 0 : nSteps),
+    fSumw2(sparse ? 0 : nSteps),
+    fSparseValues(sparse ? nSteps : 0),
+    fLastVars(nVars, std::numeric_limits<Double_t>::quiet_NaN()),  // NaN never matches -> first fill always looks up the bins
+    fLastBins(nVars, 0)
+  {
+  }
+
+  void Fill(Long64_t bin, Int_t istep, Double_t weight)
+  {
+    if (fSparse)
+    {
+      std::pair<TemplateType, TemplateType> &entry = fSparseValues[istep][bin];
+      entry.first += weight;
+      entry.second += weight * weight;
+      return;
+    }
+
+    std::vector<TemplateType> &values = fValues[istep];
+    if (values.empty())
+      values.resize(fNBins, 0);
+    // same convention as the main container: sumw2 only created at the first weight != 1
+    if (weight != 1 && fSumw2[istep].empty())
+      fSumw2[istep] = values;
+
+    values[bin] += weight;
+    if (!fSumw2[istep].empty())
+      fSumw2[istep][bin] += weight * weight;
+  }
+
+  void Clear()
+  {
+    for (UInt_t i=0; i<fValues.size(); i++)
+    {
+      std::vector<TemplateType>().swap(fValues[i]);
+      std::vector<TemplateType>().swap(fSumw2[i]);
+    }
+    for (UInt_t i=0; i<fSparseValues.size(); i++)
+      SparseStep_t().swap(fSparseValues[i]);
+  }
+
+  Long64_t fNBins;                                    // number of total bins
+  Bool_t fSparse;                                     // sparse storage
+  std::vector<std::vector<TemplateType> > fValues;    // dense storage per step (empty until first fill)
+  std::vector<std::vector<TemplateType> > fSumw2;     // dense sumw2 per step (empty until first weight != 1)
+  std::vector<SparseStep_t> fSparseValues;            // sparse storage per step
+  std::vector<Double_t> fLastVars;                    // caching of last used bins of this shard
+  std::vector<Int_t> fLastBins;                       // caching of last used bins of this shard
+};
+
 template <class TemplateArray, typename TemplateType>
 AliTHnT<TemplateArray, TemplateType>::AliTHnT() : 
   AliTHnBase(),
@@ -51,9 +118,13 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   fValues(0),
   fSumw2(0),
   axisCache(0),
+  fBinLookups(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fSparseStorage(kFALSE),
+  fShards(0)
 {
   // Constructor
 }
@@ -67,9 +138,13 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   fValues(0),
   fSumw2(0),
   axisCache(0),
+  fBinLookups(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fSparseStorage(kFALSE),
+  fShards(0)
 {
   // Constructor
 
@@ -104,9 +179,13 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   fValues(new TemplateArray*[c.fNSteps]),
   fSumw2(new TemplateArray*[c.fNSteps]),
   axisCache(0),
+  fBinLookups(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fSparseStorage(kFALSE),
+  fShards(0)
 {
   //
   // AliTHnT copy constructor
@@ -131,10 +210,13 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   
   delete[] fValues;
   delete[] fSumw2;
+  ResetBinLookup(-1);
   delete[] axisCache;
   delete[] fNbinsCache;
   delete[] fLastVars;
   delete[] fLastBins;
+
+  DeleteShards();
 }
 
 template <class TemplateArray, typename TemplateType>
@@ -194,6 +276,7 @@ AliTHnT<TemplateArray, TemplateType> &AliTHnT<TemplateArray, TemplateType>::oper
     delete [] axisCache;
     axisCache = new TAxis*[fNVars];
     memcpy(axisCache, c.axisCache, fNVars*sizeof(TAxis*));
+    ResetBinLookup(-1);
   }
   return *this;
 }
@@ -241,11 +324,19 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
   
   if (list->IsEmpty())
     return 1;
-  
-  AliCFContainer::Merge(list);
 
+  // flush the private fill buffers first, in sparse storage mode they are written into the parent grids
+  MergeShards();
   TIterator* iter = list->MakeIterator();
   TObject* obj;
+  while ((obj = iter->Next())) {
+    AliTHnT* entry = dynamic_cast<AliTHnT*> (obj);
+    if (entry)
+      entry->MergeShards();
+  }
+  iter->Reset();
+  
+  AliCFContainer::Merge(list);
   
   Int_t count = 0;
   while ((obj = iter->Next())) {
@@ -282,11 +373,13 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::InitAxisCache()
 {
-  // fills an entry
+  // fills the axis cache and creates the bin lookups
+
+  if (fBinLookups)
+    return;
 
-  // fill axis cache
   if (!axisCache)
   {
     axisCache = new TAxis*[fNVars];
@@ -296,44 +389,149 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
       axisCache[i] = GetAxis(i, 0);
       fNbinsCache[i] = axisCache[i]->GetNbins();
     }
-    
+  }
+
+  if (!fLastVars)
+  {
     fLastVars = new Double_t[fNVars];
     fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
     for (Int_t i=0; i<fNVars; i++)
     {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
+      fLastVars[i] = std::numeric_limits<Double_t>::quiet_NaN();
+      fLastBins[i] = 0;
     }
   }
-  
-  // calculate global bin index
-  Long64_t bin = 0;
+
+  fBinLookups = new TBinLookup*[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
+    fBinLookups[i] = new TBinLookup(*axisCache[i]);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::ResetBinLookup(Int_t ivar)
+{
+  // updates the bin lookup of variable <ivar> after its bins have been changed, -1 deletes all lookups
+  // they are (re)created from the axes in InitAxisCache
+
+  if (!fBinLookups)
+    return;
+
+  if (ivar >= 0)
+  {
+    delete fBinLookups[ivar];
+    fBinLookups[ivar] = new TBinLookup(*axisCache[ivar]);
+
+    // the last-bin caches refer to the old bins, NaN never matches
+    fLastVars[ivar] = std::numeric_limits<Double_t>::quiet_NaN();
+    for (Int_t i=0; i<fNShards; i++)
+      fShards[i]->fLastVars[ivar] = std::numeric_limits<Double_t>::quiet_NaN();
+    return;
+  }
+
+  for (Int_t i=0; i<fNVars; i++)
+    delete fBinLookups[i];
+  delete[] fBinLookups;
+  fBinLookups = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetBinLimits(Int_t ivar, Double_t min, Double_t max)
+{
+  // sets uniform bins for variable <ivar>
+
+  AliCFContainer::SetBinLimits(ivar, min, max);
+  ResetBinLookup(ivar);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetBinLimits(Int_t ivar, const Double_t * array)
+{
+  // sets the bin edges of variable <ivar>
+
+  AliCFContainer::SetBinLimits(ivar, array);
+  ResetBinLookup(ivar);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetBinning(Int_t ivar, const TBinning &binning)
+{
+  // sets the bins of variable <ivar> from a binning description (e.g. TLinearBinning, TCustomBinning)
+  // the number of bins has to be the one given in the constructor
+
+  TArrayD binEdges;
+  binning.CreateBinEdges(binEdges);
+  if (binEdges.GetSize() != GetNBins(ivar) + 1)
+  {
+    AliError(Form("Binning of variable %d has %d bins, %d expected", ivar, binEdges.GetSize() - 1, GetNBins(ivar)));
+    return;
+  }
+
+  SetBinLimits(ivar, binEdges.GetArray());
+}
+
+template <class TemplateArray, typename TemplateType>
+Bool_t AliTHnT<TemplateArray, TemplateType>::FindGlobalBin(const Double_t *var, Double_t *lastVars, Int_t *lastBins, Long64_t &bin) const
+{
+  // calculates the global bin index for the values <var> using and updating the last-bin cache <lastVars>, <lastBins>
+  // returns kFALSE if one of the values is in the under/overflow bin
+
+  bin = 0;
   for (Int_t i=0; i<fNVars; i++)
   {
     bin *= fNbinsCache[i];
     
     Int_t tmpBin = 0;
-    if (fLastVars[i] == var[i])
-      tmpBin = fLastBins[i];
+    if (lastVars[i] == var[i])
+      tmpBin = lastBins[i];
     else
     {
-      tmpBin = axisCache[i]->FindBin(var[i]);
-      fLastBins[i] = tmpBin;
-      fLastVars[i] = var[i];
+      tmpBin = fBinLookups[i]->FindBin(var[i]);
+      lastBins[i] = tmpBin;
+      lastVars[i] = var[i];
     }
     //Printf("%d", tmpBin);
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return kFALSE;
     
     // bins start from 0 here
     bin += tmpBin - 1;
 //     Printf("%lld", bin);
   }
 
+  return kTRUE;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  if (fNShards > 0)
+  {
+    FillShard(var, istep, weight, 0);
+    return;
+  }
+
+  // fill axis cache
+  if (!fBinLookups)
+  {
+    InitAxisCache();
+    
+    // initial values to prevent checking for 0 below
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      fLastBins[i] = fBinLookups[i]->FindBin(var[i]);
+      fLastVars[i] = var[i];
+    }
+  }
+  
+  // calculate global bin index
+  Long64_t bin = 0;
+  if (!FindGlobalBin(var, fLastVars, fLastBins, bin))
+    return;
+
   if (!fValues[istep])
   {
     fValues[istep] = new TemplateArray(fNBins);
@@ -381,6 +579,8 @@ template <class TemplateArray, typename TemplateType>
 void AliTHnT<TemplateArray, TemplateType>::FillContainer(AliCFContainer* cont)
 {
   // fills the information stored in the buffer in this class into the container <cont>
+
+  MergeShards();
   
   for (Int_t i=0; i<fNSteps; i++)
   {
@@ -456,6 +656,8 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
 {
   // "removes" one axis by summing over the axis and putting the entry to bin 1
   // TODO presently only implemented for the last axis
+
+  MergeShards();
   
   Int_t axis = fNVars-1;
   
@@ -531,5 +733,149 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   }
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetNShards(Int_t nShards)
+{
+  // creates <nShards> private fill buffers, one per filling thread
+  // the buffers are summed into the container in MergeShards()
+  // nShards = 0 switches back to filling the container directly
+
+  MergeShards();
+  DeleteShards();
+
+  if (nShards < 0)
+    nShards = 0;
+
+  // cache axes now, Fill must not initialize shared state when called from several threads
+  InitAxisCache();
+
+  fNShards = nShards;
+  if (fNShards == 0)
+    return;
+
+  fShards = new AliTHnFillBuffer<TemplateType>*[fNShards];
+  for (Int_t i=0; i<fNShards; i++)
+    fShards[i] = new AliTHnFillBuffer<TemplateType>(fNVars, fNSteps, fNBins, fSparseStorage);
+
+  AliInfo(Form("Created %d %s fill buffers", fNShards, fSparseStorage ? "sparse" : "dense"));
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetSparseStorage(Bool_t sparse)
+{
+  // keep only filled bins in the fill buffers
+  // if no fill buffers have been requested so far, one buffer is created
+
+  fSparseStorage = sparse;
+  SetNShards(fNShards > 0 ? fNShards : 1);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShards()
+{
+  // deletes the private fill buffers (without merging)
+
+  for (Int_t i=0; i<fNShards; i++)
+    delete fShards[i];
+  delete[] fShards;
+  fShards = 0;
+  fNShards = 0;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillShard(const Double_t *var, Int_t istep, Double_t weight, Int_t ishard)
+{
+  // fills an entry into the private buffer <ishard>
+  // thread-safe as long as each thread uses its own buffer
+
+  if (ishard < 0 || ishard >= fNShards)
+  {
+    AliFatal(Form("Fill buffer %d requested, but only %d available", ishard, fNShards));
+    return;
+  }
+
+  AliTHnFillBuffer<TemplateType>* shard = fShards[ishard];
+
+  Long64_t bin = 0;
+  if (!FindGlobalBin(var, &(shard->fLastVars[0]), &(shard->fLastBins[0]), bin))
+    return;
+
+  shard->Fill(bin, istep, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::MergeShards()
+{
+  // sums the private fill buffers into the container and clears them
+  // dense buffers are added to the internal storage, sparse buffers are written into the parent THnSparse grids
+  // must not be called while other threads are filling
+
+  if (fNShards == 0)
+    return;
+
+  Int_t* binIdx = new Int_t[fNVars];
+
+  for (Int_t ishard=0; ishard<fNShards; ishard++)
+  {
+    AliTHnFillBuffer<TemplateType>* shard = fShards[ishard];
+
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      if (shard->fSparse)
+      {
+        const typename AliTHnFillBuffer<TemplateType>::SparseStep_t &entries = shard->fSparseValues[i];
+        if (entries.empty())
+          continue;
+
+        THnSparse* target = GetGrid(i)->GetGrid();
+        for (typename AliTHnFillBuffer<TemplateType>::SparseStep_t::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+          // global bin index -> TAxis bin indexes
+          Long64_t globalBin = it->first;
+          for (Int_t j=fNVars-1; j>=0; j--)
+          {
+            binIdx[j] = globalBin % fNbinsCache[j] + 1;
+            globalBin /= fNbinsCache[j];
+          }
+
+          Long64_t targetBin = target->GetBin(binIdx, kTRUE);
+          Double_t content = target->GetBinContent(targetBin);
+          Double_t error2 = target->GetBinError2(targetBin);
+          target->SetBinContent(targetBin, content + it->second.first);
+          target->SetBinError2(targetBin, error2 + it->second.second);
+        }
+        continue;
+      }
+
+      if (shard->fValues[i].empty())
+        continue;
+
+      if (!fValues[i])
+        fValues[i] = new TemplateArray(fNBins);
+
+      const Bool_t shardSumw2 = !shard->fSumw2[i].empty();
+      // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
+      if (shardSumw2 && !fSumw2[i])
+        fSumw2[i] = new TemplateArray(*fValues[i]);
+
+      TemplateType* values = fValues[i]->GetArray();
+      TemplateType* sumw2 = (fSumw2[i]) ? fSumw2[i]->GetArray() : 0;
+      const TemplateType* sourceValues = &(shard->fValues[i][0]);
+      // without sumw2 in the buffer all entries have been filled with weight == 1
+      const TemplateType* sourceSumw2 = (shardSumw2) ? &(shard->fSumw2[i][0]) : sourceValues;
+
+      for (Long64_t l = 0; l<fNBins; l++)
+        values[l] += sourceValues[l];
+      if (sumw2)
+        for (Long64_t l = 0; l<fNBins; l++)
+          sumw2[l] += sourceSumw2[l];
+    }
+
+    shard->Clear();
+  }
+
+  delete[] binIdx;
+}
+
 template class AliTHnT<TArrayF, Float_t>;
 template class AliTHnT<TArrayD, Double_t>;
@@ -9,6 +9,17 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+//
+// For filling from several threads, call SetNShards(n) before the first fill. Each thread then fills
+// its own private buffer via FillShard(..., ishard), the buffers are summed into the container by
+// MergeShards() (called automatically by FillParent() and Merge()). Call MergeShards() before the
+// output is written (e.g. in FinishTaskOutput).
+// With SetSparseStorage() the shard buffers only keep filled bins in memory, which is more compact
+// for high-dimensional containers which are mostly empty. In this mode MergeShards() writes the
+// content directly into the parent THnSparse grids.
+// The bin of each variable is found with a TBinLookup built from the axes at the first fill, so that
+// bins of equal width are found without a binary search. SetBinning() sets the bins of a variable from a
+// TBinning description.
 
 #include "TObject.h"
 #include "TString.h"
@@ -18,6 +29,9 @@ class TArray;
 class TArrayF;
 class TArrayD;
 class TCollection;
+class TBinLookup;
+class TBinning;
+template <typename TemplateType> class AliTHnFillBuffer;
 
 class AliTHnBase : public AliCFContainer
 {
@@ -34,6 +48,11 @@ public:
 
   virtual void DeleteContainers() = 0;
   virtual void ReduceAxis() = 0;  
+
+  virtual void SetNShards(Int_t nShards) = 0;
+  virtual void SetSparseStorage(Bool_t sparse = kTRUE) = 0;
+  virtual void FillShard(const Double_t *var, Int_t istep, Double_t weight, Int_t ishard) = 0;
+  virtual void MergeShards() = 0;
   
   ClassDef(AliTHnBase, 1) // AliTHn base class
 };
@@ -56,6 +75,17 @@ class AliTHnT : public AliTHnBase
   
   virtual void DeleteContainers();
   virtual void ReduceAxis();
+
+  virtual void SetBinLimits(Int_t ivar, Double_t min, Double_t max);
+  virtual void SetBinLimits(Int_t ivar, const Double_t * array);
+  void SetBinning(Int_t ivar, const TBinning &binning);
+
+  virtual void SetNShards(Int_t nShards);
+  virtual void SetSparseStorage(Bool_t sparse = kTRUE);
+  virtual void FillShard(const Double_t *var, Int_t istep, Double_t weight, Int_t ishard);
+  virtual void MergeShards();
+  Int_t GetNShards() const { return fNShards; }
+  Bool_t IsSparseStorage() const { return fSparseStorage; }
   
   AliTHnT(const AliTHnT &c);
   AliTHnT& operator=(const AliTHnT& corr);
@@ -65,6 +95,10 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitAxisCache();
+  void ResetBinLookup(Int_t ivar);
+  void DeleteShards();
+  Bool_t FindGlobalBin(const Double_t *var, Double_t *lastVars, Int_t *lastBins, Long64_t &bin) const;
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
   
   Long64_t fNBins;   // number of total bins
@@ -74,11 +108,15 @@ protected:
   TemplateArray **fSumw2;   //[fNSteps] data container
   
   TAxis** axisCache; //! cache axis pointers (about 50% of the time in Fill is spent in GetAxis otherwise)
+  TBinLookup** fBinLookups; //! fast bin lookup per axis, built from the cached axes
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Int_t    fNShards;        //! number of private fill buffers (0 = fill directly)
+  Bool_t   fSparseStorage;  //! keep only filled bins in the fill buffers
+  AliTHnFillBuffer<TemplateType>** fShards; //! [fNShards] private fill buffers
   
-  ClassDef(AliTHnT, 5) // THn like container
+  ClassDef(AliTHnT, 6) // THn like container
 };
 
 typedef AliTHnT<TArrayF, Float_t> AliTHn;
@@ -0,0 +1,370 @@
+/**************************************************************************
+ * Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <chrono>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include <TMath.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TFile.h>
+#include <TDirectory.h>
+#include <TList.h>
+#include <TSystem.h>
+#include <TCollection.h>
+
+#include "AliTaskCostMonitor.h"
+
+/// \cond CLASSIMP
+ClassImp(AliTaskCostMonitor)
+/// \endcond
+
+/**
+ * Default constructor, for ROOT I/O
+ */
+AliTaskCostMonitor::AliTaskCostMonitor() :
+  TNamed(),
+  fRegionNames(),
+  fCalls(),
+  fWallTime(),
+  fCpuTime(),
+  fMaxWallTime(),
+  fMemGrowth(),
+  fMemSamples(),
+  fHistEntries(0),
+  fNJobs(1),
+  fSampling(100),
+  fWallStart(),
+  fCpuStart(),
+  fMemStart(),
+  fOutput(0x0)
+{
+  fRegionNames.SetOwner(kTRUE);
+}
+
+/**
+ * Named constructor, the name is the one of the wagon. The region "Event" is created.
+ * @param[in] name Name of the monitor
+ */
+AliTaskCostMonitor::AliTaskCostMonitor(const char *name) :
+  TNamed(name, "Task cost monitor"),
+  fRegionNames(),
+  fCalls(),
+  fWallTime(),
+  fCpuTime(),
+  fMaxWallTime(),
+  fMemGrowth(),
+  fMemSamples(),
+  fHistEntries(0),
+  fNJobs(1),
+  fSampling(100),
+  fWallStart(),
+  fCpuStart(),
+  fMemStart(),
+  fOutput(0x0)
+{
+  fRegionNames.SetOwner(kTRUE);
+  AddRegion("Event");
+}
+
+/**
+ * Add a timed region
+ * @param[in] name Name of the region, unique within the monitor
+ * @return Index of the region, to be used in Start() and Stop()
+ */
+Int_t AliTaskCostMonitor::AddRegion(const char *name)
+{
+  Int_t region = FindRegion(name);
+  if (region >= 0) return region;
+
+  region = GetNRegions();
+  fRegionNames.AddLast(new TNamed(name, name));
+  const Int_t n = region + 1;
+  fCalls.Set(n);
+  fWallTime.Set(n);
+  fCpuTime.Set(n);
+  fMaxWallTime.Set(n);
+  fMemGrowth.Set(n);
+  fMemSamples.Set(n);
+  fWallStart.Set(n);
+  fCpuStart.Set(n);
+  fMemStart.Set(n);
+  fMemStart[region] = -1;
+  return region;
+}
+
+/**
+ * @param[in] name Name of the region
+ * @return Index of the region, -1 if it does not exist
+ */
+Int_t AliTaskCostMonitor::FindRegion(const char *name) const
+{
+  for (Int_t i = 0; i < GetNRegions(); i++) {
+    if (!strcmp(fRegionNames.At(i)->GetName(), name)) return i;
+  }
+  return -1;
+}
+
+/**
+ * Start a call of a region. Regions may be nested, but a region must be stopped before it
+ * is started again.
+ * @param[in] region Index of the region
+ */
+void AliTaskCostMonitor::Start(Int_t region)
+{
+  if (region < 0 || region >= GetNRegions()) return;
+  // the transient arrays are not streamed
+  if (fWallStart.GetSize() != GetNRegions()) {
+    fWallStart.Set(GetNRegions());
+    fCpuStart.Set(GetNRegions());
+    fMemStart.Set(GetNRegions());
+    fMemStart.Reset(-1);
+  }
+  if (fSampling > 0 && Long64_t(fCalls[region]) % fSampling == 0) {
+    fMemStart[region] = ResidentMemory();
+  }
+  fCpuStart[region] = CpuClock();
+  fWallStart[region] = WallClock();
+}
+
+/**
+ * Stop a call of a region and add its cost
+ * @param[in] region Index of the region
+ */
+void AliTaskCostMonitor::Stop(Int_t region)
+{
+  if (region < 0 || region >= fWallStart.GetSize()) return;
+  const Double_t wall = WallClock() - fWallStart[region];
+  const Double_t cpu = CpuClock() - fCpuStart[region];
+  fCalls[region] += 1;
+  fWallTime[region] += wall;
+  fCpuTime[region] += cpu;
+  if (wall > fMaxWallTime[region]) fMaxWallTime[region] = wall;
+  if (fMemStart[region] >= 0) {
+    fMemGrowth[region] += ResidentMemory() - fMemStart[region];
+    fMemSamples[region] += 1;
+    fMemStart[region] = -1;
+    if (region == kEvent && fOutput) fHistEntries = CountHistogramEntries(fOutput);
+  }
+}
+
+/**
+ * Update the histogram entries at the end of the job
+ */
+void AliTaskCostMonitor::Finish()
+{
+  if (fOutput) fHistEntries = CountHistogramEntries(fOutput);
+}
+
+/**
+ * @param[in] region Index of the region
+ * @return Growth of the resident memory (kB) in all calls of the region, extrapolated from the sampled calls
+ */
+Double_t AliTaskCostMonitor::GetMemoryGrowth(Int_t region) const
+{
+  if (fMemSamples[region] <= 0) return 0;
+  return fMemGrowth[region] * fCalls[region] / fMemSamples[region];
+}
+
+/**
+ * Add the counters of other monitors. Regions are matched by name.
+ * @param[in] list Monitors to be merged
+ * @return Number of merged monitors
+ */
+Long64_t AliTaskCostMonitor::Merge(TCollection *list)
+{
+  if (!list) return 0;
+  Long64_t nmerged = 0;
+  TIter next(list);
+  const AliTaskCostMonitor *mon = 0x0;
+  while ((mon = dynamic_cast<const AliTaskCostMonitor *>(next()))) {
+    for (Int_t i = 0; i < mon->GetNRegions(); i++) {
+      const Int_t region = AddRegion(mon->GetRegionName(i));
+      fCalls[region] += mon->fCalls[i];
+      fWallTime[region] += mon->fWallTime[i];
+      fCpuTime[region] += mon->fCpuTime[i];
+      fMaxWallTime[region] = TMath::Max(fMaxWallTime[region], mon->fMaxWallTime[i]);
+      fMemGrowth[region] += mon->fMemGrowth[i];
+      fMemSamples[region] += mon->fMemSamples[i];
+    }
+    fHistEntries += mon->fHistEntries;
+    fNJobs += mon->fNJobs;
+    nmerged++;
+  }
+  return nmerged;
+}
+
+/**
+ * Print the counters of all regions
+ */
+void AliTaskCostMonitor::Print(Option_t *) const
+{
+  Printf("%s: %d job(s), %.0f histogram entries", GetName(), fNJobs, fHistEntries);
+  Printf("  %-24s %12s %12s %12s %10s %12s %12s", "region", "calls", "wall (s)", "ms/call", "cpu/wall", "max (ms)", "mem (MB)");
+  for (Int_t i = 0; i < GetNRegions(); i++) {
+    Printf("  %-24s %12.0f %12.3f %12.4f %10.2f %12.3f %12.1f", GetRegionName(i), fCalls[i], fWallTime[i],
+           fCalls[i] > 0 ? 1e3 * fWallTime[i] / fCalls[i] : 0., fWallTime[i] > 0 ? fCpuTime[i] / fWallTime[i] : 0.,
+           1e3 * fMaxWallTime[i], GetMemoryGrowth(i) / 1024.);
+  }
+}
+
+/**
+ * Print the wagons of a train output file by their share of the time
+ * @param[in] fileName Train output file
+ */
+void AliTaskCostMonitor::PrintSummary(const char *fileName)
+{
+  TFile *file = TFile::Open(fileName);
+  if (!file || file->IsZombie()) {
+    ::Error("AliTaskCostMonitor::PrintSummary", "Cannot open %s", fileName);
+    delete file;
+    return;
+  }
+  TList monitors;
+  monitors.SetOwner(kTRUE);
+  FindMonitors(file, &monitors);
+  PrintSummary(&monitors);
+  file->Close();
+  delete file;
+}
+
+/**
+ * Print the wagons by their share of the total time of the event methods. The share of the
+ * user regions is given with respect to the event method of their wagon.
+ * @param[in] monitors Monitors of the wagons
+ */
+void AliTaskCostMonitor::PrintSummary(const TCollection *monitors)
+{
+  std::vector<const AliTaskCostMonitor *> wagons;
+  Double_t total = 0;
+  TIter next(monitors);
+  const AliTaskCostMonitor *mon = 0x0;
+  while ((mon = dynamic_cast<const AliTaskCostMonitor *>(next()))) {
+    wagons.push_back(mon);
+    total += mon->GetWallTime(kEvent);
+  }
+  if (wagons.empty()) {
+    Printf("No task cost monitors found");
+    return;
+  }
+  std::sort(wagons.begin(), wagons.end(), [](const AliTaskCostMonitor *a, const AliTaskCostMonitor *b) {
+    return a->GetWallTime(kEvent) > b->GetWallTime(kEvent);
+  });
+
+  Printf("%d wagons, %.1f s in the event methods", Int_t(wagons.size()), total);
+  Printf("%-40s %8s %12s %10s %8s %12s %10s %10s %14s", "wagon", "jobs", "events", "wall (s)", "share",
+         "ms/event", "cpu/wall", "mem (MB)", "hist entries");
+  for (std::vector<const AliTaskCostMonitor *>::const_iterator it = wagons.begin(); it != wagons.end(); ++it) {
+    mon = *it;
+    const Double_t wall = mon->GetWallTime(kEvent);
+    const Double_t calls = mon->GetCalls(kEvent);
+    Printf("%-40s %8d %12.0f %10.1f %7.1f%% %12.4f %10.2f %10.1f %14.0f", mon->GetName(), mon->GetNJobs(), calls, wall,
+           total > 0 ? 1e2 * wall / total : 0., calls > 0 ? 1e3 * wall / calls : 0.,
+           wall > 0 ? mon->GetCpuTime(kEvent) / wall : 0., mon->GetMemoryGrowth(kEvent) / 1024., mon->GetHistogramEntries());
+    for (Int_t i = 1; i < mon->GetNRegions(); i++) {
+      const Double_t rcalls = mon->GetCalls(i);
+      Printf("  %-38s %8s %12.0f %10.1f %7.1f%% %12.4f %10.2f %10.1f", mon->GetRegionName(i), "", rcalls, mon->GetWallTime(i),
+             wall > 0 ? 1e2 * mon->GetWallTime(i) / wall : 0., rcalls > 0 ? 1e3 * mon->GetWallTime(i) / rcalls : 0.,
+             mon->GetWallTime(i) > 0 ? mon->GetCpuTime(i) / mon->GetWallTime(i) : 0., mon->GetMemoryGrowth(i) / 1024.);
+    }
+  }
+}
+
+/**
+ * Collect copies of the monitors stored in a directory and its subdirectories and lists
+ * @param[in] dir Directory to be searched
+ * @param[out] monitors Copies of the monitors found, owned by the caller
+ */
+void AliTaskCostMonitor::FindMonitors(TDirectory *dir, TCollection *monitors)
+{
+  TIter next(dir->GetListOfKeys());
+  TKey *key = 0x0;
+  while ((key = static_cast<TKey *>(next()))) {
+    TObject *obj = key->ReadObj();
+    if (!obj) continue;
+    if (obj->InheritsFrom(AliTaskCostMonitor::Class())) {
+      monitors->Add(obj);
+      continue;
+    }
+    if (obj->InheritsFrom(TDirectory::Class())) {
+      FindMonitors(static_cast<TDirectory *>(obj), monitors);
+    }
+    else if (obj->InheritsFrom(TCollection::Class())) {
+      FindMonitors(static_cast<TCollection *>(obj), monitors);
+      delete obj;
+    }
+    else {
+      delete obj;
+    }
+  }
+}
+
+/**
+ * Collect copies of the monitors stored in a list and its sublists
+ * @param[in] list List to be searched
+ * @param[out] monitors Copies of the monitors found, owned by the caller
+ */
+void AliTaskCostMonitor::FindMonitors(const TCollection *list, TCollection *monitors)
+{
+  TIter next(list);
+  TObject *obj = 0x0;
+  while ((obj = next())) {
+    if (obj->InheritsFrom(AliTaskCostMonitor::Class())) monitors->Add(obj->Clone());
+    else if (obj->InheritsFrom(TCollection::Class())) FindMonitors(static_cast<TCollection *>(obj), monitors);
+  }
+}
+
+/**
+ * @param[in] list Output list of a wagon
+ * @return Sum of the entries of the histograms in the list and its sublists
+ */
+Double_t AliTaskCostMonitor::CountHistogramEntries(const TCollection *list)
+{
+  Double_t entries = 0;
+  TIter next(list);
+  TObject *obj = 0x0;
+  while ((obj = next())) {
+    if (obj->InheritsFrom(TH1::Class())) entries += static_cast<TH1 *>(obj)->GetEntries();
+    else if (obj->InheritsFrom(TCollection::Class())) entries += CountHistogramEntries(static_cast<TCollection *>(obj));
+  }
+  return entries;
+}
+
+/**
+ * @return Monotonic wall clock (s)
+ */
+Double_t AliTaskCostMonitor::WallClock()
+{
+  return std::chrono::duration<Double_t>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @return CPU time of the process (s)
+ */
+Double_t AliTaskCostMonitor::CpuClock()
+{
+  return Double_t(std::clock()) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @return Resident memory of the process (kB)
+ */
+Double_t AliTaskCostMonitor::ResidentMemory()
+{
+  ProcInfo_t info;
+  gSystem->GetProcInfo(&info);
+  return info.fMemResident;
+}
@@ -0,0 +1,114 @@
+#ifndef ALITASKCOSTMONITOR_H
+#define ALITASKCOSTMONITOR_H
+/* Copyright(c) 1998-2017, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <TNamed.h>
+#include <TArrayD.h>
+#include <TObjArray.h>
+
+class TCollection;
+class TDirectory;
+
+/**
+ * \class AliTaskCostMonitor
+ * \brief Per-wagon cost counters: wall and CPU time, memory growth and histogram entries
+ *
+ * Opt-in instrumentation for analysis trains. The common base tasks (AliAnalysisTaskEmcal,
+ * AliAnalysisTaskEmcalLight, AliAnalysisTaskReducedEventProcessor, AliRsnMiniAnalysisTask,
+ * AliAnalysisTaskFemto) create one monitor per wagon when SetCostMonitoring() is enabled,
+ * time their event method in the region "Event" and store the monitor in their output list.
+ * Derived tasks can time their own regions:
+ *
+ * ~~~{.cxx}
+ * // UserCreateOutputObjects
+ * if (GetCostMonitor()) fRegionJets = GetCostMonitor()->AddRegion("JetFinding");
+ * // Run
+ * AliTaskCostMonitor::Scope s(GetCostMonitor(), fRegionJets);
+ * ~~~
+ *
+ * The resident memory and the number of histogram entries in the output of the wagon are
+ * sampled every SetSampling() events, to keep the overhead per event at two clock reads.
+ * The memory growth of a region is the change of the resident memory of the process while
+ * the region was active and serves as proxy for its allocations. Monitors merge across
+ * jobs; PrintSummary() lists the wagons of a train output file by their share of the time.
+ */
+class AliTaskCostMonitor : public TNamed {
+public:
+  /**
+   * \class Scope
+   * \brief Times a region for the lifetime of the object, also on early returns
+   */
+  class Scope {
+  public:
+    Scope(AliTaskCostMonitor *monitor, Int_t region) : fMonitor(monitor), fRegion(region) { if (fMonitor) fMonitor->Start(fRegion); }
+    ~Scope() { if (fMonitor) fMonitor->Stop(fRegion); }
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+    AliTaskCostMonitor *fMonitor;
+    Int_t               fRegion;
+  };
+
+  enum { kEvent = 0 };
+
+  AliTaskCostMonitor();
+  AliTaskCostMonitor(const char *name);
+  virtual ~AliTaskCostMonitor() {}
+
+  Int_t         AddRegion(const char *name);
+  Int_t         FindRegion(const char *name) const;
+  Int_t         GetNRegions() const                 { return fRegionNames.GetEntriesFast(); }
+  const char   *GetRegionName(Int_t region) const   { return fRegionNames.At(region)->GetName(); }
+
+  void          SetSampling(Int_t n)                { fSampling = n; }
+  void          SetOutput(const TCollection *output) { fOutput = output; }
+
+  void          Start(Int_t region);
+  void          Stop(Int_t region);
+  void          Finish();
+
+  Double_t      GetCalls(Int_t region) const        { return fCalls[region]; }
+  Double_t      GetWallTime(Int_t region) const     { return fWallTime[region]; }
+  Double_t      GetCpuTime(Int_t region) const      { return fCpuTime[region]; }
+  Double_t      GetMaxWallTime(Int_t region) const  { return fMaxWallTime[region]; }
+  Double_t      GetMemoryGrowth(Int_t region) const;
+  Double_t      GetHistogramEntries() const         { return fHistEntries; }
+  Int_t         GetNJobs() const                    { return fNJobs; }
+
+  Long64_t      Merge(TCollection *list);
+  virtual void  Print(Option_t *opt = "") const;
+
+  static void   PrintSummary(const char *fileName);
+  static void   PrintSummary(const TCollection *monitors);
+  static void   FindMonitors(TDirectory *dir, TCollection *monitors);
+  static void   FindMonitors(const TCollection *list, TCollection *monitors);
+  static Double_t CountHistogramEntries(const TCollection *list);
+
+private:
+  AliTaskCostMonitor(const AliTaskCostMonitor&);             // not implemented
+  AliTaskCostMonitor& operator=(const AliTaskCostMonitor&);  // not implemented
+
+  static Double_t WallClock();
+  static Double_t CpuClock();
+  static Double_t ResidentMemory();
+
+  TObjArray             fRegionNames;    ///< Names of the regions (TNamed), region 0 is the event method
+  TArrayD               fCalls;          ///< Number of calls per region
+  TArrayD               fWallTime;       ///< Wall time per region (s)
+  TArrayD               fCpuTime;        ///< CPU time per region (s)
+  TArrayD               fMaxWallTime;    ///< Longest call per region (s)
+  TArrayD               fMemGrowth;      ///< Sum of the resident memory growth of the sampled calls per region (kB)
+  TArrayD               fMemSamples;     ///< Number of sampled calls per region
+  Double_t              fHistEntries;    ///< Entries of the histograms in the output at the last sample
+  Int_t                 fNJobs;          ///< Number of merged jobs
+  Int_t                 fSampling;       ///< Sampling period (calls) of memory and histogram entries
+  TArrayD               fWallStart;      //!<! Wall clock at the start of the active calls
+  TArrayD               fCpuStart;       //!<! CPU clock at the start of the active calls
+  TArrayD               fMemStart;       //!<! Resident memory at the start of the sampled active calls, -1 if not sampled
+  const TCollection    *fOutput;         //!<! Output of the wagon, for the histogram entries
+
+  ClassDef(AliTaskCostMonitor, 1);
+};
+
+#endif /* ALITASKCOSTMONITOR_H */
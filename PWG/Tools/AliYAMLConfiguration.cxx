@@ -5,6 +5,7 @@
 
 #include <cstdio>
 #include <fstream>
+#include <map>
 
 #include <TSystem.h>
 #include <TGrid.h>
@@ -27,6 +28,7 @@ namespace Tools {
 AliYAMLConfiguration::AliYAMLConfiguration(const std::string prefixString, const std::string delimiterCharacter):
   TObject(),
   fConfigurations(),
+  fSnapshot(),
   fConfigurationsStrings(),
   fInitialized(false),
   fPrefixString(prefixString),
@@ -103,6 +105,7 @@ int AliYAMLConfiguration::AddConfiguration(const YAML::Node node, std::string co
   // Add the configuration
   AliDebugStream(2) << "Adding configuration \"" << configurationName << "\".\n";
   fConfigurations.push_back(std::make_pair(configurationName, node));
+  fSnapshot.reset();
 
   // Return the location of the new configuration
   return fConfigurations.size() - 1;
@@ -121,6 +124,7 @@ bool AliYAMLConfiguration::RemoveConfiguration(const unsigned int i)
   if (i < fConfigurations.size())
   {
     fConfigurations.erase(fConfigurations.begin() + i);
+    fSnapshot.reset();
     returnValue = true;
   }
 
@@ -381,6 +385,7 @@ bool AliYAMLConfiguration::Reinitialize()
       YAML::Node node = YAML::Load(configStrPair.second);
       fConfigurations.push_back(std::make_pair(configStrPair.first, node));
     }
+    fSnapshot.reset();
 
     returnValue = true;
   }
@@ -388,6 +393,198 @@ bool AliYAMLConfiguration::Reinitialize()
   return returnValue;
 }
 
+/**
+ * Build the flattened snapshot of the configurations. Each configuration is stored as a hash map from the full
+ * property path (joined with the delimiter) to its YAML node, with the shared parameters resolved. Subsequent
+ * calls to GetProperty(...) look up the requested path in these maps instead of walking the YAML nodes.
+ *
+ * Snapshots are kept in a registry keyed by the configurations, so that tasks and components of the same train
+ * which are configured with identical YAML share a single snapshot.
+ *
+ * If requested, the properties of each configuration are checked against the last configuration (usually the
+ * default configuration), which is expected to define every available property. Properties which are not found
+ * there (taking into account specializations) are reported as unknown, which catches misspelled settings early.
+ *
+ * NOTE: Modifying a configuration through GetConfiguration(...) is not tracked. Build the snapshot again afterwards.
+ *
+ * @param[in] checkUnknownProperties If true, report properties which are not in the last configuration.
+ *
+ * @return False if unknown properties were found, true otherwise.
+ */
+bool AliYAMLConfiguration::BuildSnapshot(const bool checkUnknownProperties)
+{
+  // Registry of the snapshots which are currently in use
+  static std::map<std::string, std::weak_ptr<const Snapshot_t> > snapshotRegistry;
+
+  std::stringstream keySS;
+  keySS << fDelimiter << "\n";
+  for (const auto & configPair : fConfigurations) {
+    keySS << "--- " << configPair.first << "\n" << configPair.second << "\n";
+  }
+  const std::string key = keySS.str();
+
+  fSnapshot = snapshotRegistry[key].lock();
+  if (!fSnapshot)
+  {
+    std::shared_ptr<Snapshot_t> snapshot = std::make_shared<Snapshot_t>(fConfigurations.size());
+    for (unsigned int i = 0; i < fConfigurations.size(); i++)
+    {
+      const YAML::Node & node = fConfigurations.at(i).second;
+      if (node.IsNull() != true) {
+        FlattenNode(node, node["sharedParameters"], "", snapshot->at(i));
+      }
+    }
+    fSnapshot = snapshot;
+    snapshotRegistry[key] = fSnapshot;
+    AliDebugStream(1) << "Built snapshot of " << fConfigurations.size() << " configuration(s).\n";
+  }
+
+  bool returnValue = true;
+  if (checkUnknownProperties == true && fSnapshot->size() > 1)
+  {
+    const SnapshotMap_t & reference = fSnapshot->back();
+    for (unsigned int i = 0; i < fSnapshot->size() - 1; i++)
+    {
+      for (const auto & property : fSnapshot->at(i))
+      {
+        // Only check the values themselves. The configuration name and shared parameters are not properties.
+        if (property.second.IsMap() || property.first == "name" || property.first.find("sharedParameters") == 0) {
+          continue;
+        }
+        if (!FindInSnapshot(reference, SplitPropertyName(property.first), 0, "")) {
+          AliWarningStream() << "Property \"" << property.first << "\" of the " << fConfigurations.at(i).first
+                     << " configuration is not defined in the " << fConfigurations.back().first << " configuration!\n";
+          returnValue = false;
+        }
+      }
+    }
+  }
+
+  return returnValue;
+}
+
+/**
+ * Add all the nodes below a YAML map node to the flattened configuration. Values which refer to a shared parameter
+ * are replaced by the shared parameter node, and left out if the shared parameter does not exist (as in
+ * GetProperty(...)).
+ *
+ * @param[in] node YAML map node to flatten.
+ * @param[in] sharedParametersNode YAML node containing the shared parameters of the configuration.
+ * @param[in] path Path of the node (empty for the configuration itself).
+ * @param[out] flatMap Flattened configuration.
+ */
+void AliYAMLConfiguration::FlattenNode(const YAML::Node & node, const YAML::Node & sharedParametersNode, const std::string & path, SnapshotMap_t & flatMap) const
+{
+  if (node.IsMap() != true) {
+    return;
+  }
+
+  for (const auto & child : node)
+  {
+    std::string childPath = child.first.as<std::string>();
+    if (path != "") {
+      childPath = path + fDelimiter + childPath;
+    }
+
+    const YAML::Node & value = child.second;
+    if (value.IsScalar())
+    {
+      std::string sharedValueName = value.as<std::string>();
+      if (IsSharedValue(sharedValueName)) {
+        if (sharedParametersNode[sharedValueName]) {
+          flatMap.emplace(childPath, sharedParametersNode[sharedValueName]);
+        }
+        continue;
+      }
+    }
+
+    flatMap.emplace(childPath, value);
+    FlattenNode(value, sharedParametersNode, childPath, flatMap);
+  }
+}
+
+/**
+ * Split a property name into the names of the nodes along its path.
+ *
+ * @param[in] propertyName Name of the property, separated by the delimiter.
+ *
+ * @return Names of the nodes.
+ */
+std::vector<std::string> AliYAMLConfiguration::SplitPropertyName(const std::string & propertyName) const
+{
+  std::vector<std::string> pathComponents;
+  std::size_t start = 0;
+  std::size_t delimiterPosition = 0;
+  while ((delimiterPosition = propertyName.find(fDelimiter, start)) != std::string::npos)
+  {
+    pathComponents.push_back(propertyName.substr(start, delimiterPosition - start));
+    start = delimiterPosition + fDelimiter.length();
+  }
+  pathComponents.push_back(propertyName.substr(start));
+
+  return pathComponents;
+}
+
+/**
+ * Look up a property in the snapshot, checking the configurations in order of precedence.
+ *
+ * @param[in] propertyName Name of the property (with the prefix already removed).
+ *
+ * @return Node of the property, or nullptr if it is not found.
+ */
+const YAML::Node * AliYAMLConfiguration::FindInSnapshot(const std::string & propertyName) const
+{
+  std::vector<std::string> pathComponents = SplitPropertyName(propertyName);
+  for (const auto & flatMap : *fSnapshot)
+  {
+    const YAML::Node * node = FindInSnapshot(flatMap, pathComponents, 0, "");
+    if (node) {
+      return node;
+    }
+  }
+
+  return nullptr;
+}
+
+/**
+ * Look up a property in one flattened configuration. As in GetProperty(...), each node name along the path is
+ * first tried as is, and then without its specialization (everything after the first "_").
+ *
+ * @param[in] flatMap Flattened configuration.
+ * @param[in] pathComponents Names of the nodes along the path of the property.
+ * @param[in] index Index of the node name to resolve.
+ * @param[in] path Resolved path up to this node name.
+ *
+ * @return Node of the property, or nullptr if it is not found.
+ */
+const YAML::Node * AliYAMLConfiguration::FindInSnapshot(const SnapshotMap_t & flatMap, const std::vector<std::string> & pathComponents, const unsigned int index, const std::string & path) const
+{
+  const std::string & nodeName = pathComponents.at(index);
+  const std::string prefix = (path != "") ? path + fDelimiter : "";
+
+  if (index + 1 == pathComponents.size()) {
+    auto it = flatMap.find(prefix + nodeName);
+    return (it != flatMap.end()) ? &(it->second) : nullptr;
+  }
+
+  const YAML::Node * node = nullptr;
+  if (flatMap.count(prefix + nodeName)) {
+    node = FindInSnapshot(flatMap, pathComponents, index + 1, prefix + nodeName);
+  }
+
+  // Check for the specialization
+  std::size_t specializationPosition = nodeName.find("_");
+  if (!node && specializationPosition != std::string::npos)
+  {
+    std::string specializationPath = prefix + nodeName.substr(0, specializationPosition);
+    if (flatMap.count(specializationPath)) {
+      node = FindInSnapshot(flatMap, pathComponents, index + 1, specializationPath);
+    }
+  }
+
+  return node;
+}
+
 /**
  * Check if value is a shared parameter, meaning we should look
  * at another node. Also edits the input string to remove "sharedParameters:"
@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 #include <ostream>
+#include <memory>
+#include <unordered_map>
 
 #include <TObject.h>
 
@@ -104,6 +106,15 @@
  *
  * Given the limitations, YAML anchors are recommended for more advanced usage as they can be much more sophisticated.
  *
+ * Notes on the configuration snapshot:
+ *
+ * When many properties are retrieved (for example, while setting up the EMCal correction components), call
+ * BuildSnapshot() once all configurations are added. It flattens each configuration into a hash map from the full
+ * property path to the YAML node, with the shared parameters already resolved, so that GetProperty(...) no longer
+ * walks the node trees. The lookup order, the specialization fallback and the shared parameters behave as before.
+ * Copies of the configuration share the snapshot, and configurations built from identical YAML are given the same
+ * snapshot. Adding, removing or writing to a configuration drops the snapshot; it must then be built again.
+ *
  * @author Raymond Ehlers <raymond.ehlers@yale.edu>, Yale University
  * @date Sept 19, 2017
  */
@@ -183,6 +194,14 @@ class AliYAMLConfiguration : public TObject {
   template<typename T>
   bool WriteProperty(std::string propertyName, T & property, std::string configurationName = "");
   /** @} */
+
+  /** @{
+   * @name Flattened snapshot of the configurations for fast property retrieval.
+   */
+  bool BuildSnapshot(const bool checkUnknownProperties = false);
+  bool HasSnapshot() const { return fSnapshot != nullptr; }
+  void ClearSnapshot() { fSnapshot.reset(); }
+  /** @} */
   #endif
 
   /** @{
@@ -245,7 +264,16 @@ class AliYAMLConfiguration : public TObject {
   template<typename T>
   void WriteValue(YAML::Node & node, std::string propertyName, T & proeprty);
 
+  // Snapshot
+  typedef std::unordered_map<std::string, YAML::Node> SnapshotMap_t;  ///< Full property path -> node of one configuration
+  typedef std::vector<SnapshotMap_t> Snapshot_t;                      ///< Flattened configurations, in order of precedence
+  void FlattenNode(const YAML::Node & node, const YAML::Node & sharedParametersNode, const std::string & path, SnapshotMap_t & flatMap) const;
+  std::vector<std::string> SplitPropertyName(const std::string & propertyName) const;
+  const YAML::Node * FindInSnapshot(const std::string & propertyName) const;
+  const YAML::Node * FindInSnapshot(const SnapshotMap_t & flatMap, const std::vector<std::string> & pathComponents, const unsigned int index, const std::string & path) const;
+
   std::vector<std::pair<std::string, YAML::Node> > fConfigurations;         //!<! Contains all YAML configurations. The first element has the highest precedence.
+  std::shared_ptr<const Snapshot_t> fSnapshot;                              //!<! Flattened configurations, shared between copies. Empty if not built.
   #endif
   std::vector<std::pair<std::string, std::string> > fConfigurationsStrings; ///<  Contains all YAML configurations as strings so that they can be streamed.
 
@@ -418,21 +446,33 @@ bool AliYAMLConfiguration::GetProperty(std::string propertyName, T & property, c
   }
 
   bool setProperty = false;
-  for (auto configPair : fConfigurations)
+  if (fSnapshot)
   {
-    if (setProperty == true) {
-      AliDebugGeneralStream("AliYAMLConfiguration", 2) << "Property \"" << propertyName << "\" found!\n";
-      break;
+    const YAML::Node * node = FindInSnapshot(propertyName);
+    if (node) {
+      property = node->as<T>();
+      setProperty = true;
+      AliDebugGeneralStream("AliYAMLConfiguration", 2) << "Property \"" << propertyName << "\" found in the snapshot!\n";
     }
-
-    // IsNull checks is a node is empty. A node is empty if it is created.
-    // IsDefined checks if the node that was requested was not actually created.
-    if (configPair.second.IsNull() != true)
+  }
+  else
+  {
+    for (auto configPair : fConfigurations)
     {
-      AliDebugGeneralStream("AliYAMLConfiguration", 2) << "Looking for parameter \"" << propertyName << "\" in \"" << configPair.first << "\" configuration\n";
-      // NOTE: This may not exist, but that is entirely fine.
-      YAML::Node sharedParameters = configPair.second["sharedParameters"];
-      setProperty = GetProperty(configPair.second, sharedParameters, configPair.first, propertyName, property);
+      if (setProperty == true) {
+        AliDebugGeneralStream("AliYAMLConfiguration", 2) << "Property \"" << propertyName << "\" found!\n";
+        break;
+      }
+
+      // IsNull checks is a node is empty. A node is empty if it is created.
+      // IsDefined checks if the node that was requested was not actually created.
+      if (configPair.second.IsNull() != true)
+      {
+        AliDebugGeneralStream("AliYAMLConfiguration", 2) << "Looking for parameter \"" << propertyName << "\" in \"" << configPair.first << "\" configuration\n";
+        // NOTE: This may not exist, but that is entirely fine.
+        YAML::Node sharedParameters = configPair.second["sharedParameters"];
+        setProperty = GetProperty(configPair.second, sharedParameters, configPair.first, propertyName, property);
+      }
     }
   }
 
@@ -594,6 +634,9 @@ bool AliYAMLConfiguration::WriteProperty(std::string propertyName, T & property,
 
   std::pair<std::string, YAML::Node> & configPair = fConfigurations.at(configurationIndex);
 
+  // The snapshot would not contain the new value
+  fSnapshot.reset();
+
   WriteValue(configPair.second, propertyName, property);
   AliDebugGeneralStream("AliYAMLConfiguration", 2) << "Final Node:\n" << configPair.second << "\n";
 
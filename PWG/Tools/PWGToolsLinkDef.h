@@ -9,6 +9,8 @@
 #pragma link C++ class AliFigure+;
 #pragma link C++ class AliCanvas+;
 #pragma link C++ class AliHelperPID+;
+#pragma link C++ class AliPIDResponseCache+;
+#pragma link C++ class AliMCHeaderCache+;
 #pragma link C++ class AliLatexTable+;
 #pragma link C++ class AliNamedArrayI+;
 #pragma link C++ class AliNamedString+;
@@ -30,6 +32,9 @@
 #pragma link C++ class AliJSONString+;
 #pragma link C++ class AliAnalysisTaskDummy+;
 #pragma link C++ class AliTLorentzVector+;
+#pragma link C++ class AliCompactEventPool+;
+#pragma link C++ class AliCompactEventPoolManager+;
+#pragma link C++ class AliTaskCostMonitor+;
 #if ROOT_VERSION_CODE > ROOT_VERSION(6,4,0)
 #pragma link C++ namespace YAML+;
 #pragma link C++ class YAML::Node+;
@@ -46,4 +51,6 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandle();
+#pragma link C++ function TestTHistManager::TestRunBinLookup();
 #endif
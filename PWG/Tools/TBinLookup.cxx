@@ -0,0 +1,128 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TMath.h>
+#include <TBinLookup.h>
+#include <TBinning.h>
+
+const Int_t TBinLookup::fgkMaxSegments = 8;
+const Double_t TBinLookup::fgkWidthTolerance = 1e-6;
+
+TBinLookup::TBinLookup():
+  fMode(kFixed),
+  fNbins(0),
+  fMinimum(0.),
+  fMaximum(0.),
+  fEdges(),
+  fInverseWidths(),
+  fSegments()
+{
+
+}
+
+TBinLookup::TBinLookup(const TArrayD &binedges):
+  fMode(kFixed),
+  fNbins(0),
+  fMinimum(0.),
+  fMaximum(0.),
+  fEdges(),
+  fInverseWidths(),
+  fSegments()
+{
+  Set(binedges.GetSize(), binedges.GetArray());
+}
+
+TBinLookup::TBinLookup(const TBinning &binning):
+  fMode(kFixed),
+  fNbins(0),
+  fMinimum(0.),
+  fMaximum(0.),
+  fEdges(),
+  fInverseWidths(),
+  fSegments()
+{
+  TArrayD binedges;
+  binning.CreateBinEdges(binedges);
+  Set(binedges.GetSize(), binedges.GetArray());
+}
+
+TBinLookup::TBinLookup(const TAxis &axis):
+  fMode(kFixed),
+  fNbins(0),
+  fMinimum(0.),
+  fMaximum(0.),
+  fEdges(),
+  fInverseWidths(),
+  fSegments()
+{
+  Set(axis);
+}
+
+void TBinLookup::Set(const TAxis &axis){
+  const TArrayD *binedges = axis.GetXbins();
+  if(binedges->GetSize()){
+    Set(binedges->GetSize(), binedges->GetArray());
+    return;
+  }
+
+  // Fixed bins: the edges are only used for the bin widths
+  Int_t nbins = axis.GetNbins();
+  std::vector<Double_t> edges(nbins + 1);
+  for(Int_t ibin = 0; ibin < nbins; ibin++) edges[ibin] = axis.GetBinLowEdge(ibin + 1);
+  edges[nbins] = axis.GetXmax();
+  Set(nbins + 1, &edges[0]);
+  fMode = kFixed;
+  fSegments.clear();
+}
+
+void TBinLookup::Set(Int_t nedges, const Double_t *binedges){
+  fMode = kFixed;
+  fNbins = nedges > 1 ? nedges - 1 : 0;
+  fEdges.assign(binedges, binedges + (fNbins ? nedges : 0));
+  fInverseWidths.resize(fNbins);
+  fSegments.clear();
+  if(!fNbins){
+    fMinimum = fMaximum = 0.;
+    return;
+  }
+  fMinimum = fEdges.front();
+  fMaximum = fEdges.back();
+  for(Int_t ibin = 0; ibin < fNbins; ibin++) fInverseWidths[ibin] = 1./(fEdges[ibin+1] - fEdges[ibin]);
+
+  // Split the edges in ranges of equal bin width
+  Int_t firstbin = 1;
+  Double_t width = fEdges[1] - fEdges[0];
+  for(Int_t ibin = 2; ibin <= fNbins + 1; ibin++){
+    if(ibin <= fNbins && TMath::Abs(fEdges[ibin] - fEdges[ibin-1] - width) <= fgkWidthTolerance * width) continue;
+    if(static_cast<Int_t>(fSegments.size()) == fgkMaxSegments){
+      // Too many ranges, a search is faster
+      fSegments.clear();
+      fMode = kSearch;
+      return;
+    }
+    Segment_t segment;
+    segment.fMinimum = fEdges[firstbin-1];
+    segment.fInverseWidth = (ibin - firstbin) / (fEdges[ibin-1] - fEdges[firstbin-1]);
+    segment.fFirstBin = firstbin;
+    segment.fLastBin = ibin - 1;
+    fSegments.push_back(segment);
+    if(ibin <= fNbins){
+      firstbin = ibin;
+      width = fEdges[ibin] - fEdges[ibin-1];
+    }
+  }
+  fMode = kSegmented;
+}
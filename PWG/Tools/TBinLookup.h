@@ -0,0 +1,189 @@
+#ifndef TBINLOOKUP_H
+#define TBINLOOKUP_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+class TArrayD;
+class TAxis;
+class TBinning;
+
+#include <vector>
+#include <Rtypes.h>
+
+/**
+ * @class TBinLookup
+ * @brief Fast bin lookup for a fixed set of bin edges, used in the fill path of histograms
+ * @ingroup Histmanager
+ *
+ * Histograms created from a TBinning get variable bin edges, so that TAxis::FindBin
+ * falls back to a binary search for every fill. TBinLookup analyses the bin edges once
+ * and selects the fastest way to find the bin of a value:
+ * - Fixed: axes with fixed bins, using the same formula as TAxis::FindBin
+ * - Segmented: the edges consist of at most fgkMaxSegments ranges with equal bin width
+ *   (as created by TLinearBinning and TCustomBinning). The range is found with a short
+ *   branch-free scan, the bin within the range is computed in constant time and then
+ *   checked against the bin edges
+ * - Search: any other binning, using a binary search without data-dependent branches
+ *
+ * In all cases the result is the same as TAxis::FindFixBin for the corresponding axis,
+ * including the ROOT conventions for the underflow (0) and overflow (nbins+1) bins:
+ *
+ * ~~~{.cxx}
+ * TBinLookup lookup(TCustomBinning(...));
+ * Int_t bin = lookup.FindBin(x);
+ * ~~~
+ *
+ * The lookup keeps a copy of the bin edges. It must be rebuilt when the axis it was
+ * created from is changed.
+ */
+class TBinLookup {
+public:
+
+  /**
+   * @enum ELookupMode_t
+   * @brief Method used to find the bin
+   */
+  enum ELookupMode_t {
+    kFixed = 0,       ///< Fixed bins, bin computed from minimum and maximum
+    kSegmented = 1,   ///< Ranges with equal bin width, bin computed within the range
+    kSearch = 2       ///< Variable bins, binary search on the bin edges
+  };
+
+  /**
+   * Constructor, creating an empty lookup (all values are in the overflow bin)
+   */
+  TBinLookup();
+
+  /**
+   * Constructor, creating a lookup from a set of bin edges
+   * @param[in] binedges Bin edges in increasing order
+   */
+  TBinLookup(const TArrayD &binedges);
+
+  /**
+   * Constructor, creating a lookup from the bin edges of a binning
+   * @param[in] binning Binning description
+   */
+  TBinLookup(const TBinning &binning);
+
+  /**
+   * Constructor, creating a lookup from the bins of a histogram axis
+   * @param[in] axis Histogram axis
+   */
+  TBinLookup(const TAxis &axis);
+
+  /**
+   * Destructor
+   */
+  ~TBinLookup() {}
+
+  /**
+   * Build the lookup from a set of bin edges
+   * @param[in] nedges Number of bin edges (number of bins + 1)
+   * @param[in] binedges Bin edges in increasing order
+   */
+  void Set(Int_t nedges, const Double_t *binedges);
+
+  /**
+   * Build the lookup from the bins of a histogram axis
+   * @param[in] axis Histogram axis
+   */
+  void Set(const TAxis &axis);
+
+  /**
+   * Find the bin of a value
+   * @param[in] x Value
+   * @return Bin number (0 for underflow, nbins+1 for overflow)
+   */
+  inline Int_t FindBin(Double_t x) const;
+
+  /**
+   * Get the width of a bin
+   * @param[in] bin Bin number (1 to nbins)
+   * @return Width of the bin
+   */
+  Double_t GetBinWidth(Int_t bin) const { return fEdges[bin] - fEdges[bin-1]; }
+
+  /**
+   * Get the inverse width of a bin, precomputed when the lookup is built
+   * @param[in] bin Bin number (1 to nbins)
+   * @return Inverse width of the bin
+   */
+  Double_t GetInverseBinWidth(Int_t bin) const { return fInverseWidths[bin-1]; }
+
+  /**
+   * Get the number of bins
+   * @return Number of bins
+   */
+  Int_t GetNbins() const { return fNbins; }
+
+  /**
+   * Get the method used to find the bin
+   * @return Lookup mode
+   */
+  ELookupMode_t GetMode() const { return fMode; }
+
+  static const Int_t fgkMaxSegments;          ///< Maximum number of ranges with equal bin width for the segmented lookup
+  static const Double_t fgkWidthTolerance;    ///< Relative tolerance on the bin width within a range
+
+private:
+
+  /**
+   * @struct Segment_t
+   * @brief Range of bins with equal width
+   */
+  struct Segment_t {
+    Double_t        fMinimum;                 ///< Lower edge of the range
+    Double_t        fInverseWidth;            ///< Inverse (average) bin width in the range
+    Int_t           fFirstBin;                ///< First bin of the range
+    Int_t           fLastBin;                 ///< Last bin of the range
+  };
+
+  Int_t FindBinSegmented(Double_t x) const;
+  Int_t FindBinSearch(Double_t x) const;
+
+  ELookupMode_t             fMode;            ///< Method used to find the bin
+  Int_t                     fNbins;           ///< Number of bins
+  Double_t                  fMinimum;         ///< Lower edge of the first bin
+  Double_t                  fMaximum;         ///< Upper edge of the last bin
+  std::vector<Double_t>     fEdges;           ///< Bin edges
+  std::vector<Double_t>     fInverseWidths;   ///< Inverse bin widths
+  std::vector<Segment_t>    fSegments;        ///< Ranges with equal bin width (segmented lookup)
+};
+
+Int_t TBinLookup::FindBin(Double_t x) const {
+  // same conventions as TAxis::FindFixBin, including NaN ending up in the overflow bin
+  if(x < fMinimum) return 0;
+  if(!(x < fMaximum)) return fNbins + 1;
+  switch(fMode){
+  case kFixed: return 1 + Int_t(fNbins * (x - fMinimum) / (fMaximum - fMinimum));
+  case kSegmented: return FindBinSegmented(x);
+  default: return FindBinSearch(x);
+  };
+}
+
+inline Int_t TBinLookup::FindBinSegmented(Double_t x) const {
+  Int_t isegment = 0;
+  for(UInt_t iseg = 1; iseg < fSegments.size(); iseg++) isegment += (x >= fSegments[iseg].fMinimum);
+  const Segment_t &segment = fSegments[isegment];
+  Int_t bin = segment.fFirstBin + Int_t((x - segment.fMinimum) * segment.fInverseWidth);
+  if(bin > segment.fLastBin) bin = segment.fLastBin;
+  // rounding of the width: move to the bin whose edges contain x
+  while(bin > segment.fFirstBin && x < fEdges[bin-1]) bin--;
+  while(bin < segment.fLastBin && !(x < fEdges[bin])) bin++;
+  return bin;
+}
+
+inline Int_t TBinLookup::FindBinSearch(Double_t x) const {
+  // last edge <= x, number of iterations only depends on the number of bins
+  const Double_t *base = &fEdges[0];
+  Int_t length = fNbins + 1;
+  while(length > 1){
+    Int_t half = length / 2;
+    base = (base[half] <= x) ? base + half : base;
+    length -= half;
+  }
+  return Int_t(base - &fEdges[0]) + 1;
+}
+
+#endif /* TBINLOOKUP_H */
@@ -33,7 +33,10 @@
 #include <TString.h>
 
 #include "TBinning.h"
+#include "TCustomBinning.h"
 #include "THistManager.h"
+#include "TLinearBinning.h"
+#include "TVariableBinning.h"
 
 /// \cond CLASSIMP
 ClassImp(THistManager)
@@ -409,38 +412,18 @@ void THistManager::SetObject(TObject * const o, const char *group) {
 }
 
 void THistManager::FillTH1(const char *name, double x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optionstring(opt);
-	if(optionstring.Contains("w")){
-	  // use bin width as weight
-	  Int_t bin = hist->GetXaxis()->FindBin(x);
-	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
-	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
-	}
-	hist->Fill(x, weight);
+  TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::FillTH1"));
+  if(!hist){
+    Fatal("THistManager::FillTH1", "Histogram %s is not of type TH1", name);
+    return;
+  }
+  FillTH1Kernel(hist, x, weight, ParseWidthCorrection(opt, 1));
 }
 
 void THistManager::FillTH1(const char *name, const char *label, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH1", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH1 *hist = dynamic_cast<TH1 *>(parent->FindObject(hname));
+  TH1 *hist = dynamic_cast<TH1 *>(FindHistogram(name, "THistManager::FillTH1"));
   if(!hist){
-    Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    Fatal("THistManager::FillTH1", "Histogram %s is not of type TH1", name);
     return;
   }
 	TString optionstring(opt);
@@ -456,65 +439,22 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 }
 
 void THistManager::FillTH2(const char *name, double x, double y, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(x, y, myweight);
+  TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
+  if(!hist){
+    Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
+    return;
+  }
+  FillTH2Kernel(hist, x, y, weight, ParseWidthCorrection(opt, 2));
 }
 
 void THistManager::FillTH2(const char *name, double *point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	hist->Fill(point[0], point[1], weight);
+  FillTH2(name, point[0], point[1], weight, opt);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
-  TString dirname(basename(name)), hname(histname(name));
-  THashList *parent(FindGroup(dirname));
-  if(!parent){
-    Fatal("THistManager::FillTH2", "Parent group %s does not exist", dirname.Data());
-    return;
-  }
-  TH2 *hist = dynamic_cast<TH2 *>(parent->FindObject(hname));
+  TH2 *hist = dynamic_cast<TH2 *>(FindHistogram(name, "THistManager::FillTH2"));
   if(!hist){
-    Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    Fatal("THistManager::FillTH2", "Histogram %s is not of type TH2", name);
     return;
   }
   TString optstring(opt);
@@ -531,98 +471,198 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(x, y, z, weight);
+  TH3 *hist = dynamic_cast<TH3 *>(FindHistogram(name, "THistManager::FillTH3"));
+  if(!hist){
+    Fatal("THistManager::FillTH3", "Histogram %s is not of type TH3", name);
+    return;
+  }
+  FillTH3Kernel(hist, x, y, z, weight, ParseWidthCorrection(opt, 3));
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTH3", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	TH3 *hist = dynamic_cast<TH3 *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	if(optstring.Contains("wx")){
-	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
-	}
-	if(optstring.Contains("wy")){
-	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
-	}
-	if(optstring.Contains("wz")){
-	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
-	}
-	hist->Fill(point[0], point[1], point[2], weight);
+  FillTH3(name, point[0], point[1], point[2], weight, opt);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
-	TString dirname(basename(name)), hname(histname(name));
-	THashList *parent(FindGroup(dirname));
-	if(!parent){
-		Fatal("THistManager::FillTHnSparse", "Parent group %s does not exist", dirname.Data());
-		return;
-	}
-	THnSparseD *hist = dynamic_cast<THnSparseD *>(parent->FindObject(hname));
-	if(!hist){
-		Fatal("THistManager::FillTHnSparse", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-		return;
-	}
-	TString optstring(opt);
-	Double_t myweight = optstring.Contains("w") ? 1. : weight;
-	for(Int_t iaxis = 0; iaxis < hist->GetNdimensions(); iaxis++){
-	  std::stringstream weighthandler;
-	  weighthandler << "w" << iaxis;
-	  if(optstring.Contains(weighthandler.str().c_str())){
-	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
-	  }
-	}
-
-	hist->Fill(x, weight);
+  THnBase *hist = dynamic_cast<THnBase *>(FindHistogram(name, "THistManager::FillTHnSparse"));
+  if(!hist){
+    Fatal("THistManager::FillTHnSparse", "Histogram %s is not of type THnSparse", name);
+    return;
+  }
+  FillTHnKernel(hist, x, weight, ParseWidthCorrection(opt, hist->GetNdimensions()));
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
+  TProfile *hist = dynamic_cast<TProfile *>(FindHistogram(name, "THistManager::FillTProfile"));
+  if(!hist){
+    Fatal("THistManager::FillTProfile", "Histogram %s is not of type TProfile", name);
+    return;
+  }
+  hist->Fill(x, y, weight);
+}
+
+THistManager::THistHandle THistManager::GetHandleTH1(const char *name, Option_t *opt){
+  return RegisterHandle(name, kTHMTH1, opt);
+}
+
+THistManager::THistHandle THistManager::GetHandleTH2(const char *name, Option_t *opt){
+  return RegisterHandle(name, kTHMTH2, opt);
+}
+
+THistManager::THistHandle THistManager::GetHandleTH3(const char *name, Option_t *opt){
+  return RegisterHandle(name, kTHMTH3, opt);
+}
+
+THistManager::THistHandle THistManager::GetHandleTHnSparse(const char *name, Option_t *opt){
+  return RegisterHandle(name, kTHMTHn, opt);
+}
+
+THistManager::THistHandle THistManager::GetHandleProfile(const char *name){
+  return RegisterHandle(name, kTHMProfile, "");
+}
+
+void THistManager::FillTH1(const THistHandle &handle, double x, double weight){
+  const THistHandleEntry &entry = GetHandleEntry(handle, kTHMTH1);
+  FillTH1Kernel(static_cast<TH1 *>(entry.fObject), x, weight, entry.fWidthCorrection, HandleLookups(entry));
+}
+
+void THistManager::FillTH2(const THistHandle &handle, double x, double y, double weight){
+  const THistHandleEntry &entry = GetHandleEntry(handle, kTHMTH2);
+  FillTH2Kernel(static_cast<TH2 *>(entry.fObject), x, y, weight, entry.fWidthCorrection, HandleLookups(entry));
+}
+
+void THistManager::FillTH3(const THistHandle &handle, double x, double y, double z, double weight){
+  const THistHandleEntry &entry = GetHandleEntry(handle, kTHMTH3);
+  FillTH3Kernel(static_cast<TH3 *>(entry.fObject), x, y, z, weight, entry.fWidthCorrection, HandleLookups(entry));
+}
+
+void THistManager::FillTHnSparse(const THistHandle &handle, const double *x, double weight){
+  const THistHandleEntry &entry = GetHandleEntry(handle, kTHMTHn);
+  FillTHnKernel(static_cast<THnBase *>(entry.fObject), x, weight, entry.fWidthCorrection, HandleLookups(entry));
+}
+
+void THistManager::FillProfile(const THistHandle &handle, double x, double y, double weight){
+  const THistHandleEntry &entry = GetHandleEntry(handle, kTHMProfile);
+  static_cast<TProfile *>(entry.fObject)->Fill(x, y, weight);
+}
+
+THistManager::THistHandle THistManager::RegisterHandle(const char *name, THMHistType_t type, Option_t *opt){
+  TObject *hist = FindHistogram(name, "THistManager::RegisterHandle");
+  // Perform the type check once here - the handle-based fill relies on it
+  Int_t ndim(0);
+  switch(type){
+  case kTHMTH1:     if(dynamic_cast<TH1 *>(hist)) ndim = 1; break;
+  case kTHMTH2:     if(dynamic_cast<TH2 *>(hist)) ndim = 2; break;
+  case kTHMTH3:     if(dynamic_cast<TH3 *>(hist)) ndim = 3; break;
+  case kTHMTHn:     if(THnBase *hn = dynamic_cast<THnBase *>(hist)) ndim = hn->GetNdimensions(); break;
+  case kTHMProfile: if(dynamic_cast<TProfile *>(hist)) ndim = 1; break;
+  };
+  if(!ndim){
+    Fatal("THistManager::RegisterHandle", "Histogram %s is not of the requested type", name);
+    return THistHandle();
+  }
+  THistHandleEntry entry;
+  entry.fObject = hist;
+  entry.fType = type;
+  entry.fWidthCorrection = type == kTHMProfile ? 0 : ParseWidthCorrection(opt, ndim);
+  if(entry.fWidthCorrection){
+    // bin lookups for the bin width correction, built once here instead of searching the axis for each fill
+    for(Int_t iaxis = 0; iaxis < ndim && iaxis < 31; iaxis++){
+      const TAxis *axis(NULL);
+      switch(type){
+      case kTHMTH1: case kTHMTH2: case kTHMTH3:
+        axis = iaxis == 0 ? static_cast<TH1 *>(hist)->GetXaxis() : (iaxis == 1 ? static_cast<TH1 *>(hist)->GetYaxis() : static_cast<TH1 *>(hist)->GetZaxis());
+        break;
+      default:
+        axis = static_cast<THnBase *>(hist)->GetAxis(iaxis);
+      };
+      entry.fLookups.push_back(TBinLookup(*axis));
+    }
+  }
+  fHandles.push_back(entry);
+  return THistHandle(fHandles.size() - 1);
+}
+
+const THistManager::THistHandleEntry &THistManager::GetHandleEntry(const THistHandle &handle, THMHistType_t type) const {
+  if(handle.GetIndex() < 0 || handle.GetIndex() >= static_cast<Int_t>(fHandles.size()))
+    Fatal("THistManager::GetHandleEntry", "Invalid histogram handle %d", handle.GetIndex());
+  const THistHandleEntry &entry = fHandles[handle.GetIndex()];
+  if(entry.fType != type)
+    Fatal("THistManager::GetHandleEntry", "Histogram %s was registered with a different type", entry.fObject->GetName());
+  return entry;
+}
+
+UInt_t THistManager::ParseWidthCorrection(Option_t *opt, Int_t ndim){
+  TString optstring(opt);
+  if(!optstring.Contains("w")) return 0;
+  UInt_t mask = kTHMReplaceWeight;
+  if(ndim == 1) {
+    mask |= 1;
+  } else if(ndim <= 3) {
+    const char *axisopts[3] = {"wx", "wy", "wz"};
+    for(Int_t iaxis = 0; iaxis < ndim; iaxis++)
+      if(optstring.Contains(axisopts[iaxis])) mask |= (1u << iaxis);
+  } else {
+    for(Int_t iaxis = 0; iaxis < ndim && iaxis < 31; iaxis++){
+      std::stringstream weighthandler;
+      weighthandler << "w" << iaxis;
+      if(optstring.Contains(weighthandler.str().c_str())) mask |= (1u << iaxis);
+    }
+  }
+  return mask;
+}
+
+double THistManager::BinWidthWeight(const TAxis *axis, double x){
+  Int_t bin = axis->FindFixBin(x);
+  // check if not overflow or underflow bin
+  if(bin < 1 || bin > axis->GetNbins()) return 1.;
+  return 1./axis->GetBinWidth(bin);
+}
+
+void THistManager::FillTH1Kernel(TH1 *hist, double x, double weight, UInt_t widthcorrection, const TBinLookup *lookups){
+  if(widthcorrection) weight = AxisWeight(widthcorrection, hist->GetXaxis(), lookups, 0, x);
+  hist->Fill(x, weight);
+}
+
+void THistManager::FillTH2Kernel(TH2 *hist, double x, double y, double weight, UInt_t widthcorrection, const TBinLookup *lookups){
+  if(widthcorrection){
+    weight = AxisWeight(widthcorrection, hist->GetXaxis(), lookups, 0, x)
+           * AxisWeight(widthcorrection, hist->GetYaxis(), lookups, 1, y);
+  }
+  hist->Fill(x, y, weight);
+}
+
+void THistManager::FillTH3Kernel(TH3 *hist, double x, double y, double z, double weight, UInt_t widthcorrection, const TBinLookup *lookups){
+  if(widthcorrection){
+    weight = AxisWeight(widthcorrection, hist->GetXaxis(), lookups, 0, x)
+           * AxisWeight(widthcorrection, hist->GetYaxis(), lookups, 1, y)
+           * AxisWeight(widthcorrection, hist->GetZaxis(), lookups, 2, z);
+  }
+  hist->Fill(x, y, z, weight);
+}
+
+void THistManager::FillTHnKernel(THnBase *hist, const double *x, double weight, UInt_t widthcorrection, const TBinLookup *lookups){
+  if(widthcorrection){
+    weight = 1.;
+    for(Int_t iaxis = 0; iaxis < hist->GetNdimensions() && iaxis < 31; iaxis++)
+      weight *= AxisWeight(widthcorrection, hist->GetAxis(iaxis), lookups, iaxis, x[iaxis]);
+  }
+  hist->Fill(x, weight);
+}
+
+TObject *THistManager::FindHistogram(const char *name, const char *method) const {
   TString dirname(basename(name)), hname(histname(name));
   THashList *parent(FindGroup(dirname));
-  if(!parent)
-		Fatal("THistManager::FillTProfile", "Parent group %s does not exist", dirname.Data());
-  TProfile *hist = dynamic_cast<TProfile *>(parent->FindObject(hname));
-  if(!hist)
-		Fatal("THistManager::FillTProfile", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
-  hist->Fill(x, y, weight);
+  if(!parent){
+    Fatal(method, "Parent group %s does not exist", dirname.Data());
+    return NULL;
+  }
+  TObject *hist = parent->FindObject(hname);
+  if(!hist){
+    Fatal(method, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+    return NULL;
+  }
+  return hist;
 }
 
 TObject *THistManager::FindObject(const char *name) const {
@@ -1030,6 +1070,143 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1", "Test handle fill 1D histogram", 1, 0., 1.);
+    testmgr.CreateTH1("TestWidth", "Test handle fill 1D histogram with bin width correction", 1, 0., 0.5);
+    testmgr.CreateTH2("Test2", "Test handle fill 2D histogram", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Test3", "Test handle fill 3D histogram", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("TestN", "Test handle fill THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("TestProfile", "Test handle fill Profile histogram", 1, 0., 1.);
+
+    THistManager::THistHandle handle1 = testmgr.GetHandleTH1("Group1/Test1"),
+                              handleWidth = testmgr.GetHandleTH1("TestWidth", "w"),
+                              handle2 = testmgr.GetHandleTH2("Test2"),
+                              handle3 = testmgr.GetHandleTH3("Test3"),
+                              handleN = testmgr.GetHandleTHnSparse("TestN"),
+                              handleProfile = testmgr.GetHandleProfile("TestProfile");
+
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      testmgr.FillTH1(handle1, 0.5);
+      testmgr.FillTH1(handleWidth, 0.25);
+      testmgr.FillTH2(handle2, 0.5, 0.5);
+      testmgr.FillTH3(handle3, 0.5, 0.5, 0.5);
+      testmgr.FillTHnSparse(handleN, point);
+      testmgr.FillProfile(handleProfile, 0.5, 1.);
+    }
+
+    // Evaluate test
+    // tell user why test has failed
+    bool success(true);
+
+    TH1 *test1 = dynamic_cast<TH1 *>(testmgr.FindObject("Group1/Test1"));
+    if(!test1 || TMath::Abs(test1->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Not found or mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    TH1 *testwidth = dynamic_cast<TH1 *>(testmgr.FindObject("TestWidth"));
+    if(!testwidth || TMath::Abs(testwidth->GetBinContent(1) - 200) > DBL_EPSILON){
+      std::cout << "TestWidth: Not found or mismatch in values, expected 200" << std::endl;
+      success = false;
+    }
+    TH2 *test2 = dynamic_cast<TH2 *>(testmgr.FindObject("Test2"));
+    if(!test2 || TMath::Abs(test2->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test2: Not found or mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    TH3 *test3 = dynamic_cast<TH3 *>(testmgr.FindObject("Test3"));
+    if(!test3 || TMath::Abs(test3->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test3: Not found or mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    THnSparse *testN = dynamic_cast<THnSparse *>(testmgr.FindObject("TestN"));
+    int index[4] = {1,1,1,1};
+    if(!testN || TMath::Abs(testN->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "TestN: Not found or mismatch in values, expected 100" << std::endl;
+      success = false;
+    }
+    TProfile *testProfile = dynamic_cast<TProfile *>(testmgr.FindObject("TestProfile"));
+    if(!testProfile || TMath::Abs(testProfile->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "TestProfile: Not found or mismatch in values, expected 1" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
+  int THistManagerTestSuite::TestBinLookup(){
+    TCustomBinning custombinning;
+    custombinning.SetMinimum(0.);
+    custombinning.AddStep(5., 0.1);
+    custombinning.AddStep(10., 0.5);
+    custombinning.AddStep(50., 5.);
+    // no two adjacent bins with the same width: too many ranges for the segmented lookup
+    double variableedges[11] = {0., 0.3, 0.4, 1., 2.5, 2.6, 3.5, 5., 7., 10., 14.};
+    const TBinning *binnings[3] = {new TLinearBinning(100, -1., 1.), &custombinning, new TVariableBinning(10, variableedges)};
+    const char *names[3] = {"linear", "custom", "variable"};
+    TBinLookup::ELookupMode_t modes[3] = {TBinLookup::kSegmented, TBinLookup::kSegmented, TBinLookup::kSearch};
+
+    // Evaluate test
+    // tell user why test has failed
+    bool success(true);
+    for(int ibinning = 0; ibinning < 3; ibinning++){
+      TArrayD edges;
+      binnings[ibinning]->CreateBinEdges(edges);
+      TAxis axis(edges.GetSize() - 1, edges.GetArray());
+      TBinLookup lookup(*binnings[ibinning]);
+      if(lookup.GetMode() != modes[ibinning]){
+        std::cout << names[ibinning] << ": Unexpected lookup mode " << lookup.GetMode() << std::endl;
+        success = false;
+      }
+      // bin edges, values close to the bin edges and values outside the range
+      std::vector<double> values;
+      for(int iedge = 0; iedge < edges.GetSize(); iedge++){
+        values.push_back(edges[iedge]);
+        values.push_back(edges[iedge] - 1e-9);
+        values.push_back(edges[iedge] + 1e-9);
+      }
+      for(int ivalue = 0; ivalue < 1000; ivalue++) values.push_back(edges[0] - 1. + (edges[edges.GetSize()-1] - edges[0] + 2.) * ivalue / 1000.);
+      int nmismatch(0);
+      for(std::vector<double>::iterator value = values.begin(); value != values.end(); ++value)
+        if(lookup.FindBin(*value) != axis.FindFixBin(*value)) nmismatch++;
+      if(nmismatch){
+        std::cout << names[ibinning] << ": " << nmismatch << " values in a different bin than in TAxis" << std::endl;
+        success = false;
+      }
+    }
+    delete binnings[0];
+    delete binnings[2];
+
+    TAxis fixedaxis(100, -1., 1.);
+    TBinLookup fixedlookup(fixedaxis);
+    for(int ivalue = 0; ivalue < 1000; ivalue++){
+      double value = -1.5 + 3. * ivalue / 1000.;
+      if(fixedlookup.FindBin(value) != fixedaxis.FindFixBin(value)){
+        std::cout << "fixed: Value " << value << " in a different bin than in TAxis" << std::endl;
+        success = false;
+        break;
+      }
+    }
+
+    // bin width correction of handle-based fills with a custom binning
+    THistManager testmgr("testmgr");
+    testmgr.CreateTH1("TestCustomWidth", "Test handle fill with bin width correction", custombinning);
+    THistManager::THistHandle handle = testmgr.GetHandleTH1("TestCustomWidth", "w");
+    testmgr.FillTH1(handle, 2.55);
+    testmgr.FillTH1(handle, 7.2);
+    testmgr.FillTH1(handle, 60.);
+    TH1 *testwidth = dynamic_cast<TH1 *>(testmgr.FindObject("TestCustomWidth"));
+    if(!testwidth || TMath::Abs(testwidth->GetBinContent(testwidth->FindBin(2.55)) - 10.) > 1e-6
+        || TMath::Abs(testwidth->GetBinContent(testwidth->FindBin(7.2)) - 2.) > 1e-6
+        || TMath::Abs(testwidth->GetBinContent(testwidth->GetNbinsX() + 1) - 1.) > 1e-6){
+      std::cout << "TestCustomWidth: Not found or mismatch in values, expected 10, 2 and 1 (overflow)" << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1227,14 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
+    std::cout << "Running test: Bin lookup" << std::endl;
+    testresult += testsuite.TestBinLookup();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1257,14 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
+
+  int TestRunBinLookup(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestBinLookup();
+  }
 }
@@ -7,6 +7,8 @@
 #include <TIterator.h>
 #include <TNamed.h>
 #include <iterator>
+#include <vector>
+#include "TBinLookup.h"
 
 class TArrayD;
 class TAxis;
@@ -15,6 +17,7 @@ class TList;
 class TH1;
 class TH2;
 class TH3;
+class THnBase;
 class THnSparse;
 class TProfile;
 
@@ -95,6 +98,25 @@ class TProfile;
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
  * the weight is calculated for all directions at the same time.
+ *
+ * ## Handle-based filling
+ *
+ * Filling via the histogram name requires tokenizing the name, searching the
+ * histogram in the groups and parsing the fill options for every fill. For
+ * histograms filled many times per event the histogram can be registered once
+ * and filled via a handle instead:
+ *
+ * ~~~{.cxx}
+ * THistManager::THistHandle hptHandle = mgr.GetHandleTH1("hPt");
+ * ...
+ * mgr.FillTH1(hptHandle, pt);
+ * ~~~
+ *
+ * Fill options (i.e. bin width correction) are specified when obtaining
+ * the handle. The bin width correction of handle-based fills uses a
+ * TBinLookup per axis, built at registration time, instead of searching
+ * the bin in the axis for every fill. The binning of histograms filled via
+ * handles must therefore not change after the handle is obtained.
  */
 class THistManager : public TNamed {
 public:
@@ -229,6 +251,40 @@ public:
     iterator();
   };
 
+  /**
+   * @class THistHandle
+   * @brief Lightweight handle to a histogram registered for fast filling
+   * @ingroup Histmanager
+   *
+   * Handles are obtained once via the GetHandle methods (i.e. in
+   * UserCreateOutputObjects) and passed to the handle-based Fill methods
+   * in the event loop. The handle-based Fill methods neither tokenize the
+   * histogram path nor look up the histogram in the groups or evaluate
+   * the fill options: all this is done once at registration time. Handles
+   * are only valid for the histogram manager they were obtained from.
+   */
+  class THistHandle {
+  public:
+    THistHandle(): fIndex(-1) {}
+    explicit THistHandle(Int_t index): fIndex(index) {}
+    ~THistHandle() {}
+
+    /**
+     * @brief Check whether the handle points to a registered histogram
+     * @return True if the handle is valid
+     */
+    Bool_t IsValid() const { return fIndex >= 0; }
+
+    /**
+     * @brief Get the index of the histogram in the handle cache
+     * @return Index in the handle cache
+     */
+    Int_t GetIndex() const { return fIndex; }
+
+  private:
+    Int_t                       fIndex;               ///< Index in the handle cache of the histogram manager
+  };
+
   /**
    * @brief Default constructor.
    *
@@ -634,6 +690,98 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Register a 1D histogram for handle-based filling.
+   *
+   * Looking up the histogram and parsing of the fill options is
+   * done only once here. Registering the same histogram again
+   * creates a new handle (i.e. with different fill options).
+   * @param[in] name Name of the histogram (including parent group(s))
+   * @param[in] opt Fill options applied for every fill with the handle
+   * @return Handle to be used in the FillTH1 method
+   * @throw Fatal in case the histogram doesn't exist or is not of type TH1
+   */
+  THistHandle GetHandleTH1(const char *name, Option_t *opt = "");
+
+  /**
+   * @brief Register a 2D histogram for handle-based filling.
+   * @param[in] name Name of the histogram (including parent group(s))
+   * @param[in] opt Fill options applied for every fill with the handle
+   * @return Handle to be used in the FillTH2 method
+   * @throw Fatal in case the histogram doesn't exist or is not of type TH2
+   */
+  THistHandle GetHandleTH2(const char *name, Option_t *opt = "");
+
+  /**
+   * @brief Register a 3D histogram for handle-based filling.
+   * @param[in] name Name of the histogram (including parent group(s))
+   * @param[in] opt Fill options applied for every fill with the handle
+   * @return Handle to be used in the FillTH3 method
+   * @throw Fatal in case the histogram doesn't exist or is not of type TH3
+   */
+  THistHandle GetHandleTH3(const char *name, Option_t *opt = "");
+
+  /**
+   * @brief Register a n-dimensional histogram for handle-based filling.
+   * @param[in] name Name of the histogram (including parent group(s))
+   * @param[in] opt Fill options applied for every fill with the handle
+   * @return Handle to be used in the FillTHnSparse method
+   * @throw Fatal in case the histogram doesn't exist or is not of type THnBase
+   */
+  THistHandle GetHandleTHnSparse(const char *name, Option_t *opt = "");
+
+  /**
+   * @brief Register a profile histogram for handle-based filling.
+   * @param[in] name Name of the profile histogram (including parent group(s))
+   * @return Handle to be used in the FillProfile method
+   * @throw Fatal in case the histogram doesn't exist or is not of type TProfile
+   */
+  THistHandle GetHandleProfile(const char *name);
+
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   * @param[in] handle Handle obtained from GetHandleTH1
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH1(const THistHandle &handle, double x, double weight = 1.);
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] handle Handle obtained from GetHandleTH2
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH2(const THistHandle &handle, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] handle Handle obtained from GetHandleTH3
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH3(const THistHandle &handle, double x, double y, double z, double weight = 1.);
+
+  /**
+   * @brief Fill a n-dimensional histogram via its handle.
+   * @param[in] handle Handle obtained from GetHandleTHnSparse
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTHnSparse(const THistHandle &handle, const double *x, double weight = 1.);
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] handle Handle obtained from GetHandleProfile
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillProfile(const THistHandle &handle, double x, double y, double weight = 1.);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -695,6 +843,127 @@ private:
 	THistManager(const THistManager &);
 	THistManager &operator=(const THistManager &);
 
+	/**
+	 * @enum THMHistType_t
+	 * @brief Histogram types supported by the handle-based fill
+	 */
+	enum THMHistType_t {
+	  kTHMTH1 = 0,          //!< TH1
+	  kTHMTH2 = 1,          //!< TH2
+	  kTHMTH3 = 2,          //!< TH3
+	  kTHMTHn = 3,          //!< THnBase (THnSparse)
+	  kTHMProfile = 4       //!< TProfile
+	};
+
+	/**
+	 * @brief Bit in the bin width correction mask indicating that the
+	 * user weight is replaced by the bin width weight. Lower bits flag the
+	 * axes for which the correction is applied.
+	 */
+	static const UInt_t kTHMReplaceWeight = 1u << 31;
+
+	/**
+	 * @struct THistHandleEntry
+	 * @brief Cached information for a histogram registered via a handle
+	 */
+	struct THistHandleEntry {
+	  TObject          *fObject;                ///< The histogram (not owned)
+	  THMHistType_t     fType;                  ///< Type the histogram was registered with
+	  UInt_t            fWidthCorrection;       ///< Bin width correction mask parsed from the fill options
+	  std::vector<TBinLookup> fLookups;         ///< Bin lookup per axis, only in case of bin width correction
+	};
+
+	/**
+	 * @brief Find the histogram, check its type and add it to the handle cache.
+	 * @param[in] name Name of the histogram (including parent group(s))
+	 * @param[in] type Expected histogram type
+	 * @param[in] opt Fill options
+	 * @return Handle to the histogram
+	 */
+	THistHandle RegisterHandle(const char *name, THMHistType_t type, Option_t *opt);
+
+	/**
+	 * @brief Get the entry in the handle cache connected to the handle
+	 *
+	 * Checks whether the handle is valid and of the expected type.
+	 * @param[in] handle Handle of the histogram
+	 * @param[in] type Expected histogram type
+	 * @return Entry in the handle cache
+	 */
+	const THistHandleEntry &GetHandleEntry(const THistHandle &handle, THMHistType_t type) const;
+
+	/**
+	 * @brief Get the bin lookups of the axes of a handle entry
+	 * @param[in] entry Entry in the handle cache
+	 * @return Bin lookups of all axes, NULL if the handle is filled without bin width correction
+	 */
+	static const TBinLookup *HandleLookups(const THistHandleEntry &entry) {
+	  return entry.fLookups.empty() ? NULL : &entry.fLookups[0];
+	}
+
+	/**
+	 * @brief Parse fill options for the bin width correction
+	 *
+	 * Encodes the axes for which the bin width correction is applied
+	 * (w for 1D histograms, wx, wy, wz for 2D and 3D histograms, w0, w1, ...
+	 * for n-dimensional histograms) as bit mask.
+	 * @param[in] opt Fill options
+	 * @param[in] ndim Number of dimensions of the histogram
+	 * @return Bin width correction mask
+	 */
+	static UInt_t ParseWidthCorrection(Option_t *opt, Int_t ndim);
+
+	/**
+	 * @brief Calculate the weight for the bin width correction.
+	 * @param[in] axis Axis for which the correction is applied
+	 * @param[in] x Value on the axis
+	 * @return Inverse bin width (1 for underflow and overflow bins)
+	 */
+	static double BinWidthWeight(const TAxis *axis, double x);
+
+	/**
+	 * @brief Calculate the weight for the bin width correction using the bin lookup of the axis.
+	 * @param[in] lookup Bin lookup of the axis for which the correction is applied
+	 * @param[in] x Value on the axis
+	 * @return Inverse bin width (1 for underflow and overflow bins)
+	 */
+	static double BinWidthWeight(const TBinLookup &lookup, double x) {
+	  Int_t bin = lookup.FindBin(x);
+	  return (bin < 1 || bin > lookup.GetNbins()) ? 1. : lookup.GetInverseBinWidth(bin);
+	}
+
+	/**
+	 * @brief Apply bin width correction to the weight of a fill.
+	 *
+	 * Uses the bin lookups of the handle (if any), otherwise the axis.
+	 * @param[in] mask Bin width correction mask
+	 * @param[in] axis Axis for which the correction is applied
+	 * @param[in] lookups Bin lookups of all axes of the histogram (can be NULL)
+	 * @param[in] iaxis Index of the axis in the histogram
+	 * @param[in] x Value on the axis
+	 * @return Weight factor for the axis
+	 */
+	static double AxisWeight(UInt_t mask, const TAxis *axis, const TBinLookup *lookups, Int_t iaxis, double x) {
+	  if(!(mask & (1u << iaxis))) return 1.;
+	  return lookups ? BinWidthWeight(lookups[iaxis], x) : BinWidthWeight(axis, x);
+	}
+
+	/**
+	 * @brief Find a histogram of a given type in the container.
+	 *
+	 * Raises a fatal error in case the parent group or the
+	 * histogram is not found.
+	 * @param[in] name Name of the histogram (including parent group(s))
+	 * @param[in] method Method name used in the error message
+	 * @return The histogram (not type checked)
+	 */
+	TObject *FindHistogram(const char *name, const char *method) const;
+
+	void FillTH1Kernel(TH1 *hist, double x, double weight, UInt_t widthcorrection, const TBinLookup *lookups = NULL);
+	void FillTH2Kernel(TH2 *hist, double x, double y, double weight, UInt_t widthcorrection, const TBinLookup *lookups = NULL);
+	void FillTH3Kernel(TH3 *hist, double x, double y, double z, double weight, UInt_t widthcorrection, const TBinLookup *lookups = NULL);
+	void FillTHnKernel(THnBase *hist, const double *x, double weight, UInt_t widthcorrection, const TBinLookup *lookups = NULL);
+
 
 	/**
 	 * @brief Find histogram group.
@@ -721,6 +990,7 @@ private:
 
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	std::vector<THistHandleEntry> fHandles; //!<! Cache of histograms registered for handle-based filling
 
   /// \cond CLASSIMP
 	ClassDef(THistManager, 1);  // Container for histograms
@@ -762,6 +1032,8 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms via handles
+ * - Bin lookups
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +1117,36 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether histograms registered via handles are filled properly
+   * Relies on: TestBuildSimpleHistograms, TestBuildGroupedHistograms
+   *
+   * Creating histograms of all types, the TH1 inside a group, register them via handles
+   * and fill them 100 times each with the same value via the handles. In addition a 1D histogram
+   * with bin width 0.5 is registered with bin width correction.
+   *
+   * Test passed:
+   * - All histograms have the expected value (100 for histograms, 1 for profile, 200 for the
+   *   histogram with bin width correction)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
+
+  /**
+   * Purpose of the test: Check whether the bin lookups find the same bins as TAxis
+   *
+   * Create bin lookups for a linear, a custom and a variable binning and for an axis
+   * with fixed bins, and compare the bins found for the bin edges, values close to
+   * the edges and values inside and outside the range. In addition a 1D histogram with
+   * custom binning is filled via a handle with bin width correction.
+   *
+   * Test passed:
+   * - The bin lookups use the expected lookup mode and find the same bins as TAxis
+   * - The histogram has the expected values (inverse bin width, 1 in the overflow bin)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestBinLookup();
 };
 
 /**
@@ -882,5 +1184,19 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
+/**
+ * Run the test for the bin lookups. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunBinLookup();
+
 }
 #endif
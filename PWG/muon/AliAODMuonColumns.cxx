@@ -0,0 +1,148 @@
+/**************************************************************************
+* Copyright(c) 1998-2013, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///
+/// Compact, columnar muon and dimuon information, written by the
+/// AliAODMuonReplicator next to the full muon tracks.
+///
+/// The pDCA is computed with the momentum at vertex and the DCA with respect
+/// to the primary vertex; AliMuonTrackCuts uses in addition the momentum
+/// averaged over the absorber, so the two differ by the mean energy loss.
+///
+/// The MC ancestor of a muon is its first ancestor which is not a muon,
+/// looked up once in the replicated MC particles, so that the source of
+/// a muon or a dimuon can be selected without walking the MC particles.
+///
+
+#include "AliAODMuonColumns.h"
+
+#include "AliAODMCParticle.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
+#include "AliAnalysisMuonUtility.h"
+#include "TClonesArray.h"
+#include "TMath.h"
+
+/// \cond CLASSIMP
+ClassImp(AliAODMuonColumns)
+/// \endcond
+
+//_____________________________________________________________________________
+AliAODMuonColumns::AliAODMuonColumns(const char* name)
+: TNamed(name,"compact muon and dimuon columns"),
+fPt(), fEta(), fPhi(), fPz(), fCharge(), fMatchTrigger(),
+fChi2perNDF(), fChi2MatchTrigger(), fPDCA(), fRabs(),
+fMCLabel(), fMCAncestorLabel(), fMCAncestorPdg(),
+fDimuonLeg1(), fDimuonLeg2(), fDimuonMass(), fDimuonPt(), fDimuonY(), fDimuonCharge()
+{
+  /// ctor
+}
+
+//_____________________________________________________________________________
+void AliAODMuonColumns::Clear(Option_t*)
+{
+  /// empty all the columns, keeping their capacity
+  fPt.clear(); fEta.clear(); fPhi.clear(); fPz.clear(); fCharge.clear(); fMatchTrigger.clear();
+  fChi2perNDF.clear(); fChi2MatchTrigger.clear(); fPDCA.clear(); fRabs.clear();
+  fMCLabel.clear(); fMCAncestorLabel.clear(); fMCAncestorPdg.clear();
+  fDimuonLeg1.clear(); fDimuonLeg2.clear(); fDimuonMass.clear(); fDimuonPt.clear();
+  fDimuonY.clear(); fDimuonCharge.clear();
+}
+
+//_____________________________________________________________________________
+void AliAODMuonColumns::AddMuon(const AliAODTrack& track, const AliAODVertex* vertex,
+                                const TClonesArray* mcParticles)
+{
+  /// append one muon track
+  ///
+  /// \param vertex primary vertex for the DCA (none: DCA as stored in the track)
+  /// \param mcParticles MC particles the label of the track refers to (if any)
+
+  fPt.push_back(track.Pt());
+  fEta.push_back(track.Eta());
+  fPhi.push_back(track.Phi());
+  fPz.push_back(track.Pz());
+  fCharge.push_back(track.Charge());
+  fMatchTrigger.push_back(AliAnalysisMuonUtility::GetMatchTrigger(&track));
+  fChi2perNDF.push_back(AliAnalysisMuonUtility::GetChi2perNDFtracker(&track));
+  fChi2MatchTrigger.push_back(AliAnalysisMuonUtility::GetChi2MatchTrigger(&track));
+  fRabs.push_back(AliAnalysisMuonUtility::GetRabs(&track));
+
+  Double_t dcaX = AliAnalysisMuonUtility::GetXatDCA(&track) - (vertex ? vertex->GetX() : 0.);
+  Double_t dcaY = AliAnalysisMuonUtility::GetYatDCA(&track) - (vertex ? vertex->GetY() : 0.);
+  fPDCA.push_back(track.P()*TMath::Sqrt(dcaX*dcaX+dcaY*dcaY));
+
+  Int_t label = track.GetLabel();
+  Int_t ancestor = -1;
+  Int_t ancestorPdg = 0;
+  if ( mcParticles && label >= 0 && label < mcParticles->GetEntriesFast() )
+  {
+    Int_t imother = static_cast<AliAODMCParticle*>(mcParticles->UncheckedAt(label))->GetMother();
+    while ( imother >= 0 && imother < mcParticles->GetEntriesFast() )
+    {
+      AliAODMCParticle* mother = static_cast<AliAODMCParticle*>(mcParticles->UncheckedAt(imother));
+      if ( TMath::Abs(mother->GetPdgCode()) != 13 )
+      {
+        ancestor = imother;
+        ancestorPdg = mother->GetPdgCode();
+        break;
+      }
+      imother = mother->GetMother();
+    }
+  }
+  fMCLabel.push_back(mcParticles ? label : -1);
+  fMCAncestorLabel.push_back(ancestor);
+  fMCAncestorPdg.push_back(ancestorPdg);
+}
+
+//_____________________________________________________________________________
+void AliAODMuonColumns::MakeDimuons()
+{
+  /// fill the dimuon columns with all the pairs of the muons added so far
+
+  Double_t m2 = AliAnalysisMuonUtility::MuonMass2();
+  Int_t nmu = GetNMuons();
+
+  for ( Int_t i = 0; i < nmu; ++i )
+  {
+    Double_t px1 = fPt[i]*TMath::Cos(fPhi[i]);
+    Double_t py1 = fPt[i]*TMath::Sin(fPhi[i]);
+    Double_t e1 = TMath::Sqrt(fPt[i]*fPt[i]+fPz[i]*fPz[i]+m2);
+
+    for ( Int_t j = i+1; j < nmu; ++j )
+    {
+      Double_t px = px1 + fPt[j]*TMath::Cos(fPhi[j]);
+      Double_t py = py1 + fPt[j]*TMath::Sin(fPhi[j]);
+      Double_t pz = fPz[i] + fPz[j];
+      Double_t e = e1 + TMath::Sqrt(fPt[j]*fPt[j]+fPz[j]*fPz[j]+m2);
+      Double_t mass2 = e*e - px*px - py*py - pz*pz;
+
+      fDimuonLeg1.push_back(i);
+      fDimuonLeg2.push_back(j);
+      fDimuonMass.push_back(mass2 > 0. ? TMath::Sqrt(mass2) : 0.);
+      fDimuonPt.push_back(TMath::Sqrt(px*px+py*py));
+      fDimuonY.push_back(e > TMath::Abs(pz) ? 0.5*TMath::Log((e+pz)/(e-pz)) : 0.);
+      fDimuonCharge.push_back(fCharge[i]+fCharge[j]);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t AliAODMuonColumns::IsDimuonSameMCAncestor(Int_t i) const
+{
+  /// whether both legs of dimuon i come from the same MC ancestor
+  Int_t ancestor = fMCAncestorLabel[fDimuonLeg1[i]];
+  return ( ancestor >= 0 && ancestor == fMCAncestorLabel[fDimuonLeg2[i]] );
+}
@@ -0,0 +1,84 @@
+#ifndef ALIAODMUONCOLUMNS_H
+#define ALIAODMUONCOLUMNS_H
+
+/* Copyright(c) 1998-2013, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include "TNamed.h"
+
+class AliAODTrack;
+class AliAODVertex;
+class TClonesArray;
+
+///
+/// \class AliAODMuonColumns
+/// \brief Compact, columnar muon and dimuon information of one event
+///
+/// One entry per muon (resp. dimuon) in each of the flat columns, so that
+/// the branch can be split and read column by column.
+///
+
+class AliAODMuonColumns : public TNamed
+{
+public:
+  AliAODMuonColumns(const char* name="muonColumns");
+  virtual ~AliAODMuonColumns() {}
+
+  virtual void Clear(Option_t* opt="");
+
+  void AddMuon(const AliAODTrack& track, const AliAODVertex* vertex, const TClonesArray* mcParticles);
+  void MakeDimuons();
+
+  Int_t GetNMuons() const { return fPt.size(); }
+  Int_t GetNDimuons() const { return fDimuonMass.size(); }
+
+  // per muon
+  Float_t GetPt(Int_t i) const { return fPt[i]; }
+  Float_t GetEta(Int_t i) const { return fEta[i]; }
+  Float_t GetPhi(Int_t i) const { return fPhi[i]; }
+  Short_t GetCharge(Int_t i) const { return fCharge[i]; }
+  Short_t GetMatchTrigger(Int_t i) const { return fMatchTrigger[i]; }
+  Float_t GetChi2perNDF(Int_t i) const { return fChi2perNDF[i]; }
+  Float_t GetChi2MatchTrigger(Int_t i) const { return fChi2MatchTrigger[i]; }
+  Float_t GetPDCA(Int_t i) const { return fPDCA[i]; }
+  Float_t GetRabs(Int_t i) const { return fRabs[i]; }
+  Int_t GetMCLabel(Int_t i) const { return fMCLabel[i]; }
+  Int_t GetMCAncestorLabel(Int_t i) const { return fMCAncestorLabel[i]; }
+  Int_t GetMCAncestorPdg(Int_t i) const { return fMCAncestorPdg[i]; }
+
+  // per dimuon
+  Short_t GetDimuonLeg(Int_t i, Int_t leg) const { return leg ? fDimuonLeg2[i] : fDimuonLeg1[i]; }
+  Float_t GetDimuonMass(Int_t i) const { return fDimuonMass[i]; }
+  Float_t GetDimuonPt(Int_t i) const { return fDimuonPt[i]; }
+  Float_t GetDimuonY(Int_t i) const { return fDimuonY[i]; }
+  Short_t GetDimuonCharge(Int_t i) const { return fDimuonCharge[i]; }
+  Bool_t IsDimuonSameMCAncestor(Int_t i) const;
+
+private:
+  std::vector<Float_t> fPt; ///< transverse momentum
+  std::vector<Float_t> fEta; ///< pseudo-rapidity
+  std::vector<Float_t> fPhi; ///< azimuthal angle
+  std::vector<Float_t> fPz; ///< longitudinal momentum (for the dimuon kinematics)
+  std::vector<Short_t> fCharge; ///< charge
+  std::vector<Short_t> fMatchTrigger; ///< trigger matching (0: none, 1: Apt, 2: Lpt, 3: Hpt)
+  std::vector<Float_t> fChi2perNDF; ///< normalized chi2 of the tracker
+  std::vector<Float_t> fChi2MatchTrigger; ///< chi2 of the tracker-trigger matching
+  std::vector<Float_t> fPDCA; ///< p x DCA, with respect to the primary vertex
+  std::vector<Float_t> fRabs; ///< radial position at the end of the absorber
+  std::vector<Int_t> fMCLabel; ///< MC label (in the replicated MC particles), -1 if none
+  std::vector<Int_t> fMCAncestorLabel; ///< MC label of the first ancestor which is not a muon, -1 if none
+  std::vector<Int_t> fMCAncestorPdg; ///< PDG code of this ancestor, 0 if none
+
+  std::vector<Short_t> fDimuonLeg1; ///< index of the first muon
+  std::vector<Short_t> fDimuonLeg2; ///< index of the second muon
+  std::vector<Float_t> fDimuonMass; ///< invariant mass
+  std::vector<Float_t> fDimuonPt; ///< transverse momentum
+  std::vector<Float_t> fDimuonY; ///< rapidity
+  std::vector<Short_t> fDimuonCharge; ///< sum of the charges of the legs
+
+  ClassDef(AliAODMuonColumns,1) // compact muon and dimuon columns of muon AODs
+};
+
+#endif
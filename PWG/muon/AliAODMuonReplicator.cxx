@@ -28,6 +28,10 @@
 /// The vertices are filtered so that only the primary (and pileup) vertices make it
 /// to the output aods.
 ///
+/// Optionally (SetReplicateColumns) the kept muon tracks are also written as
+/// compact per-muon and per-dimuon columns (AliAODMuonColumns), which can be
+/// read without unpacking the full AliAODTrack objects.
+///
 /// \author L. Aphecetche (Subatech)
 
 #include "AliAODMuonReplicator.h"
@@ -35,6 +39,7 @@
 #include "AliAODEvent.h"
 #include "AliAODMCHeader.h"
 #include "AliAODMCParticle.h"
+#include "AliAODMuonColumns.h"
 #include "AliAODTZERO.h"
 #include "AliAODTrack.h"
 #include "AliAODVZERO.h"
@@ -66,9 +71,10 @@ fMCParticles(0x0),
 fMCHeader(0x0),
 fMCMode(mcMode),
 fLabelMap(),
-fParticleSelected(),
 fReplicateHeader(replicateHeader),
-fReplicateTracklets(replicateTracklets)
+fReplicateTracklets(replicateTracklets),
+fReplicateColumns(kFALSE),
+fColumns(0x0)
 {
   /// default ctor
   ///
@@ -92,51 +98,62 @@ AliAODMuonReplicator::~AliAODMuonReplicator()
 }
 
 //_____________________________________________________________________________
-void AliAODMuonReplicator::SelectParticle(Int_t i)
+Bool_t AliAODMuonReplicator::SelectParticle(Int_t i)
 {
   /// taking the absolute values here, need to take care
   /// of negative daughter and mother
   /// IDs when setting!
+  /// Returns kTRUE if the particle was not selected yet
   
-  if (!IsParticleSelected(TMath::Abs(i)))
-  {
-    fParticleSelected.Add(TMath::Abs(i),1);    
-  }
+  i = TMath::Abs(i);
+  if ( i >= fLabelMap.GetSize() || fLabelMap[i] >= 0 ) return kFALSE;
+  fLabelMap[i] = 0;
+  return kTRUE;
 }
 
 //_____________________________________________________________________________
-Bool_t AliAODMuonReplicator::IsParticleSelected(Int_t i)  
+Bool_t AliAODMuonReplicator::IsParticleSelected(Int_t i) const
 {
   /// taking the absolute values here, need to take
   /// care with negative daughter and mother
   /// IDs when setting!
-  return (fParticleSelected.GetValue(TMath::Abs(i))==1);
+  i = TMath::Abs(i);
+  return ( i < fLabelMap.GetSize() && fLabelMap[i] >= 0 );
 }
 
+//_____________________________________________________________________________
+void AliAODMuonReplicator::SelectAncestors(Int_t label, const TClonesArray& mcParticles)
+{
+  /// select particle label and all its ancestors. The walk stops at the
+  /// first ancestor already selected, as its own ancestors are then selected too
+  
+  while ( label >= 0 && SelectParticle(label) )
+  {
+    AliAODMCParticle* mother = static_cast<AliAODMCParticle*>(mcParticles.UncheckedAt(label));
+    if (!mother)
+    {
+      AliError("Got a null mother ! Check that !");
+      label = -1;
+    }
+    else
+    {
+      label = mother->GetMother();
+    }
+  }
+}
 
 //_____________________________________________________________________________
-void AliAODMuonReplicator::CreateLabelMap(const AliAODEvent& source)
+void AliAODMuonReplicator::CreateLabelMap()
 {  
   //
   // this should be called once all selections are done 
   //
   
-  fLabelMap.Delete();
-  
-  TClonesArray* mcParticles = static_cast<TClonesArray*>(source.FindListObject(AliAODMCParticle::StdBranchName()));
-  
-  Int_t i(0);
   Int_t j(0);
   
-  TIter next(mcParticles);
-  
-  while ( next() ) 
+  for ( Int_t i = 0; i < fLabelMap.GetSize(); ++i )
   {
-    if (IsParticleSelected(i))
-    {
-      fLabelMap.Add(i,j++);
-    }
-    ++i;
+    if ( fLabelMap[i] >= 0 ) fLabelMap[i] = j++;
   }
 }
 
@@ -150,7 +167,7 @@ Int_t AliAODMuonReplicator::GetNewLabel(Int_t i)
     AliError(Form("Searching for new label of particle with invalid label %i",i));
     return i;
   }
-  return fLabelMap.GetValue(i);
+  return ( i < fLabelMap.GetSize() && fLabelMap[i] >= 0 ) ? fLabelMap[i] : 0;
 }
 
 //_____________________________________________________________________________
@@ -164,7 +181,7 @@ void AliAODMuonReplicator::FilterMC(const AliAODEvent& source)
   AliAODMCHeader* mcHeader(0x0);
   TClonesArray* mcParticles(0x0);
   
-  fParticleSelected.Delete();
+  fLabelMap.Set(0);
   
   if ( fMCMode==2 && !fTracks->GetEntries() ) return;
   // for fMCMode==2 we only copy MC information for events where there's at least one muon track
@@ -180,28 +197,17 @@ void AliAODMuonReplicator::FilterMC(const AliAODEvent& source)
   
   if ( mcParticles && mcParticles->GetLast() >= 0 && fMCMode>=2 )
   {
+    // flat index of the selected particles: -1 = not selected
+    fLabelMap.Set(mcParticles->GetEntriesFast());
+    fLabelMap.Reset(-1);
+    
     // loop on (kept) muon tracks to find their ancestors
     TIter nextMT(fTracks);
     AliAODTrack* mt;
     
     while ( ( mt = static_cast<AliAODTrack*>(nextMT()) ) )
     {
-      Int_t label = mt->GetLabel();
-      
-      while ( label >= 0 ) 
-      {
-        SelectParticle(label);
-        AliAODMCParticle* mother = static_cast<AliAODMCParticle*>(mcParticles->UncheckedAt(label));
-        if (!mother)
-        {
-          AliError("Got a null mother ! Check that !");
-          label = -1;
-        }
-        else
-        {
-          label = mother->GetMother();
-        }
-      }
+      SelectAncestors(mt->GetLabel(),*mcParticles);
     }
     
     if ( mcParticles && fMCMode==3 )
@@ -211,26 +217,11 @@ void AliAODMuonReplicator::FilterMC(const AliAODEvent& source)
       {
         AliAODMCParticle* mcp = static_cast<AliAODMCParticle*>(mcParticles->UncheckedAt(ipart));
         if ( TMath::Abs(mcp->PdgCode()) != 13 ) continue;
-        Int_t label = ipart;
-
-        while ( label >= 0 )
-        {
-          SelectParticle(label);
-          AliAODMCParticle* mother = static_cast<AliAODMCParticle*>(mcParticles->UncheckedAt(label));
-          if (!mother)
-          {
-            AliError("Got a null mother ! Check that !");
-            label = -1;
-          }
-          else
-          {
-            label = mother->GetMother();
-          }
-        }
+        SelectAncestors(ipart,*mcParticles);
       }
     }
     
-    CreateLabelMap(source);
+    CreateLabelMap();
     
     // Actual filtering and label remapping (shamelessly taken for the implementation of AliAODHandler::StoreMCParticles)
     TIter nextMC(mcParticles);
@@ -392,6 +383,12 @@ TList* AliAODMuonReplicator::GetList() const
     fList->Add(fZDC);
     fList->Add(fAD);
     
+    if ( fReplicateColumns )
+    {
+      fColumns = new AliAODMuonColumns;
+      fList->Add(fColumns);
+    }
+    
     if ( fMCMode > 0 )
     {
       fMCHeader = new AliAODMCHeader;    
@@ -478,5 +475,29 @@ void AliAODMuonReplicator::ReplicateAndFilter(const AliAODEvent& source)
 
   if (fMCMode>0) FilterMC(source);
 
+  if (fColumns) FillColumns(source);
+}
+
+//_____________________________________________________________________________
+void AliAODMuonReplicator::FillColumns(const AliAODEvent& source)
+{
+  /// Fill the compact columns from the kept muon tracks, once their
+  /// MC labels refer to the replicated MC particles
+  
+  fColumns->Clear();
+  
+  const AliAODVertex* vertex = source.GetPrimaryVertex();
+  const TClonesArray* mcParticles = ( fMCParticles && fMCParticles->GetEntriesFast() ) ? fMCParticles : 0x0;
+  
+  TIter next(fTracks);
+  AliAODTrack* t;
+  
+  while ( ( t = static_cast<AliAODTrack*>(next()) ) )
+  {
+    if ( !t->IsMuonTrack() && !t->IsMuonGlobalTrack() ) continue;
+    fColumns->AddMuon(*t,vertex,mcParticles);
+  }
+  
+  fColumns->MakeDimuons();
 }
 
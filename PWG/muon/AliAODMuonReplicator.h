@@ -10,8 +10,8 @@
 #ifndef ALIDAODBRANCHREPLICATOR_H
 #  include "AliAODBranchReplicator.h"
 #endif
-#ifndef ROOT_TExMap
-#  include "TExMap.h"
+#ifndef ROOT_TArrayI
+#  include "TArrayI.h"
 #endif
 
 //
@@ -29,6 +29,7 @@ class AliAODHeader;
 class AliAODTracklets;
 class AliAODZDC;
 class AliAODAD;
+class AliAODMuonColumns;
 
 class AliAODMuonReplicator : public AliAODBranchReplicator
 {
@@ -46,13 +47,18 @@ public:
   virtual TList* GetList() const;
   
   virtual void ReplicateAndFilter(const AliAODEvent& source);
+
+  /// Also write the compact muon and dimuon columns (AliAODMuonColumns)
+  void SetReplicateColumns(Bool_t flag=kTRUE) { fReplicateColumns = flag; }
   
 private:
   void FilterMC(const AliAODEvent& source);
-  void SelectParticle(Int_t i);
-  Bool_t IsParticleSelected(Int_t i);
-  void CreateLabelMap(const AliAODEvent& source);
+  Bool_t SelectParticle(Int_t i);
+  Bool_t IsParticleSelected(Int_t i) const;
+  void SelectAncestors(Int_t i, const TClonesArray& mcParticles);
+  void CreateLabelMap();
   Int_t GetNewLabel(Int_t i);
+  void FillColumns(const AliAODEvent& source);
   
 private:
   AliAnalysisCuts* fTrackCut; // decides which tracks to keep
@@ -70,16 +76,17 @@ private:
   mutable TClonesArray* fMCParticles; //! internal array of MC particles
   mutable AliAODMCHeader* fMCHeader; //! internal array of MC header
   Int_t fMCMode; // MC filtering switch (0=none=no mc information,1=normal=simple copy,>=2=aggressive=filter out)
-  TExMap fLabelMap; //! for MC label remapping (in case of aggressive filtering)
-  TExMap fParticleSelected; //! List of selected MC particles
+  TArrayI fLabelMap; //! new label of each input MC particle (-1 = not selected), for the label remapping (in case of aggressive filtering)
   Bool_t fReplicateHeader; // whether or not the replicate the AOD Header
   Bool_t fReplicateTracklets; // whether or not the replicate the AOD Tracklets
+  Bool_t fReplicateColumns; // whether or not to write the compact muon columns
+  mutable AliAODMuonColumns* fColumns; //! internal muon columns object
   
 private:
   AliAODMuonReplicator(const AliAODMuonReplicator&);
   AliAODMuonReplicator& operator=(const AliAODMuonReplicator&);
   
-  ClassDef(AliAODMuonReplicator,10) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliAODMuonReplicator,11) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -51,6 +51,14 @@ fMuonEventCuts(muonEventCuts)
   /// ctor. For the parameters \see AliAODMuonReplicator::AliAODMuonReplicator
 }
 
+//_____________________________________________________________________________
+void AliAnalysisTaskAOD2MuonAOD::SetReplicateColumns(Bool_t flag)
+{
+  /// also write the compact muon and dimuon columns (muonColumns branch).
+  /// Must be called before UserCreateOutputObjects
+  static_cast<AliAODMuonReplicator*>(fBranchReplicator)->SetReplicateColumns(flag);
+}
+
 //_____________________________________________________________________________
 AliAnalysisTaskAOD2MuonAOD::~AliAnalysisTaskAOD2MuonAOD()
 {
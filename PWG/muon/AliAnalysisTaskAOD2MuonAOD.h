@@ -26,6 +26,8 @@ public:
   virtual void UserCreateOutputObjects();
   virtual void UserExec(Option_t *option);
 
+  void SetReplicateColumns(Bool_t flag=kTRUE);
+
 private:
   
   AliAnalysisTaskAOD2MuonAOD(const AliAnalysisTaskAOD2MuonAOD& rhs); // not implemented on purpose
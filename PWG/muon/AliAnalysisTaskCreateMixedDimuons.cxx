@@ -116,6 +116,9 @@ void AliAnalysisTaskCreateMixedDimuons::UserCreateOutputObjects() {
 
 void AliAnalysisTaskCreateMixedDimuons::UserExec(Option_t *) {
 
+  // Each event of the buffer is mixed with the muons stored in the pool for the
+  // current bin (compact records, see AliEventPoolMuon::AddEvent), then added to it
+
   if (!fOutputUserAOD) {
     Printf("ERROR: fOutputUserAOD not available\n");
     return;
@@ -123,100 +126,86 @@ void AliAnalysisTaskCreateMixedDimuons::UserExec(Option_t *) {
 
   printf("Calling USER EXEC\n\n");
 
+  Int_t bin = fPoolMuon->BinNumber() - 1;
+
   for (Int_t iEv=0; iEv<fBufferSize; iEv++) {
-    for (Int_t jEv=0; jEv<iEv; jEv++) {
-
-      Int_t nTracksEv[2]  = {0};
-      Int_t nFWMuonsEv[2] = {0};
-      
-      nTracksEv[0] = fInputAOD[iEv]->GetNumberOfTracks();
-      nTracksEv[1] = fInputAOD[jEv]->GetNumberOfTracks();
-      // Check if both events contain std aod tracks
-      if (!dynamic_cast<AliAODTrack*>(fInputAOD[iEv]->GetTrack(0)) || dynamic_cast<AliAODTrack*>(fInputAOD[jEv]->GetTrack(0))){
-        AliFatal("Not a standard AOD");
-      }
 
-      for (Int_t i=0; i<nTracksEv[0]; i++) if(((AliAODTrack*)fInputAOD[iEv]->GetTrack(i))->IsMuonTrack()) nFWMuonsEv[0]++;
-      for (Int_t i=0; i<nTracksEv[1]; i++) if(((AliAODTrack*)fInputAOD[jEv]->GetTrack(i))->IsMuonTrack()) nFWMuonsEv[1]++;
-      
-      // Muon track mixing to fill a mass spectrum
-      
-      if (nFWMuonsEv[0] && nFWMuonsEv[1]) {
-	
-	Int_t rndMuonTrack[2] = {0};
-	rndMuonTrack[0] = gRandom->Integer(nFWMuonsEv[0]);
-	rndMuonTrack[1] = gRandom->Integer(nFWMuonsEv[1]);
-	
-	Int_t nFWMUonsAdded = 0;
-	Int_t nPosTracksAdded = 0;
-	Int_t nNegTracksAdded = 0;
-	
-	AliAODVertex *vertex = new AliAODVertex();
-	vertex -> SetX(0.0);
-	vertex -> SetY(0.0);
-	vertex -> SetZ(fPoolMuon->GetMeanPrimaryVertexZ());
-	
-	Int_t muonCounter[2] = {0};
-	
-	// adding tracks and vertex to the output event...
-	
-	for (Int_t i=0; i<nTracksEv[0]; i++) {
-	  if(((AliAODTrack*)fInputAOD[iEv]->GetTrack(i))->IsMuonTrack()) {
-	    if (fDebug) printf("fInputAOD[%d]->GetTrack(%d) = %p    pt = %f     uniqueID = %d\n",
-			       iEv,i,fInputAOD[iEv]->GetTrack(i),fInputAOD[iEv]->GetTrack(i)->Pt(),
-			       fInputAOD[iEv]->GetTrack(i)->GetUniqueID());
-	    if (muonCounter[0]==rndMuonTrack[0]) {
-	      fOutputUserAOD->AddTrack((AliAODTrack*)fInputAOD[iEv]->GetTrack(i));
-	      nFWMUonsAdded++;
-	      if (fInputAOD[iEv]->GetTrack(i)->Charge()>0) nPosTracksAdded++;
-	      else nNegTracksAdded++;
-	    }
-	    muonCounter[0]++;
-	  }
-	}
-	
-	for (Int_t i=0; i<nTracksEv[1]; i++) {
-	  if(((AliAODTrack*)fInputAOD[jEv]->GetTrack(i))->IsMuonTrack()) {
-	    if (fDebug) printf("fInputAOD[%d]->GetTrack(%d) = %p    pt = %f     uniqueID = %d\n",
-			       jEv,i,fInputAOD[jEv]->GetTrack(i),fInputAOD[jEv]->GetTrack(i)->Pt(),
-			       fInputAOD[jEv]->GetTrack(i)->GetUniqueID());
-	    if (muonCounter[1]==rndMuonTrack[1]) {
-	      fOutputUserAOD->AddTrack((AliAODTrack*)fInputAOD[jEv]->GetTrack(i));
-	      nFWMUonsAdded++;
-	      if (fInputAOD[jEv]->GetTrack(i)->Charge()>0) nPosTracksAdded++;
-	      else nNegTracksAdded++;
-	    }
-	    muonCounter[1]++;	
-	  }
-	}
-	
-	fOutputUserAOD->AddVertex(vertex);
-	
-	// ... done!
-	
-	if (fDebug) {
-	  for (Int_t i=0; i<nFWMUonsAdded; i++) {
-	    AliAODTrack *tr = dynamic_cast<AliAODTrack*>( fOutputUserAOD->GetTrack(i));
-	    if(!tr) AliFatal("Not a standard AOD");
-	    printf("fOutputUserAOD->GetTrack(%d) = %p    pt = %f\n",i,tr,tr->Pt());
-	  }
-	}
-	
-
-        AliAODHeader * header = dynamic_cast<AliAODHeader*>(fOutputUserAOD->GetHeader());
-        if(!header) AliFatal("Not a standard AOD");
-	header->SetRefMultiplicity(nFWMUonsAdded); 
-	header->SetRefMultiplicityPos(nPosTracksAdded);
-	header->SetRefMultiplicityNeg(nNegTracksAdded);
-	
-	fOutputUserHandler -> FinishEvent();
-	
+    Int_t nTracks  = fInputAOD[iEv]->GetNumberOfTracks();
+    Int_t nFWMuons = 0;
+    for (Int_t i=0; i<nTracks; i++) {
+      AliAODTrack *track = dynamic_cast<AliAODTrack*>(fInputAOD[iEv]->GetTrack(i));
+      if (!track) AliFatal("Not a standard AOD");
+      if (track->IsMuonTrack()) nFWMuons++;
+    }
+    
+    // Muon track mixing to fill a mass spectrum
+
+    Int_t nStored = nFWMuons ? fPoolMuon->GetNStoredEvents(bin) : 0;
+
+    for (Int_t jEv=0; jEv<nStored; jEv++) {
+
+      Int_t nStoredMuons = 0;
+      const AliEventPoolMuon::MuonRecord *muons = fPoolMuon->GetStoredMuons(bin, jEv, nStoredMuons);
+      if (!nStoredMuons) continue;
+
+      Int_t rndMuonTrack = gRandom->Integer(nFWMuons);
+      const AliEventPoolMuon::MuonRecord &rndMuon = muons[gRandom->Integer(nStoredMuons)];
+
+      Int_t nPosTracksAdded = 0;
+      Int_t nNegTracksAdded = 0;
+
+      AliAODVertex *vertex = new AliAODVertex();
+      vertex -> SetX(0.0);
+      vertex -> SetY(0.0);
+      vertex -> SetZ(fPoolMuon->GetMeanPrimaryVertexZ());
+
+      // adding tracks and vertex to the output event...
+
+      Int_t muonCounter = 0;
+      for (Int_t i=0; i<nTracks; i++) {
+        AliAODTrack *track = static_cast<AliAODTrack*>(fInputAOD[iEv]->GetTrack(i));
+        if (!track->IsMuonTrack()) continue;
+        if (muonCounter++ != rndMuonTrack) continue;
+        if (fDebug) printf("fInputAOD[%d]->GetTrack(%d) = %p    pt = %f     uniqueID = %d\n",
+                           iEv,i,track,track->Pt(),track->GetUniqueID());
+        fOutputUserAOD->AddTrack(track);
+        if (track->Charge()>0) nPosTracksAdded++;
+        else nNegTracksAdded++;
+        break;
       }
 
-      PostData(1, fOutputUserAODTree);
-      
+      AliAODTrack storedTrack;
+      Double_t p[3] = {rndMuon.fPx, rndMuon.fPy, rndMuon.fPz};
+      storedTrack.SetP(p, kTRUE);
+      storedTrack.SetCharge(rndMuon.fCharge);
+      storedTrack.SetChi2perNDF(rndMuon.fChi2perNDF);
+      storedTrack.SetChi2MatchTrigger(rndMuon.fChi2MatchTrigger);
+      storedTrack.SetMatchTrigger(rndMuon.fMatchTrigger);
+      storedTrack.SetMuonClusterMap(rndMuon.fMuonClusterMap);
+      if (fDebug) printf("stored muon %d of bin %d    pt = %f\n",jEv,bin,storedTrack.Pt());
+      fOutputUserAOD->AddTrack(&storedTrack);
+      if (rndMuon.fCharge>0) nPosTracksAdded++;
+      else nNegTracksAdded++;
+
+      fOutputUserAOD->AddVertex(vertex);
+      delete vertex;
+
+      // ... done!
+
+      AliAODHeader * header = dynamic_cast<AliAODHeader*>(fOutputUserAOD->GetHeader());
+      if(!header) AliFatal("Not a standard AOD");
+      header->SetRefMultiplicity(2);
+      header->SetRefMultiplicityPos(nPosTracksAdded);
+      header->SetRefMultiplicityNeg(nNegTracksAdded);
+
+      fOutputUserHandler -> FinishEvent();
+
     }
-    
+
+    fPoolMuon->AddEvent(bin, *fInputAOD[iEv]);
+
+    PostData(1, fOutputUserAODTree);
+
   }
   
 }      
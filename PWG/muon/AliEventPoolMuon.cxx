@@ -7,6 +7,9 @@
 #include "AliDetectorTagCuts.h"
 #include "AliEventTagCuts.h"
 #include "AliTagAnalysis.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "TMath.h"
 
 // Realisation of an AliVEventPool via
 // on the flight generation of the bin using AliTagAnalysis.
@@ -41,7 +44,15 @@ AliEventPoolMuon::AliEventPoolMuon():
   fPrimaryVertexZMax(0),
   fPrimaryVertexZStep(0),
   fPrimaryVertexZ(0),
-  fBinNumber(0) {
+  fBinNumber(0),
+  fMemoryBudget(100000000),
+  fMaxMuonsPerEvent(20),
+  fEvictionPolicy(kEvictOldest),
+  fMaxEventsPerBin(0),
+  fStoredMuons(),
+  fStoredNMuons(),
+  fStoredFirst(),
+  fStoredN() {
   
   // Default constructor
 
@@ -69,7 +80,15 @@ AliEventPoolMuon::AliEventPoolMuon(const Char_t *name, const Char_t *title):
   fPrimaryVertexZMax(0),
   fPrimaryVertexZStep(0),
   fPrimaryVertexZ(0),
-  fBinNumber(0) {
+  fBinNumber(0),
+  fMemoryBudget(100000000),
+  fMaxMuonsPerEvent(20),
+  fEvictionPolicy(kEvictOldest),
+  fMaxEventsPerBin(0),
+  fStoredMuons(),
+  fStoredNMuons(),
+  fStoredFirst(),
+  fStoredN() {
 
   // Constructor
 
@@ -97,7 +116,15 @@ AliEventPoolMuon::AliEventPoolMuon(const AliEventPoolMuon& obj):
   fPrimaryVertexZMax(0),
   fPrimaryVertexZStep(0),
   fPrimaryVertexZ(0),
-  fBinNumber(0) {
+  fBinNumber(0),
+  fMemoryBudget(100000000),
+  fMaxMuonsPerEvent(20),
+  fEvictionPolicy(kEvictOldest),
+  fMaxEventsPerBin(0),
+  fStoredMuons(),
+  fStoredNMuons(),
+  fStoredFirst(),
+  fStoredN() {
 
   // Copy constructor
 
@@ -123,6 +150,8 @@ void AliEventPoolMuon::Init() {
   fNFWMuon        = fNFWMuonMin;
   fPrimaryVertexZ = fPrimaryVertexZMin;
 
+  InitStorage();
+
 }
 
 //=====================================================================================================
@@ -182,3 +211,128 @@ Int_t AliEventPoolMuon::GetDimension() {
 }
 
 //=====================================================================================================
+
+Int_t AliEventPoolMuon::GetNBins() const {
+
+  // Number of bins visited by GetNextChain
+
+  Int_t nMultiplicity = fMultiplicityStep > 0 ? (fMultiplicityMax - fMultiplicityMin + 1) / fMultiplicityStep : 1;
+  Int_t nNFWMuon      = fNFWMuonStep > 0 ? (fNFWMuonMax - fNFWMuonMin + 1) / fNFWMuonStep : 1;
+  Int_t nVertexZ      = fPrimaryVertexZStep > 0 ? Int_t((fPrimaryVertexZMax - fPrimaryVertexZMin) / fPrimaryVertexZStep + 1e-6) : 1;
+
+  return TMath::Max(1, nMultiplicity) * TMath::Max(1, nNFWMuon) * TMath::Max(1, nVertexZ);
+
+}
+
+//=====================================================================================================
+
+void AliEventPoolMuon::InitStorage() {
+
+  // Share the memory budget between the bins. The buffers of a bin are only
+  // allocated when its first event is stored
+
+  Int_t nBins = GetNBins();
+  Long64_t bytesPerEvent = Long64_t(TMath::Max(1, fMaxMuonsPerEvent)) * (sizeof(MuonRecord) + sizeof(Int_t));
+  fMaxEventsPerBin = Int_t(TMath::Min(fMemoryBudget / (nBins * bytesPerEvent), Long64_t(kMaxInt)));
+
+  ClearStorage();
+  fStoredMuons.resize(nBins);
+  fStoredNMuons.resize(nBins);
+  fStoredFirst.assign(nBins, 0);
+  fStoredN.assign(nBins, 0);
+
+}
+
+//=====================================================================================================
+
+void AliEventPoolMuon::ClearStorage() {
+
+  // Release the stored muons of all the bins
+
+  fStoredMuons.clear();
+  fStoredNMuons.clear();
+  fStoredFirst.clear();
+  fStoredN.clear();
+
+}
+
+//=====================================================================================================
+
+Bool_t AliEventPoolMuon::AddEvent(Int_t bin, const AliAODEvent& event) {
+
+  // Store the muons of the event in the ring buffer of the bin.
+  // Returns kFALSE if the event was not stored (no muon, or full bin with kKeepOldest)
+
+  if (fStoredN.empty()) InitStorage();
+  if (bin < 0 || bin >= Int_t(fStoredN.size()) || fMaxEventsPerBin <= 0) return kFALSE;
+
+  Int_t nTracks = event.GetNumberOfTracks();
+  Int_t nMuons = 0;
+  for (Int_t i=0; i<nTracks; i++) {
+    const AliAODTrack *track = static_cast<const AliAODTrack*>(event.GetTrack(i));
+    if (track && track->IsMuonTrack()) nMuons++;
+  }
+  if (!nMuons) return kFALSE;
+
+  if (fStoredMuons[bin].empty()) {
+    fStoredMuons[bin].resize(fMaxEventsPerBin * fMaxMuonsPerEvent);
+    fStoredNMuons[bin].resize(fMaxEventsPerBin);
+  }
+
+  Int_t slot;
+  if (fStoredN[bin] < fMaxEventsPerBin) {
+    slot = (fStoredFirst[bin] + fStoredN[bin]) % fMaxEventsPerBin;
+    fStoredN[bin]++;
+  }
+  else if (fEvictionPolicy == kKeepOldest) return kFALSE;
+  else {
+    slot = fStoredFirst[bin];
+    fStoredFirst[bin] = (fStoredFirst[bin] + 1) % fMaxEventsPerBin;
+  }
+
+  MuonRecord *record = &fStoredMuons[bin][slot * fMaxMuonsPerEvent];
+  Int_t nStored = 0;
+  for (Int_t i=0; i<nTracks && nStored<fMaxMuonsPerEvent; i++) {
+    const AliAODTrack *track = static_cast<const AliAODTrack*>(event.GetTrack(i));
+    if (!track || !track->IsMuonTrack()) continue;
+    record->fPx              = track->Px();
+    record->fPy              = track->Py();
+    record->fPz              = track->Pz();
+    record->fChi2perNDF      = track->Chi2perNDF();
+    record->fChi2MatchTrigger = track->GetChi2MatchTrigger();
+    record->fMuonClusterMap  = track->GetMUONClusterMap();
+    record->fCharge          = track->Charge();
+    record->fMatchTrigger    = track->GetMatchTrigger();
+    record++;
+    nStored++;
+  }
+  fStoredNMuons[bin][slot] = nStored;
+
+  return kTRUE;
+
+}
+
+//=====================================================================================================
+
+Int_t AliEventPoolMuon::GetNStoredEvents(Int_t bin) const {
+
+  return (bin >= 0 && bin < Int_t(fStoredN.size())) ? fStoredN[bin] : 0;
+
+}
+
+//=====================================================================================================
+
+const AliEventPoolMuon::MuonRecord* AliEventPoolMuon::GetStoredMuons(Int_t bin, Int_t iEvent, Int_t& nMuons) const {
+
+  // Contiguous muon records of the stored event iEvent (0 = oldest) of the bin
+
+  nMuons = 0;
+  if (iEvent < 0 || iEvent >= GetNStoredEvents(bin)) return 0x0;
+
+  Int_t slot = (fStoredFirst[bin] + iEvent) % fMaxEventsPerBin;
+  nMuons = fStoredNMuons[bin][slot];
+  return &fStoredMuons[bin][slot * fMaxMuonsPerEvent];
+
+}
+
+//=====================================================================================================
@@ -3,6 +3,8 @@
 
 /* $Id$ */ 
 
+#include <vector>
+
 #include "AliVEventPool.h"
 #include "AliRunTagCuts.h"
 #include "AliLHCTagCuts.h"
@@ -10,10 +12,16 @@
 #include "AliEventTagCuts.h"
 #include "AliTagAnalysis.h"
 
+class AliAODEvent;
+
 // Realisation of an AliVEventPool via
 // on the flight generation of the bin using AliTagAnalysis.
 // Created expanding AliEventPoolOTF class functionalities
 //
+// The muons of the events already seen can be kept, per bin, as compact
+// records (MuonRecord) in ring buffers bounded by a memory budget, so that
+// they can be mixed with the following events without keeping the events.
+//
 // Authors Alessandro De Falco and Antonio Uras, INFN Cagliari
 // alessandro.de.falco@ca.infn.it  antonio.uras@ca.infn.it
 
@@ -22,6 +30,19 @@
 class AliEventPoolMuon : public AliVEventPool {
 
  public:
+  // Compact record of one stored muon
+  struct MuonRecord {
+    Float_t fPx, fPy, fPz;        // momentum
+    Float_t fChi2perNDF;          // chi2/ndf of the tracker
+    Float_t fChi2MatchTrigger;    // chi2 of the tracker-trigger matching
+    UInt_t  fMuonClusterMap;      // chambers with clusters
+    Char_t  fCharge;              // charge
+    UChar_t fMatchTrigger;        // trigger matching (0: none, 1: Apt, 2: Lpt, 3: Hpt)
+  };
+
+  // What to do with a new event when the ring buffer of its bin is full
+  enum EEvictionPolicy { kEvictOldest, kKeepOldest };
+
   AliEventPoolMuon();
   AliEventPoolMuon(const Char_t *name, const Char_t *title = "AOD");
   
@@ -42,10 +63,23 @@ class AliEventPoolMuon : public AliVEventPool {
   void SetTagDirectory(const Char_t *dirname) {fTagDirectory = dirname;};
   virtual Int_t BinNumber() const {return fBinNumber;}
   
+  // storage of the muons for the mixing
+  void  SetMemoryBudget(Long64_t bytes) { fMemoryBudget = bytes; }
+  void  SetMaxMuonsPerEvent(Int_t n) { fMaxMuonsPerEvent = n; }
+  void  SetEvictionPolicy(EEvictionPolicy policy) { fEvictionPolicy = policy; }
+  Int_t GetNBins() const;
+  Int_t GetMaxEventsPerBin() const { return fMaxEventsPerBin; }
+  Bool_t AddEvent(Int_t bin, const AliAODEvent& event);
+  Int_t GetNStoredEvents(Int_t bin) const;
+  const MuonRecord* GetStoredMuons(Int_t bin, Int_t iEvent, Int_t& nMuons) const;
+  void  ClearStorage();
+  
  private:
   AliEventPoolMuon(const AliEventPoolMuon& obj);
   AliEventPoolMuon& operator=(const AliEventPoolMuon& other);
 
+  void  InitStorage();
+
  protected:
 
   AliTagAnalysis      *fTagAnalysis;  // Pointer to tag analysis
@@ -73,6 +107,15 @@ class AliEventPoolMuon : public AliVEventPool {
   
   Int_t  fBinNumber;             // Current bin number
   
+  Long64_t fMemoryBudget;        // Memory budget of the muon storage (bytes), all bins together
+  Int_t    fMaxMuonsPerEvent;    // Maximum number of muons stored per event
+  Int_t    fEvictionPolicy;      // EEvictionPolicy
+  Int_t    fMaxEventsPerBin;     //! Number of event slots per bin, from the memory budget
+  std::vector< std::vector<MuonRecord> > fStoredMuons;  //! per bin: fMaxMuonsPerEvent records per event slot
+  std::vector< std::vector<Int_t> >      fStoredNMuons; //! per bin and event slot: number of muons
+  std::vector<Int_t>                     fStoredFirst;  //! per bin: slot of the oldest event
+  std::vector<Int_t>                     fStoredN;      //! per bin: number of stored events
+  
   ClassDef(AliEventPoolMuon, 0); 
 
 };
@@ -11,6 +11,7 @@
 #pragma link C++ class AliAnalysisTaskLUT+;
 #pragma link C++ class AliAnalysisTaskESDMuonFilter+;
 #pragma link C++ class AliAODMuonReplicator+;
+#pragma link C++ class AliAODMuonColumns+;
 #pragma link C++ class AliAnalysisNonMuonTrackCuts+;
 #pragma link C++ class AliAnalysisNonPrimaryVertices+;
 #pragma link C++ class AliESDMuonTrackCuts+;
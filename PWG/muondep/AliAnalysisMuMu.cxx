@@ -77,6 +77,18 @@ using std::cout;
 using std::endl;
 using std::ifstream;
 
+namespace
+{
+  // One (binning, trigger, event type, pair cut, centrality) combination fitted by FitJpsi
+  struct FitJob {
+    Int_t ibinning;
+    const TObjString* trigger;
+    const TObjString* eventType;
+    const TObjString* pairCut;
+    const TObjString* centrality;
+  };
+}
+
 ClassImp(AliAnalysisMuMu)
 
 //_____________________________________________________________________________
@@ -1631,6 +1643,15 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
   TString EPdetector = "SPD";//{"VZEROA", "VZEROA","SPD"};
 
+  // ---- Lookups which do not depend on the bin, done once for all the bins ----
+
+  // Specific fit parameters
+  TObjArray* fitSingle = Config()->GetListElements(Config()->FitSingleKey(),IsSimulation());
+
+  // Minv spectra used by the mean pt/v2 fits, looked for at the first such fit
+  AliAnalysisMuMuSpectra* minvSpectra(0x0);
+  Bool_t minvSpectraLookedFor = kFALSE;
+
   // ---- MAIN PART : Loop on every binning range ----
 
   AliAnalysisMuMuBinning::Range* bin;
@@ -1675,7 +1696,8 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
     std::cout << "Fitting" << isCorr.Data() << sHistoType.Data() << " spectra in " << id->Data() << std::endl;
 
     // Finally gets it
-    if ( OC()->Histo(id->Data(),hname.Data()) ) histo = static_cast<TH1*>(OC()->Histo(id->Data(),hname.Data())->Clone(Form("%s%d",sHistoType.Data(),n++)));
+    TH1* storedHisto = OC()->Histo(id->Data(),hname.Data());
+    if ( storedHisto ) histo = static_cast<TH1*>(storedHisto->Clone(Form("%s%d",sHistoType.Data(),n++)));
     if ( !histo ) {
       AliError(Form("Could not find histo %s/%s",id->Data(),hname.Data()));
       continue;
@@ -1712,7 +1734,6 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
       std::cout << "" << std::endl;
 
       // Look for specific fit param.
-      TObjArray* fitSingle = Config()->GetListElements(Config()->FitSingleKey(),IsSimulation());
       TIter nextFitSingle(fitSingle);
       TObjString* specifit;
       nextFitSingle.Reset();
@@ -1744,7 +1765,6 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
         delete oldFitParam;
       }
-      delete fitSingle;
 
       if(  mix != fitType->String().Contains("mix")  )  {
         printf("skip %s because inconsistant with FitMethod \n",fitType->String().Data() );
@@ -1793,7 +1813,10 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
         std::cout << "++The Minv parameters will be taken from " << spectraName.Data() << std::endl;
         std::cout << "" << std::endl;
 
-        AliAnalysisMuMuSpectra* minvSpectra = dynamic_cast<AliAnalysisMuMuSpectra*>(OC()->GetObject(Form("/FitResults%s",id->Data()),spectraName.Data()));
+        if ( !minvSpectraLookedFor ) {
+          minvSpectra = dynamic_cast<AliAnalysisMuMuSpectra*>(OC()->GetObject(Form("/FitResults%s",id->Data()),spectraName.Data()));
+          minvSpectraLookedFor = kTRUE;
+        }
 
         if ( !minvSpectra ){
           AliError(Form("Cannot fit mean pt: could not get the minv spectra for /FitResults%s",id->Data()));
@@ -1840,7 +1863,10 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
         std::cout << "++The Minv parameters will be taken from " << spectraName.Data() << std::endl;
         std::cout << "" << std::endl;
 
-        AliAnalysisMuMuSpectra* minvSpectra = dynamic_cast<AliAnalysisMuMuSpectra*>(OC()->GetObject(Form("/FitResults%s",id->Data()),spectraName.Data()));
+        if ( !minvSpectraLookedFor ) {
+          minvSpectra = dynamic_cast<AliAnalysisMuMuSpectra*>(OC()->GetObject(Form("/FitResults%s",id->Data()),spectraName.Data()));
+          minvSpectraLookedFor = kTRUE;
+        }
 
         if ( !minvSpectra ){
           AliError(Form("Cannot fit mean pt: could not get the minv spectra for /FitResults%s",id->Data()));
@@ -1886,7 +1912,10 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
         std::cout << "++The Minv parameters will be taken from " << spectraName.Data() << std::endl;
         std::cout << "" << std::endl;
 
-        AliAnalysisMuMuSpectra* minvSpectra = dynamic_cast<AliAnalysisMuMuSpectra*>(OC()->GetObject(Form("/FitResults%s",id->Data()),spectraName.Data()));
+        if ( !minvSpectraLookedFor ) {
+          minvSpectra = dynamic_cast<AliAnalysisMuMuSpectra*>(OC()->GetObject(Form("/FitResults%s",id->Data()),spectraName.Data()));
+          minvSpectraLookedFor = kTRUE;
+        }
 
         if ( !minvSpectra ){
           AliError(Form("Cannot fit mean v2: could not get the minv spectra for /FitResults%s",id->Data()));
@@ -2017,6 +2046,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
     delete fitTypeArray;
   }
 
+  delete fitSingle;
   delete bins;
   if (refTrigger) delete  refTrigger;
   if (refEvent)   delete  refEvent;
@@ -3248,18 +3278,13 @@ Int_t AliAnalysisMuMu::FitJpsi(const char* binType, const char* flavour, const T
   TString refTrigger(Form("%s",Config()->First(Config()->RefMixTriggerKey(),IsSimulation()).Data()));
   TString refEvent(Form("%s",Config()->First(Config()->RefMixEventSelectionKey(),IsSimulation()).Data()));
 
-  TIter nextTrigger(TriggerArray);
-  TIter nextEventType(eventTypeArray);
-  TIter nextPairCut(pairCutArray);
-  TIter nextbinType(binTypeArray);
-  TIter nextCentrality(centralityArray);
+  // ---- Enumerate all the (binning, trigger, event type, pair cut, centrality) fit jobs up front ----
 
-  TObjString* trigger;
-  TObjString* eventType;
-  TObjString* pairCut;
-  TObjString* sbinType;
-  TObjString* centrality;
+  std::vector<AliAnalysisMuMuBinning*> binnings;
+  std::vector<TString> binningNames;
 
+  TIter nextbinType(binTypeArray);
+  TObjString* sbinType;
   while ( ( sbinType = static_cast<TObjString*>(nextbinType()) ) )
   {
     AliAnalysisMuMuBinning* binning(0x0);
@@ -3271,111 +3296,105 @@ Int_t AliAnalysisMuMu::FitJpsi(const char* binType, const char* flavour, const T
       binning->AddBin(particle,sbinType->String().Data());
     }
 
-    StdoutToAliDebug(1,std::cout << "++++++++++++ binning=" << sbinType->String().Data() << std::endl;);
-
-    std::cout << "" << std::endl;
-    std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << std::endl;
-    std::cout << "+++++++++++++++++++ binning  = " << sbinType->String().Data() << std::endl;
-    std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << std::endl;
-    std::cout << "" << std::endl;
-    std::cout << "" << std::endl;
-
     if (!binning) {
-      AliError("oups. binning is NULL");
+      AliError(Form("oups. binning is NULL for %s",sbinType->String().Data()));
       continue;
     }
 
-    StdoutToAliDebug(1,binning->Print(););
-
-    // Loop over all trigger
-    while ( ( trigger = static_cast<TObjString*>(nextTrigger())) ) {
-      AliDebug(1,Form("--TRIGGER %s",trigger->String().Data()));
-      nextEventType.Reset();
-
-      // Loop over all evenType
-      while ( ( eventType = static_cast<TObjString*>(nextEventType())) ){
-        AliDebug(1,Form("----EVENTTYPE %s",eventType->String().Data()));
-        nextPairCut.Reset();
+    binnings.push_back(binning);
+    binningNames.push_back(sbinType->String());
+  }
 
-        // Loop over all paircut
-        while ( ( pairCut = static_cast<TObjString*>(nextPairCut())) ) {
-          AliDebug(1,Form("------PAIRCUT %s",pairCut->String().Data()));
-          nextCentrality.Reset();
+  std::vector<FitJob> jobs;
+
+  for ( Int_t ib = 0; ib < (Int_t)binnings.size(); ++ib )
+    for ( Int_t it = 0; it <= TriggerArray->GetLast(); ++it )
+      for ( Int_t ie = 0; ie <= eventTypeArray->GetLast(); ++ie )
+        for ( Int_t ip = 0; ip <= pairCutArray->GetLast(); ++ip )
+          for ( Int_t ic = 0; ic <= centralityArray->GetLast(); ++ic ) {
+            FitJob job = { ib,
+                           static_cast<const TObjString*>(TriggerArray->At(it)),
+                           static_cast<const TObjString*>(eventTypeArray->At(ie)),
+                           static_cast<const TObjString*>(pairCutArray->At(ip)),
+                           static_cast<const TObjString*>(centralityArray->At(ic)) };
+            jobs.push_back(job);
+          }
 
-          // Loop over all centrality
-          while ( ( centrality = static_cast<TObjString*>(nextCentrality()) ) ) {
-            AliDebug(1,"------Fitting...");
+  std::cout << "" << std::endl;
+  std::cout << "+++++++++++++++++++ " << jobs.size() << " fit jobs for " << binnings.size() << " binning(s)" << std::endl;
 
-            // Select stored path
-            TObject* o;
-            TString id = "";
-            if(fitMethod.Contains("mix"))
-              id = Form("/FitResults/%s_%s/%s/%s/%s/%s",refEvent.Data(),refTrigger.Data(),eventType->String().Data(),trigger->String().Data(),centrality->String().Data(),pairCut->String().Data());
-            else
-              id = Form("/FitResults/%s/%s/%s/%s",eventType->String().Data(),trigger->String().Data(),centrality->String().Data(),pairCut->String().Data());
+  // ---- Run the jobs in order ----
 
-            printf("\n ----- id:%s -----\n",id.Data() );
-            AliAnalysisMuMuSpectra* spectra(0x0);
-            AliAnalysisMuMuSpectra* spectraCorr(0x0);
+  Int_t currentBinning(-1);
+  for ( size_t ijob = 0; ijob < jobs.size(); ++ijob )
+  {
+    const FitJob& job = jobs[ijob];
+    AliAnalysisMuMuBinning* binning = binnings[job.ibinning];
 
-            // ---- The main part. The fit method is called ----
+    if ( job.ibinning != currentBinning ) {
+      currentBinning = job.ibinning;
 
-            AliDebug(1,"------Fitting spectra...");
-            spectra = FitParticle(particle,trigger->String().Data(),eventType->String().Data(),pairCut->String().Data(),centrality->String().Data(),*binning,kFALSE,&fitMethod,flavour,histoType);
-            AliDebug(1,Form("------fitting done spectra = %p",spectra));
+      StdoutToAliDebug(1,std::cout << "++++++++++++ binning=" << binningNames[currentBinning].Data() << std::endl;);
 
-            // AliDebug(1,"------Fitting corrected spectra...");
-            // spectraCorr = FitParticle(particle,trigger->String().Data(),eventType->String().Data(),pairCut->String().Data(),centrality->String().Data(),*binning,kTRUE,&fitMethod,flavour,histoType);
-            // AliDebug(1,Form("------fitting done corrected spectra = %p",spectraCorr));
+      std::cout << "" << std::endl;
+      std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << std::endl;
+      std::cout << "+++++++++++++++++++ binning  = " << binningNames[currentBinning].Data() << std::endl;
+      std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << std::endl;
+      std::cout << "" << std::endl;
+      std::cout << "" << std::endl;
 
-            // ----
+      StdoutToAliDebug(1,binning->Print(););
+    }
 
-            // --- save results in mergeable collection ---
-            if ( spectra ) {
-              ++nfits;
+    const TString& trigger    = job.trigger->String();
+    const TString& eventType  = job.eventType->String();
+    const TString& pairCut    = job.pairCut->String();
+    const TString& centrality = job.centrality->String();
 
-              o = fMergeableCollection->GetObject(id.Data(),spectra->GetName());
-              AliDebug(1,Form("----nfits=%d id=%s o=%p",nfits,id.Data(),o));
+    AliDebug(1,Form("------Fitting job %d/%d : TRIGGER %s EVENTTYPE %s PAIRCUT %s CENTRALITY %s",(Int_t)ijob+1,(Int_t)jobs.size(),
+                    trigger.Data(),eventType.Data(),pairCut.Data(),centrality.Data()));
 
-              if (o) {
-                AliWarning(Form("Replacing %s/%s",id.Data(),spectra->GetName()));
-                fMergeableCollection->Remove(Form("%s/%s",id.Data(),spectra->GetName()));
-              }
+    // Select stored path
+    TObject* o;
+    TString id = "";
+    if(fitMethod.Contains("mix"))
+      id = Form("/FitResults/%s_%s/%s/%s/%s/%s",refEvent.Data(),refTrigger.Data(),eventType.Data(),trigger.Data(),centrality.Data(),pairCut.Data());
+    else
+      id = Form("/FitResults/%s/%s/%s/%s",eventType.Data(),trigger.Data(),centrality.Data(),pairCut.Data());
 
-              Bool_t adoptOK = fMergeableCollection->Adopt(id.Data(),spectra);
+    printf("\n ----- id:%s -----\n",id.Data() );
+    AliAnalysisMuMuSpectra* spectra(0x0);
 
-              if ( adoptOK ) std::cout << "+++Spectra " << spectra->GetName() << " adopted" << std::endl;
-              else AliError(Form("Could not adopt spectra %s",spectra->GetName()));
+    // ---- The main part. The fit method is called ----
 
-              StdoutToAliDebug(1,spectra->Print(););
-            } else AliError("Error creating spectra");
+    AliDebug(1,"------Fitting spectra...");
+    spectra = FitParticle(particle,trigger.Data(),eventType.Data(),pairCut.Data(),centrality.Data(),*binning,kFALSE,&fitMethod,flavour,histoType);
+    AliDebug(1,Form("------fitting done spectra = %p",spectra));
 
-            o = 0x0;
-            if ( spectraCorr ) {
-              ++nfits;
+    // --- save results in mergeable collection ---
+    if ( spectra ) {
+      ++nfits;
 
-              o = fMergeableCollection->GetObject(id.Data(),spectraCorr->GetName());
-              AliDebug(1,Form("----nfits=%d id=%s o=%p",nfits,id.Data(),o));
+      o = fMergeableCollection->GetObject(id.Data(),spectra->GetName());
+      AliDebug(1,Form("----nfits=%d id=%s o=%p",nfits,id.Data(),o));
 
-              if (o) {
-                AliWarning(Form("Replacing %s/%s",id.Data(),spectraCorr->GetName()));
-                fMergeableCollection->Remove(Form("%s/%s",id.Data(),spectraCorr->GetName()));
-              }
+      if (o) {
+        AliWarning(Form("Replacing %s/%s",id.Data(),spectra->GetName()));
+        fMergeableCollection->Remove(Form("%s/%s",id.Data(),spectra->GetName()));
+      }
 
-              Bool_t adoptOK = fMergeableCollection->Adopt(id.Data(),spectraCorr);
+      Bool_t adoptOK = fMergeableCollection->Adopt(id.Data(),spectra);
 
-              if ( adoptOK ) std::cout << "+++Spectra " << spectraCorr->GetName() << " adopted" << std::endl;
-              else AliError(Form("Could not adopt spectra %s",spectraCorr->GetName()));
+      if ( adoptOK ) std::cout << "+++Spectra " << spectra->GetName() << " adopted" << std::endl;
+      else AliError(Form("Could not adopt spectra %s",spectra->GetName()));
 
-              StdoutToAliDebug(1,spectraCorr->Print(););
-            }
-            else AliError("Error creating spectra");
-          }
-        }
-      }
-    }
+      StdoutToAliDebug(1,spectra->Print(););
+    } else AliError("Error creating spectra");
   }
 
+  for ( size_t ib = 0; ib < binnings.size(); ++ib ) delete binnings[ib];
+
+  delete binTypeArray;
   delete eventTypeArray;
   delete TriggerArray;
   delete pairCutArray;
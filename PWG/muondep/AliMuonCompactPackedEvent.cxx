@@ -0,0 +1,55 @@
+#include "AliMuonCompactPackedEvent.h"
+
+#include "AliMuonCompactEvent.h"
+
+/// \ingroup compact
+UInt_t AliMuonCompactPackedEvent::PackCluster(const AliMuonCompactCluster& cl)
+{
+    /// Pack the two manu indices of a cluster in 32 bits
+    UInt_t b = static_cast<UInt_t>(cl.BendingManuIndex()+1) & 0x7FFF;
+    UInt_t nb = static_cast<UInt_t>(cl.NonBendingManuIndex()+1) & 0x7FFF;
+    return b | ( nb << 15 );
+}
+
+void AliMuonCompactPackedEvent::Pack(const AliMuonCompactEvent& event)
+{
+    /// Fill this packed event from a regular compact event
+    Clear();
+    mPt = event.mPt;
+    mY = event.mY;
+
+    for ( std::vector<AliMuonCompactTrack>::size_type i = 0;
+            i < event.mTracks.size(); ++i )
+    {
+        const AliMuonCompactTrack& track = event.mTracks[i];
+        mMomenta.push_back(track.mPx);
+        mMomenta.push_back(track.mPy);
+        mMomenta.push_back(track.mPz);
+        mNofClusters.push_back(track.mClusters.size());
+        for ( std::vector<AliMuonCompactCluster>::size_type j = 0;
+                j < track.mClusters.size(); ++j )
+        {
+            mClusters.push_back(PackCluster(track.mClusters[j]));
+        }
+    }
+}
+
+void AliMuonCompactPackedEvent::Unpack(AliMuonCompactEvent& event) const
+{
+    /// Convert this packed event back to a regular compact event
+    event.Clear();
+    event.SetInput(mPt,mY);
+
+    std::vector<UInt_t>::size_type icl = 0;
+
+    for ( std::vector<UShort_t>::size_type i = 0; i < mNofClusters.size(); ++i )
+    {
+        AliMuonCompactTrack track(mMomenta[3*i],mMomenta[3*i+1],mMomenta[3*i+2]);
+        for ( UShort_t j = 0; j < mNofClusters[i]; ++j, ++icl )
+        {
+            track.mClusters.push_back(AliMuonCompactCluster(BendingManuIndex(mClusters[icl]),
+                        NonBendingManuIndex(mClusters[icl])));
+        }
+        event.mTracks.push_back(track);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef ALIMUONCOMPACTPACKEDEVENT_H
+#define ALIMUONCOMPACTPACKEDEVENT_H
+
+#include <vector>
+#include "Rtypes.h"
+
+struct AliMuonCompactEvent;
+struct AliMuonCompactCluster;
+
+/**
+
+  @ingroup pwg_muondep_compact
+
+  @struct AliMuonCompactPackedEvent
+
+  @brief A bit-packed version of AliMuonCompactEvent
+
+  Same content as AliMuonCompactEvent, but stored as flat vectors
+  instead of vectors of tracks holding vectors of clusters :
+
+  - the momenta of all the tracks (px,py,pz per track), as Double32_t
+  - the number of clusters of each track
+  - the clusters of all the tracks, each one packed in 32 bits :
+    bits 0-14 are the bending manu index+1 and bits 15-29 the non-bending
+    manu index+1 (0 meaning no manu on this cathode). Absolute manu
+    indices are below 16828 (see AliMuonCompactMapping) so they fit in 15 bits
+
+*/
+
+struct AliMuonCompactPackedEvent
+{
+    AliMuonCompactPackedEvent() : mMomenta(), mNofClusters(), mClusters(), mPt(0), mY(0) {}
+
+    std::vector<Double32_t> mMomenta; // px,py,pz of each track
+    std::vector<UShort_t> mNofClusters; // number of clusters of each track
+    std::vector<UInt_t> mClusters; // packed clusters of all the tracks
+    Double32_t mPt; // input pt
+    Double32_t mY; // input rapidity
+
+    void Clear() { mMomenta.clear(); mNofClusters.clear(); mClusters.clear(); }
+
+    Int_t NofTracks() const { return mNofClusters.size(); }
+
+    void Pack(const AliMuonCompactEvent& event);
+    void Unpack(AliMuonCompactEvent& event) const;
+
+    static UInt_t PackCluster(const AliMuonCompactCluster& cl);
+    static Int_t BendingManuIndex(UInt_t packed) { return static_cast<Int_t>(packed & 0x7FFF) - 1; }
+    static Int_t NonBendingManuIndex(UInt_t packed) { return static_cast<Int_t>((packed >> 15) & 0x7FFF) - 1; }
+};
+
+#endif
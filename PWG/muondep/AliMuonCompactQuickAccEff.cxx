@@ -5,6 +5,7 @@
 #include "AliMuonCompactManuStatus.h"
 #include "AliMuonCompactManuStatus.h"
 #include "AliMuonCompactMapping.h"
+#include "AliMuonCompactPackedEvent.h"
 #include "TFile.h"
 #include "TGraphErrors.h"
 #include "TH1.h"
@@ -12,25 +13,42 @@
 #include "TMath.h"
 #include "TParameter.h"
 #include "TTree.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
 /// \ingroup compact
 AliMuonCompactQuickAccEff::AliMuonCompactQuickAccEff(int maxevents, bool rejectMonoCathodeClusters)
-    : fMaxEvents(maxevents), fRejectMonoCathodeClusters(rejectMonoCathodeClusters)
+    : fMaxEvents(maxevents), fRejectMonoCathodeClusters(rejectMonoCathodeClusters), fAllConfigurationsInOnePass(false)
 {
 }
 
 UInt_t AliMuonCompactQuickAccEff::GetEvents(TTree* tree,std::vector<AliMuonCompactEvent>& events, Bool_t verbose)
 {
-    /// Read events from the tree
+    /// Read events from the tree, written either as AliMuonCompactEvent
+    /// or as AliMuonCompactPackedEvent
     events.clear();
     AliMuonCompactEvent* compactEvent=0x0;
-    tree->SetBranchAddress("event",&compactEvent);
+    AliMuonCompactPackedEvent* packedEvent=0x0;
+    AliMuonCompactEvent unpackedEvent;
+
+    if ( tree->GetBranch("packedevent") )
+    {
+        tree->SetBranchAddress("packedevent",&packedEvent);
+        compactEvent = &unpackedEvent;
+    }
+    else
+    {
+        tree->SetBranchAddress("event",&compactEvent);
+    }
 
     for ( Long64_t i = 0; i < tree->GetEntries(); ++i )
     {
         tree->GetEntry(i);
+        if ( packedEvent )
+        {
+            packedEvent->Unpack(unpackedEvent);
+        }
         events.push_back(*compactEvent);
         if (verbose)
         {
@@ -258,6 +276,184 @@ TH1* AliMuonCompactQuickAccEff::ComputeMinv(const std::vector<AliMuonCompactEven
     return h;
 }
 
+void AliMuonCompactQuickAccEff::ComputeNofPairs(const std::vector<AliMuonCompactEvent>& events,
+        const std::vector<const std::vector<UInt_t>*>& manustatus,
+        const std::vector<UInt_t>& causeMask,
+        std::vector<Int_t>& npairs)
+{
+    /// Same as ComputeMinv (without histogram) for all the configurations
+    /// (manustatus[i],causeMask[i]) in one loop over the events.
+    ///
+    /// Configuration i is bit i%64 of word i/64 of the bitsets.
+    /// For each manu we get the bitset of the configurations where it is bad,
+    /// then for each cluster the bitset of the configurations where it is
+    /// valid, and for each track, from the stations and chambers hit, the
+    /// bitset of the configurations where it survives.
+    /// Tracks whose clusters are not ordered by chamber are checked with
+    /// ValidateTrack for each configuration, as the chamber counting
+    /// of ValidateTrack depends on the cluster order.
+
+    const std::vector<UInt_t>::size_type nconf = causeMask.size();
+    const Int_t nwords = (nconf+63)/64;
+
+    npairs.assign(nconf,0);
+    if (!nconf) return;
+
+    std::vector<Int_t> nValidatedTracks(nconf,0);
+    Int_t nTracks=0;
+
+    // existing configurations, and configurations where all the tracks are accepted
+    std::vector<ULong64_t> confMask(nwords,~0ULL);
+    if ( nconf%64 ) confMask[nwords-1] = ( 1ULL << (nconf%64) ) - 1;
+    std::vector<ULong64_t> allValid(nwords,0);
+
+    std::vector<UInt_t>::size_type nmanus = 0;
+    for ( std::vector<UInt_t>::size_type i = 0; i < nconf; ++i )
+    {
+        if ( manustatus[i]->empty() || causeMask[i] == 0 ) allValid[i/64] |= ( 1ULL << (i%64) );
+        nmanus = TMath::Max(nmanus,manustatus[i]->size());
+    }
+
+    // bad manu bitsets
+    std::vector<ULong64_t> badManus(nmanus*nwords,0);
+    for ( std::vector<UInt_t>::size_type i = 0; i < nconf; ++i )
+    {
+        const std::vector<UInt_t>& ms = *(manustatus[i]);
+        for ( std::vector<UInt_t>::size_type m = 0; m < ms.size(); ++m )
+        {
+            if ( ms[m] & causeMask[i] ) badManus[m*nwords+i/64] |= ( 1ULL << (i%64) );
+        }
+    }
+
+    const double m2 = 0.1056584*0.1056584;
+
+    uint64_t maxevents = fMaxEvents;
+
+    if (!maxevents) {
+        maxevents = events.size();
+    }
+
+    std::vector<ULong64_t> trackValid;
+    std::vector<ULong64_t> chamberHit(10*nwords);
+    std::vector<ULong64_t> noBad(nwords,0);
+
+    for ( std::vector<AliMuonCompactEvent>::size_type i = 0;
+             i < maxevents; ++i )
+    {
+        const AliMuonCompactEvent& e = events[i];
+
+        trackValid.assign(e.mTracks.size()*nwords,0);
+
+        for ( std::vector<AliMuonCompactTrack>::size_type j = 0;
+                j < e.mTracks.size(); ++j )
+        {
+            const AliMuonCompactTrack& t = e.mTracks[j];
+            ULong64_t* valid = &trackValid[j*nwords];
+
+            ++nTracks;
+
+            std::fill(chamberHit.begin(),chamberHit.end(),0);
+            Bool_t ordered = kTRUE;
+            Int_t previousCh = -1;
+
+            for ( std::vector<AliMuonCompactCluster>::size_type k = 0;
+                    k < t.mClusters.size(); ++k )
+            {
+                const AliMuonCompactCluster& cl = t.mClusters[k];
+
+                Int_t b = cl.BendingManuIndex();
+                Int_t nb = cl.NonBendingManuIndex();
+                const ULong64_t* badB = ( b >= 0 && b < (int)nmanus ) ? &badManus[b*nwords] : &noBad[0];
+                const ULong64_t* badNB = ( nb >= 0 && nb < (int)nmanus ) ? &badManus[nb*nwords] : &noBad[0];
+
+                Bool_t station12 = ( b >=0 && b < 7152 ) || ( nb >=0 && nb < 7152 );
+                Bool_t bothCathodes = fRejectMonoCathodeClusters && !station12;
+
+                Int_t ch = cl.DetElemId()/100 - 1;
+                if ( ch < previousCh ) ordered = kFALSE;
+                previousCh = ch;
+
+                ULong64_t* hit = &chamberHit[ch*nwords];
+                for ( Int_t w = 0; w < nwords; ++w )
+                {
+                    hit[w] |= ( bothCathodes ? ~(badB[w] | badNB[w]) : ~(badB[w] & badNB[w]) );
+                }
+            }
+
+            if ( ordered )
+            {
+                for ( Int_t w = 0; w < nwords; ++w )
+                {
+                    const ULong64_t* h = &chamberHit[w];
+                    // at least one cluster per station 
+                    ULong64_t v = ( h[0] | h[nwords] ) & ( h[2*nwords] | h[3*nwords] ) & ( h[4*nwords] | h[5*nwords] ) &
+                        ( h[6*nwords] | h[7*nwords] ) & ( h[8*nwords] | h[9*nwords] );
+                    // 2 chambers hit in the same station (4 or 5)
+                    v &= ( h[6*nwords] & h[7*nwords] ) | ( h[8*nwords] & h[9*nwords] );
+                    valid[w] = ( v | allValid[w] ) & confMask[w];
+                }
+            }
+            else
+            {
+                for ( std::vector<UInt_t>::size_type c = 0; c < nconf; ++c )
+                {
+                    if ( ValidateTrack(t,*(manustatus[c]),causeMask[c]) ) valid[c/64] |= ( 1ULL << (c%64) );
+                }
+            }
+
+            for ( std::vector<UInt_t>::size_type c = 0; c < nconf; ++c )
+            {
+                if ( ( valid[c/64] >> (c%64) ) & 1 ) ++nValidatedTracks[c];
+            }
+        }
+
+        for ( std::vector<AliMuonCompactTrack>::size_type j = 0;
+                j < e.mTracks.size(); ++j )
+        {
+            const AliMuonCompactTrack& t1 = e.mTracks[j];
+
+            for ( std::vector<AliMuonCompactTrack>::size_type k = j+1;
+                    k < e.mTracks.size(); ++k )
+            {
+                const AliMuonCompactTrack& t2 = e.mTracks[k];
+
+                double p1square = t1.mPx*t1.mPx +
+                    t1.mPy*t1.mPy +
+                    t1.mPz*t1.mPz;
+
+                double p2square = t2.mPx*t2.mPx +
+                    t2.mPy*t2.mPy +
+                    t2.mPz*t2.mPz;
+
+                double e = sqrt(m2+p1square+p2square+2.0*sqrt(p1square)*sqrt(p2square));
+                double pz = t1.mPz+t2.mPz;
+
+                double y = 0.5*log( (e+pz) / (e-pz) );
+
+                if ( y < -4 || y > -2.5 ) continue;
+
+                const ULong64_t* v1 = &trackValid[j*nwords];
+                const ULong64_t* v2 = &trackValid[k*nwords];
+
+                for ( Int_t w = 0; w < nwords; ++w )
+                {
+                    ULong64_t both = v1[w] & v2[w];
+                    for ( Int_t bit = 0; both; ++bit, both >>= 1 )
+                    {
+                        if ( both & 1 ) ++npairs[w*64+bit];
+                    }
+                }
+            }
+        }
+    }
+
+    for ( std::vector<UInt_t>::size_type c = 0; c < nconf; ++c )
+    {
+        std::cout << Form("config %4d nTracks %d nValidated %d npairs %d",(int)c,nTracks,
+                nValidatedTracks[c],npairs[c]) << std::endl;
+    }
+}
+
 void AliMuonCompactQuickAccEff::ComputeEvolution(const std::vector<AliMuonCompactEvent>& events, 
         std::vector<int>& vrunlist,
         const std::map<int,std::vector<UInt_t> >& manuStatusForRuns,
@@ -320,6 +516,25 @@ void AliMuonCompactQuickAccEff::ComputeEvolution(const std::vector<AliMuonCompac
         g->SetMarkerSize(1.5);
     }
 
+    // number of pairs for all the (run,cause) configurations, config = i*causes.size()+icause
+    std::vector<Int_t> npairsAll;
+
+    if ( fAllConfigurationsInOnePass )
+    {
+        std::vector<const std::vector<UInt_t>*> confManuStatus;
+        std::vector<UInt_t> confCauses;
+        for ( std::vector<int>::size_type i = 0; i < vrunlist.size(); ++i )
+        {
+            const std::vector<UInt_t>& manustatus = manuStatusForRuns.find(vrunlist[i])->second;
+            for ( std::vector<UInt_t>::size_type icause = 0; icause < causes.size(); ++icause )
+            {
+                confManuStatus.push_back(&manustatus);
+                confCauses.push_back(causes[icause]);
+            }
+        }
+        ComputeNofPairs(events,confManuStatus,confCauses,npairsAll);
+    }
+
     for ( std::vector<int>::size_type i = 0; i < vrunlist.size(); ++i )
     {
         Int_t runNumber = vrunlist[i];
@@ -341,7 +556,16 @@ void AliMuonCompactQuickAccEff::ComputeEvolution(const std::vector<AliMuonCompac
                 nbad
                 );
             Int_t npairs(0);
-            TH1* h = ComputeMinv(events,manustatus,causes[icause],npairs);
+            TH1* h = 0x0;
+            if ( fAllConfigurationsInOnePass )
+            {
+                npairs = npairsAll[i*causes.size()+icause];
+                std::cout << Form("npairs %d",npairs) << std::endl;
+            }
+            else
+            {
+                h = ComputeMinv(events,manustatus,causes[icause],npairs);
+            }
             if (h)
             {
                 h->SetName(Form("hminv%6d%s",runNumber,AliMuonCompactManuStatus::CauseAsString(causes[icause]).c_str()));
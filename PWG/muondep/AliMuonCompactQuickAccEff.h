@@ -22,6 +22,12 @@ class TTree;
   This class is meant to get a quick computation of
   the evolution of the Acc x Eff for some runs.
 
+  With SetAllConfigurationsInOnePass() all the (run,cause) manu status
+  configurations are tested in a single loop over the events : for each
+  manu, the configurations where it is bad are stored in a bitset, so
+  that each cluster, track and pair is checked for all the configurations
+  at once with bitwise operations.
+
 */
 
 
@@ -31,6 +37,8 @@ class AliMuonCompactQuickAccEff
 
         AliMuonCompactQuickAccEff(int maxevents=0, bool rejectMonoCathodeClusters=false);
 
+        void SetAllConfigurationsInOnePass(bool value=true) { fAllConfigurationsInOnePass = value; }
+
         void ComputeEvolution(const std::vector<AliMuonCompactEvent>& events, 
                 std::vector<int>& vrunlist,
                 const std::map<int,std::vector<UInt_t> >& manuStatusForRuns,
@@ -50,6 +58,11 @@ class AliMuonCompactQuickAccEff
                 UInt_t causeMask,
                 Int_t& npairs);
 
+        void ComputeNofPairs(const std::vector<AliMuonCompactEvent>& events,
+                const std::vector<const std::vector<UInt_t>*>& manustatus,
+                const std::vector<UInt_t>& causeMask,
+                std::vector<Int_t>& npairs);
+
         void ComputeEvolutionFromManuStatus(const char* treeFile,
                 const char* runList,
                 const char* outputfile,
@@ -64,6 +77,7 @@ class AliMuonCompactQuickAccEff
     private:
         ULong64_t fMaxEvents;
         bool fRejectMonoCathodeClusters;
+        bool fAllConfigurationsInOnePass;
 };
 
 #endif
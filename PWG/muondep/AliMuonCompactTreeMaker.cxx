@@ -40,13 +40,13 @@ namespace {
 ClassImp(AliMuonCompactTreeMaker)
 
 AliMuonCompactTreeMaker::AliMuonCompactTreeMaker(const char* ocdbPath): 
-    AliAnalysisTaskSE("AliMuonCompactTreeMaker"), fOCDBPath(ocdbPath), fRunNumber(-1), fGeometryTransformer(nullptr), fOutputTree(nullptr), fCompactEvent()
+    AliAnalysisTaskSE("AliMuonCompactTreeMaker"), fOCDBPath(ocdbPath), fRunNumber(-1), fGeometryTransformer(nullptr), fOutputTree(nullptr), fCompactEvent(), fPackedOutput(kFALSE), fPackedEvent()
 {
     DefineOutput(1,TTree::Class());
 }
 
 AliMuonCompactTreeMaker::AliMuonCompactTreeMaker(): 
-    AliAnalysisTaskSE("AliMuonCompactTreeMaker"), fOCDBPath(), fRunNumber(-1), fGeometryTransformer(nullptr), fOutputTree(nullptr), fCompactEvent()
+    AliAnalysisTaskSE("AliMuonCompactTreeMaker"), fOCDBPath(), fRunNumber(-1), fGeometryTransformer(nullptr), fOutputTree(nullptr), fCompactEvent(), fPackedOutput(kFALSE), fPackedEvent()
 {
 }
 
@@ -197,6 +197,11 @@ void AliMuonCompactTreeMaker::UserExec(Option_t*)
         }
     }
 
+    if ( fPackedOutput )
+    {
+        fPackedEvent.Pack(fCompactEvent);
+    }
+
     fOutputTree->Fill();
     PostData(1,fOutputTree);
 }
@@ -206,7 +211,14 @@ void AliMuonCompactTreeMaker::UserCreateOutputObjects()
     OpenFile(1);
 
     fOutputTree = new TTree("compactevents","a tree with compacted tracks");
-    fOutputTree->Branch("event",&fCompactEvent);
+    if ( fPackedOutput )
+    {
+        fOutputTree->Branch("packedevent",&fPackedEvent);
+    }
+    else
+    {
+        fOutputTree->Branch("event",&fCompactEvent);
+    }
 
     PostData(1,fOutputTree);
 }
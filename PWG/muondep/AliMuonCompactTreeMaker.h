@@ -4,6 +4,7 @@
 #include <string>
 #include "Rtypes.h"
 #include "AliMuonCompactEvent.h"
+#include "AliMuonCompactPackedEvent.h"
 
 class AliESDEvent;
 class AliMUONGeometryTransformer;
@@ -21,6 +22,9 @@ class TTree;
 
 @brief Class to transform regular ESD into a very compact muon one
 
+With SetPackedOutput() the events are written as AliMuonCompactPackedEvent
+(branch "packedevent") instead of AliMuonCompactEvent (branch "event").
+
 */
 
 class AliMuonCompactTreeMaker : public AliAnalysisTaskSE
@@ -34,6 +38,8 @@ class AliMuonCompactTreeMaker : public AliAnalysisTaskSE
         AliMuonCompactTreeMaker(const char* ocdbPath);
         AliMuonCompactTreeMaker();
 
+        void SetPackedOutput(Bool_t value=kTRUE) { fPackedOutput = value; }
+
     private:
 
         void CleanupOCDB();
@@ -50,8 +56,10 @@ class AliMuonCompactTreeMaker : public AliAnalysisTaskSE
         AliMUONGeometryTransformer* fGeometryTransformer;
         TTree* fOutputTree;
         AliMuonCompactEvent fCompactEvent;
+        Bool_t fPackedOutput; // write AliMuonCompactPackedEvent instead of AliMuonCompactEvent
+        AliMuonCompactPackedEvent fPackedEvent; //! packed version of fCompactEvent
 
-    ClassDef(AliMuonCompactTreeMaker,1)
+    ClassDef(AliMuonCompactTreeMaker,2)
 };
 
 #endif
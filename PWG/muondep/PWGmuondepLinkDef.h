@@ -35,6 +35,7 @@
 #pragma link C++ class AliMuonCompactEvent+;
 #pragma link C++ class AliMuonCompactTrack+;
 #pragma link C++ class AliMuonCompactCluster+;
+#pragma link C++ class AliMuonCompactPackedEvent+;
 #pragma link C++ class AliMuonCompactTreeMaker+;
 #pragma link C++ class AliMuonCompactManuStatus+;
 #pragma link C++ class AliMuonCompactQuickAccEff+;
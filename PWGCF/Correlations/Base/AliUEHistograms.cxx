@@ -77,7 +77,8 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fTwoTrackRadii()
 {
   // Constructor
   //
@@ -248,7 +249,8 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
   fRunNumber(0),
-  fMergeCount(1)
+  fMergeCount(1),
+  fTwoTrackRadii()
 {
   //
   // AliUEHistograms copy constructor
@@ -540,6 +542,60 @@ void AliUEHistograms::Fill(AliVParticle* leadingMC, AliVParticle* leadingReco)
   }
 }
 
+//____________________________________________________________________
+void AliUEHistograms::PrepareDPhiStarTerms(Int_t nTriggers, Int_t nAssociated)
+{
+  // prepares the per-track lookup of the dphistar bending terms for one call of FillCorrelations
+  //
+  // dphistar = phi1 - phi2 - charge1 * bSign * asin(0.075 r / pt1) + charge2 * bSign * asin(0.075 r / pt2) is separable in the two tracks,
+  // therefore the term of each track is computed once per radius instead of once per pair and radius.
+  // Terms are filled lazily in GetDPhiStarTerms as only tracks which pass the deta requirement need them.
+  // nAssociated is 0 for same-event correlations where the trigger table is used for both tracks.
+  
+  if (fTwoTrackRadii.size() == 0 || fTwoTrackRadii[0] != fTwoTrackCutMinRadius)
+  {
+    fTwoTrackRadii.clear();
+    fTwoTrackRadii.push_back(fTwoTrackCutMinRadius);
+    fTwoTrackRadii.push_back(2.5);
+    // same accumulation as the original scan to obtain bit-identical radii
+    for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01)
+      fTwoTrackRadii.push_back(rad);
+  }
+  
+  const Int_t nRadii = fTwoTrackRadii.size();
+  const Int_t nTracks[2] = { nTriggers, nAssociated };
+  for (Int_t table=0; table<2; table++)
+  {
+    if ((Int_t) fDPhiStarTerms[table].size() < nTracks[table] * nRadii)
+      fDPhiStarTerms[table].resize(nTracks[table] * nRadii);
+    fDPhiStarTermsFilled[table].assign(nTracks[table], 0);
+  }
+}
+
+//____________________________________________________________________
+const Double_t* AliUEHistograms::GetDPhiStarTerms(Int_t table, Int_t index, AliVParticle* particle, Float_t bSign)
+{
+  // returns the bending terms charge * bSign * asin(0.075 r / pt) of the given track for all radii in fTwoTrackRadii
+  // the arithmetic follows GetDPhiStar so that the resulting dphistar values are unchanged
+  
+  const Int_t nRadii = fTwoTrackRadii.size();
+  Double_t* terms = &fDPhiStarTerms[table][index * nRadii];
+  
+  if (!fDPhiStarTermsFilled[table][index])
+  {
+    Float_t pt = particle->Pt();
+    Float_t charge = particle->Charge();
+    Float_t chargeBSign = charge * bSign;
+    
+    for (Int_t k=0; k<nRadii; k++)
+      terms[k] = chargeBSign * TMath::ASin(0.075 * fTwoTrackRadii[k] / pt);
+    
+    fDPhiStarTermsFilled[table][index] = 1;
+  }
+  
+  return terms;
+}
+
 //____________________________________________________________________
 void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency)
 {
@@ -572,6 +628,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   for (Int_t i=0; i<input->GetEntriesFast(); i++)
     eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
   
+  // the two-track cut evaluates dphistar at many radii, the single-track terms are cached per call
+  if (twoTrackEfficiencyCut && particles)
+    PrepareDPhiStarTerms(particles->GetEntriesFast(), (mixed) ? mixed->GetEntriesFast() : 0);
+  
   // if particles is not set, just fill event statistics
   if (particles)
   {
@@ -841,20 +901,24 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 
 	  Float_t phi1 = triggerParticle->Phi();
 	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
 	    
 	  Float_t phi2 = particle->Phi();
 	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
 	      
 	  Float_t deta = triggerEta - eta[j];
 	      
 	  // optimization
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	  {
+	    // per-track terms of dphistar, see GetDPhiStar; entry 0 is at fTwoTrackCutMinRadius, 1 at 2.5, then the radius scan
+	    const Double_t* terms1 = GetDPhiStarTerms(0, i, triggerParticle, bSign);
+	    const Double_t* terms2 = GetDPhiStarTerms((mixed) ? 1 : 0, j, particle, bSign);
+	    const Int_t nRadii = fTwoTrackRadii.size();
+	    Float_t dphi = phi1 - phi2;
+	    
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+	    Float_t dphistar1 = WrapDPhiStar(dphi - terms1[0] + terms2[0]);
+	    Float_t dphistar2 = WrapDPhiStar(dphi - terms1[1] + terms2[1]);
 	    
 	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
 
@@ -862,9 +926,9 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	    Float_t dphistarmin = 1e5;
 	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+	      for (Int_t k=2; k<nRadii; k++) 
 	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+		Float_t dphistar = WrapDPhiStar(dphi - terms1[k] + terms2[k]);
 
 		Float_t dphistarabs = TMath::Abs(dphistar);
 		
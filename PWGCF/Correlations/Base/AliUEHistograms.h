@@ -12,6 +12,7 @@
 #include "AliUEHist.h"
 #include "TMath.h"
 #include "THn.h" // in cxx file causes .../THn.h:257: error: conflicting declaration ‘typedef class THnT<float> THnF’
+#include <vector>
 
 class AliVParticle;
 
@@ -113,6 +114,9 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t WrapDPhiStar(Float_t dphistar);
+  void PrepareDPhiStarTerms(Int_t nTriggers, Int_t nAssociated);
+  const Double_t* GetDPhiStarTerms(Int_t table, Int_t index, AliVParticle* particle, Float_t bSign);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -163,6 +167,10 @@ protected:
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
+  std::vector<Float_t> fTwoTrackRadii;          //! radii at which dphistar is evaluated: min radius, 2.5, then the scan from min radius to 2.5 in steps of 0.01
+  std::vector<Double_t> fDPhiStarTerms[2];      //! per-track bending terms charge*bSign*asin(0.075*r/pt) for each radius (0: trigger/same event, 1: mixed associated)
+  std::vector<Char_t> fDPhiStarTermsFilled[2];  //! flags which entries of fDPhiStarTerms are computed for the current call
+  
   ClassDef(AliUEHistograms, 31)  // underlying event histogram container
 };
 
@@ -174,6 +182,15 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   
   Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
   
+  return WrapDPhiStar(dphistar);
+}
+
+Float_t AliUEHistograms::WrapDPhiStar(Float_t dphistar)
+{
+  //
+  // brings dphistar into the range [-pi, pi]
+  //
+  
   static const Double_t kPi = TMath::Pi();
   
   // circularity
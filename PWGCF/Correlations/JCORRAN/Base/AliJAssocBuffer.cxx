@@ -0,0 +1,101 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// Associated particles of one event, packed and bucketed by pT bin
+
+#include <TClonesArray.h>
+
+#include "AliJAssocBuffer.h"
+#include "AliJBaseTrack.h"
+
+AliJAssocBuffer::AliJAssocBuffer() :
+  fTracks(),
+  fBinFirst(),
+  fBinCount()
+{
+  // default constructor
+}
+
+void AliJAssocBuffer::Clear(){
+  // empty the buffer, keeping the allocated memory
+  fTracks.clear();
+  fBinFirst.clear();
+}
+
+void AliJAssocBuffer::Fill(TClonesArray *list){
+  // Pack the tracks of the list, sorted by associated pT bin.
+  // Tracks outside of the associated pT bins are not kept.
+
+  Clear();
+
+  int noTracks = list->GetEntriesFast();
+
+  // count the tracks per bin
+  fBinCount.clear();
+  for(int i=0;i<noTracks;i++){
+    AliJBaseTrack *track = (AliJBaseTrack*)list->At(i);
+    int iBin = track->GetAssocBin();
+    if(iBin<0) continue;
+    if(iBin >= (int)fBinCount.size()) fBinCount.resize(iBin+1, 0);
+    fBinCount[iBin]++;
+  }
+
+  int noBins = fBinCount.size();
+  fBinFirst.resize(noBins+1, 0);
+  for(int iBin=0;iBin<noBins;iBin++){
+    fBinFirst[iBin+1] = fBinFirst[iBin] + fBinCount[iBin];
+    fBinCount[iBin] = fBinFirst[iBin]; // next position to fill in the bin
+  }
+
+  fTracks.resize(fBinFirst[noBins]);
+  for(int i=0;i<noTracks;i++){
+    AliJBaseTrack *track = (AliJBaseTrack*)list->At(i);
+    int iBin = track->GetAssocBin();
+    if(iBin<0) continue;
+    Pack(*track, fTracks[fBinCount[iBin]++]);
+  }
+}
+
+void AliJAssocBuffer::Pack(const AliJBaseTrack &track, AliJPackedTrack &packed){
+  // pack the variables used by the correlation analysis
+
+  packed.fPx       = track.Px();
+  packed.fPy       = track.Py();
+  packed.fPz       = track.Pz();
+  packed.fE        = track.E();
+  packed.fPt       = track.Pt();
+  packed.fEta      = track.Eta();
+  packed.fPhi      = track.Phi();
+  packed.fEff      = track.GetTrackEff();
+  packed.fID       = track.GetID();
+  packed.fFlags    = track.GetFlags();
+  packed.fType     = track.GetParticleType();
+  packed.fCharge   = track.GetCharge();
+  packed.fTriggBin = track.GetTriggBin();
+  packed.fAssocBin = track.GetAssocBin();
+}
+
+void AliJAssocBuffer::Unpack(const AliJPackedTrack &packed, AliJBaseTrack &track){
+  // set back a track from the packed variables
+
+  track.SetPxPyPzE(packed.fPx, packed.fPy, packed.fPz, packed.fE);
+  track.SetID(packed.fID);
+  track.SetFlags(packed.fFlags);
+  track.SetParticleType(packed.fType);
+  track.SetCharge(packed.fCharge);
+  track.SetTriggBin(packed.fTriggBin);
+  track.SetAssocBin(packed.fAssocBin);
+  track.SetTrackEff(packed.fEff);
+}
@@ -0,0 +1,69 @@
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice */
+
+// Associated particles of one event, packed and bucketed by pT bin
+
+//===========================================================
+// AliJAssocBuffer.h
+//
+//   The associated particles are stored as plain structures
+//   (momentum, eta, phi, efficiency, ID, charge, type, bins)
+//   sorted by their associated pT bin, so that the correlation
+//   kernel can loop over one pT bin at a time without touching
+//   the TClonesArray of tracks. Used for the real events and
+//   as storage of the event pool.
+//===========================================================
+
+#ifndef ALIJASSOCBUFFER_H
+#define ALIJASSOCBUFFER_H
+
+#include <vector>
+
+class TClonesArray;
+class AliJBaseTrack;
+
+struct AliJPackedTrack {
+  float fPx;      // momentum x
+  float fPy;      // momentum y
+  float fPz;      // momentum z
+  float fE;       // energy
+  float fPt;      // transverse momentum
+  float fEta;     // pseudorapidity
+  float fPhi;     // azimuthal angle, as AliJBaseTrack::Phi()
+  float fEff;     // track efficiency
+  int   fID;      // track ID
+  unsigned int fFlags; // AliJBaseTrack flags (isolation, primary)
+  short fType;    // particle type
+  short fCharge;  // charge
+  short fTriggBin; // trigger pT bin
+  short fAssocBin; // associated pT bin
+};
+
+class AliJAssocBuffer {
+
+public:
+
+  AliJAssocBuffer();
+  virtual ~AliJAssocBuffer(){;}
+
+  void Clear();
+  void Fill(TClonesArray *list);
+
+  int GetEntries() const { return fTracks.size(); }
+  int GetNBins() const { return fBinFirst.size()>0 ? fBinFirst.size()-1 : 0; }
+  int GetBinFirst(int iBin) const { return fBinFirst[iBin]; }
+  int GetBinLast(int iBin) const { return fBinFirst[iBin+1]; }
+  const AliJPackedTrack & At(int i) const { return fTracks[i]; }
+
+  static void Pack(const AliJBaseTrack &track, AliJPackedTrack &packed);
+  static void Unpack(const AliJPackedTrack &packed, AliJBaseTrack &track);
+
+private:
+
+  std::vector<AliJPackedTrack> fTracks;  // tracks sorted by associated pT bin
+  std::vector<int> fBinFirst;            // first track of each pT bin, one more entry for the end
+  std::vector<int> fBinCount;            // number of tracks per pT bin, used while filling
+
+};
+
+#endif
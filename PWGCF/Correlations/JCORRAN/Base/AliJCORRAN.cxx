@@ -26,6 +26,7 @@
 #include "AliJHistos.h"
 #include "AliJCorrelations.h"
 #include "AliJEventPool.h"
+#include "AliJAssocBuffer.h"
 #include "AliJDataManager.h"
 
 #include "AliJEventHeader.h"
@@ -63,6 +64,7 @@ ClassImp(AliJCORRAN)
         fpizeroList(0), 
         ftriggList(0),  
         fassocList(0), 
+        fassocBuffer(0), 
         fpairList(0), 
         fpairCounterList(0), 
         finputList(0), 
@@ -112,6 +114,7 @@ AliJCORRAN::AliJCORRAN(Bool_t execLocal) :
     fpizeroList(0), 
     ftriggList(0),  
     fassocList(0), 
+    fassocBuffer(0), 
     fpairList(0), 
     fpairCounterList(0), 
     finputList(0), 
@@ -165,6 +168,7 @@ AliJCORRAN::AliJCORRAN(const AliJCORRAN& obj) :
     fpizeroList(obj.fpizeroList), 
     ftriggList(obj.ftriggList),  
     fassocList(obj.fassocList), 
+    fassocBuffer(obj.fassocBuffer), 
     fpairList(obj.fpairList), 
     fpairCounterList(obj.fpairCounterList), 
     finputList(obj.finputList), 
@@ -267,6 +271,7 @@ void AliJCORRAN::UserCreateOutputObjects(){
   fpizeroList = new TClonesArray(kParticleProtoType[kJPizero],1500);
   ftriggList  = new TClonesArray(kParticleProtoType[fjtrigg],1500);
   fassocList  = new TClonesArray(kParticleProtoType[fjassoc],1500);
+  fassocBuffer = new AliJAssocBuffer();
   fpairList     = new TClonesArray(kParticleProtoType[fjtrigg],1500);
   fpairCounterList  = new TClonesArray("AliJTrackCounter",1500);
   finputList = NULL;
@@ -653,7 +658,8 @@ void AliJCORRAN::UserExec(){
 	//if(noTriggs==0 || ((fjtrigg==kPizero) && (fjassoc==kPizero)) )
 	//if(leadingPt<1.5) //should be fixed
 	//if(noTriggs==0 && noAssocs>0 ){}
-	if(noAssocs>0 ) fassocPool->AcceptList(fassocList, fcent, zVert, noAllChargedTracks, fevt);
+	fassocBuffer->Fill(fassocList);
+	if(noAssocs>0 ) fassocPool->AcceptList(*fassocBuffer, fcent, zVert, noAllChargedTracks, fevt);
 
 	//------------------------------------------------------------------
 	// Do the Correlation 
@@ -681,6 +687,12 @@ void AliJCORRAN::UserExec(){
 
 		if(triggTr->GetIsIsolated()>0) fhistos->fhTriggPtBinIsolTrigg[kReal][cBin][iptt]->Fill(ptt, effCorr);
 
+		if(!fbLPpairCorrel){
+			// all the assoc, one pT bin at a time
+			fcorrelations->FillAzimuthHistos(kReal, cBin, zBin, triggTr, *fassocBuffer);
+			continue;
+		}
+
 		for(int jj=0;jj<noAssocs;jj++){ // assoc loop
 			AliJBaseTrack  *assocTr = (AliJBaseTrack*)fassocList->At(jj);
 			//assocTr->PrintOut("assoc track");
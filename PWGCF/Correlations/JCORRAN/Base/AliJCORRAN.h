@@ -16,6 +16,7 @@ class AliJHistos;
 class AliJCorrelations;
 class AliJEventHeader;
 class AliJEventPool;
+class AliJAssocBuffer;
 class AliJHistos;
 class AliJRunHeader;
 class AliJEfficiency;
@@ -98,6 +99,7 @@ class AliJCORRAN : public TObject
 	TClonesArray *fpizeroList; //!
 	TClonesArray *ftriggList; //! 
 	TClonesArray *fassocList; //!
+	AliJAssocBuffer *fassocBuffer; //! assoc list packed by pT bin
 	TClonesArray *fpairList; //!
 	TClonesArray *fpairCounterList; //!
 	TClonesArray *finputList; //!
@@ -131,7 +133,7 @@ class AliJCORRAN : public TObject
 	float fIsolationR; // comment1
 	int fHadronSelectionCut; /// comment2
 
-	ClassDef(AliJCORRAN, 1); // EMCAL for jcorran
+	ClassDef(AliJCORRAN, 2); // EMCAL for jcorran
 
 };
 
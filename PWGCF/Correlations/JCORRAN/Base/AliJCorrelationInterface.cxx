@@ -16,9 +16,24 @@
 // Interface that all correlation analysis must fulfill
 
 #include "AliJCorrelationInterface.h"
+#include "AliJAssocBuffer.h"
 
 
 AliJCorrelationInterface::AliJCorrelationInterface()
 {
   // default constructor
-}
\ No newline at end of file
+}
+
+void AliJCorrelationInterface::FillHisto(corrFillType cFTyp, fillType fTyp, int cBin, int zBin, AliJBaseTrack *ftk1, const AliJAssocBuffer &assocs, bool leadingParticle){
+  // Correlate the trigger with all the tracks of the buffer. The tracks are unpacked
+  // one by one and passed to the pair filler. Analyses can override this with a kernel
+  // working directly on the packed tracks.
+  
+  AliJBaseTrack assocTrack;
+  for(int jj=0;jj<assocs.GetEntries();jj++){
+    const AliJPackedTrack &packed = assocs.At(jj);
+    if(leadingParticle && ftk1->Pt() < packed.fPt) continue; // In leading particle correlations, accept only those associated particles whose pT is lower than that of the trigger
+    AliJAssocBuffer::Unpack(packed, assocTrack);
+    FillHisto(cFTyp, fTyp, cBin, zBin, ftk1, &assocTrack);
+  }
+}
@@ -17,6 +17,8 @@
 
 using namespace std;
 
+class AliJAssocBuffer;
+
 class AliJCorrelationInterface {
   
 public:
@@ -25,6 +27,7 @@ public:
   virtual ~AliJCorrelationInterface(){;} //destructor
   
   virtual void FillHisto(corrFillType cFTyp, fillType fTyp, int cBin, int zBin, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2) = 0; // virtual histogram filler method needed in AliJEventPool.cxx
+  virtual void FillHisto(corrFillType cFTyp, fillType fTyp, int cBin, int zBin, AliJBaseTrack *ftk1, const AliJAssocBuffer &assocs, bool leadingParticle = false); // trigger with all the tracks of a packed buffer, by default one pair at a time
 
 };
 
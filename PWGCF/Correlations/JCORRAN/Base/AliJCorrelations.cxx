@@ -23,6 +23,7 @@
 #include "AliJCard.h"
 #include "AliJHistos.h"
 #include "AliJRunTable.h"
+#include "AliJAssocBuffer.h"
 
 
 
@@ -71,7 +72,8 @@ AliJCorrelations::AliJCorrelations( AliJCard *cardIn, AliJHistos *histosIn) :
   fXlongBin(0),
   fIsLikeSign(false),
   fGeometricAcceptanceCorrection(1),
-  fGeometricAcceptanceCorrection3D(1)
+  fGeometricAcceptanceCorrection3D(1),
+  fQualityControlLevel(0)
 {
   // constructor
   
@@ -84,6 +86,8 @@ AliJCorrelations::AliJCorrelations( AliJCard *cardIn, AliJHistos *histosIn) :
   cout << fmaxEtaRange <<" fDPhiUERegion[0]="<< fDPhiUERegion[0] <<" fDPhiUERegion[1]="<< fDPhiUERegion[1] <<endl;
   fIsHeavyIon = AliJRunTable::GetInstance().IsHeavyIon();
   fAcceptanceCorrection = new AliJAcceptanceCorrection(cardIn);
+  fQualityControlLevel = int(fcard->Get("QualityControlLevel"));
+  fPairBinHistos.fKey[0] = -1;
 
   // -----------------------------------------------------------------------------------------------
   // HARD CODED NUMBERS - VIOLATIONS - BREAKS the code when only on bin used in card.input!!!
@@ -140,9 +144,11 @@ AliJCorrelations::AliJCorrelations() :
   fXlongBin(0),
   fIsLikeSign(false),
   fGeometricAcceptanceCorrection(1),
-  fGeometricAcceptanceCorrection3D(1)
+  fGeometricAcceptanceCorrection3D(1),
+  fQualityControlLevel(0)
 {
   // default constructor
+  fPairBinHistos.fKey[0] = -1;
 }
 
 AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
@@ -183,7 +189,8 @@ AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
   fXlongBin(in.fXlongBin),
   fIsLikeSign(in.fIsLikeSign),
   fGeometricAcceptanceCorrection(in.fGeometricAcceptanceCorrection),
-  fGeometricAcceptanceCorrection3D(in.fGeometricAcceptanceCorrection3D)
+  fGeometricAcceptanceCorrection3D(in.fGeometricAcceptanceCorrection3D),
+  fQualityControlLevel(in.fQualityControlLevel)
 {
   // The pointers to card and histos are just copied. I think this is safe, since they are not created by
   // AliJCorrelations and thus should not disappear if the AliJCorrelation managing them is destroyed.
@@ -197,6 +204,7 @@ AliJCorrelations::AliJCorrelations(const AliJCorrelations& in) :
   
   frandom = new TRandom3(); // frandom generator for jt flow UE
   frandom->SetSeed(0);
+  fPairBinHistos.fKey[0] = -1;
 }
 
 AliJCorrelations& AliJCorrelations::operator=(const AliJCorrelations& in){
@@ -238,6 +246,8 @@ AliJCorrelations& AliJCorrelations::operator=(const AliJCorrelations& in){
   fawayPhiGap = in.fawayPhiGap;
   fmaxEtaRange = in.fmaxEtaRange;
   fRSignalBin = in.fRSignalBin;
+  fQualityControlLevel = in.fQualityControlLevel;
+  fPairBinHistos.fKey[0] = -1;
   
   // The pointers to card and histos are just copied. I think this is safe, since they are not created by
   // AliJCorrelations and thus should not disappear if the AliJCorrelation managing them is destroyed.
@@ -267,60 +277,125 @@ void AliJCorrelations::FillHisto(corrFillType cFTyp, fillType fTyp, int cBin, in
   
 }
 
+void AliJCorrelations::FillHisto(corrFillType cFTyp, fillType fTyp, int cBin, int zBin, AliJBaseTrack *ftk1, const AliJAssocBuffer &assocs, bool leadingParticle){
+  // histo filler for a trigger and a buffer of associated tracks
+  if( cFTyp == kAzimuthFill )
+    FillAzimuthHistos( fTyp, cBin, zBin, ftk1, assocs, leadingParticle);
+  
+}
+
 //=============================================================================================
 void AliJCorrelations::FillAzimuthHistos(fillType fTyp, int CentBin, int ZBin, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2)
 //=============================================================================================
+{
+  // histo filler for one pair
+  AliJPackedTrack trigg, assoc;
+  AliJAssocBuffer::Pack(*ftk1, trigg);
+  AliJAssocBuffer::Pack(*ftk2, assoc);
+  FillAzimuthPair(fTyp, CentBin, ZBin, trigg, assoc);
+}
+
+//=============================================================================================
+void AliJCorrelations::FillAzimuthHistos(fillType fTyp, int CentBin, int ZBin, AliJBaseTrack *ftk1, const AliJAssocBuffer &assocs, bool leadingParticle)
+//=============================================================================================
+{
+  // histo filler for a trigger and all the associated tracks of the buffer,
+  // one associated pT bin after the other so that the histograms of the bin are reused
+  AliJPackedTrack trigg;
+  AliJAssocBuffer::Pack(*ftk1, trigg);
+  
+  for(int iBin=0; iBin<assocs.GetNBins(); iBin++){
+    for(int jj=assocs.GetBinFirst(iBin); jj<assocs.GetBinLast(iBin); jj++){
+      const AliJPackedTrack &assoc = assocs.At(jj);
+      if(leadingParticle && trigg.fPt < assoc.fPt) continue; // In leading particle correlations, accept only those associated particles whose pT is lower than that of the trigger
+      FillAzimuthPair(fTyp, CentBin, ZBin, trigg, assoc);
+    }
+  }
+}
+
+//=============================================================================================
+void AliJCorrelations::SetPairBins(fillType fTyp, int cBin, int zBin, int pttBin, int ptaBin)
+//=============================================================================================
+{
+  // Forget the histograms of the previous pair if its bins are different
+  PairBinHistos &h = fPairBinHistos;
+  if( h.fKey[0] == fTyp && h.fKey[1] == cBin && h.fKey[2] == zBin && h.fKey[3] == pttBin && h.fKey[4] == ptaBin ) return;
+  
+  h.fKey[0] = fTyp;
+  h.fKey[1] = cBin;
+  h.fKey[2] = zBin;
+  h.fKey[3] = pttBin;
+  h.fKey[4] = ptaBin;
+  
+  for(int i=0; i<3; i++) h.fxEPtBin[i] = 0;
+  h.fxEN = 0;
+  h.fxEF = 0;
+  h.fxEFIsolTrigg = 0;
+  h.fDetaNearMixAcceptance = 0;
+  h.fDEtaFar = 0;
+  h.fDphiAssocIsolTrigg = 0;
+  h.fDphiDetaPta = 0;
+  h.fAssocPtBin = 0;
+  h.fMeanPtAssoc = 0;
+  h.fMeanZtAssoc = 0;
+  h.fPtAssocUEIsolTrigg = 0;
+  h.fPtAssocN = 0;
+  h.fPtAssocF = 0;
+  h.fDphiAssoc2DIAA = 0;
+}
+
+//=============================================================================================
+void AliJCorrelations::FillAzimuthPair(fillType fTyp, int CentBin, int ZBin, const AliJPackedTrack &trigg, const AliJPackedTrack &assoc)
+//=============================================================================================
 {
   // histo filler
   bool twoTracks = false;
-  if(ftk1->GetParticleType()==kJHadron && ftk2->GetParticleType()==kJHadron) twoTracks =true;
+  if(trigg.fType==kJHadron && assoc.fType==kJHadron) twoTracks =true;
   
   //double-counting check
-  if(fTyp == kReal && twoTracks && ftk1->GetID()==ftk2->GetID()) return;
+  if(fTyp == kReal && twoTracks && trigg.fID==assoc.fID) return;
   
   // Check the signs of the paired particles
   fIsLikeSign = false;
-  if(ftk1->GetCharge() > 0 && ftk2->GetCharge() > 0) fIsLikeSign = true;
-  if(ftk1->GetCharge() < 0 && ftk2->GetCharge() < 0) fIsLikeSign = true;
+  if(trigg.fCharge > 0 && assoc.fCharge > 0) fIsLikeSign = true;
+  if(trigg.fCharge < 0 && assoc.fCharge < 0) fIsLikeSign = true;
   
   //----------------------------------------------------------------
-  fptt = ftk1->Pt();
-  fpta = ftk2->Pt();
+  fptt = trigg.fPt;
+  fpta = assoc.fPt;
   
-  fTrackPairEfficiency = 1./( ftk1->GetTrackEff() * ftk2->GetTrackEff() );
+  fTrackPairEfficiency = 1./( trigg.fEff * assoc.fEff );
   
-  fIsIsolatedTrigger =  ftk1->GetIsIsolated()>0  ? true : false; //FK// trigger particle is isolated hadron
+  fIsIsolatedTrigger =  TESTBIT(trigg.fFlags, AliJBaseTrack::kIsIsolated) ? true : false; //FK// trigger particle is isolated hadron
   
-  TLorentzVector vTrigger = ftk1->GetLorentzVector(), vAssoc = ftk2->GetLorentzVector();    // Lorentz vectors for trigger and associated particles
+  // Scalar product of the trigger and associated momenta
+  double pDot = trigg.fPx*assoc.fPx + trigg.fPy*assoc.fPy + trigg.fPz*assoc.fPz;
+  double pTrigger2 = trigg.fPx*trigg.fPx + trigg.fPy*trigg.fPy + trigg.fPz*trigg.fPz;
   
-  //phit= ftk1->Phi();                                 //for RP
-  fpttBin       = ftk1->GetTriggBin();
-  fptaBin       = ftk2->GetAssocBin();
-  fPhiTrigger   = ftk1->Phi();
-  fPhiAssoc     = ftk2->Phi();
+  fpttBin       = trigg.fTriggBin;
+  fptaBin       = assoc.fAssocBin;
+  fPhiTrigger   = trigg.fPhi;
+  fPhiAssoc     = assoc.fPhi;
   fDeltaPhi     = DeltaPhi(fPhiTrigger, fPhiAssoc);  //radians
   fDeltaPhiPiPi = atan2(sin(fPhiTrigger-fPhiAssoc), cos(fPhiTrigger-fPhiAssoc));
-  fDeltaEta     = ftk1->Eta() - ftk2->Eta();
-  fEtaTrigger   = ftk1->Eta();
-  fEtaAssoc     = ftk2->Eta();
-  //double dEtaFar   = ftk1->Eta() + ftk2->Eta();
+  fDeltaEta     = trigg.fEta - assoc.fEta;
+  fEtaTrigger   = trigg.fEta;
+  fEtaAssoc     = assoc.fEta;
   
   fNearSide     = cos(fPhiTrigger-fPhiAssoc) > 0 ? true : false;  // Traditional near side definition using deltaPhi
-  fNearSide3D   = vTrigger.Vect().Dot(vAssoc.Vect()) > 0 ? true : false; // Near side definition using half ball around the trigger
+  fNearSide3D   = pDot > 0 ? true : false; // Near side definition using half ball around the trigger
 
   fEtaGapBin = fcard->GetBin( kEtaGapType, fabs(fDeltaEta));
   fPhiGapBinNear = fcard->GetBin( kEtaGapType, fabs(fDeltaPhiPiPi) );
   fPhiGapBinAway = fcard->GetBin( kEtaGapType, fabs(fDeltaPhi-kJPi) ); //here the angle must be 0-2pi and not (-pi,pi)
-  fRGapBinNear   = fcard->GetBin( kRGapType, fabs(ftk1->DeltaR(*ftk2)));
+  fRGapBinNear   = fcard->GetBin( kRGapType, sqrt(fDeltaPhiPiPi*fDeltaPhiPiPi+fDeltaEta*fDeltaEta) ); // same as AliJBaseTrack::DeltaR
   fRGapBinAway   = fcard->GetBin( kRGapType, sqrt(pow(fDeltaPhi-kJPi,2)+fDeltaEta*fDeltaEta) );
   fCentralityBin = CentBin;
   
   
-  fXlong = vTrigger.Vect().Dot(vAssoc.Vect())/pow(vTrigger.P(),2);
+  fXlong = pDot/pTrigger2;
   fXlongBin = fcard->GetBin(kXeType, TMath::Abs(fXlong));
   
-  //if( rGapBin != fRGapBinNear ) cout<<"dR vs fRGapBinNear = "<<rGapBin<<"\t"<<fRGapBinNear<<endl;
-  //if( rGapBin != fRGapBinAway ) cout<<"dR vs fRGapBinAway = "<<rGapBin<<"\t"<<fRGapBinAway<<endl;
   //----------------------------------------------------------------
   
   //acceptance correction  triangle  or mixed fevent
@@ -330,13 +405,15 @@ void AliJCorrelations::FillAzimuthHistos(fillType fTyp, int CentBin, int ZBin, A
   
   if(fpttBin<0 || fptaBin<0 || fEtaGapBin<0 ){
     cout<<"Error in FillAzimuthHistos: some pT or eta out of bin. pttBin="<<fpttBin<<" pTaBin="<<fptaBin <<" etaGapBin="<< fEtaGapBin << endl;
-    ftk1->Print();
-    ftk2->Print();
+    cout<<"trigger pt="<<trigg.fPt<<" eta="<<trigg.fEta<<" phi="<<trigg.fPhi<<" ID="<<trigg.fID<<endl;
+    cout<<"assoc   pt="<<assoc.fPt<<" eta="<<assoc.fEta<<" phi="<<assoc.fPhi<<" ID="<<assoc.fID<<endl;
     exit(-1);
     //return;
   }
   
-  if(fDeltaPhi==0) cout <<" fdphi=0; fptt="<<  fptt<<"   fpta="<<fpta<<"  TID="<<ftk1->GetID()<<"  AID="<<ftk2->GetID() <<" tphi="<< fPhiTrigger <<" aphi="<< fPhiAssoc << endl;
+  if(fDeltaPhi==0) cout <<" fdphi=0; fptt="<<  fptt<<"   fpta="<<fpta<<"  TID="<<trigg.fID<<"  AID="<<assoc.fID <<" tphi="<< fPhiTrigger <<" aphi="<< fPhiAssoc << endl;
+  
+  SetPairBins(fTyp, fCentralityBin, ZBin, fpttBin, fptaBin);
   
   // ===================================================================
   // =====================  Fill Histograms  ===========================
@@ -345,7 +422,7 @@ void AliJCorrelations::FillAzimuthHistos(fillType fTyp, int CentBin, int ZBin, A
   bool fill2DBackgroundQualityControlHistograms = false;  // Choose whether to fill the DeltaPhi DeltaEta histograms for jT background
   
   // If quality control level is high enough, fill 2D quality control histograms
-  if(fcard->Get("QualityControlLevel")>1) fill2DBackgroundQualityControlHistograms = true;
+  if(fQualityControlLevel>1) fill2DBackgroundQualityControlHistograms = true;
   
   //if(fhistos->fhCosThetaStar.Dimension()>0) FillPairPtAndCosThetaStarHistograms(fTyp, ftk1, ftk2);  // Fill the pair pT and cos(theta*) histograms TODO: Does not work! Needs debugging
   if(fhistos->fhxEF.Dimension()>0) FillXeHistograms(fTyp);  // Fill the xE and xLong histograms
@@ -422,37 +499,47 @@ void AliJCorrelations::FillXeHistograms(fillType fTyp)
   // This method fills the xE and xLong histograms
   
   double xe = -fpta*cos(fPhiTrigger-fPhiAssoc)/fptt;
+  PairBinHistos &h = fPairBinHistos;
   
   if( fTyp == kReal ) {
-    fhistos->fhxEPtBin[0][fpttBin][fptaBin]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
-    if( fNearSide ) {
-      fhistos->fhxEPtBin[1][fpttBin][fptaBin]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
-    } else {
-      fhistos->fhxEPtBin[2][fpttBin][fptaBin]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
-    }
+    if(!h.fxEPtBin[0]) h.fxEPtBin[0] = fhistos->fhxEPtBin[0][fpttBin][fptaBin];
+    h.fxEPtBin[0]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+    int iSide = fNearSide ? 1 : 2;
+    if(!h.fxEPtBin[iSide]) h.fxEPtBin[iSide] = fhistos->fhxEPtBin[iSide][fpttBin][fptaBin];
+    h.fxEPtBin[iSide]->Fill(fXlong, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
   }
   
   if(fNearSide) {
-    fhistos->fhxEN [fTyp][fpttBin]->Fill(-xe, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+    if(!h.fxEN) h.fxEN = fhistos->fhxEN [fTyp][fpttBin];
+    h.fxEN->Fill(-xe, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
   } else {
-    fhistos->fhxEF [fTyp][fpttBin]->Fill(xe, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
-    if(fIsIsolatedTrigger) fhistos->fhxEFIsolTrigg[fTyp][fpttBin]->Fill(xe, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+    if(!h.fxEF) h.fxEF = fhistos->fhxEF [fTyp][fpttBin];
+    h.fxEF->Fill(xe, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+    if(fIsIsolatedTrigger){
+      if(!h.fxEFIsolTrigg) h.fxEFIsolTrigg = fhistos->fhxEFIsolTrigg[fTyp][fpttBin];
+      h.fxEFIsolTrigg->Fill(xe, fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+    }
   }
 }
 
 void AliJCorrelations::FillDeltaEtaHistograms(fillType fTyp, int ZBin)
 {
   // This method fills the DeltaEta histograms
+  PairBinHistos &h = fPairBinHistos;
   
   if( fNearSide ){ //one could check the phiGapBin, but in the pi/2 <1.6 and thus phiGap is always>-1
     if( fTyp == 0 ) {
       fhistos->fhDEtaNear[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
     } else {
       fhistos->fhDEtaNearM[fCentralityBin][ZBin][fPhiGapBinNear][fpttBin][fptaBin]->Fill( fDeltaEta , fGeometricAcceptanceCorrection * fTrackPairEfficiency );
-      fhistos->fhDetaNearMixAcceptance[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaEta, fTrackPairEfficiency);
+      if(!h.fDetaNearMixAcceptance) h.fDetaNearMixAcceptance = fhistos->fhDetaNearMixAcceptance[fCentralityBin][fpttBin][fptaBin];
+      h.fDetaNearMixAcceptance->Fill( fDeltaEta, fTrackPairEfficiency);
     }
   } else {
-    if(fPhiGapBinAway<=3) fhistos->fhDEtaFar[fTyp][fCentralityBin][fpttBin]->Fill( fDeltaEta, fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+    if(fPhiGapBinAway<=3){
+      if(!h.fDEtaFar) h.fDEtaFar = fhistos->fhDEtaFar[fTyp][fCentralityBin][fpttBin];
+      h.fDEtaFar->Fill( fDeltaEta, fGeometricAcceptanceCorrection * fTrackPairEfficiency );
+    }
   }
   
   // Different near side definition for xlong bins
@@ -478,7 +565,11 @@ void AliJCorrelations::FillDeltaPhiHistograms(fillType fTyp)
   fhistos->fhDphiAssoc[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
   if(fXlongBin>=0 && fNearSide3D) fhistos->fhDphiAssocXEbin[fTyp][fCentralityBin][fEtaGapBin][fpttBin][fXlongBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection3D * fTrackPairEfficiency);
   
-  if(fIsIsolatedTrigger) fhistos->fhDphiAssocIsolTrigg[fTyp][fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency); //FK//
+  if(fIsIsolatedTrigger){ //FK//
+    PairBinHistos &h = fPairBinHistos;
+    if(!h.fDphiAssocIsolTrigg) h.fDphiAssocIsolTrigg = fhistos->fhDphiAssocIsolTrigg[fTyp][fCentralityBin][fpttBin][fptaBin];
+    h.fDphiAssocIsolTrigg->Fill( fDeltaPhi/kJPi , fGeometricAcceptanceCorrection * fTrackPairEfficiency);
+  }
 }
 
 void AliJCorrelations::FillDeltaEtaDeltaPhiHistograms(fillType fTyp, int zBin)
@@ -488,7 +579,9 @@ void AliJCorrelations::FillDeltaEtaDeltaPhiHistograms(fillType fTyp, int zBin)
   
   // Fill the histogram in pTa bins
   if(fNearSide){
-    fhistos->fhDphiDetaPta[fTyp][fCentralityBin][zBin][fpttBin][fptaBin]->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
+    PairBinHistos &h = fPairBinHistos;
+    if(!h.fDphiDetaPta) h.fDphiDetaPta = fhistos->fhDphiDetaPta[fTyp][fCentralityBin][zBin][fpttBin][fptaBin];
+    h.fDphiDetaPta->Fill(fDeltaEta, fDeltaPhiPiPi, fTrackPairEfficiency);
   }
   
   // Fill the histogram in xlong bins
@@ -502,17 +595,22 @@ void AliJCorrelations::FillPtaHistograms(fillType fTyp)
 {
   // This method fills various pta histograms
   
+  PairBinHistos &h = fPairBinHistos;
+  
   if ( fTyp == kReal ) {
     //must be here, not in main, to avoid counting triggers
-    fhistos->fhAssocPtBin[fCentralityBin][fpttBin][fptaBin]->Fill(fpta ); //I think It should not be weighted by Eff
+    if(!h.fAssocPtBin) h.fAssocPtBin = fhistos->fhAssocPtBin[fCentralityBin][fpttBin][fptaBin];
+    h.fAssocPtBin->Fill(fpta ); //I think It should not be weighted by Eff
     
     //++++++++++++++++++++++++++++++++++++++++++++++++++
     // in order to get mean pTa in the jet peak one has
     // to fill fhMeanPtAssoc in |DeltaEta|<0.4
     // +++++++++++++++++++++++++++++++++++++++++++++++++
     if(fEtaGapBin>=0 && fEtaGapBin<2){
-      fhistos->fhMeanPtAssoc[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fpta );
-      fhistos->fhMeanZtAssoc[fCentralityBin][fpttBin][fptaBin]->Fill( fDeltaPhi/kJPi , fpta/fptt);
+      if(!h.fMeanPtAssoc) h.fMeanPtAssoc = fhistos->fhMeanPtAssoc[fCentralityBin][fpttBin][fptaBin];
+      if(!h.fMeanZtAssoc) h.fMeanZtAssoc = fhistos->fhMeanZtAssoc[fCentralityBin][fpttBin][fptaBin];
+      h.fMeanPtAssoc->Fill( fDeltaPhi/kJPi , fpta );
+      h.fMeanZtAssoc->Fill( fDeltaPhi/kJPi , fpta/fptt);
     }
     
     //UE distribution
@@ -520,11 +618,18 @@ void AliJCorrelations::FillPtaHistograms(fillType fTyp)
       for(int iEtaGap=0; iEtaGap<=fEtaGapBin; iEtaGap++)  //FK// UE Pta spectrum for different eta gaps
         fhistos->fhPtAssocUE[fCentralityBin][iEtaGap][fpttBin]->Fill(fpta, fTrackPairEfficiency);
       if(fIsIsolatedTrigger){ //FK// trigger is isolated hadron
-        fhistos->fhPtAssocUEIsolTrigg[fpttBin]->Fill(fpta, fTrackPairEfficiency); //FK//
+        if(!h.fPtAssocUEIsolTrigg) h.fPtAssocUEIsolTrigg = fhistos->fhPtAssocUEIsolTrigg[fpttBin];
+        h.fPtAssocUEIsolTrigg->Fill(fpta, fTrackPairEfficiency); //FK//
       }
     }
-    if(fabs(fDeltaPhi/kJPi)<0.15) fhistos->fhPtAssocN[fpttBin]->Fill(fpta, fTrackPairEfficiency);
-    if(fabs(fDeltaPhi/kJPi-1)<0.15) fhistos->fhPtAssocF[fpttBin]->Fill(fpta, fTrackPairEfficiency);
+    if(fabs(fDeltaPhi/kJPi)<0.15){
+      if(!h.fPtAssocN) h.fPtAssocN = fhistos->fhPtAssocN[fpttBin];
+      h.fPtAssocN->Fill(fpta, fTrackPairEfficiency);
+    }
+    if(fabs(fDeltaPhi/kJPi-1)<0.15){
+      if(!h.fPtAssocF) h.fPtAssocF = fhistos->fhPtAssocF[fpttBin];
+      h.fPtAssocF->Fill(fpta, fTrackPairEfficiency);
+    }
     
     fnReal++;
   } else { // only mix
@@ -536,7 +641,11 @@ void AliJCorrelations::FillIAAAndMoonHistograms(fillType fTyp, int ZBin)
 {
   // This method fills the I_AA and moon histograms
   
-  if(fhistos->Is2DHistosEnabled()) fhistos->fhDphiAssoc2DIAA[fTyp][fCentralityBin][ZBin][fpttBin][fptaBin]->Fill( fDeltaEta, fDeltaPhi/kJPi, fTrackPairEfficiency);
+  if(fhistos->Is2DHistosEnabled()){
+    PairBinHistos &h = fPairBinHistos;
+    if(!h.fDphiAssoc2DIAA) h.fDphiAssoc2DIAA = fhistos->fhDphiAssoc2DIAA[fTyp][fCentralityBin][ZBin][fpttBin][fptaBin];
+    h.fDphiAssoc2DIAA->Fill( fDeltaEta, fDeltaPhi/kJPi, fTrackPairEfficiency);
+  }
   
   if(fRGapBinNear>=0){
     if(fRGapBinNear <= fRSignalBin) fhistos->fhDRNearPt[fTyp][fCentralityBin][ZBin][fRGapBinNear][fpttBin]->Fill( fpta, fGeometricAcceptanceCorrection * fTrackPairEfficiency );
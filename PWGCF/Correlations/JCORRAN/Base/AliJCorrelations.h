@@ -28,6 +28,11 @@ class AliJCorrelations;
 class AliJHistos;
 class AliJBaseTrack;
 class AliJCard;
+class AliJAssocBuffer;
+struct AliJPackedTrack;
+class TH1D;
+class TH2D;
+class TProfile;
 
 class AliJCorrelations : public AliJCorrelationInterface{
   
@@ -43,7 +48,9 @@ public:
   void PrintOut(){cout<<"Real correl = "<<fnReal<<"  mixed = "<<fnMix<<endl;}
   
   void FillHisto(corrFillType cFTyp, fillType fTyp,    int cBin, int zBin, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2);
+  void FillHisto(corrFillType cFTyp, fillType fTyp,    int cBin, int zBin, AliJBaseTrack *ftk1, const AliJAssocBuffer &assocs, bool leadingParticle = false);
   void FillAzimuthHistos (fillType fTyp,    int cBin, int zBin, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2);
+  void FillAzimuthHistos (fillType fTyp,    int cBin, int zBin, AliJBaseTrack *ftk1, const AliJAssocBuffer &assocs, bool leadingParticle = false);
   
   double GetGeoAccCorrFlat(double deltaEta);
   double GetGeoAccCorrIncl(double deltaEta, int assocBin, int assocType);
@@ -108,8 +115,36 @@ protected:
   double fGeometricAcceptanceCorrection;   // Acceptance correction due to the detector geometry
   double fGeometricAcceptanceCorrection3D; // Acceptance correction due to the detector geometry for 3D near side
   
+  int fQualityControlLevel; // quality control level from the card
+  
 private:
   
+  // Histograms depending only on the (type, centrality, z, pTt, pTa) bins of the pair,
+  // resolved from the histogram manager once for consecutive pairs in the same bins
+  struct PairBinHistos {
+    int fKey[5];                  // type, centrality, z, pTt and pTa bins
+    TH1D *fxEPtBin[3];            // xE in pTt and pTa bins, all, near and far
+    TH1D *fxEN;                   // near side xE
+    TH1D *fxEF;                   // far side xE
+    TH1D *fxEFIsolTrigg;          // far side xE for isolated triggers
+    TH1D *fDetaNearMixAcceptance; // mixed near side deltaEta for acceptance correction
+    TH1D *fDEtaFar;               // far side deltaEta
+    TH1D *fDphiAssocIsolTrigg;    // deltaPhi for isolated triggers
+    TH2D *fDphiDetaPta;           // deltaEta-deltaPhi in pta bins
+    TH1D *fAssocPtBin;            // associated pT
+    TProfile *fMeanPtAssoc;       // mean associated pT
+    TProfile *fMeanZtAssoc;       // mean associated zT
+    TH1D *fPtAssocUEIsolTrigg;    // underlying event associated pT for isolated triggers
+    TH1D *fPtAssocN;              // near side associated pT
+    TH1D *fPtAssocF;              // far side associated pT
+    TH2D *fDphiAssoc2DIAA;        // 2D IAA histogram
+  };
+  
+  void SetPairBins(fillType fTyp, int cBin, int zBin, int pttBin, int ptaBin);
+  void FillAzimuthPair(fillType fTyp, int cBin, int zBin, const AliJPackedTrack &trigg, const AliJPackedTrack &assoc);
+  
+  PairBinHistos fPairBinHistos; // histograms of the current pair bins
+  
   void FillPairPtAndCosThetaStarHistograms(fillType fTyp, AliJBaseTrack *ftk1, AliJBaseTrack *ftk2);
   void FillXeHistograms(fillType fTyp);
   void FillDeltaEtaHistograms(fillType fTyp, int zBin);
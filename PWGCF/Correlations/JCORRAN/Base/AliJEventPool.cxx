@@ -5,10 +5,7 @@
 #include  "AliJEventPool.h"
 
 #include  "AliJBaseTrack.h"
-#include  "AliJTrack.h"
-#include  "AliJMCTrack.h"
-#include  "AliJPhoton.h"
-#include  "AliJPiZero.h"
+#include  "AliJAssocBuffer.h"
 
 #include  "AliJCard.h"
 #include  "AliJCorrelationInterface.h"
@@ -28,8 +25,7 @@ AliJEventPool::AliJEventPool(AliJCard *cardin, AliJHistogramInterface *histosin,
   //ftk(NULL),
   //ftk1(NULL),
   //ftk2(NULL),
-  fthisPoolType(particle),
-  fpoolList(NULL)
+  fthisPoolType(particle)
 {       
   // constructor
   
@@ -45,9 +41,13 @@ AliJEventPool::AliJEventPool(AliJCard *cardin, AliJHistogramInterface *histosin,
     }
   } cout <<endl; 
 
+  for(int ic=0;ic<kMaxNoCentrBin;ic++){
+    for(int ie=0;ie<MAXNOEVENT;ie++) fBuffers[ic][ie] = NULL;
+  }
+
   for(int ic=0;ic<fcard->GetNoOfBins(kCentrType);ic++){
     for(int ie=0;ie<fcard->GetEventPoolDepth(ic); ie++){ 
-      fLists[ic][ie]  = new TClonesArray(kParticleProtoType[particle],1500);
+      fBuffers[ic][ie]  = new AliJAssocBuffer();
     }
     flastAccepted[ic] = -1; //to start from 0
     fwhereToStore[ic] = -1; //to start from 0
@@ -63,6 +63,9 @@ AliJEventPool::AliJEventPool(AliJCard *cardin, AliJHistogramInterface *histosin,
 
 AliJEventPool::~AliJEventPool( ){
   // destructor
+  for(int ic=0;ic<kMaxNoCentrBin;ic++){
+    for(int ie=0;ie<MAXNOEVENT;ie++) delete fBuffers[ic][ie];
+  }
   //delete ftk;
   //delete ftk1;
   //delete ftk2;
@@ -75,11 +78,13 @@ AliJEventPool::AliJEventPool(const AliJEventPool& obj) :
   //ftk(obj.ftk),
   //ftk1(obj.ftk1),
   //ftk2(obj.ftk2),
-  fthisPoolType(obj.fthisPoolType),
-  fpoolList(obj.fpoolList)
+  fthisPoolType(obj.fthisPoolType)
 {
-  // copy constructor
+  // copy constructor, the pool content is not copied
   JUNUSED(obj);
+  for(int ic=0;ic<kMaxNoCentrBin;ic++){
+    for(int ie=0;ie<MAXNOEVENT;ie++) fBuffers[ic][ie] = NULL;
+  }
 }
 
 AliJEventPool& AliJEventPool::operator=(const AliJEventPool& obj){
@@ -97,7 +102,6 @@ void AliJEventPool::Mix( TClonesArray *triggList,
     int cBin = fcard->GetBin(kCentrType, cent);
     int zBin = fcard->GetBin(kZVertType, Z);
     int noTrigg=triggList->GetEntriesFast();
-    int noAssoc=0;
 
     if ( cBin< 0 ) return;
    
@@ -105,10 +109,9 @@ void AliJEventPool::Mix( TClonesArray *triggList,
 
 
     for(int backCounter=0; backCounter <= flastAccepted[cBin]; backCounter++){
-        fpoolList = fLists [cBin] [backCounter];
-        noAssoc = fpoolList->GetEntries();
+        const AliJAssocBuffer &poolBuffer = *fBuffers [cBin] [backCounter];
 
-        if(noAssoc<=0) continue;
+        if(poolBuffer.GetEntries()<=0) continue;
 
         //mixit=======
         fnoMix[cBin]++;
@@ -126,24 +129,22 @@ void AliJEventPool::Mix( TClonesArray *triggList,
             for(int ii=0;ii<noTrigg;ii++){
                 AliJBaseTrack *ftk1 = (AliJBaseTrack*)triggList->At(ii);        
                 //fhistos->fhTriggPtBin[kMixed][cBin][iptt]->Fill(ptt); //who needs that?
-                for(int jj=0;jj<noAssoc ;jj++){
-                    AliJBaseTrack *ftk2 = (AliJBaseTrack*)fpoolList->At(jj);
-                    if(leadingParticle && ftk1->Pt() < ftk2->Pt()) continue; // In leading particle correlations, accept only those associated particles whose pT is lower than that of the trigger
-                    fcorrelations->FillHisto(cFTyp,kMixed, cBin, zBin, ftk1, ftk2);
-                } //inner loop mixing
+                // inner loop mixing, over the pT bins of the packed pool event
+                fcorrelations->FillHisto(cFTyp,kMixed, cBin, zBin, ftk1, poolBuffer, leadingParticle);
             }//outer loop mixing
         }//if good for mix
     }//mixed fevent loop
 }
 
 //______________________________________________________________________________
-void AliJEventPool::AcceptList(TClonesArray *inList, float cent, float Z, float inMult, int iev){
+int AliJEventPool::StoreSlot(float cent, float Z, float inMult, int iev){
     //////////////////////////////////////////////////////////////
     // circular buffer. New fevent added after the previous one, 
-    // mixing goes backwards 
+    // mixing goes backwards. Returns the slot to fill, -1 if the
+    // centrality is out of the bins
     //////////////////////////////////////////////////////////////
     int cBin = fcard->GetBin(kCentrType, cent);
-    if (cBin <0 ) return;
+    if (cBin <0 ) return -1;
     flastAccepted[cBin]++;
     fwhereToStore[cBin]++;
     if( flastAccepted[cBin] >= fcard->GetEventPoolDepth(cBin) ) flastAccepted[cBin] = fcard->GetEventPoolDepth(cBin)-1;
@@ -152,27 +153,23 @@ void AliJEventPool::AcceptList(TClonesArray *inList, float cent, float Z, float
     fZVertex   [cBin][fwhereToStore[cBin]] = Z;
     fcentrality[cBin][fwhereToStore[cBin]] = cent;
     fmult      [cBin][fwhereToStore[cBin]] = inMult;
+    return cBin;
+}
 
-    fLists[cBin][fwhereToStore[cBin]]->Clear();
-    for(int i=0;i<inList->GetEntriesFast();i++){
-				if( fthisPoolType == kJPhoton || fthisPoolType == kJDecayphoton ){
-					AliJPhoton *tkp = (AliJPhoton*)inList->At(i);
-					new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJPhoton(*tkp);
-				}
-				else if( fthisPoolType == kJPizero || fthisPoolType == kJEta ){
-					AliJPiZero *tkpz = (AliJPiZero*)inList->At(i);
-					new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJPiZero(*tkpz);
-				}
-        else if ( fthisPoolType == kJHadronMC ){
-          AliJMCTrack *mcTrack = (AliJMCTrack*)inList->At(i);
-          new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJMCTrack(*mcTrack);
-        }
-				else{
-					AliJTrack *tk3 = (AliJTrack*)inList->At(i);
-					new ((*fLists[cBin][fwhereToStore[cBin]])[i]) AliJTrack(*tk3);
-				}
-    }
+//______________________________________________________________________________
+void AliJEventPool::AcceptList(TClonesArray *inList, float cent, float Z, float inMult, int iev){
+    // store the particles of the event, packed by assoc pT bin
+    int cBin = StoreSlot(cent, Z, inMult, iev);
+    if (cBin <0 ) return;
+    fBuffers[cBin][fwhereToStore[cBin]]->Fill(inList);
+}
 
+//______________________________________________________________________________
+void AliJEventPool::AcceptList(const AliJAssocBuffer &inBuffer, float cent, float Z, float inMult, int iev){
+    // store an already packed event, as used for the real correlations
+    int cBin = StoreSlot(cent, Z, inMult, iev);
+    if (cBin <0 ) return;
+    *fBuffers[cBin][fwhereToStore[cBin]] = inBuffer;
 }
 
 
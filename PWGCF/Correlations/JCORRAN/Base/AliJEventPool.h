@@ -23,6 +23,7 @@ class AliJMCTrack;
 class AliJCard;
 class AliJCorrelationInterface;
 class AliJHistogramInterface;
+class AliJAssocBuffer;
 class TH1D;
 
 #define   MAXNOEVENT 2000    // Maximum no of events in pools (400 used for QM anal.) 
@@ -44,6 +45,7 @@ class AliJEventPool {
        //void MixRNDM( AliJEventPool *cross, void (AliJCorrelationInterface::*fillHisto)(fillType, int, AliJBaseTrack*, AliJBaseTrack*) );
 
         void AcceptList(TClonesArray *inList, float cent, float Z, float inMult, int iev);
+        void AcceptList(const AliJAssocBuffer &inBuffer, float cent, float Z, float inMult, int iev);
 
         void Mysample(TH1D *fromh, TH1D *toh );
         void PrintOut(){for(int i=0;i<kMaxNoCentrBin;i++)
@@ -60,7 +62,9 @@ class AliJEventPool {
         long fnoMix[kMaxNoCentrBin];  // comment me
         long fnoMixCut[kMaxNoCentrBin];   // comment me
 
-        TClonesArray   *fLists[kMaxNoCentrBin][MAXNOEVENT]; // mix lists
+        int  StoreSlot(float cent, float Z, float inMult, int iev);
+
+        AliJAssocBuffer *fBuffers[kMaxNoCentrBin][MAXNOEVENT]; // mix lists, packed and sorted by assoc pT bin
         AliJCard  *fcard;  // card
         AliJCorrelationInterface *fcorrelations; // correlation object
         AliJHistogramInterface *fhistos;  // histos
@@ -69,8 +73,6 @@ class AliJEventPool {
         //AliJBaseTrack *ftk2; // track
         particleType fthisPoolType; // pool type
 
-        TClonesArray  *fpoolList;  // pool list
-
         //int   trials[MAXNOEVENT];
 
 };
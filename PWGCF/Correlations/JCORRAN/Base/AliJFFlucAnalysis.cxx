@@ -424,9 +424,11 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	TComplex QnB_star[kNH];
 
 	//--------------- Calculate Qn--------------------
+	// SP and QC Q-vectors for all the harmonics in one track loop
+	CalculateQvectors();
 	for(int ih=0; ih<kNH; ih++){
-		QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-		QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
+		QnA[ih] = QnSP[kSubA][ih];
+		QnB[ih] = QnSP[kSubB][ih];
 		QnA_star[ih] = TComplex::Conjugate ( QnA[ih] ) ;
 		QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
 	}
@@ -575,8 +577,6 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		fh_correlator[27][fCBin]->Fill( nV7V3starV4star.Re(),ebe_3p_weight );
 	}
 
-	CalculateQvectorsQC();
-
 	//cumulants (no mixed harmonics)
 	TComplex four[kNH];
 	TComplex two[kNH];
@@ -633,18 +633,22 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 	//Double_t QC_4p_value[kNH][kNH];
 	//Double_t QC_2p_value[kNH];
 
+	// denominators, same for all the harmonics
+	Double_t four_0000 = Four(0,0,0,0).Re();
+	Double_t two_00 = Two(0,0).Re();
+
 	Double_t event_weight_four = 1.0;
 	Double_t event_weight_two = 1.0;
 	Double_t event_weight_two_eta10 = 1.0;
 	if(flags & FLUC_EBE_WEIGHTING){
-		event_weight_four = Four(0,0,0,0).Re();
-		event_weight_two = Two(0,0).Re();
+		event_weight_four = four_0000;
+		event_weight_two = two_00;
 		event_weight_two_eta10 = (QvectorQCeta10[0][kSubA]*QvectorQCeta10[0][kSubB]).Re();
 	}
 
 	for(int ih=2; ih < kNH; ih++){
 		for(int ihh=2; ihh<ih; ihh++){
-			TComplex scfour = Four( ih, ihh, -ih, -ihh ) / Four(0,0,0,0).Re();
+			TComplex scfour = Four( ih, ihh, -ih, -ihh ) / four_0000;
 			
 			fh_SC_with_QC_4corr[ih][ihh][fCBin]->Fill( scfour.Re(), event_weight_four );
 			//QC_4p_value[ih][ihh] = scfour.Re();
@@ -655,7 +659,7 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		// two(2,2) = Q2 Q2* - Q0 = Q2Q2* - M
 		// two(0,0) = Q0 Q0* - Q0 = M^2 - M
 		//two[ih] = Two(ih, -ih) / Two(0,0).Re();
-		TComplex sctwo = Two(ih, -ih) / Two(0,0).Re();
+		TComplex sctwo = Two(ih, -ih) / two_00;
 		fh_SC_with_QC_2corr[ih][fCBin]->Fill( sctwo.Re(), event_weight_two );
 		//QC_2p_value[ih] = sctwo.Re();
 		// fill single vn  with QC without EtaGap as method 2
@@ -878,29 +882,40 @@ TComplex AliJFFlucAnalysis::Get_Qn_pt(Double_t eta1, Double_t eta2, int harmonic
    Please see Generic Framwork from Ante
    use Standalone method  */
 //________________________________________________________________________
-void AliJFFlucAnalysis::CalculateQvectorsQC(){
-	// calcualte Q-vector for QC method ( no subgroup )
+void AliJFFlucAnalysis::CalculateQvectors(){
+	// calculate in one track loop the Q-vectors for all the harmonics:
+	// SP Q-vectors of SubA and SubB (same as CalculateQnSP),
+	// QC Q-vectors Q(n,p) (no subgroup) and the QC Q-vectors with eta gap.
+	// cos(n*phi) and sin(n*phi) are obtained by recurrence from cos(phi), sin(phi)
+	// and the real and imaginary parts are summed in separate arrays.
+	Double_t spRe[2][kNH], spIm[2][kNH], spW[2];
+	Double_t eta10Re[2][kNH], eta10Im[2][kNH];
 	//init
-	for(int ih=0; ih<kNH; ih++){
-		for(int ik=0; ik<nKL; ++ik)
-			QvectorQC[ih][ik] = TComplex(0, 0);
-		for(int isub=0; isub<2; isub++){
-			QvectorQCeta10[ih][isub] = TComplex(0, 0);
+	for(int isub=0; isub<2; isub++){
+		spW[isub] = 0;
+		for(int ih=0; ih<kNH; ih++){
+			spRe[isub][ih] = 0; spIm[isub][ih] = 0;
+			eta10Re[isub][ih] = 0; eta10Im[isub][ih] = 0;
+		}
+	}
+	for(int ik=0; ik<nKL; ik++){
+		for(int ih=0; ih<kNQH; ih++){
+			fQvectorRe[ik][ih] = 0;
+			fQvectorIm[ik][ih] = 0;
 		}
-	} // for max harmonics
+	}
+	Double_t cosn[kNQH], sinn[kNQH], wp[nKL];
 	//Calculate Q-vector with particle loop
 	Long64_t ntracks = fInputList->GetEntriesFast(); // all tracks from Task input
 	for( Long64_t it=0; it<ntracks; it++){
 		AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
 		Double_t eta = itrack->Eta();
 		// track Eta cut Note! pt cuts already applied in AliJFFlucTask.cxx
-		// Do we need arbitary Eta cut for QC method?
-		// fixed eta ranged -0.8 < eta < 0.8 for QC
-//				if( TMath::Abs(eta) > fEta_max || TMath::Abs(eta) < fEta_min ) continue; << this is SP cut
-//				if( TMath::Abs(eta) > 0.8 ) continue;  //   << this is old QC cut
-		// we need more configuration for to study eta dep of SC(m,n) with QC method.
 		// eta cut among all tracks (this is not same with SC(m,n) SP method (SP method needs symmetric eta range)//
-		if( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max)
+		bool isQC = !( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max );
+		// SubA: fEta_min < eta < fEta_max, SubB: -fEta_max < eta < -fEta_min
+		bool isSP[2] = { !(eta < fEta_min || eta > fEta_max), !(eta < -fEta_max || eta > -fEta_min) };
+		if( !isQC && !isSP[0] && !isSP[1] )
 			continue;
 		/////////////////////////////////////////////////
 
@@ -915,46 +930,114 @@ void AliJFFlucAnalysis::CalculateQvectorsQC(){
 				phi_module_corr = 1.0/phi_module_corr;
 		}
 		Double_t effCorr = fEfficiency->GetCorrection( pt, fEffFilterBit, fCent);
+		Double_t w = 1.0/effCorr*phi_module_corr;
+
+		// cos(n*phi), sin(n*phi)
+		Double_t c1 = TMath::Cos(phi), s1 = TMath::Sin(phi);
+		cosn[0] = 1.0; sinn[0] = 0.0;
+		for(int ih=1; ih<kNQH; ih++){
+			cosn[ih] = cosn[ih-1]*c1 - sinn[ih-1]*s1;
+			sinn[ih] = sinn[ih-1]*c1 + cosn[ih-1]*s1;
+		}
 
-		for(int ih=0; ih<kNH; ih++){
-			Double_t tf = 1.0;
-			TComplex q[nKL];
-			for(int ik=0; ik<nKL; ik++){
-				q[ik] = TComplex(tf*TMath::Cos(ih*phi),tf*TMath::Sin(ih*phi));
-				QvectorQC[ih][ik] += q[ik];
-				tf *= 1.0/effCorr*phi_module_corr;
+		for(int iSP=0; iSP<2; iSP++){
+			if( !isSP[iSP] )
+				continue;
+			for(int ih=0; ih<kNH; ih++){
+				spRe[iSP][ih] += w*cosn[ih];
+				spIm[iSP][ih] += w*sinn[ih];
 			}
-			//this is for normalized SC ( denominator needs an eta gap )
-			if(TMath::Abs(eta) > fQC_eta_gap_half){
-				QvectorQCeta10[ih][isub] += q[1];
+			spW[iSP] += w;
+		}
+
+		if( !isQC )
+			continue;
+		wp[0] = 1.0;
+		for(int ik=1; ik<nKL; ik++)
+			wp[ik] = wp[ik-1]*w;
+		for(int ik=0; ik<nKL; ik++){
+			Double_t *qre = fQvectorRe[ik], *qim = fQvectorIm[ik];
+			for(int ih=0; ih<kNQH; ih++){
+				qre[ih] += wp[ik]*cosn[ih];
+				qim[ih] += wp[ik]*sinn[ih];
+			}
+		}
+		//this is for normalized SC ( denominator needs an eta gap )
+		if(TMath::Abs(eta) > fQC_eta_gap_half){
+			for(int ih=0; ih<kNH; ih++){
+				eta10Re[isub][ih] += w*cosn[ih];
+				eta10Im[isub][ih] += w*sinn[ih];
 			}
 		}
 	} // track loop done.
+
+	for(int isub=0; isub<2; isub++){
+		for(int ih=0; ih<kNH; ih++){
+			QnSP[isub][ih] = TComplex(spRe[isub][ih], spIm[isub][ih]);
+			if( ih != 0 )
+				QnSP[isub][ih] /= spW[isub]; // Use Qn[0] as total number of tracks(*eff)
+			QvectorQCeta10[ih][isub] = TComplex(eta10Re[isub][ih], eta10Im[isub][ih]);
+		}
+	}
 }
 //________________________________________________________________________
 TComplex AliJFFlucAnalysis::Q(int n, int p){
-	// Return QvectorQC
+	// Return QC Q-vector
 	// Q{-n, p} = Q{n, p}*
 	if(n >= 0)
-		return QvectorQC[n][p];
-	return TComplex::Conjugate(QvectorQC[-n][p]);
+		return TComplex(fQvectorRe[p][n], fQvectorIm[p][n]);
+	return TComplex(fQvectorRe[p][-n], -fQvectorIm[p][-n]);
+}
+//________________________________________________________________________
+TComplex AliJFFlucAnalysis::Recursion(int n, int *harmonic, int mult, int skip){
+	// Generic recursive formula of the n-particle correlation
+	// of the harmonics harmonic[0..n-1] in terms of Q(n,p),
+	// see the Generic Framework (Bilandzic et al., Phys. Rev. C 89, 064904).
+	// The harmonic array is permuted during the recursion and restored at the end.
+	int nm1 = n-1;
+	TComplex c(Q(harmonic[nm1], mult));
+	if(nm1 == 0)
+		return c;
+	c *= Recursion(nm1, harmonic);
+	if(nm1 == skip)
+		return c;
+
+	int multp1 = mult+1;
+	int nm2 = n-2;
+	int counter1 = 0;
+	int hhold = harmonic[counter1];
+	harmonic[counter1] = harmonic[nm2];
+	harmonic[nm2] = hhold + harmonic[nm1];
+	TComplex c2(Recursion(nm1, harmonic, multp1, nm2));
+	int counter2 = n-3;
+	while(counter2 >= skip){
+		harmonic[nm2] = harmonic[counter1];
+		harmonic[counter1] = hhold;
+		++counter1;
+		hhold = harmonic[counter1];
+		harmonic[counter1] = harmonic[nm2];
+		harmonic[nm2] = hhold + harmonic[nm1];
+		c2 += Recursion(nm1, harmonic, multp1, counter2);
+		--counter2;
+	}
+	harmonic[nm2] = harmonic[counter1];
+	harmonic[counter1] = hhold;
+
+	if(mult == 1)
+		return c-c2;
+	return c-Double_t(mult)*c2;
 }
 //________________________________________________________________________
 TComplex AliJFFlucAnalysis::Two(int n1, int n2 ){
 	// two-particle correlation <exp[i(n1*phi1 + n2*phi2)]>
-	//	cout << "TWO FUNCTION " << Q(n1,1) << "*" << Q(n2,1) << " - " << Q(n1+n2 , 2) << endl;
-	TComplex two = Q(n1, 1) * Q(n2, 1) - Q( n1+n2, 2);
-	return two;
+	int harmonic[2] = {n1, n2};
+	return Recursion(2, harmonic);
 }
 //________________________________________________________________________
 TComplex AliJFFlucAnalysis::Four( int n1, int n2, int n3, int n4){
-	TComplex four =
-		Q(n1,1)*Q(n2,1)*Q(n3,1)*Q(n4,1)-Q(n1+n2,2)*Q(n3,1)*Q(n4,1)-Q(n2,1)*Q(n1+n3,2)*Q(n4,1)
-		- Q(n1,1)*Q(n2+n3,2)*Q(n4,1)+2.*Q(n1+n2+n3,3)*Q(n4,1)-Q(n2,1)*Q(n3,1)*Q(n1+n4,2)
-		+ Q(n2+n3,2)*Q(n1+n4,2)-Q(n1,1)*Q(n3,1)*Q(n2+n4,2)+Q(n1+n3,2)*Q(n2+n4,2)
-		+ 2.*Q(n3,1)*Q(n1+n2+n4,3)-Q(n1,1)*Q(n2,1)*Q(n3+n4,2)+Q(n1+n2,2)*Q(n3+n4,2)
-		+ 2.*Q(n2,1)*Q(n1+n3+n4,3)+2.*Q(n1,1)*Q(n2+n3+n4,3)-6.*Q(n1+n2+n3+n4,4);
-	return four;
+	// four-particle correlation <exp[i(n1*phi1 + n2*phi2 + n3*phi3 + n4*phi4)]>
+	int harmonic[4] = {n1, n2, n3, n4};
+	return Recursion(4, harmonic);
 }
 //__________________________________________________________________________
 void AliJFFlucAnalysis::SetPhiModuleHistos( int cent, int sub, TH1D *hModuledPhi){
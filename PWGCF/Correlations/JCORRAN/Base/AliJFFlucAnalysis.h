@@ -68,8 +68,9 @@ public:
 	AliJEfficiency* GetAliJEfficiency() { return fEfficiency; }
 
 	// new function for QC method //
-	void CalculateQvectorsQC();
+	void CalculateQvectors();
 	TComplex Q(int n, int p);
+	TComplex Recursion( int n, int *harmonic, int mult = 1, int skip = 0);
 	TComplex Two( int n1, int n2);
 	TComplex Four( int n1, int n2, int n3, int n4);
 
@@ -94,6 +95,7 @@ public:
 private:
 	enum{kH0, kH1, kH2, kH3, kH4, kH5, kH6, kH7, kH8, kNH}; //harmonics
 	enum{kK0, kK1, kK2, kK3, kK4, nKL}; // order
+	enum{kNQH = 2*kNH-1}; // harmonics of the QC Q-vectors, up to the sums of two harmonics in Four()
 
 	Long64_t AnaEntry;
 	TClonesArray * fInputList;
@@ -124,8 +126,10 @@ private:
 	Double_t fQC_eta_cut_max;
 	Double_t fQC_eta_gap_half;
 
-	TComplex QvectorQC[kNH][nKL];
+	Double_t fQvectorRe[nKL][kNQH];//! // QC Q-vectors Q(n,p) [p][n], real part
+	Double_t fQvectorIm[nKL][kNQH];//! // QC Q-vectors Q(n,p) [p][n], imaginary part
 	TComplex QvectorQCeta10[kNH][2]; // ksub
+	TComplex QnSP[2][kNH]; // SP Q-vectors for SubA and SubB, normalized for ih>0
 
 	TH1D *h_phi_module[7][2]; // cent, isub
 	TFile *inclusFile; // pointer for root file
@@ -178,7 +182,7 @@ private:
 	//AliJTH1D fh_QvectorQCphi;//!
 	AliJTH1D fh_evt_SP_QC_ratio_2p;//! // check SP QC evt by evt ratio
 	AliJTH1D fh_evt_SP_QC_ratio_4p;//! // check SP QC evt by evt ratio
-	ClassDef(AliJFFlucAnalysis, 1); // example of analysis
+	ClassDef(AliJFFlucAnalysis, 2); // example of analysis
 };
 
 #endif
@@ -62,6 +62,9 @@ AliCorrelation3p::AliCorrelation3p(const char* name,TArrayD MBinEdges, TArrayD Z
   , fbinver(0)
   , fCollisionType(PbPb)
   , fTriggerType(tracks)
+  , fCurrentPhiPhiDEta(NULL)
+  , fCurrentPhiEta(NULL)
+  , fCurrentPhiEtaa(NULL)
 {
   // default constructor
 }
@@ -85,6 +88,9 @@ AliCorrelation3p::AliCorrelation3p(const AliCorrelation3p& other)
   , fbinver(other.fbinver)
   , fCollisionType(other.fCollisionType)
   , fTriggerType(other.fTriggerType)
+  , fCurrentPhiPhiDEta(NULL)
+  , fCurrentPhiEta(NULL)
+  , fCurrentPhiEtaa(NULL)
 {
   // copy constructor
 }
@@ -239,7 +245,16 @@ int AliCorrelation3p::SetMultVZ(Double_t Mult, Double_t Vz)
   fVzBin = GetZBin(fVZ);
   HistFill(kcentrvsvz,fMultiplicity,fVZ);
   HistFill(kcentrvsvzbin,fMBin,fVzBin);
+  fCurrentPhiPhiDEta=NULL;
+  fCurrentPhiEta=NULL;
+  fCurrentPhiEtaa=NULL;
   if (fMBin<0||fVzBin<0) return -1;
+  if (fHistograms) {
+    //histograms of this M,Z bin, filled for each triplet and pair
+    fCurrentPhiPhiDEta=dynamic_cast<TH3F*>(fHistograms->At(GetNumberHist(khPhiPhiDEta,fMBin,fVzBin)));
+    fCurrentPhiEta=dynamic_cast<TH2D*>(fHistograms->At(GetNumberHist(khPhiEta,fMBin,fVzBin)));
+    fCurrentPhiEtaa=dynamic_cast<TH2D*>(fHistograms->At(GetNumberHist(khPhiEtaa,fMBin,fVzBin)));
+  }
   HistFill(GetNumberHist(khQAtocheckadressing,fMBin,fVzBin),1.0);
   return 1;
 }
@@ -343,6 +358,40 @@ int AliCorrelation3p::FillTrigger(AliVParticle* ptrigger)
   HistFill(GetNumberHist(kHistNTriggers,fMBin,fVzBin),0.5,fillweight);//Increments number of triggers by weight. Call before filling with any associated.
   return 1;
 }
+int AliCorrelation3p::FillDeltas(Double_t ptTrigger, Double_t pt1, Double_t pt2, Double_t DeltaPhi1, Double_t DeltaPhi2, Double_t DeltaEta1, Double_t DeltaEta2, Double_t DeltaEta12, const double weight)
+{
+  /// fill the 3p histogram from the trigger-associated differences computed
+  /// once per event by the correlator, same selection as Fill(trigger,p1,p2).
+  if ((ptTrigger<pt1)||(ptTrigger<pt2)) {return 0;}
+  if(TMath::Abs(DeltaPhi1-DeltaPhi2)<1.0E-10&&TMath::Abs(DeltaEta12)<1.0E-10)	return 0;//Track duplicate, reject.
+  if(TMath::Abs(DeltaEta1)<1.0E-10)						return 0;//Track duplicate, reject.
+  if(TMath::Abs(DeltaEta2)<1.0E-10)						return 0;//Track duplicate, reject.
+  if(fCurrentPhiPhiDEta) fCurrentPhiPhiDEta->Fill(DeltaEta12,DeltaPhi1,DeltaPhi2, weight);
+  else HistFill(GetNumberHist(khPhiPhiDEta,fMBin,fVzBin),DeltaEta12,DeltaPhi1,DeltaPhi2, weight);
+  return 0;
+}
+int AliCorrelation3p::FillDeltas(Double_t ptTrigger, Double_t pt1, Double_t DeltaPhi, Double_t DeltaEta, const double weight)
+{
+  /// fill the 2p histogram from the trigger-associated differences, same selection as Fill(trigger,p1).
+  if (ptTrigger<=pt1) return 0;
+  if(fCurrentPhiEta) fCurrentPhiEta->Fill(DeltaEta,DeltaPhi, weight);
+  else HistFill(GetNumberHist(khPhiEta,fMBin,fVzBin),DeltaEta,DeltaPhi, weight);//2p correlation
+  return 0;
+}
+int AliCorrelation3p::FillaDeltas(Double_t DeltaPhi, Double_t DeltaEta, const double weight)
+{
+  /// fill the associated-associated histogram from precomputed differences.
+  if(fCurrentPhiEtaa) fCurrentPhiEtaa->Fill(DeltaEta,DeltaPhi, weight);
+  else HistFill(GetNumberHist(khPhiEtaa,fMBin,fVzBin),DeltaEta,DeltaPhi, weight);//2p correlation
+  return 0;
+}
+Double_t AliCorrelation3p::DeltaPhi(Double_t phi1, Double_t phi2)
+{
+  Double_t DeltaPhi = phi1 - phi2;
+  if (DeltaPhi<-0.5*gkPii) DeltaPhi += 2*gkPii;
+  if (DeltaPhi>1.5*gkPii)  DeltaPhi -= 2*gkPii;
+  return DeltaPhi;
+}
 void AliCorrelation3p::Clear(Option_t * /*option*/)
 {
   /// overloaded from TObject: cleanup
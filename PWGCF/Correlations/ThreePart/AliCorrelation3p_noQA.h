@@ -54,6 +54,12 @@ class AliCorrelation3p_noQA : public TNamed {
   int Fill( AliVParticle* trigger		, AliVParticle* p1				, const double weight=1.0);
   int Filla( AliVParticle* p1			, AliVParticle* p2				, const double weight=1.0);
   int FillTrigger( AliVParticle*ptrigger);
+  /// fill histograms from precomputed trigger-associated differences (DeltaEta=eta_trigger-eta_assoc)
+  int FillDeltas(Double_t ptTrigger, Double_t pt1, Double_t pt2, Double_t DeltaPhi1, Double_t DeltaPhi2, Double_t DeltaEta1, Double_t DeltaEta2, Double_t DeltaEta12, const double weight=1.0);
+  int FillDeltas(Double_t ptTrigger, Double_t pt1, Double_t DeltaPhi, Double_t DeltaEta, const double weight=1.0);
+  int FillaDeltas(Double_t DeltaPhi, Double_t DeltaEta, const double weight=1.0);
+  /// phi difference in the range [-pi/2,3pi/2]
+  static Double_t DeltaPhi(Double_t phi1, Double_t phi2);
   int MakeResultsFile(const char* scalingmethod, bool recreate=false, bool all=false);
   /// overloaded from TObject: cleanup
   virtual void Clear(Option_t * option ="");
@@ -152,6 +158,9 @@ class AliCorrelation3p_noQA : public TNamed {
   int fbinver;
   CollisionType fCollisionType;
   TriggerType fTriggerType;
+  TH3F* fCurrentPhiPhiDEta; //! 3p histogram of the current M,Z bin
+  TH2D* fCurrentPhiEta;     //! 2p histogram of the current M,Z bin
+  TH2D* fCurrentPhiEtaa;    //! associated-associated histogram of the current M,Z bin
 
   //Class definition.
   ClassDef(AliCorrelation3p_noQA, 1)
@@ -23,7 +23,8 @@ class TMCParticle;
 /**
  * @class AliFilteredTrack
  * An AliVTrack/AliVParticle implementation with minimal persistent members.
- * - pt, phi, theta
+ * - pt, phi, theta, stored as Float16_t with a 12 bit mantissa
+ * - charge and track selection flags, stored as bits of TObject
  * - (x,y,z of initial point) to be implemented
  *
  * Other properties are derived from minimal parameter set.
@@ -150,10 +151,10 @@ class AliFilteredTrack : public AliVTrack {
  protected:
  private:
    
-  // persistent members stored for the class
-  float fPt;        // transverse momentum
-  float fPhi;       // phi
-  float fTheta;     // theta
+  // persistent members stored for the class, packed on file
+  Float16_t fPt;    //[0,0,12] transverse momentum
+  Float16_t fPhi;   //[0,0,12] phi
+  Float16_t fTheta; //[0,0,12] theta
   // all other members are transient and calculated from the
   // momentum vector
   float feff;	    //! efficiency
@@ -162,7 +163,7 @@ class AliFilteredTrack : public AliVTrack {
   float fPtot;      //! momentum
   float fEta;       //! eta
 
-  ClassDef(AliFilteredTrack, 1)
+  ClassDef(AliFilteredTrack, 2)
 };
 
 template<typename T>
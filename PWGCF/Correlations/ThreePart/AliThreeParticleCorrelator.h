@@ -50,8 +50,12 @@ class AliThreeParticleCorrelator : public TNamed {
     , fMETA2Correlations()
     , factiveTriggers()
     , fAssociated()
-    , fAssociatedmixed1()
-    , fAssociatedmixed2()
+    , fAssociatedPool()
+    , fKinTriggers()
+    , fKinAssociated1()
+    , fKinAssociated2()
+    , fDeltas1()
+    , fDeltas2()
     , fEventPoolMgr(NULL)
     , fVz(0)
     , fMultiplicity(0)
@@ -74,8 +78,12 @@ class AliThreeParticleCorrelator : public TNamed {
     , fMETA2Correlations(other.fMETA2Correlations)
     , factiveTriggers(other.factiveTriggers)
     , fAssociated(other.fAssociated)
-    , fAssociatedmixed1(other.fAssociatedmixed1)
-    , fAssociatedmixed2(other.fAssociatedmixed2)
+    , fAssociatedPool()
+    , fKinTriggers()
+    , fKinAssociated1()
+    , fKinAssociated2()
+    , fDeltas1()
+    , fDeltas2()
     , fEventPoolMgr(other.fEventPoolMgr)
     , fVz(other.fVz)
     , fMultiplicity(other.fMultiplicity)
@@ -205,32 +213,35 @@ class AliThreeParticleCorrelator : public TNamed {
 	  //Correlate triggers from this event with past associated:
 	  MakeAssociated(Mixedparticles, fAssociated,fMECorrelations,false);
 	  MakeTriggers(Mixedparticles,fMECorrelations,fLeading,false);
+	  //The associated of each pool event are selected once and reused for all combinations.
+	  fAssociatedPool.resize(EventsInPool);
+	  for (int nEvent=0; nEvent<EventsInPool; nEvent++) MakeAssociated(pool->GetEvent(nEvent), fAssociatedPool[nEvent],fMECorrelations);
 	  for (int nEvent=0; nEvent<EventsInPool; nEvent++) {
-	    MakeAssociated(pool->GetEvent(nEvent), fAssociatedmixed1,fMECorrelations);
-	    ProcessEvent(factiveTriggers,fAssociated,fAssociatedmixed1,fMETACorrelations);
-	    ProcessEvent(factiveTriggers,fAssociatedmixed1,fAssociated,fMETA2Correlations);
-	    ProcessEvent(factiveTriggers, fAssociatedmixed1,fMETriggerCorrelations);
+	    const std::vector<AliVParticle*>& associatedmixed1=fAssociatedPool[nEvent];
+	    ProcessEvent(factiveTriggers,fAssociated,associatedmixed1,fMETACorrelations);
+	    ProcessEvent(factiveTriggers,associatedmixed1,fAssociated,fMETA2Correlations);
+	    ProcessEvent(factiveTriggers, associatedmixed1,fMETriggerCorrelations);
 	    for(int mEvent=nEvent+1;mEvent<EventsInPool;mEvent++){
 	      // all particles from different events
-	      MakeAssociated(pool->GetEvent(mEvent), fAssociatedmixed2,fMECorrelations);
-	      ProcessEvent(factiveTriggers,fAssociatedmixed1,fAssociatedmixed2,fMECorrelations);
-	      ProcessEvent(factiveTriggers,fAssociatedmixed2,fAssociatedmixed1,fMECorrelations,false);
+	      const std::vector<AliVParticle*>& associatedmixed2=fAssociatedPool[mEvent];
+	      ProcessEvent(factiveTriggers,associatedmixed1,associatedmixed2,fMECorrelations);
+	      ProcessEvent(factiveTriggers,associatedmixed2,associatedmixed1,fMECorrelations,false);
 	    }//end inner loop
 	  }//End mixed event loop
 	  //Correlate associated from this event with triggers and associated from past events:
 	  for (int nEvent=0; nEvent<EventsInPool; nEvent++){
 	    MakeTriggers(pool->GetEvent(nEvent),fMECorrelations,fLeading);
-	    MakeAssociated(pool->GetEvent(nEvent), fAssociatedmixed1,fMECorrelations);
-	    //Now factiveTriggers is the same event as fAssociatedmixed1.
-	    ProcessEvent(factiveTriggers,fAssociatedmixed1,fAssociated,fMETACorrelations);
-	    ProcessEvent(factiveTriggers,fAssociated,fAssociatedmixed1,fMETA2Correlations);
+	    const std::vector<AliVParticle*>& associatedmixed1=fAssociatedPool[nEvent];
+	    //Now factiveTriggers is the same event as associatedmixed1.
+	    ProcessEvent(factiveTriggers,associatedmixed1,fAssociated,fMETACorrelations);
+	    ProcessEvent(factiveTriggers,fAssociated,associatedmixed1,fMETA2Correlations);
 	    ProcessEvent(factiveTriggers, fAssociated,fMETriggerCorrelations);
 	    for(int mEvent=0;mEvent<EventsInPool;mEvent++){
 	      if(nEvent==mEvent)continue;//dont double count
 	      // all particles from different events
-	      MakeAssociated(pool->GetEvent(mEvent), fAssociatedmixed2,fMECorrelations);
-	      ProcessEvent(factiveTriggers,fAssociated,fAssociatedmixed2,fMECorrelations);
-	      ProcessEvent(factiveTriggers,fAssociatedmixed2,fAssociated,fMECorrelations,false);
+	      const std::vector<AliVParticle*>& associatedmixed2=fAssociatedPool[mEvent];
+	      ProcessEvent(factiveTriggers,fAssociated,associatedmixed2,fMECorrelations);
+	      ProcessEvent(factiveTriggers,associatedmixed2,fAssociated,fMECorrelations,false);
 	    }//end inner loop
 	  }//End mixed event loop
 	}//End poolisready
@@ -242,39 +253,41 @@ class AliThreeParticleCorrelator : public TNamed {
     }
     factiveTriggers.clear();
     fAssociated.clear();
-    fAssociatedmixed1.clear();
-    fAssociatedmixed2.clear();
+    fAssociatedPool.clear();
     delete arrayParticles;
     return iResult;
   }
   int ProcessEvent(const std::vector<AliVParticle*>& activeTriggers, const std::vector<AliVParticle*>& associated,C* AnalysisObject) {
     /// Three particle correlation loop over array of AliVParticle objects
     /// Fill correlation objects of different properties 
-    Double_t NAssociated = associated.size();
-    Double_t weightt = 1.0;
-    Double_t weighta1 = 1.0;
-    Double_t weighta2 = 1.0;
+    /// The trigger-associated differences are computed once per trigger and
+    /// associated and reused for all triplets.
+    const size_t NAssociated = associated.size();
     if(NAssociated==0) return 0;//No associated means we need not fill anything.
     if (activeTriggers.size()==0) return 0;//No Triggers means we need not fill anything
-    for (typename std::vector<AliVParticle*>::const_iterator trigger=activeTriggers.begin(), e=activeTriggers.end(); trigger!=e; ++trigger) {
-      AnalysisObject->FillTrigger(*trigger);//Fill histogram for number of triggers.
-      weightt = 1.0;
-      if(dynamic_cast<AliFilteredTrack*>(*trigger))weightt = dynamic_cast<AliFilteredTrack*>(*trigger)->GetEff();
-      for (typename std::vector<AliVParticle*>::const_iterator assoc=associated.begin(), eassoc=associated.end(); assoc!=eassoc; ++assoc) {
-	weighta1 = 1.0;
-	if(dynamic_cast<AliFilteredTrack*>(*assoc))weighta1 = dynamic_cast<AliFilteredTrack*>(*assoc)->GetEff();
-	for (typename std::vector<AliVParticle*>::const_iterator assoc2=assoc+1, eassoc2 = associated.end(); assoc2 !=eassoc2;++assoc2){
-	  weighta2 = 1.0;
-	  if(dynamic_cast<AliFilteredTrack*>(*assoc2))weighta2 = dynamic_cast<AliFilteredTrack*>(*assoc2)->GetEff();
-	  AnalysisObject->Fill(*trigger,*assoc,*assoc2,weightt*weighta1*weighta2);//Fill histogram for number of triggers.
-	  AnalysisObject->Fill(*trigger,*assoc2,*assoc,weightt*weighta1*weighta2);//Fill histogram for number of triggers.
-	  if(trigger==activeTriggers.begin()){
+    MakeKinematics(activeTriggers,fKinTriggers);
+    MakeKinematics(associated,fKinAssociated1);
+    MakeDeltas(fKinTriggers,fKinAssociated1,fDeltas1);
+    for (size_t itrigger=0; itrigger<activeTriggers.size(); itrigger++) {
+      AnalysisObject->FillTrigger(activeTriggers[itrigger]);//Fill histogram for number of triggers.
+      const Double_t* trigger=&fKinTriggers[kNKin*itrigger];
+      const Double_t* deltas=&fDeltas1[kNDeltas*NAssociated*itrigger];
+      for (size_t iassoc=0; iassoc<NAssociated; iassoc++) {
+	const Double_t* assoc=&fKinAssociated1[kNKin*iassoc];
+	const Double_t* delta=&deltas[kNDeltas*iassoc];
+	for (size_t iassoc2=iassoc+1; iassoc2<NAssociated; iassoc2++){
+	  const Double_t* assoc2=&fKinAssociated1[kNKin*iassoc2];
+	  const Double_t* delta2=&deltas[kNDeltas*iassoc2];
+	  Double_t weight=trigger[kEff]*assoc[kEff]*assoc2[kEff];
+	  AnalysisObject->FillDeltas(trigger[kPt],assoc[kPt],assoc2[kPt],delta[kDeltaPhi],delta2[kDeltaPhi],delta[kDeltaEta],delta2[kDeltaEta],assoc[kEta]-assoc2[kEta],weight);
+	  AnalysisObject->FillDeltas(trigger[kPt],assoc2[kPt],assoc[kPt],delta2[kDeltaPhi],delta[kDeltaPhi],delta2[kDeltaEta],delta[kDeltaEta],assoc2[kEta]-assoc[kEta],weight);
+	  if(itrigger==0){
 	    //once per event fill the a-a 2p correlation histogram symmitrized
-	    AnalysisObject->Filla(*assoc,*assoc2,weighta1*weighta2);
-	    AnalysisObject->Filla(*assoc2,*assoc,weighta1*weighta2);
+	    AnalysisObject->FillaDeltas(C::DeltaPhi(assoc[kPhi],assoc2[kPhi]),assoc[kEta]-assoc2[kEta],assoc[kEff]*assoc2[kEff]);
+	    AnalysisObject->FillaDeltas(C::DeltaPhi(assoc2[kPhi],assoc[kPhi]),assoc2[kEta]-assoc[kEta],assoc[kEff]*assoc2[kEff]);
 	  }
 	}//loop over second associated
-	AnalysisObject->Fill(*trigger,*assoc,weightt*weighta1);//Fill histogram for number of triggers.	        
+	AnalysisObject->FillDeltas(trigger[kPt],assoc[kPt],delta[kDeltaPhi],delta[kDeltaEta],trigger[kEff]*assoc[kEff]);//2p correlation
       } // loop over first associated
     } // loop over triggers
     return 0;
@@ -282,32 +295,37 @@ class AliThreeParticleCorrelator : public TNamed {
   int ProcessEvent(const std::vector<AliVParticle*>& activeTriggers,const std::vector<AliVParticle*>& associated, const std::vector<AliVParticle*>& associatedmixed,C* AnalysisObject,bool twop = true) {
     /// Three particle correlation loop over array of AliVParticle objects
     /// Fill correlation objects of different properties 
-    Double_t NAssociated1 = associated.size();
-    Double_t NAssociated2 = associatedmixed.size();
-    Double_t weightt = 1.0;
-    Double_t weighta1 = 1.0;
-    Double_t weighta2 = 1.0;
+    /// The trigger-associated differences are computed once per trigger and
+    /// associated and reused for all triplets.
+    const size_t NAssociated1 = associated.size();
+    const size_t NAssociated2 = associatedmixed.size();
     if(NAssociated1==0||NAssociated2==0) return 0;//No associated means we need not fill anything.
     if (activeTriggers.size()==0) return 0;//no triggers means nothing to be correlated
-    for (typename std::vector<AliVParticle*>::const_iterator trigger=activeTriggers.begin(), e=activeTriggers.end(); trigger!=e; ++trigger) {
-      AnalysisObject->FillTrigger(*trigger);//Fill histogram for number of triggers.
-      weightt = 1.0;
-      if(dynamic_cast<AliFilteredTrack*>(*trigger))weightt = dynamic_cast<AliFilteredTrack*>(*trigger)->GetEff();
-      for (typename std::vector<AliVParticle*>::const_iterator assoc=associated.begin(), eassoc=associated.end(); assoc!=eassoc; ++assoc) {
-	weighta1 = 1.0;
-	if(dynamic_cast<AliFilteredTrack*>(*assoc))weighta1 = dynamic_cast<AliFilteredTrack*>(*assoc)->GetEff();
-	for (typename std::vector<AliVParticle*>::const_iterator assoc2=associatedmixed.begin(), eassoc2 = associatedmixed.end(); assoc2 !=eassoc2;++assoc2){
-	  weighta2 = 1.0;
-	  if(dynamic_cast<AliFilteredTrack*>(*assoc2))weighta2 = dynamic_cast<AliFilteredTrack*>(*assoc2)->GetEff();
-	  AnalysisObject->Fill(*trigger,*assoc,*assoc2,weightt*weighta1*weighta2);//Fill histogram for number of triggers.
-	  if(trigger==activeTriggers.begin()){
+    MakeKinematics(activeTriggers,fKinTriggers);
+    MakeKinematics(associated,fKinAssociated1);
+    MakeKinematics(associatedmixed,fKinAssociated2);
+    MakeDeltas(fKinTriggers,fKinAssociated1,fDeltas1);
+    MakeDeltas(fKinTriggers,fKinAssociated2,fDeltas2);
+    for (size_t itrigger=0; itrigger<activeTriggers.size(); itrigger++) {
+      AnalysisObject->FillTrigger(activeTriggers[itrigger]);//Fill histogram for number of triggers.
+      const Double_t* trigger=&fKinTriggers[kNKin*itrigger];
+      const Double_t* deltas1=&fDeltas1[kNDeltas*NAssociated1*itrigger];
+      const Double_t* deltas2=&fDeltas2[kNDeltas*NAssociated2*itrigger];
+      for (size_t iassoc=0; iassoc<NAssociated1; iassoc++) {
+	const Double_t* assoc=&fKinAssociated1[kNKin*iassoc];
+	const Double_t* delta=&deltas1[kNDeltas*iassoc];
+	for (size_t iassoc2=0; iassoc2<NAssociated2; iassoc2++){
+	  const Double_t* assoc2=&fKinAssociated2[kNKin*iassoc2];
+	  const Double_t* delta2=&deltas2[kNDeltas*iassoc2];
+	  AnalysisObject->FillDeltas(trigger[kPt],assoc[kPt],assoc2[kPt],delta[kDeltaPhi],delta2[kDeltaPhi],delta[kDeltaEta],delta2[kDeltaEta],assoc[kEta]-assoc2[kEta],trigger[kEff]*assoc[kEff]*assoc2[kEff]);
+	  if(itrigger==0){
 	    //once per event fill the a-a 2p correlation histogram
-	    AnalysisObject->Filla(*assoc,*assoc2,weighta1*weighta2);
-	    AnalysisObject->Filla(*assoc2,*assoc,weighta1*weighta2);
+	    AnalysisObject->FillaDeltas(C::DeltaPhi(assoc[kPhi],assoc2[kPhi]),assoc[kEta]-assoc2[kEta],assoc[kEff]*assoc2[kEff]);
+	    AnalysisObject->FillaDeltas(C::DeltaPhi(assoc2[kPhi],assoc[kPhi]),assoc2[kEta]-assoc[kEta],assoc[kEff]*assoc2[kEff]);
 	  }
 	}//loop over second associated
 	if (twop){
-	  AnalysisObject->Fill(*trigger,*assoc,weightt*weighta1);//Fill histogram for number of triggers.  
+	  AnalysisObject->FillDeltas(trigger[kPt],assoc[kPt],delta[kDeltaPhi],delta[kDeltaEta],trigger[kEff]*assoc[kEff]);//2p correlation
 	  }
 	} // loop over first associated
     } // loop over triggers
@@ -390,6 +408,34 @@ class AliThreeParticleCorrelator : public TNamed {
     }
     return ;
   }
+  void MakeKinematics(const std::vector<AliVParticle*>& particles, std::vector<Double_t>& kinematics) {
+    /// cache pt, eta, phi and efficiency weight of the particles
+    kinematics.resize(kNKin*particles.size());
+    for (size_t i=0; i<particles.size(); i++) {
+      AliVParticle* p=particles[i];
+      Double_t* kin=&kinematics[kNKin*i];
+      kin[kPt]=p->Pt();
+      kin[kEta]=p->Eta();
+      kin[kPhi]=p->Phi();
+      AliFilteredTrack* track=dynamic_cast<AliFilteredTrack*>(p);
+      kin[kEff]=track?track->GetEff():1.0;
+    }
+  }
+  void MakeDeltas(const std::vector<Double_t>& kinTriggers, const std::vector<Double_t>& kinematics, std::vector<Double_t>& deltas) {
+    /// table of the phi and eta differences of each (trigger, particle) combination, one row per trigger
+    const size_t ntriggers=kinTriggers.size()/kNKin;
+    const size_t nparticles=kinematics.size()/kNKin;
+    deltas.resize(kNDeltas*ntriggers*nparticles);
+    for (size_t itrigger=0; itrigger<ntriggers; itrigger++) {
+      const Double_t* trigger=&kinTriggers[kNKin*itrigger];
+      Double_t* row=&deltas[kNDeltas*nparticles*itrigger];
+      for (size_t i=0; i<nparticles; i++) {
+	const Double_t* kin=&kinematics[kNKin*i];
+	row[kNDeltas*i+kDeltaPhi]=C::DeltaPhi(trigger[kPhi],kin[kPhi]);
+	row[kNDeltas*i+kDeltaEta]=trigger[kEta]-kin[kEta];
+      }
+    }
+  }
   void Clear(Option_t * /*option*/)
   {
     /// overloaded from TObject: cleanup
@@ -401,6 +447,8 @@ class AliThreeParticleCorrelator : public TNamed {
     TObject::Print();
   }
  private:
+  enum {kPt, kEta, kPhi, kEff, kNKin}; // layout of the cached kinematics
+  enum {kDeltaPhi, kDeltaEta, kNDeltas}; // layout of the trigger-particle difference tables
   C* fCorrelations; //! worker object
   C* fMECorrelations; //! ME analysis clones of worker, all three particles different events, only one associated from each event
   C* fMETriggerCorrelations; //! ME analysis clones of worker, associated particles same events
@@ -408,8 +456,12 @@ class AliThreeParticleCorrelator : public TNamed {
   C* fMETA2Correlations; //! ME analysis clones of worker, second associated particle from the same events as the trigger
   std::vector<AliVParticle*> factiveTriggers; //!Vector to contain the triggers.
   std::vector<AliVParticle*> fAssociated;//!vector to contain the associated particles.
-  std::vector<AliVParticle*> fAssociatedmixed1; //! buffer for Associated
-  std::vector<AliVParticle*> fAssociatedmixed2; //! buffer for Associated
+  std::vector<std::vector<AliVParticle*> > fAssociatedPool; //! associated of each event in the pool
+  std::vector<Double_t> fKinTriggers; //! pt, eta, phi, efficiency of the triggers
+  std::vector<Double_t> fKinAssociated1; //! pt, eta, phi, efficiency of the first associated
+  std::vector<Double_t> fKinAssociated2; //! pt, eta, phi, efficiency of the second associated
+  std::vector<Double_t> fDeltas1; //! phi and eta differences (trigger, first associated)
+  std::vector<Double_t> fDeltas2; //! phi and eta differences (trigger, second associated)
   AliEventPoolManager* fEventPoolMgr; //! event pool manager, external pointer
   Double_t fVz;//Vertex in z
   Double_t fMultiplicity;//Multiplicity in %
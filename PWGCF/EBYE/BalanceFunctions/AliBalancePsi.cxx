@@ -33,6 +33,8 @@
 #include <TString.h>
 #include <TSpline.h>
 #include <TRandom3.h>
+#include <TDatabasePDG.h>
+#include <algorithm>
 
 #include "AliVParticle.h"
 #include "AliMCParticle.h"
@@ -46,6 +48,22 @@ using std::cout;
 using std::endl;
 using std::cerr;
 
+namespace {
+  // order of the tracks in the packed buffer of the fast pair loop:
+  // charge class (positive, negative, neutral), then pT if requested
+  struct AliBalancePsiPackOrder {
+    AliBalancePsiPackOrder(const Short_t *chargeClass, const Float_t *pt, Bool_t byPt) :
+      fChargeClass(chargeClass), fPt(pt), fByPt(byPt) {}
+    bool operator()(Int_t a, Int_t b) const {
+      if(fChargeClass[a] != fChargeClass[b]) return fChargeClass[a] < fChargeClass[b];
+      return fByPt && fPt[a] < fPt[b];
+    }
+    const Short_t *fChargeClass;
+    const Float_t *fPt;
+    Bool_t fByPt;
+  };
+}
+
 ClassImp(AliBalancePsi)
 
 //____________________________________________________________________//
@@ -89,8 +107,27 @@ AliBalancePsi::AliBalancePsi() :
   fVertexBinning(kFALSE),
   fCustomBinning(""),
   fBinningString(""),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fFastPairLoop(kFALSE),
+  fPackIndex(),
+  fPackCharge(),
+  fPackEta(),
+  fPackPhi(),
+  fPackPt(),
+  fPackCosPhi(),
+  fPackSinPhi(),
+  fPackCotTheta(),
+  fPackSqrtESqu(),
+  fPackCorrection(),
+  fPackPx(),
+  fPackPy(),
+  fPackPz(),
+  fPackEPion(),
+  fPackEProton(),
+  fPairDeltaEta(),
+  fPairDeltaPhi(){
   // Default constructor
+  for(Int_t i = 0; i < 4; i++) fPackBlockStart[i] = 0;
 }
 
 //____________________________________________________________________//
@@ -133,8 +170,27 @@ AliBalancePsi::AliBalancePsi(const AliBalancePsi& balance):
   fVertexBinning(balance.fVertexBinning),
   fCustomBinning(balance.fCustomBinning),
   fBinningString(balance.fBinningString),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fFastPairLoop(balance.fFastPairLoop),
+  fPackIndex(),
+  fPackCharge(),
+  fPackEta(),
+  fPackPhi(),
+  fPackPt(),
+  fPackCosPhi(),
+  fPackSinPhi(),
+  fPackCotTheta(),
+  fPackSqrtESqu(),
+  fPackCorrection(),
+  fPackPx(),
+  fPackPy(),
+  fPackPz(),
+  fPackEPion(),
+  fPackEProton(),
+  fPairDeltaEta(),
+  fPairDeltaPhi(){
   //copy constructor
+  for(Int_t i = 0; i < 4; i++) fPackBlockStart[i] = 0;
 }
 
 //____________________________________________________________________//
@@ -451,6 +507,9 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     secondCharge[i]  = (Short_t)((AliVParticle*) particlesSecond->At(i))->Charge();
     secondCorrection[i]  = (Double_t)((AliBFBasicParticle*) particlesSecond->At(i))->Correction();   //==========================correction
   }
+
+  // charge-sorted packed copy of the same tracks for the fast pair loop
+  if(fFastPairLoop) PackSecondParticles(particlesSecond);
   
   //TLorenzVector implementation for resonances
   TLorentzVector vectorMother, vectorDaughter[2];
@@ -512,6 +571,11 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     if(charge1 > 0)      fHistP->Fill(trackVariablesSingle,0,firstCorrection); //==========================correction
     else if(charge1 < 0) fHistN->Fill(trackVariablesSingle,0,firstCorrection);  //==========================correction
     
+    if(fFastPairLoop) {
+      FillPairsPacked(i, firstEta, firstPhi, firstPt, charge1, firstCorrection, trackVariablesSingle[0], vertexZ, bSign, particlesMixed != 0);
+      continue;
+    }
+
     // 2nd particle loop
     for(Int_t j = 0; j < jMax; j++) {   
 
@@ -584,60 +648,8 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
       // HBT like cut
       //if(fHBTCut){ // VERSION 3 (all pairs)
       if(fHBTCut && charge1 * charge2 > 0){  // VERSION 2 (only for LS)
-	//if( dphi < 3 || deta < 0.01 ){   // VERSION 1
-	//  continue;
-	
-	Double_t deta = firstEta - secondEta[j];
-	Double_t dphi = firstPhi - secondPhi[j];
-	if(dphi > TMath::Pi())
-	  dphi = secondPhi[j] - firstPhi;
-
-	// for QA: get dphistar in the middle of the TPC R = 1.65
-	Float_t  dphistarMiddle = GetDPhiStar(firstPhi, firstPt, charge1, secondPhi[j], secondPt[j], charge2, 1.65, bSign);
-
-	// VERSION 2 (Taken from DPhiCorrelations)
-	// the variables & cuthave been developed by the HBT group 
-	// see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
-	fHistHBTbefore->Fill(deta,dphi);
-	fHistPhiStarHBTbefore->Fill(deta,dphistarMiddle);
-	
-	// optimization
-	if (TMath::Abs(deta) < fHBTCutValue * 2.5 * 3) //fHBTCutValue = 0.02 [default for dphicorrelations]
-	  {
-	    // phi in rad
-	    //Float_t phi1rad = firstPhi*TMath::DegToRad();
-	    //Float_t phi2rad = secondPhi[j]*TMath::DegToRad();
-	    Float_t phi1rad = firstPhi;
-	    Float_t phi2rad = secondPhi[j];
-	    
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 0.8, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = fHBTCutValue * 3;
-	    
-	    Float_t dphistarminabs = 1e5;
-	    //Float_t dphistarmin = 1e5;
-	    
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0 ) {
-	      for (Double_t rad=0.8; rad<2.51; rad+=0.01) {
-		Float_t dphistar = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt[j], charge2, rad, bSign);
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs) {
-		  //dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      if (dphistarminabs < fHBTCutValue && TMath::Abs(deta) < fHBTCutValue) {
-		//AliInfo(Form("HBT: Removed track pair %d %d with [[%f %f]] %f %f %f | %f %f %d %f %f %d %f", i, j, deta, dphi, dphistarminabs, dphistar1, dphistar2, phi1rad, pt1, charge1, phi2rad, pt2, charge2, bSign));
-		continue;
-	      }
-	    }
-	  }
-	fHistHBTafter->Fill(deta,dphi);
-	fHistPhiStarHBTafter->Fill(deta,dphistarMiddle);
+	if(!PassHBTCut(firstEta, firstPhi, firstPt, charge1, secondEta[j], secondPhi[j], secondPt[j], charge2, bSign))
+	  continue;
       }//HBT cut
 	
       // conversions
@@ -701,6 +713,282 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
   }//end of 1st particle loop
 }  
 
+//____________________________________________________________________//
+void AliBalancePsi::PackSecondParticles(TObjArray *particles) {
+  // Fills the packed buffer of the fast pair loop with the tracks of the
+  // inner loop: one array per variable, tracks sorted by charge (positive,
+  // negative, neutral) and, with momentum ordering, by increasing pT.
+  // The kinematics needed by the resonance and conversion cuts are
+  // computed here once per track instead of once per pair.
+  static const Double_t kMassPion   = TDatabasePDG::Instance()->GetParticle(211)->Mass();
+  static const Double_t kMassProton = TDatabasePDG::Instance()->GetParticle(2212)->Mass();
+  const Float_t kMassElectron = 0.510e-3;
+
+  Int_t nTracks = particles->GetEntriesFast();
+  std::vector<Short_t> chargeClass(nTracks);
+  std::vector<Float_t> pt(nTracks);
+  std::vector<Int_t> order(nTracks);
+  for(Int_t i = 0; i < nTracks; i++) {
+    AliVParticle *part = (AliVParticle*) particles->At(i);
+    Short_t charge = (Short_t) part->Charge();
+    chargeClass[i] = (charge > 0) ? 0 : ((charge < 0) ? 1 : 2);
+    pt[i] = part->Pt();
+    order[i] = i;
+  }
+  AliBalancePsiPackOrder packOrder(nTracks ? &chargeClass[0] : 0, nTracks ? &pt[0] : 0, fMomentumOrdering);
+  std::stable_sort(order.begin(), order.end(), packOrder);
+
+  fPackIndex.resize(nTracks); fPackCharge.resize(nTracks);
+  fPackEta.resize(nTracks); fPackPhi.resize(nTracks); fPackPt.resize(nTracks);
+  fPackCosPhi.resize(nTracks); fPackSinPhi.resize(nTracks);
+  fPackCotTheta.resize(nTracks); fPackSqrtESqu.resize(nTracks);
+  fPackCorrection.resize(nTracks);
+  fPackPx.resize(nTracks); fPackPy.resize(nTracks); fPackPz.resize(nTracks);
+  fPackEPion.resize(nTracks); fPackEProton.resize(nTracks);
+  for(Int_t i = 0; i < 4; i++) fPackBlockStart[i] = nTracks;
+  fPackBlockStart[0] = 0;
+
+  for(Int_t k = nTracks - 1; k >= 0; k--) {
+    Int_t i = order[k];
+    AliBFBasicParticle *part = (AliBFBasicParticle*) particles->At(i);
+    fPackBlockStart[chargeClass[i]] = k;
+    fPackIndex[k]      = i;
+    fPackCharge[k]     = (Short_t) part->Charge();
+    fPackEta[k]        = part->Eta();
+    fPackPhi[k]        = part->Phi();
+    fPackPt[k]         = pt[i];
+    fPackCorrection[k] = (Double_t) part->Correction();
+    fPackCosPhi[k]     = TMath::Cos(fPackPhi[k]);
+    fPackSinPhi[k]     = TMath::Sin(fPackPhi[k]);
+
+    // as TLorentzVector::SetPtEtaPhiM in the resonance cut
+    fPackPx[k] = pt[i] * TMath::Cos(fPackPhi[k]);
+    fPackPy[k] = pt[i] * TMath::Sin(fPackPhi[k]);
+    fPackPz[k] = pt[i] * TMath::SinH(fPackEta[k]);
+    Double_t p2 = fPackPx[k]*fPackPx[k] + fPackPy[k]*fPackPy[k] + fPackPz[k]*fPackPz[k];
+    fPackEPion[k]   = TMath::Sqrt(p2 + kMassPion*kMassPion);
+    fPackEProton[k] = TMath::Sqrt(p2 + kMassProton*kMassProton);
+
+    // as in the conversion cut
+    Float_t tantheta = 1e10;
+    if (fPackEta[k] < -1e-10 || fPackEta[k] > 1e-10)
+      tantheta = 2 * TMath::Exp(-fPackEta[k]) / ( 1 - TMath::Exp(-2*fPackEta[k]));
+    fPackCotTheta[k] = 1.0 / tantheta;
+    fPackSqrtESqu[k] = TMath::Sqrt(kMassElectron * kMassElectron + pt[i] * pt[i] * (1.0 + fPackCotTheta[k] * fPackCotTheta[k]));
+  }
+  // empty charge classes start where the next one starts
+  for(Int_t iBlock = 2; iBlock > 0; iBlock--)
+    if(fPackBlockStart[iBlock] < fPackBlockStart[iBlock-1]) fPackBlockStart[iBlock-1] = fPackBlockStart[iBlock];
+
+  if((Int_t)fPairDeltaEta.size() < nTracks) {
+    fPairDeltaEta.resize(nTracks);
+    fPairDeltaPhi.resize(nTracks);
+  }
+}
+
+//____________________________________________________________________//
+void AliBalancePsi::FillPairsPacked(Int_t iFirst, Float_t firstEta, Float_t firstPhi, Float_t firstPt,
+				    Short_t charge1, Float_t firstCorrection, Double_t eventClass,
+				    Double_t vertexZ, Float_t bSign, Bool_t mixing) {
+  // Fast version of the 2nd particle loop of CalculateBalance on the
+  // tracks packed by PackSecondParticles. For each charge block the
+  // target histogram is fixed, the momentum ordering is a binary search
+  // and delta eta/phi are computed for the whole block in one loop.
+  // The resonance cut uses the precomputed four-momenta: the Lambda
+  // hypotheses are tested on the mass squared, and the square root is
+  // only taken for the QA histograms. Same pairs, cuts and weights as
+  // the standard loop.
+  static const Double_t kMassPion   = TDatabasePDG::Instance()->GetParticle(211)->Mass();
+  static const Double_t kMassProton = TDatabasePDG::Instance()->GetParticle(2212)->Mass();
+  static const Double_t kMassRho0   = TDatabasePDG::Instance()->GetParticle(113)->Mass();
+  static const Double_t kMassK0s    = TDatabasePDG::Instance()->GetParticle(310)->Mass();
+  static const Double_t kMassLambda = TDatabasePDG::Instance()->GetParticle(3122)->Mass();
+  const Double_t gWidthForRho0 = 0.01;
+  const Double_t gWidthForK0s = 0.01;
+  const Double_t gWidthForLambda = 0.006;
+  const Double_t nSigmaRejection = 3.0;
+  const Double_t kLambdaMin = TMath::Max(kMassLambda - nSigmaRejection*gWidthForLambda, 0.);
+  const Double_t kLambdaMax = kMassLambda + nSigmaRejection*gWidthForLambda;
+  const Double_t kLambdaMin2 = kLambdaMin*kLambdaMin;
+  const Double_t kLambdaMax2 = kLambdaMax*kLambdaMax;
+  const Float_t kMassElectron = 0.510e-3;
+
+  // kinematics of the first particle for the resonance and conversion cuts
+  Double_t firstPx = 0., firstPy = 0., firstPz = 0., firstEPion = 0., firstEProton = 0.;
+  Float_t firstCos = 0., firstSin = 0., firstCotTheta = 0., firstSqrtESqu = 0.;
+  if(fResonancesCut || fConversionCut) {
+    firstPx = firstPt * TMath::Cos(firstPhi);
+    firstPy = firstPt * TMath::Sin(firstPhi);
+    firstPz = firstPt * TMath::SinH(firstEta);
+    Double_t p2 = firstPx*firstPx + firstPy*firstPy + firstPz*firstPz;
+    firstEPion   = TMath::Sqrt(p2 + kMassPion*kMassPion);
+    firstEProton = TMath::Sqrt(p2 + kMassProton*kMassProton);
+    firstCos = TMath::Cos(firstPhi);
+    firstSin = TMath::Sin(firstPhi);
+    Float_t tantheta = 1e10;
+    if (firstEta < -1e-10 || firstEta > 1e-10)
+      tantheta = 2 * TMath::Exp(-firstEta) / ( 1 - TMath::Exp(-2*firstEta));
+    firstCotTheta = 1.0 / tantheta;
+    firstSqrtESqu = TMath::Sqrt(kMassElectron * kMassElectron + firstPt * firstPt * (1.0 + firstCotTheta * firstCotTheta));
+  }
+
+  Double_t trackVariablesPair[kTrackVariablesPair];
+  trackVariablesPair[0] = eventClass;
+  trackVariablesPair[3] = firstPt;  // pt trigger
+  trackVariablesPair[5] = vertexZ;  // z of the primary vertex
+
+  for(Int_t iBlock = 0; iBlock < 3; iBlock++) {
+    Int_t jBegin = fPackBlockStart[iBlock];
+    Int_t jEnd   = fPackBlockStart[iBlock+1];
+    // pT,Assoc <= pT,Trig: the block is sorted in pT
+    if(fMomentumOrdering)
+      jEnd = std::upper_bound(fPackPt.begin() + jBegin, fPackPt.begin() + jEnd, firstPt) - fPackPt.begin();
+    Int_t nPairs = jEnd - jBegin;
+    if(nPairs <= 0) continue;
+
+    AliTHn *histPair = 0;
+    if(charge1 > 0)      histPair = (iBlock == 0) ? fHistPP : ((iBlock == 1) ? fHistPN : 0);
+    else if(charge1 < 0) histPair = (iBlock == 0) ? fHistNP : ((iBlock == 1) ? fHistNN : 0);
+    // pairs with a neutral particle only enter the QA of the momentum difference cut
+    if(!histPair && !fQCut) continue;
+
+    // delta eta and delta phi of the block
+    const Float_t *secondEta = &fPackEta[jBegin];
+    const Float_t *secondPhi = &fPackPhi[jBegin];
+    Double_t *deltaEta = &fPairDeltaEta[0];
+    Double_t *deltaPhi = &fPairDeltaPhi[0];
+    for(Int_t k = 0; k < nPairs; k++) {
+      deltaEta[k] = firstEta - secondEta[k];
+      Double_t dphi = firstPhi - secondPhi[k];
+      if (dphi > TMath::Pi()) dphi -= 2.*TMath::Pi(); // delta phi between -pi and pi
+      if (dphi < - TMath::Pi()) dphi += 2.*TMath::Pi();
+      if (dphi < - TMath::Pi()/2.) dphi += 2.*TMath::Pi();
+      deltaPhi[k] = dphi;
+    }
+
+    for(Int_t k = 0; k < nPairs; k++) {
+      Int_t j = jBegin + k;
+      if(!mixing && fPackIndex[j] == iFirst) continue; // no auto correlations (only for non mixing)
+
+      Short_t charge2 = fPackCharge[j];
+      trackVariablesPair[1] = deltaEta[k];
+      trackVariablesPair[2] = deltaPhi[k];
+      trackVariablesPair[4] = fPackPt[j];
+
+      if(fResonancesCut && charge1 * charge2 < 0) {
+	Double_t pDot = firstPx*fPackPx[j] + firstPy*fPackPy[j] + firstPz*fPackPz[j];
+
+	//rho0 and K0s
+	Double_t mass2 = 2.*kMassPion*kMassPion + 2.*(firstEPion*fPackEPion[j] - pDot);
+	Double_t mass = (mass2 < 0) ? -TMath::Sqrt(-mass2) : TMath::Sqrt(mass2);
+	fHistResonancesBefore->Fill(deltaEta[k],deltaPhi[k],mass);
+	if(TMath::Abs(mass - kMassRho0) <= nSigmaRejection*gWidthForRho0)
+	  continue;
+	fHistResonancesRho->Fill(deltaEta[k],deltaPhi[k],mass);
+	if(TMath::Abs(mass - kMassK0s) <= nSigmaRejection*gWidthForK0s)
+	  continue;
+	fHistResonancesK0->Fill(deltaEta[k],deltaPhi[k],mass);
+
+	//Lambda (pi p and p pi)
+	mass2 = kMassPion*kMassPion + kMassProton*kMassProton + 2.*(firstEPion*fPackEProton[j] - pDot);
+	if(mass2 >= kLambdaMin2 && mass2 <= kLambdaMax2)
+	  continue;
+	mass2 = kMassPion*kMassPion + kMassProton*kMassProton + 2.*(firstEProton*fPackEPion[j] - pDot);
+	if(mass2 >= kLambdaMin2 && mass2 <= kLambdaMax2)
+	  continue;
+	mass = (mass2 < 0) ? -TMath::Sqrt(-mass2) : TMath::Sqrt(mass2);
+	fHistResonancesLambda->Fill(deltaEta[k],deltaPhi[k],mass);
+      }
+
+      if(fHBTCut && charge1 * charge2 > 0) {
+	if(!PassHBTCut(firstEta, firstPhi, firstPt, charge1, fPackEta[j], fPackPhi[j], fPackPt[j], charge2, bSign))
+	  continue;
+      }
+
+      if(fConversionCut && charge1 * charge2 < 0) {
+	Float_t masssqu = 2 * kMassElectron * kMassElectron + 2 * ( firstSqrtESqu * fPackSqrtESqu[j] - ( firstPt * fPackPt[j] * ( firstCos * fPackCosPhi[j] + firstSin * fPackSinPhi[j] + firstCotTheta * fPackCotTheta[j] ) ) );
+	Double_t dphi = firstPhi - fPackPhi[j];
+	fHistConversionbefore->Fill(deltaEta[k],dphi,masssqu);
+	if (masssqu < fInvMassCutConversion*fInvMassCutConversion)
+	  continue;
+	fHistConversionafter->Fill(deltaEta[k],dphi,masssqu);
+      }
+
+      if(fQCut) {
+	Double_t ptDifference = TMath::Abs( firstPt - fPackPt[j]);
+	fHistQbefore->Fill(deltaEta[k],deltaPhi[k],ptDifference);
+	if(ptDifference < fDeltaPtMin) continue;
+	fHistQafter->Fill(deltaEta[k],deltaPhi[k],ptDifference);
+      }
+
+      if(histPair) histPair->Fill(trackVariablesPair,0,firstCorrection*fPackCorrection[j]);
+    }
+  }
+}
+
+//____________________________________________________________________//
+Bool_t AliBalancePsi::PassHBTCut(Float_t firstEta, Float_t firstPhi, Float_t firstPt, Short_t charge1,
+				 Float_t secondEta, Float_t secondPhi, Float_t secondPt, Short_t charge2,
+				 Float_t bSign) {
+  // two-track efficiency cut (like HBT group), fills the QA histograms
+  // returns kFALSE if the pair has to be removed
+  //if( dphi < 3 || deta < 0.01 ){   // VERSION 1
+  //  continue;
+  
+  Double_t deta = firstEta - secondEta;
+  Double_t dphi = firstPhi - secondPhi;
+  if(dphi > TMath::Pi())
+    dphi = secondPhi - firstPhi;
+
+  // for QA: get dphistar in the middle of the TPC R = 1.65
+  Float_t  dphistarMiddle = GetDPhiStar(firstPhi, firstPt, charge1, secondPhi, secondPt, charge2, 1.65, bSign);
+
+  // VERSION 2 (Taken from DPhiCorrelations)
+  // the variables & cuthave been developed by the HBT group 
+  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+  fHistHBTbefore->Fill(deta,dphi);
+  fHistPhiStarHBTbefore->Fill(deta,dphistarMiddle);
+  
+  // optimization
+  if (TMath::Abs(deta) < fHBTCutValue * 2.5 * 3) //fHBTCutValue = 0.02 [default for dphicorrelations]
+    {
+      // phi in rad
+      //Float_t phi1rad = firstPhi*TMath::DegToRad();
+      //Float_t phi2rad = secondPhi*TMath::DegToRad();
+      Float_t phi1rad = firstPhi;
+      Float_t phi2rad = secondPhi;
+      
+      // check first boundaries to see if is worth to loop and find the minimum
+      Float_t dphistar1 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt, charge2, 0.8, bSign);
+      Float_t dphistar2 = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt, charge2, 2.5, bSign);
+      
+      const Float_t kLimit = fHBTCutValue * 3;
+      
+      Float_t dphistarminabs = 1e5;
+      //Float_t dphistarmin = 1e5;
+      
+      if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0 ) {
+        for (Double_t rad=0.8; rad<2.51; rad+=0.01) {
+          Float_t dphistar = GetDPhiStar(phi1rad, firstPt, charge1, phi2rad, secondPt, charge2, rad, bSign);
+          Float_t dphistarabs = TMath::Abs(dphistar);
+          
+          if (dphistarabs < dphistarminabs) {
+            //dphistarmin = dphistar;
+            dphistarminabs = dphistarabs;
+          }
+        }
+        
+        if (dphistarminabs < fHBTCutValue && TMath::Abs(deta) < fHBTCutValue) {
+          //AliInfo(Form("HBT: Removed track pair %d %d with [[%f %f]] %f %f %f | %f %f %d %f %f %d %f", i, j, deta, dphi, dphistarminabs, dphistar1, dphistar2, phi1rad, pt1, charge1, phi2rad, pt2, charge2, bSign));
+          return kFALSE;
+        }
+      }
+    }
+  fHistHBTafter->Fill(deta,dphi);
+  fHistPhiStarHBTafter->Fill(deta,dphistarMiddle);
+  return kTRUE;
+}
+
 //____________________________________________________________________//
 TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
 						 Int_t iVariablePair,
@@ -231,6 +231,7 @@ class AliBalancePsi : public TObject {
     fConversionCut = kTRUE; fInvMassCutConversion = setInvMassCutConversion; }
   void UseMomentumDifferenceCut(Double_t gDeltaPtCutMin) {
     fQCut = kTRUE; fDeltaPtMin = gDeltaPtCutMin;}
+  void UseFastPairLoop(Bool_t fastPairLoop = kTRUE) {fFastPairLoop = fastPairLoop;}
 
   // related to customized binning of output AliTHn
   Bool_t    IsUseVertexBinning() { return fVertexBinning; }
@@ -239,6 +240,12 @@ class AliBalancePsi : public TObject {
 
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
+  Bool_t    PassHBTCut(Float_t firstEta, Float_t firstPhi, Float_t firstPt, Short_t charge1,
+		       Float_t secondEta, Float_t secondPhi, Float_t secondPt, Short_t charge2, Float_t bSign);
+  void      PackSecondParticles(TObjArray *particles);
+  void      FillPairsPacked(Int_t iFirst, Float_t firstEta, Float_t firstPhi, Float_t firstPt,
+			    Short_t charge1, Float_t firstCorrection, Double_t eventClass,
+			    Double_t vertexZ, Float_t bSign, Bool_t mixing);
 
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
@@ -288,9 +295,31 @@ class AliBalancePsi : public TObject {
 
   TString fEventClass;
 
+  Bool_t fFastPairLoop;//pair loop on charge-sorted packed tracks (same output as the standard loop)
+
+  // packed tracks of the inner loop, sorted by charge (+, -, 0)
+  std::vector<Int_t>    fPackIndex;//! index in the input array
+  std::vector<Short_t>  fPackCharge;//! charge
+  std::vector<Float_t>  fPackEta;//! eta
+  std::vector<Float_t>  fPackPhi;//! phi
+  std::vector<Float_t>  fPackPt;//! pT
+  std::vector<Float_t>  fPackCosPhi;//! cos(phi) (conversion cut)
+  std::vector<Float_t>  fPackSinPhi;//! sin(phi) (conversion cut)
+  std::vector<Float_t>  fPackCotTheta;//! 1/tan(theta) (conversion cut)
+  std::vector<Float_t>  fPackSqrtESqu;//! energy with electron mass (conversion cut)
+  std::vector<Double_t> fPackCorrection;//! correction weight
+  std::vector<Double_t> fPackPx;//! px (resonance cut)
+  std::vector<Double_t> fPackPy;//! py (resonance cut)
+  std::vector<Double_t> fPackPz;//! pz (resonance cut)
+  std::vector<Double_t> fPackEPion;//! energy with pion mass (resonance cut)
+  std::vector<Double_t> fPackEProton;//! energy with proton mass (resonance cut)
+  Int_t fPackBlockStart[4];//! first track of the +, -, 0 blocks and number of tracks
+  std::vector<Double_t> fPairDeltaEta;//! delta eta of the pairs of one block
+  std::vector<Double_t> fPairDeltaPhi;//! delta phi of the pairs of one block
+
   AliBalancePsi & operator=(const AliBalancePsi & ) {return *this;}
 
-  ClassDef(AliBalancePsi, 2)
+  ClassDef(AliBalancePsi, 3)
 };
 
 #endif
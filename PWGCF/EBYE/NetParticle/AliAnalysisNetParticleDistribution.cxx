@@ -20,6 +20,7 @@
 #include "AliAODTrack.h"
 #include "AliAODMCParticle.h"
 
+#include "AliAnalysisNetParticleMoments.h"
 #include "AliAnalysisNetParticleDistribution.h"
 
 using namespace std;
@@ -46,6 +47,7 @@ AliAnalysisNetParticleDistribution::AliAnalysisNetParticleDistribution() :
   fOutList(NULL),
 
   fOrder(8),
+  fMomentsOnly(kFALSE),
   fNNp(6),
   fNp(NULL),
   fNpPt(NULL),
@@ -600,6 +602,13 @@ void  AliAnalysisNetParticleDistribution::AddHistSetCent(const Char_t *name, con
   TString sNetTitle(Form("N_{%s} - N_{%s}", fHelper->GetParticleTitleLatex(1).Data(), fHelper->GetParticleTitleLatex(0).Data()));
   TString sSumTitle(Form("N_{%s} + N_{%s}", fHelper->GetParticleTitleLatex(1).Data(), fHelper->GetParticleTitleLatex(0).Data()));
 
+  // -- Add moments accumulator : [cent]
+  list->Add(new AliAnalysisNetParticleMoments(Form("m%sNet%s", name, fHelper->GetParticleName(1).Data()), 
+					      Form("%s : %s", sNetTitle.Data(), sTitle.Data()),
+					      nBinsCent, fHelper->GetNSubSamples(), fOrder));
+  if (fMomentsOnly)
+    return;
+
   // -- Add Particle / Anti-Particle Distributions
   for (Int_t idxPart = 0; idxPart < 2; ++idxPart) {
     list->Add(new TH2D(Form("h%s%s", name, fHelper->GetParticleName(idxPart).Data()), 
@@ -730,6 +739,13 @@ void  AliAnalysisNetParticleDistribution::AddHistSetCentPt(const Char_t *name, c
   TString sNetTitle(Form("N_{%s} - N_{%s}", fHelper->GetParticleTitleLatex(1).Data(), fHelper->GetParticleTitleLatex(0).Data()));
   TString sSumTitle(Form("N_{%s} + N_{%s}", fHelper->GetParticleTitleLatex(1).Data(), fHelper->GetParticleTitleLatex(0).Data()));
 
+  // -- Add moments accumulator : [cent * nBinsPt + ptBin]
+  list->Add(new AliAnalysisNetParticleMoments(Form("m%sNet%s", name, fHelper->GetParticleName(1).Data()), 
+					      Form("%s : %s", sNetTitle.Data(), sTitle.Data()),
+					      nBinsCent*nBinsPt, fHelper->GetNSubSamples(), fOrder));
+  if (fMomentsOnly)
+    return;
+
   // -- Add Particle / Anti-Particle Distributions
   for (Int_t idxPart = 0; idxPart < 2; ++idxPart) {
     list->Add(new TH3D(Form("h%s%s", name, fHelper->GetParticleName(idxPart).Data()), 
@@ -830,6 +846,11 @@ void AliAnalysisNetParticleDistribution::FillHistSetCent(const Char_t *name, Int
   // -- Select MC or Data
   Int_t **np = (isMC) ? fMCNp : fNp;
 
+  // -- Fill moments accumulator
+  (static_cast<AliAnalysisNetParticleMoments*>(list->FindObject(Form("m%sNet%s", name, fHelper->GetParticleName(1).Data()))))->Fill(Int_t(centralityBin), fHelper->GetSubSampleIdx(), np[idx][1], np[idx][0]);
+  if (fMomentsOnly)
+    return;
+
   // -----------------------------------------------------------------------------------------------
 
   Int_t sumNp   = np[idx][1]+np[idx][0];  // p + pbar
@@ -925,6 +946,13 @@ void AliAnalysisNetParticleDistribution::FillHistSetCentPt(const Char_t *name, I
   // -- Select MC or Data
   Int_t ***npPt = (isMC) ? fMCNpPt : fNpPt;
 
+  // -- Fill moments accumulator
+  AliAnalysisNetParticleMoments *moments = static_cast<AliAnalysisNetParticleMoments*>(list->FindObject(Form("m%sNet%s", name, fHelper->GetParticleName(1).Data())));
+  for (Int_t idxPt  = 0; idxPt < AliAnalysisNetParticleHelper::fgkfHistNBinsPt; ++idxPt)
+    moments->Fill(Int_t(centralityBin)*AliAnalysisNetParticleHelper::fgkfHistNBinsPt + idxPt, fHelper->GetSubSampleIdx(), npPt[idx][1][idxPt], npPt[idx][0][idxPt]);
+  if (fMomentsOnly)
+    return;
+
   // -----------------------------------------------------------------------------------------------
 
   // -- Loop over the pt bins
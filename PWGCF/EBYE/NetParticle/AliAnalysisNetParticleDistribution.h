@@ -42,6 +42,9 @@ class AliAnalysisNetParticleDistribution : public AliAnalysisNetParticleBase {
 
   void SetOutList(TList* l) {fOutList = l;}
 
+  /** Fill only the moments accumulators, no multiplicity distributions / profiles */
+  void SetMomentsOnly(Bool_t b) {fMomentsOnly = b;}
+
   ///////////////////////////////////////////////////////////////////////////////////
 
  private:
@@ -99,6 +102,7 @@ class AliAnalysisNetParticleDistribution : public AliAnalysisNetParticleBase {
   TList                *fOutList;               //! Output data container
   // =======================================================================
   Int_t                 fOrder;                 //  Max order of higher order distributions
+  Bool_t                fMomentsOnly;           //  Fill only the moments accumulators
   // -----------------------------------------------------------------------
   Int_t                 fNNp;                   //  N sets of arrays of particle/anti-particle counts
   Int_t               **fNp;                    //  Array of particle/anti-particle counts
@@ -113,7 +117,7 @@ class AliAnalysisNetParticleDistribution : public AliAnalysisNetParticleBase {
   THnSparseD           *fHnTrackUnCorr;         //  THnSparseD : uncorrected probe particles
   // -----------------------------------------------------------------------
 
-  ClassDef(AliAnalysisNetParticleDistribution, 1);
+  ClassDef(AliAnalysisNetParticleDistribution, 2);
 };
 
 #endif
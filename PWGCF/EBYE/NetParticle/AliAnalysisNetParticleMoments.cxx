@@ -0,0 +1,221 @@
+//-*- Mode: C++ -*-
+
+#include "TMath.h"
+#include "TCollection.h"
+
+#include "AliLog.h"
+
+#include "AliAnalysisNetParticleMoments.h"
+
+using namespace std;
+
+/**
+ * Class for NetParticle Distributions
+ * -- Streaming moments accumulator
+ */
+
+ClassImp(AliAnalysisNetParticleMoments)
+
+/*
+ * ---------------------------------------------------------------------------------
+ *                            Constructor / Destructor
+ * ---------------------------------------------------------------------------------
+ */
+
+//________________________________________________________________________
+AliAnalysisNetParticleMoments::AliAnalysisNetParticleMoments() :
+  TNamed(),
+  fNBins(0),
+  fNSubSamples(0),
+  fOrder(0),
+  fCellSize(0),
+  fSums(),
+  fRedFact() {
+  // Constructor   
+}
+
+//________________________________________________________________________
+AliAnalysisNetParticleMoments::AliAnalysisNetParticleMoments(const Char_t* name, const Char_t* title, 
+							     Int_t nBins, Int_t nSubSamples, Int_t order) :
+  TNamed(name, title),
+  fNBins(nBins),
+  fNSubSamples((nSubSamples > 0) ? nSubSamples : 1),
+  fOrder(order),
+  fCellSize((order+1)*(order+1) + order),
+  fSums(),
+  fRedFact(2*(order+1)) {
+  // Constructor   
+
+  fSums.Set(fNBins*fNSubSamples*fCellSize);
+}
+
+/*
+ * ---------------------------------------------------------------------------------
+ *                                 Public Methods
+ * ---------------------------------------------------------------------------------
+ */
+
+//________________________________________________________________________
+void AliAnalysisNetParticleMoments::Fill(Int_t bin, Int_t subSample, Int_t nPlus, Int_t nMinus) {
+  // -- Add one event
+
+  if (bin < 0 || bin >= fNBins || subSample < 0 || subSample >= fNSubSamples)
+    return;
+
+  if (fRedFact.GetSize() != 2*(fOrder+1))
+    fRedFact.Set(2*(fOrder+1));
+
+  // -- Reduced factorials - idx 0 = 1
+  Double_t *redFact = fRedFact.GetArray();
+  redFact[0] = 1.;
+  redFact[1] = 1.;
+  for (Int_t idxOrder = 1; idxOrder <= fOrder; ++idxOrder) {
+    redFact[2*idxOrder]   = redFact[2*(idxOrder-1)]   * Double_t(nMinus-(idxOrder-1));
+    redFact[2*idxOrder+1] = redFact[2*(idxOrder-1)+1] * Double_t(nPlus-(idxOrder-1));
+  }
+
+  Double_t *cell = fSums.GetArray() + GetCellIdx(bin, subSample);
+
+  // -- f_ik : ii -> particle, kk -> anti-particle ; f_00 = N events
+  for (Int_t ii = 0; ii <= fOrder; ++ii)
+    for (Int_t kk = 0; kk <= fOrder; ++kk)
+      cell[ii*(fOrder+1)+kk] += redFact[2*ii+1] * redFact[2*kk];
+
+  // -- (N+ - N-)^k
+  Double_t *netPow = cell + (fOrder+1)*(fOrder+1);
+  Double_t delta   = 1.;
+  for (Int_t idxOrder = 1; idxOrder <= fOrder; ++idxOrder) {
+    delta *= Double_t(nPlus - nMinus);
+    netPow[idxOrder-1] += delta;
+  }
+}
+
+//________________________________________________________________________
+Long64_t AliAnalysisNetParticleMoments::Merge(TCollection *list) {
+  // -- Merge accumulators with the same binning
+
+  if (!list)
+    return 0;
+
+  TIter next(list);
+  TObject *obj = NULL;
+  while ((obj = next())) {
+    AliAnalysisNetParticleMoments *moments = dynamic_cast<AliAnalysisNetParticleMoments*>(obj);
+    if (!moments || moments == this)
+      continue;
+    if (moments->fNBins != fNBins || moments->fNSubSamples != fNSubSamples || moments->fOrder != fOrder) {
+      AliError(Form("Cannot merge %s : different binning", moments->GetName()));
+      continue;
+    }
+    for (Int_t idx = 0; idx < fSums.GetSize(); ++idx)
+      fSums[idx] += moments->fSums[idx];
+  }
+
+  Double_t nEvents = 0.;
+  for (Int_t bin = 0; bin < fNBins; ++bin)
+    nEvents += GetNEvents(bin);
+  return Long64_t(nEvents);
+}
+
+//________________________________________________________________________
+void AliAnalysisNetParticleMoments::Reset(Option_t */*option*/) {
+  // -- Reset all sums
+
+  fSums.Reset();
+}
+
+/*
+ * ---------------------------------------------------------------------------------
+ *                                    Getter
+ * ---------------------------------------------------------------------------------
+ */
+
+//________________________________________________________________________
+Double_t AliAnalysisNetParticleMoments::GetNEvents(Int_t bin, Int_t subSample) const {
+  // -- N events
+
+  return GetSum(bin, subSample, 0);
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisNetParticleMoments::GetMoment(Int_t bin, Int_t k, Int_t subSample) const {
+  // -- <(N+ - N-)^k>
+
+  Double_t nEvents = GetNEvents(bin, subSample);
+  if (k == 0)
+    return 1.;
+  if (nEvents <= 0. || k < 0 || k > fOrder)
+    return 0.;
+  return GetSum(bin, subSample, (fOrder+1)*(fOrder+1) + k-1) / nEvents;
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisNetParticleMoments::GetFactorialMoment(Int_t bin, Int_t i, Int_t k, Int_t subSample) const {
+  // -- <N+!/(N+-i)! * N-!/(N--k)!>
+
+  Double_t nEvents = GetNEvents(bin, subSample);
+  if (nEvents <= 0. || i < 0 || i > fOrder || k < 0 || k > fOrder)
+    return 0.;
+  return GetSum(bin, subSample, i*(fOrder+1)+k) / nEvents;
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisNetParticleMoments::GetCumulant(Int_t bin, Int_t k, Int_t subSample) const {
+  // -- Cumulant of order k from the raw moments
+  //    kappa_n = m_n - sum_{j=1}^{n-1} (n-1 over j-1) kappa_j m_{n-j}
+
+  if (k < 1 || k > fOrder)
+    return 0.;
+
+  TArrayD kappa(k+1);
+  for (Int_t nn = 1; nn <= k; ++nn) {
+    kappa[nn] = GetMoment(bin, nn, subSample);
+    for (Int_t jj = 1; jj < nn; ++jj)
+      kappa[nn] -= TMath::Binomial(nn-1, jj-1) * kappa[jj] * GetMoment(bin, nn-jj, subSample);
+  }
+  return kappa[k];
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisNetParticleMoments::GetCumulantError(Int_t bin, Int_t k) const {
+  // -- Error of the cumulant : RMS of the subsample cumulants / sqrt(N subsamples)
+
+  Int_t    nSub  = 0;
+  Double_t sum   = 0.;
+  Double_t sum2  = 0.;
+  for (Int_t idxSub = 0; idxSub < fNSubSamples; ++idxSub) {
+    if (GetNEvents(bin, idxSub) <= 0.)
+      continue;
+    Double_t kappa = GetCumulant(bin, k, idxSub);
+    sum  += kappa;
+    sum2 += kappa*kappa;
+    ++nSub;
+  }
+  if (nSub < 2)
+    return 0.;
+
+  Double_t var = (sum2 - sum*sum/nSub) / (nSub-1);
+  return (var > 0.) ? TMath::Sqrt(var/nSub) : 0.;
+}
+
+/*
+ * ---------------------------------------------------------------------------------
+ *                            Helper Methods - private
+ * ---------------------------------------------------------------------------------
+ */
+
+//________________________________________________________________________
+Double_t AliAnalysisNetParticleMoments::GetSum(Int_t bin, Int_t subSample, Int_t entry) const {
+  // -- Sum of one entry of the cell over one or all subsamples
+
+  if (bin < 0 || bin >= fNBins || subSample >= fNSubSamples)
+    return 0.;
+
+  if (subSample >= 0)
+    return fSums[GetCellIdx(bin, subSample) + entry];
+
+  Double_t sum = 0.;
+  for (Int_t idxSub = 0; idxSub < fNSubSamples; ++idxSub)
+    sum += fSums[GetCellIdx(bin, idxSub) + entry];
+  return sum;
+}
@@ -0,0 +1,107 @@
+//-*- Mode: C++ -*-
+
+#ifndef ALIANALYSISNETPARTICLEMOMENTS_H
+#define ALIANALYSISNETPARTICLEMOMENTS_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/**
+ * Class for NetParticle Distributions
+ * -- Streaming moments accumulator
+ *    Keeps per bin and per subsample the sums of the powers of the net
+ *    number (N+ - N-)^k and of the reduced factorial products
+ *    f_ik = N+!/(N+-i)! * N-!/(N--k)!, k,i up to the given order.
+ *    Cumulants and their subsample errors are computed from the sums,
+ *    without storing the joint multiplicity distributions.
+ *    The total over all subsamples is the sum of the subsamples,
+ *    Merge() is exact.
+ */
+
+#include "TNamed.h"
+#include "TArrayD.h"
+
+class TCollection;
+
+class AliAnalysisNetParticleMoments : public TNamed {
+
+ public:
+
+  AliAnalysisNetParticleMoments();
+  AliAnalysisNetParticleMoments(const Char_t* name, const Char_t* title, Int_t nBins, Int_t nSubSamples = 1, Int_t order = 6);
+  virtual ~AliAnalysisNetParticleMoments() {}
+
+  /*
+   * ---------------------------------------------------------------------------------
+   *                                 Public Methods
+   * ---------------------------------------------------------------------------------
+   */
+
+  /** Add one event with nPlus particles and nMinus anti-particles */
+  void     Fill(Int_t bin, Int_t subSample, Int_t nPlus, Int_t nMinus);
+
+  /** Merge accumulators with the same binning */
+  Long64_t Merge(TCollection *list);
+
+  /** Reset all sums */
+  virtual void Reset(Option_t *option = "");
+
+  /*
+   * ---------------------------------------------------------------------------------
+   *                                 Setter/Getter
+   * ---------------------------------------------------------------------------------
+   *  subSample < 0 : sum over all subsamples
+   */
+
+  Int_t    GetNBins()       const {return fNBins;}
+  Int_t    GetNSubSamples() const {return fNSubSamples;}
+  Int_t    GetOrder()       const {return fOrder;}
+
+  /** N events */
+  Double_t GetNEvents(Int_t bin, Int_t subSample = -1) const;
+
+  /** <(N+ - N-)^k> */
+  Double_t GetMoment(Int_t bin, Int_t k, Int_t subSample = -1) const;
+
+  /** <N+!/(N+-i)! * N-!/(N--k)!> */
+  Double_t GetFactorialMoment(Int_t bin, Int_t i, Int_t k, Int_t subSample = -1) const;
+
+  /** Cumulant of order k of N+ - N- */
+  Double_t GetCumulant(Int_t bin, Int_t k, Int_t subSample = -1) const;
+
+  /** Statistical error of the cumulant from the spread of the subsamples */
+  Double_t GetCumulantError(Int_t bin, Int_t k) const;
+
+  ///////////////////////////////////////////////////////////////////////////////////
+
+ private:
+
+  /*
+   * ---------------------------------------------------------------------------------
+   *                            Helper Methods - private
+   * ---------------------------------------------------------------------------------
+   */
+
+  /** Sum of one entry of the cell over one or all subsamples */
+  Double_t GetSum(Int_t bin, Int_t subSample, Int_t entry) const;
+
+  /** Index of the first entry of one cell */
+  Int_t    GetCellIdx(Int_t bin, Int_t subSample) const {return (bin*fNSubSamples + subSample)*fCellSize;}
+
+  /*
+   * ---------------------------------------------------------------------------------
+   *                             Members - private
+   * ---------------------------------------------------------------------------------
+   */
+
+  Int_t                 fNBins;                 //  N bins (e.g. centrality x pt)
+  Int_t                 fNSubSamples;           //  N subsamples
+  Int_t                 fOrder;                 //  Max order
+  Int_t                 fCellSize;              //  N sums per bin and subsample : (order+1)^2 f_ik + order net powers
+  TArrayD               fSums;                  //  Sums : [bin][subSample][f_ik, (N+ - N-)^k]
+  TArrayD               fRedFact;               //! Reduced factorials of the current event : [order+1][particle]
+
+  ClassDef(AliAnalysisNetParticleMoments, 1);
+};
+
+#endif
@@ -237,7 +237,7 @@ void AliAnalysisTaskNetParticle::UserExec(Option_t *) {
   // -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
   // -- Process Distributions 
   // -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
-  if (fModeDistCreation == 1)
+  if (fModeDistCreation > 0)
     fDist->Process();
 
   // -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
@@ -379,9 +379,10 @@ Int_t AliAnalysisTaskNetParticle::Initialize() {
   // ------------------------------------------------------------------
   // -- Create / Initialize Distribution Determination
   // ------------------------------------------------------------------
-  if (fModeDistCreation == 1) {
+  if (fModeDistCreation > 0) {
     fDist = new AliAnalysisNetParticleDistribution;
     fDist->SetOutList(fOutList);
+    fDist->SetMomentsOnly(fModeDistCreation == 2);
     fDist->Initialize(fHelper, fESDTrackCuts);
   }
 
@@ -447,7 +448,7 @@ Int_t AliAnalysisTaskNetParticle::SetupEvent() {
   if (fModeDCACreation == 1)
     fDCA->SetupEvent();
 
-  if (fModeDistCreation == 1)
+  if (fModeDistCreation > 0)
     fDist->SetupEvent(); 
 
   if (fModeQACreation == 1)
@@ -612,7 +613,7 @@ void AliAnalysisTaskNetParticle::ResetEvent() {
     fMCEvent = NULL;
 
   // -- Reset Dist Creation 
-  if (fModeDistCreation == 1)
+  if (fModeDistCreation > 0)
     fDist->ResetEvent();
 
   return;
@@ -72,6 +72,7 @@
 #pragma link C++ class AliAnalysisNetParticleDistribution+;
 #pragma link C++ class AliAnalysisNetParticleEffCont+;
 #pragma link C++ class AliAnalysisNetParticleHelper+;
+#pragma link C++ class AliAnalysisNetParticleMoments+;
 #pragma link C++ class AliAnalysisTaskNetParticle+;
 
 #pragma link C++ class AliAnalysisTempFluc+;
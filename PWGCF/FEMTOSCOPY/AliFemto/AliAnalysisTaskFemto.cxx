@@ -21,6 +21,7 @@
 #include "AliGenEventHeader.h"
 #include "AliGenHijingEventHeader.h"
 #include "AliGenCocktailEventHeader.h"
+#include "AliTaskCostMonitor.h"
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -59,7 +60,9 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto(TString name,
   f1DcorrectionsProtonsMinus(NULL),
   f1DcorrectionsAll(NULL),
   f1DcorrectionsLambdas(NULL),
-  f1DcorrectionsLambdasMinus(NULL)
+  f1DcorrectionsLambdasMinus(NULL),
+  fCostMonitoring(kFALSE),
+  fCostMonitor(NULL)
 {
   // Constructor.
   // Input slot #0 works with an Ntuple
@@ -94,7 +97,9 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto(TString name,
   f1DcorrectionsProtonsMinus(NULL),
   f1DcorrectionsAll(NULL),
   f1DcorrectionsLambdas(NULL),
-  f1DcorrectionsLambdasMinus(NULL)
+  f1DcorrectionsLambdasMinus(NULL),
+  fCostMonitoring(kFALSE),
+  fCostMonitor(NULL)
 {
   // Constructor.
   // Input slot #0 works with an Ntuple
@@ -127,7 +132,9 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto(const AliAnalysisTaskFemto &aFemtoTas
   f1DcorrectionsProtonsMinus(aFemtoTask.f1DcorrectionsProtonsMinus),
   f1DcorrectionsAll(aFemtoTask.f1DcorrectionsAll),
   f1DcorrectionsLambdas(aFemtoTask.f1DcorrectionsLambdas),
-  f1DcorrectionsLambdasMinus(aFemtoTask.f1DcorrectionsLambdasMinus)
+  f1DcorrectionsLambdasMinus(aFemtoTask.f1DcorrectionsLambdasMinus),
+  fCostMonitoring(aFemtoTask.fCostMonitoring),
+  fCostMonitor(NULL)
 {
   // copy constructor
 }
@@ -163,6 +170,7 @@ AliAnalysisTaskFemto &AliAnalysisTaskFemto::operator=(const AliAnalysisTaskFemto
   f1DcorrectionsAll = aFemtoTask.f1DcorrectionsAll;
   f1DcorrectionsLambdas = aFemtoTask.f1DcorrectionsLambdas;
   f1DcorrectionsLambdasMinus = aFemtoTask.f1DcorrectionsLambdasMinus;
+  fCostMonitoring = aFemtoTask.fCostMonitoring;
 
   return *this;
 }
@@ -407,6 +415,12 @@ void AliAnalysisTaskFemto::CreateOutputObjects()
     delete tOL;
   }
 
+  if (fCostMonitoring) {
+    fCostMonitor = new AliTaskCostMonitor(Form("fCostMonitor_%s", GetName()));
+    fCostMonitor->SetOutput(fOutputList);
+    fOutputList->Add(fCostMonitor);
+  }
+
   PostData(0, fOutputList);
 }
 
@@ -414,6 +428,8 @@ void AliAnalysisTaskFemto::CreateOutputObjects()
 void AliAnalysisTaskFemto::Exec(Option_t *)
 {
   // Task making a femtoscopic analysis.
+  AliTaskCostMonitor::Scope costScope(fCostMonitor, AliTaskCostMonitor::kEvent);
+
   if (fOfflineTriggerMask) {
     Bool_t isSelected = (((AliInputEventHandler *)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()))->IsEventSelected() & fOfflineTriggerMask);
     if (!isSelected) {
@@ -606,6 +622,9 @@ void AliAnalysisTaskFemto:: FinishTaskOutput()
   if (fManager) {
     fManager->Finish();
   }
+  if (fCostMonitor) {
+    fCostMonitor->Finish();
+  }
 }
 //________________________________________________________________________
 void AliAnalysisTaskFemto::SetFemtoReaderESD(AliFemtoEventReaderESDChain *aReader)
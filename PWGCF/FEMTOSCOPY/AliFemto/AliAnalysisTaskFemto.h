@@ -56,6 +56,8 @@
 #include "AliAODpidUtil.h"
 #include "AliAODHeader.h"
 
+class AliTaskCostMonitor;
+
 
 class AliAnalysisTaskFemto : public AliAnalysisTaskSE { //AliAnalysisTask
 public:
@@ -91,6 +93,11 @@ public:
   /// Set the femtomanager containing this task's analyses.
   void SetFemtoManager(AliFemtoManager *aManager);
 
+  /// Store the cost counters (time, memory growth, histogram entries) of
+  /// this wagon in the output list, see AliTaskCostMonitor.
+  void SetCostMonitoring(Bool_t yn=kTRUE) { fCostMonitoring = yn; }
+  AliTaskCostMonitor *GetCostMonitor() const { return fCostMonitor; }
+
   void SetFemtoReaderESD(AliFemtoEventReaderESDChain *aReader);
   void SetFemtoReaderESDKine(AliFemtoEventReaderESDChainKine *aReader);
   void SetFemtoReaderAOD(AliFemtoEventReaderAODChain *aReader);
@@ -133,9 +140,11 @@ private:
   TH1D                 *f1DcorrectionsAll; //file with corrections, pT dependant
   TH1D                 *f1DcorrectionsLambdas; //file with corrections, pT dependant
   TH1D                 *f1DcorrectionsLambdasMinus; //file with corrections, pT dependant
+  Bool_t               fCostMonitoring; ///<  Store the cost counters in the output list
+  AliTaskCostMonitor   *fCostMonitor;  //!<! Cost counters of this wagon
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskFemto, 3);
+  ClassDef(AliAnalysisTaskFemto, 4);
   /// \endcond
 };
 
@@ -163,7 +172,9 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto():
   f1DcorrectionsProtonsMinus(NULL),
   f1DcorrectionsAll(NULL),
   f1DcorrectionsLambdas(NULL),
-  f1DcorrectionsLambdasMinus(NULL)
+  f1DcorrectionsLambdasMinus(NULL),
+  fCostMonitoring(kFALSE),
+  fCostMonitor(NULL)
 {
   /* no-op */
 }
@@ -34,6 +34,19 @@ void AliFemtoCorrFctn::AddMixedPair(AliFemtoPair*)
   cout << "Not implemented" << endl;
 }
 
+void AliFemtoCorrFctn::AddRealPairs(AliFemtoPair** pairs, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    AddRealPair(pairs[i]);
+  }
+}
+void AliFemtoCorrFctn::AddMixedPairs(AliFemtoPair** pairs, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; i++) {
+    AddMixedPair(pairs[i]);
+  }
+}
+
 void AliFemtoCorrFctn::AddFirstParticle(AliFemtoParticle*, bool)
 {
   cout << "Not implemented" << endl;
@@ -41,6 +41,12 @@ public:
   /// Not Implemented - Add background pair
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  /// Add a block of signal pairs. Default calls AddRealPair on each pair,
+  /// correlation functions can override this to process the block at once.
+  virtual void AddRealPairs(AliFemtoPair** aPairs, unsigned int aN);
+  /// Add a block of background pairs. Default calls AddMixedPair on each pair.
+  virtual void AddMixedPairs(AliFemtoPair** aPairs, unsigned int aN);
+
   /// Not Implemented - Add pair with optional
   virtual void AddFirstParticle(AliFemtoParticle *particle, bool mixing);
   virtual void AddSecondParticle(AliFemtoParticle *particle);
@@ -52,6 +58,10 @@ public:
 
   virtual TList* GetOutputList() = 0;
 
+  /// Particle content (AliFemtoParticle::EMixingContent) used by
+  /// AddMixedPair, see AliFemtoPairCut::MixingContent
+  virtual unsigned int MixingContent() const { return AliFemtoParticle::kMixAll; }
+
   virtual AliFemtoCorrFctn* Clone() { return 0;}
 
   AliFemtoAnalysis* HbtAnalysis(){return fyAnalysis;};
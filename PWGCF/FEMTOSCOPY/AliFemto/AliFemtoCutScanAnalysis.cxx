@@ -0,0 +1,403 @@
+///
+/// \file AliFemtoCutScanAnalysis.cxx
+///
+
+#include "AliFemtoCutScanAnalysis.h"
+#include "AliFemtoTrackCut.h"
+#include "AliFemtoV0Cut.h"
+#include "AliFemtoKinkCut.h"
+#include "AliFemtoXiTrackCut.h"
+#include "AliFemtoPicoEvent.h"
+
+#include <TObjString.h>
+
+#include <iostream>
+
+#ifdef __ROOT__
+  /// \cond CLASSIMP
+  ClassImp(AliFemtoCutScanAnalysis);
+  /// \endcond
+#endif
+
+//____________________________
+AliFemtoCutScanAnalysis::AliFemtoCutScanAnalysis(UInt_t binsVertex,
+                                                 Double_t minVertex,
+                                                 Double_t maxVertex,
+                                                 UInt_t binsMult,
+                                                 Double_t minMult,
+                                                 Double_t maxMult):
+  AliFemtoVertexMultAnalysis(binsVertex, minVertex, maxVertex,
+                             binsMult, minMult, maxMult),
+  fVariationFirstParticleCut(),
+  fVariationSecondParticleCut(),
+  fVariationPairCut(),
+  fVariationCorrFctn(),
+  fVariationOfCorrFctn(),
+  fVariationPairBlock()
+{
+}
+//____________________________
+AliFemtoCutScanAnalysis::AliFemtoCutScanAnalysis(const AliFemtoCutScanAnalysis& orig):
+  AliFemtoVertexMultAnalysis(orig),
+  fVariationFirstParticleCut(),
+  fVariationSecondParticleCut(),
+  fVariationPairCut(),
+  fVariationCorrFctn(),
+  fVariationOfCorrFctn(),
+  fVariationPairBlock()
+{
+  CopyVariations(orig);
+}
+//____________________________
+AliFemtoCutScanAnalysis& AliFemtoCutScanAnalysis::operator=(const AliFemtoCutScanAnalysis& rhs)
+{
+  if (this == &rhs) {
+    return *this;
+  }
+
+  AliFemtoVertexMultAnalysis::operator=(rhs);
+
+  DeleteVariations();
+  CopyVariations(rhs);
+
+  return *this;
+}
+//____________________________
+AliFemtoCutScanAnalysis::~AliFemtoCutScanAnalysis()
+{
+  DeleteVariations();
+}
+//____________________________
+void AliFemtoCutScanAnalysis::CopyVariations(const AliFemtoCutScanAnalysis& aAna)
+{
+  // Clone the cuts and correlation functions of the variations of aAna
+  for (UInt_t iv = 0; iv < aAna.NumberOfVariations(); iv++) {
+    AliFemtoParticleCut *first = aAna.fVariationFirstParticleCut[iv]->Clone(),
+                        *second = (aAna.fVariationSecondParticleCut[iv] == aAna.fVariationFirstParticleCut[iv])
+                                ? first
+                                : aAna.fVariationSecondParticleCut[iv]->Clone();
+    AliFemtoPairCut *pair = aAna.fVariationPairCut[iv]
+                          ? aAna.fVariationPairCut[iv]->Clone()
+                          : NULL;
+
+    if (!first || !second || (aAna.fVariationPairCut[iv] && !pair)) {
+      cerr << " WARNING [AliFemtoCutScanAnalysis] Could not clone the cuts of variation " << iv << endl;
+    }
+    AddVariation(first, second, pair);
+  }
+
+  for (UInt_t icf = 0; icf < aAna.fVariationCorrFctn.size(); icf++) {
+    AliFemtoCorrFctn *fctn = aAna.fVariationCorrFctn[icf]->Clone();
+    if (fctn) {
+      AddVariationCorrFctn(aAna.fVariationOfCorrFctn[icf], fctn);
+    }
+  }
+}
+//____________________________
+void AliFemtoCutScanAnalysis::DeleteVariations()
+{
+  for (UInt_t iv = 0; iv < NumberOfVariations(); iv++) {
+    if (fVariationSecondParticleCut[iv] != fVariationFirstParticleCut[iv]) {
+      delete fVariationSecondParticleCut[iv];
+    }
+    delete fVariationFirstParticleCut[iv];
+    delete fVariationPairCut[iv];
+  }
+  for (auto &cf : fVariationCorrFctn) {
+    delete cf;
+  }
+
+  fVariationFirstParticleCut.clear();
+  fVariationSecondParticleCut.clear();
+  fVariationPairCut.clear();
+  fVariationCorrFctn.clear();
+  fVariationOfCorrFctn.clear();
+  fVariationPairBlock.clear();
+}
+//____________________________
+Int_t AliFemtoCutScanAnalysis::AddVariation(AliFemtoParticleCut* aFirstParticleCut,
+                                            AliFemtoParticleCut* aSecondParticleCut,
+                                            AliFemtoPairCut* aPairCut)
+{
+  if (!aFirstParticleCut) {
+    cerr << "E-AliFemtoCutScanAnalysis::AddVariation: a first particle cut is required" << endl;
+    return -1;
+  }
+
+  if (NumberOfVariations() >= kMaxVariations) {
+    cerr << "E-AliFemtoCutScanAnalysis::AddVariation: at most "
+         << kMaxVariations << " variations are supported" << endl;
+    return -1;
+  }
+
+  if (!aSecondParticleCut) {
+    aSecondParticleCut = aFirstParticleCut;
+  }
+
+  aFirstParticleCut->SetAnalysis(this);
+  aSecondParticleCut->SetAnalysis(this);
+  if (aPairCut) {
+    aPairCut->SetAnalysis(this);
+  }
+
+  fVariationFirstParticleCut.push_back(aFirstParticleCut);
+  fVariationSecondParticleCut.push_back(aSecondParticleCut);
+  fVariationPairCut.push_back(aPairCut);
+
+  return NumberOfVariations() - 1;
+}
+//____________________________
+void AliFemtoCutScanAnalysis::AddVariationCorrFctn(Int_t aVariation, AliFemtoCorrFctn* aCorrFctn)
+{
+  if (aVariation < 0 || static_cast<UInt_t>(aVariation) >= NumberOfVariations()) {
+    cerr << "E-AliFemtoCutScanAnalysis::AddVariationCorrFctn: no variation " << aVariation << endl;
+    return;
+  }
+
+  fVariationCorrFctn.push_back(aCorrFctn);
+  fVariationOfCorrFctn.push_back(aVariation);
+  aCorrFctn->SetAnalysis(this);
+}
+//____________________________
+ULong64_t AliFemtoCutScanAnalysis::VariationMask(const std::vector<AliFemtoParticleCut*>& aCuts,
+                                                 const AliFemtoParticle* aParticle) const
+{
+  ULong64_t mask = 0;
+
+  for (UInt_t iv = 0; iv < aCuts.size(); iv++) {
+    AliFemtoParticleCut *cut = aCuts[iv];
+    bool pass = false;
+
+    switch (cut->Type()) {
+    case hbtTrack:
+      pass = aParticle->Track() && ((AliFemtoTrackCut*)cut)->Pass(aParticle->Track());
+      break;
+    case hbtV0:
+      pass = aParticle->V0() && ((AliFemtoV0Cut*)cut)->Pass(aParticle->V0());
+      break;
+    case hbtXi:
+      pass = aParticle->Xi() && ((AliFemtoXiTrackCut*)cut)->Pass(aParticle->Xi());
+      break;
+    case hbtKink:
+      pass = aParticle->Kink() && ((AliFemtoKinkCut*)cut)->Pass(aParticle->Kink());
+      break;
+    default:
+      break;
+    }
+
+    if (pass) {
+      mask |= (1ULL << iv);
+    }
+  }
+
+  return mask;
+}
+//____________________________
+void AliFemtoCutScanAnalysis::ParticleCollectionsFilled()
+{
+  // Each particle is tested once against all the variations, the mask
+  // stays with the particle in the mixing buffer
+  for (auto particle : *fPicoEvent->FirstParticleCollection()) {
+    particle->SetVariationMask(VariationMask(fVariationFirstParticleCut, particle));
+  }
+
+  if (!AnalyzeIdenticalParticles()) {
+    for (auto particle : *fPicoEvent->SecondParticleCollection()) {
+      particle->SetVariationMask(VariationMask(fVariationSecondParticleCut, particle));
+    }
+  }
+}
+//____________________________
+void AliFemtoCutScanAnalysis::FlushPairBlock(bool isReal, UInt_t n)
+{
+  AliFemtoVertexMultAnalysis::FlushPairBlock(isReal, n);
+
+  if (n == 0 || fVariationCorrFctn.empty()) {
+    return;
+  }
+
+  const UInt_t nvar = NumberOfVariations();
+  fVariationPairBlock.resize(nvar);
+  for (auto &block : fVariationPairBlock) {
+    block.clear();
+  }
+
+  // Track1 of a pair always comes from a first particle collection and
+  // Track2 from a second one (or both from the first for identical
+  // particles), so the masks combine the right particle cuts
+  for (UInt_t ip = 0; ip < n; ip++) {
+    AliFemtoPair *pair = fPairBlock[ip];
+    ULong64_t mask = pair->Track1()->VariationMask()
+                   & pair->Track2()->VariationMask();
+
+    for (UInt_t iv = 0; mask && iv < nvar; iv++, mask >>= 1) {
+      if (!(mask & 1ULL)) {
+        continue;
+      }
+      if (fVariationPairCut[iv] && !fVariationPairCut[iv]->Pass(pair)) {
+        continue;
+      }
+      fVariationPairBlock[iv].push_back(pair);
+    }
+  }
+
+  for (UInt_t icf = 0; icf < fVariationCorrFctn.size(); icf++) {
+    std::vector<AliFemtoPair*> &block = fVariationPairBlock[fVariationOfCorrFctn[icf]];
+    if (block.empty()) {
+      continue;
+    }
+    if (isReal) {
+      fVariationCorrFctn[icf]->AddRealPairs(&block[0], block.size());
+    } else {
+      fVariationCorrFctn[icf]->AddMixedPairs(&block[0], block.size());
+    }
+  }
+}
+//____________________________
+unsigned int AliFemtoCutScanAnalysis::MixingContent() const
+{
+  unsigned int content = AliFemtoVertexMultAnalysis::MixingContent();
+
+  for (auto &cut : fVariationPairCut) {
+    if (cut) {
+      content |= cut->MixingContent();
+    }
+  }
+  for (auto &cf : fVariationCorrFctn) {
+    content |= cf->MixingContent();
+  }
+
+  return content;
+}
+//____________________________
+void AliFemtoCutScanAnalysis::EventBegin(const AliFemtoEvent* ev)
+{
+  AliFemtoVertexMultAnalysis::EventBegin(ev);
+
+  for (UInt_t iv = 0; iv < NumberOfVariations(); iv++) {
+    fVariationFirstParticleCut[iv]->EventBegin(ev);
+    if (fVariationSecondParticleCut[iv] != fVariationFirstParticleCut[iv]) {
+      fVariationSecondParticleCut[iv]->EventBegin(ev);
+    }
+    if (fVariationPairCut[iv]) {
+      fVariationPairCut[iv]->EventBegin(ev);
+    }
+  }
+  for (auto &cf : fVariationCorrFctn) {
+    cf->EventBegin(ev);
+  }
+}
+//____________________________
+void AliFemtoCutScanAnalysis::EventEnd(const AliFemtoEvent* ev)
+{
+  AliFemtoVertexMultAnalysis::EventEnd(ev);
+
+  for (UInt_t iv = 0; iv < NumberOfVariations(); iv++) {
+    fVariationFirstParticleCut[iv]->EventEnd(ev);
+    if (fVariationSecondParticleCut[iv] != fVariationFirstParticleCut[iv]) {
+      fVariationSecondParticleCut[iv]->EventEnd(ev);
+    }
+    if (fVariationPairCut[iv]) {
+      fVariationPairCut[iv]->EventEnd(ev);
+    }
+  }
+  for (auto &cf : fVariationCorrFctn) {
+    cf->EventEnd(ev);
+  }
+}
+//____________________________
+void AliFemtoCutScanAnalysis::Finish()
+{
+  AliFemtoVertexMultAnalysis::Finish();
+
+  for (auto &cf : fVariationCorrFctn) {
+    cf->Finish();
+  }
+}
+//____________________________
+AliFemtoString AliFemtoCutScanAnalysis::Report()
+{
+  TString report("-----------\nHbt AliFemtoCutScanAnalysis Report:\n");
+
+  report += TString::Format("Number of cut variations: %u\n", NumberOfVariations());
+
+  for (UInt_t iv = 0; iv < NumberOfVariations(); iv++) {
+    report += TString::Format("Variation %u - First Particle:\n", iv)
+            + fVariationFirstParticleCut[iv]->Report() + "\n";
+    if (fVariationSecondParticleCut[iv] != fVariationFirstParticleCut[iv]) {
+      report += TString::Format("Variation %u - Second Particle:\n", iv)
+              + fVariationSecondParticleCut[iv]->Report() + "\n";
+    }
+    if (fVariationPairCut[iv]) {
+      report += TString::Format("Variation %u - Pair Cut:\n", iv)
+              + fVariationPairCut[iv]->Report() + "\n";
+    }
+  }
+
+  for (UInt_t icf = 0; icf < fVariationCorrFctn.size(); icf++) {
+    report += TString::Format("Variation %d - Correlation Function:\n", fVariationOfCorrFctn[icf])
+            + fVariationCorrFctn[icf]->Report() + "\n";
+  }
+
+  report += "Now adding AliFemtoVertexMultAnalysis(base) Report\n"
+          + AliFemtoVertexMultAnalysis::Report();
+
+  return AliFemtoString((const char *)report);
+}
+//____________________________
+TList* AliFemtoCutScanAnalysis::ListSettings()
+{
+  TList *settings = AliFemtoVertexMultAnalysis::ListSettings();
+
+  settings->Add(new TObjString(
+    TString::Format("AliFemtoCutScanAnalysis.variations=%u", NumberOfVariations())
+  ));
+
+  for (UInt_t iv = 0; iv < NumberOfVariations(); iv++) {
+    const TString prefix = TString::Format("AliFemtoCutScanAnalysis.variation_%u.", iv);
+
+    AliFemtoParticleCut *cuts[2] = { fVariationFirstParticleCut[iv],
+                                     fVariationSecondParticleCut[iv] != fVariationFirstParticleCut[iv]
+                                       ? fVariationSecondParticleCut[iv]
+                                       : NULL };
+    for (int icut = 0; icut < 2; icut++) {
+      TList *cut_settings = cuts[icut] ? cuts[icut]->ListSettings() : NULL;
+      if (cut_settings == NULL) {
+        continue;
+      }
+      TListIter next_setting(cut_settings);
+      while (TObject *obj = next_setting()) {
+        settings->Add(new TObjString(prefix + obj->GetName()));
+      }
+      delete cut_settings;
+    }
+
+    TList *pair_cut_settings = fVariationPairCut[iv] ? fVariationPairCut[iv]->ListSettings() : NULL;
+    if (pair_cut_settings != NULL) {
+      TListIter next_setting(pair_cut_settings);
+      while (TObject *obj = next_setting()) {
+        settings->Add(new TObjString(prefix + obj->GetName()));
+      }
+      delete pair_cut_settings;
+    }
+  }
+
+  return settings;
+}
+//____________________________
+TList* AliFemtoCutScanAnalysis::GetOutputList()
+{
+  TList *tOutputList = AliFemtoVertexMultAnalysis::GetOutputList();
+
+  for (auto &cf : fVariationCorrFctn) {
+    TList *tListCf = cf->GetOutputList();
+
+    TIter nextListCf(tListCf);
+    while (TObject *obj = nextListCf()) {
+      tOutputList->Add(obj);
+    }
+    delete tListCf;
+  }
+
+  return tOutputList;
+}
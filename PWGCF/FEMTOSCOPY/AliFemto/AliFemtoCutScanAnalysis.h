@@ -0,0 +1,142 @@
+///
+/// \file AliFemtoCutScanAnalysis.h
+///
+
+#ifndef ALIFEMTOCUTSCANANALYSIS_H
+#define ALIFEMTOCUTSCANANALYSIS_H
+
+#include "AliFemtoVertexMultAnalysis.h"
+
+#include <vector>
+
+/// \class AliFemtoCutScanAnalysis
+/// \brief Vertex and multiplicity mixing analysis running a set of cut
+///        variations on the same events
+///
+/// Systematic studies run the same analysis with slightly different track
+/// and pair cuts. Instead of adding one AliFemtoVertexMultAnalysis per
+/// variation to the AliFemtoManager, each reading, copying and mixing the
+/// same events, one scan analysis holds them all:
+///
+/// - the cuts set with SetFirstParticleCut, SetSecondParticleCut and
+///   SetPairCut are the base configuration. They fill the pico event and
+///   the mixing buffer, and must be looser than (or equal to) all the
+///   variations. The correlation functions added with AddCorrFctn get all
+///   the pairs passing the base cuts.
+///
+/// - each variation added with AddVariation has its own particle cuts, an
+///   optional pair cut and its own correlation functions (AddVariationCorrFctn).
+///
+/// Each particle passing the base cut is tested once against the particle
+/// cuts of all the variations, the result is kept in the particle as a bit
+/// mask (AliFemtoParticle::VariationMask), also for the events in the
+/// mixing buffer. Each pair passing the base pair cut is then handed to the
+/// variations present in both masks which accept it with their pair cut.
+///
+/// The cut monitors of the variation cuts are not filled, and the names of
+/// the output objects of the variation correlation functions have to be
+/// made unique by the user. At most kMaxVariations variations can be added.
+///
+class AliFemtoCutScanAnalysis : public AliFemtoVertexMultAnalysis {
+public:
+  enum { kMaxVariations = 64 };
+
+  AliFemtoCutScanAnalysis(UInt_t binsVertex=10,
+                          Double_t minVertex=-100.0,
+                          Double_t maxVertex=+100.0,
+                          UInt_t binsMult=10,
+                          Double_t minMult=-1.0e9,
+                          Double_t maxMult=+1.0e9);
+
+  /// Copy the base configuration and clone the cuts and correlation
+  /// functions of all the variations
+  AliFemtoCutScanAnalysis(const AliFemtoCutScanAnalysis& TheOriginalAnalysis);
+  AliFemtoCutScanAnalysis& operator=(const AliFemtoCutScanAnalysis& TheOriginalAnalysis);
+
+  /// Deletes the cuts and correlation functions of the variations
+  virtual ~AliFemtoCutScanAnalysis();
+
+  /// Add a cut variation and return its index, or -1 if kMaxVariations
+  /// variations are already defined.
+  ///
+  /// The analysis takes ownership of the cuts. For identical particles
+  /// (same base first and second particle cut) the second cut of the
+  /// variation is ignored. A NULL second cut means the same as the first,
+  /// a NULL pair cut accepts all pairs passing the base pair cut.
+  Int_t AddVariation(AliFemtoParticleCut* aFirstParticleCut,
+                     AliFemtoParticleCut* aSecondParticleCut=NULL,
+                     AliFemtoPairCut* aPairCut=NULL);
+
+  /// Add a correlation function filled with the pairs of a variation
+  void AddVariationCorrFctn(Int_t aVariation, AliFemtoCorrFctn* aCorrFctn);
+
+  UInt_t NumberOfVariations() const;
+  AliFemtoParticleCut* VariationFirstParticleCut(Int_t aVariation) const;
+  AliFemtoParticleCut* VariationSecondParticleCut(Int_t aVariation) const;
+  AliFemtoPairCut* VariationPairCut(Int_t aVariation) const;
+
+  virtual void EventBegin(const AliFemtoEvent* TheEventToBegin);
+  virtual void EventEnd(const AliFemtoEvent* TheEventToWrapUp);
+  virtual void Finish();
+
+  virtual AliFemtoString Report();
+  virtual TList* ListSettings();
+  virtual TList* GetOutputList();
+
+protected:
+
+  /// Fill the variation masks of the particles of fPicoEvent
+  virtual void ParticleCollectionsFilled();
+
+  /// Hand the pairs to the base correlation functions, then to the
+  /// correlation functions of the variations accepting them
+  virtual void FlushPairBlock(bool isReal, UInt_t n);
+
+  /// Particle content used by the base and the variation pair cuts and
+  /// correlation functions
+  virtual unsigned int MixingContent() const;
+
+  /// Bit mask of the given particle cuts passed by the particle
+  ULong64_t VariationMask(const std::vector<AliFemtoParticleCut*>& aCuts,
+                          const AliFemtoParticle* aParticle) const;
+
+  void CopyVariations(const AliFemtoCutScanAnalysis& aAna);
+  void DeleteVariations();
+
+  std::vector<AliFemtoParticleCut*> fVariationFirstParticleCut;   ///< first particle cut of each variation
+  std::vector<AliFemtoParticleCut*> fVariationSecondParticleCut;  ///< second particle cut of each variation
+  std::vector<AliFemtoPairCut*> fVariationPairCut;                ///< pair cut of each variation, may be NULL
+  std::vector<AliFemtoCorrFctn*> fVariationCorrFctn;              ///< correlation functions of all the variations
+  std::vector<Int_t> fVariationOfCorrFctn;                        ///< variation of each entry of fVariationCorrFctn
+
+  std::vector< std::vector<AliFemtoPair*> > fVariationPairBlock;  //!<! pairs of the current block accepted by each variation
+
+#ifdef __ROOT__
+  /// \cond CLASSIMP
+  ClassDef(AliFemtoCutScanAnalysis, 1);
+  /// \endcond
+#endif
+
+};
+
+inline UInt_t AliFemtoCutScanAnalysis::NumberOfVariations() const
+{
+  return fVariationFirstParticleCut.size();
+}
+
+inline AliFemtoParticleCut* AliFemtoCutScanAnalysis::VariationFirstParticleCut(Int_t aVariation) const
+{
+  return fVariationFirstParticleCut.at(aVariation);
+}
+
+inline AliFemtoParticleCut* AliFemtoCutScanAnalysis::VariationSecondParticleCut(Int_t aVariation) const
+{
+  return fVariationSecondParticleCut.at(aVariation);
+}
+
+inline AliFemtoPairCut* AliFemtoCutScanAnalysis::VariationPairCut(Int_t aVariation) const
+{
+  return fVariationPairCut.at(aVariation);
+}
+
+#endif
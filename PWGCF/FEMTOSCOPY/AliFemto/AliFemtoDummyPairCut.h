@@ -84,6 +84,7 @@ public:
   virtual bool Pass(const AliFemtoPair*);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
+  virtual unsigned int MixingContent() const { return AliFemtoParticle::kMixMomentum; }
   AliFemtoDummyPairCut* Clone();
 
 private:
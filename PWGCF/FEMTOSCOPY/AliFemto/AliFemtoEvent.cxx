@@ -55,6 +55,7 @@ AliFemtoEvent::AliFemtoEvent():
   fV0Collection(NULL),
   fXiCollection(NULL),
   fKinkCollection(NULL),
+  fOwnsTracks(true),
   fZDCN1Energy(0.0f),
   fZDCP1Energy(0.0f),
   fZDCN2Energy(0.0f),
@@ -106,6 +107,7 @@ AliFemtoEvent::AliFemtoEvent(const AliFemtoEvent& ev, AliFemtoTrackCut* tCut, Al
   fV0Collection(NULL),
   fXiCollection(NULL),
   fKinkCollection(NULL),
+  fOwnsTracks(true),
   fZDCN1Energy(ev.fZDCN1Energy),
   fZDCP1Energy(ev.fZDCP1Energy),
   fZDCN2Energy(ev.fZDCN2Energy),
@@ -187,6 +189,7 @@ AliFemtoEvent::AliFemtoEvent(const AliFemtoEvent& ev):
   fV0Collection(NULL),
   fXiCollection(NULL),
   fKinkCollection(NULL),
+  fOwnsTracks(true),
   fZDCN1Energy(ev.fZDCN1Energy),
   fZDCP1Energy(ev.fZDCP1Energy),
   fZDCN2Energy(ev.fZDCN2Energy),
@@ -275,8 +278,10 @@ AliFemtoEvent& AliFemtoEvent::operator=(const AliFemtoEvent& aEvent)
   fEP = aEvent.fEP;
 
   if (fTrackCollection) {
-    for (AliFemtoTrackIterator iter=fTrackCollection->begin();iter!=fTrackCollection->end();iter++){
-      delete *iter;
+    if (fOwnsTracks) {
+      for (AliFemtoTrackIterator iter=fTrackCollection->begin();iter!=fTrackCollection->end();iter++){
+        delete *iter;
+      }
     }
     fTrackCollection->clear();
   } else {
@@ -315,6 +320,7 @@ AliFemtoEvent& AliFemtoEvent::operator=(const AliFemtoEvent& aEvent)
     AliFemtoTrack* trackCopy = new AliFemtoTrack(**tIter);
     fTrackCollection->push_back(trackCopy);
   }
+  fOwnsTracks = true;
   // copy v0 collection
   for ( AliFemtoV0Iterator vIter=aEvent.fV0Collection->begin(); vIter!=aEvent.fV0Collection->end(); vIter++) {
     AliFemtoV0* v0Copy = new AliFemtoV0(**vIter);
@@ -340,8 +346,10 @@ AliFemtoEvent::~AliFemtoEvent(){
 #ifdef STHBTDEBUG
   cout << " AliFemtoEvent::~AliFemtoEvent() " << endl;
 #endif
-  for (AliFemtoTrackIterator iter=fTrackCollection->begin();iter!=fTrackCollection->end();iter++){
-    delete *iter;
+  if (fOwnsTracks) {
+    for (AliFemtoTrackIterator iter=fTrackCollection->begin();iter!=fTrackCollection->end();iter++){
+      delete *iter;
+    }
   }
   fTrackCollection->clear();
   delete fTrackCollection;
@@ -410,6 +418,8 @@ AliFemtoV0Collection* AliFemtoEvent::V0Collection() const {return fV0Collection;
 AliFemtoXiCollection* AliFemtoEvent::XiCollection() const {return fXiCollection;}
 AliFemtoKinkCollection* AliFemtoEvent::KinkCollection() const {return fKinkCollection;}
 AliFemtoTrackCollection* AliFemtoEvent::TrackCollection() const {return fTrackCollection;}
+bool AliFemtoEvent::OwnsTracks() const {return fOwnsTracks;}
+void AliFemtoEvent::SetOwnsTracks(bool aOwns) {fOwnsTracks = aOwns;}
 AliFemtoThreeVector AliFemtoEvent::PrimVertPos() const {return fPrimVertPos;}
 const double* AliFemtoEvent::PrimVertCov() const {return fPrimVertCov;}
 double AliFemtoEvent::MagneticField() const {return fMagneticField;}
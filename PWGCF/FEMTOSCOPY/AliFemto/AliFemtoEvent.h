@@ -39,6 +39,10 @@ public:
   AliFemtoXiCollection* XiCollection() const;
   AliFemtoKinkCollection* KinkCollection() const;
   AliFemtoTrackCollection* TrackCollection() const;
+  /// If false the tracks belong to the event reader (pooled tracks) and are
+  /// not deleted with the event. Copies of the event always own their tracks.
+  bool OwnsTracks() const;
+  void SetOwnsTracks(bool aOwns);
   double MagneticField() const;
   bool IsCollisionCandidate() const;
 
@@ -158,6 +162,7 @@ private:
   AliFemtoV0Collection*    fV0Collection;    ///< collection of V0s
   AliFemtoXiCollection*    fXiCollection;    ///< collection of Xis
   AliFemtoKinkCollection*  fKinkCollection;  ///< collection of kinks
+  bool fOwnsTracks;                          ///< delete the tracks with the event
 
   //for alice changed by Marek Chojnacki
   float        fZDCN1Energy;      ///< reconstructed energy in the neutron ZDC
@@ -19,6 +19,8 @@
 #include "SystemOfUnits.h"
 
 #include "AliFemtoEvent.h"
+#include "AliFemtoTrackCut.h"
+#include "AliFemtoV0Cut.h"
 #include "AliFemtoModelHiddenInfo.h"
 #include "AliFemtoModelGlobalHiddenInfo.h"
 #include "AliPID.h"
@@ -94,7 +96,12 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD():
   fIsKaonAnalysis(kFALSE),
   fIsProtonAnalysis(kFALSE),
   fIsPionAnalysis(kFALSE),
-  fIsElectronAnalysis(kFALSE)
+  fIsElectronAnalysis(kFALSE),
+  fTrackPreselection(),
+  fV0Preselection(),
+  fUseTrackPool(kFALSE),
+  fTrackPool(),
+  fTrackPoolUsed(0)
 {
   // default constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -148,8 +155,12 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD(const AliFemtoEventReaderAOD &aRe
   fIsKaonAnalysis(aReader.fIsKaonAnalysis),
   fIsProtonAnalysis(aReader.fIsProtonAnalysis),
   fIsPionAnalysis(aReader.fIsPionAnalysis),
-  fIsElectronAnalysis(aReader.fIsElectronAnalysis)
-
+  fIsElectronAnalysis(aReader.fIsElectronAnalysis),
+  fTrackPreselection(aReader.fTrackPreselection),
+  fV0Preselection(aReader.fV0Preselection),
+  fUseTrackPool(aReader.fUseTrackPool),
+  fTrackPool(),
+  fTrackPoolUsed(0)
 {
   // copy constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -166,6 +177,9 @@ AliFemtoEventReaderAOD::~AliFemtoEventReaderAOD()
   delete fTree;
   delete fEvent;
   delete fAodFile;
+  for (size_t i = 0; i < fTrackPool.size(); i++) {
+    delete fTrackPool[i];
+  }
 //   if (fPWG2AODTracks) {
 //     fPWG2AODTracks->Delete();
 //     delete fPWG2AODTracks;
@@ -223,6 +237,9 @@ AliFemtoEventReaderAOD &AliFemtoEventReaderAOD::operator=(const AliFemtoEventRea
   fIsProtonAnalysis = aReader.fIsProtonAnalysis;
   fIsPionAnalysis = aReader.fIsPionAnalysis;
   fIsElectronAnalysis = aReader.fIsElectronAnalysis;
+  fTrackPreselection = aReader.fTrackPreselection;
+  fV0Preselection = aReader.fV0Preselection;
+  fUseTrackPool = aReader.fUseTrackPool;
 
   return *this;
 }
@@ -301,6 +318,10 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
 
   AliFemtoEvent *tEvent = new AliFemtoEvent();
 
+  // the tracks of the previous event can be reused
+  fTrackPoolUsed = 0;
+  tEvent->SetOwnsTracks(!fUseTrackPool);
+
   // setting global event characteristics
   tEvent->SetRunNumber(fEvent->GetRunNumber());
   tEvent->SetMagneticField(fEvent->GetMagneticField()*kilogauss);//to check if here is ok
@@ -531,7 +552,12 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
    
     tEvent->SetNormalizedMult(norm_mult);
 
-    
+    // quick cuts of the analyses before the (expensive) conversion,
+    // after the track has been counted in the multiplicity
+    if (!PassTrackPreselection(aodtrack)) {
+      continue;
+    }
+
     AliFemtoTrack *trackCopy = CopyAODtoFemtoTrack(aodtrack);
    
     trackCopy->SetMultiplicity(norm_mult);
@@ -714,7 +740,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
       }
       else {
 	// cout<<"bad track : AOD REader pdg cod"<<pdg<<" ptrue "<<ptrue<<endl;
-	delete  trackCopy;
+	DeleteFemtoTrack(trackCopy);
       }
       //Special MC analysis for pi,K,p,e slected by PDG code <--
     }
@@ -755,6 +781,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
       if (aodv0->GetCharge() != 0) continue;
       if (aodv0->ChargeProng(0) == aodv0->ChargeProng(1)) continue;
       if (aodv0->CosPointingAngle(fV1) < 0.98) continue;
+      if (!PassV0Preselection(aodv0)) continue;
 
       AliAODTrack *daughterTrackPos = (AliAODTrack *)aodv0->GetDaughter(0),   // getting positive daughter track
                   *daughterTrackNeg = (AliAODTrack *)aodv0->GetDaughter(1);   // getting negative daughter track
@@ -958,7 +985,7 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrac
 {
   // Copy the track information from the AOD into the internal AliFemtoTrack
   // If it exists, use the additional information from the PWG2 AOD
-  AliFemtoTrack *tFemtoTrack = new AliFemtoTrack();
+  AliFemtoTrack *tFemtoTrack = NewFemtoTrack();
 
   // Primary Vertex position
 
@@ -2132,3 +2159,75 @@ void AliFemtoEventReaderAOD::SetElectronAnalysis(Bool_t aSetElectronAna)
   fIsElectronAnalysis = aSetElectronAna;
 }
 //Special MC analysis for pi,K,p,e selected by PDG code <--
+
+void AliFemtoEventReaderAOD::AddTrackPreselection(AliFemtoTrackCut *aCut)
+{
+  if (aCut) fTrackPreselection.push_back(aCut);
+}
+
+void AliFemtoEventReaderAOD::AddV0Preselection(AliFemtoV0Cut *aCut)
+{
+  if (aCut) fV0Preselection.push_back(aCut);
+}
+
+void AliFemtoEventReaderAOD::SetUseTrackPool(Bool_t aUse)
+{
+  fUseTrackPool = aUse;
+}
+
+bool AliFemtoEventReaderAOD::PassTrackPreselection(const AliAODTrack *tAodTrack) const
+{
+  // A track is kept if any of the analyses may use it
+  if (fTrackPreselection.empty()) return true;
+
+  const float pt = tAodTrack->Pt(),
+              eta = tAodTrack->Eta();
+  const int charge = tAodTrack->Charge();
+
+  for (size_t i = 0; i < fTrackPreselection.size(); i++) {
+    if (fTrackPreselection[i]->PassPreselection(pt, eta, charge)) return true;
+  }
+  return false;
+}
+
+bool AliFemtoEventReaderAOD::PassV0Preselection(const AliAODv0 *tAODv0) const
+{
+  // A V0 is kept if any of the analyses may use it
+  if (fV0Preselection.empty()) return true;
+
+  const float pt = tAODv0->Pt(),
+              eta = tAODv0->Eta();
+
+  for (size_t i = 0; i < fV0Preselection.size(); i++) {
+    if (fV0Preselection[i]->PassPreselection(pt, eta)) return true;
+  }
+  return false;
+}
+
+AliFemtoTrack *AliFemtoEventReaderAOD::NewFemtoTrack()
+{
+  if (!fUseTrackPool) return new AliFemtoTrack();
+
+  if (fTrackPoolUsed == fTrackPool.size()) {
+    fTrackPool.push_back(new AliFemtoTrack());
+    return fTrackPool[fTrackPoolUsed++];
+  }
+
+  // reset the pooled track, keeps the memory of its cluster maps
+  AliFemtoTrack *track = fTrackPool[fTrackPoolUsed++];
+  *track = AliFemtoTrack();
+  return track;
+}
+
+void AliFemtoEventReaderAOD::DeleteFemtoTrack(AliFemtoTrack *tFemtoTrack)
+{
+  if (!fUseTrackPool) {
+    delete tFemtoTrack;
+    return;
+  }
+
+  // pooled tracks stay owned by the pool, the last one taken can be reused
+  if (fTrackPoolUsed > 0 && fTrackPool[fTrackPoolUsed - 1] == tFemtoTrack) {
+    fTrackPoolUsed--;
+  }
+}
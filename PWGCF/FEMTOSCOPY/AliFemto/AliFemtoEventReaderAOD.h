@@ -19,6 +19,7 @@
 #include "TBits.h"
 #include "AliAODEvent.h"
 #include <list>
+#include <vector>
 //#include "AliPWG2AODTrack.h"
 #include "AliAODMCParticle.h"
 #include "AliFemtoV0.h"
@@ -29,6 +30,8 @@
 
 class AliFemtoEvent;
 class AliFemtoTrack;
+class AliFemtoTrackCut;
+class AliFemtoV0Cut;
 
 class AliFemtoEventReaderAOD : public AliFemtoEventReader {
 public:
@@ -98,6 +101,17 @@ public:
   void SetProtonAnalysis(Bool_t aSetProtonAna);
   void SetElectronAnalysis(Bool_t aSetElectronAna);
   //Special MC analysis for pi,K,p,e slected by PDG code <--
+
+  /// Add the cut of an analysis to the preselection. AOD tracks failing
+  /// AliFemtoTrackCut::PassPreselection of all added cuts are not converted
+  /// into AliFemtoTracks. The cut is not owned by the reader.
+  void AddTrackPreselection(AliFemtoTrackCut *aCut);
+  /// As AddTrackPreselection, for the V0s (AliFemtoV0Cut::PassPreselection)
+  void AddV0Preselection(AliFemtoV0Cut *aCut);
+  /// Reuse the AliFemtoTrack objects of the previous event instead of
+  /// allocating new ones. The returned event does not own its tracks and has
+  /// to be deleted before the next event is read, as done by AliFemtoManager.
+  void SetUseTrackPool(Bool_t aUse);
   
 protected:
   virtual AliFemtoEvent *CopyAODtoFemtoEvent();
@@ -108,6 +122,11 @@ protected:
   virtual AliFemtoXi *CopyAODtoFemtoXi(AliAODcascade *tAODxi);
   virtual void CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
 
+  bool PassTrackPreselection(const AliAODTrack *tAodTrack) const;
+  bool PassV0Preselection(const AliAODv0 *tAODv0) const;
+  AliFemtoTrack *NewFemtoTrack();                 ///< new or pooled track, reset to the default values
+  void DeleteFemtoTrack(AliFemtoTrack *tFemtoTrack); ///< delete or give back a track from NewFemtoTrack
+
   int            fNumberofEvent;    ///< number of Events in AOD file
   int            fCurEvent;         ///< number of current event
   AliAODEvent   *fEvent;            ///< AOD event
@@ -164,10 +183,16 @@ private:
   Bool_t fIsElectronAnalysis; // e+e- are taken (for gamma cut tuning)
   //Special MC analysis for pi,K,p,e slected by PDG code <--
 
+  std::vector<AliFemtoTrackCut*> fTrackPreselection; //!<! cuts of the track preselection, not owned
+  std::vector<AliFemtoV0Cut*> fV0Preselection;       //!<! cuts of the V0 preselection, not owned
+  Bool_t fUseTrackPool;                              ///< reuse the tracks of the previous event
+  std::vector<AliFemtoTrack*> fTrackPool;            //!<! pooled tracks, owned
+  UInt_t fTrackPoolUsed;                             //!<! pooled tracks given to the current event
+
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoEventReaderAOD, 12);
+  ClassDef(AliFemtoEventReaderAOD, 13);
   /// \endcond
 #endif
 
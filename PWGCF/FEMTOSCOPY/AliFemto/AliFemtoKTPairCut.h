@@ -46,6 +46,10 @@ public:
   virtual bool Pass(const AliFemtoPair* pair);
   virtual bool Pass(const AliFemtoPair* pair, double aRPAngle);
 
+  /// The tracks are only needed for the single-particle pT range
+  virtual unsigned int MixingContent() const
+    { return (fPtMin > 0.0 || fPtMax < 1000.0) ? AliFemtoParticle::kMixTrack : AliFemtoParticle::kMixMomentum; }
+
  protected:
   Double_t fKTMin;          // Minimum allowed pair transverse momentum
   Double_t fKTMax;          // Maximum allowed pair transverse momentum 
@@ -234,6 +234,21 @@ AliFemtoString AliFemtoModelCorrFctn::Report()
   return tStr;
 }
 
+//_______________________
+void AliFemtoModelCorrFctn::AddRealPairs(AliFemtoPair** aPairs, unsigned int aN)
+{
+  // Let the manager compute the weights of the block at once (if switched on)
+  if (fManager) fManager->PrepareWeights(aPairs, aN);
+  AliFemtoCorrFctn::AddRealPairs(aPairs, aN);
+  if (fManager) fManager->ClearWeights();
+}
+//_______________________
+void AliFemtoModelCorrFctn::AddMixedPairs(AliFemtoPair** aPairs, unsigned int aN)
+{
+  if (fManager) fManager->PrepareWeights(aPairs, aN);
+  AliFemtoCorrFctn::AddMixedPairs(aPairs, aN);
+  if (fManager) fManager->ClearWeights();
+}
 //_______________________
 void AliFemtoModelCorrFctn::AddRealPair(AliFemtoPair* aPair)
 {
@@ -29,6 +29,8 @@ public:
 
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
+  virtual void AddRealPairs(AliFemtoPair** aPairs, unsigned int aN);
+  virtual void AddMixedPairs(AliFemtoPair** aPairs, unsigned int aN);
 
   virtual void EventBegin(const AliFemtoEvent* aEvent);
   virtual void EventEnd(const AliFemtoEvent* aEvent);
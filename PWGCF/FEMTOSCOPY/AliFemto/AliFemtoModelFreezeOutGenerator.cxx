@@ -12,6 +12,8 @@
 #endif
 
 #include "AliFemtoModelFreezeOutGenerator.h"
+#include "AliFemtoModelHiddenInfo.h"
+#include "AliFemtoLorentzVector.h"
 
 //____________________________
 AliFemtoModelFreezeOutGenerator::AliFemtoModelFreezeOutGenerator():
@@ -41,3 +43,24 @@ AliFemtoModelFreezeOutGenerator* AliFemtoModelFreezeOutGenerator::Clone() const
 {
   return 0;
 }
+//____________________________
+Bool_t AliFemtoModelFreezeOutGenerator::GenerateFreezeOutBlock(AliFemtoPair ** /* aPairs */, Int_t /* aNPairs */,
+                                                               Double_t * /* aX */, UChar_t * /* aValid */)
+{
+  return kFALSE;
+}
+//____________________________
+void AliFemtoModelFreezeOutGenerator::SetEmissionPoints(AliFemtoPair *aPair, const Double_t *aX)
+{
+  AliFemtoTrack *tTracks[2] = { (AliFemtoTrack *) aPair->Track1()->Track(),
+                                (AliFemtoTrack *) aPair->Track2()->Track() };
+  for (int i=0; i<2; i++) {
+    const Double_t *tX = aX + 4*i;
+    if (!(((AliFemtoModelHiddenInfo*)tTracks[i]->GetHiddenInfo())->GetEmissionPoint())) {
+      AliFemtoLorentzVector tPos(tX[0], tX[1], tX[2], tX[3]);
+      tTracks[i]->SetEmissionPoint(&tPos);
+    }
+    else
+      tTracks[i]->SetEmissionPoint(tX[0], tX[1], tX[2], tX[3]);
+  }
+}
@@ -21,6 +21,17 @@ class AliFemtoModelFreezeOutGenerator
   
   virtual ~AliFemtoModelFreezeOutGenerator();
   virtual void GenerateFreezeOut(AliFemtoPair *aPair) = 0;
+
+  /// Freeze-out coordinates of a block of pairs, drawn at once. Fills aX
+  /// with the emission points (x,y,z,t) of the first and second particle
+  /// of each pair (8 values per pair) and aValid with 0 for the pairs
+  /// whose emission points are to be left untouched. Returns kFALSE if the
+  /// generator has no block implementation (the default).
+  virtual Bool_t GenerateFreezeOutBlock(AliFemtoPair **aPairs, Int_t aNPairs, Double_t *aX, UChar_t *aValid);
+
+  /// Set the emission points of both particles of the pair from the
+  /// 8 values filled by GenerateFreezeOutBlock
+  static void SetEmissionPoints(AliFemtoPair *aPair, const Double_t *aX);
   
   virtual AliFemtoModelFreezeOutGenerator* Clone() const;
   
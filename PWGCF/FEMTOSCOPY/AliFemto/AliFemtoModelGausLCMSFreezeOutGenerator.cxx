@@ -19,7 +19,8 @@
 
 //_______________________
 AliFemtoModelGausLCMSFreezeOutGenerator::AliFemtoModelGausLCMSFreezeOutGenerator() :
-  fSizeOut(0), fSizeSide(0), fSizeLong(0)
+  fSizeOut(0), fSizeSide(0), fSizeLong(0),
+  fBlockP(), fBlockRndm()
 {
   // Default constructor
   fRandom = new TRandom2();
@@ -28,7 +29,8 @@ AliFemtoModelGausLCMSFreezeOutGenerator::AliFemtoModelGausLCMSFreezeOutGenerator
 //_______________________
 AliFemtoModelGausLCMSFreezeOutGenerator::AliFemtoModelGausLCMSFreezeOutGenerator(const AliFemtoModelGausLCMSFreezeOutGenerator &aModel):
   AliFemtoModelFreezeOutGenerator(aModel),
-  fSizeOut(0), fSizeSide(0), fSizeLong(0)
+  fSizeOut(0), fSizeSide(0), fSizeLong(0),
+  fBlockP(), fBlockRndm()
 {
   // Copy constructor
   fRandom = new TRandom2();
@@ -134,6 +136,67 @@ void AliFemtoModelGausLCMSFreezeOutGenerator::GenerateFreezeOut(AliFemtoPair *aP
  }
 }
 
+//_______________________
+Bool_t AliFemtoModelGausLCMSFreezeOutGenerator::GenerateFreezeOutBlock(AliFemtoPair **aPairs, Int_t aNPairs, Double_t *aX, UChar_t *aValid)
+{
+  // Same source as GenerateFreezeOut, for a block of pairs: the pair
+  // momenta are collected first, then all the gaussian numbers are made
+  // from one array of uniform numbers (Box-Muller) and the rotation and
+  // boost to the lab are done in one loop without branches
+  if (aNPairs <= 0) return kTRUE;
+
+  fBlockP.resize(4*aNPairs);
+  for (Int_t i=0; i<aNPairs; i++) {
+    AliFemtoTrack *inf1 = (AliFemtoTrack *) aPairs[i]->Track1()->Track();
+    AliFemtoTrack *inf2 = (AliFemtoTrack *) aPairs[i]->Track2()->Track();
+    if ((!inf1) || (!inf2)) { cout << "Hidden info not created! "  << endl; exit(kFALSE); }
+    AliFemtoModelHiddenInfo *hid1 = (AliFemtoModelHiddenInfo*)inf1->GetHiddenInfo();
+    AliFemtoModelHiddenInfo *hid2 = (AliFemtoModelHiddenInfo*)inf2->GetHiddenInfo();
+    const AliFemtoThreeVector *tP1 = hid1->GetTrueMomentum();
+    const AliFemtoThreeVector *tP2 = hid2->GetTrueMomentum();
+    Double_t tM1 = hid1->GetMass();
+    Double_t tM2 = hid2->GetMass();
+    Double_t *tP = &fBlockP[4*i];
+    tP[0] = tP1->x() + tP2->x();
+    tP[1] = tP1->y() + tP2->y();
+    tP[2] = tP1->z() + tP2->z();
+    tP[3] = sqrt(tM1*tM1 + tP1->Mag2()) + sqrt(tM2*tM2 + tP2->Mag2());
+    aValid[i] = !(tP[0]==0 && tP[1]==0 && tP[2]==0);
+  }
+
+  // three gaussian numbers per pair, two per pair of uniform numbers
+  const Int_t tNRndm = 2*((3*aNPairs + 1)/2);
+  fBlockRndm.resize(tNRndm);
+  Double_t *tU = &fBlockRndm[0];
+  fRandom->RndmArray(tNRndm, tU);
+  for (Int_t i=0; i<tNRndm; i+=2) {
+    Double_t tRho = sqrt(-2.0*log(tU[i] > 0 ? tU[i] : 1e-300));
+    Double_t tPhi = TMath::TwoPi()*tU[i+1];
+    tU[i] = tRho*cos(tPhi);
+    tU[i+1] = tRho*sin(tPhi);
+  }
+
+  const Double_t *tP = &fBlockP[0];
+  for (Int_t i=0; i<aNPairs; i++) {
+    const Double_t tPx = tP[4*i], tPy = tP[4*i+1], tPz = tP[4*i+2], tEs = tP[4*i+3];
+    const Double_t tPt = sqrt(tPx*tPx + tPy*tPy);
+
+    const Double_t tRout = fSizeOut*tU[3*i];
+    const Double_t tRside = fSizeSide*tU[3*i+1];
+    const Double_t tRlong = fSizeLong*tU[3*i+2];
+
+    const Double_t tBetaz = tPz/tEs;
+    const Double_t tGammaz = 1.0/sqrt(1-tBetaz*tBetaz);
+
+    Double_t *tX = aX + 8*i;
+    tX[0] = tX[1] = tX[2] = tX[3] = 0;
+    tX[4] = (tPx * tRout + tPy * tRside)/tPt;
+    tX[5] = (tPy * tRout - tPx * tRside)/tPt;
+    tX[6] = tGammaz * tRlong;
+    tX[7] = tGammaz * tBetaz * tRlong;
+  }
+  return kTRUE;
+}
 //_______________________
 void AliFemtoModelGausLCMSFreezeOutGenerator::SetSizeOut(Double_t aSizeOut)
 {
@@ -8,6 +8,8 @@
 #ifndef ALIFEMTOMODELGAUSLCMSFREEZEOUTGENERATOR_H
 #define ALIFEMTOMODELGAUSLCMSFREEZEOUTGENERATOR_H
 
+#include <vector>
+
 #include "AliFemtoModelFreezeOutGenerator.h"
 
 #include "TRandom.h"
@@ -20,6 +22,7 @@ class AliFemtoModelGausLCMSFreezeOutGenerator : public AliFemtoModelFreezeOutGen
   virtual ~AliFemtoModelGausLCMSFreezeOutGenerator();
   AliFemtoModelGausLCMSFreezeOutGenerator& operator=(const AliFemtoModelGausLCMSFreezeOutGenerator &aModel);
   virtual void GenerateFreezeOut(AliFemtoPair *aPair);
+  virtual Bool_t GenerateFreezeOutBlock(AliFemtoPair **aPairs, Int_t aNPairs, Double_t *aX, UChar_t *aValid);
 
   void SetSizeOut(Double_t aSizeOut);
   void SetSizeSide(Double_t aSizeSide);
@@ -36,6 +39,9 @@ class AliFemtoModelGausLCMSFreezeOutGenerator : public AliFemtoModelFreezeOutGen
   Double_t fSizeSide; // Size of the source in the side direction
   Double_t fSizeLong; // Size of the source in the long direction
 
+  std::vector<Double_t> fBlockP;     //! pair momenta (px,py,pz,E) of the block
+  std::vector<Double_t> fBlockRndm;  //! uniform random numbers of the block
+
  private:
   AliFemtoModelFreezeOutGenerator* GetGenerator() const;
 		
@@ -18,14 +18,26 @@
 AliFemtoModelManager::AliFemtoModelManager():
   fFreezeOutGenerator(0),
   fWeightGenerator(0),
-  fCreateCopyHiddenInfo(kFALSE)
+  fCreateCopyHiddenInfo(kFALSE),
+  fBlockWeights(kFALSE),
+  fBlockPairs(),
+  fBlockWeight(),
+  fBlockX(),
+  fBlockValid(),
+  fBlockNext(0)
 {
 }
 //_____________________________________________
 AliFemtoModelManager::AliFemtoModelManager(const AliFemtoModelManager& aManager):
   fFreezeOutGenerator(0),
   fWeightGenerator(0),
-  fCreateCopyHiddenInfo(aManager.fCreateCopyHiddenInfo)
+  fCreateCopyHiddenInfo(aManager.fCreateCopyHiddenInfo),
+  fBlockWeights(aManager.fBlockWeights),
+  fBlockPairs(),
+  fBlockWeight(),
+  fBlockX(),
+  fBlockValid(),
+  fBlockNext(0)
 {
   if (aManager.fFreezeOutGenerator) {
     fFreezeOutGenerator = aManager.fFreezeOutGenerator->Clone();
@@ -54,6 +66,8 @@ AliFemtoModelManager& AliFemtoModelManager::operator=(const AliFemtoModelManager
   }
   else fWeightGenerator = 0;
   fCreateCopyHiddenInfo = aManager.fCreateCopyHiddenInfo;
+  fBlockWeights = aManager.fBlockWeights;
+  ClearWeights();
 
   return *this;
 }
@@ -76,7 +90,58 @@ Double_t AliFemtoModelManager::GetWeight(AliFemtoPair *aPair)
 //    exit(0);
   }
   // Return femtoscopic weight for a given pair
+
+  // weights of a block prepared by PrepareWeights, looked up in order
+  if (fBlockNext < fBlockPairs.size()) {
+    while (fBlockNext < fBlockPairs.size() && fBlockPairs[fBlockNext] != aPair) fBlockNext++;
+    if (fBlockNext < fBlockPairs.size()) return fBlockWeight[fBlockNext];
+  }
+
+  if (fCreateCopyHiddenInfo) CreateHiddenInfo(aPair);
+
+  if (fFreezeOutGenerator) {
+    fFreezeOutGenerator->GenerateFreezeOut(aPair);
+  }
+  return fWeightGenerator->GenerateWeight(aPair);
+}
+//_____________________________________________
+void AliFemtoModelManager::SetBlockWeights(Bool_t aBlock)
+{
+  fBlockWeights = aBlock;
+  ClearWeights();
+}
+//_____________________________________________
+void AliFemtoModelManager::PrepareWeights(AliFemtoPair **aPairs, Int_t aNPairs)
+{
+  // Compute the weights of a block of pairs, for the following GetWeight() calls
+  ClearWeights();
+  if (!fBlockWeights || !fWeightGenerator || !fFreezeOutGenerator || aNPairs <= 0) return;
+
   if (fCreateCopyHiddenInfo) {
+    for (Int_t i=0; i<aNPairs; i++) CreateHiddenInfo(aPairs[i]);
+  }
+
+  fBlockX.resize(8*aNPairs);
+  fBlockValid.resize(aNPairs);
+  if (!fFreezeOutGenerator->GenerateFreezeOutBlock(aPairs, aNPairs, &fBlockX[0], &fBlockValid[0])) return;
+
+  fBlockPairs.assign(aPairs, aPairs + aNPairs);
+  fBlockWeight.resize(aNPairs);
+  for (Int_t i=0; i<aNPairs; i++) {
+    if (fBlockValid[i]) AliFemtoModelFreezeOutGenerator::SetEmissionPoints(aPairs[i], &fBlockX[8*i]);
+    fBlockWeight[i] = fWeightGenerator->GenerateWeight(aPairs[i]);
+  }
+}
+//_____________________________________________
+void AliFemtoModelManager::ClearWeights()
+{
+  fBlockPairs.clear();
+  fBlockNext = 0;
+}
+//_____________________________________________
+void AliFemtoModelManager::CreateHiddenInfo(AliFemtoPair *aPair)
+{
+  {
     // Try to guess particle masses and pid from the weight generator
     Double_t tMass1=0.0001, tMass2=0.0001;
     Int_t tPid1=0, tPid2=0;
@@ -188,11 +253,6 @@ Double_t AliFemtoModelManager::GetWeight(AliFemtoPair *aPair)
       delete inf2;
     }
   }
-
-  if (fFreezeOutGenerator) {
-    fFreezeOutGenerator->GenerateFreezeOut(aPair);
-  }
-  return fWeightGenerator->GenerateWeight(aPair);
 }
 //_____________________________________________
 void AliFemtoModelManager::CreateCopyHiddenInfo(Bool_t aCopy)
@@ -8,6 +8,8 @@
 #ifndef AliFemtoModelManager_hh
 #define AliFemtoModelManager_hh
 
+#include <vector>
+
 #include "AliFemtoEnumeration.h"
 #include "AliFemtoModelWeightGenerator.h"
 #include "AliFemtoModelFreezeOutGenerator.h"
@@ -29,17 +31,35 @@ class AliFemtoModelManager
   AliFemtoModelWeightGenerator*    GetWeightGenerator();
 
   virtual Double_t GetWeight(AliFemtoPair *aPair);
+
+  /// Weights of a whole block of pairs, with the freeze-out coordinates
+  /// drawn at once by the freeze-out generator. The weights are kept and
+  /// returned by GetWeight() for these pairs until ClearWeights(). The
+  /// weight generator then holds the state of the last pair of the block.
+  void SetBlockWeights(Bool_t aBlock=kTRUE);
+  Bool_t GetBlockWeights() const { return fBlockWeights; }
+  virtual void PrepareWeights(AliFemtoPair **aPairs, Int_t aNPairs);
+  void ClearWeights();
   
  protected:
+  void CreateHiddenInfo(AliFemtoPair *aPair);
+
   AliFemtoModelFreezeOutGenerator *fFreezeOutGenerator;   // Freeze-out coordinates generator
   AliFemtoModelWeightGenerator    *fWeightGenerator;      // Femtoscopic weight generator
   Bool_t                           fCreateCopyHiddenInfo; // Switch to turn on hidden-info generation
+  Bool_t                           fBlockWeights;         // Switch to compute the weights of pair blocks at once
+
+  std::vector<AliFemtoPair*>       fBlockPairs;           //! pairs of the prepared block
+  std::vector<Double_t>            fBlockWeight;          //! weights of the prepared block
+  std::vector<Double_t>            fBlockX;               //! emission points of the prepared block
+  std::vector<UChar_t>             fBlockValid;           //! pairs with generated emission points
+  UInt_t                           fBlockNext;            //! position of the last weight lookup
 
  private:
 		
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoModelManager, 1);
+  ClassDef(AliFemtoModelManager, 2);
   /// \endcond
 #endif
 
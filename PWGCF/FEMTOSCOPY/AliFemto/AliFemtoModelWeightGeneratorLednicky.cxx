@@ -114,7 +114,10 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky() :
   fSphereApp(false),fT0App(false) ,
   fLL(0), fNuclChargeSign(1), fSwap(0), fLLMax(30), fLLName(0), 
   fNumProcessPair(0), fNumbNonId(0),
-  fKpKmModel(14),fPhi_OffOn(1)
+  fKpKmModel(14),fPhi_OffOn(1),
+  fTabulated(false),fTabNKStar(80),fTabKStarMax(0.2),
+  fTabNRStar(80),fTabRStarMax(20.),fTabNCosTheta(81),
+  fWeightTable(0)
 {
   // default constructor
   fLLName=new char*[fLLMax+1];
@@ -163,7 +166,10 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky(const
   fSphereApp(false),fT0App(false) ,
   fLL(0), fNuclChargeSign(1), fSwap(0), fLLMax(30), fLLName(0), 
   fNumProcessPair(0), fNumbNonId(0),
-  fKpKmModel(14),fPhi_OffOn(1)
+  fKpKmModel(14),fPhi_OffOn(1),
+  fTabulated(false),fTabNKStar(80),fTabKStarMax(0.2),
+  fTabNRStar(80),fTabRStarMax(20.),fTabNCosTheta(81),
+  fWeightTable(0)
 {
   // copy constructor
   fWei = aWeight.fWei; 
@@ -190,6 +196,13 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky(const
   fNumProcessPair=new int[fLLMax+1];
   fKpKmModel = aWeight.fKpKmModel;
   fPhi_OffOn = aWeight.fPhi_OffOn;
+  fTabulated = aWeight.fTabulated;
+  fTabNKStar = aWeight.fTabNKStar;
+  fTabKStarMax = aWeight.fTabKStarMax;
+  fTabNRStar = aWeight.fTabNRStar;
+  fTabRStarMax = aWeight.fTabRStarMax;
+  fTabNCosTheta = aWeight.fTabNCosTheta;
+  DeleteWeightTables();
   int i;
   for (i=1;i<=fLLMax;i++) {fLLName[i]=new char[40];fNumProcessPair[i]=0;}
   strncpy( fLLName[1],"neutron neutron",40);
@@ -258,6 +271,13 @@ AliFemtoModelWeightGeneratorLednicky& AliFemtoModelWeightGeneratorLednicky::oper
   fNumProcessPair=new int[fLLMax+1];
   fKpKmModel = aWeight.fKpKmModel;
   fPhi_OffOn = aWeight.fPhi_OffOn;
+  fTabulated = aWeight.fTabulated;
+  fTabNKStar = aWeight.fTabNKStar;
+  fTabKStarMax = aWeight.fTabKStarMax;
+  fTabNRStar = aWeight.fTabNRStar;
+  fTabRStarMax = aWeight.fTabRStarMax;
+  fTabNCosTheta = aWeight.fTabNCosTheta;
+  DeleteWeightTables();
   int i;
   for (i=1;i<=fLLMax;i++) {fLLName[i]=new char[40];fNumProcessPair[i]=0;}
   strncpy( fLLName[1],"neutron neutron",40);
@@ -421,11 +441,6 @@ Double_t tDTime =inf1->GetEmissionPoint()->t()  - inf2->GetEmissionPoint()->t();
       fWeightDen=0.;
       return 0;  
     } 
-    if (fSwap) {
-      fsimomentum(*p2,*p1);
-    } else {
-      fsimomentum(*p1,*p2);
-    }
     AliFemtoLorentzVector* tPoint;
 //    tPoint=((AliFemtoModelHiddenInfo*)inf1->GetHiddenInfo())->GetEmissionPoint();
     tPoint=inf1->GetEmissionPoint();
@@ -444,9 +459,15 @@ Double_t tDTime =inf1->GetEmissionPoint()->t()  - inf2->GetEmissionPoint()->t();
       fWeightDen=0.;
       return 0;  
     } 
+    if (fTabulated && fI3c==0) {
+      double tWeight;
+      if (GetTabulatedWeight(tWeight)) return tWeight;
+    }
     if (fSwap) {
+      fsimomentum(*p2,*p1);
       fsiposition(*x2,*x1);
     } else {
+      fsimomentum(*p1,*p2);
       fsiposition(*x1,*x2);
     }
     FsiSetLL();
@@ -497,6 +518,7 @@ void AliFemtoModelWeightGeneratorLednicky::FsiInit(){
    cout <<"mI3c dans FsiInit() = " << fI3c << endl;
    
   fsiin(fItest,fIch,fIqs,fIsi,fI3c);
+  DeleteWeightTables();
 }
 
 void AliFemtoModelWeightGeneratorLednicky::FsiSetKpKmModelType(){
@@ -641,6 +663,7 @@ AliFemtoModelWeightGeneratorLednicky::~AliFemtoModelWeightGeneratorLednicky()
 { 
   if (fLLName) delete [] fLLName;
   if (fNumProcessPair) delete [] fNumProcessPair;
+  DeleteWeightTables();
 /* no-op */ 
 }
 
@@ -720,15 +743,15 @@ void     AliFemtoModelWeightGeneratorLednicky::SetPairTypeFromPair(AliFemtoPair
 }
 
 //K+K- model type
-void AliFemtoModelWeightGeneratorLednicky::SetKpKmModelType(const int aModelType, const int aPhi_OffOn) {fKpKmModel=aModelType; fPhi_OffOn=aPhi_OffOn; fNS_4=4; FsiSetKpKmModelType();}
+void AliFemtoModelWeightGeneratorLednicky::SetKpKmModelType(const int aModelType, const int aPhi_OffOn) {fKpKmModel=aModelType; fPhi_OffOn=aPhi_OffOn; fNS_4=4; FsiSetKpKmModelType(); DeleteWeightTables();}
 
 void AliFemtoModelWeightGeneratorLednicky::SetNuclCharge(const double aNuclCharge) {fNuclCharge=aNuclCharge;FsiNucl();}
 void AliFemtoModelWeightGeneratorLednicky::SetNuclMass(const double aNuclMass){fNuclMass=aNuclMass;FsiNucl();}
 
-void AliFemtoModelWeightGeneratorLednicky::SetSphere(){fSphereApp=true;}
-void AliFemtoModelWeightGeneratorLednicky::SetSquare(){fSphereApp=false;}
-void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOn(){ fT0App=true;}
-void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOff(){ fT0App=false;}
+void AliFemtoModelWeightGeneratorLednicky::SetSphere(){fSphereApp=true;DeleteWeightTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetSquare(){fSphereApp=false;DeleteWeightTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOn(){ fT0App=true;DeleteWeightTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOff(){ fT0App=false;DeleteWeightTables();}
 void AliFemtoModelWeightGeneratorLednicky::SetDefaultCalcPar(){
   fItest=1;fIqs=1;fIsi=1;fI3c=0;fIch=1;FsiInit();
   fSphereApp=false;fT0App=false;}
@@ -751,6 +774,98 @@ Double_t AliFemtoModelWeightGeneratorLednicky::GetRStarOut() const { return AliF
 Double_t AliFemtoModelWeightGeneratorLednicky::GetRStarSide() const { return AliFemtoModelWeightGenerator::GetRStarSide(); }
 Double_t AliFemtoModelWeightGeneratorLednicky::GetRStarLong() const { return AliFemtoModelWeightGenerator::GetRStarLong(); }
 
+void AliFemtoModelWeightGeneratorLednicky::SetTabulatedWeights(const bool aOn, const int aNKStar, const double aKStarMax,
+                                                               const int aNRStar, const double aRStarMax, const int aNCosTheta)
+{
+  // switch on/off the interpolation of the weights on a (k*, r*, cos theta*) grid;
+  // the k* and r* nodes are the centers of aNKStar (aNRStar) bins up to aKStarMax (aRStarMax)
+  fTabulated = aOn;
+  fTabNKStar = (aNKStar>1) ? aNKStar : 2;
+  fTabKStarMax = aKStarMax;
+  fTabNRStar = (aNRStar>1) ? aNRStar : 2;
+  fTabRStarMax = aRStarMax;
+  fTabNCosTheta = (aNCosTheta>1) ? aNCosTheta : 2;
+  DeleteWeightTables();
+}
+
+void AliFemtoModelWeightGeneratorLednicky::DeleteWeightTables()
+{
+  // remove the tabulated weights, to be rebuilt with the current settings
+  if (!fWeightTable) return;
+  for (int i=0;i<=fLLMax;i++) delete [] fWeightTable[i];
+  delete [] fWeightTable;
+  fWeightTable = 0;
+}
+
+void AliFemtoModelWeightGeneratorLednicky::BuildWeightTable()
+{
+  // compute the weights of the current pair type fLL on the grid nodes, in the pair
+  // rest frame: first particle with k* along z, emission points separated by r* at
+  // angle theta* to k*, same emission time
+  if (!fWeightTable) {
+    fWeightTable = new double*[fLLMax+1];
+    for (int i=0;i<=fLLMax;i++) fWeightTable[i] = 0;
+  }
+  cout << "AliFemtoModelWeightGeneratorLednicky: tabulating the weights of " << fLLName[fLL]
+       << " on " << fTabNKStar << "x" << fTabNRStar << "x" << fTabNCosTheta << " nodes" << endl;
+  double *tTable = new double[fTabNKStar*fTabNRStar*fTabNCosTheta];
+  const double tDK = fTabKStarMax/fTabNKStar;
+  const double tDR = fTabRStarMax/fTabNRStar;
+  const double tDC = 2./(fTabNCosTheta-1);
+  double tWeif, tWei, tWein;
+  FsiSetLL();
+  for (int ik=0;ik<fTabNKStar;ik++) {
+    double tK = (ik+0.5)*tDK;
+    for (int ir=0;ir<fTabNRStar;ir++) {
+      double tR = (ir+0.5)*tDR;
+      for (int ic=0;ic<fTabNCosTheta;ic++) {
+        double tCos = -1.+ic*tDC;
+        double tSin = ::sqrt(1.-tCos*tCos);
+        double p1[]={0.,0.,tK};
+        double p2[]={0.,0.,-tK};
+        double x1[]={tR*tSin,0.,tR*tCos,0.};
+        double x2[]={0.,0.,0.,0.};
+        fsimomentum(*p1,*p2);
+        fsiposition(*x1,*x2);
+        ltran12();
+        fsiw(1,tWeif,tWei,tWein);
+        tTable[(ik*fTabNRStar+ir)*fTabNCosTheta+ic] = tWein;
+      }
+    }
+  }
+  fWeightTable[fLL] = tTable;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::GetTabulatedWeight(double &aWeight)
+{
+  // trilinear interpolation of the weight of the current pair (fKStar*, fRStar*)
+  // on the grid of its pair type; kFALSE if the pair is outside the grid
+  if (fKStar<=0. || fRStar<=0.) return false;
+  double tXK = fKStar/fTabKStarMax*fTabNKStar - 0.5;
+  double tXR = fRStar/fTabRStarMax*fTabNRStar - 0.5;
+  if (tXK<0. || tXK>fTabNKStar-1 || tXR<0. || tXR>fTabNRStar-1) return false;
+  double tCos = (fKStarOut*fRStarOut + fKStarSide*fRStarSide + fKStarLong*fRStarLong)/(fKStar*fRStar);
+  double tXC = (tCos+1.)/2.*(fTabNCosTheta-1);
+  if (tXC<0.) tXC = 0.;
+  if (tXC>fTabNCosTheta-1) tXC = fTabNCosTheta-1;
+
+  if (!fWeightTable || !fWeightTable[fLL]) BuildWeightTable();
+  const double *tTable = fWeightTable[fLL];
+
+  int tIK = (int)tXK; if (tIK>fTabNKStar-2) tIK = fTabNKStar-2;
+  int tIR = (int)tXR; if (tIR>fTabNRStar-2) tIR = fTabNRStar-2;
+  int tIC = (int)tXC; if (tIC>fTabNCosTheta-2) tIC = fTabNCosTheta-2;
+  double tFK = tXK-tIK, tFR = tXR-tIR, tFC = tXC-tIC;
+  aWeight = 0.;
+  for (int dk=0;dk<2;dk++) 
+    for (int dr=0;dr<2;dr++) 
+      for (int dc=0;dc<2;dc++) {
+        double tW = (dk ? tFK : 1.-tFK)*(dr ? tFR : 1.-tFR)*(dc ? tFC : 1.-tFC);
+        aWeight += tW*tTable[((tIK+dk)*fTabNRStar+tIR+dr)*fTabNCosTheta+tIC+dc];
+      }
+  return true;
+}
+
 AliFemtoModelWeightGenerator* AliFemtoModelWeightGeneratorLednicky::Clone() const {
   AliFemtoModelWeightGenerator* tmp = new AliFemtoModelWeightGeneratorLednicky(*this);
   return tmp;
@@ -66,6 +66,13 @@ class AliFemtoModelWeightGeneratorLednicky : public  AliFemtoModelWeightGenerato
 
   void SetKpKmModelType(const int aModelType, const int aPhi_OffOn);  // K+K- model type,Phi off/on
 
+// >>> Tabulated weights: interpolation on a (k*, r*, cos theta*) grid per pair type,
+//     computed at the first pair of each type in the equal-time approximation (t*=0);
+//     the exact calculation is used outside the grid and with the 3-body influence
+  void SetTabulatedWeights(const bool aOn, const int aNKStar=80, const double aKStarMax=0.2,
+                           const int aNRStar=80, const double aRStarMax=20., const int aNCosTheta=81);
+  bool GetTabulatedWeights() const {return fTabulated;}
+
   virtual AliFemtoString Report();
 
 protected:
@@ -103,6 +110,15 @@ protected:
   int       fPhi_OffOn;      //0->Phi Off,1->Phi On
   int       fNS_4;           //set NS is equal to 4
 
+  //Tabulated weights
+  bool      fTabulated;      // interpolate the weights on a grid
+  int       fTabNKStar;      // number of k* nodes
+  double    fTabKStarMax;    // upper edge of the k* grid
+  int       fTabNRStar;      // number of r* nodes
+  double    fTabRStarMax;    // upper edge of the r* grid
+  int       fTabNCosTheta;   // number of cos(theta*) nodes in [-1,1]
+  double**  fWeightTable;    //! grid of weights of each pair type, built at first use
+
   // Interface to the fortran functions
   void FsiSetKpKmModelType();  //// initialize K+K- model type
   void FsiInit();
@@ -110,8 +126,12 @@ protected:
   void FsiNucl();
   bool SetPid(const int aPid1,const int aPid2);
 
+  void   BuildWeightTable();
+  void   DeleteWeightTables();
+  bool   GetTabulatedWeight(double &aWeight);
+
 #ifdef __ROOT__
-  ClassDef(AliFemtoModelWeightGeneratorLednicky,1)
+  ClassDef(AliFemtoModelWeightGeneratorLednicky,2)
 #endif
 };
 
@@ -27,6 +27,13 @@ AliFemtoPair::AliFemtoPair():
   fCVK(0.0),
   fKStarCalc(0.0),
   fNonIdParNotCalculatedGlobal(0),
+  fLabParNotCalculated(1),
+  fQInvCalc(0.0),
+  fKTCalc(0.0),
+  fMInvCalc(0.0),
+  fQOutCMSCalc(0.0),
+  fQSideCMSCalc(0.0),
+  fQLongCMSCalc(0.0),
   fMergingParNotCalculated(0),
   fWeightedAvSep(0.0),
   fFracOfMergedRow(0.0),
@@ -65,6 +72,13 @@ AliFemtoPair::AliFemtoPair(AliFemtoParticle* a, AliFemtoParticle* b):
   fCVK(0.0),
   fKStarCalc(0.0),
   fNonIdParNotCalculatedGlobal(0),
+  fLabParNotCalculated(1),
+  fQInvCalc(0.0),
+  fKTCalc(0.0),
+  fMInvCalc(0.0),
+  fQOutCMSCalc(0.0),
+  fQSideCMSCalc(0.0),
+  fQLongCMSCalc(0.0),
   fMergingParNotCalculated(0),
   fWeightedAvSep(0.0),
   fFracOfMergedRow(0.0),
@@ -134,6 +148,13 @@ AliFemtoPair::AliFemtoPair(const AliFemtoPair &aPair):
   fCVK(aPair.fCVK),
   fKStarCalc(aPair.fKStarCalc),
   fNonIdParNotCalculatedGlobal(aPair.fNonIdParNotCalculatedGlobal),
+  fLabParNotCalculated(aPair.fLabParNotCalculated),
+  fQInvCalc(aPair.fQInvCalc),
+  fKTCalc(aPair.fKTCalc),
+  fMInvCalc(aPair.fMInvCalc),
+  fQOutCMSCalc(aPair.fQOutCMSCalc),
+  fQSideCMSCalc(aPair.fQSideCMSCalc),
+  fQLongCMSCalc(aPair.fQLongCMSCalc),
   fMergingParNotCalculated(aPair.fMergingParNotCalculated),
   fWeightedAvSep(aPair.fWeightedAvSep),
   fFracOfMergedRow(aPair.fFracOfMergedRow),
@@ -181,6 +202,14 @@ AliFemtoPair& AliFemtoPair::operator=(const AliFemtoPair &aPair)
 
   fNonIdParNotCalculatedGlobal = aPair.fNonIdParNotCalculatedGlobal;
 
+  fLabParNotCalculated = aPair.fLabParNotCalculated;
+  fQInvCalc = aPair.fQInvCalc;
+  fKTCalc = aPair.fKTCalc;
+  fMInvCalc = aPair.fMInvCalc;
+  fQOutCMSCalc = aPair.fQOutCMSCalc;
+  fQSideCMSCalc = aPair.fQSideCMSCalc;
+  fQLongCMSCalc = aPair.fQLongCMSCalc;
+
   fMergingParNotCalculated = aPair.fMergingParNotCalculated;
   fWeightedAvSep = aPair.fWeightedAvSep;
   fFracOfMergedRow = aPair.fFracOfMergedRow;
@@ -219,20 +248,40 @@ double AliFemtoPair::GetPairAngleEP() const
 	return fPairAngleEP;
 }
 //_________________
-double AliFemtoPair::MInv() const
+void AliFemtoPair::CalcLabPar() const
 {
-  // invariant mass
-    double tInvariantMass = abs(fTrack1->FourMomentum() + fTrack2->FourMomentum());
-    return (tInvariantMass);
-}
-//_________________
-double AliFemtoPair::KT() const
-{
-  // transverse momentum
-  double tmp = (fTrack1->FourMomentum() + fTrack2->FourMomentum()).Perp();
-  tmp *= .5;
+  // Calculate qinv, kT, minv and the LCMS relative momentum components
+  // in one pass; the correlation functions attached to an analysis all
+  // ask for the same quantities of the same pair
+  const AliFemtoLorentzVector& tP1 = fTrack1->FourMomentum();
+  const AliFemtoLorentzVector& tP2 = fTrack2->FourMomentum();
+
+  AliFemtoLorentzVector tDiff = tP1 - tP2;
+  AliFemtoLorentzVector tSum = tP1 + tP2;
+  fQInvCalc = -1.* tDiff.m();
+  fMInvCalc = abs(tSum);
+
+  double x1 = tP1.x();  double y1 = tP1.y();
+  double x2 = tP2.x();  double y2 = tP2.y();
+  double xt = x1+x2;    double yt = y1+y2;
+  double k1 = ::sqrt(xt*xt+yt*yt);
+
+  fKTCalc = .5*tSum.Perp();
+
+  if(k1!=0) {
+    fQOutCMSCalc = ((x1-x2)*xt+(y1-y2)*yt)/k1;
+    fQSideCMSCalc = 2.0*(x2*y1-x1*y2)/k1;
+  }
+  else {
+    fQOutCMSCalc = 0;
+    fQSideCMSCalc = 0;
+  }
 
-  return (tmp);
+  double beta = tSum.z()/tSum.t();
+  double gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
+  fQLongCMSCalc = gamma*(tDiff.z() - beta*tDiff.t());
+
+  fLabParNotCalculated=0;
 }
 //_________________
 double AliFemtoPair::Rap() const
@@ -352,68 +401,6 @@ void AliFemtoPair::QYKPPF(double& qP, double& qT, double& q0) const
   qT = l.vect().Perp();
   q0 = l.e();
 }
-//_________________
-double AliFemtoPair::QOutCMS() const
-{
-  // relative momentum out component in lab frame
-    AliFemtoThreeVector tmp1 = fTrack1->FourMomentum().vect();
-    AliFemtoThreeVector tmp2 = fTrack2->FourMomentum().vect();
-
-    double dx = tmp1.x() - tmp2.x();
-    double xt = tmp1.x() + tmp2.x();
-
-    double dy = tmp1.y() - tmp2.y();
-    double yt = tmp1.y() + tmp2.y();
-
-    double k1 = (::sqrt(xt*xt+yt*yt));
-    double k2 = (dx*xt+dy*yt);
-    double tmp;
-
-    if(k1!=0) tmp= k2/k1;
-    else tmp=0;
-
-    return (tmp);
-}
-//_________________
-double AliFemtoPair::QSideCMS() const
-{
-  // relative momentum side component in lab frame
-    AliFemtoThreeVector tmp1 = fTrack1->FourMomentum().vect();
-    AliFemtoThreeVector tmp2 = fTrack2->FourMomentum().vect();
-
-    double x1 = tmp1.x();  double y1 = tmp1.y();
-    double x2 = tmp2.x();  double y2 = tmp2.y();
-
-    double xt = x1+x2;  double yt = y1+y2;
-    double k1 = ::sqrt(xt*xt+yt*yt);
-
-    double tmp;
-    if(k1!=0) tmp= 2.0*(x2*y1-x1*y2)/k1;
-    else tmp=0;
-
-    return (tmp);
-}
-
-//_________________________
-double AliFemtoPair::QLongCMS() const
-{
-  // relative momentum component in lab frame
-    AliFemtoLorentzVector tmp1 = fTrack1->FourMomentum();
-    AliFemtoLorentzVector tmp2 = fTrack2->FourMomentum();
-
-    double dz = tmp1.z() - tmp2.z();
-    double zz = tmp1.z() + tmp2.z();
-
-    double dt = tmp1.t() - tmp2.t();
-    double tt = tmp1.t() + tmp2.t();
-
-    double beta = zz/tt;
-    double gamma = 1.0/TMath::Sqrt((1.-beta)*(1.+beta));
-
-    double temp = gamma*(dz - beta*dt);
-    return (temp);
-}
-
 //________________________________
 double AliFemtoPair::QOutPf() const
 {
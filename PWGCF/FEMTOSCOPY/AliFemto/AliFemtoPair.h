@@ -173,6 +173,15 @@ private:
   void CalcNonIdPar() const;
 
   mutable short fNonIdParNotCalculatedGlobal; // If global k* was calculated
+
+  mutable short fLabParNotCalculated; // If lab frame variables (qinv, kT, LCMS q) were calculated
+  mutable double fQInvCalc;     // qinv
+  mutable double fKTCalc;       // pair kT
+  mutable double fMInvCalc;     // invariant mass
+  mutable double fQOutCMSCalc;  // q out in LCMS
+  mutable double fQSideCMSCalc; // q side in LCMS
+  mutable double fQLongCMSCalc; // q long in LCMS
+  void CalcLabPar() const;
  /* mutable double fDKSideGlobal;
   mutable double fDKOutGlobal;
   mutable double fDKLongGlobal;
@@ -229,6 +238,7 @@ private:
 inline void AliFemtoPair::ResetParCalculated(){
   fNonIdParNotCalculated=1;
   fNonIdParNotCalculatedGlobal=1;
+  fLabParNotCalculated=1;
   fMergingParNotCalculated=1;
   fMergingParNotCalculatedTrkV0Pos=1;
   fMergingParNotCalculatedTrkV0Neg=1;
@@ -267,8 +277,28 @@ inline double AliFemtoPair::KStar() const{
   return fKStarCalc;
 }
 inline double AliFemtoPair::QInv() const {
-  AliFemtoLorentzVector tDiff = (fTrack1->FourMomentum()-fTrack2->FourMomentum());
-  return ( -1.* tDiff.m());
+  if(fLabParNotCalculated) CalcLabPar();
+  return fQInvCalc;
+}
+inline double AliFemtoPair::KT() const {
+  if(fLabParNotCalculated) CalcLabPar();
+  return fKTCalc;
+}
+inline double AliFemtoPair::MInv() const {
+  if(fLabParNotCalculated) CalcLabPar();
+  return fMInvCalc;
+}
+inline double AliFemtoPair::QOutCMS() const {
+  if(fLabParNotCalculated) CalcLabPar();
+  return fQOutCMSCalc;
+}
+inline double AliFemtoPair::QSideCMS() const {
+  if(fLabParNotCalculated) CalcLabPar();
+  return fQSideCMSCalc;
+}
+inline double AliFemtoPair::QLongCMS() const {
+  if(fLabParNotCalculated) CalcLabPar();
+  return fQLongCMSCalc;
 }
 
 // Fabrice private <<<
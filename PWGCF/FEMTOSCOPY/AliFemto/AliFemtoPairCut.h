@@ -44,6 +44,11 @@ public:
   virtual void EventBegin(const AliFemtoEvent* aEvent);
   virtual void EventEnd(const AliFemtoEvent* aEvent);
 
+  /// Particle content (AliFemtoParticle::EMixingContent) used by Pass,
+  /// which has to be kept in a compact mixing buffer. The default keeps
+  /// everything, cuts using only the four-momenta can return less.
+  virtual unsigned int MixingContent() const { return AliFemtoParticle::kMixAll; }
+
   /// the following allows "back-pointing" from the CorrFctn to the "parent" Analysis
   AliFemtoAnalysis* HbtAnalysis(){return fyAnalysis;};
   void SetAnalysis(AliFemtoAnalysis* aAnalysis);    ///< Set back-pointer to Analysis
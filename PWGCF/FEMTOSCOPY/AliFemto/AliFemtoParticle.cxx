@@ -35,6 +35,7 @@ AliFemtoParticle::AliFemtoParticle() :
   fFourMomentum(),
   fHelix(),
   fHiddenInfo(NULL),
+  fVariationMask(0),
   fPrimaryVertex(),
   fSecondaryVertex(),
   fHelixV0Pos(),
@@ -56,6 +57,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
   fFourMomentum(aParticle.fFourMomentum),
   fHelix(aParticle.fHelix),
   fHiddenInfo(NULL),
+  fVariationMask(aParticle.fVariationMask),
   fPrimaryVertex(aParticle.fPrimaryVertex),
   fSecondaryVertex(aParticle.fSecondaryVertex),
   fHelixV0Pos(aParticle.fHelixV0Pos),
@@ -99,6 +101,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const do
   fFourMomentum(::sqrt(hbtTrack->P().Mag2() + mass*mass), hbtTrack->P()),
   fHelix(hbtTrack->Helix()),
   fHiddenInfo(NULL),
+  fVariationMask(0),
   fPrimaryVertex(),
   fSecondaryVertex(),
   fHelixV0Pos(),
@@ -133,6 +136,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoV0 *const hbtV0, const double &
   fFourMomentum(::sqrt(hbtV0->MomV0().Mag2() + mass*mass), hbtV0->MomV0()),
   fHelix(),
   fHiddenInfo(NULL),
+  fVariationMask(0),
   fPrimaryVertex(hbtV0->PrimaryVertex()),
   fSecondaryVertex(hbtV0->DecayVertexV0()),
   fHelixV0Pos(hbtV0->HelixPos()),
@@ -160,6 +164,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoKink *const hbtKink, const doub
 //   fNominalTpcExitPoint(0),
 //   fNominalTpcEntrancePoint(0),
   fHiddenInfo(NULL),
+  fVariationMask(0),
   fPrimaryVertex(),
   fSecondaryVertex(),
   fHelixV0Pos(),
@@ -184,6 +189,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoXi *const hbtXi, const double &
 //   fNominalTpcExitPoint(0),
 //   fNominalTpcEntrancePoint(0),
   fHiddenInfo(NULL),
+  fVariationMask(0),
   fPrimaryVertex(),
   fSecondaryVertex(),
   fHelixV0Pos(),
@@ -228,6 +234,7 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
 
   fPrimaryVertex = aParticle.fPrimaryVertex;
   fSecondaryVertex = aParticle.fSecondaryVertex;
+  fVariationMask = aParticle.fVariationMask;
 
     //   for (int iter=0; iter<11; iter++)
     //     fNominalPosSample[iter] = aParticle.fNominalPosSample[iter];
@@ -282,6 +289,39 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
 
   return *this;
 }
+//_____________________
+void AliFemtoParticle::StripForMixing(unsigned int aContent)
+{
+  // Release the copies not needed once the particle is in the mixing buffer
+  if (!(aContent & kMixTrack)) {
+    delete fTrack;
+    fTrack = NULL;
+  }
+  if (!(aContent & kMixV0)) {
+    delete fV0;
+    fV0 = NULL;
+    delete fKink;
+    fKink = NULL;
+    delete fXi;
+    fXi = NULL;
+  }
+  if (!(aContent & kMixHiddenInfo)) {
+    delete fHiddenInfo;
+    fHiddenInfo = NULL;
+  }
+}
+//_____________________
+size_t AliFemtoParticle::MemorySize() const
+{
+  // Size of the particle and of the objects it owns
+  size_t size = sizeof(AliFemtoParticle);
+  if (fTrack)      size += sizeof(AliFemtoTrack);
+  if (fV0)         size += sizeof(AliFemtoV0);
+  if (fKink)       size += sizeof(AliFemtoKink);
+  if (fXi)         size += sizeof(AliFemtoXi);
+  if (fHiddenInfo) size += sizeof(AliFemtoHiddenInfo);
+  return size;
+}
 // //_____________________
 // const AliFemtoThreeVector& AliFemtoParticle::NominalTpcExitPoint() const{
 //   // in future, may want to calculate this "on demand" only, sot this routine may get more sophisticated
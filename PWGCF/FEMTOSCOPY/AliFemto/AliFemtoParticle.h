@@ -23,6 +23,17 @@ class AliFemtoHiddenInfo;
 
 class AliFemtoParticle {
 public:
+  /// Content of the particle kept in a compact mixing buffer, see
+  /// AliFemtoSimpleAnalysis::SetCompactMixing. The four-momentum, helices,
+  /// vertices and purities are always kept.
+  enum EMixingContent {
+    kMixMomentum   = 0,       ///< only the members stored by value
+    kMixTrack      = 1 << 0,  ///< copy of the track
+    kMixV0         = 1 << 1,  ///< copies of the V0, kink and Xi
+    kMixHiddenInfo = 1 << 2,  ///< hidden (Monte Carlo) information
+    kMixAll        = kMixTrack | kMixV0 | kMixHiddenInfo
+  };
+
   AliFemtoParticle();
   AliFemtoParticle(const AliFemtoParticle &aParticle);
   AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const double &mass);
@@ -64,6 +75,19 @@ public:
 
   void ResetFourMomentum(const AliFemtoLorentzVector &fourMomentum);
 
+  /// Delete the owned copies which are not in the content mask
+  /// (a combination of EMixingContent)
+  void StripForMixing(unsigned int aContent);
+
+  /// Approximate memory used by the particle and its owned copies in bytes,
+  /// the hidden information is counted by the size of its base class only
+  size_t MemorySize() const;
+
+  /// Bit mask of the cut variations passed by the particle, see
+  /// AliFemtoCutScanAnalysis
+  ULong64_t VariationMask() const;
+  void SetVariationMask(ULong64_t aMask);
+
   const AliFemtoHiddenInfo* HiddenInfo() const;
 
   AliFemtoHiddenInfo* GetHiddenInfo() const;
@@ -102,6 +126,8 @@ private:
 
   double fPurity[6];  // Purity variables
 
+  ULong64_t fVariationMask; // Cut variations passed by the particle
+
   static double fgPrimPimPar0; // purity parameterization parameter
   static double fgPrimPimPar1; // purity parameterization parameter
   static double fgPrimPimPar2; // purity parameterization parameter
@@ -128,6 +154,16 @@ private:
   AliFemtoThreeVector fTpcV0NegExitPoint;     // negative V0 daughter exit point from TPC
 };
 
+inline ULong64_t AliFemtoParticle::VariationMask() const
+{
+  return fVariationMask;
+}
+
+inline void AliFemtoParticle::SetVariationMask(ULong64_t aMask)
+{
+  fVariationMask = aMask;
+}
+
 inline AliFemtoTrack *AliFemtoParticle::Track() const
 {
   return fTrack;
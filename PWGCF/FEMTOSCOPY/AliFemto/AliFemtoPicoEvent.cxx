@@ -195,4 +195,36 @@ AliFemtoPicoEvent& AliFemtoPicoEvent::operator=(const AliFemtoPicoEvent& aPicoEv
 
   return *this;
 }
-
+//_________________
+void AliFemtoPicoEvent::StripForMixing(unsigned int aContent)
+{
+  // Strip the particles of all collections down to the content
+  // (AliFemtoParticle::EMixingContent) used by the mixed pairs
+  AliFemtoParticleCollection* collections[3] = {fFirstParticleCollection,
+                                                fSecondParticleCollection,
+                                                fThirdParticleCollection};
+  for (int icoll=0; icoll<3; icoll++) {
+    if (!collections[icoll]) continue;
+    for (AliFemtoParticleIterator iter=collections[icoll]->begin();iter!=collections[icoll]->end();iter++){
+      (*iter)->StripForMixing(aContent);
+    }
+  }
+}
+//_________________
+size_t AliFemtoPicoEvent::MemorySize() const
+{
+  // Memory of the event, its collections and their particles. Each list
+  // node is counted as two links and the particle pointer.
+  size_t size = sizeof(AliFemtoPicoEvent);
+  const AliFemtoParticleCollection* collections[3] = {fFirstParticleCollection,
+                                                      fSecondParticleCollection,
+                                                      fThirdParticleCollection};
+  for (int icoll=0; icoll<3; icoll++) {
+    if (!collections[icoll]) continue;
+    size += sizeof(AliFemtoParticleCollection);
+    for (AliFemtoParticleConstIterator iter=collections[icoll]->begin();iter!=collections[icoll]->end();iter++){
+      size += 3*sizeof(void*) + (*iter)->MemorySize();
+    }
+  }
+  return size;
+}
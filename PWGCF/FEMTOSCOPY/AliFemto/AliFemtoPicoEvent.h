@@ -58,6 +58,9 @@ public:
   AliFemtoParticleCollection* SecondParticleCollection();
   AliFemtoParticleCollection* ThirdParticleCollection();
 
+  void StripForMixing(unsigned int aContent);  // keep only the content needed for mixing
+  size_t MemorySize() const;                   // approximate memory used by the event in bytes
+
 private:
   AliFemtoParticleCollection* fFirstParticleCollection;  // Collection of particles of type 1
   AliFemtoParticleCollection* fSecondParticleCollection; // Collection of particles of type 2
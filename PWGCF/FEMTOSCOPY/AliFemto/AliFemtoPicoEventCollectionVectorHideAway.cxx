@@ -128,3 +128,29 @@ AliFemtoPicoEventCollectionVectorHideAway& AliFemtoPicoEventCollectionVectorHide
 unsigned int AliFemtoPicoEventCollectionVectorHideAway::GetBinXNumber(double x) { return (int)floor( (x-fMinx)/fStepx ); }
 unsigned int AliFemtoPicoEventCollectionVectorHideAway::GetBinYNumber(double y) { return (int)floor( (y-fMiny)/fStepy ); }
 unsigned int AliFemtoPicoEventCollectionVectorHideAway::GetBinZNumber(double z) { return (int)floor( (z-fMinz)/fStepz ); }
+//___________________________________
+int AliFemtoPicoEventCollectionVectorHideAway::BinIndex(const AliFemtoPicoEventCollection* aCollection) const
+{
+  // linear bin number of a collection returned by PicoEventCollection
+  for (int bin=0; bin<(int)fCollectionVector.size(); bin++) {
+    if (fCollectionVector[bin] == aCollection) return bin;
+  }
+  return -1;
+}
+//___________________________________
+size_t AliFemtoPicoEventCollectionVectorHideAway::MemorySize(int bin) const
+{
+  // memory used by the events stored in the given bin
+  if (bin<0 || bin>=(int)fCollectionVector.size()) return 0;
+  return MemorySize(*fCollectionVector[bin]);
+}
+//___________________________________
+size_t AliFemtoPicoEventCollectionVectorHideAway::MemorySize(const AliFemtoPicoEventCollection& aCollection)
+{
+  // memory of a mixing buffer, each list node is counted as two links and the event pointer
+  size_t size = sizeof(AliFemtoPicoEventCollection);
+  for (AliFemtoPicoEventCollection::const_iterator iter=aCollection.begin(); iter!=aCollection.end(); iter++) {
+    size += 3*sizeof(void*) + (*iter)->MemorySize();
+  }
+  return size;
+}
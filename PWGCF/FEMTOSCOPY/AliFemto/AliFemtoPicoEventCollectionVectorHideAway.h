@@ -35,6 +35,12 @@ public:
   unsigned int GetBinXNumber(double x);
   unsigned int GetBinYNumber(double y);
   unsigned int GetBinZNumber(double z);
+
+  int NumberOfBins() const { return fBinsTot; }
+  int BinIndex(const AliFemtoPicoEventCollection* aCollection) const; // linear bin of a collection, -1 if not found
+  size_t MemorySize(int bin) const;                                  // approximate memory of the events in a bin
+
+  static size_t MemorySize(const AliFemtoPicoEventCollection& aCollection);
 private:
   int fBinsTot;                                        // Total number of bins 
   int fBinsx,fBinsy,fBinsz;                            // Number of bins on x, y, z axis
@@ -189,6 +189,15 @@ AliFemtoString AliFemtoQinvCorrFctn::Report(){
   return returnThis;
 }
 //____________________________
+unsigned int AliFemtoQinvCorrFctn::MixingContent() const
+{
+  // the tracks are only used by the deta-dphi* histograms
+  unsigned int content = fDetaDphiscal ? AliFemtoParticle::kMixTrack : AliFemtoParticle::kMixMomentum;
+  if (fPairCut)
+    content |= fPairCut->MixingContent();
+  return content;
+}
+//____________________________
 void AliFemtoQinvCorrFctn::AddRealPair(AliFemtoPair* pair){
   // add true pair
   if (fPairCut)
@@ -78,6 +78,7 @@ public:
   TH1D* Ratio();
 
   virtual TList* GetOutputList();
+  virtual unsigned int MixingContent() const;
   void Write();
 
 private:
@@ -9,6 +9,9 @@
 #include "AliFemtoXiCut.h"
 #include "AliFemtoXiTrackCut.h"
 #include "AliFemtoPicoEvent.h"
+#include "AliFemtoPicoEventCollectionVectorHideAway.h"
+
+#include <TH1D.h>
 
 #include <string>
 #include <iostream>
@@ -171,7 +174,18 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fUsePairPreCut(kFALSE),
+  fPairPreCutKtMin(0.0),
+  fPairPreCutKtMax(1e6),
+  fPairPreCutQinvMax(1e6),
+  fPairBlockSize(64),
+  fPairBuffer1(),
+  fPairBuffer2(),
+  fPairPreCutMask(),
+  fPairBlock(),
+  fCompactMixing(kFALSE),
+  fMixingBufferMemory(nullptr)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -193,7 +207,18 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fUsePairPreCut(a.fUsePairPreCut),
+  fPairPreCutKtMin(a.fPairPreCutKtMin),
+  fPairPreCutKtMax(a.fPairPreCutKtMax),
+  fPairPreCutQinvMax(a.fPairPreCutQinvMax),
+  fPairBlockSize(a.fPairBlockSize),
+  fPairBuffer1(),
+  fPairBuffer2(),
+  fPairPreCutMask(),
+  fPairBlock(),
+  fCompactMixing(a.fCompactMixing),
+  fMixingBufferMemory(nullptr)
 {
   /// Copy constructor
 
@@ -305,6 +330,12 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  for (auto &pair : fPairBlock) {
+    delete pair;
+  }
+
+  delete fMixingBufferMemory;
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -390,6 +421,12 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fUsePairPreCut = aAna.fUsePairPreCut;
+  fPairPreCutKtMin = aAna.fPairPreCutKtMin;
+  fPairPreCutKtMax = aAna.fPairPreCutKtMax;
+  fPairPreCutQinvMax = aAna.fPairPreCutQinvMax;
+  fPairBlockSize = aAna.fPairBlockSize;
+  fCompactMixing = aAna.fCompactMixing;
 
   return *this;
 }
@@ -429,6 +466,11 @@ AliFemtoString AliFemtoSimpleAnalysis::Report()
     report += cf->Report() + "\n";
   }
 
+  if (fCompactMixing) {
+    report += TString::Format("Compact mixing buffer: %u events per bin, particle content 0x%x\n",
+                              fNumEventsToMix, MixingContent());
+  }
+
   report += "-------------\n";
 
   return AliFemtoString((const char *)report);
@@ -518,6 +560,8 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     return;
   }
 
+  ParticleCollectionsFilled();
+
   //------ Make real pairs. If identical, make pairs for one collection ------//
   if (AnalyzeIdenticalParticles()) {
     collection2 = nullptr;
@@ -550,6 +594,12 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
     cout << " - mixed done   \n";
   }
 
+  if (fCompactMixing) {
+    AddToCompactMixingBuffer();
+    EventEnd(hbtEvent);  // cleanup for EbyE
+    return;
+  }
+
   //--------- If mixing buffer is full, delete oldest event ---------//
   if ( MixingBufferFull() ) {
     delete MixingBuffer()->back();
@@ -569,76 +619,73 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
                                        AliFemtoParticleCollection *partCollection2,
                                        Bool_t enablePairMonitors)
 {
-/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
-/// AddMixedPair() methods. If no second particle collection is
+/// Build pairs, check pair cuts, and call CFs' AddRealPairs() or
+/// AddMixedPairs() methods. If no second particle collection is
 /// specfied, make pairs within first particle collection.
 
   const string type = typeIn;
+  const bool isReal = (type == "real");
 
-  //  int swpart = ((long int) partCollection1) % 2;
+  if (!isReal && type != "mixed") {
+    cout << "Problem with pair type, type = " << type << endl;
+    return;
+  }
 
   // Used to swap particle 1 & 2 in identical-particle analysis
   // to avoid any implicit ordering in the event collection
   // "Seed" this here.
   bool swpart = fNeventsProcessed % 2;
 
-  // Setup iterator ranges
-  //
-  // The outer loop alway starts at beginning of particle collection 1.
-  // * If we are iterating over both particle collections, then the loop simply
-  // runs through both from beginning to end.
-  // * If we are only iterating over one particle collection, the inner loop
-  // loops over all particles between the outer iterator and the end of the
-  // collection. The outer loop must skip the last entry of the list.
-  AliFemtoParticleConstIterator tStartOuterLoop = partCollection1->begin(),
-                                tEndOuterLoop = partCollection1->end(),
-                                tStartInnerLoop,
-                                tEndInnerLoop;
-
-  if (partCollection2) {                         // Two collections:
-    tStartInnerLoop = partCollection2->begin();  //   Full inner & outer loops
-    tEndInnerLoop   = partCollection2->end();    //
-  }
-  else {                                         // One collection:
-    tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
-    tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
-  }
-
-  // Create the pair outside the loop - only allocate once
-  AliFemtoPair* tPair = new AliFemtoPair;
-
-  // Begin the outer loop
-  for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
-                                     tPartIter1 != tEndOuterLoop;
-                                     ++tPartIter1) {
-
-    // If analyzing identical particles, start inner loop at the particle
-    // after the current outer loop position, (loops until end)
-    if (!partCollection2) {
-      tStartInnerLoop = tPartIter1;
-      tStartInnerLoop++;
+  // Pack the particles and their momenta. If we are only iterating over
+  // one particle collection, the inner loop runs over all particles after
+  // the outer particle, and the outer loop skips the last entry.
+  fPairBuffer1.Fill(*partCollection1);
+  if (partCollection2) {
+    fPairBuffer2.Fill(*partCollection2);
+  }
+  const PairMomentumBuffer &outer = fPairBuffer1,
+                           &inner = partCollection2 ? fPairBuffer2 : fPairBuffer1;
+  const UInt_t nOuter = outer.Size(),
+               nInner = inner.Size();
+
+  // The pre-cut is skipped with pair monitors, which have to see all pairs
+  const bool usePreCut = fUsePairPreCut && !enablePairMonitors;
+  if (usePreCut && fPairPreCutMask.size() < nInner) {
+    fPairPreCutMask.resize(nInner);
+  }
+
+  // Create the pairs outside the loop - only allocate once
+  while (fPairBlock.size() < fPairBlockSize) {
+    fPairBlock.push_back(new AliFemtoPair);
+  }
+  UInt_t nBlock = 0;
+
+  for (UInt_t i = 0; i < nOuter; i++) {
+    const UInt_t jStart = partCollection2 ? 0 : i + 1;
+    if (jStart >= nInner) {
+      break;
     }
 
-    // If we have two collections - set the first track
-    if (partCollection2 != nullptr) {
-      tPair->SetTrack1(*tPartIter1);
+    if (usePreCut) {
+      PairKinematicPreCut(outer, i, inner, jStart);
     }
 
-    // Begin the inner loop
-    for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
-                                       tPartIter2 != tEndInnerLoop;
-                                     ++tPartIter2) {
-      // If we have two collections - only set the second track
-      if (partCollection2 != nullptr) {
-        tPair->SetTrack2(*tPartIter2);
-
-      // Swap between first and second particles to avoid biased ordering
-      } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
+    for (UInt_t j = jStart; j < nInner; j++) {
+      // Swap between first and second particles to avoid biased ordering,
+      // the sequence does not depend on the pre-cut
+      const bool swap = !partCollection2 && swpart;
+      if (!partCollection2) {
         swpart = !swpart;
       }
 
+      if (usePreCut && !fPairPreCutMask[j]) {
+        continue;
+      }
+
+      AliFemtoPair *tPair = fPairBlock[nBlock];
+      tPair->SetTrack1(swap ? inner.fParticle[j] : outer.fParticle[i]);
+      tPair->SetTrack2(swap ? outer.fParticle[i] : inner.fParticle[j]);
+
       // check if the pair passes the cut
       bool tmpPassPair = fPairCut->Pass(tPair);
 
@@ -647,23 +694,135 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
         fPairCut->FillCutMonitor(tPair, tmpPassPair);
       }
 
-      // If pair passes cut, loop over CF's and add pair to real/mixed
-      if (tmpPassPair) {
-        for (auto &tCorrFctn : *fCorrFctnCollection) {
-          if (type == "real")
-            tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
-            tCorrFctn->AddMixedPair(tPair);
-          else
-            cout << "Problem with pair type, type = " << type << endl;
-        } // loop over corellatoin functions
+      // If pair passes cut, keep it for the correlation functions
+      if (tmpPassPair && ++nBlock == fPairBlockSize) {
+        FlushPairBlock(isReal, nBlock);
+        nBlock = 0;
       }
-
     }    // loop over second particle
   }      // loop over first particle
 
-  // we are done with the pair
-  delete tPair;
+  FlushPairBlock(isReal, nBlock);
+}
+//_________________________
+void AliFemtoSimpleAnalysis::PairMomentumBuffer::Fill(const AliFemtoParticleCollection &collection)
+{
+  fParticle.clear();
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fE.clear();
+
+  for (auto particle : collection) {
+    const AliFemtoLorentzVector &p = particle->FourMomentum();
+    fParticle.push_back(particle);
+    fPx.push_back(p.px());
+    fPy.push_back(p.py());
+    fPz.push_back(p.pz());
+    fE.push_back(p.e());
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::PairKinematicPreCut(const PairMomentumBuffer &outer, UInt_t i,
+                                                 const PairMomentumBuffer &inner, UInt_t jStart)
+{
+  // Branch-free loop over the packed momenta, so that it can be
+  // vectorized by the compiler. Compares (2 kT)^2 and qinv^2.
+  const double px1 = outer.fPx[i],
+               py1 = outer.fPy[i],
+               pz1 = outer.fPz[i],
+               e1 = outer.fE[i];
+
+  const double ktMin2 = 4.0 * fPairPreCutKtMin * fPairPreCutKtMin,
+               ktMax2 = 4.0 * fPairPreCutKtMax * fPairPreCutKtMax,
+               qinvMax2 = fPairPreCutQinvMax * fPairPreCutQinvMax;
+
+  const double *px = &inner.fPx[0],
+               *py = &inner.fPy[0],
+               *pz = &inner.fPz[0],
+               *e = &inner.fE[0];
+  unsigned char *mask = &fPairPreCutMask[0];
+
+  const UInt_t n = inner.Size();
+  for (UInt_t j = jStart; j < n; j++) {
+    const double sx = px1 + px[j],
+                 sy = py1 + py[j];
+    const double kt2 = sx * sx + sy * sy;
+
+    const double dx = px1 - px[j],
+                 dy = py1 - py[j],
+                 dz = pz1 - pz[j],
+                 de = e1 - e[j];
+    const double qinv2 = dx * dx + dy * dy + dz * dz - de * de;
+
+    mask[j] = (kt2 >= ktMin2) & (kt2 <= ktMax2) & (qinv2 <= qinvMax2);
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::FlushPairBlock(bool isReal, UInt_t n)
+{
+  if (n == 0) {
+    return;
+  }
+
+  for (auto &tCorrFctn : *fCorrFctnCollection) {
+    if (isReal) {
+      tCorrFctn->AddRealPairs(&fPairBlock[0], n);
+    } else {
+      tCorrFctn->AddMixedPairs(&fPairBlock[0], n);
+    }
+  }
+}
+//_________________________
+unsigned int AliFemtoSimpleAnalysis::MixingContent() const
+{
+  unsigned int content = fPairCut->MixingContent();
+  for (auto &cf : *fCorrFctnCollection) {
+    content |= cf->MixingContent();
+  }
+  return content;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ParticleCollectionsFilled()
+{
+  /* no-op */
+}
+//_________________________
+void AliFemtoSimpleAnalysis::AddToCompactMixingBuffer()
+{
+  // Mixed pairs of this event are done - drop what they will not need
+  fPicoEvent->StripForMixing(MixingContent());
+
+  AliFemtoPicoEventCollection *buffer = MixingBuffer();
+
+  // Shrink if the number of events to mix was lowered
+  while (!buffer->empty() && buffer->size() > fNumEventsToMix) {
+    delete buffer->back();
+    buffer->pop_back();
+  }
+
+  // The list nodes of the bin are the slots of the ring: the slot of the
+  // oldest event is moved to the front and takes the new event
+  if (fNumEventsToMix == 0) {
+    delete fPicoEvent;
+    fPicoEvent = nullptr;
+  } else if (MixingBufferFull()) {
+    buffer->splice(buffer->begin(), *buffer, std::prev(buffer->end()));
+    delete buffer->front();
+    buffer->front() = fPicoEvent;
+  } else {
+    buffer->push_front(fPicoEvent);
+  }
+
+  if (fMixingBufferMemory) {
+    const int bin = fPicoEventCollectionVectorHideAway
+                  ? fPicoEventCollectionVectorHideAway->BinIndex(buffer)
+                  : 0;
+    const double memory = AliFemtoPicoEventCollectionVectorHideAway::MemorySize(*buffer) / 1024.0;
+    if (bin >= 0 && memory > fMixingBufferMemory->GetBinContent(bin + 1)) {
+      fMixingBufferMemory->SetBinContent(bin + 1, memory);
+    }
+  }
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
@@ -830,5 +989,17 @@ TList* AliFemtoSimpleAnalysis::GetOutputList()
     delete tListCf;
   }
 
+  if (fCompactMixing) {
+    if (!fMixingBufferMemory) {
+      const int nbins = fPicoEventCollectionVectorHideAway
+                      ? fPicoEventCollectionVectorHideAway->NumberOfBins()
+                      : 1;
+      fMixingBufferMemory = new TH1D("MixingBufferMemory",
+                                     "Peak memory of the mixing buffer;mixing bin;memory (kB)",
+                                     nbins, -0.5, nbins - 0.5);
+    }
+    tOutputList->Add(fMixingBufferMemory);
+  }
+
   return tOutputList;
 }
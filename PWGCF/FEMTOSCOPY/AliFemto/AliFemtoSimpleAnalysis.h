@@ -16,8 +16,11 @@
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
 
+#include <vector>
+
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
+class TH1D;
 
 ///
 /// \class AliFemtoSimpleAnalysis
@@ -99,6 +102,32 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Kinematic pre-selection of the pairs on kT and qinv
+  ///
+  /// The pre-selection is evaluated in MakePairs on packed four-momentum
+  /// arrays, before building the AliFemtoPair and calling the pair cut.
+  /// It only removes work and has to be looser than (or equal to) the cuts
+  /// of the pair cut and correlation functions. It is not applied when the
+  /// pair cut monitors are enabled, such that the monitors see every pair.
+  void SetPairKinematicPreCut(double ktMin, double ktMax, double qinvMax);
+  void UnsetPairKinematicPreCut();
+
+  /// Number of pairs passing the pair cut which are handed to the
+  /// correlation functions at once (see AliFemtoCorrFctn::AddRealPairs)
+  void SetPairBlockSize(UInt_t aSize);
+  UInt_t PairBlockSize() const;
+
+  /// Compact mixing buffer
+  ///
+  /// Events entering the mixing buffer keep only the particle content used
+  /// by the pair cut and the correlation functions (see
+  /// AliFemtoPairCut::MixingContent), the buffer of each mixing bin is used
+  /// as a ring of NumEventsToMix() slots, and the peak memory of each bin is
+  /// written to the output (histogram "MixingBufferMemory", in kB).
+  /// Only used by the ProcessEvent of this class.
+  void SetCompactMixing(Bool_t aCompact);
+  Bool_t CompactMixing() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -159,6 +188,35 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Packed particle pointers and four-momenta of a particle collection
+  struct PairMomentumBuffer {
+    std::vector<AliFemtoParticle*> fParticle;
+    std::vector<double> fPx, fPy, fPz, fE;
+
+    void Fill(const AliFemtoParticleCollection &collection);
+    UInt_t Size() const { return fParticle.size(); }
+  };
+
+  /// Evaluate the kinematic pre-cut for particle i of outer with particles
+  /// [jStart, inner.Size()) of inner, result in fPairPreCutMask
+  void PairKinematicPreCut(const PairMomentumBuffer &outer, UInt_t i,
+                           const PairMomentumBuffer &inner, UInt_t jStart);
+
+  /// Hand the first n pairs of fPairBlock to all correlation functions
+  virtual void FlushPairBlock(bool isReal, UInt_t n);
+
+  /// Union of the particle content used by the pair cut and the correlation
+  /// functions for mixed pairs
+  virtual unsigned int MixingContent() const;
+
+  /// Called in ProcessEvent once the particle collections of fPicoEvent are
+  /// filled and accepted, before any pair is made. Does nothing here.
+  virtual void ParticleCollectionsFilled();
+
+  /// Put fPicoEvent in the compact mixing buffer, replacing the oldest event
+  /// in its ring slot when the buffer is full, and record the bin memory
+  void AddToCompactMixingBuffer();
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -178,6 +236,20 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  Bool_t fUsePairPreCut;                             ///< Apply the kinematic pair pre-cut in MakePairs
+  Double_t fPairPreCutKtMin;                         ///< Minimum kT of the pair pre-cut
+  Double_t fPairPreCutKtMax;                         ///< Maximum kT of the pair pre-cut
+  Double_t fPairPreCutQinvMax;                       ///< Maximum qinv of the pair pre-cut
+  UInt_t fPairBlockSize;                             ///< Number of pairs handed to the correlation functions at once
+
+  PairMomentumBuffer fPairBuffer1;                   //!<! Packed particles of the outer collection in MakePairs
+  PairMomentumBuffer fPairBuffer2;                   //!<! Packed particles of the inner collection in MakePairs
+  std::vector<unsigned char> fPairPreCutMask;        //!<! Result of the kinematic pre-cut for the inner collection
+  std::vector<AliFemtoPair*> fPairBlock;             //!<! Pairs passing the pair cut, waiting for the correlation functions
+
+  Bool_t fCompactMixing;                             ///< Use the compact mixing buffer
+  TH1D* fMixingBufferMemory;                         //!<! Peak memory per mixing bin in kB, only with the compact mixing buffer
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
@@ -305,4 +377,37 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetPairKinematicPreCut(double ktMin, double ktMax, double qinvMax)
+{
+  fUsePairPreCut = kTRUE;
+  fPairPreCutKtMin = ktMin;
+  fPairPreCutKtMax = ktMax;
+  fPairPreCutQinvMax = qinvMax;
+}
+
+inline void AliFemtoSimpleAnalysis::UnsetPairKinematicPreCut()
+{
+  fUsePairPreCut = kFALSE;
+}
+
+inline void AliFemtoSimpleAnalysis::SetPairBlockSize(UInt_t aSize)
+{
+  fPairBlockSize = aSize > 0 ? aSize : 1;
+}
+
+inline UInt_t AliFemtoSimpleAnalysis::PairBlockSize() const
+{
+  return fPairBlockSize;
+}
+
+inline void AliFemtoSimpleAnalysis::SetCompactMixing(Bool_t aCompact)
+{
+  fCompactMixing = aCompact;
+}
+
+inline Bool_t AliFemtoSimpleAnalysis::CompactMixing() const
+{
+  return fCompactMixing;
+}
+
 #endif
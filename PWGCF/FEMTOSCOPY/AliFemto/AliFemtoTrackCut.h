@@ -25,6 +25,11 @@ public:
   AliFemtoTrackCut& operator=(const AliFemtoTrackCut&); ///< Assignment operator
 
   virtual bool Pass(const AliFemtoTrack* track) = 0;    ///< Returns true if passes, false if not
+
+  /// Quick preselection on quantities known before the conversion into an
+  /// AliFemtoTrack (see AliFemtoEventReaderAOD::AddTrackPreselection).
+  /// Has to be looser than or equal to Pass. The default accepts all tracks.
+  virtual bool PassPreselection(float pt, float eta, int charge) const;
   virtual AliFemtoParticleType Type();                  ///< Always returns hbtTrack
   virtual AliFemtoTrackCut* Clone();                    ///< Returns NULL - subclasses must overload this method to use
 
@@ -64,6 +69,11 @@ inline AliFemtoParticleType AliFemtoTrackCut::Type()
   return hbtTrack;
 }
 
+inline bool AliFemtoTrackCut::PassPreselection(float /* pt */, float /* eta */, int /* charge */) const
+{
+  return true;
+}
+
 inline AliFemtoTrackCut* AliFemtoTrackCut::Clone()
 {
   return NULL;
@@ -26,6 +26,11 @@ public:
   virtual bool Pass(const AliFemtoV0* aV0) = 0; ///< true if V0 passes, false if not
   virtual bool Pass(const AliFemtoXi* aXi) = 0; ///< true if Xi passes, false if not
 
+  /// Quick preselection on quantities known before the conversion into an
+  /// AliFemtoV0 (see AliFemtoEventReaderAOD::AddV0Preselection).
+  /// Has to be looser than or equal to Pass. The default accepts all V0s.
+  virtual bool PassPreselection(float /* pt */, float /* eta */) const { return true; }
+
   virtual AliFemtoParticleType Type() { return hbtV0; };
   virtual AliFemtoV0Cut* Clone() { return NULL; }; ///< WARNING - default implementation returns NULL
 
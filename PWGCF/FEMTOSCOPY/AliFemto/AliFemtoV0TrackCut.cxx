@@ -245,6 +245,15 @@ AliFemtoV0TrackCut* AliFemtoV0TrackCut::Clone()
 }
 
 
+//------------------------------
+bool AliFemtoV0TrackCut::PassPreselection(float pt, float eta) const
+{
+  // same kinematic cuts as in Pass, on the V0 before the conversion
+  if (TMath::Abs(eta) > fEta) return false;
+  if (pt < fPtMin || fPtMax < pt) return false;
+  return true;
+}
+
 //------------------------------
 bool AliFemtoV0TrackCut::Pass(const AliFemtoV0* aV0)
 {
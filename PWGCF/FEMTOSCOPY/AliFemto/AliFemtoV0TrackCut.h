@@ -40,6 +40,7 @@ public:
   virtual AliFemtoV0TrackCut* Clone();
 
   virtual bool Pass(const AliFemtoV0* aV0);
+  virtual bool PassPreselection(float pt, float eta) const;
 
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
@@ -12,6 +12,7 @@
 #pragma link C++ class AliFemtoLikeSignAnalysis+;
 #pragma link C++ class AliFemtoVertexAnalysis+;
 #pragma link C++ class AliFemtoVertexMultAnalysis+;
+#pragma link C++ class AliFemtoCutScanAnalysis+;
 #pragma link C++ class AliFemtoAnalysisAzimuthal+;
 #pragma link C++ class AliFemtoSimpleAnalysis+;
 #pragma link C++ class AliFemtoEventAnalysis+;
@@ -146,6 +146,15 @@ AliFemtoESDTrackCut::~AliFemtoESDTrackCut()
   /* noop */
 }
 //------------------------------
+bool AliFemtoESDTrackCut::PassPreselection(float pt, float eta, int charge) const
+{
+  // charge and kinematic cuts of Pass, before the track is converted
+  if (fCharge != 0 && charge != fCharge) return false;
+  if ((eta < fEta[0]) || (eta > fEta[1])) return false;
+  if ((pt < fPt[0]) || (pt > fPt[1])) return false;
+  return true;
+}
+//------------------------------
 bool AliFemtoESDTrackCut::Pass(const AliFemtoTrack* track)
 {
   //cout<<"AliFemtoESDTrackCut::Pass"<<endl;
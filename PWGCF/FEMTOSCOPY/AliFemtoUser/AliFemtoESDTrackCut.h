@@ -23,6 +23,7 @@ public:
   virtual ~AliFemtoESDTrackCut();
 
   virtual bool Pass(const AliFemtoTrack* aTrack);
+  virtual bool PassPreselection(float pt, float eta, int charge) const;
 
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
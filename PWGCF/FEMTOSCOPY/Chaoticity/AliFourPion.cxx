@@ -176,7 +176,8 @@ AliAnalysisTaskSE(),
   fWeightmuonCorrection(0x0),
   fqOutFcn(0x0),
   fqSideFcn(0x0),
-  fqLongFcn(0x0)
+  fqLongFcn(0x0),
+  fPairWeights()
 {
   // Default constructor
   for(Int_t mb=0; mb<fMbins; mb++){
@@ -393,7 +394,8 @@ AliFourPion::AliFourPion(const Char_t *name)
   fWeightmuonCorrection(0x0),
   fqOutFcn(0x0),
   fqSideFcn(0x0),
-  fqLongFcn(0x0)
+  fqLongFcn(0x0),
+  fPairWeights()
 {
   // Main constructor
   fAODcase=kTRUE;
@@ -615,7 +617,8 @@ AliFourPion::AliFourPion(const AliFourPion &obj)
     fWeightmuonCorrection(obj.fWeightmuonCorrection),
     fqOutFcn(obj.fqOutFcn),
     fqSideFcn(obj.fqSideFcn),
-    fqLongFcn(obj.fqLongFcn)
+    fqLongFcn(obj.fqLongFcn),
+    fPairWeights()
 {
   // Copy Constructor
   
@@ -3028,6 +3031,7 @@ void AliFourPion::UserExec(Option_t *)
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
+    fPairWeights.clear();// pair weights are cached for the current event and its mixed events only
     for(Int_t en2=0; en2<=1; en2++){// 2nd event number (en2=0 is the same event as current event)
       for(Int_t en3=en2; en3<=2; en3++){// 3rd event number
 	if(en2==0 && en3>2) continue;// not needed config
@@ -3397,9 +3401,9 @@ void AliFourPion::UserExec(Option_t *)
 		if(ENsum==6 && ch1==ch2 && ch1==ch3){
 		  Positive1stTripletWeights = kTRUE;
 		  //
-		  GetWeight(pVect1, pVect2, weight12, weight12Err);
-		  GetWeight(pVect1, pVect3, weight13, weight13Err);
-		  GetWeight(pVect2, pVect3, weight23, weight23Err);
+		  GetPairWeight(0, i, en2, j, pVect1, pVect2, weight12, weight12Err);
+		  GetPairWeight(0, i, en3, k, pVect1, pVect3, weight13, weight13Err);
+		  GetPairWeight(en2, j, en3, k, pVect2, pVect3, weight23, weight23Err);
 		  
 		  
 		  if(sqrt(fabs(weight12*weight13*weight23)) > 1.0) {// weight should never be larger than 1
@@ -3807,9 +3811,9 @@ void AliFourPion::UserExec(Option_t *)
 		  if(ch1==ch2 && ch1==ch3 && ch1==ch4 && ENsum==6 && !fMCcase){
 		    Positive2ndTripletWeights=kTRUE;
 		    //
-		    GetWeight(pVect1, pVect4, weight14, weight14Err);
-		    GetWeight(pVect2, pVect4, weight24, weight24Err);
-		    GetWeight(pVect3, pVect4, weight34, weight34Err);
+		    GetPairWeight(0, i, en4, l, pVect1, pVect4, weight14, weight14Err);
+		    GetPairWeight(en2, j, en4, l, pVect2, pVect4, weight24, weight24Err);
+		    GetPairWeight(en3, k, en4, l, pVect3, pVect4, weight34, weight34Err);
 		    
 		    if(fOnlineCorrection){
 		      Float_t MuonCorr14=1.0, MuonCorr24=1.0, MuonCorr34=1.0;
@@ -4467,6 +4471,20 @@ void AliFourPion::SetWeightArrays(Bool_t legoCase, TH3F *histos[AliFourPion::fKb
   
 }
 //________________________________________________________________________
+void AliFourPion::GetPairWeight(Int_t en1, Int_t index1, Int_t en2, Int_t index2, Float_t track1[], Float_t track2[], Float_t& wgt, Float_t& wgtErr){
+  // GetWeight of the pair (track index1 of event en1, track index2 of event en2).
+  // The same pairs enter many triplets and quadruplets, the interpolation is done once per event
+  Long64_t key = (Long64_t(en1*4 + en2) << 40) | (Long64_t(index1) << 20) | Long64_t(index2);
+  std::map<Long64_t, std::pair<Float_t,Float_t> >::const_iterator it = fPairWeights.find(key);
+  if(it != fPairWeights.end()){
+    wgt = it->second.first;
+    wgtErr = it->second.second;
+    return;
+  }
+  GetWeight(track1, track2, wgt, wgtErr);
+  fPairWeights[key] = std::make_pair(wgt, wgtErr);
+}
+//________________________________________________________________________
 void AliFourPion::GetWeight(Float_t track1[], Float_t track2[], Float_t& wgt, Float_t& wgtErr){
   
   Float_t kt=sqrt( pow(track1[1]+track2[1],2) + pow(track1[2]+track2[2],2))/2.;
@@ -33,6 +33,8 @@ class AliESDpid;
 #include "AliFourPionEventCollection.h"
 #include "AliCentrality.h"
 
+#include <map>
+
 class AliFourPion : public AliAnalysisTaskSE {
  public:
 
@@ -134,6 +136,7 @@ class AliFourPion : public AliAnalysisTaskSE {
   Float_t GetQinv(Float_t[], Float_t[]);
   void GetQosl(Float_t[], Float_t[], Float_t&, Float_t&, Float_t&);
   void GetWeight(Float_t[], Float_t[], Float_t&, Float_t&);
+  void GetPairWeight(Int_t, Int_t, Int_t, Int_t, Float_t[], Float_t[], Float_t&, Float_t&);
   Float_t FSICorrelation(Int_t, Int_t, Float_t);
   Float_t MCWeight(Int_t[2], Float_t, Float_t, Float_t, Float_t);
   Float_t MCWeightOSL(Int_t, Int_t, Int_t, Int_t, Float_t, Float_t, Float_t, Float_t);
@@ -402,6 +405,8 @@ class AliFourPion : public AliAnalysisTaskSE {
   TF1 *fqSideFcn; //!
   TF1 *fqLongFcn; //!
 
+  std::map<Long64_t, std::pair<Float_t,Float_t> > fPairWeights; //! weight and error of the pairs of the current event, see GetPairWeight
+
 
  public:
   TH2D *fMomResC2SC;
@@ -418,7 +423,7 @@ class AliFourPion : public AliAnalysisTaskSE {
   TF1 *ExchangeAmp[7][50][2];
 
  
-  ClassDef(AliFourPion, 1); 
+  ClassDef(AliFourPion, 2); 
 };
 
 #endif
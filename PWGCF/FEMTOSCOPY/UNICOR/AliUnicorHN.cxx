@@ -40,7 +40,8 @@ ClassImp(AliUnicorHN)
 //=============================================================================
 AliUnicorHN::AliUnicorHN(const char *nam, Int_t ndim, TAxis **ax) 
   : TH1D(nam, nam, Albins(ndim,ax), 0.5, Albins(ndim,ax)+0.5), 
-    fNdim(ndim) {
+    fNdim(ndim),
+    fBinCache(0) {
 
   // constructor
  
@@ -58,6 +59,7 @@ AliUnicorHN::AliUnicorHN(const char *nam, Int_t ndim, TAxis **ax)
   for (int i=0; i<fgkMaxNdim; i++) fNbins[i] = fAxis[i].GetNbins();
   for (int i=0; i<fgkMaxNdim; i++) fMbins[i] = 1;
   for (int i=fNdim-1; i>0; i--) fMbins[i-1] = fMbins[i]*fNbins[i];
+  InitBinCache();
   printf("   %d-dimensional histogram %s with %d bins created\n",fNdim,nam,GetNbinsX());
 }
 //=============================================================================
@@ -124,15 +126,39 @@ Int_t AliUnicorHN::MulToOne(const Int_t * const k) const {
   return n;
 }
 //=============================================================================
+void AliUnicorHN::InitBinCache() {
+
+  // Store the lower edge and the range of the fixed bin size axes, such 
+  // that their bin can be found without calling TAxis::FindFixBin. 
+
+  for (int i=0; i<fgkMaxNdim; i++) {
+    fXmin[i] = fAxis[i].GetXmin();
+    fXwidth[i] = (i<fNdim && !fAxis[i].IsVariableBinSize())? fAxis[i].GetXmax()-fXmin[i] : 0;
+  }
+  fBinCache = 1;
+}
+//=============================================================================
 Int_t AliUnicorHN::MulToOne(Double_t *x) {
 
   // Calculate the 1-dim index n from n-dim vector x, representing the 
   // abscissa of the n-dim histogram. The result will be between 0 and 
-  // GetNbinsX()-1. 
+  // GetNbinsX()-1. Return -1 if under- or overflow in any dimension. 
+  // For fixed bin size axes the bin is calculated here, with the same 
+  // arithmetic as TAxis::FindFixBin. 
 
-  Int_t k[fgkMaxNdim] = {0};
-  for (int i=0; i<fNdim; i++) k[i] = fAxis[i].FindFixBin(x[i])-1;
-  return MulToOne(k);
+  if (!fBinCache) InitBinCache();
+  Int_t n = 0;
+  for (int i=0; i<fNdim; i++) {
+    Int_t k;
+    if (fXwidth[i]>0) {
+      if (!(x[i]>=fXmin[i] && x[i]<fAxis[i].GetXmax())) return -1;
+      k = Int_t(fNbins[i]*(x[i]-fXmin[i])/fXwidth[i]);
+    }
+    else k = fAxis[i].FindFixBin(x[i])-1;
+    if (k<0 || k>=fNbins[i]) return -1;
+    n += fMbins[i]*k;
+  }
+  return n;
 }
 //=============================================================================
 void AliUnicorHN::OneToMul(Int_t n, Int_t *k) const {
@@ -149,6 +175,40 @@ void AliUnicorHN::OneToMul(Int_t n, Int_t *k) const {
   }
 }
 //=============================================================================
+Int_t AliUnicorHN::FirstBin(Int_t *k, Int_t *lo, Int_t *hi, const Int_t * const first, 
+			    const Int_t * const last) const {
+
+  // Start a loop over the bins between first[i] and last[i] (root convention, 
+  // 0 means no limit). Set the n-dim index k and its limits lo, hi (lowest 
+  // index 0) and return the 1-dim index of the first bin, -1 if the range 
+  // is empty. 
+
+  Int_t n = 0;
+  for (int i=0; i<fNdim; i++) {
+    lo[i] = (first && first[i]>0)? first[i]-1 : 0;
+    hi[i] = (last && last[i]>0 && last[i]<fNbins[i])? last[i]-1 : fNbins[i]-1;
+    if (lo[i]>hi[i]) return -1;
+    k[i] = lo[i];
+    n += fMbins[i]*k[i];
+  }
+  return n;
+}
+//=============================================================================
+Int_t AliUnicorHN::NextBin(Int_t n, Int_t *k, const Int_t * const lo, 
+			   const Int_t * const hi) const {
+
+  // Advance the n-dim index k within lo, hi, last dimension fastest, and 
+  // return the updated 1-dim index n, -1 at the end of the range. No 
+  // divisions are needed, unlike OneToMul. 
+
+  for (int i=fNdim-1; i>=0; i--) {
+    if (k[i]<hi[i]) {k[i]++; return n+fMbins[i];}
+    n -= fMbins[i]*(k[i]-lo[i]);
+    k[i] = lo[i];
+  }
+  return -1;
+}
+//=============================================================================
 Int_t AliUnicorHN::Fill(Double_t *xx, Double_t w) {
 
   // Fill the histogram. The array xx holds the abscissa information, w is the 
@@ -160,19 +220,6 @@ Int_t AliUnicorHN::Fill(Double_t *xx, Double_t w) {
   return TH1D::Fill(nbin+1,w); 
 }
 //=============================================================================
-Int_t AliUnicorHN::Fill(Double_t x0, Double_t x1, ...) {
-
-  // Fill the histogram. Arguments are passed as doubles rather than array. 
-
-  va_list ap;
-  Double_t xx[fgkMaxNdim] = {x0, x1};
-  va_start(ap,x1);
-  for (int i=2; i<fNdim; i++) xx[i] = va_arg(ap,Double_t);
-  Double_t weigth = va_arg(ap,Double_t);
-  va_end(ap);
-  return Fill(xx,weigth);
-}
-//=============================================================================
 Int_t AliUnicorHN::Save() const {
 
   // Save the 1-dim histo and the axes in a subdirectory on file. This might 
@@ -216,17 +263,20 @@ AliUnicorHN *AliUnicorHN::ProjectAlong(const char *nam, Int_t dim, Int_t first,
 
   // sum up the content and errors squared
 
-  int k[fgkMaxNdim] = {0}; // old hist multiindex
-  int m[fgkMaxNdim] = {0}; // new hist multiindex
-  for (int i=0; i<GetNbinsX(); i++) {
-    OneToMul(i,k);
-    if (k[dim]+1<first) continue;
-    if (k[dim]+1>last) continue;
+  // only the bins between first and last of dimension dim are visited
+
+  int k[fgkMaxNdim] = {0};  // old hist multiindex
+  int lo[fgkMaxNdim] = {0}; // old hist multiindex range
+  int hi[fgkMaxNdim] = {0};
+  int kfirst[fgkMaxNdim] = {0};
+  int klast[fgkMaxNdim] = {0};
+  kfirst[dim] = first;
+  klast[dim] = last;
+  for (int i=FirstBin(k,lo,hi,kfirst,klast); i>=0; i=NextBin(i,k,lo,hi)) {
     n = 0;
-    for (int j=0; j<fNdim; j++) if (j!=dim) m[n++] = k[j];
-    n = his->MulToOne(m);
+    for (int j=0, l=0; j<fNdim; j++) if (j!=dim) n += his->fMbins[l++]*k[j];
     his->AddBinContent(n+1,GetBinContent(i+1));
-    eis->AddBinContent(n+1,GetBinError(i+1)*GetBinError(i+1));
+    eis->AddBinContent(n+1,BinError2(i));
   }
 
   // combine content and errors in one histogram
@@ -262,18 +312,14 @@ TH1D *AliUnicorHN::ProjectOn(const char *nam, Int_t dim, const Int_t * const fir
   double *ey = new double[fNbins[dim]]; // error
   for (int i=0; i<fNbins[dim]; i++) yy[i]=0;
   for (int i=0; i<fNbins[dim]; i++) ey[i]=0;
-  Int_t *k = new Int_t[fNdim];
-  for (int i=0; i<GetNbinsX(); i++) {
-    OneToMul(i,k);
-    int isgood = 1; // bin within the range?
-    for (int j=0; j<fNdim; j++) {
-      if (first) if (first[j]) if (k[j]+1<first[j]) {isgood = 0; break;}
-      if (last)  if (last[j])  if (k[j]+1>last[j])  {isgood = 0; break;}
-    }
-    if (isgood) {
-      yy[k[dim]]+=GetBinContent(i+1);
-      ey[k[dim]]+=GetBinError(i+1)*GetBinError(i+1);
-    }
+  // only the bins within the range are visited
+
+  Int_t k[fgkMaxNdim] = {0};
+  Int_t lo[fgkMaxNdim] = {0};
+  Int_t hi[fgkMaxNdim] = {0};
+  for (int i=FirstBin(k,lo,hi,first,last); i>=0; i=NextBin(i,k,lo,hi)) {
+    yy[k[dim]]+=GetBinContent(i+1);
+    ey[k[dim]]+=BinError2(i);
   }
 
   // make the projection histogram
@@ -301,7 +347,6 @@ TH1D *AliUnicorHN::ProjectOn(const char *nam, Int_t dim, const Int_t * const fir
 
   delete [] yy;
   delete [] ey;
-  delete [] k;
   //  if (name!=nam) delete [] name;
 
   return his;
@@ -341,18 +386,14 @@ TH2D *AliUnicorHN::ProjectOn(const char *nam, Int_t dim0, Int_t dim1, const Int_
   for (int i=0; i<fNbins[dim0]; i++) ey[i] = new double[fNbins[dim1]]; 
   for (int i=0; i<fNbins[dim0]; i++) for (int j=0; j<fNbins[dim1]; j++) yy[i][j]=0;
   for (int i=0; i<fNbins[dim0]; i++) for (int j=0; j<fNbins[dim1]; j++) ey[i][j]=0;
-  Int_t *k = new Int_t[fNdim];
-  for (int i=0; i<GetNbinsX(); i++) {
-    OneToMul(i,k);
-    int isgood = 1; // bin within the range?
-    for (int j=0; j<fNdim; j++) {
-      if (first) if (first[j]) if (k[j]+1<first[j]) {isgood = 0; break;}
-      if (last)  if (last[j])  if (k[j]+1>last[j])  {isgood = 0; break;}
-    }
-    if (isgood) {
-      yy[k[dim0]][k[dim1]]+=GetBinContent(i+1);
-      ey[k[dim0]][k[dim1]]+=GetBinError(i+1)*GetBinError(i+1);
-    }
+  // only the bins within the range are visited
+
+  Int_t k[fgkMaxNdim] = {0};
+  Int_t lo[fgkMaxNdim] = {0};
+  Int_t hi[fgkMaxNdim] = {0};
+  for (int i=FirstBin(k,lo,hi,first,last); i>=0; i=NextBin(i,k,lo,hi)) {
+    yy[k[dim0]][k[dim1]]+=GetBinContent(i+1);
+    ey[k[dim0]][k[dim1]]+=BinError2(i);
   }
 
   // make the projection histogram
@@ -397,7 +438,6 @@ TH2D *AliUnicorHN::ProjectOn(const char *nam, Int_t dim0, Int_t dim1, const Int_
   for (int i=0; i<fNbins[dim0]; i++) delete [] ey[i];
   delete [] yy;
   delete [] ey;
-  delete [] k;
   //  if (name!=nam) delete [] name;
 
   return his;
@@ -11,6 +11,7 @@
 // multidimensional histogram 
 //=============================================================================
 
+#include <cmath>
 #include <TH1.h>
 class TH2D;
 class TAxis;
@@ -20,7 +21,7 @@ class AliUnicorHN : public TH1D {
 
  public:
   AliUnicorHN(const char *nam="muhi", Int_t ndim=0, TAxis **ax=0);     // constructor
-  AliUnicorHN(TRootIOCtor *) : TH1D(), fNdim(0) {for (int i=0; i<fgkMaxNdim; i++) fNbins[i]=fMbins[i]=0;}  // default constructor
+  AliUnicorHN(TRootIOCtor *) : TH1D(), fNdim(0), fBinCache(0) {for (int i=0; i<fgkMaxNdim; i++) fNbins[i]=fMbins[i]=0;}  // default constructor
   virtual ~AliUnicorHN() {}                                            // destructor
   static AliUnicorHN* Retrieve(const char *filnam, const char *nam);   // read from file
 
@@ -30,7 +31,25 @@ class AliUnicorHN : public TH1D {
   Int_t Fill(Double_t *xx, Double_t y=1);   // fill histo
   Int_t Fill(Double_t)                      {return -1;} // insufficient number of arguments
   Int_t Fill(Double_t x0, Double_t w)       {Double_t x[1]={x0}; return Fill(x,w);} // 1-dim histo fill
-  Int_t Fill(Double_t x0, Double_t x1, ...);// 2 or more dim histo fill
+  // 2 or more dim histo fill; the last argument is the weight
+  Int_t Fill(Double_t x0, Double_t x1, Double_t w) 
+    {Double_t x[2]={x0,x1}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t w) 
+    {Double_t x[3]={x0,x1,x2}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t w) 
+    {Double_t x[4]={x0,x1,x2,x3}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t x4, Double_t w) 
+    {Double_t x[5]={x0,x1,x2,x3,x4}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t x4, Double_t x5, Double_t w) 
+    {Double_t x[6]={x0,x1,x2,x3,x4,x5}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t x4, Double_t x5, Double_t x6, Double_t w) 
+    {Double_t x[7]={x0,x1,x2,x3,x4,x5,x6}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t x4, Double_t x5, Double_t x6, Double_t x7, Double_t w) 
+    {Double_t x[8]={x0,x1,x2,x3,x4,x5,x6,x7}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t x4, Double_t x5, Double_t x6, Double_t x7, Double_t x8, Double_t w) 
+    {Double_t x[9]={x0,x1,x2,x3,x4,x5,x6,x7,x8}; return Fill(x,w);}
+  Int_t Fill(Double_t x0, Double_t x1, Double_t x2, Double_t x3, Double_t x4, Double_t x5, Double_t x6, Double_t x7, Double_t x8, Double_t x9, Double_t w) 
+    {Double_t x[10]={x0,x1,x2,x3,x4,x5,x6,x7,x8,x9}; return Fill(x,w);}
   Int_t Fill(const char*, Double_t)         {return -1;} // overload TH1
 
   Int_t Save() const;                      // save histo and axis on file 
@@ -55,6 +74,14 @@ class AliUnicorHN : public TH1D {
   static Int_t Albins(Int_t n, TAxis **ax);     // product of nbins of ax[0]...ax[n-1]
   Int_t MulToOne(const Int_t * const k) const;  // calc 1-dim index from n-dim indices
   Int_t MulToOne(Double_t *x);                  // calc 1-dim index from n-dim vector
+  void  InitBinCache();                         // fill fXmin, fXwidth
+  Int_t FirstBin(Int_t *k, Int_t *lo, Int_t *hi, const Int_t * const first, const Int_t * const last) const; // start range loop
+  Int_t NextBin(Int_t n, Int_t *k, const Int_t * const lo, const Int_t * const hi) const; // next bin of range loop
+  Double_t BinError2(Int_t n) const             {return fSumw2.fN? fSumw2.fArray[n+1] : fabs(fArray[n+1]);} // error^2 of 1-dim index n
+
+  Bool_t             fBinCache;                 //! fXmin and fXwidth are valid
+  Double_t           fXmin[fgkMaxNdim];         //! lower edge of fixed bin size axes
+  Double_t           fXwidth[fgkMaxNdim];       //! range of fixed bin size axes, 0 for variable bin size
 
   ClassDef(AliUnicorHN,1)
 };
@@ -26,6 +26,7 @@
 #pragma link C++ class AliDielectronV0Cuts+;
 #pragma link C++ class AliDielectronTrackCuts+;
 #pragma link C++ class AliDielectronPairLegCuts+;
+#pragma link C++ class AliDielectronPairKineCuts+;
 #pragma link C++ class AliDielectronSignalBase+;
 #pragma link C++ class AliDielectronSignalExt+;
 #pragma link C++ class AliDielectronSignalFunc+;
@@ -63,6 +63,7 @@
 
 #include "AliAnalysisTaskElectronEfficiency.h"
 #include <bitset>
+#include <algorithm>
 
 ClassImp(AliAnalysisTaskElectronEfficiency)
 
@@ -282,7 +283,11 @@ pxMC(-1.),
 pyMC(-1.),
 pzMC(-1.),
 fSelectedByCut(0),
-fSelectedByExtraCut(0)
+fSelectedByExtraCut(0),
+fvCriteria(),
+fvCriteriaIndex(),
+fvTrackCutMask(),
+fvLabelTrack()
 {
   /// Default Constructor
 fSingleEff.SetOwner();
@@ -501,7 +506,11 @@ pxMC(-1.),
 pyMC(-1.),
 pzMC(-1.),
 fSelectedByCut(0),
-fSelectedByExtraCut(0)
+fSelectedByExtraCut(0),
+fvCriteria(),
+fvCriteriaIndex(),
+fvTrackCutMask(),
+fvLabelTrack()
 {
   /// Constructor
 
@@ -563,6 +572,10 @@ void AliAnalysisTaskElectronEfficiency::UserCreateOutputObjects()
     std::cout << "  phiEleResArr: " << fPhiEleResArr << std::endl;
     std::cout << "  phiPosResArr: " << fPhiPosResArr << std::endl;
   }
+  /// The cut sets are stored as bits per track
+  if(fvTrackCuts.size() > 32) {
+    AliFatal(Form("At most 32 cut sets are supported, %d attached!", (Int_t)fvTrackCuts.size()));
+  }
   /// Check if an MC signal was attached
   if(!fSignalsMC) {
     AliFatal("Task needs an AliDielectronSignalMC as basis for the electron selection!"
@@ -1162,6 +1175,9 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
     Int_t nMCtracks = mcEvent->GetNumberOfTracks();
     //AliStack *fStack = mcEvent->Stack();
 
+    // evaluate all tracks once against the cut sets
+    FillTrackCutMasks();
+
     for(Int_t iMCtrack = 0; iMCtrack < nMCtracks; iMCtrack++){
       // New:
       // Select electrons based on an attached AliDielectronSignalMC.
@@ -1185,14 +1201,15 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
       }
       Bool_t bFilled(kFALSE);
 
-      for (Int_t iTracks = 0; iTracks < fESD->GetNumberOfTracks(); iTracks++){
+      // only the tracks with this label, in the order of the ESD
+      std::vector< std::pair<Int_t,Int_t> >::const_iterator itLabel = std::lower_bound(fvLabelTrack.begin(), fvLabelTrack.end(), std::make_pair(iMCtrack, -1));
+      for (; itLabel != fvLabelTrack.end() && itLabel->first == iMCtrack; ++itLabel){
+        Int_t iTracks = itLabel->second;
         fSelectedByCut = 0;
         fSelectedByExtraCut = 0;
         AliESDtrack* track = fESD->GetTrack(iTracks);
-        if (!track) { Printf("ERROR: Could not receive track %d", iTracks); continue; }
         Int_t label = track->GetLabel();
         Int_t abslabel = TMath::Abs( track->GetLabel() );
-        if(abslabel != iMCtrack) continue;
         if(mctrack->Charge()/3 != track->Charge()) continue;
 
         Double_t trackPt  = track->Pt();
@@ -1207,28 +1224,24 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
           else                      fNgen2_Rec_Pos ->Fill(trackPt,trackEta,trackPhi);
           bFilled = kTRUE;
         }
+        // Check for TOF Mismatch, rejected for TOFRequire cutsettings
+        // Int_t fMCTOFMatch = -99;
+        Bool_t TOFmismatch = kFALSE;
+        if (fvIsTOFrequireCut.size() > 0){ // If "IsTOFrequire"-vector filled? If not assume it to be TOFif cut
+          Bool_t TOFout = !((track->GetStatus()&AliVTrack::kTOFout) == 0);
+          Bool_t TIME   = !((track->GetStatus()&AliVTrack::kTIME) == 0);
+          Int_t TOFTrkLabel[3] = {-1};//This can contain three particles wich occupy the same cluster
+          track->GetTOFLabel(TOFTrkLabel);// Gets the labels of the tracks matched to the TOF, this can be used to remove
+                                          // the mismatch and to compute the efficiency! The label to check is the first
+                                          // one, the others can come from different tracks
+          TOFmismatch = (abslabel != TOFTrkLabel[0] && (TOFout && TIME)); // Mismatch and PID info available
+        }
+
+        UInt_t trackCutMask = fvTrackCutMask.at(iTracks);
         for (UInt_t iCut=0; iCut<GetNCutsets(); ++iCut){ // loop over all specified cutInstances
-          //cutting logic taken from AliDielectron::FillTrackArrays()
-          UInt_t selectedMask=(1<<fvTrackCuts.at(iCut)->GetCuts()->GetEntries())-1;
-          //apply track cuts
-          UInt_t cutMask=fvTrackCuts.at(iCut)->IsSelected(track);
-          if (cutMask!=selectedMask) continue;
-
-
-          // Check for TOF Mismatch and reject for TOFRequire cutsettings
-          // Int_t fMCTOFMatch = -99;
-          if (fvIsTOFrequireCut.size() > 0){ // If "IsTOFrequire"-vector filled? If not assume it to be TOFif cut
-            Bool_t TOFout = !((track->GetStatus()&AliVTrack::kTOFout) == 0);
-            Bool_t TIME   = !((track->GetStatus()&AliVTrack::kTIME) == 0);
-            Int_t TOFTrkLabel[3] = {-1};//This can contain three particles wich occupy the same cluster
-            track->GetTOFLabel(TOFTrkLabel);// Gets the labels of the tracks matched to the TOF, this can be used to remove
-                                            // the mismatch and to compute the efficiency! The label to check is the first
-                                            // one, the others can come from different tracks
-
-            if (abslabel != TOFTrkLabel[0] && (TOFout && TIME) && (fvIsTOFrequireCut.at(iCut) == kTRUE)) { // Mismatch and PID info available and TOFrequire
-              continue;
-            }
-          }
+          // track cuts, evaluated in FillTrackCutMasks()
+          if (!(trackCutMask & 1<<iCut)) continue;
+          if (TOFmismatch && fvIsTOFrequireCut.at(iCut) == kTRUE) continue;
 
           vecEleCand_perCut.at(iCut).push_back(iTracks);
           if(track->Charge() < 0){
@@ -1456,7 +1469,7 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
         if(grmLab >= 0) grmother = dynamic_cast<AliMCParticle*> (mcEvent->GetTrack(grmLab));
         Int_t grmPDG(0);
         if(grmother) grmPDG = grmother->PdgCode();
-        LMEEparticle lmeeLeg(GetNCutsets());
+        LMEEparticle lmeeLeg;
         lmeeLeg.genP     = part->P();
         lmeeLeg.genPt    = part->Pt();
         lmeeLeg.genTheta = part->Theta();
@@ -1466,17 +1479,10 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
         lmeeLeg.mPDG     = mPDG;
         lmeeLeg.grmlabel = grmLab;
         lmeeLeg.grmPDG   = grmPDG;
-        for(Int_t iESD = 0; iESD < fESD->GetNumberOfTracks(); ++iESD){
-          AliESDtrack *track = fESD->GetTrack(iESD);
-          if(!track){ Printf("ERROR: Could not receive track %d", iESD); continue; }
-          if(TMath::Abs(track->GetLabel()) != iMC) continue;
-          for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut){ // loop over all specified cutInstances
-            UInt_t selectedMask=(1<<fvTrackCuts.at(iCut)->GetCuts()->GetEntries())-1;
-            UInt_t cutMask=fvTrackCuts.at(iCut)->IsSelected(track);
-            if(cutMask==selectedMask)
-              lmeeLeg.vbRec.at(iCut) = kTRUE;
-          } // cut loop
-        } // ESD loop
+        // cut sets passed by any track of this particle
+        std::vector< std::pair<Int_t,Int_t> >::const_iterator itLabel = std::lower_bound(fvLabelTrack.begin(), fvLabelTrack.end(), std::make_pair(iMC, -1));
+        for(; itLabel != fvLabelTrack.end() && itLabel->first == iMC; ++itLabel)
+          lmeeLeg.recMask |= fvTrackCutMask.at(itLabel->second);
         if(fCalcEfficiencyRec){
           if(fPhiEleResArr && fPhiPosResArr){
             Double_t phiSmearing = 0.;
@@ -1517,6 +1523,7 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
             Bool_t bAccGen2 = it2->genPt > fPtMinCut && it2->genPt < fPtMaxCut && it2->genEta < fEtaMaxCut && it2->genEta > fEtaMinCut;
             Bool_t bAccRec2 = it2->recPt > fPtMinCut && it2->recPt < fPtMaxCut && it2->recEta < fEtaMaxCut && it2->recEta > fEtaMinCut;
             if(!(bAccGen2 || bAccRec2)) continue;
+            UInt_t pairMask = it1->recMask & it2->recMask; // cut sets passed by both legs
             Bool_t charm2  =  TMath::Abs(it2->mPDG) > 400 && TMath::Abs(it2->mPDG) < 440 && !(TMath::Abs(it2->grmPDG) > 500 && TMath::Abs(it2->grmPDG) < 550);
             Bool_t beauty2 = (TMath::Abs(it2->mPDG) > 400 && TMath::Abs(it2->mPDG) < 440 && TMath::Abs(it2->grmPDG) > 500  && TMath::Abs(it2->grmPDG) < 550) || (TMath::Abs(it2->mPDG) > 500 && TMath::Abs(it2->mPDG) < 550);
             if(fCalcEfficiencyGen && bAccGen1 && bAccGen2){
@@ -1525,26 +1532,26 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
               if(it1->mlabel == it2->mlabel){
                 fNgenPairsResonances->Fill(mee,ptee);
                 for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
-                  if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsResonances.at(iCut)->Fill(mee,ptee);
+                  if(pairMask & 1<<iCut) fvRecoPairsResonances.at(iCut)->Fill(mee,ptee);
               }
               else{
                 fNgenPairsDiffMothers->Fill(mee,ptee);
                 for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
-                  if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsDiffMothers.at(iCut)->Fill(mee,ptee);
+                  if(pairMask & 1<<iCut) fvRecoPairsDiffMothers.at(iCut)->Fill(mee,ptee);
                 if(charm1 && charm2){
                   fNgenPairsCharm ->Fill(mee,ptee);
                   for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
-                    if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsCharm.at(iCut)->Fill(mee,ptee);
+                    if(pairMask & 1<<iCut) fvRecoPairsCharm.at(iCut)->Fill(mee,ptee);
                 }
                 if(beauty1 && beauty2){
                   fNgenPairsBeauty->Fill(mee,ptee);
                   for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
-                    if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsBeauty.at(iCut)->Fill(mee,ptee);
+                    if(pairMask & 1<<iCut) fvRecoPairsBeauty.at(iCut)->Fill(mee,ptee);
                 }
                 if((charm1 || beauty1) && (charm2 || beauty2)){
                   fNgenPairsHF->Fill(mee,ptee);
                   for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
-                    if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsHF.at(iCut)->Fill(mee,ptee);
+                    if(pairMask & 1<<iCut) fvRecoPairsHF.at(iCut)->Fill(mee,ptee);
                 }
               }
             }
@@ -1555,7 +1562,7 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
                 fNgenPairsRecResonances->Fill(mee,ptee);
                 for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
                 {
-                  if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsRecResonances.at(iCut)->Fill(mee,ptee);
+                  if(pairMask & 1<<iCut) fvRecoPairsRecResonances.at(iCut)->Fill(mee,ptee);
                   if (fDoWeighting && static_cast<TH3D *> (fSingleEff.At(iCut)))       fvGenPairsWeightedResonances.at(iCut)->Fill(mee,ptee,GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it1->recPt,it1->recEta,it1->recPhi)*GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it2->recPt,it2->recEta,it2->recPhi));
                 }
               }
@@ -1563,21 +1570,21 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
                 fNgenPairsRecDiffMothers->Fill(mee,ptee);
                 for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
                 {
-                  if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsRecDiffMothers.at(iCut)->Fill(mee,ptee);
+                  if(pairMask & 1<<iCut) fvRecoPairsRecDiffMothers.at(iCut)->Fill(mee,ptee);
                   if (fDoWeighting && static_cast<TH3D *> (fSingleEff.At(iCut))) fvGenPairsWeightedDiffMothers.at(iCut)->Fill(mee,ptee,GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it1->recPt,it1->recEta,it1->recPhi)*GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it2->recPt,it2->recEta,it2->recPhi));
                 }
                 if(charm1 && charm2){
                   fNgenPairsRecCharm ->Fill(mee,ptee);
                   for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
                   {
-                    if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsRecCharm.at(iCut)->Fill(mee,ptee);
+                    if(pairMask & 1<<iCut) fvRecoPairsRecCharm.at(iCut)->Fill(mee,ptee);
                     if (fDoWeighting && static_cast<TH3D *> (fSingleEff.At(iCut))) fvGenPairsWeightedCharm.at(iCut)->Fill(mee,ptee,GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it1->recPt,it1->recEta,it1->recPhi)*GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it2->recPt,it2->recEta,it2->recPhi));
                   }
                 }
                 if(beauty1 && beauty2){
                   fNgenPairsRecBeauty->Fill(mee,ptee);
                   for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut){
-                    if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsRecBeauty.at(iCut)->Fill(mee,ptee);
+                    if(pairMask & 1<<iCut) fvRecoPairsRecBeauty.at(iCut)->Fill(mee,ptee);
                     if (fDoWeighting && static_cast<TH3D *> (fSingleEff.At(iCut))) fvGenPairsWeightedBeauty.at(iCut)->Fill(mee,ptee,GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it1->recPt,it1->recEta,it1->recPhi)*GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it2->recPt,it2->recEta,it2->recPhi));
                   }
                 }
@@ -1585,7 +1592,7 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
                   fNgenPairsRecHF->Fill(mee,ptee);
                   for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut)
                   {
-                    if(it1->vbRec.at(iCut) && it2->vbRec.at(iCut)) fvRecoPairsRecHF.at(iCut)->Fill(mee,ptee);
+                    if(pairMask & 1<<iCut) fvRecoPairsRecHF.at(iCut)->Fill(mee,ptee);
                     if (fDoWeighting && static_cast<TH3D *> (fSingleEff.At(iCut))) fvGenPairsWeightedHF.at(iCut)->Fill(mee,ptee,GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it1->recPt,it1->recEta,it1->recPhi)*GetSingleEff(static_cast<TH3D *> (fSingleEff.At(iCut)),it2->recPt,it2->recEta,it2->recPhi));
                   }
                 }
@@ -1706,6 +1713,66 @@ void AliAnalysisTaskElectronEfficiency::UserExec(Option_t *)
   //Printf("__________ end of Event ( %i ) __________", fEventcount);
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskElectronEfficiency::FillTrackCutMasks()
+{
+  /// Cut bitmap pass: every ESD track is evaluated once against all criteria of the attached cut sets.
+  /// Criteria shared between cut sets (the same AliAnalysisCuts object attached to several AliAnalysisFilters)
+  /// are evaluated once per track. The result is stored per track as bit mask of the cut sets it passes
+  /// ('fvTrackCutMask'), from which the single-leg and pair efficiencies of all cut sets are filled.
+  /// The tracks are also indexed by their MC label ('fvLabelTrack'), to avoid looping over all tracks for each MC electron.
+
+  // distinct criteria, collected once
+  if(fvCriteriaIndex.size() != fvTrackCuts.size()){
+    fvCriteria.clear();
+    fvCriteriaIndex.clear();
+    for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut){
+      std::vector<Int_t> vIndex;
+      TIter nextCut(fvTrackCuts.at(iCut)->GetCuts());
+      AliAnalysisCuts *cuts = 0x0;
+      while( (cuts = static_cast<AliAnalysisCuts*>(nextCut())) ){
+        std::vector<AliAnalysisCuts*>::iterator it = std::find(fvCriteria.begin(), fvCriteria.end(), cuts);
+        vIndex.push_back(it - fvCriteria.begin());
+        if(it == fvCriteria.end()) fvCriteria.push_back(cuts);
+      }
+      fvCriteriaIndex.push_back(vIndex);
+    }
+  }
+
+  Int_t nTracks = fESD->GetNumberOfTracks();
+  fvTrackCutMask.assign(nTracks, 0);
+  fvLabelTrack.clear();
+  std::vector<Bool_t> vAccepted(fvCriteria.size(), kFALSE);
+  for(Int_t iTracks = 0; iTracks < nTracks; iTracks++){
+    AliESDtrack* track = fESD->GetTrack(iTracks);
+    if (!track) { Printf("ERROR: Could not receive track %d", iTracks); continue; }
+    fvLabelTrack.push_back(std::make_pair(TMath::Abs(track->GetLabel()), iTracks));
+
+    for(UInt_t iCrit=0; iCrit<fvCriteria.size(); ++iCrit) vAccepted[iCrit] = fvCriteria[iCrit]->IsSelected(track);
+
+    UInt_t trackCutMask = 0;
+    for(UInt_t iCut=0; iCut<fvTrackCuts.size(); ++iCut){
+      // same logic as AliAnalysisFilter::IsSelected(), on the cached criteria
+      const std::vector<Int_t> &vIndex = fvCriteriaIndex[iCut];
+      UInt_t cutMask = 0;
+      for(UInt_t i=0; i<vIndex.size(); ++i){
+        AliAnalysisCuts *cuts = fvCriteria[vIndex[i]];
+        Bool_t acc = vAccepted[vIndex[i]];
+        UInt_t filterMask = cuts->GetFilterMask();
+        if(filterMask > 0) acc = (acc && (filterMask == cutMask));
+        cuts->SetSelected(acc);
+        if(acc) cutMask |= (1<<i) & 0x00ffffff;
+      }
+      //cutting logic taken from AliDielectron::FillTrackArrays()
+      UInt_t selectedMask=(1<<vIndex.size())-1;
+      if(cutMask==selectedMask) trackCutMask |= 1<<iCut;
+    }
+    fvTrackCutMask[iTracks] = trackCutMask;
+  }
+  // sorted by label and, for the same label, by track index
+  std::sort(fvLabelTrack.begin(), fvLabelTrack.end());
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskElectronEfficiency::CalcPrefilterEff(AliMCEvent* mcEventLocal, const std::vector< std::vector<Int_t> > & vvEleCand, const std::vector<Bool_t> & vbEleExtra)
 {
@@ -52,6 +52,7 @@
 #include "THnSparse.h"
 #include "THn.h"
 #include <vector>
+#include <utility>
 #include "AliAnalysisCuts.h"
 #include "AliAnalysisFilter.h"
 #include "TParticlePDG.h"
@@ -162,6 +163,7 @@ class AliAnalysisTaskElectronEfficiency : public AliAnalysisTaskSE {
 
  private:
   void          CalcPrefilterEff(AliMCEvent* mcEventLocal, const std::vector< std::vector<Int_t> > & vvEleCand, const std::vector<Bool_t> & vbEleExtra);
+  void          FillTrackCutMasks();
   Double_t      PhivPair(Double_t MagField, Int_t charge1, Int_t charge2, TVector3 dau1, TVector3 dau2);
   const char*   GetParticleName(Int_t pdg) {
     /**/          TParticlePDG* p1 = TDatabasePDG::Instance()->GetParticle(pdg);
@@ -275,13 +277,13 @@ class AliAnalysisTaskElectronEfficiency : public AliAnalysisTaskSE {
     Int_t mPDG;
     Int_t grmlabel;
     Int_t grmPDG;
-    std::vector<Bool_t> vbRec;
+    UInt_t recMask;   // bit mask of the cut sets passed by a track of this particle
     TLorentzVector genLv;
     TLorentzVector recLv;
     // functions
-    LMEEparticle(Int_t Ncuts=0) : genP(-99.),genPt(-99.),genTheta(-99.),genEta(-99.),genPhi(-99.),
-                                  recP(-99.),recPt(-99.),recTheta(-99.),recEta(-99.),recPhi(-99.),
-                                  mlabel(-1),mPDG(-1),grmlabel(-1),grmPDG(-1),vbRec(Ncuts,kFALSE),genLv(),recLv()
+    LMEEparticle() : genP(-99.),genPt(-99.),genTheta(-99.),genEta(-99.),genPhi(-99.),
+                     recP(-99.),recPt(-99.),recTheta(-99.),recEta(-99.),recPhi(-99.),
+                     mlabel(-1),mPDG(-1),grmlabel(-1),grmPDG(-1),recMask(0),genLv(),recLv()
     {
     }
     void MakeGenLV(){ genLv.SetPtEtaPhiM(genPt,genEta,genPhi,0.0005109989); }
@@ -452,6 +454,12 @@ class AliAnalysisTaskElectronEfficiency : public AliAnalysisTaskSE {
   UInt_t    fSelectedByCut; // bit mask
   UInt_t    fSelectedByExtraCut; // bit mask
 
+  // cut bitmap pass, see FillTrackCutMasks()
+  std::vector<AliAnalysisCuts*>         fvCriteria;      //! distinct criteria of all cut sets
+  std::vector< std::vector<Int_t> >     fvCriteriaIndex; //! criteria of each cut set, as index in fvCriteria
+  std::vector<UInt_t>                   fvTrackCutMask;  //! bit mask of the cut sets passed, per ESD track
+  std::vector< std::pair<Int_t,Int_t> > fvLabelTrack;    //! (|MC label|, ESD track index) of all tracks, sorted
+
   //protected:
   enum {kAllEvents=0, kPhysicsSelectionEvents, kFilteredEvents , kEventStatBins};
 
@@ -453,6 +453,10 @@ void AliAnalysisTaskMultiDielectron::FinishTaskOutput()
 
   }
 
+  // materialise the compiled histogram arrays, after the remaining mixing
+  nextDie.Reset();
+  while ( (die=static_cast<AliDielectron*>(nextDie())) ) die->FinishHistogramArray();
+
   PostData(1, &fListHistos);
   PostData(2, &fListCF);
 }
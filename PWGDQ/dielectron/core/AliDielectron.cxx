@@ -47,6 +47,7 @@ The names are available via the function PairClassName(Int_t i)
 #include <TMath.h>
 #include <TObject.h>
 #include <TGrid.h>
+#include <TDatabasePDG.h>
 
 #include <AliKFParticle.h>
 
@@ -68,6 +69,9 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronMixingHandler.h"
 #include "AliDielectronPairLegCuts.h"
+#include "AliDielectronPairKineCuts.h"
+#include "AliDielectronCutGroup.h"
+#include "AliDielectronVarCuts.h"
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
@@ -119,6 +123,7 @@ AliDielectron::AliDielectron() :
   fPairPreFilterLegs1("PairPreFilterLegs1"),
   fPairPreFilterLegs2("PairPreFilterLegs2"),
   fPairFilter("PairFilter"),
+  fPairKineCuts(0x0),
   fEventPlanePreFilter("EventPlanePreFilter"),
   fEventPlanePOIPreFilter("EventPlanePOIPreFilter"),
   fQnTPCACcuts(0x0),
@@ -160,6 +165,8 @@ AliDielectron::AliDielectron() :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseTrackCache(kFALSE),
+  fTrackCacheVars(0x0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -196,6 +203,7 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fPairPreFilterLegs1("PairPreFilterLegs1"),
   fPairPreFilterLegs2("PairPreFilterLegs2"),
   fPairFilter("PairFilter"),
+  fPairKineCuts(0x0),
   fEventPlanePreFilter("EventPlanePreFilter"),
   fEventPlanePOIPreFilter("EventPlanePOIPreFilter"),
   fQnTPCACcuts(0x0),
@@ -237,6 +245,8 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fDontClearArrays(kFALSE),
   fEventProcess(kTRUE),
   fUseGammaTracks(kTRUE),
+  fUseTrackCache(kFALSE),
+  fTrackCacheVars(0x0),
   fEstimatorFilename(""),
   fEstimatorObjArray(0x0),
   fTRDpidCorrectionFilename(""),
@@ -276,6 +286,8 @@ AliDielectron::~AliDielectron()
   if (fSignalsMC) delete fSignalsMC;
   if (fCfManagerPair) delete fCfManagerPair;
   if (fHistoArray) delete fHistoArray;
+  if (fTrackCacheVars) delete fTrackCacheVars;
+  if (fPairKineCuts) delete fPairKineCuts;
 }
 
 //________________________________________________________________
@@ -348,6 +360,45 @@ void AliDielectron::Init()
       fEvtVsTrkHist->SetHistogramList(fHistos);
     }
   }
+
+  if (fUseTrackCache) {
+    // collect the track variables needed by the cuts and histograms, the var manager fills them once per track
+    if (!fTrackCacheVars) fTrackCacheVars=new TBits(AliDielectronVarManager::kNMaxValues);
+    (*fTrackCacheVars)|=(*fUsedVars);
+    AddUsedVars(fTrackFilter.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fPairPreFilter1.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fPairPreFilter2.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fPairPreFilterLegs1.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fPairPreFilterLegs2.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fPairFilter.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fEventPlanePreFilter.GetCuts(),fTrackCacheVars);
+    AddUsedVars(fEventPlanePOIPreFilter.GetCuts(),fTrackCacheVars);
+  }
+}
+
+//________________________________________________________________
+void AliDielectron::AddUsedVars(const TCollection *cuts, TBits * const vars)
+{
+  //
+  // Add the variables of all AliDielectronVarCuts and AliDielectronPID in 'cuts' to 'vars',
+  // cut groups and the leg filters of pair leg cuts are searched recursively
+  //
+  if (!cuts || !vars) return;
+  TIter nextCut(cuts);
+  while (TObject *cut = nextCut()) {
+    TBits *used=0x0;
+    if      (cut->InheritsFrom(AliDielectronVarCuts::Class())) used=static_cast<AliDielectronVarCuts*>(cut)->GetUsedVars();
+    else if (cut->InheritsFrom(AliDielectronPID::Class()))     used=static_cast<AliDielectronPID*>(cut)->GetUsedVars();
+    else if (cut->InheritsFrom(AliDielectronCutGroup::Class())) {
+      AddUsedVars(static_cast<AliDielectronCutGroup*>(cut)->GetCuts(),vars);
+    }
+    else if (cut->InheritsFrom(AliDielectronPairLegCuts::Class())) {
+      AliDielectronPairLegCuts *legCuts=static_cast<AliDielectronPairLegCuts*>(cut);
+      AddUsedVars(legCuts->GetLeg1Filter().GetCuts(),vars);
+      AddUsedVars(legCuts->GetLeg2Filter().GetCuts(),vars);
+    }
+    if (used) (*vars)|=(*used);
+  }
 }
 
 //________________________________________________________________
@@ -457,6 +508,9 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   if ((ev1&&cutmask!=selectedMask) ||
       (ev2&&fEventFilter.IsSelected(ev2)!=selectedMask)) return 0;
 
+  // cache track variables for this event, legs are selected and filled for many pairs
+  if (fUseTrackCache) AliDielectronVarManager::SetTrackCache(kTRUE,fTrackCacheVars);
+
   if(fEvtVsTrkHist){
     fEvtVsTrkHist->SetPIDResponse(AliDielectronVarManager::GetPIDResponse());
     fEvtVsTrkHist->FillHistograms(ev1);
@@ -553,6 +607,7 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
         ((AliDielectronV0Cuts*)fTrackFilter.GetCuts()->At(iCut))->ResetUniqueEventNumbers();
     }
   }
+  if (fUseTrackCache) AliDielectronVarManager::SetTrackCache(kFALSE);
 
   return 1;
 
@@ -1420,10 +1475,24 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
+  // first stage: kinematic pair cuts from the leg momenta, before any KF pair is built
+  //   pairs rejected here do not enter the CF container and the cut QA
+  AliDielectronLegBuffer legs1, legs2;
+  Double_t magField=0.;
+  if (fPairKineCuts){
+    TDatabasePDG *db=TDatabasePDG::Instance();
+    legs1.Fill(arrTracks1, db->GetParticle(fPdgLeg1) ? db->GetParticle(fPdgLeg1)->Mass() : 0.);
+    legs2.Fill(arrTracks2, db->GetParticle(fPdgLeg2) ? db->GetParticle(fPdgLeg2)->Mass() : 0.);
+    AliVEvent *currentEvent=AliDielectronVarManager::GetCurrentEvent();
+    if (currentEvent) magField=currentEvent->GetMagneticField();
+  }
+
   for (Int_t itrack1=0; itrack1<ntrack1; ++itrack1){
     Int_t end=ntrack2;
     if (arr1==arr2) end=itrack1;
     for (Int_t itrack2=0; itrack2<end; ++itrack2){
+      if (fPairKineCuts && !fPairKineCuts->IsSelected(legs1,itrack1,legs2,itrack2,magField)) continue;
+
       //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
       candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
                            &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
@@ -39,6 +39,7 @@ class AliDielectronTrackRotator;
 class AliDielectronPair;
 class AliDielectronSignalMC;
 class AliDielectronMixingHandler;
+class AliDielectronPairKineCuts;
 
 //________________________________________________________________
 class AliDielectron : public TNamed {
@@ -89,6 +90,8 @@ public:
   void SetNoPairing(Bool_t noPairing=kTRUE) { fNoPairing=noPairing; }
   void SetProcessLS(Bool_t doLS=kTRUE) { fProcessLS=doLS; }
   void SetUseKF(Bool_t useKF=kTRUE) { fUseKF=useKF; }
+  void SetPairKineCuts(AliDielectronPairKineCuts * const cuts) { fPairKineCuts=cuts; }
+  AliDielectronPairKineCuts* GetPairKineCuts() const { return fPairKineCuts; }
   const TObjArray* GetTrackArray(Int_t i) const {return (i>=0&&i<4)?&fTracks[i]:0;}
   const TObjArray* GetPairArray(Int_t i)  const {return (i>=0&&i<11)?
       static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i)):0;}
@@ -146,6 +149,8 @@ public:
 
   void SetStoreRotatedPairs(Bool_t storeTR) {fStoreRotatedPairs = storeTR;}
   void SetDontClearArrays(Bool_t dontClearArrays=kTRUE) { fDontClearArrays=dontClearArrays; }
+  void SetUseTrackCache(Bool_t useCache=kTRUE) { fUseTrackCache=useCache; }
+  Bool_t GetUseTrackCache() const { return fUseTrackCache; }
   Bool_t DontClearArrays() const { return fDontClearArrays; }
 
   void AddSignalMC(AliDielectronSignalMC* signal);
@@ -191,6 +196,7 @@ public:
   void  FillHistogramsFromPairArray(Bool_t pairInfoOnly=kFALSE);
 
   void FinishEvtVsTrkHistoClass();
+  void FinishHistogramArray() { if(fHistoArray) fHistoArray->FinishGrid(); }
 
 private:
 
@@ -215,6 +221,7 @@ private:
   AliAnalysisFilter fPairPreFilterLegs1; // Leg filter after the pair prefilter cuts
   AliAnalysisFilter fPairPreFilterLegs2; // Leg filter after the pair prefilter cuts
   AliAnalysisFilter fPairFilter;     // pair cuts
+  AliDielectronPairKineCuts *fPairKineCuts; // kinematic pair cuts from the leg momenta, applied before the pair is built
   AliAnalysisFilter fEventPlanePreFilter;  // event plane prefilter cuts
   AliAnalysisFilter fEventPlanePOIPreFilter;  // PoI cuts in the event plane prefilter
   AliDielectronQnEPcorrection *fQnTPCACcuts; // QnFramework est. 2016 ac removal
@@ -273,6 +280,8 @@ private:
   Bool_t fDontClearArrays;      //Don't clear the arrays at the end of the Process function, needed for external use of pair and tracks
   Bool_t fEventProcess;         //Process event (or pair array)
   Bool_t fUseGammaTracks;       // use function SetGammaTracks for MCtruth photons
+  Bool_t fUseTrackCache;        // fill the track variables once per event, see AliDielectronVarManager::SetTrackCache
+  TBits *fTrackCacheVars;       //! track variables used by the configured cuts and histograms
 
   void FillTrackArrays(AliVEvent * const ev, Int_t eventNr=0);
   void EventPlanePreFilter(Int_t arr1, Int_t arr2, TObjArray arrTracks1, TObjArray arrTracks2, const AliVEvent *ev);
@@ -309,10 +318,12 @@ private:
 
   void  FillDebugTree();
 
+  static void AddUsedVars(const TCollection *cuts, TBits * const vars);
+
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,19);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
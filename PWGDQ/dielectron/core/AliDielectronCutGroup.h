@@ -52,6 +52,7 @@ public:
 
   virtual void Print(const Option_t* option = "") const;
   const AliAnalysisCuts* GetCut(Int_t iCut) const;
+  const TList* GetCuts() const { return &fCutGroupList; }
 
   
 private:
@@ -64,7 +64,15 @@ AliDielectronHF::AliDielectronHF() :
   fHasMC(kFALSE),
   fStepGenerated(kFALSE),
   fEventArray(kFALSE),
-  fRefObj(1)
+  fRefObj(1),
+  fCompiledGrid(kFALSE),
+  fGridCellSize(0),
+  fGridObjOffset(),
+  fGridStep(),
+  fGrid(),
+  fGridBins(),
+  fGridFillBin(),
+  fGridFillW()
 {
   //
   // Default Constructor
@@ -91,7 +99,15 @@ AliDielectronHF::AliDielectronHF(const char* name, const char* title) :
   fHasMC(kFALSE),
   fStepGenerated(kFALSE),
   fEventArray(kFALSE),
-  fRefObj(1)
+  fRefObj(1),
+  fCompiledGrid(kFALSE),
+  fGridCellSize(0),
+  fGridObjOffset(),
+  fGridStep(),
+  fGrid(),
+  fGridBins(),
+  fGridFillBin(),
+  fGridFillW()
 {
   //
   // Named Constructor
@@ -482,67 +498,202 @@ void AliDielectronHF::Fill(Int_t index, Double_t * const valuesPair, Double_t *
   //
 
   TObjArray *histArr = static_cast<TObjArray*>(fArrPairType.At(index));
-  if(!histArr) return;
+  if(!histArr || !histArr->GetEntriesFast()) return;
 
-  Int_t size  = GetNumberOfBins();
-  // loop over all histograms
-  for(Int_t ihist=0; ihist<size; ihist++) {
+  // accepted bins of each cut variable, stored as offset in the bin cell index
+  Int_t nvars = fAxes.GetEntriesFast();
+  Int_t first[kMaxCuts];
+  Int_t nacc[kMaxCuts];
+  Int_t ipos    = 0;
+  Int_t sizeAdd = 1;
+  for(Int_t ivar=0; ivar<nvars; ivar++) {
+
+    TVectorD *bins = static_cast<TVectorD*>(fAxes.At(ivar));
+    Int_t nbins    = bins->GetNrows()-1;
+    if(fGridBins.GetSize()<ipos+nbins) fGridBins.Set(ipos+nbins);
+
+    first[ivar] = ipos;
+    nacc[ivar]  = 0;
+    Bool_t leg  = fVarCutType->TestBitNumber(ivar);
+    Double_t val1 = (leg ? valuesLeg1[fVarCuts[ivar]] : valuesPair[fVarCuts[ivar]]);
+    Double_t val2 = (leg ? valuesLeg2[fVarCuts[ivar]] : val1);
+    for(Int_t ibin=0; ibin<nbins; ibin++) {
+      Double_t lowEdge=0., upEdge=0.;
+      GetBinLimits(ivar, ibin, lowEdge, upEdge);
+      if(val1 < lowEdge || val1 >= upEdge || val2 < lowEdge || val2 >= upEdge) continue;
+      fGridBins[ipos++] = ibin*sizeAdd;
+      ++nacc[ivar];
+    }
+
+    // no bin cell selected
+    if(!nacc[ivar]) return;
+    sizeAdd*=nbins;
+  } //end of var cut loop
+
+  // bins and weights of the objects accumulated in the grid, the same for all bin cells
+  Int_t nobj = fRefObj.GetEntriesFast();
+  Double_t *shard = 0x0;
+  if(fGridCellSize) {
+    for(Int_t i=0; i<nobj; i++) {
+      if(fGridObjOffset[i]<0) continue;
+      TH1 *ref = static_cast<TH1*>(fRefObj.UncheckedAt(i));
+      Int_t binx = ref->GetXaxis()->FindFixBin(valuesPair[ref->GetXaxis()->GetUniqueID()]);
+      Int_t biny = (ref->GetDimension()>1 ? ref->GetYaxis()->FindFixBin(valuesPair[ref->GetYaxis()->GetUniqueID()]) : 0);
+      Int_t binz = (ref->GetDimension()>2 ? ref->GetZaxis()->FindFixBin(valuesPair[ref->GetZaxis()->GetUniqueID()]) : 0);
+      fGridFillBin[i] = ref->GetBin(binx, biny, binz);
+      fGridFillW[i]   = (ref->GetUniqueID()!=(UInt_t)AliDielectronHistos::kNoWeights ? valuesPair[ref->GetUniqueID()] : 1.);
+    }
 
-    Int_t sizeAdd   = 1;
-    Bool_t selected = kTRUE;
+    // shard of this pair type is allocated with the first pair
+    if(fGridStep[index]<0) {
+      fGridStep[index] = fGrid.GetSize();
+      fGrid.Set(fGrid.GetSize() + GetNumberOfBins()*fGridCellSize);
+    }
+    shard = fGrid.GetArray() + fGridStep[index];
+  }
 
-    // loop over all cut variables
-    Int_t nvars = fAxes.GetEntriesFast();
-    for(Int_t ivar=0; ivar<nvars; ivar++) {
+  // loop over the selected bin cells only
+  Int_t idx[kMaxCuts] = {0};
+  while(kTRUE) {
 
-      // get bin limits
-      TVectorD *bins = static_cast<TVectorD*>(fAxes.At(ivar));
-      Int_t nbins    = bins->GetNrows()-1;
+    Int_t ihist = 0;
+    for(Int_t ivar=0; ivar<nvars; ivar++) ihist += fGridBins[first[ivar]+idx[ivar]];
 
-      // bin limits for current ivar bin
-      Int_t ibin   = (ihist/sizeAdd)%nbins;
-      Double_t lowEdge = (*bins)[ibin];
-      Double_t upEdge  = (*bins)[ibin+1];
-      switch(fBinType[ivar]) {
-      case kStdBin:     upEdge=(*bins)[ibin+1];     break;
-      case kBinToMax:   upEdge=(*bins)[nbins];      break;
-      case kBinFromMin: lowEdge=(*bins)[0];         break;
-      case kSymBin:     upEdge=(*bins)[nbins-ibin];
-	if(ibin>=((Double_t)(nbins+1))/2) upEdge=(*bins)[nbins]; // to avoid low>up
-	break;
+    // fill the object with Pair and event values
+    TObjArray *tmp = static_cast<TObjArray*>(histArr->UncheckedAt(ihist));
+    AliDebug(10,tmp->GetName());
+    for(Int_t i=0; i<nobj; i++) {
+      Int_t offset = (fGridCellSize ? fGridObjOffset[i] : -1);
+      if(offset<0) {
+	AliDielectronHistos::FillValues(tmp->UncheckedAt(i), valuesPair);
+	continue;
       }
+      // block of the object: entries, sum of weights, sum of squared weights
+      Double_t *block = shard + ihist*fGridCellSize + offset;
+      Int_t ncells    = static_cast<TH1*>(fRefObj.UncheckedAt(i))->GetNcells();
+      Double_t w      = fGridFillW[i];
+      block[0] += 1.;
+      block[1+fGridFillBin[i]]        += w;
+      block[1+ncells+fGridFillBin[i]] += w*w;
+    }
+
+    // next combination of accepted bins
+    Int_t ivar=0;
+    for(; ivar<nvars; ivar++) {
+      if(++idx[ivar]<nacc[ivar]) break;
+      idx[ivar]=0;
+    }
+    if(ivar==nvars) break;
+  } //end of bin cell loop
+
+}
+
+//______________________________________________
+void AliDielectronHF::FinishGrid()
+{
+  //
+  // materialise the compiled grid into the histograms of the bin cells
+  // and reset it, to be called before the output is written
+  //
+  if(!fGridCellSize || !fGrid.GetSize()) return;
+
+  Int_t size = GetNumberOfBins();
+  Int_t nobj = fRefObj.GetEntriesFast();
+  for(Int_t istep=0; istep<fGridStep.GetSize(); istep++) {
+    if(fGridStep[istep]<0) continue;
+    TObjArray *histArr = static_cast<TObjArray*>(fArrPairType.At(istep));
+    Double_t *shard = fGrid.GetArray() + fGridStep[istep];
 
-      // leg variable
-      if(fVarCutType->TestBitNumber(ivar)) {
-	if( (valuesLeg1[fVarCuts[ivar]] < lowEdge || valuesLeg1[fVarCuts[ivar]] >= upEdge) ||
-	    (valuesLeg2[fVarCuts[ivar]] < lowEdge || valuesLeg2[fVarCuts[ivar]] >= upEdge) ) {
-	  selected=kFALSE;
-	  break;
+    for(Int_t ihist=0; ihist<size; ihist++) {
+      TObjArray *tmp = static_cast<TObjArray*>(histArr->UncheckedAt(ihist));
+      for(Int_t i=0; i<nobj; i++) {
+	if(fGridObjOffset[i]<0) continue;
+	Double_t *block = shard + ihist*fGridCellSize + fGridObjOffset[i];
+	if(block[0]==0.) continue;
+
+	TH1 *h = static_cast<TH1*>(tmp->UncheckedAt(i));
+	Int_t ncells = h->GetNcells();
+	// weighted fills switch on the errors, as TH1::Fill does
+	if(!h->GetSumw2N()) {
+	  for(Int_t ibin=0; ibin<ncells; ibin++) {
+	    if(block[1+ibin]==block[1+ncells+ibin]) continue;
+	    h->Sumw2();
+	    break;
+	  }
 	}
-      }
-      else { // pair and event variables
-	if( (valuesPair[fVarCuts[ivar]] < lowEdge || valuesPair[fVarCuts[ivar]] >= upEdge) ) {
-	  selected=kFALSE;
-	  break;
+	Double_t entries = h->GetEntries() + block[0];
+	for(Int_t ibin=0; ibin<ncells; ibin++) {
+	  if(block[1+ibin]==0. && block[1+ncells+ibin]==0.) continue;
+	  h->AddBinContent(ibin, block[1+ibin]);
+	  if(h->GetSumw2N()) h->GetSumw2()->fArray[ibin] += block[1+ncells+ibin];
 	}
+	h->ResetStats();
+	h->SetEntries(entries);
       }
+    }
+  }
 
-      sizeAdd*=nbins;
-    } //end of var cut loop
+  fGrid.Reset();
+}
 
-    // do not fill the histogram
-    if(!selected) continue;
+//______________________________________________
+void AliDielectronHF::GetBinLimits(Int_t ivar, Int_t ibin, Double_t &lowEdge, Double_t &upEdge) const
+{
+  //
+  // limits of the bin cells of cut variable ivar according to its binning type
+  //
+  TVectorD *bins = static_cast<TVectorD*>(fAxes.At(ivar));
+  Int_t nbins    = bins->GetNrows()-1;
+
+  lowEdge = (*bins)[ibin];
+  upEdge  = (*bins)[ibin+1];
+  switch(fBinType[ivar]) {
+  case kStdBin:     upEdge=(*bins)[ibin+1];     break;
+  case kBinToMax:   upEdge=(*bins)[nbins];      break;
+  case kBinFromMin: lowEdge=(*bins)[0];         break;
+  case kSymBin:     upEdge=(*bins)[nbins-ibin];
+    if(ibin>=((Double_t)(nbins+1))/2) upEdge=(*bins)[nbins]; // to avoid low>up
+    break;
+  }
+}
 
-    // fill the object with Pair and event values
-    TObjArray *tmp = (TObjArray*) histArr->At(ihist);
-    TString title = tmp->GetName();
-    AliDebug(10,title.Data());
-    for(Int_t i=0; i<tmp->GetEntriesFast(); i++) {
-      AliDielectronHistos::FillValues(tmp->At(i), valuesPair);
+//______________________________________________
+void AliDielectronHF::CompileGrid()
+{
+  //
+  // layout of the flat grid: one block per bin cell holding, for each
+  // plain (weighted) TH1/2/3 reference object, the entries and the sums of
+  // weights and squared weights of all its bins. Profiles, sparses and
+  // trigger map histograms are filled directly
+  //
+  Int_t nobj = fRefObj.GetEntriesFast();
+  fGridObjOffset.Set(nobj);
+  fGridFillBin.Set(nobj);
+  fGridFillW.Set(nobj);
+  fGridCellSize = 0;
+  for(Int_t i=0; i<nobj; i++) {
+    fGridObjOffset[i] = -1;
+    if(!fCompiledGrid) continue;
+
+    TObject *obj = fRefObj.UncheckedAt(i);
+    if(!obj->InheritsFrom(TH1::Class())) continue;
+    if(obj->InheritsFrom(TProfile::Class()) || obj->InheritsFrom(TProfile2D::Class()) || obj->InheritsFrom(TProfile3D::Class())) continue;
+    TH1 *h = static_cast<TH1*>(obj);
+    if(h->GetUniqueID()==(UInt_t)AliDielectronHistos::kNoAutoFill) continue;
+    UInt_t vars[4] = { h->GetXaxis()->GetUniqueID(), h->GetYaxis()->GetUniqueID(), h->GetZaxis()->GetUniqueID(), h->GetUniqueID() };
+    Bool_t trigger = kFALSE;
+    for(Int_t j=0; j<4; j++) {
+      if(vars[j]==AliDielectronVarManager::kTriggerInclONL || vars[j]==AliDielectronVarManager::kTriggerInclOFF) trigger = kTRUE;
     }
-    //    AliDebug(10,Form("Fill var %d %s value %f in %s \n",fVar,AliDielectronVarManager::GetValueName(fVar),valuesPair[fVar],tmp->GetName()));
-  } //end of hist loop
+    if(trigger) continue;
+
+    fGridObjOffset[i] = fGridCellSize;
+    fGridCellSize    += 1 + 2*h->GetNcells();
+  }
 
+  fGridStep.Set(fArrPairType.GetSize());
+  fGridStep.Reset(-1);
+  fGrid.Set(0);
 }
 
 //______________________________________________
@@ -599,18 +750,10 @@ void AliDielectronHF::Init()
     // loop over all bin cells an set unique titles
     for(Int_t ihist=0; ihist<size; ihist++) {
 
-      // get the lower limit for current ivar bin
+      // get the limits for current ivar bin
       Int_t ibin   = (ihist/sizeAdd)%nbins;
-      Double_t lowEdge = (*bins)[ibin];
-      Double_t upEdge  = (*bins)[ibin+1];
-      switch(fBinType[ivar]) {
-      case kStdBin:     upEdge=(*bins)[ibin+1];     break;
-      case kBinToMax:   upEdge=(*bins)[nbins];      break;
-      case kBinFromMin: lowEdge=(*bins)[0];         break;
-      case kSymBin:     upEdge=(*bins)[nbins-ibin];
-	if(ibin>=((Double_t)(nbins+1))/2) upEdge=(*bins)[nbins]; // to avoid low>up
-	break;
-      }
+      Double_t lowEdge=0., upEdge=0.;
+      GetBinLimits(ivar, ibin, lowEdge, upEdge);
 
       TObjArray *tmp= (TObjArray*) histArr->At(ihist);
       TString title = tmp->GetName();
@@ -671,6 +814,9 @@ void AliDielectronHF::Init()
     delete histArr;
     histArr=0;
   }
+
+  // layout of the compiled grid
+  CompileGrid();
 }
 
 //______________________________________________
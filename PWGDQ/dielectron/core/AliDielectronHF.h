@@ -16,6 +16,8 @@
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TBits.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
 #include <THnBase.h>
 
 #include "AliDielectronVarManager.h"
@@ -49,6 +51,7 @@ public:
   void SetStepForMCGenerated(Bool_t switcher=kTRUE)    {fStepGenerated = switcher;}
   void SetPairTypes(EPairType ptype) { fPairType=ptype; }
   void SetEventArray(Bool_t switcher=kTRUE) {fEventArray=switcher;}
+  void SetCompiledGrid(Bool_t switcher=kTRUE) {fCompiledGrid=switcher;}
 
   // functions to add 1-dimensional objects
   void UserProfile(const char* histClass, UInt_t valTypeP,
@@ -93,6 +96,7 @@ public:
   void Fill(Int_t pairIndex, const AliDielectronPair *particle);
   void Fill(Int_t label1, Int_t label2, Int_t nSignal);
   void Fill(Int_t Index, Double_t * const valuesPair, Double_t * const valuesLeg1, Double_t * const valuesLeg2);
+  void FinishGrid();
 
   Bool_t IsPairTypeSelected(Int_t itype);
 
@@ -100,6 +104,7 @@ public:
   const TObjArray * GetHistArray() const { return &fArrPairType; }
   Bool_t GetStepForMCGenerated()   const { return fStepGenerated; }
   Bool_t IsEventArray()           const { return fEventArray; }
+  Bool_t IsCompiledGrid()         const { return fCompiledGrid; }
   
   
 
@@ -121,11 +126,23 @@ private:
   Bool_t    fEventArray;            // switch OFF pair types and ON event array
   TObjArray fRefObj;               // reference object
 
+  Bool_t    fCompiledGrid;          // accumulate histograms in the flat grid, see FinishGrid
+  Int_t     fGridCellSize;          //! size of one bin cell in the grid
+  TArrayI   fGridObjOffset;         //! offset of the reference objects in a bin cell (-1: filled directly)
+  TArrayI   fGridStep;              //! start of the grid shard of each pair type (-1: not yet filled)
+  TArrayD   fGrid;                  //! flat grid of entries, sum of weights and squared weights
+  TArrayI   fGridBins;              //! accepted bins of all cut variables for the current pair
+  TArrayI   fGridFillBin;           //! bin of the reference objects for the current pair
+  TArrayD   fGridFillW;             //! weight of the reference objects for the current pair
+
+  void GetBinLimits(Int_t ivar, Int_t ibin, Double_t &lowEdge, Double_t &upEdge) const;
+  void CompileGrid();
+
   AliDielectronHF(const AliDielectronHF &c);
   AliDielectronHF &operator=(const AliDielectronHF &c);
 
   
-  ClassDef(AliDielectronHF,6)         // Dielectron HF
+  ClassDef(AliDielectronHF,7)         // Dielectron HF
 };
 
 
@@ -35,6 +35,7 @@ Detailed description
 #include <AliLog.h>
 #include <AliExternalTrackParam.h>
 #include <AliPIDResponse.h>
+#include <AliPIDResponseCache.h>
 #include <AliTRDPIDResponse.h>
 #include <AliESDtrack.h> //!!!!! Remove once Eta correction is treated in the tender
 #include <AliAODTrack.h>
@@ -376,7 +377,7 @@ Bool_t AliDielectronPID::IsSelected(TObject* track)
 
     // check if fFunSigma is set, then check if 'part' is in sigma range of the function
     if(fFunSigma[icut]){
-        val= fPIDResponse->NumberOfSigmasTPC(part, fPartType[icut]);
+        val= AliPIDResponseCache::NumberOfSigmasTPC(fPIDResponse, part, fPartType[icut]);
         if (fPartType[icut]==AliPID::kElectron){
             val-=fgCorr;
         }
@@ -455,7 +456,7 @@ Bool_t AliDielectronPID::IsSelectedITS(AliVTrack * const part, Int_t icut)
 
   Double_t mom=part->P();
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasITS(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::NumberOfSigmasITS(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
@@ -484,7 +485,7 @@ Bool_t AliDielectronPID::IsSelectedTPC(AliVTrack * const part, Int_t icut, Doubl
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasTPC(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::NumberOfSigmasTPC(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
@@ -581,7 +582,7 @@ Bool_t AliDielectronPID::IsSelectedTOF(AliVTrack * const part, Int_t icut)
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasTOF(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::NumberOfSigmasTOF(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
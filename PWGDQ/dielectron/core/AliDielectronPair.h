@@ -63,7 +63,7 @@ public:
                  AliVTrack * const refParticle2);
 
   static void SetRandomizeDaughters(Bool_t random=kTRUE) { fRandomizeDaughters=random; }
-  //static Bool_t GetRandomizeDaughters() { return fRandomizeDaughters; }
+  static Bool_t GetRandomizeDaughters() { return fRandomizeDaughters; }
 
   //AliVParticle interface
   // kinematics
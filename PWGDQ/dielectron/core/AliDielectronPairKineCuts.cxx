@@ -0,0 +1,231 @@
+/*************************************************************************
+* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+//   Kinematic pair cuts (mass, opening angle, phiV) computed directly   //
+//   from the leg momenta                                                //
+//                                                                       //
+/*
+Used by AliDielectron::SetPairKineCuts() as a first pairing stage: pairs
+failing these cuts are rejected before the AliDielectronPair (KF particle)
+is built and the pair filter is applied. The mass and the opening angle
+are computed from the leg 4-momenta, not from the KF pair, so the ranges
+should be set somewhat looser than the corresponding cuts of the pair filter.
+
+  AliDielectronPairKineCuts *kine=new AliDielectronPairKineCuts("kine","kine");
+  kine->SetMassRange(2.0,5.0);
+  kine->SetPhivRejection(2.9,3.2,0.05);
+  diele->SetPairKineCuts(kine);
+
+The cuts can also be added to the pair filter, they then use the pair
+information.
+*/
+//                                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+#include <TMath.h>
+#include <TObjArray.h>
+
+#include "AliVTrack.h"
+#include "AliVEvent.h"
+#include "AliDielectronPair.h"
+#include "AliDielectronVarManager.h"
+
+#include "AliDielectronPairKineCuts.h"
+
+ClassImp(AliDielectronPairKineCuts)
+
+//________________________________________________________________________
+void AliDielectronLegBuffer::Fill(const TObjArray &tracks, Double_t mass)
+{
+  //
+  // Copy the momenta of the tracks in the array
+  //
+  Int_t ntracks=tracks.GetEntriesFast();
+  fPx.resize(ntracks); fPy.resize(ntracks); fPz.resize(ntracks);
+  fE.resize(ntracks); fPt.resize(ntracks); fCharge.resize(ntracks);
+  Double_t p[3];
+  for (Int_t itrack=0; itrack<ntracks; ++itrack){
+    AliVTrack *track=static_cast<AliVTrack*>(tracks.UncheckedAt(itrack));
+    track->PxPyPz(p);
+    fPx[itrack]=p[0]; fPy[itrack]=p[1]; fPz[itrack]=p[2];
+    fPt[itrack]=TMath::Sqrt(p[0]*p[0]+p[1]*p[1]);
+    fE[itrack]=TMath::Sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]+mass*mass);
+    fCharge[itrack]=track->Charge();
+  }
+}
+
+//________________________________________________________________________
+AliDielectronPairKineCuts::AliDielectronPairKineCuts() :
+  AliAnalysisCuts(),
+  fCutMass(kFALSE),
+  fMassMin(0.),
+  fMassMax(0.),
+  fMassExclude(kFALSE),
+  fCutOpeningAngle(kFALSE),
+  fOpeningAngleMin(0.),
+  fOpeningAngleMax(0.),
+  fOpeningAngleExclude(kFALSE),
+  fCutPhiv(kFALSE),
+  fPhivMin(0.),
+  fPhivMax(0.),
+  fPhivMassMax(0.)
+{
+  //
+  // Default contructor
+  //
+}
+
+//________________________________________________________________________
+AliDielectronPairKineCuts::AliDielectronPairKineCuts(const char* name, const char* title) :
+  AliAnalysisCuts(name,title),
+  fCutMass(kFALSE),
+  fMassMin(0.),
+  fMassMax(0.),
+  fMassExclude(kFALSE),
+  fCutOpeningAngle(kFALSE),
+  fOpeningAngleMin(0.),
+  fOpeningAngleMax(0.),
+  fOpeningAngleExclude(kFALSE),
+  fCutPhiv(kFALSE),
+  fPhivMin(0.),
+  fPhivMax(0.),
+  fPhivMassMax(0.)
+{
+  //
+  // Named contructor
+  //
+}
+
+//________________________________________________________________________
+AliDielectronPairKineCuts::~AliDielectronPairKineCuts()
+{
+  //
+  // Default destructor
+  //
+}
+
+//________________________________________________________________________
+Bool_t AliDielectronPairKineCuts::Decision(Double_t mass, Double_t openingAngle, Double_t phiv) const
+{
+  //
+  // Cut decision, phiv<-1 if not available
+  //
+  if (fCutMass && ((mass<fMassMin || mass>fMassMax)^fMassExclude)) return kFALSE;
+  if (fCutOpeningAngle && ((openingAngle<fOpeningAngleMin || openingAngle>fOpeningAngleMax)^fOpeningAngleExclude)) return kFALSE;
+  if (fCutPhiv && phiv>-1. && mass<fPhivMassMax && phiv>=fPhivMin && phiv<=fPhivMax) return kFALSE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliDielectronPairKineCuts::IsSelected(TObject* pair)
+{
+  //
+  // Make cut decision on an AliDielectronPair
+  //
+  SetSelected(kFALSE);
+  AliDielectronPair *p=dynamic_cast<AliDielectronPair*>(pair);
+  if (!p) return kFALSE;
+
+  AliVEvent *ev=AliDielectronVarManager::GetCurrentEvent();
+  Double_t phiv=(fCutPhiv && ev) ? p->PhivPair(ev->GetMagneticField()) : -5.;
+  Bool_t isSelected=Decision(p->M(),p->OpeningAngle(),phiv);
+  SetSelected(isSelected);
+  return isSelected;
+}
+
+//________________________________________________________________________
+Bool_t AliDielectronPairKineCuts::IsSelected(const AliDielectronLegBuffer &legs1, Int_t i1,
+                                             const AliDielectronLegBuffer &legs2, Int_t i2, Double_t magField) const
+{
+  //
+  // Make cut decision from the leg momenta, without building the pair
+  //
+  Double_t px=legs1.Px(i1)+legs2.Px(i2);
+  Double_t py=legs1.Py(i1)+legs2.Py(i2);
+  Double_t pz=legs1.Pz(i1)+legs2.Pz(i2);
+  Double_t e=legs1.E(i1)+legs2.E(i2);
+  Double_t m2=e*e-px*px-py*py-pz*pz;
+  Double_t mass=(m2>0. ? TMath::Sqrt(m2) : 0.);
+
+  Double_t openingAngle=0.;
+  if (fCutOpeningAngle){
+    Double_t p1=TMath::Sqrt(legs1.Px(i1)*legs1.Px(i1)+legs1.Py(i1)*legs1.Py(i1)+legs1.Pz(i1)*legs1.Pz(i1));
+    Double_t p2=TMath::Sqrt(legs2.Px(i2)*legs2.Px(i2)+legs2.Py(i2)*legs2.Py(i2)+legs2.Pz(i2)*legs2.Pz(i2));
+    Double_t cosAngle=(p1*p2>0. ? (legs1.Px(i1)*legs2.Px(i2)+legs1.Py(i1)*legs2.Py(i2)+legs1.Pz(i1)*legs2.Pz(i2))/(p1*p2) : 1.);
+    openingAngle=TMath::ACos(TMath::Max(-1.,TMath::Min(1.,cosAngle)));
+  }
+
+  // phiV depends on the leg order for like sign pairs, which is only known without randomization
+  Double_t phiv=-5.;
+  Short_t q1=legs1.Charge(i1), q2=legs2.Charge(i2);
+  if (fCutPhiv && mass<fPhivMassMax && !(q1*q2>0 && AliDielectronPair::GetRandomizeDaughters())){
+    // first leg has the larger pt, as in AliDielectronPair
+    if (legs1.Pt(i1)>legs2.Pt(i2))
+      phiv=PhivPair(legs1.Px(i1),legs1.Py(i1),legs1.Pz(i1),q1,legs2.Px(i2),legs2.Py(i2),legs2.Pz(i2),q2,magField);
+    else
+      phiv=PhivPair(legs2.Px(i2),legs2.Py(i2),legs2.Pz(i2),q2,legs1.Px(i1),legs1.Py(i1),legs1.Pz(i1),q1,magField);
+  }
+
+  return Decision(mass,openingAngle,phiv);
+}
+
+//________________________________________________________________________
+Double_t AliDielectronPairKineCuts::PhivPair(Double_t px1, Double_t py1, Double_t pz1, Short_t q1,
+                                             Double_t px2, Double_t py2, Double_t pz2, Short_t q2, Double_t magField)
+{
+  //
+  // Angle of the ee plane w.r.t. the magnetic field, same definition as AliDielectronPair::PhivPair()
+  // leg 1 is the leg with the larger pt
+  //
+  Bool_t swap=kFALSE;
+  if (q1*q2>0) swap=(magField<0) ? (q1<0) : (q1>0);  // like sign
+  else         swap=(magField>0) ? (q1<0) : (q1>0);  // unlike sign
+  if (swap){
+    Double_t tmp=px1; px1=px2; px2=tmp;
+    tmp=py1; py1=py2; py2=tmp;
+    tmp=pz1; pz1=pz2; pz2=tmp;
+  }
+
+  Double_t px=px1+px2;
+  Double_t py=py1+py2;
+  Double_t pz=pz1+pz2;
+  Double_t pl=TMath::Sqrt(px*px+py*py+pz*pz);
+
+  //unit vector of (pep+pem)
+  Double_t ux=px/pl;
+  Double_t uy=py/pl;
+  Double_t uz=pz/pl;
+  Double_t ax=uy/TMath::Sqrt(ux*ux+uy*uy);
+  Double_t ay=-ux/TMath::Sqrt(ux*ux+uy*uy);
+
+  //vector product of pep X pem
+  Double_t vpx=py1*pz2-pz1*py2;
+  Double_t vpy=pz1*px2-px1*pz2;
+  Double_t vpz=px1*py2-py1*px2;
+  Double_t vp=TMath::Sqrt(vpx*vpx+vpy*vpy+vpz*vpz);
+
+  //unit vector of pep X pem
+  Double_t vx=vpx/vp;
+  Double_t vy=vpy/vp;
+  Double_t vz=vpz/vp;
+
+  //the third axis defined by vector product (ux,uy,uz)X(vx,vy,vz)
+  Double_t wx=uy*vz-uz*vy;
+  Double_t wy=uz*vx-ux*vz;
+
+  return TMath::ACos(wx*ax+wy*ay);
+}
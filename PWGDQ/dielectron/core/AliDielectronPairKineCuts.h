@@ -0,0 +1,96 @@
+#ifndef ALIDIELECTRONPAIRKINECUTS_H
+#define ALIDIELECTRONPAIRKINECUTS_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#############################################################
+//#                                                           # 
+//#         Class AliDielectronPairKineCuts                   #
+//#         Kinematic pair cuts from the leg momenta,         #
+//#         applied before the AliDielectronPair is built     #
+//#                                                           #
+//#############################################################
+
+#include <vector>
+
+#include <AliAnalysisCuts.h>
+
+class TObjArray;
+
+//
+// Leg momenta of a track array, filled once per pairing call
+//
+class AliDielectronLegBuffer {
+public:
+  AliDielectronLegBuffer() : fPx(), fPy(), fPz(), fE(), fPt(), fCharge() {}
+
+  void Fill(const TObjArray &tracks, Double_t mass);
+
+  Int_t    GetEntries()     const { return fPx.size(); }
+  Double_t Px(Int_t i)      const { return fPx[i]; }
+  Double_t Py(Int_t i)      const { return fPy[i]; }
+  Double_t Pz(Int_t i)      const { return fPz[i]; }
+  Double_t E(Int_t i)       const { return fE[i]; }
+  Double_t Pt(Int_t i)      const { return fPt[i]; }
+  Short_t  Charge(Int_t i)  const { return fCharge[i]; }
+
+private:
+  std::vector<Double_t> fPx;      // px of the legs
+  std::vector<Double_t> fPy;      // py of the legs
+  std::vector<Double_t> fPz;      // pz of the legs
+  std::vector<Double_t> fE;       // energy of the legs with the leg mass hypothesis
+  std::vector<Double_t> fPt;      // pt of the legs
+  std::vector<Short_t>  fCharge;  // charge of the legs
+};
+
+class AliDielectronPairKineCuts : public AliAnalysisCuts {
+public:
+  AliDielectronPairKineCuts();
+  AliDielectronPairKineCuts(const char* name, const char* title);
+  virtual ~AliDielectronPairKineCuts();
+
+  void SetMassRange(Double_t min, Double_t max, Bool_t exclude=kFALSE)
+    { fCutMass=kTRUE; fMassMin=min; fMassMax=max; fMassExclude=exclude; }
+  void SetOpeningAngleRange(Double_t min, Double_t max, Bool_t exclude=kFALSE)
+    { fCutOpeningAngle=kTRUE; fOpeningAngleMin=min; fOpeningAngleMax=max; fOpeningAngleExclude=exclude; }
+  // reject pairs with phiV in [min,max] and a mass below massMax (conversion rejection)
+  void SetPhivRejection(Double_t min, Double_t max, Double_t massMax)
+    { fCutPhiv=kTRUE; fPhivMin=min; fPhivMax=max; fPhivMassMax=massMax; }
+
+  //
+  //AliAnalysisCuts interface
+  //
+  virtual Bool_t IsSelected(TObject* pair);
+  virtual Bool_t IsSelected(TList*   /* list */ ) {return kFALSE;}
+
+  // cut decision from the leg momenta, no state is changed
+  Bool_t IsSelected(const AliDielectronLegBuffer &legs1, Int_t i1,
+                    const AliDielectronLegBuffer &legs2, Int_t i2, Double_t magField) const;
+
+  static Double_t PhivPair(Double_t px1, Double_t py1, Double_t pz1, Short_t q1,
+                           Double_t px2, Double_t py2, Double_t pz2, Short_t q2, Double_t magField);
+
+private:
+  Bool_t Decision(Double_t mass, Double_t openingAngle, Double_t phiv) const;
+
+  Bool_t   fCutMass;               // apply the mass cut
+  Double_t fMassMin;               // lower mass limit
+  Double_t fMassMax;               // upper mass limit
+  Bool_t   fMassExclude;           // reject pairs inside the mass range
+  Bool_t   fCutOpeningAngle;       // apply the opening angle cut
+  Double_t fOpeningAngleMin;       // lower opening angle limit
+  Double_t fOpeningAngleMax;       // upper opening angle limit
+  Bool_t   fOpeningAngleExclude;   // reject pairs inside the opening angle range
+  Bool_t   fCutPhiv;               // apply the phiV rejection
+  Double_t fPhivMin;               // lower phiV limit of the rejected region
+  Double_t fPhivMax;               // upper phiV limit of the rejected region
+  Double_t fPhivMassMax;           // phiV rejection only below this mass
+
+  AliDielectronPairKineCuts(const AliDielectronPairKineCuts &c);
+  AliDielectronPairKineCuts &operator=(const AliDielectronPairKineCuts &c);
+
+  ClassDef(AliDielectronPairKineCuts,1)         //Kinematic pair cuts applied from the leg momenta
+};
+
+#endif
@@ -28,6 +28,8 @@ Detailed description
 #include <TMath.h>
 #include <TRandom3.h>
 #include <TObjArray.h>
+#include <TDatabasePDG.h>
+#include <TParticlePDG.h>
 
 #include <AliVTrack.h>
 
@@ -44,6 +46,11 @@ AliDielectronTrackRotator::AliDielectronTrackRotator() :
   fStartAnglePhi(TMath::Pi()),
   fConeAnglePhi(TMath::Pi()/6.),
   fKeepLocalY(kFALSE),
+  fBatchMode(kFALSE),
+  fPreCutMassMin(0.),
+  fPreCutMassMax(0.),
+  fPreCutPtMin(0.),
+  fPreCutPtMax(0.),
   fkArrTracksP(0x0),
   fkArrTracksN(0x0),
   fCurrentIteration(0),
@@ -56,7 +63,10 @@ AliDielectronTrackRotator::AliDielectronTrackRotator() :
   fVTrackN(0x0),
   fPdgLeg1(-11),
   fPdgLeg2(11),
-  fSameTracks(kTRUE)
+  fSameTracks(kTRUE),
+  fBatchAngle(),
+  fBatchRotateP(),
+  fBatchPassed()
 {
   //
   // Default Constructor
@@ -72,6 +82,11 @@ AliDielectronTrackRotator::AliDielectronTrackRotator(const char* name, const cha
   fStartAnglePhi(TMath::Pi()),
   fConeAnglePhi(TMath::Pi()/6.),
   fKeepLocalY(kFALSE),
+  fBatchMode(kFALSE),
+  fPreCutMassMin(0.),
+  fPreCutMassMax(0.),
+  fPreCutPtMin(0.),
+  fPreCutPtMax(0.),
   fkArrTracksP(0x0),
   fkArrTracksN(0x0),
   fCurrentIteration(0),
@@ -84,7 +99,10 @@ AliDielectronTrackRotator::AliDielectronTrackRotator(const char* name, const cha
   fVTrackN(0x0),
   fPdgLeg1(-11),
   fPdgLeg2(11),
-  fSameTracks(kTRUE)
+  fSameTracks(kTRUE),
+  fBatchAngle(),
+  fBatchRotateP(),
+  fBatchPassed()
 {
   //
   // Named Constructor
@@ -130,19 +148,31 @@ Bool_t AliDielectronTrackRotator::NextCombination()
     return kFALSE;
   }
   
-  if (fCurrentIteration==fIterations){
-    fCurrentIteration=0;
-    ++fCurrentTackP;
-  }
-  
-  if (fCurrentTackP==nP){
-    ++fCurrentTackN;
-    fCurrentTackP=0;
-  }
-  
-  if (fCurrentTackN==nN){
-    Reset();
-    return kFALSE;
+  while (kTRUE){
+    if (fCurrentIteration==fIterations){
+      fCurrentIteration=0;
+      ++fCurrentTackP;
+    }
+
+    if (fCurrentTackP==nP){
+      ++fCurrentTackN;
+      fCurrentTackP=0;
+    }
+
+    if (fCurrentTackN==nN){
+      Reset();
+      return kFALSE;
+    }
+
+    if (!fBatchMode) break;
+
+    // batch mode: skip the rotations failing the pre-selection
+    if (fCurrentIteration==0 && !PrepareBatch()){
+      Reset();
+      return kFALSE;
+    }
+    if (fBatchPassed[fCurrentIteration]) break;
+    ++fCurrentIteration;
   }
   
   if (!RotateTracks()){
@@ -181,19 +211,104 @@ Bool_t AliDielectronTrackRotator::RotateTracks()
   fVTrackP=trackP;
   fVTrackN=trackN;
 
-  Double_t angle  = fStartAnglePhi+(2*gRandom->Rndm()-1)*fConeAnglePhi;
-  Int_t    charge = TMath::Nint(gRandom->Rndm());
-  if( fKeepLocalY){// only rotate by multiples of one TPC chamber size
-    angle = (Int_t) ( angle /  TMath::Pi() * 9 ) ;
+  Double_t angle  = 0.;
+  Bool_t   rotateP = kTRUE;
+  if (fBatchMode){
+    // angle and leg drawn in PrepareBatch
+    angle   = fBatchAngle[fCurrentIteration];
+    rotateP = fBatchRotateP[fCurrentIteration];
+  } else {
+    angle   = fStartAnglePhi+(2*gRandom->Rndm()-1)*fConeAnglePhi;
+    Int_t charge = TMath::Nint(gRandom->Rndm());
+    if( fKeepLocalY){// only rotate by multiples of one TPC chamber size
+      angle = (Int_t) ( angle /  TMath::Pi() * 9 ) ;
+    }
+    rotateP = (fRotationType==kRotatePositive||(fRotationType==kRotateBothRandom&&charge==0));
   }
   
-  if (fRotationType==kRotatePositive||(fRotationType==kRotateBothRandom&&charge==0)){
+  if (rotateP){
     AliDielectronHelper::RotateKFParticle(&fTrackP, angle, fEvent);
-  }
-  
-  if (fRotationType==kRotateNegative||(fRotationType==kRotateBothRandom&&charge==1)){
+  } else {
     AliDielectronHelper::RotateKFParticle(&fTrackN, angle, fEvent);
   }
 
   return kTRUE;
 }
+
+//______________________________________________
+Bool_t AliDielectronTrackRotator::PrepareBatch()
+{
+  //
+  // Draw the rotations of all iterations of the current track pair and
+  // pre-select them on the pair mass and pt. These are computed for all
+  // angles at once from the leg four-vectors, only the rotated pairs passing
+  // are then built with the full KF rotation in RotateTracks.
+  // The pre-selection should be looser than the pair cuts, since the KF pair
+  // is constrained to a common vertex
+  //
+
+  fBatchAngle.Set(fIterations);
+  fBatchRotateP.Set(fIterations);
+  fBatchPassed.Set(fIterations);
+  for (Int_t ileg=0; ileg<2; ++ileg){
+    fBatchCos[ileg].Set(fIterations);
+    fBatchSin[ileg].Set(fIterations);
+  }
+  fBatchPassed.Reset();
+
+  AliVTrack *trackP=dynamic_cast<AliVTrack*>(fkArrTracksP->UncheckedAt(fCurrentTackP));
+  AliVTrack *trackN=dynamic_cast<AliVTrack*>(fkArrTracksN->UncheckedAt(fCurrentTackN));
+  if (!trackP||!trackN) return kFALSE;
+  if (trackP==trackN) return kTRUE;
+
+  // angles drawn in the same sequence as without batch mode
+  for (UInt_t iter=0; iter<fIterations; ++iter){
+    Double_t angle  = fStartAnglePhi+(2*gRandom->Rndm()-1)*fConeAnglePhi;
+    Int_t    charge = TMath::Nint(gRandom->Rndm());
+    if( fKeepLocalY){// only rotate by multiples of one TPC chamber size
+      angle = (Int_t) ( angle /  TMath::Pi() * 9 ) ;
+    }
+    Bool_t rotateP = (fRotationType==kRotatePositive||(fRotationType==kRotateBothRandom&&charge==0));
+    fBatchAngle[iter]   = angle;
+    fBatchRotateP[iter] = rotateP;
+    // the leg not rotated keeps its momentum: cos 1, sin 0
+    Double_t c = TMath::Cos(angle);
+    Double_t s = TMath::Sin(angle);
+    fBatchCos[0][iter] = rotateP ? c  : 1.;
+    fBatchSin[0][iter] = rotateP ? s  : 0.;
+    fBatchCos[1][iter] = rotateP ? 1. : c;
+    fBatchSin[1][iter] = rotateP ? 0. : s;
+  }
+
+  // leg four-vectors
+  TParticlePDG *partP = TDatabasePDG::Instance()->GetParticle(fPdgLeg1);
+  TParticlePDG *partN = TDatabasePDG::Instance()->GetParticle(fPdgLeg2);
+  const Double_t mP = partP ? partP->Mass() : 0.;
+  const Double_t mN = partN ? partN->Mass() : 0.;
+  const Double_t pxP=trackP->Px(), pyP=trackP->Py(), pzP=trackP->Pz();
+  const Double_t pxN=trackN->Px(), pyN=trackN->Py(), pzN=trackN->Pz();
+  const Double_t e   = TMath::Sqrt(pxP*pxP+pyP*pyP+pzP*pzP+mP*mP) + TMath::Sqrt(pxN*pxN+pyN*pyN+pzN*pzN+mN*mN);
+  const Double_t pz  = pzP+pzN;
+  const Double_t m2z = e*e-pz*pz;
+
+  const Bool_t cutMass = fPreCutMassMax>fPreCutMassMin;
+  const Bool_t cutPt   = fPreCutPtMax>fPreCutPtMin;
+  const Double_t mass2Min = fPreCutMassMin>0. ? fPreCutMassMin*fPreCutMassMin : -1.e30;
+  const Double_t mass2Max = fPreCutMassMax*fPreCutMassMax;
+  const Double_t pt2Min   = fPreCutPtMin>0. ? fPreCutPtMin*fPreCutPtMin : -1.;
+  const Double_t pt2Max   = fPreCutPtMax*fPreCutPtMax;
+
+  // rotation of px,py as in AliDielectronHelper::RotateKFParticle
+  const Double_t *cP=fBatchCos[0].GetArray(), *sP=fBatchSin[0].GetArray();
+  const Double_t *cN=fBatchCos[1].GetArray(), *sN=fBatchSin[1].GetArray();
+  Char_t *passed=fBatchPassed.GetArray();
+  for (UInt_t iter=0; iter<fIterations; ++iter){
+    const Double_t px  = cP[iter]*pxP + sP[iter]*pyP + cN[iter]*pxN + sN[iter]*pyN;
+    const Double_t py  = cP[iter]*pyP - sP[iter]*pxP + cN[iter]*pyN - sN[iter]*pxN;
+    const Double_t pt2 = px*px+py*py;
+    const Double_t m2  = m2z-pt2;
+    passed[iter] = (!cutMass || (m2>=mass2Min && m2<mass2Max)) && (!cutPt || (pt2>=pt2Min && pt2<pt2Max));
+  }
+
+  return kTRUE;
+}
@@ -20,6 +20,8 @@
 //#############################################################
 
 #include <TNamed.h>
+#include <TArrayC.h>
+#include <TArrayD.h>
 
 #include <AliKFParticle.h>
 
@@ -46,6 +48,9 @@ public:
   void SetStartAnglePhi(Double_t phi)      { fStartAnglePhi=phi; }
   void SetConeAnglePhi(Double_t phi)       { fConeAnglePhi=phi;  }
   void SetKeepLocalY(Bool_t keep)          { fKeepLocalY=keep;  }
+  void SetBatchMode(Bool_t batch=kTRUE)    { fBatchMode=batch;  }
+  void SetPreCutMass(Double_t min, Double_t max) { fPreCutMassMin=min; fPreCutMassMax=max; }
+  void SetPreCutPt(Double_t min, Double_t max)   { fPreCutPtMin=min;   fPreCutPtMax=max;   }
 
   //Getters
   Int_t GetIterations() const           { return fIterations;    }
@@ -53,6 +58,7 @@ public:
   Double_t GetStartAnglePhi() const     { return fStartAnglePhi; }
   Double_t GetConeAnglePhi() const      { return fConeAnglePhi;  }
   Bool_t GetKeepLocalY() const          { return fKeepLocalY;  }
+  Bool_t GetBatchMode() const           { return fBatchMode;     }
 
   void SetEvent(AliVEvent * const ev)   { fEvent = ev;           }
   void SetPdgLegs(Int_t pdfLeg1, Int_t pdfLeg2) { fPdgLeg1=pdfLeg1; fPdgLeg2=pdfLeg2; }
@@ -73,6 +79,12 @@ private:
   Double_t fConeAnglePhi;           // opening angle in phi for multiple rotation
   Bool_t fKeepLocalY;               // rotate on such an angle that the position wrt TPC chamber borders stays the same
 
+  Bool_t   fBatchMode;              // pre-select all rotations of a track pair at once
+  Double_t fPreCutMassMin;          // minimum pair mass of the pre-selection
+  Double_t fPreCutMassMax;          // maximum pair mass of the pre-selection (off if <= minimum)
+  Double_t fPreCutPtMin;            // minimum pair pt of the pre-selection
+  Double_t fPreCutPtMax;            // maximum pair pt of the pre-selection (off if <= minimum)
+
   const TObjArray *fkArrTracksP;    //! array of positive tracks
   const TObjArray *fkArrTracksN;    //! array of negative tracks
 
@@ -92,13 +104,20 @@ private:
   Int_t fPdgLeg2;                   //! pdg code leg2
   Bool_t fSameTracks;               //! tracks in both arrays at current position are the same
 
+  TArrayD fBatchAngle;              //! rotation angles of the current track pair
+  TArrayD fBatchCos[2];             //! cosine of the rotation of the positive/negative leg
+  TArrayD fBatchSin[2];             //! sine of the rotation of the positive/negative leg
+  TArrayC fBatchRotateP;            //! positive (1) or negative (0) leg rotated
+  TArrayC fBatchPassed;             //! rotation passed the pre-selection
+
   Bool_t RotateTracks();
+  Bool_t PrepareBatch();
   
   AliDielectronTrackRotator(const AliDielectronTrackRotator &c);
   AliDielectronTrackRotator &operator=(const AliDielectronTrackRotator &c);
 
   
-  ClassDef(AliDielectronTrackRotator,2)         // Dielectron TrackRotator
+  ClassDef(AliDielectronTrackRotator,3)         // Dielectron TrackRotator
 };
 
 
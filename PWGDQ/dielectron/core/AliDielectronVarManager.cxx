@@ -661,6 +661,11 @@ TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
 TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+Bool_t          AliDielectronVarManager::fgTrackCacheEnabled = kFALSE;
+TBits*          AliDielectronVarManager::fgTrackCacheFillMap = 0x0;
+std::map<const TObject*,Int_t> AliDielectronVarManager::fgTrackCacheIndex;
+std::vector<const TBits*>      AliDielectronVarManager::fgTrackCacheMaps;
+std::vector<Double_t>          AliDielectronVarManager::fgTrackCacheValues;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -22,6 +22,9 @@
 //#                                                           #
 //#############################################################
 
+#include <map>
+#include <vector>
+
 #include <TNamed.h>
 #include <TProfile.h>
 #include <TProfile2D.h>
@@ -66,6 +69,7 @@
 #include <AliAODpidUtil.h>
 #include <AliPID.h>
 #include <AliPIDResponse.h>
+#include <AliPIDResponseCache.h>
 #include <AliESDtrackCuts.h>
 
 #include "AliDielectronPair.h"
@@ -702,6 +706,9 @@ public:
   static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
   static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
   static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetTrackCache(Bool_t enable, TBits *map=0x0);
+  static Bool_t IsTrackCacheEnabled() { return fgTrackCacheEnabled; }
+  static void ResetTrackCache();
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
@@ -740,6 +747,8 @@ private:
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
   static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t IsFillMapCovered(const TBits *requested, const TBits *available);
+  static void FillCachedTrack(const TObject *track, Double_t * const values);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -769,6 +778,11 @@ private:
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
   static TBits           *fgFillMap;             // map for requested variable filling
+  static Bool_t           fgTrackCacheEnabled;   // fill tracks through the per-event track cache
+  static TBits           *fgTrackCacheFillMap;   // union of the variables requested for tracks, used to fill the cache
+  static std::map<const TObject*,Int_t> fgTrackCacheIndex; //! position of a track in the cache
+  static std::vector<const TBits*> fgTrackCacheMaps;       //! fill map each cached track was filled with
+  static std::vector<Double_t> fgTrackCacheValues;         //! cached track and pair-range values, kPairMax per track
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -802,6 +816,10 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
   // Main function to fill all available variables according to the type of particle
   //
   if (!object) return;
+  if (fgTrackCacheEnabled && (object->IsA() == AliESDtrack::Class() || object->IsA() == AliAODTrack::Class())) {
+    FillCachedTrack(object, values);
+    return;
+  }
   if      (object->IsA() == AliESDtrack::Class())       FillVarESDtrack(static_cast<const AliESDtrack*>(object), values);
   else if (object->IsA() == AliAODTrack::Class())       FillVarAODTrack(static_cast<const AliAODTrack*>(object), values);
   else if (object->IsA() == AliMCParticle::Class())     FillVarMCParticle(static_cast<const AliMCParticle*>(object), values);
@@ -818,6 +836,66 @@ inline void AliDielectronVarManager::Fill(const TObject* object, Double_t * cons
 //   else printf(Form("AliDielectronVarManager::Fill: Type %s is not supported by AliDielectronVarManager!", object->ClassName())); //TODO: implement without object needed
 }
 
+inline Bool_t AliDielectronVarManager::IsFillMapCovered(const TBits *requested, const TBits *available)
+{
+  //
+  // Check that all variables requested are contained in the available ones (no map means all variables)
+  //
+  if (!available) return kTRUE;
+  if (!requested) return kFALSE;
+  for (UInt_t i=requested->FirstSetBit(); i<requested->GetNbits(); i=requested->FirstSetBit(i+1))
+    if (!available->TestBitNumber(i)) return kFALSE;
+  return kTRUE;
+}
+
+inline void AliDielectronVarManager::FillCachedTrack(const TObject *track, Double_t * const values)
+{
+  //
+  // Fill track variables through the per-event cache. A track is filled once with the union of all
+  // variables requested by the configured cuts and histograms (fgTrackCacheFillMap), further requests
+  // for the same track are served by a copy, e.g. for legs which are shared by many pairs.
+  // Requests outside of the union are added to it. Event variables are always taken from the current event data.
+  //
+  std::map<const TObject*,Int_t>::const_iterator it=fgTrackCacheIndex.find(track);
+  Int_t index=-1;
+  if (it!=fgTrackCacheIndex.end()) {
+    index=it->second;
+    if (IsFillMapCovered(fgFillMap,fgTrackCacheMaps[index])) {
+      const Double_t *cached=&fgTrackCacheValues[index*kPairMax];
+      for (Int_t i=0; i<kPairMax; ++i) values[i]=cached[i];
+      for (Int_t i=kPairMax; i<kNMaxValues; ++i) values[i]=fgData[i];
+      values[AliDielectronVarManager::kRndm]=gRandom->Rndm();
+      return;
+    }
+  }
+
+  // fill with the union of the requested variables
+  TBits *requested=fgFillMap;
+  if (fgTrackCacheFillMap && requested) {
+    if (!IsFillMapCovered(requested,fgTrackCacheFillMap)) {
+      // extend the union by this request, tracks cached so far were filled without it
+      (*fgTrackCacheFillMap)|=(*requested);
+      ResetTrackCache();
+      index=-1;
+    }
+    fgFillMap=fgTrackCacheFillMap;
+  }
+  if (track->IsA() == AliESDtrack::Class()) FillVarESDtrack(static_cast<const AliESDtrack*>(track), values);
+  else                                      FillVarAODTrack(static_cast<const AliAODTrack*>(track), values);
+  const TBits *filled=fgFillMap;
+  fgFillMap=requested;
+
+  if (index<0) {
+    index=fgTrackCacheMaps.size();
+    fgTrackCacheIndex[track]=index;
+    fgTrackCacheMaps.push_back(filled);
+    fgTrackCacheValues.resize((index+1)*kPairMax);
+  }
+  fgTrackCacheMaps[index]=filled;
+  Double_t *cached=&fgTrackCacheValues[index*kPairMax];
+  for (Int_t i=0; i<kPairMax; ++i) cached[i]=values[i];
+}
+
 inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *particle, Double_t * const values)
 {
   ///
@@ -1095,30 +1173,30 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTPCnSigmaEle]   =(AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTPCnSigmaPio]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kPion);
+  values[AliDielectronVarManager::kTPCnSigmaMuo]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kTPCnSigmaKao]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kTPCnSigmaPro]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
+  values[AliDielectronVarManager::kITSnSigmaEleRaw]= AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kITSnSigmaEle]   =(AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kElectron)
                                                      -AliDielectronPID::GetCntrdCorrITS(particle)
                                                      ) / AliDielectronPID::GetWdthCorrITS(particle);
 
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kITSnSigmaPio]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kPion);
+  values[AliDielectronVarManager::kITSnSigmaMuo]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kITSnSigmaKao]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kITSnSigmaPro]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTOFnSigmaEle]   =(AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+  values[AliDielectronVarManager::kTOFnSigmaPio]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kPion);
+  values[AliDielectronVarManager::kTOFnSigmaMuo]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kTOFnSigmaKao]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kTOFnSigmaPro]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kProton);
 
   //EMCAL PID information
   Double_t eop=0;
@@ -1351,29 +1429,29 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     }
 
     // nsigma for various detectors
-    if(Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-    if(Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron)-AliDielectronPID::GetCorrVal()-AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+    if(Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kElectron);
+    if(Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kElectron)-AliDielectronPID::GetCorrVal()-AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-    if(Req(kTPCnSigmaPio)) values[kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-    if(Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-    if(Req(kTPCnSigmaKao)) values[kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-    if(Req(kTPCnSigmaPro)) values[kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+    if(Req(kTPCnSigmaPio)) values[kTPCnSigmaPio]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kPion);
+    if(Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kMuon);
+    if(Req(kTPCnSigmaKao)) values[kTPCnSigmaKao]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kKaon);
+    if(Req(kTPCnSigmaPro)) values[kTPCnSigmaPro]=AliPIDResponseCache::NumberOfSigmasTPC(fgPIDResponse,particle,AliPID::kProton);
 
-    if(Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-    if(Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
+    if(Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kElectron);
+    if(Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
 
-    if(Req(kITSnSigmaPio)) values[kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-    if(Req(kITSnSigmaMuo)) values[kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-    if(Req(kITSnSigmaKao)) values[kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-    if(Req(kITSnSigmaPro)) values[kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+    if(Req(kITSnSigmaPio)) values[kITSnSigmaPio]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kPion);
+    if(Req(kITSnSigmaMuo)) values[kITSnSigmaMuo]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kMuon);
+    if(Req(kITSnSigmaKao)) values[kITSnSigmaKao]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kKaon);
+    if(Req(kITSnSigmaPro)) values[kITSnSigmaPro]=AliPIDResponseCache::NumberOfSigmasITS(fgPIDResponse,particle,AliPID::kProton);
 
-    if(Req(kTOFnSigmaEleRaw)) values[kTOFnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-    if(Req(kTOFnSigmaEle))    values[kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+    if(Req(kTOFnSigmaEleRaw)) values[kTOFnSigmaEleRaw]= AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kElectron);
+    if(Req(kTOFnSigmaEle))    values[kTOFnSigmaEle]   =(AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
 
-    if(Req(kTOFnSigmaPio)) values[kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-    if(Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-    if(Req(kTOFnSigmaKao)) values[kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-    if(Req(kTOFnSigmaPro)) values[kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+    if(Req(kTOFnSigmaPio)) values[kTOFnSigmaPio]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kPion);
+    if(Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kMuon);
+    if(Req(kTOFnSigmaKao)) values[kTOFnSigmaKao]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kKaon);
+    if(Req(kTOFnSigmaPro)) values[kTOFnSigmaPro]=AliPIDResponseCache::NumberOfSigmasTOF(fgPIDResponse,particle,AliPID::kProton);
 
     Double_t prob[AliPID::kSPECIES]={0.0};
     // switch computation off since it takes 70% of the CPU time for filling all AODtrack variables
@@ -3411,9 +3489,32 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 }
 
 
+inline void AliDielectronVarManager::SetTrackCache(Bool_t enable, TBits *map)
+{
+  //
+  // Enable the per-event track cache. Tracks are identified by their address, therefore the cache
+  // is only valid for track objects which live for the whole event. It is reset with each new event.
+  // 'map' should contain all track variables requested in the event, see AliDielectron::SetUseTrackCache
+  //
+  fgTrackCacheEnabled=enable;
+  fgTrackCacheFillMap=map;
+  ResetTrackCache();
+}
+
+inline void AliDielectronVarManager::ResetTrackCache()
+{
+  //
+  // Remove all tracks from the cache, the memory is kept for the next event
+  //
+  fgTrackCacheIndex.clear();
+  fgTrackCacheMaps.clear();
+  fgTrackCacheValues.clear();
+}
+
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
   fgEvent = ev;
+  ResetTrackCache();
   if (fgKFVertex) delete fgKFVertex;
   fgKFVertex=0x0;
   if (!ev) return;
@@ -3426,6 +3527,7 @@ inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielect
 {
   for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
   for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  ResetTrackCache();
 }
 
 
@@ -3466,6 +3568,7 @@ inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evpla
 
   fgTPCEventPlane = evplane;
   FillVarTPCEventPlane(evplane,fgData);
+  ResetTrackCache(); // track variables relative to the event plane change
   //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
   //  AliDielectronVarManager::Fill(fgEvent, fgData);
 }
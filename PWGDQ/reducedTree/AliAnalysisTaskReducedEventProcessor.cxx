@@ -30,6 +30,7 @@ Instructions in AddTask_EPcorrectionsExample.C
 #include "AliHistogramManager.h"
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedEventInputHandler.h"
+#include "AliTaskCostMonitor.h"
 
 using std::cout;
 using std::endl;
@@ -44,7 +45,9 @@ AliAnalysisTaskReducedEventProcessor::AliAnalysisTaskReducedEventProcessor() :
   fReducedTask(0x0),
   fRunningMode(kUseEventsFromTree),
   fReducedEvent(),
-  fWriteFilteredTree(kFALSE)
+  fWriteFilteredTree(kFALSE),
+  fCostMonitoring(kFALSE),
+  fCostMonitor(0x0)
 {
   //
   // Default constructor
@@ -57,7 +60,9 @@ AliAnalysisTaskReducedEventProcessor::AliAnalysisTaskReducedEventProcessor(const
   fReducedTask(0x0),
   fRunningMode(runningMode),
   fReducedEvent(),
-  fWriteFilteredTree(writeFilteredTree)
+  fWriteFilteredTree(writeFilteredTree),
+  fCostMonitoring(kFALSE),
+  fCostMonitor(0x0)
 {
   //
   // Constructor
@@ -106,6 +111,11 @@ void AliAnalysisTaskReducedEventProcessor::UserCreateOutputObjects()
   // Add all histogram manager histogram lists to the output TList
   //
   fReducedTask->GetHistogramManager()->AddHistogramsToOutputList();
+  if(fCostMonitoring) {
+     fCostMonitor = new AliTaskCostMonitor(Form("fCostMonitor_%s", GetName()));
+     fCostMonitor->SetOutput(fReducedTask->GetHistogramManager()->GetHistogramOutputList());
+     fReducedTask->GetHistogramManager()->GetHistogramOutputList()->Add(fCostMonitor);
+  }
   PostData(1, fReducedTask->GetHistogramManager()->GetHistogramOutputList());
   
   if(fWriteFilteredTree) {
@@ -123,7 +133,9 @@ void AliAnalysisTaskReducedEventProcessor::UserExec(Option_t *){
   //
   // Main loop. Called for every event
   //   
+  AliTaskCostMonitor::Scope costScope(fCostMonitor, 0);
   AliReducedBaseEvent* event = NULL;
+  AliReducedEventInputHandler* handler = NULL;
   if(fRunningMode==kUseOnTheFlyReducedEvents) 
      event = dynamic_cast<AliReducedBaseEvent*>(GetInputData(0)); 
   
@@ -133,14 +145,21 @@ void AliAnalysisTaskReducedEventProcessor::UserExec(Option_t *){
      if (fMultiInputHandler)
         fInputHandler = dynamic_cast<AliInputEventHandler *>(fMultiInputHandler->GetFirstInputEventHandler());
      
-     AliReducedEventInputHandler* handler = dynamic_cast<AliReducedEventInputHandler *>(fInputHandler);
+     handler = dynamic_cast<AliReducedEventInputHandler *>(fInputHandler);
      if(handler)
        event = handler->GetReducedEvent();
   }
   
   if(!event) return;
+  
+  // with lazy reading only the event header is read by the handler; tasks which do not request their collections get the full event
+  if(handler && handler->GetLazyReading() && !fReducedTask->IsLazyReadingSupported()) {
+     handler->LoadAllCollections();
+     handler = NULL;
+  }
     
   fReducedTask->SetEvent(event);
+  fReducedTask->SetEventReader(handler && handler->GetLazyReading() ? handler : NULL);
   fReducedTask->Process();
   PostData(1, fReducedTask->GetHistogramManager()->GetHistogramOutputList());
   
@@ -157,6 +176,7 @@ void AliAnalysisTaskReducedEventProcessor::FinishTaskOutput()
     // Finish Task 
     //
   fReducedTask->Finish();
+  if(fCostMonitor) fCostMonitor->Finish();
   PostData(1, fReducedTask->GetHistogramManager()->GetHistogramOutputList());
   if(fWriteFilteredTree)
      PostData(2, fReducedTask->GetFilteredTree());
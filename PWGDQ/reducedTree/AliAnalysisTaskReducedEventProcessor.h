@@ -17,6 +17,7 @@
 class TObject;
 class AliAnalysis;
 class AliReducedAnalysisTaskSE;
+class AliTaskCostMonitor;
 
 //_________________________________________________________
 class AliAnalysisTaskReducedEventProcessor : public AliAnalysisTaskSE {
@@ -45,6 +46,9 @@ public:
   
   Bool_t GetWriteFilteredTree() const {return fWriteFilteredTree;}
   
+  void SetCostMonitoring(Bool_t flag=kTRUE) {fCostMonitoring=flag;}
+  AliTaskCostMonitor* GetCostMonitor() const {return fCostMonitor;}
+  
  protected:
   AliReducedAnalysisTaskSE* fReducedTask;      // Pointer to the analysis task which will process the reduced events
   
@@ -54,10 +58,13 @@ public:
   
   Bool_t fWriteFilteredTree;                   // if kTRUE, the reduced task will produce filtered reduced trees
   
+  Bool_t fCostMonitoring;                      // if kTRUE, the processing time of the reduced task is recorded in the output
+  AliTaskCostMonitor* fCostMonitor;            //! cost monitor, added to the histogram output list
+  
   AliAnalysisTaskReducedEventProcessor(const AliAnalysisTaskReducedEventProcessor &c);
   AliAnalysisTaskReducedEventProcessor& operator= (const AliAnalysisTaskReducedEventProcessor &c);
 
-  ClassDef(AliAnalysisTaskReducedEventProcessor, 4);
+  ClassDef(AliAnalysisTaskReducedEventProcessor, 5);
 };
 
 #endif
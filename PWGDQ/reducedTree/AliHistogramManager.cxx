@@ -48,7 +48,14 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fIsCompiled(kFALSE),
+  fCompiledClassStart(),
+  fCompiledHists(),
+  fCompiledFillMode(),
+  fCompiledVarStart(),
+  fCompiledVars(),
+  fCompiledWeight()
 {
   //
   // Constructor
@@ -70,7 +77,14 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fIsCompiled(kFALSE),
+  fCompiledClassStart(),
+  fCompiledHists(),
+  fCompiledFillMode(),
+  fCompiledVarStart(),
+  fCompiledVars(),
+  fCompiledWeight()
 {
   //
   // Constructor
@@ -130,6 +144,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fIsCompiled = kFALSE;
 }
 
 //_________________________________________________________________
@@ -143,6 +158,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fIsCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -282,6 +298,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fIsCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -423,6 +440,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF
   //
+  fIsCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -472,6 +490,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF with equal or variable bin widths
   //
+  fIsCompiled = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -604,6 +623,90 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 
+//__________________________________________________________________
+void AliHistogramManager::Compile() {
+  //
+  // Build the compiled list of histograms for each histogram class.
+  // The histogram type and the variables are decoded here once from the unique IDs set in AddHistogram(),
+  // and histograms with variables which are not used are left out (they would never be filled).
+  //
+  fCompiledClassStart.clear(); fCompiledHists.clear(); fCompiledFillMode.clear();
+  fCompiledVarStart.clear(); fCompiledVars.clear(); fCompiledWeight.clear();
+  fCompiledClassStart.push_back(0);
+  fCompiledVarStart.push_back(0);
+  
+  TIter nextClass(&fMainList);
+  THashList* hList=0x0;
+  Int_t classIndex = 0;
+  while((hList=(THashList*)nextClass())) {
+    hList->SetUniqueID(++classIndex);      // the class index (+1) is stored in the unique ID of the histogram list
+    
+    TIter next(hList);
+    TObject* h=0x0;
+    while((h=next())) {
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
+      Int_t thnDim = 0;
+      if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
+      Int_t dimension = 0;
+      if(!isTHn) dimension = ((TH1*)h)->GetDimension();
+      
+      uid = (uid-(uid%100))/100;
+      Int_t varT = -1;
+      Int_t varW = -1;
+      if(uid>0) {
+        varW = uid%(fNVars+1)-1;
+        if(varW==0) varW=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) varT = uid - 1;
+      }
+      if(varW>AliReducedVarManager::kNothing && !fUsedVars[varW]) continue;
+      
+      Int_t mode = -1;
+      std::vector<Int_t> vars;
+      if(!isTHn) {
+        vars.push_back(((TH1*)h)->GetXaxis()->GetUniqueID());
+        if(dimension>1 || isProfile) vars.push_back(((TH1*)h)->GetYaxis()->GetUniqueID());
+        if(dimension>2 || (dimension==2 && isProfile)) vars.push_back(((TH1*)h)->GetZaxis()->GetUniqueID());
+        if(dimension==3 && isProfile) vars.push_back(varT);
+        if(dimension==1) mode = (isProfile ? kFillProfile : kFillTH1);
+        if(dimension==2) mode = (isProfile ? kFillProfile2D : kFillTH2);
+        if(dimension==3) mode = (isProfile ? kFillProfile3D : kFillTH3);
+      }
+      else {
+        for(Int_t idim=0;idim<thnDim;++idim) vars.push_back(((THnF*)h)->GetAxis(idim)->GetUniqueID());
+        mode = kFillTHn;
+      }
+      if(mode<0) continue;
+      
+      Bool_t allVarsGood = kTRUE;
+      for(UInt_t iv=0; iv<vars.size(); ++iv) 
+        allVarsGood &= (vars[iv]>=0 && vars[iv]<AliReducedVarManager::kNVars && fUsedVars[vars[iv]]);
+      if(!allVarsGood) continue;
+      
+      fCompiledHists.push_back(h);
+      fCompiledFillMode.push_back(mode);
+      fCompiledWeight.push_back(varW>AliReducedVarManager::kNothing ? varW : -1);
+      fCompiledVars.insert(fCompiledVars.end(), vars.begin(), vars.end());
+      fCompiledVarStart.push_back(fCompiledVars.size());
+    }  // end loop over histograms
+    fCompiledClassStart.push_back(fCompiledHists.size());
+  }  // end loop over histogram classes
+  fIsCompiled = kTRUE;
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassIndex(const Char_t* className) {
+  //
+  //  get the index of a histogram class to be used with FillHistClass(Int_t, Float_t*); -1 if the class does not exist
+  //
+  if(!fIsCompiled) Compile();
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  return Int_t(hList->GetUniqueID())-1;
+}
+
 //__________________________________________________________________
 void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
   //
@@ -615,131 +718,58 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
     cout << "         Histogram list not filled" << endl; */
     return;
   }
-  if(!hList) {
-    return;
-  }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
+  if(!fIsCompiled) Compile();
+  FillHistClass(Int_t(hList->GetUniqueID())-1, values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classIndex, Float_t* values) {
+  //
+  //  fill a class of histograms using the compiled histogram lists
+  //
+  if(classIndex<0) return;
+  if(!fIsCompiled) Compile();
+  if(classIndex>=Int_t(fCompiledClassStart.size())-1) return;
+  
   Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW])
-            ((THnF*)h)->Fill(fillValues,values[varW]);
-        }
-        else
-          ((THnF*)h)->Fill(fillValues);
-      }
-    }
-  }
+  for(Int_t ih=fCompiledClassStart[classIndex]; ih<fCompiledClassStart[classIndex+1]; ++ih) {
+    TObject* h = fCompiledHists[ih];
+    const Int_t* v = &fCompiledVars[fCompiledVarStart[ih]];
+    Int_t varW = fCompiledWeight[ih];
+    switch(fCompiledFillMode[ih]) {
+      case kFillTH1:
+        if(varW>=0) ((TH1F*)h)->Fill(values[v[0]],values[varW]);
+        else ((TH1F*)h)->Fill(values[v[0]]);
+        break;
+      case kFillProfile:
+        if(varW>=0) ((TProfile*)h)->Fill(values[v[0]],values[v[1]],values[varW]);
+        else ((TProfile*)h)->Fill(values[v[0]],values[v[1]]);
+        break;
+      case kFillTH2:
+        if(varW>=0) ((TH2F*)h)->Fill(values[v[0]],values[v[1]],values[varW]);
+        else ((TH2F*)h)->Fill(values[v[0]],values[v[1]]);
+        break;
+      case kFillProfile2D:
+        if(varW>=0) ((TProfile2D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[varW]);
+        else ((TProfile2D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]]);
+        break;
+      case kFillTH3:
+        if(varW>=0) ((TH3F*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[varW]);
+        else ((TH3F*)h)->Fill(values[v[0]],values[v[1]],values[v[2]]);
+        break;
+      case kFillProfile3D:
+        if(varW>=0) ((TProfile3D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[v[3]],values[varW]);
+        else ((TProfile3D*)h)->Fill(values[v[0]],values[v[1]],values[v[2]],values[v[3]]);
+        break;
+      case kFillTHn:
+        for(Int_t idim=0; idim<fCompiledVarStart[ih+1]-fCompiledVarStart[ih]; ++idim) fillValues[idim] = values[v[idim]];
+        if(varW>=0) ((THnF*)h)->Fill(fillValues,values[varW]);
+        else ((THnF*)h)->Fill(fillValues);
+        break;
+      default:
+        break;
+    }  // end switch
+  }  // end loop over compiled histograms
 }
 
 //__________________________________________________________________
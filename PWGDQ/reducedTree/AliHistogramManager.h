@@ -13,6 +13,7 @@
 #include <THn.h>
 #include <TList.h>
 #include <THashList.h>
+#include <vector>
 
 #include "AliReducedVarManager.h"
 
@@ -65,6 +66,12 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classIndex, Float_t* values);
+  // NOTE: Compile() builds, for each histogram class, the list of (histogram, fill mode, variable indices) to be used when filling.
+  //       It is called automatically before the first fill and again after adding new histograms.
+  //       The class index returned by GetHistClassIndex() can be used to fill a class without any string lookup.
+  void Compile();
+  Int_t GetHistClassIndex(const Char_t* className);
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -101,9 +108,21 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // compiled histogram lists
+  enum CompiledFillModes {
+    kFillTH1=0, kFillProfile, kFillTH2, kFillProfile2D, kFillTH3, kFillProfile3D, kFillTHn
+  };
+  Bool_t fIsCompiled;                             //! true if the compiled lists are up to date with the histogram definitions
+  std::vector<Int_t> fCompiledClassStart;         //! first compiled histogram of each class (in the order of fMainList), size nclasses+1
+  std::vector<TObject*> fCompiledHists;           //! compiled histograms
+  std::vector<Int_t> fCompiledFillMode;           //! fill mode of each compiled histogram, see CompiledFillModes
+  std::vector<Int_t> fCompiledVarStart;           //! first entry in fCompiledVars of each compiled histogram, size nhists+1
+  std::vector<Int_t> fCompiledVars;               //! variables used to fill each compiled histogram, in the order of the Fill() arguments
+  std::vector<Int_t> fCompiledWeight;             //! weight variable of each compiled histogram, -1 if not weighted
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
   
-  ClassDef(AliHistogramManager, 3)
+  ClassDef(AliHistogramManager, 4)
 };
 
 #endif
@@ -21,6 +21,7 @@ using std::flush;
 
 #include "AliReducedVarManager.h"
 #include "AliReducedBaseTrack.h"
+#include "AliReducedLegBuffer.h"
 
 ClassImp(AliMixingHandler);
 
@@ -187,6 +188,9 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   //
   // Fill the leg1 and leg2 lists in the appropriate category, based on the event 
   // characteristics (centrality, vtxz, ep)
+  // NOTE: For the resonance legs mixing setup, the pools are made of packed leg buffers (AliReducedLegBuffer)
+  //       holding only the leg kinematics, charge and cut mask. For the correlation setup, the pools hold TLists
+  //       with clones of the input objects, since the full pair information of the trigger particle is needed.
   //
   if(!fIsInitialized) Init();
   if(leg1List->GetEntries()==0 && leg2List->GetEntries()==0) return;
@@ -199,23 +203,32 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   Int_t category = FindEventCategory(values);
   if(category<0) return;   // event characteristics outside the defined ranges
   
+  const Char_t* poolClass = (fMixingSetup==kMixResonanceLegs ? "AliReducedLegBuffer" : "TList");
   TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
-  if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
+  if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray(poolClass,1);
   leg1PoolP->SetOwner(kTRUE);
   TClonesArray *leg2PoolP=static_cast<TClonesArray*>(fPoolsLeg2.At(category));
-  if(!leg2PoolP) leg2PoolP = new(fPoolsLeg2[category]) TClonesArray("TList",1);
+  if(!leg2PoolP) leg2PoolP = new(fPoolsLeg2[category]) TClonesArray(poolClass,1);
   leg2PoolP->SetOwner(kTRUE);
   
   TClonesArray &leg1Pool=*leg1PoolP;
   TClonesArray &leg2Pool=*leg2PoolP;
-  // add the leg lists to the appropriate pools
-  TList *list1 = new(leg1Pool[leg1Pool.GetEntries()]) TList();
-  TList *list2 = new(leg2Pool[leg2Pool.GetEntries()]) TList();
-  list1->SetOwner(kTRUE); list2->SetOwner(kTRUE);
-  for(Int_t it=0; it<leg1List->GetEntries(); ++it)
-     list1->Add(leg1List->At(it)->Clone());
-  for(Int_t it=0; it<leg2List->GetEntries(); ++it)
-     list2->Add(leg2List->At(it)->Clone());
+  // add the legs to the appropriate pools
+  if(fMixingSetup==kMixResonanceLegs) {
+     AliReducedLegBuffer *legs1 = new(leg1Pool[leg1Pool.GetEntries()]) AliReducedLegBuffer();
+     AliReducedLegBuffer *legs2 = new(leg2Pool[leg2Pool.GetEntries()]) AliReducedLegBuffer();
+     legs1->Fill(leg1List);
+     legs2->Fill(leg2List);
+  }
+  else {
+     TList *list1 = new(leg1Pool[leg1Pool.GetEntries()]) TList();
+     TList *list2 = new(leg2Pool[leg2Pool.GetEntries()]) TList();
+     list1->SetOwner(kTRUE); list2->SetOwner(kTRUE);
+     for(Int_t it=0; it<leg1List->GetEntries(); ++it)
+        list1->Add(leg1List->At(it)->Clone());
+     for(Int_t it=0; it<leg2List->GetEntries(); ++it)
+        list2->Add(leg2List->At(it)->Clone());
+  }
     
   // increment the size of the pools in this category
   ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
@@ -395,10 +408,19 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
   // NOTE: The mixingMask is a bit map with bits toggled for the pools which need mixing
   //       The type is the pair candidate type. It is used in AliReducedPairInfo::CandidateType, mainly to know which mass assumption to be made for the legs
   //
+  if(fMixingSetup==kMixResonanceLegs) {
+     RunLegBufferMixing(leg1Pool, leg2Pool, mixingMask, type, values);
+     return;
+  }
+  
   Int_t entries = leg1Pool->GetEntries();
   if(entries<2) return;
   
+  // compiled indices of the histogram classes, to avoid histogram class look-ups in the pair loops
   TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  TArrayI histClassIds(histClassArr->GetEntries());
+  for(Int_t i=0; i<histClassArr->GetEntries(); ++i) histClassIds[i] = fHistos->GetHistClassIndex(histClassArr->At(i)->GetName());
+  delete histClassArr;
   
   TIter iterEv1Leg1Pool(leg1Pool);
   TIter iterEv1Leg2Pool(leg2Pool);
@@ -438,10 +460,10 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           if(!IsPairSelected(values, 1)) continue;   // fill histograms only if pair cuts are fulfilled
           for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) { 
-              if(fMixingSetup==kMixResonanceLegs) fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
+              if(fMixingSetup==kMixResonanceLegs) fHistos->FillHistClass(histClassIds[ibit*3+1], values);
               if(fMixingSetup==kMixCorrelation) {
                 Int_t pairType = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->PairType();
-                fHistos->FillHistClass(histClassArr->At(ibit*3+pairType)->GetName(), values);
+                fHistos->FillHistClass(histClassIds[ibit*3+pairType], values);
               }
             }
           }  
@@ -462,7 +484,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           if(!IsPairSelected(values, 0)) continue;   // fill histograms only if pair cuts are fulfilled
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
+              fHistos->FillHistClass(histClassIds[ibit*3+0], values);
           }  
 	}  // end loop over the ev2-leg1 list
       }  // end loop over the ev1-leg1 list
@@ -490,7 +512,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           if(!IsPairSelected(values, 2)) continue;   // fill histograms only if pair cuts are fulfilled
 	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
+              fHistos->FillHistClass(histClassIds[ibit*3+2], values);
           }  
 	}  // end loop over the ev2-leg2 list
       }  // end loop over the ev1-leg2 list
@@ -563,6 +585,118 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
 }
 
 
+//_________________________________________________________________________
+void AliMixingHandler::RunLegBufferMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask,
+				          Int_t type, Float_t* values) {
+  //
+  // Run event mixing over pools made of packed leg buffers (resonance legs mixing setup)
+  // NOTE: Same pairing logic as in RunEventMixing() over the track lists
+  //
+  Int_t entries = leg1Pool->GetEntries();
+  if(entries<2) return;
+  
+  // compiled indices of the histogram classes, to avoid histogram class look-ups in the pair loops
+  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  TArrayI histClassIds(histClassArr->GetEntries());
+  for(Int_t i=0; i<histClassArr->GetEntries(); ++i) histClassIds[i] = fHistos->GetHistClassIndex(histClassArr->At(i)->GetName());
+  delete histClassArr;
+  
+  ULong_t testFlags1 = 0;
+  ULong_t testFlags2 = 0;
+  for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
+    // get the leg1 and leg2 buffers for the first event
+    AliReducedLegBuffer* ev1Leg1 = (AliReducedLegBuffer*)leg1Pool->At(iev1);
+    AliReducedLegBuffer* ev1Leg2 = (AliReducedLegBuffer*)leg2Pool->At(iev1);
+    
+    for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop 
+      if(iev1==iev2) continue;
+      AliReducedLegBuffer* ev2Leg1 = (AliReducedLegBuffer*)leg1Pool->At(iev2);
+      AliReducedLegBuffer* ev2Leg2 = (AliReducedLegBuffer*)leg2Pool->At(iev2);
+      
+      //loop over the ev1-leg1 legs
+      for(Int_t i1=0; i1<ev1Leg1->GetEntries(); ++i1) {
+        // check that this leg has at least one common bit with the mixing mask
+        testFlags1 = mixingMask & ev1Leg1->GetFlags(i1);
+        if(!testFlags1) continue;
+	
+        //loop over the ev2-leg2 legs
+        for(Int_t i2=0; i2<ev2Leg2->GetEntries(); ++i2) {
+          // check that this leg has at least one common bit with the mixing mask and with ev1-leg1
+          testFlags2 = testFlags1 & ev2Leg2->GetFlags(i2);
+          if(!testFlags2) continue;
+	  
+          // fill cross-pairs (leg1 - leg2) for the enabled bits
+          AliReducedVarManager::FillPairInfoME(ev1Leg1, i1, ev2Leg2, i2, type, values);
+          if(!IsPairSelected(values, 1)) continue;   // fill histograms only if pair cuts are fulfilled
+          for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+            if((testFlags2)&(ULong_t(1)<<ibit)) 
+              fHistos->FillHistClass(histClassIds[ibit*3+1], values);
+          }  
+	}  // end loop over the ev2-leg2 legs
+	
+	if(!fMixLikeSign) continue;
+	// loop over the ev2-leg1 legs
+	for(Int_t i2=0; i2<ev2Leg1->GetEntries(); ++i2) {
+	  // check that this leg has at least one common bit with the mixing mask and with ev1-leg1
+	  testFlags2 = testFlags1 & ev2Leg1->GetFlags(i2);
+          if(!testFlags2) continue;
+	  
+	  // fill like-pairs (leg1 - leg1) for the enabled bits
+	  AliReducedVarManager::FillPairInfoME(ev1Leg1, i1, ev2Leg1, i2, type, values);
+          if(!IsPairSelected(values, 0)) continue;   // fill histograms only if pair cuts are fulfilled
+	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+            if((testFlags2)&(ULong_t(1)<<ibit)) 
+              fHistos->FillHistClass(histClassIds[ibit*3+0], values);
+          }  
+	}  // end loop over the ev2-leg1 legs
+      }  // end loop over the ev1-leg1 legs
+      
+      if(!fMixLikeSign) continue;
+      //loop over the ev1-leg2 legs
+      for(Int_t i1=0; i1<ev1Leg2->GetEntries(); ++i1) {
+	// check that this leg has at least one common bit with the mixing mask
+	testFlags1 = mixingMask & ev1Leg2->GetFlags(i1);
+        if(!testFlags1) continue;
+	
+	//loop over the ev2-leg2 legs
+	for(Int_t i2=0; i2<ev2Leg2->GetEntries(); ++i2) {
+	  // check that this leg has at least one common bit with the mixing mask and with ev1-leg2
+	  testFlags2 = testFlags1 & ev2Leg2->GetFlags(i2);
+          if(!testFlags2) continue;
+	  
+	  // fill like-pairs (leg2 - leg2) for the enabled bits
+	  AliReducedVarManager::FillPairInfoME(ev1Leg2, i1, ev2Leg2, i2, type, values);
+          if(!IsPairSelected(values, 2)) continue;   // fill histograms only if pair cuts are fulfilled
+	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+            if((testFlags2)&(ULong_t(1)<<ibit)) 
+              fHistos->FillHistClass(histClassIds[ibit*3+2], values);
+          }  
+	}  // end loop over the ev2-leg2 legs
+      }  // end loop over the ev1-leg2 legs
+    }  // end second event loop
+  }  // end first event loop
+  
+  // unset the mixing flags and remove the legs which don't have enabled mixing flags anymore
+  for(Int_t iev=0; iev<entries; ++iev) {
+    AliReducedLegBuffer* legs1 = (AliReducedLegBuffer*)leg1Pool->At(iev);
+    AliReducedLegBuffer* legs2 = (AliReducedLegBuffer*)leg2Pool->At(iev);
+    for(Int_t i=0; i<legs1->GetEntries(); ++i) legs1->UnsetFlags(i, mixingMask);
+    for(Int_t i=0; i<legs2->GetEntries(); ++i) legs2->UnsetFlags(i, mixingMask);
+    legs1->Compress();
+    legs2->Compress();
+  }
+  
+  // clean the events without any legs left
+  for(Int_t i=leg1Pool->GetEntries()-1;i>=0;--i) {
+    if(((AliReducedLegBuffer*)leg1Pool->At(i))->GetEntries()==0 && 
+       ((AliReducedLegBuffer*)leg2Pool->At(i))->GetEntries()==0) {
+       leg1Pool->RemoveAt(i); leg1Pool->Compress();
+       leg2Pool->RemoveAt(i); leg2Pool->Compress();
+    }
+  }
+}
+
+
 //_________________________________________________________________________
 Bool_t AliMixingHandler::IsPairSelected(Float_t* values, Int_t pairType) {
    //
@@ -644,6 +778,27 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       TClonesArray &leg1Pool=*leg1PoolP;
       TClonesArray *leg2PoolP = static_cast<TClonesArray*>(fPoolsLeg2.At(iCateg));
       
+      if(fMixingSetup==kMixResonanceLegs) {
+         for(Int_t iev=0; iev<leg1Pool.GetEntries(); ++iev) {
+            AliReducedLegBuffer* legs[2] = {(AliReducedLegBuffer*)leg1PoolP->At(iev), (AliReducedLegBuffer*)leg2PoolP->At(iev)};
+            cout << "	Event #" << iev << ";  No. of legs (leg1/leg2) :: " 
+            << legs[0]->GetEntries() << " / " << legs[1]->GetEntries() << endl;
+            if(debugLevel<3) continue;
+            
+            for(Int_t ileg=0; ileg<2; ++ileg) {
+               cout << "		Leg" << ileg+1 << " buffer" << endl;
+               for(Int_t itrack=0; itrack<legs[ileg]->GetEntries(); ++itrack) {
+                  cout << "		track #" << itrack << " (p/px/py/pz/charge/flags) :: "
+                  << legs[ileg]->P(itrack) << " / " << legs[ileg]->Px(itrack) << " / " 
+                  << legs[ileg]->Py(itrack) << " / " << legs[ileg]->Pz(itrack) << "/" << legs[ileg]->Charge(itrack) << " / " << flush;
+                  AliReducedVarManager::PrintBits(legs[ileg]->GetFlags(itrack), fNParallelCuts);	 
+                  cout << endl;
+               }  // end loop over legs
+            }
+         }  // end loop over events
+         continue;
+      }
+      
       TIter iterLeg1Pool(leg1PoolP);
       TIter iterLeg2Pool(leg2PoolP);
       for(Int_t iev=0; iev<leg1Pool.GetEntries(); ++iev) {
@@ -89,8 +89,8 @@ private:
   Float_t fDownscaleEvents;      // random downscale adding events to the pools
   Float_t fDownscaleTracks;      // random downscale adding tracks fo the pools
   
-  TClonesArray fPoolsLeg1;         // array of pools
-  TClonesArray fPoolsLeg2;         // array of pools
+  TClonesArray fPoolsLeg1;         // array of pools (AliReducedLegBuffer per event for kMixResonanceLegs, TList otherwise)
+  TClonesArray fPoolsLeg2;         // array of pools (AliReducedLegBuffer per event for kMixResonanceLegs, TList otherwise)
   Int_t fNParallelCuts;            // number of parallel cuts which are run
   TString fHistClassNames;         // name of the histogram classes for each cut, separated by a semicolon ";"
   TArrayI fPoolSize;               // counters for the pool sizes
@@ -108,10 +108,11 @@ private:
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void RunLegBufferMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,3);
+  ClassDef(AliMixingHandler,4);
 };
 
 #endif
@@ -18,6 +18,8 @@ using std::endl;
 #include "AliReducedBaseTrack.h"
 #include "AliReducedTrackInfo.h"
 #include "AliReducedPairInfo.h"
+#include "AliReducedVarCut.h"
+#include "AliReducedEventInputHandler.h"
 #include "AliHistogramManager.h"
 
 ClassImp(AliReducedAnalysisJpsi2ee);
@@ -35,6 +37,9 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fOptionLoopOverTracks(kTRUE),
   fOptionRunPrefilter(kTRUE),
   fOptionStoreJpsiCandidates(kFALSE),
+  fOptionUsePairKernel(kTRUE),
+  fUsePairKernelForPrefilter(kFALSE),
+  fUsePairKernelForPairCuts(kFALSE),
   fEventCuts(),
   fTrackCuts(),
   fPreFilterTrackCuts(),
@@ -44,11 +49,21 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fJpsiCandidates()
+  fJpsiCandidates(),
+  fPosLegs(),
+  fNegLegs(),
+  fPrefilterPosLegs(),
+  fPrefilterNegLegs(),
+  fHistClassIds(kNHistClasses),
+  fCompiledTrackHistClass(""),
+  fTrackHistClassIds(),
+  fCompiledPairHistClass(""),
+  fPairHistClassIds()
 {
   //
   // default constructor
   //
+  fHistClassIds.Reset(-1);
 }
 
 
@@ -64,6 +79,9 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fOptionLoopOverTracks(kTRUE),
   fOptionRunPrefilter(kTRUE),
   fOptionStoreJpsiCandidates(kFALSE),
+  fOptionUsePairKernel(kTRUE),
+  fUsePairKernelForPrefilter(kFALSE),
+  fUsePairKernelForPairCuts(kFALSE),
   fEventCuts(),
   fTrackCuts(),
   fPreFilterTrackCuts(),
@@ -73,7 +91,16 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fJpsiCandidates()
+  fJpsiCandidates(),
+  fPosLegs(),
+  fNegLegs(),
+  fPrefilterPosLegs(),
+  fPrefilterNegLegs(),
+  fHistClassIds(kNHistClasses),
+  fCompiledTrackHistClass(""),
+  fTrackHistClassIds(),
+  fCompiledPairHistClass(""),
+  fPairHistClassIds()
 {
   //
   // named constructor
@@ -88,6 +115,7 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
    fPrefilterPosTracks.SetOwner(kFALSE);
    fPrefilterNegTracks.SetOwner(kFALSE);
    fJpsiCandidates.SetOwner(kTRUE);
+   fHistClassIds.Reset(-1);
 }
 
 
@@ -195,6 +223,23 @@ Bool_t AliReducedAnalysisJpsi2ee::IsPairPreFilterSelected(Float_t* values) {
    return kFALSE;
 }
 
+//___________________________________________________________________________
+Bool_t AliReducedAnalysisJpsi2ee::CutsUsePairKernelVariablesOnly(TList* cuts) const {
+   //
+   // check whether all the cuts in the list can be evaluated on the variables filled by the pair kernel
+   // NOTE: only AliReducedVarCut cuts are inspected, any other cut type may use arbitrary pair information
+   //
+   for(Int_t i=0; i<cuts->GetEntries(); ++i) {
+      if(cuts->At(i)->IsA()!=AliReducedVarCut::Class()) return kFALSE;
+      AliReducedVarCut* cut = (AliReducedVarCut*)cuts->At(i);
+      for(Int_t icut=0; icut<cut->GetNCuts(); ++icut) {
+         if(!AliReducedVarManager::IsPairKernelVariable(cut->GetCutVariable(icut))) return kFALSE;
+         if(cut->UsesDependentVariable(icut) && !AliReducedVarManager::IsPairKernelVariable(cut->GetDependentVariable(icut))) return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
 //___________________________________________________________________________
 void AliReducedAnalysisJpsi2ee::Init() {
   //
@@ -213,6 +258,76 @@ void AliReducedAnalysisJpsi2ee::Init() {
    fHistosManager->SetDefaultVarNames(AliReducedVarManager::fgVariableNames,AliReducedVarManager::fgVariableUnits);
    
    fMixingHandler->SetHistogramManager(fHistosManager);
+   
+   // the pair kernel on packed legs is used only if the cut decisions do not depend on other pair variables
+   fUsePairKernelForPrefilter = fOptionUsePairKernel && fPreFilterPairCuts.GetEntries()>0 && CutsUsePairKernelVariablesOnly(&fPreFilterPairCuts);
+   fUsePairKernelForPairCuts = fOptionUsePairKernel && fPairCuts.GetEntries()>0 && CutsUsePairKernelVariablesOnly(&fPairCuts);
+   
+   // derive the variables to be computed from the histogram definitions and from the cuts
+   AliReducedVarManager::SetUseVars(fHistosManager->GetUsedVars());
+   AliReducedVarManager::SetUseVarsFromCuts(&fEventCuts);
+   AliReducedVarManager::SetUseVarsFromCuts(&fTrackCuts);
+   AliReducedVarManager::SetUseVarsFromCuts(&fPreFilterTrackCuts);
+   AliReducedVarManager::SetUseVarsFromCuts(&fPairCuts);
+   AliReducedVarManager::SetUseVarsFromCuts(&fPreFilterPairCuts);
+   cout << "AliReducedAnalysisJpsi2ee::Init(): " << AliReducedVarManager::GetNUsedVars() << " variables out of " 
+        << AliReducedVarManager::kNVars << " are computed" << endl;
+   
+   // compile the histogram lists and the histogram class indices
+   CompileHistClasses();
+}
+
+
+//___________________________________________________________________________
+void AliReducedAnalysisJpsi2ee::CompileHistClasses() {
+   //
+   // compile the histogram manager lists and look up the indices of the histogram classes with fixed names
+   //
+   fHistosManager->Compile();
+   const Char_t* names[kNHistClasses] = {
+      "Event_BeforeCuts", "EventTag_BeforeCuts", "EventTriggers_BeforeCuts", 
+      "Event_AfterCuts", "EventTag_AfterCuts", "EventTriggers_AfterCuts",
+      "Track_BeforeCuts", "TrackStatusFlags_BeforeCuts", "TrackITSclusterMap_BeforeCuts", "TrackTPCclusterMap_BeforeCuts",
+      "MCTruth_BeforeSelection", "MCTruth_AfterSelection"
+   };
+   fHistClassIds.Set(kNHistClasses);
+   for(Int_t i=0; i<kNHistClasses; ++i) fHistClassIds[i] = fHistosManager->GetHistClassIndex(names[i]);
+   fCompiledTrackHistClass = ""; fTrackHistClassIds.Set(0);
+   fCompiledPairHistClass = ""; fPairHistClassIds.Set(0);
+}
+
+
+//___________________________________________________________________________
+void AliReducedAnalysisJpsi2ee::CompileTrackHistClasses(TString trackClass) {
+   //
+   // look up the indices of the track histogram classes for a given class prefix
+   //
+   const Char_t* suffix[4] = {"_", "StatusFlags_", "ITSclusterMap_", "TPCclusterMap_"};
+   fTrackHistClassIds.Set(8*fTrackCuts.GetEntries());
+   for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
+      for(Int_t i=0; i<4; ++i) {
+         fTrackHistClassIds[8*icut+2*i] = fHistosManager->GetHistClassIndex(Form("%s%s%s", trackClass.Data(), suffix[i], fTrackCuts.At(icut)->GetName()));
+         fTrackHistClassIds[8*icut+2*i+1] = fHistosManager->GetHistClassIndex(Form("%s%s%s_MCTruth", trackClass.Data(), suffix[i], fTrackCuts.At(icut)->GetName()));
+      }
+   }
+   fCompiledTrackHistClass = trackClass;
+}
+
+
+//___________________________________________________________________________
+void AliReducedAnalysisJpsi2ee::CompilePairHistClasses(TString pairClass) {
+   //
+   // look up the indices of the pair histogram classes for a given class prefix
+   //
+   TString typeStr[3] = {"PP", "PM", "MM"};
+   fPairHistClassIds.Set(6*fTrackCuts.GetEntries());
+   for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
+      for(Int_t i=0; i<3; ++i) {
+         fPairHistClassIds[6*icut+2*i] = fHistosManager->GetHistClassIndex(Form("%s%s_%s", pairClass.Data(), typeStr[i].Data(), fTrackCuts.At(icut)->GetName()));
+         fPairHistClassIds[6*icut+2*i+1] = fHistosManager->GetHistClassIndex(Form("%s%s_%s_MCTruth", pairClass.Data(), typeStr[i].Data(), fTrackCuts.At(icut)->GetName()));
+      }
+   }
+   fCompiledPairHistClass = pairClass;
 }
 
 
@@ -246,20 +361,29 @@ void AliReducedAnalysisJpsi2ee::Process() {
   
   // fill event information before event cuts
   AliReducedVarManager::FillEventInfo(fEvent, fValues);
-  fHistosManager->FillHistClass("Event_BeforeCuts", fValues);
+  fHistosManager->FillHistClass(fHistClassIds[kEventBeforeCuts], fValues);
   for(UShort_t ibit=0; ibit<64; ++ibit) {
      AliReducedVarManager::FillEventTagInput(fEvent, ibit, fValues);
-     fHistosManager->FillHistClass("EventTag_BeforeCuts", fValues);
+     fHistosManager->FillHistClass(fHistClassIds[kEventTagBeforeCuts], fValues);
   }
   for(UShort_t ibit=0; ibit<64; ++ibit) {
       AliReducedVarManager::FillEventOnlineTrigger(ibit, fValues);
-      fHistosManager->FillHistClass("EventTriggers_BeforeCuts", fValues);
+      fHistosManager->FillHistClass(fHistClassIds[kEventTriggersBeforeCuts], fValues);
   }
   
   
   // apply event selection
   if(!IsEventSelected(fEvent)) return;
   
+  // read the collections needed for the selected event (only relevant for lazy reading of the input tree)
+  if(fOptionRunOverMC || fOptionLoopOverTracks) {
+    LoadEventCollection(AliReducedEventInputHandler::kTracks);
+    LoadEventCollection(AliReducedEventInputHandler::kTracks2);
+  }
+  if(fOptionLoopOverTracks && (AliReducedVarManager::GetUsedVar(AliReducedVarManager::kEMCALmatchedEnergy) ||
+                               AliReducedVarManager::GetUsedVar(AliReducedVarManager::kEMCALmatchedEOverP)))
+    LoadEventCollection(AliReducedEventInputHandler::kCaloClusters);
+  
   if(fOptionRunOverMC) FillMCTruthHistograms();
   
   // select tracks
@@ -295,14 +419,14 @@ void AliReducedAnalysisJpsi2ee::Process() {
     RunSameEventPairing();
  
   // fill event info histograms after cuts
-  fHistosManager->FillHistClass("Event_AfterCuts", fValues);
+  fHistosManager->FillHistClass(fHistClassIds[kEventAfterCuts], fValues);
   for(UShort_t ibit=0; ibit<64; ++ibit) {
      AliReducedVarManager::FillEventTagInput(fEvent, ibit, fValues);
-     fHistosManager->FillHistClass("EventTag_AfterCuts", fValues);
+     fHistosManager->FillHistClass(fHistClassIds[kEventTagAfterCuts], fValues);
   }
   for(UShort_t ibit=0; ibit<64; ++ibit) {
      AliReducedVarManager::FillEventOnlineTrigger(ibit, fValues);
-     fHistosManager->FillHistClass("EventTriggers_AfterCuts", fValues);
+     fHistosManager->FillHistClass(fHistClassIds[kEventTriggersAfterCuts], fValues);
   }
 }
 
@@ -339,25 +463,35 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedTrackInfo* track,
    //
    // fill track level histograms
    //
+   if(trackClass!=fCompiledTrackHistClass || fTrackHistClassIds.GetSize()!=8*fTrackCuts.GetEntries()) 
+      CompileTrackHistClasses(trackClass);
    Bool_t isMCTruth = fOptionRunOverMC && IsMCTruth(track);
    for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
       if(track->TestFlag(icut)) {
-         fHistosManager->FillHistClass(Form("%s_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-         if(isMCTruth) fHistosManager->FillHistClass(Form("%s_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-         for(UInt_t iflag=0; iflag<AliReducedVarManager::kNTrackingFlags; ++iflag) {
-            AliReducedVarManager::FillTrackingFlag(track, iflag, fValues);
-            fHistosManager->FillHistClass(Form("%sStatusFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-            if(isMCTruth) fHistosManager->FillHistClass(Form("%sStatusFlags_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         const Int_t* ids = fTrackHistClassIds.GetArray()+8*icut;
+         fHistosManager->FillHistClass(ids[0], fValues);
+         if(isMCTruth) fHistosManager->FillHistClass(ids[1], fValues);
+         // the flag loops are skipped if the corresponding histogram classes are not defined
+         if(ids[2]>=0 || (isMCTruth && ids[3]>=0)) {
+            for(UInt_t iflag=0; iflag<AliReducedVarManager::kNTrackingFlags; ++iflag) {
+               AliReducedVarManager::FillTrackingFlag(track, iflag, fValues);
+               fHistosManager->FillHistClass(ids[2], fValues);
+               if(isMCTruth) fHistosManager->FillHistClass(ids[3], fValues);
+            }
          }
-         for(Int_t iLayer=0; iLayer<6; ++iLayer) {
-            AliReducedVarManager::FillITSlayerFlag(track, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sITSclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-            if(isMCTruth) fHistosManager->FillHistClass(Form("%sITSclusterMap_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         if(ids[4]>=0 || (isMCTruth && ids[5]>=0)) {
+            for(Int_t iLayer=0; iLayer<6; ++iLayer) {
+               AliReducedVarManager::FillITSlayerFlag(track, iLayer, fValues);
+               fHistosManager->FillHistClass(ids[4], fValues);
+               if(isMCTruth) fHistosManager->FillHistClass(ids[5], fValues);
+            }
          }
-         for(Int_t iLayer=0; iLayer<8; ++iLayer) {
-            AliReducedVarManager::FillTPCclusterBitFlag(track, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sTPCclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-            if(isMCTruth) fHistosManager->FillHistClass(Form("%sTPCclusterMap_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         if(ids[6]>=0 || (isMCTruth && ids[7]>=0)) {
+            for(Int_t iLayer=0; iLayer<8; ++iLayer) {
+               AliReducedVarManager::FillTPCclusterBitFlag(track, iLayer, fValues);
+               fHistosManager->FillHistClass(ids[6], fValues);
+               if(isMCTruth) fHistosManager->FillHistClass(ids[7], fValues);
+            }
          }
       } // end if(track->TestFlag(icut))
    }  // end loop over cuts
@@ -369,11 +503,12 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t mask, Int_t pairType,
    //
    // fill pair level histograms
    // NOTE: pairType can be 0,1 or 2 corresponding to ++, +- or -- pairs
-   TString typeStr[3] = {"PP", "PM", "MM"};
+   if(pairClass!=fCompiledPairHistClass || fPairHistClassIds.GetSize()!=6*fTrackCuts.GetEntries()) 
+      CompilePairHistClasses(pairClass);
    for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
       if(mask & (ULong_t(1)<<icut)) {
-         fHistosManager->FillHistClass(Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(icut)->GetName()), fValues);
-         if(isMCTruth && pairType==1) fHistosManager->FillHistClass(Form("%s%s_%s_MCTruth", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         fHistosManager->FillHistClass(fPairHistClassIds[6*icut+2*pairType], fValues);
+         if(isMCTruth && pairType==1) fHistosManager->FillHistClass(fPairHistClassIds[6*icut+2*pairType+1], fValues);
       }
    }  // end loop over cuts
 }
@@ -407,19 +542,19 @@ void AliReducedAnalysisJpsi2ee::LoopOverTracks(Int_t arrayOption /*=1*/) {
       if(fOptionRunOverMC && track->IsMCTruth()) continue;
       //cout << "track " << it << ": "; AliReducedVarManager::PrintBits(track->Status()); cout << endl;
       AliReducedVarManager::FillTrackInfo(track, fValues);
-      fHistosManager->FillHistClass("Track_BeforeCuts", fValues);
+      fHistosManager->FillHistClass(fHistClassIds[kTrackBeforeCuts], fValues);
       for(UInt_t iflag=0; iflag<AliReducedVarManager::kNTrackingStatus; ++iflag) {
          //cout << "track / tracking flags :: " << track << " / "; AliReducedVarManager::PrintBits(track->Status()); cout << endl;
          AliReducedVarManager::FillTrackingFlag(track, iflag, fValues);
-         fHistosManager->FillHistClass("TrackStatusFlags_BeforeCuts", fValues);
+         fHistosManager->FillHistClass(fHistClassIds[kTrackStatusFlagsBeforeCuts], fValues);
       }
       for(Int_t iLayer=0; iLayer<6; ++iLayer) {
          AliReducedVarManager::FillITSlayerFlag(track, iLayer, fValues);
-         fHistosManager->FillHistClass("TrackITSclusterMap_BeforeCuts", fValues);
+         fHistosManager->FillHistClass(fHistClassIds[kTrackITSclusterMapBeforeCuts], fValues);
       }
       for(Int_t iLayer=0; iLayer<8; ++iLayer) {
          AliReducedVarManager::FillTPCclusterBitFlag(track, iLayer, fValues);
-         fHistosManager->FillHistClass("TrackTPCclusterMap_BeforeCuts", fValues);
+         fHistosManager->FillHistClass(fHistClassIds[kTrackTPCclusterMapBeforeCuts], fValues);
       }
       if(IsTrackSelected(track, fValues)) {
          fValues[AliReducedVarManager::kEvAverageTPCchi2] += track->TPCchi2();
@@ -441,6 +576,13 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
    if(fOptionStoreJpsiCandidates) fJpsiCandidates.Clear("C");
    fValues[AliReducedVarManager::kNpairsSelected] = 0;
    
+   // NOTE: If the pair cuts use only pair kernel variables, the pairs are first selected with the pair kernel
+   //       on the packed legs and the full pair information is computed only for the selected pairs
+   if(fUsePairKernelForPairCuts) {
+      fPosLegs.Fill(&fPosTracks);
+      fNegLegs.Fill(&fNegTracks);
+   }
+   
    TIter nextPosTrack(&fPosTracks);
    TIter nextNegTrack(&fNegTracks);
    
@@ -457,6 +599,10 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
          
          // verify that the two current tracks have at least 1 common bit
          if(!(pTrack->GetFlags() & nTrack->GetFlags())) continue;
+         if(fUsePairKernelForPairCuts) {
+            AliReducedVarManager::FillPairKernel(&fPosLegs, ip, &fNegLegs, in, AliReducedPairInfo::kJpsiToEE, fValues);
+            if(!IsPairSelected(fValues)) continue;
+         }
          AliReducedVarManager::FillPairInfo(pTrack, nTrack, AliReducedPairInfo::kJpsiToEE, fValues);
          if(IsPairSelected(fValues)) {
             FillPairHistograms(pTrack->GetFlags() & nTrack->GetFlags(), 1, pairClass, fOptionRunOverMC && IsMCTruth(pTrack, nTrack));    // 1 is for +- pairs 
@@ -480,6 +626,10 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
          
             // verify that the two current tracks have at least 1 common bit
             if(!(pTrack->GetFlags() & pTrack2->GetFlags())) continue;
+            if(fUsePairKernelForPairCuts) {
+               AliReducedVarManager::FillPairKernel(&fPosLegs, ip, &fPosLegs, ip2, AliReducedPairInfo::kJpsiToEE, fValues);
+               if(!IsPairSelected(fValues)) continue;
+            }
             AliReducedVarManager::FillPairInfo(pTrack, pTrack2, AliReducedPairInfo::kJpsiToEE, fValues);
             if(IsPairSelected(fValues)) {
                FillPairHistograms(pTrack->GetFlags() & pTrack2->GetFlags(), 0, pairClass);       // 0 is for ++ pairs 
@@ -509,6 +659,10 @@ void AliReducedAnalysisJpsi2ee::RunSameEventPairing(TString pairClass /*="PairSE
          
             // verify that the two current tracks have at least 1 common bit
             if(!(nTrack->GetFlags() & nTrack2->GetFlags())) continue;
+            if(fUsePairKernelForPairCuts) {
+               AliReducedVarManager::FillPairKernel(&fNegLegs, in, &fNegLegs, in2, AliReducedPairInfo::kJpsiToEE, fValues);
+               if(!IsPairSelected(fValues)) continue;
+            }
             AliReducedVarManager::FillPairInfo(nTrack, nTrack2, AliReducedPairInfo::kJpsiToEE, fValues);
             if(IsPairSelected(fValues)) {
                FillPairHistograms(nTrack->GetFlags() & nTrack2->GetFlags(), 2, pairClass);      // 2 is for -- pairs
@@ -535,7 +689,15 @@ void AliReducedAnalysisJpsi2ee::RunPrefilter() {
    //
    // Run the prefilter selection
    // At this point it is assumed that the track lists are filled
+   // NOTE: If the prefilter pair cuts use only pair kernel variables, the pairs are built from the packed legs
    //
+   if(fUsePairKernelForPrefilter) {
+      fPosLegs.Fill(&fPosTracks);
+      fNegLegs.Fill(&fNegTracks);
+      fPrefilterPosLegs.Fill(&fPrefilterPosTracks);
+      fPrefilterNegLegs.Fill(&fPrefilterNegTracks);
+   }
+   
    TIter nextPosTrack(&fPosTracks);
    TIter nextNegTrack(&fNegTracks);
    TIter nextPosPrefilterTrack(&fPrefilterPosTracks);
@@ -552,7 +714,8 @@ void AliReducedAnalysisJpsi2ee::RunPrefilter() {
          trackPref = (AliReducedTrackInfo*)nextPosPrefilterTrack();
          
          if(track->TrackId()==trackPref->TrackId()) continue;       // avoid self-pairing
-         AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
+         if(fUsePairKernelForPrefilter) AliReducedVarManager::FillPairKernel(&fPosLegs, ip, &fPrefilterPosLegs, ipp, AliReducedPairInfo::kJpsiToEE, fValues);
+         else AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
          if(!IsPairPreFilterSelected(fValues)) {
             track->ResetFlags(); 
             break;
@@ -563,7 +726,8 @@ void AliReducedAnalysisJpsi2ee::RunPrefilter() {
       for(Int_t ipn = 0; ipn<fPrefilterNegTracks.GetEntries(); ++ipn) {
          trackPref = (AliReducedTrackInfo*)nextNegPrefilterTrack();
          
-         AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
+         if(fUsePairKernelForPrefilter) AliReducedVarManager::FillPairKernel(&fPosLegs, ip, &fPrefilterNegLegs, ipn, AliReducedPairInfo::kJpsiToEE, fValues);
+         else AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
          if(!IsPairPreFilterSelected(fValues)) {
             track->ResetFlags(); 
             break;
@@ -578,7 +742,8 @@ void AliReducedAnalysisJpsi2ee::RunPrefilter() {
       for(Int_t ipp = 0; ipp<fPrefilterPosTracks.GetEntries(); ++ipp) {
          trackPref = (AliReducedTrackInfo*)nextPosPrefilterTrack();
          
-         AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
+         if(fUsePairKernelForPrefilter) AliReducedVarManager::FillPairKernel(&fNegLegs, in, &fPrefilterPosLegs, ipp, AliReducedPairInfo::kJpsiToEE, fValues);
+         else AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
          if(!IsPairPreFilterSelected(fValues)) {
             track->ResetFlags(); 
             break;
@@ -590,7 +755,8 @@ void AliReducedAnalysisJpsi2ee::RunPrefilter() {
          trackPref = (AliReducedTrackInfo*)nextNegPrefilterTrack();
          
          if(track->TrackId()==trackPref->TrackId()) continue;       // avoid self-pairing
-         AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
+         if(fUsePairKernelForPrefilter) AliReducedVarManager::FillPairKernel(&fNegLegs, in, &fPrefilterNegLegs, ipn, AliReducedPairInfo::kJpsiToEE, fValues);
+         else AliReducedVarManager::FillPairInfo(track, trackPref, AliReducedPairInfo::kJpsiToEE, fValues);
          if(!IsPairPreFilterSelected(fValues)) {
             track->ResetFlags(); 
             break;
@@ -673,14 +839,14 @@ void AliReducedAnalysisJpsi2ee::FillMCTruthHistograms() {
        leg1 = (leg1Id>-1 ? (AliReducedTrackInfo*)fEvent->GetTrack(leg1Id) : 0x0);
        leg2 = (leg2Id>-1 ? (AliReducedTrackInfo*)fEvent->GetTrack(leg2Id) : 0x0);
        AliReducedVarManager::FillMCTruthInfo(track, fValues, leg1, leg2);
-       fHistosManager->FillHistClass("MCTruth_BeforeSelection", fValues);
+       fHistosManager->FillHistClass(fHistClassIds[kMCTruthBeforeSelection], fValues);
        if(!leg1) continue;
        if(!leg2) continue;
        if(TMath::Abs(leg1->EtaMC())>0.9) continue;                       // TODO: use dynamic kinematic cut on legs
        if(TMath::Abs(leg2->EtaMC())>0.9) continue;
        if(leg1->PtMC()<1.0) continue;
        if(leg2->PtMC()<1.0) continue;
-       fHistosManager->FillHistClass("MCTruth_AfterSelection", fValues);
+       fHistosManager->FillHistClass(fHistClassIds[kMCTruthAfterSelection], fValues);
      }
   }
 }
@@ -6,12 +6,14 @@
 #define ALIREDUCEDANALYSISJPSI2EE_H
 
 #include <TList.h>
+#include <TArrayI.h>
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
 #include "AliReducedBaseEvent.h"
 #include "AliReducedBaseTrack.h"
 #include "AliReducedTrackInfo.h"
+#include "AliReducedLegBuffer.h"
 #include "AliHistogramManager.h"
 #include "AliMixingHandler.h"
 
@@ -19,6 +21,24 @@
 //________________________________________________________________
 class AliReducedAnalysisJpsi2ee : public AliReducedAnalysisTaskSE {
   
+public:
+  // histogram classes with fixed names, filled via their compiled class index
+  enum HistClasses {
+    kEventBeforeCuts=0,
+    kEventTagBeforeCuts,
+    kEventTriggersBeforeCuts,
+    kEventAfterCuts,
+    kEventTagAfterCuts,
+    kEventTriggersAfterCuts,
+    kTrackBeforeCuts,
+    kTrackStatusFlagsBeforeCuts,
+    kTrackITSclusterMapBeforeCuts,
+    kTrackTPCclusterMapBeforeCuts,
+    kMCTruthBeforeSelection,
+    kMCTruthAfterSelection,
+    kNHistClasses
+  };
+  
 public:
   AliReducedAnalysisJpsi2ee();
   AliReducedAnalysisJpsi2ee(const Char_t* name, const Char_t* title);
@@ -30,6 +50,7 @@ public:
   virtual void Process();
   // finish, to be executed after all events were processed
   virtual void Finish();
+  virtual Bool_t IsLazyReadingSupported() const {return kTRUE;}
   
   // setters
   void AddEventCut(AliReducedInfoCut* cut) {fEventCuts.Add(cut);}
@@ -47,6 +68,7 @@ public:
   }
   void SetRunPrefilter(Bool_t option) {fOptionRunPrefilter = option;}
   void SetStoreJpsiCandidates(Bool_t option) {fOptionStoreJpsiCandidates = option;}
+  void SetUsePairKernel(Bool_t option) {fOptionUsePairKernel = option;}
   
   // getters
   virtual AliHistogramManager* GetHistogramManager() const {return fHistosManager;}
@@ -60,6 +82,7 @@ public:
   Bool_t GetLoopOverTracks() const {return fOptionLoopOverTracks;}
   Bool_t GetRunPrefilter() const {return fOptionRunPrefilter;}
   Bool_t GetStoreJpsiCandidates() const {return fOptionStoreJpsiCandidates;}
+  Bool_t GetUsePairKernel() const {return fOptionUsePairKernel;}
   
 protected:
    AliHistogramManager* fHistosManager;   // Histogram manager
@@ -72,6 +95,9 @@ protected:
    Bool_t fOptionLoopOverTracks;       // true (default); if false do not loop over tracks and consequently no pairing
    Bool_t fOptionRunPrefilter;        // true (default); if false do not run the prefilter
    Bool_t fOptionStoreJpsiCandidates;   // false (default); if true, store the same event jpsi candidates in a TList 
+   Bool_t fOptionUsePairKernel;          // true (default); evaluate the pair cuts with the pair kernel on packed legs whenever the cuts allow it
+   Bool_t fUsePairKernelForPrefilter;    //! true if all prefilter pair cuts use only pair kernel variables
+   Bool_t fUsePairKernelForPairCuts;     //! true if all pair cuts use only pair kernel variables
   
    TList fEventCuts;               // array of event cuts
    TList fTrackCuts;               // array of track cuts
@@ -85,11 +111,26 @@ protected:
    TList fPrefilterNegTracks; // list of prefilter selected negative tracks in the current event
    TList fJpsiCandidates;       // list of Jpsi candidates --> to be used in analyses inheriting from this 
    
+   AliReducedLegBuffer fPosLegs;               //! packed legs of the selected positive tracks, same order as fPosTracks
+   AliReducedLegBuffer fNegLegs;               //! packed legs of the selected negative tracks, same order as fNegTracks
+   AliReducedLegBuffer fPrefilterPosLegs;      //! packed legs of the prefilter positive tracks, same order as fPrefilterPosTracks
+   AliReducedLegBuffer fPrefilterNegLegs;      //! packed legs of the prefilter negative tracks, same order as fPrefilterNegTracks
+   
+   TArrayI fHistClassIds;                 //! compiled indices of the histogram classes with fixed names, see HistClasses
+   TString fCompiledTrackHistClass;       //! track histogram class prefix for which fTrackHistClassIds was compiled
+   TArrayI fTrackHistClassIds;            //! compiled indices of the track histogram classes, 8 per track cut
+   TString fCompiledPairHistClass;        //! pair histogram class prefix for which fPairHistClassIds was compiled
+   TArrayI fPairHistClassIds;             //! compiled indices of the pair histogram classes, 6 per track cut (PP,PM,MM x MC truth)
+   
   Bool_t IsEventSelected(AliReducedBaseEvent* event, Float_t* values=0x0);
   Bool_t IsTrackSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsTrackPrefilterSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsPairSelected(Float_t* values);
   Bool_t IsPairPreFilterSelected(Float_t* values);
+  Bool_t CutsUsePairKernelVariablesOnly(TList* cuts) const;
+  void CompileHistClasses();
+  void CompileTrackHistClasses(TString trackClass);
+  void CompilePairHistClasses(TString pairClass);
   Bool_t IsMCTruth(AliReducedTrackInfo* ptrack, AliReducedTrackInfo* ntrack);
   Bool_t IsMCTruth(AliReducedTrackInfo* track);
   void    FindJpsiTruthLegs(AliReducedTrackInfo* mother, Int_t& leg1, Int_t& leg2);
@@ -103,7 +144,7 @@ protected:
   void FillPairHistograms(ULong_t mask, Int_t pairType, TString pairClass = "PairSE", Bool_t isMCTruth = kFALSE);
   void FillMCTruthHistograms();
   
-  ClassDef(AliReducedAnalysisJpsi2ee,4);
+  ClassDef(AliReducedAnalysisJpsi2ee,6);
 };
 
 #endif
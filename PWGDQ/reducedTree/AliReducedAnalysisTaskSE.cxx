@@ -9,6 +9,7 @@
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedEventInfo.h"
+#include "AliReducedEventInputHandler.h"
 
 ClassImp(AliReducedAnalysisTaskSE);
 
@@ -19,6 +20,7 @@ AliReducedAnalysisTaskSE::AliReducedAnalysisTaskSE() :
   fName(""),
   fTitle(""),
   fEvent(0x0),
+  fEventReader(0x0),
   fFilteredTree(0x0),
   fActiveBranches(""),
   fInactiveBranches(""),
@@ -42,6 +44,7 @@ AliReducedAnalysisTaskSE::AliReducedAnalysisTaskSE(const Char_t* name, const Cha
   fName(name),
   fTitle(title),
   fEvent(0x0),
+  fEventReader(0x0),
   fFilteredTree(0x0),
   fActiveBranches(""),
   fInactiveBranches(""),
@@ -107,6 +110,16 @@ void AliReducedAnalysisTaskSE::InitFilteredTree() {
    }
 }
 
+//___________________________________________________________________________
+Bool_t AliReducedAnalysisTaskSE::LoadEventCollection(Int_t collection) {
+   //
+   // Read the requested collection of the current event (see AliReducedEventInputHandler::EReducedEventCollections).
+   // Nothing to do if the events are not read lazily from a tree (e.g. on the fly reduced events)
+   //
+   if(!fEventReader) return kTRUE;
+   return fEventReader->LoadCollection(collection);
+}
+
 //___________________________________________________________________________
 void AliReducedAnalysisTaskSE::Init() {
    //
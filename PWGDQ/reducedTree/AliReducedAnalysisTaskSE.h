@@ -18,6 +18,8 @@
 #include "AliHistogramManager.h"
 #include "AliReducedBaseEvent.h"
 
+class AliReducedEventInputHandler;
+
 //________________________________________________________________
 class AliReducedAnalysisTaskSE : public TObject {
   
@@ -41,11 +43,14 @@ public:
   // finish, to be executed after all events were processed
   virtual void Finish();
   // add output objects;
+  // true if the task requests the event collections it needs via LoadEventCollection(), see AliReducedEventInputHandler::SetLazyReading()
+  virtual Bool_t IsLazyReadingSupported() const {return kFALSE;}
   
   void InitFilteredTree();
   
   // setters
   void SetEvent(AliReducedBaseEvent* event) {fEvent = event;}
+  void SetEventReader(AliReducedEventInputHandler* reader) {fEventReader = reader;}
   
   void SetFilteredTreeWritingOption(Int_t option)         {fFilteredTreeWritingOption = option;}
   void SetFilteredTreeActiveBranch(TString b)   {fActiveBranches+=b+";";}
@@ -63,10 +68,13 @@ protected:
   AliReducedAnalysisTaskSE(const AliReducedAnalysisTaskSE& task);             
   AliReducedAnalysisTaskSE& operator=(const AliReducedAnalysisTaskSE& task);      
   
+  Bool_t LoadEventCollection(Int_t collection);
+  
   TString fName;             // name
   TString fTitle;                // title
     
   AliReducedBaseEvent* fEvent;           //! current event to be processed
+  AliReducedEventInputHandler* fEventReader;   //! input handler of the current event, used to read the event collections on demand
   Float_t fValues[AliReducedVarManager::kNVars];   // array of values to hold information for histograms
   
   TTree *fFilteredTree;                          //! tree to hold filtered reduced events
@@ -78,7 +86,7 @@ protected:
   
   ULong_t fEventCounter;   // event counter
   
-  ClassDef(AliReducedAnalysisTaskSE, 4)
+  ClassDef(AliReducedAnalysisTaskSE, 5)
 };
 
 #endif
@@ -3,8 +3,14 @@
 //     Author: Ionut-Cristian Arsene, iarsene@cern.ch, i.c.arsene@fys.uio.no
 //
 
+#include <iostream>
+using std::cout;
+using std::endl;
+
 #include <TTree.h>
 #include <TFile.h>
+#include <TBranch.h>
+#include <TString.h>
 #include "AliReducedEventInputHandler.h"
 #include "AliReducedBaseEvent.h"
 #include "AliReducedEventInfo.h"
@@ -15,7 +21,13 @@ ClassImp(AliReducedEventInputHandler)
 AliReducedEventInputHandler::AliReducedEventInputHandler() :
     AliInputEventHandler(),
     fEventInputOption(kReducedBaseEvent),
-    fReducedEvent(0)
+    fReducedEvent(0),
+    fLazyReading(kFALSE),
+    fCurrentEntry(-1),
+    fCurrentTreeNumber(-1),
+    fLoadedCollections(0),
+    fHeaderBranches(),
+    fCollectionBranches(kNCollections)
 {
   // Default constructor
 }
@@ -24,7 +36,13 @@ AliReducedEventInputHandler::AliReducedEventInputHandler() :
 AliReducedEventInputHandler::AliReducedEventInputHandler(const char* name, const char* title):
   AliInputEventHandler(name, title),
   fEventInputOption(kReducedBaseEvent),
-  fReducedEvent(0)
+  fReducedEvent(0),
+  fLazyReading(kFALSE),
+  fCurrentEntry(-1),
+  fCurrentTreeNumber(-1),
+  fLoadedCollections(0),
+  fHeaderBranches(),
+  fCollectionBranches(kNCollections)
  {
     // Constructor
 }
@@ -59,6 +77,9 @@ Bool_t AliReducedEventInputHandler::Init(TTree* tree, Option_t* opt)
     
     tree->SetBranchAddress("Event",&fReducedEvent);
     
+    // the branch lists used for lazy reading are (re)built in BeginEvent() for each tree of the chain
+    fCurrentTreeNumber = -1;
+    
     return kTRUE;
 }
 
@@ -71,7 +92,21 @@ Bool_t AliReducedEventInputHandler::BeginEvent(Long64_t entry)
     if (prevRunNumber != fReducedEvent->RunNo() ) {
       prevRunNumber = fReducedEvent->RunNo();
     } 
-    fTree->GetEvent(entry);
+    fLoadedCollections = 0;
+    if(fLazyReading) {
+      fCurrentEntry = fTree->LoadTree(entry);
+      if(fCurrentEntry<0) return kFALSE;
+      if(fTree->GetTreeNumber()!=fCurrentTreeNumber) BuildBranchLists();
+    }
+    if(!fLazyReading) {
+      fTree->GetEvent(entry);
+      fLoadedCollections = (1<<kNCollections)-1;
+      return kTRUE;
+    }
+    
+    // lazy reading: read only the event header, the collections are read on request by LoadCollection()
+    for(Int_t i=0; i<fHeaderBranches.GetEntriesFast(); ++i)
+      ((TBranch*)fHeaderBranches.UncheckedAt(i))->GetEntry(fCurrentEntry, 1);
     
     // set transient pointer to event inside tracks
     // fEvent->ConnectTracks();
@@ -80,6 +115,83 @@ Bool_t AliReducedEventInputHandler::BeginEvent(Long64_t entry)
 }
 
 
+//______________________________________________________________________________
+Bool_t AliReducedEventInputHandler::LoadCollection(Int_t collection)
+{
+   //
+   // Read the given collection (see EReducedEventCollections) of the current event, if not already read.
+   // Returns false if the collection does not exist in the input tree
+   //
+   if(collection<0 || collection>=kNCollections) return kFALSE;
+   if(fLoadedCollections&(1<<collection)) return kTRUE;
+   TBranch* branch = (TBranch*)fCollectionBranches.At(collection);
+   if(!branch) return kFALSE;
+   // the parent branch reads all its sub-branches, even if switched off in the tree
+   if(branch->GetEntry(fCurrentEntry, 1)<0) return kFALSE;
+   fLoadedCollections |= (1<<collection);
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+void AliReducedEventInputHandler::LoadAllCollections()
+{
+   //
+   // Read all the collections of the current event
+   //
+   for(Int_t i=0; i<kNCollections; ++i) LoadCollection(i);
+}
+
+//______________________________________________________________________________
+void AliReducedEventInputHandler::BuildBranchLists()
+{
+   //
+   // Sort the sub-branches of the event branch of the current tree into header leaf branches and
+   // collection branches. The event tree is written with split level 99, so that each collection
+   // has its own branch and can be read independently from the rest of the event
+   //
+   fHeaderBranches.Clear();
+   fCollectionBranches.Clear();
+   TTree* tree = fTree->GetTree();
+   if(!tree) return;
+   fCurrentTreeNumber = fTree->GetTreeNumber();
+   TBranch* eventBranch = tree->GetBranch("Event");
+   if(!eventBranch) {
+      cout << "ERROR: AliReducedEventInputHandler::BuildBranchLists() No Event branch found in the input tree" << endl;
+      return;
+   }
+   TObjArray* subBranches = eventBranch->GetListOfBranches();
+   if(subBranches->GetEntries()==0) {
+      cout << "WARNING: AliReducedEventInputHandler::BuildBranchLists() The Event branch is not split, lazy reading is switched off" << endl;
+      fLazyReading = kFALSE;
+      return;
+   }
+   for(Int_t i=0; i<subBranches->GetEntries(); ++i) AddBranches((TBranch*)subBranches->At(i));
+}
+
+//______________________________________________________________________________
+void AliReducedEventInputHandler::AddBranches(TBranch* branch)
+{
+   //
+   // Add a branch either to the collection branches or to the header branches.
+   // Branches which are neither a collection nor a leaf (e.g. split base classes) are added recursively
+   //
+   static const Char_t* collectionNames[kNCollections] = {"fTracks", "fTracks2", "fCandidates", "fCaloClusters", "fFMD", "fEventPlane"};
+   TString name = branch->GetName();
+   if(name.BeginsWith("Event.")) name.Remove(0, 6);
+   for(Int_t i=0; i<kNCollections; ++i) {
+      if(!name.CompareTo(collectionNames[i])) {
+         fCollectionBranches.AddAt(branch, i);
+         return;
+      }
+   }
+   TObjArray* subBranches = branch->GetListOfBranches();
+   if(subBranches->GetEntries()==0) {
+      fHeaderBranches.Add(branch);
+      return;
+   }
+   for(Int_t i=0; i<subBranches->GetEntries(); ++i) AddBranches((TBranch*)subBranches->At(i));
+}
+
 //______________________________________________________________________________
 Bool_t AliReducedEventInputHandler::Notify(const char* path)
 {
@@ -6,6 +6,7 @@
 //     Author: Ionut-Cristian Arsene, iarsene@cern.ch, i.c.arsene@fys.uio.no
 //
 
+#include <TObjArray.h>
 #include "AliInputEventHandler.h"
 #include "AliReducedBaseEvent.h"
 //#include "AliReducedEventInfo.h"
@@ -17,6 +18,15 @@ class AliReducedEventInputHandler : public AliInputEventHandler {
    enum EReducedEventInputType {
       kReducedBaseEvent=0,     // minimal event information (AliReducedBaseEvent)
       kReducedEventInfo            // extended event information (AliReducedEventInfo)
+   };
+   enum EReducedEventCollections {
+      kTracks=0,                      // fTracks
+      kTracks2,                        // fTracks2
+      kPairs,                            // fCandidates
+      kCaloClusters,               // fCaloClusters (AliReducedEventInfo only)
+      kFMD,                               // fFMD (AliReducedEventInfo only)
+      kEventPlane,                   // fEventPlane (AliReducedEventInfo only)
+      kNCollections
    };
     AliReducedEventInputHandler();
     AliReducedEventInputHandler(const char* name, const char* title);
@@ -33,16 +43,33 @@ class AliReducedEventInputHandler : public AliInputEventHandler {
              
                  void                                SetInputEventType(Int_t type) {fEventInputOption = type;} ;
                  Int_t                               GetInputEventType() const {return fEventInputOption;};
+                 void                                SetLazyReading(Bool_t option=kTRUE) {fLazyReading = option;}
+                 Bool_t                             GetLazyReading() const {return fLazyReading;}
+                 
+                 Bool_t                             LoadCollection(Int_t collection);
+                 void                                LoadAllCollections();
+                 Bool_t                             IsCollectionLoaded(Int_t collection) const 
+                   {return (collection>=0 && collection<kNCollections ? (fLoadedCollections&(1<<collection)) : kFALSE);}
                  
  private:
     AliReducedEventInputHandler(const AliReducedEventInputHandler& handler);             
     AliReducedEventInputHandler& operator=(const AliReducedEventInputHandler& handler);      
     
+    void   BuildBranchLists();
+    void   AddBranches(TBranch* branch);
+    
     Int_t  fEventInputOption;                          // one of the options listed in EReducedEventInputType
     AliReducedBaseEvent* fReducedEvent;   //! Pointer to the event
     //AliReducedEventInfo* fReducedEvent;   //! Pointer to the event
     
-    ClassDef(AliReducedEventInputHandler, 2);
+    Bool_t fLazyReading;                            // if true, only the event header is read in BeginEvent(), the collections are read on demand
+    Long64_t fCurrentEntry;                       //! local tree entry of the current event
+    Int_t fCurrentTreeNumber;                  //! number of the tree in the chain for which the branch lists were built
+    UInt_t fLoadedCollections;                  //! bit map of the collections read for the current event
+    TObjArray fHeaderBranches;                  //! leaf branches of the event header
+    TObjArray fCollectionBranches;            //! top branch of each collection, indexed by EReducedEventCollections
+    
+    ClassDef(AliReducedEventInputHandler, 3);
 };
 
 #endif
@@ -0,0 +1,95 @@
+/*
+***********************************************************
+  Implementation of AliReducedLegBuffer class.
+  Contact: iarsene@cern.ch
+  2026/10/14
+  *********************************************************
+*/
+
+#ifndef ALIREDUCEDLEGBUFFER_H
+#include "AliReducedLegBuffer.h"
+#endif
+
+#include <TList.h>
+#include <TIterator.h>
+
+#include "AliReducedBaseTrack.h"
+
+ClassImp(AliReducedLegBuffer)
+
+//____________________________________________________________________________
+AliReducedLegBuffer::AliReducedLegBuffer() :
+  TObject(),
+  fPx(),
+  fPy(),
+  fPz(),
+  fP(),
+  fPt(),
+  fCharge(),
+  fFlags(),
+  fTrackId()
+{
+  //
+  // default constructor
+  //
+}
+
+//____________________________________________________________________________
+AliReducedLegBuffer::~AliReducedLegBuffer() {
+  //
+  // destructor
+  //
+}
+
+//____________________________________________________________________________
+void AliReducedLegBuffer::Add(AliReducedBaseTrack* track) {
+  //
+  // add a leg; the momentum components are taken from the track getters such that
+  // pair quantities computed from the buffer are identical to those computed from the track
+  //
+  fPx.push_back(track->Px());
+  fPy.push_back(track->Py());
+  fPz.push_back(track->Pz());
+  fP.push_back(track->P());
+  fPt.push_back(track->Pt());
+  fCharge.push_back(track->Charge());
+  fFlags.push_back(track->GetFlags());
+  fTrackId.push_back(track->TrackId());
+}
+
+//____________________________________________________________________________
+void AliReducedLegBuffer::Fill(TList* tracks) {
+  //
+  // fill the buffer with the tracks in the list, keeping the order of the list
+  //
+  Clear();
+  TIter nextTrack(tracks);
+  AliReducedBaseTrack* track = 0x0;
+  while((track=(AliReducedBaseTrack*)nextTrack())) Add(track);
+}
+
+//____________________________________________________________________________
+void AliReducedLegBuffer::Clear(Option_t* /*option*/) {
+  //
+  // remove all legs, the allocated memory is kept for the next event
+  //
+  fPx.clear(); fPy.clear(); fPz.clear(); fP.clear(); fPt.clear();
+  fCharge.clear(); fFlags.clear(); fTrackId.clear();
+}
+
+//____________________________________________________________________________
+Int_t AliReducedLegBuffer::Compress() {
+  //
+  // remove the legs without any cut bit left and return the number of remaining legs
+  //
+  Int_t n = 0;
+  for(Int_t i=0; i<GetEntries(); ++i) {
+    if(!fFlags[i]) continue;
+    fPx[n] = fPx[i]; fPy[n] = fPy[i]; fPz[n] = fPz[i]; fP[n] = fP[i]; fPt[n] = fPt[i];
+    fCharge[n] = fCharge[i]; fFlags[n] = fFlags[i]; fTrackId[n] = fTrackId[i];
+    ++n;
+  }
+  fPx.resize(n); fPy.resize(n); fPz.resize(n); fP.resize(n); fPt.resize(n);
+  fCharge.resize(n); fFlags.resize(n); fTrackId.resize(n);
+  return n;
+}
@@ -0,0 +1,57 @@
+// Packed buffer of pair leg candidates
+// Author: Ionut-Cristian Arsene (iarsene@cern.ch)
+//   14/10/2026
+//
+// The kinematics, charge and cut mask of the leg candidates of one event are stored in contiguous arrays.
+// Pair loops which only need these quantities (pair kernel, event mixing) read the buffer
+// instead of iterating lists of full track objects.
+
+#ifndef ALIREDUCEDLEGBUFFER_H
+#define ALIREDUCEDLEGBUFFER_H
+
+#include <vector>
+#include <TObject.h>
+
+class TList;
+class AliReducedBaseTrack;
+
+//_________________________________________________________________________
+class AliReducedLegBuffer : public TObject {
+
+ public:
+  AliReducedLegBuffer();
+  virtual ~AliReducedLegBuffer();
+  
+  void Add(AliReducedBaseTrack* track);
+  void Fill(TList* tracks);
+  virtual void Clear(Option_t* option="");
+  Int_t Compress();
+  
+  // getters
+  Int_t    GetEntries()       const {return fPx.size();}
+  Float_t  Px(Int_t i)        const {return fPx[i];}
+  Float_t  Py(Int_t i)        const {return fPy[i];}
+  Float_t  Pz(Int_t i)        const {return fPz[i];}
+  Float_t  P(Int_t i)         const {return fP[i];}
+  Float_t  Pt(Int_t i)        const {return fPt[i];}
+  Int_t    Charge(Int_t i)    const {return fCharge[i];}
+  ULong_t  GetFlags(Int_t i)  const {return fFlags[i];}
+  UShort_t TrackId(Int_t i)   const {return fTrackId[i];}
+  
+  // setters
+  void UnsetFlags(Int_t i, ULong_t mask) {fFlags[i] &= ~mask;}
+  
+ protected:
+  std::vector<Float_t>  fPx;         // px of the legs
+  std::vector<Float_t>  fPy;         // py of the legs
+  std::vector<Float_t>  fPz;         // pz of the legs
+  std::vector<Float_t>  fP;          // total momentum of the legs
+  std::vector<Float_t>  fPt;         // transverse momentum of the legs
+  std::vector<Char_t>   fCharge;     // charge of the legs
+  std::vector<ULong_t>  fFlags;      // cut mask of the legs (AliReducedBaseTrack::GetFlags())
+  std::vector<UShort_t> fTrackId;    // track id of the legs
+  
+  ClassDef(AliReducedLegBuffer,1);
+};
+
+#endif
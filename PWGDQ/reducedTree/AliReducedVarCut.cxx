@@ -249,3 +249,15 @@ Bool_t AliReducedVarCut::IsSelected(Float_t* values) {
    
    return kTRUE;
 }
+
+//____________________________________________________________________________
+void AliReducedVarCut::SetUsedVars() const {
+   //
+   // flag the variables used by this cut as used in the AliReducedVarManager
+   //
+   for(Int_t i=0; i<fNCuts; ++i) {
+      if(fCutVariables[i]>=0) AliReducedVarManager::SetUseVariable((AliReducedVarManager::Variables)fCutVariables[i]);
+      if(UsesDependentVariable(i) && fDependentVariable[i]>=0) 
+         AliReducedVarManager::SetUseVariable((AliReducedVarManager::Variables)fDependentVariable[i]);
+   }
+}
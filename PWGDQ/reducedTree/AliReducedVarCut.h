@@ -39,6 +39,16 @@ class AliReducedVarCut : public AliReducedInfoCut {
   virtual Bool_t IsSelected(Float_t* values);
   virtual Bool_t IsSelected(TObject* obj, Float_t* values);
   
+  // getters
+  Int_t GetNCuts() const {return fNCuts;}
+  Short_t GetCutVariable(Int_t i) const {return (i>=0 && i<fNCuts ? fCutVariables[i] : -1);}
+  Short_t GetDependentVariable(Int_t i) const {return (i>=0 && i<fNCuts ? fDependentVariable[i] : -1);}
+  // NOTE: true if the cut reads the dependent variable, either as applicability range or as argument of a cut function
+  Bool_t UsesDependentVariable(Int_t i) const {return (i>=0 && i<fNCuts ? (fCutHasDependentVariable[i] || fFuncCutLow[i] || fFuncCutHigh[i]) : kFALSE);}
+  
+  // flag in the AliReducedVarManager all the variables needed by this cut (e.g. for a cut object read from a file)
+  void SetUsedVars() const;
+  
  protected: 
   
    Int_t       fNCuts;                                    // number of enabled cuts
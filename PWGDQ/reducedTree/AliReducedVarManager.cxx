@@ -34,6 +34,8 @@ using std::ifstream;
 #include "AliReducedEventPlaneInfo.h"
 #include "AliReducedTrackInfo.h"
 #include "AliReducedPairInfo.h"
+#include "AliReducedLegBuffer.h"
+#include "AliReducedVarCut.h"
 #include "AliReducedCaloClusterInfo.h"
 #include "AliKFParticle.h"
 
@@ -195,6 +197,30 @@ AliReducedVarManager::~AliReducedVarManager() {
   //
 }
 
+//__________________________________________________________________
+void AliReducedVarManager::SetUseVarsFromCuts(TList* cuts) {
+  //
+  // Set as used all the variables required by the AliReducedVarCut (and derived) cuts in the list
+  //
+  if(!cuts) return;
+  for(Int_t i=0; i<cuts->GetEntries(); ++i) {
+    if(cuts->At(i)->InheritsFrom(AliReducedVarCut::Class())) 
+      ((AliReducedVarCut*)cuts->At(i))->SetUsedVars();
+  }
+}
+
+
+//__________________________________________________________________
+Int_t AliReducedVarManager::GetNUsedVars() {
+  //
+  // Number of variables which are computed
+  //
+  Int_t n = 0;
+  for(Int_t i=0; i<kNVars; ++i) if(fgUsedVars[i]) ++n;
+  return n;
+}
+
+
 //__________________________________________________________________
 void AliReducedVarManager::SetVariableDependencies() {
   //
@@ -1839,6 +1865,117 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
 }
 
 
+//_________________________________________________________________
+void AliReducedVarManager::FillPairInfoME(AliReducedLegBuffer* legs1, Int_t i1, AliReducedLegBuffer* legs2, Int_t i2, Int_t type, Float_t* values) {
+  //
+  // Lightweight fill pair information from 2 legs stored in packed leg buffers.
+  // NOTE: Same variables as FillPairInfoME(track, track, type, values), used when the mixing pools are made of leg buffers
+  //
+  PAIR p;
+  p.PxPyPz(legs1->Px(i1)+legs2->Px(i2), legs1->Py(i1)+legs2->Py(i2), legs1->Pz(i1)+legs2->Pz(i2));
+  p.CandidateId(type);
+    
+  if(legs1->Charge(i1)*legs2->Charge(i2)<0) p.PairType(1);
+  else if(legs1->Charge(i1)>0)              p.PairType(0);
+  else                                      p.PairType(2);
+  values[kPairType] = p.PairType();
+  values[kCandidateId] = type;
+  values[kPairChisquare] = -999.;
+  
+  Float_t m1 = 0.0; Float_t m2 = 0.0;
+  GetLegMassAssumption(type,m1,m2); 
+    
+  if(fgUsedVars[kMass]) {     
+    values[kMass] = m1*m1+m2*m2 + 
+                    2.0*(TMath::Sqrt(m1*m1+legs1->P(i1)*legs1->P(i1))*TMath::Sqrt(m2*m2+legs2->P(i2)*legs2->P(i2)) - 
+                    legs1->Px(i1)*legs2->Px(i2) - legs1->Py(i1)*legs2->Py(i2) - legs1->Pz(i1)*legs2->Pz(i2));
+    if(values[kMass]<0.0) {
+      cout << "FillPairInfoME(legs, i, legs, j, type, values): Warning: Very small squared mass found. "
+           << "   Could be negative due to resolution of Float_t so it will be set to a small positive value." << endl; 
+      cout << "   mass2: " << values[kMass] << endl;
+      values[kMass] = 0.0;
+    }
+    else
+      values[kMass] = TMath::Sqrt(values[kMass]);
+    p.SetMass(values[kMass]);
+  }
+  
+  values[kPx] = p.Px();
+  values[kPy] = p.Py();
+  values[kPz] = p.Pz();
+  if(fgUsedVars[kPt] || fgUsedVars[kPtSquared]) {
+    values[kPt] = p.Pt();
+    if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
+  }
+  if(fgUsedVars[kP]) values[kP] = p.P();
+  if(fgUsedVars[kEta]) values[kEta] = p.Eta();
+  if(fgUsedVars[kRap]) values[kRap] = p.Rapidity();
+  if(fgUsedVars[kPhi]) values[kPhi] = p.Phi();
+  if(fgUsedVars[kTheta]) values[kTheta] = p.Theta();
+
+  if((fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq]) && fgPairEffMap) {
+    Int_t binX = fgPairEffMap->GetXaxis()->FindBin(values[fgEffMapVarDependencyX]); //make sure the values[XVar] are filled for EM
+    if(binX==0) binX = 1;
+    if(binX==fgPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
+    Int_t binY = fgPairEffMap->GetYaxis()->FindBin(values[fgEffMapVarDependencyY]); //make sure the values[YVar] are filled for EM
+    if(binY==0) binY=1;
+    if(binY==fgPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
+    Float_t pairEff = fgPairEffMap->GetBinContent(binX, binY);
+    Float_t oneOverPairEff = 1;
+    if (pairEff > 1.0e-6) oneOverPairEff = 1/pairEff;
+    values[kPairEff] = pairEff;
+    values[kOneOverPairEff] = oneOverPairEff;
+    values[kOneOverPairEffSq] = oneOverPairEff*oneOverPairEff;
+  }
+}
+
+
+//_________________________________________________________________
+Bool_t AliReducedVarManager::IsPairKernelVariable(Int_t var) {
+  //
+  // variables filled by FillPairKernel()
+  //
+  return (var==kPairType || var==kCandidateId || var==kMass || var==kPt || var==kPtSquared || var==kPairOpeningAngle);
+}
+
+
+//_________________________________________________________________
+void AliReducedVarManager::FillPairKernel(AliReducedLegBuffer* legs1, Int_t i1, AliReducedLegBuffer* legs2, Int_t i2, Int_t type, Float_t* values) {
+  //
+  // Fill only the pair variables listed in IsPairKernelVariable(), using the legs stored in packed leg buffers.
+  // The arithmetic is the same as in FillPairInfo(track, track, type, values), such that a selection
+  // on these variables gives the same decision.
+  // NOTE: Intended as a fast pre-selection in same event pair loops (prefilter, pair cuts)
+  //
+  Float_t px = legs1->Px(i1)+legs2->Px(i2);
+  Float_t py = legs1->Py(i1)+legs2->Py(i2);
+  
+  if(legs1->Charge(i1)*legs2->Charge(i2)<0) values[kPairType] = 1;
+  else if(legs1->Charge(i1)>0)              values[kPairType] = 0;
+  else                                      values[kPairType] = 2;
+  values[kCandidateId] = type;
+  
+  if(fgUsedVars[kMass]) {
+    Float_t m1 = 0.0; Float_t m2 = 0.0;
+    GetLegMassAssumption(type,m1,m2); 
+    values[kMass] = m1*m1+m2*m2 + 
+                    2.0*(TMath::Sqrt(m1*m1+legs1->P(i1)*legs1->P(i1))*TMath::Sqrt(m2*m2+legs2->P(i2)*legs2->P(i2)) - 
+                         legs1->Px(i1)*legs2->Px(i2) - legs1->Py(i1)*legs2->Py(i2) - legs1->Pz(i1)*legs2->Pz(i2));
+    if(values[kMass]<0.0) values[kMass] = 0.0;
+    else values[kMass] = TMath::Sqrt(values[kMass]);
+  }
+  
+  if(fgUsedVars[kPt]) values[kPt] = TMath::Sqrt(px*px+py*py);
+  if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
+  
+  if(fgUsedVars[kPairOpeningAngle]) {
+    TVector3 v1(legs1->Px(i1), legs1->Py(i1), legs1->Pz(i1));
+    TVector3 v2(legs2->Px(i2), legs2->Py(i2), legs2->Pz(i2));
+    values[kPairOpeningAngle] = v1.Angle(v2);
+  }
+}
+
+
 //_________________________________________________________________
 void AliReducedVarManager::FillPairInfo(PAIR* t1, BASETRACK* t2, Int_t type, Float_t* values) {
   //
@@ -21,6 +21,8 @@ class AliReducedEventInfo;
 class AliReducedEventPlaneInfo;
 class AliReducedBaseTrack;
 class AliReducedTrackInfo;
+class AliReducedLegBuffer;
+class TList;
 class AliReducedCaloClusterInfo;
 class AliKFParticle;
 
@@ -579,13 +581,15 @@ class AliReducedVarManager : public TObject {
   static void SetEvent(AliReducedBaseEvent* const ev) {fgEvent = ev;};
   static void SetEventPlane(AliReducedEventPlaneInfo* const ev) {fgEventPlane = ev;};
   static void SetUseVariable(Variables var) {fgUsedVars[var] = kTRUE; SetVariableDependencies();}
-  static void SetUseVars(Bool_t* usedVars) {
+  static void SetUseVars(const Bool_t* usedVars) {
     for(Int_t i=0;i<kNVars;++i) {
       if(usedVars[i]) fgUsedVars[i]=kTRUE;    // overwrite only the variables that are being used since there are more channels to modify the used variables array, independently
     }
     SetVariableDependencies();
   }
   static Bool_t GetUsedVar(Variables var) {return fgUsedVars[var];}
+  static void SetUseVarsFromCuts(TList* cuts);
+  static Int_t GetNUsedVars();
   
   static void FillEventInfo(Float_t* values);
   static void FillEventInfo(AliReducedBaseEvent* event, Float_t* values, AliReducedEventPlaneInfo* eventPlane=0x0);
@@ -606,6 +610,9 @@ class AliReducedVarManager : public TObject {
   static void FillPairInfo(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
   static void FillPairInfo(AliReducedPairInfo* leg1, AliReducedBaseTrack* leg2, Int_t type, Float_t* values);
   static void FillPairInfoME(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
+  static void FillPairInfoME(AliReducedLegBuffer* legs1, Int_t i1, AliReducedLegBuffer* legs2, Int_t i2, Int_t type, Float_t* values);
+  static void FillPairKernel(AliReducedLegBuffer* legs1, Int_t i1, AliReducedLegBuffer* legs2, Int_t i2, Int_t type, Float_t* values);
+  static Bool_t IsPairKernelVariable(Int_t var);
   static void FillCorrelationInfo(AliReducedBaseTrack* p, AliReducedBaseTrack* t, Float_t* values);
   static void FillCorrelationInfo(AliReducedBaseTrack* t, Float_t* values);
   static void FillCaloClusterInfo(AliReducedCaloClusterInfo* cl, Float_t* values);
@@ -26,6 +26,7 @@
 #pragma link C++ class AliReducedEventPlaneInfo+;
 #pragma link C++ class AliReducedFMDInfo+;
 #pragma link C++ class AliReducedInfoCut+;
+#pragma link C++ class AliReducedLegBuffer+;
 #pragma link C++ class AliReducedPairInfo+;
 #pragma link C++ class AliReducedTrackCut+;
 #pragma link C++ class AliReducedTrackInfo+;
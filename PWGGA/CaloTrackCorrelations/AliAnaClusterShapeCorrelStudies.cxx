@@ -64,6 +64,7 @@ fConstantTimeShift(0),
 
 fClusterMomentum(),                    fClusterMomentum2(),                    
 fCaloCellList(NULL),                   fCaloClusList(NULL),
+fClusterNLM(),
 
 // Histograms
 
@@ -473,7 +474,7 @@ fhECellTotalRatioMod(0),               fhECellTotalLogRatioMod(0)
 ///
 //___________________________________________________
 void AliAnaClusterShapeCorrelStudies::ChannelCorrelationInTCard
-(AliVCluster* clus, Bool_t matched,Int_t absIdMax, Float_t exoticity) 
+(AliVCluster* clus, Bool_t matched,Int_t absIdMax, Float_t exoticity, Int_t iclus) 
 {
   // Get the col and row of the leading cluster cell
 
@@ -621,6 +622,7 @@ void AliAnaClusterShapeCorrelStudies::ChannelCorrelationInTCard
   Float_t maxEList [ncells];
   Int_t nlm  = GetCaloUtils()->GetNumberOfLocalMaxima(clus, fCaloCellList, absIdList, maxEList) ; 
 //Int_t nlm  = GetCaloUtils()->GetNumberOfLocalMaxima(clus,fCaloCellList);
+  if ( iclus >= 0 && iclus < (Int_t) fClusterNLM.size() ) fClusterNLM[iclus] = nlm;
 
   //
   // Correlation to max
@@ -1148,7 +1150,7 @@ void AliAnaClusterShapeCorrelStudies::ChannelCorrelationInTCard
       
       if(   absIdMax == absIdMax2   
          || !IsGoodCluster(absIdMax2, clus2->GetM02(), clus2->GetNCells()) 
-         || GetCaloUtils()->GetNumberOfLocalMaxima(clus2,fCaloCellList) > 1 
+         || GetClusterNLM(jclus, clus2) > 1 
          || clus2->GetM02() > fInvMassMaxM02Cut
          || clus2->GetM02() < fInvMassMinM02Cut
          || clus2->E() < fInvMassMinECut 
@@ -1379,7 +1381,7 @@ void AliAnaClusterShapeCorrelStudies::ChannelCorrelationInTCard
 void AliAnaClusterShapeCorrelStudies::ClusterShapeHistograms
 (AliVCluster* clus , Int_t   absIdMax, Double_t maxFrac  , 
  Float_t eCrossFrac, Float_t eCellMax, Double_t tmax     ,
- Int_t   matchedPID, Int_t    mcIndex)
+ Int_t   matchedPID, Int_t    mcIndex , Int_t    iclus)
 {
   // By definition a cluster has at least 1 cell, 
   // and shape only makes sense with at least 2
@@ -1390,7 +1392,7 @@ void AliAnaClusterShapeCorrelStudies::ClusterShapeHistograms
   Float_t energy = clus->E();
   Float_t m02    = clus->GetM02();
   Float_t m20    = clus->GetM20();
-  Int_t   nlm    = GetCaloUtils()->GetNumberOfLocalMaxima(clus, fCaloCellList) ; 
+  Int_t   nlm    = GetClusterNLM(iclus, clus) ; 
 
   Int_t   nCell  = 0;
 
@@ -1740,7 +1742,7 @@ void AliAnaClusterShapeCorrelStudies::ClusterShapeHistograms
       
       if(   absIdMax == absIdMax2   
          || !IsGoodCluster(absIdMax2, clus2->GetM02(), clus2->GetNCells()) 
-         || GetCaloUtils()->GetNumberOfLocalMaxima(clus2,fCaloCellList) > 1 
+         || GetClusterNLM(jclus, clus2) > 1 
          || clus2->GetM02() > fInvMassMaxM02Cut
          || clus2->GetM02() < fInvMassMinM02Cut
          || clus2->E() < fInvMassMinECut 
@@ -1969,11 +1971,11 @@ void AliAnaClusterShapeCorrelStudies::ClusterLoopHistograms()
   
     //
     if ( fStudyShape  && matchedPID >= 0 && matchedPID < 3 )
-      ClusterShapeHistograms(clus, absIdMax, maxCellFraction, eCrossFrac, ampMax, tmax, matchedPID, mcIndex);
+      ClusterShapeHistograms(clus, absIdMax, maxCellFraction, eCrossFrac, ampMax, tmax, matchedPID, mcIndex, iclus);
     
     //
     if ( fStudyTCardCorrelation ) 
-      ChannelCorrelationInTCard(clus, matched, absIdMax, eCrossFrac);
+      ChannelCorrelationInTCard(clus, matched, absIdMax, eCrossFrac, iclus);
     
     // 
     if ( fStudyWeight ) 
@@ -4821,12 +4823,32 @@ void  AliAnaClusterShapeCorrelStudies::MakeAnalysisFillHistograms()
   
   AliDebug(1,Form("N cells %d, N clusters %d \n",fCaloCellList->GetNumberOfCells(),fCaloClusList->GetEntriesFast()));
   
+  // Number of local maxima, calculated at most once per cluster and event
+  fClusterNLM.assign(fCaloClusList->GetEntriesFast(), -1);
+  
   // Clusters
   ClusterLoopHistograms();
     
   AliDebug(1,"End");
 }
 
+//_________________________________________________________________________________
+/// \return number of local maxima of the cluster, calculated only the first
+/// time it is requested in the event.
+/// \param iclus: index of the cluster in fCaloClusList, -1 if unknown
+/// \param clus: cluster pointer
+//_________________________________________________________________________________
+Int_t AliAnaClusterShapeCorrelStudies::GetClusterNLM(Int_t iclus, AliVCluster* clus)
+{
+  if ( iclus < 0 || iclus >= (Int_t) fClusterNLM.size() ) 
+    return GetCaloUtils()->GetNumberOfLocalMaxima(clus, fCaloCellList);
+  
+  if ( fClusterNLM[iclus] < 0 ) 
+    fClusterNLM[iclus] = GetCaloUtils()->GetNumberOfLocalMaxima(clus, fCaloCellList);
+  
+  return fClusterNLM[iclus];
+}
+
 //_________________________________________________________________________________
 /// Check cluster weights, check the effect of different w0 parameter on shower shape
 /// Check effect of time and energy cuts at cell level on the shower shape
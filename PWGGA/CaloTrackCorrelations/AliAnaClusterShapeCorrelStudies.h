@@ -26,6 +26,7 @@ class AliVCaloCells;
 class AliVCaloCluster;
 class AliVTrack;
 
+#include <vector>
 #include "AliAnaCaloTrackCorrBaseClass.h"
  
 class AliAnaClusterShapeCorrelStudies : public AliAnaCaloTrackCorrBaseClass {
@@ -58,13 +59,15 @@ public:
   void         ClusterShapeHistograms(AliVCluster* cluster,  
                                       Int_t   absIdMax    , Double_t maxCellFraction, 
                                       Float_t eCrossFrac  , Float_t ampMax  , Double_t tmax, 
-                                      Int_t   matchedPID  , Int_t    mcIndex);
+                                      Int_t   matchedPID  , Int_t    mcIndex, Int_t iclus = -1);
   
   void         ClusterMatchedToTrackPID(AliVCluster *clus, Int_t & matchedPID);
   
   void         ClusterLoopHistograms();
       
-  void         ChannelCorrelationInTCard(AliVCluster* clus, Bool_t matched, Int_t absIdMax, Float_t exoticity) ;
+  void         ChannelCorrelationInTCard(AliVCluster* clus, Bool_t matched, Int_t absIdMax, Float_t exoticity, Int_t iclus = -1) ;
+  
+  Int_t        GetClusterNLM(Int_t iclus, AliVCluster* clus) ;
     
   Bool_t       IsGoodCluster(Int_t absIdMax, Float_t m02, Int_t nCellsPerCluster);
 
@@ -180,6 +183,7 @@ public:
   
   AliVCaloCells * fCaloCellList;                //!<! cells temporary container                     
   TObjArray     * fCaloClusList;                //!<! clusters temporary container                     
+  std::vector<Int_t> fClusterNLM;               //!<! number of local maxima per cluster in fCaloClusList, -1 if not yet calculated
         
   //
   // T-Card correlation
@@ -551,7 +555,7 @@ public:
   AliAnaClusterShapeCorrelStudies(              const AliAnaClusterShapeCorrelStudies & qa) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaClusterShapeCorrelStudies,5) ;
+  ClassDef(AliAnaClusterShapeCorrelStudies,6) ;
   /// \endcond
 
 } ;
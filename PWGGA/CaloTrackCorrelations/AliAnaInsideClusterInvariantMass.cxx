@@ -42,6 +42,7 @@ ClassImp(AliAnaInsideClusterInvariantMass) ;
 //__________________________________________________________________
 AliAnaInsideClusterInvariantMass::AliAnaInsideClusterInvariantMass() :
   AliAnaCaloTrackCorrBaseClass(),
+  fClusterRecord(),
   fMinNCells(0),                             fMinBadDist(0),
   fHistoECut(0),                             fCheckSplitDistToBad(0),                   fFillAngleHisto(kFALSE),
   fFillTMHisto(kFALSE),                      fFillTMResidualHisto(kFALSE),              fFillSSExtraHisto(kFALSE),
@@ -545,7 +546,19 @@ void AliAnaInsideClusterInvariantMass::CheckLocalMaximaMCOrigin(AliVCluster* clu
   const UInt_t nc = cluster->GetNCells();
   Int_t   list[nc];
   Float_t elist[nc];
-  Int_t nMax = GetCaloUtils()->GetNumberOfLocalMaxima(cluster, GetEMCALCells(),list, elist);
+  Int_t nMax = 0;
+  
+  // Local maxima already found for the cluster record
+  if(!fClusterRecord.fLocMaxId.empty())
+  {
+    nMax = fClusterRecord.fLocMaxId.size();
+    for(Int_t i = 0; i < nMax; i++)
+    {
+      list [i] = fClusterRecord.fLocMaxId[i];
+      elist[i] = fClusterRecord.fLocMaxE [i];
+    }
+  }
+  else nMax = GetCaloUtils()->GetNumberOfLocalMaxima(cluster, GetEMCALCells(),list, elist);
   
   //// PRINTS /////
   
@@ -2686,13 +2699,9 @@ void AliAnaInsideClusterInvariantMass::FillSSExtraHistograms(AliVCluster  *clust
 {
   Float_t en = cluster->E();
   
-  // Get more Shower Shape parameters
-  Float_t ll0  = 0., ll1  = 0.;
-  Float_t disp= 0., dispEta = 0., dispPhi    = 0.;
-  Float_t sEta = 0., sPhi = 0., sEtaPhi = 0.;
-  
-  GetCaloUtils()->GetEMCALRecoUtils()->RecalculateClusterShowerShapeParameters(GetEMCALGeometry(), GetReader()->GetInputEvent()->GetEMCALCells(), cluster,
-                                                                               ll0, ll1, disp, dispEta, dispPhi, sEta, sPhi, sEtaPhi);
+  // More Shower Shape parameters, recalculated once for the cluster record
+  Float_t dispEta = fClusterRecord.fDispEta;
+  Float_t dispPhi = fClusterRecord.fDispPhi;
   
   Float_t dispAsy = -1;
   if(dispEta+dispPhi >0 ) dispAsy = (dispPhi-dispEta) / (dispPhi+dispEta);
@@ -6458,31 +6467,23 @@ void  AliAnaInsideClusterInvariantMass::MakeAnalysisFillHistograms()
     
     // Get PID, N local maximum, *** split cluster ***
     
-    Int_t    nMax = 0;
-    Double_t mass = 0., angle = 0.;
-    Int_t    absId1   =-1; Int_t   absId2   =-1;
-    Float_t  distbad1 =-1; Float_t distbad2 =-1;
-    Bool_t   fidcut1  = 0; Bool_t  fidcut2  = 0;
-    
-    Int_t pidTag = GetCaloPID()->GetIdentifiedParticleTypeFromClusterSplitting(cluster,cells,GetCaloUtils(),
-                                                                               GetVertex(0), nMax, mass, angle,
-                                                                               fSubClusterMom1,fSubClusterMom2,
-                                                                               absId1,absId2,
-                                                                               distbad1,distbad2,
-                                                                               fidcut1,fidcut2);
-    if (nMax <= 0) 
+    if(!FillClusterSplitRecord(cluster,cells))
     {
       AliWarning("No local maximum found! It did not pass CaloPID selection criteria");
       continue;
     }
     
-    // Set some index for array histograms
-    
-    Int_t inlm = -1;
-    if     (nMax == 1) inlm = 0;
-    else if(nMax == 2) inlm = 1;
-    else if(nMax >  2) inlm = 2;
-    else AliDebug(2,Form("Wrong N local maximum -> %d, n cells in cluster %d",nMax,nc));
+    Int_t    nMax     = fClusterRecord.fNLocMax;
+    Int_t    inlm     = fClusterRecord.fInlm;
+    Double_t mass     = fClusterRecord.fMass;
+    Double_t angle    = fClusterRecord.fAngle;
+    Int_t    pidTag   = fClusterRecord.fPidTag;
+    Int_t    absId1   = fClusterRecord.fAbsId1;
+    Int_t    absId2   = fClusterRecord.fAbsId2;
+    Float_t  distbad1 = fClusterRecord.fDistBad1;
+    Float_t  distbad2 = fClusterRecord.fDistBad2;
+    Bool_t   fidcut1  = fClusterRecord.fFidCut1;
+    Bool_t   fidcut2  = fClusterRecord.fFidCut2;
 
     // Skip events where one of the new clusters (lowest energy) is close to an EMCal border or a bad channel
     if( (fCheckSplitDistToBad) &&
@@ -6506,56 +6507,21 @@ void  AliAnaInsideClusterInvariantMass::MakeAnalysisFillHistograms()
       continue ;
     }
 
-    // Get sub-cluster parameters
-    
-    Float_t e1 = fSubClusterMom1.Energy();
-    Float_t e2 = fSubClusterMom2.Energy();
-    
-    Double_t tof1  = cells->GetCellTime(absId1);
-    GetCaloUtils()->RecalibrateCellTime(tof1, GetCalorimeter(), absId1,GetReader()->GetInputEvent()->GetBunchCrossNumber());
-    tof1*=1.e9;
-    
-    Double_t tof2  = cells->GetCellTime(absId2);
-    GetCaloUtils()->RecalibrateCellTime(tof2, GetCalorimeter(), absId2,GetReader()->GetInputEvent()->GetBunchCrossNumber());
-    tof2*=1.e9;
-    
-    Double_t t12diff = tof1-tof2;
-    
-    Float_t splitFrac = (e1+e2)/en;
-
-    Float_t asym = -10;
-    if(e1+e2>0) asym = (e1-e2)/(e1+e2);
-    
-    //
-    
-    Int_t ebin = -1;
-    if(en > 8  && en <= 12) ebin = 0;
-    if(en > 12 && en <= 16) ebin = 1;
-    if(en > 16 && en <= 20) ebin = 2;
-    if(en > 20)             ebin = 3;
+    // Sub-cluster parameters, shower shape and MC origin
     
-    // MC data histograms and some related calculations
-    // mc tag, n overlaps, asym of generated mesons
+    CompleteClusterRecord(cluster,cells,matched);
     
-    Int_t   mcindex   = -1;
-    Int_t   mctag     = -1;
-    Float_t eprim     = -1;
-    Float_t asymGen   = -2;
-    Float_t angleGen  =  2000;
-    Int_t   noverlaps =  0;
-    
-    if(IsDataMC())
-    {
-      // MC indexes
-
-      GetMCIndex(cluster,mcindex,mctag);
-      
-      // MC primary kine, generation fractions
-
-      GetMCPrimaryKine(cluster,mcindex,mctag,matched,eprim,asymGen,angleGen,noverlaps);
-        
-      // For cluster with MC pi0 and more than 1 maxima
-     }
+    Float_t  e1        = fClusterRecord.fE1;
+    Float_t  e2        = fClusterRecord.fE2;
+    Double_t t12diff   = fClusterRecord.fT12Diff;
+    Float_t  splitFrac = fClusterRecord.fSplitFrac;
+    Float_t  asym      = fClusterRecord.fAsym;
+    Int_t    ebin      = fClusterRecord.fEbin;
+    Int_t    mcindex   = fClusterRecord.fMCIndex;
+    Float_t  eprim     = fClusterRecord.fEPrim;
+    Float_t  asymGen   = fClusterRecord.fAsymGen;
+    Float_t  angleGen  = fClusterRecord.fAngleGen;
+    Int_t    noverlaps = fClusterRecord.fNOverlaps;
     
     //
     
@@ -6646,6 +6612,121 @@ void  AliAnaInsideClusterInvariantMass::MakeAnalysisFillHistograms()
   AliDebug(1,"End");
 }
 
+//______________________________________________________________________
+/// Split the cluster in 2 sub-clusters and get its PID, fill the first part
+/// of the cluster record.
+/// \return kFALSE if no local maximum was found.
+//______________________________________________________________________
+Bool_t AliAnaInsideClusterInvariantMass::FillClusterSplitRecord(AliVCluster * cluster, AliVCaloCells * cells)
+{
+  ClusterRecord_t & rec = fClusterRecord;
+  
+  rec.fNLocMax  = 0;
+  rec.fMass     = 0.; rec.fAngle    = 0.;
+  rec.fAbsId1   =-1;  rec.fAbsId2   =-1;
+  rec.fDistBad1 =-1;  rec.fDistBad2 =-1;
+  rec.fFidCut1  = 0;  rec.fFidCut2  = 0;
+  rec.fLocMaxId.clear();
+  rec.fLocMaxE .clear();
+  
+  rec.fPidTag = GetCaloPID()->GetIdentifiedParticleTypeFromClusterSplitting(cluster,cells,GetCaloUtils(),
+                                                                            GetVertex(0), rec.fNLocMax, rec.fMass, rec.fAngle,
+                                                                            fSubClusterMom1,fSubClusterMom2,
+                                                                            rec.fAbsId1,rec.fAbsId2,
+                                                                            rec.fDistBad1,rec.fDistBad2,
+                                                                            rec.fFidCut1,rec.fFidCut2);
+  if (rec.fNLocMax <= 0) return kFALSE;
+  
+  // Set some index for array histograms
+  
+  rec.fInlm = -1;
+  if     (rec.fNLocMax == 1) rec.fInlm = 0;
+  else if(rec.fNLocMax == 2) rec.fInlm = 1;
+  else if(rec.fNLocMax >  2) rec.fInlm = 2;
+  
+  return kTRUE;
+}
+
+//______________________________________________________________________
+/// Complete the cluster record of an accepted split cluster:
+/// sub-cluster energies and timing, asymmetry, energy bin,
+/// shower shape and local maxima when needed, and MC origin.
+//______________________________________________________________________
+void AliAnaInsideClusterInvariantMass::CompleteClusterRecord(AliVCluster * cluster, AliVCaloCells * cells, Bool_t matched)
+{
+  ClusterRecord_t & rec = fClusterRecord;
+  
+  Float_t en = cluster->E();
+  
+  rec.fE1 = fSubClusterMom1.Energy();
+  rec.fE2 = fSubClusterMom2.Energy();
+  
+  Double_t tof1  = cells->GetCellTime(rec.fAbsId1);
+  GetCaloUtils()->RecalibrateCellTime(tof1, GetCalorimeter(), rec.fAbsId1,GetReader()->GetInputEvent()->GetBunchCrossNumber());
+  tof1*=1.e9;
+  
+  Double_t tof2  = cells->GetCellTime(rec.fAbsId2);
+  GetCaloUtils()->RecalibrateCellTime(tof2, GetCalorimeter(), rec.fAbsId2,GetReader()->GetInputEvent()->GetBunchCrossNumber());
+  tof2*=1.e9;
+  
+  rec.fT12Diff   = tof1-tof2;
+  
+  rec.fSplitFrac = (rec.fE1+rec.fE2)/en;
+  
+  rec.fAsym = -10;
+  if(rec.fE1+rec.fE2>0) rec.fAsym = (rec.fE1-rec.fE2)/(rec.fE1+rec.fE2);
+  
+  rec.fEbin = -1;
+  if(en > 8  && en <= 12) rec.fEbin = 0;
+  if(en > 12 && en <= 16) rec.fEbin = 1;
+  if(en > 16 && en <= 20) rec.fEbin = 2;
+  if(en > 20)             rec.fEbin = 3;
+  
+  // Shower shape parameters beyond M02
+  
+  rec.fDispEta = 0.;
+  rec.fDispPhi = 0.;
+  if(fFillSSExtraHisto)
+  {
+    Float_t ll0  = 0., ll1  = 0., disp = 0.;
+    Float_t sEta = 0., sPhi = 0., sEtaPhi = 0.;
+    GetCaloUtils()->GetEMCALRecoUtils()->RecalculateClusterShowerShapeParameters(GetEMCALGeometry(), GetReader()->GetInputEvent()->GetEMCALCells(), cluster,
+                                                                                 ll0, ll1, disp, rec.fDispEta, rec.fDispPhi, sEta, sPhi, sEtaPhi);
+  }
+  
+  // MC data histograms and some related calculations
+  // mc tag, n overlaps, asym of generated mesons
+  
+  rec.fMCIndex   = -1;
+  rec.fMCTag     = -1;
+  rec.fEPrim     = -1;
+  rec.fAsymGen   = -2;
+  rec.fAngleGen  =  2000;
+  rec.fNOverlaps =  0;
+  
+  if(!IsDataMC()) return;
+  
+  // MC indexes
+  
+  GetMCIndex(cluster,rec.fMCIndex,rec.fMCTag);
+  
+  // MC primary kine, generation fractions
+  
+  GetMCPrimaryKine(cluster,rec.fMCIndex,rec.fMCTag,matched,rec.fEPrim,rec.fAsymGen,rec.fAngleGen,rec.fNOverlaps);
+  
+  // Local maxima cells, for the MC origin of the maxima
+  
+  if(fFillMCOverlapHisto && (rec.fMCIndex == kmcPi0 || rec.fMCIndex == kmcPi0Conv))
+  {
+    const Int_t nc = cluster->GetNCells();
+    Int_t   list[nc];
+    Float_t elist[nc];
+    Int_t nMax = GetCaloUtils()->GetNumberOfLocalMaxima(cluster, cells, list, elist);
+    rec.fLocMaxId.assign(list , list +nMax);
+    rec.fLocMaxE .assign(elist, elist+nMax);
+  }
+}
+
 //______________________________________________________________________
 /// Print some relevant parameters set for the analysis.
 //______________________________________________________________________
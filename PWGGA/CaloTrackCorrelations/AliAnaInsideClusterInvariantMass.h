@@ -27,6 +27,7 @@ class TLorentzVector;
 // --- ANALYSIS system ---
 class AliAODCaloCluster;
 
+#include <vector>
 #include "AliAnaCaloTrackCorrBaseClass.h"
 
 class AliAnaInsideClusterInvariantMass : public AliAnaCaloTrackCorrBaseClass {
@@ -207,6 +208,46 @@ class AliAnaInsideClusterInvariantMass : public AliAnaCaloTrackCorrBaseClass {
 
  private:
   
+  /// \struct ClusterRecord_t
+  /// Splitting, shower shape and MC origin of the cluster being analysed,
+  /// computed once per cluster and used by all the histogram filling methods.
+  struct ClusterRecord_t
+  {
+    Int_t    fPidTag;                  ///<  PID from cluster splitting
+    Int_t    fNLocMax;                 ///<  Number of local maxima
+    Int_t    fInlm;                    ///<  Index of NLM: 1, 2, >2
+    Double_t fMass;                    ///<  Invariant mass of the split sub-clusters
+    Double_t fAngle;                   ///<  Opening angle of the split sub-clusters
+    Int_t    fAbsId1;                  ///<  Main cell of sub-cluster 1
+    Int_t    fAbsId2;                  ///<  Main cell of sub-cluster 2
+    Float_t  fDistBad1;                ///<  Distance to bad channel of sub-cluster 1
+    Float_t  fDistBad2;                ///<  Distance to bad channel of sub-cluster 2
+    Bool_t   fFidCut1;                 ///<  Sub-cluster 1 away from borders
+    Bool_t   fFidCut2;                 ///<  Sub-cluster 2 away from borders
+    Float_t  fE1;                      ///<  Energy of sub-cluster 1
+    Float_t  fE2;                      ///<  Energy of sub-cluster 2
+    Double_t fT12Diff;                 ///<  Time difference of the main cells of the sub-clusters
+    Float_t  fSplitFrac;               ///<  (e1+e2)/E
+    Float_t  fAsym;                    ///<  Energy asymmetry of the sub-clusters
+    Int_t    fEbin;                    ///<  Energy bin index, -1 if below 8 GeV
+    Float_t  fDispEta;                 ///<  Dispersion in eta, if fFillSSExtraHisto
+    Float_t  fDispPhi;                 ///<  Dispersion in phi, if fFillSSExtraHisto
+    Int_t    fMCIndex;                 ///<  MC origin index
+    Int_t    fMCTag;                   ///<  MC origin tag
+    Float_t  fEPrim;                   ///<  MC primary energy
+    Float_t  fAsymGen;                 ///<  MC generated decay asymmetry
+    Float_t  fAngleGen;                ///<  MC generated decay opening angle
+    Int_t    fNOverlaps;               ///<  MC number of overlapping particles
+    std::vector<Int_t>   fLocMaxId;    ///<  Local maxima cells, if MC overlap histograms are filled
+    std::vector<Float_t> fLocMaxE;     ///<  Local maxima energies, if MC overlap histograms are filled
+  };
+  
+  Bool_t       FillClusterSplitRecord(AliVCluster * cluster, AliVCaloCells * cells);
+  
+  void         CompleteClusterRecord (AliVCluster * cluster, AliVCaloCells * cells, Bool_t matched);
+  
+  ClusterRecord_t fClusterRecord;      //!<! Record of the cluster being analysed
+  
   Int_t        fMinNCells   ;          ///<  Study clusters with ncells larger than cut
   Float_t      fMinBadDist  ;          ///<  Minimal distance to bad channel to accept cluster
   Float_t      fHistoECut   ;          ///<  Fixed E cut for some histograms
@@ -801,7 +842,7 @@ class AliAnaInsideClusterInvariantMass : public AliAnaCaloTrackCorrBaseClass {
   AliAnaInsideClusterInvariantMass & operator = (const AliAnaInsideClusterInvariantMass & split) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaInsideClusterInvariantMass,30) ;
+  ClassDef(AliAnaInsideClusterInvariantMass,31) ;
   /// \endcond
 
 } ;
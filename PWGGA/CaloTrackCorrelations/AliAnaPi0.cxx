@@ -14,6 +14,7 @@
  **************************************************************************/
 
 // --- ROOT system ---
+#include <algorithm>
 #include "TH3.h"
 #include "TH2F.h"
 //#include "Riostream.h"
@@ -51,7 +52,7 @@ ClassImp(AliAnaPi0) ;
 /// Default Constructor. Initialized parameters with default values.
 //______________________________________________________
 AliAnaPi0::AliAnaPi0() : AliAnaCaloTrackCorrBaseClass(),
-fEventsList(0x0),
+fMixPool(), fMixPhotons1(),
 fUseAngleCut(kFALSE),        fUseAngleEDepCut(kFALSE),     fAngleCut(0),                 fAngleMaxCut(0.),
 fMultiCutAna(kFALSE),        fMultiCutAnaSim(kFALSE),      fMultiCutAnaAcc(kFALSE),
 fNPtCuts(0),                 fNAsymCuts(0),                fNCellNCuts(0),               fNPIDBits(0), fNAngleCutBins(0),
@@ -62,7 +63,7 @@ fFillAngleHisto(kFALSE),     fFillAsymmetryHisto(kFALSE),  fFillOriginHisto(0),
 fFillArmenterosThetaStar(0), fFillOnlyMCAcceptanceHisto(0),
 fFillSecondaryCellTiming(0), fFillOpAngleCutHisto(0),      fCheckAccInSector(0),
 fPairWithOtherDetector(0),   fOtherDetectorInputName(""),
-fPhotonMom1(),               fPhotonMom1Boost(),           fPhotonMom2(),                fMCPrimMesonMom(),
+fPhotonMom1(),               fPhotonMom1Boost(),           fPhotonMom2(),                fPhotonMom12(),               fMCPrimMesonMom(),
 fMCProdVertex(),
 
 // Histograms
@@ -237,24 +238,7 @@ fhReSecondaryCellOutTimeWindow(0), fhMiSecondaryCellOutTimeWindow(0)
 //_____________________
 AliAnaPi0::~AliAnaPi0()
 {
-  // Remove event containers
-  
-  if(DoOwnMix() && fEventsList)
-  {
-    for(Int_t ic=0; ic<GetNCentrBin(); ic++)
-    {
-      for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-      {
-        for(Int_t irp=0; irp<GetNRPBin(); irp++)
-        {
-          Int_t bin = GetEventMixBin(ic,iz,irp);
-          fEventsList[bin]->Delete() ;
-          delete fEventsList[bin] ;
-        }
-      }
-    }
-    delete[] fEventsList;
-  }
+  // Event containers are removed with the object
 }
 
 //______________________________
@@ -820,20 +804,7 @@ TList * AliAnaPi0::GetCreateOutputObjects()
   //
   // Create mixed event containers
   //
-  fEventsList = new TList*[GetNCentrBin()*GetNZvertBin()*GetNRPBin()] ;
-  
-  for(Int_t ic=0; ic<GetNCentrBin(); ic++)
-  {
-    for(Int_t iz=0; iz<GetNZvertBin(); iz++)
-    {
-      for(Int_t irp=0; irp<GetNRPBin(); irp++)
-      {
-        Int_t bin = GetEventMixBin(ic,iz,irp);
-        fEventsList[bin] = new TList() ;
-        fEventsList[bin]->SetOwner(kFALSE);
-      }
-    }
-  }
+  fMixPool.assign(GetNCentrBin()*GetNZvertBin()*GetNRPBin(), std::deque< std::vector<MixPhoton_t> >()) ;
       
   fhRe1 = new TH2F*[GetNCentrBin()*fNPIDBits*fNAsymCuts] ;
   fhMi1 = new TH2F*[GetNCentrBin()*fNPIDBits*fNAsymCuts] ;
@@ -3058,12 +3029,7 @@ void AliAnaPi0::FillAcceptanceHistograms()
           
           if ( fNAngleCutBins > 0 && fFillOpAngleCutHisto )
           {
-            Int_t angleBin = -1;
-            for(Int_t ibin = 0; ibin < fNAngleCutBins; ibin++)
-            {
-              if(angle >= fAngleCutBinsArray[ibin] && 
-                 angle <  fAngleCutBinsArray[ibin+1]) angleBin = ibin;
-            }
+            Int_t angleBin = GetAngleCutBin(angle);
             
             if( angleBin >= 0 && angleBin < fNAngleCutBins)
               fhPrimPi0AccPtOpAngCuts[angleBin]->Fill(mesonPt,GetEventWeight()*weightPt);
@@ -3106,12 +3072,7 @@ void AliAnaPi0::FillAcceptanceHistograms()
           
           if ( fNAngleCutBins > 0 && fFillOpAngleCutHisto )
           {
-            Int_t angleBin = -1;
-            for(Int_t ibin = 0; ibin < fNAngleCutBins; ibin++)
-            {
-              if(angle >= fAngleCutBinsArray[ibin] && 
-                 angle <  fAngleCutBinsArray[ibin+1]) angleBin = ibin;
-            }
+            Int_t angleBin = GetAngleCutBin(angle);
             
             if( angleBin >= 0 && angleBin < fNAngleCutBins)
               fhPrimEtaAccPtOpAngCuts[angleBin]->Fill(mesonPt,GetEventWeight()*weightPt);
@@ -3419,12 +3380,7 @@ void AliAnaPi0::FillMCVersusRecDataHistograms(Int_t ancLabel , Int_t ancPDG,
         
         if ( fNAngleCutBins > 0 && fFillOpAngleCutHisto )
         {
-          Int_t angleBin = -1;
-          for(Int_t ibin = 0; ibin < fNAngleCutBins; ibin++)
-          {
-            if(angle >= fAngleCutBinsArray[ibin] && 
-               angle <  fAngleCutBinsArray[ibin+1]) angleBin = ibin;
-          }
+          Int_t angleBin = GetAngleCutBin(angle);
           
           if( angleBin >= 0 && angleBin < fNAngleCutBins)
             fhReOpAngleBinPairClusterMassMCTruePi0[angleBin]->Fill(pt, mass, GetEventWeight()*weightPt);
@@ -3599,12 +3555,7 @@ void AliAnaPi0::FillMCVersusRecDataHistograms(Int_t ancLabel , Int_t ancPDG,
         
         if ( fNAngleCutBins > 0 && fFillOpAngleCutHisto )
         {
-          Int_t angleBin = -1;
-          for(Int_t ibin = 0; ibin < fNAngleCutBins; ibin++)
-          {
-            if(angle >= fAngleCutBinsArray[ibin] && 
-               angle <  fAngleCutBinsArray[ibin+1]) angleBin = ibin;
-          }
+          Int_t angleBin = GetAngleCutBin(angle);
           
           if( angleBin >= 0 && angleBin < fNAngleCutBins)
             fhReOpAngleBinPairClusterMassMCTrueEta[angleBin]->Fill(pt, mass, GetEventWeight()*weightPt);
@@ -4377,12 +4328,7 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
       // Fill histograms for different opening angle bins
       if(fFillOpAngleCutHisto)
       {        
-        Int_t angleBin = -1;
-        for(Int_t ibin = 0; ibin < fNAngleCutBins; ibin++)
-        {
-          if(angle >= fAngleCutBinsArray[ibin] && 
-             angle <  fAngleCutBinsArray[ibin+1]) angleBin = ibin;
-        }
+        Int_t angleBin = GetAngleCutBin(angle);
         
         if( angleBin >= 0 && angleBin < fNAngleCutBins)
         {
@@ -4556,19 +4502,23 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Check that the bin exists, if not (bad determination of RP, centrality or vz bin) do nothing
     if(eventbin < 0) return ;
     
-    TList * evMixList=fEventsList[eventbin] ;
-    
-    if(!evMixList)
+    if(eventbin >= (Int_t) fMixPool.size())
     {
       AliWarning(Form("Mix event list not available, bin %d",eventbin));
       return;
     }
     
-    Int_t nMixed = evMixList->GetSize() ;
+    std::deque< std::vector<MixPhoton_t> > & evMixList = fMixPool[eventbin] ;
+    
+    // Compact copy of the selected photons of the current event, done once for all the mixed events
+    FillMixPhotons(GetInputAODBranch(), fMixPhotons1);
+    Int_t nPhot1 = fMixPhotons1.size();
+    
+    Int_t nMixed = evMixList.size() ;
     for(Int_t ii=0; ii<nMixed; ii++)
     {
-      TClonesArray* ev2= (TClonesArray*) (evMixList->At(ii));
-      Int_t nPhot2=ev2->GetEntriesFast() ;
+      const std::vector<MixPhoton_t> & ev2 = evMixList[ii];
+      Int_t nPhot2=ev2.size() ;
       Double_t m = -999;
       AliDebug(1,Form("Mixed event %d photon entries %d, centrality bin %d",ii, nPhot2, GetEventCentralityBin()));
       
@@ -4577,41 +4527,35 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
       //---------------------------------
       // First loop on photons/clusters
       //---------------------------------
-      for(Int_t i1 = 0; i1 < nPhot; i1++)
+      for(Int_t i1 = 0; i1 < nPhot1; i1++)
       {
-        AliCaloTrackParticle * p1 = (AliCaloTrackParticle*) (GetInputAODBranch()->At(i1)) ;
-        
-        // Select photons within a pT range
-        if ( p1->Pt() < GetMinPt() || p1->Pt()  > GetMaxPt() ) continue ;
-        
-        // Not sure why this line is here
-        //if(fSameSM && GetModuleNumber(p1)!=module1) continue;
+        const MixPhoton_t & p1 = fMixPhotons1[i1] ;
         
         //Get kinematics of cluster and (super) module of this cluster
-        fPhotonMom1.SetPxPyPzE(p1->Px(),p1->Py(),p1->Pz(),p1->E());
-        module1 = GetModuleNumber(p1);
+        fPhotonMom1.SetPxPyPzE(p1.fPx,p1.fPy,p1.fPz,p1.fE);
+        module1 = p1.fModule;
         
         //---------------------------------
         // Second loop on other mixed event photons/clusters
         //---------------------------------
         for(Int_t i2 = 0; i2 < nPhot2; i2++)
         {
-          AliCaloTrackParticle * p2 = (AliCaloTrackParticle*) (ev2->At(i2)) ;
-          
-          // Select photons within a pT range
-          if ( p2->Pt() < GetMinPt() || p2->Pt()  > GetMaxPt() ) continue ;
+          const MixPhoton_t & p2 = ev2[i2] ;
           
-          // Get kinematics of second cluster and calculate those of the pair
-          fPhotonMom2.SetPxPyPzE(p2->Px(),p2->Py(),p2->Pz(),p2->E());
-          m           = (fPhotonMom1+fPhotonMom2).M() ;
-          Double_t pt = (fPhotonMom1 + fPhotonMom2).Pt();
-          Double_t a  = TMath::Abs(p1->E()-p2->E())/(p1->E()+p2->E()) ;
+          //
+          // Pair kinematics, computed once per pair
+          //
+          fPhotonMom2.SetPxPyPzE(p2.fPx,p2.fPy,p2.fPz,p2.fE);
+          fPhotonMom12 = fPhotonMom1+fPhotonMom2;
+          m           = fPhotonMom12.M() ;
+          Double_t pt = fPhotonMom12.Pt();
+          Double_t a  = TMath::Abs(p1.fE-p2.fE)/(p1.fE+p2.fE) ;
           
           // Check if opening angle is too large or too small compared to what is expected
           Double_t angle   = fPhotonMom1.Angle(fPhotonMom2.Vect());
-          if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow((fPhotonMom1+fPhotonMom2).E(),angle+0.05))
+          if(fUseAngleEDepCut && !GetNeutralMesonSelection()->IsAngleInWindow(fPhotonMom12.E(),angle+0.05))
           {
-            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), (fPhotonMom1+fPhotonMom2).E()));
+            AliDebug(2,Form("Mix pair angle %f (deg) not in E %f window",RadToDeg(angle), fPhotonMom12.E()));
             continue;
           }
           
@@ -4621,11 +4565,18 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
             continue;
           }
           
-          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",p1->Pt(), p2->Pt(), pt,m,a));
+          AliDebug(2,Form("Mixed Event: pT: fPhotonMom1 %2.2f, fPhotonMom2 %2.2f; Pair: pT %2.2f, mass %2.3f, a %2.3f",fPhotonMom1.Pt(), fPhotonMom2.Pt(), pt,m,a));
           
           // In case we want only pairs in same (super) module, check their origin.
-          module2 = GetModuleNumber(p2);
-                    
+          module2 = p2.fModule;
+          
+          // Asymmetry bins passed by the pair
+          UInt_t asymBits = 0;
+          for(Int_t iasym=0; iasym < fNAsymCuts; iasym++)
+          {
+            if(a < fAsymCuts[iasym]) asymBits |= (1<<iasym);
+          }
+          
           //-------------------------------------------------------------------------------------------------
           // Fill module dependent histograms, put a cut on assymmetry on the first available cut in the array
           //-------------------------------------------------------------------------------------------------
@@ -4683,8 +4634,8 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
               Float_t phi1 = GetPhi(fPhotonMom1.Phi());
               Float_t phi2 = GetPhi(fPhotonMom2.Phi());
               Bool_t etaside = 0;
-              if(   (p1->GetDetectorTag()==kEMCAL && fPhotonMom1.Eta() < 0) 
-                 || (p2->GetDetectorTag()==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
+              if(   (p1.fDetectorTag==kEMCAL && fPhotonMom1.Eta() < 0) 
+                 || (p2.fDetectorTag==kEMCAL && fPhotonMom2.Eta() < 0)) etaside = 1;
               
               if      (    phi1 > DegToRad(260) && phi2 > DegToRad(260) && phi1 < DegToRad(280) && phi2 < DegToRad(280))  fhMiSameSectorDCALPHOSMod[0+etaside]->Fill(pt, m, GetEventWeight());
               else if (    phi1 > DegToRad(280) && phi2 > DegToRad(280) && phi1 < DegToRad(300) && phi2 < DegToRad(300))  fhMiSameSectorDCALPHOSMod[2+etaside]->Fill(pt, m, GetEventWeight());
@@ -4726,80 +4677,73 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check if one of the clusters comes from a conversion
           if(fCheckConversion)
           {
-            if     (p1->IsTagged() && p2->IsTagged()) fhMiConv2->Fill(pt, m, GetEventWeight());
-            else if(p1->IsTagged() || p2->IsTagged()) fhMiConv ->Fill(pt, m, GetEventWeight());
+            if     (p1.fTagged && p2.fTagged) fhMiConv2->Fill(pt, m, GetEventWeight());
+            else if(p1.fTagged || p2.fTagged) fhMiConv ->Fill(pt, m, GetEventWeight());
           }
           
           //
           // Main invariant mass histograms
           // Fill histograms for different bad channel distance, centrality, assymmetry cut and pid bit
           //
+          UInt_t pidBits = p1.fPIDBits & p2.fPIDBits;
           for(Int_t ipid=0; ipid<fNPIDBits; ipid++)
           {
-            if((p1->IsPIDOK(ipid,AliCaloPID::kPhoton)) && (p2->IsPIDOK(ipid,AliCaloPID::kPhoton)))
+            if(!(pidBits & (1<<ipid))) continue;
+            
+            for(Int_t iasym=0; iasym < fNAsymCuts; iasym++)
             {
-              for(Int_t iasym=0; iasym < fNAsymCuts; iasym++)
+              if(!(asymBits & (1<<iasym))) continue;
+              
+              Int_t index = ((curCentrBin*fNPIDBits)+ipid)*fNAsymCuts + iasym;
+              
+              if(index < 0 || index >= ncentr*fNPIDBits*fNAsymCuts) continue ;
+              
+              fhMi1[index]->Fill(pt, m, GetEventWeight()) ;
+              if(fMakeInvPtPlots)fhMiInvPt1[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
+              
+              if(fFillBadDistHisto)
               {
-                if(a < fAsymCuts[iasym])
+                if(p1.fDistToBad>0 && p2.fDistToBad>0)
                 {
-                  Int_t index = ((curCentrBin*fNPIDBits)+ipid)*fNAsymCuts + iasym;
-                  
-                  if(index < 0 || index >= ncentr*fNPIDBits*fNAsymCuts) continue ;
+                  fhMi2[index]->Fill(pt, m, GetEventWeight()) ;
+                  if(fMakeInvPtPlots)fhMiInvPt2[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
                   
-                  fhMi1[index]->Fill(pt, m, GetEventWeight()) ;
-                  if(fMakeInvPtPlots)fhMiInvPt1[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
-                  
-                  if(fFillBadDistHisto)
+                  if(p1.fDistToBad>1 && p2.fDistToBad>1)
                   {
-                    if(p1->DistToBad()>0 && p2->DistToBad()>0)
-                    {
-                      fhMi2[index]->Fill(pt, m, GetEventWeight()) ;
-                      if(fMakeInvPtPlots)fhMiInvPt2[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
-                      
-                      if(p1->DistToBad()>1 && p2->DistToBad()>1)
-                      {
-                        fhMi3[index]->Fill(pt, m, GetEventWeight()) ;
-                        if(fMakeInvPtPlots)fhMiInvPt3[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
-                      }
-                    }
-                  }// Fill bad dist histo
-                  
-                }//Asymmetry cut
-              }// Asymmetry loop
-            }//PID cut
+                    fhMi3[index]->Fill(pt, m, GetEventWeight()) ;
+                    if(fMakeInvPtPlots)fhMiInvPt3[index]->Fill(pt, m, 1./pt * GetEventWeight()) ;
+                  }
+                }
+              }// Fill bad dist histo
+            }// Asymmetry loop
           }// PID loop 
 
           //-----------------------
           // Multi cuts analysis
           //-----------------------
-          Int_t  ncell1 = p1->GetNCells();
-          Int_t  ncell2 = p1->GetNCells();
+          Int_t  ncell1 = p1.fNCells;
+          Int_t  ncell2 = p2.fNCells;
           
           if(fMultiCutAna)
           {
             // Several pt,ncell and asymmetry cuts
             for(Int_t ipt=0; ipt<fNPtCuts; ipt++)
             {
+              if(fPhotonMom1.Pt() <= fPtCuts[ipt]    || fPhotonMom2.Pt() <= fPtCuts[ipt]    ||
+                 fPhotonMom1.Pt() >= fPtCutsMax[ipt] || fPhotonMom2.Pt() >= fPtCutsMax[ipt]) continue;
+              
               for(Int_t icell=0; icell<fNCellNCuts; icell++)
               {
+                if(ncell1 < fCellNCuts[icell] || ncell2 < fCellNCuts[icell]) continue;
+                
                 for(Int_t iasym=0; iasym<fNAsymCuts; iasym++)
                 {
+                  if(!(asymBits & (1<<iasym))) continue;
+                  
                   Int_t index = ((ipt*fNCellNCuts)+icell)*fNAsymCuts + iasym;
                   
-                  if(p1->Pt() >   fPtCuts[ipt]      && p2->Pt() > fPtCuts[ipt]      &&
-                     p1->Pt() <   fPtCutsMax[ipt]   && p2->Pt() < fPtCutsMax[ipt]   &&
-                     a        <   fAsymCuts[iasym]                                  &&
-                     ncell1   >=  fCellNCuts[icell] && ncell2   >= fCellNCuts[icell] 
-                     )
-                  {
-                    //printf("MI ipt %d, iasym%d, icell %d, index %d \n",ipt, iasym, icell, index);
-                    //printf("\t %p, %p\n",fhMiPtNCellAsymCuts[index],fhMiPtNCellAsymCutsOpAngle[index]);
-                    
-                    fhMiPtNCellAsymCuts[index]->Fill(pt, m, GetEventWeight()) ;
-                    if(fFillAngleHisto)  fhMiPtNCellAsymCutsOpAngle[index]->Fill(pt, angle, GetEventWeight()) ;
-                    
-                    //printf("ipt %d, icell%d, iasym %d, name %s\n",ipt, icell, iasym,  fhRePtNCellAsymCuts[((ipt*fNCellNCuts)+icell)*fNAsymCuts + iasym]->GetName());
-                  }
+                  fhMiPtNCellAsymCuts[index]->Fill(pt, m, GetEventWeight()) ;
+                  if(fFillAngleHisto)  fhMiPtNCellAsymCutsOpAngle[index]->Fill(pt, angle, GetEventWeight()) ;
                 }// pid bit cut loop
               }// icell loop
             }// pt cut loop
@@ -4817,94 +4761,37 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Fill histograms for different opening angle bins
           if(fFillOpAngleCutHisto)
           {
-            Int_t angleBin = -1;
-            for(Int_t ibin = 0; ibin < fNAngleCutBins; ibin++)
-            {
-              if(angle >= fAngleCutBinsArray[ibin] && 
-                 angle <  fAngleCutBinsArray[ibin+1]) angleBin = ibin;
-            }
+            Int_t angleBin = GetAngleCutBin(angle);
             
             if( angleBin >= 0 && angleBin < fNAngleCutBins)
             {
-              Float_t e1   = fPhotonMom1.E();
-              Float_t e2   = fPhotonMom2.E();
-              
-              Float_t t1   = p1->GetTime();
-              Float_t t2   = p2->GetTime();
+              // order the pair by energy
+              const MixPhoton_t    & pMax    = p2.fE > p1.fE ? p2 : p1;
+              const MixPhoton_t    & pMin    = p2.fE > p1.fE ? p1 : p2;
+              const TLorentzVector & momMax  = p2.fE > p1.fE ? fPhotonMom2 : fPhotonMom1;
+              const TLorentzVector & momMin  = p2.fE > p1.fE ? fPhotonMom1 : fPhotonMom2;
               
-              Int_t nc1    = ncell1;
-              Int_t nc2    = ncell2;
-              
-              Float_t eta1 = fPhotonMom1.Eta(); 
-              Float_t eta2 = fPhotonMom2.Eta(); 
-              
-              Float_t phi1 = GetPhi(fPhotonMom1.Phi());
-              Float_t phi2 = GetPhi(fPhotonMom2.Phi());
-              
-              Int_t   mod1 = module1;
-              Int_t   mod2 = module2;
-              
-              //              // Recover original cluster
-              //              Int_t iclus1 = -1, iclus2 = -1 ;
-              //              AliVCluster * cluster1 = FindCluster(GetEMCALClusters(),p1->GetCaloLabel(0),iclus1);
-              //              AliVCluster * cluster2 = FindCluster(GetEMCALClusters(),p2->GetCaloLabel(0),iclus2);
-              //              
-              //              Float_t maxCellFraction1 = 0, maxCellFraction2 = 0;
-              //              Int_t absIdMax1 = GetCaloUtils()->GetMaxEnergyCell(GetEMCALCells(),cluster1,maxCellFraction1);
-              //              Int_t absIdMax2 = GetCaloUtils()->GetMaxEnergyCell(GetEMCALCells(),cluster2,maxCellFraction2);
-              
-              if(e2 > e1)
-              {
-                e1   = fPhotonMom2.E();
-                e2   = fPhotonMom1.E();
-                
-                t1   = p2->GetTime();
-                t2   = p1->GetTime();
-                
-                nc1  = ncell2;
-                nc2  = ncell1;
-                
-                eta1 = fPhotonMom2.Eta(); 
-                eta2 = fPhotonMom1.Eta(); 
-                
-                phi1 = GetPhi(fPhotonMom2.Phi());
-                phi2 = GetPhi(fPhotonMom1.Phi());
-                
-                mod1 = module2;
-                mod2 = module1;
-                
-                //                Int_t tmp = absIdMax2;
-                //                absIdMax2 = absIdMax1;
-                //                absIdMax1 = tmp;
-              }
+              Float_t e1   = pMax.fE;
+              Float_t e2   = pMin.fE;
+              Int_t   mod1 = pMax.fModule;
+              Int_t   mod2 = pMin.fModule;
               
               fhMiOpAngleBinMinClusterEPerSM[angleBin]->Fill(e2,mod2,GetEventWeight()) ; 
               fhMiOpAngleBinMaxClusterEPerSM[angleBin]->Fill(e1,mod1,GetEventWeight()) ; 
               
-              fhMiOpAngleBinMinClusterTimePerSM[angleBin]->Fill(t2,mod2,GetEventWeight()) ; 
-              fhMiOpAngleBinMaxClusterTimePerSM[angleBin]->Fill(t1,mod1,GetEventWeight()) ; 
+              fhMiOpAngleBinMinClusterTimePerSM[angleBin]->Fill(pMin.fTime,mod2,GetEventWeight()) ; 
+              fhMiOpAngleBinMaxClusterTimePerSM[angleBin]->Fill(pMax.fTime,mod1,GetEventWeight()) ; 
               
-              fhMiOpAngleBinMinClusterNCellPerSM[angleBin]->Fill(nc2,mod2,GetEventWeight()) ; 
-              fhMiOpAngleBinMaxClusterNCellPerSM[angleBin]->Fill(nc1,mod1,GetEventWeight()) ; 
+              fhMiOpAngleBinMinClusterNCellPerSM[angleBin]->Fill(pMin.fNCells,mod2,GetEventWeight()) ; 
+              fhMiOpAngleBinMaxClusterNCellPerSM[angleBin]->Fill(pMax.fNCells,mod1,GetEventWeight()) ; 
               
               fhMiOpAngleBinPairClusterMass[angleBin]->Fill(pt,m,GetEventWeight()) ;
               if(mod2 == mod1)  fhMiOpAngleBinPairClusterMassPerSM[angleBin]->Fill(m,mod1,GetEventWeight()) ;
               
               if(e1 > 0.01) fhMiOpAngleBinPairClusterRatioPerSM[angleBin]->Fill(e2/e1,mod1,GetEventWeight()) ;  
               
-              fhMiOpAngleBinMinClusterEtaPhi[angleBin]->Fill(eta2,phi2,GetEventWeight()) ;
-              fhMiOpAngleBinMaxClusterEtaPhi[angleBin]->Fill(eta1,phi1,GetEventWeight()) ;
-              
-              //              Int_t   icol1 = -1, icol2 = -1, icolAbs1 = -1, icolAbs2 = -1;
-              //              Int_t   irow1 = -1, irow2 = -1, irowAbs1 = -1, irowAbs2 = -1;
-              //              Int_t   iRCU1 = -1, iRCU2 = -1;
-              //              GetModuleNumberCellIndexesAbsCaloMap(absIdMax1,GetCalorimeter(), icol1, irow1, iRCU1, icolAbs1, irowAbs1);
-              //              GetModuleNumberCellIndexesAbsCaloMap(absIdMax2,GetCalorimeter(), icol2, irow2, iRCU1, icolAbs2, irowAbs2);
-              //              
-              //              fhMiOpAngleBinPairClusterAbsIdMaxCell[angleBin]->Fill(absIdMax1,absIdMax2,GetEventWeight());
-              //
-              //              fhMiColRowClusterMinOpAngleBin[angleBin]->Fill(icolAbs2,irowAbs2,GetEventWeight()) ;
-              //              fhMiOpAngleBinMaxClusterColRow[angleBin]->Fill(icolAbs1,irowAbs1,GetEventWeight()) ;
+              fhMiOpAngleBinMinClusterEtaPhi[angleBin]->Fill(momMin.Eta(),GetPhi(momMin.Phi()),GetEventWeight()) ;
+              fhMiOpAngleBinMaxClusterEtaPhi[angleBin]->Fill(momMax.Eta(),GetPhi(momMax.Phi()),GetEventWeight()) ;
             }
           }
           
@@ -4919,10 +4806,10 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
           // Check cell time content in cluster
           if ( fFillSecondaryCellTiming )
           {
-            if      ( p1->GetFiducialArea() == 0 && p2->GetFiducialArea() == 0 )
+            if      ( p1.fFiducialArea == 0 && p2.fFiducialArea == 0 )
               fhMiSecondaryCellInTimeWindow ->Fill(pt, m, GetEventWeight());
             
-            else if ( p1->GetFiducialArea() != 0 && p2->GetFiducialArea() != 0 )
+            else if ( p1.fFiducialArea != 0 && p2.fFiducialArea != 0 )
               fhMiSecondaryCellOutTimeWindow->Fill(pt, m, GetEventWeight());
           }
                   
@@ -4934,31 +4821,80 @@ void AliAnaPi0::MakeAnalysisFillHistograms()
     // Add the current event to the list of events for mixing
     //--------------------------------------------------------
     
-    //TClonesArray *currentEvent = new TClonesArray(*GetInputAODBranch());
-    TClonesArray *currentEvent = new TClonesArray(*secondLoopInputData);
-    
     // Add current event to buffer and Remove redundant events
-    if( currentEvent->GetEntriesFast() > 0 )
+    if( secondLoopInputData->GetEntriesFast() > 0 )
     {
-      evMixList->AddFirst(currentEvent) ;
-      currentEvent=0 ; //Now list of particles belongs to buffer and it will be deleted with buffer
-      if( evMixList->GetSize() >= GetNMaxEvMix() )
+      if( (Int_t) evMixList.size() + 1 < GetNMaxEvMix() )
       {
-        TClonesArray * tmp = (TClonesArray*) (evMixList->Last()) ;
-        evMixList->RemoveLast() ;
-        delete tmp ;
+        evMixList.push_front(std::vector<MixPhoton_t>());
+        FillMixPhotons(secondLoopInputData, evMixList.front());
+      }
+      else if( !evMixList.empty() )
+      {
+        // Buffer full, reuse the memory of the oldest event
+        evMixList.push_front(std::vector<MixPhoton_t>());
+        evMixList.front().swap(evMixList.back());
+        evMixList.pop_back();
+        FillMixPhotons(secondLoopInputData, evMixList.front());
       }
-    }
-    else
-    { // empty event
-      delete currentEvent ;
-      currentEvent=0 ;
     }
   }// DoOwnMix
   
   AliDebug(1,"End fill histograms");
 }
 
+//________________________________________________________________________
+/// Copy the photons of the array within the pT range into the compact
+/// records used for the event mixing, evaluating once per photon
+/// the module number and the PID bits.
+//________________________________________________________________________
+void AliAnaPi0::FillMixPhotons(TClonesArray * array, std::vector<MixPhoton_t> & photons) const
+{
+  photons.clear();
+  
+  Int_t nPhot = array->GetEntriesFast();
+  for(Int_t i = 0; i < nPhot; i++)
+  {
+    AliCaloTrackParticle * p = (AliCaloTrackParticle*) (array->At(i)) ;
+    
+    // Select photons within a pT range
+    if ( p->Pt() < GetMinPt() || p->Pt()  > GetMaxPt() ) continue ;
+    
+    MixPhoton_t photon;
+    photon.fPx           = p->Px();
+    photon.fPy           = p->Py();
+    photon.fPz           = p->Pz();
+    photon.fE            = p->E();
+    photon.fTime         = p->GetTime();
+    photon.fModule       = GetModuleNumber(p);
+    photon.fNCells       = p->GetNCells();
+    photon.fFiducialArea = p->GetFiducialArea();
+    photon.fDetectorTag  = p->GetDetectorTag();
+    photon.fDistToBad    = p->DistToBad() > 127 ? 127 : p->DistToBad();
+    photon.fTagged       = p->IsTagged();
+    photon.fPIDBits      = 0;
+    for(Int_t ipid = 0; ipid < fNPIDBits && ipid < 16; ipid++)
+    {
+      if(p->IsPIDOK(ipid,AliCaloPID::kPhoton)) photon.fPIDBits |= (1<<ipid);
+    }
+    
+    photons.push_back(photon);
+  }
+}
+
+//________________________________________________________________________
+/// \return the opening angle bin, -1 if outside the fNAngleCutBins bins
+/// defined by fAngleCutBinsArray.
+//________________________________________________________________________
+Int_t AliAnaPi0::GetAngleCutBin(Double_t angle) const
+{
+  Int_t angleBin = std::upper_bound(fAngleCutBinsArray, fAngleCutBinsArray+fNAngleCutBins+1, angle) - fAngleCutBinsArray - 1;
+  
+  if ( angleBin >= fNAngleCutBins ) return -1;
+  
+  return angleBin;
+}
+
 //________________________________________________________________________
 /// It retieves the event index and checks the vertex
 ///  * in the mixed buffer returns -2 if vertex NOK
@@ -25,10 +25,13 @@
 //_________________________________________________________________________
 
 // Root
+#include <deque>
+#include <vector>
 class TList;
 class TH3F ;
 class TH2F ;
 class TObjString;
+class TClonesArray;
 
 // Analysis
 #include "AliAnaCaloTrackCorrBaseClass.h"
@@ -182,8 +185,29 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
 
   private:
 
-  /// Containers for photons in stored events
-  TList ** fEventsList ;               //![GetNCentrBin()*GetNZvertBin()*GetNRPBin()]
+  /// \struct MixPhoton_t
+  /// Compact copy of a selected photon of a stored event, with what the mixing needs.
+  struct MixPhoton_t
+  {
+    Float_t  fPx, fPy, fPz, fE;        ///<  4-momentum
+    Float_t  fTime;                    ///<  cluster time
+    Int_t    fModule;                  ///<  (super) module number
+    Int_t    fNCells;                  ///<  number of cells in cluster
+    Int_t    fFiducialArea;            ///<  secondary cells timing flag
+    UInt_t   fDetectorTag;             ///<  detector of the photon
+    UShort_t fPIDBits;                 ///<  bit ipid set if IsPIDOK(ipid,kPhoton)
+    Char_t   fDistToBad;               ///<  distance to bad channel
+    Bool_t   fTagged;                  ///<  tagged as conversion
+  };
+  
+  void     FillMixPhotons(TClonesArray * array, std::vector<MixPhoton_t> & photons) const ;
+  
+  Int_t    GetAngleCutBin(Double_t angle) const ;
+  
+  /// Containers for photons in stored events, per mixing bin, most recent event first
+  std::vector< std::deque< std::vector<MixPhoton_t> > > fMixPool ; //!<!
+  
+  std::vector<MixPhoton_t> fMixPhotons1 ; //!<! Compact copy of the selected photons of the current event, temporary array
   
   Bool_t   fUseAngleCut ;              ///<  Select pairs depending on their opening angle
   Bool_t   fUseAngleEDepCut ;          ///<  Select pairs depending on their opening angle
@@ -233,6 +257,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   TLorentzVector fPhotonMom1;          //!<! Photon cluster momentum, temporary array
   TLorentzVector fPhotonMom1Boost;     //!<! Photon cluster momentum, temporary array
   TLorentzVector fPhotonMom2;          //!<! Photon cluster momentum, temporary array
+  TLorentzVector fPhotonMom12;         //!<! Photon pair momentum, temporary array
   TLorentzVector fMCPrimMesonMom;      //!<! Pi0/Eta MC primary momentum, temporary array
   TVector3       fMCProdVertex;        //!<! Pi0/Eta MC Production vertex, temporary array
     
@@ -605,7 +630,7 @@ class AliAnaPi0 : public AliAnaCaloTrackCorrBaseClass {
   AliAnaPi0 & operator = (const AliAnaPi0 & api0) ;
   
   /// \cond CLASSIMP
-  ClassDef(AliAnaPi0,35) ;
+  ClassDef(AliAnaPi0,36) ;
   /// \endcond
   
 } ;
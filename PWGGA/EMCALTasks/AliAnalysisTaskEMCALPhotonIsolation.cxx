@@ -233,6 +233,11 @@ fphietaOthersBis(0),
 fSPDclustVsSPDtracklets(0),
 fnPUevents(0),
 f2012EGA(0),
+fIsoTrackPt(),
+fIsoTrackEta(),
+fIsoTrackPhi(),
+fIsoTrackLabel(),
+fIsoTracksFilled(kFALSE),
 fHistoRangeContainer(0x0)
   // tracks(0),
   // clusters(0)
@@ -429,6 +434,11 @@ fphietaOthersBis(0),
 fSPDclustVsSPDtracklets(0),
 fnPUevents(0),
 f2012EGA(0),
+fIsoTrackPt(),
+fIsoTrackEta(),
+fIsoTrackPhi(),
+fIsoTrackLabel(),
+fIsoTracksFilled(kFALSE),
 fHistoRangeContainer(0x0)
   // tracks(0),
   // clusters(0)
@@ -1274,6 +1284,8 @@ Bool_t AliAnalysisTaskEMCALPhotonIsolation::Run()
 {
     // Run the analysis
 
+  fIsoTracksFilled = kFALSE;
+
   AliTrackContainer *tracks = GetTrackContainer("tpconlyMatch");
   if(!tracks){
     AliWarning(Form("Cannot find the tracks for CT matching"));
@@ -2142,66 +2154,30 @@ void AliAnalysisTaskEMCALPhotonIsolation::EtIsoClusPhiBand(TLorentzVector c, Dou
     }
   }
 
-  AliTrackContainer *tracksAna = GetTrackContainer("filterTracksAna");
-    // fTracksAna = dynamic_cast<TClonesArray*>(InputEvent()->FindListObject("FilterTracksAna"));
-    // Name hard coded to use the defined tracks for analysis
-
-  if(!tracksAna){
-    AliError(Form("Could not retrieve tracks !"));
+  // Tracks passing the isolation track selection, filled once per event
+  if(!FillIsoTracks())
     return;
-  }
-
-  tracksAna->ResetCurrentID();
 
-  AliVTrack *eTrack = 0x0;
   Int_t iTracksCone = 0.;
-  AliAODTrack *aodEtrack = 0x0;
   Double_t phiTrack = 0., etaTrack = 0.;
 
-  while((eTrack = static_cast<AliVTrack*>(tracksAna->GetNextAcceptParticle()))){
-    if(!eTrack){
-      AliError(Form("No tracks in collection"));
-      continue;
-    }
-
-    if(!fIsEsd){
-      aodEtrack = static_cast<AliAODTrack*>(eTrack);
-      if(!(aodEtrack->IsHybridGlobalConstrainedGlobal()))
-        continue;
-    }
-
-    if((eTrack->Pt())<0.2)
-      continue;
-
-    if((eTrack->GetStatus() & AliAODTrack::kITSrefit) != AliAODTrack::kITSrefit)
-      continue;
-
-    if(!fIsEsd){
-      Double_t frac = 0.;
-      Float_t ncls  = Float_t(aodEtrack->GetTPCncls ());
-      Float_t nclsS = Float_t(aodEtrack->GetTPCnclsS());
-      if(ncls> 0)  frac =  nclsS / ncls ;
-
-      if(frac > 0.4)
-        continue;
-    }
-
-    phiTrack = eTrack->Phi();
-    etaTrack = eTrack->Eta();
+  for(UInt_t itrack = 0; itrack < fIsoTrackPt.size(); itrack++){
+    phiTrack = fIsoTrackPhi[itrack];
+    etaTrack = fIsoTrackEta[itrack];
 
     if((phiTrack < phiMax) && (phiTrack > phiMin) && (etaTrack < etaMax) && (etaTrack > etaMin)){
       radius = TMath::Sqrt(TMath::Power(phiTrack - c.Phi(),2)+TMath::Power(etaTrack - c.Eta(),2)); // Define the radius between the leading cluster and the considered track
       if(radius > fIsoConeRadius){                                                                 // The track is outside the isolation cone -> add the track pT to pT_UE
 	if(TMath::Abs(etaTrack - c.Eta()) < fIsoConeRadius)
-	  sumpTPhiBandTracks += eTrack->Pt();
+	  sumpTPhiBandTracks += fIsoTrackPt[itrack];
       }
       else{                                                                                        // The track is inside the isolation cone -> add the track pT to pT_iso
-	sumpTConeCharged += eTrack->Pt();
+	sumpTConeCharged += fIsoTrackPt[itrack];
 	if(fIsMC){
-	  int tracklabel = TMath::Abs(eTrack->GetLabel());
+	  int tracklabel = fIsoTrackLabel[itrack];
 	  AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
     if(fWho==1)
-      fTrackResolutionPtMC->Fill(eTrack->Pt(), pMC->Pt() - eTrack->Pt());
+      fTrackResolutionPtMC->Fill(fIsoTrackPt[itrack], pMC->Pt() - fIsoTrackPt[itrack]);
 	}
 	iTracksCone++;
       }
@@ -2345,63 +2321,36 @@ void AliAnalysisTaskEMCALPhotonIsolation::EtIsoClusEtaBand(TLorentzVector c, Dou
   if(tracksAna->GetTrackFilterType() != AliEmcalTrackSelection::kHybridTracks)
     AliError(Form("NOT Hybrid Tracks"));
 
-  tracksAna->ResetCurrentID();
+  // Tracks passing the isolation track selection, filled once per event
+  if(!FillIsoTracks())
+    return;
 
-  AliVTrack *eTrack = 0x0;
   Double_t phiTrack = 0., etaTrack = 0.;
   Int_t iTracksCone = 0;
-  AliAODTrack *aodEtrack = 0x0;
-
-  while((eTrack = static_cast<AliVTrack*>(tracksAna->GetNextAcceptParticle()))){
-    if(!eTrack){
-      AliError(Form("No tracks in collection"));
-      continue;
-    }
-
-    if(!fIsEsd){
-      aodEtrack = static_cast<AliAODTrack*>(eTrack);
-      if(!(aodEtrack->IsHybridGlobalConstrainedGlobal()))
-        continue;
-    }
-
-    if((eTrack->Pt())<0.2)
-      continue;
-
-    if((eTrack->GetStatus() & AliAODTrack::kITSrefit) != AliAODTrack::kITSrefit)
-      continue;
 
-    if(!fIsEsd){
-      Double_t frac = 0.;
-      Float_t ncls  = Float_t(aodEtrack->GetTPCncls ());
-      Float_t nclsS = Float_t(aodEtrack->GetTPCnclsS());
-      if(ncls> 0) frac =  nclsS / ncls ;
-
-      if(frac > 0.4)
-        continue;
-    }
-
-    phiTrack = eTrack->Phi();
-    etaTrack = eTrack->Eta();
+  for(UInt_t itrack = 0; itrack < fIsoTrackPt.size(); itrack++){
+    phiTrack = fIsoTrackPhi[itrack];
+    etaTrack = fIsoTrackEta[itrack];
 
     if((phiTrack < phiMax) && (phiTrack > phiMin) && (etaTrack < etaMax) && (etaTrack > etaMin)){
       radius = TMath::Sqrt(TMath::Power(phiTrack - c.Phi(),2)+TMath::Power(etaTrack - c.Eta(),2)); // Define the radius between the leading cluster and the considered track
       if(radius > fIsoConeRadius){                                                                 // The track is outside the isolation cone -> add the track pT to pT_UE
 	if(TMath::Abs(phiTrack - c.Phi()) < fIsoConeRadius){
-	  sumpTEtaBandTracks += eTrack->Pt();
+	  sumpTEtaBandTracks += fIsoTrackPt[itrack];
 
 	  if(fWho == 2 && etaTrack < 0.)
-	    sumpTEtaBandTracks_Cside += eTrack->Pt();
+	    sumpTEtaBandTracks_Cside += fIsoTrackPt[itrack];
 	  if(fWho == 2 && etaTrack > 0.)
-	    sumpTEtaBandTracks_Aside += eTrack->Pt();
+	    sumpTEtaBandTracks_Aside += fIsoTrackPt[itrack];
 	}
       }
       else{                                                                                             // The track is inside the isolation cone -> add the track pT to pT_iso
-	sumpTConeCharged += eTrack->Pt();
+	sumpTConeCharged += fIsoTrackPt[itrack];
 	if(fIsMC){
-	  int tracklabel = TMath::Abs(eTrack->GetLabel());
+	  int tracklabel = fIsoTrackLabel[itrack];
 	  AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
     if(fWho==1)
-      fTrackResolutionPtMC->Fill(eTrack->Pt(), pMC->Pt() - eTrack->Pt());
+      fTrackResolutionPtMC->Fill(fIsoTrackPt[itrack], pMC->Pt() - fIsoTrackPt[itrack]);
 	}
 	iTracksCone++;
       }
@@ -2500,62 +2449,30 @@ void AliAnalysisTaskEMCALPhotonIsolation::PtIsoTrackPhiBand(TLorentzVector c, Do
     }
   }
 
-  AliTrackContainer *tracksAna = GetTrackContainer("filterTracksAna");
-  if(!tracksAna){
-    AliError(Form("Could not retrieve tracks !"));
+  // Tracks passing the isolation track selection, filled once per event
+  if(!FillIsoTracks())
     return;
-  }
-
-  tracksAna->ResetCurrentID();
 
-  AliVTrack *eTrack = 0x0;
   Double_t phiTrack = 0., etaTrack = 0., radius = 0.;
   Int_t iTracksCone = 0;
-  AliAODTrack *aodEtrack = 0x0;
-
-  while((eTrack = static_cast<AliVTrack*>(tracksAna->GetNextAcceptParticle()))){
-    if(!eTrack){
-      AliError(Form("No tracks in collection"));
-      continue;
-    }
-
-    if(!fIsEsd){
-      aodEtrack = static_cast<AliAODTrack*>(eTrack);
-      if(!(aodEtrack->IsHybridGlobalConstrainedGlobal()))
-        continue;
-    }
-
-    if((eTrack->Pt())<0.2)
-      continue;
 
-    if((eTrack->GetStatus() & AliAODTrack::kITSrefit) != AliAODTrack::kITSrefit)
-      continue;
-
-    if(!fIsEsd){
-      Double_t frac = 0.;
-      Float_t ncls  = Float_t(aodEtrack->GetTPCncls ());
-      Float_t nclsS = Float_t(aodEtrack->GetTPCnclsS());
-      if(ncls> 0)  frac =  nclsS / ncls ;
-
-      if(frac > 0.4) continue;
-    }
-
-    phiTrack = eTrack->Phi();
-    etaTrack = eTrack->Eta();
+  for(UInt_t itrack = 0; itrack < fIsoTrackPt.size(); itrack++){
+    phiTrack = fIsoTrackPhi[itrack];
+    etaTrack = fIsoTrackEta[itrack];
 
     if((phiTrack < phiMax) && (phiTrack > phiMin) && (etaTrack < etaMax) && (etaTrack > etaMin)){
       radius = TMath::Sqrt(TMath::Power(phiTrack - c.Phi(),2)+TMath::Power(etaTrack - c.Eta(),2)); // Define the radius between the leading cluster and the considered track
       if(radius > fIsoConeRadius){                                                                 // The track is outside the isolation cone -> add the track pT to pT_UE
         if(TMath::Abs(etaTrack - c.Eta()) < fIsoConeRadius)
-          sumpTPhiBandTrack += eTrack->Pt();
+          sumpTPhiBandTrack += fIsoTrackPt[itrack];
       }
       else{                                                                                             // The track is inside the isolation cone -> add the track pT to pT_iso
-        sumpTConeCharged += eTrack->Pt();
+        sumpTConeCharged += fIsoTrackPt[itrack];
         if(fIsMC){
-          int tracklabel = TMath::Abs(eTrack->GetLabel());
+          int tracklabel = fIsoTrackLabel[itrack];
           AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
           if(fWho==1)
-            fTrackResolutionPtMC->Fill(eTrack->Pt(), pMC->Pt() - eTrack->Pt());
+            fTrackResolutionPtMC->Fill(fIsoTrackPt[itrack], pMC->Pt() - fIsoTrackPt[itrack]);
         }
         iTracksCone++;
       }
@@ -2599,63 +2516,30 @@ void AliAnalysisTaskEMCALPhotonIsolation::PtIsoTrackEtaBand(TLorentzVector c, Do
     }
   }
 
-  AliTrackContainer *tracksAna = GetTrackContainer("filterTracksAna");
-  if(!tracksAna){
-    AliError(Form("Could not retrieve tracks !"));
+  // Tracks passing the isolation track selection, filled once per event
+  if(!FillIsoTracks())
     return;
-  }
-
-  tracksAna->ResetCurrentID();
 
-  AliVTrack *eTrack = 0x0;
   Double_t phiTrack = 0., etaTrack = 0., radius = 0.;
   Int_t iTracksCone = 0;
-  AliAODTrack *aodEtrack = 0x0;
-
-  while((eTrack = static_cast<AliVTrack*>(tracksAna->GetNextAcceptParticle()))){
-    if(!eTrack){
-      AliError(Form("No tracks in collection"));
-      continue;
-    }
-
-    if(!fIsEsd){
-      aodEtrack = static_cast<AliAODTrack*>(eTrack);
-      if(!(aodEtrack->IsHybridGlobalConstrainedGlobal()))
-        continue;
-    }
-
-    if((eTrack->Pt())<0.2)
-      continue;
-
-    if((eTrack->GetStatus() & AliAODTrack::kITSrefit) != AliAODTrack::kITSrefit)
-      continue;
-
-    if(!fIsEsd){
-      Double_t frac = 0.;
-      Float_t ncls  = Float_t(aodEtrack->GetTPCncls ());
-      Float_t nclsS = Float_t(aodEtrack->GetTPCnclsS());
-      if(ncls> 0)  frac =  nclsS / ncls ;
 
-      if(frac > 0.4)
-        continue;
-    }
-
-    phiTrack = eTrack->Phi();
-    etaTrack = eTrack->Eta();
+  for(UInt_t itrack = 0; itrack < fIsoTrackPt.size(); itrack++){
+    phiTrack = fIsoTrackPhi[itrack];
+    etaTrack = fIsoTrackEta[itrack];
 
     if( (phiTrack < phiMax) && (phiTrack > phiMin) && (etaTrack < etaMax) && (etaTrack > etaMin)){
       radius = TMath::Sqrt(TMath::Power(phiTrack - c.Phi(),2)+TMath::Power(etaTrack - c.Eta(),2)); // Define the radius between the leading cluster and the considered track
       if(radius > fIsoConeRadius){                                                                 // The track is outside the isolation cone -> add the track pT to pT_UE
         if(TMath::Abs(phiTrack - c.Phi()) < fIsoConeRadius)
-          sumpTEtaBandTrack += eTrack->Pt();
+          sumpTEtaBandTrack += fIsoTrackPt[itrack];
       }
       else{                                                                                             // The track is inside the isolation cone -> add the track pT to pT_iso
-        sumpTConeCharged += eTrack->Pt();
+        sumpTConeCharged += fIsoTrackPt[itrack];
         if(fIsMC){
-          int tracklabel = TMath::Abs(eTrack->GetLabel());
+          int tracklabel = fIsoTrackLabel[itrack];
           AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
           if(fWho==1)
-            fTrackResolutionPtMC->Fill(eTrack->Pt(), pMC->Pt() - eTrack->Pt());
+            fTrackResolutionPtMC->Fill(fIsoTrackPt[itrack], pMC->Pt() - fIsoTrackPt[itrack]);
         }
         iTracksCone++;
       }
@@ -2688,57 +2572,25 @@ void AliAnalysisTaskEMCALPhotonIsolation::PtIsoTrackOrthCones(TLorentzVector c,
   if(phiCone1 < 0.)
     phiCone1 += 2*TMath::Pi();
 
-  AliTrackContainer *tracksAna = GetTrackContainer("filterTracksAna");
-  if(!tracksAna){
-    AliError(Form("Could not retrieve tracks !"));
+  // Tracks passing the isolation track selection, filled once per event
+  if(!FillIsoTracks())
     return;
-  }
 
-  tracksAna->ResetCurrentID();
-
-  AliVTrack *eTrack = 0x0;
-  AliAODTrack *aodEtrack = 0x0;
   Double_t phiTrack = 0., etaTrack = 0., dist2Clust = 0., dist2Cone1 = 0., dist2Cone2 = 0.;
   Int_t iTracksCone = 0;
 
-  while((eTrack = static_cast<AliVTrack*>(tracksAna->GetNextAcceptParticle()))){
-    if(!eTrack){
-      AliError(Form("No tracks in collection"));
-      continue;
-    }
-
-    if(!fIsEsd){
-      aodEtrack = static_cast<AliAODTrack*>(eTrack);
-      if(!(aodEtrack->IsHybridGlobalConstrainedGlobal()))
-        continue;
-    }
-
-    if((eTrack->Pt())<0.2)
-      continue;
-
-    if((eTrack->GetStatus() & AliAODTrack::kITSrefit) != AliAODTrack::kITSrefit)
-      continue;
-
-    if(!fIsEsd){
-      Double_t frac = 0.;
-      Float_t ncls  = Float_t(aodEtrack->GetTPCncls ());
-      Float_t nclsS = Float_t(aodEtrack->GetTPCnclsS());
-      if(ncls> 0)  frac =  nclsS / ncls ;
-
-      if(frac > 0.4) continue;
-    }
-
-    phiTrack = eTrack->Phi();
-    etaTrack = eTrack->Eta();
+  for(UInt_t itrack = 0; itrack < fIsoTrackPt.size(); itrack++){
+    phiTrack = fIsoTrackPhi[itrack];
+    etaTrack = fIsoTrackEta[itrack];
     dist2Clust = TMath::Sqrt(TMath::Power(etaTrack-etaClus, 2)+TMath::Power(phiTrack-phiClus, 2));
 
     if(dist2Clust<fIsoConeRadius){ // The track is inside the isolation cone -> add the track pT to pT_iso
-      sumpTConeCharged += eTrack->Pt();
+      sumpTConeCharged += fIsoTrackPt[itrack];
       if(fIsMC){
-        int tracklabel = TMath::Abs(eTrack->GetLabel());
+        int tracklabel = fIsoTrackLabel[itrack];
         AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
         if(fWho==1)
-          fTrackResolutionPtMC->Fill(eTrack->Pt(), pMC->Pt() - eTrack->Pt());
+          fTrackResolutionPtMC->Fill(fIsoTrackPt[itrack], pMC->Pt() - fIsoTrackPt[itrack]);
       }
       iTracksCone++;
     }
@@ -2750,7 +2602,7 @@ void AliAnalysisTaskEMCALPhotonIsolation::PtIsoTrackOrthCones(TLorentzVector c,
 
         // The track is inside one of the two orthogonal cones -> add the track pT to pT_UE
       if((dist2Cone1 < fIsoConeRadius) || (dist2Cone2 < fIsoConeRadius))
-        sumpTPerpConeTrack += eTrack->Pt();
+        sumpTPerpConeTrack += fIsoTrackPt[itrack];
     }
   }
   // if(fWho==2 && !fLightOutput){
@@ -2769,17 +2621,70 @@ void AliAnalysisTaskEMCALPhotonIsolation::PtIsoTrackFullTPC(TLorentzVector c, Do
 
   Double_t sumpTConeCharged = 0., sumpTTPCexceptB2B = 0.;
 
+  // Tracks passing the isolation track selection, filled once per event
+  if(!FillIsoTracks())
+    return;
+
+  Double_t phiTrack = 0., etaTrack = 0., radius = 0., dphiUp = 0., dphiDown = 0.;
+  Int_t iTracksCone = 0;
+
+  for(UInt_t itrack = 0; itrack < fIsoTrackPt.size(); itrack++){
+    phiTrack = fIsoTrackPhi[itrack];
+    etaTrack = fIsoTrackEta[itrack];
+
+    radius = TMath::Sqrt(TMath::Power(phiTrack-c.Phi(),2)+TMath::Power(etaTrack-c.Eta(),2)); // Define the radius between the leading cluster and the considered track
+
+    if(radius > fIsoConeRadius){                                                             // The track is outside the isolation cone -> add the track pT to pT_UE
+      dphiUp = c.Phi() + TMath::Pi() - fIsoConeRadius;
+      dphiDown = c.Phi() + TMath::Pi() + fIsoConeRadius;
+
+      if(phiTrack < dphiDown && phiTrack> dphiUp)
+        sumpTTPCexceptB2B += fIsoTrackPt[itrack];
+    }
+    else{                                                                                         // The track is inside the isolation cone -> add the track pT to pT_iso
+      sumpTConeCharged += fIsoTrackPt[itrack];
+      if(fIsMC){
+        int tracklabel = fIsoTrackLabel[itrack];
+        AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
+        if(fWho==1)
+          fTrackResolutionPtMC->Fill(fIsoTrackPt[itrack], pMC->Pt() - fIsoTrackPt[itrack]);
+      }
+      iTracksCone++;
+    }
+  }
+
+  // if(fWho==2 && !fLightOutput){
+  //   fTrackMultvsSumChargedvsUE->Fill(iTracksCone,sumpTConeCharged, sumpTTPCexceptB2B);
+  //   fTrackMultvsPt->Fill(iTracksCone,c.Pt());
+  // }
+
+  ptIso = sumpTConeCharged;
+  full = sumpTTPCexceptB2B;
+}
+
+  //__________________________________________________________________________
+Bool_t AliAnalysisTaskEMCALPhotonIsolation::FillIsoTracks(){
+
+    // Fill once per event the kinematics of the tracks passing the isolation track
+    // selection, shared by all the candidates and all the cone and UE band methods
+
+  if(fIsoTracksFilled)
+    return kTRUE;
+
   AliTrackContainer *tracksAna = GetTrackContainer("filterTracksAna");
   if(!tracksAna){
     AliError(Form("Could not retrieve tracks !"));
-    return;
+    return kFALSE;
   }
 
+  fIsoTrackPt.clear();
+  fIsoTrackEta.clear();
+  fIsoTrackPhi.clear();
+  fIsoTrackLabel.clear();
+
   tracksAna->ResetCurrentID();
 
   AliVTrack *eTrack = 0x0;
-  Double_t phiTrack = 0., etaTrack = 0., radius = 0., dphiUp = 0., dphiDown = 0.;
-  Int_t iTracksCone = 0;
   AliAODTrack *aodEtrack = 0x0;
 
   while((eTrack = static_cast<AliVTrack*>(tracksAna->GetNextAcceptParticle()))){
@@ -2806,40 +2711,18 @@ void AliAnalysisTaskEMCALPhotonIsolation::PtIsoTrackFullTPC(TLorentzVector c, Do
       Float_t nclsS = Float_t(aodEtrack->GetTPCnclsS());
       if(ncls> 0)  frac =  nclsS / ncls ;
 
-      if(frac > 0.4) continue;
+      if(frac > 0.4)
+        continue;
     }
 
-    phiTrack = eTrack->Phi();
-    etaTrack = eTrack->Eta();
-
-    radius = TMath::Sqrt(TMath::Power(phiTrack-c.Phi(),2)+TMath::Power(etaTrack-c.Eta(),2)); // Define the radius between the leading cluster and the considered track
-
-    if(radius > fIsoConeRadius){                                                             // The track is outside the isolation cone -> add the track pT to pT_UE
-      dphiUp = c.Phi() + TMath::Pi() - fIsoConeRadius;
-      dphiDown = c.Phi() + TMath::Pi() + fIsoConeRadius;
-
-      if(phiTrack < dphiDown && phiTrack> dphiUp)
-        sumpTTPCexceptB2B += eTrack->Pt();
-    }
-    else{                                                                                         // The track is inside the isolation cone -> add the track pT to pT_iso
-      sumpTConeCharged += eTrack->Pt();
-      if(fIsMC){
-        int tracklabel = TMath::Abs(eTrack->GetLabel());
-        AliAODMCParticle *pMC = static_cast<AliAODMCParticle*>(fAODMCParticles->At(tracklabel));
-        if(fWho==1)
-          fTrackResolutionPtMC->Fill(eTrack->Pt(), pMC->Pt() - eTrack->Pt());
-      }
-      iTracksCone++;
-    }
+    fIsoTrackPt.push_back(eTrack->Pt());
+    fIsoTrackEta.push_back(eTrack->Eta());
+    fIsoTrackPhi.push_back(eTrack->Phi());
+    fIsoTrackLabel.push_back(TMath::Abs(eTrack->GetLabel()));
   }
 
-  // if(fWho==2 && !fLightOutput){
-  //   fTrackMultvsSumChargedvsUE->Fill(iTracksCone,sumpTConeCharged, sumpTTPCexceptB2B);
-  //   fTrackMultvsPt->Fill(iTracksCone,c.Pt());
-  // }
-
-  ptIso = sumpTConeCharged;
-  full = sumpTTPCexceptB2B;
+  fIsoTracksFilled = kTRUE;
+  return kTRUE;
 }
 
   //__________________________________________________________________________
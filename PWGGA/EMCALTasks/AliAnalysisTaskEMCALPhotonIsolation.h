@@ -132,6 +132,7 @@ class AliAnalysisTaskEMCALPhotonIsolation: public AliAnalysisTaskEmcal {
   void                         PtIsoTrackEtaBand     ( TLorentzVector c, Double_t &ptIso, Double_t &etaBand );              // PIsoCone via Track UE via EtaBand TPC
   void                         PtIsoTrackOrthCones   ( TLorentzVector c, Double_t &ptIso, Double_t &cones );                // PIsoCone via Tracks UE via Orthogonal Cones in Phi
   void                         PtIsoTrackFullTPC     ( TLorentzVector c, Double_t &ptIso, Double_t &full );                 // PIsoCone via Tracks UE via FullTPC - IsoCone - B2BEtaBand
+  Bool_t                       FillIsoTracks         ( );                                                                   // Tracks for the isolation, once per event
   void                         ComputeConeArea       ( TLorentzVector c, Double_t &coneArea );                              // Isolation cone area depending on the cluster position
   void                         ComputeEtaBandArea    ( TLorentzVector c, Double_t &etaBandArea_InclCone );                  // Eta-band area depending on the cluster position
   void                         ApplySmearing         ( AliVCluster * coi, Double_t &m02COI );                               // Applying smearing on MC
@@ -356,6 +357,11 @@ class AliAnalysisTaskEMCALPhotonIsolation: public AliAnalysisTaskEmcal {
   TH1F                       * fnPUevents;                      //!<!
   Bool_t                       f2012EGA;                        // Analyze only Events with EGA recalc patches above threshold
   Int_t                        fAbsIDNLM[2];                    //!<!
+  std::vector<Double_t>        fIsoTrackPt;                     //!<! pT of the selected tracks for the isolation in the event
+  std::vector<Double_t>        fIsoTrackEta;                    //!<! eta of the selected tracks for the isolation in the event
+  std::vector<Double_t>        fIsoTrackPhi;                    //!<! phi of the selected tracks for the isolation in the event
+  std::vector<Int_t>           fIsoTrackLabel;                  //!<! MC label (absolute value) of the selected tracks for the isolation in the event
+  Bool_t                       fIsoTracksFilled;                //!<! selected tracks for the isolation filled for the event
   // TH1                        * fPDGM02;                         //!<! check for zeroM02 clusters
   // TH2                        * fEtrueEclustM02;                 //!<! check for zeroM02 clusters
   // TH2                        * fDphiDetaM02;                    //!<! check for zeroM02 clusters
@@ -373,7 +379,7 @@ class AliAnalysisTaskEMCALPhotonIsolation: public AliAnalysisTaskEmcal {
   AliAnalysisTaskEMCALPhotonIsolation&operator = ( const AliAnalysisTaskEMCALPhotonIsolation & ); // Not implemented
   
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEMCALPhotonIsolation, 22);            // EMCal neutrals base analysis task
+  ClassDef(AliAnalysisTaskEMCALPhotonIsolation, 23);            // EMCal neutrals base analysis task
   /// \endcond
 };
 #endif
@@ -360,7 +360,14 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fDoInvMassShowerShapeTree(kFALSE),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL),
-  fAllowOverlapHeaders(kTRUE)
+  fAllowOverlapHeaders(kTRUE),
+  fUseSharedCandidatePool(kFALSE),
+  fPoolLeader(),
+  fPoolSharedBackground(),
+  fPoolClusters(),
+  fPoolGammaBits(),
+  fPoolNGammas(),
+  fPoolEventBits(0)
 {
 
 }
@@ -665,7 +672,14 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fDoInvMassShowerShapeTree(kFALSE),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL),
-  fAllowOverlapHeaders(kTRUE)
+  fAllowOverlapHeaders(kTRUE),
+  fUseSharedCandidatePool(kFALSE),
+  fPoolLeader(),
+  fPoolSharedBackground(),
+  fPoolClusters(),
+  fPoolGammaBits(),
+  fPoolNGammas(),
+  fPoolEventBits(0)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -697,6 +711,8 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete[] fBGClusHandlerRP;
     fBGClusHandlerRP = 0x0;
   }
+  for(UInt_t i = 0; i<fPoolClusters.size(); i++) delete fPoolClusters[i];
+  fPoolClusters.clear();
 }
 //___________________________________________________________
 void AliAnalysisTaskGammaConvCalo::InitBack(){
@@ -2290,6 +2306,9 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
     if (fV0Reader->GetV0FindingEfficiencyHistograms())
       fOutputContainer->Add(fV0Reader->GetV0FindingEfficiencyHistograms());
 
+  if(fV0Reader && fV0Reader->GetUseAnalyticPreselection() && fV0Reader->GetPreselectionHistograms())
+    fOutputContainer->Add(fV0Reader->GetPreselectionHistograms());
+
   for(Int_t iMatcherTask = 0; iMatcherTask < 3; iMatcherTask++){
     AliCaloTrackMatcher* temp = (AliCaloTrackMatcher*) (AliAnalysisManager::GetAnalysisManager()->GetTask(Form("CaloTrackMatcher_%i",iMatcherTask)));
     if(temp) fOutputContainer->Add(temp->GetCaloTrackMatcherHistograms());
@@ -2330,6 +2349,7 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
     fOutputContainer->Add(tBrokenFiles);
   }
 
+  InitCandidatePool();
 
   PostData(1, fOutputContainer);
 }
@@ -2413,6 +2433,11 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
     fV0Reader->RelabelAODs(kTRUE);
   }
 
+  if(fUseSharedCandidatePool){
+    fPoolGammaBits.assign(fReaderGammas->GetEntriesFast(),0);
+    fPoolEventBits = 0;
+  }
+
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
 
     fiCut = iCut;
@@ -2525,7 +2550,9 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
 
     fHistoNGammaCandidates[iCut]->Fill(fGammaCandidates->GetEntries(),fWeightJetJetMC);
     if(!fDoLightOutput) fHistoNGoodESDTracksVsNGammaCandidates[iCut]->Fill(fV0Reader->GetNumberOfPrimaryTracks(),fGammaCandidates->GetEntries(),fWeightJetJetMC);
-    if(fDoMesonAnalysis){ // Meson Analysis
+    if(fDoMesonAnalysis && fUseSharedCandidatePool && fPoolLeader[iCut] >= 0){
+      AddToCandidatePool(); // meson candidates are built once per group after the cut loop
+    } else if(fDoMesonAnalysis){ // Meson Analysis
       if(((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseMCPSmearing() && fIsMC>0){
         fUnsmearedPx = new Double_t[fGammaCandidates->GetEntries()]; // Store unsmeared Momenta
         fUnsmearedPy = new Double_t[fGammaCandidates->GetEntries()];
@@ -2597,6 +2624,14 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
     fClusterCandidates->Clear(); // delete cluster candidates
   }
 
+  if(fUseSharedCandidatePool){
+    for(Int_t iCut = 0; iCut<fnCuts; iCut++){
+      if(fPoolLeader[iCut] != iCut) continue;
+      CalculatePooledPi0Candidates(iCut);
+      fPoolClusters[iCut]->Clear();
+    }
+  }
+
   if(fIsMC>0 && fInputEvent->IsA()==AliAODEvent::Class() && !(fV0Reader->AreAODsRelabeled())){
     RelabelAODPhotonCandidates(kFALSE); // Back to ESDMC Label
     fV0Reader->RelabelAODs(kFALSE);
@@ -4936,6 +4971,258 @@ void AliAnalysisTaskGammaConvCalo::UpdateEventByEventData(){
 }
 
 
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::InitCandidatePool(){
+  // group the cuts which have the same event, cluster and meson cut and differ only in the
+  // conversion photon cut: they share the cluster candidates and the pairs are built once
+  fPoolLeader.assign(fnCuts,-1);
+  fPoolSharedBackground.assign(fnCuts,kFALSE);
+  fPoolNGammas.assign(fnCuts,0);
+  for(UInt_t i = 0; i<fPoolClusters.size(); i++) delete fPoolClusters[i];
+  fPoolClusters.assign(fnCuts,(TList*)NULL);
+  if(!fUseSharedCandidatePool || !fDoMesonAnalysis) return;
+
+  if(fIsMC > 0 || fDoConvGammaShowerShapeTree || fDoInvMassShowerShapeTree || fnCuts > 64){
+    AliWarning("shared candidate pool is only available for data without shower shape trees and up to 64 cuts, analysing cut by cut");
+    fUseSharedCandidatePool = kFALSE;
+    return;
+  }
+
+  for(Int_t iCut = 1; iCut<fnCuts; iCut++){
+    TString eventCut    = ((AliConvEventCuts*)fEventCutArray->At(iCut))->GetCutNumber();
+    TString clusterCut  = ((AliCaloPhotonCuts*)fClusterCutArray->At(iCut))->GetCutNumber();
+    TString mesonCut    = ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->GetCutNumber();
+    for(Int_t jCut = 0; jCut<iCut; jCut++){
+      if(fPoolLeader[jCut] >= 0 && fPoolLeader[jCut] != jCut) continue;
+      if(eventCut.CompareTo(((AliConvEventCuts*)fEventCutArray->At(jCut))->GetCutNumber()) != 0) continue;
+      if(clusterCut.CompareTo(((AliCaloPhotonCuts*)fClusterCutArray->At(jCut))->GetCutNumber()) != 0) continue;
+      if(mesonCut.CompareTo(((AliConversionMesonCuts*)fMesonCutArray->At(jCut))->GetCutNumber()) != 0) continue;
+      fPoolLeader[jCut] = jCut;
+      fPoolLeader[iCut] = jCut;
+      break;
+    }
+  }
+
+  for(Int_t iCut = 0; iCut<fnCuts; iCut++){
+    if(fPoolLeader[iCut] != iCut) continue;
+    fPoolClusters[iCut] = new TList();
+    fPoolClusters[iCut]->SetOwner(kTRUE);
+    // the cluster pool for the mixed events can be shared if it does not depend on the photon cut
+    AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(iCut);
+    Bool_t shared = mesonCuts->DoBGCalculation() && mesonCuts->BackgroundHandlerType() == 0 && mesonCuts->UseTrackMultiplicity();
+    for(Int_t jCut = iCut; jCut<fnCuts && shared; jCut++){
+      if(fPoolLeader[jCut] == iCut && ((AliConversionPhotonCuts*)fCutArray->At(jCut))->GetInPlaneOutOfPlaneCut() != 0) shared = kFALSE;
+    }
+    fPoolSharedBackground[iCut] = shared;
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::AddToCandidatePool(){
+  // register the photon candidates of the current cut in the pool of its group
+  Int_t leader = fPoolLeader[fiCut];
+
+  if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+    if(fPoolSharedBackground[leader]){
+      // the cluster pool is filled once for the group in CalculatePooledPi0Candidates
+      if(fGammaCandidates->GetEntries() > 0)
+        fBGHandler[fiCut]->AddEvent(fGammaCandidates,fInputEvent->GetPrimaryVertex()->GetX(),fInputEvent->GetPrimaryVertex()->GetY(),fInputEvent->GetPrimaryVertex()->GetZ(),fV0Reader->GetNumberOfPrimaryTracks(),fEventPlaneAngle);
+    } else if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+      CalculateBackground(); // Combinatorial Background
+      UpdateEventByEventData(); // Store Event for mixed Events
+    } else {
+      CalculateBackgroundRP(); // Combinatorial Background
+      fBGHandlerRP[fiCut]->AddEvent(fGammaCandidates,fInputEvent); // Store Event for mixed Events
+      fBGClusHandlerRP[fiCut]->AddEvent(fClusterCandidates,fInputEvent); // Store Event for mixed Events
+    }
+  }
+
+  // the cluster candidates are the same for all cuts of the group, keep those of the first one
+  Bool_t firstInGroup = kTRUE;
+  for(Int_t iCut = leader; iCut<fiCut; iCut++){
+    if(fPoolLeader[iCut] == leader && (fPoolEventBits & (1ULL<<iCut))) firstInGroup = kFALSE;
+  }
+  if(firstInGroup){
+    TList *clusters = fPoolClusters[leader];
+    fPoolClusters[leader] = fClusterCandidates;
+    fClusterCandidates = clusters;
+  }
+
+  fPoolEventBits |= (1ULL<<fiCut);
+  fPoolNGammas[fiCut] = fGammaCandidates->GetEntries();
+  for(Int_t i = 0; i<fGammaCandidates->GetEntries(); i++){
+    Int_t index = fReaderGammas->IndexOf(fGammaCandidates->At(i));
+    if(index >= 0) fPoolGammaBits[index] |= (1ULL<<fiCut);
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::CalculatePooledPi0Candidates(Int_t leader){
+  // combine the union of the conversion photons of the group with its clusters once and
+  // fill the pair into all cuts for which the conversion photon is a candidate
+  ULong64_t groupBits = 0;
+  for(Int_t iCut = leader; iCut<fnCuts; iCut++){
+    if(fPoolLeader[iCut] == leader) groupBits |= (1ULL<<iCut);
+  }
+  groupBits &= fPoolEventBits;
+  if(!groupBits) return;
+
+  // cluster and meson cuts are the same for all cuts of the group
+  fiCut = leader;
+  AliCaloPhotonCuts *clusterCuts      = (AliCaloPhotonCuts*)fClusterCutArray->At(leader);
+  AliConversionMesonCuts *mesonCuts   = (AliConversionMesonCuts*)fMesonCutArray->At(leader);
+  Double_t etaShift                   = ((AliConvEventCuts*)fEventCutArray->At(leader))->GetEtaShift();
+  TList *clusters                     = fPoolClusters[leader];
+
+  for(Int_t firstGammaIndex=0;firstGammaIndex<fReaderGammas->GetEntriesFast();firstGammaIndex++){
+    ULong64_t bits = fPoolGammaBits[firstGammaIndex] & groupBits;
+    if(!bits) continue;
+    AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fReaderGammas->At(firstGammaIndex));
+    if (gamma0==NULL) continue;
+
+    for(Int_t secondGammaIndex=0;secondGammaIndex<clusters->GetEntries();secondGammaIndex++){
+      Bool_t matched = kFALSE;
+      AliAODConversionPhoton *gamma1=dynamic_cast<AliAODConversionPhoton*>(clusters->At(secondGammaIndex));
+      if (gamma1==NULL) continue;
+
+      if (gamma1->GetIsCaloPhoton()){
+        AliVCluster* cluster = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef());
+        matched = clusterCuts->MatchConvPhotonToCluster(gamma0,cluster, fInputEvent, fWeightJetJetMC);
+      }
+
+      AliAODConversionMother pi0cand(gamma0,gamma1);
+      pi0cand.SetLabels(firstGammaIndex,secondGammaIndex);
+      if(!mesonCuts->MesonIsSelected(&pi0cand,kTRUE,etaShift)) continue;
+
+      for(Int_t iCut = leader; iCut<fnCuts; iCut++){
+        if(!(bits & (1ULL<<iCut))) continue;
+        fiCut = iCut;
+        FillPooledPi0Candidate(&pi0cand,gamma0,gamma1,matched);
+      }
+      fiCut = leader;
+    }
+  }
+
+  if(fPoolSharedBackground[leader]){
+    CalculatePooledBackground(leader);
+    // store the clusters once for the group, if at least one cut had a photon candidate
+    Bool_t hasGamma = kFALSE;
+    for(UInt_t i = 0; i<fPoolGammaBits.size() && !hasGamma; i++) hasGamma = (fPoolGammaBits[i] & groupBits) != 0;
+    if(hasGamma)
+      fBGClusHandler[leader]->AddEvent(clusters,fInputEvent->GetPrimaryVertex()->GetX(),fInputEvent->GetPrimaryVertex()->GetY(),fInputEvent->GetPrimaryVertex()->GetZ(),fV0Reader->GetNumberOfPrimaryTracks(),fEventPlaneAngle);
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::FillPooledPi0Candidate(AliAODConversionMother *pi0cand, AliAODConversionPhoton *gamma0, AliAODConversionPhoton *gamma1, Bool_t matched){
+  // fill the histograms of cut fiCut for a pair of the shared candidate pool
+  if (matched){
+    if(!fDoLightOutput) fHistoMotherMatchedInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+    return;
+  }
+  fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+
+  if(!fDoLightOutput){
+    fHistoPhotonPairPtconv[fiCut]->Fill(pi0cand->M(),gamma0->Pt(),fWeightJetJetMC);
+    if(TMath::Abs(pi0cand->GetAlpha())<0.1)
+      fHistoMotherInvMassPtAlpha[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+  }
+
+  if (fDoMesonQA > 0){
+    if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+      fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fWeightJetJetMC);
+      fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetAlpha(),fWeightJetJetMC);
+      fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),fWeightJetJetMC);
+      fHistoMotherPi0ConvPhotonEtaPhi[fiCut]->Fill(gamma0->GetPhotonPhi(), gamma0->GetPhotonEta(),fWeightJetJetMC);
+    }
+    if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+      fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fWeightJetJetMC);
+      fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetAlpha(),fWeightJetJetMC);
+      fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),fWeightJetJetMC);
+      fHistoMotherEtaConvPhotonEtaPhi[fiCut]->Fill(gamma0->GetPhotonPhi(), gamma0->GetPhotonEta(),fWeightJetJetMC);
+    }
+  }
+
+  if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+    Int_t zbin = 0;
+    Int_t mbin = 0;
+    if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+      zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+      if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+        mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+      }else {
+        mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fPoolNGammas[fiCut]);
+      }
+    }else{
+      zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+      if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+        mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+      }else {
+        mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fPoolNGammas[fiCut]);
+      }
+    }
+    Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
+    fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
+  }
+
+  if (!fDoLightOutput){
+    fHistoMotherInvMassECalib[fiCut]->Fill(pi0cand->M(),gamma1->E(),fWeightJetJetMC);
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskGammaConvCalo::CalculatePooledBackground(Int_t leader){
+  // mix the union of the conversion photons of the group with the shared cluster pool,
+  // only used with track multiplicity bins, so that the pool does not depend on the photon cut
+  ULong64_t groupBits = 0;
+  for(Int_t iCut = leader; iCut<fnCuts; iCut++){
+    if(fPoolLeader[iCut] == leader) groupBits |= (1ULL<<iCut);
+  }
+  groupBits &= fPoolEventBits;
+
+  fiCut = leader;
+  AliConversionMesonCuts *mesonCuts   = (AliConversionMesonCuts*)fMesonCutArray->At(leader);
+  Double_t etaShift                   = ((AliConvEventCuts*)fEventCutArray->At(leader))->GetEtaShift();
+  Int_t zbin = fBGClusHandler[leader]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+  Int_t mbin = fBGClusHandler[leader]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+
+  AliGammaConversionAODBGHandler::GammaConversionVertex *bgEventVertex = NULL;
+  for(Int_t nEventsInBG=0;nEventsInBG<fBGClusHandler[leader]->GetNBGEvents();nEventsInBG++){
+    AliGammaConversionAODVector *previousEventV0s = fBGClusHandler[leader]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
+    if(!previousEventV0s) continue;
+    if(fMoveParticleAccordingToVertex == kTRUE){
+      bgEventVertex = fBGClusHandler[leader]->GetBGEventVertex(zbin,mbin,nEventsInBG);
+    }
+
+    for(Int_t iCurrent=0;iCurrent<fReaderGammas->GetEntriesFast();iCurrent++){
+      ULong64_t bits = fPoolGammaBits[iCurrent] & groupBits;
+      if(!bits) continue;
+      AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fReaderGammas->At(iCurrent));
+      for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
+        AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
+        if(fMoveParticleAccordingToVertex == kTRUE && bgEventVertex){
+          MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
+        }
+
+        AliAODConversionMother backgroundCandidate(&currentEventGoodV0,&previousGoodV0);
+        backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+        if(!mesonCuts->MesonIsSelected(&backgroundCandidate,kFALSE,etaShift)) continue;
+
+        for(Int_t iCut = leader; iCut<fnCuts; iCut++){
+          if(!(bits & (1ULL<<iCut))) continue;
+          fHistoMotherBackInvMassPt[iCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
+          if(!fDoLightOutput) fHistoPhotonPairMixedEventPtconv[iCut]->Fill(backgroundCandidate.M(),currentEventGoodV0.Pt());
+          if(fDoTHnSparse){
+            Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
+            fSparseMotherBackInvMassPtZM[iCut]->Fill(sparesFill,1);
+          }
+          if(!fDoLightOutput) fHistoMotherBackInvMassECalib[iCut]->Fill(backgroundCandidate.M(),currentEventGoodV0.E(),fWeightJetJetMC);
+        }
+      }
+    }
+  }
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskGammaConvCalo::FillPhotonCombinatorialBackgroundHist(AliAODConversionPhoton *TruePhotonCandidate, Int_t pdgCode[])
 {
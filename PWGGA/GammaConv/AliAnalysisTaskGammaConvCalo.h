@@ -76,6 +76,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     void SetDoTreeConvGammaShowerShape  ( Bool_t flag )                                     { fDoConvGammaShowerShapeTree = flag          ;}
     void SetDoTreeInvMassShowerShape    ( Bool_t flag )                                     { fDoInvMassShowerShapeTree = flag            ;}
     void SetAllowOverlapHeaders         ( Bool_t allowOverlapHeader )                       { fAllowOverlapHeaders = allowOverlapHeader   ;}
+    void SetUseSharedCandidatePool      ( Bool_t flag )                                     { fUseSharedCandidatePool = flag              ;}
 
     // Setting the cut lists for the conversion photons
     void SetEventCutList                ( Int_t nCuts,
@@ -119,6 +120,16 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
                                                   const AliGammaConversionAODBGHandler::GammaConversionVertex *vertex);
     void UpdateEventByEventData         ();
 
+    // shared meson candidates for cuts which differ only in the conversion photon cut
+    void InitCandidatePool              ();
+    void AddToCandidatePool             ();
+    void CalculatePooledPi0Candidates   ( Int_t leader );
+    void CalculatePooledBackground      ( Int_t leader );
+    void FillPooledPi0Candidate         ( AliAODConversionMother *pi0cand,
+                                          AliAODConversionPhoton *gamma0,
+                                          AliAODConversionPhoton *gamma1,
+                                          Bool_t matched );
+
     // Additional functions for convenience
     void SetLogBinningXTH2              ( TH2* histoRebin );
     Int_t GetSourceClassification       (Int_t daughter,
@@ -476,12 +487,19 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     TTree*                  tBrokenFiles;                                       // tree for keeping track of broken files
     TObjString*             fFileNameBroken;                                    // string object for broken file name
     Bool_t                  fAllowOverlapHeaders;                               // enable overlapping headers for cluster selection
+    Bool_t                  fUseSharedCandidatePool;                            // build the meson candidates once for cuts differing only in the conversion photon cut
+    vector<Int_t>           fPoolLeader;                                        //! first cut of the pool group of each cut, -1 if the cut is not pooled
+    vector<Bool_t>          fPoolSharedBackground;                              //! mixed event pool shared by the group (indexed by leader)
+    vector<TList*>          fPoolClusters;                                      //! cluster candidates of the group in the current event (indexed by leader)
+    vector<ULong64_t>       fPoolGammaBits;                                     //! bit iCut set if the reader gamma is a candidate of cut iCut
+    vector<Int_t>           fPoolNGammas;                                       //! number of photon candidates of each cut in the current event
+    ULong64_t               fPoolEventBits;                                     //! bit iCut set if cut iCut added the current event to the pool
 
   private:
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 41);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 42);
 };
 
 #endif
@@ -259,6 +259,7 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fIsFromSelectedHeader(kTRUE),
   fIsMC(0),
   fDoTHnSparse(kTRUE),
+  fBGPoolMemoryBudget(0),
   fWeightJetJetMC(1),
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
@@ -469,6 +470,7 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fIsFromSelectedHeader(kTRUE),
   fIsMC(0),
   fDoTHnSparse(kTRUE),
+  fBGPoolMemoryBudget(0),
   fWeightJetJetMC(1),
   fWeightCentrality(NULL),
   fEnableClusterCutsForTrigger(kFALSE),
@@ -575,6 +577,7 @@ void AliAnalysisTaskGammaConvV1::InitBack(){
                                   ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->GetNumberOfBGEvents(),
                                   ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity(),
                                   0,8,5);
+        if(fBGPoolMemoryBudget > 0) fBGHandler[iCut]->SetUseCompactPool(kTRUE,fBGPoolMemoryBudget/fnCuts);
         fBGHandlerRP[iCut] = NULL;
       } else {
         fBGHandlerRP[iCut] = new AliConversionAODBGHandlerRP(
@@ -1566,6 +1569,9 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
     if (fV0Reader->GetV0FindingEfficiencyHistograms())
       fOutputContainer->Add(fV0Reader->GetV0FindingEfficiencyHistograms());
 
+  if(fV0Reader && fV0Reader->GetUseAnalyticPreselection() && fV0Reader->GetPreselectionHistograms())
+    fOutputContainer->Add(fV0Reader->GetPreselectionHistograms());
+
   if(fV0Reader && fV0Reader->GetProduceImpactParamHistograms())fOutputContainer->Add(fV0Reader->GetImpactParamHistograms());
 
   for(Int_t iCut = 0; iCut<fnCuts;iCut++){
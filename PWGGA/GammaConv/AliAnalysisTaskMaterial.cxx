@@ -27,6 +27,7 @@
 #include "AliPIDResponse.h"
 #include "AliESDtrackCuts.h"
 #include "TFile.h"
+#include "THnSparse.h"
 
 class iostream;
 
@@ -49,6 +50,9 @@ AliAnalysisTaskMaterial::AliAnalysisTaskMaterial() : AliAnalysisTaskSE(),
 	fTreeMaterialRec(NULL),
 	fTreeMaterialAllGamma(NULL),
 	fTreeMaterialConvGamma(NULL),
+	fConvPointMap(NULL),
+	fPtEfficiency(NULL),
+	fDoConvPointTree(kTRUE),
 	fPrimVtxZ(0.),
 	fNContrVtx(0),
 	fNESDtracksEta09(0),
@@ -91,6 +95,9 @@ AliAnalysisTaskMaterial::AliAnalysisTaskMaterial(const char *name) : AliAnalysis
 	fTreeMaterialRec(NULL),
 	fTreeMaterialAllGamma(NULL),
 	fTreeMaterialConvGamma(NULL),
+	fConvPointMap(NULL),
+	fPtEfficiency(NULL),
+	fDoConvPointTree(kTRUE),
 	fPrimVtxZ(0.),
 	fNContrVtx(0),
 	fNESDtracksEta09(0),
@@ -166,17 +173,29 @@ void AliAnalysisTaskMaterial::UserCreateOutputObjects()
 	fRecGammaList->SetOwner(kTRUE);
 	fOutputList->Add(fRecGammaList);
 		
-	fTreeMaterialRec = new TTree("ConvPointRec","ConvPointRec");   
-	fTreeMaterialRec->Branch("nGoodTracksEta09",&fNESDtracksEta09,"fNESDtracksEta09/I");
-	fTreeMaterialRec->Branch("recCords",&fRecCords);
-	fTreeMaterialRec->Branch("daughterProp",&fDaughterProp);
-	fTreeMaterialRec->Branch("pt",&fGammaPt,"fGammaPt/F");
-	fTreeMaterialRec->Branch("theta",&fGammaTheta,"fGammaTheta/F");
-	fTreeMaterialRec->Branch("chi2ndf",&fGammaChi2NDF,"fGammaChi2NDF/F");
-	if (fIsMC) {
-		fTreeMaterialRec->Branch("kind",&fKind,"fKind/b");
-	}   
-	fRecGammaList->Add(fTreeMaterialRec);
+	if (fDoConvPointTree){
+		fTreeMaterialRec = new TTree("ConvPointRec","ConvPointRec");   
+		fTreeMaterialRec->Branch("nGoodTracksEta09",&fNESDtracksEta09,"fNESDtracksEta09/I");
+		fTreeMaterialRec->Branch("recCords",&fRecCords);
+		fTreeMaterialRec->Branch("daughterProp",&fDaughterProp);
+		fTreeMaterialRec->Branch("pt",&fGammaPt,"fGammaPt/F");
+		fTreeMaterialRec->Branch("theta",&fGammaTheta,"fGammaTheta/F");
+		fTreeMaterialRec->Branch("chi2ndf",&fGammaChi2NDF,"fGammaChi2NDF/F");
+		if (fIsMC) {
+			fTreeMaterialRec->Branch("kind",&fKind,"fKind/b");
+		}   
+		fRecGammaList->Add(fTreeMaterialRec);
+	}
+
+	// conversion point map, from which the material maps are projected
+	// (see ProjectConversionPointMap) without re-reading the tree
+	Int_t nBinsMap[kNMapAxes]	= {360, 360, 360, 100, 28, 16};
+	Double_t minMap[kNMapAxes]	= {0., 0., -180., 0., -1.4, -0.5};
+	Double_t maxMap[kNMapAxes]	= {180., TMath::TwoPi(), 180., 10., 1.4, 15.5};
+	fConvPointMap = new THnSparseF("ConvPointMap","ConvPointMap;R (cm);#varphi_{conv};Z (cm);p_{T} (GeV/c);#eta;kind",
+								   kNMapAxes, nBinsMap, minMap, maxMap);
+	fConvPointMap->Sumw2();
+	fRecGammaList->Add(fConvPointMap);
 	
 // 	if (fIsMC) {
 // 		fAllMCGammaList = new TList();
@@ -448,9 +467,44 @@ void AliAnalysisTaskMaterial::ProcessPhotons(){
 		if (fTreeMaterialRec){
 			fTreeMaterialRec->Fill();
 		}
+		if (fConvPointMap){
+			Double_t weight = 1.;
+			if (fPtEfficiency){
+				Double_t efficiency = fPtEfficiency->GetBinContent(fPtEfficiency->FindBin(fGammaPt));
+				weight = (efficiency > 0.) ? 1./efficiency : 0.;
+			}
+			Double_t phiConv = TMath::ATan2(fRecCords(1),fRecCords(0));
+			if (phiConv < 0.) phiConv += TMath::TwoPi();
+			Double_t point[kNMapAxes] = {fRecCords(3), phiConv, fRecCords(2), fGammaPt, gamma->GetPhotonEta(), (Double_t)fKind};
+			fConvPointMap->Fill(point,weight);
+		}
 	}
 }
 
+//________________________________________________________________________
+TH1* AliAnalysisTaskMaterial::ProjectConversionPointMap(THnSparse *map, Int_t axisX, Int_t axisY,
+														Double_t etaMin, Double_t etaMax,
+														Double_t ptMin, Double_t ptMax, Int_t kind){
+	// project the conversion point map on axisX (and axisY) for photons in the given eta
+	// and pt range and of the given kind; the ranges of the map are restored afterwards
+	if (!map) return NULL;
+
+	TAxis *axisEta	= map->GetAxis(kMapEta);
+	TAxis *axisPt	= map->GetAxis(kMapPt);
+	TAxis *axisKind	= map->GetAxis(kMapKind);
+	axisEta->SetRange(axisEta->FindBin(etaMin+1e-6),axisEta->FindBin(etaMax-1e-6));
+	axisPt->SetRange(axisPt->FindBin(ptMin+1e-6),axisPt->FindBin(ptMax-1e-6));
+	if (kind >= 0) axisKind->SetRange(axisKind->FindBin(kind),axisKind->FindBin(kind));
+
+	TH1* projection = NULL;
+	if (axisY < 0) projection = map->Projection(axisX,"E");
+	else projection = map->Projection(axisY,axisX,"E");
+	projection->SetDirectory(0);
+
+	for (Int_t iAxis = 0; iAxis < map->GetNdimensions(); iAxis++) map->GetAxis(iAxis)->SetRange();
+	return projection;
+}
+
 //________________________________________________________________________
 Int_t AliAnalysisTaskMaterial::CountTracks09(){
 	Int_t fNumberOfESDTracks = 0;
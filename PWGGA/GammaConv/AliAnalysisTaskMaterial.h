@@ -17,11 +17,16 @@
 
 using namespace std;
 
+class THnSparse;
+
 
 class AliAnalysisTaskMaterial : public AliAnalysisTaskSE{
 
 	public:
 
+		// axes of the conversion point map
+		enum { kMapR = 0, kMapPhi, kMapZ, kMapPt, kMapEta, kMapKind, kNMapAxes };
+
 		AliAnalysisTaskMaterial();
 		AliAnalysisTaskMaterial(const char *name);
 		virtual ~AliAnalysisTaskMaterial();
@@ -42,6 +47,15 @@ class AliAnalysisTaskMaterial : public AliAnalysisTaskSE{
 			fEventCuts=conversionCuts;
 			fIsHeavyIon = IsHeavyIon;
 		}
+		// photons enter the conversion point map with weight 1/efficiency(pt)
+		void SetPtEfficiency(TH1* efficiency){fPtEfficiency=efficiency;}
+		void SetFillConversionPointTree(Bool_t fill){fDoConvPointTree=fill;}
+
+		// material map from the conversion point map (axes kMapR,...), in the given eta, pt range and for
+		// the given MC kind (-1: all); 2D if axisY >= 0
+		static TH1* ProjectConversionPointMap(THnSparse *map, Int_t axisX, Int_t axisY = -1,
+		                                      Double_t etaMin = -1.4, Double_t etaMax = 1.4,
+		                                      Double_t ptMin = 0., Double_t ptMax = 10., Int_t kind = -1);
 		
 	private:
 		
@@ -65,6 +79,9 @@ class AliAnalysisTaskMaterial : public AliAnalysisTaskSE{
 		TTree* 						fTreeMaterialRec;			//
 		TTree* 						fTreeMaterialAllGamma;		//
 		TTree* 						fTreeMaterialConvGamma;		//
+		THnSparse* 					fConvPointMap;				// conversion points (R, phi, Z) vs pt, eta, kind
+		TH1* 						fPtEfficiency;				// efficiency vs pt for the weights of the map
+		Bool_t 						fDoConvPointTree;			// fill the conversion point tree
 		Float_t 					fPrimVtxZ;					//
 		Int_t 						fNContrVtx;					//
 		Int_t 						fNESDtracksEta09;			//
@@ -91,7 +108,7 @@ class AliAnalysisTaskMaterial : public AliAnalysisTaskSE{
 		AliAnalysisTaskMaterial& operator=(const AliAnalysisTaskMaterial&); // not implemented
 
 
-        ClassDef(AliAnalysisTaskMaterial, 3);
+        ClassDef(AliAnalysisTaskMaterial, 4);
 };
 
 #endif
@@ -2490,6 +2490,24 @@ void AliAnalysisTaskNeutralMesonToPiPlPiMiPiZero::CalculateMesonCandidates(){
 
   // Conversion Gammas
   if( fNeutralPionCandidates->GetEntries() > 0 && fGoodVirtualParticles->GetEntries() > 0 ){
+
+    // The charged pion momenta only depend on the pi+pi- pair: take them from the ESD
+    // tracks once per pair instead of once per pi0 - pi+pi- combination
+    Int_t nVirtualParticles = fGoodVirtualParticles->GetEntries();
+    std::vector<AliAODConversionMother> negPions(nVirtualParticles);
+    std::vector<AliAODConversionMother> posPions(nVirtualParticles);
+    std::vector<Bool_t> hasPions(nVirtualParticles,kFALSE);
+    for(Int_t virtualParticleIndex=0;virtualParticleIndex<nVirtualParticles;virtualParticleIndex++){
+      AliAODConversionPhoton *vParticle=dynamic_cast<AliAODConversionPhoton*>(fGoodVirtualParticles->At(virtualParticleIndex));
+      if (vParticle==NULL) continue;
+      AliESDtrack *negPionCandidatetmp = (AliESDtrack*) fESDEvent->GetTrack(vParticle->GetTrackLabel(1));
+      AliESDtrack *posPionCandidatetmp = (AliESDtrack*) fESDEvent->GetTrack(vParticle->GetTrackLabel(0));
+      if(negPionCandidatetmp==NULL || posPionCandidatetmp==NULL) continue;
+      negPions[virtualParticleIndex].SetPxPyPzE(negPionCandidatetmp->Px(), negPionCandidatetmp->Py(), negPionCandidatetmp->Pz(), negPionCandidatetmp->E());
+      posPions[virtualParticleIndex].SetPxPyPzE(posPionCandidatetmp->Px(), posPionCandidatetmp->Py(), posPionCandidatetmp->Pz(), posPionCandidatetmp->E());
+      hasPions[virtualParticleIndex] = kTRUE;
+    }
+
     for(Int_t mesonIndex=0; mesonIndex<fNeutralPionCandidates->GetEntries(); mesonIndex++){
       AliAODConversionMother *neutralPion=dynamic_cast<AliAODConversionMother*>(fNeutralPionCandidates->At(mesonIndex));
       if (neutralPion==NULL) continue;
@@ -2497,9 +2515,14 @@ void AliAnalysisTaskNeutralMesonToPiPlPiMiPiZero::CalculateMesonCandidates(){
       // cut on pT of neutralPion
       if(neutralPion->Pt() < fNeutralPionPtMin) continue;
 
-      for(Int_t virtualParticleIndex=0;virtualParticleIndex<fGoodVirtualParticles->GetEntries();virtualParticleIndex++){
+      // pi0 with pz adjusted to the PDG mass, the same for all pi+pi- pairs
+      AliAODConversionMother Pi0tmp;
+      Pi0tmp.SetPxPyPzE(neutralPion->Px(), neutralPion->Py(), neutralPion->Pz(), neutralPion->Energy());
+      FixPzToMatchPDGInvMassPi0(&Pi0tmp);
 
-                AliAODConversionPhoton *vParticle=dynamic_cast<AliAODConversionPhoton*>(fGoodVirtualParticles->At(virtualParticleIndex));
+      for(Int_t virtualParticleIndex=0;virtualParticleIndex<nVirtualParticles;virtualParticleIndex++){
+
+        AliAODConversionPhoton *vParticle=dynamic_cast<AliAODConversionPhoton*>(fGoodVirtualParticles->At(virtualParticleIndex));
         if (vParticle==NULL) continue;
         //Check for same Electron ID
 
@@ -2507,15 +2530,9 @@ void AliAnalysisTaskNeutralMesonToPiPlPiMiPiZero::CalculateMesonCandidates(){
         mesoncand->SetLabels(mesonIndex,virtualParticleIndex);
         if( ( ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(mesoncand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift())) ){
 
-          AliESDtrack *negPionCandidatetmp = (AliESDtrack*) fESDEvent->GetTrack(vParticle->GetTrackLabel(1));
-          if(negPionCandidatetmp==NULL){ delete mesoncand; continue;}
-          AliAODConversionMother *NegPiontmp = new AliAODConversionMother();
-          NegPiontmp->SetPxPyPzE(negPionCandidatetmp->Px(), negPionCandidatetmp->Py(), negPionCandidatetmp->Pz(), negPionCandidatetmp->E());
-
-          AliESDtrack *posPionCandidatetmp = (AliESDtrack*) fESDEvent->GetTrack(vParticle->GetTrackLabel(0));
-          if(posPionCandidatetmp==NULL){ delete NegPiontmp; delete mesoncand; continue;}
-          AliAODConversionMother *PosPiontmp = new AliAODConversionMother();
-          PosPiontmp->SetPxPyPzE(posPionCandidatetmp->Px(), posPionCandidatetmp->Py(), posPionCandidatetmp->Pz(), posPionCandidatetmp->E());
+          if(!hasPions[virtualParticleIndex]){ delete mesoncand; continue;}
+          AliAODConversionMother *NegPiontmp = &negPions[virtualParticleIndex];
+          AliAODConversionMother *PosPiontmp = &posPions[virtualParticleIndex];
 
           if(KinematicCut(NegPiontmp, PosPiontmp, neutralPion, mesoncand)){
               if(!fDoLightOutput){
@@ -2532,13 +2549,8 @@ void AliAnalysisTaskNeutralMesonToPiPlPiMiPiZero::CalculateMesonCandidates(){
                   //fTHnSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
               }
               fHistoMotherInvMassSubPi0[fiCut]->Fill(mesoncand->M()-neutralPion->M(),mesoncand->Pt());
-              AliAODConversionMother *Pi0tmp = new AliAODConversionMother();
-              Pi0tmp->SetPxPyPzE(neutralPion->Px(), neutralPion->Py(), neutralPion->Pz(), neutralPion->Energy());
-              FixPzToMatchPDGInvMassPi0(Pi0tmp);
-              AliAODConversionMother *mesontmp = new AliAODConversionMother(Pi0tmp,vParticle);
-              fHistoMotherInvMassFixedPzPi0[fiCut]->Fill(mesontmp->M(),mesontmp->Pt());
-              delete Pi0tmp;
-              delete mesontmp;
+              AliAODConversionMother mesontmp(&Pi0tmp,vParticle);
+              fHistoMotherInvMassFixedPzPi0[fiCut]->Fill(mesontmp.M(),mesontmp.Pt());
               fHistoMotherInvMassPt[fiCut]->Fill(mesoncand->M(),mesoncand->Pt());
             if(fMCEvent){
               ProcessTrueMesonCandidates(mesoncand,neutralPion,vParticle);
@@ -2548,10 +2560,6 @@ void AliAnalysisTaskNeutralMesonToPiPlPiMiPiZero::CalculateMesonCandidates(){
               fHistoMotherInvMassPtRejectedKinematic[fiCut]->Fill(mesoncand->M(),mesoncand->Pt());
             }
           }
-          if(!fDoLightOutput){
-            delete NegPiontmp;
-            delete PosPiontmp;
-          }
         }
         delete mesoncand;
         mesoncand=0x0;
@@ -251,7 +251,15 @@ AliCaloPhotonCuts::AliCaloPhotonCuts(Int_t isMC, const char *name,const char *ti
   fHistClusterEvsTrackEPrimaryButNoElec(NULL),
   fHistClusterEvsTrackSumEPrimaryButNoElec(NULL),
   fNMaxDCalModules(8),
-  fgkDCALCols(32)
+  fgkDCALCols(32),
+  fCellModule(),
+  fCellCol(),
+  fCellRow(),
+  fCellNeighbours(),
+  fCellDistanceToBadChannel(),
+  fDistanceMapRun(-1),
+  fNonLinearityIsMC(-1),
+  fNonLinearityIsIdentity(kFALSE)
 {
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
   fCutString=new TObjString((GetCutNumber()).Data());
@@ -423,7 +431,15 @@ AliCaloPhotonCuts::AliCaloPhotonCuts(const AliCaloPhotonCuts &ref) :
   fHistClusterEvsTrackEPrimaryButNoElec(NULL),
   fHistClusterEvsTrackSumEPrimaryButNoElec(NULL),
   fNMaxDCalModules(ref.fNMaxDCalModules),
-  fgkDCALCols(ref.fgkDCALCols)
+  fgkDCALCols(ref.fgkDCALCols),
+  fCellModule(),
+  fCellCol(),
+  fCellRow(),
+  fCellNeighbours(),
+  fCellDistanceToBadChannel(),
+  fDistanceMapRun(-1),
+  fNonLinearityIsMC(-1),
+  fNonLinearityIsIdentity(kFALSE)
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
@@ -2068,8 +2084,9 @@ Int_t AliCaloPhotonCuts::FindLargestCellInCluster(AliVCluster* cluster, AliVEven
   if (nCells < 1) return idMax;
   for (Int_t iCell = 0;iCell < nCells;iCell++){
     Int_t cellAbsID       = cluster->GetCellsAbsId()[iCell];
-    if (cells->GetCellAmplitude(cellAbsID)> eMax){
-      eMax                = cells->GetCellAmplitude(cellAbsID);
+    Float_t cellAmp       = cells->GetCellAmplitude(cellAbsID);
+    if (cellAmp > eMax){
+      eMax                = cellAmp;
       idMax               = cellAbsID;
     }
   }
@@ -2216,6 +2233,14 @@ Bool_t AliCaloPhotonCuts::AreNeighbours(Int_t absCellId1, Int_t absCellId2){
 //* derived from G. Conesa Balbastre's AliCalorimeterUtils ***************
 //************************************************************************
 Int_t AliCaloPhotonCuts::GetModuleNumberAndCellPosition(Int_t absCellId, Int_t & icol, Int_t & irow){
+  // look up the precomputed position, fall back to the geometry for cells outside the table
+  if(fCellModule.empty()) InitializeCellTables();
+  if(absCellId >= 0 && absCellId < (Int_t)fCellModule.size()){
+    icol                  = fCellCol[absCellId];
+    irow                  = fCellRow[absCellId];
+    return fCellModule[absCellId];
+  }
+
   if( fClusterType == 1 || fClusterType == 3){ //EMCAL & DCAL
     fGeomEMCAL = AliEMCALGeometry::GetInstance();
     if(!fGeomEMCAL) AliFatal("EMCal geometry not initialized!");
@@ -2238,6 +2263,124 @@ Int_t AliCaloPhotonCuts::GetModuleNumberAndCellPosition(Int_t absCellId, Int_t &
   return imod;
 }
 
+//________________________________________________________________________
+//************** Precompute module, row and column of all cells **********
+//* and the neighbour table of the EMCal/DCal cells                      *
+//************************************************************************
+void AliCaloPhotonCuts::InitializeCellTables(){
+  Int_t nCells = 0;
+  if( fClusterType == 1 || fClusterType == 3){ //EMCAL & DCAL
+    fGeomEMCAL = AliEMCALGeometry::GetInstance();
+    if(!fGeomEMCAL) AliFatal("EMCal geometry not initialized!");
+    nCells = fGeomEMCAL->GetNCells();
+  } else if( fClusterType == 2 ){ //PHOS
+    fGeomPHOS = AliPHOSGeometry::GetInstance();
+    if(!fGeomPHOS) AliFatal("PHOS geometry not initialized!");
+    nCells = fNMaxPHOSModules*56*64+1;
+  } else return;
+
+  fCellModule.assign(nCells,-1);
+  fCellCol.assign(nCells,-1);
+  fCellRow.assign(nCells,-1);
+  for(Int_t iCell = 0;iCell < nCells;iCell++){
+    Int_t imod = -1;Int_t iTower = -1, iIphi = -1, iIeta = -1;
+    Int_t icol = -1;Int_t irow = -1;
+    if( fClusterType == 1 || fClusterType == 3){
+      fGeomEMCAL->GetCellIndex(iCell,imod,iTower,iIphi,iIeta);
+      fGeomEMCAL->GetCellPhiEtaIndexInSModule(imod,iTower,iIphi,iIeta,irow,icol);
+    } else {
+      Int_t relId[4];
+      fGeomPHOS->AbsToRelNumbering(iCell,relId);
+      irow                = relId[2];
+      icol                = relId[3];
+      imod                = relId[0]-1;
+    }
+    fCellModule[iCell]    = imod;
+    fCellCol[iCell]       = icol;
+    fCellRow[iCell]       = irow;
+  }
+
+  // neighbour table only needed for the distance to bad channel, not implemented for PHOS
+  fCellNeighbours.clear();
+  if(fClusterType == 2) return;
+
+  const Int_t nCols       = AliEMCALGeoParams::fgkEMCALCols;
+  const Int_t nRows       = AliEMCALGeoParams::fgkEMCALRows;
+  const Int_t nModules    = fGeomEMCAL->GetNumberOfSuperModules();
+  std::vector<Int_t> cellAt(nModules*nRows*nCols,-1);
+  for(Int_t iCell = 0;iCell < nCells;iCell++){
+    Int_t imod = fCellModule[iCell], icol = fCellCol[iCell], irow = fCellRow[iCell];
+    if(imod < 0 || imod >= nModules || icol < 0 || icol >= nCols || irow < 0 || irow >= nRows) continue;
+    cellAt[(imod*nRows+irow)*nCols+icol] = iCell;
+  }
+
+  // edge neighbours first, then the corners
+  const Int_t dCol[8]     = { 1,-1, 0, 0, 1, 1,-1,-1};
+  const Int_t dRow[8]     = { 0, 0, 1,-1, 1,-1, 1,-1};
+  fCellNeighbours.assign(8*nCells,-1);
+  for(Int_t iCell = 0;iCell < nCells;iCell++){
+    Int_t imod = fCellModule[iCell];
+    if(imod < 0 || imod >= nModules) continue;
+    for(Int_t in = 0;in < 8;in++){
+      Int_t nmod = imod, ncol = fCellCol[iCell]+dCol[in], nrow = fCellRow[iCell]+dRow[in];
+      if(nrow < 0 || nrow >= nRows) continue;
+      // In case of a shared cluster, index of SM in C side, columns start at 48 and ends at 48*2-1
+      // C Side impair SM, nSupMod%2=1;A side pair SM nSupMod%2=0
+      if(fClusterType == 1 && imod%2 && ncol < 0){
+        nmod              = imod-1;
+        ncol             += nCols;
+      } else if(fClusterType == 1 && !(imod%2) && ncol >= nCols){
+        nmod              = imod+1;
+        ncol             -= nCols;
+      }
+      if(nmod >= nModules || ncol < 0 || ncol >= nCols) continue;
+      fCellNeighbours[8*iCell+in] = cellAt[(nmod*nRows+nrow)*nCols+ncol];
+    }
+  }
+}
+
+//________________________________________________________________________
+//************** Distance of each cell to the closest bad channel ********
+//* bounded breadth-first search from each bad channel, through edge     *
+//* neighbours (fUseDistanceToBadChannel==1) or edge and corner          *
+//* neighbours (fUseDistanceToBadChannel==2)                             *
+//************************************************************************
+void AliCaloPhotonCuts::BuildDistanceToBadChannelMap(Int_t runnumber){
+  fDistanceMapRun         = runnumber;
+  if(fCellNeighbours.empty()) InitializeCellTables();
+
+  const Int_t maxDistance = (Int_t)fMinDistanceToBadChannel;
+  const Int_t nCells      = fCellModule.size();
+  fCellDistanceToBadChannel.assign(nCells,maxDistance+1);
+  if(!fEMCALBadChannelsMap || fCellNeighbours.empty()) return;
+
+  const Int_t nNeighbours = fUseDistanceToBadChannel == 2 ? 8 : 4;
+  std::vector<Int_t> visitedFrom(nCells,-1), front, next;
+  for(Int_t iCell = 0;iCell < nCells;iCell++){
+    Int_t imod = fCellModule[iCell];
+    if(imod < 0 || imod >= fEMCALBadChannelsMap->GetEntries()) continue;
+    TH2I* badMap = (TH2I*)fEMCALBadChannelsMap->At(imod);
+    if(!badMap || (Int_t) badMap->GetBinContent(fCellCol[iCell],fCellRow[iCell]) == 0) continue;
+
+    // the bad channel itself is not counted, only the cells around it
+    visitedFrom[iCell]    = iCell;
+    front.assign(1,iCell);
+    for(Int_t distance = 1;distance <= maxDistance && !front.empty();distance++){
+      next.clear();
+      for(UInt_t ifront = 0;ifront < front.size();ifront++){
+        for(Int_t in = 0;in < nNeighbours;in++){
+          Int_t neighbour = fCellNeighbours[8*front[ifront]+in];
+          if(neighbour < 0 || visitedFrom[neighbour] == iCell) continue;
+          visitedFrom[neighbour] = iCell;
+          if(distance < fCellDistanceToBadChannel[neighbour]) fCellDistanceToBadChannel[neighbour] = distance;
+          next.push_back(neighbour);
+        }
+      }
+      front.swap(next);
+    }
+  }
+}
+
 //___________________________________________________________________________
 // Split energy of cluster between the 2 local maxima, sum energy on 3x3, and if the 2
 // maxima are too close and have common cells, split the energy between the 2.
@@ -2366,141 +2509,16 @@ Bool_t AliCaloPhotonCuts::CheckDistanceToBadChannel(AliVCluster* cluster, AliVEv
   if( (fClusterType == 1 || fClusterType == 3) && !fEMCALInitialized ) InitializeEMCAL(event);
   if( fClusterType == 2 && ( !fPHOSInitialized || (fPHOSCurrentRun != event->GetRunNumber()) ) ) InitializePHOS(event);
 
+  if(fDistanceMapRun != event->GetRunNumber()) BuildDistanceToBadChannelMap(event->GetRunNumber());
+
   Int_t largestCellID = FindLargestCellInCluster(cluster,event);
   if(largestCellID==-1) AliFatal("CheckDistanceToBadChannel: FindLargestCellInCluster found cluster with NCells<1?");
+  if(largestCellID >= (Int_t)fCellDistanceToBadChannel.size() || fCellModule[largestCellID] < 0) AliFatal("CheckDistanceToBadChannel: GetModuleNumberAndCellPosition found SM with ID<0?");
 
-  Int_t largestCellicol = -1, largestCellirow = -1;
-  Int_t rowdiff =  0, coldiff =  0;
-
-  Int_t largestCelliMod = GetModuleNumberAndCellPosition(largestCellID, largestCellicol, largestCellirow);
-  if(largestCelliMod < 0) AliFatal("CheckDistanceToBadChannel: GetModuleNumberAndCellPosition found SM with ID<0?");
-
-  Int_t nMinRows = 0, nMaxRows = 0;
-  Int_t nMinCols = 0, nMaxCols = 0;
-
-  Bool_t checkNextSM = kFALSE;
-  Int_t distanceForLoop = fMinDistanceToBadChannel+1;
-  if( fClusterType == 1 ){
-    nMinRows = largestCellirow - distanceForLoop;
-    nMaxRows = largestCellirow + distanceForLoop;
-    if(nMinRows < 0) nMinRows = 0;
-    if(nMaxRows > AliEMCALGeoParams::fgkEMCALRows) nMaxRows = AliEMCALGeoParams::fgkEMCALRows;
-
-    nMinCols = largestCellicol - distanceForLoop;
-    nMaxCols = largestCellicol + distanceForLoop;
-
-    if(largestCelliMod%2){
-      if(nMinCols < 0){
-        nMinCols = 0;
-        checkNextSM = kTRUE;
-      }
-      if(nMaxCols > AliEMCALGeoParams::fgkEMCALCols) nMaxCols = AliEMCALGeoParams::fgkEMCALCols;
-    }else{
-      if(nMinCols < 0) nMinCols = 0;
-      if(nMaxCols > AliEMCALGeoParams::fgkEMCALCols){
-        nMaxCols = AliEMCALGeoParams::fgkEMCALCols;
-        checkNextSM = kTRUE;
-      }
-    }
-  }else if( fClusterType == 3 ){
-    nMinRows = largestCellirow - distanceForLoop;
-    nMaxRows = largestCellirow + distanceForLoop;
-    if(nMinRows < 0) nMinRows = 0;
-    if(nMaxRows > AliEMCALGeoParams::fgkEMCALCols) nMaxRows = AliEMCALGeoParams::fgkEMCALCols; //AliEMCALGeoParams::fgkDCALRows; <- doesnt exist yet (DCAl = EMCAL here)
-
-    nMinCols = largestCellicol - distanceForLoop;
-    nMaxCols = largestCellicol + distanceForLoop;
-    if(nMinCols < 0) nMinCols = 0;
-    if(nMaxCols > fgkDCALCols) nMaxCols = fgkDCALCols; // AliEMCALGeoParams::fgkDCALCols; <- doesnt exist yet
-
-  }else if( fClusterType == 2 ){
-//    nMaxRows = 64;
-//    nMaxCols = 56;
-  }
-
-//  cout << "Cluster: " << fClusterType << ",checkNextSM: " << checkNextSM << endl;
-//  cout << "largestCell: " << largestCellID << ",mod: " << largestCelliMod << ",col: " << largestCellicol << ",row: " << largestCellirow << endl;
-//  cout << "distanceForLoop: " << distanceForLoop << ",nMinRows: " << nMinRows << ",nMaxRows: " << nMaxRows << ",nMinCols: " << nMinCols << ",nMaxCols: " << nMaxCols << endl;
-
-  //check bad cells within respective SM
-  for (Int_t irow = nMinRows;irow < nMaxRows;irow++)
-  {
-    for (Int_t icol = nMinCols;icol < nMaxCols;icol++)
-    {
-      if(irow == largestCellirow && icol == largestCellicol) continue;
-
-      Int_t iBadCell = 0;
-      if( (fClusterType == 1 || fClusterType == 3) && largestCelliMod<fEMCALBadChannelsMap->GetEntries()){
-        iBadCell = (Int_t) ((TH2I*)fEMCALBadChannelsMap->At(largestCelliMod))->GetBinContent(icol,irow);
-      }else if( fClusterType == 2 && fPHOSBadChannelsMap[largestCelliMod+1]){
-        iBadCell = (Int_t) ((TH2I*)fPHOSBadChannelsMap[largestCelliMod+1])->GetBinContent(icol,irow);
-      }
-      //cout << "largestCelliMod: " << largestCelliMod << ",iBadCell: " << iBadCell << ",icol: " << icol << ",irow: " << irow << endl;
-      if(iBadCell==0) continue;
-
-      rowdiff = TMath::Abs( largestCellirow - irow ) ;
-      coldiff = TMath::Abs( largestCellicol - icol ) ;
-      //cout << "rowdiff: " << rowdiff << ",coldiff: " << coldiff << endl;
-      if(fUseDistanceToBadChannel==1){
-        if ((coldiff + rowdiff <= fMinDistanceToBadChannel )) return kTRUE;
-      }else if(fUseDistanceToBadChannel==2){
-        if (( coldiff <= fMinDistanceToBadChannel )  && ( rowdiff <= fMinDistanceToBadChannel ) && (coldiff + rowdiff <= fMinDistanceToBadChannel*2)) return kTRUE;
-      }
-      //cout << "not within distanceToBadChannel!" << endl;
-    }
-  }
-
-  //check bad cells in neighboring SM only if within chosen distanceToBadChannel from maxEnergyCell the next SM could be reached
-  if(checkNextSM) {
-    // In case of a shared cluster, index of SM in C side, columns start at 48 and ends at 48*2-1
-    // C Side impair SM, nSupMod%2=1;A side pair SM nSupMod%2=0
-    if( fClusterType == 1 ){
-      if(largestCelliMod%2){
-        nMinCols = largestCellicol - distanceForLoop + AliEMCALGeoParams::fgkEMCALCols;
-        nMaxCols = AliEMCALGeoParams::fgkEMCALCols;
-
-        largestCelliMod -= 1;
-        largestCellicol += AliEMCALGeoParams::fgkEMCALCols;
-      }else{
-        nMinCols = 0;
-        nMaxCols = largestCellicol + distanceForLoop - AliEMCALGeoParams::fgkEMCALCols;
-
-        largestCelliMod += 1;
-        largestCellicol -= AliEMCALGeoParams::fgkEMCALCols;
-      }
-    }else if( fClusterType == 2 ){
-//      nMaxRows = 64;
-//      nMaxCols = 56;
-    }
-    //cout << "largestCell: " << largestCellID << ",mod: " << largestCelliMod << ",col: " << largestCellicol << ",row: " << largestCellirow << endl;
-    //cout << "distanceForLoop: " << distanceForLoop << ",nMinRows: " << nMinRows << ",nMaxRows: " << nMaxRows << ",nMinCols: " << nMinCols << ",nMaxCols: " << nMaxCols << endl;
-    for (Int_t irow = nMinRows;irow < nMaxRows;irow++)
-    {
-      for (Int_t icol = nMinCols;icol < nMaxCols;icol++)
-      {
-        Int_t iBadCell = 0;
-        if( fClusterType == 1 && largestCelliMod<fEMCALBadChannelsMap->GetEntries()){
-          iBadCell = (Int_t) ((TH2I*)fEMCALBadChannelsMap->At(largestCelliMod))->GetBinContent(icol,irow);
-        }else if( fClusterType == 2 && fPHOSBadChannelsMap[largestCelliMod+1]){
-          iBadCell = (Int_t) ((TH2I*)fPHOSBadChannelsMap[largestCelliMod+1])->GetBinContent(icol,irow);
-        }
-        //cout << "largestCelliMod: " << largestCelliMod << ",iBadCell: " << iBadCell << ",icol: " << icol << ",irow: " << irow << endl;
-        if(iBadCell==0) continue;
-
-        rowdiff = TMath::Abs( largestCellirow - irow ) ;
-        coldiff = TMath::Abs( largestCellicol - icol ) ;
-        //cout << "rowdiff: " << rowdiff << ",coldiff: " << coldiff << endl;
-        if(fUseDistanceToBadChannel==1){
-          if ((coldiff + rowdiff <= fMinDistanceToBadChannel )) return kTRUE;
-        }else if(fUseDistanceToBadChannel==2){
-          if (( coldiff <= fMinDistanceToBadChannel )  && ( rowdiff <= fMinDistanceToBadChannel ) && (coldiff + rowdiff <= fMinDistanceToBadChannel*2)) return kTRUE;
-        }
-        //cout << "not within distanceToBadChannel!" << endl;
-      }
-    }
-  }
-
-  return kFALSE;
+  // within the SM (and the neighbouring SM for EMCal), a bad channel with
+  // coldiff + rowdiff <= fMinDistanceToBadChannel for fUseDistanceToBadChannel==1,
+  // coldiff, rowdiff <= fMinDistanceToBadChannel for fUseDistanceToBadChannel==2
+  return fCellDistanceToBadChannel[largestCellID] <= fMinDistanceToBadChannel;
 }
 
 
@@ -4374,6 +4392,7 @@ Bool_t AliCaloPhotonCuts::SetNonLinearity2(Int_t nl2)
     if(nl2 == 0) fUseNonLinearity = kFALSE;
     else if(nl2 > 0) fUseNonLinearity = kTRUE;
     fSwitchNonLinearity = fNonLinearity1*10 + fNonLinearity2;
+    fNonLinearityIsMC = -1;
   }
   else{
     AliError(Form("NonLinearity Correction (part2) not defined %d",nl2));
@@ -4408,6 +4427,21 @@ void AliCaloPhotonCuts::ApplyNonLinearity(AliVCluster* cluster, Int_t isMC)
     }
   }
 
+  if(fNonLinearityIsMC != isMC) InitializeNonLinearity(isMC);
+  if(fNonLinearityIsIdentity) return;
+
+  cluster->SetE(GetNonLinearityCorrectedEnergy(energy, isMC));
+
+  return;
+}
+
+//________________________________________________________________________
+void AliCaloPhotonCuts::InitializeNonLinearity(Int_t isMC)
+{
+  // Resolve the period and the NonLinearity setting once, instead of for every cluster.
+  // The branch of GetNonLinearityCorrectedEnergy() only depends on the setting, the
+  // period, the cluster type and isMC, not on the cluster energy, such that a setting
+  // leaving the probe energies unchanged is a pure pass-through and can be skipped.
   if(fCurrentMC==kNoMC){
     AliV0ReaderV1* V0Reader = (AliV0ReaderV1*) AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
     if( V0Reader == NULL ){
@@ -4420,6 +4454,22 @@ void AliCaloPhotonCuts::ApplyNonLinearity(AliVCluster* cluster, Int_t isMC)
     printf("AliCaloPhotonCuts:Period name has been set to %s, period-enum: %o\n",fPeriodName.Data(),fCurrentMC ) ;
   }
 
+  const Int_t nProbes = 6;
+  const Float_t probeEnergies[nProbes] = {0.3, 1., 3., 10., 30., 100.};
+  fNonLinearityIsIdentity = kTRUE;
+  for(Int_t i = 0; i < nProbes; i++){
+    if(GetNonLinearityCorrectedEnergy(probeEnergies[i], isMC) != probeEnergies[i]){
+      fNonLinearityIsIdentity = kFALSE;
+      break;
+    }
+  }
+  fNonLinearityIsMC = isMC;
+}
+
+//________________________________________________________________________
+Float_t AliCaloPhotonCuts::GetNonLinearityCorrectedEnergy(Float_t energy, Int_t isMC)
+{
+  // NonLinearity corrected cluster energy for the current setting, period and cluster type
 
   Bool_t fPeriodNameAvailable = kTRUE;
 
@@ -5185,18 +5235,16 @@ void AliCaloPhotonCuts::ApplyNonLinearity(AliVCluster* cluster, Int_t isMC)
 
     default:
       AliFatal(Form("NonLinearity correction not defined for cut: '%d' ! Returning...",fSwitchNonLinearity));
-      return;
+      return energy;
 
   }
 
   if(!fPeriodNameAvailable){
     AliFatal(Form("NonLinearity correction not defined for fPeriodName: '%s'! Please check cut number (%d) as well as function AliCaloPhotonCuts::ApplyNonLinearity. Correction failed, returning...",fPeriodName.Data(),fSwitchNonLinearity));
-    return;
+    return energy;
   }
 
-  cluster->SetE(energy);
-
-  return;
+  return energy;
 }
 
 //________________________________________________________________________
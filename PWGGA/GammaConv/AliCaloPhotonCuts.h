@@ -229,6 +229,8 @@ class AliCaloPhotonCuts : public AliAnalysisCuts {
     MCSet       FindEnumForMCSet(TString namePeriod);
 
     void        ApplyNonLinearity(AliVCluster* cluster, Int_t isMC);
+    void        InitializeNonLinearity(Int_t isMC);
+    Float_t     GetNonLinearityCorrectedEnergy(Float_t energy, Int_t isMC);
 
     Float_t     FunctionNL_kPi0MC(Float_t e, Float_t p0, Float_t p1, Float_t p2, Float_t p3, Float_t p4, Float_t p5, Float_t p6);
     Float_t     FunctionNL_PHOS(Float_t e, Float_t p0, Float_t p1, Float_t p2);
@@ -277,6 +279,8 @@ class AliCaloPhotonCuts : public AliAnalysisCuts {
     Int_t       FindLargestCellInCluster(AliVCluster* cluster, AliVEvent* event);
     Int_t       FindSecondLargestCellInCluster(AliVCluster* cluster, AliVEvent* event);
     Bool_t      CheckDistanceToBadChannel(AliVCluster* cluster, AliVEvent* event);
+    void        InitializeCellTables();
+    void        BuildDistanceToBadChannelMap(Int_t runnumber);
     Int_t       ClassifyClusterForTMEffi(AliVCluster* cluster, AliVEvent* event, AliMCEvent* mcEvent, Bool_t isESD);
 
     std::vector<Int_t> GetVectorMatchedTracksToCluster(AliVEvent* event, AliVCluster* cluster);
@@ -522,10 +526,18 @@ class AliCaloPhotonCuts : public AliAnalysisCuts {
     Int_t      fNMaxDCalModules;                        // max number of DCal Modules
     Int_t      fgkDCALCols;                             // Number of columns in DCal
 
+    std::vector<Int_t>   fCellModule;                   //! module number per absolute cell ID
+    std::vector<Int_t>   fCellCol;                      //! column in module per absolute cell ID
+    std::vector<Int_t>   fCellRow;                      //! row in module per absolute cell ID
+    std::vector<Int_t>   fCellNeighbours;               //! EMCal/DCal: 8 neighbours per absolute cell ID (-1 if none), first 4 sharing an edge
+    std::vector<Short_t> fCellDistanceToBadChannel;     //! EMCal/DCal: distance to the closest other bad channel, capped at fMinDistanceToBadChannel+1
+    Int_t      fDistanceMapRun;                         //! run for which fCellDistanceToBadChannel was built
+    Int_t      fNonLinearityIsMC;                       //! isMC flag for which the NonLinearity setting was resolved, -1 if not yet resolved
+    Bool_t     fNonLinearityIsIdentity;                 //! resolved NonLinearity setting does not change the cluster energy
 
   private:
 
-    ClassDef(AliCaloPhotonCuts,52)
+    ClassDef(AliCaloPhotonCuts,54)
 };
 
 #endif
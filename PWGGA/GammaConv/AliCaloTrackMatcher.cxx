@@ -57,6 +57,8 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType) :
   fRunNumber(-1),
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
+  fClusterGrid(),
+  fClusterGridMinR(0),
   fMapTrackToCluster(),
   fMapClusterToTrack(),
   fNEntries(1),
@@ -214,6 +216,22 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
+  // Bin the cluster positions on a z-phi grid, so that each track is only
+  // compared to the clusters around it. The window in phi follows from
+  // the smallest transverse radius, the 3D distance is still checked below.
+  fClusterGrid.Reset(-500., 500., fMatchingWindow, fMatchingWindow/450.);
+  fClusterGridMinR = 1e9;
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = event->GetCaloCluster(iclus);
+    if (!cluster) continue;
+    Float_t gridPos[3] = {0.,0.,0.};
+    cluster->GetPosition(gridPos);
+    fClusterGrid.Add(gridPos[2],TMath::ATan2(gridPos[1],gridPos[0]),iclus);
+    fClusterGridMinR = TMath::Min(fClusterGridMinR,(Double_t)TMath::Sqrt(gridPos[0]*gridPos[0]+gridPos[1]*gridPos[1]));
+  }
+  fClusterGrid.Build();
+  vector<Int_t> candidates;
+
   for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
     AliExternalTrackParam *trackParam = 0;
     AliVTrack *inTrack = 0x0;
@@ -294,7 +312,11 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
 //cout << "eta/phi: " << eta << ", " << phi << endl;
 //cout << "nClus: " << nClus << endl;
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
+    Double_t minR = TMath::Min(fClusterGridMinR,TMath::Sqrt(exPos[0]*exPos[0]+exPos[1]*exPos[1]));
+    Double_t phiWindow = (minR > 0 && fMatchingWindow < 2*minR) ? 2*TMath::ASin(fMatchingWindow/(2*minR)) : TMath::Pi();
+    fClusterGrid.FindCandidates(exPos[2],TMath::ATan2(exPos[1],exPos[0]),fMatchingWindow,phiWindow,candidates);
+    for(UInt_t icand=0;icand < candidates.size();icand++){
+      Int_t iclus = fClusterGrid.GetIndex(candidates[icand]);
       AliVCluster* cluster = event->GetCaloCluster(iclus);
       if (!cluster) continue;
 //cout << "-------------------------LOOPING: " << iclus << ", " << cluster->GetID() << endl;
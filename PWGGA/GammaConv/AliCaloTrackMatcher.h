@@ -4,6 +4,9 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliEMCALGeometry.h"
 #include "AliPHOSGeometry.h"
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include "AliEmcalMatchingGrid.h"
+#endif
 #include <vector>
 #include <map>
 #include <utility>
@@ -103,6 +106,11 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliEMCALGeometry*     fGeomEMCAL;              // pointer to EMCAL geometry
     AliPHOSGeometry*      fGeomPHOS;               // pointer to PHOS geometry
 
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+    AliEmcalMatchingGrid  fClusterGrid;            //! z-phi grid of the cluster positions of the current event
+#endif
+    Double_t              fClusterGridMinR;        //! smallest transverse radius of the clusters in the grid
+
     multimap<Int_t,Int_t> fMapTrackToCluster;      // connects a given track ID with all associated cluster IDs
     multimap<Int_t,Int_t> fMapClusterToTrack;      // connects a given cluster ID with all associated track IDs
 
@@ -124,7 +132,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     TH2F*                 fHistControlMatches;     // bookkeeping for processed tracks/clusters and succesful matches
     TH2F*                 fSecHistControlMatches;  // bookkeeping for processed V0-tracks/clusters and succesful matches
 
-    ClassDef(AliCaloTrackMatcher,3)
+    ClassDef(AliCaloTrackMatcher,4)
 };
 
 #endif
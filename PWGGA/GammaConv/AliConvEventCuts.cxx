@@ -59,6 +59,10 @@ using namespace std;
 ClassImp(AliConvEventCuts)
 /// \endcond
 
+std::map<TString,Float_t> AliConvEventCuts::fgEventCache;
+const AliVEvent*          AliConvEventCuts::fgEventCacheEvent = 0x0;
+Long64_t                  AliConvEventCuts::fgEventCacheEntry = -1;
+
 
 const char* AliConvEventCuts::fgkCutNames[AliConvEventCuts::kNCuts] = {
   "HeavyIon",                     //0
@@ -1913,10 +1917,41 @@ Bool_t AliConvEventCuts::GetUseNewMultiplicityFramework(){
   }
 }
 
+//-------------------------------------------------------------
+Bool_t AliConvEventCuts::GetCachedEventValue(AliVEvent *event, const TString &key, Float_t &value)
+{
+  // Look up a value of the shared event cache. The cache is cleared as soon as the
+  // analysis manager moved to another event, such that all instances of the event
+  // cuts processing the same event share the values computed by the first of them.
+  if(!event) return kFALSE;
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if(event != fgEventCacheEvent || entry != fgEventCacheEntry){
+    fgEventCache.clear();
+    fgEventCacheEvent = event;
+    fgEventCacheEntry = entry;
+    return kFALSE;
+  }
+  std::map<TString,Float_t>::const_iterator it = fgEventCache.find(key);
+  if(it == fgEventCache.end()) return kFALSE;
+  value = it->second;
+  return kTRUE;
+}
+
 //-------------------------------------------------------------
 Float_t AliConvEventCuts::GetCentrality(AliVEvent *event)
-{   // Get Event Centrality
+{   // Get Event Centrality, evaluated once per event for each estimator setting
+  TString key = Form("centrality_%d_%d_%d", fIsHeavyIon==2, fDetectorCentrality, GetUseNewMultiplicityFramework());
+  Float_t centrality = -1;
+  if(GetCachedEventValue(event, key, centrality)) return centrality;
+  centrality = EvaluateCentrality(event);
+  if(event) SetCachedEventValue(key, centrality);
+  return centrality;
+}
 
+//-------------------------------------------------------------
+Float_t AliConvEventCuts::EvaluateCentrality(AliVEvent *event)
+{
   AliESDEvent *esdEvent=dynamic_cast<AliESDEvent*>(event);
   if(esdEvent){
     if(GetUseNewMultiplicityFramework()){
@@ -1963,7 +1998,21 @@ Float_t AliConvEventCuts::GetCentrality(AliVEvent *event)
 //_____________________________________________________________________________________
 Bool_t AliConvEventCuts::IsCentralitySelected(AliVEvent *event, AliMCEvent *mcEvent)
 {
-  // Centrality Selection
+  // Centrality Selection, evaluated once per event for each set of centrality settings
+  // (heavy ion, centrality min and max digits of the cut string)
+  if(fIsHeavyIon && fCentralityMin != fCentralityMax && fCentralityMax==0) fCentralityMax=10; //CentralityRange = fCentralityMin-10*multfactor
+  TString key = Form("centralitysel_%d_%d_%d_%d_%d_%d_%d_%s", fIsHeavyIon, fDetectorCentrality, fModCentralityClass,
+                     fCentralityMin, fCentralityMax, fPeriodEnum, mcEvent!=0x0, fV0ReaderName.Data());
+  Float_t selected = 0;
+  if(GetCachedEventValue(event, key, selected)) return selected > 0;
+  Bool_t isSelected = EvaluateCentralitySelection(event, mcEvent);
+  if(event) SetCachedEventValue(key, isSelected);
+  return isSelected;
+}
+
+//-------------------------------------------------------------
+Bool_t AliConvEventCuts::EvaluateCentralitySelection(AliVEvent *event, AliMCEvent *mcEvent)
+{
   if(!fIsHeavyIon){
     if ((fCentralityMin == 0 && fCentralityMax == 0) || (fCentralityMin > fCentralityMax) ){
       return kTRUE;
@@ -2280,6 +2329,9 @@ Bool_t AliConvEventCuts::IsOutOfBunchPileupPastFuture(AliVEvent *event)
     }
   }
 
+  TString key = Form("pastfuture_%d_%d", fPastFutureRejectionLow, fPastFutureRejectionHigh);
+  Float_t cached = 0;
+  if(GetCachedEventValue(event, key, cached)) return cached > 0;
   Bool_t isOutOfBunchPileup = 0;
   Int_t pf1 = fPastFutureRejectionLow +bunchCrossings%4;
   Int_t pf2 = fPastFutureRejectionHigh+bunchCrossings%4;
@@ -2293,6 +2345,7 @@ Bool_t AliConvEventCuts::IsOutOfBunchPileupPastFuture(AliVEvent *event)
     if (i>0 && i<=ir1skip) continue; // skip next 2 for old IR definitions
     isOutOfBunchPileup|=fIR1.TestBitNumber(90+i); // V0-based clean-up
   }
+  SetCachedEventValue(key, isOutOfBunchPileup);
   return isOutOfBunchPileup;
 }
 //________________________________________________________________________
@@ -2300,6 +2353,12 @@ Bool_t AliConvEventCuts::IsOutOfBunchPileupPastFuture(AliVEvent *event)
 Bool_t AliConvEventCuts::IsPileUpV0MTPCout(AliVEvent *event)
 {
   Bool_t isPileUpV0MTPCout=0;
+  if ( fFPileUpRejectV0MTPCout == 0x0 ) return isPileUpV0MTPCout;
+
+  TString key = Form("v0mtpcout_%d_%g_%g_%s", fIsHeavyIon==2, fFPileUpRejectV0MTPCout->GetParameter(0),
+                     fFPileUpRejectV0MTPCout->GetParameter(1), fV0ReaderName.Data());
+  Float_t cached = 0;
+  if(GetCachedEventValue(event, key, cached)) return cached > 0;
 
   Double_t multV0M;
   Double_t valFunc;
@@ -2314,6 +2373,7 @@ Bool_t AliConvEventCuts::IsPileUpV0MTPCout(AliVEvent *event)
     if (multV0M < valFunc  ) isPileUpV0MTPCout=1;
   }
 
+  SetCachedEventValue(key, isPileUpV0MTPCout);
   return isPileUpV0MTPCout;
 
 }
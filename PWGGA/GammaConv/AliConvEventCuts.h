@@ -17,6 +17,7 @@
 #include "AliAnalysisManager.h"
 #include "TRandom3.h"
 #include "AliVCaloTrigger.h"
+#include <map>
 
 class AliESDEvent;
 class AliAODEvent;
@@ -633,9 +634,20 @@ class AliConvEventCuts : public AliAnalysisCuts {
       TH1D*                       hReweightMultMC;                        ///< histogram input for reweighting Pi0
       Int_t                       fDebugLevel;                            ///< debug level for interactive debugging
   private:
+      Float_t   EvaluateCentrality(AliVEvent *event);
+      Bool_t    EvaluateCentralitySelection(AliVEvent *event, AliMCEvent *mcEvent);
+      Bool_t    GetCachedEventValue(AliVEvent *event, const TString &key, Float_t &value);
+      void      SetCachedEventValue(const TString &key, Float_t value)             { fgEventCache[key] = value                                 ; }
+
+      // Event level quantities which only depend on the event and on a few cut
+      // settings are shared by all instances (cut variations and wagons) and
+      // evaluated once per event for each set of settings, see GetCachedEventValue()
+      static std::map<TString,Float_t> fgEventCache;                      //!<! cached values of the current event, keyed by the settings they depend on
+      static const AliVEvent*     fgEventCacheEvent;                      //!<! event the cache was filled for
+      static Long64_t             fgEventCacheEntry;                      //!<! entry of the analysis manager the cache was filled for
 
       /// \cond CLASSIMP
-      ClassDef(AliConvEventCuts,39)
+      ClassDef(AliConvEventCuts,40)
       /// \endcond
 };
 
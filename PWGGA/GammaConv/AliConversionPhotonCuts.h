@@ -242,6 +242,10 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     Bool_t UseElecSharingCut(){return fDoSharedElecCut;}
     Bool_t UseToCloseV0sCut(){return fDoToCloseV0sCut;}
     Double_t GetEtaCut(){return fEtaCut;}
+    Double_t GetMaxR(){return fMaxR;}
+    Double_t GetMinR(){return fMinR;}
+    Bool_t UseQtGammaSelection(){return fDoQtGammaSelection;}
+    Double_t GetQtMax(){return fQtMax;}
     void SetDodEdxSigmaCut(Bool_t k=kTRUE)  {fDodEdxSigmaCut=k;}
     void SetSwitchToKappaInsteadOfNSigdEdxTPC(Bool_t k=kTRUE) {fSwitchToKappa=k;}
     
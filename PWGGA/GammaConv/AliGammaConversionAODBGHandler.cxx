@@ -45,7 +45,16 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(),
 	fBGEventsENeg(),
-	fBGEventsMeson()
+	fBGEventsMeson(),
+	fUseCompactPool(kFALSE),
+	fPoolMemoryBudget(0),
+	fPoolCapacity(0),
+	fPoolPhotons(),
+	fPoolHead(),
+	fPoolDropped(),
+	fPoolEventStart(),
+	fPoolEventSize(),
+	fPoolScratch()
 {
 	// constructor
 }
@@ -66,7 +75,16 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fUseCompactPool(kFALSE),
+	fPoolMemoryBudget(0),
+	fPoolCapacity(0),
+	fPoolPhotons(),
+	fPoolHead(),
+	fPoolDropped(),
+	fPoolEventStart(),
+	fPoolEventSize(),
+	fPoolScratch()
 {
 	// constructor
 }
@@ -89,7 +107,16 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fUseCompactPool(kFALSE),
+	fPoolMemoryBudget(0),
+	fPoolCapacity(0),
+	fPoolPhotons(),
+	fPoolHead(),
+	fPoolDropped(),
+	fPoolEventStart(),
+	fPoolEventSize(),
+	fPoolScratch()
 {
 	// constructor
     if(fNBinsZ>8) fNBinsZ = 8;
@@ -361,7 +388,16 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBinLimitsArrayMultiplicity(original.fBinLimitsArrayMultiplicity),
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
-	fBGEventsMeson(original.fBGEventsMeson)
+	fBGEventsMeson(original.fBGEventsMeson),
+	fUseCompactPool(original.fUseCompactPool),
+	fPoolMemoryBudget(original.fPoolMemoryBudget),
+	fPoolCapacity(original.fPoolCapacity),
+	fPoolPhotons(original.fPoolPhotons),
+	fPoolHead(original.fPoolHead),
+	fPoolDropped(original.fPoolDropped),
+	fPoolEventStart(original.fPoolEventStart),
+	fPoolEventSize(original.fPoolEventSize),
+	fPoolScratch()
 {
 	//copy constructor	
 }
@@ -425,6 +461,10 @@ AliGammaConversionAODBGHandler::~AliGammaConversionAODBGHandler(){
 	if(fBinLimitsArrayMultiplicity){
 		delete[] fBinLimitsArrayMultiplicity;
 	}
+	for(UInt_t d=0;d<fPoolScratch.size();d++){
+		delete fPoolScratch[d];
+	}
+	fPoolScratch.clear();
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -577,6 +617,16 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 		fBGEventCounter[z][m]=0;
 	}
 	Int_t eventCounter=fBGEventCounter[z][m];
+
+	if(fUseCompactPool){
+		fBGEventVertex[z][m][eventCounter].fX = xvalue;
+		fBGEventVertex[z][m][eventCounter].fY = yvalue;
+		fBGEventVertex[z][m][eventCounter].fZ = zvalue;
+		fBGEventVertex[z][m][eventCounter].fEP = epvalue;
+		AddCompactEvent(eventGammas,z,m,eventCounter);
+		fBGEventCounter[z][m]++;
+		return;
+	}
 	
 	/*
 	if(fBGEventVertex[z][m][eventCounter]){
@@ -703,6 +753,7 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event){
 	//see headerfile for documentation
+	if(fUseCompactPool) return GetCompactEvent(zbin,mbin,event);
 	return &(fBGEvents[zbin][mbin][event]);
 }
 
@@ -744,3 +795,125 @@ void AliGammaConversionAODBGHandler::PrintBGArray(){
 		}
 	}
 }
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::SetUseCompactPool(Bool_t useCompact, Long64_t memoryBudget){
+	// switch to the memory bounded compact photon pools
+	if(!fPoolHead.empty()){
+		cout<<"AliGammaConversionAODBGHandler: compact pool has to be configured before the first event, ignored"<<endl;
+		return;
+	}
+	fUseCompactPool = useCompact;
+	fPoolMemoryBudget = memoryBudget;
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::AddCompactEvent(TList* const eventGammas, Int_t z, Int_t m, Int_t eventCounter){
+	// store the photons of an event in the ring buffer of its bin
+	Int_t nBins = fNBinsZ*fNBinsMultiplicity;
+	if(fPoolHead.empty()){
+		// the capacity per bin follows from the budget
+		Long64_t perBin = fPoolMemoryBudget/(nBins*(Long64_t)sizeof(GammaConversionCompactPhoton));
+		fPoolCapacity = perBin > 1 ? (perBin < 100000000 ? (Int_t)perBin : 100000000) : 1;
+		fPoolPhotons.assign(nBins,std::vector<GammaConversionCompactPhoton>());
+		fPoolHead.assign(nBins,0);
+		fPoolDropped.assign(nBins,0);
+		fPoolEventStart.assign(nBins*fNEvents,0);
+		fPoolEventSize.assign(nBins*fNEvents,0);
+	}
+	Int_t bin = z*fNBinsMultiplicity+m;
+	Int_t slot = bin*fNEvents+eventCounter;
+	std::vector<GammaConversionCompactPhoton> &ring = fPoolPhotons[bin];
+
+	Int_t nGammas = eventGammas->GetEntries();
+	if(nGammas > fPoolCapacity){
+		fPoolDropped[bin] += nGammas-fPoolCapacity;
+		nGammas = fPoolCapacity;
+	}
+	fPoolEventStart[slot] = fPoolHead[bin];
+	fPoolEventSize[slot] = nGammas;
+	for(Int_t i=0; i<nGammas; i++){
+		AliAODConversionPhoton *gamma = (AliAODConversionPhoton*)(eventGammas->At(i));
+		GammaConversionCompactPhoton compact;
+		compact.fPx = gamma->Px();
+		compact.fPy = gamma->Py();
+		compact.fPz = gamma->Pz();
+		compact.fE = gamma->E();
+		compact.fConvX = gamma->GetConversionX();
+		compact.fConvY = gamma->GetConversionY();
+		compact.fConvZ = gamma->GetConversionZ();
+		compact.fChi2perNDF = gamma->GetChi2perNDF();
+		compact.fV0Index = gamma->GetV0Index();
+		compact.fQuality = gamma->GetPhotonQuality();
+		compact.fFlags = gamma->GetIsCaloPhoton() ? kCompactCaloPhoton : 0;
+		Long64_t pos = fPoolHead[bin] % fPoolCapacity;
+		if(pos < (Long64_t)ring.size()) ring[pos] = compact;
+		else ring.push_back(compact);
+		fPoolHead[bin]++;
+	}
+}
+
+//_____________________________________________________________________________________________________________________________
+AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetCompactEvent(Int_t zbin, Int_t mbin, Int_t event){
+	// rebuild the photons of a stored event, empty if not stored or overwritten
+	Int_t nGammas = 0;
+	Int_t bin = zbin*fNBinsMultiplicity+mbin;
+	Int_t slot = bin*fNEvents+event;
+	if(!fPoolHead.empty() && fPoolHead[bin]-fPoolEventStart[slot] <= fPoolCapacity){
+		nGammas = fPoolEventSize[slot];
+	}
+	for(Int_t i=fPoolScratch.size(); i<nGammas; i++){
+		fPoolScratch.push_back(new AliAODConversionPhoton());
+	}
+	for(Int_t i=0; i<nGammas; i++){
+		const GammaConversionCompactPhoton &compact = fPoolPhotons[bin][(fPoolEventStart[slot]+i) % fPoolCapacity];
+		AliAODConversionPhoton *gamma = fPoolScratch[i];
+		*gamma = AliAODConversionPhoton();
+		gamma->SetPxPyPzE(compact.fPx,compact.fPy,compact.fPz,compact.fE);
+		Double_t convPoint[3] = {compact.fConvX,compact.fConvY,compact.fConvZ};
+		gamma->SetConversionPoint(convPoint);
+		gamma->SetChi2perNDF(compact.fChi2perNDF);
+		gamma->SetV0Index(compact.fV0Index);
+		gamma->SetPhotonQuality(compact.fQuality);
+		if(compact.fFlags & kCompactCaloPhoton) gamma->SetIsCaloPhoton();
+	}
+	// the photon objects are kept for the next call, only the size changes
+	fBGEvents[zbin][mbin][event].assign(fPoolScratch.begin(),fPoolScratch.begin()+nGammas);
+	return &(fBGEvents[zbin][mbin][event]);
+}
+
+//_____________________________________________________________________________________________________________________________
+Int_t AliGammaConversionAODBGHandler::GetPoolOccupancy(Int_t zbin, Int_t mbin) const {
+	// number of photons currently held in the compact pool of a bin
+	if(fPoolPhotons.empty()) return 0;
+	return fPoolPhotons[zbin*fNBinsMultiplicity+mbin].size();
+}
+
+//_____________________________________________________________________________________________________________________________
+Long64_t AliGammaConversionAODBGHandler::GetPoolMemoryUsage() const {
+	// memory allocated by the compact pools in bytes
+	Long64_t size = 0;
+	for(UInt_t bin=0; bin<fPoolPhotons.size(); bin++){
+		size += fPoolPhotons[bin].capacity()*sizeof(GammaConversionCompactPhoton);
+	}
+	return size;
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::PrintPoolOccupancy() const {
+	// report of the compact pool occupancy per bin
+	if(!fUseCompactPool){
+		cout<<"AliGammaConversionAODBGHandler: compact pool not used"<<endl;
+		return;
+	}
+	cout<<"AliGammaConversionAODBGHandler: compact pool capacity "<<fPoolCapacity<<" photons per bin, "
+		<<GetPoolMemoryUsage()<<" of "<<fPoolMemoryBudget<<" bytes used"<<endl;
+	if(fPoolPhotons.empty()) return;
+	for(Int_t z=0;z<fNBinsZ;z++){
+		for(Int_t m=0;m<fNBinsMultiplicity;m++){
+			Int_t bin = z*fNBinsMultiplicity+m;
+			cout<<"  z bin "<<z<<", mult bin "<<m<<": "<<GetPoolOccupancy(z,m)<<" photons, "
+				<<fPoolHead[bin]<<" written, "<<fPoolDropped[bin]<<" dropped"<<endl;
+		}
+	}
+}
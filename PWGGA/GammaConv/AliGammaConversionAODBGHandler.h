@@ -36,6 +36,22 @@ class AliGammaConversionAODBGHandler : public TObject {
 	
 	typedef struct GammaConversionVertex GammaConversionVertex; 																//!
 
+	// compact photon for the memory bounded pools, see SetUseCompactPool
+	struct GammaConversionCompactPhoton{
+		Float_t fPx;
+		Float_t fPy;
+		Float_t fPz;
+		Float_t fE;
+		Float_t fConvX;
+		Float_t fConvY;
+		Float_t fConvZ;
+		Float_t fChi2perNDF;
+		Int_t fV0Index;					// V0 index or leading cell ID for calo photons
+		UChar_t fQuality;
+		UChar_t fFlags;					// bit mask of ECompactFlags
+	};
+	enum ECompactFlags { kCompactCaloPhoton = 0x1 };
+
 	typedef std::vector<AliGammaConversionAODVector> AliGammaConversionBGEventVector;
 	typedef std::vector<AliGammaConversionBGEventVector> AliGammaConversionMultipicityVector;
 	typedef std::vector<AliGammaConversionMultipicityVector> AliGammaConversionBGVector;
@@ -78,6 +94,18 @@ class AliGammaConversionAODBGHandler : public TObject {
 	
 	void PrintBGArray();
 
+	// Memory bounded photon pools: photons are stored as GammaConversionCompactPhoton in a
+	// fixed capacity ring buffer per z x multiplicity bin, the capacity follows from the memory
+	// budget (in bytes, shared by all bins). Events whose photons were overwritten are returned
+	// empty. GetBGGoodV0s returns photons rebuilt from the compact pool, valid until the next call.
+	// Has to be set before the first event is added.
+	void SetUseCompactPool(Bool_t useCompact, Long64_t memoryBudget = 200000000);
+	Bool_t GetUseCompactPool() const {return fUseCompactPool;}
+	Int_t GetPoolCapacity() const {return fPoolCapacity;}
+	Int_t GetPoolOccupancy(Int_t zbin, Int_t mbin) const;
+	Long64_t GetPoolMemoryUsage() const;
+	void PrintPoolOccupancy() const;
+
 	GammaConversionVertex * GetBGEventVertex(Int_t zbin, Int_t mbin, Int_t event){return &fBGEventVertex[zbin][mbin][event];}
 
 	Double_t GetBGProb(Int_t z, Int_t m){return fBGProbability[z][m];}
@@ -98,7 +126,19 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEvents; 						// photon background events
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector 	fBGEventsMeson; 				// neutral meson background events
-		
-	ClassDef(AliGammaConversionAODBGHandler,6)
+		Bool_t								fUseCompactPool;				// store photons in the memory bounded compact pools
+		Long64_t							fPoolMemoryBudget;				// memory budget of the compact pools in bytes
+		Int_t								fPoolCapacity;					//! photons per bin in the compact pools
+		std::vector< std::vector<GammaConversionCompactPhoton> > fPoolPhotons;	//! ring buffer of photons per bin
+		std::vector<Long64_t>				fPoolHead;						//! photons written per bin
+		std::vector<Long64_t>				fPoolDropped;					//! photons not stored per bin, event larger than the capacity
+		std::vector<Long64_t>				fPoolEventStart;				//! first photon of each event in the ring buffer
+		std::vector<Int_t>					fPoolEventSize;					//! number of photons of each event
+		AliGammaConversionAODVector			fPoolScratch;					//! photons rebuilt from the compact pool (owned)
+
+		void AddCompactEvent(TList* const eventGammas, Int_t z, Int_t m, Int_t eventCounter);
+		AliGammaConversionAODVector* GetCompactEvent(Int_t zbin, Int_t mbin, Int_t event);
+
+	ClassDef(AliGammaConversionAODBGHandler,7)
 };
 #endif
@@ -148,7 +148,11 @@ AliV0ReaderV1::AliV0ReaderV1(const char *name) : AliAnalysisTaskSE(name),
   fImpactParamTree(NULL),
   fVectorFoundGammas(0),
   fCurrentFileName(""),
-  fMCFileChecked(kFALSE)
+  fMCFileChecked(kFALSE),
+  fUseAnalyticPreselection(kFALSE),
+  fPreselectionMargin(0.1),
+  fPreselectionHistograms(NULL),
+  fHistoPreselectionStages(NULL)
 {
   // Default constructor
 
@@ -405,6 +409,24 @@ void AliV0ReaderV1::UserCreateOutputObjects()
     fImpactParamHistograms->Add(fImpactParamTree);
   }
 
+  if(fUseAnalyticPreselection){
+    if(fPreselectionHistograms != NULL){
+      delete fPreselectionHistograms;
+      fPreselectionHistograms = NULL;
+    }
+    fPreselectionHistograms = new TList();
+    fPreselectionHistograms->SetOwner(kTRUE);
+    fPreselectionHistograms->SetName(Form("PreselectionHistograms_%s_%s",fEventCuts->GetCutNumber().Data(),fConversionCuts->GetCutNumber().Data()));
+
+    fHistoPreselectionStages = new TH1F("fHistoPreselectionStages","V0s surviving each reconstruction stage",5,-0.5,4.5);
+    fHistoPreselectionStages->GetXaxis()->SetBinLabel(1,"# V0s");
+    fHistoPreselectionStages->GetXaxis()->SetBinLabel(2,"track & dE/dx cuts");
+    fHistoPreselectionStages->GetXaxis()->SetBinLabel(3,"analytic R");
+    fHistoPreselectionStages->GetXaxis()->SetBinLabel(4,"analytic q_{T}");
+    fHistoPreselectionStages->GetXaxis()->SetBinLabel(5,"KF photon cuts");
+    fPreselectionHistograms->Add(fHistoPreselectionStages);
+  }
+
   if (fProduceV0findingEffi){
     TH1::AddDirectory(kFALSE);
     if(fHistograms != NULL){
@@ -775,6 +797,7 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
     fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kOnFly);
     return 0x0;
   }
+  if(fHistoPreselectionStages) fHistoPreselectionStages->Fill(0);
 
   if (fMCEvent && fProduceV0findingEffi ) FillRecMCHistosForV0FinderEffiESD(fCurrentV0);
 
@@ -814,6 +837,14 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
     return 0x0;
   }
   fConversionCuts->FillV0EtaAfterdEdxCuts(fCurrentV0->Eta());
+  if(fHistoPreselectionStages) fHistoPreselectionStages->Fill(1);
+
+  // Cheap analytic cuts before the KF reconstruction and the propagations
+  if(fUseAnalyticPreselection && !PassesAnalyticPreselection(fCurrentV0,fCurrentExternalTrackParamPositive,fCurrentExternalTrackParamNegative)){
+    fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kPhotonCuts);
+    return 0x0;
+  }
+
   // Reconstruct Photon
   AliKFConversionPhoton *fCurrentMotherKF=NULL;
   //    fUseConstructGamma = kFALSE;
@@ -936,9 +967,60 @@ AliKFConversionPhoton *AliV0ReaderV1::ReconstructV0(AliESDv0 *fCurrentV0,Int_t c
   if(fProduceImpactParamHistograms) FillImpactParamHistograms(posTrack, negTrack, fCurrentV0, fCurrentMotherKF);
 
   fConversionCuts->FillPhotonCutIndex(AliConversionPhotonCuts::kPhotonOut);
+  if(fHistoPreselectionStages) fHistoPreselectionStages->Fill(4);
   return fCurrentMotherKF;
 }
 
+///________________________________________________________________________
+Bool_t AliV0ReaderV1::PassesAnalyticPreselection(const AliESDv0 *v0, const AliExternalTrackParam *pparam, const AliExternalTrackParam *nparam){
+
+  // Loose versions of the radius and qT photon cuts, computed from the helix parameters
+  // and the V0 daughter momenta without KF reconstruction or track propagation. The
+  // cuts are widened by fPreselectionMargin since the final values come from the KF photon.
+
+  Double_t b = fInputEvent->GetMagneticField();
+  Double_t helixpos[6];
+  pparam->GetHelixParameters(helixpos,b);
+  Double_t helixneg[6];
+  nparam->GetHelixParameters(helixneg,b);
+
+  // xy-position of the conversion point as in GetConversionPoint, skipped without field
+  if(helixpos[4] != 0 && helixneg[4] != 0){
+    Double_t helixcenterpos[2];
+    GetHelixCenter(pparam,helixcenterpos);
+    Double_t helixcenterneg[2];
+    GetHelixCenter(nparam,helixcenterneg);
+    Double_t posradius = TMath::Abs(1./helixpos[4]);
+    Double_t negradius = TMath::Abs(1./helixneg[4]);
+
+    Double_t convX = (helixcenterpos[0]*negradius + helixcenterneg[0]*posradius)/(negradius+posradius);
+    Double_t convY = (helixcenterpos[1]*negradius + helixcenterneg[1]*posradius)/(negradius+posradius);
+    Double_t convR = TMath::Sqrt(convX*convX + convY*convY);
+    if(convR > fConversionCuts->GetMaxR()*(1.+fPreselectionMargin)) return kFALSE;
+    if(convR < fConversionCuts->GetMinR()*(1.-fPreselectionMargin)) return kFALSE;
+  }
+  if(fHistoPreselectionStages) fHistoPreselectionStages->Fill(2);
+
+  // Armenteros qT of the positive daughter with respect to the V0 momentum
+  if(fConversionCuts->UseQtGammaSelection()){
+    Double_t mp[3] = {0,0,0};
+    Double_t mn[3] = {0,0,0};
+    v0->GetPPxPyPz(mp[0],mp[1],mp[2]);
+    v0->GetNPxPyPz(mn[0],mn[1],mn[2]);
+    Double_t mom[3] = {mp[0]+mn[0],mp[1]+mn[1],mp[2]+mn[2]};
+    Double_t mom2 = mom[0]*mom[0] + mom[1]*mom[1] + mom[2]*mom[2];
+    if(mom2 > 0){
+      Double_t pLong = (mp[0]*mom[0] + mp[1]*mom[1] + mp[2]*mom[2])/TMath::Sqrt(mom2);
+      Double_t qt2 = mp[0]*mp[0] + mp[1]*mp[1] + mp[2]*mp[2] - pLong*pLong;
+      Double_t qtMax = fConversionCuts->GetQtMax()*(1.+fPreselectionMargin);
+      if(qt2 > qtMax*qtMax) return kFALSE;
+    }
+  }
+  if(fHistoPreselectionStages) fHistoPreselectionStages->Fill(3);
+
+  return kTRUE;
+}
+
 ///________________________________________________________________________
 Double_t AliV0ReaderV1::GetPsiPair(const AliESDv0* v0, const AliExternalTrackParam *positiveparam,const AliExternalTrackParam *negativeparam,const Double_t convpos[3]) const {
   //
@@ -143,6 +143,13 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
 
     Bool_t             GetProduceImpactParamHistograms()                {return fProduceImpactParamHistograms;}
     TList*             GetImpactParamHistograms()                       {return fImpactParamHistograms;}
+    void               SetUseAnalyticPreselection(Bool_t b, Double_t margin=0.1)
+                                                                        {fUseAnalyticPreselection = b;
+                                                                         fPreselectionMargin = margin;
+                                                                         if(b) AliInfo("Enabled analytic preselection of V0s before the KF reconstruction");
+                                                                         return;}
+    Bool_t             GetUseAnalyticPreselection()                     {return fUseAnalyticPreselection;}
+    TList*             GetPreselectionHistograms()                      {return fPreselectionHistograms;}
 
     Bool_t             ParticleIsConvertedPhoton(AliMCEvent *mcEvent, TParticle *particle, Double_t etaMax, Double_t rMax, Double_t zMax);
     void               CreatePureMCHistosForV0FinderEffiESD();
@@ -178,6 +185,7 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     Bool_t               GetConversionPoint(const AliExternalTrackParam *pparam, const AliExternalTrackParam *nparam, Double_t convpos[3], Double_t dca[2]);
     Bool_t               GetHelixCenter(const AliExternalTrackParam *track, Double_t center[2]);
     Double_t             GetPsiPair(const AliESDv0* v0, const AliExternalTrackParam *positiveparam, const AliExternalTrackParam *negativeparam, const Double_t convpos[3]) const;
+    Bool_t               PassesAnalyticPreselection(const AliESDv0 *v0, const AliExternalTrackParam *pparam, const AliExternalTrackParam *nparam);
     Bool_t 	   kAddv0sInESDFilter; 	          // Add PCM v0s to AOD created in ESD filter
     TBits		     *fPCMv0BitField;	  // Pointer to bitfield of PCM v0s
     AliConversionPhotonCuts  *fConversionCuts;    // Pointer to the ConversionCut Selection
@@ -249,12 +257,16 @@ class AliV0ReaderV1 : public AliAnalysisTaskSE {
     vector<Int_t>  fVectorFoundGammas;            // vector with found MC labels of gammas
     TString       fCurrentFileName;               // current file name
     Bool_t        fMCFileChecked;                 // vector with MC file names which are broken
+    Bool_t        fUseAnalyticPreselection;       // apply analytic pre-cuts on the helix parameters before the KF reconstruction
+    Double_t      fPreselectionMargin;            // relative margin of the pre-cuts with respect to the photon cuts
+    TList        *fPreselectionHistograms;        // list of histograms of the reconstruction stages
+    TH1F         *fHistoPreselectionStages;       // number of V0s surviving each reconstruction stage
     
   private:
     AliV0ReaderV1(AliV0ReaderV1 &original);
     AliV0ReaderV1 &operator=(const AliV0ReaderV1 &ref);
 
-    ClassDef(AliV0ReaderV1, 16)
+    ClassDef(AliV0ReaderV1, 17)
 
 };
 
@@ -208,7 +208,18 @@ void AliAnalysisTaskCaloCellsQA::UserExec(Option_t *)
     UShort_t BC = event->GetBunchCrossNumber();
     fCellsQA->FillTimeDDL(&clusArray, BC);
   }    
-  
+
+  // the output array was posted in UserCreateOutputObjects(); the per cell
+  // statistics are added to its histograms in FinishTaskOutput()
+}
+
+//________________________________________________________________
+void AliAnalysisTaskCaloCellsQA::FinishTaskOutput()
+{
+  // Bring the histograms up to date before the output is written
+
+  fCellsQA->FlushCellRunStats();
+
   if (fOutfile.Length() == 0)
     PostData(1, fCellsQA->GetListOfHistos());
 }
@@ -32,6 +32,7 @@ public:
 
   void   UserCreateOutputObjects();
   void   UserExec(Option_t *);
+  void   FinishTaskOutput();
   void   Terminate(Option_t *);
 
   void   SetBadCells(Int_t badcells[], Int_t nbad);
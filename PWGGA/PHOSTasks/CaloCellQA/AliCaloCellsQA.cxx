@@ -107,6 +107,17 @@ AliCaloCellsQA::AliCaloCellsQA() :
   fAbsIdMin(0),
   fAbsIdMax(0),
   fListOfHistos(0),
+  fCellSM(),
+  fCellEta(),
+  fCellPhi(),
+  fCellGrid(),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fCellEventAmp(),
+  fCellEventStamp(),
+  fEventStamp(0),
+  fCellRunStats(),
+  fCellRunStatsFilled(kFALSE),
   fhNEventsProcessedPerRun(0),
   fhTimeDDL(),
   fhCellLocMaxNTimesInClusterElow(),
@@ -153,6 +164,17 @@ AliCaloCellsQA::AliCaloCellsQA(Int_t nmods, Int_t det, Int_t startRunNumber, Int
   fAbsIdMin(0),
   fAbsIdMax(0),
   fListOfHistos(0),
+  fCellSM(),
+  fCellEta(),
+  fCellPhi(),
+  fCellGrid(),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fCellEventAmp(),
+  fCellEventStamp(),
+  fEventStamp(0),
+  fCellRunStats(),
+  fCellRunStatsFilled(kFALSE),
   fhNEventsProcessedPerRun(0),
   fhTimeDDL(),
   fhCellLocMaxNTimesInClusterElow(),
@@ -285,6 +307,96 @@ void AliCaloCellsQA::Fill(Int_t runNumber, TObjArray *clusArray, AliVCaloCells *
   FillPi0Mass(clusArray, vertexXYZ);
 }
 
+//_________________________________________________________________________
+TObjArray* AliCaloCellsQA::GetListOfHistos()
+{
+  // Array with all the histograms, up to date with the processed events.
+
+  FlushCellRunStats();
+  return fListOfHistos;
+}
+
+//_________________________________________________________________________
+void AliCaloCellsQA::FlushCellRunStats()
+{
+  // Add the accumulated statistics of cells in clusters to the current run histograms.
+  // Bin contents, errors and number of entries are the same as if the histograms were
+  // filled cluster by cluster.
+
+  if (!fCellRunStatsFilled) return;
+  fCellRunStatsFilled = kFALSE;
+
+  Int_t ncells = fAbsIdMax - fAbsIdMin;
+
+  for (Int_t cls = 0; cls < kNCellClasses; cls++) {
+    TH1F *hN = 0, *hE = 0;
+    GetCellRunHistos(cls, hN, hE);
+
+    Double_t nfills = 0;
+    for (Int_t i = 0; i < ncells; i++) {
+      Double_t *stats = &fCellRunStats[(i*kNCellClasses + cls)*3];
+      if (stats[0] == 0) continue;
+
+      if (hN && hE) {
+        if (!hE->GetSumw2N()) hE->Sumw2();
+        hN->AddBinContent(i+1, stats[0]);
+        if (hN->GetSumw2N()) hN->GetSumw2()->GetArray()[i+1] += stats[0];
+        hE->AddBinContent(i+1, stats[1]);
+        hE->GetSumw2()->GetArray()[i+1] += stats[2];
+        nfills += stats[0];
+      }
+      stats[0] = stats[1] = stats[2] = 0;
+    }
+
+    if (nfills == 0) continue;
+
+    Double_t entries = hN->GetEntries() + nfills;
+    hN->ResetStats();
+    hN->SetEntries(entries);
+
+    entries = hE->GetEntries() + nfills;
+    hE->ResetStats();
+    hE->SetEntries(entries);
+  }
+}
+
+//_________________________________________________________________________
+void AliCaloCellsQA::GetCellRunHistos(Int_t cls, TH1F *&hN, TH1F *&hE)
+{
+  // Current run histograms (number of times, total cluster energy) of a class of cells in clusters.
+
+  switch (cls) {
+    case kLocMaxElow:     hN = fhCellLocMaxNTimesInClusterElow;     hE = fhCellLocMaxETotalClusterElow;     break;
+    case kLocMaxEhigh:    hN = fhCellLocMaxNTimesInClusterEhigh;    hE = fhCellLocMaxETotalClusterEhigh;    break;
+    case kNonLocMaxElow:  hN = fhCellNonLocMaxNTimesInClusterElow;  hE = fhCellNonLocMaxETotalClusterElow;  break;
+    case kNonLocMaxEhigh: hN = fhCellNonLocMaxNTimesInClusterEhigh; hE = fhCellNonLocMaxETotalClusterEhigh; break;
+    default:              hN = 0;                                   hE = 0;
+  }
+}
+
+//_________________________________________________________________________
+void AliCaloCellsQA::FillCellRunStats(Int_t absId, Int_t cls, Double_t eclus)
+{
+  // Count cell absId of class cls in a cluster of energy eclus for the current run.
+
+  Int_t i = absId - fAbsIdMin;
+
+  // under/overflow: fill the histograms directly
+  if (i < 0 || i >= fAbsIdMax - fAbsIdMin || fCellRunStats.empty()) {
+    TH1F *hN = 0, *hE = 0;
+    GetCellRunHistos(cls, hN, hE);
+    if (hN) hN->Fill(absId);
+    if (hE) hE->Fill(absId, eclus);
+    return;
+  }
+
+  Double_t *stats = &fCellRunStats[(i*kNCellClasses + cls)*3];
+  stats[0] += 1;
+  stats[1] += eclus;
+  stats[2] += eclus*eclus;
+  fCellRunStatsFilled = kTRUE;
+}
+
 //_________________________________________________________________________
 void AliCaloCellsQA::SetClusterEnergyCuts(Double_t pi0EClusMin, Double_t elowMin, Double_t ehighMin)
 {
@@ -368,6 +480,11 @@ void AliCaloCellsQA::InitTransientFindCurrentRun(Int_t runNumber)
   // try previous value ...
   if (fRI >= 0 && fRunNumbers[fRI] == runNumber) return;
 
+  // statistics of the previous run go to the previous run histograms
+  FlushCellRunStats();
+  if (fCellRunStats.empty())
+    fCellRunStats.assign((fAbsIdMax-fAbsIdMin)*kNCellClasses*3, 0.);
+
   // ... or find current run index ...
   for (fRI = 0; fRI < fNRuns; fRI++)
     if (fRunNumbers[fRI] == runNumber) break;
@@ -598,22 +715,16 @@ void AliCaloCellsQA::FillCellsInCluster(TObjArray *clusArray, AliVCaloCells *cel
         Int_t absId = clus->GetCellAbsId(c);
 
         if (IsCellLocalMaximum(c, clus, cells)) {// local maximum
-          if (clus->E() < fClusEhighMin) {
-            fhCellLocMaxNTimesInClusterElow->Fill(absId);
-            fhCellLocMaxETotalClusterElow->Fill(absId, clus->E());
-          } else {
-            fhCellLocMaxNTimesInClusterEhigh->Fill(absId);
-            fhCellLocMaxETotalClusterEhigh->Fill(absId, clus->E());
-          }
+          if (clus->E() < fClusEhighMin)
+            FillCellRunStats(absId, kLocMaxElow, clus->E());
+          else
+            FillCellRunStats(absId, kLocMaxEhigh, clus->E());
         }
         else if (fkFullAnalysis) {// not a local maximum
-          if (clus->E() < fClusEhighMin) {
-            fhCellNonLocMaxNTimesInClusterElow->Fill(absId);
-            fhCellNonLocMaxETotalClusterElow->Fill(absId, clus->E());
-          } else {
-            fhCellNonLocMaxNTimesInClusterEhigh->Fill(absId);
-            fhCellNonLocMaxETotalClusterEhigh->Fill(absId, clus->E());
-          }
+          if (clus->E() < fClusEhighMin)
+            FillCellRunStats(absId, kNonLocMaxElow, clus->E());
+          else
+            FillCellRunStats(absId, kNonLocMaxEhigh, clus->E());
         }
       } // cells loop
   } // cluster loop
@@ -630,6 +741,22 @@ void AliCaloCellsQA::FillJustCells(AliVCaloCells *cells)
   Double_t amp, time,efrac;
   Int_t sm;
 
+  // amplitudes of the event by cell index, for the local maximum search among cells
+  Bool_t useEventAmp = kFALSE;
+  if (fhCellAmplitude && fkFullAnalysis) {
+    if (fCellSM.empty()) BuildCellTables();
+    if (!fCellGrid.empty()) {
+      useEventAmp = kTRUE;
+      fEventStamp++;
+      for (Short_t c = 0; c < cells->GetNumberOfCells(); c++) {
+        Int_t i = cells->GetCellNumber(c) - fAbsIdMin;
+        if (i < 0 || i >= fAbsIdMax - fAbsIdMin) continue;
+        fCellEventAmp[i] = cells->GetAmplitude(c);
+        fCellEventStamp[i] = fEventStamp;
+      }
+    }
+  }
+
   for (Short_t c = 0; c < cells->GetNumberOfCells(); c++) {
     cells->GetCell(c, absId, amp, time,mclabel,efrac);
     if ((sm = GetSM(absId)) < 0) continue;
@@ -642,7 +769,11 @@ void AliCaloCellsQA::FillJustCells(AliVCaloCells *cells)
       fhCellTime->Fill(absId, time);
 
       // fill not a local maximum distributions
-      if (fkFullAnalysis && !IsCellLocalMaximum(absId, cells)) {
+      Bool_t isLocMax = kTRUE;
+      if (fkFullAnalysis)
+        isLocMax = useEventAmp ? IsCellLocalMaximumInEvent(absId, cells->GetCellAmplitude(absId))
+                               : IsCellLocalMaximum(absId, cells);
+      if (!isLocMax) {
         fhCellAmplitudeNonLocMax->Fill(absId, amp);
         fhCellAmplitudeEhighNonLocMax->Fill(absId, amp);
       }
@@ -793,6 +924,69 @@ Bool_t AliCaloCellsQA::IsCellLocalMaximum(Int_t absId, AliVCaloCells* cells)
   return kTRUE;
 }
 
+//____________________________________________________________
+Bool_t AliCaloCellsQA::IsCellLocalMaximumInEvent(Int_t absId, Double_t amp)
+{
+  // Same as IsCellLocalMaximum(absId, cells), with the amplitudes of the event
+  // cells taken from fCellEventAmp: only the 8 neighbours are looked at.
+
+  Int_t sm, eta, phi;
+  AbsIdToSMEtaPhi(absId, sm, eta, phi);
+  if (sm < 0 || sm > 9 || eta < 0 || eta >= fGridNEta || phi < 0 || phi >= fGridNPhi) return kTRUE;
+
+  for (Int_t deta = -1; deta <= 1; deta++)
+    for (Int_t dphi = -1; dphi <= 1; dphi++) {
+      if (deta == 0 && dphi == 0) continue;
+      Int_t eta2 = eta + deta;
+      Int_t phi2 = phi + dphi;
+      if (eta2 < 0 || eta2 >= fGridNEta || phi2 < 0 || phi2 >= fGridNPhi) continue;
+
+      Int_t i2 = fCellGrid[(sm*fGridNEta + eta2)*fGridNPhi + phi2];
+      if (i2 < 0 || fCellEventStamp[i2] != fEventStamp) continue;
+      if (amp < fCellEventAmp[i2]) return kFALSE;
+    }
+
+  return kTRUE;
+}
+
+//____________________________________________________________
+void AliCaloCellsQA::BuildCellTables()
+{
+  // Fill the (sm, eta, phi) indices of all the cells and the inverse grid.
+  // Geometry must be already initialized.
+
+  Int_t ncells = fAbsIdMax - fAbsIdMin;
+  fCellSM.assign(ncells, -1);
+  fCellEta.assign(ncells, -1);
+  fCellPhi.assign(ncells, -1);
+  fCellEventAmp.assign(ncells, 0.);
+  fCellEventStamp.assign(ncells, 0);
+  fEventStamp = 0;
+
+  Int_t maxeta = -1, maxphi = -1;
+  for (Int_t i = 0; i < ncells; i++) {
+    Int_t sm = -1, eta = -1, phi = -1;
+    if (!ComputeSMEtaPhi(i + fAbsIdMin, sm, eta, phi)) continue;
+    if (sm < 0 || sm > 9 || eta < 0 || phi < 0) continue;
+
+    fCellSM[i] = sm;
+    fCellEta[i] = eta;
+    fCellPhi[i] = phi;
+    if (eta > maxeta) maxeta = eta;
+    if (phi > maxphi) maxphi = phi;
+  }
+
+  fGridNEta = maxeta + 1;
+  fGridNPhi = maxphi + 1;
+  fCellGrid.clear();
+  if (fGridNEta == 0 || fGridNPhi == 0) return;
+
+  fCellGrid.assign(10*fGridNEta*fGridNPhi, -1);
+  for (Int_t i = 0; i < ncells; i++)
+    if (fCellSM[i] >= 0)
+      fCellGrid[(fCellSM[i]*fGridNEta + fCellEta[i])*fGridNPhi + fCellPhi[i]] = i;
+}
+
 //____________________________________________________________
 void AliCaloCellsQA::AbsIdToSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &phi)
 {
@@ -800,6 +994,25 @@ void AliCaloCellsQA::AbsIdToSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &
   // Works both for EMCAL and for PHOS.
   // Geometry must be already initialized.
 
+  if (fCellSM.empty()) BuildCellTables();
+
+  Int_t i = absId - fAbsIdMin;
+  if (i >= 0 && i < (Int_t) fCellSM.size() && fCellSM[i] >= 0) {
+    sm = fCellSM[i];
+    eta = fCellEta[i];
+    phi = fCellPhi[i];
+    return;
+  }
+
+  ComputeSMEtaPhi(absId, sm, eta, phi);
+}
+
+//____________________________________________________________
+Bool_t AliCaloCellsQA::ComputeSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &phi)
+{
+  // Converts absId --> (sm, eta, phi) for a cell from the geometry.
+  // Returns false if the geometry does not know the cell.
+
   // EMCAL
   if (fDetector == kEMCAL) {
     AliEMCALGeometry *geomEMCAL = AliEMCALGeometry::GetInstance();
@@ -807,9 +1020,9 @@ void AliCaloCellsQA::AbsIdToSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &
       AliFatal("EMCAL geometry is not initialized");
 
     Int_t nModule, nIphi, nIeta;
-    geomEMCAL->GetCellIndex(absId, sm, nModule, nIphi, nIeta);
+    Bool_t ok = geomEMCAL->GetCellIndex(absId, sm, nModule, nIphi, nIeta);
     geomEMCAL->GetCellPhiEtaIndexInSModule(sm, nModule, nIphi, nIeta, phi, eta);
-    return;
+    return ok;
   }
 
   // PHOS
@@ -819,12 +1032,14 @@ void AliCaloCellsQA::AbsIdToSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &
       AliFatal("PHOS geometry is not initialized");
 
     Int_t relid[4];
-    geomPHOS->AbsToRelNumbering(absId, relid);
+    Bool_t ok = geomPHOS->AbsToRelNumbering(absId, relid);
     sm = relid[0];
     eta = relid[2];
     phi = relid[3];
+    return ok;
   }
 
   // DCAL
   // not implemented
+  return kFALSE;
 }
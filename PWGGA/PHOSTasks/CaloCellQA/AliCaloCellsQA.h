@@ -9,6 +9,7 @@
 #define ALICALOCELLSQA_H
 
 // --- ROOT system ---
+#include <vector>
 #include <TObjArray.h>
 #include <TH1D.h>
 #include <TH1F.h>
@@ -42,6 +43,7 @@ public:
   virtual void InitTransientFindCurrentRun(Int_t runNumber);
   virtual void Fill(Int_t runNumber, TObjArray *clusArray, AliVCaloCells *cells, Double_t vertexXYZ[3]);  // main method
   virtual void FillTimeDDL(TObjArray *clusArray, UShort_t BC);
+  virtual void FlushCellRunStats();
   
   // getters
   virtual Int_t      GetDetector()     { return fDetector; }
@@ -51,7 +53,7 @@ public:
   virtual Double_t   GetPi0EClusMin()  { return fPi0EClusMin; }
   virtual Bool_t     GetFullAnalysis() { return fkFullAnalysis; }
 
-  virtual TObjArray* GetListOfHistos() { return fListOfHistos; }
+  virtual TObjArray* GetListOfHistos();
 
   // setters
   virtual void SetClusterEnergyCuts(Double_t pi0EClusMin = 0.5, Double_t ElowMin = 0.3, Double_t EhighMin = 1.0);
@@ -75,6 +77,12 @@ protected:
   virtual void    AbsIdToSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &phi);
   
   Int_t WhichDDL(Int_t module, Int_t cellx);
+
+  Bool_t  ComputeSMEtaPhi(Int_t absId, Int_t &sm, Int_t &eta, Int_t &phi);
+  void    BuildCellTables();
+  Bool_t  IsCellLocalMaximumInEvent(Int_t absId, Double_t amp);
+  void    FillCellRunStats(Int_t absId, Int_t cls, Double_t eclus);
+  void    GetCellRunHistos(Int_t cls, TH1F *&hN, TH1F *&hE);
   
 private:
 
@@ -111,6 +119,35 @@ private:
 
   TObjArray  *fListOfHistos;            // array with all the histograms
 
+  // classes of cells in clusters, see FillCellsInCluster()
+  enum {
+    kLocMaxElow = 0,
+    kLocMaxEhigh,
+    kNonLocMaxElow,
+    kNonLocMaxEhigh,
+    kNCellClasses
+  };
+
+  /* Dense per cell tables, indexed by absId - fAbsIdMin.
+   *
+   * The (sm, eta, phi) indices of the cells are taken from the geometry only once.
+   * The statistics of cells in clusters (number of times and cluster energy sums,
+   * per cell class) of the current run are accumulated in fCellRunStats and only
+   * added to the per run histograms by FlushCellRunStats(): at a run change and
+   * when the list of histograms is requested.
+   */
+  std::vector<Int_t>    fCellSM;              //! supermodule per cell, -1 if not a valid cell
+  std::vector<Int_t>    fCellEta;             //! eta index per cell
+  std::vector<Int_t>    fCellPhi;             //! phi index per cell
+  std::vector<Int_t>    fCellGrid;            //! cell index for (sm, eta, phi), -1 if none
+  Int_t                 fGridNEta;            //! eta dimension of fCellGrid
+  Int_t                 fGridNPhi;            //! phi dimension of fCellGrid
+  std::vector<Double_t> fCellEventAmp;        //! cell amplitude in the current event
+  std::vector<Int_t>    fCellEventStamp;      //! value of fEventStamp when fCellEventAmp was set
+  Int_t                 fEventStamp;          //! counter of events with filled fCellEventAmp
+  std::vector<Double_t> fCellRunStats;        //! per cell and class: number of times, sum and sum of squares of cluster energy
+  Bool_t                fCellRunStatsFilled;  //! fCellRunStats contains statistics not yet in the histograms
+
 
   /* All the histograms below are present in fListOfHistos.
    *
@@ -144,7 +181,7 @@ private:
   TH2F *fhCellAmplitudeEhighNonLocMax;        //! amplitude distribution per not a local maximum cell, high energies
   TH2F *fhCellTime;                           //! time distribution per cell
 
-  ClassDef(AliCaloCellsQA,2)
+  ClassDef(AliCaloCellsQA,3)
 };
 
 #endif
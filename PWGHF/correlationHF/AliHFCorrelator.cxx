@@ -91,7 +91,12 @@ fnMultBinLimits(1),
 fMultBinLimits(0),
 fMinMultCand(-1.),
 fMaxMultCand(100000.),
-fStoreInfoSoftPiME(kFALSE)
+fStoreInfoSoftPiME(kFALSE),
+fUsePackedPool(kFALSE),
+fPackedPools(0x0),
+fPackedPool(0x0),
+fPackedPart(0x0),
+fPackedEventStart(0)
 {
 	// default constructor	
 }
@@ -142,7 +147,12 @@ fnMultBinLimits(1),
 fMultBinLimits(0),
 fMinMultCand(-1.),
 fMaxMultCand(100000.),
-fStoreInfoSoftPiME(kFALSE)
+fStoreInfoSoftPiME(kFALSE),
+fUsePackedPool(kFALSE),
+fPackedPools(0x0),
+fPackedPool(0x0),
+fPackedPart(0x0),
+fPackedEventStart(0)
 {
 	fhadcuts = cuts;
      if(!fDMesonCutObject) AliInfo("D meson cut object not loaded - if using centrality the estimator will be V0M!");
@@ -192,7 +202,12 @@ fnMultBinLimits(1),
 fMultBinLimits(0),
 fMinMultCand(-1.),
 fMaxMultCand(100000.),
-fStoreInfoSoftPiME(kFALSE)
+fStoreInfoSoftPiME(kFALSE),
+fUsePackedPool(kFALSE),
+fPackedPools(0x0),
+fPackedPool(0x0),
+fPackedPart(0x0),
+fPackedEventStart(0)
 {
 	fhadcuts = cuts;
     fDMesonCutObject = cutObject;
@@ -216,7 +231,7 @@ AliHFCorrelator::~AliHFCorrelator()
     if(fDMesonCutObject) {delete fDMesonCutObject; fDMesonCutObject=0;}
 	if(fAssociatedTracks) {delete fAssociatedTracks; fAssociatedTracks=0;}
 	if(fmcArray) {delete fmcArray; fmcArray=0;}
-	if(fReducedPart) {delete fReducedPart; fReducedPart=0;}
+	if(fReducedPart && fReducedPart!=fPackedPart) {delete fReducedPart; fReducedPart=0;}
 	if(fD0cand) {delete fD0cand; fD0cand=0;}
 	
 	
@@ -234,6 +249,8 @@ AliHFCorrelator::~AliHFCorrelator()
 	
 	if(fk0InvMass) fk0InvMass=0;
 	if(fMultBinLimits) {delete [] fMultBinLimits; fMultBinLimits=0;}
+	if(fPackedPools) {delete fPackedPools; fPackedPools=0;}
+	if(fPackedPart) {delete fPackedPart; fPackedPart=0;}
 }
 
 //---------------------------------------------------------------------------
@@ -276,10 +293,25 @@ Bool_t AliHFCorrelator::DefineEventPool(){
 	Double_t *ZVrtxBins = fhadcuts->GetZvtxPoolBins();
 		
 			
+	Double_t targetFrac = fhadcuts->GetTargetFracTracks();
+
+	if(fUsePackedPool && fselect==kElectron) {
+		AliInfo("Packed pools are not available for electrons (reduced particles with D-meson info), using AliEventPoolManager");
+		fUsePackedPool = kFALSE;
+	}
+	if(fUsePackedPool) { // one packed pool per (multiplicity, zVtx) bin, index iCent+iZ*NofCentBins
+		fPackedPools = new TObjArray(NofCentBins*NofZVrtxBins);
+		fPackedPools->SetOwner(kTRUE);
+		for(int j=0;j<NofZVrtxBins;j++) {
+			for(int i=0;i<NofCentBins;i++) fPackedPools->AddAt(new AliHFPackedEventPool(MaxNofEvents,MinNofTracks,targetFrac,fStoreInfoSoftPiME),i+j*NofCentBins);
+		}
+		fPackedPart = new AliReducedParticle();
+		return kTRUE;
+	}
+
 	fPoolMgr = new AliEventPoolManager(MaxNofEvents, MinNofTracks, NofCentBins, CentBins, NofZVrtxBins, ZVrtxBins);
 	if(!fPoolMgr) return kFALSE;
 
-	Double_t targetFrac = fhadcuts->GetTargetFracTracks();
         for(int i=0;i<NofCentBins;i++) {
           for(int j=0;j<NofZVrtxBins;j++) {
              fPoolMgr->GetEventPool(i,j)->SetTargetTrackDepth(MinNofTracks,targetFrac);
@@ -335,6 +367,21 @@ Bool_t AliHFCorrelator::Initialize(){
 			return kFALSE;
 		}
 	
+	if(fUsePackedPool) {
+		fPackedPool = 0x0;
+		Int_t nCentBins = fhadcuts->GetNCentPoolBins(), nZBins = fhadcuts->GetNZvtxPoolBins();
+		Double_t *ZVrtxBins = fhadcuts->GetZvtxPoolBins();
+		Int_t iCent = -1, iZ = -1;
+		for(Int_t i=0; i<nCentBins; i++) if(fMultCentr>=CentBins[i] && (fMultCentr<CentBins[i+1] || i==nCentBins-1)) {iCent=i; break;}
+		for(Int_t j=0; j<nZBins; j++) if(zvertex>=ZVrtxBins[j] && (zvertex<ZVrtxBins[j+1] || (j==nZBins-1 && zvertex==ZVrtxBins[j+1]))) {iZ=j; break;}
+		if(iCent>=0 && iZ>=0) fPackedPool = (AliHFPackedEventPool*)fPackedPools->At(iCent+iZ*nCentBins);
+		if(!fPackedPool) {
+			AliInfo(Form("No pool found for multiplicity = %f, zVtx = %f cm", fMultCentr, zvertex));
+			return kFALSE;
+		}
+		return kTRUE;
+	}
+
 	fPool = fPoolMgr->GetEventPool(fMultCentr, zvertex);
 	
 	if (!fPool){
@@ -350,6 +397,12 @@ Bool_t AliHFCorrelator::ProcessEventPool(){
 	 // analysis on Mixed Events
 	//cout << "AliHFCorrelator::ProcessEventPool"<< endl;
 		if(!fmixing) return kFALSE;
+		if(fUsePackedPool) {
+			if(!fPackedPool || !fPackedPool->IsReady()) return kFALSE;
+			if(fPackedPool->GetCurrentNEvents()<fhadcuts->GetMinEventsToMix()) return kFALSE;
+			fPoolContent = fPackedPool->GetCurrentNEvents();
+			return kTRUE;
+		}
 		if(!fPool->IsReady()) return kFALSE;
 		if(fPool->GetCurrentNEvents()<fhadcuts->GetMinEventsToMix()) return kFALSE;
 	//	fPool->PrintInfo();
@@ -383,6 +436,13 @@ Bool_t AliHFCorrelator::ProcessAssociatedTracks(Int_t EventLoopIndex, const TObj
     
   }
   
+  if(fmixing && fUsePackedPool) { // analysis on Mixed Events, packed pool: no object is retrieved
+    if(!fPackedPool || EventLoopIndex<0 || EventLoopIndex>=fPackedPool->GetCurrentNEvents()) return kFALSE;
+    fPackedEventStart = fPackedPool->GetEventStart(EventLoopIndex);
+    fNofTracks = fPackedPool->GetNTracksInEvent(EventLoopIndex);
+    return kTRUE;
+  }
+
   if(fmixing) { // analysis on Mixed Events
 		
 			
@@ -404,6 +464,16 @@ Bool_t AliHFCorrelator::ProcessAssociatedTracks(Int_t EventLoopIndex, const TObj
 Bool_t AliHFCorrelator::Correlate(Int_t loopindex){
 
 	if(loopindex >= fNofTracks) return kFALSE;
+
+	if(fmixing && fUsePackedPool) { // read from the packed columns, the unpacked particle is reused
+		Int_t iTrack = fPackedEventStart+loopindex;
+		fDeltaPhi = SetCorrectPhiRange(fPhiTrigger - fPackedPool->GetPhi()[iTrack]);
+		fDeltaEta = fEtaTrigger - fPackedPool->GetEta()[iTrack];
+		fPackedPool->GetParticle(iTrack,*fPackedPart);
+		fReducedPart = fPackedPart;
+		return kTRUE;
+	}
+
 	if(!fAssociatedTracks) return kFALSE;
 	
 	fReducedPart = (AliReducedParticle*)fAssociatedTracks->At(loopindex);
@@ -421,6 +491,17 @@ Bool_t AliHFCorrelator::Correlate(Int_t loopindex){
 Bool_t AliHFCorrelator::PoolUpdate(const TObjArray* associatedTracks){
 
 	if(!fmixing) return kFALSE;
+	if(fUsePackedPool) { // the reduced particles are packed in the pool and deleted
+		if(!fPackedPool) return kFALSE;
+		TObjArray* objArr = NULL;
+		if(fselect==kHadron || fselect==kKaon) objArr = (TObjArray*)AcceptAndReduceTracks(fAODEvent);
+		else if(fselect==kKZero) objArr = (TObjArray*)AcceptAndReduceKZero(fAODEvent);
+		else return kFALSE;
+		if(objArr->GetEntriesFast()>0) fPackedPool->UpdatePool(objArr);
+		objArr->Delete();
+		delete objArr;
+		return kTRUE;
+	}
 	if(!fPool) return kFALSE;
 	if(fmixing) { // update the pool for Event Mixing
 		TObjArray* objArr = NULL;
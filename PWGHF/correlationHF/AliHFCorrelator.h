@@ -34,6 +34,7 @@
 #include "AliEventPoolManager.h"
 #include "AliVParticle.h"
 #include "AliReducedParticle.h"
+#include "AliHFPackedEventPool.h"
 #include "AliVertexingHFUtils.h"
 #include "AliRDHFCuts.h"
 
@@ -98,9 +99,11 @@ class AliHFCorrelator : public TNamed
 	Double_t SetCorrectPhiRange(Double_t phi); // sets all the angles in the correct range
 	void SetPidAssociated() {fhadcuts->SetPidAssociated();}
     	void SetStoreInfoSoftPiME(Bool_t storeInfoSoftPiME) {fStoreInfoSoftPiME=storeInfoSoftPiME;}
+	void SetUsePackedPool(Bool_t usePacked=kTRUE) {fUsePackedPool=usePacked;} // mixed events stored in AliHFPackedEventPool (to be set before DefineEventPool)
 
 	//getters
 	AliEventPool* GetPool() {return fPool;}
+	AliHFPackedEventPool* GetPackedPool() {return fPackedPool;}
 	TObjArray * GetTrackArray(){return fAssociatedTracks;}
 	AliHFAssociatedTrackCuts* GetSelectionCuts() {return fhadcuts;}
 	AliReducedParticle* GetAssociatedParticle() {return fReducedPart;}
@@ -176,7 +179,13 @@ class AliHFCorrelator : public TNamed
 
     Bool_t fStoreInfoSoftPiME; //save info on px, py, pz, E to use soft-pi cut in ME online analysis
 
-	ClassDef(AliHFCorrelator,4); // class for HF correlations
+	Bool_t fUsePackedPool; // use packed pools instead of AliEventPoolManager for event mixing
+	TObjArray* fPackedPools; //! packed pools, one per (multiplicity, zVtx) bin
+	AliHFPackedEventPool* fPackedPool; //! packed pool of the current event
+	AliReducedParticle* fPackedPart; //! associated particle unpacked from fPackedPool
+	Int_t fPackedEventStart; //! first track of the mixed event in fPackedPool
+
+	ClassDef(AliHFCorrelator,5); // class for HF correlations
 };
 
 
@@ -23,6 +23,7 @@
 //  fabio.colamaria@cern.ch
 //-----------------------------------------------------------------------
 
+#include <algorithm>
 #include "AliHFOfflineCorrelator.h"
 
 //___________________________________________________________________________________________
@@ -115,7 +116,8 @@ fNameCutObj(0),
 fUseEff(0),
 fMake2DPlots(kFALSE),
 fWeightPeriods(kTRUE),
-fRejectSoftPi(kTRUE)
+fRejectSoftPi(kTRUE),
+fBulkCorrelation(kFALSE)
 {
 
 }
@@ -171,7 +173,8 @@ fNameCutObj(source.fNameCutObj),
 fUseEff(source.fUseEff),
 fMake2DPlots(source.fMake2DPlots),
 fWeightPeriods(source.fWeightPeriods),
-fRejectSoftPi(source.fRejectSoftPi)
+fRejectSoftPi(source.fRejectSoftPi),
+fBulkCorrelation(source.fBulkCorrelation)
 {
 
 }
@@ -231,6 +234,7 @@ fUseEff = orig.fUseEff;
 fMake2DPlots = orig.fMake2DPlots;
 fWeightPeriods = orig.fWeightPeriods;
 fRejectSoftPi = orig.fRejectSoftPi;
+fBulkCorrelation = orig.fBulkCorrelation;
 
 return *this; //returns pointer of the class
 }
@@ -459,7 +463,7 @@ Bool_t AliHFOfflineCorrelator::Correlate() {
   }
 
   for(Int_t iFile=0; iFile<(int)fFileList.size(); iFile++) {
-    Bool_t success = CorrelateSingleFile(iFile);
+    Bool_t success = fBulkCorrelation ? CorrelateSingleFileBulk(iFile) : CorrelateSingleFile(iFile);
     if(!success) {
       std::cout << "Error in the evaluation of correlations for file #" << iFile << ". Exiting..." << std::endl;
       return kFALSE;
@@ -476,7 +480,7 @@ Bool_t AliHFOfflineCorrelator::Correlate() {
 }
 
 //___________________________________________________________________________________________
-Bool_t AliHFOfflineCorrelator::CorrelateSingleFile(Int_t iFile) {
+Bool_t AliHFOfflineCorrelator::OpenInputFile(Int_t iFile) {
 
   std::cout << "Opening file: " << fFileList.at(iFile) << std::endl;
 
@@ -517,6 +521,14 @@ Bool_t AliHFOfflineCorrelator::CorrelateSingleFile(Int_t iFile) {
     }  
   }
 
+  return kTRUE;
+}
+
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelator::CorrelateSingleFile(Int_t iFile) {
+
+  if(!OpenInputFile(iFile)) return kFALSE;
+
   AliHFCorrelationBranchD *brD = 0;
   AliHFCorrelationBranchTr *brTr = 0;
 
@@ -690,6 +702,289 @@ Bool_t AliHFOfflineCorrelator::CorrelateSingleFile(Int_t iFile) {
   return kTRUE;
 }
 
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelator::CorrelateSingleFileBulk(Int_t iFile) {
+  //
+  // Same output as CorrelateSingleFile, but the track TTree is read only once per file: the
+  // selected tracks are packed in one array per variable, sorted by event (SE) or by pool (ME).
+  // Each D meson is then correlated with a contiguous block of tracks, with deltaPhi and deltaEta
+  // evaluated in a single loop on the block, and the output plots are looked up once per file.
+  // The order of the pairs, the random ranges of fMaxTracks and the weights are the same
+  //
+
+  if(!OpenInputFile(iFile)) return kFALSE;
+
+  AliHFCorrelationBranchD *brD = 0;
+  AliHFCorrelationBranchTr *brTr = 0;
+
+  fTreeD->SetBranchAddress("branchD",&brD);
+  fTreeTr->SetBranchAddress("branchTr",&brTr);
+
+  std::cout << "File contains a total of " << fTreeD->GetEntries() << " D mesons and of " << fTreeTr->GetEntries() << " associated tracks" << std::endl;
+  std::cout << "Correlating (bulk mode)..." << std::endl;
+
+  Int_t poolD = 0;
+  Int_t minDLoop = 0, maxDLoop = fTreeD->GetEntries();
+  Int_t minTrackLoop = 0, maxTrackLoop = fTreeTr->GetEntries();
+
+  if(fMinD>=0) minDLoop=fMinD;
+  if(fMaxD>=0) maxDLoop=fMaxD;
+  if(fMinD>fMaxD) {printf("Warning! Wrong settings of D-meson loop edges! Exiting...\n"); return kFALSE;}
+  if(fMinD>fTreeD->GetEntries()) {printf("Warning! The lower edge of D meson loop exceeds the number of D in the TTree! No loop will be done\n"); return kTRUE;}
+  if(fMaxD>fTreeD->GetEntries()) {printf("Warning! The upper edge of D meson loop exceeds the number of D in the TTree!\n"); maxDLoop = fTreeD->GetEntries();}
+
+  //Output plots, looked up once
+  const Int_t nRng = (Int_t)fPtBinsTrLow.size();
+  const Int_t nHist = fNBinsPt*nRng*fnPools;
+  std::vector<TH1F*> hMass(fNBinsPt,0), hMassEff(fNBinsPt,0);
+  std::vector<TH3F*> h3D(nHist,0), h3Dsp(nHist,0);
+  std::vector<TH2F*> h2DSign(nHist,0), h2DSignsp(nHist,0), h2DSB(nHist,0), h2DSBsp(nHist,0);
+  std::vector<TH1F*> hEtaD(nHist,0), hEtaTr(nHist,0), hEtaDSign(nHist,0), hEtaTrSign(nHist,0), hEtaDSB(nHist,0), hEtaTrSB(nHist,0);
+  for(Int_t iBin=0; iBin<fNBinsPt; iBin++) {
+    hMass[iBin] = (TH1F*)fOutputMass->FindObject(Form("histMass_%d",fFirstBinNum+iBin));
+    if(fUseEff) hMassEff[iBin] = (TH1F*)fOutputMass->FindObject(Form("histMass_WeigD0Eff_%d",fFirstBinNum+iBin));
+    for(Int_t iRng=0; iRng<nRng; iRng++) {
+      for(Int_t iPool=0; iPool<fnPools; iPool++) {
+        Int_t iH = (iBin*nRng+iRng)*fnPools+iPool;
+        TString suffix = Form("_Bin%d_%1.1fto%1.1f_p%d",fFirstBinNum+iBin,fPtBinsTrLow.at(iRng),fPtBinsTrUp.at(iRng),iPool);
+        h3D[iH] = (TH3F*)fOutputDistr->FindObject(Form("h3DCorrelations%s",suffix.Data()));
+        if(fAnType==kME) h3Dsp[iH] = (TH3F*)fOutputDistr->FindObject(Form("h3DCorrelations%s_softpiME",suffix.Data()));
+        if(fMake2DPlots) {
+          h2DSign[iH] = (TH2F*)fOutputDistr->FindObject(Form("h2DCorrelations_Sign%s",suffix.Data()));
+          h2DSB[iH] = (TH2F*)fOutputDistr->FindObject(Form("h2DCorrelations_SB%s",suffix.Data()));
+          if(fAnType==kME) {
+            h2DSignsp[iH] = (TH2F*)fOutputDistr->FindObject(Form("h2DCorrelations_Sign%s_softpiME",suffix.Data()));
+            h2DSBsp[iH] = (TH2F*)fOutputDistr->FindObject(Form("h2DCorrelations_SB%s_softpiME",suffix.Data()));
+          }
+        }
+        if(fDebug) {
+          hEtaD[iH] = (TH1F*)fOutputDistr->FindObject(Form("hEtaD%s",suffix.Data()));
+          hEtaTr[iH] = (TH1F*)fOutputDistr->FindObject(Form("hEtaTr%s",suffix.Data()));
+          if(fMake2DPlots) {
+            hEtaDSign[iH] = (TH1F*)fOutputDistr->FindObject(Form("hEtaD_Sign%s",suffix.Data()));
+            hEtaTrSign[iH] = (TH1F*)fOutputDistr->FindObject(Form("hEtaTr_Sign%s",suffix.Data()));
+            hEtaDSB[iH] = (TH1F*)fOutputDistr->FindObject(Form("hEtaD_SB%s",suffix.Data()));
+            hEtaTrSB[iH] = (TH1F*)fOutputDistr->FindObject(Form("hEtaTr_SB%s",suffix.Data()));
+          }
+        }
+      }
+    }
+  }
+
+  //Single pass on the track TTree: selection, centrality and pool do not depend on the D meson,
+  //and a track with a wrong pool is never correlated
+  std::vector<std::pair<std::pair<UInt_t,ULong64_t>,Int_t> > sortKeys; //(SE: period, orbit+BC; ME: pool), index of the selected track
+  std::vector<AliHFCorrelationBranchTr> selTracks;
+  std::vector<Int_t> selPool, selIndex;
+  std::vector<Double_t> selEff;
+  std::vector<Bool_t> selEffInRange;
+  for(Int_t iTr=0; iTr<fTreeTr->GetEntries(); iTr++) {
+    fTreeTr->GetEntry(iTr);
+    if(fNumSelTr>=0 && (brTr->sel_Tr>>fNumSelTr)%2!=1) continue;
+    if(fMinCent!=0 && fMaxCent!=0) {if(brTr->cent_Tr < fMinCent || brTr->cent_Tr > fMaxCent) continue;}
+    Int_t poolTr = GetPoolBin(brTr->mult_Tr,brTr->zVtx_Tr);
+    if(poolTr<0) continue;
+    Int_t iSel = (Int_t)selTracks.size();
+    selTracks.push_back(*brTr);
+    selPool.push_back(poolTr);
+    selIndex.push_back(iTr);
+    Double_t effTr = 1.;
+    Bool_t inRange = kTRUE;
+    if(fUseEff) {
+      Int_t binTr=fMapEffTr->FindBin(brTr->pT_Tr,brTr->eta_Tr,brTr->zVtx_Tr);
+      if(fMapEffTr->IsBinUnderflow(binTr)||fMapEffTr->IsBinOverflow(binTr)) inRange = kFALSE;
+      else effTr = fMapEffTr->GetBinContent(binTr);
+    }
+    selEff.push_back(effTr);
+    selEffInRange.push_back(inRange);
+    if(fAnType==kSE) sortKeys.push_back(std::make_pair(std::make_pair(brTr->period_Tr,((ULong64_t)brTr->orbit_Tr<<16)|brTr->BC_Tr),iSel));
+    else sortKeys.push_back(std::make_pair(std::make_pair((UInt_t)poolTr,(ULong64_t)0),iSel));
+  }
+  std::sort(sortKeys.begin(),sortKeys.end()); //ties are resolved by tree index, so the track order inside a group is the tree order
+
+  //Packed arrays, in group order, and first track of each group
+  const Int_t nSel = (Int_t)sortKeys.size();
+  std::vector<Float_t> trPhi(nSel), trEta(nSel), trPt(nSel);
+  std::vector<Int_t> trIndex(nSel), trPool(nSel);
+  std::vector<Short_t> trID1(nSel), trID2(nSel), trID3(nSel), trID4(nSel);
+  std::vector<UInt_t> trPeriod(nSel), trOrbit(nSel);
+  std::vector<UShort_t> trBC(nSel);
+  std::vector<Double_t> trEff(nSel);
+  std::vector<Bool_t> trEffInRange(nSel);
+  std::vector<std::pair<UInt_t,ULong64_t> > groupKey;
+  std::vector<Int_t> groupStart;
+  for(Int_t i=0; i<nSel; i++) {
+    Int_t iSel = sortKeys[i].second;
+    const AliHFCorrelationBranchTr &tr = selTracks[iSel];
+    trPhi[i] = tr.phi_Tr; trEta[i] = tr.eta_Tr; trPt[i] = tr.pT_Tr;
+    trPool[i] = selPool[iSel];
+    trIndex[i] = selIndex[iSel];
+    trID1[i] = tr.IDtrig_Tr; trID2[i] = tr.IDtrig2_Tr; trID3[i] = tr.IDtrig3_Tr; trID4[i] = tr.IDtrig4_Tr;
+    trPeriod[i] = tr.period_Tr; trOrbit[i] = tr.orbit_Tr; trBC[i] = tr.BC_Tr;
+    trEff[i] = selEff[iSel]; trEffInRange[i] = selEffInRange[iSel];
+    if(i==0 || sortKeys[i].first!=sortKeys[i-1].first) {
+      groupKey.push_back(sortKeys[i].first);
+      groupStart.push_back(i);
+    }
+  }
+  groupStart.push_back(nSel);
+  std::vector<AliHFCorrelationBranchTr>().swap(selTracks);
+  std::cout << nSel << " associated tracks packed in " << groupKey.size() << (fAnType==kSE ? " events" : " pools") << std::endl;
+
+  std::vector<Double_t> dPhi, dEta;
+
+  TRandom3 *tRnd = new TRandom3();
+  tRnd->SetSeed(1);
+
+  TStopwatch *tim = new TStopwatch();
+  tim->Start();
+
+  for(Int_t iD=minDLoop; iD<maxDLoop; iD++) {  //loop on D-mesons in tree   
+
+    //time monitoring
+    if(iD%10==0) {
+      tim->Stop();
+      std::cout << "--- D-meson " << iD << std::endl;
+      tim->Print();
+      tim->Continue();
+    }
+
+    fTreeD->GetEntry(iD); 
+    Int_t ptBinD = PtBin(brD->pT_D);
+    if(ptBinD<0) continue;  
+    if(fNumSelD>=0 && (brD->sel_D>>fNumSelD)%2!=1) continue; //important in case of multiple selection (default selection is 0)
+    if(fMinCent!=0 && fMaxCent!=0) {if(brD->cent_D < fMinCent || brD->cent_D > fMaxCent) continue;} //skip triggers outside centrality range
+    
+    poolD = GetPoolBin(brD->mult_D,brD->zVtx_D); 
+
+    if(fMaxTracks>0) { //select random range of 'fMaxTracks' tracks in the TTree of tracks (the range changes for each D meson to use all the sample)
+      if(fMaxTracks>=fTreeTr->GetEntries()) printf("Warning! Requested to loop on more tracks than the available number! Standard loop being done\n");
+      else {
+        minTrackLoop = tRnd->Rndm()*(fTreeTr->GetEntries()-fMaxTracks);
+        maxTrackLoop = fMaxTracks+minTrackLoop;
+      }
+    }
+
+    std::vector<Int_t> fillOnce(nRng,0);
+
+    //Fill mass plots
+    hMass[ptBinD]->Fill(brD->invMass_D);
+    Double_t effD = 1.;
+    Bool_t effDInRange = kTRUE;
+    if(fUseEff) {
+      hMassEff[ptBinD]->Fill(brD->invMass_D,GetEfficiencyWeightDOnly(brD));
+      Int_t binD=fMapEffD->FindBin(brD->pT_D,brD->mult_D);
+      if(fMapEffD->IsBinUnderflow(binD)||fMapEffD->IsBinOverflow(binD)) effDInRange = kFALSE;
+      else effD = fMapEffD->GetBinContent(binD);
+    }
+    if(poolD<0) continue;  //no track can match a wrong pool
+
+    //Block of tracks to be correlated: same event (SE) or same pool (ME)
+    std::pair<UInt_t,ULong64_t> key = (fAnType==kSE) ? std::make_pair(brD->period_D,((ULong64_t)brD->orbit_D<<16)|brD->BC_D) : std::make_pair((UInt_t)poolD,(ULong64_t)0);
+    std::vector<std::pair<UInt_t,ULong64_t> >::iterator itGroup = std::lower_bound(groupKey.begin(),groupKey.end(),key);
+    if(itGroup==groupKey.end() || *itGroup!=key) continue;
+    Int_t iGroup = itGroup-groupKey.begin();
+    const Int_t first = groupStart[iGroup], nBlock = groupStart[iGroup+1]-first;
+
+    //deltaPhi, deltaEta for the whole block (same arithmetic as GetCorrelationsValue)
+    if((Int_t)dPhi.size()<nBlock) {dPhi.resize(nBlock); dEta.resize(nBlock);}
+    const Float_t phiD = brD->phi_D, etaD = brD->eta_D;
+    const Float_t *phiTr = &trPhi[first], *etaTr = &trEta[first];
+    for(Int_t i=0; i<nBlock; i++) {
+      Double_t deltaPhi = phiD - phiTr[i];
+      if(deltaPhi < -TMath::Pi()/2.)   deltaPhi = deltaPhi + 2*TMath::Pi();
+      if(deltaPhi > 3.*TMath::Pi()/2.) deltaPhi = deltaPhi - 2*TMath::Pi();
+      dPhi[i] = deltaPhi;
+      dEta[i] = etaD - etaTr[i];
+    }
+
+    //Correlation plots!
+    for(Int_t i=0; i<nBlock; i++) {
+
+      Int_t it = first+i;
+      if(trIndex[it]<minTrackLoop || trIndex[it]>=maxTrackLoop) continue;
+      if(fAnType==kSE) {
+        if(brD->IDtrig_D==trID1[it] || brD->IDtrig_D==trID2[it] || brD->IDtrig_D==trID3[it] || brD->IDtrig_D==trID4[it]) continue; //skips D0 daughter association with their own trigger (or own soft-pion, for the D0)
+        if(trPool[it]!=poolD) continue;
+      } else {
+        if(brD->period_D==trPeriod[it] && brD->orbit_D==trOrbit[it] && brD->BC_D==trBC[it]) continue; //skips D and tracks from same event in ME
+      }
+
+      Double_t weight = 1.;
+      if(fUseEff && effDInRange && trEffInRange[it] && effD*trEff[it]!=0) weight = 1./(effD*trEff[it]); //efficiency weighting
+      if(fWeightPeriods && fAnType==kME) weight*=fPrdWeights.at(iFile); //period-by-period weighting
+      Double_t deltaPhi = dPhi[i], deltaEta = dEta[i];
+
+      Bool_t fillSoftpiME=kFALSE;
+      if(fRejectSoftPi && fDmesonSpecies==kD0toKpi) {
+        if(fAnType==kSE || (deltaPhi > -0.4 && deltaPhi < 0.4 && deltaEta > -0.4 && deltaEta < 0.4)) {
+          Double_t ptTr = trPt[it], phiTrk = trPhi[it], etaTrk = trEta[it];
+          Bool_t reject = IsSoftPionFromDstar(brD,ptTr*TMath::Cos(phiTrk),ptTr*TMath::Sin(phiTrk),ptTr*TMath::SinH(etaTrk));
+          if(fAnType==kSE && reject) continue; //reject softPi in SE events
+          if(fAnType==kME && reject) fillSoftpiME=kTRUE; //to fill histograms containing only fake softpi in ME analysis
+        }
+      }
+
+      for(Int_t iRng=0; iRng<nRng; iRng++) {  //loop on associated track ranges
+
+        //fill 3D and 2D correlation plots
+        if(trPt[it] < fPtBinsTrLow.at(iRng) || trPt[it] > fPtBinsTrUp.at(iRng)) continue; //skip cases where associated track pT is out of range
+        Int_t iH = (ptBinD*nRng+iRng)*fnPools+poolD;
+        h3D[iH]->Fill(deltaPhi,deltaEta,brD->invMass_D,weight);
+        if(fillSoftpiME) h3Dsp[iH]->Fill(deltaPhi,deltaEta,brD->invMass_D,weight);
+
+        Bool_t inSign = kFALSE, inSB1 = kFALSE, inSB2 = kFALSE;
+        if(fMake2DPlots) {
+          inSign = (brD->invMass_D > fMassSignL.at(ptBinD) && brD->invMass_D < fMassSignR.at(ptBinD));
+          inSB1 = (brD->invMass_D > fMassSB1L.at(ptBinD) && brD->invMass_D < fMassSB1R.at(ptBinD));
+          inSB2 = (fDmesonSpecies!=kDStarD0pi && (brD->invMass_D > fMassSB2L.at(ptBinD) && brD->invMass_D < fMassSB2R.at(ptBinD)));
+          if(inSign) {
+            h2DSign[iH]->Fill(deltaPhi,deltaEta,weight);
+            if(fillSoftpiME) h2DSignsp[iH]->Fill(deltaPhi,deltaEta,weight);
+          }
+          if(inSB1) {
+            h2DSB[iH]->Fill(deltaPhi,deltaEta,weight);
+            if(fillSoftpiME) h2DSBsp[iH]->Fill(deltaPhi,deltaEta,weight);
+          }
+          if(inSB2) {
+            h2DSB[iH]->Fill(deltaPhi,deltaEta,weight);
+            if(fillSoftpiME) h2DSBsp[iH]->Fill(deltaPhi,deltaEta,weight);
+          }
+        } //end if 2D plots
+
+        //***fill debug plots***
+        if(fDebug) {
+          if(fillOnce[iRng]==0) hEtaD[iH]->Fill(brD->eta_D);  //in the track loop, fill only once for D-meson!
+          hEtaTr[iH]->Fill(trEta[it]);  //fill at each track iteration for the tracks!
+          if(inSign) {
+            if(fillOnce[iRng]==0) hEtaDSign[iH]->Fill(brD->eta_D);
+            hEtaTrSign[iH]->Fill(trEta[it]);
+          }
+          if(inSB1) {
+            if(fillOnce[iRng]==0) hEtaDSB[iH]->Fill(brD->eta_D);
+            hEtaTrSB[iH]->Fill(trEta[it]);
+          }
+          if(inSB2) {
+            if(fillOnce[iRng]==0) hEtaDSB[iH]->Fill(brD->eta_D);
+            hEtaTrSB[iH]->Fill(trEta[it]);
+          }
+          fillOnce[iRng]++; //to avoid re-filling of D-meson debug plots with further tracks for the same meson
+        } //***end fill debug plots***
+
+      } //end ass track ranges
+    } //end ass track block
+  } //end D-meson loop
+
+  delete tRnd;
+  delete tim;
+
+  std::cout << "Done! Closing file." << std::endl;
+
+  fFile->TFile::Close();
+
+  return kTRUE;
+}
+
 //___________________________________________________________________________________________
 void AliHFOfflineCorrelator::GetCorrelationsValue(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr, Double_t &deltaPhi, Double_t &deltaEta) {
 
@@ -888,6 +1183,18 @@ Bool_t AliHFOfflineCorrelator::IsSoftPionFromDstar(AliHFCorrelationBranchD *brD,
 	// Calculates invmass of track+D0 and rejects if compatible with D*
 	// (to remove fake pions from D* in ME events, and true soft pions in SE the cut)
 	// 
+	Double_t pxTr = brTr->pT_Tr*TMath::Cos(brTr->phi_Tr);
+	Double_t pyTr = brTr->pT_Tr*TMath::Sin(brTr->phi_Tr);
+	Double_t pzTr = brTr->pT_Tr*TMath::SinH(brTr->eta_Tr);
+
+	return IsSoftPionFromDstar(brD,pxTr,pyTr,pzTr);
+}
+
+//___________________________________________________________________________________________
+Bool_t AliHFOfflineCorrelator::IsSoftPionFromDstar(AliHFCorrelationBranchD *brD, Double_t pxTr, Double_t pyTr, Double_t pzTr) {
+	//
+	// Same as above, with the track momentum given directly (used by the bulk correlation)
+	// 
 	Double_t nsigma = 3.;
 	
 	Double_t mPi = TDatabasePDG::Instance()->GetParticle(211)->Mass();
@@ -895,9 +1202,6 @@ Bool_t AliHFOfflineCorrelator::IsSoftPionFromDstar(AliHFCorrelationBranchD *brD,
 	Double_t pxD = brD->pT_D*TMath::Cos(brD->phi_D);
 	Double_t pyD = brD->pT_D*TMath::Sin(brD->phi_D);
 	Double_t pzD = brD->pT_D*TMath::SinH(brD->eta_D);
-	Double_t pxTr = brTr->pT_Tr*TMath::Cos(brTr->phi_Tr);
-	Double_t pyTr = brTr->pT_Tr*TMath::Sin(brTr->phi_Tr);
-	Double_t pzTr = brTr->pT_Tr*TMath::SinH(brTr->eta_Tr);
 	Double_t invmassDstar1 = 0, invmassDstar2 = 0; 
 	
 	//hyp 1 (pi,K) - D0
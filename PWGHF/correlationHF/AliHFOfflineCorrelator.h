@@ -124,16 +124,20 @@ public:
     void SetCentralitySelection(Double_t min, Double_t max) {fMinCent=min; fMaxCent=max;} //activated only if both values are != 0
     void SetRejectSoftPion(Bool_t store) {fRejectSoftPi=store;}
     void SetDebugLevel(Int_t deb=0) {fDebug=deb;}
+    void SetBulkCorrelation(Bool_t bulk=kTRUE) {fBulkCorrelation=bulk;} //reads the track tree once per file and correlates from packed arrays
 
     Bool_t Correlate();
 
     void DefineOutputObjects();
     void PrintCfg() const;
+    Bool_t OpenInputFile(Int_t iFile);
     Bool_t CorrelateSingleFile(Int_t iFile);
+    Bool_t CorrelateSingleFileBulk(Int_t iFile);
     void GetCorrelationsValue(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr, Double_t &deltaPhi, Double_t &deltaEta);
     Double_t GetEfficiencyWeight(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr);
     Double_t GetEfficiencyWeightDOnly(AliHFCorrelationBranchD *brD);
     Bool_t IsSoftPionFromDstar(AliHFCorrelationBranchD *brD, AliHFCorrelationBranchTr *brTr);
+    Bool_t IsSoftPionFromDstar(AliHFCorrelationBranchD *brD, Double_t pxTr, Double_t pyTr, Double_t pzTr);
     Int_t PtBin(Double_t pt) const;
     Int_t GetPoolBin(Double_t mult, Double_t zVtx) const;
     Bool_t DefinePeriodWeights();
@@ -201,8 +205,9 @@ private:
     Bool_t fMake2DPlots; 		//flag to produce 2D plots for sign.region and SB
     Bool_t fWeightPeriods;		//flag to weight periods in ME analysis with max number of tracks used
     Bool_t fRejectSoftPi;	     //flag to remove soft pions in SE and ME analysis for D0 meson (ME rejection is done in extraction code)
+    Bool_t fBulkCorrelation;	     //flag to use CorrelateSingleFileBulk instead of CorrelateSingleFile
 
-    ClassDef(AliHFOfflineCorrelator,4); // class for plotting HF correlations
+    ClassDef(AliHFOfflineCorrelator,5); // class for plotting HF correlations
 
 };
 
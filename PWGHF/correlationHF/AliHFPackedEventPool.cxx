@@ -0,0 +1,158 @@
+/**************************************************************************
+ * Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//
+//             Event pool for the mixed-event HF correlations with
+//             packed associated particles
+//
+//-----------------------------------------------------------------------
+
+/* $Id$ */
+
+#include "TObjArray.h"
+#include "AliReducedParticle.h"
+#include "AliHFPackedEventPool.h"
+
+ClassImp(AliHFPackedEventPool)
+
+//_____________________________________________________
+AliHFPackedEventPool::AliHFPackedEventPool() :
+TObject(),
+fMaxNEvents(0),
+fTargetTrackDepth(0),
+fTargetFraction(1.),
+fStoreMomentum(kFALSE),
+fNTracksInEvent(),
+fEventStart(),
+fEta(),
+fPhi(),
+fPt(),
+fWeight(),
+fImpPar(),
+fMcLabel(),
+fID(),
+fCharge(),
+fCheckSoftPi(),
+fPx(),
+fPy(),
+fPz(),
+fE()
+{
+  // default constructor
+}
+
+//_____________________________________________________
+AliHFPackedEventPool::AliHFPackedEventPool(Int_t maxNEvents, Int_t targetTrackDepth, Double_t targetFrac, Bool_t storeMomentum) :
+TObject(),
+fMaxNEvents(maxNEvents),
+fTargetTrackDepth(targetTrackDepth),
+fTargetFraction(targetFrac),
+fStoreMomentum(storeMomentum),
+fNTracksInEvent(),
+fEventStart(),
+fEta(),
+fPhi(),
+fPt(),
+fWeight(),
+fImpPar(),
+fMcLabel(),
+fID(),
+fCharge(),
+fCheckSoftPi(),
+fPx(),
+fPy(),
+fPz(),
+fE()
+{
+  // standard constructor
+}
+
+//_____________________________________________________
+void AliHFPackedEventPool::Clear(Option_t * /*opt*/){
+  // removes all the events
+  fNTracksInEvent.clear(); fEventStart.clear();
+  fEta.clear(); fPhi.clear(); fPt.clear(); fWeight.clear(); fImpPar.clear();
+  fMcLabel.clear(); fID.clear(); fCharge.clear(); fCheckSoftPi.clear();
+  fPx.clear(); fPy.clear(); fPz.clear(); fE.clear();
+}
+
+//_____________________________________________________
+void AliHFPackedEventPool::RemoveOldestEvent(){
+  // erases the tracks of the first event from all the columns
+  if(fNTracksInEvent.empty()) return;
+  Int_t n = fNTracksInEvent.front();
+  fNTracksInEvent.pop_front();
+  fEta.erase(fEta.begin(),fEta.begin()+n);
+  fPhi.erase(fPhi.begin(),fPhi.begin()+n);
+  fPt.erase(fPt.begin(),fPt.begin()+n);
+  fWeight.erase(fWeight.begin(),fWeight.begin()+n);
+  fImpPar.erase(fImpPar.begin(),fImpPar.begin()+n);
+  fMcLabel.erase(fMcLabel.begin(),fMcLabel.begin()+n);
+  fID.erase(fID.begin(),fID.begin()+n);
+  fCharge.erase(fCharge.begin(),fCharge.begin()+n);
+  fCheckSoftPi.erase(fCheckSoftPi.begin(),fCheckSoftPi.begin()+n);
+  if(fStoreMomentum) {
+    fPx.erase(fPx.begin(),fPx.begin()+n);
+    fPy.erase(fPy.begin(),fPy.begin()+n);
+    fPz.erase(fPz.begin(),fPz.begin()+n);
+    fE.erase(fE.begin(),fE.begin()+n);
+  }
+}
+
+//_____________________________________________________
+void AliHFPackedEventPool::UpdatePool(const TObjArray *tracks){
+  // appends the AliReducedParticle of tracks as the newest event,
+  // after dropping the oldest one if needed. tracks is not modified
+
+  Int_t mult = tracks->GetEntriesFast();
+  Int_t nTrk = NTracksInPool();
+  Bool_t removeFirstEvent = kFALSE;
+  if(nTrk>fTargetTrackDepth && !fNTracksInEvent.empty() && nTrk-fNTracksInEvent.front()+mult>fTargetTrackDepth) removeFirstEvent = kTRUE;
+  if(fMaxNEvents>0 && GetCurrentNEvents()>=fMaxNEvents) removeFirstEvent = kTRUE;
+  if(removeFirstEvent) RemoveOldestEvent();
+
+  for(Int_t i=0; i<mult; i++) {
+    AliReducedParticle *part = (AliReducedParticle*)tracks->UncheckedAt(i);
+    fEta.push_back(part->Eta());
+    fPhi.push_back(part->Phi());
+    fPt.push_back(part->Pt());
+    fWeight.push_back(part->GetWeight());
+    fImpPar.push_back(part->GetImpPar());
+    fMcLabel.push_back(part->GetLabel());
+    fID.push_back(part->GetID());
+    fCharge.push_back(part->Charge());
+    fCheckSoftPi.push_back(part->CheckSoftPi());
+    if(fStoreMomentum) {
+      fPx.push_back(part->Px());
+      fPy.push_back(part->Py());
+      fPz.push_back(part->Pz());
+      fE.push_back(part->Epion());
+    }
+  }
+  fNTracksInEvent.push_back(mult);
+
+  fEventStart.resize(fNTracksInEvent.size());
+  Int_t start = 0;
+  for(Int_t iEv=0; iEv<(Int_t)fNTracksInEvent.size(); iEv++) {
+    fEventStart[iEv] = start;
+    start += fNTracksInEvent[iEv];
+  }
+}
+
+//_____________________________________________________
+void AliHFPackedEventPool::GetParticle(Int_t i, AliReducedParticle &part) const {
+  // unpacks track i (index in the columns) into part
+  if(fStoreMomentum) part = AliReducedParticle(fEta[i],fPhi[i],fPt[i],fMcLabel[i],fID[i],fImpPar[i],fCheckSoftPi[i],fCharge[i],fWeight[i],fPx[i],fPy[i],fPz[i],fE[i]);
+  else part = AliReducedParticle(fEta[i],fPhi[i],fPt[i],fMcLabel[i],fID[i],fImpPar[i],fCheckSoftPi[i],fCharge[i],fWeight[i]);
+}
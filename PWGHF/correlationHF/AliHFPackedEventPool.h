@@ -0,0 +1,92 @@
+#ifndef AliHFPackedEventPool_H
+#define AliHFPackedEventPool_H
+
+/**************************************************************************
+ * Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//
+//             Event pool for the mixed-event HF correlations with the
+//             associated particles packed in contiguous arrays
+//             (one per variable) instead of AliReducedParticle objects
+//
+//-----------------------------------------------------------------------
+//
+//  Same rolling-buffer logic as AliEventPool: the oldest event is
+//  dropped when the pool would stay above the target track depth
+//  without it, or when the maximum number of events is reached.
+//  The pool is ready when it holds targetFrac*trackDepth tracks.
+//
+//-----------------------------------------------------------------------
+
+#include <vector>
+#include <deque>
+#include "TObject.h"
+
+class TObjArray;
+class AliReducedParticle;
+
+class AliHFPackedEventPool : public TObject
+{
+ public:
+
+  AliHFPackedEventPool();
+  AliHFPackedEventPool(Int_t maxNEvents, Int_t targetTrackDepth, Double_t targetFrac, Bool_t storeMomentum);
+  virtual ~AliHFPackedEventPool() {}
+
+  void   UpdatePool(const TObjArray *tracks); // packs the AliReducedParticle of one event
+  void   Clear(Option_t *opt="");
+
+  Bool_t IsReady() const {return NTracksInPool() >= fTargetFraction*fTargetTrackDepth;}
+  Int_t  GetCurrentNEvents() const {return (Int_t)fNTracksInEvent.size();}
+  Int_t  NTracksInPool() const {return (Int_t)fEta.size();}
+  Int_t  GetNTracksInEvent(Int_t iEv) const {return fNTracksInEvent.at(iEv);}
+  Int_t  GetEventStart(Int_t iEv) const {return fEventStart.at(iEv);}
+
+  // columns, to be indexed with GetEventStart(iEv)+i
+  const Float_t *GetEta() const {return fEta.empty() ? 0 : &fEta[0];}
+  const Float_t *GetPhi() const {return fPhi.empty() ? 0 : &fPhi[0];}
+  const Float_t *GetPt() const {return fPt.empty() ? 0 : &fPt[0];}
+  void  GetParticle(Int_t i, AliReducedParticle &part) const; // unpacks track i
+
+ private:
+
+  void RemoveOldestEvent();
+
+  Int_t    fMaxNEvents;        // maximum number of events in the pool (no limit if <=0)
+  Int_t    fTargetTrackDepth;  // number of tracks to be kept in the pool
+  Double_t fTargetFraction;    // fraction of fTargetTrackDepth needed to mix
+  Bool_t   fStoreMomentum;     // store px, py, pz, E (soft pion cut in ME)
+
+  std::deque<Int_t> fNTracksInEvent; // number of tracks of each event, oldest first
+  std::vector<Int_t> fEventStart;    // first track of each event in the columns
+
+  std::vector<Float_t> fEta;     // eta
+  std::vector<Float_t> fPhi;     // phi
+  std::vector<Float_t> fPt;      // pT
+  std::vector<Float_t> fWeight;  // track weight (e.g. 1/efficiency)
+  std::vector<Float_t> fImpPar;  // impact parameter
+  std::vector<Int_t>   fMcLabel; // MC label
+  std::vector<Int_t>   fID;      // track ID
+  std::vector<Short_t> fCharge;  // charge
+  std::vector<Char_t>  fCheckSoftPi; // compatibility with a soft pion from D*
+  std::vector<Float_t> fPx;      // px (only if fStoreMomentum)
+  std::vector<Float_t> fPy;      // py (only if fStoreMomentum)
+  std::vector<Float_t> fPz;      // pz (only if fStoreMomentum)
+  std::vector<Float_t> fE;       // E with pion mass (only if fStoreMomentum)
+
+  ClassDef(AliHFPackedEventPool,1); // event pool with packed associated particles
+};
+
+#endif
@@ -20,6 +20,7 @@
 #pragma link C++ class AliHFCorrelationBranchD+;
 #pragma link C++ class AliHFCorrelationBranchTr+;
 #pragma link C++ class AliReducedParticle+;
+#pragma link C++ class AliHFPackedEventPool+;
 #pragma link C++ class AliD0hCutOptim+;
 #pragma link C++ class AliDstarhCutOptim+;
 #pragma link C++ class AliDPlushCutOptim+;
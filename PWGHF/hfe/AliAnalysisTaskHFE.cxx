@@ -70,6 +70,7 @@
 #include "AliVVertex.h"
 
 #include "AliHFEcollection.h"
+#include "AliHFEcandidateTable.h"
 #include "AliHFEcontainer.h"
 #include "AliHFEcuts.h"
 #include "AliHFEelecbackground.h"
@@ -148,6 +149,7 @@ AliAnalysisTaskSE("PID efficiency Analysis")
 , fTaggedTrackAnalysis(NULL)
 , fExtraCuts(NULL)
 , fBackgroundSubtraction(NULL)
+, fCandidateTable(NULL)
 , fTRDTrigger(kFALSE)
 , fWhichTRDTrigger(0)
 , fV0Tagger(NULL)
@@ -230,6 +232,7 @@ AliAnalysisTaskSE(name)
 , fTaggedTrackAnalysis(NULL)
 , fExtraCuts(NULL)
 , fBackgroundSubtraction(NULL)
+, fCandidateTable(NULL)
 , fTRDTrigger(kFALSE)
 , fWhichTRDTrigger(0)
 , fV0Tagger(NULL)
@@ -324,6 +327,7 @@ AliAnalysisTaskSE(ref)
 , fTaggedTrackAnalysis(NULL)
 , fExtraCuts(NULL)
 , fBackgroundSubtraction(NULL)
+, fCandidateTable(NULL)
 , fTRDTrigger(ref.fTRDTrigger)
 , fWhichTRDTrigger(ref.fWhichTRDTrigger)
 , fV0Tagger(NULL)
@@ -685,6 +689,7 @@ void AliAnalysisTaskHFE::UserExec(Option_t *){
   if(fRemoveFirstEvent){
     if(fAnalysisUtils->IsFirstEventInChunk(fInputEvent)) return;
   }
+  fCandidateTable = AliHFEcandidateTable::GetTable(fInputEvent, fCuts->GetSharedCandidateKey());
 
   AliESDEvent *ev = dynamic_cast<AliESDEvent *>(fInputEvent);
   if(ev && fTRDTrigger && (fWhichTRDTrigger<6))
@@ -2391,7 +2396,9 @@ Bool_t AliAnalysisTaskHFE::ProcessCutStep(Int_t cutStep, AliVParticle *track){
   // Fill the particle container
   //
   const Int_t kMCOffset = AliHFEcuts::kNcutStepsMCTrack;
-  if(!fCFM->CheckParticleCuts(cutStep + kMCOffset, track)) return kFALSE;
+  if(fCandidateTable){
+    if(!fCandidateTable->CheckParticleCuts(fCFM, cutStep + kMCOffset, track)) return kFALSE;
+  } else if(!fCFM->CheckParticleCuts(cutStep + kMCOffset, track)) return kFALSE;
   if(fVarManager->IsSignalTrack()) {
     fVarManager->FillContainer(fContainer, "recTrackContReco", cutStep, kFALSE);
     fVarManager->FillContainer(fContainer, "recTrackContMC", cutStep, kTRUE);
@@ -40,6 +40,7 @@ class AliHFEcuts;
 class AliHFEextraCuts;
 class AliHFEelecbackground;
 class AliHFENonPhotonicElectron;
+class AliHFEcandidateTable;
 class AliHFEmcQA;
 class AliHFEpid;
 class AliHFEpidQAmanager;
@@ -277,6 +278,7 @@ class AliAnalysisTaskHFE : public AliAnalysisTaskSE{
     AliHFEtaggedTrackAnalysis *fTaggedTrackAnalysis;     //!Analyse V0-tagged tracks
     AliHFEextraCuts *fExtraCuts;          //! temporary implementation for IP QA
     AliHFENonPhotonicElectron *fBackgroundSubtraction; // Background subtraction
+    AliHFEcandidateTable *fCandidateTable; //! Candidates shared with other tasks (see AliHFEcuts::SetSharedCandidateKey)
     Bool_t fTRDTrigger;                   // Check if event is TRD triggered event
     Int_t  fWhichTRDTrigger;               // Select type of TRD trigger
 
@@ -52,6 +52,7 @@
 #include "AliKFParticle.h"
 #include "AliKFVertex.h"
 
+#include "AliHFEcandidateTable.h"
 #include "AliHFEcuts.h"
 #include "AliHFEpid.h"
 #include "AliHFEpidQAmanager.h"
@@ -111,6 +112,9 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fAnaPairGen(kFALSE)
     ,fNumberofGenerations(1)
     ,fDisplayMCStack(kFALSE)
+    ,fSharedCandidateKey()
+    ,fPoolTheta()
+    ,fPoolByTheta()
 {
     //
     // Constructor
@@ -169,6 +173,9 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fAnaPairGen(kFALSE)
     ,fNumberofGenerations(1)
     ,fDisplayMCStack(kFALSE)
+    ,fSharedCandidateKey()
+    ,fPoolTheta()
+    ,fPoolByTheta()
 {
     //
     // Constructor
@@ -227,6 +234,9 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fAnaPairGen(kFALSE)
     ,fNumberofGenerations(1)
     ,fDisplayMCStack(kFALSE)
+    ,fSharedCandidateKey(ref.fSharedCandidateKey)
+    ,fPoolTheta()
+    ,fPoolByTheta()
 {
     //
     // Copy Constructor
@@ -595,6 +605,23 @@ Int_t AliHFENonPhotonicElectron::FillPoolAssociatedTracks(AliVEvent *inputEvent,
 
     //printf(Form("Associated Pool: Tracks %d, fCounterPoolBackground %d \n", nbtracks, fCounterPoolBackground));
 
+    // Sort the pool in polar angle for the partner search of GetPhotonicTag
+    TArrayD theta(fCounterPoolBackground);
+    for(Int_t ii = 0; ii < fCounterPoolBackground; ii++){
+        AliVTrack *track = (AliVTrack *) inputEvent->GetTrack(fArraytrack->At(ii));
+        theta[ii] = track ? track->Theta() : -1.;
+    }
+    fPoolByTheta.Set(fCounterPoolBackground);
+    fPoolTheta.Set(fCounterPoolBackground);
+    if(fCounterPoolBackground > 0){
+        TArrayI order(fCounterPoolBackground);
+        TMath::Sort(fCounterPoolBackground, theta.GetArray(), order.GetArray(), kFALSE);
+        for(Int_t ii = 0; ii < fCounterPoolBackground; ii++){
+            fPoolByTheta[ii] = fArraytrack->At(order[ii]);
+            fPoolTheta[ii] = theta[order[ii]];
+        }
+    }
+
     return fCounterPoolBackground;
 
 }
@@ -874,10 +901,85 @@ Int_t AliHFENonPhotonicElectron::LookAtNonHFE(Int_t iTrack1, AliVTrack *track1,
     if(!kUSignPhotonic &&  kLSignPhotonic) taggedphotonic = 4;
     if( kUSignPhotonic && !kLSignPhotonic) taggedphotonic = 2;
 
+    // Share the tag with the other tasks of the train
+    if(fSharedCandidateKey.Length()){
+        AliHFEcandidateTable *table = AliHFEcandidateTable::GetTable(vEvent, fSharedCandidateKey.Data());
+        if(table) table->SetPhotonicTag(track1, taggedphotonic);
+    }
+
     AliDebug(1,"------------------------------------ \n");
     return taggedphotonic;
 }
 
+//_____________________________________________________________________________________________
+Int_t AliHFENonPhotonicElectron::GetPhotonicTag(Int_t iTrack1, AliVTrack *track1, AliVEvent *vEvent)
+{
+    //
+    // Photonic tag of the electron candidate, with the same meaning as the
+    // return value of LookAtNonHFE, without filling any histogram.
+    // Taken from the shared candidate table if another task (or LookAtNonHFE)
+    // already computed it, otherwise computed from the associated pool:
+    // the 3D opening angle is not smaller than the difference in polar angle,
+    // which is constant along the tracks, so that only the tracks of the pool
+    // (sorted in FillPoolAssociatedTracks) within fMaxOpening3D in polar angle
+    // are paired. All the tracks are paired with the mass constraint, which
+    // changes the momenta of the legs.
+    //
+    AliHFEcandidateTable *table = NULL;
+    if(fSharedCandidateKey.Length()){
+        table = AliHFEcandidateTable::GetTable(vEvent, fSharedCandidateKey.Data());
+        if(table && table->HasPhotonicTag(track1)) return table->GetPhotonicTag(track1);
+    }
+
+    Int_t taggedphotonic = -1;
+    if(!fArraytrack || fPoolByTheta.GetSize() != fCounterPoolBackground) return taggedphotonic;
+
+    AliAODEvent *aodeventu = dynamic_cast<AliAODEvent*>(vEvent);
+    AliKFParticle::SetField(vEvent->GetMagneticField());
+    AliKFVertex primV(*(vEvent->GetPrimaryVertex()));
+
+    Int_t first = 0, last = fCounterPoolBackground;
+    if(!fSetMassConstraint && fMaxOpening3D < TMath::Pi() && fCounterPoolBackground > 0){
+        Double_t theta1 = track1->Theta();
+        first = TMath::BinarySearch(fCounterPoolBackground, fPoolTheta.GetArray(), theta1 - fMaxOpening3D);
+        if(first < 0 || fPoolTheta[first] < theta1 - fMaxOpening3D) first++;
+        last = TMath::BinarySearch(fCounterPoolBackground, fPoolTheta.GetArray(), theta1 + fMaxOpening3D) + 1;
+    }
+
+    Float_t fCharge1 = track1->Charge();
+    Bool_t kUSignPhotonic = kFALSE;
+    Bool_t kLSignPhotonic = kFALSE;
+    Double_t angle(-1.);
+    Double_t invmass(-1);
+    for(Int_t idex = first; idex < last && !(kUSignPhotonic && kLSignPhotonic); idex++){
+        Int_t iTrack2 = fPoolByTheta[idex];
+        if(iTrack2 == iTrack1) continue;
+        AliVTrack *track2 = (AliVTrack *)vEvent->GetTrack(iTrack2);
+        if(!track2) continue;
+
+        Bool_t likesign = (fCharge1*track2->Charge()) > 0.0;
+        if(likesign ? kLSignPhotonic : kUSignPhotonic) continue;       // nothing new to learn
+
+        if(fAlgorithmMA){
+            if(!MakePairDCA(track1, track2, vEvent, (aodeventu != NULL), invmass, angle)) continue;
+        } else {
+            if(!MakePairKF(track1, track2, primV, invmass, angle)) continue;
+        }
+        if(angle > fMaxOpening3D) continue;
+        if(invmass > fMaxInvMass) continue;
+
+        if(likesign) kLSignPhotonic = kTRUE;
+        else         kUSignPhotonic = kTRUE;
+    }
+
+    if( kUSignPhotonic &&  kLSignPhotonic) taggedphotonic = 6;
+    if(!kUSignPhotonic &&  kLSignPhotonic) taggedphotonic = 4;
+    if( kUSignPhotonic && !kLSignPhotonic) taggedphotonic = 2;
+
+    if(table) table->SetPhotonicTag(track1, taggedphotonic);
+    return taggedphotonic;
+}
+
 //_________________________________________________________________________
 Int_t AliHFENonPhotonicElectron::FindMother(Int_t tr, Int_t &indexmother) const {
     //
@@ -22,6 +22,10 @@
 #include <TArrayD.h>
 #endif
 
+#ifndef ROOT_TArrayI
+#include <TArrayI.h>
+#endif
+
 class AliESDtrackCuts;
 class AliHFEpid;
 class AliHFEpidQAmanager;
@@ -91,6 +95,7 @@ class AliHFENonPhotonicElectron : public TNamed {
   void SetAnaPairGen(Bool_t setAna = kTRUE, Int_t nGen = 2)     { fAnaPairGen = setAna; fNumberofGenerations = nGen;};
   void SetNPairGenerations(Int_t nGen)                          { fNumberofGenerations = nGen;};
   void SetDisplayMCStack(Bool_t setDisplay = kTRUE)             { fDisplayMCStack = setDisplay;};
+  void SetSharedCandidateKey(const char *key)                   { fSharedCandidateKey = key; };
 
   TList      *GetListOutput()		const	{ return fListOutput; };
   THnSparseF *GetAssElectronHisto()	const	{ return fAssElectron; };
@@ -105,6 +110,7 @@ class AliHFENonPhotonicElectron : public TNamed {
   Int_t    FillPoolAssociatedTracks	(AliVEvent *inputEvent, Int_t binct=-1);
   Int_t    CountPoolAssociated		(AliVEvent *inputEvent, Int_t binct=-1);
   Int_t    LookAtNonHFE			(Int_t iTrack1, AliVTrack *track1, AliVEvent *vEvent, Double_t weight=1., Int_t binct=-1, Double_t deltaphi=-1, Int_t source=-1, Int_t indexmother=-1,Int_t mcQAsource=-1);
+  Int_t    GetPhotonicTag		(Int_t iTrack1, AliVTrack *track1, AliVEvent *vEvent);
 
   Int_t    FindMother		(Int_t tr, Int_t &indexmother) const;
 
@@ -184,10 +190,13 @@ class AliHFENonPhotonicElectron : public TNamed {
   Bool_t                    fAnaPairGen;                     // switch on the analysis of the pair generation (switch for performance)
   Int_t                     fNumberofGenerations;            // number of generations stored in pair container variable nGen
   Bool_t                    fDisplayMCStack;                 // display MC stack for true likesign pairs (usually misidentification), for debugging
+  TString                   fSharedCandidateKey;             // key of the AliHFEcandidateTable keeping the photonic tags (empty: not shared)
+  TArrayD                   fPoolTheta;                      //! polar angle of the associated tracks, sorted
+  TArrayI                   fPoolByTheta;                    //! associated tracks sorted in polar angle
 
   AliHFENonPhotonicElectron(const AliHFENonPhotonicElectron &ref); 
 
-  ClassDef(AliHFENonPhotonicElectron, 5); //!example of analysis
+  ClassDef(AliHFENonPhotonicElectron, 6); //!example of analysis
 };
 
 #endif
@@ -0,0 +1,242 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//
+// Class AliHFEcandidateTable
+// Event-level table of electron candidates: for each track the cut
+// steps evaluated and passed and the outcome of the photonic partner
+// search; the electron n sigma come from AliPIDResponseCache. The table is
+// attached to the list of the input event under a name built from
+// a key chosen by the user, such that all the tasks of a train
+// declaring the same key (and running the same cuts) share it. It
+// is reset when a new event is found.
+//
+#include <TList.h>
+
+#include "AliAODEvent.h"
+#include "AliCFManager.h"
+#include "AliESDEvent.h"
+#include "AliLog.h"
+#include "AliPIDResponseCache.h"
+#include "AliVEvent.h"
+#include "AliVHeader.h"
+#include "AliVTrack.h"
+#include "AliVVertex.h"
+
+#include "AliHFEcuts.h"
+#include "AliHFEcandidateTable.h"
+
+ClassImp(AliHFEcandidateTable)
+
+//___________________________________________________________________
+AliHFEcandidateTable::AliHFEcandidateTable():
+  TNamed(),
+  fRunNumber(-1),
+  fEventId(0),
+  fNTracks(-1),
+  fNContributors(-1),
+  fCandidates(),
+  fIndex()
+{
+  //
+  // Default constructor
+  //
+  memset(fVtxPos, 0, sizeof(Double_t) * 3);
+}
+
+//___________________________________________________________________
+AliHFEcandidateTable::AliHFEcandidateTable(const char *name):
+  TNamed(name, "HFE electron candidates"),
+  fRunNumber(-1),
+  fEventId(0),
+  fNTracks(-1),
+  fNContributors(-1),
+  fCandidates(),
+  fIndex()
+{
+  //
+  // Constructor
+  //
+  memset(fVtxPos, 0, sizeof(Double_t) * 3);
+  fCandidates.reserve(100);
+}
+
+//___________________________________________________________________
+AliHFEcandidateTable *AliHFEcandidateTable::GetTable(AliVEvent *ev, const char *key){
+  //
+  // Table attached to the event for the given key, created at the
+  // first call and reset if it was filled for another event
+  //
+  if(!ev || !ev->GetList() || !key || !key[0]) return NULL;
+  TString name = TableName(key);
+  AliHFEcandidateTable *table = dynamic_cast<AliHFEcandidateTable *>(ev->GetList()->FindObject(name.Data()));
+  if(!table){
+    table = new AliHFEcandidateTable(name.Data());
+    AliESDEvent *esd = dynamic_cast<AliESDEvent *>(ev);
+    AliAODEvent *aod = dynamic_cast<AliAODEvent *>(ev);
+    if(esd) esd->AddObject(table);
+    else if(aod) aod->AddObject(table);
+    else {
+      delete table;
+      return NULL;
+    }
+  }
+  if(!table->IsSameEvent(ev)){
+    table->Reset();
+    table->SetEvent(ev);
+  }
+  return table;
+}
+
+//___________________________________________________________________
+void AliHFEcandidateTable::Reset(){
+  //
+  // Remove all the candidates
+  //
+  fCandidates.clear();
+  fIndex.Delete();
+}
+
+//___________________________________________________________________
+Bool_t AliHFEcandidateTable::IsSameEvent(const AliVEvent *ev) const {
+  //
+  // Check whether ev is the event the table was filled for
+  //
+  if(ev->GetRunNumber() != fRunNumber) return kFALSE;
+  if(ev->GetNumberOfTracks() != fNTracks) return kFALSE;
+  AliVHeader *header = ev->GetHeader();
+  if(header && header->GetEventIdAsLong() != fEventId) return kFALSE;
+  const AliVVertex *vtx = ev->GetPrimaryVertex();
+  if(!vtx) return fNContributors < 0;
+  if(vtx->GetNContributors() != fNContributors) return kFALSE;
+  Double_t pos[3];
+  vtx->GetXYZ(pos);
+  for(Int_t i = 0; i < 3; i++) if(pos[i] != fVtxPos[i]) return kFALSE;
+  return kTRUE;
+}
+
+//___________________________________________________________________
+void AliHFEcandidateTable::SetEvent(const AliVEvent *ev){
+  //
+  // Store the identifiers of the current event
+  //
+  fRunNumber = ev->GetRunNumber();
+  fNTracks = ev->GetNumberOfTracks();
+  AliVHeader *header = ev->GetHeader();
+  fEventId = header ? header->GetEventIdAsLong() : 0;
+  const AliVVertex *vtx = ev->GetPrimaryVertex();
+  fNContributors = -1;
+  memset(fVtxPos, 0, sizeof(Double_t) * 3);
+  if(vtx){
+    fNContributors = vtx->GetNContributors();
+    vtx->GetXYZ(fVtxPos);
+  }
+}
+
+//___________________________________________________________________
+const AliHFEcandidateTable::Candidate_t *AliHFEcandidateTable::GetCandidate(const TObject *track) const {
+  //
+  // Entry of the track, NULL if not in the table
+  //
+  Long64_t pos = const_cast<TExMap &>(fIndex).GetValue((Long64_t)track);
+  return pos ? &fCandidates[pos - 1] : NULL;
+}
+
+//___________________________________________________________________
+AliHFEcandidateTable::Candidate_t *AliHFEcandidateTable::AddCandidate(const TObject *track){
+  //
+  // Entry of the track, created if not yet in the table
+  //
+  Long64_t pos = fIndex.GetValue((Long64_t)track);
+  if(pos) return &fCandidates[pos - 1];
+  Candidate_t cand;
+  cand.fTrack = track;
+  cand.fStepsChecked = 0;
+  cand.fStepsPassed = 0;
+  cand.fPhotonic = kPhotonicUnknown;
+  fCandidates.push_back(cand);
+  fIndex.Add((Long64_t)track, fCandidates.size());
+  return &fCandidates.back();
+}
+
+//___________________________________________________________________
+Bool_t AliHFEcandidateTable::IsStepChecked(const TObject *track, UInt_t step) const {
+  const Candidate_t *cand = GetCandidate(track);
+  return cand && step < 32 && TESTBIT(cand->fStepsChecked, step);
+}
+
+//___________________________________________________________________
+Bool_t AliHFEcandidateTable::HasPassedStep(const TObject *track, UInt_t step) const {
+  const Candidate_t *cand = GetCandidate(track);
+  return cand && step < 32 && TESTBIT(cand->fStepsPassed, step);
+}
+
+//___________________________________________________________________
+void AliHFEcandidateTable::SetStep(const TObject *track, UInt_t step, Bool_t passed){
+  if(step >= 32) return;
+  Candidate_t *cand = AddCandidate(track);
+  SETBIT(cand->fStepsChecked, step);
+  if(passed) SETBIT(cand->fStepsPassed, step);
+  else CLRBIT(cand->fStepsPassed, step);
+}
+
+//___________________________________________________________________
+Bool_t AliHFEcandidateTable::CheckParticleCuts(AliCFManager *cfm, UInt_t step, TObject *track){
+  //
+  // Outcome of the cut step of the CF manager, evaluated only
+  // if no task did it before for this track
+  //
+  if(IsStepChecked(track, step)) return HasPassedStep(track, step);
+  Bool_t passed = cfm->CheckParticleCuts(step, track);
+  SetStep(track, step, passed);
+  return passed;
+}
+
+//___________________________________________________________________
+Bool_t AliHFEcandidateTable::CheckParticleCuts(AliHFEcuts *cuts, UInt_t step, TObject *track){
+  //
+  // Same for the cuts checked without the CF manager
+  //
+  if(IsStepChecked(track, step)) return HasPassedStep(track, step);
+  Bool_t passed = cuts->CheckParticleCuts(step, track);
+  SetStep(track, step, passed);
+  return passed;
+}
+
+//___________________________________________________________________
+Float_t AliHFEcandidateTable::GetNSigmaElectron(const AliVTrack *track, AliPIDResponse::EDetector det, const AliPIDResponse *pid){
+  //
+  // Electron n sigma from the PID response (no HFE specific
+  // corrections), computed once per event for all the tasks
+  //
+  if(!pid) return -999.;
+  return AliPIDResponseCache::NumberOfSigmas(pid, det, track, AliPID::kElectron);
+}
+
+//___________________________________________________________________
+Bool_t AliHFEcandidateTable::HasPhotonicTag(const TObject *track) const {
+  const Candidate_t *cand = GetCandidate(track);
+  return cand && cand->fPhotonic != kPhotonicUnknown;
+}
+
+//___________________________________________________________________
+Int_t AliHFEcandidateTable::GetPhotonicTag(const TObject *track) const {
+  const Candidate_t *cand = GetCandidate(track);
+  return cand ? cand->fPhotonic : static_cast<Int_t>(kPhotonicUnknown);
+}
+
+//___________________________________________________________________
+void AliHFEcandidateTable::SetPhotonicTag(const TObject *track, Int_t tag){
+  AddCandidate(track)->fPhotonic = tag;
+}
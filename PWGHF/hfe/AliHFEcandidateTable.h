@@ -0,0 +1,95 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//
+// Event-level table of HFE electron candidates
+// shared by the HFE tasks of a train
+//
+#ifndef ALIHFECANDIDATETABLE_H
+#define ALIHFECANDIDATETABLE_H
+
+#ifndef ROOT_TNamed
+#include <TNamed.h>
+#endif
+
+#ifndef ROOT_TExMap
+#include <TExMap.h>
+#endif
+
+#include <vector>
+
+#include "AliPIDResponse.h"
+
+class AliCFManager;
+class AliHFEcuts;
+class AliVEvent;
+class AliVTrack;
+
+class AliHFEcandidateTable : public TNamed{
+  public:
+    enum{
+      kPhotonicUnknown = -100   // photonic partner search not done
+    };
+    struct Candidate_t{
+      const TObject *fTrack;          // track (owned by the event)
+      UInt_t         fStepsChecked;   // bit i: cut step i evaluated
+      UInt_t         fStepsPassed;    // bit i: cut step i passed
+      Short_t        fPhotonic;       // photonic partners as in AliHFENonPhotonicElectron::LookAtNonHFE
+    };
+
+    AliHFEcandidateTable();
+    AliHFEcandidateTable(const char *name);
+    virtual ~AliHFEcandidateTable() {}
+
+    static AliHFEcandidateTable *GetTable(AliVEvent *ev, const char *key);
+    static TString TableName(const char *key) { return TString::Format("HFEcandidateTable_%s", key); }
+
+    void Reset();
+    Int_t GetNCandidates() const { return fCandidates.size(); }
+    const Candidate_t *GetCandidate(const TObject *track) const;
+    Candidate_t *AddCandidate(const TObject *track);
+
+    // Cut steps
+    Bool_t IsStepChecked(const TObject *track, UInt_t step) const;
+    Bool_t HasPassedStep(const TObject *track, UInt_t step) const;
+    void SetStep(const TObject *track, UInt_t step, Bool_t passed);
+    Bool_t CheckParticleCuts(AliCFManager *cfm, UInt_t step, TObject *track);
+    Bool_t CheckParticleCuts(AliHFEcuts *cuts, UInt_t step, TObject *track);
+
+    // PID: the n sigma are shared through AliPIDResponseCache
+    static Float_t GetNSigmaElectron(const AliVTrack *track, AliPIDResponse::EDetector det, const AliPIDResponse *pid);
+
+    // Photonic partners
+    Bool_t HasPhotonicTag(const TObject *track) const;
+    Int_t GetPhotonicTag(const TObject *track) const;
+    void SetPhotonicTag(const TObject *track, Int_t tag);
+
+  private:
+    AliHFEcandidateTable(const AliHFEcandidateTable &ref);
+    AliHFEcandidateTable &operator=(const AliHFEcandidateTable &ref);
+
+    Bool_t IsSameEvent(const AliVEvent *ev) const;
+    void SetEvent(const AliVEvent *ev);
+
+    Int_t     fRunNumber;                       // run number of the tabulated event
+    ULong64_t fEventId;                         // period/orbit/bunch crossing of the tabulated event
+    Int_t     fNTracks;                         // number of tracks of the tabulated event
+    Int_t     fNContributors;                   // contributors to the primary vertex of the tabulated event
+    Double_t  fVtxPos[3];                       // primary vertex position of the tabulated event
+    std::vector<Candidate_t> fCandidates;       //! candidates of the event
+    TExMap    fIndex;                           //! track address -> position in fCandidates + 1
+
+    ClassDef(AliHFEcandidateTable, 1)           // Event-level table of electron candidates
+};
+#endif
@@ -149,6 +149,7 @@ AliHFEcuts::AliHFEcuts():
   fAODFilterBit(-1),
   fRejectKinkDaughters(kTRUE),
   fRejectKinkMothers(kTRUE),
+  fSharedCandidateKey(),
   fHistQA(0x0),
   fCutList(0x0),
   fDebugLevel(0),
@@ -212,6 +213,7 @@ AliHFEcuts::AliHFEcuts(const Char_t *name, const Char_t *title):
   fAODFilterBit(-1),
   fRejectKinkDaughters(kTRUE),
   fRejectKinkMothers(kTRUE),
+  fSharedCandidateKey(),
   fHistQA(0x0),
   fCutList(0x0),
   fDebugLevel(0),
@@ -275,6 +277,7 @@ AliHFEcuts::AliHFEcuts(const AliHFEcuts &c):
   fAODFilterBit(-1),
   fRejectKinkDaughters(c.fRejectKinkDaughters),
   fRejectKinkMothers(c.fRejectKinkMothers),
+  fSharedCandidateKey(c.fSharedCandidateKey),
   fHistQA(0x0),
   fCutList(0x0),
   fDebugLevel(0),
@@ -339,6 +342,7 @@ void AliHFEcuts::Copy(TObject &c) const {
   target.fAODFilterBit = fAODFilterBit;
   target.fRejectKinkDaughters = fRejectKinkDaughters;
   target.fRejectKinkMothers = fRejectKinkMothers;
+  target.fSharedCandidateKey = fSharedCandidateKey;
   target.fDebugLevel = 0;
   target.fPIDResponse = fPIDResponse;
 
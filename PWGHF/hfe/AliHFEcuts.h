@@ -199,6 +199,9 @@ class AliHFEcuts : public TNamed{
     void SetAcceptKinkDaughters() { fRejectKinkDaughters = kFALSE; }
     void SetRejectKinkMothers() { fRejectKinkMothers = kTRUE; }
     void SetAcceptKinkMothers() { fRejectKinkMothers = kFALSE; }
+    // Share the outcome of the cut steps among the tasks declaring the same key (see AliHFEcandidateTable)
+    void SetSharedCandidateKey(const char *key) { fSharedCandidateKey = key; }
+    const char *GetSharedCandidateKey() const { return fSharedCandidateKey.Data(); }
 
     void SetDebugLevel(Int_t level) { fDebugLevel = level; };
     Int_t GetDebugLevel() const { return fDebugLevel; };
@@ -285,6 +288,7 @@ class AliHFEcuts : public TNamed{
     Int_t    fAODFilterBit;                   // AOD Filter Bit Number
     Bool_t   fRejectKinkDaughters;            // Reject Kink Daughters
     Bool_t   fRejectKinkMothers;              // Reject Kink Daughters
+    TString  fSharedCandidateKey;             // Key of the shared candidate table (empty: not shared)
     
     TList *fHistQA;		                        //! QA Histograms
     TObjArray *fCutList;	                    //! List of cut objects(Correction Framework Manager)
@@ -293,7 +297,7 @@ class AliHFEcuts : public TNamed{
 
     const AliPIDResponse *fPIDResponse;//! PID Response
     
-  ClassDef(AliHFEcuts, 8)                     // Container for HFE cuts
+  ClassDef(AliHFEcuts, 9)                     // Container for HFE cuts
 };
 
 //__________________________________________________________________
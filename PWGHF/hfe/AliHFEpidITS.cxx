@@ -32,6 +32,7 @@
 #include "AliPID.h"
 #include "AliVParticle.h"
 #include "AliPIDResponse.h"
+#include "AliPIDResponseCache.h"
 
 #include "AliHFEdetPIDqa.h"
 #include "AliHFEpidITS.h"
@@ -144,7 +145,7 @@ Double_t AliHFEpidITS::GetITSNsigmaCorrected(const AliVTrack *track) const {
     //
     // Get the ITS number of sigmas corrected for a possible shift of the mean dE/dx
     //
-    return fkPIDResponse->NumberOfSigmasITS(track, AliPID::kElectron) - fMeanShift;
+    return AliPIDResponseCache::NumberOfSigmasITS(fkPIDResponse, track, AliPID::kElectron) - fMeanShift;
 }
 //___________________________________________________________________
 void AliHFEpidITS::SetITSnSigma(Float_t nSigmalow, Float_t nSigmahigh) {
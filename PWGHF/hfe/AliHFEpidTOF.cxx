@@ -28,6 +28,7 @@
 #include "AliESDtrack.h"
 #include "AliPID.h"
 #include "AliPIDResponse.h"
+#include "AliPIDResponseCache.h"
 #include "AliTOFPIDResponse.h"
 
 #include "AliHFEdetPIDqa.h"
@@ -162,7 +163,7 @@ Int_t AliHFEpidTOF::IsSelected(const AliHFEpidObject *track, AliHFEpidQAmanager
   if(pidqa) pidqa->ProcessTrack(track, AliHFEpid::kTOFpid, AliHFEdetPIDqa::kBeforePID);
 
   // Fill before selection
-  Double_t sigEle = fkPIDResponse->NumberOfSigmasTOF(track->GetRecTrack(), AliPID::kElectron);
+  Double_t sigEle = AliPIDResponseCache::NumberOfSigmasTOF(fkPIDResponse, track->GetRecTrack(), AliPID::kElectron);
   AliDebug(2, Form("Number of sigmas in TOF: %f", sigEle));
   Int_t pdg = 0;
   if(TestBit(kSigmaBand)){
@@ -254,7 +255,7 @@ void AliHFEpidTOF::GenerateTOFmismatch(const AliVTrack * const trk, int ntrk, TA
       AliESDtrack *esdtrk = static_cast<AliESDtrack *>(copytrk);
       esdtrk->SetTOFsignal(tofsignal);
     }
-    sigmaEl[itrk] = fkPIDResponse->NumberOfSigmasTOF(copytrk, AliPID::kElectron);
+    sigmaEl[itrk] = AliPIDResponseCache::NumberOfSigmasTOF(fkPIDResponse, copytrk, AliPID::kElectron);
   }
   delete copytrk;
 }
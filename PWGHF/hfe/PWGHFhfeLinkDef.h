@@ -79,6 +79,7 @@
 
 #pragma link C++ class  AliSelectNonHFE+;
 #pragma link C++ class  AliHFENonPhotonicElectron+;
+#pragma link C++ class  AliHFEcandidateTable+;
 #pragma link C++ class  AliHFEdebugTreeTaskAOD+;
 
 #pragma link C++ class  AliHFECorrectSpectrumBase+;
@@ -52,7 +52,10 @@ AliHFJetTaggingIP::AliHFJetTaggingIP(void)
 , fCurrentDCA(0.)
 , fThreshold(-99.)
 , fDiscriminators()
-, fTrackDCA(0)
+, fJetTrackIP()
+, fTrackIP()
+, fTrackIPIndex()
+, fCurrentIP(NULL)
 , fJetIndices()
 , fThresholdFuction(NULL)
 , fEvent(NULL)
@@ -136,7 +139,7 @@ Bool_t AliHFJetTaggingIP::GetJetDiscriminator(AliEmcalJet* jet, Double_t* discri
 	//========================================================================
 	// Calculates overall discriminator
 	//========================================================================
-	std::vector<std::pair<Int_t, Double_t> > bSignedImpactParameter;
+	fJetTrackIP.clear();
 	if(!jet)
 		return kFALSE;
 	if(!fParticles)
@@ -160,41 +163,34 @@ Bool_t AliHFJetTaggingIP::GetJetDiscriminator(AliEmcalJet* jet, Double_t* discri
 			continue;
 		if(!PassedCuts(bTrack, bIp2d, bDCAZ))
 			continue;
-		if(fVertexRecalculated) {
-			delete fVertexRecalculated;
-			fVertexRecalculated = NULL;
-		}
-		bSignedImpactParameter.push_back(std::make_pair(j, bSign * bIp2d));
-		this->fTrackDCA.push_back(std::make_pair(j, bDCAZ));
+		JetTrackIP_t ip = { j, bSign * bIp2d, bDCAZ };
+		fJetTrackIP.push_back(ip);
 	}
+	return FillDiscriminators(discriminator, check_discr);
+}
+
+Bool_t AliHFJetTaggingIP::FillDiscriminators(Double_t* discriminator, Bool_t* check_discr)
+{
+	//========================================================================
+	// Track counting discriminators from the signed impact parameters of the
+	// current jet: only the three largest values are sorted
+	//========================================================================
 	discriminator[0] = -99.;
 	discriminator[1] = -99.;
 	discriminator[2] = -99.;
-	Int_t numoftracks = (Int_t)bSignedImpactParameter.size();
+	Int_t numoftracks = (Int_t)fJetTrackIP.size();
 	if(numoftracks < this->fSelectionCuts[AliHFJetTaggingIP::S_MINNTRACKS])
 		return kFALSE;
-	if(numoftracks == 0) {
-		bSignedImpactParameter.clear();
+	if(numoftracks == 0)
 		return kFALSE;
+	Int_t nsorted = TMath::Min(numoftracks, 3);
+	std::partial_sort(fJetTrackIP.begin(), fJetTrackIP.begin() + nsorted, fJetTrackIP.end(), AliHFJetTaggingIP::mysort);
+	for(Int_t i = 0; i < nsorted; ++i) {
+		discriminator[i] = fJetTrackIP[i].fSIP;
+		fCurrentTrack[i] = fJet->TrackAt(fJetTrackIP[i].fIndex);
+		fCurrentTrackDCAz[i] = fJetTrackIP[i].fDCAz;
+		check_discr[i] = kTRUE;
 	}
-	std::sort(bSignedImpactParameter.begin(), bSignedImpactParameter.end(), AliHFJetTaggingIP::mysort);
-	if(numoftracks > 2) {
-		discriminator[2] = bSignedImpactParameter.at(2).second;
-		fCurrentTrack[2] = jet->TrackAt(bSignedImpactParameter.at(2).first);
-
-		check_discr[2] = kTRUE;
-	}
-	if(numoftracks > 1) {
-		discriminator[1] = bSignedImpactParameter.at(1).second;
-		fCurrentTrack[1] = jet->TrackAt(bSignedImpactParameter.at(1).first);
-		check_discr[1] = kTRUE;
-	}
-	if(numoftracks > 0) {
-		discriminator[0] = bSignedImpactParameter.at(0).second;
-		fCurrentTrack[0] = jet->TrackAt(bSignedImpactParameter.at(0).first);
-		check_discr[0] = kTRUE;
-	}
-	SetCurrentDCAz();
 
 	return kTRUE;
 }
@@ -207,7 +203,7 @@ Bool_t AliHFJetTaggingIP::GetJetDiscriminatorQualityClass(Int_t qtyclass,
 	//========================================================================
 	// Calculates overall discriminator
 	//========================================================================
-	std::vector<std::pair<Int_t, Double_t> > bSignedImpactParameter;
+	fJetTrackIP.clear();
 	if(!jet)
 		return kFALSE;
 	if(!fParticles)
@@ -226,108 +222,95 @@ Bool_t AliHFJetTaggingIP::GetJetDiscriminatorQualityClass(Int_t qtyclass,
 		bTrack = (AliVTrack*)((AliPicoTrack*)fParticles->GetParticle(jet->TrackAt((int)j)))->GetTrack();
 		if(!bTrack)	continue;
 		if(!GetImpactParameter(bTrack, &bSign, &bIp2d, &bDCAZ)) continue;
-		if(this->fVertexRecalculated) {
-			delete fVertexRecalculated;
-			fVertexRecalculated = NULL;
-		}
 		if(!IsInQualityClass((AliAODTrack*)bTrack, qtyclass,bIp2d,bDCAZ)) continue;
-		bSignedImpactParameter.push_back(std::make_pair(j, bSign * bIp2d));
-		this->fTrackDCA.push_back(std::make_pair(j, bDCAZ));
-		//	Printf("%i , pt %f" , j,bTrack->Pt());
-	}
-	//	Printf("Done with loop\n");
-	discriminator[0] = -99.;
-	discriminator[1] = -99.;
-	discriminator[2] = -99.;
-	Int_t numoftracks = (Int_t)bSignedImpactParameter.size();
-	if(numoftracks < this->fSelectionCuts[AliHFJetTaggingIP::S_MINNTRACKS])
-		return kFALSE;
-	if(numoftracks == 0) {
-		bSignedImpactParameter.clear();
-		return kFALSE;
-	}
-	std::sort(bSignedImpactParameter.begin(), bSignedImpactParameter.end(), AliHFJetTaggingIP::mysort);
-	if(numoftracks > 2) {
-		discriminator[2] = bSignedImpactParameter.at(2).second;
-		fCurrentTrack[2] = jet->TrackAt((int)bSignedImpactParameter.at(2).first);
-		check_discr[2] = kTRUE;
-	//	Printf("--> %i , pt %f" , 2,this->GetCurrentTrack(2)->Pt());
-
-	}
-	if(numoftracks > 1) {
-		discriminator[1] = bSignedImpactParameter.at(1).second;
-		fCurrentTrack[1] = jet->TrackAt((int)bSignedImpactParameter.at(1).first);
-		check_discr[1] = kTRUE;
-		//	Printf("--> %i , pt %f" , 1,this->GetCurrentTrack(1)->Pt());
-
+		JetTrackIP_t ip = { j, bSign * bIp2d, bDCAZ };
+		fJetTrackIP.push_back(ip);
 	}
-	if(numoftracks > 0) {
-		discriminator[0] = bSignedImpactParameter.at(0).second;
-		fCurrentTrack[0] = jet->TrackAt((int)bSignedImpactParameter.at(0).first);
-		check_discr[0] = kTRUE;
-		//	Printf("--> %i , pt %f" , 0,this->GetCurrentTrack(0)->Pt());
-
-	}
-	SetCurrentDCAz();
-
-
+	return FillDiscriminators(discriminator, check_discr);
+}
 
-	return kTRUE;
+void AliHFJetTaggingIP::ResetIPCache()
+{
+	//========================================================================
+	// Forget the impact parameters of the previous event
+	//========================================================================
+	fTrackIP.clear();
+	fTrackIPIndex.Delete();
+	fCurrentIP = NULL;
 }
 
-Bool_t AliHFJetTaggingIP::GetImpactParameter(AliVTrack* bTrack, Double_t* bSign, Double_t* bIp2d, Double_t* zDCA)
+const AliHFJetTaggingIP::TrackIP_t* AliHFJetTaggingIP::GetTrackIP(AliVTrack* bTrack)
 {
 	//========================================================================
-	// Calculates the 2d impact parameter significance using the re-calculated event vertex
+	// Jet independent part of the impact parameter: primary vertex refitted
+	// without the track and propagation of the track to its DCA. Computed at
+	// the first request in the event and shared by all the jets (and jet radii)
+	// the track belongs to
 	//========================================================================
-	if(!bTrack || !this->fEvent || !this->fJet)
-		return kFALSE;
+	Long64_t pos = fTrackIPIndex.GetValue((Long64_t)bTrack);
+	if(pos)
+		return &fTrackIP[pos - 1];
+
 	Int_t bSkipped[2];
 	Float_t bDiamondcovxy[3];
-	Double_t bPosAtDCA[2] = { -999, -999 };
-	Double_t bCovar[3] = { -999, -999, -999 };
-	Double_t bpV[3] = { 0., 0., 0. };
-	Double_t bpTrack[3] = { 0., 0., 0. };
-	Double_t bpTrackP[3] = { 0., 0., 0. };
-
 	const Double_t kBeampiperadius = 2.6;
 
-	this->fVertex = (AliVVertex*)this->fEvent->GetPrimaryVertex();
-	AliVertexerTracks* bVertexer = new AliVertexerTracks(fEvent->GetMagneticField());
+	TrackIP_t ip;
+	ip.fOK = kFALSE;
+	for(Int_t i = 0; i < 3; ++i) {
+		ip.fVtx[i] = ip.fXYZ[i] = ip.fP[i] = 0.;
+		ip.fCovar[i] = -999.;
+	}
+	ip.fPosAtDCA[0] = ip.fPosAtDCA[1] = -999.;
 
-	bVertexer->SetITSMode();
-	bVertexer->SetMinClusters(4);
+	AliVVertex* vertex = (AliVVertex*)this->fEvent->GetPrimaryVertex();
+	AliVertexerTracks bVertexer(fEvent->GetMagneticField());
+	bVertexer.SetITSMode();
+	bVertexer.SetMinClusters(4);
 	bSkipped[0] = bTrack->GetID();
-	bVertexer->SetSkipTracks(1, bSkipped);
-	bVertexer->SetConstraintOn();
+	bVertexer.SetSkipTracks(1, bSkipped);
+	bVertexer.SetConstraintOn();
 	fEvent->GetDiamondCovXY(bDiamondcovxy);
 
 	Double_t bpos[3] = { this->fEvent->GetDiamondX(), this->fEvent->GetDiamondY(), 0. };
 	Double_t bcov[6] = { bDiamondcovxy[0], bDiamondcovxy[1], bDiamondcovxy[2], 0., 0., 10. };
-	AliESDVertex* bDiamond = new AliESDVertex(bpos, bcov, 1., 1);
-
-	bVertexer->SetVtxStart(bDiamond);
-
-	this->fVertexRecalculated = bVertexer->FindPrimaryVertex(fEvent);
-	delete bDiamond;
-	bDiamond = 0x0;
-	delete bVertexer;
-	bVertexer = NULL;
-	if(this->fVertexRecalculated)
-		this->fVertex = this->fVertexRecalculated;
-
-	AliExternalTrackParam betp;
-	betp.CopyFromVTrack(bTrack);
-	if(!(betp.PropagateToDCA(fVertex, fEvent->GetMagneticField(), kBeampiperadius, bPosAtDCA, bCovar))) {
-		if(this->fVertexRecalculated) {
-			delete this->fVertexRecalculated;
-			this->fVertexRecalculated = NULL;
-		}
-		return kFALSE;
+	AliESDVertex bDiamond(bpos, bcov, 1., 1);
+	bVertexer.SetVtxStart(&bDiamond);
+
+	AliESDVertex* recalculated = bVertexer.FindPrimaryVertex(fEvent);
+	if(recalculated)
+		vertex = recalculated;
+
+	ip.fParam.CopyFromVTrack(bTrack);
+	AliExternalTrackParam betp(ip.fParam);
+	if(betp.PropagateToDCA(vertex, fEvent->GetMagneticField(), kBeampiperadius, ip.fPosAtDCA, ip.fCovar)) {
+		ip.fOK = kTRUE;
+		vertex->GetXYZ(ip.fVtx);
+		betp.GetXYZ(ip.fXYZ);
+		betp.GetPxPyPz(ip.fP);
 	}
-	fVertex->GetXYZ(bpV);
-	betp.GetXYZ(bpTrack);
-	betp.GetPxPyPz(bpTrackP);
+	delete recalculated;
+
+	fTrackIP.push_back(ip);
+	fTrackIPIndex.Add((Long64_t)bTrack, fTrackIP.size());
+	return &fTrackIP.back();
+}
+
+Bool_t AliHFJetTaggingIP::GetImpactParameter(AliVTrack* bTrack, Double_t* bSign, Double_t* bIp2d, Double_t* zDCA)
+{
+	//========================================================================
+	// Calculates the 2d impact parameter significance using the re-calculated event vertex
+	//========================================================================
+	if(!bTrack || !this->fEvent || !this->fJet)
+		return kFALSE;
+	fCurrentIP = GetTrackIP(bTrack);
+	if(!fCurrentIP->fOK)
+		return kFALSE;
+
+	const Double_t* bPosAtDCA = fCurrentIP->fPosAtDCA;
+	const Double_t* bCovar = fCurrentIP->fCovar;
+	const Double_t* bpV = fCurrentIP->fVtx;
+	const Double_t* bpTrack = fCurrentIP->fXYZ;
 
 	Double_t bIPVector[3] = { bpTrack[0] - bpV[0], bpTrack[1] - bpV[1], bpTrack[2] - bpV[2] };
 	Double_t absIP =
@@ -337,17 +320,19 @@ Bool_t AliHFJetTaggingIP::GetImpactParameter(AliVTrack* bTrack, Double_t* bSign,
 			(bIPVector[0] * this->fJet->Px() + bIPVector[1] * this->fJet->Py() + bIPVector[2] * this->fJet->Pz()) /
 			(absIP * this->fJet->P());
 	*zDCA = bPosAtDCA[1];
-	bVar >= 0 ? *bSign = 1. : *bSign = -1.;
 
 	*bSign = bVar;
 	Double_t ptrIP = fabs(bPosAtDCA[0]);
 	if(fUse3DsIP) {
 		ptrIP = TMath::Sqrt(bPosAtDCA[0] * bPosAtDCA[0] + bPosAtDCA[1] * bPosAtDCA[1]);
 	}
-	Double_t pJetArray[3];
-	fJet->PxPyPz(pJetArray);
 	if(fUseSignAtlas) {
-		*bSign = GetSignAtlasDefinition(bpTrack, bpTrackP, bpV, pJetArray);
+		Double_t pJetArray[3];
+		fJet->PxPyPz(pJetArray);
+		Double_t xDCA[3] = { bpTrack[0], bpTrack[1], bpTrack[2] };
+		Double_t pDCA[3] = { fCurrentIP->fP[0], fCurrentIP->fP[1], fCurrentIP->fP[2] };
+		Double_t xVtx[3] = { bpV[0], bpV[1], bpV[2] };
+		*bSign = GetSignAtlasDefinition(xDCA, pDCA, xVtx, pJetArray);
 	}
 	*bIp2d = ptrIP;
 
@@ -370,19 +355,17 @@ Double_t AliHFJetTaggingIP::GetDecayLength(AliVTrack* bTrack)
 	// Calculates decay length i.e. distance from primary vertex to the position
 	// of closest aproach to the jet and the distance in that point
 	//========================================================================
-	if(!bTrack)
+	if(!bTrack || !fCurrentIP)
 		return -1.;
 	Double_t bcv[21] = { 0 };
 	Double_t bpxpypz[3] = { fJet->Px(), fJet->Py(), fJet->Pz() };
-	Double_t bpos[3] = { 0x0 };
+	Double_t bpos[3] = { fCurrentIP->fVtx[0], fCurrentIP->fVtx[1], fCurrentIP->fVtx[2] };
 	Double_t xa = 0., xb = 0.;
 	Double_t xyz[3] = { 0., 0., 0. };
 	Double_t xyzb[3] = { 0., 0., 0. };
-	this->fVertex->GetXYZ(bpos);
 	AliExternalTrackParam bjetparam(bpos, bpxpypz, bcv, (Short_t)0);
-	AliExternalTrackParam betp;
-	betp.CopyFromVTrack(bTrack);
-	if(!bTrack || !(this->fEvent->GetMagneticField()))
+	const AliExternalTrackParam& betp = fCurrentIP->fParam;
+	if(!(this->fEvent->GetMagneticField()))
 		return -1.;
 	this->fCurrentDCA = bjetparam.GetDCA(&betp, this->fEvent->GetMagneticField(), xa, xb);
 	bjetparam.GetXYZAt(xa, this->fEvent->GetMagneticField(), xyz);
@@ -437,9 +420,9 @@ Bool_t AliHFJetTaggingIP::PassedCuts(AliVTrack* bTrack, Double_t ip, Double_t ip
 
 	return kTRUE;
 }
-bool AliHFJetTaggingIP::mysort(const std::pair<Int_t, Double_t>& i, const std::pair<Int_t, Double_t>& j)
+bool AliHFJetTaggingIP::mysort(const JetTrackIP_t& i, const JetTrackIP_t& j)
 {
-	if(i.second <= j.second)
+	if(i.fSIP <= j.fSIP)
 		return false;
 	else
 		return true;
@@ -629,16 +612,3 @@ Double_t AliHFJetTaggingIP::GetCurrentTrackDCAz(int i)
 	else
 		return this->fCurrentTrackDCAz[i];
 }
-
-void AliHFJetTaggingIP::SetCurrentDCAz()
-{
-	for(int i = 0; i < 3; ++i) {
-		int curIdx = this->fCurrentTrack[i];
-		if(curIdx < 0)
-			continue;
-		for(int j = 0; j < (int)this->fTrackDCA.size(); ++j) {
-			if(fTrackDCA.at(j).first == curIdx)
-				this->fCurrentTrackDCAz[i] = fTrackDCA.at(j).second;
-		}
-	}
-}
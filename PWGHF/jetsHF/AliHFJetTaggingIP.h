@@ -4,6 +4,8 @@
 * See cxx source for full Copyright notice */
 #include <utility>
 #include <vector>
+#include "TExMap.h"
+#include "AliExternalTrackParam.h"
 
 class AliVEvent;
 class AliVVertex;
@@ -25,7 +27,9 @@ public:
     void SetEvent(AliVEvent* bEvent)
     {
 	fEvent = bEvent;
+	ResetIPCache(); // to be called for each event
     };
+    void ResetIPCache();
     void SetParticleContainer(AliParticleContainer* particles)
     {
 	fParticles = particles;
@@ -43,6 +47,23 @@ public:
     virtual Double_t GetCurrentTrackDCAz(int i = 0);
 
 private:
+    // Jet independent part of the impact parameter of a track, computed once per event
+    struct TrackIP_t {
+	Bool_t fOK;                    // propagation to the DCA succeeded
+	Double_t fVtx[3];              // primary vertex refitted without the track
+	Double_t fPosAtDCA[2];         // DCA in xy and z
+	Double_t fCovar[3];            // covariance of the DCA
+	Double_t fXYZ[3];              // track position at the DCA
+	Double_t fP[3];                // track momentum at the DCA
+	AliExternalTrackParam fParam;  // track parameters for the DCA to the jet axis
+    };
+    // Signed impact parameter of a jet constituent
+    struct JetTrackIP_t {
+	Int_t fIndex;                  // constituent index in the jet
+	Double_t fSIP;                 // signed impact parameter (significance)
+	Double_t fDCAz;                // DCA in z
+    };
+    const TrackIP_t* GetTrackIP(AliVTrack* bTrack);
     Bool_t GetImpactParameter(AliVTrack* bTrack, Double_t* bSign, Double_t* bIp2d, Double_t* zDCA);
     Bool_t PassedCuts(AliVTrack* bTrack, Double_t ip,Double_t ipz);
     Bool_t IsV0DaughterRadius(AliVTrack* track, Double_t& Radius);
@@ -50,8 +71,8 @@ private:
     Double_t GetDecayLength(AliVTrack* bTrack);
     Double_t CalculateTrackProbability(AliVTrack* bTrack);
     Double_t GetSignAtlasDefinition(Double_t* xDCA, Double_t* pDCA, Double_t* xVtx, Double_t* pJet);
-    static bool mysort(const std::pair<Int_t, Double_t>& i, const std::pair<Int_t, Double_t>& j);
-    void SetCurrentDCAz();
+    static bool mysort(const JetTrackIP_t& i, const JetTrackIP_t& j);
+    Bool_t FillDiscriminators(Double_t* discriminator, Bool_t* check_discr);
     Bool_t fUseThresholdFuction;
     Bool_t fAnaTypeAOD;
     Bool_t fUseSignAtlas;
@@ -64,7 +85,10 @@ private:
     Double_t fCurrentDCA;
     Double_t fThreshold;
     std::vector<Double_t> fDiscriminators;              //
-    std::vector<std::pair<Int_t, Double_t> > fTrackDCA; //
+    std::vector<JetTrackIP_t> fJetTrackIP;              //! signed impact parameters of the current jet
+    std::vector<TrackIP_t> fTrackIP;                    //! impact parameters of the tracks of the event
+    TExMap fTrackIPIndex;                               //! track address -> position in fTrackIP + 1
+    const TrackIP_t* fCurrentIP;                        //! impact parameter of the current track
     std::vector<unsigned int> fJetIndices; // //Indices to get matched MC jet
 	
     TF1* fThresholdFuction;           //!
@@ -74,6 +98,6 @@ private:
     AliEmcalJet* fJet;                //!
     AliParticleContainer* fParticles; //! Particle container containing AliVTracks
 
-    ClassDef(AliHFJetTaggingIP, 1);
+    ClassDef(AliHFJetTaggingIP, 2);
 };
 #endif
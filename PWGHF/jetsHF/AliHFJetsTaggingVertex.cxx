@@ -21,11 +21,13 @@
 
 //--Root--
 #include <TClonesArray.h>
+#include <TMath.h>
 
 //--AliRoot--
 #include "AliAODEvent.h"
 #include "AliAODVertex.h"
 #include "AliEmcalJet.h"
+#include "AliExternalTrackParam.h"
 #include "AliESDtrack.h"
 #include "AliESDtrackCuts.h"
 #include "AliESDVertex.h"
@@ -41,18 +43,30 @@
 ClassImp(AliHFJetsTaggingVertex)
 
 //_____________________________________________________________________________________
-AliHFJetsTaggingVertex::AliHFJetsTaggingVertex() : AliHFJetsTagging(), fCutsHFjets(NULL)
+AliHFJetsTaggingVertex::AliHFJetsTaggingVertex() : AliHFJetsTagging(), fCutsHFjets(NULL),
+  fTrackArray(NULL),
+  fVertexer(NULL),
+  fTrkPassImpPar(),
+  fTrkPt(),
+  fPairPassDCA()
 {
 
   fTrackArray = new TObjArray();
+  fVertexer   = new AliVertexerTracks();
 }
 
 //_____________________________________________________________________________________
 AliHFJetsTaggingVertex::AliHFJetsTaggingVertex(const char* name) : AliHFJetsTagging(name),
-  fCutsHFjets(NULL)
+  fCutsHFjets(NULL),
+  fTrackArray(NULL),
+  fVertexer(NULL),
+  fTrkPassImpPar(),
+  fTrkPt(),
+  fPairPassDCA()
 {
 
   fTrackArray = new TObjArray();
+  fVertexer   = new AliVertexerTracks();
 }
 
 //_____________________________________________________________________________________
@@ -63,6 +77,10 @@ AliHFJetsTaggingVertex::~AliHFJetsTaggingVertex()
     delete fTrackArray; fTrackArray = NULL;
   }
 
+  if (fVertexer) {
+    delete fVertexer; fVertexer = NULL;
+  }
+
   if (fCutsHFjets) {
     delete fCutsHFjets; fCutsHFjets = NULL;
   }
@@ -152,8 +170,12 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
     return -4;
   }
 
+  // daughter cuts which do not depend on the vertex, evaluated once per jet
+  FillCombinationTables(jet, fTrackArrayIn, vecESDTrks, aodEvent, magZkG);
+
   Int_t up = nGoodTrks - ((nProngTrack == 2) ? 1 : 2);
   Int_t nVtxContributorsBelongToV0 = 0;
+  Int_t combIdx[3];
   for (Int_t it1 = 0; it1 < up; ++it1) {
 
     Int_t        jTrkID_1 = (vecESDTrks.at(it1)).first;
@@ -167,6 +189,15 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
       Int_t        jTrkID_2 = (vecESDTrks.at(it2)).first;
       AliESDtrack* esdTrk_2 = (vecESDTrks.at(it2)).second;
 
+      // all the combinations containing a pair failing the DCA cut are rejected
+      if (!fPairPassDCA[it1 * nGoodTrks + it2])
+        continue;
+
+      combIdx[0] = it1;
+      combIdx[1] = it2;
+      if (nProngTrack == 2 && !IsCombinationSelected(2, combIdx))
+        continue;
+
       fTrackArray->AddAt(esdTrk_2, 1);
 
       if (nProngTrack == 2) {
@@ -179,8 +210,10 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
           secAODVertex->AddDaughter(aodTrk_1);
           secAODVertex->AddDaughter(aodTrk_2);
 
-          if (!fCutsHFjets->IsVertexSelected(secAODVertex, aodEvent, magZkG, vtxRes))
+          if (!fCutsHFjets->IsVertexSelected(secAODVertex, aodEvent, magZkG, vtxRes)) {
+            delete secAODVertex;
             continue;
+          }
 
           if (mapV0gTrks != NULL) {
             nVtxContributorsBelongToV0 = (* mapV0gTrks)[aodTrk_1->GetID()] +
@@ -190,6 +223,7 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
           new ((* arrayVtxHF)[nSecndVxtHF]) AliAODVertex(* secAODVertex);
           vecVtxDisp.push_back(make_pair(vtxRes, nVtxContributorsBelongToV0));
           nSecndVxtHF++;
+          delete secAODVertex;
         } // end if (vert)
       } else { // end if ( nProngTrack == 2 )
         for (Int_t it3 = it2 + 1; it3 < nGoodTrks; ++it3) {
@@ -197,6 +231,10 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
           Int_t        jTrkID_3 = (vecESDTrks.at(it3)).first;
           AliESDtrack* esdTrk_3 = (vecESDTrks.at(it3)).second;
 
+          combIdx[2] = it3;
+          if (!IsCombinationSelected(3, combIdx))
+            continue;
+
           fTrackArray->AddAt(esdTrk_3, 2);
 
           AliAODVertex* secAODVertex = ReconstructSecondaryVertex(fTrackArray, primaryESDVertex, magZkG, vtxRes);
@@ -210,8 +248,10 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
             secAODVertex->AddDaughter(aodTrk_2);
             secAODVertex->AddDaughter(aodTrk_3);
 
-            if (!fCutsHFjets->IsVertexSelected(secAODVertex, aodEvent, magZkG, vtxRes))
+            if (!fCutsHFjets->IsVertexSelected(secAODVertex, aodEvent, magZkG, vtxRes)) {
+              delete secAODVertex;
               continue;
+            }
 
             if (mapV0gTrks != NULL) {
               nVtxContributorsBelongToV0 =  (* mapV0gTrks)[aodTrk_1->GetID()] +
@@ -221,6 +261,7 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
             new ((* arrayVtxHF)[nSecndVxtHF]) AliAODVertex(* secAODVertex);
             vecVtxDisp.push_back(make_pair(vtxRes, nVtxContributorsBelongToV0));
             nSecndVxtHF++;
+            delete secAODVertex;
           } // end if (vert)
         } // end for it3
       } // end else
@@ -233,6 +274,88 @@ Int_t AliHFJetsTaggingVertex::FindVertices(const AliEmcalJet* jet,
   return nSecndVxtHF;
 }
 
+//_____________________________________________________________________________________
+void AliHFJetsTaggingVertex::FillCombinationTables(const AliEmcalJet*          jet,
+                                                   TClonesArray*               fTrackArrayIn,
+                                                   const vctr_pair_int_esdTrk& vecESDTrks,
+                                                   AliAODEvent*                aodEvent,
+                                                   Double_t                    magZkG)
+{
+  // Per jet tables of the good daughter tracks:
+  // - |d0xy| to the primary vertex above the impact parameter cut and pt,
+  //   as checked on the daughters in AliRDHFJetsCutsVertex::IsVertexSelected
+  // - closest approach between each pair of tracks below the pair DCA cut
+
+  Int_t nGoodTrks = (Int_t)vecESDTrks.size();
+
+  fTrkPassImpPar.assign(nGoodTrks, kTRUE);
+  fTrkPt.assign(nGoodTrks, 0.);
+  fPairPassDCA.assign(nGoodTrks * nGoodTrks, kTRUE);
+
+  AliAODVertex* aodPrimVtx = (AliAODVertex*)aodEvent->GetPrimaryVertex();
+  Double_t impParCut = fCutsHFjets->GetImpParCut();
+
+  for (Int_t it = 0; it < nGoodTrks; ++it) {
+    AliAODTrack* aodTrk = (AliAODTrack*)jet->TrackAt((vecESDTrks.at(it)).first, fTrackArrayIn);
+    fTrkPt[it] = aodTrk->Pt();
+
+    // on a copy, not to move the AOD track to the DCA
+    AliExternalTrackParam etp;
+    etp.CopyFromVTrack(aodTrk);
+    Double_t d0z0[2], covd0z0[3];
+    if (etp.PropagateToDCA(aodPrimVtx, magZkG, kVeryBig, d0z0, covd0z0))
+      fTrkPassImpPar[it] = (TMath::Abs(d0z0[0]) > impParCut);
+  }
+
+  Double_t maxDCAPair = fCutsHFjets->GetMaxDCAPair();
+  if (maxDCAPair < 0.)
+    return;
+
+  for (Int_t it1 = 0; it1 < nGoodTrks - 1; ++it1) {
+    AliESDtrack* esdTrk_1 = (vecESDTrks.at(it1)).second;
+    for (Int_t it2 = it1 + 1; it2 < nGoodTrks; ++it2) {
+      AliESDtrack* esdTrk_2 = (vecESDTrks.at(it2)).second;
+      Double_t xa, xb;
+      Bool_t pass = (esdTrk_1->GetDCA(esdTrk_2, magZkG, xa, xb) < maxDCAPair);
+      fPairPassDCA[it1 * nGoodTrks + it2] = pass;
+      fPairPassDCA[it2 * nGoodTrks + it1] = pass;
+    }
+  }
+}
+
+//_____________________________________________________________________________________
+Bool_t AliHFJetsTaggingVertex::IsCombinationSelected(Int_t nTrks, const Int_t* idx) const
+{
+  // Cuts on a combination of good daughters (indices in the per jet tables) which
+  // can be applied before the vertex fit: all the pairs pass the DCA cut, at least
+  // nTrks-1 tracks pass the impact parameter cut, the hardest track pt
+
+  Int_t nGoodTrks = (Int_t)fTrkPt.size();
+  Int_t nPassImpPar = 0;
+  Double_t maxPt = 0.;
+
+  for (Int_t i = 0; i < nTrks; ++i) {
+    for (Int_t j = i + 1; j < nTrks; ++j) {
+      if (!fPairPassDCA[idx[i] * nGoodTrks + idx[j]])
+        return kFALSE;
+    }
+
+    if (fTrkPassImpPar[idx[i]])
+      nPassImpPar++;
+
+    if (fTrkPt[idx[i]] > maxPt)
+      maxPt = fTrkPt[idx[i]];
+  }
+
+  if (nPassImpPar < nTrks - 1)
+    return kFALSE;
+
+  if (maxPt < fCutsHFjets->GetMinPtHardestTrack())
+    return kFALSE;
+
+  return kTRUE;
+}
+
 //_____________________________________________________________________________________
 AliAODVertex* AliHFJetsTaggingVertex::ReconstructSecondaryVertex(TObjArray*    trkArray,
                                                                  AliESDVertex* v1,
@@ -245,7 +368,8 @@ AliAODVertex* AliHFJetsTaggingVertex::ReconstructSecondaryVertex(TObjArray*    t
   //AliCodeTimerAuto("",0);
 
   AliESDVertex*      vertexESD = NULL;
-  AliVertexerTracks* vertexerTracks = new AliVertexerTracks(magzkG);
+  AliVertexerTracks* vertexerTracks = fVertexer;
+  vertexerTracks->SetFieldkG(magzkG);
 
   Int_t nProngTrks   = trkArray->GetEntriesFast();
   Int_t secVtxWithKF = fCutsHFjets->GetSecVtxWithKF();
@@ -304,7 +428,6 @@ AliAODVertex* AliHFJetsTaggingVertex::ReconstructSecondaryVertex(TObjArray*    t
   vtxRes   = vertexESD->GetDispersion();
 
   delete vertexESD; vertexESD = NULL;
-  delete vertexerTracks;
 
   return (new AliAODVertex(pos, cov, chi2xNDF, NULL, -1, AliAODVertex::kUndef, nProngTrks));
 }
@@ -21,6 +21,7 @@ class AliAODEvent;
 class AliAODVertex;
 class AliEmcalJet;
 class AliESDVertex;
+class AliVertexerTracks;
 
 //--AliHFJetsClass--
 #include "AliHFJetsUtils.h"
@@ -85,13 +86,28 @@ protected:
     }
   };
 
+  void  FillCombinationTables(const AliEmcalJet*          jet,
+                              TClonesArray*               fTrackArrayIn,
+                              const vctr_pair_int_esdTrk& vecESDTrks,
+                              AliAODEvent*                aodEvent,
+                              Double_t                    magZkG);
+
+  Bool_t IsCombinationSelected(Int_t nTrks, const Int_t* idx) const;
+
 private:
 
   AliRDHFJetsCutsVertex* fCutsHFjets;  // jet cut object
 
   TObjArray*             fTrackArray;  //! track array
 
-  ClassDef(AliHFJetsTaggingVertex, 2);
+  AliVertexerTracks*     fVertexer;    //! secondary vertexer, reused for all the fits
+
+  // per jet tables of the good daughter tracks, used to reject combinations before the fit
+  vector<Bool_t>         fTrkPassImpPar; //! |d0xy| above the impact parameter cut
+  vector<Double_t>       fTrkPt;         //! pt
+  vector<Bool_t>         fPairPassDCA;   //! DCA between the two tracks below the cut, [i*n+j]
+
+  ClassDef(AliHFJetsTaggingVertex, 3);
 };
 
 //-------------------------------------------------------------------------------------
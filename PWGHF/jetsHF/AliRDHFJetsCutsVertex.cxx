@@ -67,7 +67,8 @@ AliRDHFJetsCutsVertex::AliRDHFJetsCutsVertex(const Char_t* name, const Char_t* t
   fInvMassCut(0),
   fSigvert(1000),
   fChi2(1000),
-  fIsElec(0)
+  fIsElec(0),
+  fMaxDCAPair(-1.)
 {
   //
   // Default Constructor
@@ -86,7 +87,8 @@ AliRDHFJetsCutsVertex::AliRDHFJetsCutsVertex(const AliRDHFJetsCutsVertex &source
   fInvMassCut(source.fInvMassCut),
   fSigvert(source.fSigvert),
   fChi2(source.fChi2),
-  fIsElec(source.fIsElec)
+  fIsElec(source.fIsElec),
+  fMaxDCAPair(source.fMaxDCAPair)
 {
   //
   // Copy constructor
@@ -113,6 +115,7 @@ AliRDHFJetsCutsVertex &AliRDHFJetsCutsVertex::operator=(const AliRDHFJetsCutsVer
   fSigvert=source.fSigvert;
   fChi2=source.fChi2;
   fIsElec=source.fIsElec;
+  fMaxDCAPair=source.fMaxDCAPair;
 
   return *this;
 }
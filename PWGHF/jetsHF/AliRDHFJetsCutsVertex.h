@@ -48,6 +48,7 @@ class AliRDHFJetsCutsVertex : public AliRDHFJetsCuts {
   void SetSigmaVert(Double_t sig){fSigvert=sig;}
   void SetChi2(Double_t chi){fChi2=chi;}
   void SetIsElec(Bool_t eflag=kFALSE){fIsElec=eflag;}
+  void SetMaxDCAPair(Double_t dca){fMaxDCAPair=dca;}
 
   //getters
  
@@ -61,6 +62,7 @@ class AliRDHFJetsCutsVertex : public AliRDHFJetsCuts {
   Double_t GetSigmaVert(){return fSigvert;}
   Double_t GetVertChi2(){return fChi2;}
   Double_t GetIsElec(){return fIsElec;}
+  Double_t GetMaxDCAPair(){return fMaxDCAPair;}
  
  protected:
 
@@ -74,8 +76,9 @@ class AliRDHFJetsCutsVertex : public AliRDHFJetsCuts {
   Double_t fSigvert;
   Double_t fChi2;
   Bool_t fIsElec;
+  Double_t fMaxDCAPair; //max DCA between each pair of daughters, checked before the vertex fit (<0: no cut)
 
-  ClassDef(AliRDHFJetsCutsVertex,1);  // base class for cuts on AOD reconstructed heavy-flavour decays
+  ClassDef(AliRDHFJetsCutsVertex,2);  // base class for cuts on AOD reconstructed heavy-flavour decays
 };
 
 #endif
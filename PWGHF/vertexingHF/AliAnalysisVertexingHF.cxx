@@ -52,6 +52,7 @@
 #include "AliAODRecoDecayHF3Prong.h"
 #include "AliAODRecoDecayHF4Prong.h"
 #include "AliAODRecoCascadeHF.h"
+#include "AliHFRecoCandCache.h"
 #include "AliRDHFCutsD0toKpi.h"
 #include "AliRDHFCutsJpsitoee.h"
 #include "AliRDHFCutsDplustoK0spi.h"
@@ -70,6 +71,7 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#include <vector>
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
@@ -138,6 +140,8 @@ fFindVertexForDstar(kTRUE),
 fFindVertexForCascades(kTRUE),
 fV0TypeForCascadeVertex(0),
 fMassCutBeforeVertexing(kFALSE),
+fPairKinematicPreselection(kFALSE),
+fUseSharedFillCache(kFALSE),
 fMassCalc2(0),
 fMassCalc3(0),
 fMassCalc4(0),
@@ -233,6 +237,8 @@ fFindVertexForDstar(source.fFindVertexForDstar),
 fFindVertexForCascades(source.fFindVertexForCascades),
 fV0TypeForCascadeVertex(source.fV0TypeForCascadeVertex),
 fMassCutBeforeVertexing(source.fMassCutBeforeVertexing),
+fPairKinematicPreselection(source.fPairKinematicPreselection),
+fUseSharedFillCache(source.fUseSharedFillCache),
 fMassCalc2(source.fMassCalc2),
 fMassCalc3(source.fMassCalc3),
 fMassCalc4(source.fMassCalc4),
@@ -327,6 +333,8 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fFindVertexForCascades = source.fFindVertexForCascades;
   fV0TypeForCascadeVertex = source.fV0TypeForCascadeVertex;
   fMassCutBeforeVertexing = source.fMassCutBeforeVertexing;
+  fPairKinematicPreselection = source.fPairKinematicPreselection;
+  fUseSharedFillCache = source.fUseSharedFillCache;
   fMassCalc2 = source.fMassCalc2;
   fMassCalc3 = source.fMassCalc3;
   fMassCalc4 = source.fMassCalc4;
@@ -618,6 +626,19 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // momenta at primary vertex of the selected tracks and highest pt of the
+  // displaced ones, for the kinematic preselection of the track pairs
+  std::vector<Double_t> momAtVtx;
+  Double_t ptMaxDispl=0.;
+  if(fPairKinematicPreselection) {
+    momAtVtx.resize(3*nSeleTrks);
+    for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+      AliExternalTrackParam *trkAtVtx=(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk);
+      trkAtVtx->GetPxPyPz(&momAtVtx[3*iTrk]);
+      if(TESTBIT(seleFlags[iTrk],kBitDispl) && trkAtVtx->Pt()>ptMaxDispl) ptMaxDispl=trkAtVtx->Pt();
+    }
+  }
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -859,6 +880,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
       }
 
+      // reject pairs that cannot seed any candidate, before propagation
+      if(fPairKinematicPreselection &&
+	 !IsPairKinematicallyCompatible(&momAtVtx[3*iTrkP1],&momAtVtx[3*iTrkN1],isLikeSign2Prong,ptMaxDispl)) {
+	negtrack1=0;
+	continue;
+      }
+
       // back to primary vertex
       //      postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
       //      negtrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1701,6 +1729,8 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF3P
   // and fill on-the-fly the data member of rd
   if(rd->GetIsFilled()!=0)return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1: standard dAOD, 2 already refilled)
   if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
+  AliHFRecoCandCache *cache = fUseSharedFillCache ? AliHFRecoCandCache::GetCache(dynamic_cast<AliAODEvent*>(event)) : 0;
+  if(cache && cache->IsFillFailed(rd,3)) return kFALSE;//already failed in another wagon
   TObjArray *threeTrackArray   = new TObjArray(3);
 
   AliAODTrack *track1 =(AliAODTrack*)event->GetTrack(fAODMap[rd->GetProngID(0)]);//retrieve daughter from the trackID through the AOD index map
@@ -1747,6 +1777,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF3P
     delete postrack1; postrack1=NULL;
     delete negtrack1; negtrack1=NULL;
     delete esdt3; esdt3=NULL;
+    if(cache) cache->SetFillFailed(rd,3);
     return kFALSE;
   }
 
@@ -1771,6 +1802,8 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF2P
   // and fill on-the-fly the data member of rd
   if(rd->GetIsFilled()!=0)return kTRUE;//if 0: reduced dAOD. skip if rd is already filled (1:standard dAOD, 2 already refilled)
   if(!fAODMap)MapAODtracks(event);//fill the AOD index map if it is not yet done
+  AliHFRecoCandCache *cache = fUseSharedFillCache ? AliHFRecoCandCache::GetCache(dynamic_cast<AliAODEvent*>(event)) : 0;
+  if(cache && cache->IsFillFailed(rd,2)) return kFALSE;//already failed in another wagon
 
   Double_t dispersion;
   TObjArray *twoTrackArray1    = new TObjArray(2);
@@ -1808,6 +1841,7 @@ Bool_t AliAnalysisVertexingHF::FillRecoCand(AliVEvent *event,AliAODRecoDecayHF2P
     delete fV1; fV1=0;
     delete esdt1; esdt1=NULL;
     delete esdt2; esdt2=NULL;
+    if(cache) cache->SetFillFailed(rd,2);
     return kFALSE;     }
   Bool_t okD0=kFALSE;
   Bool_t okJPSI=kFALSE;
@@ -3020,6 +3054,63 @@ Bool_t AliAnalysisVertexingHF::SelectInvMassAndPt3prong(TObjArray *trkArray){
   return retval;
 }
 
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::IsPairKinematicallyCompatible(const Double_t *p1,
+							     const Double_t *p2,
+							     Bool_t isLikeSign,
+							     Double_t ptMaxOther) const {
+  /// Quick check, with the momenta at the primary vertex, whether a track pair
+  /// can be part of any of the requested 2, 3 or 4 prong candidates.
+  /// The pair mass in the lightest mass hypothesis is a lower bound for the
+  /// mass of each candidate containing the pair, and the candidate pt is at most
+  /// the pair pt plus ptMaxOther for each additional prong.
+  /// Mass windows and pt thresholds are the ones of SelectInvMassAndPt*.
+
+  // D0 from D* are selected with the D* cuts, no bound is applied
+  if(fDstar) return kTRUE;
+
+  static const Double_t kMassPi=TDatabasePDG::Instance()->GetParticle(211)->Mass();
+  static const Double_t kMassEle=TDatabasePDG::Instance()->GetParticle(11)->Mass();
+
+  Double_t px=p1[0]+p2[0];
+  Double_t py=p1[1]+p2[1];
+  Double_t pz=p1[2]+p2[2];
+  Double_t pt=TMath::Sqrt(px*px+py*py);
+  Double_t p2sum=px*px+py*py+pz*pz;
+  Double_t mom1sq=p1[0]*p1[0]+p1[1]*p1[1]+p1[2]*p1[2];
+  Double_t mom2sq=p2[0]*p2[0]+p2[1]*p2[1]+p2[2]*p2[2];
+  Double_t energy=TMath::Sqrt(mom1sq+kMassPi*kMassPi)+TMath::Sqrt(mom2sq+kMassPi*kMassPi);
+  Double_t massPiPi=TMath::Sqrt(TMath::Max(energy*energy-p2sum,0.));
+  Double_t minPt=0;
+  Double_t hilim;
+
+  if(fD0toKpi) {
+    minPt=fCutsD0toKpi->GetMinPtCandidate();
+    hilim=fMassDzero+fCutsD0toKpi->GetMassCut();
+    if(massPiPi<hilim && (minPt<=0.1 || pt>=minPt)) return kTRUE;
+  }
+  if(fJPSItoEle) {
+    energy=TMath::Sqrt(mom1sq+kMassEle*kMassEle)+TMath::Sqrt(mom2sq+kMassEle*kMassEle);
+    Double_t massEE=TMath::Sqrt(TMath::Max(energy*energy-p2sum,0.));
+    minPt=fCutsJpsitoee->GetMinPtCandidate();
+    hilim=fMassJpsi+fCutsJpsitoee->GetMassCut();
+    if(massEE<hilim && (minPt<=0.1 || pt>=minPt)) return kTRUE;
+  }
+  if(f3Prong) {
+    minPt=TMath::Min(fCutsDplustoKpipi->GetMinPtCandidate(),fCutsDstoKKpi->GetMinPtCandidate());
+    minPt=TMath::Min(minPt,fCutsLctopKpi->GetMinPtCandidate());
+    hilim=TMath::Max(fMassDplus+fCutsDplustoKpipi->GetMassCut(),fMassDs+fCutsDstoKKpi->GetMassCut());
+    hilim=TMath::Max(hilim,fMassLambdaC+fCutsLctopKpi->GetMassCut());
+    if(massPiPi+kMassPi<hilim && (minPt<=0.1 || pt+ptMaxOther>=minPt)) return kTRUE;
+  }
+  if(f4Prong && !isLikeSign) {
+    minPt=fCutsD0toKpipipi->GetMinPtCandidate();
+    hilim=fMassDzero+fCutsD0toKpipipi->GetMassCut();
+    if(massPiPi+2.*kMassPi<hilim && (minPt<=0.1 || pt+2.*ptMaxOther>=minPt)) return kTRUE;
+  }
+
+  return kFALSE;
+}
 //-----------------------------------------------------------------------------
 Bool_t AliAnalysisVertexingHF::SelectInvMassAndPt4prong(TObjArray *trkArray){
   /// Invariant mass cut on tracks
@@ -179,6 +179,10 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  void SetPairKinematicPreselection(Bool_t flag) { fPairKinematicPreselection=flag; }
+  Bool_t GetPairKinematicPreselection() const { return fPairKinematicPreselection; }
+  void SetUseSharedFillCache(Bool_t flag=kTRUE) { fUseSharedFillCache=flag; }
+  Bool_t GetUseSharedFillCache() const { return fUseSharedFillCache; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -324,6 +328,8 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t fFindVertexForCascades;  /// reconstruct a secondary vertex or assume it's from the primary vertex
   Int_t  fV0TypeForCascadeVertex;  /// Select which V0 type we want to use for the cascas
   Bool_t fMassCutBeforeVertexing; /// to go faster in PbPb
+  Bool_t fPairKinematicPreselection; /// reject track pairs with mass/pt bounds before propagation and vertexing
+  Bool_t fUseSharedFillCache; /// do not retry in FillRecoCand the candidates that already failed in this event (AliHFRecoCandCache)
   // dummies for invariant mass calculation
   AliAODRecoDecay *fMassCalc2; /// for 2 prong
   AliAODRecoDecay *fMassCalc3; /// for 3 prong
@@ -402,6 +408,8 @@ class AliAnalysisVertexingHF : public TNamed {
   Bool_t SelectInvMassAndPtCascade(Double_t *px,Double_t *py,Double_t *pz);
 
   Bool_t SelectInvMassAndPt3prong(TObjArray *trkArray);
+  Bool_t IsPairKinematicallyCompatible(const Double_t *p1,const Double_t *p2,
+				       Bool_t isLikeSign,Double_t ptMaxOther) const;
   Bool_t SelectInvMassAndPt4prong(TObjArray *trkArray);
   Bool_t SelectInvMassAndPtDstarD0pi(TObjArray *trkArray);
 
@@ -420,7 +428,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,29);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
@@ -0,0 +1,234 @@
+/**************************************************************************
+ * Copyright(c) 2008-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <TH1F.h>
+#include <TTree.h>
+#include <TCollection.h>
+#include "AliLog.h"
+#include "AliHFMassFitter.h"
+#include "AliHFMassFitterBatch.h"
+
+/// \cond CLASSIMP
+ClassImp(AliHFMassFitterBatch);
+/// \endcond
+
+//_________________________________________________________________________
+AliHFMassFitterBatch::AliHFMassFitterBatch() :
+  TNamed(),
+  fHistos(),
+  fConfMinMass(),
+  fConfMaxMass(),
+  fConfRebin(),
+  fConfTypeBkg(),
+  fConfTypeSgn(),
+  fConfFixSigma(),
+  fInitialMean(1.865),
+  fInitialSigma(0.012),
+  fWarmStart(kTRUE),
+  fNSigmaForBkg(3.),
+  fFitOption("L,E"),
+  fStatus(),
+  fResults()
+{
+  /// default constructor
+  fHistos.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________
+AliHFMassFitterBatch::AliHFMassFitterBatch(const char* name, const char* title) :
+  TNamed(name,title),
+  fHistos(),
+  fConfMinMass(),
+  fConfMaxMass(),
+  fConfRebin(),
+  fConfTypeBkg(),
+  fConfTypeSgn(),
+  fConfFixSigma(),
+  fInitialMean(1.865),
+  fInitialSigma(0.012),
+  fWarmStart(kTRUE),
+  fNSigmaForBkg(3.),
+  fFitOption("L,E"),
+  fStatus(),
+  fResults()
+{
+  /// standard constructor
+  fHistos.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________
+AliHFMassFitterBatch::~AliHFMassFitterBatch(){
+  /// destructor
+}
+
+//_________________________________________________________________________
+Int_t AliHFMassFitterBatch::AddHisto(const TH1F* histo){
+  /// add a histogram to the batch, return its index
+  if(!histo){
+    AliError("Histogram not defined");
+    return -1;
+  }
+  TH1F* hcopy=(TH1F*)histo->Clone(Form("%s_%d",histo->GetName(),GetNHistos()));
+  hcopy->SetDirectory(0);
+  fHistos.AddLast(hcopy);
+  ResizeResults();
+  return GetNHistos()-1;
+}
+
+//_________________________________________________________________________
+Int_t AliHFMassFitterBatch::AddConfiguration(Double_t minMass, Double_t maxMass, Int_t rebin,
+					     Int_t typeb, Int_t types, Double_t fixedSigma){
+  /// add a fit configuration to the batch, return its index
+  if(minMass>=maxMass){
+    AliError(Form("Invalid fit range %f-%f",minMass,maxMass));
+    return -1;
+  }
+  fConfMinMass.push_back(minMass);
+  fConfMaxMass.push_back(maxMass);
+  fConfRebin.push_back(rebin>0 ? rebin : 1);
+  fConfTypeBkg.push_back(typeb);
+  fConfTypeSgn.push_back(types);
+  fConfFixSigma.push_back(fixedSigma);
+  ResizeResults();
+  return GetNConfigurations()-1;
+}
+
+//_________________________________________________________________________
+void AliHFMassFitterBatch::ResizeResults(){
+  /// reset the result table to the current number of fits
+  Int_t nFits=GetNFits();
+  fStatus.assign(nFits,kNotFitted);
+  fResults.assign(kNResults*nFits,0.);
+}
+
+//_________________________________________________________________________
+Bool_t AliHFMassFitterBatch::Fit(Int_t iShard, Int_t nShards){
+  /// fit the configurations with iConf%nShards==iShard for all histograms
+  if(nShards<1 || iShard<0 || iShard>=nShards){
+    AliError(Form("Invalid shard %d of %d",iShard,nShards));
+    return kFALSE;
+  }
+  Int_t nHistos=GetNHistos();
+  Bool_t allOK=kTRUE;
+  for(Int_t iConf=iShard; iConf<GetNConfigurations(); iConf+=nShards){
+    Double_t mean=fInitialMean;
+    Double_t sigma=fInitialSigma;
+    for(Int_t iHisto=0; iHisto<nHistos; iHisto++){
+      Bool_t ok=FitOne(iHisto,iConf,mean,sigma);
+      if(!ok) allOK=kFALSE;
+      if(fWarmStart && ok){
+	mean=GetResult(kMean,iHisto,iConf);
+	sigma=GetResult(kSigma,iHisto,iConf);
+      }else{
+	mean=fInitialMean;
+	sigma=fInitialSigma;
+      }
+    }
+  }
+  return allOK;
+}
+
+//_________________________________________________________________________
+Bool_t AliHFMassFitterBatch::FitOne(Int_t iHisto, Int_t iConf, Double_t initMean, Double_t initSigma){
+  /// fit one histogram with one configuration and fill the result table
+  TH1F* histo=(TH1F*)fHistos.UncheckedAt(iHisto);
+  Int_t iFit=GetFitIndex(iHisto,iConf);
+  Int_t nFits=GetNFits();
+
+  AliHFMassFitter fitter(histo,fConfMinMass[iConf],fConfMaxMass[iConf],fConfRebin[iConf],fConfTypeBkg[iConf],fConfTypeSgn[iConf]);
+  fitter.SetFitOption(fFitOption);
+  fitter.SetInitialGaussianMean(initMean);
+  fitter.SetInitialGaussianSigma(initSigma);
+  if(fConfFixSigma[iConf]>0.) fitter.SetFixGaussianSigma(fConfFixSigma[iConf],kTRUE);
+
+  if(!fitter.MassFitter(kFALSE)){
+    fStatus[iFit]=kFailed;
+    for(Int_t iRes=0; iRes<kNResults; iRes++) fResults[iRes*nFits+iFit]=0.;
+    return kFALSE;
+  }
+
+  Double_t bkg=0.,errBkg=0.,signif=0.,errSignif=0.;
+  if(fConfTypeBkg[iConf]!=AliHFMassFitter::kNoBk) {
+    fitter.Background(fNSigmaForBkg,bkg,errBkg);
+    fitter.Significance(fNSigmaForBkg,signif,errSignif);
+  }
+  fResults[kRawYield*nFits+iFit]=fitter.GetRawYield();
+  fResults[kRawYieldErr*nFits+iFit]=fitter.GetRawYieldError();
+  fResults[kMean*nFits+iFit]=fitter.GetMean();
+  fResults[kMeanErr*nFits+iFit]=fitter.GetMeanUncertainty();
+  fResults[kSigma*nFits+iFit]=fitter.GetSigma();
+  fResults[kSigmaErr*nFits+iFit]=fitter.GetSigmaUncertainty();
+  fResults[kReducedChi2*nFits+iFit]=fitter.GetReducedChiSquare();
+  fResults[kBackground*nFits+iFit]=bkg;
+  fResults[kBackgroundErr*nFits+iFit]=errBkg;
+  fResults[kSignificance*nFits+iFit]=signif;
+  fResults[kSignificanceErr*nFits+iFit]=errSignif;
+  fStatus[iFit]=kOK;
+  return kTRUE;
+}
+
+//_________________________________________________________________________
+TTree* AliHFMassFitterBatch::MakeTree(const char* name) const {
+  /// one entry per fit, with the indices of histogram and configuration
+  static const char* colNames[kNResults]={"rawYield","rawYieldErr","mean","meanErr","sigma","sigmaErr",
+					  "redChi2","bkg","bkgErr","signif","signifErr"};
+  TTree* tree=new TTree(name,"mass fit results");
+  tree->SetDirectory(0);
+  Int_t iHisto=0,iConf=0,status=0;
+  Double_t values[kNResults];
+  tree->Branch("iHisto",&iHisto,"iHisto/I");
+  tree->Branch("iConf",&iConf,"iConf/I");
+  tree->Branch("status",&status,"status/I");
+  for(Int_t iRes=0; iRes<kNResults; iRes++) tree->Branch(colNames[iRes],&values[iRes],Form("%s/D",colNames[iRes]));
+  Int_t nFits=GetNFits();
+  for(Int_t iFit=0; iFit<nFits; iFit++){
+    iHisto=iFit%GetNHistos();
+    iConf=iFit/GetNHistos();
+    status=fStatus[iFit];
+    for(Int_t iRes=0; iRes<kNResults; iRes++) values[iRes]=fResults[iRes*nFits+iFit];
+    tree->Fill();
+  }
+  tree->ResetBranchAddresses();
+  return tree;
+}
+
+//_________________________________________________________________________
+Long64_t AliHFMassFitterBatch::Merge(TCollection* list){
+  /// merge the results of batches with the same histograms and
+  /// configurations fitted in different shards
+  if (!list) return 0;
+  if (list->IsEmpty()) return 1;
+
+  Int_t nFits=GetNFits();
+  TIter next(list);
+  const TObject* obj = 0x0;
+  while ((obj = next())) {
+    const AliHFMassFitterBatch* batch = dynamic_cast<const AliHFMassFitterBatch*>(obj);
+    if (!batch) {
+      AliError(Form("object named %s is not AliHFMassFitterBatch! Skipping it.", obj->GetName()));
+      continue;
+    }
+    if (batch->GetNHistos()!=GetNHistos() || batch->GetNConfigurations()!=GetNConfigurations()) {
+      AliError(Form("object named %s has a different number of fits! Skipping it.", obj->GetName()));
+      continue;
+    }
+    for(Int_t iFit=0; iFit<nFits; iFit++){
+      if(batch->fStatus[iFit]==kNotFitted) continue;
+      fStatus[iFit]=batch->fStatus[iFit];
+      for(Int_t iRes=0; iRes<kNResults; iRes++) fResults[iRes*nFits+iFit]=batch->fResults[iRes*nFits+iFit];
+    }
+  }
+  return (Long64_t)1;
+}
@@ -0,0 +1,106 @@
+#ifndef ALIHFMASSFITTERBATCH_H
+#define ALIHFMASSFITTERBATCH_H
+/* Copyright(c) 2008-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <TNamed.h>
+#include <TObjArray.h>
+#include <vector>
+
+class TH1F;
+class TTree;
+class TCollection;
+
+/////////////////////////////////////////////////////////////
+///
+/// \class AliHFMassFitterBatch
+/// \brief Batch of invariant mass fits with AliHFMassFitter
+///
+/// Fits all the combinations of a list of histograms (e.g. pt bins or
+/// cut variations) and a list of fit configurations (range, rebin,
+/// background and signal function, fixed sigma). For each configuration
+/// the histograms are fitted in the order in which they were added, and
+/// the gaussian mean and sigma of a successful fit are used as initial
+/// values for the next histogram.
+///
+/// The results are stored in a columnar table: GetColumn(kRawYield)
+/// returns the raw yields of all the fits, with fit index
+/// iConf*GetNHistos()+iHisto. The fits can be split in shards with
+/// Fit(iShard,nShards) (one shard = a subset of the configurations)
+/// to be run in separate jobs, and the outputs merged with Merge().
+///
+/////////////////////////////////////////////////////////////
+
+class AliHFMassFitterBatch : public TNamed {
+
+ public:
+
+  enum EResult{ kRawYield=0, kRawYieldErr, kMean, kMeanErr, kSigma, kSigmaErr,
+		kReducedChi2, kBackground, kBackgroundErr, kSignificance, kSignificanceErr,
+		kNResults };
+  enum EFitStatus{ kNotFitted=-1, kFailed=0, kOK=1 };
+
+  AliHFMassFitterBatch();
+  AliHFMassFitterBatch(const char* name, const char* title="");
+  virtual ~AliHFMassFitterBatch();
+
+  Int_t AddHisto(const TH1F* histo);
+  Int_t AddConfiguration(Double_t minMass, Double_t maxMass, Int_t rebin=1,
+			 Int_t typeb=0, Int_t types=0, Double_t fixedSigma=-1.);
+
+  void SetInitialGaussianMean(Double_t mean) {fInitialMean=mean;}
+  void SetInitialGaussianSigma(Double_t sigma) {fInitialSigma=sigma;}
+  void SetWarmStart(Bool_t opt=kTRUE) {fWarmStart=opt;}
+  void SetNSigmaForBkgEval(Double_t nsigma) {fNSigmaForBkg=nsigma;}
+  void SetUseChi2Fit() {fFitOption="E";}
+  void SetUseLikelihoodFit() {fFitOption="L,E";}
+
+  Bool_t Fit(Int_t iShard=0, Int_t nShards=1);
+
+  Int_t GetNHistos() const {return fHistos.GetEntriesFast();}
+  Int_t GetNConfigurations() const {return fConfMinMass.size();}
+  Int_t GetNFits() const {return GetNHistos()*GetNConfigurations();}
+  Int_t GetFitIndex(Int_t iHisto, Int_t iConf) const {return iConf*GetNHistos()+iHisto;}
+
+  Int_t GetStatus(Int_t iHisto, Int_t iConf) const {return fStatus[GetFitIndex(iHisto,iConf)];}
+  Double_t GetResult(EResult what, Int_t iHisto, Int_t iConf) const {
+    return fResults[what*GetNFits()+GetFitIndex(iHisto,iConf)];
+  }
+  const Double_t* GetColumn(EResult what) const {
+    return GetNFits()>0 ? &fResults[what*GetNFits()] : 0x0;
+  }
+  const Int_t* GetStatusColumn() const {return GetNFits()>0 ? &fStatus[0] : 0x0;}
+
+  TTree* MakeTree(const char* name="fitResults") const;
+
+  Long64_t Merge(TCollection* list);
+
+ private:
+
+  AliHFMassFitterBatch(const AliHFMassFitterBatch &source);
+  AliHFMassFitterBatch& operator=(const AliHFMassFitterBatch &source);
+
+  void ResizeResults();
+  Bool_t FitOne(Int_t iHisto, Int_t iConf, Double_t initMean, Double_t initSigma);
+
+  TObjArray fHistos;                    /// histograms to be fitted (owned)
+  std::vector<Double_t> fConfMinMass;   /// lower limit of fit range per configuration
+  std::vector<Double_t> fConfMaxMass;   /// upper limit of fit range per configuration
+  std::vector<Int_t> fConfRebin;        /// rebin factor per configuration
+  std::vector<Int_t> fConfTypeBkg;      /// background function per configuration (AliHFMassFitter::ETypeOfBkg)
+  std::vector<Int_t> fConfTypeSgn;      /// signal function per configuration (AliHFMassFitter::ETypeOfSgn)
+  std::vector<Double_t> fConfFixSigma;  /// fixed gaussian sigma per configuration (free if <=0)
+  Double_t fInitialMean;                /// initial gaussian mean when no warm start is available
+  Double_t fInitialSigma;               /// initial gaussian sigma when no warm start is available
+  Bool_t fWarmStart;                    /// start from the mean and sigma of the previous histogram
+  Double_t fNSigmaForBkg;               /// number of sigmas for background and significance
+  TString fFitOption;                   /// fit option passed to AliHFMassFitter
+  std::vector<Int_t> fStatus;           /// fit status (EFitStatus) per fit
+  std::vector<Double_t> fResults;       /// results, kNResults columns of GetNFits() entries
+
+  /// \cond CLASSIMP
+  ClassDef(AliHFMassFitterBatch,1); /// batch of invariant mass fits
+  /// \endcond
+};
+
+#endif
@@ -0,0 +1,208 @@
+/**************************************************************************
+ * Copyright(c) 2007-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+///////////////////////////////////////////////////////////////////
+//                                                               //
+// Implementation of the event-level cache of refitted primary   //
+// vertices and failed candidate refills, shared by the wagons   //
+// through the list of the AOD event                             //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+#include <TObjString.h>
+#include <TParameter.h>
+#include "AliAODEvent.h"
+#include "AliAODHeader.h"
+#include "AliAODVertex.h"
+#include "AliAODRecoDecayHF.h"
+#include "AliLog.h"
+#include "AliHFRecoCandCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliHFRecoCandCache);
+/// \endcond
+
+//___________________________________________________________________________
+AliHFRecoCandCache::AliHFRecoCandCache():
+TNamed(CacheName(),"cache of the on-the-fly HF candidate reconstruction"),
+fRunNumber(-1),
+fEventId(0),
+fNTracks(-1),
+fNContributors(-1),
+fPrimaryVtx(),
+fFillFailed(),
+fSelection()
+{
+  /// default constructor
+  for(Int_t i=0; i<3; i++) fVtxPos[i]=0.;
+  fPrimaryVtx.SetOwnerKeyValue(kTRUE,kTRUE);
+  fFillFailed.SetOwner(kTRUE);
+  fSelection.SetOwner(kTRUE);
+}
+//___________________________________________________________________________
+AliHFRecoCandCache::~AliHFRecoCandCache(){
+  /// destructor
+  Reset();
+}
+//___________________________________________________________________________
+AliHFRecoCandCache *AliHFRecoCandCache::GetCache(AliAODEvent *aod){
+  /// returns the cache attached to aod, creating it at the first call,
+  /// cleared if it was filled for another event
+
+  if(!aod || !aod->GetList()) return 0;
+  AliHFRecoCandCache *cache=(AliHFRecoCandCache*)aod->GetList()->FindObject(CacheName());
+  if(!cache){
+    cache=new AliHFRecoCandCache();
+    aod->AddObject(cache);
+  }
+  if(!cache->IsSameEvent(aod)){
+    cache->Reset();
+    cache->SetEvent(aod);
+  }
+  return cache;
+}
+//___________________________________________________________________________
+void AliHFRecoCandCache::Reset(){
+  /// removes all the cached entries
+  fPrimaryVtx.DeleteAll();
+  fFillFailed.Delete();
+  fSelection.Delete();
+}
+//___________________________________________________________________________
+Bool_t AliHFRecoCandCache::IsSameEvent(AliAODEvent *aod) const {
+  /// checks whether aod is the event the cache was filled for
+
+  if(aod->GetRunNumber()!=fRunNumber) return kFALSE;
+  if(aod->GetNumberOfTracks()!=fNTracks) return kFALSE;
+  AliVHeader *header=aod->GetHeader();
+  if(header && header->GetEventIdAsLong()!=fEventId) return kFALSE;
+  AliAODVertex *vtx=aod->GetPrimaryVertex();
+  if(!vtx) return fNContributors<0;
+  if(vtx->GetNContributors()!=fNContributors) return kFALSE;
+  Double_t pos[3];
+  vtx->GetXYZ(pos);
+  for(Int_t i=0; i<3; i++) if(pos[i]!=fVtxPos[i]) return kFALSE;
+  return kTRUE;
+}
+//___________________________________________________________________________
+void AliHFRecoCandCache::SetEvent(AliAODEvent *aod){
+  /// stores the identifiers of the current event
+
+  fRunNumber=aod->GetRunNumber();
+  fNTracks=aod->GetNumberOfTracks();
+  AliVHeader *header=aod->GetHeader();
+  fEventId= header ? header->GetEventIdAsLong() : 0;
+  AliAODVertex *vtx=aod->GetPrimaryVertex();
+  fNContributors=-1;
+  for(Int_t i=0; i<3; i++) fVtxPos[i]=0.;
+  if(vtx){
+    fNContributors=vtx->GetNContributors();
+    vtx->GetXYZ(fVtxPos);
+  }
+}
+//___________________________________________________________________________
+TString AliHFRecoCandCache::MakeKey(const AliAODRecoDecayHF *d, Int_t nProngs){
+  /// key of candidate d: class name followed by the IDs of the nProngs
+  /// daughters. Empty if the daughter IDs are not available
+
+  TString key=d->ClassName();
+  for(Int_t ip=0; ip<nProngs; ip++){
+    UShort_t id=d->GetProngID(ip);
+    if(id==9999) return "";
+    key+=Form("_%d",(Int_t)id);
+  }
+  return key;
+}
+//___________________________________________________________________________
+Bool_t AliHFRecoCandCache::GetPrimaryVtx(const AliAODRecoDecayHF *d, AliAODVertex *&vtx) const {
+  /// returns kTRUE if the primary vertex without the daughters of d was
+  /// already computed in this event; vtx is the cached vertex (owned by
+  /// the cache), 0 if the refit failed
+
+  vtx=0;
+  TString key=MakeKey(d,d->GetNDaughters());
+  if(key.IsNull()) return kFALSE;
+  TPair *entry=(TPair*)fPrimaryVtx.FindObject(key.Data());
+  if(!entry) return kFALSE;
+  vtx=(AliAODVertex*)entry->Value();
+  return kTRUE;
+}
+//___________________________________________________________________________
+void AliHFRecoCandCache::AddPrimaryVtx(const AliAODRecoDecayHF *d, const AliAODVertex *vtx){
+  /// stores a copy of the primary vertex without the daughters of d,
+  /// vtx=0 records a failed refit
+
+  TString key=MakeKey(d,d->GetNDaughters());
+  if(key.IsNull() || fPrimaryVtx.FindObject(key.Data())) return;
+  fPrimaryVtx.Add(new TObjString(key.Data()), vtx ? new AliAODVertex(*vtx) : 0);
+}
+//___________________________________________________________________________
+Bool_t AliHFRecoCandCache::IsFillFailed(const AliAODRecoDecayHF *d, Int_t nProngs) const {
+  /// kTRUE if the refilling of candidate d already failed in this event
+
+  TString key=MakeKey(d,nProngs);
+  if(key.IsNull()) return kFALSE;
+  return fFillFailed.FindObject(key.Data())!=0;
+}
+//___________________________________________________________________________
+void AliHFRecoCandCache::SetFillFailed(const AliAODRecoDecayHF *d, Int_t nProngs){
+  /// records that the refilling of candidate d failed in this event
+
+  TString key=MakeKey(d,nProngs);
+  if(key.IsNull() || fFillFailed.FindObject(key.Data())) return;
+  fFillFailed.Add(new TObjString(key.Data()));
+}
+//___________________________________________________________________________
+TString AliHFRecoCandCache::MakeSelectionKey(const char *cutsKey, const TObject *obj, Int_t level){
+  /// key of the selection of obj at the given level by the cuts cutsKey.
+  /// The candidate is identified by its address: all the wagons read the
+  /// same candidate arrays of the event
+
+  return Form("%s_%s_%p_%d",cutsKey,obj->ClassName(),(const void*)obj,level);
+}
+//___________________________________________________________________________
+Bool_t AliHFRecoCandCache::GetSelection(const char *cutsKey, const TObject *obj, Int_t level,
+                                        Int_t &sel, Int_t &selCuts, Int_t &selPID) const {
+  /// returns kTRUE if obj was already selected at the given level by the
+  /// cuts cutsKey in this event; sel, selCuts and selPID are the outcome
+  /// of IsSelected and the outcome of the cut and PID selections
+
+  TString key=MakeSelectionKey(cutsKey,obj,level);
+  TParameter<Long64_t> *entry=(TParameter<Long64_t>*)fSelection.FindObject(key.Data());
+  if(!entry) return kFALSE;
+  Long64_t packed=entry->GetVal();
+  sel    =(Int_t)((packed>>32)&0xffff)-0x8000;
+  selCuts=(Int_t)((packed>>16)&0xffff)-0x8000;
+  selPID =(Int_t)(packed&0xffff)-0x8000;
+  return kTRUE;
+}
+//___________________________________________________________________________
+void AliHFRecoCandCache::AddSelection(const char *cutsKey, const TObject *obj, Int_t level,
+                                      Int_t sel, Int_t selCuts, Int_t selPID){
+  /// stores the outcome of the selection of obj at the given level by the
+  /// cuts cutsKey (values outside the 16-bit range are not cached)
+
+  Int_t vals[3]={sel,selCuts,selPID};
+  Long64_t packed=0;
+  for(Int_t i=0; i<3; i++){
+    if(vals[i]<-0x8000 || vals[i]>=0x8000) return;
+    packed=(packed<<16)|(Long64_t)(vals[i]+0x8000);
+  }
+  TString key=MakeSelectionKey(cutsKey,obj,level);
+  if(fSelection.FindObject(key.Data())) return;
+  fSelection.Add(new TParameter<Long64_t>(key.Data(),packed));
+}
@@ -0,0 +1,83 @@
+#ifndef ALIHFRECOCANDCACHE_H
+#define ALIHFRECOCANDCACHE_H
+
+/* Copyright(c) 2007-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+///////////////////////////////////////////////////////////////////////////
+///                                                                      //
+/// \class AliHFRecoCandCache
+/// \brief Event-level cache of the on-the-fly candidate reconstruction
+///                                                                      //
+/// Stores, for the current event, the primary vertices refitted without //
+/// the daughters of a candidate (AliRDHFCuts::RecalcOwnPrimaryVtx) and  //
+/// the candidates whose refilling from the reduced dAOD failed          //
+/// (AliAnalysisVertexingHF::FillRecoCand), keyed by the candidate class //
+/// and the IDs of its daughters. Successfully refilled candidates are   //
+/// already shared, since they are flagged in the dAOD object itself.    //
+/// It also stores the outcome of AliRDHFCuts::IsSelected for the cut    //
+/// objects declared as shared (AliRDHFCuts::SetSharedSelectionKey),     //
+/// keyed by the cut key, the candidate and the selection level.         //
+/// The cache is attached to the list of the AOD event, so that all the  //
+/// wagons of a train processing the same event share it, and it is     //
+/// cleared when a new event is found.                                   //
+///                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TNamed.h"
+#include "TString.h"
+#include "TMap.h"
+#include "THashList.h"
+
+class AliAODEvent;
+class AliAODVertex;
+class AliAODRecoDecayHF;
+
+class AliHFRecoCandCache : public TNamed{
+ public:
+  AliHFRecoCandCache();
+  virtual ~AliHFRecoCandCache();
+
+  static AliHFRecoCandCache *GetCache(AliAODEvent *aod);
+  static const char *CacheName() {return "HFRecoCandCache";}
+
+  Bool_t GetPrimaryVtx(const AliAODRecoDecayHF *d, AliAODVertex *&vtx) const;
+  void   AddPrimaryVtx(const AliAODRecoDecayHF *d, const AliAODVertex *vtx);
+  Bool_t IsFillFailed(const AliAODRecoDecayHF *d, Int_t nProngs) const;
+  void   SetFillFailed(const AliAODRecoDecayHF *d, Int_t nProngs);
+  Bool_t GetSelection(const char *cutsKey, const TObject *obj, Int_t level,
+                      Int_t &sel, Int_t &selCuts, Int_t &selPID) const;
+  void   AddSelection(const char *cutsKey, const TObject *obj, Int_t level,
+                      Int_t sel, Int_t selCuts, Int_t selPID);
+
+  Int_t  GetNPrimaryVtx() const {return fPrimaryVtx.GetSize();}
+  Int_t  GetNFillFailed() const {return fFillFailed.GetSize();}
+  Int_t  GetNSelection() const {return fSelection.GetSize();}
+  void   Reset();
+
+ private:
+  AliHFRecoCandCache(const AliHFRecoCandCache &source);
+  AliHFRecoCandCache& operator=(const AliHFRecoCandCache &source);
+
+  Bool_t  IsSameEvent(AliAODEvent *aod) const;
+  void    SetEvent(AliAODEvent *aod);
+  static TString MakeKey(const AliAODRecoDecayHF *d, Int_t nProngs);
+  static TString MakeSelectionKey(const char *cutsKey, const TObject *obj, Int_t level);
+
+  Int_t     fRunNumber;     /// run number of the cached event
+  ULong64_t fEventId;       /// period/orbit/bunch crossing of the cached event
+  Int_t     fNTracks;       /// number of tracks of the cached event
+  Int_t     fNContributors; /// contributors to the primary vertex of the cached event
+  Double_t  fVtxPos[3];     /// primary vertex position of the cached event
+  TMap      fPrimaryVtx;    /// key -> primary vertex without daughters (0 if the refit failed)
+  THashList fFillFailed;    /// keys of the candidates whose refilling failed
+  THashList fSelection;     /// outcome of the shared selections (TParameter<Long64_t>)
+
+  /// \cond CLASSIMP
+  ClassDef(AliHFRecoCandCache,2); /// event-level cache of the on-the-fly candidate reconstruction
+  /// \endcond
+};
+
+#endif
@@ -0,0 +1,162 @@
+/**************************************************************************
+ * Copyright(c) 2007-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+///////////////////////////////////////////////////////////////////
+//                                                               //
+// Implementation of the class to test a matrix of cut sets on   //
+// the optimization variables of a candidate in one call         //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "AliRDHFCuts.h"
+#include "AliAODRecoDecayHF.h"
+#include "AliLog.h"
+#include "AliRDHFCutSetMatrix.h"
+
+/// \cond CLASSIMP
+ClassImp(AliRDHFCutSetMatrix);
+/// \endcond
+
+//___________________________________________________________________________
+AliRDHFCutSetMatrix::AliRDHFCutSetMatrix():
+TNamed(),
+fNPtBins(0),
+fNVars(0),
+fNSets(0),
+fIsUpperCut(),
+fCuts()
+{
+  /// default constructor
+}
+//___________________________________________________________________________
+AliRDHFCutSetMatrix::AliRDHFCutSetMatrix(const char *name, const AliRDHFCuts *refCuts):
+TNamed(name,name),
+fNPtBins(refCuts->GetNPtBins()),
+fNVars(refCuts->GetNVarsForOpt()),
+fNSets(0),
+fIsUpperCut(refCuts->GetNVarsForOpt()),
+fCuts()
+{
+  /// standard constructor: pt bins, variables for optimization and upper/lower
+  /// cut flags are taken from refCuts
+
+  Bool_t *varsForOpt=refCuts->GetVarsForOpt();
+  Bool_t *isUpperCut=refCuts->GetIsUpperCut();
+  Int_t iOpt=0;
+  for(Int_t iVar=0; iVar<refCuts->GetNVars(); iVar++){
+    if(!varsForOpt[iVar]) continue;
+    fIsUpperCut[iOpt++]=isUpperCut[iVar];
+  }
+}
+//___________________________________________________________________________
+Int_t AliRDHFCutSetMatrix::AddCutSet(const Float_t *cutsForOpt){
+  /// adds a cut set, cutsForOpt[iPtBin*GetNVars()+iVar]
+  /// returns the index of the set
+
+  TArrayF cuts(fNPtBins*fNVars*(fNSets+1));
+  for(Int_t iPt=0; iPt<fNPtBins; iPt++){
+    for(Int_t iVar=0; iVar<fNVars; iVar++){
+      Int_t iRow=iPt*fNVars+iVar;
+      for(Int_t iSet=0; iSet<fNSets; iSet++) cuts[iRow*(fNSets+1)+iSet]=fCuts[iRow*fNSets+iSet];
+      cuts[iRow*(fNSets+1)+fNSets]=cutsForOpt[iRow];
+    }
+  }
+  fCuts=cuts;
+  return fNSets++;
+}
+//___________________________________________________________________________
+Int_t AliRDHFCutSetMatrix::AddCutSet(const AliRDHFCuts *cuts){
+  /// adds the cut values of the optimization variables of cuts
+  /// returns the index of the set, -1 if cuts is not compatible
+
+  if(cuts->GetNPtBins()!=fNPtBins || cuts->GetNVarsForOpt()!=fNVars){
+    AliError(Form("Cut set %s has %d pt bins and %d variables for optimization, %d and %d expected",
+		  cuts->GetName(),cuts->GetNPtBins(),cuts->GetNVarsForOpt(),fNPtBins,fNVars));
+    return -1;
+  }
+
+  Bool_t *varsForOpt=cuts->GetVarsForOpt();
+  std::vector<Float_t> cutsForOpt(fNPtBins*fNVars);
+  for(Int_t iPt=0; iPt<fNPtBins; iPt++){
+    Int_t iOpt=0;
+    for(Int_t iVar=0; iVar<cuts->GetNVars(); iVar++){
+      if(!varsForOpt[iVar]) continue;
+      cutsForOpt[iPt*fNVars+iOpt]=cuts->GetCutValue(iVar,iPt);
+      iOpt++;
+    }
+  }
+  return AddCutSet(&cutsForOpt[0]);
+}
+//___________________________________________________________________________
+void AliRDHFCutSetMatrix::Evaluate(const Float_t *vars, Int_t iPtBin, ULong64_t *mask) const {
+  /// tests all the cut sets on the variables for optimization vars of a
+  /// candidate in pt bin iPtBin; bit iSet%64 of mask[iSet/64] is set if
+  /// the candidate passes the set iSet. mask has GetNMaskWords() words
+
+  Int_t nWords=GetNMaskWords();
+  if(iPtBin<0 || iPtBin>=fNPtBins){
+    for(Int_t iw=0; iw<nWords; iw++) mask[iw]=0;
+    return;
+  }
+  for(Int_t iw=0; iw<nWords; iw++){
+    Int_t nInWord=fNSets-iw*64;
+    mask[iw]= nInWord>=64 ? ~0ULL : (1ULL<<nInWord)-1;
+  }
+
+  for(Int_t iVar=0; iVar<fNVars; iVar++){
+    const Float_t *cuts=&fCuts[(iPtBin*fNVars+iVar)*fNSets];
+    const Float_t value=vars[iVar];
+    Bool_t anyLeft=kFALSE;
+    for(Int_t iw=0; iw<nWords; iw++){
+      if(!mask[iw]) continue;
+      Int_t first=iw*64;
+      Int_t nInWord=TMath::Min(64,fNSets-first);
+      ULong64_t passed=0;
+      if(fIsUpperCut[iVar]){
+	for(Int_t ib=0; ib<nInWord; ib++) passed|=(ULong64_t)(value<=cuts[first+ib])<<ib;
+      }else{
+	for(Int_t ib=0; ib<nInWord; ib++) passed|=(ULong64_t)(value>=cuts[first+ib])<<ib;
+      }
+      mask[iw]&=passed;
+      if(mask[iw]) anyLeft=kTRUE;
+    }
+    if(!anyLeft) return;
+  }
+}
+//___________________________________________________________________________
+ULong64_t AliRDHFCutSetMatrix::Evaluate(const Float_t *vars, Int_t iPtBin) const {
+  /// same as above, for at most 64 cut sets
+
+  if(fNSets>64) AliWarning(Form("%d cut sets, only the first 64 are returned",fNSets));
+  std::vector<ULong64_t> mask(TMath::Max(1,GetNMaskWords()),0);
+  Evaluate(vars,iPtBin,&mask[0]);
+  return mask[0];
+}
+//___________________________________________________________________________
+Int_t AliRDHFCutSetMatrix::Evaluate(AliRDHFCuts *cuts, AliAODRecoDecayHF *d, Int_t *pdgdaughters, AliAODEvent *aod, ULong64_t *mask) const {
+  /// extracts the variables for optimization of candidate d once with
+  /// cuts->GetCutVarsForOpt (own primary vertex recalculated there if
+  /// requested) and tests all the cut sets on them.
+  /// returns the pt bin of the candidate (-1 : mask set to 0)
+
+  std::vector<Float_t> vars(TMath::Max(1,fNVars));
+  Int_t iPtBin=cuts->PtBin(d->Pt());
+  if(iPtBin>=0) cuts->GetCutVarsForOpt(d,&vars[0],fNVars,pdgdaughters,aod);
+  Evaluate(&vars[0],iPtBin,mask);
+  return iPtBin;
+}
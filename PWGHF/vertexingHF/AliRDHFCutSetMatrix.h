@@ -0,0 +1,66 @@
+#ifndef ALIRDHFCUTSETMATRIX_H
+#define ALIRDHFCUTSETMATRIX_H
+
+/* Copyright(c) 2007-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+///////////////////////////////////////////////////////////////////////////
+///                                                                      //
+/// \class AliRDHFCutSetMatrix
+/// \brief Matrix of cut sets on the optimization variables of AliRDHFCuts
+///                                                                      //
+/// Stores several sets of cut values for the variables flagged for      //
+/// optimization in an AliRDHFCuts object (fVarsForOpt), in all pt bins, //
+/// and tests all of them at once on the variables of one candidate, as  //
+/// extracted with AliRDHFCuts::GetCutVarsForOpt. The result is a bit    //
+/// mask, bit i set if the candidate passes the cut set i.               //
+/// The convention of the optimization framework is used : a variable    //
+/// passes an upper cut if it is <= cut and a lower cut if it is >= cut. //
+/// The cuts on other variables, the PID and the candidate pre-selection //
+/// are not included and have to be applied with IsSelected (e.g. with   //
+/// the loosest cut set) before.                                         //
+///                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TNamed.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+
+class AliRDHFCuts;
+class AliAODRecoDecayHF;
+class AliAODEvent;
+
+class AliRDHFCutSetMatrix : public TNamed{
+ public:
+  AliRDHFCutSetMatrix();
+  AliRDHFCutSetMatrix(const char *name, const AliRDHFCuts *refCuts);
+  virtual ~AliRDHFCutSetMatrix(){};
+
+  Int_t AddCutSet(const AliRDHFCuts *cuts);
+  Int_t AddCutSet(const Float_t *cutsForOpt);
+
+  Int_t   GetNCutSets() const {return fNSets;}
+  Int_t   GetNPtBins() const {return fNPtBins;}
+  Int_t   GetNVars() const {return fNVars;}
+  Int_t   GetNMaskWords() const {return (fNSets+63)/64;}
+  Float_t GetCutValue(Int_t iSet, Int_t iVar, Int_t iPtBin) const {return fCuts[(iPtBin*fNVars+iVar)*fNSets+iSet];}
+
+  void      Evaluate(const Float_t *vars, Int_t iPtBin, ULong64_t *mask) const;
+  ULong64_t Evaluate(const Float_t *vars, Int_t iPtBin) const;
+  Int_t     Evaluate(AliRDHFCuts *cuts, AliAODRecoDecayHF *d, Int_t *pdgdaughters, AliAODEvent *aod, ULong64_t *mask) const;
+
+ private:
+  Int_t   fNPtBins;     /// number of pt bins
+  Int_t   fNVars;       /// number of variables for optimization
+  Int_t   fNSets;       /// number of cut sets
+  TArrayI fIsUpperCut;  /// 1 for upper cuts, for each variable
+  TArrayF fCuts;        /// cut values, [ptbin][var][set] so that all the sets are contiguous
+
+  /// \cond CLASSIMP
+  ClassDef(AliRDHFCutSetMatrix,1); /// matrix of cut sets on the optimization variables
+  /// \endcond
+};
+
+#endif
@@ -39,6 +39,7 @@
 #include "AliAODMCHeader.h"
 #include "AliAODMCParticle.h"
 #include "AliVertexerTracks.h"
+#include "AliHFRecoCandCache.h"
 #include "AliRDHFCuts.h"
 #include "AliAnalysisManager.h"
 #include "AliAODHandler.h"
@@ -125,7 +126,9 @@ fCutGeoNcrNclLength(130.),
 fCutGeoNcrNclGeom1Pt(1.5),
 fCutGeoNcrNclFractionNcr(0.85),
 fCutGeoNcrNclFractionNcl(0.7),
-fUseV0ANDSelectionOffline(kFALSE)
+fUseV0ANDSelectionOffline(kFALSE),
+fUseSharedVtxCache(kFALSE),
+fSharedSelectionKey("")
 {
   //
   // Default Constructor
@@ -198,7 +201,9 @@ AliRDHFCuts::AliRDHFCuts(const AliRDHFCuts &source) :
   fCutGeoNcrNclGeom1Pt(source.fCutGeoNcrNclGeom1Pt),
   fCutGeoNcrNclFractionNcr(source.fCutGeoNcrNclFractionNcr),
   fCutGeoNcrNclFractionNcl(source.fCutGeoNcrNclFractionNcl),
-  fUseV0ANDSelectionOffline(source.fUseV0ANDSelectionOffline)
+  fUseV0ANDSelectionOffline(source.fUseV0ANDSelectionOffline),
+  fUseSharedVtxCache(source.fUseSharedVtxCache),
+  fSharedSelectionKey(source.fSharedSelectionKey)
 {
   //
   // Copy constructor
@@ -298,6 +303,8 @@ AliRDHFCuts &AliRDHFCuts::operator=(const AliRDHFCuts &source)
   fCutGeoNcrNclFractionNcr=source.fCutGeoNcrNclFractionNcr;
   fCutGeoNcrNclFractionNcl=source.fCutGeoNcrNclFractionNcl;
   fUseV0ANDSelectionOffline=source.fUseV0ANDSelectionOffline;
+  fUseSharedVtxCache=source.fUseSharedVtxCache;
+  fSharedSelectionKey=source.fSharedSelectionKey;
 
   PrintAll();
 
@@ -1143,6 +1150,8 @@ void AliRDHFCuts::PrintAll() const {
   printf("Min SPD mult %d\n",fMinSPDMultiplicity);
   printf("Use PID %d  OldPid=%d\n",(Int_t)fUsePID,fPidHF ? fPidHF->GetOldPid() : -1);
   printf("Remove daughters from vtx %d\n",(Int_t)fRemoveDaughtersFromPrimary);
+  if(fRemoveDaughtersFromPrimary) printf(" -- shared vertex cache %d\n",(Int_t)fUseSharedVtxCache);
+  if(!fSharedSelectionKey.IsNull()) printf(" Selection shared among wagons with key %s\n",fSharedSelectionKey.Data());
   printf("Physics selection: %s\n",fUsePhysicsSelection ? "Yes" : "No");
   printf("Pileup rejection: %s\n",(fOptPileup > 0) ? "Yes" : "No");
   if(fOptPileup==1) printf(" -- Reject pileup event");
@@ -1596,6 +1605,24 @@ void AliRDHFCuts::MakeTable() const {
   return;
 }
 //--------------------------------------------------------------------------
+Int_t AliRDHFCuts::IsSelectedShared(TObject* obj,Int_t selectionLevel,AliAODEvent* aod)
+{
+  //
+  // IsSelected, evaluated once per candidate and event for all the wagons
+  // whose cut objects have the same shared selection key. The wagons
+  // declaring the same key must use identical cuts
+  //
+
+  AliHFRecoCandCache *cache = (!fSharedSelectionKey.IsNull() && obj) ? AliHFRecoCandCache::GetCache(aod) : 0;
+  if(!cache) return IsSelected(obj,selectionLevel,aod);
+
+  Int_t sel=0;
+  if(cache->GetSelection(fSharedSelectionKey.Data(),obj,selectionLevel,sel,fIsSelectedCuts,fIsSelectedPID)) return sel;
+  sel=IsSelected(obj,selectionLevel,aod);
+  cache->AddSelection(fSharedSelectionKey.Data(),obj,selectionLevel,sel,fIsSelectedCuts,fIsSelectedPID);
+  return sel;
+}
+//--------------------------------------------------------------------------
 Bool_t AliRDHFCuts::RecalcOwnPrimaryVtx(AliAODRecoDecayHF *d,
 					AliAODEvent *aod) const
 {
@@ -1608,7 +1635,22 @@ Bool_t AliRDHFCuts::RecalcOwnPrimaryVtx(AliAODRecoDecayHF *d,
     return 0;
   }   
 
+  // with the shared cache, the refit is done once per candidate and event
+  // for all the wagons; a cached failure is not retried
+  AliHFRecoCandCache *cache = fUseSharedVtxCache ? AliHFRecoCandCache::GetCache(aod) : 0;
+  AliAODVertex *cachedvtx=0;
+  if(cache && cache->GetPrimaryVtx(d,cachedvtx)){
+    if(!cachedvtx){
+      AliDebug(2,"Removal of daughter tracks failed (cached)");
+      return kFALSE;
+    }
+    d->SetOwnPrimaryVtx(cachedvtx);
+    d->RecalculateImpPars(cachedvtx,aod);
+    return kTRUE;
+  }
+
   AliAODVertex *recvtx=d->RemoveDaughtersFromPrimaryVtx(aod);
+  if(cache) cache->AddPrimaryVtx(d,recvtx);
   if(!recvtx){
     AliDebug(2,"Removal of daughter tracks failed");
     return kFALSE;
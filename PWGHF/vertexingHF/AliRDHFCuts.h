@@ -214,6 +214,8 @@ class AliRDHFCuts : public AliAnalysisCuts
     fPidHF=new AliAODPidHF(*pidObj);
   }
   void SetRemoveDaughtersFromPrim(Bool_t removeDaughtersPrim) {fRemoveDaughtersFromPrimary=removeDaughtersPrim;}
+  void SetUseSharedVtxCache(Bool_t flag=kTRUE) {fUseSharedVtxCache=flag; return;}
+  void SetSharedSelectionKey(const char *key="") {fSharedSelectionKey=key; return;}
   void SetMinPtCandidate(Double_t ptCand=-1.) {fMinPtCand=ptCand; return;}
   void SetMaxPtCandidate(Double_t ptCand=1000.) {fMaxPtCand=ptCand; return;}
   void SetMaxRapidityCandidate(Double_t ycand) {fMaxRapidityCand=ycand; return;}
@@ -266,6 +268,8 @@ class AliRDHFCuts : public AliAnalysisCuts
   }
   Bool_t  GetUseTrackSelectionWithFilterBits() const{return fUseTrackSelectionWithFilterBits;}
   Bool_t  GetIsPrimaryWithoutDaughters() const {return fRemoveDaughtersFromPrimary;}
+  Bool_t  GetUseSharedVtxCache() const {return fUseSharedVtxCache;}
+  const char* GetSharedSelectionKey() const {return fSharedSelectionKey.Data();}
   Bool_t GetOptPileUp() const {return fOptPileup;}
   Int_t GetUseCentrality() const {return fUseCentrality;}
   Float_t GetMinCentrality() const {return fMinCentrality;}
@@ -294,6 +298,7 @@ class AliRDHFCuts : public AliAnalysisCuts
   virtual Int_t IsSelected(TObject* obj,Int_t selectionLevel) = 0;
   virtual Int_t IsSelected(TObject* obj,Int_t selectionLevel,AliAODEvent* /*aod*/)
                 {return IsSelected(obj,selectionLevel);}
+  Int_t IsSelectedShared(TObject* obj,Int_t selectionLevel,AliAODEvent* aod);
   Int_t PtBin(Double_t pt) const;
   virtual void PrintAll()const;
   void PrintTrigger() const;
@@ -456,10 +461,12 @@ class AliRDHFCuts : public AliAnalysisCuts
   Double_t fCutGeoNcrNclFractionNcr; /// 4th parameter of GeoNcrNcl cut
   Double_t fCutGeoNcrNclFractionNcl; /// 5th parameter of GeoNcrNcl cut
   Bool_t fUseV0ANDSelectionOffline; ///flag to apply V0AND selection offline
+  Bool_t fUseSharedVtxCache; /// share the primary vertices without daughters among wagons (AliHFRecoCandCache)
+  TString fSharedSelectionKey; /// if not empty, share the outcome of IsSelected among the wagons with the same key (AliHFRecoCandCache)
   
 
   /// \cond CLASSIMP    
-  ClassDef(AliRDHFCuts,40);  /// base class for cuts on AOD reconstructed heavy-flavour decays
+  ClassDef(AliRDHFCuts,42);  /// base class for cuts on AOD reconstructed heavy-flavour decays
   /// \endcond
 };
 
@@ -75,7 +75,10 @@
 #pragma link C++ class AliAnalysisTaskTrackingSysPropagation+;
 #pragma link C++ class AliMultiDimVector+;
 #pragma link C++ class AliSignificanceCalculator+;
+#pragma link C++ class AliRDHFCutSetMatrix+;
+#pragma link C++ class AliHFRecoCandCache+;
 #pragma link C++ class AliHFMassFitter+;
+#pragma link C++ class AliHFMassFitterBatch+;
 #pragma link C++ class AliHFPtSpectrum+;
 #pragma link C++ class AliHFsubtractBFDcuts+;
 #pragma link C++ class AliNormalizationCounter+;
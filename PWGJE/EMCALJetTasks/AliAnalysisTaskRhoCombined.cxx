@@ -0,0 +1,363 @@
+// $Id$
+//
+// Calculation of all the rho flavours from one collection of kt jets:
+// - standard rho (median of pt/area), and scaled rho if a scale function is given
+//   (exported with the name as "fOutRhoName".Append("_Scaled"))
+// - sparse rho, excluding kt jets overlapping with signal jets of the second
+//   jet container, optionally corrected for the occupancy (CMS method)
+// - rho_m (median of md/area, arXiv:1211.2811)
+// - local rho, modulated in phi with the jet v2 and the V0 event plane
+// The medians are found with linear-time selection and all the
+// rho objects are published to the event at the same time.
+//
+// Based on AliAnalysisTaskRho, AliAnalysisTaskRhoSparse and AliAnalysisTaskRhoMass.
+
+#include "AliAnalysisTaskRhoCombined.h"
+
+#include <algorithm>
+
+#include <TClonesArray.h>
+#include <TF1.h>
+#include <TH2F.h>
+#include <TLorentzVector.h>
+#include <TMath.h>
+
+#include "AliAnalysisManager.h"
+#include "AliEmcalJet.h"
+#include "AliJetContainer.h"
+#include "AliLocalRhoParameter.h"
+#include "AliLog.h"
+#include "AliRhoParameter.h"
+#include "AliVCluster.h"
+#include "AliVParticle.h"
+
+ClassImp(AliAnalysisTaskRhoCombined)
+
+//________________________________________________________________________
+AliAnalysisTaskRhoCombined::AliAnalysisTaskRhoCombined() : 
+  AliAnalysisTaskRhoBase("AliAnalysisTaskRhoCombined"),
+  fNExclLeadJets(0),
+  fOutRhoSparseName(),
+  fRhoCMS(kFALSE),
+  fOutRhoMassName(),
+  fPionMassClusters(kFALSE),
+  fOutLocalRhoName(),
+  fV2Function(0),
+  fOutRhoSparse(0),
+  fOutRhoMass(0),
+  fOutLocalRho(0),
+  fLocalRhoModulation(0),
+  fRhoValues(),
+  fRhoSparseValues(),
+  fRhoMassValues(),
+  fSignalTracks(),
+  fHistRhoSparsevsCent(0),
+  fHistOccCorrvsCent(0),
+  fHistRhoMassvsCent(0)
+{
+  // Constructor.
+}
+
+//________________________________________________________________________
+AliAnalysisTaskRhoCombined::AliAnalysisTaskRhoCombined(const char *name, Bool_t histo) :
+  AliAnalysisTaskRhoBase(name, histo),
+  fNExclLeadJets(0),
+  fOutRhoSparseName(),
+  fRhoCMS(kFALSE),
+  fOutRhoMassName(),
+  fPionMassClusters(kFALSE),
+  fOutLocalRhoName(),
+  fV2Function(0),
+  fOutRhoSparse(0),
+  fOutRhoMass(0),
+  fOutLocalRho(0),
+  fLocalRhoModulation(0),
+  fRhoValues(),
+  fRhoSparseValues(),
+  fRhoMassValues(),
+  fSignalTracks(),
+  fHistRhoSparsevsCent(0),
+  fHistOccCorrvsCent(0),
+  fHistRhoMassvsCent(0)
+{
+  // Constructor.
+}
+
+//________________________________________________________________________
+AliAnalysisTaskRhoCombined::~AliAnalysisTaskRhoCombined()
+{
+  // Destructor.
+
+  if (fLocalRhoModulation) delete fLocalRhoModulation;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoCombined::UserCreateOutputObjects()
+{
+  if (!fCreateHisto) return;
+
+  AliAnalysisTaskRhoBase::UserCreateOutputObjects();
+
+  if (!fOutRhoSparseName.IsNull()) {
+    fHistRhoSparsevsCent = new TH2F("fHistRhoSparsevsCent", "fHistRhoSparsevsCent", 101, -1, 100, fNbins, fMinBinPt, fMaxBinPt*2);
+    fHistRhoSparsevsCent->GetXaxis()->SetTitle("Centrality (%)");
+    fHistRhoSparsevsCent->GetYaxis()->SetTitle("#rho_{sparse} (GeV/c * rad^{-1})");
+    fOutput->Add(fHistRhoSparsevsCent);
+
+    fHistOccCorrvsCent = new TH2F("OccCorrvsCent", "OccCorrvsCent", 101, -1, 100, 2000, 0 , 2);
+    fOutput->Add(fHistOccCorrvsCent);
+  }
+
+  if (!fOutRhoMassName.IsNull()) {
+    fHistRhoMassvsCent = new TH2F("fHistRhoMassvsCent", "fHistRhoMassvsCent", 101, -1, 100, fNbins, fMinBinPt, fMaxBinPt/4);
+    fHistRhoMassvsCent->GetXaxis()->SetTitle("Centrality (%)");
+    fHistRhoMassvsCent->GetYaxis()->SetTitle("#rho_{m} (GeV/c * rad^{-1})");
+    fOutput->Add(fHistRhoMassvsCent);
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoCombined::AttachRhoParameter(AliRhoParameter *rho)
+{
+  // Add a rho object to the event.
+
+  if (!fAttachToEvent) return;
+
+  if (!(InputEvent()->FindListObject(rho->GetName()))) {
+    InputEvent()->AddObject(rho);
+  } else {
+    AliFatal(Form("%s: Container with same name %s already present. Aborting", GetName(), rho->GetName()));
+  }
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoCombined::ExecOnce()
+{
+  // Init the analysis.
+
+  if (!fOutRhoSparseName.IsNull() && !fOutRhoSparse) {
+    fOutRhoSparse = new AliRhoParameter(fOutRhoSparseName, 0);
+    AttachRhoParameter(fOutRhoSparse);
+  }
+
+  if (!fOutRhoMassName.IsNull() && !fOutRhoMass) {
+    fOutRhoMass = new AliRhoParameter(fOutRhoMassName, 0);
+    AttachRhoParameter(fOutRhoMass);
+  }
+
+  if (!fOutLocalRhoName.IsNull() && !fOutLocalRho) {
+    fOutLocalRho = new AliLocalRhoParameter(fOutLocalRhoName, 0);
+    AttachRhoParameter(fOutLocalRho);
+    if (fV2Function) {
+      fLocalRhoModulation = new TF1(Form("%s_Modulation", fOutLocalRhoName.Data()), "[0]*(1.+2.*[1]*TMath::Cos(2.*(x-[2])))", 0, TMath::TwoPi());
+    }
+  }
+
+  AliAnalysisTaskRhoBase::ExecOnce();
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisTaskRhoCombined::Median(std::vector<Double_t> &values)
+{
+  // Median of the values with linear-time selection, same convention as
+  // TMath::Median (mean of the two central values for an even number of values).
+  // The order of the values is changed.
+
+  Int_t n = values.size();
+  if (n == 0) return 0;
+
+  std::vector<Double_t>::iterator mid = values.begin() + n / 2;
+  std::nth_element(values.begin(), mid, values.end());
+  if (n % 2 == 1) return *mid;
+
+  // the elements before mid are all smaller or equal
+  return 0.5 * (*mid + *std::max_element(values.begin(), mid));
+}
+
+//________________________________________________________________________
+Double_t AliAnalysisTaskRhoCombined::GetMd(AliEmcalJet *jet)
+{
+  // Get md as defined in http://arxiv.org/pdf/1211.2811.pdf
+
+  Double_t sum = 0.;
+
+  if (fTracks) {
+    for (Int_t icc = 0; icc < jet->GetNumberOfTracks(); icc++) {
+      AliVParticle *vp = static_cast<AliVParticle*>(jet->TrackAt(icc, fTracks));
+      if (!vp) continue;
+      sum += TMath::Sqrt(vp->M()*vp->M() + vp->Pt()*vp->Pt()) - vp->Pt();
+    }
+  }
+
+  if (fCaloClusters) {
+    for (Int_t icc = 0; icc < jet->GetNumberOfClusters(); icc++) {
+      AliVCluster *vp = static_cast<AliVCluster*>(jet->ClusterAt(icc, fCaloClusters));
+      if (!vp) continue;
+      TLorentzVector nPart;
+      vp->GetMomentum(nPart, fVertex);
+      Double_t m = 0.;
+      if (fPionMassClusters) m = 0.13957;
+      sum += TMath::Sqrt(m*m + nPart.Pt()*nPart.Pt()) - nPart.Pt();
+    }
+  }
+
+  return sum;
+}
+
+//________________________________________________________________________
+Bool_t AliAnalysisTaskRhoCombined::Run() 
+{
+  // Run the analysis.
+
+  fOutRho->SetVal(0);
+  if (fOutRhoScaled)
+    fOutRhoScaled->SetVal(0);
+  if (fOutRhoSparse)
+    fOutRhoSparse->SetVal(0);
+  if (fOutRhoMass)
+    fOutRhoMass->SetVal(0);
+  if (fOutLocalRho) {
+    fOutLocalRho->SetVal(0);
+    fOutLocalRho->SetLocalRho(0);
+  }
+
+  if (!fJets)
+    return kFALSE;
+
+  const Int_t Njets   = fJets->GetEntries();
+
+  Int_t maxJetIds[]   = {-1, -1};
+  Float_t maxJetPts[] = { 0,  0};
+
+  if (fNExclLeadJets > 0) {
+    for (Int_t ij = 0; ij < Njets; ++ij) {
+      AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(ij));
+      if (!jet) {
+        AliError(Form("%s: Could not receive jet %d", GetName(), ij));
+        continue;
+      } 
+
+      if (!AcceptJet(jet))
+        continue;
+
+      if (jet->Pt() > maxJetPts[0]) {
+        maxJetPts[1] = maxJetPts[0];
+        maxJetIds[1] = maxJetIds[0];
+        maxJetPts[0] = jet->Pt();
+        maxJetIds[0] = ij;
+      } else if (jet->Pt() > maxJetPts[1]) {
+        maxJetPts[1] = jet->Pt();
+        maxJetIds[1] = ij;
+      }
+    }
+    if (fNExclLeadJets < 2) {
+      maxJetIds[1] = -1;
+      maxJetPts[1] = 0;
+    }
+  }
+
+  // tracks of the signal jets (pt > 5 GeV/c), for the sparse rho
+  fSignalTracks.clear();
+  AliJetContainer *sigjets = fOutRhoSparse ? static_cast<AliJetContainer*>(fJetCollArray.At(1)) : 0;
+  if (sigjets) {
+    for (Int_t j = 0; j < sigjets->GetNJets(); j++) {
+      AliEmcalJet* signalJet = sigjets->GetAcceptJet(j);
+      if (!signalJet || !(signalJet->Pt() > 5))
+        continue;
+      for (Int_t i = 0; i < signalJet->GetNumberOfTracks(); i++) fSignalTracks.push_back(signalJet->TrackAt(i));
+    }
+    std::sort(fSignalTracks.begin(), fSignalTracks.end());
+  }
+
+  fRhoValues.clear();
+  fRhoSparseValues.clear();
+  fRhoMassValues.clear();
+  Double_t TotaljetArea=0;
+  Double_t TotaljetAreaPhys=0;
+
+  // push all jets within selected acceptance into stack
+  for (Int_t iJets = 0; iJets < Njets; ++iJets) {
+
+    // exlcuding lead jets
+    if (iJets == maxJetIds[0] || iJets == maxJetIds[1])
+      continue;
+
+    AliEmcalJet *jet = static_cast<AliEmcalJet*>(fJets->At(iJets));
+    if (!jet) {
+      AliError(Form("%s: Could not receive jet %d", GetName(), iJets));
+      continue;
+    } 
+
+    TotaljetArea+=jet->Area();
+    if(jet->Pt()>0.1){
+      TotaljetAreaPhys+=jet->Area();
+    }
+
+    if (!AcceptJet(jet))
+      continue;
+
+    fRhoValues.push_back(jet->Pt() / jet->Area());
+
+    if (fOutRhoMass && jet->Area() > 0.)
+      fRhoMassValues.push_back(GetMd(jet) / jet->Area());
+
+    if (fOutRhoSparse && jet->Pt() > 0.1) {
+      // search for overlap with signal jets
+      Bool_t isOverlapping = kFALSE;
+      for (Int_t i = 0; i < jet->GetNumberOfTracks() && !isOverlapping; i++) {
+        isOverlapping = std::binary_search(fSignalTracks.begin(), fSignalTracks.end(), jet->TrackAt(i));
+      }
+      if (!isOverlapping)
+        fRhoSparseValues.push_back(jet->Pt() / jet->Area());
+    }
+  }
+
+  if (!fRhoValues.empty()) {
+    //find median value
+    Double_t rho = Median(fRhoValues);
+    fOutRho->SetVal(rho);
+
+    if (fOutRhoScaled) {
+      Double_t rhoScaled = rho * GetScaleFactor(fCent);
+      fOutRhoScaled->SetVal(rhoScaled);
+    }
+  }
+
+  if (fOutRhoSparse) {
+    Double_t OccCorr=0.0;
+    if(TotaljetArea>0) OccCorr=TotaljetAreaPhys/TotaljetArea;
+
+    if (fCreateHisto)
+      fHistOccCorrvsCent->Fill(fCent, OccCorr);
+
+    if (!fRhoSparseValues.empty()) {
+      Double_t rho = Median(fRhoSparseValues);
+      if (fRhoCMS)
+        rho = rho * OccCorr;
+      fOutRhoSparse->SetVal(rho);
+    }
+
+    if (fCreateHisto)
+      fHistRhoSparsevsCent->Fill(fCent, fOutRhoSparse->GetVal());
+  }
+
+  if (fOutRhoMass) {
+    if (!fRhoMassValues.empty())
+      fOutRhoMass->SetVal(Median(fRhoMassValues));
+
+    if (fCreateHisto)
+      fHistRhoMassvsCent->Fill(fCent, fOutRhoMass->GetVal());
+  }
+
+  if (fOutLocalRho) {
+    fOutLocalRho->SetVal(fOutRho->GetVal());
+    if (fLocalRhoModulation) {
+      fLocalRhoModulation->SetParameter(0, fOutRho->GetVal());
+      fLocalRhoModulation->SetParameter(1, fV2Function->Eval(fCent));
+      fLocalRhoModulation->SetParameter(2, fEPV0);
+      fOutLocalRho->SetLocalRho(fLocalRhoModulation);
+    }
+  }
+
+  return kTRUE;
+}
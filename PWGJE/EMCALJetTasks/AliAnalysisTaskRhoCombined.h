@@ -0,0 +1,67 @@
+#ifndef ALIANALYSISTASKRHOCOMBINED_H
+#define ALIANALYSISTASKRHOCOMBINED_H
+
+// $Id$
+
+class TF1;
+class TH2F;
+class AliLocalRhoParameter;
+
+#include <vector>
+
+#include "AliAnalysisTaskRhoBase.h"
+
+class AliAnalysisTaskRhoCombined : public AliAnalysisTaskRhoBase {
+
+ public:
+  AliAnalysisTaskRhoCombined();
+  AliAnalysisTaskRhoCombined(const char *name, Bool_t histo=kFALSE);
+  virtual ~AliAnalysisTaskRhoCombined();
+
+  void             UserCreateOutputObjects();
+
+  void             SetExcludeLeadJets(UInt_t n)              { fNExclLeadJets     = n    ; }
+  void             SetOutRhoSparseName(const char *name)     { fOutRhoSparseName  = name ; }
+  void             SetRhoCMS(Bool_t cms)                     { fRhoCMS            = cms  ; }
+  void             SetOutRhoMassName(const char *name)       { fOutRhoMassName    = name ; }
+  void             SetPionMassForClusters(Bool_t b)          { fPionMassClusters  = b    ; }
+  void             SetOutLocalRhoName(const char *name)      { fOutLocalRhoName   = name ; }
+  void             SetV2Function(TF1 *f)                     { fV2Function        = f    ; }
+
+  static Double_t  Median(std::vector<Double_t> &values);
+
+ protected:
+  void             ExecOnce();
+  Bool_t           Run();
+
+  void             AttachRhoParameter(AliRhoParameter *rho);
+  Double_t         GetMd(AliEmcalJet *jet);
+
+  UInt_t           fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
+  TString          fOutRhoSparseName;              // name of the output sparse rho object, not computed if empty
+  Bool_t           fRhoCMS;                        // correct the sparse rho for the occupancy (CMS method)
+  TString          fOutRhoMassName;                // name of the output rho_m object, not computed if empty
+  Bool_t           fPionMassClusters;              // assume pion mass for clusters in rho_m
+  TString          fOutLocalRhoName;               // name of the output local rho object, not computed if empty
+  TF1             *fV2Function;                    // jet v2 as a function of centrality for the local rho
+
+  AliRhoParameter *fOutRhoSparse;                  //!output sparse rho object
+  AliRhoParameter *fOutRhoMass;                    //!output rho_m object
+  AliLocalRhoParameter *fOutLocalRho;              //!output local rho object
+  TF1             *fLocalRhoModulation;            //!rho as a function of phi for the local rho
+
+  std::vector<Double_t> fRhoValues;                //!pt/area of the jets for the standard rho
+  std::vector<Double_t> fRhoSparseValues;          //!pt/area of the jets for the sparse rho
+  std::vector<Double_t> fRhoMassValues;            //!md/area of the jets for rho_m
+  std::vector<Int_t>    fSignalTracks;             //!sorted track indices of the signal jets
+
+  TH2F            *fHistRhoSparsevsCent;           //!sparse rho vs. centrality
+  TH2F            *fHistOccCorrvsCent;             //!occupancy correction vs. centrality
+  TH2F            *fHistRhoMassvsCent;             //!rho_m vs. centrality
+
+  AliAnalysisTaskRhoCombined(const AliAnalysisTaskRhoCombined&);             // not implemented
+  AliAnalysisTaskRhoCombined& operator=(const AliAnalysisTaskRhoCombined&);  // not implemented
+  
+  ClassDef(AliAnalysisTaskRhoCombined, 1); // Rho task computing all the rho flavours from one kt clustering
+};
+#endif
@@ -0,0 +1,356 @@
+// $Id$
+//
+// Event-wide constituent subtraction (arXiv:1403.3108), done once per
+// event for all the jet finders using the subtracted particles:
+// - ghosts of pt rho*A and mt-pt rho_m*A on a fixed (eta,phi) grid,
+//   built once for the configured acceptance
+// - particle-ghost pairs only within fMaxDelR, found by visiting the
+//   ghost cells around each particle
+// - pairs processed in increasing distance (pt^alpha * deltaR) from a
+//   min heap, transferring pt and mt-pt until the particle or the ghost
+//   is exhausted
+// The particles with pt left are written as AliPicoTrack to the
+// collection fTracksOutName, which AliEmcalJetTask instances can use
+// as track collection instead of running the subtraction themselves.
+//
+// Same procedure as the event subtraction of the fastjet contrib
+// ConstituentSubtractor, with pseudo-rapidity in place of rapidity.
+
+#include "AliEmcalConstituentSubtractionTask.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <TClonesArray.h>
+#include <TH1F.h>
+#include <TMath.h>
+
+#include "AliClusterContainer.h"
+#include "AliLog.h"
+#include "AliParticleContainer.h"
+#include "AliPicoTrack.h"
+#include "AliRhoParameter.h"
+#include "AliVCluster.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+
+ClassImp(AliEmcalConstituentSubtractionTask)
+
+//________________________________________________________________________
+AliEmcalConstituentSubtractionTask::AliEmcalConstituentSubtractionTask() :
+  AliAnalysisTaskEmcal("AliEmcalConstituentSubtractionTask",kTRUE),
+  fTracksOutName(""),
+  fRhoName(""),
+  fRhomName(""),
+  fAlpha(0),
+  fMaxDelR(0.25),
+  fGhostArea(0.005),
+  fMaxEta(0.9),
+  fTracksOut(0x0),
+  fRhoParam(0),
+  fRhomParam(0),
+  fNGhostEta(0),
+  fNGhostPhi(0),
+  fGhostDEta(0),
+  fGhostDPhi(0),
+  fGhostPt(),
+  fGhostMd(),
+  fPartPt(),
+  fPartMd(),
+  fPartEta(),
+  fPartPhi(),
+  fPartLabel(),
+  fPartCharge(),
+  fPartType(),
+  fPairPart(),
+  fPairGhost(),
+  fHeap(),
+  fHistPtOut(0),
+  fHistNPairs(0)
+{
+  // Default constructor.
+  SetMakeGeneralHistograms(kTRUE);
+}
+
+//________________________________________________________________________
+AliEmcalConstituentSubtractionTask::AliEmcalConstituentSubtractionTask(const char *name) :
+  AliAnalysisTaskEmcal(name,kTRUE),
+  fTracksOutName(""),
+  fRhoName(""),
+  fRhomName(""),
+  fAlpha(0),
+  fMaxDelR(0.25),
+  fGhostArea(0.005),
+  fMaxEta(0.9),
+  fTracksOut(0x0),
+  fRhoParam(0),
+  fRhomParam(0),
+  fNGhostEta(0),
+  fNGhostPhi(0),
+  fGhostDEta(0),
+  fGhostDPhi(0),
+  fGhostPt(),
+  fGhostMd(),
+  fPartPt(),
+  fPartMd(),
+  fPartEta(),
+  fPartPhi(),
+  fPartLabel(),
+  fPartCharge(),
+  fPartType(),
+  fPairPart(),
+  fPairGhost(),
+  fHeap(),
+  fHistPtOut(0),
+  fHistNPairs(0)
+{
+  // Standard constructor.
+  SetMakeGeneralHistograms(kTRUE);
+}
+
+//________________________________________________________________________
+AliEmcalConstituentSubtractionTask::~AliEmcalConstituentSubtractionTask()
+{
+  // Destructor
+
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::ExecOnce()
+{
+  // Exec only once.
+
+  AliAnalysisTaskEmcal::ExecOnce();
+
+  if (!fTracksOutName.IsNull()) {
+    fTracksOut = new TClonesArray("AliPicoTrack");
+    fTracksOut->SetName(fTracksOutName);
+    if (InputEvent()->FindListObject(fTracksOutName)) {
+      AliFatal(Form("%s: Collection %s is already present in the event!", GetName(), fTracksOutName.Data()));
+      return;
+    }
+    else {
+      InputEvent()->AddObject(fTracksOut);
+    }
+  }
+
+  if (!fRhoName.IsNull() && !fRhoParam) {
+    fRhoParam = dynamic_cast<AliRhoParameter*>(InputEvent()->FindListObject(fRhoName));
+    if (!fRhoParam) AliError(Form("%s: Could not retrieve rho %s!", GetName(), fRhoName.Data()));
+  }
+
+  if (!fRhomName.IsNull() && !fRhomParam) {
+    fRhomParam = dynamic_cast<AliRhoParameter*>(InputEvent()->FindListObject(fRhomName));
+    if (!fRhomParam) AliError(Form("%s: Could not retrieve rho_m %s!", GetName(), fRhomName.Data()));
+  }
+
+  BuildGhostGrid();
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::UserCreateOutputObjects()
+{
+  AliAnalysisTaskEmcal::UserCreateOutputObjects();
+
+  fHistPtOut = new TH1F("fHistPtOut","fHistPtOut;#it{p}_{T};N",100,0.,100.);
+  fOutput->Add(fHistPtOut);
+
+  fHistNPairs = new TH1F("fHistNPairs","fHistNPairs;N_{pairs};N",100,0.,200000.);
+  fOutput->Add(fHistNPairs);
+
+  PostData(1, fOutput); // Post data for ALL output slots > 0 here.
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::BuildGhostGrid()
+{
+  // Place the ghosts on a grid covering |eta|<fMaxEta and the full azimuth,
+  // with cells as close as possible to fGhostArea. The geometry does not
+  // depend on the event, only the ghost momenta are reset in each event.
+
+  Double_t size = TMath::Sqrt(fGhostArea > 0 ? fGhostArea : 0.005);
+  fNGhostEta = TMath::Max(1, TMath::CeilNint(2 * fMaxEta / size));
+  fNGhostPhi = TMath::Max(1, TMath::CeilNint(TMath::TwoPi() / size));
+  fGhostDEta = 2 * fMaxEta / fNGhostEta;
+  fGhostDPhi = TMath::TwoPi() / fNGhostPhi;
+
+  AliInfo(Form("%s: %d x %d ghosts of area %.5f", GetName(), fNGhostEta, fNGhostPhi, fGhostDEta * fGhostDPhi));
+}
+
+//________________________________________________________________________
+Bool_t AliEmcalConstituentSubtractionTask::Run()
+{
+  if (!fTracksOut) return kFALSE;
+
+  fTracksOut->Clear();
+
+  FillInputParticles();
+  FindPairs();
+  Subtract();
+  WriteOutput();
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::FillInputParticles()
+{
+  // Copy the accepted particles and clusters in the acceptance of the ghosts,
+  // and set the ghost momenta from rho and rho_m.
+
+  fPartPt.clear();
+  fPartMd.clear();
+  fPartEta.clear();
+  fPartPhi.clear();
+  fPartLabel.clear();
+  fPartCharge.clear();
+  fPartType.clear();
+
+  TIter nextPartColl(&fParticleCollArray);
+  AliParticleContainer* tracks = 0;
+  while ((tracks = static_cast<AliParticleContainer*>(nextPartColl()))) {
+    AliParticleIterableMomentumContainer itcont = tracks->accepted_momentum();
+    for (AliParticleIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+      if (TMath::Abs(it->first.Eta()) > fMaxEta) continue;
+      Double_t pt = it->first.Pt();
+      fPartPt.push_back(pt);
+      fPartMd.push_back(TMath::Sqrt(pt * pt + it->first.M2()) - pt);
+      fPartEta.push_back(it->first.Eta());
+      fPartPhi.push_back(it->first.Phi_0_2pi());
+      fPartLabel.push_back(it->second->GetLabel());
+      fPartCharge.push_back(it->second->Charge());
+      AliVTrack *track = dynamic_cast<AliVTrack*>(it->second);
+      fPartType.push_back(track ? AliPicoTrack::GetTrackType(track) : 0);
+    }
+  }
+
+  TIter nextClusColl(&fClusterCollArray);
+  AliClusterContainer* clusters = 0;
+  while ((clusters = static_cast<AliClusterContainer*>(nextClusColl()))) {
+    AliClusterIterableMomentumContainer itcont = clusters->accepted_momentum();
+    for (AliClusterIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+      if (TMath::Abs(it->first.Eta()) > fMaxEta) continue;
+      Double_t pt = it->first.Pt();
+      fPartPt.push_back(pt);
+      fPartMd.push_back(TMath::Sqrt(pt * pt + it->first.M2()) - pt);
+      fPartEta.push_back(it->first.Eta());
+      fPartPhi.push_back(it->first.Phi_0_2pi());
+      fPartLabel.push_back(it->second->GetLabel());
+      fPartCharge.push_back(0);
+      fPartType.push_back(0);
+    }
+  }
+
+  Double_t rho = fRhoParam ? fRhoParam->GetVal() : 0;
+  Double_t rhom = fRhomParam ? fRhomParam->GetVal() : 0;
+  Double_t area = fGhostDEta * fGhostDPhi;
+  Int_t nGhosts = fNGhostEta * fNGhostPhi;
+  fGhostPt.assign(nGhosts, TMath::Max(rho, 0.) * area);
+  fGhostMd.assign(nGhosts, TMath::Max(rhom, 0.) * area);
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::FindPairs()
+{
+  // Make the particle-ghost pairs within fMaxDelR, visiting only the
+  // ghost cells around each particle, and heapify them by distance.
+
+  fPairPart.clear();
+  fPairGhost.clear();
+  fHeap.clear();
+
+  Bool_t bounded = fMaxDelR > 0;
+  Double_t maxDelR2 = fMaxDelR * fMaxDelR;
+  Int_t nCellsPhi = bounded ? TMath::CeilNint(fMaxDelR / fGhostDPhi) : fNGhostPhi;
+  Bool_t fullPhi = 2 * nCellsPhi + 1 >= fNGhostPhi;
+
+  for (UInt_t ipart = 0; ipart < fPartPt.size(); ipart++) {
+    Double_t eta = fPartEta[ipart];
+    Double_t phi = fPartPhi[ipart];
+    Double_t weight = fAlpha != 0 ? TMath::Power(fPartPt[ipart], fAlpha) : 1.;
+
+    Int_t etaLow = 0, etaHigh = fNGhostEta - 1;
+    if (bounded) {
+      etaLow = TMath::Max(0, Int_t(TMath::Floor((eta - fMaxDelR + fMaxEta) / fGhostDEta)));
+      etaHigh = TMath::Min(fNGhostEta - 1, Int_t(TMath::Floor((eta + fMaxDelR + fMaxEta) / fGhostDEta)));
+    }
+    Int_t phiCenter = TMath::Min(fNGhostPhi - 1, Int_t(phi / fGhostDPhi));
+    Int_t phiLow = fullPhi ? 0 : phiCenter - nCellsPhi;
+    Int_t phiHigh = fullPhi ? fNGhostPhi - 1 : phiCenter + nCellsPhi;
+
+    for (Int_t ieta = etaLow; ieta <= etaHigh; ieta++) {
+      Double_t deta = eta - (-fMaxEta + (ieta + 0.5) * fGhostDEta);
+      for (Int_t jphi = phiLow; jphi <= phiHigh; jphi++) {
+        Int_t iphi = (jphi % fNGhostPhi + fNGhostPhi) % fNGhostPhi;
+        Double_t dphi = TMath::Abs(phi - (iphi + 0.5) * fGhostDPhi);
+        if (dphi > TMath::Pi()) dphi = TMath::TwoPi() - dphi;
+        Double_t dr2 = deta * deta + dphi * dphi;
+        if (bounded && dr2 > maxDelR2) continue;
+        fHeap.push_back(std::make_pair(weight * TMath::Sqrt(dr2), Int_t(fPairPart.size())));
+        fPairPart.push_back(ipart);
+        fPairGhost.push_back(ieta * fNGhostPhi + iphi);
+      }
+    }
+  }
+
+  std::make_heap(fHeap.begin(), fHeap.end(), std::greater<std::pair<Double_t,Int_t> >());
+  fHistNPairs->Fill(fHeap.size());
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::Subtract()
+{
+  // Take the pairs in increasing distance and move pt and mt-pt from the
+  // particle to the ghost. Stops as soon as nothing is left to subtract.
+
+  Double_t ghostPtLeft = 0, ghostMdLeft = 0;
+  for (UInt_t ighost = 0; ighost < fGhostPt.size(); ighost++) {
+    ghostPtLeft += fGhostPt[ighost];
+    ghostMdLeft += fGhostMd[ighost];
+  }
+
+  std::greater<std::pair<Double_t,Int_t> > cmp;
+  std::vector<std::pair<Double_t,Int_t> >::iterator heapEnd = fHeap.end();
+  while (heapEnd != fHeap.begin() && (ghostPtLeft > 0 || ghostMdLeft > 0)) {
+    std::pop_heap(fHeap.begin(), heapEnd, cmp);
+    --heapEnd;
+    Int_t ipair = heapEnd->second;
+    Int_t ipart = fPairPart[ipair];
+    Int_t ighost = fPairGhost[ipair];
+
+    Double_t dpt = TMath::Min(fPartPt[ipart], fGhostPt[ighost]);
+    fPartPt[ipart] -= dpt;
+    fGhostPt[ighost] -= dpt;
+    ghostPtLeft -= dpt;
+
+    Double_t dmd = TMath::Min(fPartMd[ipart], fGhostMd[ighost]);
+    fPartMd[ipart] -= dmd;
+    fGhostMd[ighost] -= dmd;
+    ghostMdLeft -= dmd;
+  }
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractionTask::WriteOutput()
+{
+  // Write the particles with pt left to the output collection.
+
+  Int_t nt = 0;
+  for (UInt_t ipart = 0; ipart < fPartPt.size(); ipart++) {
+    Double_t pt = fPartPt[ipart];
+    if (pt <= 0) continue;
+    Double_t md = fPartMd[ipart];
+    Double_t mass = TMath::Sqrt(md * md + 2 * pt * md);
+
+    new ((*fTracksOut)[nt]) AliPicoTrack(pt,
+                                         fPartEta[ipart],
+                                         fPartPhi[ipart],
+                                         fPartCharge[ipart],
+                                         fPartLabel[ipart],
+                                         fPartType[ipart],
+                                         0, 0, 0, 0,
+                                         mass);
+    fHistPtOut->Fill(pt);
+    nt++;
+  }
+}
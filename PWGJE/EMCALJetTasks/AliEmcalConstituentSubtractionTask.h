@@ -0,0 +1,82 @@
+#ifndef ALIEMCALCONSTITUENTSUBTRACTIONTASK_H
+#define ALIEMCALCONSTITUENTSUBTRACTIONTASK_H
+
+// $Id$
+
+class TClonesArray;
+class TH1F;
+class AliRhoParameter;
+
+#include <vector>
+#include <utility>
+
+#include "AliAnalysisTaskEmcal.h"
+
+class AliEmcalConstituentSubtractionTask : public AliAnalysisTaskEmcal {
+ public:
+  AliEmcalConstituentSubtractionTask();
+  AliEmcalConstituentSubtractionTask(const char *name);
+  virtual ~AliEmcalConstituentSubtractionTask();
+
+  virtual void           UserCreateOutputObjects();
+
+  void                   SetTracksOutName(const char *n)          { fTracksOutName   = n;    }
+  void                   SetRhoName(const char *n)                { fRhoName         = n;    }
+  void                   SetRhomName(const char *n)               { fRhomName        = n;    }
+  void                   SetAlpha(Double_t a)                     { fAlpha           = a;    }
+  void                   SetMaxDelR(Double_t r)                   { fMaxDelR         = r;    }
+  void                   SetGhostArea(Double_t a)                 { fGhostArea       = a;    }
+  void                   SetMaxEta(Double_t e)                    { fMaxEta          = e;    }
+
+ protected:
+  void                   ExecOnce();
+  Bool_t                 Run();
+
+  void                   BuildGhostGrid();
+  void                   FillInputParticles();
+  void                   FindPairs();
+  void                   Subtract();
+  void                   WriteOutput();
+
+  TString                fTracksOutName;       // name of output track collection
+  TString                fRhoName;             // name of rho
+  TString                fRhomName;            // name of rho_m
+  Double_t               fAlpha;               // pT weight exponent of the particle-ghost distance
+  Double_t               fMaxDelR;             // max distance between ghost and particle in a pair (<=0 for no limit)
+  Double_t               fGhostArea;           // requested area of each ghost
+  Double_t               fMaxEta;              // eta range of the ghosts, particles outside are dropped
+
+  TClonesArray          *fTracksOut;           //!output track collection
+  AliRhoParameter       *fRhoParam;            //!event rho
+  AliRhoParameter       *fRhomParam;           //!event rho_m
+
+  Int_t                  fNGhostEta;           //!number of ghost rows in eta
+  Int_t                  fNGhostPhi;           //!number of ghost columns in phi
+  Double_t               fGhostDEta;           //!ghost size in eta
+  Double_t               fGhostDPhi;           //!ghost size in phi
+  std::vector<Double_t>  fGhostPt;             //!remaining pt of the ghosts
+  std::vector<Double_t>  fGhostMd;             //!remaining mt-pt of the ghosts
+
+  std::vector<Double_t>  fPartPt;              //!remaining pt of the input particles
+  std::vector<Double_t>  fPartMd;              //!remaining mt-pt of the input particles
+  std::vector<Double_t>  fPartEta;             //!eta of the input particles
+  std::vector<Double_t>  fPartPhi;             //!phi of the input particles
+  std::vector<Int_t>     fPartLabel;           //!label of the input particles
+  std::vector<Int_t>     fPartCharge;          //!charge of the input particles
+  std::vector<Int_t>     fPartType;            //!track type of the input particles (AliPicoTrack convention)
+
+  std::vector<Int_t>     fPairPart;            //!particle of each particle-ghost pair
+  std::vector<Int_t>     fPairGhost;           //!ghost of each particle-ghost pair
+  std::vector<std::pair<Double_t,Int_t> > fHeap; //!min heap of (distance, pair)
+
+  //Output objects
+  TH1F                  *fHistPtOut;           //!pT spectrum of output particles
+  TH1F                  *fHistNPairs;          //!number of particle-ghost pairs per event
+
+ private:
+  AliEmcalConstituentSubtractionTask(const AliEmcalConstituentSubtractionTask&);            // not implemented
+  AliEmcalConstituentSubtractionTask &operator=(const AliEmcalConstituentSubtractionTask&); // not implemented
+
+  ClassDef(AliEmcalConstituentSubtractionTask, 1) // event-wide constituent subtraction
+};
+#endif
@@ -0,0 +1,126 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include <TMath.h>
+
+#include <fastjet/ClusterSequence.hh>
+
+#include "AliEmcalJetDeclusteringTree.h"
+
+AliEmcalJetDeclusteringTree::AliEmcalJetDeclusteringTree(fastjet::JetAlgorithm algorithm, Double_t radius) :
+  fAlgorithm(algorithm),
+  fRadius(radius),
+  fNodes(),
+  fLastPt(0),
+  fLastM(0)
+{
+}
+
+void AliEmcalJetDeclusteringTree::Clear()
+{
+  fNodes.clear();
+  fLastPt = 0;
+  fLastM = 0;
+}
+
+/**
+ * Recluster the constituents of the jet and store the primary declustering sequence.
+ * All the constituents are merged into a single jet (exclusive_jets_up_to(1)), so the
+ * first node is the last clustering step. Throws fastjet::Error if the reclustering fails.
+ * @param jet Jet with constituents
+ */
+void AliEmcalJetDeclusteringTree::Build(const fastjet::PseudoJet &jet)
+{
+  Clear();
+  std::vector<fastjet::PseudoJet> constituents = jet.constituents();
+  if (constituents.empty()) return;
+
+  fastjet::JetDefinition jetdef(fAlgorithm, fRadius, fastjet::E_scheme, fastjet::Best);
+  fastjet::ClusterSequence reclusterizer(constituents, jetdef);
+  std::vector<fastjet::PseudoJet> reclustered = reclusterizer.exclusive_jets_up_to(1);
+  if (reclustered.empty()) return;
+
+  fastjet::PseudoJet current = reclustered[0], hard, soft;
+  while (current.has_parents(hard, soft)) {
+    if (hard.perp2() < soft.perp2()) std::swap(hard, soft);
+    Node_t node;
+    node.fPtParent = current.perp();
+    node.fMParent = current.m();
+    node.fPtHard = hard.perp();
+    node.fPtSoft = soft.perp();
+    node.fDeltaR = hard.delta_R(soft);
+    node.fZ = node.fPtSoft / (node.fPtHard + node.fPtSoft);
+    node.fKt = node.fPtSoft * node.fDeltaR;
+    node.fMu = current.m2() > 0 ? TMath::Sqrt(std::max(hard.m2(), soft.m2()) / current.m2()) : 0.;
+    fNodes.push_back(node);
+    current = hard;
+  }
+  fLastPt = current.perp();
+  fLastM = current.m();
+}
+
+/**
+ * Groom the jet with one soft drop setting: the first node with
+ * z > zcut * (deltaR/R0)^beta stops the grooming.
+ * @param setting Grooming setting
+ * @return Groomed jet parameters
+ */
+AliEmcalJetDeclusteringTree::SoftDropResult_t AliEmcalJetDeclusteringTree::SoftDrop(const SoftDropSetting_t &setting) const
+{
+  SoftDropResult_t result = {0., 0., fLastM, fLastPt, 0., 0};
+  for (const auto &node : fNodes) {
+    if (node.fZ > setting.fZCut * TMath::Power(node.fDeltaR / setting.fR0, setting.fBeta)) {
+      result.fZg = node.fZ;
+      result.fRg = node.fDeltaR;
+      result.fMg = node.fMParent;
+      result.fPtg = node.fPtParent;
+      result.fMug = node.fMu;
+      return result;
+    }
+    result.fNDropped++;
+  }
+  return result;
+}
+
+/**
+ * Groom the jet with several soft drop settings in a single pass over the nodes.
+ * @param[in] settings Grooming settings
+ * @param[out] results Groomed jet parameters, in the order of the settings
+ */
+void AliEmcalJetDeclusteringTree::SoftDrop(const std::vector<SoftDropSetting_t> &settings, std::vector<SoftDropResult_t> &results) const
+{
+  SoftDropResult_t ungroomed = {0., 0., fLastM, fLastPt, 0., static_cast<Int_t>(fNodes.size())};
+  results.assign(settings.size(), ungroomed);
+  std::vector<bool> done(settings.size(), false);
+  size_t ndone = 0;
+  for (size_t inode = 0; inode < fNodes.size() && ndone < settings.size(); inode++) {
+    const Node_t &node = fNodes[inode];
+    for (size_t iset = 0; iset < settings.size(); iset++) {
+      if (done[iset]) continue;
+      const SoftDropSetting_t &setting = settings[iset];
+      if (node.fZ <= setting.fZCut * TMath::Power(node.fDeltaR / setting.fR0, setting.fBeta)) continue;
+      SoftDropResult_t &result = results[iset];
+      result.fZg = node.fZ;
+      result.fRg = node.fDeltaR;
+      result.fMg = node.fMParent;
+      result.fPtg = node.fPtParent;
+      result.fMug = node.fMu;
+      result.fNDropped = inode;
+      done[iset] = true;
+      ndone++;
+    }
+  }
+}
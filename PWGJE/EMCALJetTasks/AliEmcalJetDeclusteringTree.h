@@ -0,0 +1,86 @@
+#ifndef ALIEMCALJETDECLUSTERINGTREE_H
+#define ALIEMCALJETDECLUSTERINGTREE_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <Rtypes.h>
+#include <fastjet/PseudoJet.hh>
+#include <fastjet/JetDefinition.hh>
+
+/**
+ * @class AliEmcalJetDeclusteringTree
+ * @brief Primary declustering sequence of a jet, evaluated for several groomers at once
+ * @ingroup PWGJETASKS
+ *
+ * The constituents of the jet are reclustered once (by default with Cambridge/Aachen) and
+ * the primary declustering sequence, following always the harder branch, is stored as a flat
+ * array of nodes. All soft drop settings (zcut, beta) are then evaluated from the same array
+ * with the semantics of fastjet::contrib::SoftDrop in grooming mode with the scalar_z
+ * symmetry measure, and the nodes are directly the primary Lund plane of the jet
+ * (ln(1/fDeltaR), ln(fKt)).
+ *
+ * ~~~{.cxx}
+ * AliEmcalJetDeclusteringTree tree;
+ * tree.Build(jet);    // one reclustering per jet
+ * std::vector<AliEmcalJetDeclusteringTree::SoftDropResult_t> results;
+ * tree.SoftDrop(settings, results);
+ * ~~~
+ */
+class AliEmcalJetDeclusteringTree {
+public:
+  /// One step of the primary declustering
+  struct Node_t {
+    Double_t fPtParent;       ///< pt of the parent (groomed jet pt if the node passes the grooming)
+    Double_t fMParent;        ///< mass of the parent
+    Double_t fPtHard;         ///< pt of the harder branch
+    Double_t fPtSoft;         ///< pt of the softer branch
+    Double_t fDeltaR;         ///< distance in rapidity-phi between the two branches
+    Double_t fZ;              ///< momentum fraction of the softer branch
+    Double_t fKt;             ///< pt of the softer branch relative to the harder one (fPtSoft * fDeltaR)
+    Double_t fMu;             ///< mass drop max(m1, m2)/m
+  };
+
+  /// Grooming setting
+  struct SoftDropSetting_t {
+    Double_t fZCut;           ///< cut on z
+    Double_t fBeta;           ///< angular exponent
+    Double_t fR0;             ///< angular normalisation
+  };
+
+  /// Groomed jet
+  struct SoftDropResult_t {
+    Double_t fZg;             ///< z of the first node passing the condition (0 if none)
+    Double_t fRg;             ///< deltaR of the first node passing the condition (0 if none)
+    Double_t fMg;             ///< groomed jet mass
+    Double_t fPtg;            ///< groomed jet pt
+    Double_t fMug;            ///< mass drop of the first node passing the condition (0 if none)
+    Int_t    fNDropped;       ///< number of dropped branches
+  };
+
+  AliEmcalJetDeclusteringTree(fastjet::JetAlgorithm algorithm = fastjet::cambridge_aachen_algorithm, Double_t radius = 1.);
+  ~AliEmcalJetDeclusteringTree() {}
+
+  void Build(const fastjet::PseudoJet &jet);
+  void Clear();
+
+  void SetReclusterAlgorithm(fastjet::JetAlgorithm algorithm) { fAlgorithm = algorithm; }
+  void SetReclusterRadius(Double_t radius)                   { fRadius = radius; }
+
+  const std::vector<Node_t> &GetNodes()          const { return fNodes; }
+  Int_t                      GetNumberOfNodes()  const { return fNodes.size(); }
+  Double_t                   GetLastPt()         const { return fLastPt; }
+  Double_t                   GetLastM()          const { return fLastM; }
+
+  SoftDropResult_t SoftDrop(const SoftDropSetting_t &setting) const;
+  void             SoftDrop(const std::vector<SoftDropSetting_t> &settings, std::vector<SoftDropResult_t> &results) const;
+
+private:
+  fastjet::JetAlgorithm fAlgorithm;      ///< reclustering algorithm
+  Double_t              fRadius;         ///< reclustering radius
+  std::vector<Node_t>   fNodes;          ///< primary declustering, from the full jet inwards
+  Double_t              fLastPt;         ///< pt of the hard branch left at the end of the declustering
+  Double_t              fLastM;          ///< mass of the hard branch left at the end of the declustering
+};
+
+#endif
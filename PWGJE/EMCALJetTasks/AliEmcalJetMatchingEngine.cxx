@@ -0,0 +1,204 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include "AliEmcalJet.h"
+#include "AliEmcalJetMatchingEngine.h"
+
+namespace {
+  /// Orders constituent entries by key, then by jet number
+  struct KeyLess {
+    const std::vector<Int_t> &fKey;
+    KeyLess(const std::vector<Int_t> &key): fKey(key) {}
+    bool operator()(Int_t a, Int_t b) const { return fKey[a] != fKey[b] ? fKey[a] < fKey[b] : a < b; }
+  };
+}
+
+AliEmcalJetMatchingEngine::AliEmcalJetMatchingEngine():
+  fJets(),
+  fGrid(),
+  fPendingJet(),
+  fPendingKey(),
+  fPendingPt(),
+  fConstStart(),
+  fConstKey(),
+  fConstPt(),
+  fKeyOrder(),
+  fFound(),
+  fTouched()
+{
+}
+
+/**
+ * Remove the jets of the previous event. The memory is kept for the next event.
+ * @param[in] maxDistance Largest distance used in FindGeometricalCandidates(), sets the cell size
+ */
+void AliEmcalJetMatchingEngine::Reset(Double_t maxDistance)
+{
+  fJets.clear();
+  fGrid.Reset(-1., 1., maxDistance, maxDistance);
+  fPendingJet.clear();
+  fPendingKey.clear();
+  fPendingPt.clear();
+  fConstStart.clear();
+  fConstKey.clear();
+  fConstPt.clear();
+  fKeyOrder.clear();
+}
+
+/**
+ * Register a jet, to be called before Build().
+ * @param[in] jet Jet of the partner collection
+ * @return Jet number, used in AddConstituent() and returned by the candidate searches
+ */
+Int_t AliEmcalJetMatchingEngine::AddJet(AliEmcalJet *jet)
+{
+  fJets.push_back(jet);
+  fGrid.Add(jet->Eta(), jet->Phi(), fJets.size() - 1);
+  return fJets.size() - 1;
+}
+
+/**
+ * Add a constituent to a registered jet, to be called before Build().
+ * @param[in] ijet Jet number returned by AddJet()
+ * @param[in] key Key of the constituent, e.g. its index in the particle container
+ * @param[in] pt Transverse momentum of the constituent
+ */
+void AliEmcalJetMatchingEngine::AddConstituent(Int_t ijet, Int_t key, Double_t pt)
+{
+  fPendingJet.push_back(ijet);
+  fPendingKey.push_back(key);
+  fPendingPt.push_back(pt);
+}
+
+/**
+ * Build the eta-phi grid and the constituent tables, to be called once after all the jets are added.
+ */
+void AliEmcalJetMatchingEngine::Build()
+{
+  fGrid.Build();
+
+  Int_t njets = fJets.size(), nconst = fPendingKey.size();
+  fConstStart.assign(njets + 1, 0);
+  for (Int_t i = 0; i < nconst; i++) fConstStart[fPendingJet[i] + 1]++;
+  for (Int_t ijet = 0; ijet < njets; ijet++) fConstStart[ijet + 1] += fConstStart[ijet];
+
+  // constituents grouped by jet, sorted by key within a jet
+  std::vector<std::pair<Int_t, Double_t> > sorted(nconst);
+  std::vector<Int_t> fill(fConstStart.begin(), fConstStart.end() - 1);
+  for (Int_t i = 0; i < nconst; i++) sorted[fill[fPendingJet[i]]++] = std::make_pair(fPendingKey[i], fPendingPt[i]);
+  fConstKey.resize(nconst);
+  fConstPt.resize(nconst);
+  for (Int_t ijet = 0; ijet < njets; ijet++) {
+    std::stable_sort(sorted.begin() + fConstStart[ijet], sorted.begin() + fConstStart[ijet + 1]);
+  }
+  for (Int_t i = 0; i < nconst; i++) {
+    fConstKey[i] = sorted[i].first;
+    fConstPt[i] = sorted[i].second;
+  }
+
+  // entries sorted by key, for the jets containing a key
+  fKeyOrder.resize(nconst);
+  for (Int_t i = 0; i < nconst; i++) fKeyOrder[i] = i;
+  std::sort(fKeyOrder.begin(), fKeyOrder.end(), KeyLess(fConstKey));
+
+  fFound.assign(nconst, 0);
+  fTouched.clear();
+}
+
+/**
+ * Find the registered jets within a distance in \f$\eta\f$-\f$\phi\f$.
+ * @param[in] jet Jet to be matched
+ * @param[in] maxDistance Largest distance (AliEmcalJet::DeltaR())
+ * @param[out] candidates Jet numbers, in the order they were added
+ */
+void AliEmcalJetMatchingEngine::FindGeometricalCandidates(const AliEmcalJet *jet, Double_t maxDistance, std::vector<Int_t> &candidates) const
+{
+  fGrid.FindCandidates(jet->Eta(), jet->Phi(), maxDistance, maxDistance, candidates);
+  UInt_t nselected = 0;
+  for (UInt_t i = 0; i < candidates.size(); i++) {
+    if (jet->DeltaR(fJets[candidates[i]]) <= maxDistance) candidates[nselected++] = candidates[i];
+  }
+  candidates.resize(nselected);
+}
+
+/**
+ * Find the registered jets containing at least one of the keys.
+ * @param[in] keys Constituent keys
+ * @param[out] candidates Jet numbers, in the order they were added
+ */
+void AliEmcalJetMatchingEngine::FindConstituentCandidates(const std::vector<Int_t> &keys, std::vector<Int_t> &candidates) const
+{
+  candidates.clear();
+  Int_t njets = fConstStart.size() - 1;
+  for (UInt_t ikey = 0; ikey < keys.size(); ikey++) {
+    // lower bound of the key in the key ordered entries
+    Int_t low = 0, high = fKeyOrder.size();
+    while (low < high) {
+      Int_t mid = (low + high) / 2;
+      if (fConstKey[fKeyOrder[mid]] < keys[ikey]) low = mid + 1;
+      else high = mid;
+    }
+    for (UInt_t i = low; i < fKeyOrder.size() && fConstKey[fKeyOrder[i]] == keys[ikey]; i++) {
+      Int_t entry = fKeyOrder[i];
+      Int_t ijet = std::upper_bound(fConstStart.begin(), fConstStart.begin() + njets + 1, entry) - fConstStart.begin() - 1;
+      candidates.push_back(ijet);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+/**
+ * Find a constituent in a registered jet.
+ * @param[in] ijet Jet number
+ * @param[in] key Constituent key
+ * @return Constituent entry (see GetConstituentPt()), -1 if the jet does not contain the key
+ */
+Int_t AliEmcalJetMatchingEngine::FindConstituent(Int_t ijet, Int_t key) const
+{
+  std::vector<Int_t>::const_iterator first = fConstKey.begin() + fConstStart[ijet], last = fConstKey.begin() + fConstStart[ijet + 1];
+  std::vector<Int_t>::const_iterator found = std::lower_bound(first, last, key);
+  if (found == last || *found != key) return -1;
+  return found - fConstKey.begin();
+}
+
+/**
+ * Shared transverse momentum of a list of constituents with a registered jet.
+ * @param[in] ijet Jet number
+ * @param[in] keys Keys of the constituents
+ * @param[in] pt Transverse momentum of the constituents
+ * @param[in] weights Weight of the constituents for the shared momentum in the registered jet (e.g. a cell fraction)
+ * @param[out] shared Sum of pt of the constituents found in the jet
+ * @param[out] sharedJet Sum of the momenta of the jet constituents found, each counted once with the weight of the first key found
+ */
+void AliEmcalJetMatchingEngine::GetSharedPt(Int_t ijet, const std::vector<Int_t> &keys, const std::vector<Double_t> &pt,
+                                            const std::vector<Double_t> &weights, Double_t &shared, Double_t &sharedJet) const
+{
+  shared = 0;
+  sharedJet = 0;
+  if (fConstStart[ijet] == fConstStart[ijet + 1]) return;
+  for (UInt_t ikey = 0; ikey < keys.size(); ikey++) {
+    Int_t entry = FindConstituent(ijet, keys[ikey]);
+    if (entry < 0) continue;
+    shared += pt[ikey];
+    if (fFound[entry]) continue;
+    sharedJet += fConstPt[entry] * weights[ikey];
+    fFound[entry] = 1;
+    fTouched.push_back(entry);
+  }
+  for (UInt_t i = 0; i < fTouched.size(); i++) fFound[fTouched[i]] = 0;
+  fTouched.clear();
+}
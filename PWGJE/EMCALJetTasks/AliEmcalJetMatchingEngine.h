@@ -0,0 +1,74 @@
+#ifndef ALIEMCALJETMATCHINGENGINE_H
+#define ALIEMCALJETMATCHINGENGINE_H
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <Rtypes.h>
+#include "AliEmcalMatchingGrid.h"
+
+class AliEmcalJet;
+
+/**
+ * @class AliEmcalJetMatchingEngine
+ * @brief Per-event index of a jet collection for jet-jet matching
+ * @ingroup PWGJETASKS
+ *
+ * The jets of the partner collection are registered once per event. They are
+ * binned in \f$\eta\f$-\f$\phi\f$ (with \f$\phi\f$ wrap-around), so that for
+ * geometrical matching only the jets around the position of a jet are
+ * compared to it. Optionally the constituents of the registered jets are added
+ * with an integer key (e.g. the index of the particle in the particle
+ * container) and their \f$p_{T}\f$, which gives
+ * - the jets sharing at least one constituent with a list of keys
+ * - the shared \f$p_{T}\f$ of a list of keys with one jet, with a lookup per key
+ *   instead of a loop over the constituents of the jet.
+ *
+ * ~~~{.cxx}
+ * engine.Reset(maxDistance);
+ * for(auto jet : jets2->all()) {
+ *   Int_t ijet = engine.AddJet(jet);
+ *   for(Int_t i = 0; i < jet->GetNumberOfTracks(); i++) engine.AddConstituent(ijet, jet->TrackAt(i), jet->Track(i)->Pt());
+ * }
+ * engine.Build();
+ * engine.FindGeometricalCandidates(jet1, maxDistance, candidates);
+ * ~~~
+ *
+ * Candidates are always returned in the order the jets were added, so that
+ * the matching result does not depend on the binning.
+ */
+class AliEmcalJetMatchingEngine {
+public:
+  AliEmcalJetMatchingEngine();
+  virtual ~AliEmcalJetMatchingEngine() {}
+
+  void         Reset(Double_t maxDistance);
+  Int_t        AddJet(AliEmcalJet *jet);
+  void         AddConstituent(Int_t ijet, Int_t key, Double_t pt);
+  void         Build();
+
+  Int_t        GetNJets()                                                                       const { return fJets.size(); }
+  AliEmcalJet *GetJet(Int_t ijet)                                                               const { return fJets[ijet]; }
+
+  void         FindGeometricalCandidates(const AliEmcalJet *jet, Double_t maxDistance, std::vector<Int_t> &candidates) const;
+  void         FindConstituentCandidates(const std::vector<Int_t> &keys, std::vector<Int_t> &candidates) const;
+  Int_t        FindConstituent(Int_t ijet, Int_t key)                                           const;
+  Double_t     GetConstituentPt(Int_t entry)                                                    const { return fConstPt[entry]; }
+  void         GetSharedPt(Int_t ijet, const std::vector<Int_t> &keys, const std::vector<Double_t> &pt,
+                           const std::vector<Double_t> &weights, Double_t &shared, Double_t &sharedJet) const;
+
+private:
+  std::vector<AliEmcalJet*>    fJets;                 ///< Registered jets
+  AliEmcalMatchingGrid         fGrid;                 ///< Jets binned in eta-phi
+  std::vector<Int_t>           fPendingJet;           ///< Jet number of the constituents added since the last Build()
+  std::vector<Int_t>           fPendingKey;           ///< Key of the constituents added since the last Build()
+  std::vector<Double_t>        fPendingPt;            ///< Transverse momentum of the constituents added since the last Build()
+  std::vector<Int_t>           fConstStart;           ///< First constituent entry per jet, size njets+1
+  std::vector<Int_t>           fConstKey;             ///< Constituent keys grouped by jet, sorted by key within a jet
+  std::vector<Double_t>        fConstPt;              ///< Constituent transverse momenta, same order as fConstKey
+  std::vector<Int_t>           fKeyOrder;             ///< Constituent entries sorted by key (and jet)
+  mutable std::vector<UChar_t> fFound;                ///< Constituent entry already counted by GetSharedPt()
+  mutable std::vector<Int_t>   fTouched;              ///< Entries set in fFound by the current GetSharedPt() call
+};
+
+#endif
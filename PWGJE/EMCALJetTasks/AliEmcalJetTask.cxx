@@ -34,6 +34,7 @@
 #include "AliFJWrapper.h"
 #include "AliEmcalJetUtility.h"
 #include "AliParticleContainer.h"
+#include "AliEmcalMergedParticleContainer.h"
 #include "AliClusterContainer.h"
 #include "AliEmcalClusterJetConstituent.h"
 #include "AliEmcalParticleJetConstituent.h"
@@ -73,6 +74,8 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fAdditionalRadii(),
+  fPackConstituents(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -80,6 +83,7 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
   fJets(0),
+  fAdditionalJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
@@ -109,6 +113,8 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fLocked(0),
   fFillConstituents(kTRUE),
+  fAdditionalRadii(),
+  fPackConstituents(kFALSE),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -116,6 +122,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
   fJets(0),
+  fAdditionalJets(0),
   fFastJetWrapper(name,name),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
@@ -127,6 +134,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  delete fAdditionalJets;
 }
 
 /**
@@ -146,6 +154,40 @@ AliEmcalJetUtility* AliEmcalJetTask::AddUtility(AliEmcalJetUtility* utility)
   return utility;
 }
 
+/**
+ * Add a jet radius for which jets are found on the same input as the main
+ * jet radius. The jet finding is repeated for each additional radius in the
+ * same event loop, and the jets are stored in a separate jet collection.
+ * @param r Jet radius
+ */
+void AliEmcalJetTask::AddJetRadius(Double_t r)
+{
+  if (IsLocked()) return;
+  if (TMath::Abs(r - fRadius) < 1e-6) {
+    AliWarning(Form("Jet radius %.2f is already the main jet radius, not added", r));
+    return;
+  }
+  for (Int_t ir = 0; ir < fAdditionalRadii.GetSize(); ir++) {
+    if (TMath::Abs(r - fAdditionalRadii[ir]) < 1e-6) {
+      AliWarning(Form("Jet radius %.2f already added", r));
+      return;
+    }
+  }
+  fAdditionalRadii.Set(fAdditionalRadii.GetSize() + 1);
+  fAdditionalRadii[fAdditionalRadii.GetSize() - 1] = r;
+}
+
+/**
+ * Get the jet collection for an additional jet radius.
+ * @param i Index of the additional radius (in the order they were added)
+ * @return Jet collection (NULL if not available)
+ */
+TClonesArray* AliEmcalJetTask::GetAdditionalJets(Int_t i) const
+{
+  if (!fAdditionalJets || i < 0 || i >= fAdditionalJets->GetEntriesFast()) return 0;
+  return static_cast<TClonesArray*>(fAdditionalJets->At(i));
+}
+
 /**
  * This method is called once before analyzing the first event. It executes
  * the Init() method of all utilities (if any).
@@ -210,15 +252,45 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  if (AliEmcalJetConstituentIndexBuffer *buffer = GetConstituentIndexBuffer(fJets)) buffer->Clear();
+  for (Int_t ir = 0; ir < fAdditionalRadii.GetSize(); ir++) {
+    TClonesArray *jets = GetAdditionalJets(ir);
+    if (!jets) continue;
+    jets->Delete();
+    if (AliEmcalJetConstituentIndexBuffer *buffer = GetConstituentIndexBuffer(jets)) buffer->Clear();
+  }
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
 
+  FindAdditionalJets();
+
   return kTRUE;
 }
 
+/**
+ * This method repeats the jet finding for all additional jet radii (if any),
+ * using the input vectors already provided to the FastJet wrapper in FindJets(),
+ * and fills the corresponding jet collections. The wrapper is left
+ * configured with the main jet radius.
+ */
+void AliEmcalJetTask::FindAdditionalJets()
+{
+  if (fAdditionalRadii.GetSize() == 0) return;
+
+  for (Int_t ir = 0; ir < fAdditionalRadii.GetSize(); ir++) {
+    TClonesArray *jets = GetAdditionalJets(ir);
+    if (!jets) continue;
+    fFastJetWrapper.SetR(fAdditionalRadii[ir]);
+    if (fFastJetWrapper.Run() != 0) continue;
+    FillJetBranch(jets, fAdditionalRadii[ir], kFALSE);
+  }
+
+  fFastJetWrapper.SetR(fRadius);
+}
+
 /**
  * This method steers the jet finding. It first loops over all particle and cluster containers
  * that were provided when the task was initialized. All accepted objects (tracks, particle, clusters)
@@ -242,11 +314,18 @@ Int_t AliEmcalJetTask::FindJets()
   AliParticleContainer* tracks = 0;
   while ((tracks = static_cast<AliParticleContainer*>(nextPartColl()))) {
     AliDebug(2,Form("Tracks from collection %d: '%s'. Embedded: %i, nTracks: %i", iColl-1, tracks->GetName(), tracks->GetIsEmbedding(), tracks->GetNParticles()));
+    AliEmcalMergedParticleContainer* merged = dynamic_cast<AliEmcalMergedParticleContainer*>(tracks);
     AliParticleIterableMomentumContainer itcont = tracks->accepted_momentum();
     for (AliParticleIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
       // artificial inefficiency
       if (fTrackEfficiency < 1.) {
-        if (fTrackEfficiencyOnlyForEmbedding == kFALSE || (fTrackEfficiencyOnlyForEmbedding == kTRUE && tracks->GetIsEmbedding())) {
+        Bool_t isEmbedding = tracks->GetIsEmbedding();
+        if (merged) {
+          Int_t localIndex = -1;
+          AliParticleContainer* component = merged->GetComponentFromIndex(it.current_index(), localIndex);
+          if (component) isEmbedding = component->GetIsEmbedding();
+        }
+        if (fTrackEfficiencyOnlyForEmbedding == kFALSE || (fTrackEfficiencyOnlyForEmbedding == kTRUE && isEmbedding)) {
           Double_t rnd = gRandom->Rndm();
           if (fTrackEfficiency < rnd) {
             AliDebug(2,Form("Track %d rejected due to artificial tracking inefficiency", it.current_index()));
@@ -291,10 +370,24 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fJets, fRadius, kTRUE);
+}
+
+/**
+ * This method fills a jet collection with the jets found by the FastJet wrapper
+ * in the last run.
+ * @param jets Jet collection to be filled
+ * @param radius Jet radius used in the last run of the FastJet wrapper
+ * @param doUtilities If kTRUE the jet utilities are executed
+ */
+void AliEmcalJetTask::FillJetBranch(TClonesArray *jets, Double_t radius, Bool_t doUtilities)
+{
+  if (doUtilities) PrepareUtilities();
+
+  AliEmcalJetConstituentIndexBuffer *indexBuffer = GetConstituentIndexBuffer(jets);
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  const std::vector<fastjet::PseudoJet>& jets_incl = fFastJetWrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -310,7 +403,7 @@ void AliEmcalJetTask::FillJetBranch()
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
@@ -319,7 +412,7 @@ void AliEmcalJetTask::FillJetBranch()
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
     std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
@@ -333,13 +426,15 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (doUtilities) ExecuteUtilities(jet, ij);
+
+    if (indexBuffer) jet->PackConstituents(*indexBuffer);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  if (doUtilities) TerminateUtilities();
 }
 
 /**
@@ -348,7 +443,7 @@ void AliEmcalJetTask::FillJetBranch()
  * @param[in] array Vector containing the list of jets obtained by the FastJet wrapper
  * @return kTRUE if at least one jet was found in array; kFALSE otherwise
  */
-Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const
+Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], const std::vector<fastjet::PseudoJet>& array) const
 {
   static Float_t pt[9999] = {0};
 
@@ -365,6 +460,37 @@ Bool_t AliEmcalJetTask::GetSortedArray(Int_t indexes[], std::vector<fastjet::Pse
   return kTRUE;
 }
 
+/**
+ * Adds a jet collection to the event, together with the index buffer
+ * for the packed jet constituents if requested.
+ * @param jets Jet collection
+ */
+void AliEmcalJetTask::AddJetCollection(TClonesArray *jets)
+{
+  ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jets->GetName());
+  InputEvent()->AddObject(jets);
+
+  if (!fPackConstituents) return;
+  TString bufferName = AliEmcalJetConstituentIndexBuffer::GetBufferName(jets->GetName());
+  if (InputEvent()->FindListObject(bufferName)) {
+    AliError(Form("%s: Object with name %s already in event! Jet constituents will not be packed", GetName(), bufferName.Data()));
+    return;
+  }
+  InputEvent()->AddObject(new AliEmcalJetConstituentIndexBuffer(bufferName));
+  ::Info("AliEmcalJetTask::ExecOnce", "Constituent index buffer with name '%s' has been added to the event.", bufferName.Data());
+}
+
+/**
+ * Index buffer for the packed jet constituents of a jet collection.
+ * @param jets Jet collection
+ * @return Index buffer (NULL if the constituents are not packed)
+ */
+AliEmcalJetConstituentIndexBuffer* AliEmcalJetTask::GetConstituentIndexBuffer(const TClonesArray *jets) const
+{
+  if (!fPackConstituents || !jets) return 0;
+  return dynamic_cast<AliEmcalJetConstituentIndexBuffer*>(InputEvent()->FindListObject(AliEmcalJetConstituentIndexBuffer::GetBufferName(jets->GetName())));
+}
+
 /**
  * This method is called once before analzying the first event.
  * It generates the output jet branch name, initializes the FastJet wrapper
@@ -395,14 +521,29 @@ void AliEmcalJetTask::ExecOnce()
   if (!(InputEvent()->FindListObject(fJetsName))) {
     fJets = new TClonesArray("AliEmcalJet");
     fJets->SetName(fJetsName);
-    ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", fJetsName.Data());
-    InputEvent()->AddObject(fJets);
+    AddJetCollection(fJets);
   }
   else {
     AliError(Form("%s: Object with name %s already in event! Returning", GetName(), fJetsName.Data()));
     return;
   }
 
+  // add the jet collections for the additional radii
+  if (fAdditionalRadii.GetSize() > 0) {
+    if (!fAdditionalJets) fAdditionalJets = new TObjArray(fAdditionalRadii.GetSize());
+    for (Int_t ir = 0; ir < fAdditionalRadii.GetSize(); ir++) {
+      TString jetsName = AliJetContainer::GenerateJetName(fJetType, fJetAlgo, fRecombScheme, fAdditionalRadii[ir], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+      if (InputEvent()->FindListObject(jetsName)) {
+        AliError(Form("%s: Object with name %s already in event! Jets with R = %.2f will not be stored", GetName(), jetsName.Data(), fAdditionalRadii[ir]));
+        continue;
+      }
+      TClonesArray *jets = new TClonesArray("AliEmcalJet");
+      jets->SetName(jetsName);
+      AddJetCollection(jets);
+      fAdditionalJets->AddAt(jets, ir);
+    }
+  }
+
   // setup fj wrapper
   fFastJetWrapper.SetAreaType(fastjet::active_area_explicit_ghosts);
   fFastJetWrapper.SetGhostArea(fGhostArea);
@@ -410,6 +551,8 @@ void AliEmcalJetTask::ExecOnce()
   fFastJetWrapper.SetAlgorithm(ConvertToFJAlgo(fJetAlgo));
   fFastJetWrapper.SetRecombScheme(ConvertToFJRecoScheme(fRecombScheme));
   fFastJetWrapper.SetMaxRap(1);
+  // in multi-radius mode the ghost grid is shared between the radii and the events
+  fFastJetWrapper.SetKeepAreaDefinition(fAdditionalRadii.GetSize() > 0);
  
 
   // setting legacy mode
@@ -425,6 +568,15 @@ void AliEmcalJetTask::ExecOnce()
   // containers' arrays are setup.
   fClusterContainerIndexMap.CopyMappingFrom(AliClusterContainer::GetEmcalContainerIndexMap(), fClusterCollArray);
   fParticleContainerIndexMap.CopyMappingFrom(AliParticleContainer::GetEmcalContainerIndexMap(), fParticleCollArray);
+
+  // Merged containers have no array of their own, the constituents are registered in the arrays of their components
+  TIter nextPartColl(&fParticleCollArray);
+  AliEmcalMergedParticleContainer* merged = 0;
+  TObject* obj = 0;
+  while ((obj = nextPartColl())) {
+    merged = dynamic_cast<AliEmcalMergedParticleContainer*>(obj);
+    if (merged) fParticleContainerIndexMap.CopyMappingFrom(AliParticleContainer::GetEmcalContainerIndexMap(), merged->GetComponents());
+  }
 }
 
 /**
@@ -509,6 +661,8 @@ void AliEmcalJetTask::FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet:
         AliError(Form("Could not find track %d",tid));
         continue;
       }
+      AliEmcalMergedParticleContainer* merged = dynamic_cast<AliEmcalMergedParticleContainer*>(partCont);
+      if (merged) partCont = merged->GetComponentFromIndex(tid, tid);
       if(fFillConstituents){
         jet->AddParticleConstituent(t, partCont->GetIsEmbedding(), fParticleContainerIndexMap.GlobalIndexFromLocalIndex(partCont, tid));
       }
@@ -9,6 +9,7 @@ class TObjArray;
 class AliVEvent;
 class AliEmcalJetUtility;
 
+#include <TArrayD.h>
 #include <AliLog.h>
 
 #include "AliAnalysisTaskEmcal.h"
@@ -44,6 +45,13 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet radii can be added via AddJetRadius(Double_t). In this case the input vectors
+ * are filled only once per event and the jet finding is repeated for each radius on the same
+ * input, reusing the FastJet area definition (ghost grid). The jets for each additional radius are
+ * stored in a separate collection in the event, named according to AliJetContainer::GenerateJetName,
+ * so that they can be connected to AliJetContainer objects in the same way as the main collection.
+ * Jet utilities are only executed for the main jet radius.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -87,6 +95,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetPhiRange(Double_t pmi, Double_t pma);
 
   AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility);
+  void                   AddJetRadius(Double_t r);
 
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
@@ -107,6 +116,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  Int_t                  GetNAdditionalRadii()      const { return fAdditionalRadii.GetSize(); }
+  Double_t               GetAdditionalRadius(Int_t i) const { return fAdditionalRadii[i]; }
+  TClonesArray*          GetAdditionalJets(Int_t i) const;
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
@@ -128,6 +140,17 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
    */
   void                   SetFillJetConsituents(Bool_t doFill) { fFillConstituents = doFill; }
 
+  /**
+   * @brief Switch for storing the constituent indices of the jets in a shared per-event buffer
+   *
+   * The indices are packed into an AliEmcalJetConstituentIndexBuffer added to the event
+   * with the name AliEmcalJetConstituentIndexBuffer::GetBufferName(jetsName), which needs to
+   * be written together with the jet collection. The jets then only store an offset into the buffer.
+   *
+   * @param doPack Switch for packing the jet constituent indices
+   */
+  void                   SetPackConstituents(Bool_t doPack) { if (IsLocked()) return; fPackConstituents = doPack; }
+
   static AliEmcalJetTask* AddTaskEmcalJet(
       const TString nTracks                      = "usedefault",
       const TString nClusters                    = "usedefault",
@@ -153,13 +176,17 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   FillJetBranch(TClonesArray *jets, Double_t radius, Bool_t doUtilities);
+  void                   FindAdditionalJets();
+  AliEmcalJetConstituentIndexBuffer* GetConstituentIndexBuffer(const TClonesArray *jets) const;
+  void                   AddJetCollection(TClonesArray *jets);
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
   void                   PrepareUtilities();
   void                   ExecuteUtilities(AliEmcalJet* jet, Int_t ij);
   void                   TerminateUtilities();
-  Bool_t                 GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const;
+  Bool_t                 GetSortedArray(Int_t indexes[], const std::vector<fastjet::PseudoJet>& array) const;
   Bool_t                 IsJetInEmcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcal(Double_t eta, Double_t phi, Double_t r);
   Bool_t                 IsJetInDcalOnly(Double_t eta, Double_t phi, Double_t r);
@@ -183,6 +210,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; ///<tituent Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 ///< true if lock is set
   Bool_t	          fFillConstituents;		 ///< If true jet consituents will be filled to the AliEmcalJet
+  TArrayD                fAdditionalRadii;        ///< additional jet radii clustered on the same input (multi-radius mode)
+  Bool_t                 fPackConstituents;       ///< If true the jet constituent indices are packed in a shared per-event buffer
 
   TString                fJetsName;               //!<!name of jet collection
   Bool_t                 fIsInit;                 //!<!=true if already initialized
@@ -192,6 +221,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
 
   TClonesArray          *fJets;                   //!<!jet collection
+  TObjArray             *fAdditionalJets;         //!<!jet collections for the additional radii (not owned)
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
@@ -207,7 +237,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 26);
+  ClassDef(AliEmcalJetTask, 28);
   /// \endcond
 };
 #endif
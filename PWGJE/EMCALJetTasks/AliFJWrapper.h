@@ -23,6 +23,7 @@ class AliFJWrapper
   virtual const char *ClassName()                            const { return "AliFJWrapper";              }
   virtual void  Clear(const Option_t* /*opt*/ = "");
   virtual void  ClearMemory();
+  virtual void  ClearClusterSequence();
   virtual void  CopySettingsFrom (const AliFJWrapper& wrapper);
   virtual void  GetMedianAndSigma(Double_t& median, Double_t& sigma, Int_t remove = 0) const;
   fastjet::ClusterSequenceArea*           GetClusterSequence() const   { return fClustSeq;                 }
@@ -50,6 +51,7 @@ class AliFJWrapper
   virtual std::vector<double>             GetSubtractedJetsPts(Double_t median_pt = -1, Bool_t sorted = kFALSE);
   Bool_t                                  GetLegacyMode()            { return fLegacyMode; }
   Bool_t                                  GetDoFilterArea()          { return fDoFilterArea; }
+  Bool_t                                  GetKeepAreaDefinition()    { return fKeepAreaDef; }
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0, Int_t Measure=0, Double_t Beta_SD=0.0, Double_t ZCut=0.1, Int_t SoftDropOn=0);
 #ifdef FASTJET_VERSION
@@ -143,6 +145,8 @@ class AliFJWrapper
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fMaxDelR = r;}
   void SetAlpha(Double_t a)  {fAlpha = a;}
+  /// Keep the area definition (ghost grid) alive in Clear(), to be reused in the next Run(). Area settings must not change afterwards.
+  void SetKeepAreaDefinition(Bool_t b) { fKeepAreaDef = b; }
 
  protected:
   TString                                fName;               //!
@@ -235,6 +239,7 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
   std::vector<double>                      fGRDenominatorSub; //!
+  Bool_t                                   fKeepAreaDef;      //!
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
 
@@ -339,6 +344,7 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fGRDenominator()
   , fGRNumeratorSub()
   , fGRDenominatorSub()
+  , fKeepAreaDef(kFALSE)
 {
   // Constructor.
 }
@@ -357,13 +363,21 @@ void AliFJWrapper::ClearMemory()
   if (fAreaDef)           { delete fAreaDef;           fAreaDef         = NULL; }
   if (fVorAreaSpec)       { delete fVorAreaSpec;       fVorAreaSpec     = NULL; }
   if (fGhostedAreaSpec)   { delete fGhostedAreaSpec;   fGhostedAreaSpec = NULL; }
+  ClearClusterSequence();
+}
+
+//_________________________________________________________________________________________________
+void AliFJWrapper::ClearClusterSequence()
+{
+  // Delete the clustering output and everything depending on R,
+  // keeping the area definition (ghost grid).
+  if (fClustSeq)          { delete fClustSeq;          fClustSeq        = NULL; }
+  if (fClustSeqES)        { delete fClustSeqES;        fClustSeqES      = NULL; }
+  if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA      = NULL; }
+  if (fClustSeqActGhosts) { delete fClustSeqActGhosts; fClustSeqActGhosts = NULL; }
   if (fJetDef)            { delete fJetDef;            fJetDef          = NULL; }
   if (fPlugin)            { delete fPlugin;            fPlugin          = NULL; }
   if (fRange)             { delete fRange;             fRange           = NULL; }
-  if (fClustSeq)          { delete fClustSeq;          fClustSeq        = NULL; }
-  if (fClustSeqES)          { delete fClustSeqES;        fClustSeqES        = NULL; }
-  if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA        = NULL; }
-  if (fClustSeqActGhosts) { delete fClustSeqActGhosts; fClustSeqActGhosts = NULL; }
   #ifdef FASTJET_VERSION
   if (fBkrdEstimator)          { delete fBkrdEstimator; fBkrdEstimator = NULL; }
   if (fGenSubtractor)          { delete fGenSubtractor; fGenSubtractor = NULL; }
@@ -412,8 +426,10 @@ void AliFJWrapper::Clear(const Option_t */*opt*/)
   fInputGhosts.clear();
   fMedUsedForBgSub = 0;
 
-  // for the moment brute force delete everything
-  ClearMemory();
+  // the area definition does not depend on the event and can be kept on request,
+  // otherwise brute force delete everything
+  if (fKeepAreaDef) ClearClusterSequence();
+  else              ClearMemory();
 }
 
 //_________________________________________________________________________________________________
@@ -695,8 +711,14 @@ void AliFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t re
 Int_t AliFJWrapper::Run()
 {
   // Run the actual jet finder.
+  // Can be called several times on the same input vectors
+  // (e.g. after changing R), the area definition is reused.
+
+  ClearClusterSequence();
 
-  if (fAreaType == fj::voronoi_area) {
+  if (fAreaDef) {
+    // reuse the area definition (ghost grid) from a previous run
+  } else if (fAreaType == fj::voronoi_area) {
     // Rfact - check dependence - default is 1.
     // NOTE: hardcoded variable!
     fVorAreaSpec = new fj::VoronoiAreaSpec(1.);
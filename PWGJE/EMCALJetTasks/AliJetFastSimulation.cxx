@@ -7,6 +7,8 @@
 
 #include "AliJetFastSimulation.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TFolder.h>
 #include <TLorentzVector.h>
@@ -59,11 +61,20 @@ AliAnalysisTaskEmcal("AliJetFastSimulation",kTRUE),
   fUseTrEfficiencyFromOADB(kFALSE),
   fPathTrPtResolution(""),
   fPathTrEfficiency(""),
+  fNReplicas(0),
+  fReplicasOut(),
+  fPackedTracks(),
+  fPackedPt(),
+  fPackedEffSum(),
+  fPackedEffLimits(),
+  fPackedCat(),
   fHistPtDet(0),
   fh2PtGenPtSmeared(0),
   fp1Efficiency(0),
   fp1PtResolution(0)
 {
+  memset(fMomResFitPar, 0, sizeof(fMomResFitPar));
+  memset(fHasMomResFit, 0, sizeof(fHasMomResFit));
   // Default constructor.
   SetMakeGeneralHistograms(kTRUE);
 }
@@ -93,11 +104,20 @@ AliJetFastSimulation::AliJetFastSimulation(const char *name) :
   fUseTrEfficiencyFromOADB(kFALSE),
   fPathTrPtResolution(""),
   fPathTrEfficiency(""),
+  fNReplicas(0),
+  fReplicasOut(),
+  fPackedTracks(),
+  fPackedPt(),
+  fPackedEffSum(),
+  fPackedEffLimits(),
+  fPackedCat(),
   fHistPtDet(0),
   fh2PtGenPtSmeared(0),
   fp1Efficiency(0),
   fp1PtResolution(0)
 {
+  memset(fMomResFitPar, 0, sizeof(fMomResFitPar));
+  memset(fHasMomResFit, 0, sizeof(fHasMomResFit));
   // Standard constructor.
   SetMakeGeneralHistograms(kTRUE);
 }
@@ -129,7 +149,21 @@ void AliJetFastSimulation::ExecOnce()
     else {
       InputEvent()->AddObject(fTracksOut);
     }
+
+    for (Int_t i = 1; i <= fNReplicas; ++i) {
+      TString replicaName = TString::Format("%s_Replica%d", fTracksOutName.Data(), i);
+      if (InputEvent()->FindListObject(replicaName)) {
+        AliFatal(Form("%s: Collection %s is already present in the event!", GetName(), replicaName.Data()));
+        return;
+      }
+      TClonesArray *replica = new TClonesArray("AliPicoTrack");
+      replica->SetName(replicaName);
+      InputEvent()->AddObject(replica);
+      fReplicasOut.push_back(replica);
+    }
   }
+
+  BuildResponseTables();
 }
 //________________________________________________________________________
 void AliJetFastSimulation::LocalInit() {
@@ -192,7 +226,6 @@ Bool_t AliJetFastSimulation::Run()
       fUseDiceEfficiency = 0;
   }
 
-  fTracksOut->Delete();
   SimulateTracks();
   return kTRUE;
 }
@@ -201,127 +234,182 @@ Bool_t AliJetFastSimulation::Run()
 void AliJetFastSimulation::SimulateTracks()
 {
   //Apply toy detector simulation to tracks
-  Int_t it = 0;
+  //The efficiencies are looked up once per event, the replicas only repeat the dicing and smearing
+  PackInputTracks();
+  SmearTracks(fTracksOut, kTRUE);
+  for (std::vector<TClonesArray*>::iterator replica = fReplicasOut.begin(); replica != fReplicasOut.end(); ++replica)
+    SmearTracks(*replica, kFALSE);
+}
+
+//________________________________________________________________________
+void AliJetFastSimulation::PackInputTracks()
+{
+  // Collect the input tracks with their efficiencies and the hybrid
+  // category ordering used to select the momentum resolution
+  fPackedTracks.clear();
+  fPackedPt.clear();
+  fPackedEffSum.clear();
+  fPackedEffLimits.clear();
+  fPackedCat.clear();
+
   const Int_t nTracks = fTracks->GetEntriesFast();
-   for (Int_t i = 0; i < nTracks; ++i) {
+  for (Int_t i = 0; i < nTracks; ++i) {
     AliPicoTrack *picotrack = static_cast<AliPicoTrack*>(fTracks->At(i));
     if (!picotrack)
       continue;
 
-    Bool_t accept = kTRUE;
+    Double_t pT = picotrack->Pt();
     Double_t eff[3] = {0};
-    Double_t rnd = fRandom->Uniform(1.);  
-    if(fUseDiceEfficiency) accept = DiceEfficiency(picotrack,eff,rnd);
-    if(!accept) continue;
+    Double_t sumEff = 0.;
+    Double_t pTdice = 0.;
+    if(fUseDiceEfficiency) {
+      if(fEfficiencyFixed<1.)
+        sumEff = fEfficiencyFixed;
+      else {
+        pTdice = pT;
+        Double_t pTtmp = pT;
+        if(pT>10.) pTtmp = 10.;
+        for(Int_t icat = 0; icat < 3; icat++) {
+          if(!fEffTable[icat].fContent.empty())
+            eff[icat] = fEffTable[icat].fContent[FindTableBin(fEffTable[icat], pTtmp)];
+        }
+        sumEff = eff[0]+eff[1]+eff[2];
+      }
+      if(fUncertEfficiency!=1) sumEff=sumEff+fUncertEfficiency;
+      fp1Efficiency->Fill(pT,sumEff);
+      // tracks below the minimum pt are always kept
+      if(pTdice <= fDiceEfficiencyMinPt) sumEff = 2.;
+    } else {
+      sumEff = 2.;
+    }
+
+    //Sort efficiencies from large to small
+    Int_t cat[3] = {0};
+    TMath::Sort(3,eff,cat);
 
+    fPackedTracks.push_back(picotrack);
+    fPackedPt.push_back(pT);
+    fPackedEffSum.push_back(sumEff);
+    fPackedEffLimits.push_back(eff[cat[2]]);
+    fPackedEffLimits.push_back(eff[cat[2]]+eff[cat[1]]);
+    fPackedCat.insert(fPackedCat.end(), cat, cat + 3);
+  }
+}
+
+//________________________________________________________________________
+void AliJetFastSimulation::SmearTracks(TClonesArray *tracksOut, Bool_t fillQA)
+{
+  // Dice the efficiency and smear the momentum of all the packed tracks.
+  // The tracks are constructed in place, reusing the objects of the previous event.
+  tracksOut->Clear();
+  Int_t it = 0;
+  const Int_t nTracks = fPackedTracks.size();
+  for (Int_t i = 0; i < nTracks; ++i) {
+    Double_t rnd = fRandom->Uniform(1.);
+    if(rnd>fPackedEffSum[i]) continue;
+
+    AliPicoTrack *vp = fPackedTracks[i];
     AliPicoTrack *track = NULL;
     if(fUseTrPtResolutionSmearing) {
-      track = SmearPt(picotrack,eff,rnd);
-      (*fTracksOut)[it] = track;
+      //Select hybrid track category
+      const Int_t *cat = &fPackedCat[3*i];
+      Double_t pT = fPackedPt[i], smear = 1.;
+      if(rnd<=fPackedEffLimits[2*i])
+        smear = GetMomentumSmearing(cat[2],pT);
+      else if(rnd<=fPackedEffLimits[2*i+1])
+        smear = GetMomentumSmearing(cat[1],pT);
+      else
+        smear = GetMomentumSmearing(cat[0],pT);
+
+      Double_t sigma = pT*smear;
+      Double_t pTrec = fRandom->Gaus(pT,sigma);
+      if(fillQA) {
+        fp1PtResolution->Fill(pT,smear);
+        fh2PtGenPtSmeared->Fill(pT,pTrec);
+      }
+
+      track = new ((*tracksOut)[it]) AliPicoTrack(pTrec,
+                                                  vp->Eta(),
+                                                  vp->Phi(),
+                                                  vp->Charge(),
+                                                  vp->GetLabel(),
+                                                  AliPicoTrack::GetTrackType(vp),
+                                                  vp->GetTrackEtaOnEMCal(),
+                                                  vp->GetTrackPhiOnEMCal(),
+                                                  vp->GetTrackPtOnEMCal(),
+                                                  vp->IsEMCAL(),
+                                                  0.13957); //assume pion mass
     } else
-      track = new ((*fTracksOut)[it]) AliPicoTrack(*picotrack);
+      track = new ((*tracksOut)[it]) AliPicoTrack(*vp);
 
     track->SetBit(TObject::kBitMask,1);
-    fHistPtDet->Fill(track->Pt());
+    if(fillQA) fHistPtDet->Fill(track->Pt());
     it++;
-   }
-}
-
-//________________________________________________________________________
-Bool_t AliJetFastSimulation::DiceEfficiency(AliPicoTrack *vp, Double_t eff[3], Double_t rnd)
-{
-  // Dice to decide if particle is kept or not - toy  model for efficiency
-  //
-  Double_t sumEff = 0.;
-  Double_t pT = 0.;
- 
-  if(fEfficiencyFixed<1.)
-    sumEff = fEfficiencyFixed;
-  else {
-    pT = vp->Pt();
-    Double_t pTtmp = pT;
-    if(pT>10.) pTtmp = 10.;
-    if(fhEffH1) eff[0] = fhEffH1->GetBinContent(fhEffH1->FindBin(pTtmp));
-    if(fhEffH2) eff[1] = fhEffH2->GetBinContent(fhEffH2->FindBin(pTtmp));
-    if(fhEffH3) eff[2] = fhEffH3->GetBinContent(fhEffH3->FindBin(pTtmp));
-
-    sumEff = eff[0]+eff[1]+eff[2];
   }
-  if(fUncertEfficiency!=1) sumEff=sumEff+fUncertEfficiency;
-  fp1Efficiency->Fill(vp->Pt(),sumEff);
-  if(rnd>sumEff && pT > fDiceEfficiencyMinPt) return kFALSE;
-  return kTRUE;
-}
-
-//________________________________________________________________________
-AliPicoTrack* AliJetFastSimulation::SmearPt(AliPicoTrack *vp, Double_t eff[3], Double_t rnd)
-{
-  //Smear momentum of generated particle
-  Double_t smear = 1.;
-  Double_t  pT = vp->Pt();
-  //Select hybrid track category
-
-  //Sort efficiencies from large to small
-  Int_t cat[3] = {0};
-  TMath::Sort(3,eff,cat);
-  if(rnd<=eff[cat[2]])
-    smear = GetMomentumSmearing(cat[2],pT);
-  else if(rnd<=(eff[cat[2]]+eff[cat[1]]))
-    smear = GetMomentumSmearing(cat[1],pT);
-  else
-    smear = GetMomentumSmearing(cat[0],pT);
-  
-  fp1PtResolution->Fill(vp->Pt(),smear);
-
-  Double_t sigma = vp->Pt()*smear;
-  Double_t pTrec = fRandom->Gaus(vp->Pt(),sigma);
-  fh2PtGenPtSmeared->Fill(vp->Pt(),pTrec);
-
-  AliPicoTrack *picotrack = new AliPicoTrack(pTrec,
-					     vp->Eta(),
-					     vp->Phi(),
-					     vp->Charge(),
-					     vp->GetLabel(),
-					     AliPicoTrack::GetTrackType(vp),
-					     vp->GetTrackEtaOnEMCal(),
-					     vp->GetTrackPhiOnEMCal(),
-					     vp->GetTrackPtOnEMCal(),
-					     vp->IsEMCAL(),
-					     0.13957); //assume pion mass
-    return picotrack;
 }
 
 //________________________________________________________________________
 Double_t AliJetFastSimulation::GetMomentumSmearing(Int_t cat, Double_t pt) {
 
   //
-  // Get smearing on generated momentum
+  // Get smearing on generated momentum from the tabulated resolution
   //
 
-  TProfile *fMomRes = 0x0;
-  if(cat==1 && fMomResH1) fMomRes = (TProfile*)fMomResH1->Clone("fMomRes");
-  if(cat==2 && fMomResH2) fMomRes = (TProfile*)fMomResH2->Clone("fMomRes");
-  if(cat==3 && fMomResH3) fMomRes = (TProfile*)fMomResH3->Clone("fMomRes");
-
-  if(!fMomRes)
+  if(cat<1 || cat>3 || fMomResTable[cat-1].fContent.empty())
     return 0.;
 
   Double_t smear = 0.;
   if(pt>20.) {
-    if(cat==1 && fMomResH1Fit) smear = fMomResH1Fit->Eval(pt);
-    if(cat==2 && fMomResH2Fit) smear = fMomResH2Fit->Eval(pt);
-    if(cat==3 && fMomResH3Fit) smear = fMomResH3Fit->Eval(pt);
+    if(fHasMomResFit[cat-1]) smear = fMomResFitPar[cat-1][0] + fMomResFitPar[cat-1][1]*pt;
   }
   else {
-    Int_t bin = fMomRes->FindBin(pt);
-    smear = fRandom->Gaus(fMomRes->GetBinContent(bin),fMomRes->GetBinError(bin));
+    const ResponseTable_t &table = fMomResTable[cat-1];
+    Int_t bin = FindTableBin(table, pt);
+    smear = fRandom->Gaus(table.fContent[bin],table.fError[bin]);
   }
-  
-  if(fMomRes) delete fMomRes;
 
   return smear;
 }
 
+//________________________________________________________________________
+void AliJetFastSimulation::BuildResponseTables() {
+  //
+  // Tabulate the efficiency and momentum resolution histograms and the resolution fits
+  //
+  TH1 *eff[3] = {fhEffH1, fhEffH2, fhEffH3};
+  TProfile *momRes[3] = {fMomResH1, fMomResH2, fMomResH3};
+  TF1 *momResFit[3] = {fMomResH1Fit, fMomResH2Fit, fMomResH3Fit};
+  for(Int_t icat = 0; icat < 3; icat++) {
+    TabulateHistogram(eff[icat], fEffTable[icat]);
+    TabulateHistogram(momRes[icat], fMomResTable[icat]);
+    fHasMomResFit[icat] = momResFit[icat] != 0;
+    if(fHasMomResFit[icat]) {
+      fMomResFitPar[icat][0] = momResFit[icat]->GetParameter(0);
+      fMomResFitPar[icat][1] = momResFit[icat]->GetParameter(1);
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliJetFastSimulation::TabulateHistogram(const TH1 *h, ResponseTable_t &table) {
+  table.fEdges.clear();
+  table.fContent.clear();
+  table.fError.clear();
+  if(!h) return;
+  const Int_t nbins = h->GetNbinsX();
+  for(Int_t ib = 1; ib <= nbins + 1; ib++) table.fEdges.push_back(h->GetXaxis()->GetBinLowEdge(ib));
+  for(Int_t ib = 0; ib <= nbins + 1; ib++) {
+    table.fContent.push_back(h->GetBinContent(ib));
+    table.fError.push_back(h->GetBinError(ib));
+  }
+}
+
+//________________________________________________________________________
+Int_t AliJetFastSimulation::FindTableBin(const ResponseTable_t &table, Double_t x) {
+  // Same convention as TAxis::FindFixBin: 0 underflow, nbins+1 overflow
+  return std::upper_bound(table.fEdges.begin(), table.fEdges.end(), x) - table.fEdges.begin();
+}
+
 //________________________________________________________________________
 void AliJetFastSimulation::LoadTrPtResolutionRootFileFromOADB() {
 
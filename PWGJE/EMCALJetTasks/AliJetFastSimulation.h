@@ -3,6 +3,8 @@
 
 // $Id$
 
+#include <vector>
+
 class TClonesArray;
 class TRandom3;
 class AliVParticle;
@@ -29,14 +31,25 @@ class AliJetFastSimulation : public AliAnalysisTaskEmcal {
   void                   SetDiceEfficiency(Int_t b)                                 { fUseDiceEfficiency         = b ;}
   void                   SetDiceEfficiencyMinPt(Double_t pt)                        { fDiceEfficiencyMinPt       = pt;}
   void                   SetUncertEfficiency(Double_t uncerteff)                   { fUncertEfficiency           =uncerteff;}      
+  void                   SetNReplicas(Int_t n)                                      { fNReplicas                 = n ;}
  protected:
+  /// Bin contents of a response histogram, looked up without the histogram
+  struct ResponseTable_t {
+    std::vector<Double_t> fEdges;              ///< low edges of the bins and upper edge of the last bin
+    std::vector<Double_t> fContent;            ///< bin contents including underflow and overflow
+    std::vector<Double_t> fError;              ///< bin errors including underflow and overflow
+  };
+
   void                   ExecOnce();
   Bool_t                 Run();
 
   void                   SimulateTracks();
-  Bool_t                 DiceEfficiency(AliPicoTrack *vp, Double_t eff[3], Double_t rnd);
-  AliPicoTrack          *SmearPt(AliPicoTrack *vp, Double_t eff[3], Double_t rnd);
+  void                   BuildResponseTables();
+  void                   PackInputTracks();
+  void                   SmearTracks(TClonesArray *tracksOut, Bool_t fillQA);
   Double_t               GetMomentumSmearing(Int_t cat, Double_t pt);
+  static void            TabulateHistogram(const TH1 *h, ResponseTable_t &table);
+  static Int_t           FindTableBin(const ResponseTable_t &table, Double_t x);
   void                   FitMomentumResolution();
   void                   LoadTrEfficiencyRootFileFromOADB();
   void                   LoadTrPtResolutionRootFileFromOADB();
@@ -65,6 +78,18 @@ class AliJetFastSimulation : public AliAnalysisTaskEmcal {
   Bool_t    fUseTrEfficiencyFromOADB;          // Load tracking efficiency root file from OADB path
   TString   fPathTrPtResolution;               // OADB path to root file
   TString   fPathTrEfficiency;                 // OADB path to root file
+  Int_t     fNReplicas;                        // number of additional output collections smeared independently (<name>_Replica<i>)
+
+  std::vector<TClonesArray*> fReplicasOut;     //! replica output collections
+  ResponseTable_t fEffTable[3];                //! tabulated efficiency per hybrid category
+  ResponseTable_t fMomResTable[3];             //! tabulated momentum resolution per hybrid category
+  Double_t  fMomResFitPar[3][2];               //! parameters of the linear momentum resolution fits
+  Bool_t    fHasMomResFit[3];                  //! momentum resolution fit available
+  std::vector<AliPicoTrack*> fPackedTracks;    //! input tracks of the event
+  std::vector<Double_t> fPackedPt;             //! pt of the input tracks
+  std::vector<Double_t> fPackedEffSum;         //! efficiency of the input tracks
+  std::vector<Double_t> fPackedEffLimits;      //! cumulated category efficiencies (2 per track)
+  std::vector<Int_t>    fPackedCat;            //! hybrid categories sorted by efficiency (3 per track)
 
   //Output objects
   TH1F     *fHistPtDet;                        //!pT spectrum of detector level particles
@@ -77,6 +102,6 @@ class AliJetFastSimulation : public AliAnalysisTaskEmcal {
   AliJetFastSimulation(const AliJetFastSimulation&);            // not implemented
   AliJetFastSimulation &operator=(const AliJetFastSimulation&); // not implemented
 
-  ClassDef(AliJetFastSimulation, 1) // Jet fast simulation task
+  ClassDef(AliJetFastSimulation, 2) // Jet fast simulation task
 };
 #endif
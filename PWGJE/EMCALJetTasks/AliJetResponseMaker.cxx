@@ -46,6 +46,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseMatchingEngine(kFALSE),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -135,6 +136,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseMatchingEngine(kFALSE),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -1423,6 +1425,11 @@ void AliJetResponseMaker::DoJetLoop()
 
   if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
 
+  if (fUseMatchingEngine && fMatching != kNoMatching) {
+    DoJetLoopWithEngine();
+    return;
+  }
+
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
@@ -1442,6 +1449,202 @@ void AliJetResponseMaker::DoJetLoop()
   } // jet1 loop
 }
 
+//________________________________________________________________________
+void AliJetResponseMaker::DoJetLoopWithEngine()
+{
+  // Do the jet loop, comparing each jet 1 only with the jets 2 it can be matched to.
+  // Geometrical matching: the jets 2 within the largest matching distance.
+  // MC label and same collections matching: the jets 2 sharing at least one constituent,
+  // if both matching parameters are below 1 (otherwise jets without common constituents, with
+  // matching level 1, can be matched as well and all jets 2 are compared).
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  Double_t maxDistance = TMath::Max(fMatchingPar1, fMatchingPar2);
+  Bool_t useConstituents = fMatching != kGeometrical && maxDistance < 1;
+  // with cells two clusters can share energy without having the same index
+  if (fMatching == kSameCollections && fUseCellsToMatch && fCaloCells) useConstituents = kFALSE;
+
+  AliEmcalJet* jet1 = 0;
+  AliEmcalJet* jet2 = 0;
+
+  fMatchingEngine.Reset(maxDistance);
+  jets2->ResetCurrentID();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    Int_t ijet2 = fMatchingEngine.AddJet(jet2);
+    if (fMatching == kGeometrical) continue;
+    for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
+      AliVParticle *part2 = jet2->Track(iTrack2);
+      fMatchingEngine.AddConstituent(ijet2, jet2->TrackAt(iTrack2), part2 ? part2->Pt() : 0.);
+    }
+    if (fMatching == kSameCollections) {
+      // clusters with negative keys
+      for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) fMatchingEngine.AddConstituent(ijet2, -1 - jet2->ClusterAt(iClus2), 0.);
+    }
+  }
+  fMatchingEngine.Build();
+
+  jets1->ResetCurrentID();
+  while ((jet1 = jets1->GetNextJet())) {
+    jet1->ResetMatching();
+
+    if (jet1->MCPt() < fMinJetMCPt) continue;
+
+    if (fMatching == kMCLabel) {
+      PrepareMCLabelMatching(jet1);
+    }
+    else if (fMatching == kSameCollections) {
+      fJet1Keys.clear();
+      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) fJet1Keys.push_back(jet1->TrackAt(iTrack1));
+      for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) fJet1Keys.push_back(-1 - jet1->ClusterAt(iClus1));
+    }
+
+    if (fMatching == kGeometrical) {
+      fMatchingEngine.FindGeometricalCandidates(jet1, maxDistance, fMatchingCandidates);
+    }
+    else if (useConstituents) {
+      fMatchingEngine.FindConstituentCandidates(fJet1Keys, fMatchingCandidates);
+    }
+    else {
+      fMatchingCandidates.resize(fMatchingEngine.GetNJets());
+      for (Int_t ijet2 = 0; ijet2 < fMatchingEngine.GetNJets(); ijet2++) fMatchingCandidates[ijet2] = ijet2;
+    }
+
+    for (UInt_t icand = 0; icand < fMatchingCandidates.size(); icand++) {
+      jet2 = fMatchingEngine.GetJet(fMatchingCandidates[icand]);
+      if (fMatching == kMCLabel) {
+        Double_t d1 = -1, d2 = -1;
+        GetMCLabelMatchingLevelFromEngine(jet1, fMatchingCandidates[icand], d1, d2);
+        SetClosestJets(jet1, jet2, d1, d2);
+      }
+      else {
+        SetMatchingLevel(jet1, jet2, fMatching);
+      }
+    } // jet2 loop
+  } // jet1 loop
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::PrepareMCLabelMatching(AliEmcalJet *jet1)
+{
+  // Collect the constituents of jet 1 associated with a MC particle, as in GetMCLabelMatchingLevel(),
+  // so that the matching level with each jet 2 is obtained from the constituent table of the engine.
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+
+  fJet1Keys.clear();
+  fJet1KeyPt.clear();
+  fJet1KeyWeights.clear();
+  fJet1MCPt = jet1->Pt();
+
+  for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+    AliVParticle *track = jet1->Track(iTrack);
+    if (!track) {
+      AliWarning(Form("Could not find track %d!", iTrack));
+      continue;
+    }
+    Int_t MClabel = TMath::Abs(track->GetLabel());
+    MClabel -= fMCLabelShift;
+    if (MClabel == 0) {
+      // this is not a MC particle; remove it completely
+      if (tracks1 && tracks1->GetArray()) fJet1MCPt -= track->Pt();
+      continue;
+    }
+    if (MClabel < 0 || !tracks2) continue;
+
+    Int_t index = tracks2->GetIndexFromLabel(MClabel);
+    if (index < 0) continue;
+
+    fJet1Keys.push_back(index);
+    fJet1KeyPt.push_back(track->Pt());
+    fJet1KeyWeights.push_back(1.);
+  }
+
+  for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+    AliVCluster *clus = jet1->Cluster(iClus);
+    if (!clus) {
+      AliWarning(Form("Could not find cluster %d!", iClus));
+      continue;
+    }
+    AliTLorentzVector part;
+    clus->GetMomentum(part, fVertex);
+
+    if (fUseCellsToMatch && fCaloCells) {
+      for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+        Int_t cellId = clus->GetCellAbsId(iCell);
+        Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
+
+        Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
+        MClabel -= fMCLabelShift;
+        if (MClabel == 0) {
+          fJet1MCPt -= part.Pt() * cellFrac;
+          continue;
+        }
+        if (MClabel < 0 || !tracks2) continue;
+
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) continue;
+
+        fJet1Keys.push_back(index);
+        fJet1KeyPt.push_back(part.Pt() * cellFrac);
+        fJet1KeyWeights.push_back(cellFrac);
+      }
+    }
+    else {
+      Int_t MClabel = TMath::Abs(clus->GetLabel());
+      MClabel -= fMCLabelShift;
+      if (MClabel == 0) {
+        fJet1MCPt -= part.Pt();
+        continue;
+      }
+      if (MClabel < 0 || !tracks2) continue;
+
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index < 0) continue;
+
+      fJet1Keys.push_back(index);
+      fJet1KeyPt.push_back(part.Pt());
+      fJet1KeyWeights.push_back(1.);
+    }
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::GetMCLabelMatchingLevelFromEngine(AliEmcalJet *jet1, Int_t ijet2, Double_t &d1, Double_t &d2) const
+{
+  // Same matching level as GetMCLabelMatchingLevel(), for the jet 1 prepared with PrepareMCLabelMatching().
+
+  AliEmcalJet *jet2 = fMatchingEngine.GetJet(ijet2);
+
+  Double_t shared1 = 0, shared2 = 0;
+  fMatchingEngine.GetSharedPt(ijet2, fJet1Keys, fJet1KeyPt, fJet1KeyWeights, shared1, shared2);
+
+  d1 = fJet1MCPt - shared1;
+  d2 = jet2->Pt() - shared2;
+
+  if (d1 < 0)
+    d1 = 0;
+
+  if (d2 < 0)
+    d2 = 0;
+
+  if (fJet1MCPt < 1)
+    d1 = -1;
+  else
+    d1 /= fJet1MCPt;
+
+  if (jet2->Pt() < 1)
+    d2 = -1;
+  else
+    d2 /= jet2->Pt();
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -1886,6 +2089,12 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
+  SetClosestJets(jet1, jet2, d1, d2);
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::SetClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2)
+{
   if (d1 >= 0) {
 
     if (d1 < jet1->ClosestJetDistance()) {
@@ -27,6 +27,10 @@ class AliNamedArrayI;
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <vector>
+#include "AliEmcalJetMatchingEngine.h"
+#endif
 
 class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  public:
@@ -47,6 +51,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
+  void                        SetUseMatchingEngine(Bool_t b=kTRUE)                            { fUseMatchingEngine = b         ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
   void                        SetDeltaEtaDeltaPhiAxis(Int_t b)                                { fDeltaEtaDeltaPhiAxis= b       ; }
@@ -93,10 +98,14 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  protected:
   void                        ExecOnce();
   void                        DoJetLoop();
+  void                        DoJetLoopWithEngine();
   Bool_t                      FillHistograms();
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
   void                        SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching);
+  void                        SetClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2);
+  void                        PrepareMCLabelMatching(AliEmcalJet *jet1);
+  void                        GetMCLabelMatchingLevelFromEngine(AliEmcalJet *jet1, Int_t ijet2, Double_t &d1, Double_t &d2) const;
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
@@ -111,6 +120,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
+  Bool_t                      fUseMatchingEngine;                      // compare each jet 1 only with the jets 2 it can be matched to
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
   Int_t                       fDeltaPtAxis;                            // add delta pt axis in THnSparse (default=0)
@@ -200,10 +210,19 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   TH2                        *fHistDeltaMCPtvsDeltaArea;               //!jet 1 MC pt - jet2 pt vs delta area
   TH2                        *fHistJet1MCPtvsJet2Pt;                   //!correlation jet 1 MC pt vs jet 2 pt
 
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  AliEmcalJetMatchingEngine   fMatchingEngine;                         //!jets 2 indexed for the matching
+  std::vector<Int_t>          fMatchingCandidates;                     //!candidate jets 2 of the current jet 1
+  std::vector<Int_t>          fJet1Keys;                               //!particle indices (in the container of jets 2) of the constituents of the current jet 1
+  std::vector<Double_t>       fJet1KeyPt;                              //!pt of the constituents of the current jet 1
+  std::vector<Double_t>       fJet1KeyWeights;                         //!cell fractions of the constituents of the current jet 1
+  Double_t                    fJet1MCPt;                               //!pt of the current jet 1 from MC particles
+#endif
+
  private:
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
@@ -13,6 +13,7 @@
 #pragma link C++ class AliAnalysisTaskRhoMass+;
 #pragma link C++ class AliAnalysisTaskRhoMassBase+;
 #pragma link C++ class AliAnalysisTaskRhoSparse+;
+#pragma link C++ class AliAnalysisTaskRhoCombined+;
 #pragma link C++ class AliAnalysisTaskRhoMassSparse+;
 #pragma link C++ class AliAnalysisTaskLocalRho+;
 #pragma link C++ class AliAnalysisTaskRhoBaseDev+;
@@ -20,6 +21,7 @@
 #pragma link C++ class AliAnalysisTaskRhoTransDev+;
 #pragma link C++ class AliAnalysisTaskDeltaPt+;
 #pragma link C++ class AliAnalysisTaskScale+;
+#pragma link C++ class AliEmcalConstituentSubtractionTask+;
 #pragma link C++ class AliEmcalJetByJetCorrection+;
 #pragma link C++ class AliEmcalPicoTrackInGridMaker+;
 #pragma link C++ class AliJetEmbeddingTask+;
@@ -242,6 +244,7 @@
 #pragma link C++ class EMCalTriggerPtAnalysis::AliAnalysisTaskTracksInJet+;
 #pragma link C++ class HighPtTracks::AliHighPtReconstructionEfficiency+;
 #pragma link C++ class EmcalTriggerJets::AliAnalysisTaskEmcalJetSubstructureTree+;
+#pragma link C++ class EmcalTriggerJets::AliJetSubstructureCompactReader+;
 #pragma link C++ class AliAnalysisTaskJetSubstructure+;
 #pragma link C++ class AliAnalysisTaskSoftDrop+;
 #pragma link C++ class AliAnalysisTaskSoftDropResponse+;
@@ -32,13 +32,14 @@
 
 #include <fastjet/ClusterSequence.hh>
 #include <fastjet/contrib/Nsubjettiness.hh>
-#include <fastjet/contrib/SoftDrop.hh>
 
+#include <TBranch.h>
 #include <THistManager.h>
 #include <TLinearBinning.h>
 #include <TLorentzVector.h>
 #include <TMath.h>
 #include <TString.h>
+#include <TVector2.h>
 #include <TVector3.h>
 
 #include "AliAODEvent.h"
@@ -51,6 +52,7 @@
 #include "AliJetContainer.h"
 #include "AliEmcalAnalysisFactory.h"
 #include "AliEmcalDownscaleFactorsOCDB.h"
+#include "AliEmcalJetDeclusteringTree.h"
 #include "AliEmcalJet.h"
 #include "AliEmcalList.h"
 #include "AliEmcalTriggerDecisionContainer.h"
@@ -89,9 +91,18 @@ AliAnalysisTaskEmcalJetSubstructureTree::AliAnalysisTaskEmcalJetSubstructureTree
     fFillMass(true),
     fFillSoftDrop(true),
     fFillNSub(true),
-    fFillStructGlob(true)
+    fFillStructGlob(true),
+    fCompactOutput(false),
+    fFillConstituents(false),
+    fCompactNJets(0),
+    fCompactFloatData(),
+    fCompactCountData(),
+    fCompactBranches()
 {
   memset(fJetTreeData, 0, sizeof(Double_t) * kTNVar);
+  memset(fCompactEventData, 0, sizeof(Float_t) * kTNVar);
+  memset(fCompactNConst, 0, sizeof(Int_t) * 2);
+  memset(fCompactConstBranches, 0, sizeof(TBranch *) * 8);
 }
 
 AliAnalysisTaskEmcalJetSubstructureTree::AliAnalysisTaskEmcalJetSubstructureTree(const char *name) :
@@ -110,9 +121,18 @@ AliAnalysisTaskEmcalJetSubstructureTree::AliAnalysisTaskEmcalJetSubstructureTree
     fFillMass(true),
     fFillSoftDrop(true),
     fFillNSub(true),
-    fFillStructGlob(true)
+    fFillStructGlob(true),
+    fCompactOutput(false),
+    fFillConstituents(false),
+    fCompactNJets(0),
+    fCompactFloatData(),
+    fCompactCountData(),
+    fCompactBranches()
 {
   memset(fJetTreeData, 0, sizeof(Double_t) * kTNVar);
+  memset(fCompactEventData, 0, sizeof(Float_t) * kTNVar);
+  memset(fCompactNConst, 0, sizeof(Int_t) * 2);
+  memset(fCompactConstBranches, 0, sizeof(TBranch *) * 8);
   DefineOutput(2, TTree::Class());
 }
 
@@ -196,27 +216,151 @@ void AliAnalysisTaskEmcalJetSubstructureTree::UserCreateOutputObjects() {
   varnames[41] = "NDroppedMeasured";
   varnames[42] = "NDroppedTrue";
 
-  for(int ib = 0; ib < kTNVar; ib++){
-    LinkOutputBranch(varnames[ib], fJetTreeData + ib);
+  if(fCompactOutput) {
+    CreateCompactBranches(varnames);
+  } else {
+    for(int ib = 0; ib < kTNVar; ib++){
+      LinkOutputBranch(varnames[ib], fJetTreeData + ib);
+    }
   }
   PostData(1, fOutput);
   PostData(2, fJetSubstructureTree);
 }
 
 void AliAnalysisTaskEmcalJetSubstructureTree::LinkOutputBranch(const TString &branchname, Double_t *datalocation) {
-  // Check whether branch is rejected
-  if(!fFillPart && IsPartBranch(branchname)) return;
-  if(!fFillAcceptance && IsAcceptanceBranch(branchname)) return;
-  if(!fFillRho && IsRhoBranch(branchname)) return;
-  if(!fFillMass && IsMassBranch(branchname)) return;
-  if(!fFillSoftDrop && IsSoftdropBranch(branchname)) return;
-  if(!fFillNSub && IsNSubjettinessBranch(branchname)) return;
-  if(!fFillStructGlob && IsStructbranch(branchname)) return;
+  if(IsBranchRejected(branchname)) return;
 
   std::cout << "Adding branch " << branchname << std::endl;
   fJetSubstructureTree->Branch(branchname, datalocation, Form("%s/D", branchname.Data()));  
 }
 
+bool AliAnalysisTaskEmcalJetSubstructureTree::IsBranchRejected(const TString &branchname) const {
+  if(!fFillPart && IsPartBranch(branchname)) return true;
+  if(!fFillAcceptance && IsAcceptanceBranch(branchname)) return true;
+  if(!fFillRho && IsRhoBranch(branchname)) return true;
+  if(!fFillMass && IsMassBranch(branchname)) return true;
+  if(!fFillSoftDrop && IsSoftdropBranch(branchname)) return true;
+  if(!fFillNSub && IsNSubjettinessBranch(branchname)) return true;
+  if(!fFillStructGlob && IsStructbranch(branchname)) return true;
+  return false;
+}
+
+void AliAnalysisTaskEmcalJetSubstructureTree::CreateCompactBranches(const TString *varnames) {
+  fCompactFloatData.assign(kTNVar, std::vector<Float_t>());
+  fCompactCountData.assign(kTNVar, std::vector<UShort_t>());
+  fCompactBranches.assign(kTNVar, nullptr);
+  fJetSubstructureTree->Branch("NJets", &fCompactNJets, "NJets/I");
+  for(int ib = 0; ib < kTNVar; ib++){
+    const TString &branchname = varnames[ib];
+    if(IsBranchRejected(branchname)) continue;
+    std::cout << "Adding compact branch " << branchname << std::endl;
+    if(IsEventVariable(ib)) {
+      fJetSubstructureTree->Branch(branchname, fCompactEventData + ib, Form("%s/F", branchname.Data()));
+    } else if(IsCountVariable(ib)) {
+      // Buffers are reserved so that the branches get a valid address, it is updated before each fill
+      fCompactCountData[ib].reserve(32);
+      fCompactBranches[ib] = fJetSubstructureTree->Branch(branchname, fCompactCountData[ib].data(), Form("%s[NJets]/s", branchname.Data()));
+    } else {
+      fCompactFloatData[ib].reserve(32);
+      fCompactBranches[ib] = fJetSubstructureTree->Branch(branchname, fCompactFloatData[ib].data(), Form("%s[NJets]/F", branchname.Data()));
+    }
+  }
+
+  if(!fFillConstituents) return;
+  const char *levels[2] = {"Rec", "Sim"};
+  for(int ilev = 0; ilev < 2; ilev++) {
+    if(ilev == 1 && !fFillPart) continue;
+    const char *lev = levels[ilev];
+    fCompactConstPerJet[ilev].reserve(32);
+    fCompactConstPt[ilev].reserve(512);
+    fCompactConstEta[ilev].reserve(512);
+    fCompactConstPhi[ilev].reserve(512);
+    fJetSubstructureTree->Branch(Form("NConst%s", lev), fCompactNConst + ilev, Form("NConst%s/I", lev));
+    fCompactConstBranches[ilev][0] = fJetSubstructureTree->Branch(Form("NConstJet%s", lev), fCompactConstPerJet[ilev].data(), Form("NConstJet%s[NJets]/s", lev));
+    fCompactConstBranches[ilev][1] = fJetSubstructureTree->Branch(Form("ConstPt%s", lev), fCompactConstPt[ilev].data(), Form("ConstPt%s[NConst%s]/F", lev, lev));
+    fCompactConstBranches[ilev][2] = fJetSubstructureTree->Branch(Form("ConstEta%s", lev), fCompactConstEta[ilev].data(), Form("ConstEta%s[NConst%s]/F", lev, lev));
+    fCompactConstBranches[ilev][3] = fJetSubstructureTree->Branch(Form("ConstPhi%s", lev), fCompactConstPhi[ilev].data(), Form("ConstPhi%s[NConst%s]/F", lev, lev));
+  }
+}
+
+void AliAnalysisTaskEmcalJetSubstructureTree::ResetCompactEvent() {
+  fCompactNJets = 0;
+  for(auto &values : fCompactFloatData) values.clear();
+  for(auto &values : fCompactCountData) values.clear();
+  for(int ilev = 0; ilev < 2; ilev++) {
+    fCompactNConst[ilev] = 0;
+    fCompactConstPerJet[ilev].clear();
+    fCompactConstPt[ilev].clear();
+    fCompactConstEta[ilev].clear();
+    fCompactConstPhi[ilev].clear();
+  }
+}
+
+void AliAnalysisTaskEmcalJetSubstructureTree::AppendCompactJet() {
+  for(int ib = 0; ib < kTNVar; ib++) {
+    if(IsEventVariable(ib)) fCompactEventData[ib] = fJetTreeData[ib];
+    else if(IsCountVariable(ib)) fCompactCountData[ib].push_back(static_cast<UShort_t>(fJetTreeData[ib]));
+    else fCompactFloatData[ib].push_back(fJetTreeData[ib]);
+  }
+  fCompactNJets++;
+}
+
+void AliAnalysisTaskEmcalJetSubstructureTree::AppendCompactConstituents(const AliEmcalJet *datajet, const AliParticleContainer *tracks, const AliClusterContainer *clusters,
+                                                                        const AliEmcalJet *mcjet, const AliParticleContainer *particles) {
+  if(!(fCompactOutput && fFillConstituents)) return;
+  PackConstituents(datajet, tracks, clusters, 0);
+  if(fFillPart) PackConstituents(mcjet, particles, nullptr, 1);
+}
+
+void AliAnalysisTaskEmcalJetSubstructureTree::PackConstituents(const AliEmcalJet *jet, const AliParticleContainer *tracks, const AliClusterContainer *clusters, Int_t level) {
+  // Always add the entry for the jet, also for missing jets, in order to keep the per-jet array aligned with NJets
+  UShort_t nconst = 0;
+  if(jet) {
+    if(tracks) {
+      for(int itrk = 0; itrk < jet->GetNumberOfTracks(); itrk++) {
+        auto track = jet->TrackAt(itrk, tracks->GetArray());
+        if(!track) continue;
+        fCompactConstPt[level].push_back(track->Pt());
+        fCompactConstEta[level].push_back(track->Eta());
+        fCompactConstPhi[level].push_back(TVector2::Phi_0_2pi(track->Phi()));
+        nconst++;
+      }
+    }
+    if(clusters) {
+      for(int icl = 0; icl < jet->GetNumberOfClusters(); icl++) {
+        auto clust = jet->ClusterAt(icl, clusters->GetArray());
+        if(!clust) continue;
+        TLorentzVector clusterp;
+        clust->GetMomentum(clusterp, fVertex, (AliVCluster::VCluUserDefEnergy_t)clusters->GetDefaultClusterEnergy());
+        fCompactConstPt[level].push_back(clusterp.Pt());
+        fCompactConstEta[level].push_back(clusterp.Eta());
+        fCompactConstPhi[level].push_back(TVector2::Phi_0_2pi(clusterp.Phi()));
+        nconst++;
+      }
+    }
+  }
+  fCompactConstPerJet[level].push_back(nconst);
+  fCompactNConst[level] += nconst;
+}
+
+void AliAnalysisTaskEmcalJetSubstructureTree::FillCompactEvent() {
+  if(!fCompactNJets) return;
+  // The vectors might have been reallocated while appending the jets of the event
+  for(int ib = 0; ib < kTNVar; ib++) {
+    if(!fCompactBranches[ib]) continue;
+    if(IsCountVariable(ib)) fCompactBranches[ib]->SetAddress(fCompactCountData[ib].data());
+    else fCompactBranches[ib]->SetAddress(fCompactFloatData[ib].data());
+  }
+  for(int ilev = 0; ilev < 2; ilev++) {
+    if(!fCompactConstBranches[ilev][0]) continue;
+    fCompactConstBranches[ilev][0]->SetAddress(fCompactConstPerJet[ilev].data());
+    fCompactConstBranches[ilev][1]->SetAddress(fCompactConstPt[ilev].data());
+    fCompactConstBranches[ilev][2]->SetAddress(fCompactConstEta[ilev].data());
+    fCompactConstBranches[ilev][3]->SetAddress(fCompactConstPhi[ilev].data());
+  }
+  fJetSubstructureTree->Fill();
+}
+
 void AliAnalysisTaskEmcalJetSubstructureTree::RunChanged(Int_t newrun) {
   if(fUseDownscaleWeight){
     AliEmcalDownscaleFactorsOCDB::Instance()->SetRun(newrun);
@@ -293,6 +437,8 @@ bool AliAnalysisTaskEmcalJetSubstructureTree::Run(){
   nsubjettinessSettings.fBeta = 1.;
   nsubjettinessSettings.fRadius = 0.4;
 
+  if(fCompactOutput) ResetCompactEvent();
+
   if(datajets) {
     AliDebugStream(1) << "In data jets branch: found " <<  datajets->GetNJets() << " jets, " << datajets->GetNAcceptedJets() << " were accepted\n";
     AliDebugStream(1) << "Having MC information: " << (mcjets ? TString::Format("yes, with %d jets", mcjets->GetNJets()) : "no") << std::endl; 
@@ -316,6 +462,7 @@ bool AliAnalysisTaskEmcalJetSubstructureTree::Run(){
           Double_t angularity[2] = {fFillStructGlob ? MakeAngularity(*jet, tracks, clusters) : 0., (fFillStructGlob && fFillPart) ? MakeAngularity(*associatedJet, particles, nullptr) : 0.},
                    ptd[2] = {fFillStructGlob ? MakePtD(*jet, tracks, clusters) : 0., (fFillStructGlob && fFillPart) ? MakePtD(*associatedJet, particles, nullptr) : 0};
           FillTree(datajets->GetJetRadius(), weight, jet, associatedJet, &(structureData.fSoftDrop), &(structureMC.fSoftDrop), &(structureData.fNsubjettiness), &(structureMC.fNsubjettiness), angularity, ptd, rhoparameters);
+          AppendCompactConstituents(jet, tracks, clusters, associatedJet, particles);
         } catch(ReclusterizerException &e) {
           AliErrorStream() << "Error in reclusterization - skipping jet" << std::endl;
         } catch(SubstructureException &e) {
@@ -328,6 +475,7 @@ bool AliAnalysisTaskEmcalJetSubstructureTree::Run(){
           Double_t angularity[2] = {fFillStructGlob ? MakeAngularity(*jet, tracks, clusters): 0., 0.},
                    ptd[2] = {fFillStructGlob ? MakePtD(*jet, tracks, clusters) : 0., 0.};
           FillTree(datajets->GetJetRadius(), weight, jet, nullptr, &(structure.fSoftDrop), nullptr, &(structure.fNsubjettiness), nullptr, angularity, ptd, rhoparameters);
+          AppendCompactConstituents(jet, tracks, clusters, nullptr, nullptr);
         } catch(ReclusterizerException &e) {
           AliErrorStream() << "Error in reclusterization - skipping jet" << std::endl;
         } catch(SubstructureException &e) {
@@ -346,6 +494,7 @@ bool AliAnalysisTaskEmcalJetSubstructureTree::Run(){
           Double_t angularity[2] = {0., MakeAngularity(*mcjet, particles, nullptr)},
                    ptd[2] = {0., MakePtD(*mcjet, particles, nullptr)};
           FillTree(mcjets->GetJetRadius(), weight, nullptr, mcjet, nullptr, &(structure.fSoftDrop), nullptr, &(structure.fNsubjettiness), angularity, ptd, rhoparameters);
+          AppendCompactConstituents(nullptr, nullptr, nullptr, mcjet, particles);
         } catch (ReclusterizerException &e) {
           AliErrorStream() << "Error in reclusterization - skipping jet" << std::endl;
         } catch (SubstructureException &e) {
@@ -355,6 +504,7 @@ bool AliAnalysisTaskEmcalJetSubstructureTree::Run(){
     }
   }
 
+  if(fCompactOutput) FillCompactEvent();
   return true;
 }
 
@@ -444,7 +594,8 @@ void AliAnalysisTaskEmcalJetSubstructureTree::FillTree(double r, double weight,
     }
   }
 
-  fJetSubstructureTree->Fill();
+  if(fCompactOutput) AppendCompactJet();
+  else fJetSubstructureTree->Fill();
 }
 
 
@@ -492,25 +643,19 @@ AliJetSubstructureData AliAnalysisTaskEmcalJetSubstructureTree::MakeJetSubstruct
 }
 
 AliSoftDropParameters AliAnalysisTaskEmcalJetSubstructureTree::MakeSoftDropParameters(const fastjet::PseudoJet &jet, const AliSoftdropDefinition &cutparameters) const {
-  fastjet::contrib::SoftDrop softdropAlgorithm(cutparameters.fBeta, cutparameters.fZ);
-  softdropAlgorithm.set_verbose_structure(kTRUE);
-  std::unique_ptr<fastjet::contrib::Recluster> reclusterizer(new fastjet::contrib::Recluster(cutparameters.fRecluserAlgo, 1, true));
-  softdropAlgorithm.set_reclustering(kTRUE, reclusterizer.get());
   AliDebugStream(4) << "Jet has " << jet.constituents().size() << " constituents" << std::endl;
-  auto groomed = softdropAlgorithm(jet);
-  try {
-    auto softdropstruct = groomed.structure_of<fastjet::contrib::SoftDrop>();
-
-    AliSoftDropParameters result({softdropstruct.symmetry(),
-                                  groomed.m(),
-                                  softdropstruct.delta_R(),
-                                  groomed.perp(),
-                                  softdropstruct.mu(),
-                                  softdropstruct.dropped_count()});
-    return result;
-  } catch(std::bad_cast &e) {
-    throw SoftDropException(); 
-  }
+  // Recluster once, all the grooming steps are read from the declustering nodes
+  AliEmcalJetDeclusteringTree declustering(cutparameters.fRecluserAlgo, 1.);
+  declustering.Build(jet);
+  // R0 = 1 as in fastjet::contrib::SoftDrop(beta, zcut)
+  AliEmcalJetDeclusteringTree::SoftDropResult_t groomed = declustering.SoftDrop({cutparameters.fZ, cutparameters.fBeta, 1.});
+  AliSoftDropParameters result({groomed.fZg,
+                                groomed.fMg,
+                                groomed.fRg,
+                                groomed.fPtg,
+                                groomed.fMug,
+                                groomed.fNDropped});
+  return result;
 }
 
 AliNSubjettinessParameters AliAnalysisTaskEmcalJetSubstructureTree::MakeNsubjettinessParameters(const fastjet::PseudoJet &jet, const AliNSubjettinessDefinition &cut) const {
@@ -629,6 +774,33 @@ void AliAnalysisTaskEmcalJetSubstructureTree::DoConstituentQA(const AliEmcalJet
 #endif
 }
 
+bool AliAnalysisTaskEmcalJetSubstructureTree::IsEventVariable(Int_t var) {
+  switch(var) {
+  case kTRadius:
+  case kTWeight:
+  case kTRhoPtRec:
+  case kTRhoPtSim:
+  case kTRhoMassRec:
+  case kTRhoMassSim:
+    return true;
+  default:
+    return false;
+  };
+}
+
+bool AliAnalysisTaskEmcalJetSubstructureTree::IsCountVariable(Int_t var) {
+  switch(var) {
+  case kTNCharged:
+  case kTNNeutral:
+  case kTNConstTrue:
+  case kTNDroppedMeasured:
+  case kTNDroppedTrue:
+    return true;
+  default:
+    return false;
+  };
+}
+
 bool AliAnalysisTaskEmcalJetSubstructureTree::IsPartBranch(const TString &branchname) const{
   return branchname.Contains("Sim") || branchname.Contains("True");
 }
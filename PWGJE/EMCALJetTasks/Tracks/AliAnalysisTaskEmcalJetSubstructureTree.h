@@ -29,11 +29,13 @@
 
 #include "AliAnalysisTaskEmcalJet.h"
 #include <exception>
+#include <vector>
 #include <TString.h>
 #include <fastjet/PseudoJet.hh>
 #include <fastjet/JetDefinition.hh>
 
 class THistManager;
+class TBranch;
 class TTree;
 class AliClusterContainer;
 class AliEmcalJet;
@@ -200,6 +202,26 @@ public:
   void SetFillNSubjettinessBranches(Bool_t doFill) { fFillNSub = doFill; }
   void SetFillSubstructureBranches(Bool_t doFill) { fFillStructGlob = doFill; }
 
+  /**
+   * @brief Write one tree entry per event instead of one per jet
+   *
+   * Event-level values (radius, weight, rho) are stored once per entry, the jet values
+   * as arrays over the NJets jets of the event: Float_t for the kinematic and substructure
+   * variables, UShort_t for the constituent and dropped-branch counts. Use
+   * AliJetSubstructureCompactReader to read the tree.
+   * @param doCompact If true the compact output is written
+   */
+  void SetCompactOutput(Bool_t doCompact) { fCompactOutput = doCompact; }
+
+  /**
+   * @brief Store the constituents of the jets in the compact output
+   *
+   * Constituents are packed per level (Rec, Sim) into flat pt, eta and phi arrays over all the
+   * jets of the event, with the number of constituents per jet in NConstJetRec / NConstJetSim.
+   * @param doFill If true the constituents are stored (compact output only)
+   */
+  void SetFillConstituents(Bool_t doFill) { fFillConstituents = doFill; }
+
 	static AliAnalysisTaskEmcalJetSubstructureTree *AddEmcalJetSubstructureTreeMaker(Bool_t isMC, Bool_t isData, Double_t jetradius, AliJetContainer::EJetType_t jettype, AliJetContainer::ERecoScheme_t recombinationScheme, const char *name);
 
 protected:
@@ -223,6 +245,17 @@ protected:
 
   void LinkOutputBranch(const TString &branchname, Double_t *datalocation);
 
+  void CreateCompactBranches(const TString *varnames);
+  void ResetCompactEvent();
+  void AppendCompactJet();
+  void AppendCompactConstituents(const AliEmcalJet *datajet, const AliParticleContainer *tracks, const AliClusterContainer *clusters, const AliEmcalJet *mcjet, const AliParticleContainer *particles);
+  void PackConstituents(const AliEmcalJet *jet, const AliParticleContainer *tracks, const AliClusterContainer *clusters, Int_t level);
+  void FillCompactEvent();
+
+  bool IsBranchRejected(const TString &branchname) const;
+  static bool IsEventVariable(Int_t var);
+  static bool IsCountVariable(Int_t var);
+
   bool IsPartBranch(const TString &branchname) const;
   bool IsAcceptanceBranch(const TString &branchname) const;
   bool IsRhoBranch(const TString &branchname) const;
@@ -253,8 +286,23 @@ private:
   Bool_t                       fFillNSub;                   ///< Fill N-subjettiness
   Bool_t                       fFillStructGlob;             ///< Fill other substructure variables
 
+  // Compact output: one entry per event
+  Bool_t                       fCompactOutput;              ///< Write one entry per event with jet arrays in reduced precision
+  Bool_t                       fFillConstituents;           ///< Fill packed constituent arrays (compact output only)
+  Int_t                        fCompactNJets;               //!<! Number of jets of the event
+  Float_t                      fCompactEventData[kTNVar];   //!<! Event-level values
+  std::vector<std::vector<Float_t> >  fCompactFloatData;    //!<! Float_t jet values per variable
+  std::vector<std::vector<UShort_t> > fCompactCountData;    //!<! Count jet values per variable
+  std::vector<TBranch *>       fCompactBranches;            //!<! Jet array branches per variable (nullptr if not written)
+  Int_t                        fCompactNConst[2];           //!<! Number of packed constituents (Rec, Sim)
+  std::vector<UShort_t>        fCompactConstPerJet[2];      //!<! Number of constituents per jet (Rec, Sim)
+  std::vector<Float_t>         fCompactConstPt[2];          //!<! Packed constituent pt (Rec, Sim)
+  std::vector<Float_t>         fCompactConstEta[2];         //!<! Packed constituent eta (Rec, Sim)
+  std::vector<Float_t>         fCompactConstPhi[2];         //!<! Packed constituent phi (Rec, Sim)
+  TBranch                     *fCompactConstBranches[2][4]; //!<! Constituent array branches (per jet, pt, eta, phi)
+
 	/// \cond CLASSIMP
-	ClassDef(AliAnalysisTaskEmcalJetSubstructureTree, 1);
+	ClassDef(AliAnalysisTaskEmcalJetSubstructureTree, 2);
 	/// \endcond
 };
 
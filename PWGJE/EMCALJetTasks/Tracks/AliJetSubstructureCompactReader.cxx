@@ -0,0 +1,219 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include <memory>
+
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TTree.h>
+
+#include "AliLog.h"
+#include "AliJetSubstructureCompactReader.h"
+
+/// \cond CLASSIMP
+ClassImp(EmcalTriggerJets::AliJetSubstructureCompactReader);
+/// \endcond
+
+namespace EmcalTriggerJets {
+
+AliJetSubstructureCompactReader::AliJetSubstructureCompactReader() :
+  TObject(),
+  fTree(nullptr),
+  fIndexBuffers(),
+  fFloatBuffers(),
+  fCountBuffers()
+{
+}
+
+AliJetSubstructureCompactReader::AliJetSubstructureCompactReader(TTree *tree, Long64_t cachesize) :
+  TObject(),
+  fTree(nullptr),
+  fIndexBuffers(),
+  fFloatBuffers(),
+  fCountBuffers()
+{
+  SetTree(tree, cachesize);
+}
+
+/**
+ * Bind the buffers to all the branches of the tree. The size of the array buffers
+ * is the maximum of their count branch over the tree.
+ * @param tree Tree (or chain) with the compact output
+ * @param cachesize Size of the TTreeCache in bytes
+ */
+void AliJetSubstructureCompactReader::SetTree(TTree *tree, Long64_t cachesize) {
+  fTree = tree;
+  fIndexBuffers.clear();
+  fFloatBuffers.clear();
+  fCountBuffers.clear();
+  if(!fTree) return;
+  fTree->LoadTree(0);     // list of leaves of a chain available only with a loaded tree
+
+  std::map<std::string, Int_t> maxcounts;
+  TIter leafiter(fTree->GetListOfLeaves());
+  TLeaf *leaf(nullptr);
+  while((leaf = static_cast<TLeaf *>(leafiter()))){
+    std::string name = leaf->GetName();
+    TString type = leaf->GetTypeName();
+    Int_t size = 1;
+    TLeaf *count = leaf->GetLeafCount();
+    if(count) {
+      std::map<std::string, Int_t>::iterator found = maxcounts.find(count->GetName());
+      if(found == maxcounts.end()) {
+        found = maxcounts.insert(std::make_pair(std::string(count->GetName()), static_cast<Int_t>(fTree->GetMaximum(count->GetName())))).first;
+      }
+      size = std::max(1, found->second);
+    }
+    if(type == "Int_t") {
+      Int_t &buffer = fIndexBuffers[name];
+      buffer = 0;
+      fTree->SetBranchAddress(name.data(), &buffer);
+    } else if(type == "UShort_t") {
+      std::vector<UShort_t> &buffer = fCountBuffers[name];
+      buffer.assign(size, 0);
+      fTree->SetBranchAddress(name.data(), buffer.data());
+    } else if(type == "Float_t") {
+      std::vector<Float_t> &buffer = fFloatBuffers[name];
+      buffer.assign(size, 0.);
+      fTree->SetBranchAddress(name.data(), buffer.data());
+    } else {
+      AliErrorStream() << "Branch " << name << " of type " << type << " not handled" << std::endl;
+    }
+  }
+  fTree->SetCacheSize(cachesize);
+  fTree->AddBranchToCache("*", kTRUE);
+}
+
+/**
+ * Read only the branches listed, all the others are disabled. The count
+ * branches (NJets, NConstRec, NConstSim) stay always enabled.
+ * @param branches Comma-separated list of branch names (wildcards allowed)
+ */
+void AliJetSubstructureCompactReader::SelectBranches(const char *branches) {
+  if(!fTree) return;
+  fTree->SetBranchStatus("*", 0);
+  fTree->DropBranchFromCache("*", kTRUE);
+  for(const auto &index : fIndexBuffers) {
+    fTree->SetBranchStatus(index.first.data(), 1);
+    fTree->AddBranchToCache(index.first.data(), kTRUE);
+  }
+  std::unique_ptr<TObjArray> tokens(TString(branches).Tokenize(","));
+  for(auto token : *tokens) {
+    TString branchname = static_cast<TObjString *>(token)->String().Strip(TString::kBoth);
+    if(!branchname.Length()) continue;
+    fTree->SetBranchStatus(branchname, 1);
+    fTree->AddBranchToCache(branchname, kTRUE);
+  }
+}
+
+Long64_t AliJetSubstructureCompactReader::GetEntries() const {
+  return fTree ? fTree->GetEntries() : 0;
+}
+
+/**
+ * Read the enabled branches of one entry into the buffers.
+ * @param entry Entry (event) number
+ * @return True if the entry was read
+ */
+Bool_t AliJetSubstructureCompactReader::ReadEvent(Long64_t entry) {
+  if(!fTree) return kFALSE;
+  return fTree->GetEntry(entry) > 0;
+}
+
+Int_t AliJetSubstructureCompactReader::GetIndex(const char *branch) const {
+  std::map<std::string, Int_t>::const_iterator found = fIndexBuffers.find(branch);
+  return found != fIndexBuffers.end() ? found->second : 0;
+}
+
+Float_t AliJetSubstructureCompactReader::GetEventValue(const char *branch) const {
+  const Float_t *values = GetJetValues(branch);
+  return values ? values[0] : 0.;
+}
+
+/**
+ * Access to a Float_t array of the current entry, with GetNumberOfJets() values
+ * for jet arrays or GetNumberOfConstituents() values for constituent arrays.
+ * @param branch Name of the branch
+ * @return Values of the branch (nullptr if not found)
+ */
+const Float_t *AliJetSubstructureCompactReader::GetJetValues(const char *branch) const {
+  std::map<std::string, std::vector<Float_t> >::const_iterator found = fFloatBuffers.find(branch);
+  return found != fFloatBuffers.end() ? found->second.data() : nullptr;
+}
+
+const UShort_t *AliJetSubstructureCompactReader::GetJetCounts(const char *branch) const {
+  std::map<std::string, std::vector<UShort_t> >::const_iterator found = fCountBuffers.find(branch);
+  return found != fCountBuffers.end() ? found->second.data() : nullptr;
+}
+
+/**
+ * Read a Float_t array branch over a range of entries, reading only the branch
+ * and its count branch (also if they are disabled by SelectBranches()).
+ * @param[in] branch Name of the branch
+ * @param[out] values Values of all the entries appended one after the other
+ * @param[in] first First entry
+ * @param[in] nentries Number of entries (-1: up to the end of the tree)
+ * @return Number of values appended
+ */
+Long64_t AliJetSubstructureCompactReader::ReadColumn(const char *branch, std::vector<Float_t> &values, Long64_t first, Long64_t nentries) {
+  const Float_t *buffer = GetJetValues(branch);
+  if(!buffer) {
+    AliErrorStream() << "Branch " << branch << " not found as Float_t branch" << std::endl;
+    return 0;
+  }
+  Long64_t last = nentries < 0 ? fTree->GetEntries() : std::min(fTree->GetEntries(), first + nentries);
+  size_t nbefore = values.size();
+  Int_t treenumber = -1;
+  TBranch *valuebranch(nullptr), *countbranch(nullptr);
+  const Int_t *count(nullptr);
+  for(Long64_t ientry = first; ientry < last; ientry++) {
+    Long64_t local = fTree->LoadTree(ientry);
+    if(local < 0) break;
+    if(fTree->GetTreeNumber() != treenumber) {
+      // Branch objects change with the file in case of a chain
+      treenumber = fTree->GetTreeNumber();
+      TTree *current = fTree->GetTree();
+      valuebranch = current->GetBranch(branch);
+      TLeaf *countleaf = valuebranch ? valuebranch->GetLeaf(branch)->GetLeafCount() : nullptr;
+      countbranch = countleaf ? countleaf->GetBranch() : nullptr;
+      count = countleaf ? &(fIndexBuffers[countleaf->GetName()]) : nullptr;
+    }
+    if(!valuebranch) break;
+    Int_t nvalues = 1;
+    if(countbranch) {
+      countbranch->GetEntry(local, 1);
+      nvalues = *count;
+    }
+    valuebranch->GetEntry(local, 1);
+    values.insert(values.end(), buffer, buffer + nvalues);
+  }
+  return values.size() - nbefore;
+}
+
+} /* namespace EmcalTriggerJets */
@@ -0,0 +1,102 @@
+/************************************************************************************
+ * Copyright (C) 2018, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIJETSUBSTRUCTURECOMPACTREADER_H
+#define ALIJETSUBSTRUCTURECOMPACTREADER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <TObject.h>
+#include <TString.h>
+
+class TTree;
+
+namespace EmcalTriggerJets {
+
+/**
+ * @class AliJetSubstructureCompactReader
+ * @brief Reader for the compact output of AliAnalysisTaskEmcalJetSubstructureTree
+ * @ingroup PWGJETASKS
+ *
+ * Binds typed buffers to all the branches of a tree written with
+ * AliAnalysisTaskEmcalJetSubstructureTree::SetCompactOutput(true): event-level values,
+ * jet arrays over the NJets jets of the entry and the packed constituent arrays. The
+ * buffers are sized once from the maximum of the count branches. A TTreeCache is set on
+ * the tree, and the branches not needed can be disabled with SelectBranches() so that
+ * only the selected columns are read.
+ *
+ * ~~~{.cxx}
+ * EmcalTriggerJets::AliJetSubstructureCompactReader reader(tree);
+ * reader.SelectBranches("PtJetRec,ZgMeasured,EventWeight");
+ * for(Long64_t ientry = 0; ientry < reader.GetEntries(); ientry++) {
+ *   reader.ReadEvent(ientry);
+ *   const Float_t *pt = reader.GetJetValues("PtJetRec"), *zg = reader.GetJetValues("ZgMeasured");
+ *   for(Int_t ijet = 0; ijet < reader.GetNumberOfJets(); ijet++) hzg->Fill(pt[ijet], zg[ijet], reader.GetEventValue("EventWeight"));
+ * }
+ * ~~~
+ *
+ * ReadColumn() reads a single jet array over a range of entries into a flat vector,
+ * reading only the branch itself and its count branch.
+ */
+class AliJetSubstructureCompactReader : public TObject {
+public:
+  AliJetSubstructureCompactReader();
+  AliJetSubstructureCompactReader(TTree *tree, Long64_t cachesize = 10000000);
+  virtual ~AliJetSubstructureCompactReader() {}
+
+  void            SetTree(TTree *tree, Long64_t cachesize = 10000000);
+  void            SelectBranches(const char *branches);
+
+  Long64_t        GetEntries() const;
+  Bool_t          ReadEvent(Long64_t entry);
+
+  Int_t           GetNumberOfJets() const { return GetIndex("NJets"); }
+  Int_t           GetNumberOfConstituents(const char *level) const { return GetIndex(Form("NConst%s", level)); }
+  Int_t           GetIndex(const char *branch) const;
+  Float_t         GetEventValue(const char *branch) const;
+  const Float_t  *GetJetValues(const char *branch) const;
+  const UShort_t *GetJetCounts(const char *branch) const;
+
+  Long64_t        ReadColumn(const char *branch, std::vector<Float_t> &values, Long64_t first = 0, Long64_t nentries = -1);
+
+private:
+  AliJetSubstructureCompactReader(const AliJetSubstructureCompactReader &);
+  AliJetSubstructureCompactReader &operator=(const AliJetSubstructureCompactReader &);
+
+  TTree                                          *fTree;          //!<! Tree with the compact output
+  std::map<std::string, Int_t>                    fIndexBuffers;  //!<! Buffers of the count branches (NJets, NConstRec, NConstSim)
+  std::map<std::string, std::vector<Float_t> >    fFloatBuffers;  //!<! Buffers of the Float_t branches (event values and jet arrays)
+  std::map<std::string, std::vector<UShort_t> >   fCountBuffers;  //!<! Buffers of the UShort_t jet arrays
+
+  /// \cond CLASSIMP
+  ClassDef(AliJetSubstructureCompactReader, 1);
+  /// \endcond
+};
+
+} /* namespace EmcalTriggerJets */
+
+#endif /* ALIJETSUBSTRUCTURECOMPACTREADER_H */
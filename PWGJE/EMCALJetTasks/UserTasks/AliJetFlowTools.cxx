@@ -58,6 +58,13 @@
 #include "TFitResultPtr.h"
 #include "Minuit2/Minuit2Minimizer.h"
 #include "Math/Functor.h"
+#include "TClass.h"
+#include "TKey.h"
+#include "TTree.h"
+#include "TSystem.h"
+// system includes for the worker processes of MakeVariations()
+#include <unistd.h>
+#include <sys/wait.h>
 // aliroot includes
 #include "AliUnfolding.h"
 #include "AliAnaChargedJetResponseMaker.h"
@@ -149,7 +156,10 @@ AliJetFlowTools::AliJetFlowTools() :
     fSubdueError        (kTRUE),
     fUnfoldedSpectrumIn (0x0),
     fUnfoldedSpectrumOut(0x0),
-    fHarmonic(2) { // class constructor
+    fHarmonic(2),
+    fVariations(),
+    fShareResponse(kFALSE),
+    fResponseCache(0x0) { // class constructor
 #ifdef ALIJETFLOWTOOLS_DEBUG_FLAG
     printf("__FILE__ = %s \n __LINE __ %i , __FUNC__ %s \n ", __FILE__, __LINE__, __func__);
 #endif
@@ -209,33 +219,11 @@ void AliJetFlowTools::Make(TH1* customIn, TH1* customOut) {
     TH1D* measuredJetSpectrumTrueBinsIn  = RebinTH1D(fSpectrumIn, fBinsTrue, TString("in"), kFALSE);
     TH1D* measuredJetSpectrumTrueBinsOut = RebinTH1D(fSpectrumOut, fBinsTrue, TString("out"), kFALSE);
     // get the full response matrix from the dpt and the detector response
-    fDetectorResponse = NormalizeTH2D(fDetectorResponse);
-    // get the full response matrix. if test mode is chosen, the full response is replace by a unity matrix
-    // so that unfolding should return the initial spectrum
-    if(!fTestMode) {
-        if(fUseDptResponse && fUseDetectorResponse) {
-            fFullResponseIn = MatrixMultiplication(fDptIn, fDetectorResponse);
-            fFullResponseOut = MatrixMultiplication(fDptOut, fDetectorResponse);
-        } else if (fUseDptResponse && !fUseDetectorResponse) {
-            fFullResponseIn = fDptIn;
-            fFullResponseOut = fDptOut;
-        } else if (!fUseDptResponse && fUseDetectorResponse) {
-            fFullResponseIn = fDetectorResponse;
-            fFullResponseOut = fDetectorResponse;
-        } else if (!fUseDptResponse && !fUseDetectorResponse && !fUnfoldingAlgorithm == AliJetFlowTools::kNone) {
-            printf(" > No response, exiting ! < \n" );
-            return;
-        }
-    } else {
-        fFullResponseIn = GetUnityResponse(fBinsTrue, fBinsRec, TString("in"));
-        fFullResponseOut = GetUnityResponse(fBinsTrue, fBinsRec, TString("out"));
-    }
-    // normalize each slide of the response to one
-    NormalizeTH2D(fFullResponseIn);
-    NormalizeTH2D(fFullResponseOut);
+    // (in a batch of variations it is prepared once by MakeVariations())
+    if(!fShareResponse && !PrepareFullResponse()) return;
     // resize to desired binning scheme
-    TH2D* resizedResponseIn  = RebinTH2D(fFullResponseIn, fBinsTrue, fBinsRec, TString("in"));
-    TH2D* resizedResponseOut = RebinTH2D(fFullResponseOut, fBinsTrue, fBinsRec, TString("out"));
+    TH2D* resizedResponseIn  = GetResizedResponse(fFullResponseIn, fBinsTrue, fBinsRec, TString("in"));
+    TH2D* resizedResponseOut = GetResizedResponse(fFullResponseOut, fBinsTrue, fBinsRec, TString("out"));
     // get the kinematic efficiency
     TH1D* kinematicEfficiencyIn  = resizedResponseIn->ProjectionX();
     kinematicEfficiencyIn->SetNameTitle("kin_eff_IN","kin_eff_IN");
@@ -387,6 +375,301 @@ void AliJetFlowTools::Make(TH1* customIn, TH1* customOut) {
 
 }
 //_____________________________________________________________________________
+Bool_t AliJetFlowTools::PrepareFullResponse() {
+#ifdef ALIJETFLOWTOOLS_DEBUG_FLAG
+    printf("__FILE__ = %s \n __LINE __ %i , __FUNC__ %s \n ", __FILE__, __LINE__, __func__);
+#endif
+    // get the full response matrix from the dpt and the detector response
+    fDetectorResponse = NormalizeTH2D(fDetectorResponse);
+    // get the full response matrix. if test mode is chosen, the full response is replace by a unity matrix
+    // so that unfolding should return the initial spectrum
+    if(!fTestMode) {
+        if(fUseDptResponse && fUseDetectorResponse) {
+            fFullResponseIn = MatrixMultiplication(fDptIn, fDetectorResponse);
+            fFullResponseOut = MatrixMultiplication(fDptOut, fDetectorResponse);
+        } else if (fUseDptResponse && !fUseDetectorResponse) {
+            fFullResponseIn = fDptIn;
+            fFullResponseOut = fDptOut;
+        } else if (!fUseDptResponse && fUseDetectorResponse) {
+            fFullResponseIn = fDetectorResponse;
+            fFullResponseOut = fDetectorResponse;
+        } else if (!fUseDptResponse && !fUseDetectorResponse && !fUnfoldingAlgorithm == AliJetFlowTools::kNone) {
+            printf(" > No response, exiting ! < \n" );
+            return kFALSE;
+        }
+    } else {
+        fFullResponseIn = GetUnityResponse(fBinsTrue, fBinsRec, TString("in"));
+        fFullResponseOut = GetUnityResponse(fBinsTrue, fBinsRec, TString("out"));
+    }
+    // normalize each slide of the response to one
+    NormalizeTH2D(fFullResponseIn);
+    NormalizeTH2D(fFullResponseOut);
+    return kTRUE;
+}
+//_____________________________________________________________________________
+TH2D* AliJetFlowTools::GetResizedResponse(TH2D* full, TArrayD* binsTrue, TArrayD* binsRec, TString suffix) {
+#ifdef ALIJETFLOWTOOLS_DEBUG_FLAG
+    printf("__FILE__ = %s \n __LINE __ %i , __FUNC__ %s \n ", __FILE__, __LINE__, __func__);
+#endif
+    // rebinned response. in a batch of variations the weighted rebinning is done once per
+    // binning scheme, the caller gets a copy it can modify and delete
+    if(!fShareResponse || !full || !binsTrue || !binsRec) return RebinTH2D(full, binsTrue, binsRec, suffix);
+    TString key(Form("%p", full));
+    for(Int_t i(0); i < binsTrue->GetSize(); i++) key += Form("_%g", binsTrue->At(i));
+    key += "__";
+    for(Int_t i(0); i < binsRec->GetSize(); i++) key += Form("_%g", binsRec->At(i));
+    if(!fResponseCache) {
+        fResponseCache = new TList();
+        fResponseCache->SetOwner(kTRUE);
+    }
+    TH2D* cached((TH2D*)fResponseCache->FindObject(key.Data()));
+    if(!cached) {
+        cached = RebinTH2D(full, binsTrue, binsRec, suffix);
+        if(!cached) return 0x0;
+        cached->SetDirectory(0);
+        cached->SetName(key.Data());
+        fResponseCache->Add(cached);
+    }
+    TH2D* resized((TH2D*)cached->Clone(Form("%s_%s", full->GetName(), suffix.Data())));
+    resized->SetDirectory(gDirectory);
+    return resized;
+}
+//_____________________________________________________________________________
+Int_t AliJetFlowTools::AddVariation(
+        TString name,
+        unfoldingAlgorithm ua,
+        prior p,
+        Int_t regIn,
+        Int_t regOut,
+        Double_t betaIn,
+        Double_t betaOut,
+        TArrayD* binsTrue,
+        TArrayD* binsRec)
+{
+    // add a variation for MakeVariations(), returns its index
+    Variation v;
+    v.fName     = name;
+    v.fAlgorithm= ua;
+    v.fPrior    = p;
+    v.fRegIn    = regIn;
+    v.fRegOut   = regOut;
+    v.fBetaIn   = betaIn;
+    v.fBetaOut  = betaOut;
+    v.fBinsTrue = binsTrue;
+    v.fBinsRec  = binsRec;
+    v.fReplica  = -1;
+    v.fSeed     = 0;
+    fVariations.push_back(v);
+    return fVariations.size()-1;
+}
+//_____________________________________________________________________________
+void AliJetFlowTools::AddBootstrapReplicas(Int_t n, UInt_t seed)
+{
+    // add n bootstrap replicas of the current configuration. each replica has a
+    // fixed seed, so the result does not depend on the distribution over workers
+    for(Int_t i(0); i < n; i++) {
+        Int_t index(AddVariation(Form("bootstrap_%i", i), fUnfoldingAlgorithm, fPrior,
+                    (fUnfoldingAlgorithm == kSVD) ? fSVDRegIn : fBayesianIterIn,
+                    (fUnfoldingAlgorithm == kSVD) ? fSVDRegOut : fBayesianIterOut,
+                    fBetaIn, fBetaOut));
+        fVariations[index].fReplica = i;
+        fVariations[index].fSeed    = seed + i;
+    }
+}
+//_____________________________________________________________________________
+void AliJetFlowTools::RunVariation(const Variation& v, Int_t prefix)
+{
+    // apply the settings of a variation and unfold it into the output list 'prefix'
+    fUnfoldingAlgorithm = v.fAlgorithm;
+    fPrior              = v.fPrior;
+    fSVDRegIn           = v.fRegIn;
+    fSVDRegOut          = v.fRegOut;
+    fBayesianIterIn     = v.fRegIn;
+    fBayesianIterOut    = v.fRegOut;
+    fBetaIn             = v.fBetaIn;
+    fBetaOut            = v.fBetaOut;
+    if(v.fBinsTrue) fBinsTrue = v.fBinsTrue;
+    if(v.fBinsRec)  fBinsRec  = v.fBinsRec;
+    fBootstrap          = (v.fReplica > -1);
+    if(fBootstrap) gRandom->SetSeed(v.fSeed);
+    fListPrefix         = prefix - 1;   // incremented by CreateOutputList
+    CreateOutputList(v.fName);
+    Make();
+}
+//_____________________________________________________________________________
+void AliJetFlowTools::MakeVariations(Int_t workers)
+{
+#ifdef ALIJETFLOWTOOLS_DEBUG_FLAG
+    printf("__FILE__ = %s \n __LINE __ %i , __FUNC__ %s \n ", __FILE__, __LINE__, __func__);
+#endif
+    // unfold all variations added with AddVariation() and AddBootstrapReplicas()
+    // 1) read the input and build the full response once
+    // 2) unfold the variations, in this process or distributed over forked workers
+    // 3) collect the output lists of the workers in the output file, in order
+    const Int_t n(fVariations.size());
+    if(n == 0) {
+        printf(" > MakeVariations:: no variations defined < \n");
+        return;
+    }
+    if(fRefreshInput && !PrepareForUnfolding()) {
+        printf(" AliJetFlowTools::MakeVariations() Fatal error \n - couldn't prepare for unfolding ! \n");
+        return;
+    }
+    if(!fOutputFile) fOutputFile = new TFile(fOutputFileName.Data(), "RECREATE");
+    // in test mode the unity response depends on the binning of the variation
+    if(!fTestMode) {
+        if(!PrepareFullResponse()) return;
+        fShareResponse = kTRUE;
+    }
+    // every variation starts from the current configuration, which is restored afterwards
+    unfoldingAlgorithm algorithm(fUnfoldingAlgorithm);
+    prior priorType(fPrior);
+    Int_t svdRegIn(fSVDRegIn), svdRegOut(fSVDRegOut), bayesianIterIn(fBayesianIterIn), bayesianIterOut(fBayesianIterOut);
+    Double_t betaIn(fBetaIn), betaOut(fBetaOut);
+    TArrayD* binsTrue(fBinsTrue);
+    TArrayD* binsRec(fBinsRec);
+    Bool_t bootstrap(fBootstrap);
+    const Int_t first(fListPrefix + 1);
+
+    if(workers > n) workers = n;
+    if(workers < 2) {
+        for(Int_t i(0); i < n; i++) RunVariation(fVariations[i], first + i);
+    } else {
+        TString base(fOutputFileName);
+        base.ReplaceAll(".root", "");
+        std::vector<pid_t> pids(workers, -1);
+        for(Int_t w(0); w < workers; w++) {
+            pids[w] = fork();
+            if(pids[w] == 0) {
+                // worker: own output file, profiles only hold the entries of this worker
+                fOutputFile = new TFile(Form("%s_worker%i.root", base.Data(), w), "RECREATE");
+                if(fRMSSpectrumIn)  fRMSSpectrumIn->Reset();
+                if(fRMSSpectrumOut) fRMSSpectrumOut->Reset();
+                if(fRMSRatio)       fRMSRatio->Reset();
+                for(Int_t i(w); i < n; i += workers) RunVariation(fVariations[i], first + i);
+                fOutputFile->cd();
+                if(fRMSSpectrumIn)  fRMSSpectrumIn->Write("fRMSSpectrumIn");
+                if(fRMSSpectrumOut) fRMSSpectrumOut->Write("fRMSSpectrumOut");
+                if(fRMSRatio)       fRMSRatio->Write("fRMSRatio");
+                fOutputFile->Close();
+                _exit(0);       // no clean-up of the objects shared with the parent
+            }
+            if(pids[w] < 0) printf(" > MakeVariations:: could not fork worker %i, its variations are unfolded in this process < \n", w);
+        }
+        for(Int_t w(0); w < workers; w++) {
+            Int_t status(0);
+            if(pids[w] > 0 && (waitpid(pids[w], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+                printf(" > MakeVariations:: worker %i failed, its variations are missing < \n", w);
+            }
+        }
+        // collect the output lists in order of the variations
+        std::vector<TFile*> files(workers, (TFile*)0x0);
+        for(Int_t w(0); w < workers; w++) {
+            if(pids[w] > 0) files[w] = TFile::Open(Form("%s_worker%i.root", base.Data(), w));
+        }
+        for(Int_t i(0); i < n; i++) {
+            Int_t w(i % workers);
+            if(pids[w] < 0) {
+                RunVariation(fVariations[i], first + i);
+                continue;
+            }
+            if(!files[w]) continue;
+            TString name(Form("%i__%s", first + i, fVariations[i].fName.Data()));
+            TDirectory* source(files[w]->GetDirectory(name.Data()));
+            if(!source) continue;
+            fOutputFile->cd();
+            CopyDirectory(source, fOutputFile->mkdir(name.Data()));
+        }
+        for(Int_t w(0); w < workers; w++) {
+            if(!files[w]) continue;
+            TProfile* p(0x0);
+            if(fRMSSpectrumIn && (p = dynamic_cast<TProfile*>(files[w]->Get("fRMSSpectrumIn"))))     fRMSSpectrumIn->Add(p);
+            if(fRMSSpectrumOut && (p = dynamic_cast<TProfile*>(files[w]->Get("fRMSSpectrumOut"))))   fRMSSpectrumOut->Add(p);
+            if(fRMSRatio && (p = dynamic_cast<TProfile*>(files[w]->Get("fRMSRatio"))))              fRMSRatio->Add(p);
+            files[w]->Close();
+            delete files[w];
+            gSystem->Unlink(Form("%s_worker%i.root", base.Data(), w));
+        }
+    }
+    WriteVariationSummary(first);
+
+    // restore the configuration
+    fUnfoldingAlgorithm = algorithm;
+    fPrior              = priorType;
+    fSVDRegIn           = svdRegIn;
+    fSVDRegOut          = svdRegOut;
+    fBayesianIterIn     = bayesianIterIn;
+    fBayesianIterOut    = bayesianIterOut;
+    fBetaIn             = betaIn;
+    fBetaOut            = betaOut;
+    fBinsTrue           = binsTrue;
+    fBinsRec            = binsRec;
+    fBootstrap          = bootstrap;
+    fListPrefix         = first + n - 1;
+    fShareResponse      = kFALSE;
+    delete fResponseCache;
+    fResponseCache      = 0x0;
+}
+//_____________________________________________________________________________
+void AliJetFlowTools::WriteVariationSummary(Int_t prefix)
+{
+    // one entry per variation, with the name of its output list and whether the unfolding converged
+    fOutputFile->cd();
+    TTree* summary = new TTree(Form("VariationSummary_%i", prefix), "variations of MakeVariations()");
+    TString list;
+    Int_t algorithm(0), priorType(0), regIn(0), regOut(0), replica(0), convergedIn(0), convergedOut(0);
+    Double_t betaIn(0), betaOut(0);
+    summary->Branch("list", &list);
+    summary->Branch("algorithm", &algorithm, "algorithm/I");
+    summary->Branch("prior", &priorType, "prior/I");
+    summary->Branch("regIn", &regIn, "regIn/I");
+    summary->Branch("regOut", &regOut, "regOut/I");
+    summary->Branch("betaIn", &betaIn, "betaIn/D");
+    summary->Branch("betaOut", &betaOut, "betaOut/D");
+    summary->Branch("replica", &replica, "replica/I");
+    summary->Branch("convergedIn", &convergedIn, "convergedIn/I");
+    summary->Branch("convergedOut", &convergedOut, "convergedOut/I");
+    for(UInt_t i(0); i < fVariations.size(); i++) {
+        const Variation& v(fVariations[i]);
+        list            = Form("%i__%s", prefix + i, v.fName.Data());
+        algorithm       = v.fAlgorithm;
+        priorType       = v.fPrior;
+        regIn           = v.fRegIn;
+        regOut          = v.fRegOut;
+        betaIn          = v.fBetaIn;
+        betaOut         = v.fBetaOut;
+        replica         = v.fReplica;
+        // -1: no output list, else the convergence flags saved by SaveConfiguration()
+        convergedIn     = -1;
+        convergedOut    = -1;
+        TDirectory* dir(fOutputFile->GetDirectory(list.Data()));
+        TH1* config(dir ? dynamic_cast<TH1*>(dir->Get("UnfoldingConfiguration")) : 0x0);
+        if(config) {
+            convergedIn  = TMath::Nint(config->GetBinContent(4));
+            convergedOut = TMath::Nint(config->GetBinContent(5));
+        }
+        summary->Fill();
+    }
+    summary->Write();
+}
+//_____________________________________________________________________________
+void AliJetFlowTools::CopyDirectory(TDirectory* source, TDirectory* target)
+{
+    // recursive copy of the contents of a directory
+    if(!source || !target) return;
+    TIter next(source->GetListOfKeys());
+    TKey* key(0x0);
+    while((key = (TKey*)next())) {
+        if(key->IsFolder() && TClass::GetClass(key->GetClassName())->InheritsFrom(TDirectory::Class())) {
+            CopyDirectory(source->GetDirectory(key->GetName()), target->mkdir(key->GetName()));
+            continue;
+        }
+        TObject* object(key->ReadObj());
+        target->WriteTObject(object, key->GetName());
+        delete object;
+    }
+}
+//_____________________________________________________________________________
 TH1D* AliJetFlowTools::UnfoldWrapper(
         const TH1D* measuredJetSpectrum,        // truncated raw jets (same binning as pt rec of response) 
         const TH2D* resizedResponse,            // response matrix
@@ -1260,7 +1543,7 @@ TH1D* AliJetFlowTools::GetPrior(
                 // for the prior, do not re-bin the output
                 TH1D* measuredJetSpectrumChi2 = RebinTH1D((!strcmp("in", suffix.Data())) ? fSpectrumIn : fSpectrumOut, fBinsRec, TString("resized_chi2"), kFALSE);
                 TH1D* measuredJetSpectrumTrueBinsChi2 = RebinTH1D((!strcmp("in", suffix.Data())) ? fSpectrumIn : fSpectrumOut, fBinsTruePrior, TString("out"), kFALSE);
-                TH2D* resizedResponseChi2(RebinTH2D((!strcmp("in", suffix.Data())) ? fFullResponseIn : fFullResponseOut,fBinsTruePrior, fBinsRec, TString("chi2")));
+                TH2D* resizedResponseChi2(GetResizedResponse((!strcmp("in", suffix.Data())) ? fFullResponseIn : fFullResponseOut,fBinsTruePrior, fBinsRec, TString("chi2")));
                 TH1D* kinematicEfficiencyChi2(resizedResponseChi2->ProjectionX());
                 kinematicEfficiencyChi2->SetNameTitle("kin_eff_chi2","kin_eff_chi2");
                 for(Int_t i(0); i < kinematicEfficiencyChi2->GetXaxis()->GetNbins(); i++) kinematicEfficiencyChi2->SetBinError(1+i, 0.);
@@ -18,6 +18,7 @@ class TArrayD;
 class TGraph;
 class TGraphErrors;
 class TObjArray;
+class TDirectory;
 // aliroot forward declarations
 class AliAnaChargedJetResponseMaker;
 class AliUnfolding;
@@ -35,6 +36,8 @@ class AliUnfolding;
 #include "TF1.h"
 #include "TH1D.h"
 #include "TMath.h"
+// std includes
+#include <vector>
 // define the following variable to build with debug flags
 // #define ALIJETFLOWTOOLS_DEBUG_FLAG
 
@@ -192,6 +195,23 @@ class AliJetFlowTools {
         // main function. buffers about 5mb per call!
         void            Make(TH1* customIn = 0x0, TH1* customOut = 0x0);
         void            MakeAU();       // test function, use with caution (09012014)
+        // batch of variations for systematic studies. the response is built once and shared by
+        // all variations, which are unfolded in 'workers' forked processes (each with its own
+        // copy of the unfolding machinery, which is not thread safe). every variation gets its
+        // own output list, the tree VariationSummary_<first list> indexes them
+        Int_t           AddVariation(
+                TString name,
+                unfoldingAlgorithm ua,
+                prior p,
+                Int_t regIn,                    // svd regularization or bayesian iterations, in plane
+                Int_t regOut,                   // same, out of plane
+                Double_t betaIn = .1,           // chi2 regularization strength, in plane
+                Double_t betaOut = .1,          // chi2 regularization strength, out of plane
+                TArrayD* binsTrue = 0x0,        // optional, different true binning
+                TArrayD* binsRec = 0x0);        // optional, different rec binning
+        void            AddBootstrapReplicas(Int_t n, UInt_t seed = 1); // n resampled copies of the current configuration
+        void            ClearVariations()                       {fVariations.clear();}
+        void            MakeVariations(Int_t workers = 1);
         void            Finish() {
             fOutputFile->cd();
             if(fRMSSpectrumIn)  fRMSSpectrumIn->Write();
@@ -385,6 +405,24 @@ TLatex* tex = new TLatex(xmin, ymax, string.Data());
         static void     SetMinuitStrategy(Double_t s)   {AliUnfolding::SetMinuitStrategy(s);}
         static void     SetDebug(Int_t d)               {AliUnfolding::SetDebug(d);}
     private:
+        struct Variation {                              // settings of one variation of MakeVariations()
+            TString             fName;                  // name of the output list
+            unfoldingAlgorithm  fAlgorithm;             // unfolding algorithm
+            prior               fPrior;                 // prior
+            Int_t               fRegIn;                 // svd regularization or bayesian iterations, in plane
+            Int_t               fRegOut;                // svd regularization or bayesian iterations, out of plane
+            Double_t            fBetaIn;                // chi2 regularization, in plane
+            Double_t            fBetaOut;               // chi2 regularization, out of plane
+            TArrayD*            fBinsTrue;              // true binning, 0x0 for the current one
+            TArrayD*            fBinsRec;               // rec binning, 0x0 for the current one
+            Int_t               fReplica;               // bootstrap replica, -1 for the measured spectra
+            UInt_t              fSeed;                  // seed of the bootstrap replica
+        };
+        Bool_t          PrepareFullResponse();
+        TH2D*           GetResizedResponse(TH2D* full, TArrayD* binsTrue, TArrayD* binsRec, TString suffix);
+        void            RunVariation(const Variation& v, Int_t prefix);
+        void            WriteVariationSummary(Int_t prefix);
+        static void     CopyDirectory(TDirectory* source, TDirectory* target);
         Bool_t          PrepareForUnfolding(TH1* customIn = 0x0, TH1* customOut = 0x0); 
         Bool_t          PrepareForUnfolding(Int_t low, Int_t up);
         TH1D*           GetPrior(                       const TH1D* measuredJetSpectrum,
@@ -577,6 +615,9 @@ TLatex* tex = new TLatex(xmin, ymax, string.Data());
         TH1*                    fUnfoldedSpectrumIn;    // unfolded spectrum in plane
         TH1*                    fUnfoldedSpectrumOut;   // unfolded spectrum out of plane
         Int_t                   fHarmonic;              // vn harmonic
+        std::vector<Variation>  fVariations;            // variations for MakeVariations()
+        Bool_t                  fShareResponse;         // full response prepared once by MakeVariations()
+        TList*                  fResponseCache;         // rebinned responses shared by the variations
 
         static TArrayD*         gV2;                    // internal use only, do not touch these
         static TArrayD*         gStat;                  // internal use only, do not touch these
@@ -898,6 +898,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine() :
   fD0Extended(kFALSE),
   fRandomGen(0),
   fTrackEfficiency(0),
+  fReclusterNeighbourhood(0),
   fRejectISR(kFALSE),
   fDataSlotNumber(-1),
   fTree(0),
@@ -944,6 +945,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(ECandidateType_t type,
   fD0Extended(kFALSE),
   fRandomGen(0),
   fTrackEfficiency(0),
+  fReclusterNeighbourhood(0),
   fDataSlotNumber(-1),
   fTree(0),
   fCurrentDmesonJetInfo(0),
@@ -986,6 +988,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(const AliAnalysisTaskD
   fD0Extended(source.fD0Extended),
   fRandomGen(source.fRandomGen),
   fTrackEfficiency(source.fTrackEfficiency),
+  fReclusterNeighbourhood(source.fReclusterNeighbourhood),
   fDataSlotNumber(-1),
   fTree(0),
   fCurrentDmesonJetInfo(0),
@@ -1308,7 +1311,7 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::ExtractRecoDecayAttributes(con
 Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::ExtractD0Attributes(const AliAODRecoDecayHF2Prong* Dcand, AliDmesonJetInfo& DmesonJet, UInt_t i)
 {
   AliDebug(10,"Checking if D0 meson is selected");
-  Int_t isSelected = fRDHFCuts->IsSelected(const_cast<AliAODRecoDecayHF2Prong*>(Dcand), AliRDHFCuts::kAll, fAodEvent);
+  Int_t isSelected = fRDHFCuts->IsSelectedShared(const_cast<AliAODRecoDecayHF2Prong*>(Dcand), AliRDHFCuts::kAll, fAodEvent);
   if (isSelected == 0) return kFALSE;
 
   Int_t MCtruthPdgCode = 0;
@@ -1418,7 +1421,7 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::ExtractD0Attributes(const AliA
 Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::ExtractDstarAttributes(const AliAODRecoCascadeHF* DstarCand, AliDmesonJetInfo& DmesonJet, UInt_t i)
 {
   AliDebug(10,"Checking if D* meson is selected");
-  Int_t isSelected = fRDHFCuts->IsSelected(const_cast<AliAODRecoCascadeHF*>(DstarCand), AliRDHFCuts::kAll, fAodEvent);
+  Int_t isSelected = fRDHFCuts->IsSelectedShared(const_cast<AliAODRecoCascadeHF*>(DstarCand), AliRDHFCuts::kAll, fAodEvent);
   if (isSelected == 0) return kFALSE;
 
   if ((i == 1 && DstarCand->Charge()>0) || (i == 0 && DstarCand->Charge()<0) || i > 1) return kFALSE; // only one mass hypothesis for the D*
@@ -1627,6 +1630,12 @@ void AliAnalysisTaskDmesonJets::AnalysisEngine::RunDetectorLevelAnalysis()
   for (auto& def : fJetDefinitions) maxJetPt[&def] = 0;
   Double_t maxDPt = 0;
 
+  // The jet constituents of the event are selected once per jet definition,
+  // each candidate then only takes those in its neighbourhood
+  if (fReclusterNeighbourhood > 0) {
+    for (auto& def : fJetDefinitions) CollectInputVectors(def);
+  }
+
   Int_t nAccCharm[3] = {0};
   for (Int_t icharm = 0; icharm < nD; icharm++) {   //loop over D candidates
     AliAODRecoDecayHF2Prong* charmCand = static_cast<AliAODRecoDecayHF2Prong*>(fCandidateArray->At(icharm)); // D candidates
@@ -1744,8 +1753,10 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Pron
     for (auto track_cont : fTrackContainers) {
       AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
       if (hftrack_cont) hftrack_cont->SetDMesonCandidate(Dcand);
-      hname = TString::Format("%s/%s/fHistTrackRejectionReason", GetName(), jetDef.GetName());
-      AddInputVectors(track_cont, 100, static_cast<TH2*>(fHistManager->FindObject(hname)), fTrackEfficiency);
+      if (fReclusterNeighbourhood <= 0) {
+        hname = TString::Format("%s/%s/fHistTrackRejectionReason", GetName(), jetDef.GetName());
+        AddInputVectors(track_cont, 100, static_cast<TH2*>(fHistManager->FindObject(hname)), fTrackEfficiency);
+      }
 
       if (hftrack_cont) {
         hname = TString::Format("%s/%s/fHistDMesonDaughterNotInJet", GetName(), jetDef.GetName());
@@ -1759,7 +1770,10 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Pron
     }
   }
 
-  if (jetDef.fJetType != AliJetContainer::kChargedJet) {
+  if (fReclusterNeighbourhood > 0) {
+    AddNeighbourhoodInputVectors(DmesonJet, jetDef);
+  }
+  else if (jetDef.fJetType != AliJetContainer::kChargedJet) {
     for (auto clus_cont : fClusterContainers) {
       hname = TString::Format("%s/%s/fHistClusterRejectionReason", GetName(), jetDef.GetName());
       AddInputVectors(clus_cont, -100, static_cast<TH2*>(fHistManager->FindObject(hname)));
@@ -1836,6 +1850,97 @@ void AliAnalysisTaskDmesonJets::AnalysisEngine::AddInputVectors(AliEmcalContaine
   }
 }
 
+/// Selects the jet constituents of the current event for a jet definition
+/// and stores them in the jet definition. The daughters of the D meson
+/// candidates are kept here and removed for each candidate in AddNeighbourhoodInputVectors().
+/// The rejection reason histograms are filled once per event.
+///
+/// \param jetDef Jet definition
+void AliAnalysisTaskDmesonJets::AnalysisEngine::CollectInputVectors(AliHFJetDefinition& jetDef)
+{
+  TString hname;
+
+  jetDef.fInputs.clear();
+  jetDef.fInputUids.clear();
+  jetDef.fInputObjects.clear();
+
+  if (jetDef.fJetType != AliJetContainer::kNeutralJet) {
+    for (auto track_cont : fTrackContainers) {
+      AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
+      if (hftrack_cont) hftrack_cont->SetDMesonCandidate(nullptr);
+      hname = TString::Format("%s/%s/fHistTrackRejectionReason", GetName(), jetDef.GetName());
+      CollectInputVectors(track_cont, 100, jetDef, static_cast<TH2*>(fHistManager->FindObject(hname)), fTrackEfficiency);
+    }
+  }
+
+  if (jetDef.fJetType != AliJetContainer::kChargedJet) {
+    for (auto clus_cont : fClusterContainers) {
+      hname = TString::Format("%s/%s/fHistClusterRejectionReason", GetName(), jetDef.GetName());
+      CollectInputVectors(clus_cont, -100, jetDef, static_cast<TH2*>(fHistManager->FindObject(hname)));
+    }
+  }
+}
+
+/// Stores the accepted particles contained in the container in the jet definition
+///
+/// \param cont Pointer to a valid AliEmcalContainer object
+void AliAnalysisTaskDmesonJets::AnalysisEngine::CollectInputVectors(AliEmcalContainer* cont, Int_t offset, AliHFJetDefinition& jetDef, TH2* rejectHist, Double_t eff)
+{
+  auto itcont = cont->all_momentum();
+  for (AliEmcalIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+    UInt_t rejectionReason = 0;
+    if (!cont->AcceptObject(it.current_index(), rejectionReason)) {
+      if (rejectHist) rejectHist->Fill(AliEmcalContainer::GetRejectionReasonBitPosition(rejectionReason), it->first.Pt());
+      continue;
+    }
+    if (fRandomGen && eff > 0 && eff < 1) {
+      Double_t rnd = fRandomGen->Rndm();
+      if (eff < rnd) {
+        if (rejectHist) rejectHist->Fill(6, it->first.Pt());
+        continue;
+      }
+    }
+    Int_t uid = offset >= 0 ? it.current_index() + offset: -it.current_index() - offset;
+    jetDef.fInputs.push_back(it->first);
+    jetDef.fInputUids.push_back(uid);
+    jetDef.fInputObjects.push_back(it->second);
+  }
+}
+
+/// Adds the jet constituents stored in the jet definition that are within
+/// fReclusterNeighbourhood * R of the D meson candidate into the fastjet wrapper,
+/// except the daughters of the candidate (taken from the HF track containers).
+///
+/// \param DmesonJet D meson candidate
+/// \param jetDef Jet definition
+void AliAnalysisTaskDmesonJets::AnalysisEngine::AddNeighbourhoodInputVectors(const AliDmesonJetInfo& DmesonJet, const AliHFJetDefinition& jetDef)
+{
+  std::vector<const TObjArray*> daughterLists;
+  if (jetDef.fJetType != AliJetContainer::kNeutralJet) {
+    for (auto track_cont : fTrackContainers) {
+      AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
+      if (hftrack_cont) daughterLists.push_back(&hftrack_cont->GetDaughterList());
+    }
+  }
+
+  Double_t maxDistance = fReclusterNeighbourhood * jetDef.fRadius;
+  for (UInt_t i = 0; i < jetDef.fInputs.size(); i++) {
+    const AliTLorentzVector& part = jetDef.fInputs[i];
+    if (DmesonJet.fD.DeltaR(part) >= maxDistance) continue;
+
+    Bool_t isDaughter = kFALSE;
+    for (auto daughters : daughterLists) {
+      if (daughters->FindObject(jetDef.fInputObjects[i])) {
+        isDaughter = kTRUE;
+        break;
+      }
+    }
+    if (isDaughter) continue;
+
+    fFastJetWrapper->AddInputVector(part.Px(), part.Py(), part.Pz(), part.E(), jetDef.fInputUids[i]);
+  }
+}
+
 /// Run a particle level analysis
 void AliAnalysisTaskDmesonJets::AnalysisEngine::RunParticleLevelAnalysis()
 {
@@ -2531,6 +2636,7 @@ AliAnalysisTaskDmesonJets::AliAnalysisTaskDmesonJets() :
   fRejectISR(kFALSE),
   fJetAreaType(fastjet::active_area),
   fJetGhostArea(0.005),
+  fReclusterNeighbourhood(0),
   fMCContainer(0),
   fAodEvent(0),
   fFastJetWrapper(0)
@@ -2553,6 +2659,7 @@ AliAnalysisTaskDmesonJets::AliAnalysisTaskDmesonJets(const char* name, Int_t nOu
   fRejectISR(kFALSE),
   fJetAreaType(fastjet::active_area),
   fJetGhostArea(0.005),
+  fReclusterNeighbourhood(0),
   fMCContainer(0),
   fAodEvent(0),
   fFastJetWrapper(0)
@@ -2980,6 +3087,7 @@ void AliAnalysisTaskDmesonJets::ExecOnce()
     params.fAodEvent = fAodEvent;
     params.fFastJetWrapper = fFastJetWrapper;
     params.fTrackEfficiency = fTrackEfficiency;
+    params.fReclusterNeighbourhood = fReclusterNeighbourhood;
     params.fRejectISR = fRejectISR;
     params.fRandomGen = rnd;
 
@@ -455,6 +455,9 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     TString                   fRhoName       ; ///<  Name of the object that holds the average background value
     AliRhoParameter          *fRho           ; ///<  Object that holds the average background value
     std::vector<AliJetInfo>   fJets          ; //!<! Inclusive jets reconstructed in the current event (includes D meson candidate daughters, if any)
+    std::vector<AliTLorentzVector> fInputs        ; //!<! Accepted jet constituents of the current event (only used with the neighbourhood reclustering)
+    std::vector<Int_t>             fInputUids     ; //!<! Fastjet user index of the accepted jet constituents
+    std::vector<const TObject*>    fInputObjects  ; //!<! Accepted tracks (0 for clusters), used to remove the D meson candidate daughters
 
   private:
     /// \cond CLASSIMP
@@ -530,6 +533,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Bool_t FillTree(Bool_t applyKinCuts);
 
     void   SetTrackEfficiency(Double_t t)      { fTrackEfficiency       = t; }
+    void   SetReclusterNeighbourhood(Double_t f) { fReclusterNeighbourhood = f; }
     void   AssignDataSlot(Int_t n)             { fDataSlotNumber        = n; }
     Int_t  GetDataSlotNumber() const           { return fDataSlotNumber    ; }
 
@@ -574,6 +578,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Bool_t                             fD0Extended            ; ///<  Store extended information in the tree (only for D0 mesons)
     TRandom                           *fRandomGen             ; //!<! Random number generator
     Double_t                           fTrackEfficiency       ; //!<! Artificial tracking inefficiency (0...1) -> set automatically at ExecOnce by AliAnalysisTaskDmesonJets
+    Double_t                           fReclusterNeighbourhood; //!<! If > 0, jet finding for each candidate only with the constituents within this distance (in units of R) -> set automatically at ExecOnce by AliAnalysisTaskDmesonJets
     Bool_t                             fRejectISR             ; //!<! Reject initial state radiation
     Int_t                              fDataSlotNumber        ; //!<! Data slot where the tree output is posted
     TTree                             *fTree                  ; //!<! Output tree
@@ -595,6 +600,9 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   private:
 
     void                AddInputVectors(AliEmcalContainer* cont, Int_t offset, TH2* rejectHist=0, Double_t eff=0.);
+    void                CollectInputVectors(AliHFJetDefinition& jetDef);
+    void                CollectInputVectors(AliEmcalContainer* cont, Int_t offset, AliHFJetDefinition& jetDef, TH2* rejectHist=0, Double_t eff=0.);
+    void                AddNeighbourhoodInputVectors(const AliDmesonJetInfo& DmesonJet, const AliHFJetDefinition& jetDef);
     void                SetCandidateProperties(Double_t range);
     AliAODMCParticle*   MatchToMC() const;
     void                RunDetectorLevelAnalysis();
@@ -634,6 +642,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   void SetRejectISR(Bool_t b)                     { fRejectISR          = b ; }
   void SetJetArea(Int_t type,
       Double_t garea = 0.005)                     { fJetAreaType        = type; fJetGhostArea = garea; }
+  void SetReclusterNeighbourhood(Double_t f)      { fReclusterNeighbourhood = f; }
 
   virtual void         UserCreateOutputObjects();
   virtual void         ExecOnce();
@@ -666,6 +675,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   Bool_t               fRejectISR                 ; ///<  Reject initial state radiation
   Int_t                fJetAreaType               ; ///<  Jet area type
   Double_t             fJetGhostArea              ; ///<  Area of the ghost particles
+  Double_t             fReclusterNeighbourhood    ; ///<  If > 0, jet finding for each D meson candidate only with the constituents within this distance (in units of R)
   AliHFAODMCParticleContainer* fMCContainer       ; //!<! MC particle container
   AliAODEvent         *fAodEvent                  ; //!<! AOD event
   AliFJWrapper        *fFastJetWrapper            ; //!<! Fastjet wrapper
@@ -676,7 +686,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   AliAnalysisTaskDmesonJets& operator=(const AliAnalysisTaskDmesonJets& source);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskDmesonJets, 9);
+  ClassDef(AliAnalysisTaskDmesonJets, 10);
   /// \endcond
 };
 
@@ -1106,7 +1106,7 @@ void AliAnalysisTaskFlavourJetCorrelations::FillHistogramsD0JetCorr(AliAODRecoDe
       point[8]=static_cast<Double_t>(bJetInEMCalAcc ? 1 : 0);
 
    }
-    Int_t isselected=fCuts->IsSelected(candidate,AliRDHFCuts::kAll,aodEvent);
+    Int_t isselected=fCuts->IsSelectedShared(candidate,AliRDHFCuts::kAll,aodEvent);
     if(isselected==1 || isselected==3)
     {
 
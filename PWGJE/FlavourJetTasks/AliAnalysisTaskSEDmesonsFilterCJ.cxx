@@ -607,7 +607,7 @@ if(fUseMCInfo && fBuildRMEff){
         
         //candidate selected by cuts and PID
         Int_t isSelected = 0;
-        isSelected = fCuts->IsSelected(charmCand, AliRDHFCuts::kAll, fAodEvent); //selected
+        isSelected = fCuts->IsSelectedShared(charmCand, AliRDHFCuts::kAll, fAodEvent); //selected
         if (!isSelected) break;
 
         fHistStat->Fill(5);
@@ -685,7 +685,7 @@ else {
 
     
     //candidate selected by cuts and PID
-    isSelected = fCuts->IsSelected(charmCand, AliRDHFCuts::kAll, fAodEvent); //selected
+    isSelected = fCuts->IsSelectedShared(charmCand, AliRDHFCuts::kAll, fAodEvent); //selected
     if (!isSelected) continue;
 
     if (fCandidateType == kDstartoKpipi) {
@@ -1104,7 +1104,7 @@ void AliAnalysisTaskSEDmesonsFilterCJ::FillDstarSideBands(AliAODRecoCascadeHF* d
   // Fills the array of Dstar side band candidates.
 
   //select by track cuts the side band candidates (don't want mass cut)
-  Int_t isSelected = fCuts->IsSelected(dstar, AliRDHFCuts::kTracks, fAodEvent);
+  Int_t isSelected = fCuts->IsSelectedShared(dstar, AliRDHFCuts::kTracks, fAodEvent);
   if (!isSelected) return;
 
   //add a reasonable cut on the invariant mass (e.g. (+-2\sigma, +-10 \sigma), with \sigma = fSigmaD0[bin])
@@ -7,6 +7,7 @@
 
 #include "AliPicoV0RD.h"
 #include "AliPicoV0MC.h"
+#include "AliPicoV0Candidates.h"
 #include "AliPicoHeaderV0.h"
 
 #include "AliAnalysisTaskSEPicoV0Filter.h"
@@ -21,6 +22,7 @@ fMult(""),
 fMultEstDef(""),
 fCutMinMult(0.),
 fCutMaxMult(0.),
+fV0Mask(0),
 fV0s(nullptr),
 fPicoHeader(nullptr),
 fPicoV0sClArr(nullptr),
@@ -39,6 +41,7 @@ fMult(""),
 fMultEstDef(""),
 fCutMinMult(-99999.),
 fCutMaxMult(999999.),
+fV0Mask(0),
 fV0s(nullptr),
 fPicoHeader(nullptr),
 fPicoV0sClArr(nullptr),
@@ -177,8 +180,21 @@ void AliAnalysisTaskSEPicoV0Filter::UserExec(Option_t */*opt*/)
 //=============================================================================
 
   auto l(fPicoV0sClArr->GetEntriesFast());
+  const auto pCands(fV0Mask ? AliPicoV0Candidates::FindInEvent(InputEvent()) : nullptr);
+  const auto nLoop(pCands ? pCands->GetNCandidates() : nV0s);
+
+  for (auto j=0; j<nLoop; ++j) {
+    auto i(j);
+    if (pCands) {
+      if (!(pCands->Mask(j) & fV0Mask)) continue;
+      i = pCands->PicoIndex(j);
+    } else if (fV0Mask) {
+      const auto pV0(static_cast<AliPicoV0*>(fV0s->At(i))); if (!pV0) continue;
+      if (!((pV0->AliPicoV0::IsKshort() && (fV0Mask & AliPicoBase::kKshort)) ||
+            (pV0->AliPicoV0::IsLambda() && (fV0Mask & AliPicoBase::kLambda)) ||
+            (pV0->AliPicoV0::IsAntiLa() && (fV0Mask & AliPicoBase::kAntiLambda)))) continue;
+    }
 
-  for (auto i=0; i<nV0s; ++i) {
     if (fIsMC) {
       const auto pV0(static_cast<AliPicoV0MC*>(fV0s->At(i))); if (!pV0) continue;
       new ((*fPicoV0sClArr)[l++]) AliPicoV0MC(*pV0);
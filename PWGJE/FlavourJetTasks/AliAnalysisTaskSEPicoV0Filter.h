@@ -26,6 +26,7 @@ class AliAnalysisTaskSEPicoV0Filter : public AliAnalysisTaskSE {
   virtual void Terminate(Option_t *opt);
 
   void SetAnaInfoMC(Bool_t b=kTRUE) { fIsMC = b; }
+  void SetV0Mask(UInt_t w) { fV0Mask = w; }  // keep only these species (AliPicoBase::kKshort...), 0: all
 
   void AddMultEsti(const TString s) {
     if (fMult.IsNull()) {
@@ -59,13 +60,15 @@ class AliAnalysisTaskSEPicoV0Filter : public AliAnalysisTaskSE {
   Double_t fCutMinMult; //
   Double_t fCutMaxMult; //
 
+  UInt_t fV0Mask; //
+
   TClonesArray *fV0s; //!
   AliPicoHeaderV0 *fPicoHeader; //!
 
   TClonesArray *fPicoV0sClArr; //!
   TList *fListUserOutputs;     //!
 
-  ClassDef(AliAnalysisTaskSEPicoV0Filter, 2);
+  ClassDef(AliAnalysisTaskSEPicoV0Filter, 3);
 };
 
 #endif
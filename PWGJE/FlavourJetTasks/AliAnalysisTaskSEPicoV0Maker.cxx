@@ -54,6 +54,7 @@
 #include "AliPicoBase.h"
 #include "AliPicoV0RD.h"
 #include "AliPicoV0MC.h"
+#include "AliPicoV0Candidates.h"
 #include "AliAnalysisTaskSEPicoV0Maker.h"
 
 ClassImp(AliAnalysisTaskSEPicoV0Maker)
@@ -104,6 +105,7 @@ fRespoPID(nullptr),
 fEventAcptMask(0),
 fMultEsti(),
 fPicoV0sClArr(nullptr),
+fV0Cands(nullptr),
 fOutputListEH(nullptr),
 fOutputListMC(nullptr)
 {
@@ -159,6 +161,7 @@ fRespoPID(nullptr),
 fEventAcptMask(0),
 fMultEsti(),
 fPicoV0sClArr(nullptr),
+fV0Cands(nullptr),
 fOutputListEH(nullptr),
 fOutputListMC(nullptr)
 {
@@ -184,6 +187,7 @@ AliAnalysisTaskSEPicoV0Maker::~AliAnalysisTaskSEPicoV0Maker()
   if (fRespoPID) { delete fRespoPID; fRespoPID = nullptr; }
 
   if (fPicoV0sClArr) { delete fPicoV0sClArr; fPicoV0sClArr = nullptr; }
+  if (fV0Cands)      { delete fV0Cands;      fV0Cands      = nullptr; }
   if (fOutputListEH) { delete fOutputListEH; fOutputListEH = nullptr; }
   if (fOutputListMC) { delete fOutputListMC; fOutputListMC = nullptr; }
 }
@@ -220,6 +224,13 @@ void AliAnalysisTaskSEPicoV0Maker::UserCreateOutputObjects()
     fPicoV0sClArr = new TClonesArray("AliPicoV0RD");
     fPicoV0sClArr->SetName("PicoV0s");
   }
+
+  if (fV0Cands) {
+    delete fV0Cands;
+    fV0Cands = nullptr;
+  }
+
+  fV0Cands = new AliPicoV0Candidates("PicoV0Candidates");
 //=============================================================================
 
   if (fOutputListEH) {
@@ -260,6 +271,9 @@ void AliAnalysisTaskSEPicoV0Maker::UserExec(Option_t */*opt*/)
 
   fPicoV0sClArr->Delete();
   if (!(InputEvent()->FindListObject("PicoV0s"))) InputEvent()->AddObject(fPicoV0sClArr);
+
+  fV0Cands->Clear();
+  if (!(InputEvent()->FindListObject("PicoV0Candidates"))) InputEvent()->AddObject(fV0Cands);
 //=============================================================================
 
   if (IsEventNotAcpt()) return;
@@ -347,6 +361,7 @@ void AliAnalysisTaskSEPicoV0Maker::FillPicoV0s()
       pV0RD->FillKshortPtInvM(hKshortPtInvM);
       pV0RD->FillLambdaPtInvM(hLambdaPtInvM);
       pV0RD->FillAntiLaPtInvM(hAntiLaPtInvM);
+      fV0Cands->AddCandidate(iV0, nAt, *pV0RD);
       new ((*fPicoV0sClArr)[nAt++]) AliPicoV0RD(*pV0RD);
       delete pV0RD; pV0RD=nullptr;
     }
@@ -355,6 +370,7 @@ void AliAnalysisTaskSEPicoV0Maker::FillPicoV0s()
       pV0MC->FillKshortPtInvM(hKshortPtInvM);
       pV0MC->FillLambdaPtInvM(hLambdaPtInvM);
       pV0MC->FillAntiLaPtInvM(hAntiLaPtInvM);
+      fV0Cands->AddCandidate(iV0, nAt, *pV0MC);
       new ((*fPicoV0sClArr)[nAt++]) AliPicoV0MC(*pV0MC);
       delete pV0MC; pV0MC=nullptr;
     }
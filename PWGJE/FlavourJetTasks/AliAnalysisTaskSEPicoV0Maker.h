@@ -22,6 +22,7 @@ class AliESDEvent;
 class AliPIDResponse;
 class AliPicoV0RD;
 class AliPicoV0MC;
+class AliPicoV0Candidates;
 
 class AliAnalysisTaskSEPicoV0Maker : public AliAnalysisTaskSE {
 
@@ -164,12 +165,13 @@ class AliAnalysisTaskSEPicoV0Maker : public AliAnalysisTaskSE {
 //=============================================================================
 
   TClonesArray *fPicoV0sClArr;  //!
+  AliPicoV0Candidates *fV0Cands;  //! packed candidate table, published as "PicoV0Candidates"
 
   TList *fOutputListEH;  //!
   TList *fOutputListMC;  //!
 //=============================================================================
 
-  ClassDef(AliAnalysisTaskSEPicoV0Maker, 6)
+  ClassDef(AliAnalysisTaskSEPicoV0Maker, 7)
 };
 
 #endif
@@ -11,6 +11,8 @@ class TLorentzVector;
 
 class AliPicoV0 : public TObject {
 
+  friend class AliPicoV0Candidates;
+
  public :
 
   AliPicoV0();
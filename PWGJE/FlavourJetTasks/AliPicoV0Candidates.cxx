@@ -0,0 +1,108 @@
+/**************************************************************************
+ * Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////
+//
+// Event-level table of the V0 candidates selected by
+// AliAnalysisTaskSEPicoV0Maker, published in the input event
+// next to "PicoV0s": one row per candidate with the V0 index,
+// the selection bits and the topological variables, packed,
+// so that the consumers can select without re-deriving the
+// V0 topology or touching the pico objects.
+//
+/////////////////////////////////////////////////////////////
+
+#include <TLorentzVector.h>
+
+#include "AliVEvent.h"
+
+#include "AliPicoV0.h"
+#include "AliPicoV0Candidates.h"
+
+ClassImp(AliPicoV0Candidates)
+
+//_____________________________________________________________________________
+AliPicoV0Candidates::AliPicoV0Candidates(const char *name) :
+TNamed(name, "packed V0 candidates"),
+fV0Index(),
+fPicoIndex(),
+fMask(),
+fVars()
+{
+//
+//  AliPicoV0Candidates::AliPicoV0Candidates
+//
+}
+
+//_____________________________________________________________________________
+void AliPicoV0Candidates::Clear(Option_t */*opt*/)
+{
+//
+//  AliPicoV0Candidates::Clear, keeps the capacity
+//
+
+  fV0Index.clear();
+  fPicoIndex.clear();
+  fMask.clear();
+  fVars.clear();
+
+  return;
+}
+
+//_____________________________________________________________________________
+void AliPicoV0Candidates::AddCandidate(Int_t iV0, Int_t iPico, const AliPicoV0 &v0)
+{
+//
+//  AliPicoV0Candidates::AddCandidate
+//
+
+  fV0Index.push_back(iV0);
+  fPicoIndex.push_back(iPico);
+  fMask.push_back(v0.fMask);
+
+  const auto n(fVars.size());
+  fVars.resize(n+kNVars);
+  auto d(&fVars[n]);
+
+  d[kV0Radius]        = (Float_t)v0.fV0Radius;
+  d[kV0CosPA]         = (Float_t)v0.fV0CosPA;
+  d[kV0DistToPVoverP] = (Float_t)v0.fV0DistToPVoverP;
+  d[kDausDCA]         = (Float_t)v0.fDausDCA;
+  d[kPosDCAtoPV]      = (Float_t)v0.fPosDCAtoPV;
+  d[kNegDCAtoPV]      = (Float_t)v0.fNegDCAtoPV;
+  d[kDauXrowsTPC]     = (Float_t)v0.fDauXrowsTPC;
+  d[kDauXrowsOverFindableClusTPC] = (Float_t)v0.fDauXrowsOverFindableClusTPC;
+  d[kV0Pt]            = (Float_t)v0.KineRD().Pt();
+  d[kRapKshort]       = (Float_t)v0.RapidityKa();
+  d[kRapLambda]       = (Float_t)v0.RapidityLa();
+  d[kInvMKshort]      = (Float_t)v0.KineKshort().M();
+  d[kInvMLambda]      = (Float_t)v0.KineLambda().M();
+  d[kInvMAntiLa]      = (Float_t)v0.KineAntiLa().M();
+  d[kPosEta]          = (Float_t)v0.fP3Pos.Eta();
+  d[kNegEta]          = (Float_t)v0.fP3Neg.Eta();
+
+  return;
+}
+
+//_____________________________________________________________________________
+AliPicoV0Candidates *AliPicoV0Candidates::FindInEvent(AliVEvent *pEvent, const char *name)
+{
+//
+//  AliPicoV0Candidates::FindInEvent, the table published by the V0 maker (if any)
+//
+
+  if (!pEvent) return nullptr;
+  return dynamic_cast<AliPicoV0Candidates*>(pEvent->FindListObject(name));
+}
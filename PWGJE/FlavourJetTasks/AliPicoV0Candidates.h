@@ -0,0 +1,69 @@
+#ifndef ALIPICOV0CANDIDATES_H
+#define ALIPICOV0CANDIDATES_H
+
+#include <vector>
+
+#include <TNamed.h>
+
+#include "AliPicoBase.h"
+
+class AliVEvent;
+class AliPicoV0;
+
+class AliPicoV0Candidates : public TNamed {
+
+ public :
+
+  enum {
+    kV0Radius = 0,     // V0 decay radius
+    kV0CosPA,          // cosine of pointing angle
+    kV0DistToPVoverP,  // decay length over momentum
+    kDausDCA,          // DCA between daughters
+    kPosDCAtoPV,       // DCA of pos. daughter to PV
+    kNegDCAtoPV,       // DCA of neg. daughter to PV
+    kDauXrowsTPC,      // min. crossed TPC rows of the daughters
+    kDauXrowsOverFindableClusTPC,  // min. crossed rows over findable clusters
+    kV0Pt,             // V0 pT
+    kRapKshort,        // rapidity, K0s hypothesis
+    kRapLambda,        // rapidity, Lambda hypothesis
+    kInvMKshort,       // inv. mass, K0s hypothesis
+    kInvMLambda,       // inv. mass, Lambda hypothesis
+    kInvMAntiLa,       // inv. mass, anti-Lambda hypothesis
+    kPosEta,           // pos. daughter eta
+    kNegEta,           // neg. daughter eta
+    kNVars
+  };
+
+  AliPicoV0Candidates(const char *name="PicoV0Candidates");
+  virtual ~AliPicoV0Candidates() {}
+
+  virtual void Clear(Option_t *opt="");
+
+  void AddCandidate(Int_t iV0, Int_t iPico, const AliPicoV0 &v0);
+
+  Int_t GetNCandidates() const { return fV0Index.size(); }
+
+  Int_t  V0Index(Int_t i)   const { return fV0Index[i];   }
+  Int_t  PicoIndex(Int_t i) const { return fPicoIndex[i]; }
+  UInt_t Mask(Int_t i)      const { return fMask[i];      }
+  Float_t Var(Int_t i, Int_t k)  const { return fVars[i*kNVars+k]; }
+  const Float_t *Vars(Int_t i)   const { return &fVars[i*kNVars]; }
+
+  Bool_t IsKshort(Int_t i) const { return ((fMask[i] & AliPicoBase::kKshort)     == AliPicoBase::kKshort);     }
+  Bool_t IsLambda(Int_t i) const { return ((fMask[i] & AliPicoBase::kLambda)     == AliPicoBase::kLambda);     }
+  Bool_t IsAntiLa(Int_t i) const { return ((fMask[i] & AliPicoBase::kAntiLambda) == AliPicoBase::kAntiLambda); }
+
+  static AliPicoV0Candidates *FindInEvent(AliVEvent *pEvent, const char *name="PicoV0Candidates");
+//=============================================================================
+
+ private :
+
+  std::vector<Int_t>   fV0Index;    // index of the V0 in the ESD/AOD
+  std::vector<Int_t>   fPicoIndex;  // index of the pico V0 in "PicoV0s"
+  std::vector<UInt_t>  fMask;       // selection bits (AliPicoBase::kKshort, kLambda, kAntiLambda)
+  std::vector<Float_t> fVars;       // kNVars variables per candidate, packed
+
+  ClassDef(AliPicoV0Candidates, 1)
+};
+
+#endif
@@ -14,6 +14,7 @@
 #pragma link C++ class AliPicoV0+;
 #pragma link C++ class AliPicoV0MC+;
 #pragma link C++ class AliPicoV0RD+;
+#pragma link C++ class AliPicoV0Candidates+;
 #pragma link C++ class AliAnalysisTaskEmcalJetV0CF+;
 #pragma link C++ class AliAnalysisTaskEmcalJetV0Filter+;
 #pragma link C++ class AliAnalysisTaskEmcalJetHF+;
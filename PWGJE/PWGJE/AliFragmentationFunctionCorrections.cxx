@@ -27,6 +27,8 @@
 #include "THnSparse.h"
 #include "TFile.h"
 #include "TDirectory.h"
+#include "TMap.h"
+#include "TObjString.h"
 #include "AliCFUnfolding.h"
 #include "AliFragmentationFunctionCorrections.h"
 #include <iostream> // OB TEST!!!
@@ -54,6 +56,8 @@ using std::fstream;
 
 ClassImp(AliFragmentationFunctionCorrections)
 
+TMap* AliFragmentationFunctionCorrections::fgInputCache = 0;
+
 //________________________________________________________________________
 AliFragmentationFunctionCorrections::AliFragmentationFunctionCorrections()
    : TObject()
@@ -1054,6 +1058,75 @@ void AliFragmentationFunctionCorrections::NormalizeBgr()
 
 }
 
+//__________________________________________________________________________________________________
+TList* AliFragmentationFunctionCorrections::GetInputList(TString strfile, TString strdir, TString strlist)
+{
+  // get input list, read from file only the first time it is requested
+  // the cache is shared by all instances, so that systematic variations 
+  // on the same raw data read the file once
+
+  TString key = strfile + ":" + strdir + ":" + strlist;
+
+  if(!fgInputCache){
+    fgInputCache = new TMap();
+    fgInputCache->SetOwnerKeyValue(kTRUE,kTRUE);
+  }
+
+  TList* list = (TList*) fgInputCache->GetValue(key);
+  if(list) return list;
+
+  TFile f(strfile,"READ");
+
+  if(!f.IsOpen()){
+    Printf("%s:%d -- error opening raw data file %s", (char*)__FILE__,__LINE__,strfile.Data());
+    return 0;
+  }
+
+  if(fDebug>0) Printf("%s:%d -- read list %s from file %s, dir %s ",(char*)__FILE__,__LINE__,strlist.Data(),strfile.Data(),strdir.Data());
+
+  if(strdir && strdir.Length()) gDirectory->cd(strdir);
+
+  if(!(list = (TList*) gDirectory->Get(strlist))){ 
+    Printf("%s:%d -- error retrieving list %s from directory %s", (char*)__FILE__,__LINE__,strlist.Data(),strdir.Data());
+    return 0;
+  }
+
+  list->SetOwner(kTRUE);
+  TIter next(list);
+  while(TObject* obj = next()){
+    if(obj->InheritsFrom(TH1::Class())) ((TH1*) obj)->SetDirectory(0);
+  }
+
+  f.Close();
+
+  fgInputCache->Add(new TObjString(key),list);
+
+  return list;
+}
+
+//__________________________________________________________________________________________________
+TObject* AliFragmentationFunctionCorrections::CloneInput(const TList* list, TString strname) const
+{
+  // private copy of cached input histo, caller takes ownership
+
+  TObject* obj = list->FindObject(strname);
+  if(!obj) return 0;
+
+  obj = obj->Clone();
+  if(obj->InheritsFrom(TH1::Class())) ((TH1*) obj)->SetDirectory(0);
+
+  return obj;
+}
+
+//__________________________________________________________________________________________________
+void AliFragmentationFunctionCorrections::ClearInputCache()
+{
+  // delete cached input lists, next read goes to file again
+
+  delete fgInputCache;
+  fgInputCache = 0;
+}
+
 //__________________________________________________________________________________________________
 void AliFragmentationFunctionCorrections::ReadRawFF(TString strfile, TString strID, TString strFFID)
 { 
@@ -1070,27 +1143,10 @@ void AliFragmentationFunctionCorrections::ReadRawFF(TString strfile, TString str
 {
   // get raw FF from input file, project in jet pt slice
   // normalization done separately 
-
-  TFile f(strfile,"READ");
-
-  if(!f.IsOpen()){
-    Printf("%s:%d -- error opening raw data file %s", (char*)__FILE__,__LINE__,strfile.Data());
-    return;
-  }
+  // input lists are cached, see GetInputList()
 
   if(fDebug>0) Printf("%s:%d -- read FF from file %s, dir %s ",(char*)__FILE__,__LINE__,strfile.Data(), strdir.Data());
 
-  gDirectory->cd(strdir);
-
-  TList* list = 0;
-  
-  if(strlist && strlist.Length()){
-    if(!(list = (TList*) gDirectory->Get(strlist))){ 
-      Printf("%s:%d -- error retrieving list %s from directory %s", (char*)__FILE__,__LINE__,strlist.Data(),strdir.Data());
-      return;
-    }
-  }
-
   TString hnameJetPt(Form("fh1FFJetPt%s",strFFID.Data()));
   TString hnameTrackPt(Form("fh2FFTrackPt%s",strFFID.Data()));
   TString hnameZ(Form("fh2FFZ%s",strFFID.Data()));
@@ -1101,17 +1157,36 @@ void AliFragmentationFunctionCorrections::ReadRawFF(TString strfile, TString str
   TH2F* fh2FFZ       = 0;
   TH2F* fh2FFXi      = 0;
   
-  if(list){
-    fh1FFJetPt   = (TH1F*) list->FindObject(hnameJetPt);
-    fh2FFTrackPt = (TH2F*) list->FindObject(hnameTrackPt);
-    fh2FFZ       = (TH2F*) list->FindObject(hnameZ);  
-    fh2FFXi      = (TH2F*) list->FindObject(hnameXi); 
+  if(strlist && strlist.Length()){
+    TList* list = GetInputList(strfile,strdir,strlist);
+    if(!list) return;
+
+    fh1FFJetPt   = (TH1F*) CloneInput(list,hnameJetPt);
+    fh2FFTrackPt = (TH2F*) CloneInput(list,hnameTrackPt);
+    fh2FFZ       = (TH2F*) CloneInput(list,hnameZ);  
+    fh2FFXi      = (TH2F*) CloneInput(list,hnameXi); 
   }
   else{
+    TFile f(strfile,"READ");
+
+    if(!f.IsOpen()){
+      Printf("%s:%d -- error opening raw data file %s", (char*)__FILE__,__LINE__,strfile.Data());
+      return;
+    }
+
+    gDirectory->cd(strdir);
+
     fh1FFJetPt   = (TH1F*) gDirectory->Get(hnameJetPt);
     fh2FFTrackPt = (TH2F*) gDirectory->Get(hnameTrackPt);
     fh2FFZ       = (TH2F*) gDirectory->Get(hnameZ);  
     fh2FFXi      = (TH2F*) gDirectory->Get(hnameXi);
+
+    if(fh1FFJetPt)   fh1FFJetPt->SetDirectory(0);
+    if(fh2FFTrackPt) fh2FFTrackPt->SetDirectory(0);
+    if(fh2FFZ)       fh2FFZ->SetDirectory(0);  
+    if(fh2FFXi)      fh2FFXi->SetDirectory(0); 
+
+    f.Close();  
   }
 
 
@@ -1120,13 +1195,6 @@ void AliFragmentationFunctionCorrections::ReadRawFF(TString strfile, TString str
   if(!fh2FFZ)      { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameZ.Data());       return; }
   if(!fh2FFXi)     { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameXi.Data());      return; }
 
-  fh1FFJetPt->SetDirectory(0);
-  fh2FFTrackPt->SetDirectory(0);
-  fh2FFZ->SetDirectory(0);  
-  fh2FFXi->SetDirectory(0); 
-
-  f.Close();  
-
 
   // nJets per bin
 
@@ -1207,28 +1275,12 @@ void AliFragmentationFunctionCorrections::ReadRawBgr(TString strfile, TString st
   // e.g. "fh1FFJetPtRecCuts", "fh2FFXiBgrPerpRecCuts"
   // normalization done separately 
 
+  // input lists are cached, see GetInputList()
+
   TString strID = strBgrID + strFFID;
   
-  TFile f(strfile,"READ");
-
-  if(!f.IsOpen()){
-    Printf("%s:%d -- error opening raw data file %s", (char*)__FILE__,__LINE__,strfile.Data());
-    return;
-  }
-
   if(fDebug>0) Printf("%s:%d -- read Bgr %s from file %s, dir %s ",(char*)__FILE__,__LINE__,strBgrID.Data(),strfile.Data(),strdir.Data());
 
-  gDirectory->cd(strdir);
-
-  TList* list = 0;
-  
-  if(strlist && strlist.Length()){
-    if(!(list = (TList*) gDirectory->Get(strlist))){
-      Printf("%s:%d -- error retrieving list %s from directory %s", (char*)__FILE__,__LINE__,strlist.Data(),strdir.Data());
-      return;
-    }
-  }
-
   TString hnameNJets = "fh1nRecJetsCuts"; 
   TString hnameJetPt(Form("fh1FFJetPt%s",strFFID.Data())); // not: strID.Data() !!! would not be proper normalization
   TString hnameBgrTrackPt(Form("fh2FFTrackPt%s",strID.Data()));
@@ -1241,19 +1293,39 @@ void AliFragmentationFunctionCorrections::ReadRawBgr(TString strfile, TString st
   TH2F* fh2FFZBgr;
   TH2F* fh2FFXiBgr;     
   
-  if(list){
-    fh1NJets        = (TH1F*) list->FindObject(hnameNJets); // needed for normalization of bgr out of 2 jets
-    fh1FFJetPtBgr   = (TH1F*) list->FindObject(hnameJetPt);
-    fh2FFTrackPtBgr = (TH2F*) list->FindObject(hnameBgrTrackPt);
-    fh2FFZBgr       = (TH2F*) list->FindObject(hnameBgrZ);  
-    fh2FFXiBgr      = (TH2F*) list->FindObject(hnameBgrXi); 
+  if(strlist && strlist.Length()){
+    TList* list = GetInputList(strfile,strdir,strlist);
+    if(!list) return;
+
+    fh1NJets        = (TH1F*) CloneInput(list,hnameNJets); // needed for normalization of bgr out of 2 jets
+    fh1FFJetPtBgr   = (TH1F*) CloneInput(list,hnameJetPt);
+    fh2FFTrackPtBgr = (TH2F*) CloneInput(list,hnameBgrTrackPt);
+    fh2FFZBgr       = (TH2F*) CloneInput(list,hnameBgrZ);  
+    fh2FFXiBgr      = (TH2F*) CloneInput(list,hnameBgrXi); 
   }
   else{
+    TFile f(strfile,"READ");
+
+    if(!f.IsOpen()){
+      Printf("%s:%d -- error opening raw data file %s", (char*)__FILE__,__LINE__,strfile.Data());
+      return;
+    }
+
+    gDirectory->cd(strdir);
+
     fh1NJets        = (TH1F*) gDirectory->Get(hnameNJets); // needed for normalization of bgr out of 2 jets
     fh1FFJetPtBgr   = (TH1F*) gDirectory->Get(hnameJetPt);
     fh2FFTrackPtBgr = (TH2F*) gDirectory->Get(hnameBgrTrackPt);
     fh2FFZBgr       = (TH2F*) gDirectory->Get(hnameBgrZ);  
     fh2FFXiBgr      = (TH2F*) gDirectory->Get(hnameBgrXi);  
+
+    if(fh1NJets)        fh1NJets->SetDirectory(0);
+    if(fh1FFJetPtBgr)   fh1FFJetPtBgr->SetDirectory(0);
+    if(fh2FFTrackPtBgr) fh2FFTrackPtBgr->SetDirectory(0);
+    if(fh2FFZBgr)       fh2FFZBgr->SetDirectory(0);  
+    if(fh2FFXiBgr)      fh2FFXiBgr->SetDirectory(0); 
+
+    f.Close();  
   }
 
 
@@ -1263,14 +1335,6 @@ void AliFragmentationFunctionCorrections::ReadRawBgr(TString strfile, TString st
   if(!fh2FFZBgr)      { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameBgrZ.Data());       return; }
   if(!fh2FFXiBgr)     { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameBgrXi.Data());      return; }
 
-  fh1FFJetPtBgr->SetDirectory(0);
-  fh2FFTrackPtBgr->SetDirectory(0);
-  fh2FFZBgr->SetDirectory(0);  
-  fh2FFXiBgr->SetDirectory(0); 
-  if(fh1NJets) fh1NJets->SetDirectory(0);
-
-  f.Close();  
-
   // nJets per bin
 
   for(Int_t i=0; i<fNJetPtSlices; i++){
@@ -1369,26 +1433,15 @@ void AliFragmentationFunctionCorrections::ReadRawBgrEmbedding(TString strfile, T
   // for embedding, the bgr FF are taken from histos "fh1FFJetPtRecCuts", "fh2FFXiRecCuts"
   // normalization done separately 
 
+  // input lists are cached, see GetInputList()
+
   TString strBgrID = "BckgEmbed";
   TString strID = strBgrID + strFFID;
 
-  TFile f(strfile,"READ");
-
-  if(!f.IsOpen()){
-    Printf("%s:%d -- error opening raw data file %s", (char*)__FILE__,__LINE__,strfile.Data());
-    return;
-  }
-
   if(fDebug>0) Printf("%s:%d -- read Bgr %s from file %s ",(char*)__FILE__,__LINE__,strFFID.Data(),strfile.Data());
 
-  gDirectory->cd(strdir);
-
-  TList* list = 0;
-  
-  if(!(list = (TList*) gDirectory->Get(strlist))){
-    Printf("%s:%d -- error retrieving list %s from directory %s", (char*)__FILE__,__LINE__,strlist.Data(),strdir.Data());
-    return;
-  }
+  TList* list = GetInputList(strfile,strdir,strlist);
+  if(!list) return;
 
   TString hnameNJets = "fh1nRecJetsCuts"; 
   TString hnameJetPt(Form("fh1FFJetPt%s",strFFID.Data())); 
@@ -1396,11 +1449,11 @@ void AliFragmentationFunctionCorrections::ReadRawBgrEmbedding(TString strfile, T
   TString hnameBgrZ(Form("fh2FFZ%s",strFFID.Data()));
   TString hnameBgrXi(Form("fh2FFXi%s",strFFID.Data()));
 
-  TH1F* fh1NJets        = (TH1F*) list->FindObject(hnameNJets); // needed for normalization of bgr out of 2 jets
-  TH1F* fh1FFJetPtBgr   = (TH1F*) list->FindObject(hnameJetPt);
-  TH2F* fh2FFTrackPtBgr = (TH2F*) list->FindObject(hnameBgrTrackPt);
-  TH2F* fh2FFZBgr       = (TH2F*) list->FindObject(hnameBgrZ);  
-  TH2F* fh2FFXiBgr      = (TH2F*) list->FindObject(hnameBgrXi); 
+  TH1F* fh1NJets        = (TH1F*) CloneInput(list,hnameNJets); // needed for normalization of bgr out of 2 jets
+  TH1F* fh1FFJetPtBgr   = (TH1F*) CloneInput(list,hnameJetPt);
+  TH2F* fh2FFTrackPtBgr = (TH2F*) CloneInput(list,hnameBgrTrackPt);
+  TH2F* fh2FFZBgr       = (TH2F*) CloneInput(list,hnameBgrZ);  
+  TH2F* fh2FFXiBgr      = (TH2F*) CloneInput(list,hnameBgrXi); 
 
   if(!fh1FFJetPtBgr)  { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameJetPt.Data());      return; }
   if(!fh1NJets)       { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameNJets.Data());      return; }
@@ -1408,14 +1461,6 @@ void AliFragmentationFunctionCorrections::ReadRawBgrEmbedding(TString strfile, T
   if(!fh2FFZBgr)      { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameBgrZ.Data());       return; }
   if(!fh2FFXiBgr)     { Printf("%s:%d -- histo %s not found",(char*)__FILE__,__LINE__,hnameBgrXi.Data());      return; }
 
-  fh1FFJetPtBgr->SetDirectory(0);
-  fh1NJets->SetDirectory(0);
-  fh2FFTrackPtBgr->SetDirectory(0);
-  fh2FFZBgr->SetDirectory(0);  
-  fh2FFXiBgr->SetDirectory(0); 
-
-  f.Close();  
-
   // nJets per bin
 
   for(Int_t i=0; i<fNJetPtSlices; i++){
@@ -13,6 +13,8 @@
 #include "TObject.h"
 
 class ThnSparse;
+class TList;
+class TMap;
 
 class AliFragmentationFunctionCorrections : public TObject {
 
@@ -87,6 +89,8 @@ class AliFragmentationFunctionCorrections : public TObject {
   void ReadRawBgrEmbedding(TString strfile, TString strID, TString strFFID);
   void ReadRawBgrEmbedding(TString strfile, TString strdir, TString strlist, TString strFFID);
 
+  static void ClearInputCache();
+
   void WriteOutput(TString strfile, TString strdir = "", Bool_t updateOutfile = kTRUE);
 
   THnSparse* TH1toSparse(const TH1F* hist, TString strName, TString strTit, const Bool_t fillConst = kFALSE);
@@ -205,7 +209,11 @@ class AliFragmentationFunctionCorrections : public TObject {
 
  private:
 
+  TList* GetInputList(TString strfile, TString strdir, TString strlist);
+  TObject* CloneInput(const TList* list, TString strname) const;
+
   static const Int_t fgMaxNCorrectionLevels = 10;  //! max number of corrections 
+  static TMap* fgInputCache;                        //! input lists read so far, key file:dir:list
   
   Int_t fDebug;              //! Debug level
   Int_t fNJetPtSlices;       //! n slices in jet pt
@@ -60,7 +60,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator()
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fUseStripArrays(false),
+    fStripFits(),
+    fStripMaxW(),
+    fStripCuts(),
+    fStripNEta(0)
 {
   // 
   // Constructor 
@@ -98,7 +103,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const char* title)
     fDoTiming(false),
     fHTiming(0), 
     fMaxOutliers(0.05),
-    fOutlierCut(0.50)
+    fOutlierCut(0.50),
+    fUseStripArrays(false),
+    fStripFits(),
+    fStripMaxW(),
+    fStripCuts(),
+    fStripNEta(0)
 {
   // 
   // Constructor 
@@ -167,7 +177,12 @@ AliFMDDensityCalculator::AliFMDDensityCalculator(const
     fDoTiming(o.fDoTiming),
     fHTiming(o.fHTiming), 
   fMaxOutliers(o.fMaxOutliers),
-  fOutlierCut(o.fOutlierCut)
+  fOutlierCut(o.fOutlierCut),
+  fUseStripArrays(o.fUseStripArrays),
+  fStripFits(o.fStripFits),
+  fStripMaxW(o.fStripMaxW),
+  fStripCuts(o.fStripCuts),
+  fStripNEta(o.fStripNEta)
 {
   // 
   // Copy constructor 
@@ -232,6 +247,11 @@ AliFMDDensityCalculator::operator=(const AliFMDDensityCalculator& o)
   fHTiming            = o.fHTiming;
   fMaxOutliers        = o.fMaxOutliers;
   fOutlierCut         = o.fOutlierCut;
+  fUseStripArrays     = o.fUseStripArrays;
+  fStripFits          = o.fStripFits;
+  fStripMaxW          = o.fStripMaxW;
+  fStripCuts          = o.fStripCuts;
+  fStripNEta          = o.fStripNEta;
 
   fRingHistos.Delete();
   TIter    next(&o.fRingHistos);
@@ -306,6 +326,23 @@ namespace {
     ret = h->GetBinContent(xbin,ybin);					
     return ret;
   }
+  Int_t RingIndex(UShort_t d, Char_t r)
+  {
+    switch (d) { 
+    case 1: return 0;
+    case 2: return (r == 'I' || r == 'i') ? 1 : 2;
+    case 3: return (r == 'I' || r == 'i') ? 3 : 4;
+    }
+    return -1;
+  }
+  void FillBin(TH2D* h, Int_t bin, Double_t w)
+  {
+    // Same as TH2D::Fill(x,y,w) for a known bin, except that the
+    // statistics sums are not updated
+    h->AddBinContent(bin, w);
+    TArrayD* sumw2 = h->GetSumw2();
+    if (sumw2->fN > 0) sumw2->fArray[bin] += w * w;
+  }
 }
 
 //____________________________________________________________________
@@ -398,6 +435,15 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   
   Double_t etaCache[20*512]; // Same number of strips per ring 
   Double_t phiCache[20*512]; // whether it is inner our outer. 
+  Int_t    binCache[20*512]; // Histogram bins if fUseStripArrays
+  const AliFMDCorrELossFit* cor = 0;
+  if (fUseStripArrays) {
+    if (fStripNEta <= 0) { 
+      AliError("Strip tables not filled - was SetupForData called?");
+      return false;
+    }
+    cor = AliForwardCorrectionManager::Instance().GetELossFit();
+  }
   // We do not use TArrayD because we do not wont a bounds check 
   // TArrayD etaCache(20*512); // Same number of strips per ring
   // TArrayD phiCache(20*512); // whether it is inner our outer. 
@@ -458,6 +504,7 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  START_TIMER(timer);
 	  etaCache[s*nt+t] = eta;
 	  phiCache[s*nt+t] = phi;
+	  if (fUseStripArrays) binCache[s*nt+t] = h->FindBin(eta, phi);
 
 	  // --- Check this strip ------------------------------------
 	  rh->fTotal->Fill(eta);
@@ -489,14 +536,25 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 
 	  // --- Get the low multiplicity cut ------------------------
 	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
+	  Int_t    iEta = -1;
+	  if (eta != AliESDFMD::kInvalidEta) { 
+	    if (fUseStripArrays) { 
+	      iEta = cor->FindEtaBin(eta);
+	      Int_t idx = StripTableIndex(d, r, iEta);
+	      if (idx >= 0) cut = fStripCuts.fArray[idx];
+	    }
+	    else cut = GetMultCut(d, r, eta,false);
+	  }
 	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
 			   d, r, s, t, eta);
 
 	  // --- Now caluculate Nch for this strip using fits --------
 	  START_TIMER(timer);
 	  Double_t n   = 0;
-	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+	  if (cut > 0 && mult > cut) 
+	    n = (fUseStripArrays ? 
+		 NParticlesInBin(mult,d,r,iEta,eta,lowFlux) :
+		 NParticles(mult,d,r,eta,lowFlux));
 	  rh->fELoss->Fill(mult);
 	  // rh->fEvsN->Fill(mult,n);
 	  // rh->fEtaVsN->Fill(eta, n);
@@ -529,7 +587,8 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	    rh->fSignal->Fill(eta, mult);
 	  }
 	  rh->fPoisson.Fill(t,s,hit,1./c);
-	  h->Fill(eta,phi,n);
+	  if (fUseStripArrays) FillBin(h, binCache[s*nt+t], n);
+	  else                 h->Fill(eta,phi,n);
 
 	  // --- If we use ELoss fits, apply now ---------------------
 	  if (!fUsePoisson) rh->fDensity->Fill(eta,phi,n);
@@ -571,12 +630,10 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  Double_t  eta  = etaCache[s*nt+t]; 
 	  // Double_t  phi  = fmd.Phi(d,r,s,t) * TMath::DegToRad();
 	  // Double_t  eta  = fmd.Eta(d,r,s,t);
-	  if (fUsePoisson) {
-	    h->Fill(eta,phi,poissonV);
-	    rh->fDensity->Fill(eta, phi, poissonV);
-	  }
-	  else
-	    hclone->Fill(eta,phi,poissonV);
+	  TH2D* dest = (fUsePoisson ? h : hclone);
+	  if (fUseStripArrays) FillBin(dest, binCache[s*nt+t], poissonV);
+	  else                 dest->Fill(eta,phi,poissonV);
+	  if (fUsePoisson) rh->fDensity->Fill(eta, phi, poissonV);
 	}
       }
       ADD_TIMER(timer,poissonTime);
@@ -771,6 +828,55 @@ AliFMDDensityCalculator::CacheMaxWeights(const TAxis& axis)
 
   // Cache cuts in histogram
   fCuts.FillHistogram(fLowCuts);
+
+  if (fUseStripArrays) CacheStripTables(cor);
+}
+
+//_____________________________________________________________________
+void
+AliFMDDensityCalculator::CacheStripTables(const AliFMDCorrELossFit* cor)
+{
+  // 
+  // Fill the per-eta-bin tables of fits, maximum weights, and low
+  // cuts for each ring.  The tables are indexed by the eta bin of the
+  // energy loss fits, which is the same as that of the max weights
+  // and low cuts.  Bin 0 is for out-of-range eta.
+  // 
+  DGUARD(fDebug, 2, "Cache strip tables in FMD density calculator");
+  if (!cor) return;
+
+  fStripNEta = cor->GetEtaAxis().GetNbins();
+  Int_t nTot = 5 * (fStripNEta + 1);
+  fStripFits.Clear();
+  fStripFits.Expand(nTot);
+  fStripMaxW.Set(nTot);
+  fStripCuts.Set(nTot);
+  for (UShort_t d = 1; d <= 3; d++) { 
+    UShort_t nr = (d == 1 ? 1 : 2);
+    for (UShort_t q = 0; q < nr; q++) { 
+      Char_t r = (q == 0 ? 'I' : 'O');
+      for (Int_t iEta = 0; iEta <= fStripNEta; iEta++) { 
+	Int_t idx = StripTableIndex(d, r, iEta);
+	fStripFits.AddAt(iEta > 0 ? cor->FindFit(d, r, iEta, -1) : 0, idx);
+	fStripMaxW[idx] = GetMaxWeight(d, r, iEta - 1);
+	fStripCuts[idx] = Rng2Cut(d, r, iEta, fLowCuts);
+      }
+    }
+  }
+}
+
+//_____________________________________________________________________
+Int_t
+AliFMDDensityCalculator::StripTableIndex(UShort_t d, Char_t r, 
+					 Int_t iEta) const
+{
+  // 
+  // Get the index into the strip tables for FMD<i>dr</i> in eta bin
+  // @a iEta, or -1 if out of bounds
+  // 
+  Int_t ring = RingIndex(d, r);
+  if (ring < 0 || iEta < 0 || iEta > fStripNEta) return -1;
+  return ring * (fStripNEta + 1) + iEta;
 }
 
 //_____________________________________________________________________
@@ -890,6 +996,62 @@ AliFMDDensityCalculator::NParticles(Float_t  mult,
   return ret;
 }
 
+//_____________________________________________________________________
+Float_t 
+AliFMDDensityCalculator::NParticlesInBin(Float_t  mult, 
+					 UShort_t d, 
+					 Char_t   r, 
+					 Int_t    iEta,
+					 Float_t  eta,
+					 Bool_t   lowFlux) const
+{
+  // 
+  // Get the number of particles corresponding to the signal mult
+  // using the cached strip tables.  Same as NParticles, but without
+  // searching for the fit and max weight of each strip.
+  // 
+  // Parameters:
+  //    mult     Signal
+  //    d        Detector
+  //    r        Ring 
+  //    iEta     Eta bin of the energy loss fits 
+  //    eta      Pseudo-rapidity 
+  //    lowFlux  Low-flux flag 
+  // 
+  // Return:
+  //    The number of particles 
+  //
+  DGUARD(fDebug, 3, "Calculate Nch from tables in FMD density calculator");
+  if (lowFlux) return 1;
+
+  Int_t idx = StripTableIndex(d, r, iEta);
+  AliFMDCorrELossFit::ELossFit* fit = (idx < 0 ? 0 : 
+    static_cast<AliFMDCorrELossFit::ELossFit*>(fStripFits.UncheckedAt(idx)));
+  if (!fit) { 
+    AliWarning(Form("No energy loss fit for FMD%d%c at eta=%f qual=%d", 
+		    d, r, eta, fMinQuality));
+    return 0;
+  }
+  
+  Int_t    m   = fStripMaxW.fArray[idx];
+  if (m < 1) { 
+    AliWarning(Form("No good fits for FMD%d%c at eta=%f", d, r, eta));
+    return 0;
+  }
+  
+  UShort_t n   = TMath::Min(fMaxParticles, UShort_t(m));
+  Double_t ret = fit->EvaluateWeighted(mult, n);
+  
+  if (fDebug > 10) {
+    AliInfo(Form("FMD%d%c, eta=%7.4f, %8.5f -> %8.5f", d, r, eta, mult, ret));
+  }
+    
+  fWeightedSum->Fill(ret);
+  fSumOfWeights->Fill(ret);
+  
+  return ret;
+}
+
 //_____________________________________________________________________
 Float_t 
 AliFMDDensityCalculator::Correction(UShort_t d, 
@@ -1117,6 +1279,7 @@ AliFMDDensityCalculator::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("etaLumping",   fEtaLumping));
   d->Add(AliForwardUtil::MakeParameter("phiLumping",   fPhiLumping));
   d->Add(AliForwardUtil::MakeParameter("recalcPhi",    fRecalculatePhi));
+  d->Add(AliForwardUtil::MakeParameter("stripArrays",  fUseStripArrays));
   d->Add(AliForwardUtil::MakeParameter("maxOutliers",  fMaxOutliers));
   d->Add(AliForwardUtil::MakeParameter("outlierCut",   fOutlierCut));
   d->Add(AliForwardUtil::MakeParameter("hitThreshold", fHitThreshold));
@@ -1196,6 +1359,7 @@ AliFMDDensityCalculator::Print(Option_t* option) const
   PFV("Eta lumping",		fEtaLumping);
   PFV("Phi lumping",		fPhiLumping);
   PFB("Recalculate phi",	fRecalculatePhi);
+  PFB("Use strip arrays",	fUseStripArrays);
   PFB("Use phi acceptance",     phiM);
   PFV("Min(quality)",           fMinQuality);
   PFV("Threshold(hit)",         fHitThreshold);
@@ -16,6 +16,8 @@
 #include <TNamed.h>
 #include <TList.h>
 #include <TArrayI.h>
+#include <TArrayD.h>
+#include <TObjArray.h>
 #include <TVector3.h>
 #include "AliForwardUtil.h"
 #include "AliFMDMultCuts.h"
@@ -163,6 +165,17 @@ public:
    * 
    */
   void SetRecalculatePhi(Bool_t use) { fRecalculatePhi = use; }
+  /** 
+   * Whether to process the strips of a ring through flat arrays.  If
+   * enabled, the energy loss fit, maximum weight, and low cut of each
+   * @f$\eta@f$ bin are looked up in tables built once in
+   * SetupForData, and the histogram bin of each strip is found once
+   * per event and reused for the Poisson result.  The output is the
+   * same as the default per-strip look-ups.
+   * 
+   * @param use If true, use the strip arrays 
+   */
+  void SetUseStripArrays(Bool_t use) { fUseStripArrays = use; }
   /** 
    * Set whether to use the phi acceptance correction. 
    * 
@@ -297,6 +310,24 @@ protected:
    * @param axis Default @f$\eta@f$ axis from parent task 
    */  
   void CacheMaxWeights(const TAxis& axis);
+  /** 
+   * Fill the per-@f$\eta@f$-bin tables of fits, maximum weights, and
+   * low cuts used when the strip arrays are enabled.  Must be called
+   * after the maximum weights and cuts are cached.
+   * 
+   * @param cor Energy loss fits 
+   */
+  void CacheStripTables(const AliFMDCorrELossFit* cor);
+  /** 
+   * Get the index into the strip tables 
+   * 
+   * @param d     Detector 
+   * @param r     Ring 
+   * @param iEta  Bin number on the energy loss fit @f$\eta@f$ axis
+   * 
+   * @return Index into the tables, or -1 if out of bounds
+   */
+  Int_t StripTableIndex(UShort_t d, Char_t r, Int_t iEta) const;
   /** 
    * Find the (cached) maximum weight for FMD<i>dr</i> in 
    * @f$\eta@f$ bin @a iEta
@@ -336,6 +367,25 @@ protected:
 			     Char_t   r, 
 			     Float_t  eta, 
 			     Bool_t   lowFlux) const;
+  /** 
+   * Get the number of particles corresponding to the signal mult,
+   * using the cached strip tables (see SetUseStripArrays)
+   * 
+   * @param mult     Signal
+   * @param d        Detector
+   * @param r        Ring 
+   * @param iEta     Bin number on the energy loss fit @f$\eta@f$ axis
+   * @param eta      Pseudo-rapidity (for messages only)
+   * @param lowFlux  Low-flux flag 
+   * 
+   * @return The number of particles 
+   */
+  Float_t NParticlesInBin(Float_t  mult, 
+			  UShort_t d, 
+			  Char_t   r, 
+			  Int_t    iEta,
+			  Float_t  eta,
+			  Bool_t   lowFlux) const;
   /** 
    * Get the inverse correction factor.  This consist of
    * 
@@ -504,8 +554,13 @@ protected:
   TProfile*              fHTiming;
   Double_t               fMaxOutliers; // Maximum ratio of outlier bins 
   Double_t               fOutlierCut;  // Maximum relative diviation 
+  Bool_t                 fUseStripArrays; // Process rings as flat arrays
+  TObjArray              fStripFits;   //! Fits per ring and eta bin
+  TArrayI                fStripMaxW;   //! Max weights per ring and eta bin
+  TArrayD                fStripCuts;   //! Low cuts per ring and eta bin
+  Int_t                  fStripNEta;   //! Number of eta bins in tables
 
-  ClassDef(AliFMDDensityCalculator,16); // Calculate Nch density 
+  ClassDef(AliFMDDensityCalculator,17); // Calculate Nch density 
 };
 
 #endif
@@ -25,7 +25,7 @@
 ///////////////////////////////////////////////////////////////////////////
 
 #include <Riostream.h>
-//#include <vector>
+#include <vector>
 
 #include <TArray.h>
 #include <TAxis.h>
@@ -1045,7 +1045,30 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
   Int_t deuIdx, proIdx, pioIdx = 0.;
   Double_t charge_d, charge_p, charge_pi = 0.;
   AliExternalTrackParam etd, etp, etpi;
-  
+
+  // -------------------------------------------------------
+  // Candidate tables: the daughters are fetched once, and the quantities
+  // which do not depend on the combination (impact parameter to the
+  // primary vertex, pion track cuts, track parameters) are computed at the
+  // first use and reused. The DCAs of the pions to a deuteron or a proton
+  // are computed the first time a d-p pair passing the DCA cut needs them
+  // (-1: not computed). The QA histograms are filled as for each combination
+  // -------------------------------------------------------
+
+  std::vector<AliAODTrack*> tracksP(nProTPC), tracksPi(nPioTPC);
+  std::vector<AliExternalTrackParam> paramP(nProTPC), paramPi(nPioTPC);
+  std::vector<Double_t> primP(2*nProTPC), primPi(2*nPioTPC);
+  std::vector<Char_t> doneP(nProTPC, 0);   // impact parameter computed
+  std::vector<Char_t> donePi(nPioTPC, 0);  // 0: not checked, 1: rejected, 2: accepted, 3: impact parameter computed
+  for(UInt_t m=0; m<nProTPC; m++) tracksP[m] = dynamic_cast<AliAODTrack*>(fAODevent->GetTrack(cproton[m]));
+  for(UInt_t s=0; s<nPioTPC; s++) tracksPi[s] = dynamic_cast<AliAODTrack*>(fAODevent->GetTrack(cpion[s]));
+
+  std::vector<Double_t> dcaDPi(nPioTPC);   // pions - current deuteron
+  std::vector<Double_t> dcaPPi;            // pions - protons, one row per proton used
+  std::vector<Int_t> rowPPi(nProTPC, -1);  // offset of the row of the proton in dcaPPi
+  Int_t offPPi = 0;
+  AliExternalTrackParam paramD;
+
   for(UInt_t j=0; j<nDeuTPC; j++){ // candidate deuteron loop cdeuteron.size()
     
     trackD = dynamic_cast<AliAODTrack*>(fAODevent->GetTrack(cdeuteron[j]));
@@ -1058,11 +1081,12 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
     if(dcadprim < fDCADPVmin) continue;
     
     charge_d = trackD->Charge();
-    etd.CopyFromVTrack(trackD);
+    paramD.CopyFromVTrack(trackD);
+    dcaDPi.assign(nPioTPC, -1.);
     
     for(UInt_t m=0; m<nProTPC; m++){ // candidate proton loop cproton.size()
           
-      trackP = dynamic_cast<AliAODTrack*>(fAODevent->GetTrack(cproton[m]));
+      trackP = tracksP[m];
 	  
       if(fMC) {if(trackD->GetLabel() == trackP->GetLabel()) continue;}
 
@@ -1070,14 +1094,23 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
 
       if((charge_d*charge_p)<0) continue; //avoid coupling d-pbar and dbar-p
       
-      trackP->PropagateToDCA(fPrimaryVertex,bz,100,pprim,pprimc);
+      if(!doneP[m]){
+        trackP->PropagateToDCA(fPrimaryVertex,bz,100,pprim,pprimc);
+        primP[2*m] = pprim[0];
+        primP[2*m+1] = pprim[1];
+        paramP[m].CopyFromVTrack(trackP);
+        doneP[m] = 1;
+      }
+      pprim[0] = primP[2*m];
+      pprim[1] = primP[2*m+1];
       dcapprim = TMath::Sqrt((pprim[0]*pprim[0])+(pprim[1]*pprim[1]));
       fHistDCApprimary->Fill(dcapprim);
       //fHistCorrDCApprimary->Fill(pprim[0],pprim[1]);
 
       if(dcapprim < fDCAPPVmin) continue;
 
-      etp.CopyFromVTrack(trackP);
+      etd = paramD;
+      etp = paramP[m];
 
       dca_dp = etd.GetDCA(&etp,bz,xthiss,xpp);
 
@@ -1085,6 +1118,11 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
 
       if(dca_dp > fDCAdp) continue;
 
+      if(rowPPi[m] < 0){
+        rowPPi[m] = dcaPPi.size();
+        dcaPPi.resize(dcaPPi.size()+nPioTPC, -1.);
+      }
+      offPPi = rowPPi[m];
             
       for(UInt_t s=0; s<nPioTPC; s++ ){ // candidate pion loop cpion.size()
 
@@ -1101,7 +1139,7 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
 	p_dp.Clear();
 	p_dpi.Clear();
 	
-	trackNPi = dynamic_cast<AliAODTrack*>(fAODevent->GetTrack(cpion[s]));
+	trackNPi = tracksPi[s];
 	brotherHood = kFALSE;
 
 	charge_pi = trackNPi->Charge();
@@ -1111,7 +1149,8 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
 	fHistpionTPCcls->Fill(trackNPi->GetTPCncls(0));
 	fHistpTpion->Fill(trackNPi->Pt());
 
-	if(!AcceptTrack(trackNPi,211)) continue;
+	if(!donePi[s]) donePi[s] = AcceptTrack(trackNPi,211) ? 2 : 1;
+	if(donePi[s] == 1) continue;
        
 
 	if(fMC){
@@ -1119,7 +1158,15 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
 	if(trackNPi->GetLabel() == trackD->GetLabel()) continue;
 	}
 
-	trackNPi->PropagateToDCA(fPrimaryVertex,bz,100,piprim,piprimc);
+	if(donePi[s] == 2){
+	  trackNPi->PropagateToDCA(fPrimaryVertex,bz,100,piprim,piprimc);
+	  primPi[2*s] = piprim[0];
+	  primPi[2*s+1] = piprim[1];
+	  paramPi[s].CopyFromVTrack(trackNPi);
+	  donePi[s] = 3;
+	}
+	piprim[0] = primPi[2*s];
+	piprim[1] = primPi[2*s+1];
 	
 	dcapiprim = TMath::Sqrt((piprim[0]*piprim[0])+(piprim[1]*piprim[1]));
 	       
@@ -1128,12 +1175,16 @@ void AliAnalysisTaskHypertriton3AOD::UserExec(Option_t *){
 	
 	if(dcapiprim < fDCAPiPVmin) continue;
 
-	etpi.CopyFromVTrack(trackNPi);
+	etd = paramD;
+	etp = paramP[m];
+	etpi = paramPi[s];
 
 	//====Triplets building====
 	
-	dca_dpi = etpi.GetDCA(&etd,bz,xthiss,xpp);
-	dca_ppi = etpi.GetDCA(&etp,bz,xthiss,xpp);
+	if(dcaDPi[s] < 0) dcaDPi[s] = etpi.GetDCA(&etd,bz,xthiss,xpp);
+	if(dcaPPi[offPPi+s] < 0) dcaPPi[offPPi+s] = etpi.GetDCA(&etp,bz,xthiss,xpp);
+	dca_dpi = dcaDPi[s];
+	dca_ppi = dcaPPi[offPPi+s];
 
 
 	fHistDCAdpdpi->Fill(dca_dp,dca_dpi);
@@ -25,7 +25,7 @@
 ///////////////////////////////////////////////////////////////////////////
 
 #include <Riostream.h>
-//#include <vector>
+#include <vector>
 
 #include <TArray.h>
 #include <TAxis.h>
@@ -626,7 +626,7 @@ Double_t AliAnalysisTaskHypertriton3Dev::ComputeSigma(Double_t dc[2], Double_t d
 }
 
 //________________________________________________________________________
-void AliAnalysisTaskHypertriton3Dev::CombineThreeTracks(Bool_t isMatter, TArrayI arrD, TArrayI arrP, TArrayI arrPi, Bool_t cent0, Bool_t cent1){
+void AliAnalysisTaskHypertriton3Dev::CombineThreeTracks(Bool_t isMatter, const TArrayI &arrD, const TArrayI &arrP, const TArrayI &arrPi, Bool_t cent0, Bool_t cent1){
 //Method to combine tracks
 //Here implemented topological and kinematical cuts
 //Total charge predefined with the correct type of array assigned to this method
@@ -668,19 +668,39 @@ TParticle *tparticleP = 0x0;
 TParticle *tparticlePi = 0x0;
 
 
+// -------------------------------------------------------
+// Candidate tables: the daughters are fetched once, the DCAs of the pions
+// to a deuteron or a proton are computed the first time a d-p pair passing
+// the DCA cut needs them and reused for the other pairs (-1: not computed)
+// -------------------------------------------------------
+
+const Int_t nD = arrD.GetSize();
+const Int_t nP = arrP.GetSize();
+const Int_t nPi = arrPi.GetSize();
+std::vector<AliESDtrack*> tracksD(nD), tracksP(nP), tracksPi(nPi);
+for(Int_t j=0; j<nD; j++) tracksD[j] = dynamic_cast<AliESDtrack*>(fESDevent->GetTrack(arrD[j]));
+for(Int_t m=0; m<nP; m++) tracksP[m] = dynamic_cast<AliESDtrack*>(fESDevent->GetTrack(arrP[m]));
+for(Int_t s=0; s<nPi; s++) tracksPi[s] = dynamic_cast<AliESDtrack*>(fESDevent->GetTrack(arrPi[s]));
+
+std::vector<Double_t> dcaDPi(nPi);   // pions - current deuteron
+std::vector<Double_t> dcaPPi;        // pions - protons, one row per proton used
+std::vector<Int_t> rowPPi(nP, -1);   // offset of the row of the proton in dcaPPi
+Int_t offPPi = 0;
+
 // -------------------------------------------------------
 // Loop for Invariant Mass
 // -------------------------------------------------------
 
 
-for(Int_t j=0; j<arrD.GetSize(); j++){ // candidate deuteron loop cdeuteron.size()
+for(Int_t j=0; j<nD; j++){ // candidate deuteron loop cdeuteron.size()
 
-  trackD = dynamic_cast<AliESDtrack*>(fESDevent->GetTrack(arrD[j]));
+  trackD = tracksD[j];
+  dcaDPi.assign(nPi, -1.);
 
 
-  for(Int_t m=0; m<arrP.GetSize(); m++){ // candidate proton loop cproton.size()
+  for(Int_t m=0; m<nP; m++){ // candidate proton loop cproton.size()
 
-    trackP = dynamic_cast<AliESDtrack*>(fESDevent->GetTrack(arrP[m]));
+    trackP = tracksP[m];
 
     if(trackD->GetID() == trackP->GetID()) continue;
 
@@ -690,8 +710,14 @@ for(Int_t j=0; j<arrD.GetSize(); j++){ // candidate deuteron loop cdeuteron.size
 
     if(dca_dp > fDCAdp) continue;
 
+    if(rowPPi[m] < 0){
+      rowPPi[m] = dcaPPi.size();
+      dcaPPi.resize(dcaPPi.size()+nPi, -1.);
+    }
+    offPPi = rowPPi[m];
+
 
-    for(Int_t s=0; s<arrPi.GetSize(); s++ ){ // candidate pion loop cpion.size()
+    for(Int_t s=0; s<nPi; s++ ){ // candidate pion loop cpion.size()
 
       fTrkArray->Clear();
       Hypertriton.Clear();
@@ -703,7 +729,7 @@ for(Int_t j=0; j<arrD.GetSize(); j++){ // candidate deuteron loop cdeuteron.size
       p1.Clear();
       pi1.Clear();
 
-      trackNPi = dynamic_cast<AliESDtrack*>(fESDevent->GetTrack(arrPi[s]));
+      trackNPi = tracksPi[s];
       brotherHood = kFALSE;
 
 
@@ -711,8 +737,10 @@ for(Int_t j=0; j<arrD.GetSize(); j++){ // candidate deuteron loop cdeuteron.size
       if(trackNPi->GetID() == trackD->GetID()) continue;
 
 
-      dca_dpi = trackNPi->GetDCA(trackD,bz,xthiss,xpp);
-      dca_ppi = trackNPi->GetDCA(trackP,bz,xthiss,xpp);
+      if(dcaDPi[s] < 0) dcaDPi[s] = trackNPi->GetDCA(trackD,bz,xthiss,xpp);
+      if(dcaPPi[offPPi+s] < 0) dcaPPi[offPPi+s] = trackNPi->GetDCA(trackP,bz,xthiss,xpp);
+      dca_dpi = dcaDPi[s];
+      dca_ppi = dcaPPi[offPPi+s];
 
 
       fHistDCAdpdpi->Fill(dca_dp,dca_dpi);
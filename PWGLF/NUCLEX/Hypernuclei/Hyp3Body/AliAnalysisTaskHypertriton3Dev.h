@@ -122,7 +122,7 @@ class AliAnalysisTaskHypertriton3Dev : public AliAnalysisTaskSE {
   Bool_t HasTOF(AliESDtrack *trk, float &beta_tof);
   Bool_t PassPIDSelection(AliESDtrack *trk, Int_t specie, Bool_t isTOFin, Float_t nsigma_cut); // specie according to AliPID enum: 2-pion, 4-proton, 5-deuteron
   Double_t ComputeSigma(Double_t dc[2], Double_t dc_cov[3]);
-  void CombineThreeTracks(Bool_t isMatter, TArrayI arrD, TArrayI arrP, TArrayI arrPi, Bool_t cent0, Bool_t cent1);
+  void CombineThreeTracks(Bool_t isMatter, const TArrayI &arrD, const TArrayI &arrP, const TArrayI &arrPi, Bool_t cent0, Bool_t cent1);
 
 
   AliESDEvent        *fESDevent;                   ///< ESD event
@@ -17,6 +17,7 @@
 //
 
 #include "AliPIDResponse.h"
+#include "AliPIDResponseCache.h"
 #include "AliESDpid.h"
 #include "AliAODpidUtil.h"
 
@@ -153,13 +154,13 @@ Bool_t AliRsnCutPIDNSigma::IsSelected(TObject *object)
    // get number of sigmas
    switch (fDetector) {
       case kITS:
-         fTrackNSigma = TMath::Abs(pid->NumberOfSigmasITS(vtrack, fSpecies));
+         fTrackNSigma = TMath::Abs(AliPIDResponseCache::NumberOfSigmasITS(pid, vtrack, fSpecies));
          break;
       case kTPC:
-         fTrackNSigma = TMath::Abs(pid->NumberOfSigmasTPC(vtrack, fSpecies));
+         fTrackNSigma = TMath::Abs(AliPIDResponseCache::NumberOfSigmasTPC(pid, vtrack, fSpecies));
          break;
       case kTOF:
-         fTrackNSigma = TMath::Abs(pid->NumberOfSigmasTOF(vtrack, fSpecies));
+         fTrackNSigma = TMath::Abs(AliPIDResponseCache::NumberOfSigmasTOF(pid, vtrack, fSpecies));
          break;
       default:
          AliError("Bad detector chosen. Rejecting track");
@@ -14,6 +14,9 @@
 //
 
 #include <Riostream.h>
+#include <deque>
+#include <map>
+#include <tuple>
 
 #include <TH1.h>
 #include <TList.h>
@@ -46,8 +49,37 @@
 #include "AliRsnMiniEvent.h"
 #include "AliRsnMiniParticle.h"
 
+#include "AliTaskCostMonitor.h"
+
 #include "AliRsnMiniAnalysisTask.h"
 
+//
+// Pools of mini-events waiting for mixing partners in the online mixing mode,
+// one pool per (vz, mult, angle) bin (a single pool for continuous mixing).
+// Each pool keeps the events in order of arrival, together with the number
+// of mixings already done with each of them.
+//
+class RsnMiniMixingPools {
+public:
+   struct Entry {
+      AliRsnMiniEvent *fEvent;
+      Int_t            fNMixed;
+   };
+   typedef std::tuple<Int_t, Int_t, Int_t> Key;
+   typedef std::deque<Entry> Pool;
+
+   ~RsnMiniMixingPools() {Clear();}
+   Pool &GetPool(const Key &key) {return fPools[key];}
+   void Clear() {
+      for (std::map<Key, Pool>::iterator it = fPools.begin(); it != fPools.end(); ++it)
+         for (size_t i = 0; i < it->second.size(); i++) delete it->second[i].fEvent;
+      fPools.clear();
+   }
+
+private:
+   std::map<Key, Pool> fPools;
+};
+
 
 ClassImp(AliRsnMiniAnalysisTask)
 
@@ -71,7 +103,14 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMaxDiffMult(10),
    fMaxDiffVz(1.0),
    fMaxDiffAngle(1E20),
+   fOnlineMix(kFALSE),
+   fMixPoolDepth(0),
+   fMixEventID(0),
+   fMixPools(0x0),
    fOutput(0x0),
+   fCostMonitoring(kFALSE),
+   fCostMonitor(0x0),
+   fCostRegionBuffer(-1),
    fHistograms("AliRsnMiniOutput", 0),
    fValues("AliRsnMiniValue", 0),
    fHEventStat(0x0),
@@ -128,7 +167,14 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fMaxDiffMult(10),
    fMaxDiffVz(1.0),
    fMaxDiffAngle(1E20),
+   fOnlineMix(kFALSE),
+   fMixPoolDepth(0),
+   fMixEventID(0),
+   fMixPools(0x0),
    fOutput(0x0),
+   fCostMonitoring(kFALSE),
+   fCostMonitor(0x0),
+   fCostRegionBuffer(-1),
    fHistograms("AliRsnMiniOutput", 0),
    fValues("AliRsnMiniValue", 0),
    fHEventStat(0x0),
@@ -191,7 +237,14 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMaxDiffMult(copy.fMaxDiffMult),
    fMaxDiffVz(copy.fMaxDiffVz),
    fMaxDiffAngle(copy.fMaxDiffAngle),
+   fOnlineMix(copy.fOnlineMix),
+   fMixPoolDepth(copy.fMixPoolDepth),
+   fMixEventID(0),
+   fMixPools(0x0),
    fOutput(0x0),
+   fCostMonitoring(copy.fCostMonitoring),
+   fCostMonitor(0x0),
+   fCostRegionBuffer(-1),
    fHistograms(copy.fHistograms),
    fValues(copy.fValues),
    fHEventStat(0x0),
@@ -274,6 +327,9 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fESDtrackCuts = copy.fESDtrackCuts;
    fBigOutput = copy.fBigOutput;
    fMixPrintRefresh = copy.fMixPrintRefresh;
+   fOnlineMix = copy.fOnlineMix;
+   fMixPoolDepth = copy.fMixPoolDepth;
+   fCostMonitoring = copy.fCostMonitoring;
    fCheckDecay = copy.fCheckDecay;
    fMaxNDaughters = copy.fMaxNDaughters;
    fCheckP = copy.fCheckP;
@@ -302,6 +358,7 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
       delete fOutput;
       delete fEvBuffer;
    }
+   delete fMixPools;
 }
 
 //__________________________________________________________________________________________________
@@ -354,6 +411,14 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
    fOutput = new TList();
    fOutput->SetOwner();
 
+   // optional cost counters of this wagon, kept in the output list
+   if (fCostMonitoring) {
+      fCostMonitor = new AliTaskCostMonitor(Form("fCostMonitor_%s", GetName()));
+      fCostRegionBuffer = fCostMonitor->AddRegion("FinishTaskOutput");
+      fCostMonitor->SetOutput(fOutput);
+      fOutput->Add(fCostMonitor);
+   }
+
    // initialize event statistics counter
    fHEventStat = new TH1F("hEventStat", "Event statistics", 16, 0.0, 16.0);
    fHEventStat->GetXaxis()->SetBinLabel(1, "CINT1B");
@@ -438,6 +503,8 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
 // creates the corresponding mini-event and stores it in the buffer.
 // The real histogram filling is done at the end, in "FinishTaskOutput".
 //
+   AliTaskCostMonitor::Scope costScope(fCostMonitor, AliTaskCostMonitor::kEvent);
+
    // increment event counter
    fEvNum++;
    
@@ -466,6 +533,14 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    // if the event is not empty, store it
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
+   } else if (fOnlineMix) {
+      // fill the outputs and mix right away, the buffer is filled only if saved to file
+      Int_t id = fMixEventID++;
+      AliDebugClass(2, Form("Processing event #%d with ID = %d", fEvNum, id));
+      fMiniEvent->ID() = id;
+      FillSingleEvent(fMiniEvent, id);
+      MixOnline();
+      if (fRsnTreeInFile) fEvBuffer->Fill();
    } else {
       Int_t id = fEvBuffer->GetEntries();
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
@@ -486,17 +561,26 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 // and then the buffer will be full with all the corresponding mini-events,
 // each one containing all tracks selected by each of the available track cuts.
 // Here a loop is done on each of these events, and both single-event and mixing are computed
+// In online mixing mode, all outputs have already been filled in UserExec.
 //
 
+   if (fOnlineMix) {
+      if (fMixPools) fMixPools->Clear();
+      if (fCostMonitor) fCostMonitor->Finish();
+      PostData(1, fOutput);
+      if (fRsnTreeInFile) PostData(2, fEvBuffer);
+      return;
+   }
+
+   // offline mode: all histograms are filled here
+   AliTaskCostMonitor::Scope costScope(fCostMonitor, fCostRegionBuffer);
+
    // security code: reassign the buffer to the mini-event cursor
    fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
    // prepare variables
    Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
-   Int_t idef, nDefs   = fHistograms.GetEntries();
    Int_t imix, iloop, ifill;
-   AliRsnMiniOutput *def = 0x0;
-   AliRsnMiniOutput::EComputation compType;
 
    Int_t printNum = fMixPrintRefresh;
    if (printNum < 0) {
@@ -517,47 +601,13 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
       }
-      // fill
-      for (idef = 0; idef < nDefs; idef++) {
-         def = (AliRsnMiniOutput *)fHistograms[idef];
-         if (!def) continue;
-         compType = def->GetComputation();
-         // execute computation in the appropriate way
-         switch (compType) {
-            case AliRsnMiniOutput::kEventOnly:
-               //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
-               ifill = 1;
-               def->FillEvent(fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTruePair:
-               //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPair:
-               //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPairRotated1:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPairRotated2:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            default:
-               // other kinds are processed elsewhere
-               ifill = 0;
-               AliDebugClass(2, Form("Computation = %d", (Int_t)compType));
-         }
-         // message
-         AliDebugClass(1, Form("Event %6d: def = '%15s' -- fills = %5d", ievt, def->GetName(), ifill));
-      }
+      FillSingleEvent(fMiniEvent, ievt);
    }
 
    // if no mixing is required, stop here and post the output
    if (fNMix < 1) {
       AliDebugClass(2, "Stopping here, since no mixing is required");
+      if (fCostMonitor) fCostMonitor->Finish();
       PostData(1, fOutput);
       return;
    }
@@ -623,16 +673,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       while ( (os = (TObjString *)next()) ) {
          imix = os->GetString().Atoi();
          fEvBuffer->GetEntry(imix);
-         for (idef = 0; idef < nDefs; idef++) {
-            def = (AliRsnMiniOutput *)fHistograms[idef];
-            if (!def) continue;
-            if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
-            if (!def->IsSymmetric()) {
-               AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
-            }
-         }
+         ifill += FillMixedPair(&evMain, fMiniEvent);
       }
       delete list;
    }
@@ -676,6 +717,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    */
 
    // post computed data
+   if (fCostMonitor) fCostMonitor->Finish();
    PostData(1, fOutput);
    if (fRsnTreeInFile) PostData(2, fEvBuffer);
 }
@@ -1489,6 +1531,134 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniAnalysisTask::FillSingleEvent(AliRsnMiniEvent *event, Int_t ievt)
+{
+//
+// Fill all the outputs which are computed from a single event
+// using the appropriate procedure depending on their type.
+// Returns the number of fills of the last output.
+//
+
+   Int_t idef, nDefs = fHistograms.GetEntries();
+   Int_t ifill = 0;
+   AliRsnMiniOutput *def = 0x0;
+   AliRsnMiniOutput::EComputation compType;
+
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def) continue;
+      compType = def->GetComputation();
+      // execute computation in the appropriate way
+      switch (compType) {
+         case AliRsnMiniOutput::kEventOnly:
+            //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
+            ifill = 1;
+            def->FillEvent(event, &fValues);
+            break;
+         case AliRsnMiniOutput::kTruePair:
+            //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(event, event, &fValues);
+            break;
+         case AliRsnMiniOutput::kTrackPair:
+            //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(event, event, &fValues);
+            break;
+         case AliRsnMiniOutput::kTrackPairRotated1:
+            //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(event, event, &fValues);
+            break;
+         case AliRsnMiniOutput::kTrackPairRotated2:
+            //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
+            ifill = def->FillPair(event, event, &fValues);
+            break;
+         default:
+            // other kinds are processed elsewhere
+            ifill = 0;
+            AliDebugClass(2, Form("Computation = %d", (Int_t)compType));
+      }
+      // message
+      AliDebugClass(1, Form("Event %6d: def = '%15s' -- fills = %5d", ievt, def->GetName(), ifill));
+   }
+   return ifill;
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniAnalysisTask::FillMixedPair(AliRsnMiniEvent *evMain, AliRsnMiniEvent *evMix)
+{
+//
+// Fill all the mixing outputs with the pairs of two matched events.
+// Non symmetric pairs are also filled in the reflected order.
+//
+
+   Int_t idef, nDefs = fHistograms.GetEntries();
+   Int_t ifill = 0;
+   AliRsnMiniOutput *def = 0x0;
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def) continue;
+      if (!def->IsTrackPairMix()) continue;
+      ifill += def->FillPair(evMain, evMix, &fValues, kTRUE);
+      if (!def->IsSymmetric()) {
+         AliDebugClass(2, "Reflecting non symmetric pair");
+         ifill += def->FillPair(evMix, evMain, &fValues, kFALSE);
+      }
+   }
+   return ifill;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::MixOnline()
+{
+//
+// Online mixing of the current mini-event.
+// The event is mixed with the events of its pool which still need mixing partners,
+// in order of arrival, until it reaches the required number of mixes;
+// then it is added to the pool if it needs more partners.
+// The older event of each pair is used as main event, as in the buffered mixing,
+// in which each event looks for its partners among the following ones.
+//
+
+   if (fNMix < 1) return;
+   if (!fMixPools) fMixPools = new RsnMiniMixingPools;
+
+   RsnMiniMixingPools::Key key(0, 0, 0);
+   if (!fContinuousMix) key = RsnMiniMixingPools::Key((Int_t)(fMiniEvent->Vz() / fMaxDiffVz),
+                                                       (Int_t)(fMiniEvent->Mult() / fMaxDiffMult),
+                                                       (Int_t)(fMiniEvent->Angle() / fMaxDiffAngle));
+   RsnMiniMixingPools::Pool &pool = fMixPools->GetPool(key);
+
+   Int_t nmixed = 0, ifill = 0;
+   for (size_t ipool = 0; ipool < pool.size() && nmixed < fNMix; ipool++) {
+      RsnMiniMixingPools::Entry &entry = pool[ipool];
+      if (entry.fNMixed >= fNMix) continue;
+      if (!EventsMatch(entry.fEvent, fMiniEvent)) continue;
+      ifill += FillMixedPair(entry.fEvent, fMiniEvent);
+      entry.fNMixed++;
+      nmixed++;
+   }
+   AliDebugClass(1, Form("Event %5d mixed %d times on arrival (%d fills)", fMiniEvent->ID(), nmixed, ifill));
+
+   // remove the events which do not need more partners
+   size_t nkept = 0;
+   for (size_t ipool = 0; ipool < pool.size(); ipool++) {
+      if (pool[ipool].fNMixed >= fNMix) delete pool[ipool].fEvent;
+      else pool[nkept++] = pool[ipool];
+   }
+   pool.resize(nkept);
+
+   if (nmixed < fNMix) {
+      RsnMiniMixingPools::Entry entry;
+      entry.fEvent = new AliRsnMiniEvent(*fMiniEvent);
+      entry.fNMixed = nmixed;
+      pool.push_back(entry);
+   }
+   while (fMixPoolDepth > 0 && (Int_t)pool.size() > fMixPoolDepth) {
+      delete pool.front().fEvent;
+      pool.pop_front();
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
@@ -30,6 +30,8 @@ class AliRsnMiniEvent;
 class AliRsnCutSet;
 class AliQnCorrectionsManager;
 class AliQnCorrectionsQnVector;
+class RsnMiniMixingPools;
+class AliTaskCostMonitor;
 
 class AliRsnMiniAnalysisTask : public AliAnalysisTaskSE {
 
@@ -54,6 +56,9 @@ public:
    void                UseContinuousMix()                 {fContinuousMix = kTRUE;}
    void                UseBinnedMix()                     {fContinuousMix = kFALSE;}
    void                SetNMix(Int_t nmix)                {fNMix = nmix;}
+   void                UseOnlineMixing(Bool_t yn = kTRUE, Int_t poolDepth = 0) {fOnlineMix = yn; fMixPoolDepth = poolDepth;}
+   void                SetCostMonitoring(Bool_t yn = kTRUE) {fCostMonitoring = yn;}
+   AliTaskCostMonitor *GetCostMonitor() const             {return fCostMonitor;}
    void                SetMaxDiffMult (Double_t val)      {fMaxDiffMult  = val;}
    void                SetMaxDiffVz   (Double_t val)      {fMaxDiffVz    = val;}
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
@@ -101,6 +106,9 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Int_t    FillSingleEvent(AliRsnMiniEvent *event, Int_t ievt);
+   Int_t    FillMixedPair(AliRsnMiniEvent *evMain, AliRsnMiniEvent *evMix);
+   void     MixOnline();
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -123,8 +131,15 @@ private:
    Double_t             fMaxDiffMult;     //  mixing --> max difference in multiplicity
    Double_t             fMaxDiffVz;       //  mixing --> max difference in Vz of prim vert
    Double_t             fMaxDiffAngle;    //  mixing --> max difference in reaction plane angle
+   Bool_t               fOnlineMix;       //  mixing --> pair each event with the pool of its bin when it arrives, instead of using the buffer in FinishTaskOutput
+   Int_t                fMixPoolDepth;    //  mixing --> max number of events kept in each online pool (0 = no limit)
+   Int_t                fMixEventID;      //! mixing --> ID of the next event in online mixing
+   RsnMiniMixingPools  *fMixPools;        //! mixing --> pools of mini-events for online mixing
 
    TList               *fOutput;          //  output list
+   Bool_t               fCostMonitoring;  //  store the cost counters of this wagon in the output list
+   AliTaskCostMonitor  *fCostMonitor;     //! cost counters of this wagon
+   Int_t                fCostRegionBuffer;//! cost region of the processing of the buffer in FinishTaskOutput
    TClonesArray         fHistograms;      //  list of histogram definitions
    TClonesArray         fValues;          //  list of values to be computed
    TH1F                *fHEventStat;      //  histogram of event statistics
@@ -158,7 +173,7 @@ private:
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
    Bool_t               fRsnTreeInFile;  // flag rsn tree should be saved in file instead of memory
 
-   ClassDef(AliRsnMiniAnalysisTask, 15);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 17);   // AliRsnMiniAnalysisTask
 };
 
 
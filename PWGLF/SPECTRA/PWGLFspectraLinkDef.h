@@ -61,6 +61,9 @@
 
 #pragma link C++ class AliAnalysisPIDEvent+;
 #pragma link C++ class AliAnalysisPIDParticle+;
+#pragma link C++ class AliAnalysisPIDSkim+;
+#pragma link C++ struct AliAnalysisPIDSkim::Record_t+;
+#pragma link C++ struct AliAnalysisPIDSkim::FitBinning_t+;
 #pragma link C++ class AliAnalysisPIDTrack+;
 #pragma link C++ class AliAnalysisPIDV0+;
 #pragma link C++ class AliAnalysisTaskTPCTOFPID+;
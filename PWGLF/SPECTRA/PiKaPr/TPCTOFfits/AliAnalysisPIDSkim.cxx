@@ -0,0 +1,247 @@
+#include "AliAnalysisPIDSkim.h"
+#include "AliAnalysisPIDEvent.h"
+#include "AliAnalysisPIDTrack.h"
+#include "AliPID.h"
+#include "TTree.h"
+#include "TList.h"
+#include "TH3F.h"
+#include "TMath.h"
+#include "TString.h"
+#include "AliLog.h"
+#include <cstring>
+
+ClassImp(AliAnalysisPIDSkim)
+
+//___________________________________________________________
+
+const Char_t *AliAnalysisPIDSkim::fgkSpeciesName[AliAnalysisPIDSkim::kNSpecies] = {
+  "pion",
+  "kaon",
+  "proton"
+};
+
+//___________________________________________________________
+
+AliAnalysisPIDSkim::AliAnalysisPIDSkim() :
+  TObject(),
+  fRecord()
+{
+  /*
+   * default constructor
+   */
+
+  memset(&fRecord, 0, sizeof(fRecord));
+}
+
+//___________________________________________________________
+
+void
+AliAnalysisPIDSkim::Branch(TTree *tree)
+{
+  /*
+   * create one branch per column
+   */
+
+  tree->Branch("pt", &fRecord.fPt, "pt/F");
+  tree->Branch("p", &fRecord.fP, "p/F");
+  tree->Branch("eta", &fRecord.fEta, "eta/F");
+  tree->Branch("dcaxy", &fRecord.fDCAxy, "dcaxy/F");
+  tree->Branch("dcaz", &fRecord.fDCAz, "dcaz/F");
+  tree->Branch("tpcdedx", &fRecord.fTPCdEdx, "tpcdedx/F");
+  tree->Branch("nsigmatpc", fRecord.fNSigmaTPC, Form("nsigmatpc[%d]/F", kNSpecies));
+  tree->Branch("nsigmatof", fRecord.fNSigmaTOF, Form("nsigmatof[%d]/F", kNSpecies));
+  tree->Branch("trackcutflag", &fRecord.fTrackCutFlag, "trackcutflag/I");
+  tree->Branch("flags", &fRecord.fFlags, "flags/I");
+  tree->Branch("centrality", &fRecord.fCentrality, "centrality/F");
+  tree->Branch("vertexz", &fRecord.fVertexZ, "vertexz/F");
+  tree->Branch("eventflags", &fRecord.fEventFlags, "eventflags/I");
+}
+
+//___________________________________________________________
+
+Bool_t
+AliAnalysisPIDSkim::SetBranchAddresses(TTree *tree)
+{
+  /*
+   * connect the branches for reading
+   */
+
+  if (!tree || !tree->GetBranch("pt")) return kFALSE;
+  tree->SetBranchAddress("pt", &fRecord.fPt);
+  tree->SetBranchAddress("p", &fRecord.fP);
+  tree->SetBranchAddress("eta", &fRecord.fEta);
+  tree->SetBranchAddress("dcaxy", &fRecord.fDCAxy);
+  tree->SetBranchAddress("dcaz", &fRecord.fDCAz);
+  tree->SetBranchAddress("tpcdedx", &fRecord.fTPCdEdx);
+  tree->SetBranchAddress("nsigmatpc", fRecord.fNSigmaTPC);
+  tree->SetBranchAddress("nsigmatof", fRecord.fNSigmaTOF);
+  tree->SetBranchAddress("trackcutflag", &fRecord.fTrackCutFlag);
+  tree->SetBranchAddress("flags", &fRecord.fFlags);
+  tree->SetBranchAddress("centrality", &fRecord.fCentrality);
+  tree->SetBranchAddress("vertexz", &fRecord.fVertexZ);
+  tree->SetBranchAddress("eventflags", &fRecord.fEventFlags);
+  return kTRUE;
+}
+
+//___________________________________________________________
+
+void
+AliAnalysisPIDSkim::Fill(AliAnalysisPIDTrack *track, AliAnalysisPIDEvent *event)
+{
+  /*
+   * fill the record from a track
+   */
+
+  fRecord.fPt = track->GetPt();
+  fRecord.fP = track->GetP();
+  fRecord.fEta = track->GetEta();
+  fRecord.fDCAxy = track->GetImpactParameter(0);
+  fRecord.fDCAz = track->GetImpactParameter(1);
+  fRecord.fTPCdEdx = track->GetTPCdEdx();
+  fRecord.fNSigmaTPC[kPion] = track->GetNSigmaPionTPC();
+  fRecord.fNSigmaTPC[kKaon] = track->GetNSigmaKaonTPC();
+  fRecord.fNSigmaTPC[kProton] = track->GetNSigmaProtonTPC();
+  fRecord.fNSigmaTOF[kPion] = track->GetNSigmaPionTOF();
+  fRecord.fNSigmaTOF[kKaon] = track->GetNSigmaKaonTOF();
+  fRecord.fNSigmaTOF[kProton] = track->GetNSigmaProtonTOF();
+  fRecord.fTrackCutFlag = track->GetTrackCutFlag();
+  fRecord.fFlags = 0;
+  if (track->GetSign() > 0.) fRecord.fFlags |= kPositive;
+  if (track->HasTPCPID()) fRecord.fFlags |= kHasTPCPID;
+  if (track->HasTOFPID()) fRecord.fFlags |= kHasTOFPID;
+  fRecord.fCentrality = event->GetV0Mmultiplicity();
+  fRecord.fVertexZ = event->GetVertexZ();
+  fRecord.fEventFlags = event->GetEventFlags();
+}
+
+//___________________________________________________________
+
+Float_t
+AliAnalysisPIDSkim::GetRapidity(const Record_t &rec, Int_t ispecies)
+{
+  /*
+   * rapidity with the mass of the species
+   */
+
+  const Int_t kPIDindex[kNSpecies] = {AliPID::kPion, AliPID::kKaon, AliPID::kProton};
+  Double_t mass = AliPID::ParticleMass(kPIDindex[ispecies]);
+  Double_t pz = rec.fPt * TMath::SinH(rec.fEta);
+  Double_t e = TMath::Sqrt(mass * mass + rec.fPt * rec.fPt + pz * pz);
+  return 0.5 * TMath::Log((e + pz) / (e - pz));
+}
+
+//___________________________________________________________
+
+void
+AliAnalysisPIDSkim::SetDefaultBinning(FitBinning_t &binning)
+{
+  /*
+   * default binning
+   */
+
+  const Int_t nptbins = 46;
+  Double_t ptbins[nptbins + 1] = {
+    0.20, 0.25, 0.30, 0.35, 0.40, 0.45, 0.50, 0.55, 0.60, 0.65,
+    0.70, 0.75, 0.80, 0.85, 0.90, 0.95, 1.00, 1.10, 1.20, 1.30,
+    1.40, 1.50, 1.60, 1.70, 1.80, 1.90, 2.00, 2.10, 2.20, 2.30,
+    2.40, 2.50, 2.60, 2.70, 2.80, 2.90, 3.00, 3.20, 3.40, 3.60,
+    3.80, 4.00, 4.50, 5.00, 6.00, 8.00, 10.00
+  };
+  const Int_t ncentbins = 10;
+  Double_t centbins[ncentbins + 1] = {0., 1., 5., 10., 15., 20., 30., 40., 50., 70., 100.};
+  binning.fPtBins.Set(nptbins + 1, ptbins);
+  binning.fCentralityBins.Set(ncentbins + 1, centbins);
+  binning.fNSigmaBins = 100;
+  binning.fNSigmaMin = -10.;
+  binning.fNSigmaMax = 10.;
+  binning.fRapidityCut = 0.5;
+  binning.fTrackCutFlag = 0;
+  binning.fEventFlags = 0;
+}
+
+//___________________________________________________________
+
+TList *
+AliAnalysisPIDSkim::BuildFitInputs(TTree *tree, const FitBinning_t &binning, Long64_t nentries)
+{
+  /*
+   * fit inputs for all species, charges, pt and centrality bins
+   * in a single pass over the skim
+   */
+
+  AliAnalysisPIDSkim skim;
+  if (!skim.SetBranchAddresses(tree)) {
+    AliErrorClass("not a PID skim tree");
+    return NULL;
+  }
+  Int_t nptbins = binning.fPtBins.GetSize() - 1;
+  Int_t ncentbins = binning.fCentralityBins.GetSize() - 1;
+  if (nptbins < 1 || ncentbins < 1 || binning.fNSigmaBins < 1) {
+    AliErrorClass("invalid binning");
+    return NULL;
+  }
+  const Double_t *ptbins = binning.fPtBins.GetArray();
+  const Double_t *centbins = binning.fCentralityBins.GetArray();
+
+  /* uniform nsigma axes */
+  TArrayD nsigmabins(binning.fNSigmaBins + 1);
+  Double_t step = (binning.fNSigmaMax - binning.fNSigmaMin) / binning.fNSigmaBins;
+  for (Int_t i = 0; i <= binning.fNSigmaBins; i++)
+    nsigmabins[i] = binning.fNSigmaMin + i * step;
+  /* tracks without TOF PID go to the underflow */
+  Float_t noTOF = binning.fNSigmaMin - 1.;
+
+  /* histograms: [species][charge][centrality] */
+  TList *list = new TList();
+  list->SetOwner(kTRUE);
+  const Char_t *chargeName[2] = {"negative", "positive"};
+  TH3F **hfit = new TH3F *[kNSpecies * 2 * ncentbins];
+  for (Int_t ipart = 0; ipart < kNSpecies; ipart++)
+    for (Int_t icharge = 0; icharge < 2; icharge++)
+      for (Int_t icent = 0; icent < ncentbins; icent++) {
+        TH3F *h = new TH3F(Form("hTPCTOF_%s_%s_cent%d", fgkSpeciesName[ipart], chargeName[icharge], icent),
+                           Form("%s %s, centrality %.0f-%.0f%%;p_{T} (GeV/c);n#sigma_{TPC};n#sigma_{TOF}",
+                                chargeName[icharge], fgkSpeciesName[ipart], centbins[icent], centbins[icent + 1]),
+                           nptbins, ptbins,
+                           binning.fNSigmaBins, nsigmabins.GetArray(),
+                           binning.fNSigmaBins, nsigmabins.GetArray());
+        list->Add(h);
+        hfit[(ipart * 2 + icharge) * ncentbins + icent] = h;
+      }
+
+  /* read only the needed columns */
+  tree->SetBranchStatus("*", 0);
+  tree->SetBranchStatus("pt", 1);
+  tree->SetBranchStatus("eta", 1);
+  tree->SetBranchStatus("nsigmatpc", 1);
+  tree->SetBranchStatus("nsigmatof", 1);
+  tree->SetBranchStatus("trackcutflag", 1);
+  tree->SetBranchStatus("flags", 1);
+  tree->SetBranchStatus("centrality", 1);
+  tree->SetBranchStatus("eventflags", 1);
+
+  /* single pass */
+  const Record_t &rec = skim.GetRecord();
+  Long64_t nent = tree->GetEntries();
+  if (nentries >= 0 && nentries < nent) nent = nentries;
+  for (Long64_t ient = 0; ient < nent; ient++) {
+    tree->GetEntry(ient);
+    if (binning.fTrackCutFlag && !(rec.fTrackCutFlag & binning.fTrackCutFlag)) continue;
+    if (binning.fEventFlags && (rec.fEventFlags & binning.fEventFlags) != binning.fEventFlags) continue;
+    if (!(rec.fFlags & kHasTPCPID)) continue;
+    if (rec.fPt < ptbins[0] || rec.fPt >= ptbins[nptbins]) continue;
+    if (rec.fCentrality < centbins[0] || rec.fCentrality >= centbins[ncentbins]) continue;
+    Int_t icent = TMath::BinarySearch(ncentbins + 1, centbins, (Double_t)rec.fCentrality);
+    Int_t icharge = (rec.fFlags & kPositive) ? 1 : 0;
+    Bool_t hasTOF = rec.fFlags & kHasTOFPID;
+    for (Int_t ipart = 0; ipart < kNSpecies; ipart++) {
+      if (TMath::Abs(GetRapidity(rec, ipart)) > binning.fRapidityCut) continue;
+      hfit[(ipart * 2 + icharge) * ncentbins + icent]->Fill(rec.fPt, rec.fNSigmaTPC[ipart], hasTOF ? rec.fNSigmaTOF[ipart] : noTOF);
+    }
+  }
+  tree->SetBranchStatus("*", 1);
+  tree->ResetBranchAddresses();
+  delete [] hfit;
+
+  return list;
+}
@@ -0,0 +1,92 @@
+#ifndef ALIANALYSISPIDSKIM_H
+#define ALIANALYSISPIDSKIM_H
+
+#include "TObject.h"
+#include "TArrayD.h"
+
+class TTree;
+class TList;
+class AliAnalysisPIDEvent;
+class AliAnalysisPIDTrack;
+
+/*
+ * Columnar PID skim for the TPC-TOF fits: one tree entry per accepted
+ * track, one branch per quantity used by the fits (the event quantities
+ * are repeated in each entry). Written by AliAnalysisTaskTPCTOFPID in
+ * skim mode instead of the AliAnalysisPID* objects.
+ *
+ * BuildFitInputs fills in a single pass over the skim the signal
+ * distributions of all species, charges, pt and centrality bins:
+ * one TH3F (pt, nsigma TPC, nsigma TOF) per species, charge and
+ * centrality bin. Tracks without TOF PID go to the underflow of the
+ * TOF axis, so the TPC-only distribution is the projection of the
+ * full TOF range including the underflow.
+ */
+
+class AliAnalysisPIDSkim :
+public TObject
+{
+
+ public:
+
+  enum ESpecies_t {kPion, kKaon, kProton, kNSpecies};
+  enum ETrackFlags_t {
+    kPositive = 1,
+    kHasTPCPID = 2,
+    kHasTOFPID = 4
+  };
+
+  /* one skimmed track */
+  struct Record_t {
+    Float_t fPt; // pt
+    Float_t fP; // p
+    Float_t fEta; // eta
+    Float_t fDCAxy; // impact parameter xy
+    Float_t fDCAz; // impact parameter z
+    Float_t fTPCdEdx; // TPC dEdx
+    Float_t fNSigmaTPC[kNSpecies]; // TPC nsigma pi, K, p
+    Float_t fNSigmaTOF[kNSpecies]; // TOF nsigma pi, K, p
+    Int_t fTrackCutFlag; // track cuts flag
+    Int_t fFlags; // ETrackFlags_t
+    Float_t fCentrality; // V0M percentile of the event
+    Float_t fVertexZ; // vertex z of the event
+    Int_t fEventFlags; // AliAnalysisPIDEvent::EventFlags_t of the event
+  };
+
+  /* binning of the fit inputs */
+  struct FitBinning_t {
+    TArrayD fPtBins; // pt bin edges
+    TArrayD fCentralityBins; // centrality bin edges
+    Int_t fNSigmaBins; // number of nsigma bins
+    Float_t fNSigmaMin; // nsigma range
+    Float_t fNSigmaMax; // nsigma range
+    Float_t fRapidityCut; // |y| cut with the mass of the species
+    Int_t fTrackCutFlag; // required track cuts flag (0: none)
+    Int_t fEventFlags; // required event flags (0: none)
+  };
+
+  AliAnalysisPIDSkim(); // default constructor
+  virtual ~AliAnalysisPIDSkim() {}; // default destructor
+
+  void Branch(TTree *tree); // create the branches
+  Bool_t SetBranchAddresses(TTree *tree); // connect the branches for reading
+  void Fill(AliAnalysisPIDTrack *track, AliAnalysisPIDEvent *event); // fill the record from a track
+  const Record_t &GetRecord() const {return fRecord;}; // getter
+
+  static Float_t GetRapidity(const Record_t &rec, Int_t ispecies); // rapidity with the mass of the species
+  static void SetDefaultBinning(FitBinning_t &binning); // default binning
+  static TList *BuildFitInputs(TTree *tree, const FitBinning_t &binning, Long64_t nentries = -1); // fit inputs
+
+  static const Char_t *fgkSpeciesName[kNSpecies]; // species name
+
+ private:
+
+  AliAnalysisPIDSkim(const AliAnalysisPIDSkim &source); // not implemented
+  AliAnalysisPIDSkim &operator=(const AliAnalysisPIDSkim &source); // not implemented
+
+  Record_t fRecord; //! current record
+
+  ClassDef(AliAnalysisPIDSkim, 1);
+};
+
+#endif /* ALIANALYSISPIDSKIM_H */
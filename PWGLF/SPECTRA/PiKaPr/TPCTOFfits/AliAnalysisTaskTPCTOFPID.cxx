@@ -23,6 +23,7 @@
 #include "AliAnalysisPIDTrack.h"
 #include "AliAnalysisPIDParticle.h"
 #include "AliAnalysisPIDEvent.h"
+#include "AliAnalysisPIDSkim.h"
 #include "TClonesArray.h"
 #include "AliAnalysisManager.h"
 #include "AliAODHandler.h"
@@ -57,6 +58,7 @@ AliAnalysisTaskTPCTOFPID::AliAnalysisTaskTPCTOFPID() :
   fPbPbFlag(kFALSE),
   fVertexSelectionFlag(kFALSE),
   fPrimaryDCASelectionFlag(kFALSE),
+  fSkimFlag(kFALSE),
   fPIDTree(0),
   fEvHist(0),
   fPIDResponse(0),
@@ -86,6 +88,7 @@ AliAnalysisTaskTPCTOFPID::AliAnalysisTaskTPCTOFPID() :
   fAnalysisParticle(new AliAnalysisPIDParticle()),
   fAnalysisV0TrackArray(new TClonesArray("AliAnalysisPIDV0")),
   fAnalysisV0Track(new AliAnalysisPIDV0()),
+  fPIDSkim(NULL),
   fTOFcalib(new AliTOFcalib()),
   fTOFT0maker(new AliTOFT0maker(fESDpid)),
   fTimeResolution(80.),
@@ -129,6 +132,7 @@ AliAnalysisTaskTPCTOFPID::AliAnalysisTaskTPCTOFPID(Bool_t isMC) :
   fPbPbFlag(kFALSE),
   fVertexSelectionFlag(kFALSE),
   fPrimaryDCASelectionFlag(kFALSE),
+  fSkimFlag(kFALSE),
   fPIDTree(0),
   fEvHist(0),
   fPIDResponse(0),
@@ -158,6 +162,7 @@ AliAnalysisTaskTPCTOFPID::AliAnalysisTaskTPCTOFPID(Bool_t isMC) :
   fAnalysisParticle(new AliAnalysisPIDParticle()),
   fAnalysisV0TrackArray(new TClonesArray("AliAnalysisPIDV0")),
   fAnalysisV0Track(new AliAnalysisPIDV0()),
+  fPIDSkim(NULL),
   fTOFcalib(new AliTOFcalib()),
   fTOFT0maker(new AliTOFT0maker(fESDpid)),
   fTimeResolution(80.),
@@ -222,6 +227,7 @@ AliAnalysisTaskTPCTOFPID::~AliAnalysisTaskTPCTOFPID()
   delete fTOFT0maker;
   delete fHistoList;
   delete fMCHistoList;
+  delete fPIDSkim;
 }
 
 
@@ -236,12 +242,20 @@ AliAnalysisTaskTPCTOFPID::UserCreateOutputObjects()
   OpenFile(1);
   OpenFile(2);
   /* output tree */
-  fPIDTree = new TTree("PIDTree","PIDTree");
-  fPIDTree->Branch("AnalysisEvent", "AliAnalysisPIDEvent", &fAnalysisEvent);  
-  fPIDTree->Branch("AnalysisTrack", "TClonesArray", &fAnalysisTrackArray); 
-  fPIDTree->Branch("AnalysisV0Track","TClonesArray",&fAnalysisV0TrackArray);
-  if (fMCFlag)
-    fPIDTree->Branch("AnalysisParticle", "TClonesArray", &fAnalysisParticleArray);
+  if (fSkimFlag) {
+    /* one entry per track, fit quantities only */
+    fPIDTree = new TTree("PIDSkim","PIDSkim");
+    fPIDSkim = new AliAnalysisPIDSkim();
+    fPIDSkim->Branch(fPIDTree);
+  }
+  else {
+    fPIDTree = new TTree("PIDTree","PIDTree");
+    fPIDTree->Branch("AnalysisEvent", "AliAnalysisPIDEvent", &fAnalysisEvent);  
+    fPIDTree->Branch("AnalysisTrack", "TClonesArray", &fAnalysisTrackArray); 
+    fPIDTree->Branch("AnalysisV0Track","TClonesArray",&fAnalysisV0TrackArray);
+    if (fMCFlag)
+      fPIDTree->Branch("AnalysisParticle", "TClonesArray", &fAnalysisParticleArray);
+  }
 
 
   AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
@@ -719,6 +733,11 @@ AliAnalysisTaskTPCTOFPID::UserExec(Option_t *option)
       if(lvcl)
 	fAnalysisTrack->SetEMCalPars(lvcl->E(),track->GetTrackPOnEMCal());
     };
+    if (fSkimFlag) {
+      fPIDSkim->Fill(fAnalysisTrack, fAnalysisEvent);
+      fPIDTree->Fill();
+      continue;
+    }
     new ((*fAnalysisTrackArray)[fAnalysisTrackArray->GetEntries()]) AliAnalysisPIDTrack(*fAnalysisTrack);
     //fAnalysisV0Track = (V0Track*)fAnalysisTrack;
     /*fAnalysisV0Track->SetExtraParam(3);
@@ -726,8 +745,10 @@ AliAnalysisTaskTPCTOFPID::UserExec(Option_t *option)
     
 
   } /* end of loop over ESD tracks */
-  ProcessV0s();
-  fPIDTree->Fill();
+  if (!fSkimFlag) {
+    ProcessV0s();
+    fPIDTree->Fill();
+  }
 
   PostData(1,fPIDTree);
   PostData(2,fEvHist);
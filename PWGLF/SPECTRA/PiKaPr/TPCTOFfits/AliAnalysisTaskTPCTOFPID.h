@@ -25,6 +25,7 @@ class TObjArray;
 class AliAnalysisPIDEvent;
 class AliAnalysisPIDTrack;
 class AliAnalysisPIDParticle;
+class AliAnalysisPIDSkim;
 class TClonesArray;
 class AliCentrality;
 class AliPIDResponse;
@@ -65,6 +66,7 @@ public AliAnalysisTaskSE
   void SetVertexCut(Double_t value) {fVertexCut = value;}; // setter
   void SetRapidityCut(Double_t value) {fRapidityCut = value;}; // setter
   void SetTimeResolution(Double_t value) {fTimeResolution = value;}; // setter
+  void SetSkimFlag(Bool_t value = kTRUE) {fSkimFlag = value;}; // write the columnar PID skim instead of the PID objects
   void ProcessV0s();
   void FillHist(Double_t myflag);
   Bool_t IsGoodSPDvertexRes(const AliESDVertex * spdVertex = NULL);
@@ -94,6 +96,7 @@ public AliAnalysisTaskSE
   Bool_t fPbPbFlag; // PbPb flag
   Bool_t fVertexSelectionFlag; // vertex selection flag
   Bool_t fPrimaryDCASelectionFlag; // primary DCA selection flag
+  Bool_t fSkimFlag; // skim flag
   TTree *fPIDTree;
   TH1D *fEvHist;
   /* ESD analysis */
@@ -125,6 +128,7 @@ public AliAnalysisTaskSE
   AliAnalysisPIDParticle *fAnalysisParticle; // analysis particle
   TClonesArray *fAnalysisV0TrackArray; //V0 track array
   AliAnalysisPIDV0 *fAnalysisV0Track; //V0 track object
+  AliAnalysisPIDSkim *fPIDSkim; //! columnar PID skim
 
   /* TOF related */
   AliTOFcalib *fTOFcalib; // TOF calib
@@ -146,7 +150,7 @@ public AliAnalysisTaskSE
   TList *fMCHistoList; // MC histo list
 
   
-  ClassDef(AliAnalysisTaskTPCTOFPID, 3);
+  ClassDef(AliAnalysisTaskTPCTOFPID, 4);
 };
 
 #endif /* ALIANALYSISTASKTPCTOFPID_H */
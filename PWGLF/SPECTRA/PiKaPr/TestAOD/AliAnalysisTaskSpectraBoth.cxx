@@ -47,6 +47,8 @@
 #include "AliSpectraBothPID.h"
 #include "AliGenEventHeader.h"	
 #include <TMCProcess.h>
+#include "TList.h"
+#include "TObjArray.h"
 
 #include <iostream>
 
@@ -59,7 +61,7 @@ using namespace std;
 ClassImp(AliAnalysisTaskSpectraBoth)
 
 //________________________________________________________________________
-AliAnalysisTaskSpectraBoth::AliAnalysisTaskSpectraBoth(const char *name) : AliAnalysisTaskSE(name), fAOD(0), fHistMan(0), fTrackCuts(0), fEventCuts(0),  fPID(0), fIsMC(0), fNRebin(0),fUseMinSigma(0),fCuts(0),fdotheMCLoopAfterEventCuts(0),fmakePIDQAhisto(1),fMotherWDPDGcode(-1),fUseEtaCut(kFALSE),fIncludecorrectlyidentifiedinMCtemplates(kFALSE)
+AliAnalysisTaskSpectraBoth::AliAnalysisTaskSpectraBoth(const char *name) : AliAnalysisTaskSE(name), fAOD(0), fHistMan(0), fTrackCuts(0), fEventCuts(0),  fPID(0), fIsMC(0), fNRebin(0),fUseMinSigma(0),fCuts(0),fdotheMCLoopAfterEventCuts(0),fmakePIDQAhisto(1),fMotherWDPDGcode(-1),fUseEtaCut(kFALSE),fIncludecorrectlyidentifiedinMCtemplates(kFALSE),fCutVariants(0),fCutVariantBits(),fVariantHistMan(0)
 
 {
   // Default constructor
@@ -69,10 +71,37 @@ AliAnalysisTaskSpectraBoth::AliAnalysisTaskSpectraBoth(const char *name) : AliAn
   DefineOutput(2, AliSpectraBothEventCuts::Class());
   DefineOutput(3, AliSpectraBothTrackCuts::Class());
   DefineOutput(4, AliSpectraBothPID::Class());
+  DefineOutput(5, TList::Class());
   fNRebin=0;
   
 }
 //________________________________________________________________________
+void AliAnalysisTaskSpectraBoth::AddTrackCutVariant(AliESDtrackCuts* cuts, UInt_t trkbit)
+{
+  // add a track type variant: on ESDs the tracks are selected with cuts, on AODs with the filter bits trkbit
+  // (0: the filter bits of the nominal track cuts); all other cuts, the PID and the MC matching are
+  // evaluated once per track and shared with the nominal selection
+  if(!cuts)
+  {
+	AliError("No track cuts given for the variant");
+	return;
+  }
+  if(GetNTrackCutVariants()>=31)
+  {
+	AliError("At most 31 track cut variants are supported");
+	return;
+  }
+  if(!fCutVariants)
+  {
+	fCutVariants=new TObjArray();
+	fCutVariants->SetOwner(kTRUE);
+  }
+  Int_t n=fCutVariants->GetEntriesFast();
+  fCutVariants->AddLast(cuts);
+  fCutVariantBits.Set(n+1);
+  fCutVariantBits[n]=trkbit;
+}
+//________________________________________________________________________
 //________________________________________________________________________
 void AliAnalysisTaskSpectraBoth::UserCreateOutputObjects()
 {
@@ -84,6 +113,18 @@ void AliAnalysisTaskSpectraBoth::UserCreateOutputObjects()
   if (!fEventCuts) AliFatal("Event Cuts should be set in the steering macro");
   if (!fPID)       AliFatal("PID object should be set in the steering macro");
   fTrackCuts->SetAliESDtrackCuts(fCuts);
+  fVariantHistMan = new TList();
+  fVariantHistMan->SetOwner(kTRUE);
+  for(Int_t i=0;i<GetNTrackCutVariants();i++)
+  {
+	if(fTrackCuts->GetTrackType()&&!fCutVariantBits[i])
+		fCutVariantBits[i]=fTrackCuts->GetTrackType();
+	// PID QA histos are only made for the nominal cuts
+	AliSpectraBothHistoManager* hman=new AliSpectraBothHistoManager(Form("SpectraHistos_%s",fCutVariants->At(i)->GetName()),fNRebin,kFALSE);
+	hman->SetIncludecorrectlyidentifiedinMCtemplates(fIncludecorrectlyidentifiedinMCtemplates);
+	fVariantHistMan->Add(hman);
+  }
+  fTrackCuts->SetTrackTypeVariants(fCutVariants,&fCutVariantBits);
   fEventCuts->InitHisto();
   fTrackCuts->InitHisto();
   if(fTrackCuts->GetYMax()<fTrackCuts->GetYMin()) 
@@ -95,6 +136,7 @@ void AliAnalysisTaskSpectraBoth::UserCreateOutputObjects()
   PostData(2, fEventCuts);
   PostData(3, fTrackCuts);
   PostData(4, fPID      );
+  PostData(5, fVariantHistMan);
 }
 //________________________________________________________________________
 void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
@@ -127,6 +169,8 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
 	if(fdotheMCLoopAfterEventCuts)
   		if(!fEventCuts->IsSelected(fAOD,fTrackCuts,fIsMC,-100,fHistMan->GetEventStatHist()))
 			return;//event selection
+  	// nominal histo manager and one per track type variant
+  	const Int_t nhman=1+GetNTrackCutVariants();
   	TClonesArray *arrayMC = 0;
   	Int_t npar=0;
   	AliStack* stack=0x0;
@@ -169,7 +213,8 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
 				  //Printf("%f     %f-%f",partMC->Eta(),fTrackCuts->GetEtaMin(),fTrackCuts->GetEtaMax());
 				  if(partMC->Eta() > fTrackCuts->GetEtaMin() && partMC->Eta() < fTrackCuts->GetEtaMax())
 				  {
-						fHistMan->GetPtHistogram(kHistPtGen)->Fill(partMC->Pt(),partMC->IsPhysicalPrimary());
+						for(Int_t ihman=0;ihman<nhman;ihman++)
+							GetHistoManager(ihman)->GetPtHistogram(kHistPtGen)->Fill(partMC->Pt(),partMC->IsPhysicalPrimary());
 				  }
 				  else 
 				  {
@@ -189,7 +234,8 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
 				  Int_t id = fPID->GetParticleSpecie(partMC);
 				  if(id != kSpUndefined) 
 				  {
-					fHistMan->GetHistogram2D(kHistPtGenTruePrimary,id,chargetmp)->Fill(partMC->Pt(),partMC->IsPhysicalPrimary());
+					for(Int_t ihman=0;ihman<nhman;ihman++)
+						GetHistoManager(ihman)->GetHistogram2D(kHistPtGenTruePrimary,id,chargetmp)->Fill(partMC->Pt(),partMC->IsPhysicalPrimary());
 				  }
 			  }
 		  }
@@ -211,7 +257,8 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
 					continue;//Skip neutrals
 			 	if(partMC->Eta() > fTrackCuts->GetEtaMin() && partMC->Eta() < fTrackCuts->GetEtaMax())
 				{
-					fHistMan->GetPtHistogram(kHistPtGen)->Fill(partMC->Pt(),stack->IsPhysicalPrimary(iMC));
+					for(Int_t ihman=0;ihman<nhman;ihman++)
+						GetHistoManager(ihman)->GetPtHistogram(kHistPtGen)->Fill(partMC->Pt(),stack->IsPhysicalPrimary(iMC));
 				}
 				else 
 				{
@@ -230,7 +277,8 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
 				Int_t id = fPID->GetParticleSpecie(partMC);
 				if(id != kSpUndefined) 
 				{
-					fHistMan->GetHistogram2D(kHistPtGenTruePrimary,id,chargetmp)->Fill(partMC->Pt(),stack->IsPhysicalPrimary(iMC));
+					for(Int_t ihman=0;ihman<nhman;ihman++)
+						GetHistoManager(ihman)->GetHistogram2D(kHistPtGenTruePrimary,id,chargetmp)->Fill(partMC->Pt(),stack->IsPhysicalPrimary(iMC));
 				}
 			  }
 		  }
@@ -239,7 +287,9 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
   		if(!fEventCuts->IsSelected(fAOD,fTrackCuts,fIsMC,mcZ,fHistMan->GetEventStatHist()))
 			return;//event selection
   	//main loop on tracks
-	Int_t ntracks=0;
+	// the cuts common to all track type variants, the PID and the MC matching are evaluated once per track
+	TArrayI ntracks(nhman);
+	TrackRecord_t rec;
   	//cout<<fAOD->GetNumberOfTracks()<<endl;
   	for (Int_t iTracks = 0; iTracks < fAOD->GetNumberOfTracks(); iTracks++) 
 	{
@@ -276,10 +326,13 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
   		}
   		else
 			continue;
-    		if (!fTrackCuts->IsSelected(track,kTRUE)) 
+		UInt_t selmask=fTrackCuts->GetSelectionMask(track,kTRUE);
+    		if (!selmask) 
 			continue;	
 			
-    		ntracks++;
+		for(Int_t ihman=0;ihman<nhman;ihman++)
+			if(selmask&(1<<ihman))
+    				ntracks[ihman]++;
 	
     		
 		//calculate DCA for AOD track
@@ -294,73 +347,47 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
       			dca=d[0];
 			dcaz=d[1];	
     		}
+		rec.fTrack=track;
+		rec.fDCA=dca;
+		rec.fDCAz=dcaz;
+		rec.fNcls=ncls;
+		rec.fChi2perNDF=chi2perndf;
+		rec.fCharge=track->Charge() > 0 ? kChPos : kChNeg;
 	
-     		fHistMan->GetPtHistogram(kHistPtRec)->Fill(track->Pt(),dca);  // PT histo
-    		// get identity and charge
-    		Bool_t rec[3]={false,false,false};
-		Bool_t sel[3]={false,false,false};
-    		Int_t idRec  = fPID->GetParticleSpecie(fHistMan,track, fTrackCuts,rec);
-		Int_t idGen     =kSpUndefined;
-		Bool_t isPrimary           = kFALSE;
-		Bool_t isSecondaryMaterial = kFALSE; 
-		Bool_t isSecondaryWeak     = kFALSE; 
+    		// get identity, the PID QA histos of the nominal cuts are only filled by tracks of the nominal type
+		Int_t firstsel=0;
+		while(!(selmask&(1<<firstsel)))
+			firstsel++;
+    		rec.fIdRec  = fPID->GetParticleSpecie(GetHistoManager(firstsel),track, fTrackCuts,rec.fRec);
+		rec.fIdGen     =kSpUndefined;
+		rec.fIsPrimary           = kFALSE;
+		rec.fIsSecondaryMaterial = kFALSE; 
+		rec.fIsSecondaryWeak     = kFALSE; 
+		rec.fPdgCode=0;
+		rec.fMotherPdg=-1;
+		rec.fChargeMC=-2;
+		rec.fHasMC=kFALSE;
 
-		for(int irec=kSpPion;irec<kNSpecies;irec++)
-    		{
-   
-			if(fUseMinSigma)
-			{
-				if(irec>kSpPion)
-					break;
-			}
-			else
-			{	
-				if(!rec[irec]) 
-					idRec = kSpUndefined;
-				else	
-					idRec=irec;
-			}		
-   
-			Int_t charge = track->Charge() > 0 ? kChPos : kChNeg;	
-			// Fill histograms, only if inside y and nsigma acceptance
-			if(idRec != kSpUndefined && fTrackCuts->CheckYCut ((BothParticleSpecies_t)idRec))
+		/* MC Part */
+		if (arrayMC||stack) 
+		{
+			if (ifAODEvent==AliSpectraBothTrackCuts::kAODobject)
 			{
-				fHistMan->GetHistogram2D(kHistPtRecSigma,idRec,charge)->Fill(track->Pt(),dca);
-				if(fTrackCuts->GetMakeQAhisto())
+				AliAODMCParticle *partMC = (AliAODMCParticle*) arrayMC->At(TMath::Abs(track->GetLabel()));
+			  	if (!partMC) 
 				{ 
-					fTrackCuts->GetHistoDCAzQA()->Fill(idRec,track->Pt(),dcaz);
-					fTrackCuts->GetHistoNclustersQA()->Fill(idRec,track->Pt(),ncls);
-					fTrackCuts->GetHistochi2perNDFQA()->Fill(idRec,track->Pt(),chi2perndf);
-				}
-				sel[idRec]=true;
-			}
-			//can't put a continue because we still have to fill allcharged primaries, done later
-		
-			/* MC Part */
-			if (arrayMC||stack) 
-			{
-				//Bool_t isPrimary           = kFALSE;
-			 //	Bool_t isSecondaryMaterial = kFALSE; 
-			 //	Bool_t isSecondaryWeak     = kFALSE; 
-			 //	Int_t idGen     =kSpUndefined;
-			 	Int_t pdgcode=0;
-				Int_t motherpdg=-1;
-				Int_t chargeMC=-2;
-				if (ifAODEvent==AliSpectraBothTrackCuts::kAODobject)
+					AliError("Cannot get MC particle");
+			  	}
+				else
 				{
-					AliAODMCParticle *partMC = (AliAODMCParticle*) arrayMC->At(TMath::Abs(track->GetLabel()));
-				  	if (!partMC) 
-					{ 
-						AliError("Cannot get MC particle");
-						continue; 
-				  	}
+					rec.fHasMC=kTRUE;
 				  	// Check if it is primary, secondary from material or secondary from weak decay
-				  	isPrimary           = partMC->IsPhysicalPrimary();
-					isSecondaryWeak     = partMC->IsSecondaryFromWeakDecay();
-					isSecondaryMaterial      = partMC->IsSecondaryFromMaterial();
+				  	rec.fIsPrimary           = partMC->IsPhysicalPrimary();
+					rec.fIsSecondaryWeak     = partMC->IsSecondaryFromWeakDecay();
+					rec.fIsSecondaryMaterial      = partMC->IsSecondaryFromMaterial();
 					//cout<<"AOD tagging "<<isPrimary<<" "<<isSecondaryWeak<<isSecondaryMaterial<<" "<<partMC->GetMCProcessCode()<<endl;
 
-				  	if(!isPrimary&&!isSecondaryWeak&&!isSecondaryMaterial)//old tagging for old AODs 
+				  	if(!rec.fIsPrimary&&!rec.fIsSecondaryWeak&&!rec.fIsSecondaryMaterial)//old tagging for old AODs 
 				  	{
 						AliError("old tagging");
 						Int_t mfl=-999,codemoth=-999;
@@ -371,179 +398,230 @@ void AliAnalysisTaskSpectraBoth::UserExec(Option_t *)
 					  		codemoth = TMath::Abs(moth->GetPdgCode());
 					  		mfl = Int_t (codemoth/ TMath::Power(10, Int_t(TMath::Log10(codemoth))));
 						}
-						//Int_t uniqueID = partMC->GetUniqueID();
-						//cout<<"uniqueID: "<<partMC->GetUniqueID()<<"       "<<kPDecay<<endl;
-						//cout<<"status: "<<partMC->GetStatus()<<"       "<<kPDecay<<endl;
-						// if(uniqueID == kPDecay)Printf("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
 						if(mfl==3) 
-							isSecondaryWeak     = kTRUE; // add if(partMC->GetStatus() & kPDecay)? FIXME
+							rec.fIsSecondaryWeak     = kTRUE; // add if(partMC->GetStatus() & kPDecay)? FIXME
 						else       
-							isSecondaryMaterial = kTRUE;
+							rec.fIsSecondaryMaterial = kTRUE;
 				  	}
-					//cout<<"AOD 2 tagging "<<isPrimary<<" "<<isSecondaryWeak<<isSecondaryMaterial<<" "<<partMC->GetMCProcessCode()<<endl;
-					if(isSecondaryWeak)
+					if(rec.fIsSecondaryWeak)
 					{	
 						Int_t indexMoth=partMC->GetMother(); // FIXME ignore fakes? TO BE CHECKED, on ESD is GetFirstMother()
 						if(indexMoth>=0)
 						{
 					  		AliAODMCParticle* moth = (AliAODMCParticle*) arrayMC->At(indexMoth);
 							if(moth)
-					  			motherpdg=TMath::Abs(moth->GetPdgCode());
+					  			rec.fMotherPdg=TMath::Abs(moth->GetPdgCode());
 						}
 					}
 
-				  	idGen     = fPID->GetParticleSpecie(partMC);
-				  	pdgcode=partMC->GetPdgCode(); 
-					chargeMC=partMC->Charge() > 0 ? kChPos : kChNeg ;
+				  	rec.fIdGen     = fPID->GetParticleSpecie(partMC);
+				  	rec.fPdgCode=partMC->GetPdgCode(); 
+					rec.fChargeMC=partMC->Charge() > 0 ? kChPos : kChNeg ;
 				}
-				else if (ifAODEvent==AliSpectraBothTrackCuts::kESDobject)
+			}
+			else if (ifAODEvent==AliSpectraBothTrackCuts::kESDobject)
+			{
+				TParticle *partMC =stack->Particle(TMath::Abs(track->GetLabel()));
+				if (!partMC) 
+				{ 
+					AliError("Cannot get MC particle");
+			  	}
+				else
 				{
-					TParticle *partMC =stack->Particle(TMath::Abs(track->GetLabel()));
-					if (!partMC) 
-					{ 
-						AliError("Cannot get MC particle");
-						continue; 
-				  	}
-				  	isPrimary           = stack->IsPhysicalPrimary(TMath::Abs(track->GetLabel()));
-					isSecondaryWeak     = stack->IsSecondaryFromWeakDecay(TMath::Abs(track->GetLabel()));
-					isSecondaryMaterial      = stack->IsSecondaryFromMaterial(TMath::Abs(track->GetLabel()));
-					//cout<<"ESD tagging "<<isPrimary<<" "<<isSecondaryWeak<<isSecondaryMaterial<<endl;
+					rec.fHasMC=kTRUE;
+				  	rec.fIsPrimary           = stack->IsPhysicalPrimary(TMath::Abs(track->GetLabel()));
+					rec.fIsSecondaryWeak     = stack->IsSecondaryFromWeakDecay(TMath::Abs(track->GetLabel()));
+					rec.fIsSecondaryMaterial      = stack->IsSecondaryFromMaterial(TMath::Abs(track->GetLabel()));
 					
-					if(isSecondaryWeak)	
+					if(rec.fIsSecondaryWeak)	
 					{
-
 						TParticle* moth=stack->Particle(TMath::Abs(partMC->GetFirstMother()));
 						if(moth)
-							 motherpdg = TMath::Abs(moth->GetPdgCode());
-
+							 rec.fMotherPdg = TMath::Abs(moth->GetPdgCode());
 					}
-					
 
-				   	idGen     = fPID->GetParticleSpecie(partMC);
-				   	pdgcode=partMC->GetPdgCode(); 
-					chargeMC = partMC->GetPDG(0)->Charge()/3.0 > 0 ? kChPos : kChNeg ;
+				   	rec.fIdGen     = fPID->GetParticleSpecie(partMC);
+				   	rec.fPdgCode=partMC->GetPdgCode(); 
+					rec.fChargeMC = partMC->GetPDG(0)->Charge()/3.0 > 0 ? kChPos : kChNeg ;
+				}
+			}
+			else
+				return;
+		}//end if(arrayMC)
 
+		for(Int_t ihman=0;ihman<nhman;ihman++)
+			if(selmask&(1<<ihman))
+				FillTrackHistos(GetHistoManager(ihman),rec,ihman==0);
+	
+  	} // end loop on tracks
 
-				}
-				else
-					return;
-			
-			//	  cout<<isPrimary<<" "<<isSecondaryWeak<<" "<<isSecondaryMaterial<<endl;
-			//	  cout<<" functions "<<partMC->IsPhysicalPrimary()<<" "<<partMC->IsSecondaryFromWeakDecay()<<" "<<partMC->IsSecondaryFromMaterial()<<endl;
+ // cout<< ntracks<<endl;
+  for(Int_t ihman=0;ihman<nhman;ihman++)
+  	GetHistoManager(ihman)->GetGenMulvsRawMulHistogram("hHistGenMulvsRawMul")->Fill(npar,ntracks[ihman]);
+    fPID->SetoldT0();
+  PostData(1, fHistMan  );
+  PostData(2, fEventCuts);
+  PostData(3, fTrackCuts);
+  PostData(4, fPID      );
+  PostData(5, fVariantHistMan);
+}
+//________________________________________________________________________
+void AliAnalysisTaskSpectraBoth::FillTrackHistos(AliSpectraBothHistoManager* hman, const TrackRecord_t& rec, Bool_t nominal)
+{
+	// fill the reconstructed spectra of one track selection from the per-track record
+	AliVTrack* track=rec.fTrack;
+	Float_t dca=rec.fDCA;
+	Int_t charge=rec.fCharge;
+     	hman->GetPtHistogram(kHistPtRec)->Fill(track->Pt(),dca);  // PT histo
+	Int_t idRec=rec.fIdRec;
+	Bool_t sel[3]={false,false,false};
+
+	for(int irec=kSpPion;irec<kNSpecies;irec++)
+    	{
+   
+		if(fUseMinSigma)
+		{
+			if(irec>kSpPion)
+				break;
+		}
+		else
+		{	
+			if(!rec.fRec[irec]) 
+				idRec = kSpUndefined;
+			else	
+				idRec=irec;
+		}		
+   
+		// Fill histograms, only if inside y and nsigma acceptance
+		if(idRec != kSpUndefined && fTrackCuts->CheckYCut ((BothParticleSpecies_t)idRec))
+		{
+			hman->GetHistogram2D(kHistPtRecSigma,idRec,charge)->Fill(track->Pt(),dca);
+			if(nominal&&fTrackCuts->GetMakeQAhisto())
+			{ 
+				fTrackCuts->GetHistoDCAzQA()->Fill(idRec,track->Pt(),rec.fDCAz);
+				fTrackCuts->GetHistoNclustersQA()->Fill(idRec,track->Pt(),rec.fNcls);
+				fTrackCuts->GetHistochi2perNDFQA()->Fill(idRec,track->Pt(),rec.fChi2perNDF);
+			}
+			sel[idRec]=true;
+		}
+		//can't put a continue because we still have to fill allcharged primaries, done later
+		
+		/* MC Part */
+		if (!rec.fHasMC) 
+			continue;
+		Int_t idGen=rec.fIdGen;
+		Bool_t isPrimary=rec.fIsPrimary;
+		Bool_t isSecondaryWeak=rec.fIsSecondaryWeak;
+		Int_t pdgcode=rec.fPdgCode;
 		  
-		  		if (isPrimary&&irec==kSpPion)
-				{
-					fHistMan->GetPtHistogram(kHistPtRecPrimaryAll)->Fill(track->Pt(),dca);  // PT histo of reconstrutsed primaries in defined eta
-					if(chargeMC!=charge)
-						fHistMan->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),4);
+  		if (isPrimary&&irec==kSpPion)
+		{
+			hman->GetPtHistogram(kHistPtRecPrimaryAll)->Fill(track->Pt(),dca);  // PT histo of reconstrutsed primaries in defined eta
+			if(rec.fChargeMC!=charge)
+				hman->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),4);
 
-				}	
+		}	
 
-				if(track->Pt()>fTrackCuts->GetPtTOFMatching(irec)&&(!fTrackCuts->CheckTOFMatchingParticleType(irec)))
-					continue;
+		if(track->Pt()>fTrackCuts->GetPtTOFMatching(irec)&&(!fTrackCuts->CheckTOFMatchingParticleType(irec)))
+			continue;
 
-				//in case of pt depended TOF cut we have to remove particles with pt above their TOF cut but below max TOF cut
+		//in case of pt depended TOF cut we have to remove particles with pt above their TOF cut but below max TOF cut
 
 	
-				if(fUseMinSigma)
-				{
-					if(idRec == kSpUndefined)
-						continue;
-					if(!fTrackCuts->CheckYCut ((BothParticleSpecies_t)idRec)) 
-						continue;
-				}			  
-				else
-				{
-					if(!fTrackCuts->CheckYCut ((BothParticleSpecies_t)irec)) 
-						continue;
+		if(fUseMinSigma)
+		{
+			if(idRec == kSpUndefined)
+				continue;
+			if(!fTrackCuts->CheckYCut ((BothParticleSpecies_t)idRec)) 
+				continue;
+		}			  
+		else
+		{
+			if(!fTrackCuts->CheckYCut ((BothParticleSpecies_t)irec)) 
+				continue;
 
-				}
-				
-		  	// rapidity cut (reconstructed pt and identity)
-		 		// if(!fTrackCuts->CheckYCut ((BothParticleSpecies_t)idRec)) continue;
-		  
-		  // Get true ID
-		  		 	
-		  
-		 		 if ((idRec == idGen)&&(idGen != kSpUndefined)) 
-					fHistMan->GetHistogram2D(kHistPtRecTrue,  idGen, charge)->Fill(track->Pt(),dca); 
+		}
+		
+		 if ((idRec == idGen)&&(idGen != kSpUndefined)) 
+			hman->GetHistogram2D(kHistPtRecTrue,  idGen, charge)->Fill(track->Pt(),dca); 
 		  
-		  		if (isPrimary) 
-				{
-					if(idRec!= kSpUndefined) // any primary 
-						fHistMan->GetHistogram2D(kHistPtRecSigmaPrimary, idRec, charge)->Fill(track->Pt(),dca); 
-					//if(idGen != kSpUndefined) 
-					//{
-					 if((idGen != kSpUndefined) &&(irec == idGen)) // genereated primary but does not have to be selected useless for min sigma 
-		  				fHistMan->GetHistogram2D(kHistPtRecPrimary,      idGen, charge)->Fill(track->Pt(),dca);
-		  			if ((idGen != kSpUndefined) &&(idRec == idGen))  // genereated and selected correctly 
-						fHistMan->GetHistogram2D(kHistPtRecTruePrimary,  idGen, charge)->Fill(track->Pt(),dca); 
-					//}
-		  		}
-		 		 //25th Apr - Muons are added to Pions -- FIXME
-		 		if ( pdgcode == 13 && idRec == kSpPion) 
-				{ 
-					fHistMan->GetPtHistogram(kHistPtRecTrueMuonPlus)->Fill(track->Pt(),dca); 
-					if(isPrimary)
-		  				fHistMan->GetPtHistogram(kHistPtRecTruePrimaryMuonPlus)->Fill(track->Pt(),dca); 
-		  		}
-		  		if ( pdgcode == -13 && idRec == kSpPion) 
-				{ 
-					fHistMan->GetPtHistogram(kHistPtRecTrueMuonMinus)->Fill(track->Pt(),dca); 
-					if (isPrimary) 
-					{
-		  				fHistMan->GetPtHistogram(kHistPtRecTruePrimaryMuonMinus)->Fill(track->Pt(),dca); 
-					}
-		  		}
-		  		
-				if(idRec == kSpUndefined)
-					continue;
+  		if (isPrimary) 
+		{
+			if(idRec!= kSpUndefined) // any primary 
+				hman->GetHistogram2D(kHistPtRecSigmaPrimary, idRec, charge)->Fill(track->Pt(),dca); 
+			 if((idGen != kSpUndefined) &&(irec == idGen)) // genereated primary but does not have to be selected useless for min sigma 
+  				hman->GetHistogram2D(kHistPtRecPrimary,      idGen, charge)->Fill(track->Pt(),dca);
+  			if ((idGen != kSpUndefined) &&(idRec == idGen))  // genereated and selected correctly 
+				hman->GetHistogram2D(kHistPtRecTruePrimary,  idGen, charge)->Fill(track->Pt(),dca); 
+  		}
+ 		 //25th Apr - Muons are added to Pions -- FIXME
+ 		if ( pdgcode == 13 && idRec == kSpPion) 
+		{ 
+			hman->GetPtHistogram(kHistPtRecTrueMuonPlus)->Fill(track->Pt(),dca); 
+			if(isPrimary)
+  				hman->GetPtHistogram(kHistPtRecTruePrimaryMuonPlus)->Fill(track->Pt(),dca); 
+  		}
+  		if ( pdgcode == -13 && idRec == kSpPion) 
+		{ 
+			hman->GetPtHistogram(kHistPtRecTrueMuonMinus)->Fill(track->Pt(),dca); 
+			if (isPrimary) 
+			{
+  				hman->GetPtHistogram(kHistPtRecTruePrimaryMuonMinus)->Fill(track->Pt(),dca); 
+			}
+  		}
+  		
+		if(idRec == kSpUndefined)
+			continue;
 
-				
-		 		 //here we can use idGen in case of fit approach
-		  
-		  		// Fill secondaries
+		
+ 		 //here we can use idGen in case of fit approach
+  
+  		// Fill secondaries
 
+		
+		if(fMotherWDPDGcode>0) // if the Mother pdg is set we undo the Secondary flag in case it dose not match
+		{
+			if(rec.fMotherPdg!=fMotherWDPDGcode)
+				isSecondaryWeak=kFALSE;
 				
-				if(fMotherWDPDGcode>0) // if the Mother pdg is set we undo the Secondary flag in case it dose not match
-				{
-					if(motherpdg!=fMotherWDPDGcode)
-						isSecondaryWeak=kFALSE;
-						
-				}
-				if(fHistMan->GetIncludecorrectlyidentifiedinMCtemplates())// we have to check if genereted is the same as reconstructed  
-				{
-					if(idRec!=idGen)
-						continue;
-				}
-		  		if(isSecondaryWeak)
-					fHistMan->GetHistogram2D(kHistPtRecSigmaSecondaryWeakDecay, idRec, charge)->Fill(track->Pt(),dca);
-		  		if(isSecondaryMaterial)  
-					fHistMan->GetHistogram2D(kHistPtRecSigmaSecondaryMaterial , idRec, charge)->Fill(track->Pt(),dca);
-		  
-			}//end if(arrayMC)
 		}
-		if(sel[0]&&sel[1]&&sel[2])//pi+k+p
-			fHistMan->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),0);
-		else if(sel[0]&&sel[1]) //pi+k
-			fHistMan->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),1);
-		else if(sel[0]&&sel[2]) //pi+k
-			fHistMan->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),2);
-		else if(sel[1]&&sel[2]) //p+k
-			fHistMan->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),3);
-		if(fmakePIDQAhisto)
-    			fPID->FillQAHistos(fHistMan, track, fTrackCuts,idGen);
-	
-	
-  	} // end loop on tracks
+		if(hman->GetIncludecorrectlyidentifiedinMCtemplates())// we have to check if genereted is the same as reconstructed  
+		{
+			if(idRec!=idGen)
+				continue;
+		}
+  		if(isSecondaryWeak)
+			hman->GetHistogram2D(kHistPtRecSigmaSecondaryWeakDecay, idRec, charge)->Fill(track->Pt(),dca);
+  		if(rec.fIsSecondaryMaterial)  
+			hman->GetHistogram2D(kHistPtRecSigmaSecondaryMaterial , idRec, charge)->Fill(track->Pt(),dca);
+	}
+	if(sel[0]&&sel[1]&&sel[2])//pi+k+p
+		hman->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),0);
+	else if(sel[0]&&sel[1]) //pi+k
+		hman->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),1);
+	else if(sel[0]&&sel[2]) //pi+k
+		hman->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),2);
+	else if(sel[1]&&sel[2]) //p+k
+		hman->GetPtHistogram("hHistDoubleCounts")->Fill(track->Pt(),3);
+	if(nominal&&fmakePIDQAhisto)
+    		fPID->FillQAHistos(hman, track, fTrackCuts,rec.fIdGen);
+}
 
- // cout<< ntracks<<endl;
-  fHistMan->GetGenMulvsRawMulHistogram("hHistGenMulvsRawMul")->Fill(npar,ntracks);
-    fPID->SetoldT0();
-  PostData(1, fHistMan  );
-  PostData(2, fEventCuts);
-  PostData(3, fTrackCuts);
-  PostData(4, fPID      );
+//_________________________________________________________________
+void AliAnalysisTaskSpectraBoth::FinishTaskOutput()
+{
+  // the event selection is common: copy the event statistics of the nominal histo manager to the variants
+  TH1F* hstat=fHistMan ? fHistMan->GetEventStatHist() : 0x0;
+  if(!hstat||!fVariantHistMan)
+	return;
+  for(Int_t i=1;i<=GetNTrackCutVariants();i++)
+  {
+	TH1F* hvar=GetHistoManager(i)->GetEventStatHist();
+	if(!hvar)
+		continue;
+	hvar->Reset();
+	hvar->Add(hstat);
+  }
 }
 
 //_________________________________________________________________
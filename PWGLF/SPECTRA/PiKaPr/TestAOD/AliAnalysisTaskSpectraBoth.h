@@ -21,17 +21,21 @@ class AliSpectraBothEventCuts;
 class AliSpectraBothPID;
 class AliESDtrackCuts;
 class AliGenEventHeader;
+class AliVTrack;
+class TList;
+class TObjArray;
 
 #include "AliSpectraBothHistoManager.h"
 #include "AliAnalysisTaskSE.h"
 #include "AliESDtrackCuts.h"
+#include "TArrayI.h"
 
 class AliAnalysisTaskSpectraBoth : public AliAnalysisTaskSE
 {
 public:
 
    // constructors
-  AliAnalysisTaskSpectraBoth() : AliAnalysisTaskSE(), fAOD(0), fHistMan(0), fTrackCuts(0), fEventCuts(0), fPID(0), fIsMC(0), fNRebin(0),fUseMinSigma(0),fCuts(0),fdotheMCLoopAfterEventCuts(0),fmakePIDQAhisto(1),fMotherWDPDGcode(-1),fUseEtaCut(kFALSE),fIncludecorrectlyidentifiedinMCtemplates(kFALSE)
+  AliAnalysisTaskSpectraBoth() : AliAnalysisTaskSE(), fAOD(0), fHistMan(0), fTrackCuts(0), fEventCuts(0), fPID(0), fIsMC(0), fNRebin(0),fUseMinSigma(0),fCuts(0),fdotheMCLoopAfterEventCuts(0),fmakePIDQAhisto(1),fMotherWDPDGcode(-1),fUseEtaCut(kFALSE),fIncludecorrectlyidentifiedinMCtemplates(kFALSE),fCutVariants(0),fCutVariantBits(),fVariantHistMan(0)
  {}
   AliAnalysisTaskSpectraBoth(const char *name);
    virtual ~AliAnalysisTaskSpectraBoth() {}
@@ -41,9 +45,11 @@ public:
 
    virtual void   UserCreateOutputObjects();
    virtual void   UserExec(Option_t *option);
+   virtual void   FinishTaskOutput();
    virtual void   Terminate(Option_t *);
 
    AliSpectraBothHistoManager * GetHistoManager()         {  return fHistMan; }
+   AliSpectraBothHistoManager * GetHistoManager(Int_t i)  {  return i ? (AliSpectraBothHistoManager*)fVariantHistMan->At(i-1) : fHistMan; }
    AliSpectraBothTrackCuts * GetTrackCuts()         {  return fTrackCuts; }
    AliSpectraBothEventCuts * GetEventCuts()         {  return fEventCuts; }
    AliSpectraBothPID * GetPID()         {  return fPID; }
@@ -61,6 +67,9 @@ public:
    void SetMotherWDPDGCode(Int_t value){fMotherWDPDGcode=value;}	
    void SetIncludecorrectlyidentifiedinMCtemplates(Bool_t flag=kFALSE){fIncludecorrectlyidentifiedinMCtemplates=flag;}
   Bool_t GetIncludecorrectlyidentifiedinMCtemplates() {return fIncludecorrectlyidentifiedinMCtemplates;}
+   // track type variants (ESD cuts / AOD filter bits) filled in the same pass, each into its own histo manager
+   void AddTrackCutVariant(AliESDtrackCuts* cuts, UInt_t trkbit=0);
+   Int_t GetNTrackCutVariants() const {return fCutVariants ? fCutVariants->GetEntriesFast() : 0;}
 		
 private:
 
@@ -78,11 +87,26 @@ private:
    Int_t fMotherWDPDGcode; //the abs of pdg code of the mother for WD decays , used during systematic studies  	
    Bool_t fUseEtaCut; // cut on eta in MC 	
    Bool_t      fIncludecorrectlyidentifiedinMCtemplates; // if set to true secondary templates are only filed after checking MC PID
+   TObjArray  *fCutVariants; // ESD track cuts of the track type variants
+   TArrayI     fCutVariantBits; // AOD filter bits of the track type variants
+   TList      *fVariantHistMan; // histo managers of the track type variants
+
+   // quantities of a selected track shared by the nominal cuts and all variants
+   struct TrackRecord_t {
+     AliVTrack *fTrack;
+     Float_t fDCA, fDCAz, fChi2perNDF;
+     Short_t fNcls;
+     Int_t   fCharge, fIdRec;
+     Bool_t  fRec[kNSpecies];
+     Bool_t  fHasMC, fIsPrimary, fIsSecondaryMaterial, fIsSecondaryWeak;
+     Int_t   fIdGen, fPdgCode, fMotherPdg, fChargeMC;
+   };
+   void FillTrackHistos(AliSpectraBothHistoManager* hman, const TrackRecord_t& rec, Bool_t nominal);
 	
    AliAnalysisTaskSpectraBoth(const AliAnalysisTaskSpectraBoth&);
    AliAnalysisTaskSpectraBoth& operator=(const AliAnalysisTaskSpectraBoth&);
 
-   ClassDef(AliAnalysisTaskSpectraBoth, 5);
+   ClassDef(AliAnalysisTaskSpectraBoth, 6);
 };
 
 #endif
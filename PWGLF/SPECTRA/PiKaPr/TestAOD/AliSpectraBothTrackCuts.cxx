@@ -37,6 +37,8 @@
 #include "AliAnalysisTaskESDfilter.h"
 #include "AliAnalysisDataContainer.h"
 #include "AliSpectraBothTrackCuts.h"
+#include "TObjArray.h"
+#include "TArrayI.h"
 //#include "AliSpectraBothHistoManager.h"
 #include <iostream>
 
@@ -64,7 +66,7 @@ AliSpectraBothTrackCuts::AliSpectraBothTrackCuts(const char *name) : TNamed(name
 fPtCutTOFMatchingPion(-1.0),fPtCutTOFMatchingKaon(-1.0),fPtCutTOFMatchingProton(-1.0),fUseTypeDependedTOFCut(kFALSE),fMakeQAhisto(kFALSE),
 fHistoCuts(0), fHistoNSelectedPos(0), fHistoNSelectedNeg(0), fHistoNMatchedPos(0), fHistoNMatchedNeg(0), fHistoEtaPhiHighPt(0), fHistoNclustersITS(0),
 fHistoDCAzQA(0),fHistoNclustersQA(0),fHistochi2perNDFQA(0),
-fTrack(0),fCuts(0)
+fTrack(0),fCuts(0),fVariantCuts(0),fVariantTrackBits(0)
   
 {
 /*
@@ -193,6 +195,46 @@ Bool_t AliSpectraBothTrackCuts::IsSelected(AliVTrack * track,Bool_t FillHistStat
       printf("ERROR: Could not receive track");
       return kFALSE;
     }
+  SetTrack(track);
+  if(!CheckTrackType()){
+    return kFALSE;
+  }
+  if(FillHistStat)fHistoCuts->Fill(kTrkBit);
+  return CheckCommonCuts(FillHistStat,kTRUE);
+}
+//_______________________________________________________
+UInt_t AliSpectraBothTrackCuts::GetSelectionMask(AliVTrack * track,Bool_t FillHistStat)
+{
+// Selection of the nominal track type (bit 0) and of the track type variants (bit i+1)
+// The track type is the only cut that differs between them, all other cuts are checked once
+// Statistics and QA histos are only filled for tracks of the nominal type, as in IsSelected
+  if (!track)
+    {
+      printf("ERROR: Could not receive track");
+      return 0;
+    }
+  SetTrack(track);
+  UInt_t mask=0;
+  if(CheckTrackType())
+	mask|=1;
+  Int_t nvariants=fVariantCuts ? fVariantCuts->GetEntriesFast() : 0;
+  for(Int_t i=0;i<nvariants;i++)
+  {
+	UInt_t bits=fVariantTrackBits ? UInt_t(fVariantTrackBits->At(i)) : fTrackBits;
+	if(CheckTrackType((AliESDtrackCuts*)fVariantCuts->At(i),bits))
+		mask|=(1<<(i+1));
+  }
+  if(!mask)
+	return 0;
+  Bool_t nominal=mask&1;
+  if(FillHistStat&&nominal)fHistoCuts->Fill(kTrkBit);
+  if(!CheckCommonCuts(FillHistStat&&nominal,nominal))
+	return 0;
+  return mask;
+}
+//_______________________________________________________
+void AliSpectraBothTrackCuts::SetTrack(AliVTrack * track)
+{
     fTrack = track;
    TString nameoftrack(track->ClassName());  
     if(!nameoftrack.CompareTo("AliESDtrack"))
@@ -201,11 +243,12 @@ Bool_t AliSpectraBothTrackCuts::IsSelected(AliVTrack * track,Bool_t FillHistStat
 		fAODtrack=kAODobject;
 	else
 		fAODtrack=kotherobject;
-  if(!CheckTrackType()){
-    return kFALSE;
-  }
-  if(FillHistStat)fHistoCuts->Fill(kTrkBit);
-  if(!CheckTrackCuts()){
+}
+//_______________________________________________________
+Bool_t AliSpectraBothTrackCuts::CheckCommonCuts(Bool_t FillHistStat,Bool_t FillHisto)
+{
+// All cuts but the track type, in the order of IsSelected
+  if(!CheckTrackCuts(FillHisto)){
     return kFALSE;
   }
   if(FillHistStat)fHistoCuts->Fill(kTrkCuts);
@@ -225,7 +268,7 @@ Bool_t AliSpectraBothTrackCuts::IsSelected(AliVTrack * track,Bool_t FillHistStat
     return kFALSE;
   }
   if(FillHistStat)fHistoCuts->Fill(kTrkPt);
-  if(!CheckTOFMatching(FillHistStat)){
+  if(!CheckTOFMatching(FillHistStat,FillHisto)){
     return kFALSE;
   }
   if(FillHistStat)fHistoCuts->Fill(kAccepted);
@@ -238,12 +281,19 @@ Bool_t AliSpectraBothTrackCuts::IsSelected(AliVTrack * track,Bool_t FillHistStat
 Bool_t AliSpectraBothTrackCuts::CheckTrackType()
 {
   // Check track Type
+  return CheckTrackType(fCuts,fTrackBits);
+}
+//_________________________________________________________
+
+Bool_t AliSpectraBothTrackCuts::CheckTrackType(AliESDtrackCuts* cuts,UInt_t trackBits)
+{
+  // Check track Type with the given ESD cuts or AOD filter bits
   if(fAODtrack==kESDobject)
   {
 	AliESDtrack* esdtrack=dynamic_cast<AliESDtrack*>(fTrack);
-	if(!esdtrack)
+	if(!esdtrack||!cuts)
 		return kFALSE;	
-	if(fCuts->AcceptTrack(esdtrack)) return kTRUE;
+	if(cuts->AcceptTrack(esdtrack)) return kTRUE;
 		return kFALSE;
  }
   else if(fAODtrack==kAODobject)
@@ -251,7 +301,7 @@ Bool_t AliSpectraBothTrackCuts::CheckTrackType()
 	AliAODTrack* aodtrack=dynamic_cast<AliAODTrack*>(fTrack);
 	if(!aodtrack)
 		return kFALSE;
-	if (aodtrack->TestFilterBit(fTrackBits)) return kTRUE;
+	if (aodtrack->TestFilterBit(trackBits)) return kTRUE;
 		return kFALSE;
   }
 
@@ -261,7 +311,7 @@ Bool_t AliSpectraBothTrackCuts::CheckTrackType()
 }
 //_________________________________________________________
 
-Bool_t AliSpectraBothTrackCuts::CheckTrackCuts()
+Bool_t AliSpectraBothTrackCuts::CheckTrackCuts(Bool_t FillHisto)
 {
   // Check additional track Cuts
   Bool_t PassTrackCuts=kTRUE;
@@ -279,7 +329,7 @@ Bool_t AliSpectraBothTrackCuts::CheckTrackCuts()
 	if (esdtrack->GetTPCNcls()<fMinTPCcls)PassTrackCuts=kFALSE;
 	if(!esdtrack->IsOn(AliESDtrack::kTPCrefit))PassTrackCuts=kFALSE;
 	if(!esdtrack->IsOn(AliESDtrack::kITSrefit))PassTrackCuts=kFALSE;
-	if(PassTrackCuts)
+	if(PassTrackCuts&&FillHisto)
 	{
 		for(int i=0;i<6;i++)
 			if(esdtrack->HasPointOnITSLayer(i))
@@ -296,7 +346,7 @@ Bool_t AliSpectraBothTrackCuts::CheckTrackCuts()
 	if (aodtrack->GetTPCNcls()<fMinTPCcls)PassTrackCuts=kFALSE;
 	if(!aodtrack->IsOn(AliAODTrack::kTPCrefit))PassTrackCuts=kFALSE;
 	if(!aodtrack->IsOn(AliAODTrack::kITSrefit))PassTrackCuts=kFALSE;
-	if(PassTrackCuts)
+	if(PassTrackCuts&&FillHisto)
 	{
 		for(int i=0;i<6;i++)
 			if(aodtrack->HasPointOnITSLayer(i))
@@ -395,7 +445,7 @@ Bool_t AliSpectraBothTrackCuts::CheckPtCut()
 }
 
 //_______________________________________________________
-Bool_t AliSpectraBothTrackCuts::CheckTOFMatching(Bool_t FillHistStat)
+Bool_t AliSpectraBothTrackCuts::CheckTOFMatching(Bool_t FillHistStat,Bool_t FillHisto)
 {
   // check Pt cut
   //    if ((fTrack->Pt() < fPtCut) && (fTrack->Pt() > 0.3 )) return kTRUE;
@@ -405,10 +455,13 @@ Bool_t AliSpectraBothTrackCuts::CheckTOFMatching(Bool_t FillHistStat)
  	{
 		if(FillHistStat)
 			fHistoCuts->Fill(kTrkPtTOF);
-    		if(fTrack->Charge()>0)
-			fHistoNSelectedPos->Fill(fTrack->Pt());
-    		else 
-			fHistoNSelectedNeg->Fill(fTrack->Pt());
+    		if(FillHisto)
+		{
+    			if(fTrack->Charge()>0)
+				fHistoNSelectedPos->Fill(fTrack->Pt());
+    			else 
+				fHistoNSelectedNeg->Fill(fTrack->Pt());
+		}
     		UInt_t status=fTrack->GetStatus();
     		if((status&AliAODTrack::kTOFout)&&FillHistStat)
 			fHistoCuts->Fill(kTrTOFout);
@@ -423,6 +476,8 @@ Bool_t AliSpectraBothTrackCuts::CheckTOFMatching(Bool_t FillHistStat)
     		} 
     		if(FillHistStat)
 			fHistoCuts->Fill(kTOFMatching);
+    		if(!FillHisto)
+			return kTRUE;
     		if(fTrack->Charge()>0)
 			fHistoNMatchedPos->Fill(fTrack->Pt());
    		 else 
@@ -19,6 +19,8 @@ class TH3F;
 class AliAODMCParticle;
 class AliAODTrack;
 class  AliESDtrackCuts;
+class TObjArray;
+class TArrayI;
 #include "AliSpectraBothHistoManager.h"
 #include "TNamed.h"
 #include "AliESDtrackCuts.h"
@@ -38,22 +40,24 @@ class AliSpectraBothTrackCuts : public TNamed
  fPtCutTOFMatchingPion(-1.0),fPtCutTOFMatchingKaon(-1.0),fPtCutTOFMatchingProton(-1.0),fUseTypeDependedTOFCut(kFALSE),fMakeQAhisto(kFALSE),
 fHistoCuts(0), fHistoNSelectedPos(0), fHistoNSelectedNeg(0), fHistoNMatchedPos(0), fHistoNMatchedNeg(0), fHistoEtaPhiHighPt(0), fHistoNclustersITS(0),
 fHistoDCAzQA(0),fHistoNclustersQA(0),fHistochi2perNDFQA(0),
-fTrack(0),fCuts(0) {}
+fTrack(0),fCuts(0),fVariantCuts(0),fVariantTrackBits(0) {}
   
   AliSpectraBothTrackCuts(const char *name);
   virtual  ~AliSpectraBothTrackCuts(); 
   
   Bool_t IsSelected(AliVTrack * track,Bool_t FillHistStat);
+  UInt_t GetSelectionMask(AliVTrack * track,Bool_t FillHistStat); // bit 0 nominal track type, bit i+1 track type variant i
   
   void SetTrackType(UInt_t bit);
   Bool_t CheckTrackType();
-  Bool_t CheckTrackCuts();
+  Bool_t CheckTrackType(AliESDtrackCuts* cuts,UInt_t trackBits);
+  Bool_t CheckTrackCuts(Bool_t FillHisto=kTRUE);
   Bool_t CheckEtaCut();
   Bool_t CheckYCut(BothParticleSpecies_t specie); // not included in standard cuts
   Bool_t CheckDCACut();
   Bool_t CheckPCut();
   Bool_t CheckPtCut();
-  Bool_t CheckTOFMatching(Bool_t FillHistStat);
+  Bool_t CheckTOFMatching(Bool_t FillHistStat,Bool_t FillHisto=kTRUE);
   Bool_t CheckTOFMatchingParticleType(Int_t type);
 	
   void PrintCuts() const;
@@ -103,6 +107,7 @@ fTrack(0),fCuts(0) {}
 
    Long64_t Merge(TCollection* list);
    void SetAliESDtrackCuts(AliESDtrackCuts*  cuts ){fCuts=cuts;}
+   void SetTrackTypeVariants(TObjArray* cuts,TArrayI* trackBits){fVariantCuts=cuts;fVariantTrackBits=trackBits;}
    void InitHisto();	 
  private:
    
@@ -139,12 +144,16 @@ fTrack(0),fCuts(0) {}
  		
    AliVTrack      *fTrack;           //! Track pointer
    AliESDtrackCuts *fCuts;      //! cuts  
+   TObjArray      *fVariantCuts;      //! ESD track cuts of the track type variants
+   TArrayI        *fVariantTrackBits; //! AOD filter bits of the track type variants
    static const char * kBinLabel[]; // labels of stat histo
 
    
    AliSpectraBothTrackCuts(const AliSpectraBothTrackCuts&);
    AliSpectraBothTrackCuts& operator=(const AliSpectraBothTrackCuts&);
    void ConfigurePtTOFCut(); 	
+   void SetTrack(AliVTrack * track);
+   Bool_t CheckCommonCuts(Bool_t FillHistStat,Bool_t FillHisto);
   
    ClassDef(AliSpectraBothTrackCuts, 8);
 };
@@ -28,6 +28,9 @@
   First version, June 4 2015
   02/07/2015, Antonio: adding MC true event shape calculation
   16/07/2015, Antonio: AODs are supported
+  All event shapes are computed from a single read of the tracks, kept
+  for the event; spherocity is minimised exactly with a sorted sweep of
+  the track directions instead of an angular scan
 
  ***************************************************************************/
 
@@ -52,6 +55,7 @@
 #include <TFile.h>
 #include "AliAODHeader.h"
 // STL includes
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -91,7 +95,23 @@ AliTransverseEventShape::AliTransverseEventShape():TObject(),
 	fhptSoMC(0),
 	fhetaStMC(0),
 	fhphiStMC(0),
-	fhptStMC(0)
+	fhptStMC(0),
+	fPtBuf(),
+	fEtaBuf(),
+	fPhiBuf(),
+	fAxisBuf(),
+	fAxisX(),
+	fAxisY(),
+	fSpherocity(-10.),
+	fSpherocityUnweighted(-10.),
+	fSphericity(-10.),
+	fLastEvent(0),
+	fLastNTracks(-1),
+	fLastRun(-1),
+	fLastPeriod(0),
+	fLastOrbit(0),
+	fLastBC(0),
+	fLastIsMC(kFALSE)
 
 {
 	// Default contructor
@@ -132,7 +152,23 @@ AliTransverseEventShape::AliTransverseEventShape(const AliTransverseEventShape &
 	fhptSoMC(0),
 	fhetaStMC(0),
 	fhphiStMC(0),
-	fhptStMC(0)
+	fhptStMC(0),
+	fPtBuf(),
+	fEtaBuf(),
+	fPhiBuf(),
+	fAxisBuf(),
+	fAxisX(),
+	fAxisY(),
+	fSpherocity(-10.),
+	fSpherocityUnweighted(-10.),
+	fSphericity(-10.),
+	fLastEvent(0),
+	fLastNTracks(-1),
+	fLastRun(-1),
+	fLastPeriod(0),
+	fLastOrbit(0),
+	fLastBC(0),
+	fLastIsMC(kFALSE)
 
 {
 	//
@@ -196,13 +232,107 @@ Float_t AliTransverseEventShape::GetEventShape( AliVEvent *event, TString lMetho
 	else if (event->InheritsFrom("AliAODEvent"))
 		fAODEvent = dynamic_cast<AliAODEvent *>(event);
 
-	if ( lMethod == "SO" ) lreturnval = GetSpherocity( fillHist );
-	if ( lMethod == "ST" ) lreturnval = GetSphericity( fillHist );
+	if ( lMethod != "SO" && lMethod != "ST" )
+		return lreturnval;
+
+	// the shapes are computed once per event, for all methods
+	if ( !IsSameEvent(event) )
+		AnalyseEvent(event);
+	if ( fNrec < fMinMultESA )
+		return -0.5;
+
+	if ( lMethod == "SO" ) {
+		if(fillHist) FillHistos(fhetaSo, fhphiSo, fhptSo);
+		lreturnval = fSpherocity;
+	}
+	if ( lMethod == "ST" ) {
+		if(fillHist) FillHistos(fhetaSt, fhphiSt, fhptSt);
+		lreturnval = fSphericity;
+	}
 
 	return lreturnval;
 
 }
 //______________________________________________________________________
+Bool_t AliTransverseEventShape::IsSameEvent( AliVEvent *event ) const
+{
+	// Were the shapes of this event already computed?
+
+	if ( fLastIsMC || event != fLastEvent )
+		return kFALSE;
+	return ( event->GetNumberOfTracks() == fLastNTracks &&
+			event->GetRunNumber() == fLastRun &&
+			event->GetPeriodNumber() == fLastPeriod &&
+			event->GetOrbitNumber() == fLastOrbit &&
+			event->GetBunchCrossNumber() == fLastBC );
+}
+//______________________________________________________________________
+Bool_t AliTransverseEventShape::AnalyseEvent( AliVEvent *event )
+{
+	// Read the accepted tracks of the event once and compute all the shapes
+
+	if (event->InheritsFrom("AliESDEvent"))
+		fESDEvent = dynamic_cast<AliESDEvent *>(event);
+	else if (event->InheritsFrom("AliAODEvent"))
+		fAODEvent = dynamic_cast<AliAODEvent *>(event);
+
+	fNrec = 0;
+	if(fESDEvent)
+		fNrec = ReadESDEvent(fPtBuf, fEtaBuf, fPhiBuf);
+	else if(fAODEvent)
+		fNrec = ReadAODEvent(fPtBuf, fEtaBuf, fPhiBuf);
+	ComputeShapes();
+
+	fLastIsMC    = kFALSE;
+	fLastEvent   = event;
+	fLastNTracks = event->GetNumberOfTracks();
+	fLastRun     = event->GetRunNumber();
+	fLastPeriod  = event->GetPeriodNumber();
+	fLastOrbit   = event->GetOrbitNumber();
+	fLastBC      = event->GetBunchCrossNumber();
+
+	return ( fNrec >= fMinMultESA );
+}
+//______________________________________________________________________
+Bool_t AliTransverseEventShape::AnalyseEventTrue( AliStack *event )
+{
+	// Same as AnalyseEvent for the physical primaries of the MC stack
+
+	fMCStack = event;
+	fNrec = ReadMC(fPtBuf, fEtaBuf, fPhiBuf);
+	ComputeShapes();
+
+	fLastIsMC  = kTRUE;
+	fLastEvent = 0;
+
+	return ( fNrec >= fMinMultESA );
+}
+//______________________________________________________________________
+void AliTransverseEventShape::ComputeShapes()
+{
+	// Shapes of the tracks in the buffers
+
+	fSpherocity = fSpherocityUnweighted = fSphericity = -0.5;
+	if( fNrec < fMinMultESA )
+		return;
+	fSphericity = AnalyseGetSphericity( kFALSE, fPtBuf, fEtaBuf, fPhiBuf );
+	fSpherocity = AnalyseGetSpherocity( kTRUE, fPtBuf, fPhiBuf );
+	fSpherocityUnweighted = AnalyseGetSpherocity( kFALSE, fPtBuf, fPhiBuf );
+}
+//______________________________________________________________________
+void AliTransverseEventShape::FillHistos( TH1D *heta, TH1D *hphi, TH1D *hpt ) const
+{
+	// QA histograms of the tracks in the buffers
+
+	if( !heta || !hphi || !hpt )
+		return;
+	for(Int_t i1 = 0; i1 < fNrec; ++i1){
+		heta->Fill(fEtaBuf[i1]);
+		hphi->Fill(fPhiBuf[i1]);
+		hpt->Fill(fPtBuf[i1]);
+	}
+}
+//______________________________________________________________________
 Float_t AliTransverseEventShape::GetEventShapeTrue( AliStack *event, TString lMethod, Bool_t fillHist )
 {
 
@@ -210,6 +340,8 @@ Float_t AliTransverseEventShape::GetEventShapeTrue( AliStack *event, TString lMe
 
 	fMCStack = event;
 
+	// no identity of the generated event: the stack is read at each call,
+	// once for all the shapes
 	if ( lMethod == "SO" ) lreturnval = GetSpherocityMC( fillHist );
 	if ( lMethod == "ST" ) lreturnval = GetSphericityMC( fillHist );
 
@@ -439,71 +571,85 @@ Float_t AliTransverseEventShape::AnalyseGetSphericity( Bool_t fillHist, const ve
 //_____________________________________________________________________
 Float_t AliTransverseEventShape::AnalyseGetSpherocity( Bool_t fillHist, const vector<Float_t> &pt, const vector<Float_t> &eta, const vector<Float_t> &phi ){
 
-
-	Float_t spherocity = -10.0;
-	Float_t pFull = 0;
-	Float_t Spherocity = 2;
-
-	//computing total pt
-	Float_t sumapt = 0;
-	for(Int_t i1 = 0; i1 < fNrec; ++i1){
-		sumapt += pt[i1];
-
-		//Fill QA histos
-		if(fillHist){
+	//Fill QA histos
+	if(fillHist){
+		for(Int_t i1 = 0; i1 < fNrec; ++i1){
 			fhetaSo->Fill(eta[i1]);
 			fhphiSo->Fill(phi[i1]);
 			fhptSo->Fill(pt[i1]);
 		}
-
 	}
 
-	//Getting thrust
-	for(Int_t i = 0; i < 360/(fSizeStepESA); ++i){
-		Float_t numerador = 0;
-		Float_t phiparam  = 0;
-		Float_t nx = 0;
-		Float_t ny = 0;
-		phiparam=( (TMath::Pi()) * i * fSizeStepESA ) / 180; // parametrization of the angle
-		nx = TMath::Cos(phiparam);            // x component of an unitary vector n
-		ny = TMath::Sin(phiparam);            // y component of an unitary vector n
-		for(Int_t i1 = 0; i1 < fNrec; ++i1){
+	return AnalyseGetSpherocity( kTRUE, pt, phi );
 
-			Float_t pxA = pt[i1] * TMath::Cos( phi[i1] );
-			Float_t pyA = pt[i1] * TMath::Sin( phi[i1] );
+}
+//_____________________________________________________________________
+Float_t AliTransverseEventShape::AnalyseGetSpherocity( Bool_t weighted, const vector<Float_t> &pt, const vector<Float_t> &phi ){
 
-			numerador += TMath::Abs( ny * pxA - nx * pyA );//product between p  proyection in XY plane and the unitary vector
-		}
-		pFull=TMath::Power( (numerador / sumapt),2 );
-		if(pFull < Spherocity)//maximization of pFull
-		{
-			Spherocity = pFull;
-		}
-	}
+	// S0 = pi^2/4 * min_n ( sum_i |p_i x n| / sum_i |p_i| )^2, with unit
+	// |p_i| if not weighted. The sum is concave between two track
+	// directions, so the minimum is along one of the tracks: with the
+	// directions folded into [0, pi) and sorted, the sum along track k is
+	// sin(phi_k) (X_below - X_above) - cos(phi_k) (Y_below - Y_above)
+	// evaluated for all k with running sums.
+
+	fAxisBuf.resize(fNrec);
+	fAxisX.resize(fNrec);
+	fAxisY.resize(fNrec);
 
-	spherocity=((Spherocity)*TMath::Pi()*TMath::Pi())/4.0;
+	Float_t sumapt = 0;
+	for(Int_t i1 = 0; i1 < fNrec; ++i1){
+		Float_t a = phi[i1];
+		while( a < 0 ) a += TMath::TwoPi();
+		while( a >= TMath::Pi() ) a -= TMath::Pi();
+		fAxisBuf[i1] = std::make_pair( a, i1 );
+		sumapt += weighted ? pt[i1] : 1.;
+	}
+	if( !(sumapt > 0) )
+		return -10.0;
+	std::sort( fAxisBuf.begin(), fAxisBuf.end() );
+
+	Float_t xabove = 0, yabove = 0;
+	for(Int_t k = 0; k < fNrec; ++k){
+		Float_t w = weighted ? pt[fAxisBuf[k].second] : 1.;
+		fAxisX[k] = w * TMath::Cos( fAxisBuf[k].first );
+		fAxisY[k] = w * TMath::Sin( fAxisBuf[k].first );
+		xabove += fAxisX[k];
+		yabove += fAxisY[k];
+	}
 
+	Float_t xbelow = 0, ybelow = 0;
+	Float_t numerador = sumapt;
+	for(Int_t k = 0; k < fNrec; ++k){
+		xabove -= fAxisX[k];
+		yabove -= fAxisY[k];
+		Float_t nx = TMath::Cos( fAxisBuf[k].first );
+		Float_t ny = TMath::Sin( fAxisBuf[k].first );
+		Float_t sum = ny * (xbelow - xabove) - nx * (ybelow - yabove);
+		if( sum < numerador )
+			numerador = sum;
+		xbelow += fAxisX[k];
+		ybelow += fAxisY[k];
+	}
+	if( numerador < 0 ) numerador = 0; // rounding
 
-	return spherocity;
+	Float_t pFull = TMath::Power( (numerador / sumapt), 2 );
+	return ( pFull * TMath::Pi() * TMath::Pi() ) / 4.0;
 
 }
 //_____________________________________________________________________
 Float_t AliTransverseEventShape::GetSpherocity( Bool_t fillHist )
 {
 
-	vector<Float_t> pt;
-	vector<Float_t> eta;
-	vector<Float_t> phi;
-
 	if(fESDEvent)
-		fNrec = ReadESDEvent(pt, eta, phi);
+		fNrec = ReadESDEvent(fPtBuf, fEtaBuf, fPhiBuf);
 	else if(fAODEvent)
-		fNrec = ReadAODEvent(pt, eta, phi);
+		fNrec = ReadAODEvent(fPtBuf, fEtaBuf, fPhiBuf);
 
 	if( fNrec < fMinMultESA )
 		return -0.5;
 
-	Float_t spherocity = AnalyseGetSpherocity( fillHist, pt, eta, phi ); 
+	Float_t spherocity = AnalyseGetSpherocity( fillHist, fPtBuf, fEtaBuf, fPhiBuf ); 
 
 	return spherocity;
 
@@ -513,19 +659,15 @@ Float_t AliTransverseEventShape::GetSphericity( Bool_t fillHist  )
 {
 
 
-	vector<Float_t> pt;
-	vector<Float_t> eta;
-	vector<Float_t> phi;
-
 	if(fESDEvent)
-		fNrec = ReadESDEvent(pt, eta, phi);
+		fNrec = ReadESDEvent(fPtBuf, fEtaBuf, fPhiBuf);
 	else if(fAODEvent)
-		fNrec = ReadAODEvent(pt, eta, phi);
+		fNrec = ReadAODEvent(fPtBuf, fEtaBuf, fPhiBuf);
 
 	if( fNrec < fMinMultESA )
 		return -0.5;
 
-	Float_t sphericity = AnalyseGetSphericity( fillHist, pt, eta, phi );
+	Float_t sphericity = AnalyseGetSphericity( fillHist, fPtBuf, fEtaBuf, fPhiBuf );
 
 	return sphericity;
 
@@ -535,15 +677,12 @@ Float_t AliTransverseEventShape::GetSphericity( Bool_t fillHist  )
 Float_t AliTransverseEventShape::GetSphericityMC( Bool_t fillHist )
 {
 
-	vector<Float_t> pt;
-	vector<Float_t> eta;
-	vector<Float_t> phi;
-
-	fNrec = ReadMC(pt, eta, phi);
+	fNrec = ReadMC(fPtBuf, fEtaBuf, fPhiBuf);
+	fLastIsMC = kTRUE;
 	if( fNrec < fMinMultESA )
 		return -0.5;
 
-	Float_t sphericity = AnalyseGetSphericity( fillHist, pt, eta, phi );
+	Float_t sphericity = AnalyseGetSphericity( fillHist, fPtBuf, fEtaBuf, fPhiBuf );
 
 	return sphericity;
 
@@ -551,15 +690,12 @@ Float_t AliTransverseEventShape::GetSphericityMC( Bool_t fillHist )
 //_____________________________________________________________________
 Float_t AliTransverseEventShape::GetSpherocityMC( Bool_t fillHist )
 {
-	vector<Float_t> pt;
-	vector<Float_t> eta;
-	vector<Float_t> phi;
-
-	fNrec = ReadMC(pt, eta, phi); 
+	fNrec = ReadMC(fPtBuf, fEtaBuf, fPhiBuf); 
+	fLastIsMC = kTRUE;
 	if( fNrec < fMinMultESA )
 		return -0.5;
 
-	Float_t spherocity = AnalyseGetSpherocity( fillHist, pt, eta, phi ); 
+	Float_t spherocity = AnalyseGetSpherocity( fillHist, fPtBuf, fEtaBuf, fPhiBuf ); 
 
 	return spherocity;
 }
@@ -13,6 +13,7 @@
 #include "TObject.h"
 
 #include <AliAnalysisFilter.h>
+#include <utility>
 #include <vector>
 
 class AliVEvent;
@@ -65,6 +66,15 @@ class AliTransverseEventShape : public TObject {
   Float_t GetSphericityMC(Bool_t fillHist);
   Float_t GetSpherocityMC(Bool_t fillHist);
 
+  // All event shapes from a single read of the tracks; the values of the
+  // last analysed event are then available with the getters below
+  Bool_t  AnalyseEvent(AliVEvent *event);
+  Bool_t  AnalyseEventTrue(AliStack *event);
+  Int_t   GetNAccepted()            const {return fNrec;}
+  Float_t GetSpherocityValue()      const {return fSpherocity;}
+  Float_t GetSpherocityUnweighted() const {return fSpherocityUnweighted;}
+  Float_t GetSphericityValue()      const {return fSphericity;}
+
   Int_t   ReadAODEvent(std::vector<Float_t> &pt, std::vector<Float_t> &eta, std::vector<Float_t> &phi);
   Int_t   ReadESDEvent(std::vector<Float_t> &pt, std::vector<Float_t> &eta, std::vector<Float_t> &phi);
   Int_t   ReadMC(std::vector<Float_t> &pt, std::vector<Float_t> &eta, std::vector<Float_t> &phi);
@@ -78,10 +88,17 @@ class AliTransverseEventShape : public TObject {
 		  const std::vector<Float_t> &phi);
 
 
+  Float_t AnalyseGetSpherocity(Bool_t weighted, const std::vector<Float_t> &pt,
+		  const std::vector<Float_t> &phi);
+
   //EvSel Snippets
   Float_t MinVal( Float_t A, Float_t B ); 
 
  private:
+  Bool_t  IsSameEvent(AliVEvent *event) const;
+  void    ComputeShapes();
+  void    FillHistos(TH1D *heta, TH1D *hphi, TH1D *hpt) const;
+
   Bool_t fAnalysisMC;          //  Real(kFALSE) or MC(kTRUE) flag
   AliESDEvent * fESDEvent;
   AliAODEvent * fAODEvent;
@@ -117,8 +134,26 @@ class AliTransverseEventShape : public TObject {
   TH1D    *fhphiStMC;
   TH1D    *fhptStMC;
 
-
-  ClassDef(AliTransverseEventShape,2) // base helper class
+  // buffers and results of the last analysed event
+  std::vector<Float_t> fPtBuf;                       //! accepted tracks
+  std::vector<Float_t> fEtaBuf;                      //!
+  std::vector<Float_t> fPhiBuf;                      //!
+  std::vector<std::pair<Float_t, Int_t> > fAxisBuf;  //! folded track directions, sorted
+  std::vector<Float_t> fAxisX;                       //! sweep of the directions
+  std::vector<Float_t> fAxisY;                       //!
+  Float_t fSpherocity;                               //! pt weighted spherocity
+  Float_t fSpherocityUnweighted;                     //! spherocity with unit weights
+  Float_t fSphericity;                               //! transverse sphericity
+  AliVEvent *fLastEvent;                             //! identity of the analysed event
+  Int_t   fLastNTracks;                              //!
+  Int_t   fLastRun;                                  //!
+  UInt_t  fLastPeriod;                               //!
+  UInt_t  fLastOrbit;                                //!
+  UShort_t fLastBC;                                  //!
+  Bool_t  fLastIsMC;                                 //! results are from the MC stack
+
+
+  ClassDef(AliTransverseEventShape,3) // base helper class
 };
 #endif
 
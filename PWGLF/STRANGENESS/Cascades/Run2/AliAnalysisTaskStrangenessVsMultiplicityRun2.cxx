@@ -118,6 +118,7 @@ class AliAODv0;
 #include "AliEventCuts.h"
 #include "AliV0Result.h"
 #include "AliCascadeResult.h"
+#include "AliStrangenessCandidateTable.h"
 #include "AliAnalysisTaskStrangenessVsMultiplicityRun2.h"
 
 using std::cout;
@@ -1228,6 +1229,10 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
     Int_t nv0s = 0;
     nv0s = lESDevent->GetNumberOfV0s();
     
+    //Topological variables, masses and N-sigmas, shared with the other strangeness tasks
+    //(rebuilt if the vertexers were re-run here)
+    AliStrangenessCandidateTable *lCandidates = AliStrangenessCandidateTable::GetTable( lESDevent, 0x0, fPIDResponse, fkRunVertexers );
+    
     for (Int_t iV0 = 0; iV0 < nv0s; iV0++) //extra-crazy test
     {   // This is the begining of the V0 loop
         AliESDv0 *v0 = ((AliESDEvent*)lESDevent)->GetV0(iV0);
@@ -1242,15 +1247,7 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
             continue;
         }
         
-        Double_t tDecayVertexV0[3];
-        v0->GetXYZ(tDecayVertexV0[0],tDecayVertexV0[1],tDecayVertexV0[2]);
-        
-        Double_t tV0mom[3];
-        v0->GetPxPyPz( tV0mom[0],tV0mom[1],tV0mom[2] );
-        Double_t lV0TotalMomentum = TMath::Sqrt(
-                                                tV0mom[0]*tV0mom[0]+tV0mom[1]*tV0mom[1]+tV0mom[2]*tV0mom[2] );
-        
-        lV0Radius = TMath::Sqrt(tDecayVertexV0[0]*tDecayVertexV0[0]+tDecayVertexV0[1]*tDecayVertexV0[1]);
+        lV0Radius = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0Radius );
         
         lPt = v0->Pt();
         lRapK0Short = v0->RapK0Short();
@@ -1376,28 +1373,20 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         //End track Quality Cuts
         //________________________________________________________________________
         
-        lDcaPosToPrimVertex = TMath::Abs(pTrack->GetD(lBestPrimaryVtxPos[0],
-                                                      lBestPrimaryVtxPos[1],
-                                                      lMagneticField) );
-        
-        lDcaNegToPrimVertex = TMath::Abs(nTrack->GetD(lBestPrimaryVtxPos[0],
-                                                      lBestPrimaryVtxPos[1],
-                                                      lMagneticField) );
+        lDcaPosToPrimVertex = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0DcaPosToPV );
+        lDcaNegToPrimVertex = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0DcaNegToPV );
         
         lOnFlyStatus = v0->GetOnFlyStatus();
         lChi2V0 = v0->GetChi2V0();
-        lDcaV0Daughters = v0->GetDcaV0Daughters();
-        lDcaV0ToPrimVertex = v0->GetD(lBestPrimaryVtxPos[0],lBestPrimaryVtxPos[1],lBestPrimaryVtxPos[2]);
-        lV0CosineOfPointingAngle = v0->GetV0CosineOfPointingAngle(lBestPrimaryVtxPos[0],lBestPrimaryVtxPos[1],lBestPrimaryVtxPos[2]);
+        lDcaV0Daughters = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0DcaV0Daughters );
+        lDcaV0ToPrimVertex = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0DcaV0ToPV );
+        lV0CosineOfPointingAngle = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0CosPA );
         fTreeVariableV0CosineOfPointingAngle=lV0CosineOfPointingAngle;
         
-        // Getting invariant mass infos directly from ESD
-        v0->ChangeMassHypothesis(310);
-        lInvMassK0s = v0->GetEffMass();
-        v0->ChangeMassHypothesis(3122);
-        lInvMassLambda = v0->GetEffMass();
-        v0->ChangeMassHypothesis(-3122);
-        lInvMassAntiLambda = v0->GetEffMass();
+        // Invariant masses for all hypotheses, from the candidate table
+        lInvMassK0s = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0MassK0Short );
+        lInvMassLambda = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0MassLambda );
+        lInvMassAntiLambda = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0MassAntiLambda );
         lAlphaV0 = v0->AlphaV0();
         lPtArmV0 = v0->PtArmV0();
         
@@ -1419,19 +1408,14 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         fTreeVariableAlphaV0 = lAlphaV0;
         fTreeVariablePtArmV0 = lPtArmV0;
         
-        //Official means of acquiring N-sigmas
-        fTreeVariableNSigmasPosProton = fPIDResponse->NumberOfSigmasTPC( pTrack, AliPID::kProton );
-        fTreeVariableNSigmasPosPion   = fPIDResponse->NumberOfSigmasTPC( pTrack, AliPID::kPion );
-        fTreeVariableNSigmasNegProton = fPIDResponse->NumberOfSigmasTPC( nTrack, AliPID::kProton );
-        fTreeVariableNSigmasNegPion   = fPIDResponse->NumberOfSigmasTPC( nTrack, AliPID::kPion );
+        //Official means of acquiring N-sigmas, precomputed in the candidate table
+        fTreeVariableNSigmasPosProton = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0NSigmaPosProton );
+        fTreeVariableNSigmasPosPion   = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0NSigmaPosPion );
+        fTreeVariableNSigmasNegProton = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0NSigmaNegProton );
+        fTreeVariableNSigmasNegPion   = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0NSigmaNegPion );
         
         //This requires an Invariant Mass Hypothesis afterwards
-        fTreeVariableDistOverTotMom = TMath::Sqrt(
-                                                  TMath::Power( tDecayVertexV0[0] - lBestPrimaryVtxPos[0] , 2) +
-                                                  TMath::Power( tDecayVertexV0[1] - lBestPrimaryVtxPos[1] , 2) +
-                                                  TMath::Power( tDecayVertexV0[2] - lBestPrimaryVtxPos[2] , 2)
-                                                  );
-        fTreeVariableDistOverTotMom /= (lV0TotalMomentum+1e-10); //avoid division by zero, to be sure
+        fTreeVariableDistOverTotMom = lCandidates->GetV0( iV0, AliStrangenessCandidateTable::kV0DistOverTotMom );
         
         //Copy Multiplicity information
         fTreeVariableCentrality = fCentrality;
@@ -1669,6 +1653,9 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
     Long_t ncascades = 0;
     ncascades = lESDevent->GetNumberOfCascades();
     
+    //Shared candidate table, rebuilt if the cascade vertexer was re-run here
+    lCandidates = AliStrangenessCandidateTable::GetTable( lESDevent, 0x0, fPIDResponse, fkRunVertexers );
+    
     for (Int_t iXi = 0; iXi < ncascades; iXi++) {
         //------------------------------------------------
         // Initializations
@@ -1869,8 +1856,8 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         fTreeCascVarNegNSigmaProton = fPIDResponse->NumberOfSigmasTPC( nTrackXi, AliPID::kProton );
         fTreeCascVarPosNSigmaPion   = fPIDResponse->NumberOfSigmasTPC( pTrackXi, AliPID::kPion );
         fTreeCascVarPosNSigmaProton = fPIDResponse->NumberOfSigmasTPC( pTrackXi, AliPID::kProton );
-        fTreeCascVarBachNSigmaPion  = fPIDResponse->NumberOfSigmasTPC( bachTrackXi, AliPID::kPion );
-        fTreeCascVarBachNSigmaKaon  = fPIDResponse->NumberOfSigmasTPC( bachTrackXi, AliPID::kKaon );
+        fTreeCascVarBachNSigmaPion  = lCandidates->GetCascade( iXi, AliStrangenessCandidateTable::kCascNSigmaBachPion );
+        fTreeCascVarBachNSigmaKaon  = lCandidates->GetCascade( iXi, AliStrangenessCandidateTable::kCascNSigmaBachKaon );
         
         //------------------------------------------------
         // Raw TPC dEdx + PIDForTracking information
@@ -1991,22 +1978,13 @@ void AliAnalysisTaskStrangenessVsMultiplicityRun2::UserExec(Option_t *)
         //lV0Chi2Xi 			= xi->GetChi2V0();
         
         
-        lV0CosineOfPointingAngleXi 	= xi->GetV0CosineOfPointingAngle( lBestPrimaryVtxPos[0],
-                                                                     lBestPrimaryVtxPos[1],
-                                                                     lBestPrimaryVtxPos[2] );
+        lV0CosineOfPointingAngleXi 	= lCandidates->GetCascade( iXi, AliStrangenessCandidateTable::kCascV0CosPA );
         //Modification: V0 CosPA wrt to Cascade decay vertex
-        lV0CosineOfPointingAngleXiSpecial 	= xi->GetV0CosineOfPointingAngle( lPosXi[0],
-                                                                             lPosXi[1],
-                                                                             lPosXi[2] );
+        lV0CosineOfPointingAngleXiSpecial 	= lCandidates->GetCascade( iXi, AliStrangenessCandidateTable::kCascV0CosPASpecial );
         
-        lDcaV0ToPrimVertexXi 		= xi->GetD( lBestPrimaryVtxPos[0],
-                                               lBestPrimaryVtxPos[1],
-                                               lBestPrimaryVtxPos[2] );
+        lDcaV0ToPrimVertexXi 		= lCandidates->GetCascade( iXi, AliStrangenessCandidateTable::kCascDcaV0ToPV );
         
-        lDcaBachToPrimVertexXi = TMath::Abs( bachTrackXi->GetD(	lBestPrimaryVtxPos[0],
-                                                               lBestPrimaryVtxPos[1],
-                                                               lMagneticField  ) );
-        // Note : AliExternalTrackParam::GetD returns an algebraic value ...
+        lDcaBachToPrimVertexXi = lCandidates->GetCascade( iXi, AliStrangenessCandidateTable::kCascDcaBachToPV );
         
         xi->GetXYZ( lPosV0Xi[0],  lPosV0Xi[1], lPosV0Xi[2] );
         lV0RadiusXi		= TMath::Sqrt( lPosV0Xi[0]*lPosV0Xi[0]  +  lPosV0Xi[1]*lPosV0Xi[1] );
@@ -0,0 +1,411 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// Per-event table of V0 and cascade candidates
+//
+// See header for usage.
+//
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "TMath.h"
+#include "TParticle.h"
+#include "TDatabasePDG.h"
+#include "AliESDEvent.h"
+#include "AliESDv0.h"
+#include "AliESDcascade.h"
+#include "AliESDtrack.h"
+#include "AliESDVertex.h"
+#include "AliMCEvent.h"
+#include "AliStack.h"
+#include "AliPIDResponse.h"
+#include "AliLog.h"
+#include "AliStrangenessCandidateTable.h"
+
+ClassImp(AliStrangenessCandidateTable);
+
+//________________________________________________________________
+AliStrangenessCandidateTable::AliStrangenessCandidateTable() :
+TNamed(),
+fRunNumber(-1),
+fPeriod(0),
+fOrbit(0),
+fBunchCross(0),
+fEventInFile(-1),
+fBuilt(kFALSE),
+fHasMC(kFALSE),
+fNV0s(0),
+fNCascades(0)
+{
+    // Dummy Constructor - not to be used!
+}
+
+//________________________________________________________________
+AliStrangenessCandidateTable::AliStrangenessCandidateTable(const char * name, const char * title) :
+TNamed(name,title),
+fRunNumber(-1),
+fPeriod(0),
+fOrbit(0),
+fBunchCross(0),
+fEventInFile(-1),
+fBuilt(kFALSE),
+fHasMC(kFALSE),
+fNV0s(0),
+fNCascades(0)
+{
+    // Named constructor
+}
+
+//________________________________________________________________
+AliStrangenessCandidateTable::~AliStrangenessCandidateTable()
+{
+    // Destructor: columns are std::vectors, nothing to delete
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::Clear(Option_t*)
+{
+    // Invalidate the content, keeping the allocated columns.
+    // Called by the event reset procedure when attached to the event.
+    fBuilt     = kFALSE;
+    fNV0s      = 0;
+    fNCascades = 0;
+}
+
+//________________________________________________________________
+AliStrangenessCandidateTable* AliStrangenessCandidateTable::GetTable( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse, Bool_t lForceRebuild )
+{
+    // Get the table attached to the event, attaching and building it
+    // if needed. As for AliMultSelection, the object can disappear on
+    // change of input file (event reset), so it is re-added if missing.
+    if( !lESDevent ) return 0x0;
+
+    AliStrangenessCandidateTable *lTable = dynamic_cast<AliStrangenessCandidateTable*>( lESDevent->FindListObject("StrangenessCandidates") );
+    if( !lTable ) {
+        lTable = new AliStrangenessCandidateTable("StrangenessCandidates");
+        lESDevent->AddObject(lTable);
+    }
+    if( lForceRebuild || !lTable->IsBuiltFor(lESDevent) ) lTable->Build( lESDevent, lMCevent, lPIDResponse );
+    return lTable;
+}
+
+//________________________________________________________________
+Bool_t AliStrangenessCandidateTable::IsBuiltFor( AliESDEvent *lESDevent ) const
+{
+    // Check that the content corresponds to this event and to its
+    // current V0 and cascade lists
+    if( !fBuilt ) return kFALSE;
+    if( fRunNumber   != lESDevent->GetRunNumber()         ) return kFALSE;
+    if( fPeriod      != lESDevent->GetPeriodNumber()      ) return kFALSE;
+    if( fOrbit       != lESDevent->GetOrbitNumber()       ) return kFALSE;
+    if( fBunchCross  != lESDevent->GetBunchCrossNumber()  ) return kFALSE;
+    if( fEventInFile != lESDevent->GetEventNumberInFile() ) return kFALSE;
+    if( fNV0s        != lESDevent->GetNumberOfV0s()       ) return kFALSE;
+    if( fNCascades   != lESDevent->GetNumberOfCascades()  ) return kFALSE;
+    return kTRUE;
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::Build( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse )
+{
+    // Compute all the columns for the V0s and cascades of the event
+    fRunNumber   = lESDevent->GetRunNumber();
+    fPeriod      = lESDevent->GetPeriodNumber();
+    fOrbit       = lESDevent->GetOrbitNumber();
+    fBunchCross  = lESDevent->GetBunchCrossNumber();
+    fEventInFile = lESDevent->GetEventNumberInFile();
+    fHasMC       = ( lMCevent && lMCevent->Stack() );
+
+    //Best primary vertex, as in the analysis tasks
+    Double_t lPV[3] = {0.,0.,0.};
+    const AliESDVertex *lPrimaryVtx = lESDevent->GetPrimaryVertex();
+    if( lPrimaryVtx ) lPrimaryVtx->GetXYZ( lPV );
+
+    BuildV0s      ( lESDevent, fHasMC ? lMCevent : 0x0, lPIDResponse, lPV );
+    BuildCascades ( lESDevent, fHasMC ? lMCevent : 0x0, lPIDResponse, lPV );
+    fBuilt = kTRUE;
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::BuildV0s( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse, const Double_t *lPV )
+{
+    fNV0s = lESDevent->GetNumberOfV0s();
+    for(Int_t icol=0; icol<kNV0Columns;    icol++) fV0Columns   [icol].assign( fNV0s, -999. );
+    for(Int_t icol=0; icol<kNV0IntColumns; icol++) fV0IntColumns[icol].assign( fNV0s, 0 );
+
+    const Double_t lMagneticField = lESDevent->GetMagneticField();
+    const Double_t lMassPion   = TDatabasePDG::Instance()->GetParticle(kPiPlus)->Mass();
+    const Double_t lMassProton = TDatabasePDG::Instance()->GetParticle(kProton)->Mass();
+    AliStack *lMCstack = lMCevent ? lMCevent->Stack() : 0x0;
+
+    for (Long_t iV0 = 0; iV0 < fNV0s; iV0++) {
+        AliESDv0 *v0 = lESDevent->GetV0(iV0);
+        if (!v0) continue;
+
+        //Assign positive and negative daughters by charge, without
+        //modifying the V0 (tasks may still call CheckChargeV0)
+        Bool_t lSwapped = ( v0->GetParamP()->Charge() < 0 && v0->GetParamN()->Charge() > 0 );
+        fV0IntColumns[kV0LikeSign][iV0] = ( v0->GetParamP()->Charge() * v0->GetParamN()->Charge() > 0 );
+
+        Double_t lMomPos[3], lMomNeg[3];
+        v0->GetPPxPyPz(lMomPos[0],lMomPos[1],lMomPos[2]);
+        v0->GetNPxPyPz(lMomNeg[0],lMomNeg[1],lMomNeg[2]);
+        UInt_t lKeyPos = (UInt_t)TMath::Abs(v0->GetPindex());
+        UInt_t lKeyNeg = (UInt_t)TMath::Abs(v0->GetNindex());
+        if( lSwapped ) {
+            for(Int_t i=0; i<3; i++) { Double_t lTmp = lMomPos[i]; lMomPos[i] = lMomNeg[i]; lMomNeg[i] = lTmp; }
+            UInt_t lTmpKey = lKeyPos; lKeyPos = lKeyNeg; lKeyNeg = lTmpKey;
+        }
+        fV0IntColumns[kV0PosIndex][iV0] = lKeyPos;
+        fV0IntColumns[kV0NegIndex][iV0] = lKeyNeg;
+        fV0IntColumns[kV0OnFlyStatus][iV0] = v0->GetOnFlyStatus();
+
+        Double_t tDecayVertexV0[3];
+        v0->GetXYZ(tDecayVertexV0[0],tDecayVertexV0[1],tDecayVertexV0[2]);
+        Double_t tV0mom[3];
+        v0->GetPxPyPz( tV0mom[0],tV0mom[1],tV0mom[2] );
+        Double_t lV0TotalMomentum = TMath::Sqrt( tV0mom[0]*tV0mom[0]+tV0mom[1]*tV0mom[1]+tV0mom[2]*tV0mom[2] );
+
+        fV0Columns[kV0Pt][iV0]          = v0->Pt();
+        fV0Columns[kV0Eta][iV0]         = v0->Eta();
+        fV0Columns[kV0RapK0Short][iV0]  = v0->RapK0Short();
+        fV0Columns[kV0RapLambda][iV0]   = v0->RapLambda();
+        fV0Columns[kV0Radius][iV0]      = TMath::Sqrt(tDecayVertexV0[0]*tDecayVertexV0[0]+tDecayVertexV0[1]*tDecayVertexV0[1]);
+        fV0Columns[kV0DcaV0Daughters][iV0] = v0->GetDcaV0Daughters();
+        fV0Columns[kV0DcaV0ToPV][iV0]   = v0->GetD(lPV[0],lPV[1],lPV[2]);
+        fV0Columns[kV0CosPA][iV0]       = v0->GetV0CosineOfPointingAngle(lPV[0],lPV[1],lPV[2]);
+        fV0Columns[kV0AlphaV0][iV0]     = lSwapped ? -v0->AlphaV0() : v0->AlphaV0();
+        fV0Columns[kV0PtArmV0][iV0]     = v0->PtArmV0();
+
+        //This requires an Invariant Mass Hypothesis afterwards
+        Double_t lDistOverTotMom = TMath::Sqrt( TMath::Power( tDecayVertexV0[0] - lPV[0] , 2) +
+                                                TMath::Power( tDecayVertexV0[1] - lPV[1] , 2) +
+                                                TMath::Power( tDecayVertexV0[2] - lPV[2] , 2) );
+        fV0Columns[kV0DistOverTotMom][iV0] = lDistOverTotMom / (lV0TotalMomentum+1e-10); //avoid division by zero, to be sure
+
+        //Invariant masses from the daughter momenta, for all hypotheses at once
+        //(same as ChangeMassHypothesis + GetEffMass, with correct charges)
+        Double_t lP2Pos = lMomPos[0]*lMomPos[0]+lMomPos[1]*lMomPos[1]+lMomPos[2]*lMomPos[2];
+        Double_t lP2Neg = lMomNeg[0]*lMomNeg[0]+lMomNeg[1]*lMomNeg[1]+lMomNeg[2]*lMomNeg[2];
+        Double_t lP2V0  = tV0mom[0]*tV0mom[0]+tV0mom[1]*tV0mom[1]+tV0mom[2]*tV0mom[2];
+        Double_t lEPosPion   = TMath::Sqrt(lP2Pos + lMassPion*lMassPion);
+        Double_t lEPosProton = TMath::Sqrt(lP2Pos + lMassProton*lMassProton);
+        Double_t lENegPion   = TMath::Sqrt(lP2Neg + lMassPion*lMassPion);
+        Double_t lENegProton = TMath::Sqrt(lP2Neg + lMassProton*lMassProton);
+        fV0Columns[kV0MassK0Short][iV0]    = TMath::Sqrt( TMath::Max( 0., TMath::Power(lEPosPion  +lENegPion  ,2) - lP2V0 ) );
+        fV0Columns[kV0MassLambda][iV0]     = TMath::Sqrt( TMath::Max( 0., TMath::Power(lEPosProton+lENegPion  ,2) - lP2V0 ) );
+        fV0Columns[kV0MassAntiLambda][iV0] = TMath::Sqrt( TMath::Max( 0., TMath::Power(lEPosPion  +lENegProton,2) - lP2V0 ) );
+
+        AliESDtrack *pTrack = lESDevent->GetTrack(lKeyPos);
+        AliESDtrack *nTrack = lESDevent->GetTrack(lKeyNeg);
+        if (!pTrack || !nTrack) {
+            AliWarning("Could not retrieve one of the V0 daughter tracks");
+            continue;
+        }
+        fV0Columns[kV0PosEta][iV0] = pTrack->Eta();
+        fV0Columns[kV0NegEta][iV0] = nTrack->Eta();
+        fV0Columns[kV0DcaPosToPV][iV0] = TMath::Abs(pTrack->GetD(lPV[0],lPV[1],lMagneticField));
+        fV0Columns[kV0DcaNegToPV][iV0] = TMath::Abs(nTrack->GetD(lPV[0],lPV[1],lMagneticField));
+
+        if( lPIDResponse ) {
+            fV0Columns[kV0NSigmaPosProton][iV0] = lPIDResponse->NumberOfSigmasTPC( pTrack, AliPID::kProton );
+            fV0Columns[kV0NSigmaPosPion][iV0]   = lPIDResponse->NumberOfSigmasTPC( pTrack, AliPID::kPion );
+            fV0Columns[kV0NSigmaNegProton][iV0] = lPIDResponse->NumberOfSigmasTPC( nTrack, AliPID::kProton );
+            fV0Columns[kV0NSigmaNegPion][iV0]   = lPIDResponse->NumberOfSigmasTPC( nTrack, AliPID::kPion );
+        }
+
+        //MC association: common mother of the two daughters
+        if( !lMCstack ) continue;
+        Int_t lblPosV0Dghter = (Int_t) TMath::Abs( pTrack->GetLabel() );
+        Int_t lblNegV0Dghter = (Int_t) TMath::Abs( nTrack->GetLabel() );
+        if( lblPosV0Dghter >= lMCstack->GetNtrack() || lblNegV0Dghter >= lMCstack->GetNtrack() ) continue;
+        TParticle* mcPosV0Dghter = lMCstack->Particle( lblPosV0Dghter );
+        TParticle* mcNegV0Dghter = lMCstack->Particle( lblNegV0Dghter );
+        if( !mcPosV0Dghter || !mcNegV0Dghter ) continue;
+        Int_t lblMotherPosV0Dghter = mcPosV0Dghter->GetFirstMother();
+        Int_t lblMotherNegV0Dghter = mcNegV0Dghter->GetFirstMother();
+        if( lblMotherPosV0Dghter != lblMotherNegV0Dghter || lblMotherPosV0Dghter < 0 ) continue;
+
+        TParticle* pThisV0 = lMCstack->Particle( lblMotherPosV0Dghter );
+        fV0IntColumns[kV0PdgMC][iV0] = pThisV0->GetPdgCode();
+        if( lMCstack->IsPhysicalPrimary       (lblMotherPosV0Dghter) ) fV0IntColumns[kV0PrimaryStatusMC][iV0] = 1; //Is Primary!
+        if( lMCstack->IsSecondaryFromWeakDecay(lblMotherPosV0Dghter) ) fV0IntColumns[kV0PrimaryStatusMC][iV0] = 2; //Weak Decay!
+        if( lMCstack->IsSecondaryFromMaterial (lblMotherPosV0Dghter) ) fV0IntColumns[kV0PrimaryStatusMC][iV0] = 3; //Material Int!
+        Int_t lblThisV0Parent = pThisV0->GetFirstMother();
+        if ( lblThisV0Parent > -1 ) fV0IntColumns[kV0PdgMotherMC][iV0] = lMCstack->Particle( lblThisV0Parent )->GetPdgCode();
+    }
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::BuildCascades( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse, const Double_t *lPV )
+{
+    fNCascades = lESDevent->GetNumberOfCascades();
+    for(Int_t icol=0; icol<kNCascadeColumns;    icol++) fCascColumns   [icol].assign( fNCascades, -999. );
+    for(Int_t icol=0; icol<kNCascadeIntColumns; icol++) fCascIntColumns[icol].assign( fNCascades, 0 );
+
+    const Double_t lMagneticField = lESDevent->GetMagneticField();
+    const Double_t lMassPion   = TDatabasePDG::Instance()->GetParticle(kPiPlus)->Mass();
+    const Double_t lMassProton = TDatabasePDG::Instance()->GetParticle(kProton)->Mass();
+    AliStack *lMCstack = lMCevent ? lMCevent->Stack() : 0x0;
+
+    for (Long_t iXi = 0; iXi < fNCascades; iXi++) {
+        AliESDcascade *xi = lESDevent->GetCascade(iXi);
+        if (!xi) continue;
+
+        Bool_t lSwapped = ( xi->GetParamP()->Charge() < 0 && xi->GetParamN()->Charge() > 0 );
+        UInt_t lIdxPosXi = (UInt_t) TMath::Abs( xi->GetPindex() );
+        UInt_t lIdxNegXi = (UInt_t) TMath::Abs( xi->GetNindex() );
+        UInt_t lBachIdx  = (UInt_t) TMath::Abs( xi->GetBindex() );
+        Double_t lPMom[3], lNMom[3];
+        xi->GetPPxPyPz( lPMom[0], lPMom[1], lPMom[2] );
+        xi->GetNPxPyPz( lNMom[0], lNMom[1], lNMom[2] );
+        if( lSwapped ) {
+            for(Int_t i=0; i<3; i++) { Double_t lTmp = lPMom[i]; lPMom[i] = lNMom[i]; lNMom[i] = lTmp; }
+            UInt_t lTmpKey = lIdxPosXi; lIdxPosXi = lIdxNegXi; lIdxNegXi = lTmpKey;
+        }
+        fCascIntColumns[kCascPosIndex][iXi]  = lIdxPosXi;
+        fCascIntColumns[kCascNegIndex][iXi]  = lIdxNegXi;
+        fCascIntColumns[kCascBachIndex][iXi] = lBachIdx;
+
+        AliESDtrack *pTrackXi    = lESDevent->GetTrack( lIdxPosXi );
+        AliESDtrack *nTrackXi    = lESDevent->GetTrack( lIdxNegXi );
+        AliESDtrack *bachTrackXi = lESDevent->GetTrack( lBachIdx );
+        if (!pTrackXi || !nTrackXi || !bachTrackXi ) {
+            AliWarning("Could not retrieve one of the cascade daughter tracks");
+            continue;
+        }
+        Int_t lCharge = bachTrackXi->Charge();
+        fCascIntColumns[kCascCharge][iXi] = lCharge;
+
+        Double_t lPosXi[3], lPosV0Xi[3];
+        xi->GetXYZcascade( lPosXi[0], lPosXi[1], lPosXi[2] );
+        xi->GetXYZ( lPosV0Xi[0], lPosV0Xi[1], lPosV0Xi[2] );
+        Double_t lXiMomX = 0., lXiMomY = 0., lXiMomZ = 0.;
+        xi->GetPxPyPz( lXiMomX, lXiMomY, lXiMomZ );
+
+        fCascColumns[kCascPt][iXi]       = TMath::Sqrt( lXiMomX*lXiMomX + lXiMomY*lXiMomY );
+        fCascColumns[kCascEta][iXi]      = xi->Eta();
+        fCascColumns[kCascRapXi][iXi]    = xi->RapXi();
+        fCascColumns[kCascRapOmega][iXi] = xi->RapOmega();
+        fCascColumns[kCascRadius][iXi]   = TMath::Sqrt( lPosXi[0]*lPosXi[0] + lPosXi[1]*lPosXi[1] );
+        fCascColumns[kCascV0Radius][iXi] = TMath::Sqrt( lPosV0Xi[0]*lPosV0Xi[0] + lPosV0Xi[1]*lPosV0Xi[1] );
+        fCascColumns[kCascDcaV0Daughters][iXi]   = xi->GetDcaV0Daughters();
+        fCascColumns[kCascDcaCascDaughters][iXi] = xi->GetDcaXiDaughters();
+        fCascColumns[kCascDcaV0ToPV][iXi]      = xi->GetD( lPV[0], lPV[1], lPV[2] );
+        fCascColumns[kCascV0CosPA][iXi]        = xi->GetV0CosineOfPointingAngle( lPV[0], lPV[1], lPV[2] );
+        fCascColumns[kCascV0CosPASpecial][iXi] = xi->GetV0CosineOfPointingAngle( lPosXi[0], lPosXi[1], lPosXi[2] );
+        fCascColumns[kCascCosPA][iXi]          = xi->GetCascadeCosineOfPointingAngle( lPV[0], lPV[1], lPV[2] );
+        fCascColumns[kCascDcaBachToPV][iXi] = TMath::Abs( bachTrackXi->GetD( lPV[0], lPV[1], lMagneticField ) );
+        fCascColumns[kCascDcaPosToPV][iXi]  = TMath::Abs( pTrackXi   ->GetD( lPV[0], lPV[1], lMagneticField ) );
+        fCascColumns[kCascDcaNegToPV][iXi]  = TMath::Abs( nTrackXi   ->GetD( lPV[0], lPV[1], lMagneticField ) );
+
+        //Lambda (AntiLambda) mass for negative (positive) bachelor:
+        //the (anti)proton is the positive (negative) daughter
+        Double_t lP2Pos = lPMom[0]*lPMom[0]+lPMom[1]*lPMom[1]+lPMom[2]*lPMom[2];
+        Double_t lP2Neg = lNMom[0]*lNMom[0]+lNMom[1]*lNMom[1]+lNMom[2]*lNMom[2];
+        Double_t lP2V0  = TMath::Power( lPMom[0]+lNMom[0], 2 ) + TMath::Power( lPMom[1]+lNMom[1], 2 ) + TMath::Power( lPMom[2]+lNMom[2], 2 );
+        Double_t lMassPos = lCharge < 0 ? lMassProton : lMassPion;
+        Double_t lMassNeg = lCharge < 0 ? lMassPion   : lMassProton;
+        Double_t lEV0 = TMath::Sqrt( lP2Pos + lMassPos*lMassPos ) + TMath::Sqrt( lP2Neg + lMassNeg*lMassNeg );
+        fCascColumns[kCascMassLambda][iXi] = TMath::Sqrt( TMath::Max( 0., lEV0*lEV0 - lP2V0 ) );
+
+        //Xi and Omega masses (perfect lambda mass assumed), back to Xi hypothesis afterwards
+        Double_t lV0quality = 0.;
+        xi->ChangeMassHypothesis( lV0quality, lCharge < 0 ? 3334 : -3334 );
+        fCascColumns[kCascMassOmega][iXi] = xi->GetEffMassXi();
+        lV0quality = 0.;
+        xi->ChangeMassHypothesis( lV0quality, lCharge < 0 ? 3312 : -3312 );
+        fCascColumns[kCascMassXi][iXi] = xi->GetEffMassXi();
+
+        if( lPIDResponse ) {
+            fCascColumns[kCascNSigmaBachPion][iXi]  = lPIDResponse->NumberOfSigmasTPC( bachTrackXi, AliPID::kPion );
+            fCascColumns[kCascNSigmaBachKaon][iXi]  = lPIDResponse->NumberOfSigmasTPC( bachTrackXi, AliPID::kKaon );
+            fCascColumns[kCascNSigmaPosProton][iXi] = lPIDResponse->NumberOfSigmasTPC( pTrackXi, AliPID::kProton );
+            fCascColumns[kCascNSigmaPosPion][iXi]   = lPIDResponse->NumberOfSigmasTPC( pTrackXi, AliPID::kPion );
+            fCascColumns[kCascNSigmaNegProton][iXi] = lPIDResponse->NumberOfSigmasTPC( nTrackXi, AliPID::kProton );
+            fCascColumns[kCascNSigmaNegPion][iXi]   = lPIDResponse->NumberOfSigmasTPC( nTrackXi, AliPID::kPion );
+        }
+
+        //MC association: V0 daughters from the same lambda, lambda and bachelor from the same mother
+        if( !lMCstack ) continue;
+        Int_t lblPosV0Dghter = (Int_t) TMath::Abs( pTrackXi->GetLabel() );
+        Int_t lblNegV0Dghter = (Int_t) TMath::Abs( nTrackXi->GetLabel() );
+        Int_t lblBach        = (Int_t) TMath::Abs( bachTrackXi->GetLabel() );
+        Int_t lNtrack = lMCstack->GetNtrack();
+        if( lblPosV0Dghter >= lNtrack || lblNegV0Dghter >= lNtrack || lblBach >= lNtrack ) continue;
+        TParticle* mcPosV0Dghter = lMCstack->Particle( lblPosV0Dghter );
+        TParticle* mcNegV0Dghter = lMCstack->Particle( lblNegV0Dghter );
+        TParticle* mcBach        = lMCstack->Particle( lblBach );
+        if( !mcPosV0Dghter || !mcNegV0Dghter || !mcBach ) continue;
+        Int_t lblMotherPosV0Dghter = mcPosV0Dghter->GetFirstMother();
+        Int_t lblMotherNegV0Dghter = mcNegV0Dghter->GetFirstMother();
+        if( lblMotherPosV0Dghter != lblMotherNegV0Dghter || lblMotherPosV0Dghter < 0 ) continue;
+        Int_t lblGrandMotherV0  = lMCstack->Particle( lblMotherPosV0Dghter )->GetFirstMother();
+        Int_t lblMotherBachelor = mcBach->GetFirstMother();
+        if( lblGrandMotherV0 != lblMotherBachelor || lblMotherBachelor < 0 ) continue;
+
+        fCascIntColumns[kCascPdgMC][iXi] = lMCstack->Particle( lblMotherBachelor )->GetPdgCode();
+        if( lMCstack->IsPhysicalPrimary( lblMotherBachelor ) ) fCascIntColumns[kCascPrimaryStatusMC][iXi] = 1;
+    }
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::SelectAllV0s( std::vector<Int_t> &lRows ) const
+{
+    lRows.resize( fNV0s );
+    for(Long_t irow=0; irow<fNV0s; irow++) lRows[irow] = irow;
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::SelectAllCascades( std::vector<Int_t> &lRows ) const
+{
+    lRows.resize( fNCascades );
+    for(Long_t irow=0; irow<fNCascades; irow++) lRows[irow] = irow;
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::FilterV0s( std::vector<Int_t> &lRows, EV0Column lCol, Float_t lMin, Float_t lMax ) const
+{
+    // Compact lRows in place, keeping the order
+    const std::vector<Float_t> &lColumn = fV0Columns[lCol];
+    size_t lNKept = 0;
+    for(size_t i=0; i<lRows.size(); i++) {
+        Float_t lValue = lColumn[lRows[i]];
+        if( lValue >= lMin && lValue <= lMax ) lRows[lNKept++] = lRows[i];
+    }
+    lRows.resize( lNKept );
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::FilterV0s( std::vector<Int_t> &lRows, EV0IntColumn lCol, Int_t lMin, Int_t lMax ) const
+{
+    const std::vector<Int_t> &lColumn = fV0IntColumns[lCol];
+    size_t lNKept = 0;
+    for(size_t i=0; i<lRows.size(); i++) {
+        Int_t lValue = lColumn[lRows[i]];
+        if( lValue >= lMin && lValue <= lMax ) lRows[lNKept++] = lRows[i];
+    }
+    lRows.resize( lNKept );
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::FilterCascades( std::vector<Int_t> &lRows, ECascadeColumn lCol, Float_t lMin, Float_t lMax ) const
+{
+    const std::vector<Float_t> &lColumn = fCascColumns[lCol];
+    size_t lNKept = 0;
+    for(size_t i=0; i<lRows.size(); i++) {
+        Float_t lValue = lColumn[lRows[i]];
+        if( lValue >= lMin && lValue <= lMax ) lRows[lNKept++] = lRows[i];
+    }
+    lRows.resize( lNKept );
+}
+
+//________________________________________________________________
+void AliStrangenessCandidateTable::FilterCascades( std::vector<Int_t> &lRows, ECascadeIntColumn lCol, Int_t lMin, Int_t lMax ) const
+{
+    const std::vector<Int_t> &lColumn = fCascIntColumns[lCol];
+    size_t lNKept = 0;
+    for(size_t i=0; i<lRows.size(); i++) {
+        Int_t lValue = lColumn[lRows[i]];
+        if( lValue >= lMin && lValue <= lMax ) lRows[lNKept++] = lRows[i];
+    }
+    lRows.resize( lNKept );
+}
@@ -0,0 +1,173 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// Per-event table of V0 and cascade candidates
+//
+// The topological variables (DCAs to PV, cosines of pointing angle,
+// decay radii), the invariant masses for all hypotheses, the TPC
+// dE/dx N-sigmas of the daughters and, if available, the MC
+// association are computed once per event for each AliESDv0 and
+// AliESDcascade and stored as columns (row i = V0 or cascade i).
+//
+// The table is attached to the input event under the name
+// "StrangenessCandidates", as done for AliMultSelection, so that
+// all the strangeness tasks running in the same train share it:
+// the first task calling GetTable() for a given event builds it,
+// the others only read it and apply their own cuts as column
+// filters (FilterV0s / FilterCascades).
+//
+// Tasks re-running the V0/cascade vertexers on the fly change the
+// candidate lists and must request a rebuild (lForceRebuild).
+//
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#ifndef AliStrangenessCandidateTable_H
+#define AliStrangenessCandidateTable_H
+#include <TNamed.h>
+#include <vector>
+
+class AliESDEvent;
+class AliMCEvent;
+class AliPIDResponse;
+
+class AliStrangenessCandidateTable : public TNamed {
+
+public:
+    //Float columns of the V0 table
+    enum EV0Column {
+        kV0Pt = 0,
+        kV0Eta,
+        kV0RapK0Short,
+        kV0RapLambda,
+        kV0Radius,
+        kV0DcaPosToPV,
+        kV0DcaNegToPV,
+        kV0DcaV0Daughters,
+        kV0DcaV0ToPV,
+        kV0CosPA,
+        kV0DistOverTotMom,
+        kV0MassK0Short,
+        kV0MassLambda,
+        kV0MassAntiLambda,
+        kV0AlphaV0,
+        kV0PtArmV0,
+        kV0PosEta,
+        kV0NegEta,
+        kV0NSigmaPosProton,
+        kV0NSigmaPosPion,
+        kV0NSigmaNegProton,
+        kV0NSigmaNegPion,
+        kNV0Columns
+    };
+    //Integer columns of the V0 table
+    enum EV0IntColumn {
+        kV0PosIndex = 0,    //ESD track index of the positive daughter
+        kV0NegIndex,        //ESD track index of the negative daughter
+        kV0OnFlyStatus,
+        kV0LikeSign,        //1 for like-sign candidates
+        kV0PdgMC,           //PDG code of the common mother of the daughters, 0 if none
+        kV0PdgMotherMC,     //PDG code of the parent of the V0, 0 if none
+        kV0PrimaryStatusMC, //1 physical primary, 2 weak decay, 3 material, 0 otherwise
+        kNV0IntColumns
+    };
+    //Float columns of the cascade table
+    enum ECascadeColumn {
+        kCascPt = 0,
+        kCascEta,
+        kCascRapXi,
+        kCascRapOmega,
+        kCascRadius,
+        kCascV0Radius,
+        kCascDcaBachToPV,
+        kCascDcaPosToPV,
+        kCascDcaNegToPV,
+        kCascDcaV0Daughters,
+        kCascDcaCascDaughters,
+        kCascDcaV0ToPV,
+        kCascV0CosPA,
+        kCascV0CosPASpecial, //V0 cosine of pointing angle wrt the cascade vertex
+        kCascCosPA,
+        kCascMassLambda,
+        kCascMassXi,
+        kCascMassOmega,
+        kCascNSigmaBachPion,
+        kCascNSigmaBachKaon,
+        kCascNSigmaPosProton,
+        kCascNSigmaPosPion,
+        kCascNSigmaNegProton,
+        kCascNSigmaNegPion,
+        kNCascadeColumns
+    };
+    //Integer columns of the cascade table
+    enum ECascadeIntColumn {
+        kCascCharge = 0,    //charge of the bachelor
+        kCascBachIndex,
+        kCascPosIndex,
+        kCascNegIndex,
+        kCascPdgMC,         //PDG code of the common mother of bachelor and V0, 0 if none
+        kCascPrimaryStatusMC, //1 physical primary, 0 otherwise
+        kNCascadeIntColumns
+    };
+
+    //Simple constructor
+    AliStrangenessCandidateTable();
+
+    //TNamed-inspired constructor
+    AliStrangenessCandidateTable(const char * name, const char * title = "Strangeness candidates");
+
+    //Simple destructor
+    ~AliStrangenessCandidateTable();
+
+    //Invalidate: next GetTable() call rebuilds
+    void Clear(Option_t* = "");
+
+    //Shared table of the event, built if not yet done for this event
+    static AliStrangenessCandidateTable* GetTable( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse, Bool_t lForceRebuild = kFALSE );
+
+    void Build( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse );
+    Bool_t IsBuiltFor( AliESDEvent *lESDevent ) const;
+
+    Long_t GetNV0s()      const { return fNV0s;      }
+    Long_t GetNCascades() const { return fNCascades; }
+    Bool_t HasMC()        const { return fHasMC;     }
+
+    Float_t GetV0     ( Long_t iV0, EV0Column    lCol ) const { return fV0Columns   [lCol][iV0]; }
+    Int_t   GetV0Int  ( Long_t iV0, EV0IntColumn lCol ) const { return fV0IntColumns[lCol][iV0]; }
+    Float_t GetCascade    ( Long_t iXi, ECascadeColumn    lCol ) const { return fCascColumns   [lCol][iXi]; }
+    Int_t   GetCascadeInt ( Long_t iXi, ECascadeIntColumn lCol ) const { return fCascIntColumns[lCol][iXi]; }
+
+    //Column filters: keep the rows of lRows within [lMin, lMax]
+    void SelectAllV0s      ( std::vector<Int_t> &lRows ) const;
+    void SelectAllCascades ( std::vector<Int_t> &lRows ) const;
+    void FilterV0s      ( std::vector<Int_t> &lRows, EV0Column         lCol, Float_t lMin, Float_t lMax ) const;
+    void FilterV0s      ( std::vector<Int_t> &lRows, EV0IntColumn      lCol, Int_t   lMin, Int_t   lMax ) const;
+    void FilterCascades ( std::vector<Int_t> &lRows, ECascadeColumn    lCol, Float_t lMin, Float_t lMax ) const;
+    void FilterCascades ( std::vector<Int_t> &lRows, ECascadeIntColumn lCol, Int_t   lMin, Int_t   lMax ) const;
+
+private:
+    void BuildV0s      ( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse, const Double_t *lPV );
+    void BuildCascades ( AliESDEvent *lESDevent, AliMCEvent *lMCevent, AliPIDResponse *lPIDResponse, const Double_t *lPV );
+
+    //Event key of the current content
+    Int_t    fRunNumber;    //!
+    UInt_t   fPeriod;       //!
+    UInt_t   fOrbit;        //!
+    UShort_t fBunchCross;   //!
+    Int_t    fEventInFile;  //!
+    Bool_t   fBuilt;        //!
+    Bool_t   fHasMC;        //!
+
+    Long_t fNV0s;      //!
+    Long_t fNCascades; //!
+
+    std::vector<Float_t> fV0Columns      [kNV0Columns];         //!
+    std::vector<Int_t>   fV0IntColumns   [kNV0IntColumns];      //!
+    std::vector<Float_t> fCascColumns    [kNCascadeColumns];    //!
+    std::vector<Int_t>   fCascIntColumns [kNCascadeIntColumns]; //!
+
+    AliStrangenessCandidateTable(const AliStrangenessCandidateTable&);            // not implemented
+    AliStrangenessCandidateTable& operator=(const AliStrangenessCandidateTable&); // not implemented
+
+    ClassDef(AliStrangenessCandidateTable, 1)
+    // 1 - original implementation
+};
+#endif
@@ -150,7 +150,7 @@ Int_t AliCascadeVertexerUncheckedCharges::V0sTracks2CascadeVertices(AliESDEvent
             AliESDv0 *pv0=&v0;
             AliExternalTrackParam bt(*btrk), *pbt=&bt;
             
-            Double_t dca=PropagateToDCA(pv0,pbt,b);
+            Double_t dca=PropagateToDCA(pv0,pbt,b,fDCAmax);
             if (dca > fDCAmax) continue;
             
             //eta cut - test
@@ -200,7 +200,7 @@ Double_t AliCascadeVertexerUncheckedCharges::Det(Double_t a00,Double_t a01,Doubl
     return  a00*Det(a11,a12,a21,a22)-a01*Det(a10,a12,a20,a22)+a02*Det(a10,a11,a20,a21);
 }
 
-Double_t AliCascadeVertexerUncheckedCharges::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, Double_t b) {
+Double_t AliCascadeVertexerUncheckedCharges::PropagateToDCA(AliESDv0 *v, AliExternalTrackParam *t, Double_t b, Double_t dcaMax) {
     //--------------------------------------------------------------------
     // This function returns the DCA between the V0 and the track
     //--------------------------------------------------------------------
@@ -225,6 +225,9 @@ Double_t AliCascadeVertexerUncheckedCharges::PropagateToDCA(AliESDv0 *v, AliExte
     
     Double_t dca=TMath::Abs(dd)/TMath::Sqrt(ax*ax + ay*ay + az*az);
     
+    //the (linear) DCA does not depend on the propagation: skip it for rejected candidates
+    if (dca > dcaMax) return dca;
+    
     //points of the DCA
     Double_t t1 = Det(x2-x1,y2-y1,z2-z1,px2,py2,pz2,ax,ay,az)/
     Det(px1,py1,pz1,px2,py2,pz2,ax,ay,az);
@@ -28,7 +28,7 @@ public:
 	       Double_t a10,Double_t a11,Double_t a12,
 	       Double_t a20,Double_t a21,Double_t a22) const;
 
-  Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk,Double_t b);
+  Double_t PropagateToDCA(AliESDv0 *vtx,AliExternalTrackParam *trk,Double_t b,Double_t dcaMax=1.e+33);
     void CheckChargeV0(AliESDv0 *v0);
 
   void GetCuts(Double_t cuts[8]) const;
@@ -27,6 +27,9 @@
 
 #include "AliESDEvent.h"
 #include "AliESDv0.h"
+#include "AliExternalTrackParam.h"
+#include <TArrayC.h>
+#include <TArrayD.h>
 #include "AliLightV0vertexer.h"
 
 ClassImp(AliLightV0vertexer)
@@ -63,6 +66,11 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
     TArrayI neg(nentr);
     TArrayI pos(nentr);
     
+    //Impact parameters and transverse circles of the helices, computed once per track
+    TArrayD negD(nentr), posD(nentr);
+    TArrayD negCircle(3*nentr), posCircle(3*nentr);
+    TArrayC negHasCircle(nentr), posHasCircle(nentr);
+    
     Int_t nneg=0, npos=0, nvtx=0;
     
     Int_t i;
@@ -80,8 +88,15 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
         if (TMath::Abs(d)<fDPmin) continue;
         if (TMath::Abs(d)>fRmax) continue;
         
-        if (esdTrack->GetSign() < 0.) neg[nneg++]=i;
-        else pos[npos++]=i;
+        if (esdTrack->GetSign() < 0.) {
+            negD[nneg]=d;
+            negHasCircle[nneg]=GetHelixCircle(esdTrack,b,&negCircle[3*nneg]);
+            neg[nneg++]=i;
+        } else {
+            posD[npos]=d;
+            posHasCircle[npos]=GetHelixCircle(esdTrack,b,&posCircle[3*npos]);
+            pos[npos++]=i;
+        }
     }
     
     
@@ -96,8 +111,13 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
             //Track pre-selection: clusters
             if (ptrk->GetTPCNcls() < fMinClusters ) continue;
             
-            if (TMath::Abs(ntrk->GetD(xPrimaryVertex,yPrimaryVertex,b))<fDNmin)
-                if (TMath::Abs(ptrk->GetD(xPrimaryVertex,yPrimaryVertex,b))<fDNmin) continue;
+            if (TMath::Abs(negD[i])<fDNmin)
+                if (TMath::Abs(posD[k])<fDNmin) continue;
+            
+            //Pre-filter: the DCA between the helices is at least the distance
+            //between their circles in the transverse plane
+            if (negHasCircle[i] && posHasCircle[k])
+                if (GetCircleDistance(&negCircle[3*i],&posCircle[3*k]) > fDCAmax) continue;
             
             Double_t xn, xp, dca=ntrk->GetDCA(ptrk,b,xn,xp);
             if (dca > fDCAmax) continue;
@@ -173,3 +193,32 @@ Int_t AliLightV0vertexer::Tracks2V0vertices(AliESDEvent *event) {
 
 
 
+
+Bool_t AliLightV0vertexer::GetHelixCircle(const AliExternalTrackParam *t, Double_t b, Double_t circle[3]) {
+    //--------------------------------------------------------------------
+    // Circle (xc, yc, r) of the track helix in the transverse plane
+    // Returns kFALSE for (nearly) straight tracks
+    //--------------------------------------------------------------------
+    Double_t hlx[6]; t->GetHelixParameters(hlx,b);
+    Double_t c=hlx[4];
+    if (TMath::Abs(c) < 1e-9) return kFALSE;
+    Double_t sn=TMath::Sin(hlx[2]), cs=TMath::Cos(hlx[2]);
+    circle[0]=hlx[5] - sn/c; // x0 - sin(phi0)/C
+    circle[1]=hlx[0] + cs/c; // y0 + cos(phi0)/C
+    circle[2]=1./TMath::Abs(c);
+    return kTRUE;
+}
+
+Double_t AliLightV0vertexer::GetCircleDistance(const Double_t circle1[3], const Double_t circle2[3]) {
+    //--------------------------------------------------------------------
+    // Minimal distance between two circles in the transverse plane,
+    // a lower bound of the DCA between the two helices
+    //--------------------------------------------------------------------
+    Double_t dx=circle1[0]-circle2[0], dy=circle1[1]-circle2[1];
+    Double_t d=TMath::Sqrt(dx*dx + dy*dy);
+    Double_t gap=d - circle1[2] - circle2[2];     // separated circles
+    if (gap > 0) return gap;
+    gap=TMath::Abs(circle1[2] - circle2[2]) - d;  // one circle inside the other
+    if (gap > 0) return gap;
+    return 0.;                                    // crossing circles
+}
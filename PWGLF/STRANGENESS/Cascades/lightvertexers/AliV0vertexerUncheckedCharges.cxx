@@ -30,6 +30,9 @@
 
 #include "AliESDEvent.h"
 #include "AliESDv0.h"
+#include "AliExternalTrackParam.h"
+#include <TArrayC.h>
+#include <TArrayD.h>
 #include "AliV0vertexerUncheckedCharges.h"
 
 ClassImp(AliV0vertexerUncheckedCharges)
@@ -65,6 +68,11 @@ Int_t AliV0vertexerUncheckedCharges::Tracks2V0vertices(AliESDEvent *event) {
     
     TArrayI trackarray(nentr);
     
+    //Impact parameters and transverse circles of the helices, computed once per track
+    TArrayD trackD(nentr);
+    TArrayD trackCircle(3*nentr);
+    TArrayC trackHasCircle(nentr);
+    
     Int_t ntracks=0, nvtx=0;
     
     Int_t i;
@@ -83,6 +91,8 @@ Int_t AliV0vertexerUncheckedCharges::Tracks2V0vertices(AliESDEvent *event) {
         if (TMath::Abs(d)>fRmax) continue;
         
         //Disregard charges
+        trackD[ntracks]=d;
+        trackHasCircle[ntracks]=GetHelixCircle(esdTrack,b,&trackCircle[3*ntracks]);
         trackarray[ntracks++]=i;
     }
     
@@ -100,8 +110,13 @@ Int_t AliV0vertexerUncheckedCharges::Tracks2V0vertices(AliESDEvent *event) {
             AliESDtrack *trk2=event->GetTrack(idx2);
             
             
-            if (TMath::Abs(trk1->GetD(xPrimaryVertex,yPrimaryVertex,b))<fDNmin)
-                if (TMath::Abs(trk2->GetD(xPrimaryVertex,yPrimaryVertex,b))<fDNmin) continue;
+            if (TMath::Abs(trackD[i])<fDNmin)
+                if (TMath::Abs(trackD[k])<fDNmin) continue;
+            
+            //Pre-filter: the DCA between the helices is at least the distance
+            //between their circles in the transverse plane
+            if (trackHasCircle[i] && trackHasCircle[k])
+                if (GetCircleDistance(&trackCircle[3*i],&trackCircle[3*k]) > fDCAmax) continue;
             
             Double_t xn, xp, dca=trk1->GetDCA(trk2,b,xn,xp);
             if (dca > fDCAmax) continue;
@@ -177,3 +192,32 @@ Int_t AliV0vertexerUncheckedCharges::Tracks2V0vertices(AliESDEvent *event) {
 
 
 
+
+Bool_t AliV0vertexerUncheckedCharges::GetHelixCircle(const AliExternalTrackParam *t, Double_t b, Double_t circle[3]) {
+    //--------------------------------------------------------------------
+    // Circle (xc, yc, r) of the track helix in the transverse plane
+    // Returns kFALSE for (nearly) straight tracks
+    //--------------------------------------------------------------------
+    Double_t hlx[6]; t->GetHelixParameters(hlx,b);
+    Double_t c=hlx[4];
+    if (TMath::Abs(c) < 1e-9) return kFALSE;
+    Double_t sn=TMath::Sin(hlx[2]), cs=TMath::Cos(hlx[2]);
+    circle[0]=hlx[5] - sn/c; // x0 - sin(phi0)/C
+    circle[1]=hlx[0] + cs/c; // y0 + cos(phi0)/C
+    circle[2]=1./TMath::Abs(c);
+    return kTRUE;
+}
+
+Double_t AliV0vertexerUncheckedCharges::GetCircleDistance(const Double_t circle1[3], const Double_t circle2[3]) {
+    //--------------------------------------------------------------------
+    // Minimal distance between two circles in the transverse plane,
+    // a lower bound of the DCA between the two helices
+    //--------------------------------------------------------------------
+    Double_t dx=circle1[0]-circle2[0], dy=circle1[1]-circle2[1];
+    Double_t d=TMath::Sqrt(dx*dx + dy*dy);
+    Double_t gap=d - circle1[2] - circle2[2];     // separated circles
+    if (gap > 0) return gap;
+    gap=TMath::Abs(circle1[2] - circle2[2]) - d;  // one circle inside the other
+    if (gap > 0) return gap;
+    return 0.;                                    // crossing circles
+}
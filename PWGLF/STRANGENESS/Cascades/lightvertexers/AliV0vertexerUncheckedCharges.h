@@ -13,6 +13,7 @@
 
 class TTree;
 class AliESDEvent;
+class AliExternalTrackParam;
 
 //_____________________________________________________________________________
 class AliV0vertexerUncheckedCharges : public TObject {
@@ -35,6 +36,10 @@ public:
     void SetDoRefit( Bool_t lDoRefit ) { fkDoRefit = lDoRefit; }
     
 private:
+    //Transverse circle of the track helix and minimal distance between two circles
+    static Bool_t   GetHelixCircle(const AliExternalTrackParam *t, Double_t b, Double_t circle[3]);
+    static Double_t GetCircleDistance(const Double_t circle1[3], const Double_t circle2[3]);
+    
     static
     Double_t fgChi2max;      // maximal allowed chi2
     static
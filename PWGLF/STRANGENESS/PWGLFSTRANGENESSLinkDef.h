@@ -48,6 +48,7 @@
 #pragma link C++ class AliV0Result+;
 #pragma link C++ class AliCascadeResult+;
 #pragma link C++ class AliStrangenessModule+;
+#pragma link C++ class AliStrangenessCandidateTable+;
 #pragma link C++ class AliAnalysisTaskWeakDecayVertexer+;
 #pragma link C++ class AliAnalysisTaskStrEffStudy+; 
 #endif
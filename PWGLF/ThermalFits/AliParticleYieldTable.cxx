@@ -0,0 +1,201 @@
+#include "AliParticleYieldTable.h"
+#include "AliParticleYield.h"
+#include "AliLog.h"
+#include "TClonesArray.h"
+#include "TObjString.h"
+#include "TMath.h"
+#include "TMatrixDSym.h"
+#include "TVectorD.h"
+
+ClassImp(AliParticleYieldTable)
+
+AliParticleYieldTable::AliParticleYieldTable() :
+  TObject(),
+  fIndex(),
+  fNEntries(0),
+  fRatios()
+{
+  // ctor
+  fRatios.SetOwner(kTRUE);
+}
+
+AliParticleYieldTable::AliParticleYieldTable(TClonesArray * arr) :
+  TObject(),
+  fIndex(),
+  fNEntries(0),
+  fRatios()
+{
+  // ctor, indexing all the particles in arr. arr is not owned and must outlive the table
+  fRatios.SetOwner(kTRUE);
+  Fill(arr);
+}
+
+AliParticleYieldTable::~AliParticleYieldTable() {
+  // dtor
+  Clear();
+}
+
+Bool_t AliParticleYieldTable::Key_t::operator<(const Key_t & rhs) const {
+  // Lexicographic order on (system, energy, centrality, pdg, pdg2): all the entries of a given centrality class are contiguous
+  if (fSystem   != rhs.fSystem)   return fSystem   < rhs.fSystem;
+  if (fSqrtS    != rhs.fSqrtS)    return fSqrtS    < rhs.fSqrtS;
+  if (fCentr    != rhs.fCentr)    return fCentr    < rhs.fCentr;
+  if (fPdgCode  != rhs.fPdgCode)  return fPdgCode  < rhs.fPdgCode;
+  return fPdgCode2 < rhs.fPdgCode2;
+}
+
+AliParticleYieldTable::Key_t AliParticleYieldTable::MakeKey(Int_t pdg, Int_t system, Float_t sqrts, TString centrality, Int_t pdg2) {
+  // Helper to build an index key
+  Key_t key;
+  key.fSystem   = system;
+  key.fSqrtS    = TMath::Nint(sqrts*1000);
+  key.fCentr    = centrality;
+  key.fPdgCode  = pdg;
+  key.fPdgCode2 = pdg2;
+  return key;
+}
+
+void AliParticleYieldTable::Fill(TClonesArray * arr) {
+  // Adds all the particles in arr to the index
+  if(!arr) return;
+  TIter iter(arr);
+  AliParticleYield * part = 0;
+  while ((part = dynamic_cast<AliParticleYield*>(iter.Next()))) Add(part);
+}
+
+void AliParticleYieldTable::Add(AliParticleYield * part) {
+  // Adds a particle to the index. The particle is not owned
+  if(!part) return;
+  fIndex[MakeKey(part->GetPdgCode(), part->GetCollisionSystem(), part->GetSqrtS(), part->GetCentr(), part->GetPdgCode2())].push_back(part);
+  fNEntries++;
+}
+
+void AliParticleYieldTable::Clear(Option_t * ) {
+  // Empties the index and deletes the ratios computed by BuildRatios
+  fIndex.clear();
+  fNEntries = 0;
+  fRatios.Delete();
+}
+
+AliParticleYield * AliParticleYieldTable::Find(Int_t pdg, Int_t system, Float_t sqrts, TString centrality, Int_t isSum, Int_t status, Int_t pdg2) const {
+  // Finds the particle matching the search criteria, with the same
+  // conventions as AliParticleYield::FindParticle: if status is -1,
+  // the best (lower status value) is returned, and 0 is returned if
+  // 2 matches have the same status. Returns 0 silently if nothing is
+  // found, so that it can be used to probe the table.
+
+  Index_t::const_iterator it = fIndex.find(MakeKey(pdg, system, sqrts, centrality, pdg2));
+  if(it == fIndex.end()) return 0;
+
+  AliParticleYield * foundPart = 0;
+  Bool_t ambiguous = kFALSE;
+  const std::vector<AliParticleYield*> & parts = it->second;
+  for(UInt_t ipart = 0; ipart < parts.size(); ipart++){
+    AliParticleYield * part = parts[ipart];
+    if((status >= 0 && part->GetStatus() != status) || (isSum >= 0 && part->GetIsSum() != isSum)) continue;
+    if(!foundPart || part->GetStatus() < foundPart->GetStatus()) {
+      foundPart = part;
+      ambiguous = kFALSE;
+    }
+    else if(part->GetStatus() == foundPart->GetStatus()) {
+      ambiguous = kTRUE;
+    }
+  }
+  if(ambiguous) {
+    AliWarning(Form("More than one entry with the same status for %d/%d (System %d, sqrts = %2.2f GeV, %s), cannot decide",
+                    pdg, pdg2, system, sqrts, centrality.Data()));
+    return 0;
+  }
+  return foundPart;
+}
+
+Int_t AliParticleYieldTable::GetCentralities(Int_t system, Float_t sqrts, TObjArray & centralities) const {
+  // Adds to centralities (as owned TObjString) all the centrality tags
+  // available for the given system and energy, in alphabetical
+  // order. This is the list of classes a centrality-dependent fit has
+  // to loop over. Returns the number of tags.
+
+  centralities.SetOwner(kTRUE);
+  Key_t key = MakeKey(0, system, sqrts, "", 0);
+  Int_t ncentr = 0;
+  TString last;
+  for(Index_t::const_iterator it = fIndex.lower_bound(key); it != fIndex.end(); ++it) {
+    if(it->first.fSystem != key.fSystem || it->first.fSqrtS != key.fSqrtS) break;
+    if(ncentr && it->first.fCentr == last) continue;
+    last = it->first.fCentr;
+    centralities.Add(new TObjString(last.Data()));
+    ncentr++;
+  }
+  return ncentr;
+}
+
+Int_t AliParticleYieldTable::BuildRatios(Int_t nratios, const Int_t * num, const Int_t * den, Int_t isSum, Option_t * opt) {
+  // Computes the ratios num[i]/den[i] for all the systems, energies
+  // and centralities in the table, and adds them to the index, so
+  // that they can be retrieved with FindRatio. Measured ratios are
+  // never overwritten: a ratio is only computed if it is not already
+  // in the table and both yields are. opt is passed to
+  // AliParticleYield::Divide. Returns the number of computed ratios.
+
+  // List the (system, energy, centrality) classes first, as the index is modified in the loop
+  std::vector<Key_t> classes;
+  for(Index_t::const_iterator it = fIndex.begin(); it != fIndex.end(); ++it) {
+    const Key_t & key = it->first;
+    if(classes.size() && classes.back().fSystem == key.fSystem && classes.back().fSqrtS == key.fSqrtS && classes.back().fCentr == key.fCentr) continue;
+    classes.push_back(key);
+  }
+
+  Int_t nbuilt = 0;
+  for(UInt_t iclass = 0; iclass < classes.size(); iclass++) {
+    const Key_t & key = classes[iclass];
+    Float_t sqrts = key.fSqrtS/1000.;
+    for(Int_t iratio = 0; iratio < nratios; iratio++) {
+      if(FindRatio(num[iratio], den[iratio], key.fSystem, sqrts, key.fCentr, isSum)) continue;
+      AliParticleYield * part1 = Find(num[iratio], key.fSystem, sqrts, key.fCentr, isSum);
+      AliParticleYield * part2 = Find(den[iratio], key.fSystem, sqrts, key.fCentr, isSum);
+      if(!part1 || !part2) continue;
+      AliParticleYield * ratio = AliParticleYield::Divide(part1, part2, 0, opt);
+      fRatios.Add(ratio);
+      Add(ratio);
+      nbuilt++;
+    }
+  }
+  return nbuilt;
+}
+
+Bool_t AliParticleYieldTable::GetCovarianceMatrix(Int_t system, Float_t sqrts, TString centrality, Int_t n, const Int_t * pdg, const Int_t * pdg2,
+                                                  TVectorD & values, TMatrixDSym & cov, Int_t isSum) const {
+  // Fills values and cov with the n yields (pdg2[i] = 0) or ratios
+  // pdg[i]/pdg2[i] of a centrality class. pdg2 can be 0 if there are
+  // no ratios.
+  // Stat and syst errors are uncorrelated. The normalization error
+  // is common to all the entries of a centrality class, and it is
+  // thus taken as fully correlated. Ratios are expected to have a 0
+  // normalization error (see AliParticleYield::Divide).
+  // Returns kFALSE if one of the entries is not in the table.
+
+  values.ResizeTo(n);
+  cov.ResizeTo(n);
+  values.Zero();
+  cov.Zero();
+
+  std::vector<Double_t> norm(n, 0.);
+  Bool_t allFound = kTRUE;
+  for(Int_t ipart = 0; ipart < n; ipart++) {
+    AliParticleYield * part = Find(pdg[ipart], system, sqrts, centrality, isSum, -1, pdg2 ? pdg2[ipart] : 0);
+    if(!part) {
+      AliWarning(Form("Cannot find %d/%d (System %d, sqrts = %2.2f GeV, %s)", pdg[ipart], pdg2 ? pdg2[ipart] : 0, system, sqrts, centrality.Data()));
+      allFound = kFALSE;
+      continue;
+    }
+    values[ipart] = part->GetYield();
+    cov(ipart, ipart) = part->GetStatError()*part->GetStatError() + part->GetSystError()*part->GetSystError();
+    norm[ipart] = part->GetNormError();
+  }
+  for(Int_t ipart = 0; ipart < n; ipart++) {
+    for(Int_t jpart = 0; jpart < n; jpart++) {
+      cov(ipart, jpart) += norm[ipart]*norm[jpart];
+    }
+  }
+  return allFound;
+}
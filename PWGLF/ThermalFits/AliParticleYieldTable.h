@@ -0,0 +1,72 @@
+#ifndef _ALIPARTICLEYIELDTABLE_H_
+#define _ALIPARTICLEYIELDTABLE_H_
+
+// AliParticleYieldTable
+// In-memory index of a set of AliParticleYield, keyed by collision
+// system, energy, centrality tag and PDG code(s), to be used as the
+// input of thermal model fits. Ratios can be precomputed for all the
+// centrality classes at once, and the covariance matrix of a set of
+// yields/ratios is built from their stat, syst and normalization errors.
+// The table does not own the indexed particles, but it owns the ratios
+// it computes.
+
+#include <map>
+#include <vector>
+#include "TObject.h"
+#include "TObjArray.h"
+#include "TString.h"
+#include "TMatrixDSymfwd.h"
+#include "TVectorDfwd.h"
+
+class TClonesArray;
+class AliParticleYield;
+
+class AliParticleYieldTable : public TObject
+{
+public:
+
+  AliParticleYieldTable();
+  AliParticleYieldTable(TClonesArray * arr);
+  virtual ~AliParticleYieldTable();
+
+  void  Fill(TClonesArray * arr);
+  void  Add(AliParticleYield * part);
+  virtual void Clear(Option_t * opt = "");
+  Int_t GetEntries() const { return fNEntries; }
+
+  // Lookup. Centrality is the exact tag (e.g. V0M0005), no substring matching as in AliParticleYield::FindParticle
+  AliParticleYield * Find(Int_t pdg, Int_t system, Float_t sqrts, TString centrality, Int_t isSum = -1, Int_t status = -1, Int_t pdg2 = 0) const;
+  AliParticleYield * FindRatio(Int_t pdg, Int_t pdg2, Int_t system, Float_t sqrts, TString centrality, Int_t isSum = -1, Int_t status = -1) const { return Find(pdg, system, sqrts, centrality, isSum, status, pdg2); }
+  Int_t GetCentralities(Int_t system, Float_t sqrts, TObjArray & centralities) const;
+
+  // Ratios and uncertainties for the fits
+  Int_t  BuildRatios(Int_t nratios, const Int_t * num, const Int_t * den, Int_t isSum = -1, Option_t * opt = "");
+  Bool_t GetCovarianceMatrix(Int_t system, Float_t sqrts, TString centrality, Int_t n, const Int_t * pdg, const Int_t * pdg2,
+                             TVectorD & values, TMatrixDSym & cov, Int_t isSum = -1) const;
+
+private:
+
+  AliParticleYieldTable(const AliParticleYieldTable&);
+  AliParticleYieldTable& operator=(const AliParticleYieldTable&);
+
+  struct Key_t {
+    Int_t   fSystem;   // collision system
+    Int_t   fSqrtS;    // center of mass energy, in MeV (rounded, so that it can be compared exactly)
+    TString fCentr;    // centrality tag
+    Int_t   fPdgCode;  // pdg code
+    Int_t   fPdgCode2; // pdg code of the denominator, 0 if not a ratio
+    Bool_t operator<(const Key_t & rhs) const;
+  };
+  typedef std::map<Key_t, std::vector<AliParticleYield*> > Index_t;
+
+  static Key_t MakeKey(Int_t pdg, Int_t system, Float_t sqrts, TString centrality, Int_t pdg2);
+
+  Index_t   fIndex;    //! particles matching each key
+  Int_t     fNEntries; //! number of indexed particles
+  TObjArray fRatios;   //! ratios computed by BuildRatios (owned)
+
+  ClassDef(AliParticleYieldTable,1)
+};
+
+
+#endif /* _ALIPARTICLEYIELDTABLE_H_ */
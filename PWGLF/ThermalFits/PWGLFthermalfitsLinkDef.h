@@ -1,6 +1,7 @@
 #ifdef __CINT__
 
 #pragma link C++ class AliParticleYield+;
+#pragma link C++ class AliParticleYieldTable+;
 
 
 #endif
@@ -2347,23 +2347,22 @@ Int_t AliAnalysisEmEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	
     Int_t nStackTracks = stack->GetNtrack();
 	
-    // get all emcal clusters
-    TRefArray* caloClusters = new TRefArray();
-    realEvent->GetEMCALClusters( caloClusters );
+    // get all emcal clusters, from the cluster table shared with the other E_T analyses of the event
+    fSelector->SetEvent(realEvent);
+    const AliAnalysisEtSelector::ClusterTable_t &clusterTable = fSelector->GetClusterTable();
 	
-    Int_t nCluster = caloClusters->GetEntries();
+    Int_t nCluster = clusterTable.size();
 	
-    Float_t pos[3] = {0};
     TVector3 caloPos(0,0,0);
     TVector3 trackPos(0,0,0);
 	
     // loop the clusters
     for (int iCluster = 0; iCluster < nCluster; iCluster++ ) 
     {
-        AliESDCaloCluster* caloCluster = ( AliESDCaloCluster* )caloClusters->At( iCluster );
-        Float_t caloE = caloCluster->E();
-        caloCluster->GetPosition(pos);		
-        caloPos.SetXYZ(pos[0],pos[1],pos[2]);
+        const AliAnalysisEtSelector::ClusterEntry_t &clusterEntry = clusterTable[iCluster];
+        AliESDCaloCluster* caloCluster = clusterEntry.fCluster;
+        Float_t caloE = clusterEntry.fE;
+        caloPos.SetXYZ(clusterEntry.fPos[0],clusterEntry.fPos[1],clusterEntry.fPos[2]);
 		
         UInt_t iPart = (UInt_t)TMath::Abs(caloCluster->GetLabel());
         TParticle *part  = stack->Particle(iPart);
@@ -3055,7 +3054,6 @@ Int_t AliAnalysisEmEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
     fHistTotalRectotETDep->Fill(fTotalRectotETDep);
 	
     //delete fGeoUt;
-    delete caloClusters;//Marcelo - Christine - make as object & don't create new one each event
 	
     return 0;    
 }	
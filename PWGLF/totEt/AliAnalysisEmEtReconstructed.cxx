@@ -9,6 +9,7 @@
 
 #include "AliAnalysisEmEtReconstructed.h"
 #include "AliAnalysisEtCuts.h"
+#include "AliAnalysisEtSelectorEmcal.h"
 #include "AliESDtrack.h"
 #include "AliStack.h"
 #include "AliVEvent.h"
@@ -192,13 +193,12 @@ Int_t AliAnalysisEmEtReconstructed::AnalyseEvent(AliVEvent* ev)
 	
   ResetEventValues();
 	
-  // get all emcal clusters
-  TRefArray* caloClusters = new TRefArray();
-  fESD->GetEMCALClusters( caloClusters );
+  // get all emcal clusters, from the cluster table shared with the other E_T analyses of the event
+  fSelector->SetEvent(fESD);
+  const AliAnalysisEtSelector::ClusterTable_t &clusterTable = fSelector->GetClusterTable();
 	
-  Int_t nCluster = caloClusters->GetEntries();
+  Int_t nCluster = clusterTable.size();
 	
-  Float_t pos[3] = {0};
   TVector3 caloPos(0,0,0);
   TVector3 trackPos(0,0,0);
 //   Double_t res=0, delta_eta=0, delta_phi=0, maxPid=-99;
@@ -211,10 +211,10 @@ Int_t AliAnalysisEmEtReconstructed::AnalyseEvent(AliVEvent* ev)
   for (int iCluster = 0; iCluster < nCluster; iCluster++ ) 
     {		
       // Retrieve calo cluster information
-      AliESDCaloCluster* caloCluster = ( AliESDCaloCluster* )caloClusters->At( iCluster );
-      Float_t caloE = caloCluster->E();
-      caloCluster->GetPosition(pos);		
-      caloPos.SetXYZ(pos[0],pos[1],pos[2]);
+      const AliAnalysisEtSelector::ClusterEntry_t &clusterEntry = clusterTable[iCluster];
+      AliESDCaloCluster* caloCluster = clusterEntry.fCluster;
+      Float_t caloE = clusterEntry.fE;
+      caloPos.SetXYZ(clusterEntry.fPos[0],clusterEntry.fPos[1],clusterEntry.fPos[2]);
 		
       // look for track that matches calo cluster  
       //track = FindMatch(caloCluster, res); // Marcelo's matching	
@@ -224,8 +224,8 @@ Int_t AliAnalysisEmEtReconstructed::AnalyseEvent(AliVEvent* ev)
 //       delta_eta = caloCluster->GetTrackDz(); 
 //       delta_phi = caloCluster->GetTrackDx(); 
 
-      if (caloCluster->GetTrackMatchedIndex() > 0) // tender's matching
-          track = fESD->GetTrack(caloCluster->GetTrackMatchedIndex());
+      if (clusterEntry.fTrackMatchedIndex > 0) // tender's matching
+          track = fESD->GetTrack(clusterEntry.fTrackMatchedIndex);
         
       //if (track)
       //   if ( !fEsdtrackCutsITSTPC->IsSelected(track) )
@@ -379,14 +379,14 @@ Int_t AliAnalysisEmEtReconstructed::AnalyseEvent(AliVEvent* ev)
 	
   fHistTotalRectotETDep->Fill(fTotalRectotETDep);
 	
-  delete caloClusters;
-	
   return 0;    
 }
 
 void AliAnalysisEmEtReconstructed::Init()
 { // init
   AliAnalysisEt::Init();
+  // the EMCAL selector provides the cluster table
+  if(!fSelector) fSelector = new AliAnalysisEtSelectorEmcal(fCuts);
 }
 
 
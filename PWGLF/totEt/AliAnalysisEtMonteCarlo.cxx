@@ -875,9 +875,10 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
     //cout<<"fcuts max phi "<<fCuts->GetGeometryEmcalPhiAccMaxCut()<<endl;
     //Note that this only returns clusters for the selected detector.  fSelector actually calls the right GetClusters... for the detector
     //It does not apply any cuts on these clusters
-    TRefArray *caloClusters = fSelector->GetClusters();
+    //The table carries the selection bits, track matching and MC labels, evaluated once per event and shared with the reconstructed analysis
+    const AliAnalysisEtSelector::ClusterTable_t &clusterTable = fSelector->GetClusterTable(stack);
 
-    Int_t nCluster = caloClusters->GetEntries();
+    Int_t nCluster = clusterTable.size();
     fClusterMult = nCluster;
 
     //cout<<endl<<"new event reconstructed nclusters "<<nCluster<<endl;
@@ -945,12 +946,13 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
     for (int iCluster = 0; iCluster < nCluster; iCluster++ )
     {
         Int_t cf = 0;
-        AliESDCaloCluster* caloCluster = ( AliESDCaloCluster* )caloClusters->At( iCluster );
+        const AliAnalysisEtSelector::ClusterEntry_t &clusterEntry = clusterTable[iCluster];
+        AliESDCaloCluster* caloCluster = clusterEntry.fCluster;
         //Float_t caloE = caloCluster->E()
-        if (!fSelector->CutGeometricalAcceptance(*caloCluster)) continue;
+        if (!clusterEntry.Passes(AliAnalysisEtSelector::kGeometricalAcceptance)) continue;
         fNClusters++;
         //const UInt_t iPart = (UInt_t)TMath::Abs(fSelector->GetLabel(caloCluster));//->GetLabel());
-	const UInt_t iPart = fSelector->GetLabel(caloCluster,stack);
+	const UInt_t iPart = clusterEntry.fLabel;
 	//if(checkLabelForHIJING) cerr<<"I am checking the label"<<endl;
 	//Some productions have signals added in.  This switch allows the explicit exclusion of these added in signals when running over the data.
 	if(checkLabelForHIJING && !IsHIJINGLabel(iPart,mcEvent,stack) ) continue;
@@ -1002,16 +1004,14 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	Float_t matchedTrackp = 0.0;
 	Float_t matchedTrackpt = 0.0;
         fDepositedCode = part->GetPdgCode();
-	fReconstructedE = caloCluster->E();
-        Float_t pos[3];
+	fReconstructedE = clusterEntry.fE;
 	//PrintFamilyTree(
-        caloCluster->GetPosition(pos);
-        TVector3 cp(pos);
-	fReconstructedEt = caloCluster->E()*TMath::Sin(cp.Theta());
-	nottrackmatched = fSelector->PassTrackMatchingCut(*caloCluster);
+        TVector3 cp(clusterEntry.fPos);
+	fReconstructedEt = clusterEntry.fE*TMath::Sin(clusterEntry.fTheta);
+	nottrackmatched = clusterEntry.Passes(AliAnalysisEtSelector::kNoTrackMatch);
 	//by default ALL matched tracks are accepted, whether or not the match is good.  So we check to see if the track is good.
 	if(!nottrackmatched){//if the track is trackmatched
-	  Int_t trackMatchedIndex = caloCluster->GetTrackMatchedIndex();
+	  Int_t trackMatchedIndex = clusterEntry.fTrackMatchedIndex;
 	  if(trackMatchedIndex < 0) nottrackmatched=kTRUE;
 	  AliESDtrack *track = realEvent->GetTrack(trackMatchedIndex);
 	  // cout<<"track code "<<fTrackDepositedCode<<" cluster code "<<fDepositedCode<<" track label "<<trackLabel<<" cluster label "<<iPart<<endl;
@@ -1128,7 +1128,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 // 		}
 // 	      }
 	    }
- 	  if(fSelector->PassDistanceToBadChannelCut(*caloCluster))//&&fSelector->CutGeometricalAcceptance(*(stack->Particle(primIdx))))
+ 	  if(clusterEntry.Passes(AliAnalysisEtSelector::kDistanceToBadChannel))//&&fSelector->CutGeometricalAcceptance(*(stack->Particle(primIdx))))
 	  {
 	    //if this contained a gamma...
 	    if(pIdx>0){
@@ -1153,7 +1153,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	  }
 	}
 	fCutFlow->Fill(cf++);
-        if(!fSelector->PassDistanceToBadChannelCut(*caloCluster)) continue;
+        if(!clusterEntry.Passes(AliAnalysisEtSelector::kDistanceToBadChannel)) continue;
         Double_t clEt = CorrectForReconstructionEfficiency(*caloCluster,fReconstructedE,fCentClass);
 //	if(code == fgK0SCode) std::cout << "K0 energy: " << caloCluster->E() << std::endl;
 	//if(!fSelector->PassMinEnergyCut(*caloCluster)) continue;
@@ -1253,7 +1253,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 		  fHistMatchedTracksEvspTBkgdvsCentEffCorr->Fill(matchedTrackp,clEt, fCentClass);//Fill with the efficiency corrected energy
 	      }
 	      //Int_t trackindex = (caloCluster->GetLabelsArray())->At(1);
-	      UInt_t trackindex = fSelector->GetLabel(caloCluster,stack);//(caloCluster->GetLabelsArray())->At(1);
+	      UInt_t trackindex = clusterEntry.fLabel;//(caloCluster->GetLabelsArray())->At(1);
 	      if(((UInt_t)caloCluster->GetLabel())!=trackindex){
 		//if(fSelector->GetLabel(caloCluster,stack) !=trackindex){
 		fHistBadTrackMatches->Fill(part->Pt(),fReconstructedE);
@@ -1377,7 +1377,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 		  continue;
 		}
 		else{
-		  if((Int_t)fSelector->GetLabel(caloCluster,stack)==track->GetLabel()){//then we found the track from the particle that created this
+		  if(clusterEntry.fLabel==track->GetLabel()){//then we found the track from the particle that created this
 		    fHistHadronDepositsAllvsECent->Fill(fReconstructedE, fCentClass);
 		  }
 		}
@@ -1407,7 +1407,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	    else{//removed and should have been
 	      //if(countasmatched) cout<<" I was counted as matched even though some of my energy might have been saved."<<endl;
 	      //cout<<" t.m. primary"<<endl;
-	      Int_t trackindex =  fSelector->GetLabel(caloCluster,stack);// (caloCluster->GetLabelsArray())->At(0);
+	      Int_t trackindex =  clusterEntry.fLabel;// (caloCluster->GetLabelsArray())->At(0);
 	      fHistChargedTrackDepositsAcceptedVsPt->Fill(part->Pt(), fCentClass,fReconstructedEt);
 	      fHistChargedTrackDepositsAcceptedVsPtEffCorr->Fill(part->Pt(), fCentClass,clEt);
 	      fHistHadronDepositsReco->Fill(part->Pt());
@@ -1422,13 +1422,13 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 		  continue;
 		}
 		else{
-		  if((Int_t) fSelector->GetLabel(caloCluster,stack)==track->GetLabel()){//then we found the track from the particle that created this
+		  if(clusterEntry.fLabel==track->GetLabel()){//then we found the track from the particle that created this
 		    fHistHadronDepositsAllvsECent->Fill(fReconstructedE, fCentClass);
 		  }
 		}
 	      }
 	      if(fReconstructedEt>0.5) fHistHadronDepositsAllCent500MeV->Fill(part->Pt(), fCentClass);
-	      if((Int_t)fSelector->GetLabel(caloCluster,stack)!= trackindex){
+	      if(clusterEntry.fLabel!= trackindex){
 		fHistBadTrackMatches->Fill(part->Pt(),fReconstructedE);
 		fHistBadTrackMatchesdPhidEta->Fill(caloCluster->GetTrackDx(),caloCluster->GetTrackDz());
 		//cout<<"Track matched, label cluster "<<caloCluster->GetLabel()<<" track "<<trackindex<<endl;
@@ -1540,7 +1540,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	      }
 	    }
 	    else{//removed but shouldn't have been
-	      Int_t trackindex = fSelector->GetLabel(caloCluster,stack);// (caloCluster->GetLabelsArray())->At(1);
+	      Int_t trackindex = clusterEntry.fLabel;// (caloCluster->GetLabelsArray())->At(1);
 	      if(caloCluster->GetLabel()!=trackindex){
 		fHistBadTrackMatches->Fill(part->Pt(),fReconstructedE);
 		fHistBadTrackMatchesdPhidEta->Fill(caloCluster->GetTrackDx(),caloCluster->GetTrackDz());
@@ -1799,9 +1799,10 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	  Float_t totalGammaEts[11] = {0.0,0.0,0.0,0.0,0.0, 0.0,0.0,0.0,0.0,0.0,  0.0};
 	  Float_t totalClusterEts[11] = {0.0,0.0,0.0,0.0,0.0, 0.0,0.0,0.0,0.0,0.0,  0.0};
 	  for (int iCluster = 0; iCluster < nCluster; iCluster++ ){//if this cluster is from any of the decay daughters of any kaon...  but there is no easy way to look at this so we loop over clusters...
-	    AliESDCaloCluster* caloCluster = ( AliESDCaloCluster* )caloClusters->At( iCluster );
-	    if (!fSelector->CutGeometricalAcceptance(*caloCluster)) continue;
-	    const Int_t myPart = fSelector->GetLabel(caloCluster,stack);
+	    const AliAnalysisEtSelector::ClusterEntry_t &clusterEntry = clusterTable[iCluster];
+	    AliESDCaloCluster* caloCluster = clusterEntry.fCluster;
+	    if (!clusterEntry.Passes(AliAnalysisEtSelector::kGeometricalAcceptance)) continue;
+	    const Int_t myPart = clusterEntry.fLabel;
 	    //const Int_t myPart = TMath::Abs(caloCluster->GetLabel());
 	    //identify the primary particle which created this cluster
 	    int primIdx = myPart;
@@ -1819,10 +1820,7 @@ Int_t AliAnalysisEtMonteCarlo::AnalyseEvent(AliVEvent* ev,AliVEvent* ev2)
 	    }
 	    if(primIdx==iPart && primIdx>0 && !hitsAsChargedKaon){//This cluster is from our primary particle and our primary particle is a kaon
 	      //cout<<"I have a particle match! prim code"<<code<<" id "<<primIdx <<endl;
-	      Float_t pos[3];
-	      caloCluster->GetPosition(pos);
-	      TVector3 cp(pos);
-	      Double_t clEt = caloCluster->E()*TMath::Sin(cp.Theta());
+	      Double_t clEt = clusterEntry.fE*TMath::Sin(clusterEntry.fTheta);
 	      Double_t clEtCorr = CorrectForReconstructionEfficiency(*caloCluster,fCentClass);
 	      for(int l=0;l<nEtCuts;l++){//loop over cut values
 		if(clEt>=etCuts[l]){
@@ -291,20 +291,17 @@ Int_t AliAnalysisEtReconstructed::AnalyseEvent(AliVEvent* ev)
 
     Int_t nUsedClusters = 0;
 
-    TRefArray *caloClusters = fSelector->GetClusters();
-    Int_t nCluster = caloClusters->GetEntries();
+    //clusters of the detector with the selection and track matching done once per event, shared with the MC analysis
+    const AliAnalysisEtSelector::ClusterTable_t &clusterTable = fSelector->GetClusterTable();
+    Int_t nCluster = clusterTable.size();
     fClusterMultiplicity = nCluster;
     //if we are making the QA tree and the cluster multiplicity (for PHOS) is less than expected, fill the QA tree so we know what event it was
     if(fMakeQATree && fClusterMultiplicity < 5e-3*fTrackMultiplicity-1.5) fQATree->Fill();
 
     for (int iCluster = 0; iCluster < nCluster; iCluster++ )
     {
-        AliESDCaloCluster* cluster = ( AliESDCaloCluster* )caloClusters->At( iCluster );
-        if (!cluster)
-        {
-            AliError(Form("ERROR: Could not get cluster %d", iCluster));
-            continue;
-        }
+        const AliAnalysisEtSelector::ClusterEntry_t &clusterEntry = clusterTable[iCluster];
+        AliESDCaloCluster* cluster = clusterEntry.fCluster;
 // 	if(!fSelector->CutGeometricalAcceptance(*cluster)){
 // 	  Float_t pos[3];
 // 	  cluster->GetPosition(pos);
@@ -315,20 +312,17 @@ Int_t AliAnalysisEtReconstructed::AnalyseEvent(AliVEvent* ev)
 	fCutFlow->Fill(x++);//fills 0
 	if(cluster->IsEMCAL()) nEmcalClusters++;
 	else nPhosClusters++;
-	if(!fSelector->IsDetectorCluster(*cluster)) continue;
+	if(!clusterEntry.Passes(AliAnalysisEtSelector::kDetectorCluster)) continue;
 	fCutFlow->Fill(x++);//fills 1
-	if(!fSelector->PassMinEnergyCut(*cluster)) continue;
+	if(!clusterEntry.Passes(AliAnalysisEtSelector::kMinEnergy)) continue;
 	fCutFlow->Fill(x++);//fills 2
-        if (!fSelector->PassDistanceToBadChannelCut(*cluster)) continue;
+        if (!clusterEntry.Passes(AliAnalysisEtSelector::kDistanceToBadChannel)) continue;
 	fCutFlow->Fill(x++);//fills 3
-        if (!fSelector->CutGeometricalAcceptance(*cluster)) continue;
+        if (!clusterEntry.Passes(AliAnalysisEtSelector::kGeometricalAcceptance)) continue;
 	//fCutFlow->Fill(x++);
-        Float_t pos[3];
-
-        cluster->GetPosition(pos);
-        TVector3 cp(pos);
+        TVector3 cp(clusterEntry.fPos);
 	fClusterPositionAll->Fill(cp.Phi(), cp.PseudoRapidity());
-	Float_t fReconstructedE = cluster->E();
+	Float_t fReconstructedE = clusterEntry.fE;
 	Float_t lostEnergy = 0.0;
 	Float_t lostTrackPt = 0.0;
 	fClusterPositionAllEnergy->Fill(cp.Phi(), cp.PseudoRapidity(),GetCorrectionModification(*cluster,0,0,cent)*fReconstructedE);
@@ -342,8 +336,8 @@ Int_t AliAnalysisEtReconstructed::AnalyseEvent(AliVEvent* ev)
 	Bool_t countasmatched = kFALSE;
 	Bool_t correctedcluster = kFALSE;
 
-	Int_t trackMatchedIndex = cluster->GetTrackMatchedIndex();//find the index of the matched track
-	matched = !(fSelector->PassTrackMatchingCut(*cluster));//PassTrackMatchingCut is false if there is a matched track
+	Int_t trackMatchedIndex = clusterEntry.fTrackMatchedIndex;//find the index of the matched track
+	matched = !clusterEntry.Passes(AliAnalysisEtSelector::kNoTrackMatch);//PassTrackMatchingCut is false if there is a matched track
 	if(matched){//if the track match is good (, is the track good?
 	  if(trackMatchedIndex < 0) matched=kFALSE;//If the index is bad, don't count it
 	  if(matched){
@@ -378,7 +372,7 @@ Int_t AliAnalysisEtReconstructed::AnalyseEvent(AliVEvent* ev)
         if (matched)
         {
 	  
-            if (cluster->GetNTracksMatched() > 0 && trackMatchedIndex>=0)
+            if (clusterEntry.fNTracksMatched > 0 && trackMatchedIndex>=0)
             {
                 AliVTrack *track = event->GetTrack(trackMatchedIndex);
                 if (!track) {
@@ -422,8 +416,7 @@ Int_t AliAnalysisEtReconstructed::AnalyseEvent(AliVEvent* ev)
 		    nChargedHadronsEtMeasured500MeV+= TMath::Sin(cp.Theta())*GetCorrectionModification(*cluster,0,0,cent)*fReconstructedE;
 		    nChargedHadronsEtTotal500MeV+= 1/eff *TMath::Sin(cp.Theta())*GetCorrectionModification(*cluster,0,0,cent)*fReconstructedE;
 		  }
-		  cluster->GetPosition(pos);	  
-		  TVector3 p2(pos);
+		  TVector3 p2(clusterEntry.fPos);
 		  uncorrEt += TMath::Sin(p2.Theta())*GetCorrectionModification(*cluster,0,0,cent)*fReconstructedE;
 		  if(correctedcluster || fReconstructedE <fsubmeanhade* track->P() ){//if more energy was deposited than the momentum of the track  and more than one particle led to the cluster and the corrected energy is greater than zero
 		    fHistMatchedTracksEvspTvsCent->Fill(track->P(),TMath::Sin(cp.Theta())*GetCorrectionModification(*cluster,0,0,cent)*fReconstructedE,cent);
@@ -515,9 +508,7 @@ Int_t AliAnalysisEtReconstructed::AnalyseEvent(AliVEvent* ev)
 	  
 	  //if (fReconstructedE >  fSingleCellEnergyCut && cluster->GetNCells() == fCuts->GetCommonSingleCell()) continue;
 	  //if (fReconstructedE < fClusterEnergyCut) continue;
-	  cluster->GetPosition(pos);
-	  
-	  TVector3 p2(pos);
+	  TVector3 p2(clusterEntry.fPos);
 	  if(countasmatched){//These are tracks where we partially subtracted the energy but we subtracted some energy
 	    float eff = fTmCorrections->TrackMatchingEfficiency(lostTrackPt,cent);
 	    if(TMath::Abs(eff)<1e-5) eff = 1.0;
@@ -13,10 +13,38 @@
 #include "TParticle.h"
 #include "TParticlePDG.h"
 #include "AliAnalysisEtCommon.h"
+#include "AliAnalysisManager.h"
+#include "TRefArray.h"
+#include "TVector3.h"
+#include <algorithm>
 #include <iostream>
+#include <list>
 
 ClassImp(AliAnalysisEtSelector);
 
+namespace {
+  // Cluster table of the current event, one per detector (selector class) and set of cluster cuts.
+  // The reconstructed and Monte Carlo analyses of a task run back-to-back on the same event:
+  // the first selector asking for it fills the table, the others reuse it.
+  struct ClusterTableRecord_t {
+    Long64_t fEntry;
+    const AliVEvent *fEvent;
+    const TClass *fDetector;
+    Double_t fCutValues[AliAnalysisEtSelector::fgkNClusterCutValues];
+    Bool_t fHasLabels;
+    AliAnalysisEtSelector::ClusterTable_t fTable;
+  };
+
+  std::list<ClusterTableRecord_t> gClusterTables;
+
+  // current entry of the analysis manager, -1 (no sharing) outside of a train
+  Long64_t CurrentEntry()
+  {
+    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+    return mgr ? mgr->GetCurrentEntry() : -1;
+  }
+}
+
 AliAnalysisEtSelector::AliAnalysisEtSelector(AliAnalysisEtCuts *cuts) : AliAnalysisEtCommon()
 ,fEvent(0)
 ,fClusterArray(0)
@@ -179,3 +207,92 @@ Bool_t AliAnalysisEtSelector::PassMinEnergyCut(Double_t e) const
   return e > fCuts->GetReconstructedEmcalClusterEnergyCut();
 }
 
+
+void AliAnalysisEtSelector::GetClusterCutValues(Double_t *values) const
+{ // cut values used by the cluster selection of either detector
+  values[0] = fCuts->GetReconstructedPhosClusterEnergyCut();
+  values[1] = fCuts->GetReconstructedEmcalClusterEnergyCut();
+  values[2] = fCuts->GetPhosBadDistanceCut();
+  values[3] = fCuts->GetPhosTrackRCut();
+  values[4] = fCuts->GetGeometryPhosEtaAccCut();
+  values[5] = fCuts->GetGeometryPhosPhiAccMinCut();
+  values[6] = fCuts->GetGeometryPhosPhiAccMaxCut();
+  values[7] = fCuts->GetGeometryEmcalEtaAccCut();
+  values[8] = fCuts->GetGeometryEmcalPhiAccMinCut();
+  values[9] = fCuts->GetGeometryEmcalPhiAccMaxCut();
+}
+
+void AliAnalysisEtSelector::FillClusterTable(ClusterTable_t &table)
+{ // one selection and track matching pass over the clusters of the detector
+  table.clear();
+  TRefArray *clusters = GetClusters();
+  if(!clusters) return;
+  Int_t nCluster = clusters->GetEntries();
+  table.reserve(nCluster);
+  for(Int_t iCluster = 0; iCluster < nCluster; iCluster++)
+  {
+    AliESDCaloCluster *cluster = static_cast<AliESDCaloCluster*>(clusters->At(iCluster));
+    if(!cluster) continue;
+    ClusterEntry_t entry;
+    entry.fCluster = cluster;
+    entry.fE = cluster->E();
+    cluster->GetPosition(entry.fPos);
+    TVector3 cp(entry.fPos);
+    entry.fTheta = cp.Theta();
+    entry.fEta = cp.Eta();
+    entry.fPhi = cp.Phi();
+    entry.fNTracksMatched = cluster->GetNTracksMatched();
+    entry.fTrackMatchedIndex = cluster->GetTrackMatchedIndex();
+    entry.fSelection = 0;
+    if(IsDetectorCluster(*cluster)) entry.fSelection |= kDetectorCluster;
+    if(PassMinEnergyCut(*cluster)) entry.fSelection |= kMinEnergy;
+    if(PassDistanceToBadChannelCut(*cluster)) entry.fSelection |= kDistanceToBadChannel;
+    if(CutGeometricalAcceptance(*cluster)) entry.fSelection |= kGeometricalAcceptance;
+    if(PassTrackMatchingCut(*cluster)) entry.fSelection |= kNoTrackMatch;
+    entry.fLabel = -1;
+    table.push_back(entry);
+  }
+}
+
+const AliAnalysisEtSelector::ClusterTable_t& AliAnalysisEtSelector::GetClusterTable(AliStack *stack)
+{ // cluster table of the current event, shared with the other selectors of the same detector and cuts
+  Long64_t entry = CurrentEntry();
+  Double_t cutValues[fgkNClusterCutValues];
+  GetClusterCutValues(cutValues);
+
+  ClusterTableRecord_t *record = 0;
+  for(std::list<ClusterTableRecord_t>::iterator it = gClusterTables.begin(); it != gClusterTables.end(); ++it)
+  {
+    if(it->fDetector != IsA()) continue;
+    if(!std::equal(cutValues, cutValues + fgkNClusterCutValues, it->fCutValues)) continue;
+    record = &(*it);
+    break;
+  }
+  if(!record)
+  {
+    gClusterTables.push_back(ClusterTableRecord_t());
+    record = &gClusterTables.back();
+    record->fEntry = -1;
+    record->fEvent = 0;
+    record->fDetector = IsA();
+    std::copy(cutValues, cutValues + fgkNClusterCutValues, record->fCutValues);
+    record->fHasLabels = kFALSE;
+  }
+
+  if(entry < 0 || entry != record->fEntry || fEvent != record->fEvent)
+  {
+    FillClusterTable(record->fTable);
+    record->fEntry = entry;
+    record->fEvent = fEvent;
+    record->fHasLabels = kFALSE;
+  }
+  if(stack && !record->fHasLabels)
+  {
+    for(UInt_t i = 0; i < record->fTable.size(); i++)
+    {
+      record->fTable[i].fLabel = GetLabel(record->fTable[i].fCluster, stack);
+    }
+    record->fHasLabels = kTRUE;
+  }
+  return record->fTable;
+}
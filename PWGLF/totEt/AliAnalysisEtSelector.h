@@ -8,6 +8,7 @@
 //*-- Authors: Oystein Djuvsland (Bergen)
 //_________________________________________________________________________
 #include <Rtypes.h>
+#include <vector>
 #include "AliAnalysisEtCommon.h"
 #include "AliESDEvent.h"
 
@@ -23,6 +24,36 @@ class AliAnalysisEtSelector : public AliAnalysisEtCommon
 {
 
 public:
+
+    // Selection bits of the entries of the cluster table
+    enum EClusterSelection
+    {
+      kDetectorCluster = BIT(0),        // IsDetectorCluster
+      kMinEnergy = BIT(1),              // PassMinEnergyCut
+      kDistanceToBadChannel = BIT(2),   // PassDistanceToBadChannelCut
+      kGeometricalAcceptance = BIT(3),  // CutGeometricalAcceptance
+      kNoTrackMatch = BIT(4)            // PassTrackMatchingCut (no matched track)
+    };
+
+    // One cluster of the detector with its selection, evaluated once per event
+    struct ClusterEntry_t
+    {
+      AliESDCaloCluster *fCluster; // the cluster (owned by the event)
+      Float_t fE;                  // energy
+      Float_t fPos[3];             // global position
+      Float_t fTheta;              // polar angle of the position
+      Float_t fEta;                // pseudorapidity of the position
+      Float_t fPhi;                // azimuth of the position
+      Int_t fNTracksMatched;       // number of matched tracks
+      Int_t fTrackMatchedIndex;    // index of the best matched track, -1 if none
+      UInt_t fSelection;           // EClusterSelection bits passed
+      Int_t fLabel;                // MC label from GetLabel, -1 if there is no stack
+
+      Bool_t Passes(UInt_t mask) const { return (fSelection & mask) == mask; }
+    };
+    typedef std::vector<ClusterEntry_t> ClusterTable_t;
+
+    static const Int_t fgkNClusterCutValues = 10; // number of values of GetClusterCutValues
   
     // Constructor takes cuts object
     AliAnalysisEtSelector(AliAnalysisEtCuts *cuts);
@@ -93,6 +124,9 @@ public:
 
     // Get correct cluster label - PHOS needs different method
     virtual UInt_t GetLabel(const AliESDCaloCluster *cluster, AliStack *stack){if(!stack){return 0;}else{return TMath::Abs(cluster->GetLabel());}}
+
+    // Clusters of the current event (see GetClusters) with the selection bits, the track matching and, given a stack, the MC label
+    const ClusterTable_t& GetClusterTable(AliStack *stack = 0);
     
     AliAnalysisEtCuts * GetCuts() const { return fCuts; }
 protected:
@@ -104,6 +138,10 @@ protected:
     AliAnalysisEtCuts *fCuts; //! Pointer to the cuts object; DS: also in base class?
     
     Bool_t SuspiciousDecayInChain(const UInt_t suspectMotherPdg, const UInt_t suspectDaughterPdg, const TParticle& part, AliStack& stack) const;
+
+    // Cut values the cluster selection depends on, which selectors must share to share a cluster table
+    void GetClusterCutValues(Double_t *values) const;
+    void FillClusterTable(ClusterTable_t &table);
     
     Int_t fRunNumber;
 
@@ -32,6 +32,10 @@
    3.) "Laser"      - dump laser tracks with space points if exists
    4.) "CosmicTree" - cosmic track candidate (random or triggered) + esdTracks(up/down)+ optional points
    5.) "dEdx"       - tree with high dEdx tpc tracks
+   Columnar output (SetColumnarOutput or AliAnalysisTaskFilteredTree_fColumnarOutput=1):
+   "highPtFlat", "V0sFlat" and "dEdxFlat" replace 1.), 2.) and 5.) - flat track parameters, covariance
+   and PID columns (no object copies, no friends, no MC), floats rounded with the precision set per 
+   variable class (SetColumnPrecision)
 */
 
 #include "iostream"
@@ -134,9 +138,22 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fColumnarOutput(kFALSE)
+  , fHighPtFlatTree(0)
+  , fV0FlatTree(0)
+  , fdEdxFlatTree(0)
+  , fFlatEvent()
+  , fFlatV0()
 {
   // Constructor
 
+  // default precision of the columnar output (mantissa bits, 23 - full float)
+  fColumnPrecision[kPrecParam] = 18;
+  fColumnPrecision[kPrecQPt]   = 18;
+  fColumnPrecision[kPrecCov]   = 10;
+  fColumnPrecision[kPrecPID]   = 12;
+  fColumnPrecision[kPrecOther] = 14;
+
   // Define input and output slots here
   DefineOutput(1, TTree::Class());
   DefineOutput(2, TTree::Class());
@@ -207,6 +224,38 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
   fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
 
+  //
+  // Columnar output: flat trees owned by the redirector, branches booked here
+  // and filled directly (no object streaming)
+  // AliAnalysisTaskFilteredTree_fColumnarOutput environment variable can be used to switch it on 
+  TString env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fColumnarOutput");
+  if (!env.IsNull()){
+    fColumnarOutput=(env.Atoi()!=0);
+    AliInfo(Form("fColumnarOutput=%d",fColumnarOutput));
+  }
+  if (fColumnarOutput) {
+    fHighPtFlatTree = ((*fTreeSRedirector)<<"highPtFlat").GetTree();
+    BookFlatEvent(fHighPtFlatTree);
+    BookFlatTrack(fHighPtFlatTree,"esdTrack",fFlatTrack[0]);
+    //
+    fV0FlatTree = ((*fTreeSRedirector)<<"V0sFlat").GetTree();
+    BookFlatEvent(fV0FlatTree);
+    fV0FlatTree->Branch("v0.type",&fFlatV0.fType,"type/I");
+    fV0FlatTree->Branch("v0.onFly",&fFlatV0.fOnFly,"onFly/I");
+    fV0FlatTree->Branch("v0.xyz",fFlatV0.fXYZ,"xyz[3]/F");
+    fV0FlatTree->Branch("v0.p",fFlatV0.fP,"p[3]/F");
+    fV0FlatTree->Branch("v0.dcaDaughters",&fFlatV0.fDcaDaughters,"dcaDaughters/F");
+    fV0FlatTree->Branch("v0.cosPA",&fFlatV0.fCosPA,"cosPA/F");
+    fV0FlatTree->Branch("v0.mass",fFlatV0.fMass,"mass[4]/F");
+    fV0FlatTree->Branch("v0.chi2KF",&fFlatV0.fChi2KF,"chi2KF/F");
+    BookFlatTrack(fV0FlatTree,"track0",fFlatTrack[0]);
+    BookFlatTrack(fV0FlatTree,"track1",fFlatTrack[1]);
+    //
+    fdEdxFlatTree = ((*fTreeSRedirector)<<"dEdxFlat").GetTree();
+    BookFlatEvent(fdEdxFlatTree);
+    BookFlatTrack(fdEdxFlatTree,"esdTrack",fFlatTrack[0]);
+  }
+
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
   }
@@ -688,11 +737,7 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       if(!accCuts->AcceptTrack(track)) continue;
 
       // downscale low-pT tracks
-      Double_t scalempt= TMath::Min(track->Pt(),10.);
-      Double_t downscaleF = gRandom->Rndm();
-      downscaleF *= fLowPtTrackDownscaligF;
-      if( downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
-      //printf("TMath::Exp(2*scalempt) %e, downscaleF %e \n",TMath::Exp(2*scalempt), downscaleF);
+      if( downscaleCounter>0 && IsLowPtTrackDownscaled(track->Pt())) continue;
 
       AliExternalTrackParam * tpcInner = (AliExternalTrackParam *)(track->GetTPCInnerParam());
       if (!tpcInner) continue;
@@ -971,6 +1016,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
     vert[2] = vtxESD->GetZ();
     Int_t mult = vtxESD->GetNContributors();
     Int_t numberOfTracks=esdEvent->GetNumberOfTracks();
+    if (fColumnarOutput) FillFlatEvent(esdEvent,vtxESD,centralityF);
     // high pT tracks
     for (Int_t iTrack = 0; iTrack < numberOfTracks; iTrack++)
     {
@@ -984,12 +1030,18 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
       if(!esdTrackCuts->AcceptTrack(track)) continue;
       if(!accCuts->AcceptTrack(track)) continue;
 
-      // downscale low-pT tracks
-      Double_t scalempt= TMath::Min(track->Pt(),10.);
-      Double_t downscaleF = gRandom->Rndm();
-      downscaleF *= fLowPtTrackDownscaligF;
-      if( downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
-      //printf("TMath::Exp(2*scalempt) %e, downscaleF %e \n",TMath::Exp(2*scalempt), downscaleF);
+      // downscale low-pT tracks - decided before any copy/propagation of the track
+      if( downscaleCounter>0 && IsLowPtTrackDownscaled(track->Pt())) continue;
+
+      // columnar output - flat track parameters only
+      if (fColumnarOutput) {
+        if (fHighPtFlatTree && fFillTree) {
+          FillFlatTrack(fFlatTrack[0],track,esdEvent,vtxESD,pidResponse);
+          fHighPtFlatTree->Fill();
+          downscaleCounter++;
+        }
+        continue;
+      }
 
       // Dump to the tree 
       // vertex
@@ -1713,10 +1765,7 @@ void AliAnalysisTaskFilteredTree::ProcessMCEff(AliESDEvent *const esdEvent, AliM
       if(!prim) continue;
 
       // downscale low-pT particles
-      Double_t scalempt= TMath::Min(particle->Pt(),10.);
-      Double_t downscaleF = gRandom->Rndm();
-      downscaleF *= fLowPtTrackDownscaligF;
-      if (downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
+      if (downscaleCounter>0 && IsLowPtTrackDownscaled(particle->Pt())) continue;
       // is particle in acceptance
       if(!accCuts->AcceptTrack(particle)) continue;
 
@@ -1951,6 +2000,7 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
     // 
     Int_t ntracks = esdEvent->GetNumberOfTracks();
     Int_t evNr=esdEvent->GetEventNumberInFile();
+    if (fColumnarOutput) FillFlatEvent(esdEvent,vtxESD,centralityF);
 
 
     for (Int_t iv0=0; iv0<nV0s; iv0++){
@@ -1961,6 +2011,9 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
       AliESDtrack * track1 = esdEvent->GetTrack(v0->GetIndex(1));
       if (!track0) continue;
       if (!track1) continue;
+      // downscale low-pT V0s - decided before any further processing
+      Bool_t isDownscaled = IsV0Downscaled(v0);
+      if (downscaleCounter>0 && isDownscaled) continue;
       AliESDfriendTrack* friendTrack0=NULL;
       AliESDfriendTrack* friendTrack1=NULL;
       if (esdFriend)       {
@@ -2006,11 +2059,37 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
       }
 
       //
-      Bool_t isDownscaled = IsV0Downscaled(v0);
-      if (downscaleCounter>0 && isDownscaled) continue;
       AliKFParticle kfparticle; //
       Int_t type=GetKFParticle(v0,esdEvent,kfparticle);
       if (type==0) continue;   
+
+      // columnar output - flat V0 and track parameters only
+      if (fColumnarOutput) {
+        if (fV0FlatTree && fFillTree) {
+          Double_t xyz[3], p[3];
+          v0->GetXYZ(xyz[0],xyz[1],xyz[2]);
+          v0->GetPxPyPz(p[0],p[1],p[2]);
+          const Int_t precParam=fColumnPrecision[kPrecParam], precQPt=fColumnPrecision[kPrecQPt], precOther=fColumnPrecision[kPrecOther];
+          fFlatV0.fType  = type;
+          fFlatV0.fOnFly = v0->GetOnFlyStatus();
+          for (Int_t i=0; i<3; i++) {
+            fFlatV0.fXYZ[i] = TruncateFloat(xyz[i],precParam);
+            fFlatV0.fP[i]   = TruncateFloat(p[i],precQPt);
+          }
+          fFlatV0.fDcaDaughters = TruncateFloat(v0->GetDcaV0Daughters(),precOther);
+          fFlatV0.fCosPA   = v0->GetV0CosineOfPointingAngle(vtxESD->GetX(),vtxESD->GetY(),vtxESD->GetZ());  // close to 1 - full precision
+          fFlatV0.fMass[0] = TruncateFloat(v0->GetEffMass(0,0),precOther);
+          fFlatV0.fMass[1] = TruncateFloat(v0->GetEffMass(2,2),precOther);
+          fFlatV0.fMass[2] = TruncateFloat(v0->GetEffMass(4,2),precOther);
+          fFlatV0.fMass[3] = TruncateFloat(v0->GetEffMass(2,4),precOther);
+          fFlatV0.fChi2KF  = TruncateFloat(kfparticle.GetChi2(),precOther);
+          FillFlatTrack(fFlatTrack[0],track0,esdEvent,vtxESD,pidResponse);
+          FillFlatTrack(fFlatTrack[1],track1,esdEvent,vtxESD,pidResponse);
+          fV0FlatTree->Fill();
+          downscaleCounter++;
+        }
+        continue;
+      }
       TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
 
       if(!fFillTree) return;
@@ -2159,6 +2238,7 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
     ULong64_t bunchCrossID = (ULong64_t)esdEvent->GetBunchCrossNumber();
     ULong64_t periodID     = (ULong64_t)esdEvent->GetPeriodNumber();
     ULong64_t gid          = ((periodID << 36) | (orbitID << 12) | bunchCrossID); 
+    if (fColumnarOutput) FillFlatEvent(esdEvent,vtxESD,-1);
     
     // large dEdx
     for (Int_t iTrack = 0; iTrack < esdEvent->GetNumberOfTracks(); iTrack++)
@@ -2178,6 +2258,16 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
       if(!accCuts->AcceptTrack(track)) continue;
 
       if(!IsHighDeDxParticle(track)) continue;
+
+      // columnar output - flat track parameters only
+      if (fColumnarOutput) {
+        if (fdEdxFlatTree && fFillTree) {
+          FillFlatTrack(fFlatTrack[0],track,esdEvent,vtxESD,pidResponse);
+          fdEdxFlatTree->Fill();
+          downscaleCounter++;
+        }
+        continue;
+      }
       TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
 
       if(!fFillTree) return;
@@ -2375,7 +2465,146 @@ Bool_t AliAnalysisTaskFilteredTree::IsV0Downscaled(AliESDv0 *const v0)
 
 }
 
+//_____________________________________________________________________________
+Bool_t AliAnalysisTaskFilteredTree::IsLowPtTrackDownscaled(Double_t pt)
+{
+  //
+  // Downscale randomly low pt tracks (particles) - flat pt spectra for fLowPtTrackDownscaligF 
+  // Common for all Process functions, to be called before any track copy
+  //
+  Double_t scalempt= TMath::Min(pt,10.);
+  Double_t downscaleF = gRandom->Rndm();
+  downscaleF *= fLowPtTrackDownscaligF;
+  return TMath::Exp(2*scalempt)<downscaleF;
+}
+
+//_____________________________________________________________________________
+Float_t AliAnalysisTaskFilteredTree::TruncateFloat(Double_t value, Int_t nBits)
+{
+  //
+  // Round the float mantissa to nBits (out of 23) - the dropped bits are zero 
+  // and compress away in the output tree (relative precision 2^-(nBits+1))
+  //
+  union { Float_t f; UInt_t u; } x;
+  x.f = value;
+  if (nBits>=23 || nBits<0) return x.f;
+  if ((x.u & 0x7f800000)==0x7f800000) return x.f;   // inf or nan
+  const UInt_t nDrop = 23-nBits;
+  x.u += 1u<<(nDrop-1);                                // round to nearest
+  x.u &= ~((1u<<nDrop)-1);
+  return x.f;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::BookFlatEvent(TTree *tree)
+{
+  //
+  // Event columns of the flat trees
+  //
+  tree->Branch("gid",&fFlatEvent.fGid,"gid/l");
+  tree->Branch("runNumber",&fFlatEvent.fRunNumber,"runNumber/I");
+  tree->Branch("evtTimeStamp",&fFlatEvent.fTimeStamp,"evtTimeStamp/I");
+  tree->Branch("evtNumberInFile",&fFlatEvent.fEvtNumberInFile,"evtNumberInFile/I");
+  tree->Branch("mult",&fFlatEvent.fMult,"mult/I");
+  tree->Branch("ntracks",&fFlatEvent.fNtracks,"ntracks/I");
+  tree->Branch("Bz",&fFlatEvent.fBz,"Bz/F");
+  tree->Branch("centralityF",&fFlatEvent.fCentrality,"centralityF/F");
+  tree->Branch("vertex",fFlatEvent.fVertex,"vertex[3]/F");
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::BookFlatTrack(TTree *tree, const char *prefix, AliFilteredTreeFlatTrack &flat)
+{
+  //
+  // Track columns of the flat trees, branch names prefix.variable
+  //
+  tree->Branch(Form("%s.status",prefix),&flat.fStatus,"status/i");
+  tree->Branch(Form("%s.label",prefix),&flat.fLabel,"label/I");
+  tree->Branch(Form("%s.nclsTPC",prefix),&flat.fNclsTPC,"nclsTPC/I");
+  tree->Branch(Form("%s.nclsITS",prefix),&flat.fNclsITS,"nclsITS/I");
+  tree->Branch(Form("%s.isOKTPCInnerC",prefix),&flat.fIsOKTPCInnerC,"isOKTPCInnerC/I");
+  tree->Branch(Form("%s.alpha",prefix),&flat.fAlpha,"alpha/F");
+  tree->Branch(Form("%s.x",prefix),&flat.fX,"x/F");
+  tree->Branch(Form("%s.param",prefix),flat.fParam,"param[5]/F");
+  tree->Branch(Form("%s.cov",prefix),flat.fCov,"cov[15]/F");
+  tree->Branch(Form("%s.tpcInnerCParam",prefix),flat.fTPCInnerCParam,"tpcInnerCParam[5]/F");
+  tree->Branch(Form("%s.tpcInnerCCov",prefix),flat.fTPCInnerCCov,"tpcInnerCCov[15]/F");
+  tree->Branch(Form("%s.chi2TPC",prefix),&flat.fChi2TPC,"chi2TPC/F");
+  tree->Branch(Form("%s.chi2ITS",prefix),&flat.fChi2ITS,"chi2ITS/F");
+  tree->Branch(Form("%s.tpcSignal",prefix),&flat.fTPCsignal,"tpcSignal/F");
+  tree->Branch(Form("%s.tofSignal",prefix),&flat.fTOFsignal,"tofSignal/F");
+  tree->Branch(Form("%s.tpcNsigma",prefix),flat.fTPCNsigma,"tpcNsigma[5]/F");
+  tree->Branch(Form("%s.tofNsigma",prefix),flat.fTOFNsigma,"tofNsigma[5]/F");
+}
 
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::FillFlatEvent(AliESDEvent *const esdEvent, const AliESDVertex *vtx, Double_t centralityF)
+{
+  //
+  // Fill event columns - once per event
+  //
+  ULong64_t orbitID      = (ULong64_t)esdEvent->GetOrbitNumber();
+  ULong64_t bunchCrossID = (ULong64_t)esdEvent->GetBunchCrossNumber();
+  ULong64_t periodID     = (ULong64_t)esdEvent->GetPeriodNumber();
+  fFlatEvent.fGid             = ((periodID << 36) | (orbitID << 12) | bunchCrossID); 
+  fFlatEvent.fRunNumber       = esdEvent->GetRunNumber();
+  fFlatEvent.fTimeStamp       = esdEvent->GetTimeStamp();
+  fFlatEvent.fEvtNumberInFile = esdEvent->GetEventNumberInFile();
+  fFlatEvent.fMult            = vtx->GetNContributors();
+  fFlatEvent.fNtracks         = esdEvent->GetNumberOfTracks();
+  fFlatEvent.fBz              = esdEvent->GetMagneticField();
+  fFlatEvent.fCentrality      = centralityF;
+  fFlatEvent.fVertex[0]       = vtx->GetX();
+  fFlatEvent.fVertex[1]       = vtx->GetY();
+  fFlatEvent.fVertex[2]       = vtx->GetZ();
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::FillFlatTrack(AliFilteredTreeFlatTrack &flat, AliESDtrack *const track, AliESDEvent *const esdEvent, const AliESDVertex *vtx, AliPIDResponse *pidResponse)
+{
+  //
+  // Fill track columns with the per class precision
+  // TPC inner params constrained to the vertex as in ProcessAll (stack copy only)
+  //
+  const Int_t precParam=fColumnPrecision[kPrecParam], precQPt=fColumnPrecision[kPrecQPt];
+  const Int_t precCov=fColumnPrecision[kPrecCov], precPID=fColumnPrecision[kPrecPID], precOther=fColumnPrecision[kPrecOther];
+
+  flat.fStatus  = track->GetStatus();
+  flat.fLabel   = track->GetLabel();
+  flat.fNclsTPC = track->GetTPCNcls();
+  flat.fNclsITS = track->GetITSNcls();
+  flat.fAlpha   = TruncateFloat(track->GetAlpha(),precParam);
+  flat.fX       = TruncateFloat(track->GetX(),precParam);
+  for (Int_t ipar=0; ipar<5; ipar++) flat.fParam[ipar] = TruncateFloat(track->GetParameter()[ipar],(ipar==4)?precQPt:precParam);
+  for (Int_t icov=0; icov<15; icov++) flat.fCov[icov] = TruncateFloat(track->GetCovariance()[icov],precCov);
+
+  flat.fIsOKTPCInnerC = 0;
+  for (Int_t ipar=0; ipar<5; ipar++) flat.fTPCInnerCParam[ipar] = 0;
+  for (Int_t icov=0; icov<15; icov++) flat.fTPCInnerCCov[icov] = 0;
+  if (track->GetTPCInnerParam()) {
+    Double_t x[3]; track->GetXYZ(x);
+    Double_t b[3]; AliTracker::GetBxByBz(x,b);
+    AliExternalTrackParam tpcInnerC(*(track->GetTPCInnerParam()));
+    Bool_t isOK = ConstrainTPCInner(&tpcInnerC,vtx,b);
+    isOK &= tpcInnerC.Rotate(track->GetAlpha());
+    isOK &= tpcInnerC.PropagateTo(track->GetX(),esdEvent->GetMagneticField());
+    flat.fIsOKTPCInnerC = isOK;
+    for (Int_t ipar=0; ipar<5; ipar++) flat.fTPCInnerCParam[ipar] = TruncateFloat(tpcInnerC.GetParameter()[ipar],(ipar==4)?precQPt:precParam);
+    for (Int_t icov=0; icov<15; icov++) flat.fTPCInnerCCov[icov] = TruncateFloat(tpcInnerC.GetCovariance()[icov],precCov);
+  }
+
+  flat.fChi2TPC   = TruncateFloat(track->GetTPCchi2(),precOther);
+  flat.fChi2ITS   = TruncateFloat(track->GetITSchi2(),precOther);
+  flat.fTPCsignal = TruncateFloat(track->GetTPCsignal(),precPID);
+  flat.fTOFsignal = TruncateFloat(track->GetTOFsignal(),precPID);
+  for (Int_t ispecie=0; ispecie<AliPID::kSPECIES; ++ispecie) {
+    flat.fTPCNsigma[ispecie] = 0;
+    flat.fTOFNsigma[ispecie] = 0;
+    if (!pidResponse || ispecie == Int_t(AliPID::kMuon)) continue;
+    flat.fTPCNsigma[ispecie] = TruncateFloat(pidResponse->NumberOfSigmas(AliPIDResponse::kTPC, track, (AliPID::EParticleType)ispecie),precPID);
+    flat.fTOFNsigma[ispecie] = TruncateFloat(pidResponse->NumberOfSigmas(AliPIDResponse::kTOF, track, (AliPID::EParticleType)ispecie),precPID);
+  }
+}
 
 //_____________________________________________________________________________
 Bool_t AliAnalysisTaskFilteredTree::ConstrainTPCInner(AliExternalTrackParam *const tpcInnerC, const AliESDVertex* vtx, Double_t b[3])
@@ -3357,10 +3586,7 @@ void AliAnalysisTaskFilteredTree::ProcessMC(){
     TParticle *particle = stack->Particle(iMc);
     if (!particle) continue;
     // apply downscaling function
-    Double_t scalempt= TMath::Min(particle->Pt(),10.);
-    Double_t downscaleF = gRandom->Rndm();
-    downscaleF *= fLowPtTrackDownscaligF;
-    if (downscaleCounter>0 && TMath::Exp(2*scalempt)<downscaleF) continue;
+    if (downscaleCounter>0 && IsLowPtTrackDownscaled(particle->Pt())) continue;
     Int_t result = GetMCInfoTrack(iMc, trackInfoF,trackInfoO);
 
   }
@@ -30,11 +30,59 @@ class TTree;
 class TTreeSRedirector;
 class TParticle;
 class TH3D;
+class AliPIDResponse;
 #include <string>
 
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
 
+//
+// Flat (columnar) output buffers - plain numbers and fixed size arrays
+// instead of object copies, see SetColumnarOutput()
+//
+struct AliFilteredTreeFlatEvent {
+  ULong64_t fGid;           // global event id (period, orbit, bunch crossing)
+  Int_t     fRunNumber;     // run number
+  Int_t     fTimeStamp;     // time stamp of event (in seconds)
+  Int_t     fEvtNumberInFile; // event number in file
+  Int_t     fMult;          // multiplicity of tracks pointing to the primary vertex
+  Int_t     fNtracks;       // number of esd tracks
+  Float_t   fBz;            // solenoid magnetic field (in kGaus)
+  Float_t   fCentrality;    // centrality
+  Float_t   fVertex[3];     // primary vertex position
+};
+
+struct AliFilteredTreeFlatTrack {
+  UInt_t  fStatus;          // esd track status bits
+  Int_t   fLabel;           // MC label
+  Int_t   fNclsTPC;         // number of TPC clusters
+  Int_t   fNclsITS;         // number of ITS clusters
+  Int_t   fIsOKTPCInnerC;   // TPC inner param constrained to the vertex
+  Float_t fAlpha;           // rotation angle of the parameters
+  Float_t fX;               // local X of the parameters
+  Float_t fParam[5];        // esd track parameters
+  Float_t fCov[15];         // esd track covariance
+  Float_t fTPCInnerCParam[5]; // TPC inner param constrained to the vertex, in the track frame
+  Float_t fTPCInnerCCov[15];  // covariance of the above
+  Float_t fChi2TPC;         // TPC chi2
+  Float_t fChi2ITS;         // ITS chi2
+  Float_t fTPCsignal;       // TPC dEdx
+  Float_t fTOFsignal;       // TOF signal
+  Float_t fTPCNsigma[5];    // TPC n sigma, AliPID species
+  Float_t fTOFNsigma[5];    // TOF n sigma, AliPID species
+};
+
+struct AliFilteredTreeFlatV0 {
+  Int_t   fType;            // type of V0 from GetKFParticle
+  Int_t   fOnFly;           // on-the-fly status
+  Float_t fXYZ[3];          // V0 decay vertex
+  Float_t fP[3];            // V0 momentum
+  Float_t fDcaDaughters;    // DCA between the daughters
+  Float_t fCosPA;           // cosine of pointing angle
+  Float_t fMass[4];         // gamma, K0s, Lambda, anti-Lambda masses
+  Float_t fChi2KF;          // KF particle chi2
+};
+
 class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
  public:
 
@@ -42,6 +90,14 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
                       kTPCITSAnalysisMode=0,
                       kTPCAnalysisMode=1 };
 
+  // precision classes of the columnar output (number of mantissa bits kept)
+  enum EColumnPrecision { kPrecParam=0,     // track parameters (y,z,snp,tgl), positions
+                          kPrecQPt=1,       // q/pt, momenta
+                          kPrecCov=2,       // covariance matrix elements
+                          kPrecPID=3,       // dEdx, TOF and n sigmas
+                          kPrecOther=4,     // chi2, masses, angles ...
+                          kNColumnPrecision=5 };
+
   AliAnalysisTaskFilteredTree(const char *name = "AliAnalysisTaskFilteredTree");
   virtual ~AliAnalysisTaskFilteredTree();
   
@@ -97,6 +153,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Int_t  GetKFParticle(AliESDv0 *const v0, AliESDEvent * const event, AliKFParticle & kfparticle);
   Bool_t IsV0Downscaled(AliESDv0 *const v0);
   Bool_t IsHighDeDxParticle(AliESDtrack * const track);
+  Bool_t IsLowPtTrackDownscaled(Double_t pt);
 
   void SetLowPtTrackDownscaligF(Double_t fact) { fLowPtTrackDownscaligF = fact; }
   void SetLowPtV0DownscaligF(Double_t fact)    { fLowPtV0DownscaligF = fact; }
@@ -115,6 +172,13 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
   Bool_t GetFillTrees() { return fFillTree ;}
 
+  // columnar output: highPtFlat, V0sFlat and dEdxFlat trees replace highPt, V0s and dEdx
+  void   SetColumnarOutput(Bool_t flag) { fColumnarOutput = flag; }
+  Bool_t GetColumnarOutput() const { return fColumnarOutput; }
+  void   SetColumnPrecision(EColumnPrecision type, Int_t nBits) { fColumnPrecision[type] = nBits; }
+  Int_t  GetColumnPrecision(EColumnPrecision type) const { return fColumnPrecision[type]; }
+  static Float_t TruncateFloat(Double_t value, Int_t nBits);
+
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
   static void SetDefaultAliasesV0(TTree *treeV0);
@@ -123,6 +187,10 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Int_t GetMCInfoKink(Int_t label,    std::map<std::string,float> &kinkInfoF, std::map<std::string,TObject*> &kinkInfoO);  // TODO
   static Int_t GetMCTrackDiff(const TParticle &particle, const AliExternalTrackParam &param, TClonesArray &trackRefArray, TVectorF &mcDiff); //TODO test before enabling
  private:
+  void BookFlatEvent(TTree *tree);
+  void BookFlatTrack(TTree *tree, const char *prefix, AliFilteredTreeFlatTrack &flat);
+  void FillFlatEvent(AliESDEvent *const esdEvent, const AliESDVertex *vtx, Double_t centralityF);
+  void FillFlatTrack(AliFilteredTreeFlatTrack &flat, AliESDtrack *const track, AliESDEvent *const esdEvent, const AliESDVertex *vtx, AliPIDResponse *pidResponse);
 
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
@@ -175,9 +243,18 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
 
+  Bool_t fColumnarOutput;                      // write the flat trees instead of the object trees
+  Int_t  fColumnPrecision[kNColumnPrecision];  // mantissa bits kept per precision class
+  TTree* fHighPtFlatTree;                      //! flat highPt tree
+  TTree* fV0FlatTree;                          //! flat V0 tree
+  TTree* fdEdxFlatTree;                        //! flat dEdx tree
+  AliFilteredTreeFlatEvent fFlatEvent;         //! flat event buffer
+  AliFilteredTreeFlatTrack fFlatTrack[2];      //! flat track buffers
+  AliFilteredTreeFlatV0    fFlatV0;            //! flat V0 buffer
+
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
@@ -9,6 +9,7 @@
 #include "TList.h"
 
 #include "AliMultiplicityCorrelations.h"
+#include "AliMultiplicityCovariance.h"
 
 // Task for HI Multiplicity correlation checks
 // Author: Jochen Thaeder <jochen@thaeder.de>
@@ -16,6 +17,10 @@
 /** ROOT macro for the implementation of ROOT specific class methods */
 ClassImp(AliMultiplicityCorrelations)
 
+const Char_t* AliMultiplicityCorrelations::fgkEstimatorNames[AliMultiplicityCorrelations::kNEstimators] = {
+  "NchTPC", "NchGlobal", "VZERO", "VZEROA", "VZEROC", "SPD", "SPDOuter", "ZDC", "ZEM"
+};
+
 /*
  * ---------------------------------------------------------------------------------
  *                            Constructor / Destructor
@@ -40,9 +45,13 @@ AliMultiplicityCorrelations::AliMultiplicityCorrelations() :
   fTpcBinning(800),fTpcBinningMin(0.),fTpcBinningMax(8000.),
   fZdcBinning(1000),fZdcBinningMin(0.),fZdcBinningMax(6000.),
   fZemBinning(500),fZemBinningMin(0.),fZemBinningMax(2500.),
-  fSpdBinning(750),fSpdBinningMin(0.),fSpdBinningMax(15000.) {
+  fSpdBinning(750),fSpdBinningMin(0.),fSpdBinningMax(15000.),
+  fCorrHistNames(""), fExtendCorrHist(kFALSE), fCovTimeSlice(0),
+  fCovariance(NULL), fCovSlice(NULL), fCovSliceRun(-1), fCovSliceIdx(0) {
   // see header file for class documentation
   
+  for (Int_t i = 0; i < kNHist; ++i) fHist[i] = NULL;
+  for (Int_t i = 0; i < kNEstimators; ++i) fEstimator[i] = 0.;
 }
 //##################################################################################
 AliMultiplicityCorrelations::AliMultiplicityCorrelations(Char_t* name, Char_t* title) : 
@@ -62,9 +71,13 @@ AliMultiplicityCorrelations::AliMultiplicityCorrelations(Char_t* name, Char_t* t
   fTpcBinning(800),fTpcBinningMin(0.),fTpcBinningMax(8000.),
   fZdcBinning(280),fZdcBinningMin(0.),fZdcBinningMax(140.),
   fZemBinning(100),fZemBinningMin(0.),fZemBinningMax(5.),
-  fSpdBinning(750),fSpdBinningMin(0.),fSpdBinningMax(15000.) {
+  fSpdBinning(750),fSpdBinningMin(0.),fSpdBinningMax(15000.),
+  fCorrHistNames(""), fExtendCorrHist(kFALSE), fCovTimeSlice(0),
+  fCovariance(NULL), fCovSlice(NULL), fCovSliceRun(-1), fCovSliceIdx(0) {
   // see header file for class documentation
   
+  for (Int_t i = 0; i < kNHist; ++i) fHist[i] = NULL;
+  for (Int_t i = 0; i < kNEstimators; ++i) fEstimator[i] = 0.;
 }
 
 //##################################################################################
@@ -94,6 +107,9 @@ Int_t AliMultiplicityCorrelations::Initialize( const Char_t* listName) {
   fHistList->SetOwner(kTRUE);
   fHistList->SetName(Form("MultiplicityCorrelations_%s",listName));
   iResult = SetupHistograms();
+
+  fCovariance = new AliMultiplicityCovariance("fCovariance", kNEstimators, fgkEstimatorNames);
+  fHistList->Add(fCovariance);
   
   if (fProcessZDC)   { AliInfo("Processing of ZDC enabled"); }
   if (fProcessTPC)   { AliInfo("Processing of TPC enabled"); }
@@ -119,6 +135,8 @@ Int_t AliMultiplicityCorrelations::ProcessEvent(AliESDEvent *esd) {
     AliWarning("No ESD event.");
     return -1;
   }
+
+  for (Int_t i = 0; i < kNEstimators; ++i) fEstimator[i] = 0.;
   
   // -- TPC .. To be done before the others
   if (fESDEvent->GetNumberOfTracks() > 0 && fProcessTPC)
@@ -143,6 +161,9 @@ Int_t AliMultiplicityCorrelations::ProcessEvent(AliESDEvent *esd) {
   // -- ZDC and Correlations
   if (fESDZDC && fProcessZDC)
     iResult = ProcessZDC();
+
+  // -- Covariance of all estimators
+  FillCovariance();
  
   return iResult;
 }
@@ -224,13 +245,13 @@ Int_t AliMultiplicityCorrelations::SetupVZERO() {
   // see header file for class documentation  
 
   // VzeroMult
-  fHistList->Add(new TH1F("fVzeroMult",  "Multiplicity^{VZERO};Multiplicity^{VZERO};N_{Events}",   
+  AddHist(kHVzeroMult, new TH1F("fVzeroMult",  "Multiplicity^{VZERO};Multiplicity^{VZERO};N_{Events}",   
 			  fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
-  fHistList->Add(new TH1F("fVzeroMultUnCorr", "Multiplicity^{VZERO} uncorrected;Multiplicity^{VZERO};N_{Events}",   
+  AddHist(kHVzeroMultUnCorr, new TH1F("fVzeroMultUnCorr", "Multiplicity^{VZERO} uncorrected;Multiplicity^{VZERO};N_{Events}",   
 			  fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
-  fHistList->Add(new TH2F("fVzeroMultAC", "Multiplicity^{VZERO} A vs C;Multiplicity^{VZERO}A ;Multiplicity^{VZERO} C", 
+  AddHist(kHVzeroMultAC, new TH2F("fVzeroMultAC", "Multiplicity^{VZERO} A vs C;Multiplicity^{VZERO}A ;Multiplicity^{VZERO} C", 
 			  fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax)); 
 
   return 0;
@@ -241,15 +262,15 @@ Int_t AliMultiplicityCorrelations::SetupZDC() {
   // see header file for class documentation  
     
   // E_{ZDC}
-  fHistList->Add(new TH1F("fZdcEzdc",  "E_{ZDC};E_{ZDC} (TeV);N_{Events}",   
+  AddHist(kHZdcEzdc, new TH1F("fZdcEzdc",  "E_{ZDC};E_{ZDC} (TeV);N_{Events}",   
 			  fZdcBinning,fZdcBinningMin,fZdcBinningMax));
 
   // E_{ZEM}
-  fHistList->Add(new TH1F("fZdcEzem",  "E_{ZEM};E_{ZEM} (TeV);N_{Events}",   
+  AddHist(kHZdcEzem, new TH1F("fZdcEzem",  "E_{ZEM};E_{ZEM} (TeV);N_{Events}",   
 			  fZemBinning,fZemBinningMin,fZemBinningMax));
   
   // E_{ZEM} vs E_{ZDC} 
-  fHistList->Add(new TH2F("fZdcEzemEzdc", "E_{ZEM} vs E_{ZDC};E_{ZEM} (TeV); E_{ZDC} (TeV)",   
+  AddHist(kHZdcEzemEzdc, new TH2F("fZdcEzemEzdc", "E_{ZEM} vs E_{ZDC};E_{ZEM} (TeV); E_{ZDC} (TeV)",   
 			  fZemBinning,fZemBinningMin,fZemBinningMax, fZdcBinning,fZdcBinningMin,fZdcBinningMax));
 
   return 0;
@@ -260,25 +281,25 @@ Int_t AliMultiplicityCorrelations::SetupTPC() {
   // see header file for class documentation  
 
   // Multiplicity
-  fHistList->Add(new TH1F("fTpcNch0", "N_{ch} esdTracks; N_{ch};N_{Events}", 
+  AddHist(kHTpcNch0, new TH1F("fTpcNch0", "N_{ch} esdTracks; N_{ch};N_{Events}", 
 			  fTpcBinning,fTpcBinningMin,fTpcBinningMax));
-  fHistList->Add(new TH1F("fTpcNch1", "N_{ch} accepted esdTracks; N_{ch};N_{Events}", 
+  AddHist(kHTpcNch1, new TH1F("fTpcNch1", "N_{ch} accepted esdTracks; N_{ch};N_{Events}", 
 			  fTpcBinning,fTpcBinningMin,fTpcBinningMax));
-  fHistList->Add(new TH1F("fTpcNch2", "N_{ch} tpcTracks; N_{ch};N_{Events}", 
+  AddHist(kHTpcNch2, new TH1F("fTpcNch2", "N_{ch} tpcTracks; N_{ch};N_{Events}", 
 			  fTpcBinning,fTpcBinningMin,fTpcBinningMax));
-  fHistList->Add(new TH1F("fTpcNch3", "N_{ch} accepted tpcTracks; N_{ch};N_{Events}", 
+  AddHist(kHTpcNch3, new TH1F("fTpcNch3", "N_{ch} accepted tpcTracks; N_{ch};N_{Events}", 
 			  fTpcBinning,fTpcBinningMin,fTpcBinningMax));
 
-  fHistList->Add(new TH2F("fTpcCorrNch","N_{ch} accepted tpcTracks vs globalTracks; N_{tpc};N_{global}", 
+  AddHist(kHTpcCorrNch, new TH2F("fTpcCorrNch","N_{ch} accepted tpcTracks vs globalTracks; N_{tpc};N_{global}", 
 			  fTpcBinning,fTpcBinningMin,fTpcBinningMax, fTpcBinning,fTpcBinningMin,fTpcBinningMax));
 
-  fHistList->Add(new TH1F("fTpcRatioNch","N_{ch} accepted tpcTracks/globalTracks; N_{ch};Ratio", 
+  AddHist(kHTpcRatioNch, new TH1F("fTpcRatioNch","N_{ch} accepted tpcTracks/globalTracks; N_{ch};Ratio", 
 			  201,0.,2.));
 
-  fHistList->Add(new TH2F("fTpcCorrNchAll","N_{ch} accepted tpcTracks vs globalTracks - uncleaned ; N_{tpc};N_{global}", 
+  AddHist(kHTpcCorrNchAll, new TH2F("fTpcCorrNchAll","N_{ch} accepted tpcTracks vs globalTracks - uncleaned ; N_{tpc};N_{global}", 
 			  fTpcBinning,fTpcBinningMin,fTpcBinningMax, fTpcBinning,fTpcBinningMin,fTpcBinningMax));
 
-  fHistList->Add(new TH1F("fTpcRatioNchAll","N_{ch} accepted tpcTracks/globalTracks - uncleaned; N_{ch};Ratio", 
+  AddHist(kHTpcRatioNchAll, new TH1F("fTpcRatioNchAll","N_{ch} accepted tpcTracks/globalTracks - uncleaned; N_{ch};Ratio", 
 			  201,0.,2.));
 
   return 0;
@@ -294,12 +315,12 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
   if (fProcessTPC && fProcessZDC) {
 
     // N_{ch} vs E_{ZDC}
-    fHistList->Add(new TH2F("fCorrEzdcNch", "N_{ch}^{TPC} vs E_{ZDC};N_{ch}^{TPC};E_{ZDC} (TeV)",   
+    AddHist(kHCorrEzdcNch, new TH2F("fCorrEzdcNch", "N_{ch}^{TPC} vs E_{ZDC};N_{ch}^{TPC};E_{ZDC} (TeV)",   
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fZdcBinning,fZdcBinningMin,fZdcBinningMax));
 
 
     // N_{ch} vs E_{ZEM}
-    fHistList->Add(new TH2F("fCorrEzemNch", "N_{ch}^{TPC} vs E_{ZEM};N_{ch}^{TPC};E_{ZEM} (TeV)",   
+    AddHist(kHCorrEzemNch, new TH2F("fCorrEzemNch", "N_{ch}^{TPC} vs E_{ZEM};N_{ch}^{TPC};E_{ZEM} (TeV)",   
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fZdcBinning,fZdcBinningMin,fZdcBinningMax));
   }
   // ----------------------------------------------------
@@ -308,12 +329,12 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
   if (fProcessZDC && fProcessVZERO) {
 
     // E_{ZDC} vs Multiplicity VZERO
-    fHistList->Add(new TH2F("fCorrEzdcVzero", 
+    AddHist(kHCorrEzdcVzero, new TH2F("fCorrEzdcVzero", 
 			    "E_{ZDC} vs Multiplicity^{VZERO};E_{ZDC} (TeV);Multiplicity^{VZERO}",  
 			    fZdcBinning,fZdcBinningMin,fZdcBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
     
     // E_{ZEM} vs Multiplicity VZERO
-    fHistList->Add(new TH2F("fCorrEzemVzero", 
+    AddHist(kHCorrEzemVzero, new TH2F("fCorrEzemVzero", 
 			    "E_{ZEM} vs Multiplicity^{VZERO};E_{ZEM} (TeV);Multiplicity^{VZERO}",  
 			    fZemBinning,fZemBinningMin,fZemBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
@@ -323,19 +344,19 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
   // ----------------------------------------------------
   if ( fProcessTPC && fProcessVZERO ) {
 
-    fHistList->Add(new TH2F("fCorrVzeroNch", 
+    AddHist(kHCorrVzeroNch, new TH2F("fCorrVzeroNch", 
 			    "N_{ch}^{TPC} vs Multiplicity^{VZERO};N_{ch}^{TPC};Multiplicity^{VZERO}", 
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
-    fHistList->Add(new TH2F("fCorrVzeroNchUnCorr", 
+    AddHist(kHCorrVzeroNchUnCorr, new TH2F("fCorrVzeroNchUnCorr", 
 			    "N_{ch}^{TPC} vs Multiplicity^{VZERO} uncorrected;N_{ch}^{TPC};Multiplicity^{VZERO}", 
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
-    fHistList->Add(new TH2F("fCorrVzeroESDNch", 
+    AddHist(kHCorrVzeroESDNch, new TH2F("fCorrVzeroESDNch", 
 			    "N_{ch}^{global} vs Multiplicity^{VZERO};N_{ch}^{TPC};Multiplicity^{VZERO}", 
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
-    fHistList->Add(new TH2F("fCorrVzeroESDNchUnCorr", 
+    AddHist(kHCorrVzeroESDNchUnCorr, new TH2F("fCorrVzeroESDNchUnCorr", 
 			    "N_{ch}^{global} vs Multiplicity^{VZERO} uncorrected;N_{ch}^{TPC};Multiplicity^{VZERO}", 
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax));
 
@@ -345,10 +366,10 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
   // ----------------------------------------------------
   if ( fProcessSPD && fProcessTPC ) {
 
-    fHistList->Add(new TH2F("fCorrSpdTpcNch", "N_{ch}^{TPC} vs N_{clusters}^{SPD};N_{ch}^{TPC};N_{clusters}^{SPD}",   
+    AddHist(kHCorrSpdTpcNch, new TH2F("fCorrSpdTpcNch", "N_{ch}^{TPC} vs N_{clusters}^{SPD};N_{ch}^{TPC};N_{clusters}^{SPD}",   
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fSpdBinning,fSpdBinningMin,fSpdBinningMax));  
 
-    fHistList->Add(new TH2F("fCorrSpdOuterTpcNch"," N_{ch}^{TPC} vs N_{clusters}^{SPD}_{Outer};N_{ch}^{TPC};N_{clusters}^{SPD}",   
+    AddHist(kHCorrSpdOuterTpcNch, new TH2F("fCorrSpdOuterTpcNch"," N_{ch}^{TPC} vs N_{clusters}^{SPD}_{Outer};N_{ch}^{TPC};N_{clusters}^{SPD}",   
 			    fTpcBinning,fTpcBinningMin,fTpcBinningMax, fSpdBinning,fSpdBinningMin,fSpdBinningMax));  
   }
   // ----------------------------------------------------
@@ -356,11 +377,11 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
   // ----------------------------------------------------
   if ( fProcessSPD && fProcessVZERO ) {
 
-    fHistList->Add(new TH2F("fCorrVzeroSpd", 
+    AddHist(kHCorrVzeroSpd, new TH2F("fCorrVzeroSpd", 
 			    "Multiplicity^{VZERO} vs N_{ch}^{SPD};Multiplicity^{VZERO};N^{SPD}", 
 			    fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax, fSpdBinning,fSpdBinningMin,fSpdBinningMax));
     
-    fHistList->Add(new TH2F("fCorrVzeroSpdOuter", 
+    AddHist(kHCorrVzeroSpdOuter, new TH2F("fCorrVzeroSpdOuter", 
 			    "Multiplicity^{VZERO} vs N_{ch}^{SPD}_{Outer};Multiplicity^{VZERO};N^{SPD}", 
 			    fVzeroBinning,fVzeroBinningMin,fVzeroBinningMax, fSpdBinning,fSpdBinningMin,fSpdBinningMax));
   }
@@ -370,10 +391,10 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
   if ( fProcessSPD && fProcessZDC) {
 
     // E_{ZDC} vs Multiplicity SPD
-    fHistList->Add(new TH2F("fCorrEzdcSpd", "E_{ZDC} vs N_{ch}^{SPD};E_{ZDC} (TeV);N^{SPD}",   
+    AddHist(kHCorrEzdcSpd, new TH2F("fCorrEzdcSpd", "E_{ZDC} vs N_{ch}^{SPD};E_{ZDC} (TeV);N^{SPD}",   
 			    fZdcBinning,fZdcBinningMin,fZdcBinningMax, fSpdBinning,fSpdBinningMin,fSpdBinningMax));
 
-    fHistList->Add(new TH2F("fCorrEzdcSpdOuter", "E_{ZDC} vs N_{ch}^{SPD};E_{ZDC} (TeV);N^{SPD}",   
+    AddHist(kHCorrEzdcSpdOuter, new TH2F("fCorrEzdcSpdOuter", "E_{ZDC} vs N_{ch}^{SPD};E_{ZDC} (TeV);N^{SPD}",   
 			    fZdcBinning,fZdcBinningMin,fZdcBinningMax, fSpdBinning,fSpdBinningMin,fSpdBinningMax));
     
   }
@@ -385,17 +406,35 @@ Int_t AliMultiplicityCorrelations::SetupCorrelations() {
 Int_t AliMultiplicityCorrelations::SetupSPD() {
   // see header file for class documentation  
   
-  fHistList->Add(new TH1F("fSpdNClusters", "Multplicity_{SPD};Multplicity_{SPD};N_{Events}",   
+  AddHist(kHSpdNClusters, new TH1F("fSpdNClusters", "Multplicity_{SPD};Multplicity_{SPD};N_{Events}",   
 			  fSpdBinning,fSpdBinningMin,fSpdBinningMax));
 
-  fHistList->Add(new TH1F("fSpdNClustersInner", "Multplicity_{SPD} Layer 0;Multplicity_{SPD};N_{Events}",   
+  AddHist(kHSpdNClustersInner, new TH1F("fSpdNClustersInner", "Multplicity_{SPD} Layer 0;Multplicity_{SPD};N_{Events}",   
 			  fSpdBinning,fSpdBinningMin,fSpdBinningMax));
 
-  fHistList->Add(new TH1F("fSpdNClustersOuter", "Multplicity_{SPD} Layer 1;Multplicity_{SPD};N_{Events}",   
+  AddHist(kHSpdNClustersOuter, new TH1F("fSpdNClustersOuter", "Multplicity_{SPD} Layer 1;Multplicity_{SPD};N_{Events}",   
 			  fSpdBinning,fSpdBinningMin,fSpdBinningMax));
   return 0;
 }
 
+//##################################################################################
+void AliMultiplicityCorrelations::AddHist(Int_t idx, TH1* hist) {
+  // see header file for class documentation
+
+  if (idx >= kHCorrFirst) {
+    if (!fCorrHistNames.IsNull() &&
+        !(TString(" ") + fCorrHistNames + " ").Contains(TString(" ") + hist->GetName() + " ")) {
+      delete hist;
+      return;
+    }
+    if (fExtendCorrHist)
+      hist->SetCanExtend(TH1::kAllAxes);
+  }
+
+  fHist[idx] = hist;
+  fHistList->Add(hist);
+}
+
 /*
  * ---------------------------------------------------------------------------------
  *                               Process - private
@@ -458,20 +497,23 @@ Int_t AliMultiplicityCorrelations::ProcessTPC() {
   if ( nESD != 0 )
     ratio = nTPC/nESD;
 
-  (static_cast<TH2F*>(fHistList->FindObject("fTpcCorrNchAll")))->Fill(fTpcTracksA,fEsdTracksA);  
-  (static_cast<TH1F*>(fHistList->FindObject("fTpcRatioNchAll")))->Fill(ratio);
+  FillHist(kHTpcCorrNchAll, fTpcTracksA,fEsdTracksA);  
+  FillHist(kHTpcRatioNchAll, ratio);
 
   // Cleaning Cut tpcTracks and globalTracks
   if ( fEsdTracksA < (-39+0.5797*fTpcTracksA))
     return -3;
 
-  (static_cast<TH1F*>(fHistList->FindObject("fTpcNch0")))->Fill(fEsdTracks);
-  (static_cast<TH1F*>(fHistList->FindObject("fTpcNch1")))->Fill(fEsdTracksA);
-  (static_cast<TH1F*>(fHistList->FindObject("fTpcNch2")))->Fill(fTpcTracks);
-  (static_cast<TH1F*>(fHistList->FindObject("fTpcNch3")))->Fill(fTpcTracksA);
+  fEstimator[kEstNchTPC]    = fTpcTracksA;
+  fEstimator[kEstNchGlobal] = fEsdTracksA;
 
-  (static_cast<TH2F*>(fHistList->FindObject("fTpcCorrNch")))->Fill(fTpcTracksA,fEsdTracksA);
-  (static_cast<TH1F*>(fHistList->FindObject("fTpcRatioNch")))->Fill(ratio);
+  FillHist(kHTpcNch0, fEsdTracks);
+  FillHist(kHTpcNch1, fEsdTracksA);
+  FillHist(kHTpcNch2, fTpcTracks);
+  FillHist(kHTpcNch3, fTpcTracksA);
+
+  FillHist(kHTpcCorrNch, fTpcTracksA,fEsdTracksA);
+  FillHist(kHTpcRatioNch, ratio);
 
   return iResult;
 }
@@ -489,23 +531,27 @@ Int_t AliMultiplicityCorrelations::ProcessVZERO() {
   else
     fVzeroMult  = (fVzeroMultA+fVzeroMultC) * 0.85871;
 
-  (static_cast<TH1F*>(fHistList->FindObject("fVzeroMult")))->Fill(fVzeroMult);
-  (static_cast<TH1F*>(fHistList->FindObject("fVzeroMultUnCorr")))->Fill(fVzeroMultA+fVzeroMultC);
-  (static_cast<TH1F*>(fHistList->FindObject("fVzeroMultAC")))->Fill(fVzeroMultA,fVzeroMultC);
+  fEstimator[kEstVzero]  = fVzeroMult;
+  fEstimator[kEstVzeroA] = fVzeroMultA;
+  fEstimator[kEstVzeroC] = fVzeroMultC;
+
+  FillHist(kHVzeroMult, fVzeroMult);
+  FillHist(kHVzeroMultUnCorr, fVzeroMultA+fVzeroMultC);
+  FillHist(kHVzeroMultAC, fVzeroMultA,fVzeroMultC);
 
   // -- VZERO - TPC correlations
   if (fESDEvent->GetNumberOfTracks() > 0 && fProcessTPC) {
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrVzeroNch")))->Fill(fTpcTracksA,fVzeroMult);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrVzeroNchUnCorr")))->Fill(fTpcTracksA,fVzeroMultA+fVzeroMultC);
+    FillHist(kHCorrVzeroNch, fTpcTracksA,fVzeroMult);
+    FillHist(kHCorrVzeroNchUnCorr, fTpcTracksA,fVzeroMultA+fVzeroMultC);
 
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrVzeroESDNch")))->Fill(fEsdTracksA,fVzeroMult);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrVzeroESDNchUnCorr")))->Fill(fEsdTracksA,fVzeroMultA+fVzeroMultC);
+    FillHist(kHCorrVzeroESDNch, fEsdTracksA,fVzeroMult);
+    FillHist(kHCorrVzeroESDNchUnCorr, fEsdTracksA,fVzeroMultA+fVzeroMultC);
   }
 
   // -- VZERO - SPD correlations
   if (fESDEvent->GetNumberOfTracks() > 0 && fProcessSPD) {
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrVzeroSpd")))->Fill(fVzeroMult, fSpdNClusters);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrVzeroSpdOuter")))->Fill(fVzeroMult, fSpdNClustersOuter);
+    FillHist(kHCorrVzeroSpd, fVzeroMult, fSpdNClusters);
+    FillHist(kHCorrVzeroSpdOuter, fVzeroMult, fSpdNClustersOuter);
   }
   
   return iResult;
@@ -537,27 +583,30 @@ Int_t AliMultiplicityCorrelations::ProcessZDC() {
   //  Double_t zdcEzemC = fESDZDC->GetZDCEMEnergy(0) / 1000.;
   Double_t zdcEzem  = zdcEzemA + zdcEzemC;
 
-  (static_cast<TH1F*>(fHistList->FindObject("fZdcEzdc")))->Fill(zdcE);
+  fEstimator[kEstZdc] = zdcE;
+  fEstimator[kEstZem] = zdcEzem;
+
+  FillHist(kHZdcEzdc, zdcE);
   
-  (static_cast<TH1F*>(fHistList->FindObject("fZdcEzem")))->Fill(zdcEzem);
-  (static_cast<TH2F*>(fHistList->FindObject("fZdcEzemEzdc")))->Fill(zdcEzem, zdcE);
+  FillHist(kHZdcEzem, zdcEzem);
+  FillHist(kHZdcEzemEzdc, zdcEzem, zdcE);
   
   // -- ZDC - TPC correlations
   if (fESDEvent->GetNumberOfTracks() > 0 && fProcessTPC) {
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrEzdcNch")))->Fill(fTpcTracksA, zdcE);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrEzemNch")))->Fill(fTpcTracksA, zdcEzem);
+    FillHist(kHCorrEzdcNch, fTpcTracksA, zdcE);
+    FillHist(kHCorrEzemNch, fTpcTracksA, zdcEzem);
   }
   
   // -- ZDC - SPD correlations
   if (fProcessSPD) {
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrEzdcSpd")))->Fill(zdcE, fSpdNClusters);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrEzdcSpdOuter")))->Fill(zdcE, fSpdNClustersOuter);
+    FillHist(kHCorrEzdcSpd, zdcE, fSpdNClusters);
+    FillHist(kHCorrEzdcSpdOuter, zdcE, fSpdNClustersOuter);
   }
 
   // -- VZERO - ZDC correlations
   if (fESDVZERO && fProcessVZERO) {
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrEzdcVzero")))->Fill(zdcE, fVzeroMult);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrEzemVzero")))->Fill(zdcEzem, fVzeroMult);
+    FillHist(kHCorrEzdcVzero, zdcE, fVzeroMult);
+    FillHist(kHCorrEzemVzero, zdcEzem, fVzeroMult);
   }
 
   return iResult;
@@ -581,19 +630,46 @@ Int_t AliMultiplicityCorrelations::ProcessSPD() {
 
   fSpdNClusters      = fSpdNClustersOuter + fSpdNClustersInner;
 
-  (static_cast<TH1F*>(fHistList->FindObject("fSpdNClusters")))->Fill(fSpdNClusters);
-  (static_cast<TH1F*>(fHistList->FindObject("fSpdNClustersInner")))->Fill(fSpdNClustersInner);
-  (static_cast<TH1F*>(fHistList->FindObject("fSpdNClustersOuter")))->Fill(fSpdNClustersOuter);
+  fEstimator[kEstSpd]      = fSpdNClusters;
+  fEstimator[kEstSpdOuter] = fSpdNClustersOuter;
+
+  FillHist(kHSpdNClusters, fSpdNClusters);
+  FillHist(kHSpdNClustersInner, fSpdNClustersInner);
+  FillHist(kHSpdNClustersOuter, fSpdNClustersOuter);
   
   // -- SPD vs TPC correlations
   if (fProcessTPC) {
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrSpdTpcNch")))->Fill(fTpcTracksA, fSpdNClusters);
-    (static_cast<TH2F*>(fHistList->FindObject("fCorrSpdOuterTpcNch")))->Fill(fTpcTracksA, fSpdNClustersOuter);
+    FillHist(kHCorrSpdTpcNch, fTpcTracksA, fSpdNClusters);
+    FillHist(kHCorrSpdOuterTpcNch, fTpcTracksA, fSpdNClustersOuter);
   }
 
   return 0;
 }
 
+//##################################################################################
+void AliMultiplicityCorrelations::FillCovariance() {
+  // see header file for class documentation
+
+  fCovariance->Fill(fEstimator);
+
+  if (fCovTimeSlice == 0)
+    return;
+
+  // -- per run and time slice, looked up only when the slice changes
+  const UInt_t sliceIdx = fESDEvent->GetTimeStamp() / fCovTimeSlice;
+  if (!fCovSlice || fCovSliceRun != fCurrentRunNo || fCovSliceIdx != sliceIdx) {
+    fCovSliceRun = fCurrentRunNo;
+    fCovSliceIdx = sliceIdx;
+    TString name(Form("fCovariance_Run%d_T%u", fCovSliceRun, sliceIdx * fCovTimeSlice));
+    fCovSlice = static_cast<AliMultiplicityCovariance*>(fHistList->FindObject(name));
+    if (!fCovSlice) {
+      fCovSlice = new AliMultiplicityCovariance(name, kNEstimators, fgkEstimatorNames);
+      fHistList->Add(fCovSlice);
+    }
+  }
+  fCovSlice->Fill(fEstimator);
+}
+
 //##################################################################################
 Float_t AliMultiplicityCorrelations::GetCorrVZERO(Float_t &v0CorrResc) {
   // correct V0 non-linearity, prepare a version rescaled to SPD2 corr
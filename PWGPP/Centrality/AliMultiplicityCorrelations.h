@@ -19,11 +19,26 @@
 #include "AliESDZDC.h"
 #include "AliMultiplicity.h"
 #include "TList.h"
+#include "TH1.h"
 
-class TH1;
+class AliMultiplicityCovariance;
 
 class AliMultiplicityCorrelations : public TNamed {
 public:
+
+  /** Multiplicity estimators of the streaming covariance */
+  enum EEstimator {
+    kEstNchTPC,      // accepted TPC tracks
+    kEstNchGlobal,   // accepted global tracks
+    kEstVzero,       // corrected VZERO multiplicity
+    kEstVzeroA,      // VZERO A multiplicity
+    kEstVzeroC,      // VZERO C multiplicity
+    kEstSpd,         // SPD clusters
+    kEstSpdOuter,    // SPD clusters outer layer
+    kEstZdc,         // E_{ZDC}
+    kEstZem,         // E_{ZEM}
+    kNEstimators
+  };
   
   /*
    * ---------------------------------------------------------------------------------
@@ -101,6 +116,17 @@ public:
   void SetProcessZDC(Bool_t b = kTRUE)  { fProcessZDC = b; }
   void SetProcessVZERO(Bool_t b = kTRUE){ fProcessVZERO = b; }
 
+  /** Keep only the listed estimator-vs-estimator histograms
+   *  (space separated names, e.g. "fCorrVzeroNch fCorrEzdcSpd"), "" keeps all.
+   *  The covariance of all estimators is always accumulated. */
+  void SetCorrelationHistograms(const Char_t* names) { fCorrHistNames = names; }
+
+  /** Let the kept correlation histograms extend their axes to the data */
+  void SetExtendCorrelationHistograms(Bool_t b = kTRUE) { fExtendCorrHist = b; }
+
+  /** Accumulate the covariance also per run and time slice of the given length (s), 0: off */
+  void SetCovarianceTimeSlice(UInt_t seconds) { fCovTimeSlice = seconds; }
+
   /*
    * ---------------------------------------------------------------------------------
    *                                 Getter - public
@@ -115,6 +141,11 @@ public:
   Float_t GetVZEROC()      const { return fVzeroMultC; }
   Float_t GetVZEROCorr()   const { return fVzeroMult; }
 
+  /** Covariance of all estimators over all processed events */
+  AliMultiplicityCovariance* GetCovariance() const { return fCovariance; }
+
+  static const Char_t* GetEstimatorName(Int_t i) { return fgkEstimatorNames[i]; }
+
   /*
    * ---------------------------------------------------------------------------------
    *                             Process - public
@@ -133,7 +164,44 @@ public:
   Float_t GetCorrSPD2(Float_t spd2raw,Float_t zv) const;
 
  private:
- 
+
+  /** Histograms, correlation histograms last */
+  enum EHist {
+    kHVzeroMult,
+    kHVzeroMultUnCorr,
+    kHVzeroMultAC,
+    kHZdcEzdc,
+    kHZdcEzem,
+    kHZdcEzemEzdc,
+    kHTpcNch0,
+    kHTpcNch1,
+    kHTpcNch2,
+    kHTpcNch3,
+    kHTpcCorrNch,
+    kHTpcRatioNch,
+    kHTpcCorrNchAll,
+    kHTpcRatioNchAll,
+    kHSpdNClusters,
+    kHSpdNClustersInner,
+    kHSpdNClustersOuter,
+    kHCorrEzdcNch,
+    kHCorrEzemNch,
+    kHCorrEzdcVzero,
+    kHCorrEzemVzero,
+    kHCorrVzeroNch,
+    kHCorrVzeroNchUnCorr,
+    kHCorrVzeroESDNch,
+    kHCorrVzeroESDNchUnCorr,
+    kHCorrSpdTpcNch,
+    kHCorrSpdOuterTpcNch,
+    kHCorrVzeroSpd,
+    kHCorrVzeroSpdOuter,
+    kHCorrEzdcSpd,
+    kHCorrEzdcSpdOuter,
+    kNHist,
+    kHCorrFirst = kHCorrEzdcNch
+  };
+
   /** copy constructor prohibited */
   AliMultiplicityCorrelations(const AliMultiplicityCorrelations&);
   
@@ -170,6 +238,13 @@ public:
   /** Setup SPD histograms */
   Int_t SetupSPD();
 
+  /** Add histogram to the list, unless it is a correlation histogram not requested */
+  void AddHist(Int_t idx, TH1* hist);
+
+  /** Fill histogram if present */
+  void FillHist(Int_t idx, Double_t x)             { if (fHist[idx]) fHist[idx]->Fill(x); }
+  void FillHist(Int_t idx, Double_t x, Double_t y) { if (fHist[idx]) fHist[idx]->Fill(x, y); }
+
   /*
    * ---------------------------------------------------------------------------------
    *                             Process - private
@@ -187,6 +262,9 @@ public:
 
   /** Process current event - ZDC and correlations */
   Int_t ProcessZDC();
+
+  /** Add the estimators of the current event to the covariance accumulators */
+  void FillCovariance();
   
   /*
    * ---------------------------------------------------------------------------------
@@ -195,6 +273,7 @@ public:
    */
 
   TList           *fHistList;             //  List of histograms
+  TH1             *fHist[kNHist];         //! Histograms in fHistList, NULL if not kept
 
   Bool_t           fIsMC;                 //  If it is MC 
 
@@ -265,7 +344,21 @@ public:
   Int_t   fSpdBinning;                    // SPD Binning nbin
   Float_t fSpdBinningMin;                 // SPD Binning min
   Float_t fSpdBinningMax;                 // SPD Binning max
+
+  // -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- 
+
+  TString  fCorrHistNames;                // Correlation histograms to keep, "" for all
+  Bool_t   fExtendCorrHist;               // Extend axes of correlation histograms
+  UInt_t   fCovTimeSlice;                 // Time slice length (s) of the covariance, 0: off
+
+  Double_t fEstimator[kNEstimators];      //! Estimators of the current event
+  AliMultiplicityCovariance *fCovariance; //! Covariance over all events, in fHistList
+  AliMultiplicityCovariance *fCovSlice;   //! Covariance of the current run and time slice
+  Int_t    fCovSliceRun;                  //! Run of fCovSlice
+  UInt_t   fCovSliceIdx;                  //! Time slice index of fCovSlice
+
+  static const Char_t* fgkEstimatorNames[kNEstimators]; // Estimator names
   
-  ClassDef(AliMultiplicityCorrelations, 3);
+  ClassDef(AliMultiplicityCorrelations, 4);
 };
 #endif
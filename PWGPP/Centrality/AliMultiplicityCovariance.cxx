@@ -0,0 +1,149 @@
+//-*- Mode: C++ -*-
+
+#include "TMath.h"
+#include "TH2D.h"
+#include "TObjString.h"
+#include "TCollection.h"
+
+#include "AliLog.h"
+#include "AliMultiplicityCovariance.h"
+
+// Streaming covariance of multiplicity estimators
+//
+// The means and co-moments are updated per entry (Welford), so that
+// no per-event information has to be kept. Accumulators of different
+// jobs are combined with the pairwise update of Chan et al.
+
+/** ROOT macro for the implementation of ROOT specific class methods */
+ClassImp(AliMultiplicityCovariance)
+
+//##################################################################################
+AliMultiplicityCovariance::AliMultiplicityCovariance() :
+  TNamed(),
+  fNVar(0), fN(0.),
+  fMean(), fCoMoment(), fVarNames(), fDelta() {
+  // see header file for class documentation
+
+  fVarNames.SetOwner(kTRUE);
+}
+
+//##################################################################################
+AliMultiplicityCovariance::AliMultiplicityCovariance(const Char_t* name, Int_t n, const Char_t** varNames) :
+  TNamed(name, name),
+  fNVar(n), fN(0.),
+  fMean(n), fCoMoment(n*(n+1)/2), fVarNames(n), fDelta(n) {
+  // see header file for class documentation
+
+  fVarNames.SetOwner(kTRUE);
+  for (Int_t i = 0; i < n; ++i)
+    fVarNames.AddAt(new TObjString(varNames ? varNames[i] : Form("x%d", i)), i);
+}
+
+//##################################################################################
+void AliMultiplicityCovariance::Fill(const Double_t *x) {
+  // see header file for class documentation
+
+  if (fDelta.GetSize() != fNVar)
+    fDelta.Set(fNVar);
+
+  fN += 1.;
+  for (Int_t i = 0; i < fNVar; ++i) {
+    fDelta[i] = x[i] - fMean[i];
+    fMean[i] += fDelta[i] / fN;
+  }
+  // C_ij += (x_i - <x_i>_old) (x_j - <x_j>_new)
+  Double_t *c = fCoMoment.GetArray();
+  for (Int_t i = 0; i < fNVar; ++i)
+    for (Int_t j = i; j < fNVar; ++j)
+      *c++ += fDelta[i] * (x[j] - fMean[j]);
+}
+
+//##################################################################################
+Long64_t AliMultiplicityCovariance::Merge(TCollection *list) {
+  // see header file for class documentation
+
+  if (!list)
+    return 0;
+
+  TIter next(list);
+  const AliMultiplicityCovariance *o = NULL;
+  Long64_t nMerged = 0;
+  while ((o = dynamic_cast<const AliMultiplicityCovariance*>(next()))) {
+    if (o->fNVar != fNVar) {
+      AliError(Form("Cannot merge %s: %d variables instead of %d", o->GetName(), o->fNVar, fNVar));
+      continue;
+    }
+    if (o->fN <= 0.)
+      continue;
+
+    const Double_t nA = fN;
+    const Double_t nB = o->fN;
+    const Double_t n  = nA + nB;
+    Int_t k = 0;
+    for (Int_t i = 0; i < fNVar; ++i) {
+      const Double_t di = o->fMean[i] - fMean[i];
+      for (Int_t j = i; j < fNVar; ++j, ++k) {
+        const Double_t dj = o->fMean[j] - fMean[j];
+        fCoMoment[k] += o->fCoMoment[k] + di * dj * nA * nB / n;
+      }
+    }
+    for (Int_t i = 0; i < fNVar; ++i)
+      fMean[i] += (o->fMean[i] - fMean[i]) * nB / n;
+    fN = n;
+    ++nMerged;
+  }
+  return nMerged;
+}
+
+//##################################################################################
+void AliMultiplicityCovariance::Reset() {
+  // see header file for class documentation
+
+  fN = 0.;
+  fMean.Reset();
+  fCoMoment.Reset();
+}
+
+//##################################################################################
+Double_t AliMultiplicityCovariance::GetCovariance(Int_t i, Int_t j) const {
+  // see header file for class documentation
+
+  return (fN > 1.) ? fCoMoment[Index(i, j)] / (fN - 1.) : 0.;
+}
+
+//##################################################################################
+Double_t AliMultiplicityCovariance::GetCorrelation(Int_t i, Int_t j) const {
+  // see header file for class documentation
+
+  const Double_t vii = fCoMoment[Index(i, i)];
+  const Double_t vjj = fCoMoment[Index(j, j)];
+  if (vii <= 0. || vjj <= 0.)
+    return 0.;
+  return fCoMoment[Index(i, j)] / TMath::Sqrt(vii * vjj);
+}
+
+//##################################################################################
+const Char_t* AliMultiplicityCovariance::GetVariableName(Int_t i) const {
+  // see header file for class documentation
+
+  const TObjString *s = static_cast<const TObjString*>(fVarNames.At(i));
+  return s ? s->GetString().Data() : "";
+}
+
+//##################################################################################
+TH2D* AliMultiplicityCovariance::MakeCorrelationMatrix() const {
+  // see header file for class documentation
+
+  TH2D *h = new TH2D(Form("%s_Correlation", GetName()), Form("%s correlation matrix", GetTitle()),
+                     fNVar, 0., fNVar, fNVar, 0., fNVar);
+  h->SetDirectory(0);
+  h->SetStats(0);
+  for (Int_t i = 0; i < fNVar; ++i) {
+    h->GetXaxis()->SetBinLabel(i+1, GetVariableName(i));
+    h->GetYaxis()->SetBinLabel(i+1, GetVariableName(i));
+    for (Int_t j = 0; j < fNVar; ++j)
+      h->SetBinContent(i+1, j+1, GetCorrelation(i, j));
+  }
+  h->SetEntries(fN);
+  return h;
+}
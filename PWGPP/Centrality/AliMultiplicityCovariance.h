@@ -0,0 +1,73 @@
+//-*- Mode: C++ -*-
+
+#ifndef ALIMULTIPLICITYCOVARIANCE_H
+#define ALIMULTIPLICITYCOVARIANCE_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+// Streaming mean / covariance / correlation of a fixed set of
+// multiplicity estimators, mergeable across jobs
+// Used by AliMultiplicityCorrelations
+
+#include "TNamed.h"
+#include "TArrayD.h"
+#include "TObjArray.h"
+
+class TCollection;
+class TH2D;
+
+class AliMultiplicityCovariance : public TNamed {
+public:
+
+  /** Default Constructor */
+  AliMultiplicityCovariance();
+
+  /** Constructor for n variables */
+  AliMultiplicityCovariance(const Char_t* name, Int_t n, const Char_t** varNames = NULL);
+
+  /** Destructor */
+  virtual ~AliMultiplicityCovariance() {}
+
+  /** Add one entry, x has GetNVariables() values */
+  void Fill(const Double_t *x);
+
+  /** Merge with other accumulators (pairwise update of the co-moments) */
+  Long64_t Merge(TCollection *list);
+
+  /** Reset all sums */
+  void Reset();
+
+  Int_t    GetNVariables()   const { return fNVar; }
+  Double_t GetEntries()      const { return fN; }
+  Double_t GetMean(Int_t i)  const { return fMean[i]; }
+  Double_t GetCovariance(Int_t i, Int_t j) const;
+  Double_t GetCorrelation(Int_t i, Int_t j) const;
+  const Char_t* GetVariableName(Int_t i) const;
+
+  /** Correlation matrix as 2D histogram, labelled with the variable names */
+  TH2D* MakeCorrelationMatrix() const;
+
+private:
+
+  /** copy constructor prohibited */
+  AliMultiplicityCovariance(const AliMultiplicityCovariance&);
+
+  /** assignment operator prohibited */
+  AliMultiplicityCovariance& operator=(const AliMultiplicityCovariance&);
+
+  /** Index of (i,j) in the packed upper triangle */
+  Int_t Index(Int_t i, Int_t j) const {
+    return (i <= j) ? i*fNVar - i*(i-1)/2 + (j-i) : Index(j, i);
+  }
+
+  Int_t     fNVar;               //  Number of variables
+  Double_t  fN;                  //  Number of entries
+  TArrayD   fMean;               //  Running means
+  TArrayD   fCoMoment;           //  Sum (x_i-<x_i>)(x_j-<x_j>), packed upper triangle
+  TObjArray fVarNames;           //  Names of the variables (TObjString)
+  TArrayD   fDelta;              //! Work array
+
+  ClassDef(AliMultiplicityCovariance, 1);
+};
+#endif
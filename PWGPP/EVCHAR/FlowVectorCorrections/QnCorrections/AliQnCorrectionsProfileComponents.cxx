@@ -5,6 +5,7 @@
 
 #include "AliQnCorrectionsEventClassVariablesSet.h"
 #include "AliQnCorrectionsProfileComponents.h"
+#include "AliQnCorrectionsQnVector.h"
 #include "AliLog.h"
 
 /// \cond CLASSIMP
@@ -21,6 +22,10 @@ AliQnCorrectionsProfileComponents::AliQnCorrectionsProfileComponents() :
   fYharmonicFillMask = 0x0000;
   fFullFilled = 0x0000;
   fEntries = NULL;
+  fCorrectionTable = NULL;
+  fValidatedTable = NULL;
+  fNoOfTableBins = 0;
+  fNoOfTableSlots = 0;
 }
 
 /// Normal constructor
@@ -50,6 +55,10 @@ AliQnCorrectionsProfileComponents::AliQnCorrectionsProfileComponents(const char
   fYharmonicFillMask = 0x0000;
   fFullFilled = 0x0000;
   fEntries = NULL;
+  fCorrectionTable = NULL;
+  fValidatedTable = NULL;
+  fNoOfTableBins = 0;
+  fNoOfTableSlots = 0;
 }
 
 /// Default destructor
@@ -62,6 +71,62 @@ AliQnCorrectionsProfileComponents::~AliQnCorrectionsProfileComponents() {
     delete [] fXValues;
   if (fYValues != NULL)
     delete [] fYValues;
+  DeleteCorrectionTable();
+}
+
+/// Releases the precomputed correction table if any
+void AliQnCorrectionsProfileComponents::DeleteCorrectionTable() {
+  if (fCorrectionTable != NULL)
+    delete [] fCorrectionTable;
+  if (fValidatedTable != NULL)
+    delete [] fValidatedTable;
+  fCorrectionTable = NULL;
+  fValidatedTable = NULL;
+  fNoOfTableBins = 0;
+  fNoOfTableSlots = 0;
+}
+
+/// Builds the precomputed correction table from the attached histograms
+///
+/// For each event class bin the validation status and, for each
+/// harmonic, the X, Y components averages and errors are stored
+/// contiguously so that a correction step gets all the information
+/// of one event class with a single indexed read.
+/// The table content is obtained with the regular getters so it is
+/// identical to what they return without the table.
+void AliQnCorrectionsProfileComponents::BuildCorrectionTable() {
+  DeleteCorrectionTable();
+
+  /* the highest harmonic actually present */
+  Int_t nHigherHarmonic = 0;
+  for (Int_t h = 1; h <= nMaxHarmonicNumberSupported; h++) {
+    if (fFullFilled & harmonicNumberMask[h]) nHigherHarmonic = h;
+  }
+  if (nHigherHarmonic == 0) return;
+
+  Long64_t nBins = fEntries->GetNbins();
+  Int_t nSlots = nHigherHarmonic + 1;
+  Float_t *table = new Float_t[nBins * nSlots * kNoOfTableColumns];
+  Bool_t *validated = new Bool_t[nBins];
+
+  for (Long64_t bin = 0; bin < nBins; bin++) {
+    validated[bin] = BinContentValidated(bin);
+    for (Int_t h = 0; h < nSlots; h++) {
+      Float_t *entry = table + (bin * nSlots + h) * kNoOfTableColumns;
+      for (Int_t col = 0; col < kNoOfTableColumns; col++)
+        entry[col] = 0.0;
+      if (!validated[bin] || !(fFullFilled & harmonicNumberMask[h])) continue;
+      entry[kTableX] = GetXBinContent(h, bin);
+      entry[kTableY] = GetYBinContent(h, bin);
+      entry[kTableXError] = GetXBinError(h, bin);
+      entry[kTableYError] = GetYBinError(h, bin);
+    }
+  }
+  /* only now the getters will start using the table */
+  fCorrectionTable = table;
+  fValidatedTable = validated;
+  fNoOfTableBins = nBins;
+  fNoOfTableSlots = nSlots;
 }
 
 /// Creates the X, Y components support histograms for the profile function
@@ -234,6 +299,7 @@ Bool_t AliQnCorrectionsProfileComponents::AttachHistograms(TList *histogramList)
   fXharmonicFillMask = 0x0000;
   fYharmonicFillMask = 0x0000;
   fFullFilled = 0x0000;
+  DeleteCorrectionTable();
 
   fEntries = (THnI *) histogramList->FindObject((const char*) entriesHistoName);
   if (fEntries != NULL && fEntries->GetEntries() != 0) {
@@ -258,8 +324,10 @@ Bool_t AliQnCorrectionsProfileComponents::AttachHistograms(TList *histogramList)
     return kFALSE;
 
   /* check that we actually got something */
-  if (fFullFilled != 0x0000)
+  if (fFullFilled != 0x0000) {
+    BuildCorrectionTable();
     return kTRUE;
+  }
   else
     return kFALSE;
 }
@@ -284,6 +352,10 @@ Long64_t AliQnCorrectionsProfileComponents::GetBin(const Float_t *variableContai
 /// \param bin the bin to check its content validity
 /// \return kTRUE if the content is valid kFALSE otherwise
 Bool_t AliQnCorrectionsProfileComponents::BinContentValidated(Long64_t bin) {
+  if (fValidatedTable != NULL) {
+    return fValidatedTable[bin];
+  }
+
   Int_t nEntries = Int_t(fEntries->GetBinContent(bin));
 
   if (nEntries < fMinNoOfEntriesToValidate) {
@@ -311,6 +383,10 @@ Float_t AliQnCorrectionsProfileComponents::GetXBinContent(Int_t harmonic, Long64
     return 0.0;
   }
 
+  if (fCorrectionTable != NULL) {
+    return fCorrectionTable[TableIndex(harmonic, bin) + kTableX];
+  }
+
   if (!BinContentValidated(bin)) {
     return 0.0;
   }
@@ -337,6 +413,10 @@ Float_t AliQnCorrectionsProfileComponents::GetYBinContent(Int_t harmonic, Long64
     return 0.0;
   }
 
+  if (fCorrectionTable != NULL) {
+    return fCorrectionTable[TableIndex(harmonic, bin) + kTableY];
+  }
+
   if (!BinContentValidated(bin)) {
     return 0.0;
   }
@@ -363,6 +443,10 @@ Float_t AliQnCorrectionsProfileComponents::GetXBinError(Int_t harmonic, Long64_t
     return 0.0;
   }
 
+  if (fCorrectionTable != NULL) {
+    return fCorrectionTable[TableIndex(harmonic, bin) + kTableXError];
+  }
+
   if (!BinContentValidated(bin)) {
     return 0.0;
   }
@@ -405,6 +489,10 @@ Float_t AliQnCorrectionsProfileComponents::GetYBinError(Int_t harmonic, Long64_t
     return 0.0;
   }
 
+  if (fCorrectionTable != NULL) {
+    return fCorrectionTable[TableIndex(harmonic, bin) + kTableYError];
+  }
+
   if (!BinContentValidated(bin)) {
     return 0.0;
   }
@@ -517,3 +605,46 @@ void AliQnCorrectionsProfileComponents::FillY(Int_t harmonic, const Float_t *var
 }
 
 
+
+/// Fills the X and Y components of all the harmonics of a Qn vector
+///
+/// Equivalent to calling FillX and FillY for each of the Qn vector
+/// harmonics but the event class bin is searched only once. The Qn
+/// vector harmonics have to match the harmonics of the profile,
+/// otherwise the regular per component filling is used.
+///
+/// \param qnVector the Qn vector whose components are to be filled
+/// \param variableContainer the current variables content addressed by var Id
+void AliQnCorrectionsProfileComponents::FillQnVector(const AliQnCorrectionsQnVector *qnVector, const Float_t *variableContainer) {
+  /* check the harmonics match and there is no ongoing per component filling */
+  UInt_t qnMask = 0x0000;
+  Int_t harmonic = qnVector->GetFirstHarmonic();
+  while (harmonic != -1) {
+    qnMask |= harmonicNumberMask[harmonic];
+    harmonic = qnVector->GetNextHarmonic(harmonic);
+  }
+
+  if ((qnMask != fFullFilled) || (fXharmonicFillMask != 0x0000) || (fYharmonicFillMask != 0x0000)) {
+    harmonic = qnVector->GetFirstHarmonic();
+    while (harmonic != -1) {
+      FillX(harmonic, variableContainer, qnVector->Qx(harmonic));
+      FillY(harmonic, variableContainer, qnVector->Qy(harmonic));
+      harmonic = qnVector->GetNextHarmonic(harmonic);
+    }
+    return;
+  }
+
+  /* all histograms share the same binning so the bin is good for all of them */
+  Long64_t bin = GetBin(variableContainer);
+  harmonic = qnVector->GetFirstHarmonic();
+  while (harmonic != -1) {
+    Double_t nXEntries = fXValues[harmonic]->GetEntries();
+    Double_t nYEntries = fYValues[harmonic]->GetEntries();
+    fXValues[harmonic]->FillBin(bin, qnVector->Qx(harmonic));
+    fYValues[harmonic]->FillBin(bin, qnVector->Qy(harmonic));
+    fXValues[harmonic]->SetEntries(nXEntries + 1);
+    fYValues[harmonic]->SetEntries(nYEntries + 1);
+    harmonic = qnVector->GetNextHarmonic(harmonic);
+  }
+  fEntries->FillBin(bin, 1.0);
+}
@@ -6,6 +6,8 @@
 
 #include "AliQnCorrectionsHistogramBase.h"
 
+class AliQnCorrectionsQnVector;
+
 /// \class AliQnCorrectionsProfileComponents
 /// \brief Base class for the components based set of profiles
 ///
@@ -35,6 +37,15 @@
 /// component before the whole set is filled you will get an execution
 /// error because you are doing something that shall be corrected
 ///
+/// Once histograms are attached as input for a correction step, the
+/// averages and errors of all harmonics are precomputed for every
+/// event class. The bin content and error getters then become a single
+/// indexed read of that table instead of several multidimensional
+/// histogram accesses per harmonic.
+///
+/// FillQnVector fills the components of all harmonics of a Qn vector
+/// with only one event class bin search.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -66,16 +77,37 @@ public:
 
   virtual void FillX(Int_t harmonic, const Float_t *variableContainer, Float_t weight);
   virtual void FillY(Int_t harmonic, const Float_t *variableContainer, Float_t weight);
+  void FillQnVector(const AliQnCorrectionsQnVector *qnVector, const Float_t *variableContainer);
 
 private:
+  void BuildCorrectionTable();
+  void DeleteCorrectionTable();
+  /// the position of the harmonic components of an event class bin within the correction table
+  /// \param harmonic the interested external harmonic number
+  /// \param bin the interested bin number
+  Long64_t TableIndex(Int_t harmonic, Long64_t bin) const { return (bin * fNoOfTableSlots + harmonic) * kNoOfTableColumns; }
+
+  /// the columns stored for each harmonic in the correction table
+  enum TableColumns {
+    kTableX,         ///< X component average
+    kTableY,         ///< Y component average
+    kTableXError,    ///< X component error
+    kTableYError,    ///< Y component error
+    kNoOfTableColumns
+  };
+
   THnF **fXValues;            //!<! X component histogram for each requested harmonic
   THnF **fYValues;            //!<! Y component histogram for each requested harmonic
   UInt_t fXharmonicFillMask;  //!<! keeps track of harmonic X component filled values
   UInt_t fYharmonicFillMask;  //!<! keeps track of harmonic Y component filled values
   UInt_t fFullFilled;         //!<! mask for the fully filled condition
   THnI  *fEntries;            //!<! Cumulates the number on each of the event classes
+  Float_t *fCorrectionTable;  //!<! precomputed averages and errors for each event class and harmonic
+  Bool_t *fValidatedTable;    //!<! precomputed validation status for each event class
+  Long64_t fNoOfTableBins;    //!<! number of event class bins in the correction table
+  Int_t fNoOfTableSlots;      //!<! number of harmonic slots per event class in the correction table
   /// \cond CLASSIMP
-  ClassDef(AliQnCorrectionsProfileComponents, 1);
+  ClassDef(AliQnCorrectionsProfileComponents, 2);
   /// \endcond
 };
 
@@ -236,18 +236,12 @@ Bool_t AliQnCorrectionsQnVectorRecentering::ProcessCorrections(const Float_t *va
 /// Pure virtual function
 /// \return kTRUE if the correction step was applied
 Bool_t AliQnCorrectionsQnVectorRecentering::ProcessDataCollection(const Float_t *variableContainer) {
-  Int_t harmonic;
   switch (fState) {
   case QCORRSTEP_calibration:
     AliInfo(Form("Recentering process in detector %s: collecting data.", fDetectorConfiguration->GetName()));
     /* collect the data needed to further produce correction parameters if the current Qn vector is good enough */
     if (fInputQnVector->IsGoodQuality()) {
-      harmonic = fInputQnVector->GetFirstHarmonic();
-      while (harmonic != -1) {
-        fCalibrationHistograms->FillX(harmonic,variableContainer,fInputQnVector->Qx(harmonic));
-        fCalibrationHistograms->FillY(harmonic,variableContainer,fInputQnVector->Qy(harmonic));
-        harmonic = fInputQnVector->GetNextHarmonic(harmonic);
-      }
+      fCalibrationHistograms->FillQnVector(fInputQnVector, variableContainer);
     }
     /* we have not perform any correction yet */
     return kFALSE;
@@ -256,23 +250,13 @@ Bool_t AliQnCorrectionsQnVectorRecentering::ProcessDataCollection(const Float_t
     AliInfo(Form("Recentering process in detector %s: collecting data.", fDetectorConfiguration->GetName()));
     /* collect the data needed to further produce correction parameters if the current Qn vector is good enough */
     if (fInputQnVector->IsGoodQuality()) {
-      harmonic = fInputQnVector->GetFirstHarmonic();
-      while (harmonic != -1) {
-        fCalibrationHistograms->FillX(harmonic,variableContainer,fInputQnVector->Qx(harmonic));
-        fCalibrationHistograms->FillY(harmonic,variableContainer,fInputQnVector->Qy(harmonic));
-        harmonic = fInputQnVector->GetNextHarmonic(harmonic);
-      }
+      fCalibrationHistograms->FillQnVector(fInputQnVector, variableContainer);
     }
     /* and proceed to ... */
   case QCORRSTEP_apply: /* apply the correction if the current Qn vector is good enough */
     /* provide QA info if required */
     if (fQAQnAverageHistogram != NULL) {
-      harmonic = fCorrectedQnVector->GetFirstHarmonic();
-      while (harmonic != -1) {
-        fQAQnAverageHistogram->FillX(harmonic, variableContainer, fCorrectedQnVector->Qx(harmonic));
-        fQAQnAverageHistogram->FillY(harmonic, variableContainer, fCorrectedQnVector->Qy(harmonic));
-        harmonic = fCorrectedQnVector->GetNextHarmonic(harmonic);
-      }
+      fQAQnAverageHistogram->FillQnVector(fCorrectedQnVector, variableContainer);
     }
     break;
   default:
@@ -24,6 +24,8 @@
 #include <TGeoGlobalMagField.h>
 #include "AliESDInputHandlerRP.h"
 #include "AliITSSumTP.h"
+#include "AliITSResidualAccumulator.h"
+#include "AliITSCompactTrackPoints.h"
 #include "AliMagF.h"
 
 /**************************************************************************
@@ -65,6 +67,8 @@ AliAnalysisTaskITSAlignQA::AliAnalysisTaskITSAlignQA() : AliAnalysisTaskSE("SDD
   fDoSDDVDriftCalib(kTRUE),
   fDoSDDDriftTime(kTRUE),
   fDoFillTPTree(kFALSE),
+  fCompactTPTree(kFALSE),
+  fDoResidualHistos(kTRUE),
   fUseITSsaTracks(kFALSE),
   fLoadGeometry(kFALSE),
   fUseVertex(kFALSE),
@@ -84,6 +88,8 @@ AliAnalysisTaskITSAlignQA::AliAnalysisTaskITSAlignQA() : AliAnalysisTaskSE("SDD
   fFitter(0),
   fITSSumTP(),
   fTPTree(),
+  fCompactTP(0),
+  fResidAcc(0),
   fRunNb(0),
   fOCDBLocation("local://$ALICE_ROOT/OCDB")
 {
@@ -104,6 +110,7 @@ AliAnalysisTaskITSAlignQA::~AliAnalysisTaskITSAlignQA(){
   }
   delete fFitter;
   delete fTPTree;
+  delete fCompactTP;
   //
 }
 //___________________________________________________________________________
@@ -131,9 +138,13 @@ void AliAnalysisTaskITSAlignQA::UserCreateOutputObjects() {
   fHistPtAccept->SetMinimum(0);
   fOutput->Add(fHistPtAccept);
 
-  if(fDoSPDResiduals) CreateSPDHistos();
+  if(fDoSPDResiduals || fDoSDDResiduals || fDoSSDResiduals) {
+    fResidAcc = new AliITSResidualAccumulator("ITSResiduals",kNSPDmods+kNSDDmods+kNSSDmods,fNPtBins,fPtBinLimits);
+    fOutput->Add(fResidAcc);
+  }
+  if(fDoSPDResiduals && fDoResidualHistos) CreateSPDHistos();
   if(fDoSDDResiduals || fDoSDDdEdxCalib || fDoSDDVDriftCalib || fDoSDDDriftTime) CreateSDDHistos();
-  if(fDoSSDResiduals) CreateSSDHistos();
+  if(fDoSSDResiduals && fDoResidualHistos) CreateSSDHistos();
   //
   if (fDoFillTPTree) {
     TFile* troutf = OpenFile(2);
@@ -141,9 +152,16 @@ void AliAnalysisTaskITSAlignQA::UserCreateOutputObjects() {
       AliFatal("Failed to open output file for AliITSSumTP tree");
       exit(1);
     }
-    fITSSumTP = new AliITSSumTP();
-    fTPTree = new TTree("ITSSumTP","ITS TP Summary");
-    fTPTree->Branch("AliITSSumTP","AliITSSumTP",&fITSSumTP);
+    if (fCompactTPTree) {
+      fCompactTP = new AliITSCompactTrackPoints();
+      fTPTree = new TTree("ITSCompactTP","ITS TP Summary, flat arrays");
+      fCompactTP->CreateBranches(fTPTree);
+    }
+    else {
+      fITSSumTP = new AliITSSumTP();
+      fTPTree = new TTree("ITSSumTP","ITS TP Summary");
+      fTPTree->Branch("AliITSSumTP","AliITSSumTP",&fITSSumTP);
+    }
     PostData(2,fTPTree);
   }
   //
@@ -178,7 +196,7 @@ void AliAnalysisTaskITSAlignQA::CreateSDDHistos(){
   // Histos for SDD
 
   for(Int_t iMod=0; iMod<kNSDDmods; iMod++){
-    if (fDoSDDResiduals) {
+    if (fDoSDDResiduals && fDoResidualHistos) {
       fHistSDDResidX[iMod] = new TH2F(Form("hSDDResidX%d",iMod+kNSPDmods),
 				      Form("hSDDResidX%d",iMod+kNSPDmods),
 				      fNPtBins,fPtBinLimits,
@@ -311,6 +329,7 @@ void AliAnalysisTaskITSAlignQA::UserExec(Option_t *)
   //
   AliESDEvent *esd = dynamic_cast<AliESDEvent*>(InputEvent());
   if (fITSSumTP) fITSSumTP->Reset();
+  if (fCompactTP) fCompactTP->Reset();
 
   if(!esd) {
     AliInfo("No ESD");
@@ -382,6 +401,14 @@ void AliAnalysisTaskITSAlignQA::UserExec(Option_t *)
       arrayITSNoVtx->SetUniqueID(itrack);
       fITSSumTP->AddTrack(arrayITSNoVtx);
     }
+    if (fCompactTP) {
+      AliTrackPointArray* arrayCompact = PrepareTrack(array, 0);
+      Double_t bz = esd->GetMagneticField();
+      const AliExternalTrackParam* inTPC = track->GetTPCInnerParam();
+      fCompactTP->AddTrack(arrayCompact, track->GetC(bz), TMath::Sqrt(track->GetSigma1Pt2())*bz*kB2C,
+			   inTPC ? inTPC->GetC(bz) : 0, inTPC ? TMath::Sqrt(inTPC->GetSigma1Pt2())*TMath::Abs(bz*kB2C) : 0);
+      delete arrayCompact;
+    }
     //
     fHistNEvents->Fill(kNTracks);
     //
@@ -436,6 +463,12 @@ void AliAnalysisTaskITSAlignQA::UserExec(Option_t *)
     if (ntp) fTPTree->Fill();
     CopyUserInfo();
   }
+  if (fCompactTP) { // flat arrays, curvatures already stored per track
+    fCompactTP->SetVertex(vtx);
+    fCompactTP->SetRun(fCurrentRunNumber);
+    if (fCompactTP->GetNTracks()) fTPTree->Fill();
+    CopyUserInfo();
+  }
 
   //
   PostData(1,fOutput);
@@ -521,6 +554,9 @@ void AliAnalysisTaskITSAlignQA::FitAndFillSPD(Int_t iLayer, const AliTrackPointA
       TGeoHMatrix *mcurr = AliITSgeomTGeo::GetMatrix(modIdSPD[ip]);
       mcurr->MasterToLocalVect(resGlo,resLoc);
       Int_t index=modIdSPD[ip];
+      fResidAcc->Fill(index,pt,AliITSResidualAccumulator::kX,resLoc[0]);
+      fResidAcc->Fill(index,pt,AliITSResidualAccumulator::kZ,resLoc[2]);
+      if (!fDoResidualHistos) continue;
       fHistSPDResidX[index]->Fill(pt,resLoc[0]);
       fHistSPDResidZ[index]->Fill(pt,resLoc[2]);
     }
@@ -585,7 +621,8 @@ void AliAnalysisTaskITSAlignQA::FitAndFillSDDrphi(const AliTrackPointArray *arra
       TGeoHMatrix *mcurr = AliITSgeomTGeo::GetMatrix(modIdSDD[ip]);
       mcurr->MasterToLocalVect(resGlo,resLoc);
       Int_t index=modIdSDD[ip]-kNSPDmods;
-      if (fDoSDDResiduals) {
+      if (fDoSDDResiduals) fResidAcc->Fill(modIdSDD[ip],pt,AliITSResidualAccumulator::kX,resLoc[0]);
+      if (fDoSDDResiduals && fDoResidualHistos) {
 	fHistSDDResidX[index]->Fill(pt,resLoc[0]);
 	fHistSDDResidXvsX[index]->Fill(xLocSDD[ip],resLoc[0]);
 	fHistSDDResidXvsZ[index]->Fill(zLocSDD[ip],resLoc[0]);
@@ -646,6 +683,8 @@ void AliAnalysisTaskITSAlignQA::FitAndFillSDDz(Int_t iLayer, const AliTrackPoint
       TGeoHMatrix *mcurr = AliITSgeomTGeo::GetMatrix(modIdSDD[ip]);
       mcurr->MasterToLocalVect(resGlo,resLoc);
       Int_t index=modIdSDD[ip]-kNSPDmods;
+      fResidAcc->Fill(modIdSDD[ip],pt,AliITSResidualAccumulator::kZ,resLoc[2]);
+      if (!fDoResidualHistos) continue;
       fHistSDDResidZ[index]->Fill(pt,resLoc[2]);
       fHistSDDResidZvsX[index]->Fill(xLocSDD[ip],resLoc[2]);
       fHistSDDResidZvsZ[index]->Fill(zLocSDD[ip],resLoc[2]);
@@ -684,6 +723,9 @@ void AliAnalysisTaskITSAlignQA::FitAndFillSSD(Int_t iLayer, const AliTrackPointA
       TGeoHMatrix *mcurr = AliITSgeomTGeo::GetMatrix(modIdSSD[ip]);
       mcurr->MasterToLocalVect(resGlo,resLoc);
       Int_t index=modIdSSD[ip]-kNSPDmods-kNSDDmods;
+      fResidAcc->Fill(modIdSSD[ip],pt,AliITSResidualAccumulator::kX,resLoc[0]);
+      fResidAcc->Fill(modIdSSD[ip],pt,AliITSResidualAccumulator::kZ,resLoc[2]);
+      if (!fDoResidualHistos) continue;
       fHistSSDResidX[index]->Fill(pt,resLoc[0]);
       fHistSSDResidZ[index]->Fill(pt,resLoc[2]);
     }
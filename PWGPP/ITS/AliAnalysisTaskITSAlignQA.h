@@ -23,6 +23,8 @@ class AliESDfriend;
 class AliITSTPArrayFit;
 class AliTrackPointArray;
 class AliITSSumTP;
+class AliITSResidualAccumulator;
+class AliITSCompactTrackPoints;
 
 #include "AliAnalysisTaskSE.h"
 
@@ -37,10 +39,14 @@ class AliAnalysisTaskITSAlignQA : public AliAnalysisTaskSE {
   virtual void   UserCreateOutputObjects();
   virtual void   Terminate(Option_t *option);
 
-  void SetDoFillTPTree(Bool_t opt){
+  void SetDoFillTPTree(Bool_t opt, Bool_t compact=kFALSE){
     fDoFillTPTree=opt;
+    fCompactTPTree=compact;
     if (fDoFillTPTree) DefineOutput(2,TTree::Class());
   }
+  void SetDoResidualHistos(Bool_t opt){
+    fDoResidualHistos=opt;
+  }
   void SetDoSPDResiduals(Bool_t opt){
     fDoSPDResiduals=opt;
   }
@@ -103,6 +109,7 @@ class AliAnalysisTaskITSAlignQA : public AliAnalysisTaskSE {
   }
 
   Double_t GetUseTPCTiming()                      const {return fUseTOFTiming;}
+  const AliITSResidualAccumulator* GetResidualAccumulator() const {return fResidAcc;}
   Bool_t   GetUseTPCMomentum()                    const {return fUseTPCMomentum;}
   Bool_t   AcceptTrack(const AliESDtrack * track, const AliESDVertex* vtx=0);
   Bool_t   AcceptVertex(const AliESDVertex * vtx, const AliESDVertex * vtxSPD);
@@ -169,6 +176,8 @@ class AliAnalysisTaskITSAlignQA : public AliAnalysisTaskSE {
   Bool_t   fDoSDDVDriftCalib; // Flag to enable histos for SDD VDrift calibration
   Bool_t   fDoSDDDriftTime;   // Flag to enable histos for SDD Drift times
   Bool_t   fDoFillTPTree;     // Flag to enable tree with trackpoints
+  Bool_t   fCompactTPTree;    // Flag to write the trackpoints tree as flat arrays (AliITSCompactTrackPoints)
+  Bool_t   fDoResidualHistos; // Flag to enable the per-module residual histos (the flat accumulator is always filled)
   Bool_t   fUseITSsaTracks;   // Flag for using standalone ITS tracks
   Bool_t   fLoadGeometry;     // Flag to control the loading of geometry from OCDB
   Bool_t   fUseVertex;        // Use the vertex as an extra point
@@ -189,10 +198,12 @@ class AliAnalysisTaskITSAlignQA : public AliAnalysisTaskSE {
   AliITSTPArrayFit* fFitter;  // Track Point fitter
   AliITSSumTP* fITSSumTP;     // !TracPoints summary objects
   TTree*   fTPTree;           // !output tree for trackpoints
+  AliITSCompactTrackPoints* fCompactTP; // !flat trackpoints of the event
+  AliITSResidualAccumulator* fResidAcc; // !per-module residual moments (in fOutput)
   Int_t fRunNb;               // Run number
   TString fOCDBLocation;      // OCDB location
 
-  ClassDef(AliAnalysisTaskITSAlignQA,7);
+  ClassDef(AliAnalysisTaskITSAlignQA,8);
 };
 
 
@@ -0,0 +1,164 @@
+/**************************************************************************
+ * Copyright(c) 1998-2012, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//*************************************************************************
+// Implementation of class AliITSCompactTrackPoints
+// Usage, writing:
+//   AliITSCompactTrackPoints tp; tp.CreateBranches(tree);
+//   per event: tp.Reset(); tp.SetVertex(vtx); tp.AddTrack(...); tree->Fill();
+// reading:
+//   tp.SetBranchAddresses(tree); tree->GetEntry(i);
+//   const Float_t *xyz = tp.GetXYZ(); ...
+//*************************************************************************
+
+#include <TTree.h>
+
+#include "AliESDVertex.h"
+#include "AliTrackPointArray.h"
+
+#include "AliITSCompactTrackPoints.h"
+
+//______________________________________________________________________________
+AliITSCompactTrackPoints::AliITSCompactTrackPoints() :
+  fRun(0),
+  fTrackFirst(),
+  fTrackNPoints(),
+  fCrv(),
+  fXYZ(),
+  fCov(),
+  fVolID(),
+  fCharge(),
+  fDriftTime(),
+  fClusterType(),
+  fpTrackFirst(&fTrackFirst),
+  fpTrackNPoints(&fTrackNPoints),
+  fpCrv(&fCrv),
+  fpXYZ(&fXYZ),
+  fpCov(&fCov),
+  fpVolID(&fVolID),
+  fpCharge(&fCharge),
+  fpDriftTime(&fDriftTime),
+  fpClusterType(&fClusterType)
+{
+  //
+  for (Int_t i=0; i<9; i++) fVertex[i] = 0;
+}
+
+//______________________________________________________________________________
+void AliITSCompactTrackPoints::Reset()
+{
+  // clear the content, keeping the capacity
+  fTrackFirst.clear();
+  fTrackNPoints.clear();
+  fCrv.clear();
+  fXYZ.clear();
+  fCov.clear();
+  fVolID.clear();
+  fCharge.clear();
+  fDriftTime.clear();
+  fClusterType.clear();
+  for (Int_t i=0; i<9; i++) fVertex[i] = 0;
+}
+
+//______________________________________________________________________________
+void AliITSCompactTrackPoints::SetVertex(const AliESDVertex *vtx)
+{
+  if (!vtx) return;
+  Double_t pos[3], cov[6];
+  vtx->GetXYZ(pos);
+  vtx->GetCovarianceMatrix(cov);
+  for (Int_t i=0; i<3; i++) fVertex[i] = pos[i];
+  for (Int_t i=0; i<6; i++) fVertex[3+i] = cov[i];
+  // n contributors in the last word
+  fVertex[8] = vtx->GetNContributors();
+}
+
+//______________________________________________________________________________
+Int_t AliITSCompactTrackPoints::AddTrack(const AliTrackPointArray *array, Float_t crvGlo, Float_t crvGloErr, Float_t crvTPC, Float_t crvTPCErr)
+{
+  // append the points of one track, return its index
+  Int_t npts = array->GetNPoints();
+  fTrackFirst.push_back(fVolID.size());
+  fTrackNPoints.push_back(npts);
+  fCrv.push_back(crvGlo);
+  fCrv.push_back(crvGloErr);
+  fCrv.push_back(crvTPC);
+  fCrv.push_back(crvTPCErr);
+  AliTrackPoint point;
+  Float_t xyz[3], cov[6];
+  for (Int_t ipt=0; ipt<npts; ipt++) {
+    array->GetPoint(point,ipt);
+    point.GetXYZ(xyz,cov);
+    fXYZ.insert(fXYZ.end(), xyz, xyz+3);
+    fCov.insert(fCov.end(), cov, cov+6);
+    fVolID.push_back(point.GetVolumeID());
+    fCharge.push_back(point.GetCharge());
+    fDriftTime.push_back(point.GetDriftTime());
+    fClusterType.push_back(point.GetClusterType() | (point.IsExtra() ? BIT(31) : 0));
+  }
+  return fTrackFirst.size()-1;
+}
+
+//______________________________________________________________________________
+void AliITSCompactTrackPoints::CreateBranches(TTree *tree)
+{
+  tree->Branch("run",&fRun,"run/I");
+  tree->Branch("vertex",fVertex,"vertex[9]/F");
+  tree->Branch("trackFirst",&fpTrackFirst);
+  tree->Branch("trackNPoints",&fpTrackNPoints);
+  tree->Branch("crv",&fpCrv);
+  tree->Branch("xyz",&fpXYZ);
+  tree->Branch("cov",&fpCov);
+  tree->Branch("volID",&fpVolID);
+  tree->Branch("charge",&fpCharge);
+  tree->Branch("driftTime",&fpDriftTime);
+  tree->Branch("clusterType",&fpClusterType);
+}
+
+//______________________________________________________________________________
+void AliITSCompactTrackPoints::SetBranchAddresses(TTree *tree)
+{
+  tree->SetBranchAddress("run",&fRun);
+  tree->SetBranchAddress("vertex",fVertex);
+  tree->SetBranchAddress("trackFirst",&fpTrackFirst);
+  tree->SetBranchAddress("trackNPoints",&fpTrackNPoints);
+  tree->SetBranchAddress("crv",&fpCrv);
+  tree->SetBranchAddress("xyz",&fpXYZ);
+  tree->SetBranchAddress("cov",&fpCov);
+  tree->SetBranchAddress("volID",&fpVolID);
+  tree->SetBranchAddress("charge",&fpCharge);
+  tree->SetBranchAddress("driftTime",&fpDriftTime);
+  tree->SetBranchAddress("clusterType",&fpClusterType);
+}
+
+//______________________________________________________________________________
+AliTrackPointArray* AliITSCompactTrackPoints::CreateTrackPointArray(Int_t itr) const
+{
+  // AliTrackPointArray of one track, owned by the caller
+  Int_t first = fTrackFirst[itr], npts = fTrackNPoints[itr];
+  AliTrackPointArray *array = new AliTrackPointArray(npts);
+  AliTrackPoint point;
+  for (Int_t ipt=0; ipt<npts; ipt++) {
+    Int_t i = first+ipt;
+    point.SetXYZ(&fXYZ[3*i],&fCov[6*i]);
+    point.SetVolumeID(fVolID[i]);
+    point.SetCharge(fCharge[i]);
+    point.SetDriftTime(fDriftTime[i]);
+    point.SetClusterType(fClusterType[i] & ~BIT(31));
+    point.SetExtra(fClusterType[i] & BIT(31));
+    array->AddPoint(ipt,&point);
+  }
+  return array;
+}
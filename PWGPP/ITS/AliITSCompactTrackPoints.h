@@ -0,0 +1,84 @@
+#ifndef ALIITSCOMPACTTRACKPOINTS_H
+#define ALIITSCOMPACTTRACKPOINTS_H
+
+/* Copyright(c) 1998-2012, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//*************************************************************************
+// Class AliITSCompactTrackPoints
+// ITS track points of all the selected tracks of one event stored as
+// flat arrays (one tree entry per event): point coordinates, covariance,
+// volume ID, charge and drift time, plus per-track offsets, curvatures
+// and the vertex. The alignment reads the arrays directly, without one
+// AliTrackPointArray object per track.
+//*************************************************************************
+
+#include <vector>
+#include <Rtypes.h>
+
+class TTree;
+class AliESDVertex;
+class AliTrackPointArray;
+
+class AliITSCompactTrackPoints {
+
+ public:
+  AliITSCompactTrackPoints();
+  ~AliITSCompactTrackPoints() {}
+
+  void  Reset();
+  void  SetRun(Int_t run) {fRun = run;}
+  void  SetVertex(const AliESDVertex *vtx);
+  Int_t AddTrack(const AliTrackPointArray *array, Float_t crvGlo, Float_t crvGloErr, Float_t crvTPC=0, Float_t crvTPCErr=0);
+
+  void  CreateBranches(TTree *tree);
+  void  SetBranchAddresses(TTree *tree);
+
+  Int_t GetRun() const {return fRun;}
+  Int_t GetNTracks() const {return fTrackFirst.size();}
+  Int_t GetNPoints() const {return fVolID.size();}
+  Int_t GetFirstPoint(Int_t itr) const {return fTrackFirst[itr];}
+  Int_t GetNPoints(Int_t itr) const {return fTrackNPoints[itr];}
+  // point ip: coordinates at 3*ip, covariance at 6*ip
+  const Float_t* GetXYZ() const {return fXYZ.empty() ? 0 : &fXYZ[0];}
+  const Float_t* GetCov() const {return fCov.empty() ? 0 : &fCov[0];}
+  const Int_t*   GetVolumeID() const {return fVolID.empty() ? 0 : &fVolID[0];}
+  const Float_t* GetCharge() const {return fCharge.empty() ? 0 : &fCharge[0];}
+  const Float_t* GetDriftTime() const {return fDriftTime.empty() ? 0 : &fDriftTime[0];}
+  Float_t GetCrvGlo(Int_t itr) const {return fCrv[4*itr];}
+  Float_t GetCrvGloErr(Int_t itr) const {return fCrv[4*itr+1];}
+  Float_t GetCrvTPC(Int_t itr) const {return fCrv[4*itr+2];}
+  Float_t GetCrvTPCErr(Int_t itr) const {return fCrv[4*itr+3];}
+  const Float_t* GetVertex() const {return fVertex;}
+
+  // rebuild the AliTrackPointArray of one track (for the existing tools)
+  AliTrackPointArray* CreateTrackPointArray(Int_t itr) const;
+
+ private:
+  AliITSCompactTrackPoints(const AliITSCompactTrackPoints &source);
+  AliITSCompactTrackPoints& operator=(const AliITSCompactTrackPoints &source);
+
+  Int_t   fRun;                       // run number
+  Float_t fVertex[9];                 // vertex position, covariance (6), n contributors
+  std::vector<Int_t>   fTrackFirst;   // first point of each track
+  std::vector<Int_t>   fTrackNPoints; // number of points of each track
+  std::vector<Float_t> fCrv;          // global and TPC curvature with errors, 4 per track
+  std::vector<Float_t> fXYZ;          // global coordinates, 3 per point
+  std::vector<Float_t> fCov;          // covariance matrix, 6 per point
+  std::vector<Int_t>   fVolID;        // volume ID of each point
+  std::vector<Float_t> fCharge;       // cluster charge of each point
+  std::vector<Float_t> fDriftTime;    // drift time of each point
+  std::vector<Int_t>   fClusterType;  // cluster type of each point (incl. the extra flag)
+  // the vectors above, as needed for the branch addresses
+  std::vector<Int_t>   *fpTrackFirst;
+  std::vector<Int_t>   *fpTrackNPoints;
+  std::vector<Float_t> *fpCrv;
+  std::vector<Float_t> *fpXYZ;
+  std::vector<Float_t> *fpCov;
+  std::vector<Int_t>   *fpVolID;
+  std::vector<Float_t> *fpCharge;
+  std::vector<Float_t> *fpDriftTime;
+  std::vector<Int_t>   *fpClusterType;
+};
+
+#endif
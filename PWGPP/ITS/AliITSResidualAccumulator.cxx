@@ -0,0 +1,151 @@
+/**************************************************************************
+ * Copyright(c) 1998-2012, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//*************************************************************************
+// Implementation of class AliITSResidualAccumulator
+// The residuals are accumulated as raw sums (N, sum, sum of squares),
+// so that merging the outputs of different jobs is a plain addition
+// of the moment arrays.
+//*************************************************************************
+
+#include <algorithm>
+
+#include <TCollection.h>
+#include <TMath.h>
+
+#include "AliITSResidualAccumulator.h"
+
+ClassImp(AliITSResidualAccumulator)
+
+//______________________________________________________________________________
+AliITSResidualAccumulator::AliITSResidualAccumulator() : TNamed(),
+  fNModules(0),
+  fNPtBins(0),
+  fPtBinLimits(),
+  fMoments()
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+AliITSResidualAccumulator::AliITSResidualAccumulator(const char *name, Int_t nModules, Int_t nPtBins, const Double_t *ptBinLimits) :
+  TNamed(name, name),
+  fNModules(nModules),
+  fNPtBins(nPtBins),
+  fPtBinLimits(ptBinLimits, ptBinLimits+nPtBins+1),
+  fMoments(nModules*nPtBins*kNMom, 0.)
+{
+  // standard constructor
+}
+
+//______________________________________________________________________________
+Int_t AliITSResidualAccumulator::FindPtBin(Double_t pt) const
+{
+  // pt bin as in the residual histograms, -1 outside of the limits
+  if (fNPtBins<1 || pt<fPtBinLimits[0] || pt>=fPtBinLimits[fNPtBins]) return -1;
+  return std::upper_bound(fPtBinLimits.begin(), fPtBinLimits.end(), pt) - fPtBinLimits.begin() - 1;
+}
+
+//______________________________________________________________________________
+void AliITSResidualAccumulator::Fill(Int_t module, Double_t pt, Int_t coord, Double_t res)
+{
+  // add one residual (coord kX or kZ) of the given module
+  if (module<0 || module>=fNModules) return;
+  Int_t ipt = FindPtBin(pt);
+  if (ipt<0) return;
+  Double_t *m = &fMoments[(module*fNPtBins + ipt)*kNMom + coord*kNMomPerCoord];
+  m[kN]    += 1.;
+  m[kSum]  += res;
+  m[kSum2] += res*res;
+}
+
+//______________________________________________________________________________
+void AliITSResidualAccumulator::Add(const AliITSResidualAccumulator &other)
+{
+  // add the moments of an accumulator with the same binning
+  if (fMoments.empty()) {
+    fNModules = other.fNModules;
+    fNPtBins = other.fNPtBins;
+    fPtBinLimits = other.fPtBinLimits;
+    fMoments.assign(other.fMoments.size(), 0.);
+  }
+  if (other.fMoments.size() != fMoments.size()) {
+    Error("Add", "Different binning (%d modules x %d pt bins, %d x %d)", fNModules, fNPtBins, other.fNModules, other.fNPtBins);
+    return;
+  }
+  for (UInt_t i=0; i<fMoments.size(); i++) fMoments[i] += other.fMoments[i];
+}
+
+//______________________________________________________________________________
+Long64_t AliITSResidualAccumulator::Merge(TCollection *list)
+{
+  // merge a list of accumulators into this one
+  if (!list) return 0;
+  TIter next(list);
+  TObject *obj;
+  Long64_t nmerged = 0;
+  while ((obj = next())) {
+    AliITSResidualAccumulator *acc = dynamic_cast<AliITSResidualAccumulator*>(obj);
+    if (!acc) {
+      Error("Merge", "Attempt to merge object of class %s with %s", obj->ClassName(), ClassName());
+      return -1;
+    }
+    Add(*acc);
+    nmerged++;
+  }
+  return nmerged;
+}
+
+//______________________________________________________________________________
+void AliITSResidualAccumulator::Clear(Option_t *)
+{
+  std::fill(fMoments.begin(), fMoments.end(), 0.);
+}
+
+//______________________________________________________________________________
+const Double_t* AliITSResidualAccumulator::GetBlock(Int_t module) const
+{
+  if (module<0 || module>=fNModules) return 0;
+  return &fMoments[module*fNPtBins*kNMom];
+}
+
+//______________________________________________________________________________
+Double_t AliITSResidualAccumulator::GetSum(Int_t module, Int_t coord, Int_t mom, Int_t ptBin) const
+{
+  // sum of the moment mom over one or all pt bins
+  const Double_t *block = GetBlock(module);
+  if (!block || ptBin>=fNPtBins) return 0.;
+  Int_t first = ptBin<0 ? 0 : ptBin, last = ptBin<0 ? fNPtBins : ptBin+1;
+  Double_t sum = 0.;
+  for (Int_t ipt=first; ipt<last; ipt++) sum += block[ipt*kNMom + coord*kNMomPerCoord + mom];
+  return sum;
+}
+
+//______________________________________________________________________________
+Double_t AliITSResidualAccumulator::GetMean(Int_t module, Int_t coord, Int_t ptBin) const
+{
+  Double_t n = GetSum(module,coord,kN,ptBin);
+  return n>0 ? GetSum(module,coord,kSum,ptBin)/n : 0.;
+}
+
+//______________________________________________________________________________
+Double_t AliITSResidualAccumulator::GetRMS(Int_t module, Int_t coord, Int_t ptBin) const
+{
+  Double_t n = GetSum(module,coord,kN,ptBin);
+  if (n<=0) return 0.;
+  Double_t mean = GetSum(module,coord,kSum,ptBin)/n;
+  Double_t var = GetSum(module,coord,kSum2,ptBin)/n - mean*mean;
+  return var>0 ? TMath::Sqrt(var) : 0.;
+}
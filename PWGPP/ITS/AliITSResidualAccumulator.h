@@ -0,0 +1,59 @@
+#ifndef ALIITSRESIDUALACCUMULATOR_H
+#define ALIITSRESIDUALACCUMULATOR_H
+
+/* Copyright(c) 1998-2012, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//*************************************************************************
+// Class AliITSResidualAccumulator
+// Flat accumulator of the track-to-point residuals of the ITS modules:
+// per module and pt bin the sums of the local X and Z residuals and of
+// their squares, stored in one contiguous array indexed by module ID.
+// The block of a module (GetBlock) can be read by the offline alignment
+// without going through per-module histograms.
+//*************************************************************************
+
+#include <vector>
+#include "TNamed.h"
+
+class TCollection;
+
+class AliITSResidualAccumulator : public TNamed {
+
+ public:
+  enum {kX=0, kZ=1};
+  enum {kN=0, kSum, kSum2, kNMomPerCoord};
+  enum {kNMom = 2*kNMomPerCoord};   // moments per module and pt bin
+
+  AliITSResidualAccumulator();
+  AliITSResidualAccumulator(const char *name, Int_t nModules, Int_t nPtBins, const Double_t *ptBinLimits);
+  virtual ~AliITSResidualAccumulator() {}
+
+  void     Fill(Int_t module, Double_t pt, Int_t coord, Double_t res);
+  void     Add(const AliITSResidualAccumulator &other);
+  Long64_t Merge(TCollection *list);
+  virtual void Clear(Option_t *opt = "");
+
+  Int_t    GetNModules() const {return fNModules;}
+  Int_t    GetNPtBins() const {return fNPtBins;}
+  Int_t    FindPtBin(Double_t pt) const;
+  // nPtBins*kNMom values of one module, or 0 for an invalid module
+  const Double_t* GetBlock(Int_t module) const;
+
+  // ptBin<0: all pt bins
+  Double_t GetEntries(Int_t module, Int_t coord, Int_t ptBin=-1) const {return GetSum(module,coord,kN,ptBin);}
+  Double_t GetMean(Int_t module, Int_t coord, Int_t ptBin=-1) const;
+  Double_t GetRMS(Int_t module, Int_t coord, Int_t ptBin=-1) const;
+
+ private:
+  Double_t GetSum(Int_t module, Int_t coord, Int_t mom, Int_t ptBin) const;
+
+  Int_t    fNModules;                // number of modules
+  Int_t    fNPtBins;                 // number of pt bins
+  std::vector<Double_t> fPtBinLimits; // limits of the pt bins
+  std::vector<Double_t> fMoments;    // [module][ptBin][kNMom]
+
+  ClassDef(AliITSResidualAccumulator,1);
+};
+
+#endif
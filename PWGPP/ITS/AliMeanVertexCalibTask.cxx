@@ -36,6 +36,7 @@
 #include "AliGRPRecoParam.h"
 
 #include "AliMeanVertexCalibTask.h"
+#include "AliMeanVertexStreamStats.h"
 
 
 ClassImp(AliMeanVertexCalibTask)
@@ -46,7 +47,11 @@ AliMeanVertexCalibTask::AliMeanVertexCalibTask(const char *name):
   fESD(0), 
   fOutput(0),
   fOnlyITSTPCTracks(kFALSE),
-  fOnlyITSSATracks(kTRUE)
+  fOnlyITSSATracks(kTRUE),
+  fTimeSliceWidth(600),
+  fSPDStats(0),
+  fTRKStats(0),
+  fITSSAStats(0)
 {
 
   // Constructor
@@ -140,6 +145,15 @@ void AliMeanVertexCalibTask::UserCreateOutputObjects()
   fOutput->Add(hITSSAVertexXHighMult);
   TH1F* hITSSAVertexYHighMult = new TH1F("hITSSAVertexYHighMult","ITSSAVertex y High Mult; y vertex [cm] Mult>1500; events",500,-0.5,0.5);
   fOutput->Add(hITSSAVertexYHighMult);
+
+  // Streaming estimators (moments and quantiles) per run and per time slice,
+  // the preprocessor can use them instead of fitting the histograms
+  fSPDStats = new AliMeanVertexStreamStats("SPDVertexStats", "SPD 3D vertex", fTimeSliceWidth);
+  fOutput->Add(fSPDStats);
+  fTRKStats = new AliMeanVertexStreamStats("TRKVertexStats", "TRK vertex", fTimeSliceWidth);
+  fOutput->Add(fTRKStats);
+  fITSSAStats = new AliMeanVertexStreamStats("ITSSAVertexStats", "ITSSA vertex", fTimeSliceWidth);
+  fOutput->Add(fITSSAStats);
   
   PostData(1, fOutput);
   
@@ -184,7 +198,11 @@ void AliMeanVertexCalibTask::UserExec(Option_t *)
   if (runNb > 0) {
     man->SetRun(runNb);
     // Printf("runNb = %d", runNb);
+    fSPDStats->SetRun(runNb);
+    fTRKStats->SetRun(runNb);
+    fITSSAStats->SetRun(runNb);
   }
+  UInt_t timeStamp = esdE->GetTimeStamp();
   
   AliCDBEntry *entry = (AliCDBEntry*)man->Get("GRP/Calib/RecoParam/");
   // Printf("entry = %p", entry);
@@ -233,6 +251,7 @@ void AliMeanVertexCalibTask::UserExec(Option_t *)
       if(title.Contains("3D")) {
 	((TH1F*)fOutput->FindObject("hSPDVertexX"))->Fill(spdv->GetX());
 	((TH1F*)fOutput->FindObject("hSPDVertexY"))->Fill(spdv->GetY());
+	fSPDStats->Fill(spdv->GetX(), spdv->GetY(), spdv->GetZ(), timeStamp);
       }
       ((TH1F*)fOutput->FindObject("hSPDVertexZ"))->Fill(spdv->GetZ());
     }
@@ -244,6 +263,7 @@ void AliMeanVertexCalibTask::UserExec(Option_t *)
       ((TH1F*)fOutput->FindObject("hTRKVertexX"))->Fill(trkv->GetX());
       ((TH1F*)fOutput->FindObject("hTRKVertexY"))->Fill(trkv->GetY());
       ((TH1F*)fOutput->FindObject("hTRKVertexZ"))->Fill(trkv->GetZ());
+      fTRKStats->Fill(trkv->GetX(), trkv->GetY(), trkv->GetZ(), timeStamp);
 
       ((TH2F*)fOutput->FindObject("hTRKVertexXvsMult"))->Fill(trkv->GetX(), ntrklets);
       ((TH2F*)fOutput->FindObject("hTRKVertexYvsMult"))->Fill(trkv->GetY(), ntrklets);
@@ -270,6 +290,7 @@ void AliMeanVertexCalibTask::UserExec(Option_t *)
       ((TH1F*)fOutput->FindObject("hITSSAVertexX"))->Fill(itsSAv->GetX());
       ((TH1F*)fOutput->FindObject("hITSSAVertexY"))->Fill(itsSAv->GetY());
       ((TH1F*)fOutput->FindObject("hITSSAVertexZ"))->Fill(itsSAv->GetZ());
+      fITSSAStats->Fill(itsSAv->GetX(), itsSAv->GetY(), itsSAv->GetZ(), timeStamp);
 
       ((TH2F*)fOutput->FindObject("hITSSAVertexXvsMult"))->Fill(itsSAv->GetX(), ntrklets);
       ((TH2F*)fOutput->FindObject("hITSSAVertexYvsMult"))->Fill(itsSAv->GetY(), ntrklets);
@@ -311,6 +332,9 @@ void AliMeanVertexCalibTask::Terminate(Option_t *)
     return;
   }
 
+  AliMeanVertexStreamStats *stats = dynamic_cast<AliMeanVertexStreamStats*>(fOutput->FindObject("TRKVertexStats"));
+  if (stats) stats->Print();
+
 
   return;
 
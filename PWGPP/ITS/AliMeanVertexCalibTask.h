@@ -27,6 +27,7 @@
 
 class TList;
 class AliESDEvent;
+class AliMeanVertexStreamStats;
 
 #include "AliAnalysisTaskSE.h"
 
@@ -43,6 +44,12 @@ class AliMeanVertexCalibTask : public AliAnalysisTaskSE
   
   void           SetOnlyITSTPCTracks() {fOnlyITSTPCTracks=kFALSE;}
   void           SetOnlyITSSATracks() {fOnlyITSSATracks=kTRUE;}
+  void           SetTimeSliceWidth(UInt_t width) {fTimeSliceWidth=width;}
+
+  // running estimates of the vertex distributions, available during the pass
+  const AliMeanVertexStreamStats* GetSPDVertexStats() const {return fSPDStats;}
+  const AliMeanVertexStreamStats* GetTRKVertexStats() const {return fTRKStats;}
+  const AliMeanVertexStreamStats* GetITSSAVertexStats() const {return fITSSAStats;}
 
   
     
@@ -53,6 +60,11 @@ class AliMeanVertexCalibTask : public AliAnalysisTaskSE
 
   Bool_t       fOnlyITSTPCTracks; // only ITS-TPC tracks to redo ITSTPC vertex
   Bool_t       fOnlyITSSATracks;  // only ITS-SA tracks to redo ITSTPC vertex
+  UInt_t       fTimeSliceWidth;   // width (s) of the time slices of the streaming estimators
+
+  AliMeanVertexStreamStats *fSPDStats;   //! streaming estimator of the SPD 3D vertices (in fOutput)
+  AliMeanVertexStreamStats *fTRKStats;   //! streaming estimator of the track vertices (in fOutput)
+  AliMeanVertexStreamStats *fITSSAStats; //! streaming estimator of the ITS-SA vertices (in fOutput)
   
   
   AliMeanVertexCalibTask(const AliMeanVertexCalibTask&);
@@ -60,7 +72,7 @@ class AliMeanVertexCalibTask : public AliAnalysisTaskSE
  
   //AliESDVertex* ReconstructPrimaryVertex(Bool_t constr=kFALSE, Int_t mode=0) const;
   
-  ClassDef(AliMeanVertexCalibTask, 1);
+  ClassDef(AliMeanVertexCalibTask, 2);
   
 };
 
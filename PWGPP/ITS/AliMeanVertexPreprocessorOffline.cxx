@@ -20,6 +20,7 @@
 // Davide Caffarri
 
 #include "AliMeanVertexPreprocessorOffline.h"
+#include "AliMeanVertexStreamStats.h"
 
 #include "AliCDBStorage.h"
 #include "AliCDBMetaData.h"
@@ -64,7 +65,8 @@ const Char_t *AliMeanVertexPreprocessorOffline::fgkStatusCodeName[AliMeanVertexP
 AliMeanVertexPreprocessorOffline::AliMeanVertexPreprocessorOffline():
 TNamed("AliMeanVertexPreprocessorOffline","AliMeanVertexPreprocessorOffline"),
 fStatus(kOk),
-fShowPlots(kFALSE)
+fShowPlots(kFALSE),
+fUseStreamStats(kFALSE)
 {
   //constructor
 }
@@ -236,7 +238,34 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
 
     TF1 *fitVtxX, *fitVtxY, *fitVtxZ;
 
-    if (useTRKvtx || useITSSAvtx) {
+    // robust position and z spread from the streaming estimators, if requested and filled
+    AliMeanVertexStreamStats *trkStats = 0x0;
+    if (fUseStreamStats && (useTRKvtx || useITSSAvtx))
+      trkStats = GetStreamStats(file, list, useTRKvtx ? "TRKVertexStats" : "ITSSAVertexStats", 50);
+
+    if (trkStats) {
+      xMeanVtx = trkStats->GetMedian(0);
+      if (TMath::Abs(xMeanVtx) > 2.) {
+        xMeanVtx = 0.;
+        writeMeanVertexSPD=kTRUE;
+        fStatus=kWriteMeanVertexSPD;
+      }
+      yMeanVtx = trkStats->GetMedian(1);
+      if (TMath::Abs(yMeanVtx) > 2.) {
+        yMeanVtx = 0.;
+        writeMeanVertexSPD=kTRUE;
+        fStatus=kWriteMeanVertexSPD;
+      }
+      zMeanVtx = trkStats->GetMedian(2);
+      zSigmaVtx = trkStats->GetRobustSigma(2);
+      if ((TMath::Abs(zMeanVtx) > 20.) || (zSigmaVtx>12.)) {
+        zMeanVtx = trkStats->GetMean(2);
+        zSigmaVtx = trkStats->GetSigma(2);
+        writeMeanVertexSPD=kTRUE;
+        fStatus=kWriteMeanVertexSPD;
+      }
+    }
+    else if (useTRKvtx || useITSSAvtx) {
       histTRKvtxX ->Fit("gaus", "M", "", -0.3, 0.3);
       fitVtxX = histTRKvtxX -> GetFunction("gaus");
       xMeanVtx = fitVtxX -> GetParameter(1);
@@ -272,8 +301,8 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
     Double_t xHistoRMS, yHistoRMS, zHistoRMS;
 
     if (useTRKvtx || useITSSAvtx) {
-      xHistoMean = histTRKvtxX -> GetMean();
-      xHistoRMS = histTRKvtxX ->GetRMS();
+      xHistoMean = trkStats ? trkStats->GetMean(0) : histTRKvtxX ->GetMean();
+      xHistoRMS = trkStats ? trkStats->GetSigma(0) : histTRKvtxX ->GetRMS();
 
       if ((TMath::Abs(xHistoMean-xMeanVtx) > 0.5)) {
         AliWarning("Possible problems with the fit mean very different from histo mean... using SPD vertex");
@@ -283,8 +312,8 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
         fStatus=kUseOfflineSPDvtx;
       }
 
-      yHistoMean = histTRKvtxY ->GetMean();
-      yHistoRMS = histTRKvtxY ->GetRMS();
+      yHistoMean = trkStats ? trkStats->GetMean(1) : histTRKvtxY ->GetMean();
+      yHistoRMS = trkStats ? trkStats->GetSigma(1) : histTRKvtxY ->GetRMS();
 
       if ((TMath::Abs(yHistoMean-yMeanVtx) > 0.5)) {
         AliWarning("Possible problems with the fit mean very different from histo mean... using SPD vertex");
@@ -294,8 +323,8 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
         fStatus=kUseOfflineSPDvtx;
       }
 
-      zHistoMean = histTRKvtxZ -> GetMean();
-      zHistoRMS = histTRKvtxZ ->GetRMS();
+      zHistoMean = trkStats ? trkStats->GetMean(2) : histTRKvtxZ ->GetMean();
+      zHistoRMS = trkStats ? trkStats->GetSigma(2) : histTRKvtxZ ->GetRMS();
 
       if ((TMath::Abs(zHistoMean-zMeanVtx) > 1.)) {
         AliWarning("Possible problems with the fit mean very different from histo mean... using SPD vertex");
@@ -308,7 +337,32 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
     }
 
 
-    if ((useSPDvtx) && (spdAvailable) && (!vertexerSPD3Doff)) {
+    AliMeanVertexStreamStats *spdStats = 0x0;
+    if (fUseStreamStats && (useSPDvtx) && (spdAvailable) && (!vertexerSPD3Doff))
+      spdStats = GetStreamStats(file, list, "SPDVertexStats", 50);
+
+    if (spdStats) {
+      xMeanVtx = spdStats->GetMedian(0);
+      xSigmaVtx = spdStats->GetRobustSigma(0);
+      if (TMath::Abs(xMeanVtx) > 2.) {
+        xMeanVtx = 0.;
+        writeMeanVertexSPD=kTRUE;
+      }
+      yMeanVtx = spdStats->GetMedian(1);
+      ySigmaVtx = spdStats->GetRobustSigma(1);
+      if (TMath::Abs(yMeanVtx) > 2.) {
+        yMeanVtx = 0.;
+        writeMeanVertexSPD=kTRUE;
+      }
+      zMeanVtx = spdStats->GetMedian(2);
+      zSigmaVtx = spdStats->GetRobustSigma(2);
+      if ((TMath::Abs(zMeanVtx) > 20.) || (zSigmaVtx>12.)) {
+        zMeanVtx = spdStats->GetMean(2);
+        zSigmaVtx = spdStats->GetSigma(2);
+        writeMeanVertexSPD = kTRUE;
+      }
+    }
+    else if ((useSPDvtx) && (spdAvailable) && (!vertexerSPD3Doff)) {
       histSPDvtxX ->Fit("gaus", "M");
       fitVtxX = histSPDvtxX -> GetFunction("gaus");
       xMeanVtx = fitVtxX -> GetParameter(1);
@@ -757,31 +811,40 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
     delete vertex;
   } // end of pass0 case
   else if (cPassMode == 1) {
-    TF1* gs = new TF1("gs", "gaus", -30, 30);
-    gs->SetParameters(histSPDvtxZ->GetMaximum(),histSPDvtxZ->GetMean(),histSPDvtxZ->GetRMS());
-    TFitResultPtr rSPD = histSPDvtxZ->Fit(gs, "ons");
-    gs->SetParameters(histTRKvtxZ->GetMaximum(),histTRKvtxZ->GetMean(),histTRKvtxZ->GetRMS());
-    TFitResultPtr rTRK = histTRKvtxZ->Fit(gs, "ons");
-    //
-    int ndfSPD = rSPD->Ndf(), ndfTRK = rTRK->Ndf();
-    double chiSPD = rSPD->Chi2(), chiTRK = rTRK->Chi2();
-    //
-    Bool_t okSPD=kFALSE,okTRK=kFALSE;
-    //
-    if (ndfSPD>1 && (histSPDvtxZ->GetEntries()>100)) okSPD = kTRUE;
-    if (ndfTRK>1 && (histTRKvtxZ->GetEntries()>100)) okTRK = kTRUE;
-    //
-    if (!okSPD && !okTRK) {
-      printf("Neither histos fits have convergecd\n");
-      fStatus=kFitUpdateZFailed;
+    AliMeanVertexStreamStats *spdStats = fUseStreamStats ? GetStreamStats(file, list, "SPDVertexStats", 100) : 0x0;
+    AliMeanVertexStreamStats *trkStats = fUseStreamStats ? GetStreamStats(file, list, "TRKVertexStats", 100) : 0x0;
+    if (spdStats && trkStats) {
+      // z update from the streaming estimators
+      ModObject("GRP/Calib/MeanVertex",trkStats->GetMedian(2),trkStats->GetRobustSigma(2), "ZcoordUpdated", db);
+      ModObject("GRP/Calib/MeanVertexSPD",spdStats->GetMedian(2),spdStats->GetRobustSigma(2), "ZcoordUpdated", db);
     }
-
-    if      (!okSPD) rSPD = rTRK;
-    else if (!okTRK) rTRK = rSPD;
-
-    if (okTRK || okSPD) {
-      ModObject("GRP/Calib/MeanVertex",rTRK->GetParams()[1],rTRK->GetParams()[2], "ZcoordUpdated", db);
-      ModObject("GRP/Calib/MeanVertexSPD",rSPD->GetParams()[1],rSPD->GetParams()[2], "ZcoordUpdated", db);
+    else {
+      TF1* gs = new TF1("gs", "gaus", -30, 30);
+      gs->SetParameters(histSPDvtxZ->GetMaximum(),histSPDvtxZ->GetMean(),histSPDvtxZ->GetRMS());
+      TFitResultPtr rSPD = histSPDvtxZ->Fit(gs, "ons");
+      gs->SetParameters(histTRKvtxZ->GetMaximum(),histTRKvtxZ->GetMean(),histTRKvtxZ->GetRMS());
+      TFitResultPtr rTRK = histTRKvtxZ->Fit(gs, "ons");
+      //
+      int ndfSPD = rSPD->Ndf(), ndfTRK = rTRK->Ndf();
+      double chiSPD = rSPD->Chi2(), chiTRK = rTRK->Chi2();
+      //
+      Bool_t okSPD=kFALSE,okTRK=kFALSE;
+      //
+      if (ndfSPD>1 && (histSPDvtxZ->GetEntries()>100)) okSPD = kTRUE;
+      if (ndfTRK>1 && (histTRKvtxZ->GetEntries()>100)) okTRK = kTRUE;
+      //
+      if (!okSPD && !okTRK) {
+        printf("Neither histos fits have convergecd\n");
+        fStatus=kFitUpdateZFailed;
+      }
+
+      if      (!okSPD) rSPD = rTRK;
+      else if (!okTRK) rTRK = rSPD;
+
+      if (okTRK || okSPD) {
+        ModObject("GRP/Calib/MeanVertex",rTRK->GetParams()[1],rTRK->GetParams()[2], "ZcoordUpdated", db);
+        ModObject("GRP/Calib/MeanVertexSPD",rSPD->GetParams()[1],rSPD->GetParams()[2], "ZcoordUpdated", db);
+      }
     }
   } // end of pass1 case
 
@@ -797,6 +860,17 @@ void AliMeanVertexPreprocessorOffline::ProcessOutput(const char *filename, AliCD
   }
 }
 
+//__________________________________________________________________________
+AliMeanVertexStreamStats* AliMeanVertexPreprocessorOffline::GetStreamStats(TFile *file, TList *list, const char *name, Double_t minEntries) const
+{
+  // streaming estimator written by AliMeanVertexCalibTask, 0x0 if absent or with too few entries
+  AliMeanVertexStreamStats *stats = 0x0;
+  if (list) stats = dynamic_cast<AliMeanVertexStreamStats*>(list->FindObject(name));
+  else if (file) stats = dynamic_cast<AliMeanVertexStreamStats*>(file->Get(name));
+  if (!stats || stats->GetEntries() < minEntries) return 0x0;
+  return stats;
+}
+
 //__________________________________________________________________________
 Int_t AliMeanVertexPreprocessorOffline::GetStatus() {
   /*
@@ -12,6 +12,9 @@
 //
 #include "TNamed.h"
 class AliCDBStorage;
+class AliMeanVertexStreamStats;
+class TFile;
+class TList;
 
 class AliMeanVertexPreprocessorOffline: public TNamed 
 {
@@ -23,12 +26,15 @@ class AliMeanVertexPreprocessorOffline: public TNamed
 	Int_t GetStatus();
 
 	void SetShowPlots(Bool_t showPlots){fShowPlots = showPlots;}
+	void SetUseStreamStats(Bool_t useStats){fUseStreamStats = useStats;}
 
 	void ModObject(const char* url, double zv, double zs, const char* commentAdd, AliCDBStorage *db=0);
 
   private:
 	AliMeanVertexPreprocessorOffline(const AliMeanVertexPreprocessorOffline & proc); // copy constructor	
 	AliMeanVertexPreprocessorOffline& operator=(const AliMeanVertexPreprocessorOffline&); //operator
+
+	AliMeanVertexStreamStats* GetStreamStats(TFile *file, TList *list, const char *name, Double_t minEntries) const;
 	
 	enum EStatusCode_t {
 	  kOk,
@@ -45,8 +51,9 @@ class AliMeanVertexPreprocessorOffline: public TNamed
 	Int_t fStatus; /* status code */
 	static const Char_t *fgkStatusCodeName[kNStatusCodes];
 	Bool_t fShowPlots; /* status code */
+	Bool_t fUseStreamStats; /* take position and z spread from the streaming estimators instead of fits */
 	
-	ClassDef(AliMeanVertexPreprocessorOffline, 3);
+	ClassDef(AliMeanVertexPreprocessorOffline, 4);
 };
 
 #endif
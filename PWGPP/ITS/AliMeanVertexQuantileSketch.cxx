@@ -0,0 +1,142 @@
+/**************************************************************************
+ * Copyright(c) 1998-2011, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//*************************************************************************
+// Class AliMeanVertexQuantileSketch
+// Streaming quantiles of a vertex coordinate with bounded memory.
+// The values are collected in level 0; when a level holds fCapacity
+// values it is sorted and every second value moves to the next level
+// with twice the weight. The rank error is of the order of
+// log2(N/fCapacity)/fCapacity, the memory of fCapacity*log2(N/fCapacity).
+// Sketches filled on different workers are merged level by level.
+//*************************************************************************
+
+#include <algorithm>
+#include <utility>
+
+#include <TCollection.h>
+#include <TMath.h>
+
+#include "AliMeanVertexQuantileSketch.h"
+
+ClassImp(AliMeanVertexQuantileSketch)
+
+//_____________________________________________________________________
+AliMeanVertexQuantileSketch::AliMeanVertexQuantileSketch(Int_t capacity):
+  TObject(),
+  fCapacity(capacity < 2 ? 2 : capacity),
+  fEntries(0),
+  fCompactions(0),
+  fLevels(1)
+{
+  // Constructor
+}
+
+//_____________________________________________________________________
+void AliMeanVertexQuantileSketch::Fill(Double_t x)
+{
+  // Add one value
+  fLevels[0].push_back(x);
+  fEntries++;
+  if ((Int_t)fLevels[0].size() >= fCapacity) Compact(0);
+}
+
+//_____________________________________________________________________
+void AliMeanVertexQuantileSketch::Compact(UInt_t level)
+{
+  // Halve the given level into the next one, cascading upwards
+  for (UInt_t h = level; h < fLevels.size(); h++) {
+    if ((Int_t)fLevels[h].size() < fCapacity) break;
+    if (h + 1 == fLevels.size()) fLevels.resize(h + 2);
+    std::vector<Double_t> &cur = fLevels[h];
+    std::sort(cur.begin(), cur.end());
+    // with an odd number of values the largest one stays at this level
+    UInt_t npairs = cur.size() / 2;
+    UInt_t offset = (fCompactions++) & 1;
+    std::vector<Double_t> &next = fLevels[h + 1];
+    for (UInt_t i = 0; i < npairs; i++) next.push_back(cur[2 * i + offset]);
+    Double_t last = cur.back();
+    Bool_t odd = cur.size() & 1;
+    cur.clear();
+    if (odd) cur.push_back(last);
+  }
+}
+
+//_____________________________________________________________________
+void AliMeanVertexQuantileSketch::Add(const AliMeanVertexQuantileSketch &other)
+{
+  // Merge the content of another sketch
+  if (other.fLevels.size() > fLevels.size()) fLevels.resize(other.fLevels.size());
+  for (UInt_t h = 0; h < other.fLevels.size(); h++)
+    fLevels[h].insert(fLevels[h].end(), other.fLevels[h].begin(), other.fLevels[h].end());
+  fEntries += other.fEntries;
+  for (UInt_t h = 0; h < fLevels.size(); h++) Compact(h);
+}
+
+//_____________________________________________________________________
+Long64_t AliMeanVertexQuantileSketch::Merge(TCollection *list)
+{
+  // Merge a list of sketches into this one
+  if (!list) return 0;
+  if (list->IsEmpty()) return fEntries;
+  TIter next(list);
+  TObject *obj;
+  while ((obj = next())) {
+    AliMeanVertexQuantileSketch *sketch = dynamic_cast<AliMeanVertexQuantileSketch*>(obj);
+    if (!sketch) {
+      Error("Merge", "Attempt to merge object of class %s with %s", obj->ClassName(), ClassName());
+      return -1;
+    }
+    Add(*sketch);
+  }
+  return fEntries;
+}
+
+//_____________________________________________________________________
+void AliMeanVertexQuantileSketch::Clear(Option_t *)
+{
+  fLevels.assign(1, std::vector<Double_t>());
+  fEntries = 0;
+  fCompactions = 0;
+}
+
+//_____________________________________________________________________
+Double_t AliMeanVertexQuantileSketch::GetQuantile(Double_t q) const
+{
+  // Value below which a fraction q of the entries lies (0 if empty)
+  std::vector< std::pair<Double_t, Double_t> > items;
+  Double_t total = 0;
+  for (UInt_t h = 0; h < fLevels.size(); h++) {
+    Double_t weight = TMath::Power(2., (Int_t)h);
+    for (UInt_t i = 0; i < fLevels[h].size(); i++) items.push_back(std::make_pair(fLevels[h][i], weight));
+    total += weight * fLevels[h].size();
+  }
+  if (items.empty()) return 0.;
+  std::sort(items.begin(), items.end());
+  Double_t target = q * total, cumul = 0;
+  for (UInt_t i = 0; i < items.size(); i++) {
+    cumul += items[i].second;
+    if (cumul >= target) return items[i].first;
+  }
+  return items.back().first;
+}
+
+//_____________________________________________________________________
+Double_t AliMeanVertexQuantileSketch::GetRobustSigma() const
+{
+  // Half of the central 68.27% interval, equal to sigma for a gaussian
+  // and insensitive to the tails
+  return 0.5 * (GetQuantile(0.841345) - GetQuantile(0.158655));
+}
@@ -0,0 +1,46 @@
+#ifndef ALIMEANVERTEXQUANTILESKETCH_H
+#define ALIMEANVERTEXQUANTILESKETCH_H
+
+/* Copyright(c) 1998-2011, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//*************************************************************************
+// Class AliMeanVertexQuantileSketch
+// Mergeable streaming quantile estimator of one vertex coordinate
+// (compactor sketch: at most fCapacity values per level, a value at
+// level h stands for 2^h entries)
+//*************************************************************************
+
+#include <vector>
+#include "TObject.h"
+
+class TCollection;
+
+class AliMeanVertexQuantileSketch : public TObject
+{
+ public:
+  AliMeanVertexQuantileSketch(Int_t capacity = 512);
+  virtual ~AliMeanVertexQuantileSketch() {}
+
+  void      Fill(Double_t x);
+  void      Add(const AliMeanVertexQuantileSketch &other);
+  Long64_t  Merge(TCollection *list);
+  virtual void Clear(Option_t *opt = "");
+
+  Long64_t  GetEntries() const {return fEntries;}
+  Double_t  GetQuantile(Double_t q) const;
+  Double_t  GetMedian() const {return GetQuantile(0.5);}
+  Double_t  GetRobustSigma() const;
+
+ private:
+  void      Compact(UInt_t level);
+
+  Int_t     fCapacity;                        // max number of values per level
+  Long64_t  fEntries;                         // number of filled values
+  UInt_t    fCompactions;                     // number of compactions, alternates the kept half
+  std::vector< std::vector<Double_t> > fLevels; // values per level
+
+  ClassDef(AliMeanVertexQuantileSketch, 1);
+};
+
+#endif
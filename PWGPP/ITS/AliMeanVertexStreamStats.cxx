@@ -0,0 +1,202 @@
+/**************************************************************************
+ * Copyright(c) 1998-2011, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//*************************************************************************
+// Class AliMeanVertexStreamStats
+// The moments are accumulated with the Welford update, partial results
+// from different workers or time slices are combined with the pairwise
+// formula of Chan et al., so that the mean and the covariance matrix are
+// available at any time during the pass without binning or fitting.
+//*************************************************************************
+
+#include <algorithm>
+
+#include <TCollection.h>
+#include <TMath.h>
+
+#include "AliMeanVertexStreamStats.h"
+
+ClassImp(AliMeanVertexStreamStats)
+
+//_____________________________________________________________________
+AliMeanVertexStreamStats::AliMeanVertexStreamStats():
+  TNamed(),
+  fRun(-1),
+  fSliceWidth(0),
+  fSliceIndex(),
+  fSliceMoments()
+{
+  // Default constructor
+  for (Int_t i = 0; i < kNMoments; i++) fMoments[i] = 0.;
+}
+
+//_____________________________________________________________________
+AliMeanVertexStreamStats::AliMeanVertexStreamStats(const char *name, const char *title, UInt_t sliceWidth):
+  TNamed(name, title),
+  fRun(-1),
+  fSliceWidth(sliceWidth),
+  fSliceIndex(),
+  fSliceMoments()
+{
+  // Constructor, sliceWidth in seconds
+  for (Int_t i = 0; i < kNMoments; i++) fMoments[i] = 0.;
+}
+
+//_____________________________________________________________________
+void AliMeanVertexStreamStats::AddPoint(Double_t *m, const Double_t v[3])
+{
+  // Welford update of the moments m with one point
+  Double_t n = m[0] + 1.;
+  Double_t d[3], dn[3];
+  for (Int_t i = 0; i < 3; i++) {
+    d[i] = v[i] - m[1 + i];
+    dn[i] = d[i] / n;
+    m[1 + i] += dn[i];
+  }
+  Double_t w = m[0];  // (n-1)/n * d_i*d_j = d_i * dn_j * (n-1)
+  m[4] += w * d[0] * dn[0];
+  m[5] += w * d[1] * dn[1];
+  m[6] += w * d[2] * dn[2];
+  m[7] += w * d[0] * dn[1];
+  m[8] += w * d[0] * dn[2];
+  m[9] += w * d[1] * dn[2];
+  m[0] = n;
+}
+
+//_____________________________________________________________________
+void AliMeanVertexStreamStats::AddMoments(Double_t *m, const Double_t *o)
+{
+  // Combine the moments o into m
+  if (o[0] <= 0) return;
+  if (m[0] <= 0) {
+    for (Int_t i = 0; i < kNMoments; i++) m[i] = o[i];
+    return;
+  }
+  Double_t n = m[0] + o[0];
+  Double_t f = m[0] * o[0] / n;
+  Double_t d[3];
+  for (Int_t i = 0; i < 3; i++) d[i] = o[1 + i] - m[1 + i];
+  m[4] += o[4] + f * d[0] * d[0];
+  m[5] += o[5] + f * d[1] * d[1];
+  m[6] += o[6] + f * d[2] * d[2];
+  m[7] += o[7] + f * d[0] * d[1];
+  m[8] += o[8] + f * d[0] * d[2];
+  m[9] += o[9] + f * d[1] * d[2];
+  for (Int_t i = 0; i < 3; i++) m[1 + i] += d[i] * o[0] / n;
+  m[0] = n;
+}
+
+//_____________________________________________________________________
+Double_t AliMeanVertexStreamStats::GetCovariance(const Double_t *m, Int_t i, Int_t j)
+{
+  // Covariance of the coordinates i and j (0 with less than 2 entries)
+  static const Int_t kIndex[3][3] = {{4, 7, 8}, {7, 5, 9}, {8, 9, 6}};
+  if (m[0] < 2) return 0.;
+  return m[kIndex[i][j]] / (m[0] - 1.);
+}
+
+//_____________________________________________________________________
+Double_t AliMeanVertexStreamStats::GetSigma(Int_t i) const
+{
+  return TMath::Sqrt(GetCovariance(i, i));
+}
+
+//_____________________________________________________________________
+Int_t AliMeanVertexStreamStats::FindSlice(UInt_t index)
+{
+  // Position of the slice with the given index, created if needed
+  std::vector<UInt_t>::iterator it = std::lower_bound(fSliceIndex.begin(), fSliceIndex.end(), index);
+  Int_t is = it - fSliceIndex.begin();
+  if (it == fSliceIndex.end() || *it != index) {
+    fSliceIndex.insert(it, index);
+    fSliceMoments.insert(fSliceMoments.begin() + is * kNMoments, kNMoments, 0.);
+  }
+  return is;
+}
+
+//_____________________________________________________________________
+void AliMeanVertexStreamStats::Fill(Double_t x, Double_t y, Double_t z, UInt_t timeStamp)
+{
+  // Add one vertex
+  Double_t v[3] = {x, y, z};
+  AddPoint(fMoments, v);
+  for (Int_t i = 0; i < 3; i++) fSketch[i].Fill(v[i]);
+  if (fSliceWidth > 0) {
+    Int_t is = FindSlice(timeStamp / fSliceWidth);
+    AddPoint(&fSliceMoments[is * kNMoments], v);
+  }
+}
+
+//_____________________________________________________________________
+void AliMeanVertexStreamStats::Add(const AliMeanVertexStreamStats &other)
+{
+  // Merge the content of another estimator with the same slicing
+  if (fRun < 0) fRun = other.fRun;
+  AddMoments(fMoments, other.fMoments);
+  for (Int_t i = 0; i < 3; i++) fSketch[i].Add(other.fSketch[i]);
+  if (fSliceWidth != other.fSliceWidth) {
+    if (other.GetNSlices()) Warning("Add", "Different time slicing (%d s, %d s), slices not merged", fSliceWidth, other.fSliceWidth);
+    return;
+  }
+  for (Int_t js = 0; js < other.GetNSlices(); js++) {
+    Int_t is = FindSlice(other.fSliceIndex[js]);
+    AddMoments(&fSliceMoments[is * kNMoments], &other.fSliceMoments[js * kNMoments]);
+  }
+}
+
+//_____________________________________________________________________
+Long64_t AliMeanVertexStreamStats::Merge(TCollection *list)
+{
+  // Merge a list of estimators into this one
+  if (!list) return 0;
+  if (list->IsEmpty()) return (Long64_t)GetEntries();
+  TIter next(list);
+  TObject *obj;
+  while ((obj = next())) {
+    AliMeanVertexStreamStats *stats = dynamic_cast<AliMeanVertexStreamStats*>(obj);
+    if (!stats) {
+      Error("Merge", "Attempt to merge object of class %s with %s", obj->ClassName(), ClassName());
+      return -1;
+    }
+    Add(*stats);
+  }
+  return (Long64_t)GetEntries();
+}
+
+//_____________________________________________________________________
+void AliMeanVertexStreamStats::Clear(Option_t *)
+{
+  for (Int_t i = 0; i < kNMoments; i++) fMoments[i] = 0.;
+  fSliceIndex.clear();
+  fSliceMoments.clear();
+  for (Int_t i = 0; i < 3; i++) fSketch[i].Clear();
+}
+
+//_____________________________________________________________________
+void AliMeanVertexStreamStats::Print(Option_t *opt) const
+{
+  printf("%s: run %d, %.0f vertices\n", GetName(), fRun, GetEntries());
+  const char *coord[3] = {"x", "y", "z"};
+  for (Int_t i = 0; i < 3; i++) {
+    printf("  %s: mean %+.4f sigma %.4f | median %+.4f robust sigma %.4f\n",
+	   coord[i], GetMean(i), GetSigma(i), GetMedian(i), GetRobustSigma(i));
+  }
+  if (TString(opt).Contains("slices")) {
+    for (Int_t is = 0; is < GetNSlices(); is++) {
+      printf("  slice %u: %.0f vertices, mean %+.4f %+.4f %+.4f\n", GetSliceStart(is), GetSliceEntries(is),
+	     GetSliceMean(is, 0), GetSliceMean(is, 1), GetSliceMean(is, 2));
+    }
+  }
+}
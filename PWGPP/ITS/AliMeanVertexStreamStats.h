@@ -0,0 +1,74 @@
+#ifndef ALIMEANVERTEXSTREAMSTATS_H
+#define ALIMEANVERTEXSTREAMSTATS_H
+
+/* Copyright(c) 1998-2011, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//*************************************************************************
+// Class AliMeanVertexStreamStats
+// Streaming estimator of the vertex distribution of one vertex type in
+// one run: running moments (mean, covariance matrix) for the whole run
+// and per time slice, quantile sketches of x, y, z for the robust
+// position and beam spread. Mergeable, stored in the output list of
+// AliMeanVertexCalibTask and read by AliMeanVertexPreprocessorOffline.
+//*************************************************************************
+
+#include <vector>
+#include "TNamed.h"
+#include "AliMeanVertexQuantileSketch.h"
+
+class TCollection;
+
+class AliMeanVertexStreamStats : public TNamed
+{
+ public:
+  enum {kNMoments = 10};  // entries, mean x y z, comoments xx yy zz xy xz yz
+
+  AliMeanVertexStreamStats();
+  AliMeanVertexStreamStats(const char *name, const char *title, UInt_t sliceWidth = 600);
+  virtual ~AliMeanVertexStreamStats() {}
+
+  void      Fill(Double_t x, Double_t y, Double_t z, UInt_t timeStamp = 0);
+  void      Add(const AliMeanVertexStreamStats &other);
+  Long64_t  Merge(TCollection *list);
+  virtual void Clear(Option_t *opt = "");
+
+  void      SetRun(Int_t run) {fRun = run;}
+  Int_t     GetRun() const {return fRun;}
+
+  // whole run, index 0,1,2 = x,y,z
+  Double_t  GetEntries() const {return fMoments[0];}
+  Double_t  GetMean(Int_t i) const {return fMoments[1 + i];}
+  Double_t  GetCovariance(Int_t i, Int_t j) const {return GetCovariance(fMoments, i, j);}
+  Double_t  GetSigma(Int_t i) const;
+  Double_t  GetMedian(Int_t i) const {return fSketch[i].GetMedian();}
+  Double_t  GetQuantile(Int_t i, Double_t q) const {return fSketch[i].GetQuantile(q);}
+  Double_t  GetRobustSigma(Int_t i) const {return fSketch[i].GetRobustSigma();}
+
+  // time slices, ordered in time
+  UInt_t    GetSliceWidth() const {return fSliceWidth;}
+  Int_t     GetNSlices() const {return fSliceIndex.size();}
+  UInt_t    GetSliceStart(Int_t is) const {return fSliceIndex[is] * fSliceWidth;}
+  Double_t  GetSliceEntries(Int_t is) const {return fSliceMoments[is * kNMoments];}
+  Double_t  GetSliceMean(Int_t is, Int_t i) const {return fSliceMoments[is * kNMoments + 1 + i];}
+  Double_t  GetSliceCovariance(Int_t is, Int_t i, Int_t j) const {return GetCovariance(&fSliceMoments[is * kNMoments], i, j);}
+
+  virtual void Print(Option_t *opt = "") const;
+
+ private:
+  static void     AddPoint(Double_t *m, const Double_t v[3]);
+  static void     AddMoments(Double_t *m, const Double_t *o);
+  static Double_t GetCovariance(const Double_t *m, Int_t i, Int_t j);
+  Int_t           FindSlice(UInt_t index);
+
+  Int_t     fRun;                           // run number
+  UInt_t    fSliceWidth;                    // width of the time slices (s), 0 for no slicing
+  Double_t  fMoments[kNMoments];            // moments of the whole run
+  std::vector<UInt_t>   fSliceIndex;        // timestamp / fSliceWidth of each slice, ascending
+  std::vector<Double_t> fSliceMoments;      // kNMoments moments per slice
+  AliMeanVertexQuantileSketch fSketch[3];   // quantiles of x, y, z
+
+  ClassDef(AliMeanVertexStreamStats, 1);
+};
+
+#endif
@@ -77,8 +77,11 @@
 #pragma link C++ class AliAnalysisTaskSDDRP+;
 #pragma link C++ class AliSPDUtils+;
 #pragma link C++ class AliAnalysisTaskdEdxSSDQA+;
+#pragma link C++ class AliITSResidualAccumulator+;
 #pragma link C++ class AliMeanVertexCalibTask+;
 #pragma link C++ class AliMeanVertexPreprocessorOffline+;
+#pragma link C++ class AliMeanVertexQuantileSketch+;
+#pragma link C++ class AliMeanVertexStreamStats+;
 
 #pragma link C++ class AliRelAlignerKalmanArray+;
 #pragma link C++ class AliAnalysisTaskITSTPCalignment+;
@@ -106,6 +109,7 @@
 #pragma link C++ class  AliTRDtrackInfo+;
 #pragma link C++ class  AliTRDtrackInfo::AliESDinfo+;
 #pragma link C++ class  AliTRDtrackInfo::AliMCinfo+;
+#pragma link C++ class  AliTRDtrackletRecords+;
 #pragma link C++ class  AliTRDeventCuts+;
 #pragma link C++ class  AliTRDeventInfo+;
 #pragma link C++ class  AliTRDpidInfo+;
@@ -156,6 +160,7 @@
 #pragma link C++ class  AliTaskCDBconnect+;
 // Centrality classes
 #pragma link C++ class  AliMultiplicityCorrelations+;
+#pragma link C++ class  AliMultiplicityCovariance+;
 #pragma link C++ class  AliAnalysisTaskHIMultCorr+;
 // ZDC
 #pragma link C++ class  AliAnalysisTaskZDCpp+;
@@ -199,5 +204,6 @@
 #pragma link C++ class  AliXMLEngine::Node+;
 #pragma link C++ class  AliXMLEngine::Attr+;
 #pragma link C++ class  AliXMLEngine+;
+#pragma link C++ class  AliVdMScanCounters+;
 
 #endif
@@ -32,6 +32,8 @@
 #include "TH2F.h"
 #include "TFile.h"
 #include "TH1D.h"
+#include "TProfile.h"
+#include "TArrayF.h"
 #include "TObjArray.h"
 #include "TString.h"
 #include "TObjString.h"
@@ -41,6 +43,7 @@
 #include "TGrid.h"
 #include "TTimeStamp.h"
 #include "AliTOFRunParams.h"
+#include "AliTOFGeometry.h"
 #include "AliCDBStorage.h"
 #include "AliCDBId.h"
 #include "AliCDBMetaData.h"
@@ -76,6 +79,7 @@ AliTOFAnalysisTaskCalibPass0::AliTOFAnalysisTaskCalibPass0() :
   fEventSelectionFlag(kFALSE),
   fVertexSelectionFlag(kFALSE),
   fVertexCut(10.),
+  fChannelOffsetFlag(kFALSE),
   fRunNumber(0),
   fESDEvent(NULL),
   fEventCuts(new AliPhysicsSelection()),
@@ -95,7 +99,8 @@ AliTOFAnalysisTaskCalibPass0::AliTOFAnalysisTaskCalibPass0() :
   fHistoDeltatEta(NULL),
   fHistoDeltazCosTheta(NULL),
   fHistoAcceptedTracksEtaPt(NULL),
-  fHistoMatchedTracksEtaPt(NULL)
+  fHistoMatchedTracksEtaPt(NULL),
+  fHistoDeltatChannel(NULL)
 {
   /* 
    * default constructor 
@@ -180,6 +185,8 @@ AliTOFAnalysisTaskCalibPass0::InitRun()
   fHistoDeltazCosTheta->SetTitle(Form("run: %d, startTimestamp: %u, BPTX: %d", fRunNumber, fStartTime, useBPTX));
   fHistoAcceptedTracksEtaPt->SetTitle(Form("run: %d, startTimestamp: %u, BPTX: %d", fRunNumber, fStartTime, useBPTX));
   fHistoMatchedTracksEtaPt->SetTitle(Form("run: %d, startTimestamp: %u, BPTX: %d", fRunNumber, fStartTime, useBPTX));
+  if (fHistoDeltatChannel)
+    fHistoDeltatChannel->SetTitle(Form("run: %d, startTimestamp: %u, BPTX: %d", fRunNumber, fStartTime, useBPTX));
   
   return kTRUE;
 }
@@ -295,6 +302,13 @@ AliTOFAnalysisTaskCalibPass0::UserCreateOutputObjects()
   fHistoMatchedTracksEtaPt = new TH2F("hHistoMatchedTracksEtaPt", ";#eta;p_{T} (GeV/c);", etaBins, etaMin, etaMax, pBins, pMin, pMax);
   fHistoList->Add(fHistoMatchedTracksEtaPt);
 
+  // Time shift per channel, accumulated over the run (channel-offset table, see ExtractChannelOffsets)
+  if (fChannelOffsetFlag) {
+    Int_t nChannels = AliTOFGeometry::NSectors() * AliTOFGeometry::NPadXSector();
+    fHistoDeltatChannel = new TProfile("hHistoDeltatChannel", ";channel index;t - t_{exp}^{(#pi)} (ps);", nChannels, 0., nChannels, deltatMin, deltatMax);
+    fHistoList->Add(fHistoDeltatChannel);
+  }
+
   /* post data */
   PostData(1, fHistoList);
 }
@@ -362,6 +376,7 @@ AliTOFAnalysisTaskCalibPass0::UserExec(Option_t *)
     fHistoDeltazEta->Fill(eta, deltaz);
     fHistoDeltatEta->Fill(eta, deltat);
     fHistoDeltazCosTheta->Fill(costheta, deltaz);
+    if (fHistoDeltatChannel) fHistoDeltatChannel->Fill(index, deltat);
     
   } /* end of loop over ESD tracks */
 
@@ -434,6 +449,42 @@ AliTOFAnalysisTaskCalibPass0::PrintStatus()
 
 //_______________________________________________________
 
+Int_t
+AliTOFAnalysisTaskCalibPass0::ExtractChannelOffsets(const TProfile *histoDeltatChannel, TArrayF &offsets, Double_t minEntries)
+{
+  /*
+   * channel-offset table: mean deltat of each channel with respect
+   * to the mean over all channels, zero for channels with less than
+   * minEntries hits. returns the number of channels with an offset
+   */
+
+  if (!histoDeltatChannel) {
+    offsets.Set(0);
+    return 0;
+  }
+  Int_t nChannels = histoDeltatChannel->GetNbinsX();
+  offsets.Set(nChannels);
+  offsets.Reset();
+  Double_t sum = 0., entries = 0.;
+  for (Int_t ich = 0; ich < nChannels; ich++) {
+    Double_t n = histoDeltatChannel->GetBinEntries(ich + 1);
+    if (n < minEntries) continue;
+    sum += histoDeltatChannel->GetBinContent(ich + 1) * n;
+    entries += n;
+  }
+  if (entries <= 0.) return 0;
+  Double_t mean = sum / entries;
+  Int_t nOffsets = 0;
+  for (Int_t ich = 0; ich < nChannels; ich++) {
+    if (histoDeltatChannel->GetBinEntries(ich + 1) < minEntries) continue;
+    offsets[ich] = histoDeltatChannel->GetBinContent(ich + 1) - mean;
+    nOffsets++;
+  }
+  return nOffsets;
+}
+
+//_______________________________________________________
+
 Bool_t
 AliTOFAnalysisTaskCalibPass0::ProcessOutput(const Char_t *filename, AliCDBStorage* db)
 {
@@ -24,6 +24,8 @@ class TList;
 class TH2F;
 class TF1;
 class TH1D;
+class TProfile;
+class TArrayF;
 class AliCDBStorage;
 
 class AliTOFAnalysisTaskCalibPass0 :
@@ -47,12 +49,14 @@ public AliAnalysisTaskSE
   void SetEventSelectionFlag(Bool_t value = kTRUE) {fEventSelectionFlag = value;}; // setter
   void SetVertexSelectionFlag(Bool_t value = kTRUE) {fVertexSelectionFlag = value;}; // setter
   void SetVertexCut(Double_t value) {fVertexCut = value;}; // setter
+  void SetChannelOffsetFlag(Bool_t value = kTRUE) {fChannelOffsetFlag = value;}; // setter
 
   /* post-processing methods */
   Bool_t ProcessOutput(const Char_t *filename, AliCDBStorage* db); // process output
   Bool_t DoProcessOutput(const Char_t *filename, AliCDBStorage* db); // process output
   Int_t GetStatus(); // get status
   void PrintStatus(); // print status
+  static Int_t ExtractChannelOffsets(const TProfile *histoDeltatChannel, TArrayF &offsets, Double_t minEntries = 10.); // channel-offset table
 
   /* static setters */
   static void SetMinVertexIntegral(Double_t value) {fgMinVertexIntegral = value;}; // setter
@@ -94,6 +98,7 @@ public AliAnalysisTaskSE
   Bool_t fEventSelectionFlag; // event selection flag
   Bool_t fVertexSelectionFlag; // vertex selection flag
   Double_t fVertexCut; // vertex cut
+  Bool_t fChannelOffsetFlag; // fill the per-channel deltat profile
 
   /* ESD analysis */
   Int_t fRunNumber; // run number
@@ -122,6 +127,7 @@ public AliAnalysisTaskSE
   TH2F *fHistoDeltazCosTheta; // deltaz-costheta histo
   TH2F *fHistoAcceptedTracksEtaPt; // accepted tracks eta-pt histo
   TH2F *fHistoMatchedTracksEtaPt; // matched tracks eta-pt histo
+  TProfile *fHistoDeltatChannel; // deltat-channel profile
 
   /* post-processing variables */
   static const Int_t fgkMaxNumberOfPoints; // max number of points
@@ -131,7 +137,7 @@ public AliAnalysisTaskSE
   static Double_t fgMinDeltatIntegralSample; // min vertex integral sample
 
 
-  ClassDef(AliTOFAnalysisTaskCalibPass0, 2);
+  ClassDef(AliTOFAnalysisTaskCalibPass0, 3);
 };
 
 #endif /* ALIANALYSISTASKEVENTTIME_H */
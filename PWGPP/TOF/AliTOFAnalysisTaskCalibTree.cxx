@@ -69,6 +69,8 @@ AliAnalysisTaskSE(name),
   fDeltaraw(0),
   fHitFlag(0),
   fSaveCoordinates(kFALSE),
+  fSaveExpectedTimes(kFALSE),
+  ftexpall(0),
   fTOFClusters(0),
   fOutputTree(0x0)             
 
@@ -88,6 +90,7 @@ AliAnalysisTaskSE(name),
   fDeltat = new Float_t[fMaxHits];
   fDeltaraw = new Float_t [fMaxHits];
   fHitFlag = new UChar_t [fMaxHits]; 
+  ftexpall = new Float_t[fMaxHits * AliPID::kSPECIES];
   for (Int_t i = 0; i < fMaxHits; i++){
       fmomentum[i] = 999999;
       flength[i] = 999999;
@@ -126,17 +129,18 @@ AliTOFAnalysisTaskCalibTree::~AliTOFAnalysisTaskCalibTree()
   delete fESDEvent;
   delete fVertex;
 
-  delete fmomentum;
-  delete flength;
-  delete findex;
-  delete ftime;
-  delete ftot;
-  delete ftexp;
-  delete fDeltax;
-  delete fDeltaz;
-  delete fDeltat;
-  delete fDeltaraw;
-  delete fHitFlag;
+  delete [] fmomentum;
+  delete [] flength;
+  delete [] findex;
+  delete [] ftime;
+  delete [] ftot;
+  delete [] ftexp;
+  delete [] fDeltax;
+  delete [] fDeltaz;
+  delete [] fDeltat;
+  delete [] fDeltaraw;
+  delete [] fHitFlag;
+  delete [] ftexpall;
   if (fOutputTree) {
     delete fOutputTree;
     fOutputTree = 0x0;
@@ -183,6 +187,11 @@ if (fSaveCoordinates) { //save reduced tree for coordinate study
 
    }
 
+if (fSaveExpectedTimes) { // columns for the calibration passes: deltat and the expected times of all species of each hit
+  fOutputTree->Branch("deltat", fDeltat, "deltat[nhits]/F");
+  fOutputTree->Branch("texpall", ftexpall, Form("texpall[nhits][%d]/F", AliPID::kSPECIES));
+}
+
   PostData(1, fOutputTree);
 
 }
@@ -253,7 +262,7 @@ void AliTOFAnalysisTaskCalibTree::UserExec(Option_t *) {
     deltat = (time - timei[AliPID::kPion] - timeZeroTOF);
     deltaraw = (track->GetTOFsignalRaw() - timei[AliPID::kPion] - timeZeroTOF);
     // add hit to array (if there is room)
-    if (fnhits > fMaxHits) continue;
+    if (fnhits >= fMaxHits) continue;
     fmomentum[fnhits] = momentum;
     flength[fnhits] = length;
     ftexp[fnhits] = timei[AliPID::kPion];
@@ -265,6 +274,8 @@ void AliTOFAnalysisTaskCalibTree::UserExec(Option_t *) {
     fDeltat[fnhits] = deltat;
     fDeltaraw[fnhits] = deltaraw;
     fHitFlag[fnhits] = 0; 
+    if (fSaveExpectedTimes)
+      for (Int_t ipart = 0; ipart < AliPID::kSPECIES; ipart++) ftexpall[fnhits * AliPID::kSPECIES + ipart] = timei[ipart];
     if (fSaveCoordinates){ // set hit flags
      
          SetClusterFlags(track,fnhits);  // check for multiple hits & adjjacent clusters in X and Z (flags 1,2,4)
@@ -62,6 +62,7 @@ public AliAnalysisTaskSE
   void SetSpecificStorageRunParams(Char_t *value) {fSpecificStorageRunParams = value;}; // set specific storage RunParams
   void SetSpecificStorageFineSlewing(Char_t *value) {fSpecificStorageFineSlewing = value;}; // set specific storage FineSlewing
   void SetSaveCoordinates(Bool_t value = kTRUE) {fSaveCoordinates = value;}; // set flag to save hit coordinates in tree
+  void SetSaveExpectedTimes(Bool_t value = kTRUE) {fSaveExpectedTimes = value;}; // set flag to save deltat and the expected times of all species in tree
 
   void SetClusterFlags(AliESDtrack *track, Int_t itrack); // set clusterisation flags in output tree
  protected:
@@ -135,11 +136,13 @@ public AliAnalysisTaskSE
   Float_t* fDeltaraw;       //[fMaxHits] delta-raw
   UChar_t* fHitFlag;        //[fMaxHits] hit flag. 1 = multiple hit; 2 = adj. cluster in x; 4 = adj. cluster in z; 8 = track primary candidate; 16 = good track Nclusters in TPC; 32 = track good TPC chi2; 64 = good T0
   Bool_t fSaveCoordinates;
+  Bool_t fSaveExpectedTimes;
+  Float_t* ftexpall;        //!<! texp of all species, packed [hit][species]
   TClonesArray* fTOFClusters; //!<! array of TOF clusters
 
   TTree* fOutputTree;                 //!<! output tree
 
-  ClassDef(AliTOFAnalysisTaskCalibTree, 5);
+  ClassDef(AliTOFAnalysisTaskCalibTree, 6);
 };
 
 #endif /* ALIANALYSISTASKTOFCOMPACTCALIB_H */
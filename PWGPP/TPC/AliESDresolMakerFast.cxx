@@ -56,6 +56,12 @@
   TF1 f1sy("f1sy","AliESDresolParams::SGetResolPrimFast(0,x,0)",0,10);
   f2sy->Draw("surf2")
   f1sy->Draw();
+  //
+  // Streaming backend - all the parameters in one pass, no (robust) fit per parameter
+  // the parameterization is fitted to the (median) values in bins of 1/pt and tan(theta)
+  //
+  AliESDresolParams paramsStream; 
+  TObjArray * arrayStream = AliESDresolMakerFast::MakeParamPrimStream(tree,cutDCA,2000,kTRUE,&paramsStream);
 
 */
 
@@ -66,6 +72,12 @@
 #include "TMath.h"
 #include "TCut.h"
 #include "TTree.h"
+#include "TTreeFormula.h"
+#include "TTreeFormulaManager.h"
+#include "TLinearFitter.h"
+#include "TObjArray.h"
+#include <vector>
+#include <algorithm>
 
 #include "AliESDresolParams.h"
 #include "AliESDresolMakerFast.h"
@@ -221,3 +233,218 @@ TObjArray * AliESDresolMakerFast::MakeParamRFast(TTree * tree,  TCut &cutV0, Flo
   return array;
 
 }
+
+
+//
+// Running statistics of one bin - mean, RMS (Welford) and median (P2 algorithm,
+// R.Jain and I.Chlamtac, Comm. ACM 28 (1985) 1076) without storing the values
+//
+struct AliESDresolBinStat {
+  AliESDresolBinStat(): fN(0), fMean(0), fM2(0) { for (Int_t i=0;i<5;i++) {fQ[i]=0; fPos[i]=i+1; fDes[i]=i+1;} }
+  void Add(Double_t x){
+    fN++;
+    Double_t delta=x-fMean;
+    fMean+=delta/fN;
+    fM2+=delta*(x-fMean);
+    if (fN<=5){
+      fQ[fN-1]=x;
+      if (fN==5) std::sort(fQ,fQ+5);
+      return;
+    }
+    Int_t k=0;
+    if (x<fQ[0])       {fQ[0]=x; k=0;}
+    else if (x>=fQ[4]) {fQ[4]=x; k=3;}
+    else               {while (k<3 && x>=fQ[k+1]) k++;}
+    for (Int_t i=k+1;i<5;i++) fPos[i]++;
+    const Double_t kInc[5]={0,0.25,0.5,0.75,1};
+    for (Int_t i=0;i<5;i++) fDes[i]+=kInc[i];
+    for (Int_t i=1;i<4;i++){
+      Double_t d=fDes[i]-fPos[i];
+      if ((d>=1 && fPos[i+1]-fPos[i]>1) || (d<=-1 && fPos[i-1]-fPos[i]<-1)){
+        Int_t sign=(d>0)?1:-1;
+        Double_t qp=fQ[i]+sign/(fPos[i+1]-fPos[i-1])*((fPos[i]-fPos[i-1]+sign)*(fQ[i+1]-fQ[i])/(fPos[i+1]-fPos[i])+(fPos[i+1]-fPos[i]-sign)*(fQ[i]-fQ[i-1])/(fPos[i]-fPos[i-1]));
+        if (qp<=fQ[i-1] || qp>=fQ[i+1]) qp=fQ[i]+sign*(fQ[i+sign]-fQ[i])/(fPos[i+sign]-fPos[i]);
+        fQ[i]=qp;
+        fPos[i]+=sign;
+      }
+    }
+  }
+  Double_t GetRMS() const { return (fN>1)? TMath::Sqrt(fM2/(fN-1)):0;}
+  Double_t GetMedian() const { 
+    if (fN>=5) return fQ[2];
+    Double_t q[5]; 
+    for (Int_t i=0;i<fN;i++) q[i]=fQ[i];
+    return (fN>0) ? TMath::Median(fN,q):0;
+  }
+  Long64_t fN;       // number of entries
+  Double_t fMean;    // running mean
+  Double_t fM2;      // running sum of squared deviations 
+  Double_t fQ[5];    // P2 marker heights
+  Double_t fPos[5];  // P2 marker positions
+  Double_t fDes[5];  // P2 desired marker positions
+};
+
+
+
+Int_t AliESDresolMakerFast::GetStreamTerms(Int_t type, Int_t ivar, Double_t x, Double_t y, Double_t *terms, Int_t *index){
+  //
+  // terms of the parameterization, as used in AliESDresolParams
+  // type 0 - GetResolPrimFast: x=1/pt, y=tan(theta)
+  // type 1 - GetResolRFast:    x=1/pt, y=radius
+  // index - position of the term in the parameter vector
+  // return number of terms
+  //
+  if (type==0){
+    Double_t val[5]={x,x*x,y,y*y,x*y};
+    for (Int_t i=0;i<5;i++) {terms[i]=val[i]; index[i]=i+1;}
+    return 5;
+  }
+  Double_t val[6]={x,y,x*x,y*y,x*y,x*y*y};
+  if (ivar==2 || ivar==3){ // phi and theta - no radius^2 terms, as in MakeParamRFast
+    Int_t sel[4]={0,1,2,4};
+    for (Int_t i=0;i<4;i++) {terms[i]=val[sel[i]]; index[i]=sel[i]+1;}
+    return 4;
+  }
+  for (Int_t i=0;i<6;i++) {terms[i]=val[i]; index[i]=i+1;}
+  return 6;
+}
+
+
+
+TObjArray * AliESDresolMakerFast::MakeParamStream(TTree * tree, TCut &cut, Int_t type, const char *binX, const char *binY, Double_t maxX, Double_t maxY, Int_t nBinsY, Int_t nVar, const char **vars, Int_t entries, Bool_t useMedian){
+  //
+  // Streaming resolution parameterization - one pass over the tree
+  // The selection, the binning variables and all the resolution variables 
+  // are evaluated with TTreeFormulas in the same loop; for each bin 
+  // in binX (1/pt) and binY the running mean, RMS and median are kept.
+  // The parameterization is then fitted to the bin values (median or mean),
+  // weighted with their errors.
+  // Arguments:
+  // entries   - number of tree entries used (as in MakeParamPrimFast)
+  // useMedian - use the bin medians (robust) instead of the means
+  //
+  const Int_t kNBinsX=16;
+  const Int_t kMinEntries=10;
+  const Int_t nBins=kNBinsX*nBinsY;
+  std::vector<AliESDresolBinStat> stat(nBins*nVar);
+  std::vector<Double_t> sumX(nBins,0), sumY(nBins,0);
+  std::vector<Long64_t> nBin(nBins,0);
+  //
+  if (tree->LoadTree(0)<0) return 0;
+  TTreeFormula *formCut = new TTreeFormula("resolCut",cut.GetTitle(),tree);
+  TTreeFormula *formX   = new TTreeFormula("resolX",binX,tree);
+  TTreeFormula *formY   = new TTreeFormula("resolY",binY,tree);
+  std::vector<TTreeFormula*> formVar(nVar);
+  TTreeFormulaManager *manager = new TTreeFormulaManager;
+  manager->Add(formCut);
+  manager->Add(formX);
+  manager->Add(formY);
+  for (Int_t ivar=0; ivar<nVar; ivar++) {
+    formVar[ivar] = new TTreeFormula(Form("resolVar%d",ivar),vars[ivar],tree);
+    manager->Add(formVar[ivar]);
+  }
+  manager->Sync();
+  //
+  Int_t treeNumber=-1;
+  for (Long64_t ientry=0; ientry<entries; ientry++){
+    if (tree->LoadTree(ientry)<0) break;
+    if (tree->GetTreeNumber()!=treeNumber){
+      treeNumber=tree->GetTreeNumber();
+      formCut->UpdateFormulaLeaves();
+      formX->UpdateFormulaLeaves();
+      formY->UpdateFormulaLeaves();
+      for (Int_t ivar=0; ivar<nVar; ivar++) formVar[ivar]->UpdateFormulaLeaves();
+    }
+    Int_t ndata = manager->GetNdata();
+    for (Int_t i=0; i<ndata; i++){
+      if (formCut->EvalInstance(i)==0) continue;
+      Double_t x = formX->EvalInstance(i);
+      Double_t y = formY->EvalInstance(i);
+      if (!(x>=0 && x<maxX && y>=0 && y<maxY)) continue;
+      Int_t ibin = Int_t(x*kNBinsX/maxX)*nBinsY+Int_t(y*nBinsY/maxY);
+      sumX[ibin]+=x;
+      sumY[ibin]+=y;
+      nBin[ibin]++;
+      for (Int_t ivar=0; ivar<nVar; ivar++){
+        Double_t val = formVar[ivar]->EvalInstance(i);
+        if (TMath::Finite(val)) stat[ibin*nVar+ivar].Add(val);
+      }
+    }
+  }
+  delete formCut;
+  delete formX;
+  delete formY;
+  for (Int_t ivar=0; ivar<nVar; ivar++) delete formVar[ivar];   // the last one deletes the manager
+  //
+  // fit the parameterization to the bin values
+  //
+  TObjArray *array = new TObjArray(nVar);
+  Double_t terms[6];
+  Int_t    index[6];
+  for (Int_t ivar=0; ivar<nVar; ivar++){
+    Int_t nTerms = GetStreamTerms(type,ivar,0,0,terms,index);
+    TLinearFitter fitter(nTerms,Form("hyp%d",nTerms));
+    Int_t npoints=0;
+    for (Int_t ibin=0; ibin<nBins; ibin++){
+      const AliESDresolBinStat &bin = stat[ibin*nVar+ivar];
+      if (bin.fN<kMinEntries) continue;
+      Double_t value = useMedian ? bin.GetMedian():bin.fMean;
+      Double_t error = bin.GetRMS()/TMath::Sqrt(Double_t(bin.fN));
+      if (useMedian) error*=1.253;   // error of the median for a gaussian
+      if (error<=0) continue;
+      GetStreamTerms(type,ivar,sumX[ibin]/nBin[ibin],sumY[ibin]/nBin[ibin],terms,index);
+      fitter.AddPoint(terms,value,error);
+      npoints++;
+    }
+    TVectorD param(type==0 ? 6:7);
+    if (npoints>nTerms && fitter.Eval()==0){
+      TVectorD fitParam;
+      fitter.GetParameters(fitParam);
+      param[0]=fitParam[0];
+      for (Int_t i=0; i<nTerms; i++) param[index[i]]=fitParam[i+1];
+    }
+    printf("%s\t%d bins\t",vars[ivar],npoints);
+    param.Print();
+    array->AddAt(new TVectorD(param),ivar);
+  }
+  return array;
+}
+
+
+
+TObjArray * AliESDresolMakerFast::MakeParamPrimStream(TTree * tree, TCut &cutDCA, Int_t entries, Bool_t useMedian, AliESDresolParams *params){
+  //
+  // DCA resolution parameterization at the primary vertex - streaming backend
+  // same variables and output as MakeParamPrimFast, all parameters in one pass
+  // params - if set, the parameterization is exported to it (SetResolPrimFast)
+  //
+  const char * vars[5]={
+    "sqrt(Tracks[].fC[0])/(0.2+abs(Tracks[].fP[4]))",
+    "sqrt(Tracks[].fC[2])/(0.2+abs(Tracks[].fP[4]))",
+    "sqrt(Tracks[].fC[5])/(0.1+abs(Tracks[].fP[4]))",
+    "sqrt(Tracks[].fC[9])/((0.1+abs(Tracks[].fP[4])*(1+Tracks[].fP[3]^2)))",
+    "sqrt(Tracks[].fC[14])/(1+abs(Tracks[].fP[4]))^2"};
+  TObjArray * array = MakeParamStream(tree,cutDCA,0,"abs(Tracks[].fP[4])","abs(Tracks[].fP[3])",8.,1.,10,5,vars,entries,useMedian);
+  if (params) params->SetResolPrimFast(array);
+  return array;
+}
+
+
+
+TObjArray * AliESDresolMakerFast::MakeParamRStream(TTree * tree, TCut &cutV0, Int_t entries, Bool_t useMedian, AliESDresolParams *params, Double_t maxR){
+  //
+  // V0 resolution parameterization, radial dependence - streaming backend
+  // same variables and output as MakeParamRFast, all parameters in one pass
+  // the vectors are in the AliESDresolParams::GetResolRFast order (7 parameters) 
+  // params - if set, the parameterization is exported to it (SetResolRFast)
+  //
+  const char * vars[5]={
+    "sqrt(sqrt((V0s[].fParamP.fC[0]))/(0.2+abs(V0s[].fParamP.fP[4])))",
+    "sqrt(sqrt((V0s[].fParamP.fC[2])))",
+    "sqrt(sqrt((V0s[].fParamP.fC[5]))/(0.1+abs(V0s[].fParamP.fP[4])))",
+    "sqrt(sqrt((V0s[].fParamP.fC[9]))/((0.1+abs(V0s[].fParamP.fP[4])*(1+abs(V0s[].fParamP.fP[3])^2))))",
+    "sqrt(sqrt((V0s[].fParamP.fC[14])))"};
+  TObjArray * array = MakeParamStream(tree,cutV0,1,"abs(V0s[].fParamP.fP[4])","V0s[].fParamP.fX",8.,maxR,25,5,vars,entries,useMedian);
+  if (params) params->SetResolRFast(array);
+  return array;
+}
@@ -15,6 +15,7 @@
 class TTree;
 class TObjArray; 
 class TCut;
+class AliESDresolParams;
 //
 class AliESDresolMakerFast : public TObject{
  public:
@@ -22,6 +23,13 @@ class AliESDresolMakerFast : public TObject{
   //
   static TObjArray * MakeParamPrimFast(TTree * tree, TCut &cutDCA, Float_t fraction=-1, Int_t entries=100000);
   static TObjArray * MakeParamRFast(TTree * tree, TCut &cutV0, Float_t fraction=-1, Int_t entries=100000);
+  //
+  // streaming backend - one pass over the tree, running mean/RMS and median per bin
+  static TObjArray * MakeParamPrimStream(TTree * tree, TCut &cutDCA, Int_t entries=100000, Bool_t useMedian=kTRUE, AliESDresolParams *params=0);
+  static TObjArray * MakeParamRStream(TTree * tree, TCut &cutV0, Int_t entries=100000, Bool_t useMedian=kTRUE, AliESDresolParams *params=0, Double_t maxR=250.);
+ protected:
+  static TObjArray * MakeParamStream(TTree * tree, TCut &cut, Int_t type, const char *binX, const char *binY, Double_t maxX, Double_t maxY, Int_t nBinsY, Int_t nVar, const char **vars, Int_t entries, Bool_t useMedian);
+  static Int_t GetStreamTerms(Int_t type, Int_t ivar, Double_t x, Double_t y, Double_t *terms, Int_t *index);
   // protected:
  public:
   // 
@@ -258,10 +258,18 @@ void AliPerformanceDCA::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
 {
   // Process comparison information 
   //
+  ExecAllTracks(mcEvent,vEvent,vFriendEvent,bUseMC,bUseVfriend);
+}
+
+//_____________________________________________________________________________
+Bool_t AliPerformanceDCA::ExecEvent(AliMCEvent* const mcEvent, AliVEvent *const vEvent, AliVfriendEvent *const vFriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend)
+{
+  // Event selection
+  //
   if(!vEvent) 
   {
     Error("Exec","vEvent not available");
-    return;
+    return kFALSE;
   }
   AliHeader* header = 0;
   AliGenEventHeader* genHeader = 0;
@@ -271,19 +279,19 @@ void AliPerformanceDCA::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
   {
     if(!mcEvent) {
       Error("Exec","mcEvent not available");
-      return;
+      return kFALSE;
     }
     // get MC event header
     header = mcEvent->Header();
     if (!header) {
       Error("Exec","Header not available");
-      return;
+      return kFALSE;
     }
     // get MC vertex
     genHeader = header->GenEventHeader();
     if (!genHeader) {
       Error("Exec","Could not retrieve genHeader from Header");
-      return;
+      return kFALSE;
     }
     genHeader->PrimaryVertex(vtxMC);
   } 
@@ -291,14 +299,14 @@ void AliPerformanceDCA::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
   if(bUseVfriend) {
     if(!vFriendEvent) {
       Error("Exec","vFriend not available");
-      return;
+      return kFALSE;
     }
   }
 
   // trigger
   if(!bUseMC &&GetTriggerClass()) {
     Bool_t isEventTriggered = vEvent->IsTriggerClassFired(GetTriggerClass());
-    if(!isEventTriggered) return; 
+    if(!isEventTriggered) return kFALSE; 
   }
 
   // get event vertex
@@ -312,21 +320,27 @@ void AliPerformanceDCA::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
     // TPC track vertex
     vVertex = vEvent->GetPrimaryVertexTPC();
   }
-  if(vVertex && (vVertex->GetStatus()<=0)) return;
+  if(vVertex && (vVertex->GetStatus()<=0)) return kFALSE;
 
-  //  Process events
-  for (Int_t iTrack = 0; iTrack < vEvent->GetNumberOfTracks(); iTrack++) 
-  { 
-    AliVTrack *track = dynamic_cast<AliVTrack*>(vEvent->GetTrack(iTrack));
-    if(!track) continue;
-    if(GetAnalysisMode() == 0) ProcessTPC(mcEvent,track,vEvent);
-    else if(GetAnalysisMode() == 1) ProcessTPCITS(mcEvent,track,vEvent);
-    else if(GetAnalysisMode() == 2) ProcessConstrained(mcEvent,track);
-    else {
-      printf("ERROR: AnalysisMode %d \n",fAnalysisMode);
-      return;
-    }
+  if(GetAnalysisMode() < 0 || GetAnalysisMode() > 2) {
+    printf("ERROR: AnalysisMode %d \n",fAnalysisMode);
+    return kFALSE;
   }
+
+  fMCEvent = mcEvent;
+  fEvent = vEvent;
+
+return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceDCA::ExecTrack(const AliPerformanceTrackInfo &info)
+{
+  // Process one track of the event
+  //
+  if(GetAnalysisMode() == 0) ProcessTPC(fMCEvent,info.fTrack,fEvent);
+  else if(GetAnalysisMode() == 1) ProcessTPCITS(fMCEvent,info.fTrack,fEvent);
+  else if(GetAnalysisMode() == 2) ProcessConstrained(fMCEvent,info.fTrack);
 }
 
 //_____________________________________________________________________________
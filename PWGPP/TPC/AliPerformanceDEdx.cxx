@@ -374,10 +374,18 @@ void AliPerformanceDEdx::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent
 {
   // Process comparison information 
   //
+  ExecAllTracks(mcEvent,vEvent,vFriendEvent,bUseMC,bUseVfriend);
+}
+
+//_____________________________________________________________________________
+Bool_t AliPerformanceDEdx::ExecEvent(AliMCEvent* const mcEvent, AliVEvent *const vEvent, AliVfriendEvent *const vFriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend)
+{
+  // Event selection
+  //
   if(!vEvent)
   {
       AliDebug(AliLog::kError, "esdEvent not available");
-      return;
+      return kFALSE;
   }
   AliHeader* header = 0;
   AliGenEventHeader* genHeader = 0;
@@ -387,21 +395,21 @@ void AliPerformanceDEdx::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent
   {
     if(!mcEvent) {
       AliDebug(AliLog::kError, "mcEvent not available");
-      return;
+      return kFALSE;
     }
 
     // get MC event header
     header = mcEvent->Header();
     if (!header) {
       AliDebug(AliLog::kError, "Header not available");
-      return;
+      return kFALSE;
     }
 
     // get MC vertex
     genHeader = header->GenEventHeader();
     if (!genHeader) {
       AliDebug(AliLog::kError, "Could not retrieve genHeader from Header");
-      return;
+      return kFALSE;
     }
     genHeader->PrimaryVertex(vtxMC);
 
@@ -411,14 +419,14 @@ void AliPerformanceDEdx::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent
   if(bUseVfriend) {
     if(!vFriendEvent) {
       AliDebug(AliLog::kError, "vFriend not available");
-      return;
+      return kFALSE;
     }
   }
 
   // trigger
   if(!bUseMC && GetTriggerClass()) {
     Bool_t isEventTriggered = vEvent->IsTriggerClassFired(GetTriggerClass());
-    if(!isEventTriggered) return; 
+    if(!isEventTriggered) return kFALSE; 
   }
 
   // get event vertex
@@ -431,29 +439,32 @@ void AliPerformanceDEdx::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent
     // TPC track vertex
     vVertex = vEvent->GetPrimaryVertexTPC();
   }
-  if(vVertex && (vVertex->GetStatus()<=0)) return;
+  if(vVertex && (vVertex->GetStatus()<=0)) return kFALSE;
   if(!vVertex) {
     printf("ERROR: Could not determine primary vertex");
-    return;
+    return kFALSE;
   }
   
-  //  Process events
-  for (Int_t iTrack = 0; iTrack < vEvent->GetNumberOfTracks(); iTrack++) 
-  {
-    AliVParticle *particle = vEvent->GetTrack(iTrack);
-    if(!particle) continue;
-    AliVTrack *track = dynamic_cast<AliVTrack*>(particle);
-    if(!track) continue;
-
-    if(GetAnalysisMode() == 0) ProcessTPC(mcEvent,track);
-    else if(GetAnalysisMode() == 1) ProcessTPCITS(mcEvent,track);
-    else if(GetAnalysisMode() == 2) ProcessConstrained(mcEvent,track);
-    else if(GetAnalysisMode() == 3) ProcessInnerTPC(mcEvent,track,vEvent);
-    else {
-      printf("ERROR: AnalysisMode %d \n",fAnalysisMode);
-      return;
-    }
+  if(GetAnalysisMode() < 0 || GetAnalysisMode() > 3) {
+    printf("ERROR: AnalysisMode %d \n",fAnalysisMode);
+    return kFALSE;
   }
+
+  fMCEvent = mcEvent;
+  fEvent = vEvent;
+
+return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceDEdx::ExecTrack(const AliPerformanceTrackInfo &info)
+{
+  // Process one track of the event
+  //
+  if(GetAnalysisMode() == 0) ProcessTPC(fMCEvent,info.fTrack);
+  else if(GetAnalysisMode() == 1) ProcessTPCITS(fMCEvent,info.fTrack);
+  else if(GetAnalysisMode() == 2) ProcessConstrained(fMCEvent,info.fTrack);
+  else if(GetAnalysisMode() == 3) ProcessInnerTPC(fMCEvent,info.fTrack,fEvent);
 }
 
 //_____________________________________________________________________________
@@ -37,6 +37,11 @@ public :
   // Execute analysis
     virtual void Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent, AliVfriendEvent *const vFriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend);
 
+  // Single pass processing
+  virtual Bool_t IsSinglePassSupported() const { return kTRUE; }
+  virtual Bool_t ExecEvent(AliMCEvent* const mcEvent, AliVEvent *const vEvent, AliVfriendEvent *const vFriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend);
+  virtual void ExecTrack(const AliPerformanceTrackInfo &info);
+
   // Merge output objects (needed by PROOF) 
   virtual Long64_t Merge(TCollection* list);
 
@@ -34,6 +34,9 @@
 #include "TMath.h"
 
 #include "AliLog.h" 
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliVfriendEvent.h"
 #include "AliPerformanceObject.h" 
 
 using namespace std;
@@ -56,7 +59,9 @@ AliPerformanceObject::AliPerformanceObject(TRootIOCtor*):
   fUseTOFBunchCrossing(kFALSE),
   fUseSparse(1),
   fCutsRC(),
-  fCutsMC()
+  fCutsMC(),
+  fMCEvent(0),
+  fEvent(0)
 {
   // io constructor
 }
@@ -77,7 +82,9 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
   fUseTOFBunchCrossing(kFALSE),
   fUseSparse(1),
   fCutsRC(),
-  fCutsMC()
+  fCutsMC(),
+  fMCEvent(0),
+  fEvent(0)
 {
 
     // constructor
@@ -176,6 +183,40 @@ Double_t * AliPerformanceObject::CreateLogAxis(Int_t nbins, Double_t xmin, Doubl
 return xbins;
 }
 
+//_____________________________________________________________________________
+Bool_t AliPerformanceObject::GetTrackInfo(AliVEvent* const vEvent, AliVfriendEvent* const vfriendEvent, Int_t iTrack, AliPerformanceTrackInfo &info)
+{
+  // fill the track info of track iTrack
+  // the friend track is only set if the friend event is given and not skipped
+
+  info.fIndex = iTrack;
+  info.fTrack = dynamic_cast<AliVTrack*>(vEvent->GetTrack(iTrack));
+  info.fFriendTrack = 0;
+  if(!info.fTrack) return kFALSE;
+
+  if(vfriendEvent && vfriendEvent->TestSkipBit()==kFALSE && iTrack<vfriendEvent->GetNumberOfTracks())
+    info.fFriendTrack = vfriendEvent->GetTrack(iTrack);
+
+return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::ExecAllTracks(AliMCEvent* const infoMC, AliVEvent* const infoRC, AliVfriendEvent* const vfriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend)
+{
+  // process the event with the single pass functions
+
+  if(!ExecEvent(infoMC,infoRC,vfriendEvent,bUseMC,bUseVfriend)) return;
+
+  AliPerformanceTrackInfo info;
+  for (Int_t iTrack = 0; iTrack < infoRC->GetNumberOfTracks(); iTrack++) 
+  {
+    if(!GetTrackInfo(infoRC,bUseVfriend ? vfriendEvent : 0,iTrack,info)) continue;
+    ExecTrack(info);
+  }
+
+  FinishEvent();
+}
+
 //_____________________________________________________________________________
 void AliPerformanceObject::InitHighMult() {
 
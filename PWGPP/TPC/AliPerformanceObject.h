@@ -18,14 +18,23 @@
 class TTree;
 class AliMCEvent;
 class AliVEvent;
+class AliVTrack;
+class AliVfriendTrack;
+class AliVfriendEvent;
 class AliRecInfoCuts;
 class AliMCInfoCuts;
-class AliVfriendEvent;
 class AliESDVertex;
 class TRootIOCtor;
 #include "AliRecInfoCuts.h"
 #include "AliMCInfoCuts.h"
 
+// Track of the event loop, shared by all the objects in single pass mode
+struct AliPerformanceTrackInfo {
+  Int_t                  fIndex;       // index of the track in the event
+  AliVTrack             *fTrack;       // track
+  const AliVfriendTrack *fFriendTrack; // friend track, 0 if friends not used or not available
+};
+
 class AliPerformanceObject : public TNamed, public AliMergeable {
 public :
   AliPerformanceObject(TRootIOCtor*); 
@@ -44,6 +53,20 @@ public :
   // call in the event loop 
   virtual void Exec(AliMCEvent* const infoMC=0, AliVEvent* const infoRC=0, AliVfriendEvent* const vfriendEvent=0, const Bool_t bUseMC=kFALSE, const Bool_t bUseVfriend=kFALSE) = 0;
 
+  // Single pass processing (see AliPerformanceTask::SetUseSinglePass)
+  // ExecEvent: event selection and event level quantities, 
+  // returns kFALSE if the event is rejected
+  // ExecTrack: process one track of the accepted event
+  // FinishEvent: event level histograms, after the track loop
+  // Exec() of the objects supporting it is ExecEvent + ExecTrack loop + FinishEvent
+  virtual Bool_t IsSinglePassSupported() const { return kFALSE; }
+  virtual Bool_t ExecEvent(AliMCEvent* const /*infoMC*/, AliVEvent* const /*infoRC*/, AliVfriendEvent* const /*vfriendEvent*/, const Bool_t /*bUseMC*/, const Bool_t /*bUseVfriend*/) { return kFALSE; }
+  virtual void ExecTrack(const AliPerformanceTrackInfo& /*info*/) { ; }
+  virtual void FinishEvent() { ; }
+
+  // Fill the track info of track iTrack, kFALSE if not a V track
+  static Bool_t GetTrackInfo(AliVEvent* const vEvent, AliVfriendEvent* const vfriendEvent, Int_t iTrack, AliPerformanceTrackInfo &info);
+
   // Merge output objects (needed by PROOF) 
   virtual Long64_t Merge(TCollection* list=0) = 0;
 
@@ -120,6 +143,9 @@ public :
     
 protected: 
 
+  // ExecEvent, ExecTrack for all the tracks and FinishEvent
+  void ExecAllTracks(AliMCEvent* const infoMC, AliVEvent* const infoRC, AliVfriendEvent* const vfriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend);
+
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, Int_t zDim, TString* selString = 0);
@@ -155,7 +181,11 @@ protected:
   AliRecInfoCuts fCutsRC;  // selection cuts for reconstructed tracks
   AliMCInfoCuts  fCutsMC;  // selection cuts for MC tracks
 
-  ClassDef(AliPerformanceObject,11);
+  // current event in single pass mode
+  AliMCEvent *fMCEvent;    //! MC event
+  AliVEvent  *fEvent;      //! V event
+
+  ClassDef(AliPerformanceObject,12);
 };
 
 #endif
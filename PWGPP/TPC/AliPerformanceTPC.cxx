@@ -93,6 +93,7 @@ AliPerformanceTPC::AliPerformanceTPC(TRootIOCtor*):
   fMult(0),
   fMultP(0),
   fMultN(0),
+  fVertStatus(kFALSE),
   h_tpc_clust_0_1_2(NULL),
   h_tpc_event_recvertex_0(NULL),
   h_tpc_event_recvertex_1(NULL),
@@ -137,6 +138,7 @@ AliPerformanceTPC::AliPerformanceTPC(const Char_t* name, const Char_t* title,Int
   fMult(0),
   fMultP(0),
   fMultN(0),
+  fVertStatus(kFALSE),
   h_tpc_clust_0_1_2(NULL),
   h_tpc_event_recvertex_0(NULL),
   h_tpc_event_recvertex_1(NULL),
@@ -778,12 +780,20 @@ void AliPerformanceTPC::ProcessConstrained(AliMCEvent* const /*mcev*/, AliVTrack
 void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent, AliVfriendEvent *const vfriendEvent, const Bool_t bUseMC, const Bool_t bUseVfriend)
 {
   // Process comparison information 
+  //
+  ExecAllTracks(mcEvent,vEvent,vfriendEvent,bUseMC,bUseVfriend);
+}
+
+//_____________________________________________________________________________
+Bool_t AliPerformanceTPC::ExecEvent(AliMCEvent* const mcEvent, AliVEvent *const vEvent, AliVfriendEvent *const /*vfriendEvent*/, const Bool_t bUseMC, const Bool_t /*bUseVfriend*/)
+{
+  // Event selection and vertex
   //
 
     if(!vEvent)
   {
     Error("Exec","vEvent not available");
-    return;
+    return kFALSE;
   }
 
   AliHeader* header = 0;
@@ -794,19 +804,19 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
   {
     if(!mcEvent) {
       Error("Exec","mcEvent not available");
-      return;
+      return kFALSE;
     }
     // get MC event header
     header = mcEvent->Header();
     if (!header) {
       Error("Exec","Header not available");
-      return;
+      return kFALSE;
     }
     // get MC vertex
     genHeader = header->GenEventHeader();
     if (!genHeader) {
       Error("Exec","Could not retrieve genHeader from Header");
-      return;
+      return kFALSE;
     }
     genHeader->PrimaryVertex(vtxMC);
   } 
@@ -817,7 +827,7 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
     Bool_t isEventTriggered = vEvent->IsTriggerClassFired(GetTriggerClass());
     if(!isEventTriggered) {
       printf("ERROR: Could not determine trigger class (requested: %s)\n", GetTriggerClass());
-      return;
+      return kFALSE;
     }
   }
 
@@ -830,7 +840,7 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
     hasVertex = vEvent->GetPrimaryVertexTPC(vertex);
   }
   if (hasVertex<0) {
-    return;
+    return kFALSE;
   }
   const AliVVertex *vVertex = &vertex;
 
@@ -838,22 +848,33 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
     fMult = 0; fMultP = 0; fMultN = 0;
   
   // store vertex status
-  Bool_t vertStatus = vVertex->GetStatus();
-  //  Process events
-  for (Int_t iTrack = 0; iTrack < vEvent->GetNumberOfTracks(); iTrack++) 
-  {
-    
-    AliVParticle *particle = vEvent->GetTrack(iTrack);
-    if(!particle) continue;
-    AliVTrack *vTrack = dynamic_cast<AliVTrack*>(particle);
-    if(!vTrack) continue;
+  fVertStatus = vVertex->GetStatus();
+  vertex.GetXYZ(fVertexXYZ);
+
+  if(GetAnalysisMode() < 0 || GetAnalysisMode() > 2) {
+    printf("ERROR: AnalysisMode %d \n",fAnalysisMode);
+    return kFALSE;
+  }
+
+  fMCEvent = mcEvent;
+  fEvent = vEvent;
+
+return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceTPC::ExecTrack(const AliPerformanceTrackInfo &info)
+{
+  // Process one track of the event
+  //
+    AliVTrack *vTrack = info.fTrack;
 
     // if not fUseKinkDaughters don't use tracks with kink index > 0
-    if(!fUseKinkDaughters && vTrack->GetKinkIndex(0) > 0) continue;
+    if(!fUseKinkDaughters && vTrack->GetKinkIndex(0) > 0) return;
 
-    if(bUseVfriend && vfriendEvent && vfriendEvent->TestSkipBit()==kFALSE && iTrack<vfriendEvent->GetNumberOfTracks())
+    if(info.fFriendTrack)
         {
-          const AliVfriendTrack *friendTrack=vfriendEvent->GetTrack(iTrack);
+          const AliVfriendTrack *friendTrack=info.fFriendTrack;
           if(friendTrack) 
               {
                 //
@@ -902,19 +923,18 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliVEvent *const vEvent,
                 } //end if(bUseVfriend && vfriendEvent && ...)
             }
     }
-    if(GetAnalysisMode() == 0) ProcessTPC(mcEvent,vTrack,vEvent,vertStatus);
-    else if(GetAnalysisMode() == 1) ProcessTPCITS(mcEvent,vTrack,vEvent,vertStatus);
-    else if(GetAnalysisMode() == 2) ProcessConstrained(mcEvent,vTrack,vEvent);
-    else {
-      printf("ERROR: AnalysisMode %d \n",fAnalysisMode);
-      return;
-    }
-    // TPC only
-  } //end iTrack iteration
+    if(GetAnalysisMode() == 0) ProcessTPC(fMCEvent,vTrack,fEvent,fVertStatus);
+    else if(GetAnalysisMode() == 1) ProcessTPCITS(fMCEvent,vTrack,fEvent,fVertStatus);
+    else if(GetAnalysisMode() == 2) ProcessConstrained(fMCEvent,vTrack,fEvent);
+}
+
+//_____________________________________________________________________________
+void AliPerformanceTPC::FinishEvent()
+{
+  // Fill event histograms
+  //
 
-    Double_t vtxPosition[3]= {0.,0.,0.};
-    vertex.GetXYZ(vtxPosition);
-    Double_t vTPCEvent[7] = {vtxPosition[0],vtxPosition[1],vtxPosition[2],static_cast<Double_t>(fMult),static_cast<Double_t>(fMultP),static_cast<Double_t>(fMultN),static_cast<Double_t>(vertStatus)};
+    Double_t vTPCEvent[7] = {fVertexXYZ[0],fVertexXYZ[1],fVertexXYZ[2],static_cast<Double_t>(fMult),static_cast<Double_t>(fMultP),static_cast<Double_t>(fMultN),static_cast<Double_t>(fVertStatus)};
     
     if(fUseSparse) fTPCEventHisto->Fill(vTPCEvent);
     else {
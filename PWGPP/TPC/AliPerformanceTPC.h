@@ -43,6 +43,13 @@ public :
 
   // Execute analysis
   virtual void  Exec(AliMCEvent* const infoMC, AliVEvent* const infoRC, AliVfriendEvent* const vfriendEvent, const Bool_t bUseMC=kFALSE, const Bool_t bUseVfriend=kFALSE);
+
+  // Single pass processing
+  virtual Bool_t IsSinglePassSupported() const { return kTRUE; }
+  virtual Bool_t ExecEvent(AliMCEvent* const infoMC, AliVEvent* const infoRC, AliVfriendEvent* const vfriendEvent, const Bool_t bUseMC=kFALSE, const Bool_t bUseVfriend=kFALSE);
+  virtual void  ExecTrack(const AliPerformanceTrackInfo &info);
+  virtual void  FinishEvent();
+
   // Merge output objects (needed by PROOF) 
   virtual Long64_t Merge(TCollection* list=0);
 
@@ -101,6 +108,8 @@ private:
   Int_t fMult;
   Int_t fMultP;
   Int_t fMultN;
+  Bool_t fVertStatus;       //! vertex status of the current event
+  Double_t fVertexXYZ[3];   //! vertex position of the current event
     
   //Cluster Histograms
   TH3D *h_tpc_clust_0_1_2;//!
@@ -135,7 +144,7 @@ private:
   AliPerformanceTPC(const AliPerformanceTPC&); // not implemented
   AliPerformanceTPC& operator=(const AliPerformanceTPC&); // not implemented
 
-  ClassDef(AliPerformanceTPC,15);
+  ClassDef(AliPerformanceTPC,16);
 };
 
 #endif
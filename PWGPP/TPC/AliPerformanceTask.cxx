@@ -34,6 +34,7 @@
 #include "TH1F.h"
 #include "TCanvas.h"
 #include "TList.h"
+#include "TObjArray.h"
 #include "TFile.h"
 #include "TSystem.h"
 #include "TBufferFile.h"
@@ -87,6 +88,7 @@ AliPerformanceTask::AliPerformanceTask()
   , fUseVfriend(kFALSE)
   , fUseHLT(kFALSE)
   , fUseTerminate(kTRUE)
+  , fUseSinglePass(kFALSE)
   , fUseCentrality(0)
   , fUseOCDB(kTRUE)
   , fDebug(0)
@@ -111,6 +113,7 @@ AliPerformanceTask::AliPerformanceTask(const char *name, const char* title)
   , fUseVfriend(kFALSE)
   , fUseHLT(kFALSE)
   , fUseTerminate(kTRUE)
+  , fUseSinglePass(kFALSE)
   , fUseCentrality(0)
   , fUseOCDB(kTRUE)
   , fDebug(0)
@@ -247,7 +250,21 @@ void AliPerformanceTask::UserExec(Option_t *)
 
   // Process comparison
     if(fEvents==1) fVEvent->InitMagneticField();
-    if (process) {
+    if (process && fUseSinglePass) {
+    // consecutive objects supporting it share one track loop,
+    // the list order is kept for the others
+    AliPerformanceObject *pObj=0;
+    TObjArray group;
+    fPitList->Reset();
+    while(( pObj = (AliPerformanceObject *)fPitList->Next()) != NULL) {
+      if (pObj->IsSinglePassSupported()) { group.Add(pObj); continue; }
+      ExecSinglePass(group);
+      if (showInfo) AliInfo(Form("...executing job %s",pObj->GetName()));
+      pObj->Exec(fMC,fVEvent,fVfriendEvent,fUseMCInfo,fUseVfriend);
+    }
+    ExecSinglePass(group);
+  }
+  else if (process) {
     AliPerformanceObject *pObj=0;
     fPitList->Reset();
     while(( pObj = (AliPerformanceObject *)fPitList->Next()) != NULL) {
@@ -265,6 +282,37 @@ void AliPerformanceTask::UserExec(Option_t *)
 
 }
 
+//_____________________________________________________________________________
+void AliPerformanceTask::ExecSinglePass(TObjArray &group)
+{
+  // Run the objects of the group in one loop over the tracks:
+  // the event is selected by each object (ExecEvent), each track 
+  // is then passed to all the objects which accepted the event, 
+  // in the list order, and the event histograms are filled at the end.
+  // The group is emptied.
+
+  Int_t nAccepted = 0;
+  for (Int_t i = 0; i < group.GetEntriesFast(); i++) {
+    AliPerformanceObject *pObj = (AliPerformanceObject *)group.UncheckedAt(i);
+    if (showInfo) AliInfo(Form("...executing job %s (single pass)",pObj->GetName()));
+    if (pObj->ExecEvent(fMC,fVEvent,fVfriendEvent,fUseMCInfo,fUseVfriend)) group.AddAt(pObj,nAccepted++);
+  }
+
+  if (nAccepted > 0) {
+    AliVfriendEvent *vfriendEvent = fUseVfriend ? fVfriendEvent : 0;
+    AliPerformanceTrackInfo info;
+    for (Int_t iTrack = 0; iTrack < fVEvent->GetNumberOfTracks(); iTrack++) {
+      if (!AliPerformanceObject::GetTrackInfo(fVEvent,vfriendEvent,iTrack,info)) continue;
+      for (Int_t i = 0; i < nAccepted; i++)
+        ((AliPerformanceObject *)group.UncheckedAt(i))->ExecTrack(info);
+    }
+    for (Int_t i = 0; i < nAccepted; i++)
+      ((AliPerformanceObject *)group.UncheckedAt(i))->FinishEvent();
+  }
+
+  group.Clear();
+}
+
 //_____________________________________________________________________________
 void AliPerformanceTask::Terminate(Option_t *) 
 {
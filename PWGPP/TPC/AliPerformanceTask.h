@@ -16,6 +16,7 @@ class AliMCEvent;
 class AliPerformanceObject;
 class AliMagF;
 class TList;
+class TObjArray;
 class TTree;
 class TNtuple;
 
@@ -48,6 +49,11 @@ class AliPerformanceTask : public AliAnalysisTaskSE {
   // Use HLT ESD
   void SetUseHLT(Bool_t useHLT = kFALSE) {fUseHLT = useHLT;}
 
+  // Single pass over the tracks for all the objects supporting it
+  // (AliPerformanceObject::IsSinglePassSupported), the others run their own loop
+  void SetUseSinglePass(Bool_t singlePass = kTRUE) {fUseSinglePass = singlePass;}
+  Bool_t GetUseSinglePass() const {return fUseSinglePass;}
+
   // Use Terminate function
   void SetUseTerminate(Bool_t useTerminate = kTRUE) {fUseTerminate = useTerminate;}
 
@@ -73,6 +79,9 @@ class AliPerformanceTask : public AliAnalysisTaskSE {
   // Calculate centrality
   Int_t CalculateCentralityBin();
 
+  // Run the objects of the group in one loop over the tracks
+  void ExecSinglePass(TObjArray &group);
+
   AliVEvent *fVEvent;         //! V event
   AliVfriendEvent *fVfriendEvent;   //! V friend event
   AliMCEvent *fMC;            //! MC event
@@ -88,6 +97,8 @@ class AliPerformanceTask : public AliAnalysisTaskSE {
 
   Bool_t fUseTerminate;       // use terminate function
 
+  Bool_t fUseSinglePass;      // one loop over the tracks for all the objects
+
   Int_t  fUseCentrality;      // use centrality (0=off(default),1=VZERO,2=SPD)
 
   Bool_t  fUseOCDB;           // use OCDB
@@ -100,7 +111,7 @@ class AliPerformanceTask : public AliAnalysisTaskSE {
   AliPerformanceTask(const AliPerformanceTask&); // not implemented
   AliPerformanceTask& operator=(const AliPerformanceTask&); // not implemented
   
-  ClassDef(AliPerformanceTask, 5); // example of analysis
+  ClassDef(AliPerformanceTask, 6); // example of analysis
 };
 
 #endif
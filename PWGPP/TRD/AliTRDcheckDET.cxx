@@ -71,6 +71,7 @@
 
 #include "info/AliTRDtrackInfo.h"
 #include "info/AliTRDeventInfo.h"
+#include "info/AliTRDtrackletRecords.h"
 #include "AliTRDinfoGen.h"
 #include "AliTRDcheckDET.h"
 #include "AliTRDpwgppHelper.h"
@@ -137,6 +138,7 @@ void AliTRDcheckDET::UserExec(Option_t *opt){
   else fCentralityClass = -1;  // Assume pp
  
   AliTRDrecoTask::UserExec(opt);  
+  if(fkTrackletRecords) FillTrackletRecords();
 
   TH1F *histo(NULL); AliTRDtrackInfo *fTrackInfo(NULL); Int_t nTracks(0);		// Count the number of tracks per event
   for(Int_t iti = 0; iti < fTracks->GetEntriesFast(); iti++){
@@ -1133,6 +1135,7 @@ TH1 *AliTRDcheckDET::PlotChargeTracklet(const AliTRDtrackV1 *track){
   //
   // Plot the charge deposit per chamber
   //
+  if(!track && fkTrackletRecords && DebugLevel() <= 3) return NULL; // filled from the tracklet records
   if(track) fkTrack = track;
   if(!fkTrack){
     AliDebug(4, "No Track defined.");
@@ -1186,6 +1189,22 @@ TH1 *AliTRDcheckDET::PlotChargeTracklet(const AliTRDtrackV1 *track){
   return h;
 }
 
+//_______________________________________________________
+void AliTRDcheckDET::FillTrackletRecords(){
+  //
+  // Fill the tracklet charge of all the barrel tracklets of the event in
+  // one loop over the flat records produced by AliTRDinfoGen. Replaces the
+  // per track cluster loop of PlotChargeTracklet (except for debug streaming)
+  //
+  TH2 *h = NULL;
+  if(!(h = dynamic_cast<TH2F *>(fContainer->At(kChargeTracklet)))){
+    AliWarning("No Histogram defined.");
+    return;
+  }
+  const AliTRDtrackletRecords::AliTRDtrackletRecord *rec = fkTrackletRecords->GetRecords();
+  for(Int_t ir = fkTrackletRecords->GetNRecords(); ir--; rec++) h->Fill(rec->fQ, fCentralityClass);
+}
+
 //_______________________________________________________
 TH1 *AliTRDcheckDET::PlotNTracksSector(const AliTRDtrackV1 *track){
   //
@@ -118,6 +118,7 @@ private:
   Bool_t MakeBarPlot(TH1 *histo, Int_t Color);
   //----------------------------------------------------
   void GetEtaPhiAt(const AliExternalTrackParam *track, Double_t x, Double_t &eta, Double_t &phi);
+  void FillTrackletRecords();
   TH1 *ProjectCentrality(TH2 *h2d, Int_t centralityBin = -1);
 
   Int_t fCentralityClass;              // Centrality Class
@@ -103,6 +103,7 @@
 #include "info/AliTRDchmbInfo.h"
 #include "info/AliTRDtriggerInfo.h"
 #include "info/AliTRDeventCuts.h"
+#include "info/AliTRDtrackletRecords.h"
 
 ClassImp(AliTRDinfoGen)
 
@@ -138,6 +139,7 @@ AliTRDinfoGen::AliTRDinfoGen()
   ,fV0List(NULL)
   ,fTracklets(NULL)
   ,fClusters(NULL)
+  ,fTrackletRecords(NULL)
   ,fContainer(NULL)
   ,fRecos(NULL)
   ,fDebugStream(NULL)
@@ -168,6 +170,7 @@ AliTRDinfoGen::AliTRDinfoGen(char* name)
   ,fV0List(NULL)
   ,fTracklets(NULL)
   ,fClusters(NULL)
+  ,fTrackletRecords(NULL)
   ,fContainer(NULL)
   ,fRecos(NULL)
   ,fDebugStream(NULL)
@@ -230,6 +233,7 @@ AliTRDinfoGen::~AliTRDinfoGen()
     fClusters->Delete(); delete fClusters;
     fClusters = NULL;
   }
+  if(fTrackletRecords) delete fTrackletRecords; fTrackletRecords = NULL;
   if(fContainer && !(AliAnalysisManager::GetAnalysisManager() && AliAnalysisManager::GetAnalysisManager()->IsProofMode())){
     fContainer->Delete(); 
     delete fContainer;
@@ -249,6 +253,16 @@ Bool_t AliTRDinfoGen::GetRefFigure(Int_t)
   return kTRUE;
 }
 
+//____________________________________________________________________
+void AliTRDinfoGen::UseTrackletRecords(Bool_t use)
+{
+// Publish the flat tracklet records of the barrel tracks (AliTRDtrackletRecords)
+// on the extra output slot AliTRDpwgppHelper::kTrackletRecords
+
+  SetBit(kTrkltRecords, use);
+  if(use) DefineOutput(AliTRDpwgppHelper::kTrackletRecords, AliTRDtrackletRecords::Class());
+}
+
 //____________________________________________________________________
 void AliTRDinfoGen::UserCreateOutputObjects()
 {	
@@ -266,6 +280,7 @@ void AliTRDinfoGen::UserCreateOutputObjects()
   fV0List       = new TObjArray(10); fV0List->SetOwner(kTRUE);
   fTracklets    = new TObjArray(1200); fTracklets->SetOwner(kTRUE);
   fClusters     = new TObjArray(AliTRDgeometry::kNdet); fClusters->SetOwner(kTRUE);
+  if(HasTrackletRecords()) fTrackletRecords = new AliTRDtrackletRecords();
 
   // define general monitor
   fContainer = new TObjArray(kNclasses); fContainer->SetOwner(kTRUE);
@@ -310,6 +325,7 @@ void AliTRDinfoGen::UserCreateOutputObjects()
   PostData(AliTRDpwgppHelper::kTracklets,    fTracklets);
   PostData(AliTRDpwgppHelper::kClusters,     fClusters);
   PostData(AliTRDpwgppHelper::kMonitor,      fContainer);
+  if(fTrackletRecords) PostData(AliTRDpwgppHelper::kTrackletRecords, fTrackletRecords);
 }
 
 //____________________________________________________________________
@@ -413,6 +429,7 @@ void AliTRDinfoGen::UserExec(Option_t *){
   fTracklets->Delete();
   fClusters->Delete();
   fEventInfo->Delete("");
+  if(fTrackletRecords) fTrackletRecords->Clear();
 
   fESDev = dynamic_cast<AliESDEvent*>(InputEvent());
   if(!fESDev){
@@ -802,6 +819,7 @@ void AliTRDinfoGen::UserExec(Option_t *){
         if(fTrackCut && !fTrackCut->IsSelected(esdTrack)) selected = kFALSE;
         if(selected){ 
           fTracksBarrel->Add(new AliTRDtrackInfo(*fTrackInfo));
+          if(fTrackletRecords) fTrackletRecords->AddTrack(fTrackInfo->GetTrack(), fTracksBarrel->GetEntriesFast()-1, fTrackInfo->GetLabel());
           nBarrel++;
           if(fTrackInfo->GetTrack()) nBarrelFriend++;
         }
@@ -990,6 +1008,7 @@ void AliTRDinfoGen::UserExec(Option_t *){
   PostData(AliTRDpwgppHelper::kTracklets,    fTracklets);
   PostData(AliTRDpwgppHelper::kClusters,     fClusters);
   PostData(AliTRDpwgppHelper::kMonitor,      fContainer);
+  if(fTrackletRecords) PostData(AliTRDpwgppHelper::kTrackletRecords, fTrackletRecords);
 }
 
 
@@ -19,6 +19,7 @@ class AliESDEvent;
 class AliMCEvent;
 class AliESDfriend;
 class AliTRDtrackInfo;
+class AliTRDtrackletRecords;
 class AliTRDeventInfo;
 class AliTRDv0Info;
 class AliTRDeventCuts;
@@ -38,6 +39,7 @@ public:
    ,kCollision            = BIT(20)
    ,kOCDB                 = BIT(21)
    ,kTrkPoints            = BIT(22)
+   ,kTrkltRecords         = BIT(23)
   };
   enum AliTRDinfoGenObjects{
      kTracksESD =  0
@@ -83,6 +85,7 @@ public:
   Bool_t  IsInitOCDB() const                        { return TestBit(kOCDB);}
   Bool_t  IsCollision() const                       { return TestBit(kCollision);}
   Bool_t  HasTrackPoints() const                    { return TestBit(kTrkPoints);}
+  Bool_t  HasTrackletRecords() const                { return TestBit(kTrkltRecords);}
   void    MakeSummary();
   static  Char_t OnlSim()                           { return fgOnlSim;}
   static const AliTRDReconstructor* Reconstructor() { return fgReconstructor;}
@@ -100,6 +103,7 @@ public:
   Bool_t  UseLocalEvSelection() const {return Bool_t(fEventCut);}
   Bool_t  UseLocalTrkSelection() const {return TestBit(kUseLocalTrkSelection);}
   void    UseTrackPoints(Bool_t use=kTRUE) {SetBit(kTrkPoints, use);}
+  void    UseTrackletRecords(Bool_t use=kTRUE);
   void    UserCreateOutputObjects();
   void    UserExec(Option_t *);
   void    Terminate(Option_t* option = "");
@@ -146,10 +150,11 @@ private:
   TObjArray        *fV0List;         //! V0 container
   TObjArray        *fTracklets;      //! Online tracklets container
   TObjArray        *fClusters;       //! Clusters container
+  AliTRDtrackletRecords *fTrackletRecords; //! Flat records of the barrel tracklets
   TObjArray        *fContainer;      //! container to store results
   TObjArray        *fRecos;          //! array of reco params
   TTreeSRedirector *fDebugStream;    //! debug stream
 
-  ClassDef(AliTRDinfoGen, 9)         // entry to TRD analysis train
+  ClassDef(AliTRDinfoGen, 10)         // entry to TRD analysis train
 };
 #endif
@@ -23,6 +23,7 @@ public:
     ,kClusters          // list of clusters from TRD.RecPoint.root
     ,kMonitor           // list of histograms for general monitoring
     ,kNOutSlots         // count for all slots
+    ,kTrackletRecords = kNOutSlots // optional flat tracklet records (see AliTRDinfoGen::UseTrackletRecords())
   };
 
   enum ETRDrecoTasks{
@@ -43,6 +43,7 @@
 #include "info/AliTRDchmbInfo.h"
 #include "info/AliTRDeventInfo.h"
 #include "info/AliTRDtrendingManager.h"
+#include "info/AliTRDtrackletRecords.h"
 #include "AliTRDrecoTask.h"
 
 ClassImp(AliTRDrecoTask)
@@ -61,6 +62,7 @@ AliTRDrecoTask::AliTRDrecoTask()
   ,fTracks(NULL)
   ,fOnlTracklets(NULL)
   ,fClusters(NULL)
+  ,fkTrackletRecords(NULL)
   ,fkClusters(NULL)
   ,fkTrack(NULL)
   ,fkMC(NULL)
@@ -91,6 +93,7 @@ AliTRDrecoTask::AliTRDrecoTask(const char *name, const char *title)
   ,fTracks(NULL)
   ,fOnlTracklets(NULL)
   ,fClusters(NULL)
+  ,fkTrackletRecords(NULL)
   ,fkClusters(NULL)
   ,fkTrack(NULL)
   ,fkMC(NULL)
@@ -228,6 +231,7 @@ void AliTRDrecoTask::UserExec(Option_t *)
 
   fTracks   = dynamic_cast<TObjArray *>(GetInputData(1));
   fEvent    = dynamic_cast<AliTRDeventInfo *>(GetInputData(2));
+  fkTrackletRecords = NULL;
   fTriggerSlot=0;
   if(fTriggerList && fEvent){
     for(Int_t itrig(0); itrig<fTriggerList->GetEntries(); itrig++){
@@ -242,6 +246,7 @@ void AliTRDrecoTask::UserExec(Option_t *)
   }
   fOnlTracklets = dynamic_cast<TObjArray*>(GetInputData(3)); // link online tracklets
   fClusters  = dynamic_cast<TObjArray*>(GetInputData(4)); // link offline clusters
+  if(HasTrackletRecords()) fkTrackletRecords = dynamic_cast<AliTRDtrackletRecords*>(GetInputData(5)); // link tracklet records
 
   if(!fPlotFuncList){
     AliWarning("No track functor list defined for the task");
@@ -292,6 +297,17 @@ void AliTRDrecoTask::UserExec(Option_t *)
   }
 }
 
+//_______________________________________________________
+void AliTRDrecoTask::UseTrackletRecords(Bool_t use)
+{
+// Read the flat tracklet records published by AliTRDinfoGen::UseTrackletRecords()
+// on input slot 5. The records refer to the barrel track list and should be used
+// only by tasks connected to it.
+
+  SetBit(kTrkltRecords, use);
+  if(use) DefineInput(5, AliTRDtrackletRecords::Class());
+}
+
 //_______________________________________________________
 Bool_t AliTRDrecoTask::GetRefFigure(Int_t /*ifig*/)
 {
@@ -30,6 +30,7 @@ class TList;
 class TObjArray;
 class TTreeSRedirector;
 class AliTRDtrackV1;
+class AliTRDtrackletRecords;
 class AliTRDrecoTask : public AliAnalysisTaskSE
 {
 friend class AliEveTRDTrackList;
@@ -39,6 +40,7 @@ public:
     ,kFriends     = BIT(19)
     ,kPostProcess = BIT(20)
     ,kHeavyIon    = BIT(21)
+    ,kTrkltRecords= BIT(22)
   };
   
   class AliTRDrecoProjection : public TNamed
@@ -94,6 +96,7 @@ public:
   Bool_t         HasMCdata() const       { return TestBit(kMCdata);};
   Bool_t         HasPostProcess() const  { return TestBit(kPostProcess);};
   Bool_t         HasRunTerminate() const { return fRunTerminate; }
+  Bool_t         HasTrackletRecords() const { return TestBit(kTrkltRecords);};
   virtual TObjArray* Histos()            { return fContainer;}
 
   virtual Bool_t Load(const Char_t *file = "AnalysisResults.root", const Char_t *dir = "TRD_Performance");
@@ -111,6 +114,7 @@ public:
   static void    SetRangeZ(TH2 *h2, Float_t m, Float_t M, Float_t thr=0., Float_t scale=1);
   void           SetRunTerminate(Bool_t runTerminate = kTRUE) { fRunTerminate = runTerminate; }
   void           SetTriggerList(const Char_t *tl);
+  void           UseTrackletRecords(Bool_t use = kTRUE);
   virtual void   Terminate(Option_t *);
 
 protected:
@@ -128,6 +132,7 @@ protected:
   TObjArray             *fTracks;          //! Array of tracks
   TObjArray             *fOnlTracklets;    //! Array of online tracklets
   TObjArray             *fClusters;        //! Array of clusters
+  const AliTRDtrackletRecords *fkTrackletRecords; //! flat tracklet records of the barrel tracks (optional input 5)
   const TObjArray       *fkClusters;       //! current detector clusters array
   const AliTRDtrackV1   *fkTrack;          //! current track
   const AliTRDtrackInfo::AliMCinfo  *fkMC; //! MC info
@@ -153,7 +158,7 @@ protected:
   static const Int_t fgNPt = 25;           //! No of debug pt bins
   static Float_t     fgPt[fgNPt+1];        //! Array with limits for debug pt bins
 
-  ClassDef(AliTRDrecoTask, 6) // base TRD reconstruction task
+  ClassDef(AliTRDrecoTask, 7) // base TRD reconstruction task
 };
 
 #endif
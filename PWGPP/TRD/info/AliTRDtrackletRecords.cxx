@@ -0,0 +1,109 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+//  Flat records of the offline tracklets of one event                    //
+//                                                                        //
+//  Produced by AliTRDinfoGen next to the list of AliTRDtrackInfo         //
+//  (see AliTRDinfoGen::UseTrackletRecords()). Each good tracklet of the  //
+//  barrel tracks is summarized in a fixed size record stored in one      //
+//  contiguous buffer, such that tracklet level QA can loop over the      //
+//  event without touching the tracks, seeds and clusters. MC truth is    //
+//  not copied; the record keeps the track label and the index of the     //
+//  track info, from which the MC info is retrieved only when needed      //
+//  (see GetTrackInfo()).                                                 //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#include "TMath.h"
+#include "TObjArray.h"
+
+#include "AliExternalTrackParam.h"
+#include "AliTRDgeometry.h"
+#include "AliTRDcluster.h"
+#include "AliTRDseedV1.h"
+#include "AliTRDtrackV1.h"
+
+#include "AliTRDtrackInfo.h"
+#include "AliTRDtrackletRecords.h"
+
+ClassImp(AliTRDtrackletRecords)
+
+//____________________________________________
+AliTRDtrackletRecords::AliTRDtrackletRecords()
+  :TObject()
+  ,fRecords()
+{
+// Constructor
+  fRecords.reserve(6*100);
+}
+
+//____________________________________________
+Int_t AliTRDtrackletRecords::AddTrack(const AliTRDtrackV1 *track, Int_t itrack, Int_t label)
+{
+// Add one record for each good tracklet of "track". "itrack" is the index
+// of the corresponding track info in the track list posted by AliTRDinfoGen.
+// Returns the number of records added.
+
+  if(!track) return 0;
+  const AliExternalTrackParam *tin(track->GetTrackIn());
+  Float_t pt(tin ? tin->Pt() : -1.);
+  Int_t n(0);
+  AliTRDtrackletRecord rec;
+  for(Int_t ily(0); ily<AliTRDgeometry::kNlayer; ily++){
+    AliTRDseedV1 *tracklet(track->GetTracklet(ily));
+    if(!tracklet || !tracklet->IsOK()) continue;
+    rec.fTrack    = itrack;
+    rec.fLabel    = label;
+    rec.fDet      = tracklet->GetDetector();
+    rec.fLayer    = ily;
+    rec.fN        = tracklet->GetN2();
+    rec.fRowCross = tracklet->IsRowCross();
+    rec.fPt       = pt;
+    rec.fX0       = tracklet->GetX0();
+    rec.fY        = tracklet->GetYfit(0);
+    rec.fZ        = tracklet->GetZfit(0);
+    rec.fDyDx     = tracklet->GetYfit(1);
+    rec.fDzDx     = tracklet->GetZfit(1);
+    rec.fChi2     = tracklet->GetChi2();
+    rec.fQ        = 0.;
+    AliTRDcluster *c(NULL);
+    for(Int_t ic(AliTRDseedV1::kNclusters); ic--;){
+      if(!(c = tracklet->GetClusters(ic))) continue;
+      rec.fQ += TMath::Abs(c->GetQ());
+    }
+    fRecords.push_back(rec);
+    n++;
+  }
+  return n;
+}
+
+//____________________________________________
+void AliTRDtrackletRecords::Clear(Option_t *)
+{
+// Remove all records, keeping the buffer
+
+  fRecords.clear();
+}
+
+//____________________________________________
+const AliTRDtrackInfo* AliTRDtrackletRecords::GetTrackInfo(const AliTRDtrackletRecord &rec, const TObjArray *tracks)
+{
+// Track info (with ESD and MC info) of the track the record belongs to
+
+  if(!tracks || rec.fTrack<0 || rec.fTrack>=tracks->GetEntriesFast()) return NULL;
+  return dynamic_cast<const AliTRDtrackInfo*>(tracks->UncheckedAt(rec.fTrack));
+}
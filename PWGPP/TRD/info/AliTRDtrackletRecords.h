@@ -0,0 +1,60 @@
+#ifndef ALITRDTRACKLETRECORDS_H
+#define ALITRDTRACKLETRECORDS_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+//  Flat records of the offline tracklets of one event                    //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_TObject
+#include "TObject.h"
+#endif
+
+class TObjArray;
+class AliTRDtrackV1;
+class AliTRDtrackInfo;
+class AliTRDtrackletRecords : public TObject
+{
+public:
+  struct AliTRDtrackletRecord {
+    Int_t   fTrack;   // index of the track info in the track list
+    Int_t   fLabel;   // MC label of the track (0 for data)
+    Short_t fDet;     // detector
+    Char_t  fLayer;   // layer
+    Char_t  fN;       // no of attached clusters
+    Bool_t  fRowCross;// tracklet crosses pad rows
+    Float_t fPt;      // track pt at TRD entrance (-1 if not available)
+    Float_t fX0;      // reference radial position
+    Float_t fY;       // fitted y at fX0
+    Float_t fZ;       // fitted z at fX0
+    Float_t fDyDx;    // fitted slope in the bending plane
+    Float_t fDzDx;    // fitted slope in the non-bending plane
+    Float_t fQ;       // total charge of the attached clusters
+    Float_t fChi2;    // tracklet chi2
+  };
+
+  AliTRDtrackletRecords();
+  virtual ~AliTRDtrackletRecords() {}
+
+  Int_t       AddTrack(const AliTRDtrackV1 *track, Int_t itrack, Int_t label=0);
+  void        Clear(Option_t *opt="");
+  Int_t       GetNRecords() const                      { return fRecords.size();}
+  const AliTRDtrackletRecord& GetRecord(Int_t i) const { return fRecords[i];}
+  const AliTRDtrackletRecord* GetRecords() const       { return fRecords.empty() ? NULL : &fRecords[0];}
+  static const AliTRDtrackInfo* GetTrackInfo(const AliTRDtrackletRecord &rec, const TObjArray *tracks);
+
+private:
+  AliTRDtrackletRecords(const AliTRDtrackletRecords&);
+  AliTRDtrackletRecords& operator=(const AliTRDtrackletRecords&);
+
+  std::vector<AliTRDtrackletRecord> fRecords; //! tracklets of the event, contiguous
+
+  ClassDef(AliTRDtrackletRecords, 1)  // flat TRD tracklet records
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef BENCHMARKRESULT_H
+#define BENCHMARKRESULT_H
+// Common measurement and output of the throughput benchmarks
+// (benchmarkSynthetic.C, benchmarkTrain.C).
+//
+// Each measurement is appended as one JSON object per line:
+// {"workload":"UEFillCorrelations","input":"synthetic:seed=4357","version":"vAN-20170901",
+//  "events":10000,"warmup":1000,"wall_s":12.3,"cpu_s":12.1,"events_per_s":813.0,
+//  "peak_rss_kb":412345,"rss_growth_kb_per_event":0.02}
+// The warm-up events are processed but not measured. The RSS growth per event
+// is the growth of the resident memory during the measured events and serves
+// as proxy for the allocations that are not given back.
+
+#include <fstream>
+#include <TString.h>
+#include <TSystem.h>
+
+// Resident memory of the process (kB)
+Long_t BenchmarkResidentMemory()
+{
+  ProcInfo_t info;
+  gSystem->GetProcInfo(&info);
+  return info.fMemResident;
+}
+
+// Peak resident memory of the process (kB), VmHWM where /proc is available
+Long_t BenchmarkPeakMemory()
+{
+  std::ifstream status(Form("/proc/%d/status", gSystem->GetPid()));
+  TString line;
+  while (status.good() && line.ReadLine(status)) {
+    if (!line.BeginsWith("VmHWM:")) continue;
+    line.Remove(0, 6);
+    line.ReplaceAll("kB", "");
+    return line.Atoll();
+  }
+  return BenchmarkResidentMemory();
+}
+
+// Version label of the measurement: $BENCHMARK_VERSION, else $ALIPHYSICS_VERSION
+TString BenchmarkVersion()
+{
+  const char *env[] = { "BENCHMARK_VERSION", "ALIPHYSICS_VERSION" };
+  for (Int_t i = 0; i < 2; i++) {
+    const char *v = gSystem->Getenv(env[i]);
+    if (v && v[0]) return v;
+  }
+  return "unknown";
+}
+
+// Append one measurement to the result file
+void BenchmarkWriteResult(const char *resultFile, const char *workload, const char *input,
+                          Long64_t nEvents, Long64_t nWarmup, Double_t wall, Double_t cpu, Long_t rssGrowth)
+{
+  TString json = Form("{\"workload\":\"%s\",\"input\":\"%s\",\"version\":\"%s\","
+                      "\"events\":%lld,\"warmup\":%lld,\"wall_s\":%.4f,\"cpu_s\":%.4f,\"events_per_s\":%.2f,"
+                      "\"peak_rss_kb\":%ld,\"rss_growth_kb_per_event\":%.4f}",
+                      workload, input, BenchmarkVersion().Data(),
+                      nEvents, nWarmup, wall, cpu, wall > 0 ? nEvents / wall : 0.,
+                      BenchmarkPeakMemory(), nEvents > 0 ? Double_t(rssGrowth) / nEvents : 0.);
+  std::ofstream out(resultFile, std::ios::app);
+  out << json.Data() << std::endl;
+  printf("%s\n", json.Data());
+}
+
+#endif
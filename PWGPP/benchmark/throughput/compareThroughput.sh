@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# Compare two result files of runThroughputBenchmark.sh.
+#
+# usage: compareThroughput.sh reference.json new.json [tolerance_percent]
+#
+# Prints per workload the median events/s, peak RSS and RSS growth per event of
+# both files. Workloads whose median throughput dropped, or whose median peak
+# RSS grew, by more than the tolerance (default 5%) are marked REGRESSION and
+# the script exits with 1.
+
+[[ $# -lt 2 ]] && { sed -n '2,/^$/s/^# \{0,1\}//p' "$0"; exit 1; }
+reference="$1"
+candidate="$2"
+tolerance="${3:-5}"
+
+# workload, events/s, peak RSS, RSS growth per event of each run
+extract()
+{
+  sed -n 's/.*"workload":"\([^"]*\)".*"events_per_s":\([^,}]*\).*"peak_rss_kb":\([^,}]*\).*"rss_growth_kb_per_event":\([^,}]*\).*/\1 \2 \3 \4/p' "$1"
+}
+
+awk -v tolerance="$tolerance" '
+  function median(key,    n, i, j, tmp, a) {
+    n = split(values[key], a, " ")
+    for (i = 2; i <= n; i++) for (j = i; j > 1 && a[j-1] > a[j]; j--) { tmp = a[j]; a[j] = a[j-1]; a[j-1] = tmp }
+    return (n % 2) ? a[(n+1)/2] : (a[n/2] + a[n/2+1]) / 2
+  }
+  {
+    workloads[$2] = 1
+    values[$1 SUBSEP $2 SUBSEP "rate"] = values[$1 SUBSEP $2 SUBSEP "rate"] " " $3
+    values[$1 SUBSEP $2 SUBSEP "rss"]  = values[$1 SUBSEP $2 SUBSEP "rss"] " " $4
+    values[$1 SUBSEP $2 SUBSEP "grow"] = values[$1 SUBSEP $2 SUBSEP "grow"] " " $5
+  }
+  END {
+    printf "%-20s %12s %12s %8s %12s %12s %10s %10s\n", "workload", "ref ev/s", "new ev/s", "change", "ref RSS kB", "new RSS kB", "ref kB/ev", "new kB/ev"
+    status = 0
+    for (w in workloads) {
+      if (!(("ref" SUBSEP w SUBSEP "rate") in values) || !(("new" SUBSEP w SUBSEP "rate") in values)) continue
+      r0 = median("ref" SUBSEP w SUBSEP "rate"); r1 = median("new" SUBSEP w SUBSEP "rate")
+      m0 = median("ref" SUBSEP w SUBSEP "rss");  m1 = median("new" SUBSEP w SUBSEP "rss")
+      g0 = median("ref" SUBSEP w SUBSEP "grow"); g1 = median("new" SUBSEP w SUBSEP "grow")
+      change = r0 > 0 ? 100 * (r1 - r0) / r0 : 0
+      flag = ""
+      if (change < -tolerance || (m0 > 0 && 100 * (m1 - m0) / m0 > tolerance)) { flag = "REGRESSION"; status = 1 }
+      printf "%-20s %12.1f %12.1f %7.1f%% %12d %12d %10.3f %10.3f %s\n", w, r0, r1, change, m0, m1, g0, g1, flag
+    }
+    exit status
+  }' <(extract "$reference" | sed 's/^/ref /') <(extract "$candidate" | sed 's/^/new /')
@@ -0,0 +1,89 @@
+#!/usr/bin/env bash
+# Throughput benchmark suite of the hot analysis frameworks.
+#
+# Runs each workload several times on fixed input and appends one JSON line per
+# run to the result file (see BenchmarkResult.h). Compare two result files with
+# compareThroughput.sh.
+#
+# usage: runThroughputBenchmark.sh [options] [workload ...]
+#   -o file      result file (default: benchmark_<version>.json)
+#   -i list      list of recorded AOD files for the train workloads (default: aod.list)
+#   -n events    measured events per run (default: 2000 synthetic, 5000 train)
+#   -w events    warm-up events per run (default: 10% of the measured events)
+#   -r runs      repetitions of each workload (default: 3)
+#   -s seed      seed of the synthetic events (default: 4357)
+#   -v version   version label (default: $ALIPHYSICS_VERSION or git describe of $ALICE_PHYSICS)
+#
+# Workloads: synthetic: UEFillCorrelations QCumulants FemtoPairing
+#            train:     EmcalIterator EmcalJetTask VertexingHF Dielectron
+# Without workloads all synthetic workloads are run, plus the train workloads
+# if the input list exists.
+
+syntheticWorkloads="UEFillCorrelations QCumulants FemtoPairing"
+trainWorkloads="EmcalIterator EmcalJetTask VertexingHF Dielectron"
+
+resultFile=""
+inputList="aod.list"
+nEvents=""
+nWarmup=""
+nRuns=3
+seed=4357
+version="${ALIPHYSICS_VERSION}"
+
+while getopts "o:i:n:w:r:s:v:h" opt; do
+  case $opt in
+    o) resultFile="$OPTARG" ;;
+    i) inputList="$OPTARG" ;;
+    n) nEvents="$OPTARG" ;;
+    w) nWarmup="$OPTARG" ;;
+    r) nRuns="$OPTARG" ;;
+    s) seed="$OPTARG" ;;
+    v) version="$OPTARG" ;;
+    *) sed -n '2,/^$/s/^# \{0,1\}//p' "$0"; exit 1 ;;
+  esac
+done
+shift $((OPTIND-1))
+
+[[ -z "$version" ]] && version=$(git -C "$ALICE_PHYSICS/../src" describe --always --dirty 2>/dev/null)
+[[ -z "$version" ]] && version="unknown"
+[[ -z "$resultFile" ]] && resultFile="benchmark_${version//\//_}.json"
+export BENCHMARK_VERSION="$version"
+
+workloads="$*"
+if [[ -z "$workloads" ]]; then
+  workloads="$syntheticWorkloads"
+  [[ -r "$inputList" ]] && workloads="$workloads $trainWorkloads"
+fi
+
+benchmarkDir=$(cd "$(dirname "$0")" && pwd)
+workDir=$(mktemp -d "${TMPDIR:-/tmp}/throughput.XXXXXX")
+cp "$benchmarkDir"/*.C "$benchmarkDir"/*.h "$workDir"/
+[[ -r "$inputList" ]] && inputList=$(cd "$(dirname "$inputList")" && pwd)/$(basename "$inputList")
+[[ "$resultFile" = /* ]] || resultFile="$PWD/$resultFile"
+
+# compile the macros once, the runs load the libraries
+( cd "$workDir" && aliroot -l -b -q -e 'gSystem->AddIncludePath("-I$ALICE_ROOT/include -I$ALICE_PHYSICS/include");' \
+    -e 'gSystem->CompileMacro("benchmarkSynthetic.C","k")' -e 'gSystem->CompileMacro("benchmarkTrain.C","k")' > compile.log 2>&1 ) \
+  || { echo "compilation failed, see $workDir/compile.log"; exit 1; }
+
+for workload in $workloads; do
+  if [[ " $syntheticWorkloads " == *" $workload "* ]]; then
+    n=${nEvents:-2000}
+    macro="benchmarkSynthetic.C+(\"$workload\",$n,${nWarmup:-$((n/10))},$seed,\"$resultFile\")"
+  elif [[ " $trainWorkloads " == *" $workload "* ]]; then
+    [[ -r "$inputList" ]] || { echo "$workload: input list $inputList not found"; continue; }
+    n=${nEvents:-5000}
+    macro="benchmarkTrain.C+(\"$workload\",\"$inputList\",$n,${nWarmup:-$((n/10))},\"$resultFile\")"
+  else
+    echo "unknown workload $workload"
+    continue
+  fi
+  for ((run=0; run<nRuns; run++)); do
+    echo "$workload run $run"
+    # each run in a fresh process, so that the peak memory is the one of the workload
+    ( cd "$workDir" && aliroot -l -b -q -e 'gSystem->AddIncludePath("-I$ALICE_ROOT/include -I$ALICE_PHYSICS/include");' \
+        "$macro" > "${workload}_${run}.log" 2>&1 ) || echo "$workload run $run failed, see $workDir/${workload}_${run}.log"
+  done
+done
+
+echo "results in $resultFile, logs in $workDir"
@@ -17,6 +17,7 @@
 #include "AliTriggerIR.h"
 
 #include "AliAnalysisTaskVdM.h"
+#include "AliVdMScanCounters.h"
 #include "AliRawEventHeaderBase.h"
 #include "AliVVZERO.h"
 #include "AliVAD.h"
@@ -202,6 +203,8 @@ void AliAnalysisTaskVdM::ADV0::FillV0(const AliVEvent *vEvent, AliTriggerAnalysi
 AliAnalysisTaskVdM::AliAnalysisTaskVdM(const char *name)
   : AliAnalysisTaskSE(name)
   , fTreeBranchNames("")
+  , fFillTree(kTRUE)
+  , fScanSteps(nullptr)
   , fTriggerAnalysis()
   , fList(nullptr)
   , fTE(nullptr)
@@ -214,6 +217,7 @@ AliAnalysisTaskVdM::AliAnalysisTaskVdM(const char *name)
   , fTriggerIRs("AliTriggerIR", 3)
   , fFiredTriggerClasses()
   , fTreeData()
+  , fScanCounters(nullptr)
 {
   for (Int_t i=0; i<kNHist;++i) {
     fHist[i] = nullptr;
@@ -230,8 +234,38 @@ AliAnalysisTaskVdM::~AliAnalysisTaskVdM()
 
   fTriggerIRs.Delete();
 
-  SafeDelete(fList);
+  SafeDelete(fList); // owns fScanCounters
   SafeDelete(fTE);
+  SafeDelete(fScanSteps);
+}
+
+Int_t AliAnalysisTaskVdM::AddScans(const char* xmlFileName) {
+  if (!fScanSteps)
+    fScanSteps = new AliVdMScanCounters;
+  return fScanSteps->AddScans(xmlFileName);
+}
+
+UInt_t AliAnalysisTaskVdM::GetCounterMask(const TreeData& d) {
+  const ADV0* info[2] = { &d.fV0Info, &d.fADInfo };
+  const Int_t counterAND[2] = { AliVdMScanCounters::kV0AND, AliVdMScanCounters::kADAND };
+  UInt_t mask = BIT(AliVdMScanCounters::kAll);
+  for (Int_t i=0; i<2; ++i) {
+    const ADV0& x = *info[i];
+    // online decision 1 = BB (AliTriggerAnalysis::kV0BB, kADBB)
+    if (x.fDecisionOnline[ADV0::kCside] != 1 || x.fDecisionOnline[ADV0::kAside] != 1)
+      continue;
+    mask |= BIT(counterAND[i]);
+    if (x.fBG[ADV0::kCside] > 0 || x.fBG[ADV0::kAside] > 0)
+      mask |= BIT(counterAND[i]+1);
+    // past-future protection: index 10 is the BC of the event
+    for (Int_t bc=0; bc<21; ++bc) {
+      if (bc != 10 && x.fPFBBA[bc] > 0 && x.fPFBBC[bc] > 0) {
+        mask |= BIT(counterAND[i]+2);
+        break;
+      }
+    }
+  }
+  return mask;
 }
 
 void AliAnalysisTaskVdM::SetBranches(TTree* t) {
@@ -260,6 +294,11 @@ void AliAnalysisTaskVdM::UserCreateOutputObjects()
   fHist[kHistTrig] = new TH1D("HTrig", ";trigger class index", 102, -1.5, 100.5);
   fHist[kHistTrig]->SetStats(0);
   fList->Add(fHist[kHistTrig]);
+  if (fScanSteps && fScanSteps->GetNSteps()) {
+    fScanCounters = new AliVdMScanCounters(*fScanSteps);
+    fScanCounters->Reset();
+    fList->Add(fScanCounters);
+  }
   PostData(1, fList);
 
   TDirectory *owd = gDirectory;
@@ -351,6 +390,12 @@ void AliAnalysisTaskVdM::UserExec(Option_t *)
   fTreeData.fV0Info.FillV0(vEvent, fTriggerAnalysis);
   fTreeData.fADInfo.FillAD(vEvent, fTriggerAnalysis);
 
+  if (fScanCounters)
+    fScanCounters->Fill(fTreeData.fEventInfo.fTimeStamp, fTreeData.fEventInfo.fBCID, GetCounterMask(fTreeData));
+
+  if (!fFillTree) // counters only: skip the vertex refit
+    return;
+
   fVertexSPD    = *esdEvent->GetPrimaryVertexSPD();
   fVertexTPC    = *esdEvent->GetPrimaryVertexTPC();
   fVertexTracks = *esdEvent->GetPrimaryVertexTracks();
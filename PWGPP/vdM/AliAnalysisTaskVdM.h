@@ -9,6 +9,7 @@ class TList;
 class AliVEvent;
 class AliESDEvent;
 class AliESDHeader;
+class AliVdMScanCounters;
 
 #include <TObject.h>
 #include <TString.h>
@@ -24,6 +25,10 @@ class AliESDHeader;
 //  * constrained and unconstrained vertex -> non-separation analysis
 //  * timing information for V0 and for AD -> bkgd estimation
 //
+// optionally per-BC and per-scan-step counters (AliVdMScanCounters) are filled
+// online and stored in the output list; with SetFillTree(kFALSE) only the
+// counters are filled and the event tree stays empty
+//
 class AliAnalysisTaskVdM : public AliAnalysisTaskSE {
 public:
 
@@ -36,6 +41,8 @@ public:
   virtual void NotifyRun();
 
   void SetBranchNames(TString options) { fTreeBranchNames = options; }
+  void SetFillTree(Bool_t b) { fFillTree = b; }
+  Int_t AddScans(const char* xmlFileName); // scan steps for the counters
 
   TString GetListName() const { return "TL"; }
   TString GetTreeName() const { return "TE"; }
@@ -115,6 +122,8 @@ public:
     ClassDef(TreeData, 1);
   } ;
 
+  static UInt_t GetCounterMask(const TreeData&);
+
 protected:
   void SetBranches(TTree* t);
   void FillTriggerIR(const AliESDHeader* );
@@ -128,6 +137,8 @@ private:
   AliAnalysisTaskVdM& operator=(const AliAnalysisTaskVdM&); // not implemented
 
   TString          fTreeBranchNames;     //
+  Bool_t           fFillTree;            // fill the event tree
+  AliVdMScanCounters *fScanSteps;        // scan step definition for the counters
 
   AliTriggerAnalysis fTriggerAnalysis;   //!
 
@@ -143,8 +154,9 @@ private:
   TClonesArray     fTriggerIRs;          //!
   TString          fFiredTriggerClasses; //!
   TreeData         fTreeData;            //!
+  AliVdMScanCounters *fScanCounters;     //! per-BC and per-step counters
 
-  ClassDef(AliAnalysisTaskVdM, 2);
+  ClassDef(AliAnalysisTaskVdM, 3);
 } ;
 
 #endif // ALIANALYSISTASKVDM_H
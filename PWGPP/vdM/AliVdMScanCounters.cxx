@@ -0,0 +1,215 @@
+#include <sstream>
+
+#include <TMath.h>
+#include <TTree.h>
+#include <TGraphErrors.h>
+#include <TCollection.h>
+
+#include "AliLog.h"
+#include "AliXMLEngine.h"
+#include "AliVdMScanCounters.h"
+
+ClassImp(AliVdMScanCounters);
+
+namespace {
+  const Double_t kOrbitFrequency = 11245.5; // Hz
+}
+
+AliVdMScanCounters::AliVdMScanCounters(const char* name)
+  : TNamed(name, "")
+  , fNScans(0)
+  , fStepScan()
+  , fTimeStart()
+  , fTimeEnd()
+  , fStepSep()
+  , fCounts()
+  , fNOutside(0)
+  , fLastStep(-1)
+{
+}
+
+AliVdMScanCounters::AliVdMScanCounters(const AliVdMScanCounters& c)
+  : TNamed(c)
+  , fNScans(c.fNScans)
+  , fStepScan(c.fStepScan)
+  , fTimeStart(c.fTimeStart)
+  , fTimeEnd(c.fTimeEnd)
+  , fStepSep(c.fStepSep)
+  , fCounts(c.fCounts)
+  , fNOutside(c.fNOutside)
+  , fLastStep(-1)
+{
+}
+
+Int_t AliVdMScanCounters::AddScans(const char* xmlFileName) {
+  // each scan node holds a table with (at least) the columns timeStart, timeEnd, sep
+  AliXMLEngine xml(xmlFileName);
+  const AliXMLEngine::Node nodeScans(xml.GetRootNode().GetChild("Scans"));
+  Int_t nScans = 0;
+  for (AliXMLEngine::Node n = nodeScans.GetChildBegin(); n != nodeScans.GetChildEnd(); ++n) {
+    TTree tSep;
+    std::istringstream iss(n.GetData());
+    if (!tSep.ReadStream(iss)) {
+      AliErrorF("cannot read the steps of scan %s", n.GetAttr("type").GetData());
+      continue;
+    }
+    const Int_t m = tSep.Draw("timeStart:timeEnd:sep", "", "GOFF");
+    const Double_t *timeStart = tSep.GetV1();
+    const Double_t *timeEnd   = tSep.GetV2();
+    const Double_t *sep       = tSep.GetV3();
+    const Int_t scan = fNScans;
+    for (Int_t i=0; i<m; ++i)
+      AddStep(scan, UInt_t(timeStart[i]), UInt_t(timeEnd[i]), sep[i]);
+    nScans += (m > 0);
+  }
+  return nScans;
+}
+
+void AliVdMScanCounters::AddStep(Int_t scan, UInt_t timeStart, UInt_t timeEnd, Double_t sep) {
+  if (fCounts.GetSize())
+    AliFatal("steps cannot be added after the counters have been allocated");
+
+  const Int_t n = GetNSteps();
+  if (n && timeStart < UInt_t(fTimeEnd[n-1])) {
+    AliErrorF("step [%u,%u] overlaps with or precedes the previous step; skipped", timeStart, timeEnd);
+    return;
+  }
+  fStepScan.Set(n+1);  fStepScan[n]  = scan;
+  fTimeStart.Set(n+1); fTimeStart[n] = timeStart;
+  fTimeEnd.Set(n+1);   fTimeEnd[n]   = timeEnd;
+  fStepSep.Set(n+1);   fStepSep[n]   = sep;
+  fNScans = TMath::Max(fNScans, scan+1);
+}
+
+Int_t AliVdMScanCounters::FindStep(UInt_t timeStamp) const {
+  // events come ordered in time within a chunk: try the previous step first
+  const Int_t n = GetNSteps();
+  if (fLastStep >= 0 && fLastStep < n &&
+      timeStamp >= UInt_t(fTimeStart[fLastStep]) && timeStamp < UInt_t(fTimeEnd[fLastStep]))
+    return fLastStep;
+
+  Int_t step = TMath::BinarySearch(n, fTimeStart.GetArray(), Int_t(timeStamp));
+  if (step < 0 || timeStamp >= UInt_t(fTimeEnd[step]))
+    return -1;
+  fLastStep = step;
+  return step;
+}
+
+void AliVdMScanCounters::Reset() {
+  fCounts.Set(kNCounters*GetNSteps()*kNBC);
+  fCounts.Reset();
+  fNOutside = 0;
+  fLastStep = -1;
+}
+
+void AliVdMScanCounters::Fill(UInt_t timeStamp, UInt_t bcID, UInt_t counterMask) {
+  if (bcID >= kNBC)
+    return;
+  const Int_t step = FindStep(timeStamp);
+  if (step < 0) {
+    ++fNOutside;
+    return;
+  }
+  for (Int_t counter=0; counter<kNCounters; ++counter) {
+    if (TESTBIT(counterMask, counter))
+      ++fCounts[Index(counter, step, bcID)];
+  }
+}
+
+Long64_t AliVdMScanCounters::Merge(TCollection *list) {
+  if (!list)
+    return 0;
+  TIter next(list);
+  const AliVdMScanCounters *c = NULL;
+  Long64_t n = 0;
+  while ((c = dynamic_cast<const AliVdMScanCounters*>(next()))) {
+    if (c->fCounts.GetSize() != fCounts.GetSize()) {
+      AliErrorF("incompatible scan steps in %s; not merged", c->GetName());
+      continue;
+    }
+    for (Int_t i=0, m=fCounts.GetSize(); i<m; ++i)
+      fCounts[i] += c->fCounts[i];
+    fNOutside += c->fNOutside;
+    ++n;
+  }
+  return n;
+}
+
+Double_t AliVdMScanCounters::GetStepCounts(Int_t counter, Int_t step, Int_t bcID) const {
+  if (!fCounts.GetSize())
+    return 0;
+  if (bcID >= 0)
+    return fCounts[Index(counter, step, bcID)];
+  const Int_t *counts = fCounts.GetArray() + Index(counter, step, 0);
+  Double_t sum = 0;
+  for (Int_t bc=0; bc<kNBC; ++bc)
+    sum += counts[bc];
+  return sum;
+}
+
+Double_t AliVdMScanCounters::GetRate(Int_t counter, Int_t step, Int_t bcID, Double_t &rateErr, UInt_t options) const {
+  // event rate (Hz) in the given step and BC; for bcID<0 the per-BC rates are summed
+  rateErr = 0;
+  const Double_t dt = GetStepDuration(step);
+  if (!fCounts.GetSize() || dt <= 0)
+    return 0;
+
+  Int_t counterBkgd = -1;
+  if (options & kBkgdSubtraction) {
+    if (counter == kV0AND) counterBkgd = kV0ANDBkgd;
+    if (counter == kADAND) counterBkgd = kADANDBkgd;
+  }
+
+  const Int_t bcMin = (bcID < 0 ? 0    : bcID);
+  const Int_t bcMax = (bcID < 0 ? kNBC : bcID+1);
+  const Int_t *counts     = fCounts.GetArray() + Index(counter, step, 0);
+  const Int_t *countsBkgd = (counterBkgd < 0 ? NULL : fCounts.GetArray() + Index(counterBkgd, step, 0));
+  Double_t rate = 0, rateErr2 = 0;
+  for (Int_t bc=bcMin; bc<bcMax; ++bc) {
+    // the background events are a subset of the selected events
+    const Double_t n = counts[bc] - (countsBkgd ? countsBkgd[bc] : 0);
+    if (n <= 0)
+      continue;
+    Double_t r  = n/dt;
+    Double_t dr = TMath::Sqrt(n)/dt;
+    if (options & kPileUpCorrection) {
+      if (r >= kOrbitFrequency) {
+        AliWarningF("rate %.0f Hz in step %d BC %d exceeds the orbit frequency", r, step, bc);
+        continue;
+      }
+      dr /= (1.0 - r/kOrbitFrequency);
+      r   = -kOrbitFrequency*TMath::Log(1.0 - r/kOrbitFrequency);
+    }
+    rate     += r;
+    rateErr2 += dr*dr;
+  }
+  rateErr = TMath::Sqrt(rateErr2);
+  return rate;
+}
+
+TGraphErrors* AliVdMScanCounters::MakeScanCurve(Int_t scan, Int_t counter, Int_t bcID, UInt_t options) const {
+  // rate vs. beam separation (in the units of the step definition)
+  TGraphErrors *g = new TGraphErrors;
+  g->SetName(TString::Format("g%s_Scan%d_BC%d", GetCounterName(counter), scan, bcID));
+  g->SetTitle(TString::Format("%s scan %d %s;separation;rate (Hz)", GetCounterName(counter), scan,
+                              (bcID < 0 ? "all BCs" : TString::Format("BC %d", bcID).Data())));
+  for (Int_t step=0, n=GetNSteps(); step<n; ++step) {
+    if (fStepScan[step] != scan)
+      continue;
+    Double_t rateErr = 0;
+    const Double_t rate = GetRate(counter, step, bcID, rateErr, options);
+    const Int_t i = g->GetN();
+    g->SetPoint(i, fStepSep[step], rate);
+    g->SetPointError(i, 0, rateErr);
+  }
+  return g;
+}
+
+const char* AliVdMScanCounters::GetCounterName(Int_t counter) {
+  static const char* names[kNCounters] = {
+    "All",
+    "V0AND", "V0ANDBkgd", "V0ANDPileUp",
+    "ADAND", "ADANDBkgd", "ADANDPileUp"
+  };
+  return (counter >= 0 && counter < kNCounters ? names[counter] : "");
+}
@@ -0,0 +1,92 @@
+// -*- C++ -*-
+#ifndef _ALI_VDM_SCAN_COUNTERS_H
+#define _ALI_VDM_SCAN_COUNTERS_H
+
+#include <TNamed.h>
+#include <TArrayI.h>
+#include <TArrayD.h>
+
+class TCollection;
+class TGraphErrors;
+
+// per-BC and per-scan-step event counters filled online by AliAnalysisTaskVdM
+//
+// the counts are kept in one dense array indexed by (counter, step, BCID) so that
+// scan curves and the rates for the non-separation fit are obtained directly from
+// the counters, without going through the event tree
+//
+// the scan steps (start/end time stamp and beam separation) are taken from the vdM
+// XML file (see AliVdMData) and are defined before the task is run
+class AliVdMScanCounters : public TNamed {
+public:
+  enum {
+    kNBC = 3564
+  };
+  enum ECounter {
+    kAll = 0,      // all physics events
+    kV0AND,        // online V0 decision BB on both sides
+    kV0ANDBkgd,    // V0AND with BG flags on either side
+    kV0ANDPileUp,  // V0AND with BB flags on both sides in a neighbouring BC
+    kADAND,        // online AD decision BB on both sides
+    kADANDBkgd,    // ADAND with BG flags on either side
+    kADANDPileUp,  // ADAND with BB flags on both sides in a neighbouring BC
+    kNCounters
+  };
+  enum {
+    kBkgdSubtraction  = BIT(0), // subtract the counts of the corresponding ..Bkgd counter
+    kPileUpCorrection = BIT(1)  // convert the rate per BC into mu = -log(1-rate/f_orbit)
+  };
+
+  AliVdMScanCounters(const char* name="VdMScanCounters");
+  AliVdMScanCounters(const AliVdMScanCounters&);
+  virtual ~AliVdMScanCounters() {}
+
+  // scan step definition
+  Int_t AddScans(const char* xmlFileName);
+  void  AddStep(Int_t scan, UInt_t timeStart, UInt_t timeEnd, Double_t sep);
+
+  Int_t    GetNSteps()             const { return fTimeStart.GetSize(); }
+  Int_t    GetNScans()             const { return fNScans; }
+  Int_t    GetStepScan(Int_t step) const { return fStepScan[step]; }
+  Double_t GetStepSep(Int_t step)  const { return fStepSep[step]; }
+  Double_t GetStepDuration(Int_t step) const { return Double_t(fTimeEnd[step]) - Double_t(fTimeStart[step]); }
+  Int_t    FindStep(UInt_t timeStamp) const;
+
+  // online filling
+  void Reset();
+  void Fill(UInt_t timeStamp, UInt_t bcID, UInt_t counterMask);
+  Long64_t Merge(TCollection *list);
+
+  // post-processing
+  Int_t    GetCounts(Int_t counter, Int_t step, Int_t bcID) const {
+    return (fCounts.GetSize() ? fCounts[Index(counter, step, bcID)] : 0);
+  }
+  Double_t GetStepCounts(Int_t counter, Int_t step, Int_t bcID=-1) const;
+  Double_t GetRate(Int_t counter, Int_t step, Int_t bcID, Double_t &rateErr, UInt_t options=0) const;
+  Int_t    GetNEventsOutside() const { return fNOutside; }
+
+  TGraphErrors* MakeScanCurve(Int_t scan, Int_t counter, Int_t bcID=-1, UInt_t options=0) const;
+
+  static const char* GetCounterName(Int_t counter);
+
+protected:
+  Int_t Index(Int_t counter, Int_t step, Int_t bcID) const {
+    return (counter*GetNSteps() + step)*kNBC + bcID;
+  }
+
+private:
+  AliVdMScanCounters& operator=(const AliVdMScanCounters&); // not implemented
+
+  Int_t    fNScans;      // number of scans
+  TArrayI  fStepScan;    // scan index of each step
+  TArrayI  fTimeStart;   // start time stamp of each step (steps are ordered in time)
+  TArrayI  fTimeEnd;     // end time stamp of each step
+  TArrayD  fStepSep;     // beam separation of each step
+  TArrayI  fCounts;      // [counter][step][BCID]
+  Int_t    fNOutside;    // physics events outside of all steps
+  mutable Int_t fLastStep; //! step of the previous event
+
+  ClassDef(AliVdMScanCounters, 1);
+} ;
+
+#endif // _ALI_VDM_SCAN_COUNTERS_H
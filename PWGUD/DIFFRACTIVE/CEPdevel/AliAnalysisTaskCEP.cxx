@@ -751,6 +751,10 @@ void AliAnalysisTaskCEP::UserExec(Option_t *)
   // kZDC: hit on any side of ZDC
   // kZNA, kZNC: ZN
   // printf("<I - UserExec> Doing trigger analysis ...\n");
+  // the SPD, V0, AD and ZDC data are read once and the decisions are
+  // shared by all the trigger terms below (kMB1 and kV0AND reuse the
+  // SPD and V0 decisions)
+  fTrigger->EvaluateAll(fEvent);
   Bool_t isSPD  =
     (fTrigger->IsOfflineTriggerFired(fEvent,AliTriggerAnalysis::kSPDGFO));
   // Bool_t isSPD  =
@@ -779,6 +783,7 @@ void AliAnalysisTaskCEP::UserExec(Option_t *)
     (fTrigger->IsOfflineTriggerFired(fEvent,AliTriggerAnalysis::kZNA));
   Bool_t isZDNC  =
     (fTrigger->IsOfflineTriggerFired(fEvent,AliTriggerAnalysis::kZNC));
+  fTrigger->ResetEventDecisions();
   
   Bool_t isV0DG = isSPD && !(isV0A || isV0C);
   Bool_t isADDG = isSPD && !(isADA || isADC);
@@ -185,14 +185,14 @@ protected:
   TObjString *fDataFilnam; //-> input file name and path
   Long64_t fEvtNum; // event number in input file
   Int_t fRunNum; // run number
-  Double_t fVtxPos[3]; // default primary vertex position
-  Double_t fVtxChi2perNDF; // chi2/ndf of vertex fit
-  Double_t fVtxCov[6]; // vertex covariance matrix
+  Double32_t fVtxPos[3]; // default primary vertex position
+  Double32_t fVtxChi2perNDF; // chi2/ndf of vertex fit
+  Double32_t fVtxCov[6]; // vertex covariance matrix
   Int_t fVtxNContributors; // # of tracklets/tracks used for the estimate
   TObjString *fVtxTitle; //-> title of default primary vertex
-  Double_t fVtxSPDpos[3]; // SPD primary vertex position
-  Double_t fVtxSPDchi2perNDF; // chi2/ndf of vertex fit
-  Double_t fVtxSPDcov[6]; // vertex covariance matrix
+  Double32_t fVtxSPDpos[3]; // SPD primary vertex position
+  Double32_t fVtxSPDchi2perNDF; // chi2/ndf of vertex fit
+  Double32_t fVtxSPDcov[6]; // vertex covariance matrix
   Int_t fVtxSPDnContributors; // # of tracklets/tracks used for the estimate
   TObjString *fVtxSPDtitle; //-> title of SPD primary vertex
   Float_t fVtxMCpos[3]; // MC primary vertex position
@@ -212,10 +212,10 @@ protected:
   UInt_t fBBFlagADA; // online beam-beam flags in V0C one bit per cell
   Int_t fADADecision; // ADA decision, set by enumeration: kADInvalid = -1, kADEmpty = 0, kADBB, kADBG, kADFake
   Int_t fADCDecision; // ADC decision
-  Double_t fZNCEnergy; // reconstructed energy in the neutron ZDC, C-side
-  Double_t fZPCEnergy; // reconstructed energy in the proton ZDC, C-side
-  Double_t fZNAEnergy; // reconstructed energy in the neutron ZDC, A-side
-  Double_t fZPAEnergy; // reconstructed energy in the proton ZDC, A-side
+  Double32_t fZNCEnergy; // reconstructed energy in the neutron ZDC, C-side
+  Double32_t fZPCEnergy; // reconstructed energy in the proton ZDC, C-side
+  Double32_t fZNAEnergy; // reconstructed energy in the neutron ZDC, A-side
+  Double32_t fZPAEnergy; // reconstructed energy in the proton ZDC, A-side
   Bool_t fZNCtdc; // ZDC TDC data, NC
   Bool_t fZPCtdc; // ZDC TDC data, PC
   Bool_t fZNAtdc; // ZDC TDC data, NA
@@ -245,7 +245,7 @@ protected:
   static TClonesArray *fgUPCMuonTracks; // array of muon upc tracks
   static TClonesArray *fgMCParticles; // array of MC particles
 
-  ClassDef(AliUPCEvent,4);
+  ClassDef(AliUPCEvent,5);
 };
 
 #endif
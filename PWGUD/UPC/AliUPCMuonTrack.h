@@ -55,21 +55,21 @@ protected:
   AliUPCMuonTrack(const AliUPCMuonTrack &o);
   AliUPCMuonTrack &operator=(const AliUPCMuonTrack &o);
 
-  Double_t fPt; // transversal momentum
-  Double_t fEta; // pseudorapidity
-  Double_t fPhi; // azimutal angle
+  Double32_t fPt; // transversal momentum
+  Double32_t fEta; // pseudorapidity
+  Double32_t fPhi; // azimutal angle
   Short_t fCharge; // track charge
   Int_t fMatchTrigger; // muon trigger match
-  Double_t fRabs; // transverse position r of the track at the end of the absorber
-  Double_t fChi2perNDF; // chi2/NDF of momentum fit
-  Double_t fDca; // Distance of Closest Approach in the vertex plane
+  Double32_t fRabs; // transverse position r of the track at the end of the absorber
+  Double32_t fChi2perNDF; //[0,0,8] chi2/NDF of momentum fit
+  Double32_t fDca; // Distance of Closest Approach in the vertex plane
   Bool_t fPdca; // pDCA by AliMuonTrackCuts
   TArrayI *fArrayInt; // extension of the muon track for other integer parameters
   TArrayD *fArrayD; // extension of the muon track for other double parameters
 
-  const Double_t fkMuonMass; // mass of muon
+  const Double_t fkMuonMass; //! mass of muon
 
-  ClassDef(AliUPCMuonTrack,1);
+  ClassDef(AliUPCMuonTrack,2);
 };
 
 #endif
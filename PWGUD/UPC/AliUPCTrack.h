@@ -90,20 +90,20 @@ protected:
   AliUPCTrack(const AliUPCTrack &o);
   AliUPCTrack &operator=(const AliUPCTrack &o);
 
-  Double_t fP[3]; // momentum px, py, pz
+  Double32_t fP[3]; // momentum px, py, pz
   Short_t fCharge; // track charge
   UChar_t fMaskMan; // 8-bit filter mask, manual fill
   UInt_t fFilterMap; // // filter information, one bit per set of cuts, 32 bit
-  Double_t fChi2perNDF; // chi2/NDF of momentum fit
-  Double_t fTPCmomentum; // tpc momentum
-  Double_t fTPCsignal; // tpc dEdx signal
+  Double32_t fChi2perNDF; //[0,0,8] chi2/NDF of momentum fit
+  Double32_t fTPCmomentum; // tpc momentum
+  Double32_t fTPCsignal; //[0,0,10] tpc dEdx signal
   UShort_t fTPCncls; // number of clusters assigned in the TPC
   Float_t fTPCrows; // number of of crossed raws in TPC
   UShort_t fTPCnclsF; // number of findable clusters in the TPC
   UShort_t fTPCnclsS; // number of shared clusters in the TPC
-  Double_t fITSchi2perNDF; // chi2 in ITS per cluster
+  Double32_t fITSchi2perNDF; //[0,0,8] chi2 in ITS per cluster
   UChar_t fITSClusterMap; // map of clusters, one bit per a layer
-  Double_t fTOFsignal; // TOF PID signal
+  Double32_t fTOFsignal; // TOF PID signal
   Float_t fDZ[2]; // impact parameters in XY and Z to default primary vertex
   Float_t fCov[3]; // Covariance matrix of the impact parameters
   Float_t fdzSPD[2]; // SPD impact parameters in XY and Z
@@ -115,7 +115,7 @@ protected:
   TArrayI *fArrayInt; // extension of the central track for other integer parameters
   TArrayD *fArrayD; // extension of the central track for other double parameters
 
-  ClassDef(AliUPCTrack,1);
+  ClassDef(AliUPCTrack,2);
 };
 
 #endif
@@ -886,7 +886,16 @@ Int_t AliMultiplicityCorrection::ApplyMinuitFit(Int_t inputRange, Bool_t fullPha
     fMultiplicityVtx[inputRange]->SetBinContent(1, 1, fMultiplicityMB[inputRange]->GetBinContent(1, 1) * fCurrentEfficiency->GetBinContent(1));
   }
   
+  ApplyTriggerBiasCorrection(inputRange, correlationID, eventType);
+  
+  return resultCode;
+}
+
+//____________________________________________________________________
+void AliMultiplicityCorrection::ApplyTriggerBiasCorrection(Int_t inputRange, Int_t correlationID, EventType eventType)
+{
   // correct for the trigger bias if requested
+
   if (eventType > kMB)
   {
     Printf("Applying trigger efficiency");
@@ -897,7 +906,30 @@ Int_t AliMultiplicityCorrection::ApplyMinuitFit(Int_t inputRange, Bool_t fullPha
       fMultiplicityESDCorrected[correlationID]->SetBinError(i, fMultiplicityESDCorrected[correlationID]->GetBinError(i) / eff->GetBinContent(i));
     }
   }
-  
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityCorrection::ApplyLinearChi2Fit(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Int_t zeroBinEvents, AliMultiplicityLinearUnfolding::RegularizationType regType, Float_t regWeight)
+{
+  //
+  // correct spectrum using the chi2 method with a quadratic regularization, solved with
+  // linear algebra instead of a minuit fit (see AliMultiplicityLinearUnfolding)
+  //
+
+  Int_t correlationID = inputRange + ((fullPhaseSpace == kFALSE) ? 0 : 4);
+
+  // use here only vtx efficiency (to MB sample) which is always needed if we use the 0 bin
+  SetupCurrentHists(inputRange, fullPhaseSpace, (eventType == kTrVtx) ? kTrVtx : kMB);
+
+  Calculate0Bin(inputRange, eventType, zeroBinEvents);
+
+  AliMultiplicityLinearUnfolding unfolding;
+  unfolding.SetResponse(fCurrentCorrelation, fCurrentEfficiency);
+  unfolding.SetRegularization(regType, regWeight);
+  Int_t resultCode = unfolding.Unfold(fCurrentESD, fMultiplicityESDCorrected[correlationID]);
+
+  ApplyTriggerBiasCorrection(inputRange, correlationID, eventType);
+
   return resultCode;
 }
 
@@ -1697,6 +1729,100 @@ TH1* AliMultiplicityCorrection::StatisticalUncertainty(AliUnfolding::MethodType
   return standardDeviation;
 }
 
+//____________________________________________________________________
+TH1* AliMultiplicityCorrection::StatisticalUncertaintyLinearChi2(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Int_t zeroBinEvents, Bool_t randomizeMeasured, Bool_t randomizeResponse, AliMultiplicityLinearUnfolding::RegularizationType regType, Float_t regWeight, Int_t nToys)
+{
+  //
+  // same as StatisticalUncertainty for the linear chi2 method (ApplyLinearChi2Fit)
+  // the weights are fixed to the ones of the measured spectrum, so that if only the measured
+  // spectrum is randomized the factorization of the first unfolding is reused for all toys
+  //
+  // returns the relative standard deviation of the toys
+  //
+
+  Int_t correlationID = inputRange + ((fullPhaseSpace == kFALSE) ? 0 : 4);
+
+  // initialize seed with current time
+  gRandom->SetSeed(0);
+
+  SetupCurrentHists(inputRange, fullPhaseSpace, (eventType == kTrVtx) ? kTrVtx : kMB);
+  Calculate0Bin(inputRange, eventType, zeroBinEvents);
+
+  AliMultiplicityLinearUnfolding unfolding;
+  unfolding.SetResponse(fCurrentCorrelation, fCurrentEfficiency);
+  unfolding.SetRegularization(regType, regWeight);
+  unfolding.SetWeights(fCurrentESD);
+
+  TH2* response = (TH2*) fCurrentCorrelation->Clone("responseLinearChi2");
+  TH1* measured = (TH1*) fCurrentESD->Clone("measuredLinearChi2");
+
+  TH1** results = new TH1*[nToys];
+  Int_t nResults = 0;
+  for (Int_t n=0; n<nToys; ++n)
+  {
+    if (n > 0)
+    {
+      if (randomizeResponse)
+      {
+        // randomize response matrix
+        for (Int_t i=1; i<=response->GetNbinsX(); ++i)
+          for (Int_t j=1; j<=response->GetNbinsY(); ++j)
+            response->SetBinContent(i, j, gRandom->Poisson(fCurrentCorrelation->GetBinContent(i, j)));
+        unfolding.SetResponse(response, fCurrentEfficiency);
+      }
+
+      if (randomizeMeasured)
+      {
+        // randomize measured spectrum
+        for (Int_t x=1; x<=measured->GetNbinsX(); x++) // mult. axis
+        {
+          Int_t randomValue = gRandom->Poisson(fCurrentESD->GetBinContent(x));
+          measured->SetBinContent(x, randomValue);
+          measured->SetBinError(x, TMath::Sqrt(randomValue));
+        }
+      }
+    }
+
+    TH1* result = (TH1*) fMultiplicityESDCorrected[correlationID]->Clone(Form("resultLinearChi2_%d", n));
+    if (unfolding.Unfold(measured, result) != 0 || result->Integral() <= 0)
+    {
+      delete result;
+      if (n == 0)
+        break;
+      continue;
+    }
+
+    // normalize
+    result->Scale(1.0 / result->Integral());
+    results[nResults++] = result;
+  }
+
+  Printf("AliMultiplicityCorrection::StatisticalUncertaintyLinearChi2: %d unfoldings with %d factorizations", nResults, unfolding.GetNFactorizations());
+
+  TH1* standardDeviation = 0;
+  if (nResults > 1)
+  {
+    standardDeviation = CalculateStdDev(results, nResults);
+
+    // fill into result histogram
+    fMultiplicityESDCorrected[correlationID]->Reset();
+    unfolding.SetResponse(fCurrentCorrelation, fCurrentEfficiency);
+    unfolding.Unfold(fCurrentESD, fMultiplicityESDCorrected[correlationID]);
+    for (Int_t i=1; i<=fMultiplicityESDCorrected[correlationID]->GetNbinsX(); ++i)
+      fMultiplicityESDCorrected[correlationID]->SetBinError(i, standardDeviation->GetBinContent(i) * fMultiplicityESDCorrected[correlationID]->GetBinContent(i));
+    ApplyTriggerBiasCorrection(inputRange, correlationID, eventType);
+  }
+
+  // clean up
+  for (Int_t n=0; n<nResults; ++n)
+    delete results[n];
+  delete[] results;
+  delete response;
+  delete measured;
+
+  return standardDeviation;
+}
+
 //____________________________________________________________________
 void AliMultiplicityCorrection::ApplyBayesianMethod(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Float_t regPar, Int_t nIterations, TH1* initialConditions, Int_t determineError)
 {
@@ -28,6 +28,7 @@ class TCollection;
 #include <TVectorD.h>
 #include <AliPWG0Helper.h>
 #include <AliUnfolding.h>
+#include "AliMultiplicityLinearUnfolding.h"
 
 class AliMultiplicityCorrection : public TNamed {
   public:
@@ -61,8 +62,11 @@ class AliMultiplicityCorrection : public TNamed {
 
     void ApplyBayesianMethod(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Float_t regPar = 1, Int_t nIterations = 100, TH1* initialConditions = 0, Int_t determineError = 1);
 
+    Int_t ApplyLinearChi2Fit(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Int_t zeroBinEvents, AliMultiplicityLinearUnfolding::RegularizationType regType = AliMultiplicityLinearUnfolding::kSecondDerivative, Float_t regWeight = 1);
+
     static TH1* CalculateStdDev(TH1** results, Int_t max);
     TH1* StatisticalUncertainty(AliUnfolding::MethodType methodType, Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Int_t zeroBinEvents, Bool_t randomizeMeasured, Bool_t randomizeResponse, const TH1* compareTo = 0);
+    TH1* StatisticalUncertaintyLinearChi2(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType, Int_t zeroBinEvents, Bool_t randomizeMeasured, Bool_t randomizeResponse, AliMultiplicityLinearUnfolding::RegularizationType regType = AliMultiplicityLinearUnfolding::kSecondDerivative, Float_t regWeight = 1, Int_t nToys = 20);
 
     Int_t ApplyNBDFit(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType);
     void ApplyGaussianMethod(Int_t inputRange, Bool_t fullPhaseSpace);
@@ -119,6 +123,7 @@ class AliMultiplicityCorrection : public TNamed {
 
   protected:
     void SetupCurrentHists(Int_t inputRange, Bool_t fullPhaseSpace, EventType eventType);
+    void ApplyTriggerBiasCorrection(Int_t inputRange, Int_t correlationID, EventType eventType);
 
     Float_t BayesCovarianceDerivate(Float_t matrixM[251][251], const TH2* hResponse, Int_t k, Int_t i, Int_t r, Int_t u);
     
@@ -0,0 +1,227 @@
+/* $Id$ */
+
+//
+// chi2 unfolding with a quadratic regularization, solved with dense linear algebra
+// see header for the definition of the chi2
+//
+
+#include <TH1.h>
+#include <TH2.h>
+#include <TMath.h>
+
+#include <AliLog.h>
+
+#include "AliMultiplicityLinearUnfolding.h"
+
+//____________________________________________________________________
+AliMultiplicityLinearUnfolding::AliMultiplicityLinearUnfolding() :
+  fRegularization(kSecondDerivative),
+  fWeight(1),
+  fNTrue(0),
+  fNMeasured(0),
+  fResponse(),
+  fEfficiency(),
+  fInvError2(),
+  fNormalization(1),
+  fFixedWeights(kFALSE),
+  fRegMatrix(),
+  fDecomposition(),
+  fCovariance(),
+  fFactorized(kFALSE),
+  fNFactorizations(0)
+{
+  // default constructor
+}
+
+//____________________________________________________________________
+void AliMultiplicityLinearUnfolding::SetRegularization(RegularizationType type, Double_t weight)
+{
+  // sets the regularization and builds L^T L
+
+  fRegularization = type;
+  fWeight = weight;
+  fFactorized = kFALSE;
+
+  if (fNTrue > 0)
+  {
+    Int_t nRows = (type == kFirstDerivative) ? fNTrue - 1 : fNTrue - 2;
+    TMatrixD derivative(TMath::Max(nRows, 1), fNTrue);
+    for (Int_t i=0; i<nRows; ++i)
+    {
+      if (type == kFirstDerivative)
+      {
+        derivative(i, i) = -1;
+        derivative(i, i+1) = 1;
+      }
+      else
+      {
+        derivative(i, i) = 1;
+        derivative(i, i+1) = -2;
+        derivative(i, i+2) = 1;
+      }
+    }
+    fRegMatrix.ResizeTo(fNTrue, fNTrue);
+    fRegMatrix.TMult(derivative);
+  }
+}
+
+//____________________________________________________________________
+void AliMultiplicityLinearUnfolding::SetResponse(const TH2* correlation, const TH1* efficiency)
+{
+  // sets the response from the correlation map (x: true, y: measured), normalized to 1 per true bin
+
+  fNTrue = correlation->GetNbinsX();
+  fNMeasured = correlation->GetNbinsY();
+
+  fResponse.ResizeTo(fNMeasured, fNTrue);
+  fEfficiency.ResizeTo(fNTrue);
+  for (Int_t t=0; t<fNTrue; ++t)
+  {
+    Double_t sum = correlation->Integral(t+1, t+1, 1, fNMeasured);
+    for (Int_t m=0; m<fNMeasured; ++m)
+      fResponse(m, t) = (sum > 0) ? correlation->GetBinContent(t+1, m+1) / sum : 0;
+    fEfficiency(t) = efficiency ? efficiency->GetBinContent(t+1) : 1;
+  }
+
+  SetRegularization(fRegularization, fWeight);
+}
+
+//____________________________________________________________________
+void AliMultiplicityLinearUnfolding::ComputeWeights(const TH1* measured)
+{
+  // weights from the errors of the measured spectrum (at least 1 entry, for empty bins)
+
+  fInvError2.ResizeTo(fNMeasured);
+  fNormalization = 0;
+  for (Int_t m=0; m<fNMeasured; ++m)
+  {
+    Double_t error = TMath::Max(measured->GetBinError(m+1), 1.);
+    fInvError2(m) = 1. / error / error;
+    fNormalization += measured->GetBinContent(m+1);
+  }
+  if (fNormalization <= 0)
+    fNormalization = 1;
+  fFactorized = kFALSE;
+}
+
+//____________________________________________________________________
+void AliMultiplicityLinearUnfolding::SetWeights(const TH1* measured)
+{
+  // fixes the weights (and the normalization of the regularization) to the ones of <measured>
+  // the following calls to Unfold reuse the factorization as long as the response and the
+  // regularization are not changed, e.g. for toy variations of the measured spectrum
+
+  ComputeWeights(measured);
+  fFixedWeights = kTRUE;
+}
+
+//____________________________________________________________________
+Bool_t AliMultiplicityLinearUnfolding::Factorize()
+{
+  // builds the normal matrix R^T W R + weight / N * L^T L and decomposes it
+
+  TMatrixDSym normal(fNTrue);
+  for (Int_t i=0; i<fNTrue; ++i)
+    for (Int_t j=i; j<fNTrue; ++j)
+    {
+      Double_t sum = 0;
+      for (Int_t m=0; m<fNMeasured; ++m)
+        sum += fResponse(m, i) * fInvError2(m) * fResponse(m, j);
+      sum += fWeight / fNormalization * fRegMatrix(i, j);
+      normal(i, j) = sum;
+      normal(j, i) = sum;
+    }
+
+  fDecomposition.SetMatrix(normal);
+  if (!fDecomposition.Decompose())
+  {
+    AliErrorClass("Normal matrix is not positive definite, increase the regularization weight");
+    return kFALSE;
+  }
+
+  fCovariance.ResizeTo(fNTrue, fNTrue);
+  fDecomposition.Invert(fCovariance);
+
+  fFactorized = kTRUE;
+  ++fNFactorizations;
+  return kTRUE;
+}
+
+//____________________________________________________________________
+Int_t AliMultiplicityLinearUnfolding::Unfold(const TH1* measured, TH1* result)
+{
+  // unfolds <measured> into <result>, the errors of <result> are the diagonal of the covariance
+  // returns 0 on success
+
+  if (fNTrue == 0 || measured->GetNbinsX() < fNMeasured || result->GetNbinsX() < fNTrue)
+  {
+    AliErrorClass("Response not set or binning inconsistent");
+    return -1;
+  }
+
+  if (!fFixedWeights)
+    ComputeWeights(measured);
+
+  if (!fFactorized && !Factorize())
+    return -1;
+
+  // R^T W y
+  TVectorD unfolded(fNTrue);
+  for (Int_t t=0; t<fNTrue; ++t)
+  {
+    Double_t sum = 0;
+    for (Int_t m=0; m<fNMeasured; ++m)
+      sum += fResponse(m, t) * fInvError2(m) * measured->GetBinContent(m+1);
+    unfolded(t) = sum;
+  }
+
+  if (!fDecomposition.Solve(unfolded))
+    return -1;
+
+  result->Reset();
+  for (Int_t t=0; t<fNTrue; ++t)
+  {
+    if (fEfficiency(t) <= 0)
+      continue;
+    result->SetBinContent(t+1, unfolded(t) / fEfficiency(t));
+    result->SetBinError(t+1, TMath::Sqrt(TMath::Max(fCovariance(t, t), 0.)) / fEfficiency(t));
+  }
+
+  return 0;
+}
+
+//____________________________________________________________________
+Double_t AliMultiplicityLinearUnfolding::Chi2(const TVectorD& unfolded, const TVectorD& measured, TVectorD* gradient) const
+{
+  // chi2 of the unfolded spectrum (before efficiency correction) with the current weights
+  // if <gradient> is given, it is filled with the analytic derivatives d chi2 / d u_t
+
+  TVectorD residual(measured);
+  residual -= fResponse * unfolded;
+
+  Double_t chi2 = 0;
+  TVectorD weighted(fNMeasured);
+  for (Int_t m=0; m<fNMeasured; ++m)
+  {
+    weighted(m) = fInvError2(m) * residual(m);
+    chi2 += residual(m) * weighted(m);
+  }
+
+  TVectorD regularized(fRegMatrix * unfolded);
+  Double_t regWeight = fWeight / fNormalization;
+  chi2 += regWeight * (unfolded * regularized);
+
+  if (gradient)
+  {
+    gradient->ResizeTo(fNTrue);
+    for (Int_t t=0; t<fNTrue; ++t)
+    {
+      Double_t sum = 0;
+      for (Int_t m=0; m<fNMeasured; ++m)
+        sum += fResponse(m, t) * weighted(m);
+      (*gradient)(t) = -2 * sum + 2 * regWeight * regularized(t);
+    }
+  }
+
+  return chi2;
+}
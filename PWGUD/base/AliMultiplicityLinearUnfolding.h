@@ -0,0 +1,69 @@
+/* $Id$ */
+
+#ifndef ALIMULTIPLICITYLINEARUNFOLDING_H
+#define ALIMULTIPLICITYLINEARUNFOLDING_H
+
+//
+// chi2 unfolding with a quadratic regularization, solved with dense linear algebra
+//
+// chi2(u) = sum_m w_m (y_m - (R u)_m)^2 + weight / N * |L u|^2
+//
+// R is the response normalized per true bin, w_m = 1/e(y_m)^2, N the integral of the
+// measured spectrum and L the first or second derivative operator. chi2 and its gradient
+// are analytic; the minimum is the solution of the normal equations, which are factorized
+// once with a Cholesky decomposition: repeated unfoldings with the same response,
+// regularization and weights (e.g. toys of the measured spectrum) reuse the factorization.
+// As in AliUnfolding, the result is divided by the efficiency.
+//
+// The solution is not constrained to be positive; negative bins indicate a too weak
+// regularization.
+//
+
+#include <TMatrixD.h>
+#include <TMatrixDSym.h>
+#include <TVectorD.h>
+#include <TDecompChol.h>
+
+class TH1;
+class TH2;
+
+class AliMultiplicityLinearUnfolding
+{
+  public:
+    enum RegularizationType { kFirstDerivative = 0, kSecondDerivative };
+
+    AliMultiplicityLinearUnfolding();
+    ~AliMultiplicityLinearUnfolding() {}
+
+    void SetRegularization(RegularizationType type, Double_t weight);
+    void SetResponse(const TH2* correlation, const TH1* efficiency);
+    void SetWeights(const TH1* measured);
+
+    Int_t Unfold(const TH1* measured, TH1* result);
+
+    Double_t Chi2(const TVectorD& unfolded, const TVectorD& measured, TVectorD* gradient = 0) const;
+
+    const TMatrixDSym& GetCovariance() const { return fCovariance; }
+    Int_t GetNFactorizations() const { return fNFactorizations; }
+
+  protected:
+    void   ComputeWeights(const TH1* measured);
+    Bool_t Factorize();
+
+    RegularizationType fRegularization; // type of the regularization
+    Double_t fWeight;                   // weight of the regularization
+    Int_t fNTrue;                       // number of true bins
+    Int_t fNMeasured;                   // number of measured bins
+    TMatrixD fResponse;                 // response (measured x true), normalized per true bin
+    TVectorD fEfficiency;               // efficiency per true bin
+    TVectorD fInvError2;                // weights of the measured bins
+    Double_t fNormalization;            // integral of the measured spectrum, normalization of the regularization
+    Bool_t fFixedWeights;               // weights set with SetWeights, kept for the following unfoldings
+    TMatrixDSym fRegMatrix;             // L^T L
+    TDecompChol fDecomposition;         // Cholesky decomposition of the normal matrix
+    TMatrixDSym fCovariance;            // inverse of the normal matrix (covariance of the unfolded spectrum)
+    Bool_t fFactorized;                 // fDecomposition is up to date
+    Int_t fNFactorizations;             // number of factorizations done
+};
+
+#endif
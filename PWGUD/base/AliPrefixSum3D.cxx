@@ -0,0 +1,125 @@
+/* $Id$ */
+
+// ------------------------------------------------------
+//
+// Summed-area table of a 3d histogram
+//
+// ------------------------------------------------------
+
+#include <TH3.h>
+#include <TMath.h>
+
+#include "AliPrefixSum3D.h"
+
+//____________________________________________________________________
+AliPrefixSum3D::AliPrefixSum3D() :
+  fXaxis(),
+  fYaxis(),
+  fZaxis(),
+  fNx(0),
+  fNy(0),
+  fNz(0),
+  fSum(),
+  fSumError2()
+{
+  // default constructor
+}
+
+//____________________________________________________________________
+AliPrefixSum3D::AliPrefixSum3D(const TH3* hist, Bool_t errors) :
+  fXaxis(),
+  fYaxis(),
+  fZaxis(),
+  fNx(0),
+  fNy(0),
+  fNz(0),
+  fSum(),
+  fSumError2()
+{
+  // constructor, builds the table from hist
+
+  Build(hist, errors);
+}
+
+//____________________________________________________________________
+void AliPrefixSum3D::Build(const TH3* hist, Bool_t errors)
+{
+  // fills the cumulative sums of hist (including under/overflow bins) in one pass
+
+  fSum.clear();
+  fSumError2.clear();
+  fNx = fNy = fNz = 0;
+  if (!hist)
+    return;
+
+  fXaxis = *hist->GetXaxis();
+  fYaxis = *hist->GetYaxis();
+  fZaxis = *hist->GetZaxis();
+
+  // one leading row of zeros per axis, then bins 0 ... n+1
+  fNx = hist->GetNbinsX() + 3;
+  fNy = hist->GetNbinsY() + 3;
+  fNz = hist->GetNbinsZ() + 3;
+
+  fSum.assign(fNx * fNy * fNz, 0.);
+  if (errors)
+    fSumError2.assign(fNx * fNy * fNz, 0.);
+
+  for (Int_t k = 1; k < fNz; ++k)
+    for (Int_t j = 1; j < fNy; ++j)
+      for (Int_t i = 1; i < fNx; ++i)
+      {
+        Int_t bin = hist->GetBin(i - 1, j - 1, k - 1);
+        Double_t content = hist->GetBinContent(bin);
+        Double_t error2 = errors ? TMath::Power(hist->GetBinError(bin), 2) : 0;
+
+        // inclusion-exclusion of the 7 already computed neighbours
+        Int_t idx = Index(i, j, k);
+        Int_t x = Index(i - 1, j, k), y = Index(i, j - 1, k), z = Index(i, j, k - 1);
+        Int_t xy = Index(i - 1, j - 1, k), xz = Index(i - 1, j, k - 1), yz = Index(i, j - 1, k - 1);
+        Int_t xyz = Index(i - 1, j - 1, k - 1);
+
+        fSum[idx] = content + fSum[x] + fSum[y] + fSum[z] - fSum[xy] - fSum[xz] - fSum[yz] + fSum[xyz];
+        if (errors)
+          fSumError2[idx] = error2 + fSumError2[x] + fSumError2[y] + fSumError2[z] - fSumError2[xy] - fSumError2[xz] - fSumError2[yz] + fSumError2[xyz];
+      }
+}
+
+//____________________________________________________________________
+Double_t AliPrefixSum3D::BoxSum(const std::vector<Double_t>& table, Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int_t binz1, Int_t binz2) const
+{
+  // sum over the inclusive bin box, the limits are clamped to the under/overflow bins
+
+  if (table.empty())
+    return 0;
+
+  binx1 = TMath::Max(binx1, 0); binx2 = TMath::Min(binx2, fNx - 2);
+  biny1 = TMath::Max(biny1, 0); biny2 = TMath::Min(biny2, fNy - 2);
+  binz1 = TMath::Max(binz1, 0); binz2 = TMath::Min(binz2, fNz - 2);
+  if (binx1 > binx2 || biny1 > biny2 || binz1 > binz2)
+    return 0;
+
+  // table index of bin b is b+1; the lower corners are the bins before the range
+  Int_t x1 = binx1, x2 = binx2 + 1;
+  Int_t y1 = biny1, y2 = biny2 + 1;
+  Int_t z1 = binz1, z2 = binz2 + 1;
+
+  return table[Index(x2, y2, z2)] - table[Index(x1, y2, z2)] - table[Index(x2, y1, z2)] - table[Index(x2, y2, z1)]
+       + table[Index(x1, y1, z2)] + table[Index(x1, y2, z1)] + table[Index(x2, y1, z1)] - table[Index(x1, y1, z1)];
+}
+
+//____________________________________________________________________
+Double_t AliPrefixSum3D::Integral(Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int_t binz1, Int_t binz2) const
+{
+  // sum of the bin contents in the given bin ranges
+
+  return BoxSum(fSum, binx1, binx2, biny1, biny2, binz1, binz2);
+}
+
+//____________________________________________________________________
+Double_t AliPrefixSum3D::IntegralError2(Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int_t binz1, Int_t binz2) const
+{
+  // sum of the squared bin errors in the given bin ranges (0 if the table was built without errors)
+
+  return BoxSum(fSumError2, binx1, binx2, biny1, biny2, binz1, binz2);
+}
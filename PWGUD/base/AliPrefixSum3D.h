@@ -0,0 +1,52 @@
+#ifndef ALIPREFIXSUM3D_H
+#define ALIPREFIXSUM3D_H
+
+/* $Id$ */
+
+// ------------------------------------------------------
+//
+// Summed-area table of a 3d histogram: the sum of the bin
+// contents (and of the squared errors) over any box of bins
+// is obtained with 8 lookups, independent of the box size.
+// Used to evaluate many sub-range integrals of the same
+// correction histogram (e.g. vertex x eta x pt ranges)
+// without projecting it again for each of them.
+//
+// ------------------------------------------------------
+
+#include <vector>
+#include <TAxis.h>
+
+class TH3;
+
+class AliPrefixSum3D
+{
+public:
+  AliPrefixSum3D();
+  AliPrefixSum3D(const TH3* hist, Bool_t errors = kFALSE);
+
+  void Build(const TH3* hist, Bool_t errors = kFALSE);
+
+  // bin ranges are inclusive and follow TH3::Integral (0 = underflow, n+1 = overflow)
+  Double_t Integral(Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int_t binz1, Int_t binz2) const;
+  Double_t IntegralError2(Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int_t binz1, Int_t binz2) const;
+
+  const TAxis* GetXaxis() const { return &fXaxis; }
+  const TAxis* GetYaxis() const { return &fYaxis; }
+  const TAxis* GetZaxis() const { return &fZaxis; }
+
+private:
+  Double_t BoxSum(const std::vector<Double_t>& table, Int_t binx1, Int_t binx2, Int_t biny1, Int_t biny2, Int_t binz1, Int_t binz2) const;
+  Int_t    Index(Int_t i, Int_t j, Int_t k) const { return (k * fNy + j) * fNx + i; }
+
+  TAxis fXaxis;                     // copy of the x axis of the histogram
+  TAxis fYaxis;                     // copy of the y axis of the histogram
+  TAxis fZaxis;                     // copy of the z axis of the histogram
+  Int_t fNx;                        // size of the table along x (bins + under/overflow + 1)
+  Int_t fNy;                        // size of the table along y
+  Int_t fNz;                        // size of the table along z
+  std::vector<Double_t> fSum;       // cumulative bin contents, fSum[Index(i+1,j+1,k+1)] = sum of bins <= (i,j,k)
+  std::vector<Double_t> fSumError2; // cumulative squared bin errors (only if built with errors)
+};
+
+#endif
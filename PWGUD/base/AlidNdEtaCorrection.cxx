@@ -26,6 +26,7 @@
 #include <AliCorrection.h>
 #include <AliCorrectionMatrix2D.h>
 #include <AliCorrectionMatrix3D.h>
+#include "AliPrefixSum3D.h"
 
 //____________________________________________________________________
 ClassImp(AlidNdEtaCorrection)
@@ -433,6 +434,42 @@ Float_t AlidNdEtaCorrection::GetMeasuredFraction(CorrectionType correctionType,
   return fraction;
 }
 
+//____________________________________________________________________
+Float_t AlidNdEtaCorrection::GetMeasuredFraction(const AliPrefixSum3D& generated, Float_t ptCutOff, Float_t eta, Int_t vertexBegin, Int_t vertexEnd)
+{
+  // same as above, from the summed-area table of the generated particle histogram
+  // (vtx_z, eta, pt) of the correction, without projecting the histogram for each call
+
+  Int_t etaBegin = 0;
+  Int_t etaEnd = 0;
+  if (eta < -99)
+  {
+    etaBegin = generated.GetYaxis()->FindFixBin(-0.8);
+    etaEnd = generated.GetYaxis()->FindFixBin(0.8);
+  }
+  else
+  {
+    etaBegin = generated.GetYaxis()->FindFixBin(eta);
+    etaEnd = etaBegin;
+  }
+
+  if (vertexBegin == -1)
+    vertexBegin = generated.GetXaxis()->FindFixBin(-9.99);
+
+  if (vertexEnd == -1)
+    vertexEnd = generated.GetXaxis()->FindFixBin(9.99);
+
+  Int_t nBinsPt = generated.GetZaxis()->GetNbins();
+  Int_t ptBin = generated.GetZaxis()->FindFixBin(ptCutOff);
+  Double_t abovePtCut = generated.Integral(vertexBegin, vertexEnd, etaBegin, etaEnd, ptBin, nBinsPt+1);
+  Double_t all = generated.Integral(vertexBegin, vertexEnd, etaBegin, etaEnd, 1, nBinsPt+1);
+
+  if (all == 0)
+    return -1;
+
+  return abovePtCut / all;
+}
+
 //____________________________________________________________________
 TH1* AlidNdEtaCorrection::GetMeasuredEventFraction(CorrectionType correctionType, Int_t multCut)
 {
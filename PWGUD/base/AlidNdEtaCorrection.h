@@ -20,6 +20,7 @@
 #include "AliPWG0Helper.h"
 
 class AliCorrection;
+class AliPrefixSum3D;
 class TH1;
 
 class AlidNdEtaCorrection : public TNamed
@@ -66,6 +67,7 @@ public:
   void    DrawOverview(const char* canvasName = 0);
 
   Float_t GetMeasuredFraction(CorrectionType correctionType, Float_t ptCutOff, Float_t eta = -100, Int_t vertexBegin = -1, Int_t vertexEnd = -1, Bool_t debug = kFALSE);
+  static Float_t GetMeasuredFraction(const AliPrefixSum3D& generated, Float_t ptCutOff, Float_t eta = -100, Int_t vertexBegin = -1, Int_t vertexEnd = -1);
   TH1*    GetMeasuredEventFraction(CorrectionType correctionType, Int_t multCut);
 
   void    ReduceInformation();
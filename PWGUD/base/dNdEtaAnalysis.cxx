@@ -21,6 +21,7 @@
 #include <AliPWG0Helper.h>
 #include <AliCorrectionMatrix2D.h>
 #include <AliCorrectionMatrix3D.h>
+#include "AliPrefixSum3D.h"
 
 //____________________________________________________________________
 ClassImp(dNdEtaAnalysis)
@@ -444,6 +445,12 @@ void dNdEtaAnalysis::Finish(AlidNdEtaCorrection* correction, Float_t ptCut, Alid
   const Float_t vertexRangeBegin[kVertexBinning] = { fvtxMin,  fvtxMin,  0.01 };
   const Float_t vertexRangeEnd[kVertexBinning]   = { fvtxMax,  -0.01,  fvtxMax };
 
+  // the pt cut off correction is needed for each eta bin and vertex range: the generated
+  // particle histogram is summed up once instead of being projected for each of them
+  AliPrefixSum3D ptCutOffSums;
+  if ((fAnalysisMode & AliPWG0Helper::kTPC || fAnalysisMode & AliPWG0Helper::kTPCITS) && (fAnalysisMode & AliPWG0Helper::kFieldOn) && correction && ptCut > 0 && correction->GetCorrection(correctionType))
+    ptCutOffSums.Build(correction->GetCorrection(correctionType)->GetTrackCorrection()->GetGeneratedHistogram());
+
   for (Int_t iEta=1; iEta<=vtxVsEta->GetNbinsY(); iEta++)
   {
     // loop over vertex ranges
@@ -553,7 +560,7 @@ void dNdEtaAnalysis::Finish(AlidNdEtaCorrection* correction, Float_t ptCut, Alid
       if ((fAnalysisMode & AliPWG0Helper::kTPC || fAnalysisMode & AliPWG0Helper::kTPCITS) && (fAnalysisMode & AliPWG0Helper::kFieldOn))
       {
         if (correction && ptCut > 0)
-            ptCutOffCorrection = correction->GetMeasuredFraction(correctionType, ptCut, vtxVsEta->GetYaxis()->GetBinCenter(iEta), vertexBinBegin, vertexBinEnd);
+            ptCutOffCorrection = correction->GetCorrection(correctionType) ? AlidNdEtaCorrection::GetMeasuredFraction(ptCutOffSums, ptCut, vtxVsEta->GetYaxis()->GetBinCenter(iEta), vertexBinBegin, vertexBinEnd) : -1;
 
         if (ptCutOffCorrection <= 0)
         {
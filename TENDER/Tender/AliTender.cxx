@@ -17,11 +17,17 @@
 
 #include <TChain.h>
 #include <TFile.h>
+#include <THashList.h>
+#include <TMap.h>
+#include <TObjString.h>
+#include <TParameter.h>
  
 #include "AliTender.h"
 #include "AliTenderSupply.h"
 #include "AliAnalysisManager.h"
 #include "AliCDBManager.h"
+#include "AliCDBEntry.h"
+#include "AliCDBId.h"
 #include "AliESDEvent.h"
 #include "AliESDInputHandler.h"
 #include "AliLog.h"
@@ -41,7 +47,9 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fEventData(NULL),
+           fCDBCache(NULL)
 {
 // Dummy constructor
 }
@@ -58,7 +66,9 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fEventData(NULL),
+           fCDBCache(NULL)
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -72,6 +82,8 @@ AliTender::~AliTender()
     fSupplies->Delete();
     delete fSupplies;
   }
+  delete fEventData;
+  delete fCDBCache;
 }
 
 //______________________________________________________________________________
@@ -115,6 +127,14 @@ void AliTender::ConnectInputData(Option_t* option)
   }   
 
   fCDB = AliCDBManager::Instance();
+  if (!fEventData) {
+    fEventData = new THashList();
+    fEventData->SetOwner();
+  }
+  if (!fCDBCache) {
+    fCDBCache = new TMap();
+    fCDBCache->SetOwnerKeyValue();
+  }
   // Initialize OCDB (only done when explicitly requested)
   if(fHandleCDB){
     // Create CDB manager
@@ -154,6 +174,7 @@ void AliTender::UserExec(Option_t* option)
     Printf("AliTender::Exec() %s ==> processing event %lld\n", fESDhandler->GetTree()->GetCurrentFile()->GetName(),entry);
   }  
   fESD = (AliESDEvent*)fESDhandler->GetEvent();
+  if (fEventData) fEventData->Delete();
 
 // Call the user analysis
 
@@ -169,6 +190,7 @@ void AliTender::UserExec(Option_t* option)
       // Lock CDB
       fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
     } 
+    UpdateCDBCache();
   }
   TIter next(fSupplies);
   AliTenderSupply *supply;
@@ -187,3 +209,80 @@ void AliTender::SetDefaultCDBStorage(const char *dbString)
 // Set default CDB storage
    fDefaultStorage = dbString;
 }
+
+//______________________________________________________________________________
+void AliTender::PublishEventObject(TObject *obj) const
+{
+// Publish an object for the supplies processed after the current one. The tender
+// takes ownership, the object is deleted at the start of the next event. An
+// object with the same name published before in the event is replaced.
+   if (!obj) return;
+   if (!fEventData) {
+      delete obj;
+      return;
+   }
+   TObject *old = fEventData->FindObject(obj->GetName());
+   if (old) {
+      fEventData->Remove(old);
+      delete old;
+   }
+   fEventData->Add(obj);
+}
+
+//______________________________________________________________________________
+TObject *AliTender::GetEventObject(const char *name) const
+{
+// Object published by a supply in the current event, NULL if not there.
+   return fEventData ? fEventData->FindObject(name) : NULL;
+}
+
+//______________________________________________________________________________
+void AliTender::PublishEventValue(const char *name, Double_t value) const
+{
+// Publish a number for the supplies processed after the current one.
+   PublishEventObject(new TParameter<Double_t>(name, value));
+}
+
+//______________________________________________________________________________
+Bool_t AliTender::GetEventValue(const char *name, Double_t &value) const
+{
+// Number published by a supply in the current event. Returns kFALSE if not there.
+   TParameter<Double_t> *par = dynamic_cast<TParameter<Double_t>*>(GetEventObject(name));
+   if (!par) return kFALSE;
+   value = par->GetVal();
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+AliCDBEntry *AliTender::GetCDBEntry(const char *path) const
+{
+// OCDB entry for the current run. The entry is retrieved once and kept by the
+// tender, so that several supplies requesting the same path and later runs in
+// the validity range of the entry do not query the OCDB again. Supplies must
+// not keep pointers to the entry content beyond the next run change.
+   if (!fCDB || !fCDBCache) return NULL;
+   AliCDBEntry *entry = (AliCDBEntry*)fCDBCache->GetValue(path);
+   if (entry) return entry;
+   AliCDBEntry *cdbEntry = fCDB->Get(path, fRun);
+   if (!cdbEntry) return NULL;
+   // keep an own copy, the entries of the manager cache are deleted when its run changes
+   entry = (AliCDBEntry*)cdbEntry->Clone();
+   fCDBCache->Add(new TObjString(path), entry);
+   return entry;
+}
+
+//______________________________________________________________________________
+void AliTender::UpdateCDBCache()
+{
+// Drop the cached OCDB entries which are not valid for the new run.
+   if (!fCDBCache) return;
+   TIter next(fCDBCache);
+   TObject *key;
+   TObjArray invalid;
+   while ((key=next())) {
+      const AliCDBId &id = ((AliCDBEntry*)fCDBCache->GetValue(key))->GetId();
+      if (fRun < id.GetFirstRun() || fRun > id.GetLastRun()) invalid.Add(key);
+   }
+   TIter nextInvalid(&invalid);
+   while ((key=nextInvalid())) fCDBCache->DeleteEntry(key);
+}
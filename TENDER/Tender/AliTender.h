@@ -20,7 +20,10 @@
 // #ifndef ALIESDINPUTHANDLER_H
 // #include "AliESDInputHandler.h"
 // #endif
+class THashList;
+class TMap;
 class AliCDBManager;
+class AliCDBEntry;
 class AliESDEvent;
 class AliESDInputHandler;
 class AliTenderSupply;
@@ -43,9 +46,12 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  THashList                *fEventData;      //! Objects published by the supplies for the current event
+  TMap                     *fCDBCache;       //! OCDB entries cached across runs, by path
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
+  void                      UpdateCDBCache();
 
 public:  
   AliTender();
@@ -60,6 +66,13 @@ public:
   TObjArray                *GetSupplies() const {return fSupplies;}
   void                      SetCheckEventSelection(Bool_t flag=kTRUE) {TObject::SetBit(kCheckEventSelection,flag);}
   Bool_t                    RunChanged() const {return fRunChanged;}
+  // Per-event data shared between supplies, cleared at the start of each event
+  void                      PublishEventObject(TObject *obj) const;
+  TObject                  *GetEventObject(const char *name) const;
+  void                      PublishEventValue(const char *name, Double_t value) const;
+  Bool_t                    GetEventValue(const char *name, Double_t &value) const;
+  // OCDB entry for the current run, kept until a run outside its validity range
+  AliCDBEntry              *GetCDBEntry(const char *path) const;
   // Configuration
   void                      SetDefaultCDBStorage(const char *dbString="local://$ALICE_ROOT/OCDB");
   /**
@@ -75,6 +88,6 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,5)  // Class describing the tender car for ESD analysis
 };
 #endif
@@ -96,12 +96,14 @@ AliAnalysisTaskVZEROEqFactorTask::AliAnalysisTaskVZEROEqFactorTask()
 // Tree Variables 
 {
   // Dummy Constructor  
+  for(Int_t i = 0; i < 64; ++i) fFactors[i] = 1.;
 }
 
 AliAnalysisTaskVZEROEqFactorTask::AliAnalysisTaskVZEROEqFactorTask(const char *name) 
   : AliAnalysisTaskSE(name), fListHist(0), fEqFactors(0), fCalibData(0), fRunNumber(0), fHistEventCounter(0), fisAOD(kFALSE)
 {
   // Constructor
+  for(Int_t i = 0; i < 64; ++i) fFactors[i] = 1.;
   DefineOutput(1, TList::Class());
 }
 
@@ -205,25 +207,25 @@ void AliAnalysisTaskVZEROEqFactorTask::UserExec(Option_t *)
       //Load Calibration object fCalibData
       fCalibData = GetCalibData(); // Mirror AliVZEROReconstructor Functionality 
       fRunNumber = runNumber; //New Run
+      if(!fCalibData) AliFatal("No VZERO CalibData Object found!");
+
+      //Equalization factors only depend on the run: compute them once here
+      Float_t factorSum = 0;
+      for(Int_t i = 0; i < 64; ++i) {
+         fFactors[i] = fEqFactors->GetBinContent(i+1)*fCalibData->GetMIPperADC(i);
+         factorSum += fFactors[i];
+      }
+      for(Int_t i = 0; i < 64; ++i) { 
+         fFactors[i] *= (64./factorSum);
+      }
    }
    if(!fCalibData) AliFatal("No VZERO CalibData Object found!");
 
-
-   Float_t factors[64];
-   Float_t factorSum = 0;
-   for(Int_t i = 0; i < 64; ++i) {
-      factors[i] = fEqFactors->GetBinContent(i+1)*fCalibData->GetMIPperADC(i);
-      factorSum += factors[i];
-   }
-   for(Int_t i = 0; i < 64; ++i) { 
-      factors[i] *= (64./factorSum);
-   }
-
    // Set the equalized factors
    if(fisAOD) {
-     lAODevent->SetVZEROEqFactors(factors);
+     lAODevent->SetVZEROEqFactors(fFactors);
    } else {
-     lESDevent->SetVZEROEqFactors(factors);
+     lESDevent->SetVZEROEqFactors(fFactors);
    }
    fHistEventCounter->Fill(3.5);
 
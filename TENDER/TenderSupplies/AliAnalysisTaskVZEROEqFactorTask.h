@@ -72,6 +72,7 @@ class AliAnalysisTaskVZEROEqFactorTask : public AliAnalysisTaskSE {
   TH1F*   fEqFactors;               //! Histogram with the equalization factors used in event-plane reconstruction
   AliVZEROCalibData* fCalibData;    //! calibration data
   Long_t fRunNumber;                //! Needed to make sure we haven't swapped runs
+  Float_t fFactors[64];             //! Normalized equalization factors of the current run
  
 //===========================================================================================
 //   Histograms - Event Counting only 
@@ -83,7 +84,7 @@ class AliAnalysisTaskVZEROEqFactorTask : public AliAnalysisTaskSE {
    AliAnalysisTaskVZEROEqFactorTask(const AliAnalysisTaskVZEROEqFactorTask&);            // not implemented
    AliAnalysisTaskVZEROEqFactorTask& operator=(const AliAnalysisTaskVZEROEqFactorTask&); // not implemented
    
-   ClassDef(AliAnalysisTaskVZEROEqFactorTask, 12);
+   ClassDef(AliAnalysisTaskVZEROEqFactorTask, 13);
 };
 
 #endif
@@ -0,0 +1,169 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include "AliAODCaloCells.h"
+#include "AliEMCALRecoUtils.h"
+#include "AliLog.h"
+#include "AliVCaloCells.h"
+#include "AliEMCALCellCalibTable.h"
+
+ClassImp(AliEMCALCellCalibTable)
+
+//_____________________________________________________
+AliEMCALCellCalibTable::AliEMCALCellCalibTable() :
+  TObject()
+  ,fRun(-1)
+  ,fSwitches(0)
+  ,fNCells(0)
+  ,fAccepted()
+  ,fEnergyFactor()
+  ,fTimeShift()
+  ,fEmptyCells(0)
+{
+  // Default constructor.
+}
+
+//_____________________________________________________
+AliEMCALCellCalibTable::~AliEMCALCellCalibTable()
+{
+  // Destructor.
+
+  delete fEmptyCells;
+}
+
+//_____________________________________________________
+Int_t AliEMCALCellCalibTable::Switches(const AliEMCALRecoUtils *reco)
+{
+  // Bit map of the reco utils switches used by RecalibrateCells.
+
+  Int_t switches = 0;
+  if (reco->IsRecalibrationOn())                switches |= 1<<0;
+  if (reco->IsTimeRecalibrationOn())            switches |= 1<<1;
+  if (reco->IsL1PhaseInTimeRecalibrationOn())   switches |= 1<<2;
+  if (reco->IsBadChannelsRemovalSwitchedOn())   switches |= 1<<3;
+
+  return switches;
+}
+
+//_____________________________________________________
+Bool_t AliEMCALCellCalibTable::IsValidFor(Int_t run, const AliEMCALRecoUtils *reco) const
+{
+  // Check that the table was built for this run and the current reco utils switches.
+
+  return fRun >= 0 && fRun == run && fSwitches == Switches(reco);
+}
+
+//_____________________________________________________
+void AliEMCALCellCalibTable::Build(Int_t run, Int_t ncells, AliEMCALRecoUtils *reco)
+{
+  // Fill the table running the reco utils recalibration on a probe list
+  // with all the cells, amplitude 1 and time 0, for each bunch crossing phase.
+  // Cells removed by the reco utils get amplitude 0 and time -1.
+
+  fRun      = run;
+  fSwitches = Switches(reco);
+  fNCells   = ncells;
+
+  fAccepted    .assign(fNCells, 1);
+  fEnergyFactor.assign(fNCells, 1.);
+  fTimeShift   .assign(5*fNCells, 0.);
+
+  if (!fEmptyCells)
+  {
+    fEmptyCells = new AliAODCaloCells("EmptyCells","EmptyCells",AliVCaloCells::kEMCALCell);
+    fEmptyCells->CreateContainer(0);
+  }
+
+  if (!fSwitches) return;
+
+  AliAODCaloCells probe("ProbeCells","ProbeCells",AliVCaloCells::kEMCALCell);
+  probe.CreateContainer(fNCells);
+
+  // bunch crossing phases 0-3, and no bunch crossing information in row 4
+  for (Int_t row = 0; row < 5; row++)
+  {
+    for (Int_t absId = 0; absId < fNCells; absId++)
+      probe.SetCell(absId, absId, 1., 0.);
+    probe.Sort();
+
+    reco->ResetCellsCalibrated();
+    reco->RecalibrateCells(&probe, row < 4 ? row : -1);
+
+    Short_t  absId   = -1;
+    Double_t amp     = 0;
+    Double_t time    = 0;
+    Int_t    mclabel = -1;
+    Double_t efrac   = 0;
+    for (Int_t icell = 0; icell < probe.GetNumberOfCells(); icell++)
+    {
+      probe.GetCell(icell, absId, amp, time, mclabel, efrac);
+      if (absId < 0 || absId >= fNCells) continue;
+
+      if (amp == 0 && time == -1)
+      {
+        fAccepted[absId] = 0;
+        continue;
+      }
+
+      if (row == 0) fEnergyFactor[absId] = amp;
+      fTimeShift[row*fNCells+absId] = time;
+    }
+  }
+
+  Int_t nbad = 0;
+  for (Int_t absId = 0; absId < fNCells; absId++)
+    if (!fAccepted[absId]) nbad++;
+
+  AliInfo(Form("Cell calibration table built for run %d: %d cells, %d removed, switches 0x%x", fRun, fNCells, nbad, fSwitches));
+}
+
+//_____________________________________________________
+void AliEMCALCellCalibTable::Apply(AliVCaloCells *cells, Int_t bc, AliEMCALRecoUtils *reco) const
+{
+  // Recalibrate the cells of the event with the table, same as
+  // AliEMCALRecoUtils::RecalibrateCells(cells, bc). The cells are
+  // then flagged as recalibrated in the reco utils.
+
+  if (!cells || !fSwitches) return;
+
+  const Double_t *shift = &fTimeShift[TimeRow(bc)*fNCells];
+
+  Short_t  absId   = -1;
+  Double_t amp     = 0;
+  Double_t time    = 0;
+  Int_t    mclabel = -1;
+  Double_t efrac   = 0;
+
+  Int_t ncells = cells->GetNumberOfCells();
+  for (Int_t icell = 0; icell < ncells; icell++)
+  {
+    cells->GetCell(icell, absId, amp, time, mclabel, efrac);
+
+    if (absId >= 0 && absId < fNCells && fAccepted[absId])
+    {
+      amp  *= fEnergyFactor[absId];
+      time += shift[absId];
+    }
+    else
+    {
+      amp  =  0;
+      time = -1;
+    }
+
+    cells->SetCell(icell, absId, amp, time, mclabel, efrac);
+  }
+
+  reco->RecalibrateCells(fEmptyCells, bc);
+}
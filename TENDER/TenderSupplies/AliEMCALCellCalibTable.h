@@ -0,0 +1,67 @@
+#ifndef ALIEMCALCELLCALIBTABLE_H
+#define ALIEMCALCELLCALIBTABLE_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+///
+/// \class AliEMCALCellCalibTable
+/// \brief Per run EMCal cell calibration table, indexed by absolute cell ID
+///
+/// Combines for each cell the bad channel status, the energy recalibration
+/// factor and the time shift (time recalibration and L1 phase, for each of
+/// the 4 bunch crossing phases) that AliEMCALRecoUtils::RecalibrateCells()
+/// applies with the current switches and calibration histograms.
+/// The table is filled once per run by running RecalibrateCells() on a
+/// probe list with all the cells (amplitude 1, time 0), so that it follows
+/// exactly the reco utils implementation, and it is then applied to the
+/// cells of each event in one pass, without geometry or histogram lookups.
+///
+/// The cells must not be recalibrated yet in the event (ResetCellsCalibrated()
+/// called before), as done by the EMCal tender and the cell correction
+/// components before updating the cells.
+///
+
+#include <TObject.h>
+#include <vector>
+
+class AliVCaloCells;
+class AliAODCaloCells;
+class AliEMCALRecoUtils;
+
+class AliEMCALCellCalibTable : public TObject {
+
+public:
+  AliEMCALCellCalibTable();
+  virtual ~AliEMCALCellCalibTable();
+
+  Bool_t   IsValidFor(Int_t run, const AliEMCALRecoUtils *reco) const;
+  void     Build(Int_t run, Int_t ncells, AliEMCALRecoUtils *reco);
+  void     Apply(AliVCaloCells *cells, Int_t bc, AliEMCALRecoUtils *reco) const;
+  void     Reset()                                        { fRun = -1                        ;}
+
+  Int_t    GetNCells()                              const { return fNCells                   ;}
+  Bool_t   IsAccepted(Int_t absId)                  const { return absId >= 0 && absId < fNCells && fAccepted[absId] ;}
+  Float_t  GetEnergyFactor(Int_t absId)             const { return fEnergyFactor[absId]      ;}
+  Double_t GetTimeShift(Int_t absId, Int_t bc)      const { return fTimeShift[TimeRow(bc)*fNCells+absId] ;}
+
+private:
+
+  static Int_t Switches(const AliEMCALRecoUtils *reco);
+  static Int_t TimeRow(Int_t bc)                          { return bc >= 0 ? bc%4 : 4        ;}
+
+  Int_t                  fRun;                    // run of the table, -1 if not built
+  Int_t                  fSwitches;               // reco utils switches of the table
+  Int_t                  fNCells;                 // number of cells in the table
+  std::vector<UChar_t>   fAccepted;               //! 0 for the cells removed by the reco utils
+  std::vector<Float_t>   fEnergyFactor;           //! energy recalibration factor per cell
+  std::vector<Double_t>  fTimeShift;              //! time shift per cell, for bc%4 and for bc<0
+  AliAODCaloCells       *fEmptyCells;             //! empty list, to flag the cells as recalibrated in the reco utils
+
+  AliEMCALCellCalibTable(            const AliEMCALCellCalibTable&c);
+  AliEMCALCellCalibTable& operator= (const AliEMCALCellCalibTable&c);
+
+  ClassDef(AliEMCALCellCalibTable, 1); // EMCAL per run cell calibration table
+};
+
+#endif
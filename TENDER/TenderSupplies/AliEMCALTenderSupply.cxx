@@ -25,6 +25,7 @@
 #include "AliAODMCParticle.h"
 #include "AliAnalysisManager.h"
 #include "AliEMCALAfterBurnerUF.h"
+#include "AliEMCALCellCalibTable.h"
 #include "AliEMCALClusterizer.h"
 #include "AliEMCALClusterizerNxN.h"
 #include "AliEMCALClusterizerv1.h"
@@ -107,6 +108,8 @@ AliEMCALTenderSupply::AliEMCALTenderSupply() :
   ,fUseAutomaticRunDepRecalib(1)
   ,fUseAutomaticTimeCalib(1)
   ,fUseAutomaticRecParam(1)
+  ,fUseCellCalibTable(1)
+  ,fCellCalibTable(0)
 {
   // Default constructor.
 
@@ -178,6 +181,8 @@ AliEMCALTenderSupply::AliEMCALTenderSupply(const char *name, const AliTender *te
   ,fUseAutomaticRunDepRecalib(1)
   ,fUseAutomaticTimeCalib(1)
   ,fUseAutomaticRecParam(1)
+  ,fUseCellCalibTable(1)
+  ,fCellCalibTable(0)
 {
   // Named constructor
   
@@ -249,6 +254,8 @@ AliEMCALTenderSupply::AliEMCALTenderSupply(const char *name, AliAnalysisTaskSE *
   ,fUseAutomaticRunDepRecalib(1)
   ,fUseAutomaticTimeCalib(1)
   ,fUseAutomaticRecParam(1)
+  ,fUseCellCalibTable(1)
+  ,fCellCalibTable(0)
 {
   // Named constructor.
   
@@ -262,6 +269,8 @@ AliEMCALTenderSupply::~AliEMCALTenderSupply()
 {
   //Destructor
 
+  delete fCellCalibTable;
+
   if (!AliAnalysisManager::GetAnalysisManager())  return;  
 
   if (!AliAnalysisManager::GetAnalysisManager()->IsProofMode()) 
@@ -360,6 +369,7 @@ void AliEMCALTenderSupply::Init()
     fExoticCellFraction     = tender->fExoticCellFraction;
     fExoticCellDiffTime     = tender->fExoticCellDiffTime;
     fExoticCellMinAmplitude = tender->fExoticCellMinAmplitude;
+    fUseCellCalibTable      = tender->fUseCellCalibTable;
 
     for(Int_t i = 0; i < AliEMCALGeoParams::fgkEMCALModules; i++) 
       fEMCALMatrix[i] = tender->fEMCALMatrix[i] ;
@@ -375,6 +385,7 @@ void AliEMCALTenderSupply::Init()
     AliInfo(Form("CalibrateTimeL1Phase : %d", fCalibrateTimeL1Phase));
     AliInfo(Form("UpdateCell : %d", fUpdateCell)); 
     AliInfo(Form("DoUpdateOnly : %d", fDoUpdateOnly)); 
+    AliInfo(Form("UseCellCalibTable : %d", fUseCellCalibTable)); 
     AliInfo(Form("Reclustering : %d", fReClusterize)); 
     AliInfo(Form("ClusterBadChannelCheck : %d", fClusterBadChannelCheck)); 
     AliInfo(Form("ClusterExoticChannelCheck : %d", fRejectExoticClusters)); 
@@ -1481,7 +1492,18 @@ void AliEMCALTenderSupply::UpdateCells()
   AliVCaloCells *cells = event->GetEMCALCells();
   Int_t bunchCrossNo = event->GetBunchCrossNumber();
 
-  fEMCALRecoUtils->RecalibrateCells(cells, bunchCrossNo); 
+  // Recalibrate with the per run table, filled from the reco utils when the run changes
+  if (fUseCellCalibTable && fEMCALGeo)
+  {
+    if (!fCellCalibTable) fCellCalibTable = new AliEMCALCellCalibTable();
+
+    if (!fCellCalibTable->IsValidFor(fRun, fEMCALRecoUtils))
+      fCellCalibTable->Build(fRun, fEMCALGeo->GetNCells(), fEMCALRecoUtils);
+
+    fCellCalibTable->Apply(cells, bunchCrossNo, fEMCALRecoUtils);
+  }
+  else
+    fEMCALRecoUtils->RecalibrateCells(cells, bunchCrossNo); 
   
   // remove exotic cells - loop through cells and zero the exotic ones
   // just like with bad cell rejection in reco utils (inside RecalibrateCells)
@@ -25,6 +25,7 @@ class TClonesArray;
 
 class AliVCluster;
 class AliEMCALRecoUtils;
+class AliEMCALCellCalibTable;
 class AliEMCALGeometry;
 class TGeoHMatrix;
 class TTree;
@@ -194,6 +195,10 @@ public:
   void     SwitchOffUseAutomaticRunDepRecalibParam()       { fUseAutomaticRunDepRecalib = kFALSE ; }
   void     SwitchOffUseAutomaticTimeCalibParam()           { fUseAutomaticTimeCalib     = kFALSE ; }
   void     SwitchOffUseAutomaticRecParam()                 { fUseAutomaticRecParam      = kFALSE ; }
+
+  // Switch on/off the per run cell calibration table, filled from the reco utils on run change
+  void     SwitchOnCellCalibTable()                        { fUseCellCalibTable         = kTRUE  ; }
+  void     SwitchOffCellCalibTable()                       { fUseCellCalibTable         = kFALSE ; }
   
 private:
 
@@ -292,10 +297,13 @@ private:
   Bool_t                 fUseAutomaticRunDepRecalib; // On by default the check in the OADB of the run dependent energy recalibration
   Bool_t                 fUseAutomaticTimeCalib;     // On by default the check in the OADB of the time recalibration
   Bool_t                 fUseAutomaticRecParam;      // On the auto setting of the rec param
+
+  Bool_t                 fUseCellCalibTable;         // Recalibrate the cells with the per run calibration table
+  AliEMCALCellCalibTable*fCellCalibTable;            //! Per run cell bad channel, energy and time calibration table
   
   AliEMCALTenderSupply(            const AliEMCALTenderSupply&c);
   AliEMCALTenderSupply& operator= (const AliEMCALTenderSupply&c);
   
-  ClassDef(AliEMCALTenderSupply, 20); // EMCAL tender task
+  ClassDef(AliEMCALTenderSupply, 21); // EMCAL tender task
 };
 #endif
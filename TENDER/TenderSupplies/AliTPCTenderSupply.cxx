@@ -281,7 +281,7 @@ void AliTPCTenderSupply::SetSplines()
   //
   fPcorrection=kFALSE;
   
-  AliCDBEntry *entryGRP=fTender->GetCDBManager()->Get("GRP/GRP/Data",fTender->GetRun());
+  AliCDBEntry *entryGRP=fTender->GetCDBEntry("GRP/GRP/Data");
   if (!entryGRP) {
     AliError("No new GRP entry found");
   } else {
@@ -21,6 +21,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <TSystem.h>
+#include <TGraph.h>
 #include "AliESDEvent.h"
 #include "AliTender.h"
 #include "AliVParticle.h"
@@ -159,10 +160,18 @@ void AliTrackFixTenderSupply::ProcessEvent()
 //_____________________________________________________
 void AliTrackFixTenderSupply::CorrectTrackPtInv(AliExternalTrackParam* trc, Int_t mode, double sideAfraction, double phi) const
 {
-  // fix track kinematics
+  // fix track kinematics, same as adding fParams->GetPtInvCorr(mode,sideAfraction,phi)
+  // but using the per-run tables filled in GetRunCorrections
   if (!trc) return;
+  const std::vector<Double_t> &corC = fPtInvCorC[mode];
+  if (corC.empty()) return; // no graph
+  while (phi>2*TMath::Pi()) phi -= 2*TMath::Pi();
+  while (phi<0) phi += 2*TMath::Pi();
+  int nb = corC.size();
+  int bin = int( phi/(2*TMath::Pi())*nb );
+  if (bin==nb) bin = nb-1;
   double *param = (double*)trc->GetParameter();
-  param[4] += fParams->GetPtInvCorr(mode,sideAfraction,phi);
+  param[4] += corC[bin] + sideAfraction*fPtInvCorAC[mode][bin];
   //
 }
 
@@ -191,11 +200,31 @@ Bool_t AliTrackFixTenderSupply::GetRunCorrections(int run)
 {
   // extract corrections for given run
   fParams = 0;
+  for (int imd=0;imd<AliOADBTrackFix::kNCorModes;imd++) {
+    fPtInvCorC[imd].clear();
+    fPtInvCorAC[imd].clear();
+  }
   if (!fOADBCont) if (!LoadOADBObjects()) return kFALSE;
   fParams = dynamic_cast<AliOADBTrackFix*>(fOADBCont->GetObject(run,"default"));
   if (!fParams) {AliError(Form("No correction parameters for found for run %d",run)); return kFALSE;}
   AliInfo(Form("Loaded correction parameters for run %d",run));
   //
+  // flatten the A,C side graphs to C and A-C tables per phi bin, such that the
+  // correction for side A fraction f is corC[bin] + f*corAC[bin]
+  for (int imd=0;imd<AliOADBTrackFix::kNCorModes;imd++) {
+    const TGraph* grA = fParams->GetPtInvCorrGraph(imd,0);
+    const TGraph* grC = fParams->GetPtInvCorrGraph(imd,1);
+    if (!grA || !grC) continue;
+    int nb = grA->GetN();
+    if (grC->GetN()<nb) {AliError(Form("Side C correction of mode %d has less points than side A",imd)); continue;}
+    fPtInvCorC[imd].resize(nb);
+    fPtInvCorAC[imd].resize(nb);
+    for (int ib=0;ib<nb;ib++) {
+      fPtInvCorC[imd][ib]  = grC->GetY()[ib];
+      fPtInvCorAC[imd][ib] = grA->GetY()[ib] - grC->GetY()[ib];
+    }
+  }
+  //
   return kTRUE;
 }
 
@@ -13,15 +13,16 @@
 //                                                                    //
 ////////////////////////////////////////////////////////////////////////
 
+#include <vector>
 #include <TString.h>
 #include "AliTenderSupply.h"
+#include "AliOADBTrackFix.h"
 
 
 class AliESDVertex;
 class AliExternalTrackParam;
 class AliOADBContainer;
 class AliESDtrack;
-class AliOADBTrackFix;
 
 class AliTrackFixTenderSupply: public AliTenderSupply {
   
@@ -57,8 +58,10 @@ private:
   TString           fOADBObjPath;            // path of file with parameters to use, starting from OADB dir
   TString           fOADBObjName;            // name of the corrections object in the OADB container
   AliOADBContainer* fOADBCont;               // OADB container with parameters collection
+  std::vector<Double_t> fPtInvCorC[AliOADBTrackFix::kNCorModes];  //! side C 1/pt correction per phi bin, current run
+  std::vector<Double_t> fPtInvCorAC[AliOADBTrackFix::kNCorModes]; //! side A - side C 1/pt correction per phi bin, current run
   //
-  ClassDef(AliTrackFixTenderSupply, 1);  // track fixing tender task 
+  ClassDef(AliTrackFixTenderSupply, 2);  // track fixing tender task 
 };
 
 
@@ -100,7 +100,7 @@ void AliVZEROTenderSupply::ProcessEvent()
       if (fDebug) printf("AliVZEROTenderSupply::Used geometry entry: %s\n",entryGeom->GetId().ToString().Data());
     }
 
-    AliCDBEntry *entryCal = fTender->GetCDBManager()->Get("VZERO/Calib/Data",fTender->GetRun());
+    AliCDBEntry *entryCal = fTender->GetCDBEntry("VZERO/Calib/Data");
     if (!entryCal) {
       AliError("No VZERO calibration entry is found");
       fCalibData = NULL;
@@ -110,7 +110,7 @@ void AliVZEROTenderSupply::ProcessEvent()
       if (fDebug) printf("AliVZEROTenderSupply::Used VZERO calibration entry: %s\n",entryCal->GetId().ToString().Data());
     }
 
-    AliCDBEntry *entrySlew = fTender->GetCDBManager()->Get("VZERO/Calib/TimeSlewing",fTender->GetRun());
+    AliCDBEntry *entrySlew = fTender->GetCDBEntry("VZERO/Calib/TimeSlewing");
     if (!entrySlew) {
       AliError("VZERO time slewing function is not found in OCDB !");
       fTimeSlewing = NULL;
@@ -120,7 +120,7 @@ void AliVZEROTenderSupply::ProcessEvent()
       if (fDebug) printf("AliVZEROTenderSupply::Used VZERO time slewing entry: %s\n",entrySlew->GetId().ToString().Data());
     }
 
-    AliCDBEntry *entryRecoParam = fTender->GetCDBManager()->Get("VZERO/Calib/RecoParam",fTender->GetRun());
+    AliCDBEntry *entryRecoParam = fTender->GetCDBEntry("VZERO/Calib/RecoParam");
     if (!entryRecoParam) {
       AliError("VZERO reco-param object is not found in OCDB !");
       fRecoParam = NULL;
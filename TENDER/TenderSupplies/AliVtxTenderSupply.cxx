@@ -37,7 +37,8 @@ ClassImp(AliVtxTenderSupply)
 AliVtxTenderSupply::AliVtxTenderSupply() :
   AliTenderSupply(),
   fDiamond(0x0),
-  fRefitAlgo(-1)
+  fRefitAlgo(-1),
+  fVertexer(0x0)
 {
   //
   // default ctor
@@ -48,13 +49,23 @@ AliVtxTenderSupply::AliVtxTenderSupply() :
 AliVtxTenderSupply::AliVtxTenderSupply(const char *name, const AliTender *tender) :
   AliTenderSupply(name,tender),
   fDiamond(0x0),
-  fRefitAlgo(-1)
+  fRefitAlgo(-1),
+  fVertexer(0x0)
 {
   //
   // named ctor
   //
 }
 
+//_____________________________________________________
+AliVtxTenderSupply::~AliVtxTenderSupply()
+{
+  //
+  // dtor
+  //
+  delete fVertexer;
+}
+
 //_____________________________________________________
 void AliVtxTenderSupply::ProcessEvent()
 {
@@ -74,25 +85,30 @@ void AliVtxTenderSupply::ProcessEvent()
 
   if (fTender->RunChanged()){
     fDiamond=0x0;
-    AliCDBEntry *meanVertex=fTender->GetCDBManager()->Get("GRP/Calib/MeanVertex",fTender->GetRun());
+    AliCDBEntry *meanVertex=fTender->GetCDBEntry("GRP/Calib/MeanVertex");
     if (!meanVertex) {
       AliError("No new MeanVertex entry found");
       return;
     } else {
       fDiamond=(AliESDVertex*)meanVertex->GetObject();
     }
+    // the vertexer is configured once per run and reused for all the events
+    if (!fVertexer) {
+      fVertexer = new AliVertexerTracks(event->GetMagneticField());
+      fVertexer->SetITSMode();
+      fVertexer->SetMinClusters(3);
+    } else {
+      fVertexer->SetFieldkG(event->GetMagneticField());
+    }
+    fVertexer->SetVtxStart(fDiamond);
     //printf("\nRun %d, sigmaX %f, sigmaY %f\n",fTender->GetRun(),fDiamond->GetXRes(),fDiamond->GetYRes());
   }
 
-  if (!fDiamond) return;
+  if (!fDiamond || !fVertexer) return;
 
   // Redo the primary with the constraint ONLY if the updated mean vertex was found in the OCDB
   if ( (fDiamond->GetXRes())<2){ 
-    AliVertexerTracks vertexer(event->GetMagneticField());
-    vertexer.SetITSMode();
-    vertexer.SetMinClusters(3);
-    vertexer.SetVtxStart(fDiamond);
-    AliESDVertex *pvertex = vertexer.FindPrimaryVertex(event);
+    AliESDVertex *pvertex = fVertexer->FindPrimaryVertex(event);
     event->SetPrimaryVertexTracks(pvertex);
     // write the diamond parameters
     event->SetDiamond(fDiamond);
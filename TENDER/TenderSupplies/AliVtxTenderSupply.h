@@ -13,6 +13,7 @@
 #include <AliTenderSupply.h>
 
 class AliESDVertex;
+class AliVertexerTracks;
 
 class AliVtxTenderSupply: public AliTenderSupply {
   
@@ -20,7 +21,7 @@ public:
   AliVtxTenderSupply();
   AliVtxTenderSupply(const char *name, const AliTender *tender=NULL);
   
-  virtual ~AliVtxTenderSupply(){;}
+  virtual ~AliVtxTenderSupply();
   
   virtual void              Init(){;}
   virtual void              ProcessEvent();
@@ -35,8 +36,9 @@ private:
 
   AliESDVertex *fDiamond;           //!Information about mean vertex  
   Int_t         fRefitAlgo;         //! optional request for vertex refit 
+  AliVertexerTracks *fVertexer;     //! vertexer with the diamond constraint of the current run
 
-  ClassDef(AliVtxTenderSupply, 1);  // Primary vertex tender task
+  ClassDef(AliVtxTenderSupply, 2);  // Primary vertex tender task
 };
 
 